@@ -0,0 +1,162 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""
+Kernel bundle, an archive of the compiled kernels of a kernel meta dir.
+
+A bundle packed on a machine that has compiled the kernels of a model is unpacked into the kernel meta dir of a new
+machine before its first build, so the kernels are found in the cache instead of compiled again. It is a tar file of
+the json and binary files of the kernels with a manifest of their sha256, and it is only unpacked by the same
+version of MindSpore as the one packing it.
+
+Usage:
+    python -m mindspore._extends.kernel_bundle <kernel_meta_dir> <bundle_path>
+"""
+import json
+import logging
+import os
+import sys
+import tarfile
+from mindspore._extends.utils import cal_sha256
+
+BUNDLE_FORMAT = 1
+MANIFEST_NAME = 'manifest.json'
+
+
+def _bundle_version():
+    """The version the bundle is packed and unpacked by."""
+    from mindspore.version import __version__
+    return __version__
+
+
+def _bin_file_name(json_name, kernel_info):
+    """The name of the binary file of a kernel, as KernelPack::ReadFromJsonFile finds it."""
+    suffix = kernel_info.get('binFileSuffix', '.ptx')
+    prefix = 'lib' if suffix == '.so' else ''
+    return prefix + json_name[:-len('.json')] + suffix
+
+
+def _compiled_kernels(kernel_meta_dir):
+    """The json and binary files of the kernels whose binaries match the sha256 of their json."""
+    kernels = []
+    for json_name in sorted(os.listdir(kernel_meta_dir)):
+        if not json_name.endswith('.json'):
+            continue
+        try:
+            with open(os.path.join(kernel_meta_dir, json_name), 'r') as f:
+                kernel_info = json.load(f)
+        except (IOError, ValueError):
+            continue
+        if not isinstance(kernel_info, dict) or 'sha256' not in kernel_info:
+            continue
+        bin_name = _bin_file_name(json_name, kernel_info)
+        if cal_sha256(os.path.join(kernel_meta_dir, bin_name)) != kernel_info['sha256']:
+            continue
+        kernels.append({'json': json_name, 'bin': bin_name, 'sha256': kernel_info['sha256']})
+    return kernels
+
+
+def pack_kernel_bundle(kernel_meta_dir, bundle_path):
+    """
+    Pack the compiled kernels of a kernel meta dir into a bundle.
+
+    Args:
+        kernel_meta_dir (str): The kernel meta dir, such as `./kernel_meta` or `$MS_COMPILER_CACHE_PATH/kernel_meta`.
+        bundle_path (str): The path of the bundle to write.
+
+    Returns:
+        int, the number of the kernels packed.
+    """
+    kernels = _compiled_kernels(kernel_meta_dir)
+    manifest = json.dumps({'format': BUNDLE_FORMAT, 'version': _bundle_version(), 'kernels': kernels}).encode()
+    manifest_path = bundle_path + '.manifest'
+    with open(manifest_path, 'wb') as f:
+        f.write(manifest)
+    try:
+        with tarfile.open(bundle_path, 'w:gz') as bundle:
+            bundle.add(manifest_path, arcname=MANIFEST_NAME)
+            for kernel in kernels:
+                bundle.add(os.path.join(kernel_meta_dir, kernel['bin']), arcname=kernel['bin'])
+                bundle.add(os.path.join(kernel_meta_dir, kernel['json']), arcname=kernel['json'])
+    finally:
+        os.remove(manifest_path)
+    os.chmod(bundle_path, 0o600)
+    return len(kernels)
+
+
+def _extract_file(bundle, name, path):
+    """Extract a file of the bundle, written aside first so the processes sharing the dir never see it half."""
+    tmp_path = path + '.' + str(os.getpid())
+    src = bundle.extractfile(name)
+    if src is None:
+        return False
+    with open(tmp_path, 'wb') as dst:
+        dst.write(src.read())
+    os.chmod(tmp_path, 0o400)
+    os.rename(tmp_path, path)
+    return True
+
+
+def _is_plain_name(name):
+    """Whether a name of the bundle is a file name in the kernel meta dir."""
+    return name and os.path.basename(name) == name and name not in ('.', '..')
+
+
+def unpack_kernel_bundle(bundle_path, kernel_meta_dir):
+    """
+    Unpack the kernels of a bundle into a kernel meta dir, the kernels already in the dir are kept.
+
+    Args:
+        bundle_path (str): The path of the bundle.
+        kernel_meta_dir (str): The kernel meta dir to unpack into.
+
+    Returns:
+        int, the number of the kernels unpacked, or -1 if the bundle can not be used.
+    """
+    try:
+        with tarfile.open(bundle_path, 'r:*') as bundle:
+            manifest = json.loads(bundle.extractfile(MANIFEST_NAME).read().decode())
+            if manifest.get('format') != BUNDLE_FORMAT or manifest.get('version') != _bundle_version():
+                logging.warning("The kernel bundle %s is packed by version %s, not %s.", bundle_path,
+                                manifest.get('version'), _bundle_version())
+                return -1
+            os.makedirs(kernel_meta_dir, mode=0o700, exist_ok=True)
+            count = 0
+            for kernel in manifest.get('kernels', []):
+                json_name, bin_name = kernel.get('json'), kernel.get('bin')
+                if not _is_plain_name(json_name) or not _is_plain_name(bin_name):
+                    continue
+                json_path = os.path.join(kernel_meta_dir, json_name)
+                bin_path = os.path.join(kernel_meta_dir, bin_name)
+                if os.path.exists(json_path):
+                    continue
+                # the json is written last, the index of the kernel meta dir only lists the kernels with their json
+                if not _extract_file(bundle, bin_name, bin_path) or cal_sha256(bin_path) != kernel.get('sha256'):
+                    logging.warning("The kernel %s of the bundle %s is broken.", bin_name, bundle_path)
+                    if os.path.exists(bin_path):
+                        os.remove(bin_path)
+                    continue
+                if _extract_file(bundle, json_name, json_path):
+                    count += 1
+            return count
+    except (IOError, KeyError, ValueError, tarfile.TarError) as e:
+        logging.warning("Unpack the kernel bundle %s failed: %s", bundle_path, e)
+        return -1
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(1)
+    print("Packed %d kernels into %s." % (pack_kernel_bundle(sys.argv[1], sys.argv[2]), sys.argv[2]))
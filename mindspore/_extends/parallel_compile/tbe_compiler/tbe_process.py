@@ -135,8 +135,10 @@ def run_compiler(op_json):
     """
     try:
         tbe_compiler = os.path.join(os.path.split(os.path.realpath(__file__))[0], "compiler.py")
+        # the kernels are written to the kernel_meta under the cwd, shared by the processes when the cache path is set
+        cache_path = os.environ.get("MS_COMPILER_CACHE_PATH") or None
         subprocess.run([sys.executable, tbe_compiler], input=op_json, timeout=300,
-                       text=True, capture_output=True, check=True)
+                       text=True, capture_output=True, check=True, cwd=cache_path)
         return "Success", "Success"
     except subprocess.TimeoutExpired:
         tb = traceback.format_exc()
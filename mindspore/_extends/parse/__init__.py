@@ -21,7 +21,7 @@ from .parser import (Parser, create_obj_instance, generate_scope,
                      get_class_member_namespace_symbol,
                      get_dataclass_attributes, get_dataclass_methods,
                      get_module_namespace, get_obj_type, get_object_key,
-                     get_parse_method_of_class, get_scope_name,
+                     get_parse_cache_key, get_parse_method_of_class, get_scope_name,
                      is_class_member, parse_cb, resolve_symbol)
 from .serialize import *
 
@@ -29,4 +29,4 @@ __all__ = ['parse_cb', 'get_parse_method_of_class', 'get_bprop_method_of_class',
            'get_object_key', 'get_class_instance_type', 'is_class_member', 'get_obj_type',
            'create_obj_instance', 'get_module_namespace', 'get_class_member_namespace_symbol',
            'Parser', 'get_dataclass_attributes', 'get_dataclass_methods', 'dump_obj', 'load_obj',
-           'get_dataclass_methods', 'get_scope_name']
+           'get_dataclass_methods', 'get_scope_name', 'get_parse_cache_key']
@@ -17,6 +17,7 @@
 """The module of parser python object, called by c++."""
 
 import ast
+import hashlib
 import types
 import inspect
 from textwrap import dedent
@@ -176,6 +177,36 @@ def get_scope_name(obj):
     return None
 
 
+def get_parse_cache_key(method):
+    """
+    Get the key of the graph parsed from the method of a cell instance.
+
+    The instances of a class whose method has the same source, the same primitive members and the same flags are
+    parsed to the same graph apart from the class members and the scope, so the graph parsed for one of them is
+    cloned and bound to the others instead of being parsed again.
+
+    Args:
+        method(MethodType): The method to parse.
+
+    Returns:
+        tuple, the key and the cell instance the graph is bound to, or None if the graph is not shared.
+    """
+    if not isinstance(method, types.MethodType) or not isinstance(method.__self__, nn.Cell):
+        return None
+    instance = method.__self__
+    fn = method.__func__
+    try:
+        source = inspect.getsource(fn)
+    except (OSError, TypeError):
+        return None
+    # the parse resolves the members of the instance which are primitives at once, and sets the flags to the graph
+    primitives = sorted(name for name, value in vars(instance).items() if hasattr(value, '__primitive_flag__'))
+    flags = sorted(getattr(instance, '_mindspore_flags', {}).items())
+    signature = hashlib.sha256(repr((source, primitives, flags)).encode()).hexdigest()
+    key = "%s.%s_ID%d_%s" % (fn.__module__, fn.__qualname__, id(fn), signature)
+    return key, instance
+
+
 def get_object_key(obj):
     """Return the function key: module + name."""
     obj_key = ""
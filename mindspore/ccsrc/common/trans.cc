@@ -17,8 +17,8 @@
 #include <algorithm>
 #include <functional>
 #include <numeric>
+#include <thread>
 #include <utility>
-#include "./securec.h"
 #include "common/utils.h"
 #include "device/convert_tensor_utils.h"
 #include "utils/convert_utils.h"
@@ -70,21 +70,174 @@ const std::map<std::pair<TypeId, TypeId>, DataTypeTransMode> mode_map{
   {std::pair<TypeId, TypeId>(kNumberTypeInt8, kNumberTypeInt32), FROM_INT8_TO_INT32},
   {std::pair<TypeId, TypeId>(kNumberTypeInt64, kNumberTypeInt32), FROM_INT64_TO_INT32}};
 
+namespace {
+// a transform runs on the threads of the host when each of them gets this many elements at least
+constexpr size_t kParallelElemNum = 64 * 1024;
+
+// run task(begin, end) over the indexes in [0, count), elem_num elements are moved for each index
+void ParallelFor(size_t count, size_t elem_num, const std::function<void(size_t, size_t)> &task) {
+  size_t max_thread_num = std::max(std::thread::hardware_concurrency(), 1u);
+  size_t thread_num = std::min(max_thread_num, count * std::max(elem_num, size_t(1)) / kParallelElemNum);
+  thread_num = std::min(thread_num, count);
+  if (thread_num <= 1) {
+    task(0, count);
+    return;
+  }
+  size_t block = Ceil(count, thread_num);
+  std::vector<std::thread> threads;
+  for (size_t begin = block; begin < count; begin += block) {
+    threads.emplace_back(task, begin, std::min(begin + block, count));
+  }
+  task(0, block);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+// the format transforms move the elements only, so they run on the unsigned integers of the element size
+template <typename Func>
+bool RunByElemSize(size_t elem_size, const Func &func) {
+  switch (elem_size) {
+    case 1:
+      func(uint8_t());
+      return true;
+    case 2:
+      func(uint16_t());
+      return true;
+    case 4:
+      func(uint32_t());
+      return true;
+    case 8:
+      func(uint64_t());
+      return true;
+    default:
+      MS_LOG(ERROR) << "unsupported element size " << elem_size;
+      return false;
+  }
+}
+
+// the fractal z is (c1 * h * w, n1, n0 = 16, c0), the padded kernels and channels are zeros
+template <typename T>
+void NchwToFracZKernel(const T *src, T *dst, size_t n, size_t c, size_t hw, size_t c0) {
+  size_t chw = c * hw;
+  size_t n_pad = Ceil(n, kCubeSize) * kCubeSize;
+  ParallelFor(Ceil(c, c0) * hw, n_pad * c0, [=](size_t begin, size_t end) {
+    for (size_t vfi = begin; vfi < end; ++vfi) {
+      size_t c_begin = vfi / hw * c0;
+      size_t c_num = std::min(c0, c - c_begin);
+      const T *src_f = src + c_begin * hw + vfi % hw;
+      T *dst_f = dst + vfi * n_pad * c0;
+      for (size_t ni = 0; ni < n_pad; ++ni) {
+        T *dst_row = dst_f + ni * c0;
+        size_t copy_num = ni < n ? c_num : 0;
+        const T *src_row = src_f + ni * chw;
+        for (size_t ci = 0; ci < copy_num; ++ci) {
+          dst_row[ci] = src_row[ci * hw];
+        }
+        std::fill(dst_row + copy_num, dst_row + c0, T(0));
+      }
+    }
+  });
+}
+
+template <typename T>
+void FracZToNchwKernel(const T *src, T *dst, size_t n, size_t c, size_t hw, size_t n_pad, size_t c0) {
+  size_t nc0 = n_pad * c0;
+  ParallelFor(n * c, hw, [=](size_t begin, size_t end) {
+    for (size_t nci = begin; nci < end; ++nci) {
+      size_t ni = nci / c;
+      size_t ci = nci % c;
+      const T *src_c = src + ci / c0 * hw * nc0 + ni * c0 + ci % c0;
+      T *dst_c = dst + nci * hw;
+      for (size_t hwi = 0; hwi < hw; ++hwi) {
+        dst_c[hwi] = src_c[hwi * nc0];
+      }
+    }
+  });
+}
+
+// the fractal nz is (times, w1, h1 * h0, w0), each row of the (times, h, w) is copied by the w0 elements
+template <typename T>
+void FracNzKernel(const T *src, T *dst, size_t times, size_t h, size_t w, size_t w1, size_t h1h0w0, size_t w0,
+                  bool to_nz) {
+  ParallelFor(times * h, w, [=](size_t begin, size_t end) {
+    for (size_t row = begin; row < end; ++row) {
+      size_t nz_head = row / h * w1 * h1h0w0 + row % h * w0;
+      size_t nd_head = row * w;
+      for (size_t w1_idx = 0; w1_idx * w0 < w; ++w1_idx) {
+        size_t copy_num = std::min(w0, w - w1_idx * w0);
+        size_t nz_offset = nz_head + w1_idx * h1h0w0;
+        size_t nd_offset = nd_head + w1_idx * w0;
+        if (to_nz) {
+          (void)std::copy_n(src + nd_offset, copy_num, dst + nz_offset);
+        } else {
+          (void)std::copy_n(src + nz_offset, copy_num, dst + nd_offset);
+        }
+      }
+    }
+  });
+}
+
+// the padded channels of the nc1hwc0 are zeros
+template <typename T>
+void NchwToNc1hwc0Kernel(const T *src, T *dst, size_t n, size_t c, size_t hw, size_t c0) {
+  size_t c1 = Ceil(c, c0);
+  ParallelFor(n * c1, hw * c0, [=](size_t begin, size_t end) {
+    for (size_t nc1i = begin; nc1i < end; ++nc1i) {
+      size_t c_begin = nc1i % c1 * c0;
+      size_t c_num = std::min(c0, c - c_begin);
+      const T *src_c = src + (nc1i / c1 * c + c_begin) * hw;
+      T *dst_c = dst + nc1i * hw * c0;
+      for (size_t hwi = 0; hwi < hw; ++hwi) {
+        T *dst_hw = dst_c + hwi * c0;
+        for (size_t ci = 0; ci < c_num; ++ci) {
+          dst_hw[ci] = src_c[ci * hw + hwi];
+        }
+        std::fill(dst_hw + c_num, dst_hw + c0, T(0));
+      }
+    }
+  });
+}
+
+template <typename T>
+void Nc1hwc0ToNchwKernel(const T *src, T *dst, size_t n, size_t c, size_t hw, size_t c1, size_t c0) {
+  ParallelFor(n * c, hw, [=](size_t begin, size_t end) {
+    for (size_t nci = begin; nci < end; ++nci) {
+      size_t ci = nci % c;
+      const T *src_c = src + (nci / c * c1 + ci / c0) * hw * c0 + ci % c0;
+      T *dst_c = dst + nci * hw;
+      for (size_t hwi = 0; hwi < hw; ++hwi) {
+        dst_c[hwi] = src_c[hwi * c0];
+      }
+    }
+  });
+}
+}  // namespace
+
 template <typename SrcT, typename DstT>
 void TransDataSrc2Dst(const TypeIdArgs &args, void *dst, const size_t data_size) {
-  for (size_t idx = 0; idx != data_size; idx++) {
-    SrcT src_data = static_cast<const SrcT *>(args.data)[idx];
-    static_cast<DstT *>(dst)[idx] = static_cast<DstT>(src_data);
-  }
+  auto src_data = static_cast<const SrcT *>(args.data);
+  auto dst_data = static_cast<DstT *>(dst);
+  ParallelFor(data_size, 1, [src_data, dst_data](size_t begin, size_t end) {
+    for (size_t idx = begin; idx < end; idx++) {
+      dst_data[idx] = static_cast<DstT>(src_data[idx]);
+    }
+  });
 }
 
 bool CastKernel(const TypeIdArgs &args, void *dst, const size_t data_size, const DataTypeTransMode mode) {
   switch (mode) {
     case FROM_FLOAT_TO_FLOAT16:
-      device::FloatToHalf(dst, args.data, data_size);
+      ParallelFor(data_size, 1, [&args, dst](size_t begin, size_t end) {
+        device::FloatToHalf(static_cast<uint16_t *>(dst) + begin, static_cast<const float *>(args.data) + begin,
+                            end - begin);
+      });
       break;
     case FROM_FLOAT16_TO_FLOAT:
-      device::HalfToFloat(dst, args.data, data_size);
+      ParallelFor(data_size, 1, [&args, dst](size_t begin, size_t end) {
+        device::HalfToFloat(static_cast<float *>(dst) + begin, static_cast<const uint16_t *>(args.data) + begin,
+                            end - begin);
+      });
       break;
     case FROM_FLOAT_TO_INT32:
       TransDataSrc2Dst<float, int32_t>(args, dst, data_size);
@@ -311,10 +464,6 @@ bool NchwToFracZ(const FormatArgs &args, void *result) {
   }
   size_t c1 = Ceil(c, c0);
   size_t hw = h * w;
-  size_t chw = c * hw;
-  size_t hwc0 = hw * c0;
-  size_t nchw = n * chw;
-
   size_t hf_cnt = Ceil(n, kCubeSize);
   size_t vf_cnt = c1 * hw;
   size_t fractal_ele_cnt = c0 * kCubeSize;
@@ -326,41 +475,10 @@ bool NchwToFracZ(const FormatArgs &args, void *result) {
                   << "dst size is :" << dst_size << "device size is :" << args.device_size;
     return false;
   }
-  for (size_t vfi = 0; vfi < vf_cnt; vfi++) {
-    auto vf_base_i = vfi * hf_cnt;  // vertical fractal matrix base index
-    for (size_t hfi = 0; hfi < hf_cnt; hfi++) {
-      auto gfi = vf_base_i + hfi;  // global fractal matrix index
-      auto src_n_offset = hfi * chw * kCubeSize;
-      auto src_f_offset = src_n_offset + vfi % hw + vfi / hw * hwc0;
-      for (size_t row = 0; row < c0; row++) {
-        auto src_ci = vfi / hw * c0 + row;
-        auto src_row_offset = src_f_offset + row * hw;
-        for (size_t col = 0; col < kCubeSize; col++) {
-          auto src_ni = hfi * kCubeSize + col;
-          auto src_offset = src_row_offset + chw * col;
-
-          auto need_pad_zero = src_ni >= n || src_offset >= nchw || src_ci >= c;
-          auto idx = gfi * fractal_ele_cnt + col * c0 + row;
-          auto offset = idx * size;
-          auto protected_size = dst_size - offset < static_cast<size_t>(SECUREC_MEM_MAX_LEN)
-                                  ? dst_size - offset
-                                  : static_cast<size_t>(SECUREC_MEM_MAX_LEN);
-          errno_t ret;
-          if (need_pad_zero) {
-            ret = memset_s(static_cast<uint8_t *>(result) + offset, protected_size, 0, size);
-          } else {
-            ret = memcpy_s(static_cast<uint8_t *>(result) + offset, protected_size,
-                           static_cast<uint8_t const *>(args.data) + src_offset * size, size);
-          }
-          if (ret != 0) {
-            MS_LOG(ERROR) << "Failed to operate the dst memory error-code " << ret;
-            return false;
-          }
-        }
-      }
-    }
-  }
-  return true;
+  return RunByElemSize(size, [&args, result, n, c, hw, c0](auto type) {
+    using T = decltype(type);
+    NchwToFracZKernel(static_cast<const T *>(args.data), static_cast<T *>(result), n, c, hw, c0);
+  });
 }
 
 bool FracZToNchw(const FormatArgs &args, void *result) {
@@ -391,40 +509,11 @@ bool FracZToNchw(const FormatArgs &args, void *result) {
   auto w = args.host_shape[3];
 
   size_t nc = ni * n0;
-  size_t ncc0 = nc * c0;
-  size_t wncc0 = w * ncc0;
-  size_t hwncc0 = h * wncc0;
   size_t hw = h * w;
-  size_t chw = c * hw;
-
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * chw;
-    for (size_t c_idx = 0; c_idx < c; c_idx++) {
-      size_t c_head_addr = n_head_addr + c_idx * hw;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c_head_addr + h_idx * w;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t dst_idx = h_head_addr + w_idx;
-          size_t c1_idx = c_idx / c0;
-          size_t c0_idx = c_idx % c0;
-          size_t nc_idx = n_idx;
-          size_t src_idx = c1_idx * hwncc0 + h_idx * wncc0 + w_idx * ncc0 + nc_idx * c0 + c0_idx;
-          auto src_offset = src_idx * size;
-          auto dst_offset = dst_idx * size;
-          auto protected_size = total_size - dst_offset < static_cast<size_t>(SECUREC_MEM_MAX_LEN)
-                                  ? total_size - dst_offset
-                                  : static_cast<size_t>(SECUREC_MEM_MAX_LEN);
-          auto ret = memcpy_s(static_cast<uint8_t *>(result) + dst_offset, protected_size,
-                              static_cast<uint8_t const *>(args.data) + src_offset, size);
-          if (ret != EOK) {
-            MS_LOG(ERROR) << "Failed to operate the dst memory error-code " << ret;
-            return false;
-          }
-        }
-      }
-    }
-  }
-  return true;
+  return RunByElemSize(size, [&args, result, n, c, hw, nc, c0](auto type) {
+    using T = decltype(type);
+    FracZToNchwKernel(static_cast<const T *>(args.data), static_cast<T *>(result), n, c, hw, nc, c0);
+  });
 }
 
 bool TransShapeToNz(const std::vector<size_t> &host_shape, std::vector<size_t> *hw_shape) {
@@ -482,7 +571,6 @@ bool NchwToFracNz(const FormatArgs &args, void *result) {
   auto times = hw_shape.at(0);
   auto h = hw_shape.at(1);
   auto w = hw_shape.at(2);
-  auto hw = h * w;
 
   auto shape_size = args.device_shape.size();
   auto w1 = args.device_shape[shape_size - 4];
@@ -490,46 +578,10 @@ bool NchwToFracNz(const FormatArgs &args, void *result) {
   auto h0 = args.device_shape[shape_size - 2];
   auto w0 = args.device_shape[shape_size - 1];
   auto h1h0w0 = h1 * h0 * w0;
-  auto w1h1h0w0 = w1 * h1h0w0;
-  auto num_w1 = w / w0;
-
-  for (size_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * w1h1h0w0;
-    auto src_times_head = times_idx * hw;
-    for (size_t h1h0_idx = 0; h1h0_idx < h; h1h0_idx++) {
-      auto h1h0_head = times_head + h1h0_idx * w0;
-      auto src_h_head = src_times_head + h1h0_idx * w;
-      for (size_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-        size_t dst_offset = (h1h0_head + w1_idx * h1h0w0) * size;
-        size_t src_offset = (src_h_head + w1_idx * w0) * size;
-        auto protected_size = dst_size - dst_offset < static_cast<size_t>(SECUREC_MEM_MAX_LEN)
-                                ? dst_size - dst_offset
-                                : static_cast<size_t>(SECUREC_MEM_MAX_LEN);
-        auto cp_ret = memcpy_s(static_cast<uint8_t *>(result) + dst_offset, protected_size,
-                               static_cast<uint8_t const *>(args.data) + src_offset, size * w0);
-        if (cp_ret != EOK) {
-          MS_LOG(ERROR) << "Failed to operate the dst memory, error-code " << cp_ret;
-          return false;
-        }
-      }
-      auto w1_head = num_w1 * w0;
-      for (size_t w0_idx = 0; w1_head + w0_idx < w; w0_idx++) {
-        auto src_w_idx = w1_head + w0_idx;
-        size_t dst_offset = (h1h0_head + num_w1 * h1h0w0 + w0_idx) * size;
-        size_t src_offset = (src_h_head + src_w_idx) * size;
-        auto protected_size = dst_size - dst_offset < static_cast<size_t>(SECUREC_MEM_MAX_LEN)
-                                ? dst_size - dst_offset
-                                : static_cast<size_t>(SECUREC_MEM_MAX_LEN);
-        auto cp_ret = memcpy_s(static_cast<uint8_t *>(result) + dst_offset, protected_size,
-                               static_cast<uint8_t const *>(args.data) + src_offset, size);
-        if (cp_ret != EOK) {
-          MS_LOG(ERROR) << "Failed to operate the dst memory error-code " << cp_ret;
-          return false;
-        }
-      }
-    }
-  }
-  return true;
+  return RunByElemSize(size, [&args, result, times, h, w, w1, h1h0w0, w0](auto type) {
+    using T = decltype(type);
+    FracNzKernel(static_cast<const T *>(args.data), static_cast<T *>(result), times, h, w, w1, h1h0w0, w0, true);
+  });
 }
 
 bool FracNzToNchw(const FormatArgs &args, void *result) {
@@ -558,7 +610,6 @@ bool FracNzToNchw(const FormatArgs &args, void *result) {
   auto times = hw_shape.at(0);
   auto h = hw_shape.at(1);
   auto w = hw_shape.at(2);
-  auto hw = h * w;
 
   auto shape_size = args.device_shape.size();
   auto w1 = args.device_shape[shape_size - 4];
@@ -566,46 +617,10 @@ bool FracNzToNchw(const FormatArgs &args, void *result) {
   auto h0 = args.device_shape[shape_size - 2];
   auto w0 = args.device_shape[shape_size - 1];
   auto h1h0w0 = h1 * h0 * w0;
-  auto w1h1h0w0 = w1 * h1h0w0;
-  auto num_w1 = w / w0;
-
-  for (size_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * w1h1h0w0;
-    auto src_times_head = times_idx * hw;
-    for (size_t h1h0_idx = 0; h1h0_idx < h; h1h0_idx++) {
-      auto h1h0_head = times_head + h1h0_idx * w0;
-      auto src_h_head = src_times_head + h1h0_idx * w;
-      for (size_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-        size_t src_offset = (h1h0_head + w1_idx * h1h0w0) * size;
-        size_t dst_offset = (src_h_head + w1_idx * w0) * size;
-        auto protected_size = dst_size - dst_offset < static_cast<size_t>(SECUREC_MEM_MAX_LEN)
-                                ? dst_size - dst_offset
-                                : static_cast<size_t>(SECUREC_MEM_MAX_LEN);
-        auto cp_ret = memcpy_s(static_cast<uint8_t *>(result) + dst_offset, protected_size,
-                               static_cast<uint8_t const *>(args.data) + src_offset, size * w0);
-        if (cp_ret != EOK) {
-          MS_LOG(ERROR) << "Failed to operate the dst memory, error-code " << cp_ret;
-          return false;
-        }
-      }
-      auto w1_head = num_w1 * w0;
-      for (size_t w0_idx = 0; w1_head + w0_idx < w; w0_idx++) {
-        auto src_w_idx = w1_head + w0_idx;
-        size_t src_offset = (h1h0_head + num_w1 * h1h0w0 + w0_idx) * size;
-        size_t dst_offset = (src_h_head + src_w_idx) * size;
-        auto protected_size = dst_size - dst_offset < static_cast<size_t>(SECUREC_MEM_MAX_LEN)
-                                ? dst_size - dst_offset
-                                : static_cast<size_t>(SECUREC_MEM_MAX_LEN);
-        auto cp_ret = memcpy_s(static_cast<uint8_t *>(result) + dst_offset, protected_size,
-                               static_cast<uint8_t const *>(args.data) + src_offset, size);
-        if (cp_ret != EOK) {
-          MS_LOG(ERROR) << "Failed to operate the dst memory error-code " << cp_ret;
-          return false;
-        }
-      }
-    }
-  }
-  return true;
+  return RunByElemSize(size, [&args, result, times, h, w, w1, h1h0w0, w0](auto type) {
+    using T = decltype(type);
+    FracNzKernel(static_cast<const T *>(args.data), static_cast<T *>(result), times, h, w, w1, h1h0w0, w0, false);
+  });
 }
 
 bool NchwToNc1hwc0(const FormatArgs &args, void *result) {
@@ -635,50 +650,15 @@ bool NchwToNc1hwc0(const FormatArgs &args, void *result) {
     MS_LOG(ERROR) << "illegal dtype.";
     return false;
   }
-  size_t c1 = Ceil(c, c0);
   size_t hw = h * w;
-  size_t chw = c * hw;
-  size_t c1hwc0 = c1 * hw * c0;
-  size_t wc0 = w * c0;
-
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * c1hwc0;
-    for (size_t c1_idx = 0; c1_idx < c1; c1_idx++) {
-      size_t c1_head_addr = n_head_addr + c1_idx * hw * c0;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c1_head_addr + h_idx * wc0;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t w_head_addr = h_head_addr + w_idx * c0;
-          for (size_t c0_idx = 0; c0_idx < c0; c0_idx++) {
-            size_t dst_index = c0_idx + w_head_addr;
-            size_t dst_offset = dst_index * size;
-            auto protected_size = total_size - dst_offset < static_cast<size_t>(SECUREC_MEM_MAX_LEN)
-                                    ? total_size - dst_offset
-                                    : static_cast<size_t>(SECUREC_MEM_MAX_LEN);
-            size_t c_idx = c0_idx + c1_idx * c0;
-            size_t src_idx = n_idx * chw + c_idx * hw + h_idx * w + w_idx;
-            auto src_offset = src_idx * size;
-
-            if (c_idx < c) {
-              auto ret = memcpy_s(static_cast<uint8_t *>(result) + dst_offset, protected_size,
-                                  static_cast<uint8_t const *>(args.data) + src_offset, size);
-              if (ret != EOK) {
-                MS_LOG(ERROR) << "Failed to operate the dst memory error-code " << ret;
-                return false;
-              }
-            } else {
-              auto ret = memset_s(static_cast<uint8_t *>(result) + dst_offset, protected_size, 0, size);
-              if (ret != EOK) {
-                MS_LOG(ERROR) << "Failed to operate the dst memory error-code " << ret;
-                return false;
-              }
-            }
-          }
-        }
-      }
-    }
+  if (n * Ceil(c, c0) * hw * c0 * size != total_size) {
+    MS_LOG(ERROR) << "illegal device shape, the c0 of the device shape should be " << c0;
+    return false;
   }
-  return true;
+  return RunByElemSize(size, [&args, result, n, c, hw, c0](auto type) {
+    using T = decltype(type);
+    NchwToNc1hwc0Kernel(static_cast<const T *>(args.data), static_cast<T *>(result), n, c, hw, c0);
+  });
 }
 
 bool Nc1hwc0ToNchw(const FormatArgs &args, void *result) {
@@ -707,38 +687,10 @@ bool Nc1hwc0ToNchw(const FormatArgs &args, void *result) {
   auto c0 = args.device_shape[4];
 
   size_t hw = h * w;
-  size_t chw = c * hw;
-  size_t wc0 = w * c0;
-  size_t hwc0 = h * wc0;
-  size_t c1hwc0 = c1 * hwc0;
-
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * chw;
-    for (size_t c_idx = 0; c_idx < c; c_idx++) {
-      size_t c_head_addr = n_head_addr + c_idx * hw;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c_head_addr + h_idx * w;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t dst_idx = h_head_addr + w_idx;
-          size_t c1_idx = c_idx / c0;
-          size_t c0_idx = c_idx % c0;
-          size_t src_idx = n_idx * c1hwc0 + c1_idx * hwc0 + h_idx * wc0 + w_idx * c0 + c0_idx;
-          auto src_offset = src_idx * size;
-          auto dst_offset = dst_idx * size;
-          auto protected_size = total_size - dst_offset < static_cast<size_t>(SECUREC_MEM_MAX_LEN)
-                                  ? total_size - dst_offset
-                                  : static_cast<size_t>(SECUREC_MEM_MAX_LEN);
-          auto ret = memcpy_s(static_cast<uint8_t *>(result) + dst_offset, protected_size,
-                              static_cast<uint8_t const *>(args.data) + src_offset, size);
-          if (ret != EOK) {
-            MS_LOG(ERROR) << "Failed to operate the dst memory error-code " << ret;
-            return false;
-          }
-        }
-      }
-    }
-  }
-  return true;
+  return RunByElemSize(size, [&args, result, n, c, hw, c1, c0](auto type) {
+    using T = decltype(type);
+    Nc1hwc0ToNchwKernel(static_cast<const T *>(args.data), static_cast<T *>(result), n, c, hw, c1, c0);
+  });
 }
 }  // namespace trans
 }  // namespace mindspore
@@ -24,8 +24,11 @@
 #include "dataset/engine/datasetops/source/mnist_op.h"
 #include "dataset/engine/datasetops/source/voc_op.h"
 #include "dataset/util/make_unique.h"
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
 #include "dataset/core/tensor.h"
 #include "dataset/engine/dataset_iterator.h"
+#include "dataset/engine/execution_tree.h"
 #include "dataset/engine/datasetops/source/manifest_op.h"
 #include "dataset/engine/datasetops/source/cifar_op.h"
 #include "dataset/engine/datasetops/source/celeba_op.h"
@@ -51,6 +54,7 @@ static std::unordered_map<uint32_t, pFunction> g_parse_op_func_ = {{kStorage, &D
 #endif
                                                                    {kMap, &DEPipeline::ParseMapOp},
                                                                    {kBatch, &DEPipeline::ParseBatchOp},
+                                                                   {kCache, &DEPipeline::ParseCacheOp},
                                                                    {kRepeat, &DEPipeline::ParseRepeatOp},
                                                                    {kZip, &DEPipeline::ParseZipOp},
                                                                    {kRename, &DEPipeline::ParseRenameOp},
@@ -121,13 +125,51 @@ Status DEPipeline::AssignRootNode(const DsOpPtr &dataset_op) { return (tree_->As
 
 // Function to launch the tree execution.
 Status DEPipeline::LaunchTreeExec() {
+  int32_t profiling_interval = GlobalContext::config_manager()->profiling_interval();
+  if (profiling_interval > 0) {
+    RETURN_IF_NOT_OK(tree_->EnableProfiling(profiling_interval));
+  }
+  if (GlobalContext::config_manager()->auto_tune()) {
+    RETURN_IF_NOT_OK(tree_->EnableAutoTune(GlobalContext::config_manager()->auto_tune_interval()));
+  }
+  std::string cpu_placement = GlobalContext::config_manager()->cpu_placement();
+  std::string reserved_cpus = GlobalContext::config_manager()->reserved_cpus();
+  if (cpu_placement != "none" || !reserved_cpus.empty()) {
+    RETURN_IF_NOT_OK(tree_->SetCpuPlacement(cpu_placement, reserved_cpus));
+  }
   RETURN_IF_NOT_OK(tree_->Prepare());
+  int64_t rows_fetched = 0;
+  if (!resume_state_.empty()) {
+    RETURN_IF_NOT_OK(tree_->LoadState(resume_state_, &rows_fetched));
+  }
   RETURN_IF_NOT_OK(tree_->Launch());
   iterator_ = make_unique<DatasetIterator>(tree_);
   if (iterator_ == nullptr) RETURN_STATUS_UNEXPECTED("Cannot create an Iterator.");
+  iterator_->set_rows_fetched(rows_fetched);
   return Status::OK();
 }
 
+Status DEPipeline::SaveState(std::string *state) const {
+  if (iterator_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED("The state can only be saved after the tree is launched.");
+  }
+  return tree_->SaveState(iterator_->rows_fetched(), state);
+}
+
+Status DEPipeline::DumpProfile(const std::string &path) {
+  if (tree_->profiler() == nullptr) {
+    RETURN_STATUS_UNEXPECTED("The pipeline profiling is off. Set a profiling interval before iterating.");
+  }
+  return tree_->profiler()->DumpJson(path);
+}
+
+Status DEPipeline::DumpChromeTrace(const std::string &path) {
+  if (tree_->profiler() == nullptr) {
+    RETURN_STATUS_UNEXPECTED("The pipeline profiling is off. Set a profiling interval before iterating.");
+  }
+  return tree_->profiler()->DumpChromeTrace(path);
+}
+
 void DEPipeline::PrintTree() {
   for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
     std::stringstream ss;
@@ -144,9 +186,11 @@ Status DEPipeline::GetNextAsMap(py::dict *output) {
     s = iterator_->GetNextAsMap(&row);
   }
   RETURN_IF_NOT_OK(s);
-  // Generate Python dict as return
+  // Generate Python dict as return, the arrays wrap the data of the tensors
   for (auto el : row) {
-    (*output)[common::SafeCStr(el.first)] = el.second;
+    py::array data;
+    RETURN_IF_NOT_OK(Tensor::ShareDataAsNumpy(el.second, &data));
+    (*output)[common::SafeCStr(el.first)] = data;
   }
   return Status::OK();
 }
@@ -159,9 +203,31 @@ Status DEPipeline::GetNextAsList(py::list *output) {
     s = iterator_->FetchNextTensorRow(&row);
   }
   RETURN_IF_NOT_OK(s);
-  // Generate Python list as return
+  // Generate Python list as return, the arrays wrap the data of the tensors
+  for (auto el : row) {
+    py::array data;
+    RETURN_IF_NOT_OK(Tensor::ShareDataAsNumpy(el, &data));
+    output->append(data);
+  }
+  return Status::OK();
+}
+
+Status DEPipeline::GetRow(const DsOpPtr &op, int64_t row_id, py::list *output) {
+  auto random_access_op = std::dynamic_pointer_cast<RandomAccessOp>(op);
+  if (random_access_op == nullptr) {
+    RETURN_STATUS_UNEXPECTED("The operator does not support random access.");
+  }
+  TensorRow row;
+  Status s;
+  {
+    py::gil_scoped_release gil_release;
+    s = random_access_op->GetRow(row_id, &row);
+  }
+  RETURN_IF_NOT_OK(s);
   for (auto el : row) {
-    output->append(el);
+    py::array data;
+    RETURN_IF_NOT_OK(Tensor::ShareDataAsNumpy(el, &data));
+    output->append(data);
   }
   return Status::OK();
 }
@@ -266,6 +332,24 @@ std::vector<DataType> ToTypeVector(const py::handle handle) {
   return vector;
 }
 
+// The shape of a column to pad is a list with -1 for its unknown dims, or None to pad all the dims
+PadInfo ToPadInfo(const py::handle handle) {
+  py::dict dict = py::reinterpret_borrow<py::dict>(handle);
+  PadInfo pad_info;
+  for (auto p : dict) {
+    py::tuple pad = py::reinterpret_borrow<py::tuple>(p.second);
+    py::object pad_shape = pad[size_t(0)];
+    py::object pad_value = pad[size_t(1)];
+    TensorShape shape = TensorShape::CreateUnknownRankShape();
+    if (!pad_shape.is_none()) {
+      std::vector<int> dims = ToIntVector(pad_shape);
+      shape = TensorShape(std::vector<dsize_t>(dims.begin(), dims.end()));
+    }
+    (void)pad_info.emplace(ToString(p.first), std::make_pair(shape, pad_value.cast<float>()));
+  }
+  return pad_info;
+}
+
 Status DEPipeline::SetBatchParameters(const py::dict &args) {
   if (args["batch_size"].is_none()) {
     std::string err_msg = "Error: batchSize is invalid or not set.";
@@ -358,6 +442,9 @@ Status DEPipeline::ParseShuffleOp(const py::dict &args, std::shared_ptr<DatasetO
     std::string err_msg = "Error: Shuffle buffer size is missing";
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
+  if (args.contains("buffer_memory_mb") && !args["buffer_memory_mb"].is_none()) {
+    (void)builder->SetShuffleMemoryMb(ToInt(args["buffer_memory_mb"]));
+  }
   std::shared_ptr<ShuffleOp> op;
   RETURN_IF_NOT_OK(builder->Build(&op));
   *ptr = op;
@@ -425,9 +512,14 @@ Status DEPipeline::ParseMindRecordOp(const py::dict &args, std::shared_ptr<Datas
         (void)builder->SetNumMindRecordWorkers(ToInt(value));
       } else if (key == "block_reader" && ToBool(value) == true) {
         (void)builder->SetBlockReader();
+      } else if (key == "mmap_mode" && ToBool(value) == true) {
+        (void)builder->SetMmapMode();
+      } else if (key == "prefetch_depth") {
+        (void)builder->SetPrefetchDepth(ToInt(value));
       } else if (key == "global_shuffle" && ToBool(value) == true) {
         uint32_t seed = args["partitions"].is_none() ? GetSeed() : 0;
-        operators.push_back(std::make_shared<mindrecord::ShardShuffle>(seed));
+        uint32_t shuffle_window = args["shuffle_window"].is_none() ? 0 : ToInt(args["shuffle_window"]);
+        operators.push_back(std::make_shared<mindrecord::ShardShuffle>(seed, shuffle_window));
       }
     }
   }
@@ -457,6 +549,8 @@ Status DEPipeline::ParseMapOp(const py::dict &args, std::shared_ptr<DatasetOp> *
   std::vector<std::shared_ptr<TensorOp>> tensor_op_list;
 
   if (args["operations"].is_none()) RETURN_STATUS_UNEXPECTED("Error: 'operations' is not set. \n");
+  // The Python functions of the operations take all the rows of a buffer at once
+  bool batched_pyfunc = args.contains("batched_pyfunc") && ToBool(args["batched_pyfunc"]);
 
   for (auto arg : args) {
     std::string key = py::str(arg.first);
@@ -471,6 +565,12 @@ Status DEPipeline::ParseMapOp(const py::dict &args, std::shared_ptr<DatasetOp> *
         (void)builder->SetNumWorkers(ToInt(value));
       } else if (key == "prefetch_size") {
         (void)builder->SetOpConnectorSize(ToInt(value));
+      } else if (key == "preserve_order") {
+        (void)builder->SetPreserveOrder(ToBool(value));
+      } else if (key == "batch_mode") {
+        (void)builder->SetBatchMode(ToBool(value));
+      } else if (key == "batched_pyfunc") {
+        // Already read, it applies to the operations
       } else if (key == "operations") {
         py::handle tensor_ops = args["operations"];
         // operation can be a list of TensorOps or a single TensorOp.
@@ -480,7 +580,7 @@ Status DEPipeline::ParseMapOp(const py::dict &args, std::shared_ptr<DatasetOp> *
             if (py::isinstance<TensorOp>(op)) {
               tensor_op = op.cast<std::shared_ptr<TensorOp>>();
             } else if (py::isinstance<py::function>(op)) {
-              tensor_op = std::make_shared<PyFuncOp>(op.cast<py::function>());
+              tensor_op = std::make_shared<PyFuncOp>(op.cast<py::function>(), batched_pyfunc);
             } else {
               RETURN_STATUS_UNEXPECTED("Error: tensor_op is not recognised (not TensorOp and not pyfunc).");
             }
@@ -501,6 +601,25 @@ Status DEPipeline::ParseMapOp(const py::dict &args, std::shared_ptr<DatasetOp> *
   return Status::OK();
 }
 
+Status DEPipeline::ParseCacheOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr) {
+  if (args["memory_mb"].is_none()) {
+    std::string err_msg = "Error: memory_mb is invalid or not set.";
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  std::shared_ptr<CacheOp::Builder> builder = std::make_shared<CacheOp::Builder>();
+  (void)builder->SetMemoryMb(ToInt(args["memory_mb"]));
+  if (!args["spill_dir"].is_none()) {
+    (void)builder->SetSpillDir(ToString(args["spill_dir"]));
+  }
+  if (args.contains("session_name") && !args["session_name"].is_none()) {
+    (void)builder->SetSessionName(ToString(args["session_name"]));
+  }
+  std::shared_ptr<CacheOp> op;
+  RETURN_IF_NOT_OK(builder->Build(&op));
+  *ptr = op;
+  return Status::OK();
+}
+
 Status DEPipeline::ParseRepeatOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr) {
   if (args["count"].is_none()) {
     std::string err_msg = "Error: count is invalid or not set.";
@@ -569,8 +688,20 @@ Status DEPipeline::ParseBatchOp(const py::dict &args, std::shared_ptr<DatasetOp>
       if (key == "input_columns") {
         (void)builder->SetColumnsToMap(ToStringVector(value));
       }
+      if (key == "in_place") {
+        (void)builder->SetInPlace(ToBool(value));
+      }
+      if (key == "pad_info") {
+        (void)builder->SetPadInfo(ToPadInfo(value));
+      }
     }
   }
+  if (args.contains("bucket_boundaries") && !args["bucket_boundaries"].is_none()) {
+    std::vector<int> boundaries = ToIntVector(args["bucket_boundaries"]);
+    std::vector<int> batch_sizes = ToIntVector(args["bucket_batch_sizes"]);
+    (void)builder->SetBucketing(ToString(args["length_column"]), boundaries, batch_sizes,
+                                ToBool(args["pad_to_bucket_boundary"]));
+  }
 
   std::shared_ptr<BatchOp> op;
   RETURN_IF_NOT_OK(builder->Build(&op));
@@ -685,6 +816,10 @@ Status DEPipeline::ParseTFReaderOp(const py::dict &args, std::shared_ptr<Dataset
         (void)builder->SetDeviceId(ToInt(value));
       } else if (key == "shard_equal_rows") {
         (void)builder->SetShardEqualRows(ToBool(value));
+      } else if (key == "num_readahead_chunks") {
+        (void)builder->SetReadaheadChunks(ToInt(value));
+      } else if (key == "write_index_files") {
+        (void)builder->SetWriteIndexFiles(ToBool(value));
       }
     }
   }
@@ -744,6 +879,8 @@ Status DEPipeline::ParseImageFolderOp(const py::dict &args, std::shared_ptr<Data
         (void)builder->SetClassIndex(ToStringMap(value));
       } else if (key == "decode") {
         (void)builder->SetDecode(ToBool(value));
+      } else if (key == "index_file") {
+        (void)builder->SetIndexFile(ToString(value));
       }
     }
   }
@@ -81,18 +81,38 @@ class DEPipeline {
   // Function to launch the tree execution.
   Status LaunchTreeExec();
 
-  // Get a row of data as dictionary of column name to the value.
+  // Saves the position of the iterator in the running tree.
+  // @param state - The serialized state of the tree
+  Status SaveState(std::string *state) const;
+
+  // Sets the state the tree resumes from, must be called before the tree is launched.
+  // @param state - A state saved by SaveState from the same pipeline
+  void SetResumeState(const std::string &state) { resume_state_ = state; }
+
+  // Get a row of data as dictionary of column name to the value, the numpy arrays share the data of the tensors.
   Status GetNextAsMap(py::dict *output);
 
-  // Get a row of data as list.
+  // Get a row of data as list of numpy arrays sharing the data of the tensors.
   Status GetNextAsList(py::list *output);
 
+  // Get a row of a source op by its id as list, without launching the tree.
+  // @param op - a source op which supports random access
+  // @param row_id - the id of the row in the dataset
+  Status GetRow(const DsOpPtr &op, int64_t row_id, py::list *output);
+
   Status GetOutputShapes(py::list *output);
 
   Status GetOutputTypes(py::list *output);
 
   int GetDatasetSize() const;
 
+  // Write the per operator profile of the running tree as json.
+  // @note The profiling must be turned on by the ConfigManager before the tree is launched.
+  Status DumpProfile(const std::string &path);
+
+  // Write the samples of the pipeline profiler in the chrome trace event format.
+  Status DumpChromeTrace(const std::string &path);
+
   int GetBatchSize() const;
 
   int GetRepeatCount() const;
@@ -109,6 +129,8 @@ class DEPipeline {
 
   Status ParseMapOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr);
 
+  Status ParseCacheOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr);
+
   Status ParseRepeatOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr);
 
   Status ParseBatchOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr);
@@ -155,6 +177,9 @@ class DEPipeline {
 
   std::unique_ptr<DatasetIterator> iterator_;
 
+  // The state to load when the tree is launched, empty to start from the beginning.
+  std::string resume_state_;
+
   // Validate required args passed to storage op.
   Status ValidateArgStorageOp(const py::dict &args);
 
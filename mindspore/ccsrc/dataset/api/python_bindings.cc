@@ -23,6 +23,7 @@
 #include "dataset/kernels/image/cut_out_op.h"
 #include "dataset/kernels/image/decode_op.h"
 #include "dataset/kernels/image/distort_bounding_box_crop_op.h"
+#include "dataset/kernels/image/fused_normalize_op.h"
 #include "dataset/kernels/image/hwc_to_chw_op.h"
 #include "dataset/kernels/image/image_utils.h"
 #include "dataset/kernels/image/normalize_op.h"
@@ -39,6 +40,12 @@
 #include "dataset/kernels/image/resize_bilinear_op.h"
 #include "dataset/kernels/image/resize_op.h"
 #include "dataset/kernels/data/type_cast_op.h"
+#include "dataset/kernels/text/pad_mask_op.h"
+#include "dataset/kernels/text/sliding_window_op.h"
+#include "dataset/kernels/text/truncate_pad_op.h"
+#include "dataset/kernels/text/vocab.h"
+#include "dataset/kernels/text/whitespace_tokenizer_op.h"
+#include "dataset/kernels/text/wordpiece_tokenizer_op.h"
 #include "dataset/engine/datasetops/source/cifar_op.h"
 #include "dataset/engine/datasetops/source/image_folder_op.h"
 #include "dataset/engine/datasetops/source/io_block.h"
@@ -90,6 +97,13 @@ void bindDEPipeline(py::module *m) {
     .def("SetBatchParameters",
          [](DEPipeline &de, const py::dict &args) { THROW_IF_ERROR(de.SetBatchParameters(args)); })
     .def("LaunchTreeExec", [](DEPipeline &de) { THROW_IF_ERROR(de.LaunchTreeExec()); })
+    .def("SetResumeState", &DEPipeline::SetResumeState)
+    .def("SaveState",
+         [](DEPipeline &de) {
+           std::string state;
+           THROW_IF_ERROR(de.SaveState(&state));
+           return state;
+         })
     .def("GetNextAsMap",
          [](DEPipeline &de) {
            py::dict out;
@@ -102,6 +116,12 @@ void bindDEPipeline(py::module *m) {
            THROW_IF_ERROR(de.GetNextAsList(&out));
            return out;
          })
+    .def("GetRow",
+         [](DEPipeline &de, const DsOpPtr &op, int64_t row_id) {
+           py::list out;
+           THROW_IF_ERROR(de.GetRow(op, row_id, &out));
+           return out;
+         })
     .def("GetOutputShapes",
          [](DEPipeline &de) {
            py::list out;
@@ -117,7 +137,10 @@ void bindDEPipeline(py::module *m) {
     .def("GetDatasetSize", &DEPipeline::GetDatasetSize)
     .def("GetBatchSize", &DEPipeline::GetBatchSize)
     .def("GetNumClasses", &DEPipeline::GetNumClasses)
-    .def("GetRepeatCount", &DEPipeline::GetRepeatCount);
+    .def("GetRepeatCount", &DEPipeline::GetRepeatCount)
+    .def("DumpProfile", [](DEPipeline &de, const std::string &path) { THROW_IF_ERROR(de.DumpProfile(path)); })
+    .def("DumpChromeTrace",
+         [](DEPipeline &de, const std::string &path) { THROW_IF_ERROR(de.DumpChromeTrace(path)); });
 }
 void bindDatasetOps(py::module *m) {
   (void)py::class_<TFReaderOp, DatasetOp, std::shared_ptr<TFReaderOp>>(*m, "TFReaderOp")
@@ -129,6 +152,11 @@ void bindDatasetOps(py::module *m) {
       }
       THROW_IF_ERROR(TFReaderOp::CountTotalRows(&count, filenames, numParallelWorkers, estimate));
       return count;
+    })
+    .def_static("create_index_file", [](const std::string &filename) {
+      int64_t count = 0;
+      THROW_IF_ERROR(TFReaderOp::CreateIndexFile(filename, &count));
+      return count;
     });
 
   (void)py::class_<CifarOp, DatasetOp, std::shared_ptr<CifarOp>>(*m, "CifarOp")
@@ -187,11 +215,29 @@ void bindTensor(py::module *m) {
     .def("set_worker_connector_size", &ConfigManager::set_worker_connector_size)
     .def("set_op_connector_size", &ConfigManager::set_op_connector_size)
     .def("set_seed", &ConfigManager::set_seed)
+    .def("set_lock_free_connector", &ConfigManager::set_lock_free_connector)
+    .def("set_profiling_interval", &ConfigManager::set_profiling_interval)
+    .def("set_auto_tune", &ConfigManager::set_auto_tune)
+    .def("set_auto_tune_interval", &ConfigManager::set_auto_tune_interval)
+    .def("set_worker_scratch_size", &ConfigManager::set_worker_scratch_size)
+    .def("set_tensor_pool", &ConfigManager::set_tensor_pool)
+    .def("set_work_stealing", &ConfigManager::set_work_stealing)
+    .def("set_cpu_placement", &ConfigManager::set_cpu_placement)
+    .def("set_reserved_cpus", &ConfigManager::set_reserved_cpus)
     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
     .def("get_worker_connector_size", &ConfigManager::worker_connector_size)
     .def("get_op_connector_size", &ConfigManager::op_connector_size)
     .def("get_seed", &ConfigManager::seed)
+    .def("get_lock_free_connector", &ConfigManager::lock_free_connector)
+    .def("get_profiling_interval", &ConfigManager::profiling_interval)
+    .def("get_auto_tune", &ConfigManager::auto_tune)
+    .def("get_auto_tune_interval", &ConfigManager::auto_tune_interval)
+    .def("get_worker_scratch_size", &ConfigManager::worker_scratch_size)
+    .def("get_tensor_pool", &ConfigManager::tensor_pool)
+    .def("get_work_stealing", &ConfigManager::work_stealing)
+    .def("get_cpu_placement", &ConfigManager::cpu_placement)
+    .def("get_reserved_cpus", &ConfigManager::reserved_cpus)
     .def("load", [](ConfigManager &c, std::string s) { (void)c.LoadFile(s); });
 
   (void)py::class_<Tensor, std::shared_ptr<Tensor>>(*m, "Tensor", py::buffer_protocol())
@@ -280,6 +326,10 @@ void bindTensorOps2(py::module *m) {
          py::arg("fillG") = RandomCropOp::kDefFillG, py::arg("fillB") = RandomCropOp::kDefFillB);
   (void)py::class_<HwcToChwOp, TensorOp, std::shared_ptr<HwcToChwOp>>(*m, "ChannelSwapOp").def(py::init<>());
 
+  (void)py::class_<FusedNormalizeOp, TensorOp, std::shared_ptr<FusedNormalizeOp>>(
+    *m, "FusedNormalizeOp", "Tensor operation to rescale, normalize and optionally transpose an image in one pass.")
+    .def(py::init<std::vector<std::shared_ptr<TensorOp>>, DataType>(), py::arg("ops"), py::arg("data_type"));
+
   (void)py::class_<ChangeModeOp, TensorOp, std::shared_ptr<ChangeModeOp>>(
     *m, "ChangeModeOp", "Tensor operation to change colors from BGR to RGB")
     .def(py::init<>());
@@ -384,6 +434,44 @@ void bindTensorOps4(py::module *m) {
          py::arg("fillR") = PadOp::kDefFillR, py::arg("fillG") = PadOp::kDefFillG, py::arg("fillB") = PadOp::kDefFillB);
 }
 
+void bindTextOps(py::module *m) {
+  (void)py::class_<Vocab, std::shared_ptr<Vocab>>(*m, "Vocab", "A hash table from the words to their ids.")
+    .def(py::init<const std::vector<std::string> &>(), py::arg("words"))
+    .def_static("from_file",
+                [](const std::string &path) {
+                  std::shared_ptr<Vocab> vocab;
+                  THROW_IF_ERROR(Vocab::FromFile(path, &vocab));
+                  return vocab;
+                })
+    .def("lookup", &Vocab::Lookup)
+    .def("__len__", &Vocab::size);
+
+  (void)py::class_<WhitespaceTokenizerOp, TensorOp, std::shared_ptr<WhitespaceTokenizerOp>>(
+    *m, "WhitespaceTokenizerOp", "Tensor operation to split a text by the whitespaces and look up the words.")
+    .def(py::init<std::shared_ptr<Vocab>, std::string, bool>(), py::arg("vocab"),
+         py::arg("unknown_token") = std::string(WhitespaceTokenizerOp::kDefUnknownToken),
+         py::arg("lower_case") = WhitespaceTokenizerOp::kDefLowerCase);
+
+  (void)py::class_<WordpieceTokenizerOp, TensorOp, std::shared_ptr<WordpieceTokenizerOp>>(
+    *m, "WordpieceTokenizerOp", "Tensor operation to tokenize a text into the ids of the word pieces, like BERT.")
+    .def(py::init<std::shared_ptr<Vocab>, std::string, bool, int32_t>(), py::arg("vocab"),
+         py::arg("unknown_token") = std::string(WhitespaceTokenizerOp::kDefUnknownToken),
+         py::arg("lower_case") = WordpieceTokenizerOp::kDefLowerCase,
+         py::arg("max_bytes_per_word") = WordpieceTokenizerOp::kDefMaxBytesPerWord);
+
+  (void)py::class_<SlidingWindowOp, TensorOp, std::shared_ptr<SlidingWindowOp>>(
+    *m, "SlidingWindowOp", "Tensor operation to stack the windows of a width along the first dimension.")
+    .def(py::init<int32_t>(), py::arg("width"));
+
+  (void)py::class_<TruncatePadOp, TensorOp, std::shared_ptr<TruncatePadOp>>(
+    *m, "TruncatePadOp", "Tensor operation to truncate or pad the first dimension to a length.")
+    .def(py::init<int32_t, double>(), py::arg("length"), py::arg("pad_value") = TruncatePadOp::kDefPadValue);
+
+  (void)py::class_<PadMaskOp, TensorOp, std::shared_ptr<PadMaskOp>>(
+    *m, "PadMaskOp", "Tensor operation to generate the mask of the elements which are not the pad value.")
+    .def(py::init<double>(), py::arg("pad_value") = PadMaskOp::kDefPadValue);
+}
+
 void bindSamplerOps(py::module *m) {
   (void)py::class_<Sampler, std::shared_ptr<Sampler>>(*m, "Sampler");
 
@@ -466,6 +554,7 @@ PYBIND11_MODULE(_c_dataengine, m) {
   bindTensorOps2(&m);
   bindTensorOps3(&m);
   bindTensorOps4(&m);
+  bindTextOps(&m);
   bindSamplerOps(&m);
   bindDatasetOps(&m);
   bindInfoObjects(&m);
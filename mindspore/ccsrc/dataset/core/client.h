@@ -26,6 +26,7 @@
 #include "dataset/engine/data_schema.h"
 #include "dataset/engine/dataset_iterator.h"
 #include "dataset/engine/datasetops/batch_op.h"
+#include "dataset/engine/datasetops/cache_op.h"
 #include "dataset/engine/datasetops/dataset_op.h"
 #include "dataset/engine/datasetops/device_queue_op.h"
 #include "dataset/engine/datasetops/map_op.h"
@@ -19,7 +19,9 @@
 #include <iostream>
 #include <string>
 
+#include "dataset/core/global_context.h"
 #include "dataset/util/system_pool.h"
+#include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace dataset {
@@ -31,7 +33,16 @@ void ConfigManager::Print(std::ostream &out) const {
       << "\nDataCache Rows per buffer    : " << rows_per_buffer_
       << "\nParallelOp workers           : " << num_parallel_workers_
       << "\nParallelOp worker connector size    : " << worker_connector_size_
-      << "\nSize of each Connector : " << op_connector_size_ << std::endl;
+      << "\nSize of each Connector : " << op_connector_size_
+      << "\nLock free Connector    : " << std::boolalpha << lock_free_connector_ << std::noboolalpha
+      << "\nProfiling interval     : " << profiling_interval_
+      << "\nAuto tune              : " << std::boolalpha << auto_tune_ << std::noboolalpha
+      << "\nAuto tune interval     : " << auto_tune_interval_
+      << "\nWorker scratch size    : " << worker_scratch_size_
+      << "\nTensor pool            : " << tensor_pool_
+      << "\nWork stealing          : " << std::boolalpha << work_stealing_ << std::noboolalpha
+      << "\nCpu placement          : " << cpu_placement_
+      << "\nReserved cpus          : " << reserved_cpus_ << std::endl;
 }
 
 // Private helper function that taks a nlohmann json format and populates the settings
@@ -41,6 +52,15 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_worker_connector_size(j.value("workerConnectorSize", worker_connector_size_));
   set_op_connector_size(j.value("opConnectorSize", op_connector_size_));
   set_seed(j.value("seed", seed_));
+  set_lock_free_connector(j.value("lockFreeConnector", lock_free_connector_));
+  set_profiling_interval(j.value("profilingInterval", profiling_interval_));
+  set_auto_tune(j.value("autoTune", auto_tune_));
+  set_auto_tune_interval(j.value("autoTuneInterval", auto_tune_interval_));
+  set_worker_scratch_size(j.value("workerScratchSize", worker_scratch_size_));
+  set_tensor_pool(j.value("tensorPool", tensor_pool_));
+  set_work_stealing(j.value("workStealing", work_stealing_));
+  set_cpu_placement(j.value("cpuPlacement", cpu_placement_));
+  set_reserved_cpus(j.value("reservedCpus", reserved_cpus_));
   return Status::OK();
 }
 
@@ -88,5 +108,40 @@ void ConfigManager::set_op_connector_size(int32_t connector_size) { op_connector
 uint32_t ConfigManager::seed() const { return seed_; }
 
 void ConfigManager::set_seed(uint32_t seed) { seed_ = seed; }
+
+// Setter function
+void ConfigManager::set_lock_free_connector(bool lock_free) { lock_free_connector_ = lock_free; }
+
+// Setter function
+void ConfigManager::set_profiling_interval(int32_t interval_ms) { profiling_interval_ = interval_ms; }
+
+// Setter function
+void ConfigManager::set_auto_tune(bool auto_tune) { auto_tune_ = auto_tune; }
+
+// Setter function
+void ConfigManager::set_auto_tune_interval(int32_t interval_ms) { auto_tune_interval_ = interval_ms; }
+
+void ConfigManager::set_worker_scratch_size(int32_t size_mb) { worker_scratch_size_ = size_mb; }
+
+void ConfigManager::set_tensor_pool(const std::string &name) {
+  if (name == tensor_pool_) {
+    return;
+  }
+  Status rc = GlobalContext::Instance()->SetMemPool(name);
+  if (rc.IsError()) {
+    MS_LOG(ERROR) << "Keeping the " << tensor_pool_ << " tensor pool. " << rc.ToString();
+    return;
+  }
+  tensor_pool_ = name;
+}
+
+// Setter function
+void ConfigManager::set_work_stealing(bool work_stealing) { work_stealing_ = work_stealing; }
+
+// Setter function
+void ConfigManager::set_cpu_placement(const std::string &policy) { cpu_placement_ = policy; }
+
+// Setter function
+void ConfigManager::set_reserved_cpus(const std::string &cpus) { reserved_cpus_ = cpus; }
 }  // namespace dataset
 }  // namespace mindspore
@@ -105,6 +105,79 @@ class ConfigManager {
   // @param connector_size - The setting to apply to the config
   void set_op_connector_size(int32_t connector_size);
 
+  // getter function
+  // @return T/F if the operators' output connectors are lock free
+  bool lock_free_connector() const { return lock_free_connector_; }
+
+  // setter function
+  // @param lock_free - The setting to apply to the config
+  void set_lock_free_connector(bool lock_free);
+
+  // getter function
+  // @return The sampling interval in milli seconds of the pipeline profiler, 0 if the profiling is off
+  int32_t profiling_interval() const { return profiling_interval_; }
+
+  // setter function
+  // @param interval_ms - The setting to apply to the config
+  void set_profiling_interval(int32_t interval_ms);
+
+  // getter function
+  // @return T/F if the worker counts and connector sizes are tuned during the first epoch
+  bool auto_tune() const { return auto_tune_; }
+
+  // setter function
+  // @param auto_tune - The setting to apply to the config
+  void set_auto_tune(bool auto_tune);
+
+  // getter function
+  // @return The sampling interval in milli seconds of the auto tune
+  int32_t auto_tune_interval() const { return auto_tune_interval_; }
+
+  // setter function
+  // @param interval_ms - The setting to apply to the config
+  void set_auto_tune_interval(int32_t interval_ms);
+
+  // getter function
+  // @return The size in MB of the scratch pool of each MapOp worker, 0 if the workers use the global pool
+  int32_t worker_scratch_size() const { return worker_scratch_size_; }
+
+  // setter function
+  // @param size_mb - The setting to apply to the config
+  void set_worker_scratch_size(int32_t size_mb);
+
+  // getter function
+  // @return The name of the memory pool of the tensor data
+  std::string tensor_pool() const { return tensor_pool_; }
+
+  // setter function. Switches the pool of the global context, the tensors created afterwards use it.
+  // An unknown name keeps the current pool.
+  // @param name - The setting to apply to the config, one of system, circular or numa
+  void set_tensor_pool(const std::string &name);
+
+  // getter function
+  // @return T/F if the MapOps compute their buffers on the work stealing Executor instead of their own workers
+  bool work_stealing() const { return work_stealing_; }
+
+  // setter function
+  // @param work_stealing - The setting to apply to the config
+  void set_work_stealing(bool work_stealing);
+
+  // getter function
+  // @return The cpus of the dataset threads: none, device for the numa node of the device, or a cpu list
+  std::string cpu_placement() const { return cpu_placement_; }
+
+  // setter function
+  // @param policy - The setting to apply to the config
+  void set_cpu_placement(const std::string &policy);
+
+  // getter function
+  // @return The cpu list the dataset threads never run on, e.g. the cpus of the compute kernels
+  std::string reserved_cpus() const { return reserved_cpus_; }
+
+  // setter function
+  // @param cpus - The setting to apply to the config
+  void set_reserved_cpus(const std::string &cpus);
+
   uint32_t seed() const;
 
   // setter function
@@ -117,6 +190,15 @@ class ConfigManager {
   int32_t worker_connector_size_{kCfgWorkerConnectorSize};
   int32_t op_connector_size_{kCfgOpConnectorSize};
   uint32_t seed_{kCfgDefaultSeed};
+  bool lock_free_connector_{kCfgLockFreeConnector};
+  int32_t profiling_interval_{kCfgProfilingInterval};
+  bool auto_tune_{kCfgAutoTune};
+  int32_t auto_tune_interval_{kCfgAutoTuneInterval};
+  int32_t worker_scratch_size_{kCfgWorkerScratchSize};
+  std::string tensor_pool_{kCfgTensorPool};
+  bool work_stealing_{kCfgWorkStealing};
+  std::string cpu_placement_{kCfgCpuPlacement};
+  std::string reserved_cpus_{kCfgReservedCpus};
 
   // Private helper function that taks a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -47,6 +47,15 @@ constexpr uint32_t kCfgParallelWorkers = 4;
 constexpr uint32_t kCfgWorkerConnectorSize = 16;
 constexpr uint32_t kCfgOpConnectorSize = 16;
 constexpr uint32_t kCfgDefaultSeed = std::mt19937::default_seed;
+constexpr bool kCfgLockFreeConnector = false;
+constexpr int32_t kCfgProfilingInterval = 0;  // In milli seconds. 0 turns the pipeline profiling off
+constexpr bool kCfgAutoTune = false;
+constexpr int32_t kCfgAutoTuneInterval = 100;  // In milli seconds
+constexpr int32_t kCfgWorkerScratchSize = 0;    // In MB. 0 turns the scratch pools of the MapOp workers off
+constexpr char kCfgTensorPool[] = "system";     // The pool of the tensor data, one of system, circular or numa
+constexpr bool kCfgWorkStealing = false;         // T/F if the MapOps compute their buffers on the shared Executor
+constexpr char kCfgCpuPlacement[] = "none";      // The cpus of the dataset threads, one of none, device or a cpu list
+constexpr char kCfgReservedCpus[] = "";          // The cpus the dataset threads never run on, a cpu list
 
 // Invalid OpenCV type should not be from 0 to 7 (opencv4/opencv2/core/hal/interface.h)
 constexpr uint8_t kCVInvalidType = 255;
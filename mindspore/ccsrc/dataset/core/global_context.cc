@@ -23,6 +23,7 @@
 #include "dataset/core/tensor.h"
 #include "dataset/util/allocator.h"
 #include "dataset/util/circular_pool.h"
+#include "dataset/util/numa_pool.h"
 #include "dataset/util/system_pool.h"
 
 namespace mindspore {
@@ -61,6 +62,21 @@ Status GlobalContext::Init() {
   return Status::OK();
 }
 
+Status GlobalContext::SetMemPool(const std::string &name) {
+  std::shared_ptr<MemoryPool> pool;
+  if (name == "system") {
+    pool = std::make_shared<SystemPool>();
+  } else if (name == "circular") {
+    RETURN_IF_NOT_OK(CircularPool::CreateCircularPool(&pool, kMaxSize, kArenaSize, kInitArena));
+  } else if (name == "numa") {
+    RETURN_IF_NOT_OK(NumaPool::CreateNumaPool(&pool));
+  } else {
+    RETURN_STATUS_UNEXPECTED("Unknown tensor pool " + name);
+  }
+  std::atomic_store(&mem_pool_, pool);
+  return Status::OK();
+}
+
 // A print method typically used for debugging
 void GlobalContext::Print(std::ostream &out) const {
   out << "GlobalContext contains the following default config: " << *config_manager_ << "\n";
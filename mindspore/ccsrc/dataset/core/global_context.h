@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <mutex>
+#include <string>
 
 #include "dataset/core/constants.h"
 #include "dataset/util/allocator.h"
@@ -72,7 +73,13 @@ class GlobalContext {
 
   // Getter method
   // @return the mem pool
-  std::shared_ptr<MemoryPool> mem_pool() const { return mem_pool_; }
+  std::shared_ptr<MemoryPool> mem_pool() const { return std::atomic_load(&mem_pool_); }
+
+  // Replaces the mem pool from which the tensors created afterwards take their data. The tensors of the old
+  // pool keep it alive until they are all gone.
+  // @param name - The pool, one of system, circular or numa
+  // @return Status - The error code return
+  Status SetMemPool(const std::string &name);
 
   // Getter method
   // @return the tensor allocator as raw pointer
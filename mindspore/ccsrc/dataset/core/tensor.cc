@@ -29,6 +29,7 @@
 #include "dataset/core/pybind_support.h"
 #include "dataset/core/tensor_shape.h"
 #include "dataset/util/make_unique.h"
+#include "dataset/util/scratch_pool.h"
 
 namespace py = pybind11;
 namespace mindspore {
@@ -51,9 +52,12 @@ namespace dataset {
   }
 
 Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape), type_(type), data_(nullptr) {
-  // grab the mem pool from global context and create the allocator for char data area
-  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
-  data_allocator_ = mindspore::make_unique<Allocator<unsigned char>>(global_pool);
+  // grab the mem pool of the thread, else the one of the global context, and create the allocator for char data area
+  std::shared_ptr<MemoryPool> pool = ScratchPool::ThreadPool();
+  if (pool == nullptr) {
+    pool = GlobalContext::Instance()->mem_pool();
+  }
+  data_allocator_ = mindspore::make_unique<Allocator<unsigned char>>(pool);
 }
 
 Tensor::Tensor(const TensorShape &shape, const DataType &type, const unsigned char *data) : Tensor(shape, type) {
@@ -77,7 +81,8 @@ Tensor::Tensor(Tensor &&other) noexcept
     : shape_(other.shape()),
       type_(other.type()),
       data_(other.StartAddr()),
-      data_allocator_(std::move(other.data_allocator_)) {
+      data_allocator_(std::move(other.data_allocator_)),
+      view_base_(std::move(other.view_base_)) {
   other.Invalidate();
 }
 
@@ -87,6 +92,7 @@ Tensor &Tensor::operator=(Tensor &&other) noexcept {
     type_ = other.type();
     data_ = other.StartAddr();
     data_allocator_ = std::move(other.data_allocator_);
+    view_base_ = std::move(other.view_base_);
     other.Invalidate();
   }
   return *this;
@@ -202,10 +208,37 @@ Status Tensor::CopyStridedArray(unsigned char *dst, unsigned char *src, std::vec
   return Status::OK();
 }
 
+Status Tensor::CreateView(std::shared_ptr<Tensor> *ptr, const std::shared_ptr<Tensor> &base,
+                          const std::vector<dsize_t> &index, const TensorShape &shape) {
+  if (ptr == nullptr || base == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Null pointer to create a view.");
+  }
+  if (!shape.known() || index.size() > static_cast<size_t>(base->Rank())) {
+    RETURN_STATUS_UNEXPECTED("Invalid shape or index of the view.");
+  }
+  uchar *start_addr = nullptr;
+  TensorShape remaining({-1});
+  RETURN_IF_NOT_OK(base->StartAddrOfIndex(index, &start_addr, &remaining));
+  // The view must end within the data of the base
+  dsize_t flat_index = (start_addr - base->StartAddr()) / base->type().SizeInBytes();
+  if (flat_index + shape.NumOfElements() > base->Size()) {
+    RETURN_STATUS_UNEXPECTED("The view does not fit in its base Tensor.");
+  }
+  *ptr = std::make_shared<Tensor>(shape, base->type());
+  // A view of a view shares the owner of the data
+  (*ptr)->view_base_ = (base->view_base_ != nullptr) ? base->view_base_ : base;
+  (*ptr)->data_allocator_ = nullptr;
+  (*ptr)->data_ = start_addr;
+  return Status::OK();
+}
+
 // Name: Destructor
 // Description: Destructor
 Tensor::~Tensor() {
-  if (data_ != nullptr) {
+  if (view_base_ != nullptr) {
+    // The data belongs to the base of the view
+    data_ = nullptr;
+  } else if (data_ != nullptr) {
     if (data_allocator_ != nullptr) {
       data_allocator_->deallocate(data_);
       data_ = nullptr;
@@ -313,11 +346,7 @@ Status Tensor::ToFlatIndex(const std::vector<dsize_t> &index, dsize_t *flat_inde
   }
   *flat_index = 0;
   for (size_t k = 0; k < index.size(); k++) {
-    dsize_t product = 1;
-    for (size_t l = k + 1; l < index.size(); l++) {
-      product *= shape_[l];
-    }
-    *flat_index += index[k] * product;
+    *flat_index += index[k] * shape_.Stride(k);
   }
   return Status::OK();
 }
@@ -364,6 +393,7 @@ void Tensor::Invalidate() {
   type_ = DataType(DataType::DE_UNKNOWN);
   data_ = nullptr;
   data_allocator_ = nullptr;
+  view_base_ = nullptr;
 }
 
 template <typename T>
@@ -383,13 +413,25 @@ Status Tensor::GetItemPtr(T **ptr, const std::vector<dsize_t> &index) const {
   }
 }
 
-Status Tensor::StartAddrOfIndex(std::vector<dsize_t> ind, uchar **start_addr_of_index, TensorShape *remaining) {
-  dsize_t flat_ind;
-  std::vector<dsize_t> t_shape = shape().AsVector();
-  std::vector<dsize_t> r(t_shape.begin() + ind.size(), t_shape.end());
+Status Tensor::StartAddrOfIndex(const std::vector<dsize_t> &ind, uchar **start_addr_of_index,
+                                TensorShape *remaining) {
+  if (ind.size() > Rank()) {
+    RETURN_STATUS_UNEXPECTED("Not a valid index");
+  }
+  // The missing indexes are 0, so every remaining dim has to be not empty as well
+  dsize_t flat_ind = 0;
+  std::vector<dsize_t> r;
+  for (dsize_t k = 0; k < Rank(); k++) {
+    dsize_t i = k < ind.size() ? ind[k] : 0;
+    if (i < 0 || i >= shape_[k]) {
+      RETURN_STATUS_UNEXPECTED("Not a valid index");
+    }
+    flat_ind += i * shape_.Stride(k);
+    if (k >= ind.size()) {
+      r.push_back(shape_[k]);
+    }
+  }
   *remaining = TensorShape(r);
-  ind.resize(this->Rank(), 0);  //  same as -> while (ind.size() < this->Rank()) ind.push_back(0);
-  RETURN_IF_NOT_OK(ToFlatIndex(ind, &flat_ind));
   // check if StartAddr() returns null, we should flag this as an error, this sanity check will only
   // be true is the tensor failed to allocate memory.
   if (StartAddr() == nullptr) {
@@ -440,12 +482,10 @@ Status Tensor::ExpandDim(const dsize_t &axis) {
   return Status::OK();
 }
 
-std::vector<dsize_t> Tensor::Strides() {
-  std::vector<dsize_t> strides(Rank());
-  dsize_t count = shape_.NumOfElements();
-  for (dsize_t i = 0; i < Rank(); i++) {
-    count /= shape_[i];
-    strides[i] = type_.SizeInBytes() * count;
+std::vector<dsize_t> Tensor::Strides() const {
+  std::vector<dsize_t> strides = shape_.Strides();
+  for (auto &s : strides) {
+    s *= type_.SizeInBytes();
   }
   return strides;
 }
@@ -522,6 +562,21 @@ Status Tensor::GetDataAsNumpy(py::array *data) {
   return Status::OK();
 }
 
+Status Tensor::ShareDataAsNumpy(const std::shared_ptr<Tensor> &tensor, py::array *data, bool writable) {
+  RETURN_UNEXPECTED_IF_NULL(tensor);
+  py::buffer_info info;
+  if (GetBufferInfo(*tensor, &info).IsError()) {
+    return tensor->GetDataAsNumpy(data);
+  }
+  auto *owner = new std::shared_ptr<Tensor>(tensor);
+  py::capsule base(owner, [](void *p) { delete static_cast<std::shared_ptr<Tensor> *>(p); });
+  *data = py::array(py::dtype(info), info.shape, info.strides, info.ptr, base);
+  if (!writable) {
+    (void)data->attr("setflags")(py::arg("write") = false);
+  }
+  return Status::OK();
+}
+
 void Tensor::Squeeze() { shape_ = shape_.Squeeze(); }
 
 template <typename T>
@@ -81,6 +81,16 @@ class Tensor {
   static Status CreateTensor(std::shared_ptr<Tensor> *, TensorImpl tensor_impl, const TensorShape &shape, DataType type,
                              const unsigned char *data = nullptr);
 
+  // A static factory method to create a Tensor which is a view on a part of the data of another Tensor.
+  // The view shares the data of the base, writing into one of them changes the other, and keeps the base alive.
+  // @param ptr output argument to hold the created view
+  // @param base the Tensor which owns the data
+  // @param index the index of the first element of the view in base, it can be incomplete, see InsertTensor
+  // @param shape the shape of the view, it must fit in the data of base from index
+  // @return Status Code
+  static Status CreateView(std::shared_ptr<Tensor> *ptr, const std::shared_ptr<Tensor> &base,
+                           const std::vector<dsize_t> &index, const TensorShape &shape);
+
   // A static factory method to create a Tensor from a given py::array.
   // @param ptr output argument to hold the created Tensor
   // @param arr py::array
@@ -195,6 +205,10 @@ class Tensor {
   // @return
   DataType type() const { return type_; }
 
+  // Getter of the Tensor which owns the data of a view, see CreateView
+  // @return the base Tensor, nullptr if this Tensor is not a view
+  const std::shared_ptr<Tensor> &view_base() const { return view_base_; }
+
   // Provide stream operator for displaying it
   // @param output stream
   // @param so the Tensor object to be printed
@@ -223,7 +237,7 @@ class Tensor {
   // @param output: startAddrofIndex
   // @param output: remaining
   // @return Status code
-  Status StartAddrOfIndex(std::vector<dsize_t> ind, uchar **start_addr_of_index, TensorShape *remaining);
+  Status StartAddrOfIndex(const std::vector<dsize_t> &ind, uchar **start_addr_of_index, TensorShape *remaining);
 
   // Expand the shape of the Tensor with one extra dimension.
   // For example, if the shape is <512,512,3>:
@@ -241,7 +255,7 @@ class Tensor {
   // Ex: Tensor of shape <4,2,2> and type DE_UINT32 (4 byte)
   // The strides will be {24,8,4}.
   // @return vector of integers
-  std::vector<dsize_t> Strides();
+  std::vector<dsize_t> Strides() const;
 
   std::string ToString() {
     std::stringstream ss;
@@ -254,6 +268,14 @@ class Tensor {
   // @return Status code
   Status GetDataAsNumpy(py::array *data);
 
+  // Constructs a numpy array which wraps the data of the tensor instead of copying it, the array keeps the tensor
+  // alive. The types numpy can not wrap are copied.
+  // @param tensor
+  // @param data this data is the location of python data
+  // @param writable false if the tensor may be shared with other rows, e.g. by a cache
+  // @return Status code
+  static Status ShareDataAsNumpy(const std::shared_ptr<Tensor> &tensor, py::array *data, bool writable = true);
+
   static Status GetBufferInfo(Tensor &t, py::buffer_info *out);
 
   // TensorIterator is a linear iterator that can be used to iterate over the elements of the Tensor
@@ -362,6 +384,121 @@ class Tensor {
     return TensorIterator<T>(data_ + SizeInBytes());
   }
 
+  // StridedIterator goes along one axis of the Tensor, stepping by the stride the shape keeps for the axis, so the
+  // index of every element is not converted again. [[1,2,3],[4,5,6]] along the axis 0 from {0,1} --> 2,5
+  // @tparam T type of values in the Tensor Iterator
+  template <typename T>
+  class StridedIterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    explicit StridedIterator(uchar *ptr = nullptr, dsize_t stride = 0)
+        : ptr_(reinterpret_cast<T *>(ptr)), stride_(stride) {}
+
+    StridedIterator(const StridedIterator<T> &raw_iterator) = default;
+
+    ~StridedIterator() = default;
+
+    StridedIterator<T> &operator=(const StridedIterator<T> &rhs) = default;
+
+    bool operator==(const StridedIterator<T> &rhs) const { return ptr_ == rhs.ptr_; }
+
+    bool operator!=(const StridedIterator<T> &rhs) const { return !(*this == rhs); }
+
+    operator bool() const { return ptr_ != nullptr; }
+
+    T &operator*() { return *ptr_; }
+
+    const T &operator*() const { return *ptr_; }
+
+    T *operator->() { return ptr_; }
+
+    T &operator[](const ptrdiff_t &n) { return ptr_[n * stride_]; }
+
+    StridedIterator<T> &operator+=(const ptrdiff_t &inc) {
+      ptr_ += inc * stride_;
+      return *this;
+    }
+
+    StridedIterator<T> &operator-=(const ptrdiff_t &inc) {
+      ptr_ -= inc * stride_;
+      return *this;
+    }
+
+    StridedIterator<T> &operator++() {
+      ptr_ += stride_;
+      return *this;
+    }
+
+    StridedIterator<T> &operator--() {
+      ptr_ -= stride_;
+      return *this;
+    }
+
+    StridedIterator<T> operator++(int) {
+      auto temp(*this);
+      ptr_ += stride_;
+      return temp;
+    }
+
+    StridedIterator<T> operator--(int) {
+      auto temp(*this);
+      ptr_ -= stride_;
+      return temp;
+    }
+
+    StridedIterator<T> operator+(const ptrdiff_t &inc) const {
+      auto temp(*this);
+      temp += inc;
+      return temp;
+    }
+
+    StridedIterator<T> operator-(const ptrdiff_t &inc) const {
+      auto temp(*this);
+      temp -= inc;
+      return temp;
+    }
+
+    ptrdiff_t operator-(const StridedIterator<T> &rhs) const { return stride_ == 0 ? 0 : (ptr_ - rhs.ptr_) / stride_; }
+
+   protected:
+    T *ptr_;
+    dsize_t stride_;
+  };
+
+  // Return a StridedIterator that points to the element at the full index and goes along the axis.
+  // It's the user responsibility to use the correct type that matches the Tensor type
+  // @tparam T The type of values in the Tensor
+  // @param index The index of the first element
+  // @param axis The axis to go along
+  // @return StridedIterator, which is null if the index or the axis is not valid
+  template <typename T>
+  StridedIterator<T> begin(const std::vector<dsize_t> &index, dsize_t axis) {
+    dsize_t flat_index;
+    if (data_ == nullptr || axis < 0 || axis >= Rank() || ToFlatIndex(index, &flat_index).IsError()) {
+      return StridedIterator<T>();
+    }
+    return StridedIterator<T>(data_ + flat_index * type_.SizeInBytes(), shape_.Stride(axis));
+  }
+
+  // Return a StridedIterator that points to the place after the last element along the axis from the index.
+  // @tparam T The type of values in the Tensor
+  // @param index The index of the first element
+  // @param axis The axis to go along
+  // @return StridedIterator
+  template <typename T>
+  StridedIterator<T> end(const std::vector<dsize_t> &index, dsize_t axis) {
+    auto itr = begin<T>(index, axis);
+    if (itr) {
+      itr += shape_[axis] - index[axis];
+    }
+    return itr;
+  }
+
  protected:
   // Returns the location of the item assuming row major memory layout.
   // @param index
@@ -398,6 +535,8 @@ class Tensor {
   unsigned char *data_;
   // An allocator for data_
   CharAllocPtr data_allocator_;
+  // The Tensor which owns data_ when this Tensor is a view, data_ is then not released by this Tensor
+  std::shared_ptr<Tensor> view_base_;
 };
 }  // namespace dataset
 }  // namespace mindspore
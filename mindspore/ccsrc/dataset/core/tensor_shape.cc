@@ -27,6 +27,7 @@
 namespace mindspore {
 namespace dataset {
 constexpr dsize_t TensorShape::kDimUnknown;
+constexpr dsize_t TensorShape::kInlineRank;
 
 bool multi_ok(dsize_t x, dsize_t y) {
   dsize_t p = x * y;
@@ -41,7 +42,8 @@ dsize_t TensorShape::NumOfElements() const {
     return 0;
   }
   dsize_t num = 1;
-  for (auto i : raw_shape_) {
+  for (dsize_t k = 0; k < rank_; k++) {
+    dsize_t i = dims()[k];
     if (multi_ok(num, i)) {
       num *= i;
     } else {
@@ -53,15 +55,15 @@ dsize_t TensorShape::NumOfElements() const {
 }
 
 void TensorShape::Print(std::ostream &out) const {
-  if (!known() && raw_shape_.empty()) {
+  if (!known() && empty()) {
     out << "<kUnknown>";
   } else {
     out << "<";
     for (auto i = 0; i < this->Rank(); i++) {
-      if (raw_shape_[i] == kDimUnknown) {
+      if (dims()[i] == kDimUnknown) {
         out << "*";
       } else {
-        out << raw_shape_[i];
+        out << dims()[i];
       }
       if (i != this->Rank() - 1) {
         out << ",";
@@ -72,20 +74,26 @@ void TensorShape::Print(std::ostream &out) const {
 }
 
 TensorShape::TensorShape(const std::initializer_list<dsize_t> &list)
-    : raw_shape_(*GlobalContext::Instance()->int_allocator()) {
+    : known_(true),
+      rank_(0),
+      heap_dims_(*GlobalContext::Instance()->int_allocator()),
+      heap_strides_(heap_dims_.get_allocator()) {
   AddListToShape(list);
 }
 
-TensorShape::TensorShape(const std::vector<dsize_t> &list) : raw_shape_(*GlobalContext::Instance()->int_allocator()) {
+TensorShape::TensorShape(const std::vector<dsize_t> &list)
+    : known_(true),
+      rank_(0),
+      heap_dims_(*GlobalContext::Instance()->int_allocator()),
+      heap_strides_(heap_dims_.get_allocator()) {
   AddListToShape(list);
 }
 
-TensorShape::TensorShape(const TensorShape &shape) : raw_shape_(*GlobalContext::Instance()->int_allocator()) {
-  AddListToShape(shape.AsVector());
-  known_ = shape.known_;  // override with the input shape in case of unknown-rank tensor shape.
-}
-
-TensorShape::TensorShape(py::list l) : raw_shape_(*GlobalContext::Instance()->int_allocator()) {
+TensorShape::TensorShape(py::list l)
+    : known_(true),
+      rank_(0),
+      heap_dims_(*GlobalContext::Instance()->int_allocator()),
+      heap_strides_(heap_dims_.get_allocator()) {
   std::vector<dsize_t> list_c;
   for (auto i : l) {
     list_c.push_back(i.cast<int>());
@@ -96,6 +104,7 @@ TensorShape::TensorShape(py::list l) : raw_shape_(*GlobalContext::Instance()->in
 TensorShape TensorShape::CreateUnknownRankShape() {
   TensorShape s({});
   s.known_ = false;
+  s.UpdateStrides();
   return s;
 }
 
@@ -105,19 +114,52 @@ TensorShape TensorShape::InsertDim(dsize_t axis, dsize_t dim) const {
   return TensorShape(tmp);
 }
 
-TensorShape::TensorShape(cv::MatSize cv_size, uint32_t type) : raw_shape_(*GlobalContext::Instance()->int_allocator()) {
+TensorShape::TensorShape(cv::MatSize cv_size, uint32_t type)
+    : known_(true),
+      rank_(0),
+      heap_dims_(*GlobalContext::Instance()->int_allocator()),
+      heap_strides_(heap_dims_.get_allocator()) {
   for (int i = 0; i < cv_size.dims(); i++) {
-    raw_shape_.push_back(cv_size[i]);
+    PushDim(cv_size[i]);
   }
   auto channels = static_cast<uint8_t>(1 + (type >> static_cast<uint8_t>(CV_CN_SHIFT)));
   if (channels != 1) {
-    raw_shape_.push_back(channels);
+    PushDim(channels);
   }
-  known_ = true;
+  UpdateStrides();
 }
 
-std::vector<dsize_t> TensorShape::AsVector() const {
-  return std::vector<dsize_t>(raw_shape_.begin(), raw_shape_.end());
+std::vector<dsize_t> TensorShape::AsVector() const { return std::vector<dsize_t>(dims(), dims() + rank_); }
+
+void TensorShape::PushDim(dsize_t dim) {
+  if (rank_ < kInlineRank) {
+    inline_dims_[rank_] = dim;
+  } else {
+    if (rank_ == kInlineRank) {
+      heap_dims_.assign(inline_dims_, inline_dims_ + kInlineRank);
+    }
+    heap_dims_.push_back(dim);
+  }
+  rank_++;
+}
+
+void TensorShape::ClearDims() {
+  rank_ = 0;
+  heap_dims_.clear();
+  heap_strides_.clear();
+}
+
+void TensorShape::UpdateStrides() {
+  dsize_t *strides = inline_strides_;
+  if (rank_ > kInlineRank) {
+    heap_strides_.resize(rank_);
+    strides = heap_strides_.data();
+  }
+  dsize_t stride = known_ ? 1 : 0;
+  for (dsize_t i = rank_ - 1; i >= 0; i--) {
+    strides[i] = stride;
+    stride *= dims()[i];
+  }
 }
 
 bool TensorShape::IsValidIndex(const std::vector<dsize_t> &index) const {
@@ -126,7 +168,7 @@ bool TensorShape::IsValidIndex(const std::vector<dsize_t> &index) const {
     return false;
   }
   for (dsize_t i = 0; i < s_rank; i++) {
-    if (index[i] < 0 || raw_shape_[i] <= index[i]) {
+    if (index[i] < 0 || dims()[i] <= index[i]) {
       return false;
     }
   }
@@ -143,7 +185,7 @@ void TensorShape::AddListToShape(const T &list) {
       if (num > std::numeric_limits<int64_t>::max() / itr) {
         MS_LOG(ERROR) << "Invalid shape data, overflow occurred!";
         known_ = false;
-        raw_shape_.clear();
+        ClearDims();
         return;
       }
       num *= itr;
@@ -156,10 +198,10 @@ void TensorShape::AddListToShape(const T &list) {
       ss << "Invalid shape data, dim (" << size << ") is larger than the maximum dim size(" << kDeMaxDim << ")!";
       MS_LOG(ERROR) << ss.str().c_str();
       known_ = false;
-      raw_shape_.clear();
+      ClearDims();
       return;
     }
-    raw_shape_.push_back(itr);
+    PushDim(itr);
     size++;
   }
   if (size > kDeMaxRank) {
@@ -167,17 +209,19 @@ void TensorShape::AddListToShape(const T &list) {
     ss << "Invalid shape data, rank (" << size << ") is larger than the maximum rank size(" << kDeMaxRank << ").";
     MS_LOG(ERROR) << ss.str().c_str();
     known_ = false;
-    raw_shape_.clear();
+    ClearDims();
     return;
   }
+  UpdateStrides();
 }
 
 TensorShape TensorShape::CreateUnknownShapeWithRank(dsize_t rank) {
   TensorShape s({});
   for (dsize_t i = 0; i < rank; i++) {
-    s.raw_shape_.push_back(kDimUnknown);
+    s.PushDim(kDimUnknown);
   }
   s.known_ = false;
+  s.UpdateStrides();
   return s;
 }
 
@@ -196,8 +240,8 @@ TensorShape TensorShape::AppendDim(dsize_t dim) const {
 
 py::list TensorShape::AsPyList() {
   py::list list;
-  for (auto i : raw_shape_) {
-    list.append(i);
+  for (dsize_t i = 0; i < rank_; i++) {
+    list.append(dims()[i]);
   }
   return list;
 }
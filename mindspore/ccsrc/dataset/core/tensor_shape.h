@@ -16,6 +16,7 @@
 #ifndef DATASET_CORE_TENSOR_SHAPE_H_
 #define DATASET_CORE_TENSOR_SHAPE_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <ostream>
 #include <sstream>
@@ -44,6 +45,8 @@ namespace dataset {
 //           Example: <3,?> (the 1st dim is unknown)\n
 //              <2,?,?,?> (all dims but the 0th dim are unknown)
 //  TensorShape supports any dim > 0 and < 2^31-1
+// The dims and the strides of the shapes up to kInlineRank are kept inline, so creating and copying them allocates
+// nothing. Higher ranks are kept on the heap.
 class TensorShape {
  public:
   static constexpr dsize_t kDimUnknown = -1;  // constant for an unknown dimension
@@ -63,7 +66,9 @@ class TensorShape {
 
   // Copy constructor
   // @param shape
-  TensorShape(const TensorShape &shape);
+  TensorShape(const TensorShape &shape) = default;
+
+  TensorShape &operator=(const TensorShape &shape) = default;
 
   ~TensorShape() = default;
 
@@ -100,21 +105,33 @@ class TensorShape {
   // @param type int that represent the type in OpenCV, example CV_8U, CV_64S
   TensorShape(cv::MatSize cv_size, uint32_t type);
 
-  dsize_t Size() const { return raw_shape_.size(); }
+  dsize_t Size() const { return rank_; }
 
-  dsize_t Rank() const { return raw_shape_.size(); }
+  dsize_t Rank() const { return rank_; }
 
   bool known() const { return known_; }
 
-  bool empty() const { return raw_shape_.empty(); }
+  bool empty() const { return rank_ == 0; }
 
   dsize_t NumOfElements() const;
 
-  bool operator==(const TensorShape &rhs) const { return known_ == rhs.known_ && raw_shape_ == rhs.raw_shape_; }
+  bool operator==(const TensorShape &rhs) const {
+    return known_ == rhs.known_ && rank_ == rhs.rank_ && std::equal(dims(), dims() + rank_, rhs.dims());
+  }
 
   bool operator!=(const TensorShape &rhs) const { return !(rhs == *this); }
 
-  dsize_t operator[](const dsize_t index) const { return raw_shape_[index]; }
+  dsize_t operator[](const dsize_t index) const { return dims()[index]; }
+
+  // Return the number of elements between two consecutive indexes of the axis in the row major layout, for example
+  // the strides of <4,2,3> are {6,3,1}. The strides of an unknown shape are 0.
+  // @param axis
+  // @return
+  dsize_t Stride(const dsize_t axis) const { return strides()[axis]; }
+
+  // Return the strides of all the axes
+  // @return
+  std::vector<dsize_t> Strides() const { return std::vector<dsize_t>(strides(), strides() + rank_); }
 
   // Return the Shape as a vector
   // @return
@@ -155,10 +172,32 @@ class TensorShape {
   TensorShape Squeeze() const;
 
  private:
+  static constexpr dsize_t kInlineRank = 6;
+
   // True if known and valid shape, false otherwise
   bool known_;
-  // Vector to keep the dims of the shape.
-  std::vector<dsize_t, IntAlloc> raw_shape_;
+  dsize_t rank_;
+  // The dims and the strides of the shape when the rank is not larger than kInlineRank.
+  dsize_t inline_dims_[kInlineRank] = {};
+  dsize_t inline_strides_[kInlineRank] = {};
+  // The dims and the strides of the shape when the rank is larger than kInlineRank.
+  std::vector<dsize_t, IntAlloc> heap_dims_;
+  std::vector<dsize_t, IntAlloc> heap_strides_;
+
+  const dsize_t *dims() const { return rank_ > kInlineRank ? heap_dims_.data() : inline_dims_; }
+
+  const dsize_t *strides() const { return rank_ > kInlineRank ? heap_strides_.data() : inline_strides_; }
+
+  // Append a dim to the shape, moving the dims to the heap when the rank goes over kInlineRank.
+  // The strides are updated by UpdateStrides() once all the dims are added.
+  // @param dim
+  void PushDim(dsize_t dim);
+
+  // Remove all the dims of the shape
+  void ClearDims();
+
+  // Compute the strides from the dims, called whenever the dims or known_ change.
+  void UpdateStrides();
 
   // Internal utility function to iterate over a list, check if the dim is valid and then insert it into the shape.
   // @tparam T list
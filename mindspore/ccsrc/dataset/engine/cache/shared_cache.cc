@@ -0,0 +1,308 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/cache/shared_cache.h"
+
+#include <fcntl.h>
+#include <securec.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "dataset/util/make_unique.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// "MSCACHE1", set once the header of a segment is written
+constexpr uint64_t kSharedCacheMagic = 0x4d53434143484531;
+// A reader gives up on a segment whose header is not written after this long
+constexpr int32_t kSharedCacheAttachTimeoutMs = 30000;
+
+// The record of one column of a row, followed by its dims and its bytes
+struct ColumnRecord {
+  int32_t type;
+  int32_t rank;
+  int64_t size;
+};
+
+int64_t AlignUp(int64_t n) { return (n + 7) & ~static_cast<int64_t>(7); }
+
+std::string SegmentName(const std::string &name) { return "/mindspore_cache_" + name; }
+
+// Sleeps one poll period.
+// @return Status - The error code return, interrupted if the pipeline is being torn down
+Status PollSleep() {
+  if (this_thread::is_interrupted()) {
+    return Status(StatusCode::kInterrupted);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(kSharedCachePollMs));
+  return Status::OK();
+}
+}  // namespace
+
+// Opens a session, creating its segment if this process is the first one.
+Status SharedCache::Open(const std::string &name, int32_t memory_mb, std::unique_ptr<SharedCache> *out) {
+  if (name.empty() || name.find('/') != std::string::npos) {
+    RETURN_STATUS_UNEXPECTED("Invalid cache session name: " + name);
+  }
+  std::string seg_name = SegmentName(name);
+  bool producer = true;
+  int fd = shm_open(seg_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+  if (fd < 0 && errno == EEXIST) {
+    producer = false;
+    fd = shm_open(seg_name.c_str(), O_RDWR, 0);
+  }
+  if (fd < 0) {
+    RETURN_STATUS_UNEXPECTED("Failed to open the shared memory of the cache session " + name + ".");
+  }
+
+  int64_t size = static_cast<int64_t>(memory_mb) * 1024 * 1024;
+  if (producer) {
+    if (size < static_cast<int64_t>(sizeof(Header)) || ftruncate(fd, size) != 0) {
+      (void)close(fd);
+      (void)shm_unlink(seg_name.c_str());
+      RETURN_STATUS_UNEXPECTED("Failed to size the shared memory of the cache session " + name + ".");
+    }
+  } else {
+    // The producer sizes the segment right after creating it
+    struct stat st {};
+    int32_t waited_ms = 0;
+    while (fstat(fd, &st) == 0 && st.st_size == 0 && waited_ms < kSharedCacheAttachTimeoutMs) {
+      Status rc = PollSleep();
+      if (rc.IsError()) {
+        (void)close(fd);
+        return rc;
+      }
+      waited_ms += kSharedCachePollMs;
+    }
+    size = st.st_size;
+    if (size < static_cast<int64_t>(sizeof(Header))) {
+      (void)close(fd);
+      RETURN_STATUS_UNEXPECTED("The shared memory of the cache session " + name + " is not usable.");
+    }
+  }
+
+  void *base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (base == MAP_FAILED) {
+    if (producer) {
+      (void)shm_unlink(seg_name.c_str());
+    }
+    RETURN_STATUS_UNEXPECTED("Failed to map the shared memory of the cache session " + name + ".");
+  }
+  *out = std::unique_ptr<SharedCache>(new SharedCache(name, base, size, producer));
+  return (*out)->producer_ ? Status::OK() : (*out)->Attach();
+}
+
+SharedCache::SharedCache(const std::string &name, void *base, int64_t size, bool producer)
+    : name_(name),
+      header_(nullptr),
+      base_(static_cast<unsigned char *>(base)),
+      size_(size),
+      producer_(producer),
+      attached_(false) {
+  if (producer_) {
+    header_ = new (base) Header();
+    header_->state.store(static_cast<int32_t>(State::kFilling));
+    header_->ref_count.store(1);
+    header_->num_rows.store(0);
+    header_->used.store(0);
+    header_->column_map_len.store(0);
+    header_->producer_pid = getpid();
+    header_->capacity = size;
+    header_->magic.store(kSharedCacheMagic, std::memory_order_release);
+    MS_LOG(INFO) << "Cache session " << name_ << " created, this process produces its rows.";
+  } else {
+    header_ = static_cast<Header *>(base);
+  }
+}
+
+// Reader side. Waits for the header of the producer, then takes a reference on the segment.
+Status SharedCache::Attach() {
+  int32_t waited_ms = 0;
+  while (header_->magic.load(std::memory_order_acquire) != kSharedCacheMagic) {
+    if (waited_ms >= kSharedCacheAttachTimeoutMs) {
+      RETURN_STATUS_UNEXPECTED("The producer of the cache session " + name_ + " did not start.");
+    }
+    RETURN_IF_NOT_OK(PollSleep());
+    waited_ms += kSharedCachePollMs;
+  }
+  (void)header_->ref_count.fetch_add(1);
+  attached_ = true;
+  MS_LOG(INFO) << "Cache session " << name_ << " attached, this process reads its rows.";
+  return Status::OK();
+}
+
+SharedCache::~SharedCache() {
+  bool last = false;
+  if (producer_ || attached_) {
+    if (producer_ && state() == State::kFilling) {
+      // The readers must not wait for rows which will never come
+      Seal(true);
+    }
+    last = (header_->ref_count.fetch_sub(1) == 1);
+  }
+  (void)munmap(base_, size_);
+  if (last) {
+    (void)shm_unlink(SegmentName(name_).c_str());
+    MS_LOG(INFO) << "Cache session " << name_ << " removed.";
+  }
+}
+
+void SharedCache::Destroy(const std::string &name) { (void)shm_unlink(SegmentName(name).c_str()); }
+
+int64_t SharedCache::NumRows() const { return header_->num_rows.load(std::memory_order_acquire); }
+
+SharedCache::State SharedCache::state() const {
+  return static_cast<State>(header_->state.load(std::memory_order_acquire));
+}
+
+int64_t *SharedCache::IndexEntry(int64_t row_id) const {
+  return reinterpret_cast<int64_t *>(base_ + size_) - (row_id + 1);
+}
+
+bool SharedCache::ProducerAlive() const { return kill(header_->producer_pid, 0) == 0 || errno == EPERM; }
+
+// Producer side. Appends the next row of the epoch.
+Status SharedCache::Publish(int64_t row_id, const TensorRow &row) {
+  if (row_id != NumRows()) {
+    RETURN_STATUS_UNEXPECTED("The rows of a cache session must be published in order.");
+  }
+  int64_t record_size = AlignUp(sizeof(int32_t));
+  for (const auto &t : row) {
+    record_size += sizeof(ColumnRecord) + t->Rank() * sizeof(int64_t) + AlignUp(t->SizeInBytes());
+  }
+  int64_t start = AlignUp(sizeof(Header)) + header_->used.load();
+  int64_t index_start = reinterpret_cast<unsigned char *>(IndexEntry(row_id)) - base_;
+  if (start + record_size > index_start) {
+    return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__, "The cache session " + name_ + " is full.");
+  }
+
+  unsigned char *p = base_ + start;
+  *reinterpret_cast<int32_t *>(p) = static_cast<int32_t>(row.size());
+  p += AlignUp(sizeof(int32_t));
+  for (const auto &t : row) {
+    std::vector<dsize_t> dims = t->shape().AsVector();
+    ColumnRecord rec{static_cast<int32_t>(t->type().value()), static_cast<int32_t>(dims.size()), t->SizeInBytes()};
+    *reinterpret_cast<ColumnRecord *>(p) = rec;
+    p += sizeof(ColumnRecord);
+    for (auto d : dims) {
+      *reinterpret_cast<int64_t *>(p) = d;
+      p += sizeof(int64_t);
+    }
+    if (rec.size > 0) {
+      int ret_code = memcpy_s(p, index_start - (p - base_), t->StartAddr(), rec.size);
+      if (ret_code != 0) {
+        RETURN_STATUS_UNEXPECTED("Failed to copy a tensor into the cache session " + name_ + ".");
+      }
+    }
+    p += AlignUp(rec.size);
+  }
+  *IndexEntry(row_id) = start;
+  header_->used.store(start + record_size - AlignUp(sizeof(Header)));
+  // Publishing last, a reader which sees the new count sees the row and its index entry
+  header_->num_rows.store(row_id + 1, std::memory_order_release);
+  return Status::OK();
+}
+
+// Producer side. Ends the fill.
+void SharedCache::Seal(bool full) {
+  State s = full ? State::kFull : State::kReady;
+  header_->state.store(static_cast<int32_t>(s), std::memory_order_release);
+  MS_LOG(INFO) << "Cache session " << name_ << " sealed with " << NumRows() << " rows"
+               << (full ? ", the rows did not all fit." : ".");
+}
+
+// Producer side. Stores the column name mapping of the rows.
+Status SharedCache::SetColumnMap(const std::unordered_map<std::string, int32_t> &column_name_map) {
+  std::ostringstream ss;
+  for (const auto &p : column_name_map) {
+    ss << p.second << ":" << p.first << "\n";
+  }
+  std::string s = ss.str();
+  if (s.size() > static_cast<size_t>(kSharedCacheColumnMapSize)) {
+    RETURN_STATUS_UNEXPECTED("The column names are too long for the cache session " + name_ + ".");
+  }
+  if (!s.empty()) {
+    int ret_code = memcpy_s(header_->column_map, kSharedCacheColumnMapSize, s.data(), s.size());
+    if (ret_code != 0) {
+      RETURN_STATUS_UNEXPECTED("Failed to copy the column names into the cache session " + name_ + ".");
+    }
+  }
+  header_->column_map_len.store(static_cast<int32_t>(s.size()), std::memory_order_release);
+  return Status::OK();
+}
+
+// Reader side. Gets the column name mapping of the rows.
+Status SharedCache::GetColumnMap(std::unordered_map<std::string, int32_t> *column_name_map) const {
+  column_name_map->clear();
+  int32_t len = header_->column_map_len.load(std::memory_order_acquire);
+  std::istringstream ss(std::string(header_->column_map, len));
+  std::string line;
+  while (std::getline(ss, line)) {
+    size_t sep = line.find(':');
+    if (sep == std::string::npos) {
+      RETURN_STATUS_UNEXPECTED("Invalid column names in the cache session " + name_ + ".");
+    }
+    (*column_name_map)[line.substr(sep + 1)] = std::stoi(line.substr(0, sep));
+  }
+  return Status::OK();
+}
+
+// Reader side. Waits until a row is published or the fill is over, then copies it out of the store.
+Status SharedCache::GetRow(int64_t row_id, TensorRow *row) const {
+  row->clear();
+  while (row_id >= NumRows()) {
+    if (state() != State::kFilling || !ProducerAlive()) {
+      // The count is final once the fill is over, look at it once more
+      if (row_id >= NumRows()) {
+        return Status::OK();
+      }
+      break;
+    }
+    RETURN_IF_NOT_OK(PollSleep());
+  }
+
+  const unsigned char *p = base_ + *IndexEntry(row_id);
+  int32_t num_cols = *reinterpret_cast<const int32_t *>(p);
+  p += AlignUp(sizeof(int32_t));
+  for (int32_t i = 0; i < num_cols; i++) {
+    ColumnRecord rec = *reinterpret_cast<const ColumnRecord *>(p);
+    p += sizeof(ColumnRecord);
+    std::vector<dsize_t> dims(rec.rank);
+    for (auto &d : dims) {
+      d = *reinterpret_cast<const int64_t *>(p);
+      p += sizeof(int64_t);
+    }
+    std::shared_ptr<Tensor> t;
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&t, TensorImpl::kFlexible, TensorShape(dims),
+                                          DataType(static_cast<DataType::Type>(rec.type)), p));
+    p += AlignUp(rec.size);
+    row->push_back(std::move(t));
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_CACHE_SHARED_CACHE_H_
+#define DATASET_ENGINE_CACHE_SHARED_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "dataset/core/tensor.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Room of the segment header for the column name mapping of the rows
+constexpr int32_t kSharedCacheColumnMapSize = 4096;
+// Milli seconds between two looks of a reader at a row which is not published yet
+constexpr int32_t kSharedCachePollMs = 1;
+
+// A store of rows in a POSIX shared memory segment, shared by the pipelines of all the processes of a
+// host which open the same session. The first process to open a session creates the segment and is its
+// producer: it publishes the rows of its pipeline in order, keyed by their row id. The other processes
+// are readers, they get the rows by row id as soon as they are published instead of producing them.
+// The segment is reference counted, the last process to close the session removes it.
+// The rows are appended from the start of the segment and their offsets are indexed from its end, the
+// store is full when both meet.
+class SharedCache {
+ public:
+  // The fill state of the store
+  enum class State : int32_t {
+    kFilling = 0,  // The producer is publishing the rows
+    kReady = 1,    // Every row of the epoch is in the store
+    kFull = 2      // The producer ran out of memory or died, the rows from NumRows() on are not in the store
+  };
+
+  // Opens a session, creating its segment if this process is the first one.
+  // @param name - The session name, the same in every process which shares the rows
+  // @param memory_mb - The size of the segment in MB, only used by the process which creates it
+  // @param out - The new store
+  // @return Status - The error code return
+  static Status Open(const std::string &name, int32_t memory_mb, std::unique_ptr<SharedCache> *out);
+
+  // Destructor. Detaches from the segment, and removes it if this is the last process of the session.
+  ~SharedCache();
+
+  // @return T/F if this process publishes the rows of the session
+  bool producer() const { return producer_; }
+
+  // @return The number of rows published so far
+  int64_t NumRows() const;
+
+  // @return The fill state of the store
+  State state() const;
+
+  // Producer side. Appends the next row of the epoch.
+  // @param row_id - The id of the row, NumRows() is expected
+  // @param row - The row
+  // @return Status - The error code return, out of memory once the store is full
+  Status Publish(int64_t row_id, const TensorRow &row);
+
+  // Producer side. Ends the fill.
+  // @param full - T/F if the rows of the epoch did not all fit
+  void Seal(bool full);
+
+  // Producer side. Stores the column name mapping of the rows, before the first row is published.
+  // @param column_name_map - The mapping
+  // @return Status - The error code return
+  Status SetColumnMap(const std::unordered_map<std::string, int32_t> &column_name_map);
+
+  // Reader side. Gets the column name mapping of the rows, once a row is published.
+  // @param column_name_map - The mapping
+  // @return Status - The error code return
+  Status GetColumnMap(std::unordered_map<std::string, int32_t> *column_name_map) const;
+
+  // Reader side. Waits until a row is published or the fill is over, then copies it out of the store.
+  // @param row_id - The id of the row
+  // @param row - The row, left empty when the row is not in the store
+  // @return Status - The error code return
+  Status GetRow(int64_t row_id, TensorRow *row) const;
+
+  // Removes the segment of a session which was left behind by processes which did not exit cleanly.
+  // @param name - The session name
+  static void Destroy(const std::string &name);
+
+ private:
+  // The header at the start of the segment
+  struct Header {
+    std::atomic<uint64_t> magic;      // Set last by the producer, the segment is usable afterwards
+    std::atomic<int32_t> state;       // See State
+    std::atomic<int32_t> ref_count;   // The processes attached to the segment
+    std::atomic<int64_t> num_rows;    // The rows published, their bytes and index entries are written first
+    std::atomic<int64_t> used;        // The bytes of the rows
+    std::atomic<int32_t> column_map_len;
+    int32_t producer_pid;
+    int64_t capacity;                 // The size of the segment
+    char column_map[kSharedCacheColumnMapSize];
+  };
+
+  SharedCache(const std::string &name, void *base, int64_t size, bool producer);
+
+  // Reader side. Waits for the header of the producer, then takes a reference on the segment.
+  // @return Status - The error code return
+  Status Attach();
+
+  // @return The index entry of a row, counted from the end of the segment
+  int64_t *IndexEntry(int64_t row_id) const;
+
+  // @return T/F if the producer of the session is still alive
+  bool ProducerAlive() const;
+
+  std::string name_;
+  Header *header_;
+  unsigned char *base_;
+  int64_t size_;
+  bool producer_;
+  bool attached_;  // T/F if a reader holds a reference on the segment
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_CACHE_SHARED_CACHE_H_
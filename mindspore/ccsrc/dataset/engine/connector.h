@@ -16,12 +16,17 @@
 #ifndef DATASET_ENGINE_CONNECTOR_H_
 #define DATASET_ENGINE_CONNECTOR_H_
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "dataset/util/task_manager.h"
 #include "dataset/util/queue.h"
+#include "dataset/util/ring_buffer.h"
 #include "dataset/util/services.h"
 #include "dataset/util/cond_var.h"
 
@@ -50,6 +55,14 @@ namespace dataset {
 //        - The caller thread of pop() is not equal to the _expectConsumer. This is to enforce
 //          the ordering.
 //
+// Backends:
+//   1. The default backend is a list of blocking Queue's, and the consumer turn is handed over with a
+//      mutex and a condition variable.
+//   2. The lock free backend replaces the queues by RingBuffer's and passes the consumer turn through an
+//      atomic counter, so no thread ever sleeps on a mutex inside the Connector.
+//   3. The lock free backend can also run unordered. Any consumer then takes the next element from
+//      whichever producer queue has one, and the ordering requirements above do not apply.
+//
 // Future improvement:
 //   1. Fault tolerant: Right now, if one of the worker dies, the Connector will not work
 //      properly.
@@ -71,9 +84,17 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
-    MS_LOG(INFO) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
+  // @param lock_free Use RingBuffer's instead of blocking queues.
+  // @param ordered Preserve the order of the elements. An unordered Connector is always lock free.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false,
+            bool ordered = true)
+      : num_producers_(n_producers),
+        num_consumers_(n_consumers),
+        queue_capacity_(queue_capacity),
+        lock_free_(lock_free || !ordered),
+        ordered_(ordered) {
+    MS_LOG(INFO) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers."
+                 << " Lock free: " << lock_free_ << ". Ordered: " << ordered_ << ".";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
     // Otherwise a ordered list of consumer ids have to be passed here. (not implemented yet)
@@ -83,8 +104,12 @@ class Connector {
     pop_from_ = 0;
 
     // Initialize the queues_ to have num_producers_ number of queues.
-    // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    // Each queue is a blocking queue (or a ring buffer) and has the same queue_capacity.
+    if (lock_free_) {
+      rings_.Init(num_producers_, queue_capacity);
+    } else {
+      queues_.Init(num_producers_, queue_capacity);
+    }
   }
 
   // Destructor of Connector
@@ -96,15 +121,15 @@ class Connector {
   // @param result The address of an object where the popped element will be placed.
   virtual Status Pop(int32_t worker_id,  // The worker-id of the caller. See the requirement at the top of this file.
                      T *result) noexcept {
-    {
-      DS_ASSERT(worker_id < num_consumers_);
-      std::unique_lock<std::mutex> lk(m_);
-      RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
-      RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
-      pop_from_ = (pop_from_ + 1) % num_producers_;
-      expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
-    }
-    cv_.NotifyAll();
+    DS_ASSERT(worker_id < num_consumers_);
+    if (!ordered_) {
+      return PopFromAnyQueue(result);
+    }
+    std::unique_lock<std::mutex> lk;
+    RETURN_IF_NOT_OK(AcquireTurn(worker_id, &lk));
+    RETURN_IF_NOT_OK(PopFromQueue(pop_from_, result));
+    pop_from_ = (pop_from_ + 1) % num_producers_;
+    ReleaseTurn(&lk, true);
     return Status::OK();
   }
 
@@ -114,7 +139,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A const lvalue element to be passed/added/pushed.
   Status Push(int32_t worker_id, const T &el) noexcept {
-    DS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
+    DS_ASSERT(worker_id < num_producers_);
+    if (lock_free_) {
+      return (rings_[worker_id]->Add(el));
+    }
     DS_ASSERT(queues_[worker_id] != nullptr);
     return (queues_[worker_id]->Add(el));
   }
@@ -125,7 +153,10 @@ class Connector {
   // @param worker_id The id of a worker thread calling this method.
   // @param el An element to be passed/added/pushed.
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
-    DS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
+    DS_ASSERT(worker_id < num_producers_);
+    if (lock_free_) {
+      return (rings_[worker_id]->Add(std::forward<T>(el)));
+    }
     DS_ASSERT(queues_[worker_id] != nullptr);
     return (queues_[worker_id]->Add(std::forward<T>(el)));
   }
@@ -136,6 +167,9 @@ class Connector {
     for (int i = 0; i < queues_.size(); ++i) {
       queues_[i]->ResetQue();
     }
+    for (int i = 0; i < rings_.size(); ++i) {
+      rings_[i]->ResetQue();
+    }
     expect_consumer_ = 0;
     pop_from_ = 0;
     MS_LOG(INFO) << "Connector counters reset.";
@@ -144,9 +178,60 @@ class Connector {
   void Print(std::ostream &out, bool showAll) const {
     out << "\n--------- Connector ------------"
         << "\nConnector Name           : " << my_name_ << "\nNumber of consumers      : " << num_consumers_
-        << "\nNumber of producers      : " << num_producers_ << "\n";
+        << "\nNumber of producers      : " << num_producers_ << "\nLock free                : " << lock_free_
+        << "\nOrdered                  : " << ordered_ << "\n";
   }
 
+  // Getter
+  // @return The number of elements waiting in all the internal queues. Only a hint while the Connector is in use.
+  int32_t size() {
+    int32_t total = 0;
+    for (int32_t i = 0; i < queues_.size(); ++i) {
+      total += queues_[i]->size();
+    }
+    for (int32_t i = 0; i < rings_.size(); ++i) {
+      total += rings_[i]->size();
+    }
+    return total;
+  }
+
+  // Getter
+  // @return The number of elements all the internal queues can hold
+  int32_t capacity() const { return num_producers_ * queue_capacity_; }
+
+  // Getter
+  // @return The number of elements each internal queue can hold
+  int32_t queue_capacity() const { return queue_capacity_; }
+
+  // Getter
+  // @return The number of slots allocated for each internal queue. It bounds set_queue_capacity().
+  int32_t max_queue_capacity() {
+    if (lock_free_) {
+      return rings_.size() > 0 ? rings_[0]->max_capacity() : 0;
+    }
+    return queues_.size() > 0 ? queues_[0]->max_capacity() : 0;
+  }
+
+  // Changes the capacity of every internal queue while the Connector is in use.
+  // @param queue_capacity The new capacity, clamped between 1 and max_queue_capacity().
+  void set_queue_capacity(int32_t queue_capacity) {
+    for (int32_t i = 0; i < queues_.size(); ++i) {
+      queues_[i]->set_capacity(queue_capacity);
+    }
+    for (int32_t i = 0; i < rings_.size(); ++i) {
+      rings_[i]->set_capacity(queue_capacity);
+    }
+    queue_capacity_ = std::min(std::max(queue_capacity, 1), max_queue_capacity());
+  }
+
+  // Getter
+  // @return T/F if the Connector is backed by ring buffers
+  bool lock_free() const { return lock_free_; }
+
+  // Getter
+  // @return T/F if the Connector preserves the order of the elements
+  bool ordered() const { return ordered_; }
+
   friend std::ostream &operator<<(std::ostream &out, const Connector &con) {
     con.print(out, false);
     return out;
@@ -156,7 +241,7 @@ class Connector {
   // @param vg
   // @return
   Status Register(TaskGroup *vg) {
-    Status rc = queues_.Register(vg);
+    Status rc = lock_free_ ? rings_.Register(vg) : queues_.Register(vg);
     if (rc.IsOk()) {
       rc = cv_.Register(vg->GetIntrpService());
     }
@@ -164,19 +249,103 @@ class Connector {
   }
 
  protected:
+  // Block the caller until it is the expect_consumer_.
+  // @param worker_id The id of the calling consumer.
+  // @param lk The lock on m_ to hold while having the turn. Not used by the lock free backend.
+  // @return Status - The error code return
+  Status AcquireTurn(int32_t worker_id, std::unique_lock<std::mutex> *lk) {
+    if (!lock_free_) {
+      *lk = std::unique_lock<std::mutex>(m_);
+      return cv_.Wait(lk, [this, worker_id]() { return expect_consumer_ == worker_id; });
+    }
+    return WaitFor([this, worker_id]() { return expect_consumer_.load(std::memory_order_acquire) == worker_id; });
+  }
+
+  // Give up the turn acquired by AcquireTurn().
+  // @param lk The lock acquired by AcquireTurn().
+  // @param advance If false, the same consumer keeps the turn.
+  void ReleaseTurn(std::unique_lock<std::mutex> *lk, bool advance) {
+    if (!lock_free_) {
+      if (advance) {
+        expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
+      }
+      lk->unlock();
+      cv_.NotifyAll();
+    } else if (advance) {
+      expect_consumer_.store((expect_consumer_.load(std::memory_order_relaxed) + 1) % num_consumers_,
+                             std::memory_order_release);
+    }
+  }
+
+  // Pop the next element of one internal queue. This blocks when that queue is empty.
+  Status PopFromQueue(int32_t queue_id, T *result) {
+    return lock_free_ ? rings_[queue_id]->PopFront(result) : queues_[queue_id]->PopFront(result);
+  }
+
+  // Try to pop an element without blocking, from the first internal queue that has one.
+  // Used when the Connector is unordered. Queues are visited round robin from a moving start point so that
+  // no producer gets starved.
+  // @param queue_id The queue where the element is popped from.
+  // @param result The address of an object where the popped element will be placed.
+  // @return T/F if an element was popped
+  bool TryPopFromAnyQueue(int32_t *queue_id, T *result) {
+    auto start = static_cast<int32_t>(next_scan_.fetch_add(1, std::memory_order_relaxed) % num_producers_);
+    for (int32_t offset = 0; offset < num_producers_; offset++) {
+      int32_t qid = (start + offset) % num_producers_;
+      if (rings_[qid]->TryPopFront(result)) {
+        *queue_id = qid;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Pop from whichever internal queue has an element. Blocks when all the queues are empty.
+  Status PopFromAnyQueue(T *result) {
+    int32_t queue_id = 0;
+    return WaitFor([this, &queue_id, result]() { return TryPopFromAnyQueue(&queue_id, result); });
+  }
+
+  // Poll f until it succeeds or the Connector gets interrupted. This is where the lock free backend waits.
+  Status WaitFor(const std::function<bool()> &f) {
+    int32_t spin = 0;
+    while (!f()) {
+      if (cv_.Interrupted()) {
+        return Status(StatusCode::kInterrupted);
+      }
+      RETURN_IF_INTERRUPTED();
+      if (spin < kRingBufferSpinCount) {
+        ++spin;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    return Status::OK();
+  }
+
   std::string my_name_;
 
   // A list of Queues that are thread safe.
   QueueList<T> queues_;
 
+  // The lock free replacement of queues_.
+  RingBufferList<T> rings_;
+
   // The consumer that we allow to get the next data from pop()
-  int32_t expect_consumer_;
+  std::atomic<int32_t> expect_consumer_;
 
   // The index to the queues_ where the next data should be popped.
   int32_t pop_from_;
 
   int32_t num_producers_;
   int32_t num_consumers_;
+  std::atomic<int32_t> queue_capacity_;
+
+  bool lock_free_;
+  bool ordered_;
+
+  // Where an unordered pop starts looking for data.
+  std::atomic<uint32_t> next_scan_{0};
 
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
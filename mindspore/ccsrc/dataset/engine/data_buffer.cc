@@ -126,6 +126,11 @@ Status DataBuffer::SliceOff(int64_t number_of_rows) {
   return Status::OK();
 }
 
+const ColumnNameMap &DataBuffer::column_name_map() const {
+  static const ColumnNameMap kNoColumns;
+  return (column_name_map_ == nullptr) ? kNoColumns : *column_name_map_;
+}
+
 // Destructor
 DataBuffer::~DataBuffer() {}
 }  // namespace dataset
@@ -33,6 +33,15 @@ namespace dataset {
 // Forward declares
 class StorageClient;
 
+// The index of each column by its name. A mapping is immutable once it is set on a buffer, so the buffers of an op
+// share one mapping instead of a copy each.
+using ColumnNameMap = std::unordered_map<std::string, int32_t>;
+
+// @return T/F if two mappings have the same columns, without a compare when the mapping is shared
+inline bool SameColumns(const std::shared_ptr<const ColumnNameMap> &a, const std::shared_ptr<const ColumnNameMap> &b) {
+  return (a == b) || (a != nullptr && b != nullptr && *a == *b);
+}
+
 // The DataBuffer class is a base class that will represent the data for n values based
 // on a unique row id for each row of data.
 // There can be different types of DataBuffers to abstract over how the data is stored
@@ -77,6 +86,11 @@ class DataBuffer {
   // Description: populates the DataBuffer with data based on it's id
   virtual Status Load();
 
+  // Name: fetch()
+  // Description: reads the raw data of the buffer ahead of the load, so the read of a buffer can overlap
+  //              with the load of another one. The load reads the data itself if it was not fetched.
+  virtual Status Fetch() { return Status::OK(); }
+
   // Convenience getter functions for flag checking
   bool eof() const { return (static_cast<uint32_t>(buffer_flags_) & static_cast<uint32_t>(kDeBFlagEOF)); }
 
@@ -107,16 +121,27 @@ class DataBuffer {
   Status SliceOff(int64_t number_of_rows);
 
   // Return a mapping from col names to col id.
-  std::unordered_map<std::string, int32_t> column_name_map() const { return column_name_map_; }
+  const ColumnNameMap &column_name_map() const;
+
+  // Return the shared mapping, which can be set on other buffers without a copy.
+  std::shared_ptr<const ColumnNameMap> shared_column_name_map() const { return column_name_map_; }
 
   // Update the column name to index mapping.
-  void set_column_name_map(const std::unordered_map<std::string, int32_t> &new_col_name_map) {
-    column_name_map_ = new_col_name_map;
+  void set_column_name_map(const ColumnNameMap &new_col_name_map) {
+    column_name_map_ = std::make_shared<const ColumnNameMap>(new_col_name_map);
+  }
+
+  // Update the column name to index mapping with a shared one.
+  void set_column_name_map(std::shared_ptr<const ColumnNameMap> new_col_name_map) {
+    column_name_map_ = std::move(new_col_name_map);
   }
 
   // Replacing mTensorTable, the unique_ptr assignment will release the old TensorTable.
   void set_tensor_table(std::unique_ptr<TensorQTable> new_table) { tensor_table_ = std::move(new_table); }
 
+  // Takes the whole table out of the buffer without touching its rows, the buffer is left with no row.
+  std::unique_ptr<TensorQTable> TakeTensorTable() { return std::move(tensor_table_); }
+
   void set_flag(BufferFlags in_flag) {
     buffer_flags_ = static_cast<BufferFlags>(static_cast<uint32_t>(buffer_flags_) | static_cast<uint32_t>(in_flag));
   }
@@ -131,10 +156,10 @@ class DataBuffer {
   }
 
  protected:
-  int32_t buffer_id_;                                         // An id for the buffer.
-  std::unique_ptr<TensorQTable> tensor_table_;                // A table (row major) of Tensors
-  BufferFlags buffer_flags_;                                  // bit mask for various buffer properties
-  std::unordered_map<std::string, int32_t> column_name_map_;  // A mapping between column index to column name.
+  int32_t buffer_id_;                                     // An id for the buffer.
+  std::unique_ptr<TensorQTable> tensor_table_;            // A table (row major) of Tensors
+  BufferFlags buffer_flags_;                              // bit mask for various buffer properties
+  std::shared_ptr<const ColumnNameMap> column_name_map_;  // A mapping between column index to column name.
 };
 }  // namespace dataset
 }  // namespace mindspore
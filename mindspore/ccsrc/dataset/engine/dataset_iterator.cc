@@ -47,13 +47,18 @@ Status IteratorBase::GetNextAsMap(TensorMap *out_map) {
   }
 
   // Populate the out map from the row and return it
-  for (auto colMap : col_name_id_map_) {
+  for (const auto &colMap : col_name_id_map()) {
     (*out_map)[colMap.first] = std::move(curr_row[colMap.second]);
   }
 
   return Status::OK();
 }
 
+const ColumnNameMap &IteratorBase::col_name_id_map() const {
+  static const ColumnNameMap kNoColumns;
+  return (col_name_id_map_ == nullptr) ? kNoColumns : *col_name_id_map_;
+}
+
 // Fetches one row of data from the iterator.
 // The base class version simply performs error handling and returns empty row. Actual
 // functionality exists in the derived versions of this function.
@@ -69,7 +74,8 @@ Status IteratorBase::FetchNextTensorRow(TensorRow *out_row) {
 }
 
 // Constructor of the DatasetIterator
-DatasetIterator::DatasetIterator(std::shared_ptr<ExecutionTree> exe_tree) : IteratorBase(), root_(exe_tree->root()) {}
+DatasetIterator::DatasetIterator(std::shared_ptr<ExecutionTree> exe_tree)
+    : IteratorBase(), root_(exe_tree->root()), rows_fetched_(0) {}
 
 DatasetIterator::~DatasetIterator() = default;
 
@@ -87,7 +93,7 @@ Status DatasetIterator::FetchNextTensorRow(TensorRow *out_row) {
 
   // Check if we need to get a new DataBuffer to iterate.
   if (curr_buffer_ == nullptr || curr_buffer_->NumRows() == 0) {
-    col_name_id_map_.clear();
+    col_name_id_map_.reset();
     RETURN_IF_NOT_OK(root_->GetNextBuffer(&curr_buffer_));
 
     // Since GetNextBuffer was used rather than GetNextInput(), it means we need to manually
@@ -121,11 +127,12 @@ Status DatasetIterator::FetchNextTensorRow(TensorRow *out_row) {
       return Status::OK();
     }
 
-    col_name_id_map_ = curr_buffer_->column_name_map();
+    col_name_id_map_ = curr_buffer_->shared_column_name_map();
   }
 
   // If we got this far, now it's time to pop that next row for return to caller
   RETURN_IF_NOT_OK(curr_buffer_->PopRow(out_row));
+  rows_fetched_++;
 
   return Status::OK();
 }
@@ -177,7 +184,7 @@ Status ChildIterator::FetchNextTensorRow(TensorRow *out_row) {
 
   // Check if we need to get a new DataBuffer to iterate.
   if (curr_buffer_ == nullptr || curr_buffer_->NumRows() == 0) {
-    col_name_id_map_.clear();
+    col_name_id_map_.reset();
     RETURN_IF_NOT_OK(current_op_->GetNextInput(&curr_buffer_, worker_id_, child_idx_));
 
     // Unlike the DatasetIterator, this child iterator does not quit after eoe.
@@ -195,7 +202,7 @@ Status ChildIterator::FetchNextTensorRow(TensorRow *out_row) {
       return Status::OK();
     }
 
-    col_name_id_map_ = curr_buffer_->column_name_map();
+    col_name_id_map_ = curr_buffer_->shared_column_name_map();
   }
 
   // If we got this far, now it's time to pop that next row for return to caller
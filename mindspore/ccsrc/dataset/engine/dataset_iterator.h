@@ -22,6 +22,7 @@
 #include <vector>
 #include "dataset/util/status.h"
 #include "dataset/core/tensor.h"
+#include "dataset/engine/data_buffer.h"
 #include "dataset/engine/datasetops/dataset_op.h"
 #include "dataset/engine/execution_tree.h"
 
@@ -66,13 +67,17 @@ class IteratorBase {
 
   // Getter
   // @return The string to column id mapping.
-  std::unordered_map<std::string, int32_t> col_name_id_map() const { return col_name_id_map_; }
+  const ColumnNameMap &col_name_id_map() const;
+
+  // Getter
+  // @return The mapping shared with the current data buffer, nullptr before the first row.
+  std::shared_ptr<const ColumnNameMap> shared_col_name_id_map() const { return col_name_id_map_; }
 
  protected:
   std::unique_ptr<DataBuffer> curr_buffer_;  // holds the current buffer
 
   // The column name-id mapping for the current data buffer.
-  std::unordered_map<std::string, int32_t> col_name_id_map_;
+  std::shared_ptr<const ColumnNameMap> col_name_id_map_;
 
   bool eof_handled_;  // T/F if this op got an eof
 };
@@ -104,9 +109,18 @@ class DatasetIterator : public IteratorBase {
   // @return Status - The error code return
   Status GetOutputTypes(std::vector<DataType> *out_types);
 
+  // Getter
+  // @return The rows fetched from the root, the position for ExecutionTree::SaveState
+  int64_t rows_fetched() const { return rows_fetched_; }
+
+  // Setter
+  // @param rows - The rows fetched before the tree resumed from a saved state
+  void set_rows_fetched(int64_t rows) { rows_fetched_ = rows; }
+
  private:
   std::shared_ptr<DatasetOp> root_;  // saves the root of the executionTree
   TensorRow device_queue_row_;
+  int64_t rows_fetched_;
 };
 
 // The ChildIterator derived class is for fetching rows from intermediate nodes of execution tree.
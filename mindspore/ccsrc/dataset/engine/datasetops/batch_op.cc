@@ -14,14 +14,18 @@
  * limitations under the License.
  */
 #include "dataset/engine/datasetops/batch_op.h"
+#include <algorithm>
 #include <utility>
 #include "common/utils.h"
 #include "dataset/engine/data_buffer.h"
+#include "dataset/engine/datasetops/batch_slot_pool.h"
+#include "dataset/engine/datasetops/map_op.h"
 #include "dataset/engine/db_connector.h"
+#include "dataset/kernels/data/data_utils.h"
 
 namespace mindspore {
 namespace dataset {
-BatchOp::Builder::Builder(int32_t batch_size) : builder_drop_(false) {
+BatchOp::Builder::Builder(int32_t batch_size) : builder_drop_(false), builder_in_place_(false) {
   builder_batch_size_ = batch_size;
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   builder_num_workers_ = cfg->num_parallel_workers();
@@ -31,7 +35,8 @@ BatchOp::Builder::Builder(int32_t batch_size) : builder_drop_(false) {
 Status BatchOp::Builder::Build(std::shared_ptr<BatchOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<BatchOp>(builder_batch_size_, builder_drop_, builder_op_connector_size_, builder_num_workers_,
-                                   builder_cols_to_map_, builder_batch_size_func_, builder_batch_map_func_);
+                                   builder_cols_to_map_, builder_batch_size_func_, builder_batch_map_func_,
+                                   builder_in_place_, builder_pad_info_, builder_bucketing_);
   return Status::OK();
 }
 
@@ -40,33 +45,59 @@ Status BatchOp::Builder::SanityCheck() {
   err += builder_op_connector_size_ <= 0 ? "connector size <= 0\n" : "";
   err += builder_batch_size_ <= 0 ? "batch size <= 0\n" : "";
   err += builder_num_workers_ <= 0 ? "batch num_parallel_workers <= 0\n" : "";
+  const std::vector<int32_t> &boundaries = builder_bucketing_.boundaries;
+  if (!boundaries.empty()) {
+    const std::vector<int32_t> &sizes = builder_bucketing_.batch_sizes;
+    err += builder_bucketing_.length_column.empty() ? "bucketing needs a length column\n" : "";
+    err += builder_batch_size_func_ != nullptr ? "bucketing does not take a batch size function\n" : "";
+    err += sizes.size() != boundaries.size() + 1 ? "bucket batch sizes should be one more than the boundaries\n" : "";
+    err += std::any_of(sizes.begin(), sizes.end(), [](int32_t size) { return size <= 0; }) ? "bucket batch size <= 0\n"
+                                                                                             : "";
+    err += boundaries[0] <= 0 ? "bucket boundary <= 0\n" : "";
+    err += std::adjacent_find(boundaries.begin(), boundaries.end(), std::greater_equal<int32_t>()) != boundaries.end()
+             ? "bucket boundaries are not increasing\n"
+             : "";
+  }
   return err.empty() ? Status::OK() : Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, common::SafeCStr(err));
 }
 
 BatchOp::BatchOp(int32_t batch_size, bool drop, int32_t op_queue_size, int32_t num_workers,
-                 const std::vector<std::string> &cols_to_map, py::function batch_size_func, py::function batch_map_func)
+                 const std::vector<std::string> &cols_to_map, py::function batch_size_func, py::function batch_map_func,
+                 bool in_place, const PadInfo &pad_info, const Bucketing &bucketing)
     : ParallelOp(num_workers, op_queue_size),
       start_batch_size_(batch_size),
       drop_(drop),
       input_column_names_(cols_to_map),
       batch_size_func_(batch_size_func),
-      batch_map_func_(batch_map_func) {
+      batch_map_func_(batch_map_func),
+      in_place_(in_place),
+      start_epoch_num_(0),
+      start_batch_num_(0),
+      pad_info_(pad_info),
+      bucketing_(bucketing),
+      length_column_(0) {
   worker_queues_.Init(num_workers, op_queue_size);
 }
 
 Status BatchOp::operator()() {
   RETURN_IF_NOT_OK(LaunchThreadsAndInitOp());
   TaskManager::FindMe()->Post();
-  int32_t epoch_num = 0, batch_num = 0, cnt = 0;
+  int32_t epoch_num = start_epoch_num_, batch_num = start_batch_num_, cnt = 0;
   TensorRow new_row;
   std::unique_ptr<TensorQTable> table = make_unique<TensorQTable>();
   child_iterator_ = mindspore::make_unique<ChildIterator>(this, 0, 0);
   RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
-  column_name_map_ = child_iterator_->col_name_id_map();
+  column_name_map_ = child_iterator_->shared_col_name_id_map();
+  RETURN_IF_NOT_OK(InitColumns());
   int32_t cur_batch_size = 0;
-  RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(0, 0, 0)));
+  RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, 0)));
   while (child_iterator_->eof_handled() == false) {
     while (new_row.empty() == false) {
+      if (!buckets_.empty()) {
+        RETURN_IF_NOT_OK(AddToBucket(std::move(new_row), epoch_num, &batch_num, &cnt));
+        RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+        continue;
+      }
       table->emplace_back(new_row);
       // if # of rows is enough to make 1 batch (1 batch is buffer), send it to worker_queue
       if (table->size() == static_cast<size_t>(cur_batch_size)) {
@@ -82,6 +113,16 @@ Status BatchOp::operator()() {
       RETURN_IF_NOT_OK(worker_queues_[cnt++ % num_workers_]->EmplaceBack(
         std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt - epoch_num))));
     }
+    // the buckets which are not full are sent as smaller batches, from the shortest rows up
+    for (size_t i = 0; i < buckets_.size(); i++) {
+      if (drop_ == false && buckets_[i]->empty() == false) {
+        CBatchInfo info(epoch_num, batch_num++, cnt - epoch_num);
+        info.bucket_ = static_cast<int32_t>(i);
+        RETURN_IF_NOT_OK(
+          worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(std::move(buckets_[i]), info)));
+      }
+      buckets_[i] = make_unique<TensorQTable>();
+    }
     table = make_unique<TensorQTable>();  // this drops when drop == true
     // end of the current epoch, batch_num should start from 0 again
     batch_num = 0;
@@ -105,19 +146,163 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
   ParallelOp::Print(out, show_all);
   out << "\nBatchOp:\n"
       << "number of parallel workers: " << num_workers_ << "\nBatch size: " << start_batch_size_
-      << "\nDrop remainder: " << (drop_ ? "yes" : "no") << "\n\n";
+      << "\nDrop remainder: " << (drop_ ? "yes" : "no") << "\nNumber of padded columns: " << pad_info_.size();
+  if (!bucketing_.boundaries.empty()) {
+    out << "\nBucketing by length of column: " << bucketing_.length_column
+        << "\nNumber of buckets: " << bucketing_.batch_sizes.size();
+  }
+  out << "\n\n";
+}
+
+Status BatchOp::InitColumns() {
+  RETURN_UNEXPECTED_IF_NULL(column_name_map_);
+  pad_columns_.clear();
+  for (const auto &pad : pad_info_) {
+    auto itr = column_name_map_->find(pad.first);
+    if (itr == column_name_map_->end()) {
+      RETURN_STATUS_UNEXPECTED("column to pad : '" + pad.first + "' does not exist\n");
+    }
+    (void)pad_columns_.emplace(static_cast<size_t>(itr->second), pad.second);
+  }
+  if (!bucketing_.boundaries.empty()) {
+    auto itr = column_name_map_->find(bucketing_.length_column);
+    if (itr == column_name_map_->end()) {
+      RETURN_STATUS_UNEXPECTED("length column : '" + bucketing_.length_column + "' does not exist\n");
+    }
+    length_column_ = static_cast<size_t>(itr->second);
+    buckets_.clear();
+    for (size_t i = 0; i < bucketing_.batch_sizes.size(); i++) {
+      buckets_.push_back(make_unique<TensorQTable>());
+    }
+  }
+  return Status::OK();
+}
+
+Status BatchOp::AddToBucket(TensorRow &&row, int32_t epoch_num, int32_t *batch_num, int32_t *cnt) {
+  if (length_column_ >= row.size() || row[length_column_]->Rank() == 0) {
+    RETURN_STATUS_UNEXPECTED("[Batch ERROR] The length column of a row should have a rank of at least 1\n");
+  }
+  dsize_t length = row[length_column_]->shape()[0];
+  const std::vector<int32_t> &boundaries = bucketing_.boundaries;
+  size_t bucket = static_cast<size_t>(std::upper_bound(boundaries.begin(), boundaries.end(), length) -
+                                      boundaries.begin());
+  buckets_[bucket]->emplace_back(std::move(row));
+  if (buckets_[bucket]->size() == static_cast<size_t>(bucketing_.batch_sizes[bucket])) {
+    CBatchInfo info(epoch_num, (*batch_num)++, *cnt - epoch_num);
+    info.bucket_ = static_cast<int32_t>(bucket);
+    RETURN_IF_NOT_OK(
+      worker_queues_[(*cnt)++ % num_workers_]->EmplaceBack(std::make_pair(std::move(buckets_[bucket]), info)));
+    buckets_[bucket] = make_unique<TensorQTable>();
+  }
+  return Status::OK();
+}
+
+Status BatchOp::PadColumn(const TensorQTable &rows, size_t col, int32_t bucket,
+                          std::shared_ptr<Tensor> *batched) const {
+  const std::pair<TensorShape, float> &pad = pad_columns_.at(col);
+  TensorShape pad_shape = pad.first;
+  const std::vector<int32_t> &boundaries = bucketing_.boundaries;
+  if (bucketing_.pad_to_boundary && bucket >= 0 && static_cast<size_t>(bucket) < boundaries.size()) {
+    std::vector<dsize_t> dims = pad_shape.AsVector();
+    if (dims.empty()) {
+      dims.assign(static_cast<size_t>(rows.front()[col]->Rank()), TensorShape::kDimUnknown);
+    }
+    if (!dims.empty() && dims[0] == TensorShape::kDimUnknown) {
+      dims[0] = boundaries[bucket] - 1;
+    }
+    pad_shape = TensorShape(dims);
+  }
+  std::vector<std::shared_ptr<Tensor>> column;
+  column.reserve(rows.size());
+  for (const TensorRow &row : rows) {
+    column.push_back(row[col]);
+  }
+  return BatchPad(column, pad_shape, pad.second, batched);
+}
+
+Status BatchOp::PrepareNodeAction() {
+  RETURN_IF_NOT_OK(ParallelOp::PrepareNodeAction());
+  if (!in_place_) {
+    return Status::OK();
+  }
+  auto map_op = child_.empty() ? nullptr : std::dynamic_pointer_cast<MapOp>(child_[0]);
+  if (batch_size_func_ != nullptr || batch_map_func_ != nullptr || !bucketing_.boundaries.empty() ||
+      map_op == nullptr || !map_op->BatchSlotsSupported()) {
+    MS_LOG(INFO) << "In place batching needs a fixed batch size, no per batch map and a child MapOp with one 1-1 "
+                 << "output column in performance mode. The rows are copied.";
+    return Status::OK();
+  }
+  batch_slots_ = std::make_shared<BatchSlotPool>(start_batch_size_);
+  map_op->set_batch_slots(batch_slots_);
+  return Status::OK();
+}
+
+bool BatchOp::BatchedInPlace(const TensorQTable &rows, size_t col, std::shared_ptr<Tensor> *batched) {
+  if (rows.empty() || col >= rows[0].size()) {
+    return false;
+  }
+  const std::shared_ptr<Tensor> &first = rows[0][col];
+  const std::shared_ptr<Tensor> &base = first->view_base();
+  // The rows must be the consecutive slots of one batch tensor, starting with the first one
+  if (base == nullptr || base->Rank() != first->Rank() + 1 || base->shape()[0] < static_cast<dsize_t>(rows.size()) ||
+      first->StartAddr() != base->StartAddr()) {
+    return false;
+  }
+  dsize_t row_bytes = first->SizeInBytes();
+  for (size_t j = 0; j < rows.size(); j++) {
+    if (col >= rows[j].size()) {
+      return false;
+    }
+    const std::shared_ptr<Tensor> &t = rows[j][col];
+    if (t->view_base() != base || t->shape() != first->shape() || t->type() != first->type() ||
+        t->StartAddr() != base->StartAddr() + j * row_bytes) {
+      return false;
+    }
+  }
+  if (base->shape()[0] == static_cast<dsize_t>(rows.size())) {
+    *batched = base;
+    return true;
+  }
+  // A partial batch only uses the front of the batch tensor
+  return Tensor::CreateView(batched, base, {0}, first->shape().PrependDim(static_cast<int64_t>(rows.size()))).IsOk();
 }
 
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *source_table,
-                          const std::unique_ptr<TensorQTable> *dest_table, size_t batch_size) {
+                          const std::unique_ptr<TensorQTable> *dest_table, size_t batch_size, int32_t bucket) {
   if ((*source_table)->size() < batch_size || (*source_table)->size() == 0) {
     RETURN_STATUS_UNEXPECTED("[Internal Batch ERROR] Insufficient rows in source_table\n");
   }
+  // The padded columns are batched at once, they are left out of the copies below
+  TensorRow padded;
+  if (!pad_columns_.empty()) {
+    padded.resize((*source_table)->front().size());
+    for (const auto &pad : pad_columns_) {
+      if (pad.first < padded.size()) {
+        RETURN_IF_NOT_OK(PadColumn(**source_table, pad.first, bucket, &padded[pad.first]));
+      }
+    }
+  }
+  // In place mode, the columns computed into their batch slots are already batched
+  TensorRow in_place;
+  if (batch_slots_ != nullptr && (*source_table)->size() == batch_size) {
+    in_place.resize((*source_table)->front().size());
+    for (size_t i = 0; i < in_place.size(); i++) {
+      if (!BatchedInPlace(**source_table, i, &in_place[i])) {
+        in_place[i] = nullptr;
+      }
+    }
+  }
   TensorRow row = std::move((*source_table)->front());
   (*source_table)->pop_front();
   if (batch_size == 1) {
-    for (std::shared_ptr<Tensor> tensor : row) {
-      RETURN_IF_NOT_OK(tensor->ExpandDim(0));
+    for (size_t i = 0; i < row.size(); i++) {
+      if (i < padded.size() && padded[i] != nullptr) {
+        row[i] = padded[i];
+      } else if (i < in_place.size() && in_place[i] != nullptr) {
+        row[i] = in_place[i];
+      } else {
+        RETURN_IF_NOT_OK(row[i]->ExpandDim(0));
+      }
     }
     (*dest_table)->push_back(row);
   } else {  // batch_size > 1
@@ -125,6 +310,14 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *source_table,
     TensorRow batched_row;
     for (size_t i = 0; i < row.size(); i++) {  // Handle the first row popped
       row_shapes.push_back(row[i]->shape());
+      if (i < padded.size() && padded[i] != nullptr) {
+        batched_row.emplace_back(padded[i]);
+        continue;
+      }
+      if (i < in_place.size() && in_place[i] != nullptr) {
+        batched_row.emplace_back(in_place[i]);
+        continue;
+      }
       std::shared_ptr<Tensor> ts;
       RETURN_IF_NOT_OK(Tensor::CreateTensor(
         &ts, TensorImpl::kFlexible, row[i]->shape().PrependDim(static_cast<int64_t>(batch_size)), row[i]->type()));
@@ -135,11 +328,15 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *source_table,
       row = std::move((*source_table)->front());
       (*source_table)->pop_front();
       for (size_t i = 0; i < row.size(); i++) {
-        if (row[i]->shape() == row_shapes[i]) {  // check the newly popped rows have the same dim as the first
-          RETURN_IF_NOT_OK(batched_row[i]->InsertTensor(std::vector<dsize_t>(1, j), row[i]));
-        } else {
+        if (i < padded.size() && padded[i] != nullptr) {
+          continue;
+        }
+        if (row[i]->shape() != row_shapes[i]) {  // check the newly popped rows have the same dim as the first
           RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent TensorShapes\n");
         }
+        if (i >= in_place.size() || in_place[i] == nullptr) {
+          RETURN_IF_NOT_OK(batched_row[i]->InsertTensor(std::vector<dsize_t>(1, j), row[i]));
+        }
       }
     }
     (*dest_table)->emplace_back(batched_row);
@@ -158,7 +355,10 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       std::unique_ptr<DataBuffer> db = nullptr;
-      RETURN_IF_NOT_OK(MakeBatchedBuffer(std::move(table_pair), &db));
+      RETURN_IF_NOT_OK(AcquireWorker());
+      Status rc = MakeBatchedBuffer(std::move(table_pair), &db);
+      ReleaseWorker();
+      RETURN_IF_NOT_OK(rc);
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::move(db)));
     }
     RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
@@ -172,12 +372,35 @@ Status BatchOp::MakeBatchedBuffer(std::pair<std::unique_ptr<TensorQTable>, CBatc
   if (!input_column_names_.empty()) RETURN_IF_NOT_OK(MapColumns(&table_pair));  // pass it through pyfunc
   (*db) = make_unique<DataBuffer>(table_pair.second.batch_num_, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> dest_table = make_unique<TensorQTable>();
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size()));
+  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size(), table_pair.second.bucket_));
   (*db)->set_tensor_table(std::move(dest_table));
   (*db)->set_column_name_map(column_name_map_);
   return Status::OK();
 }
 
+Status BatchOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  if (batch_size_func_ != nullptr) {
+    RETURN_STATUS_UNEXPECTED("BatchOp with a batch size function does not support saving the state of the pipeline.");
+  }
+  if (!bucketing_.boundaries.empty()) {
+    RETURN_STATUS_UNEXPECTED("BatchOp with bucketing does not support saving the state of the pipeline.");
+  }
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["epoch"] = pos.pass;
+  (*op_state)["batch"] = pos.rows;
+  return child_[0]->SaveState(Position{pos.pass, pos.rows * start_batch_size_}, state);
+}
+
+Status BatchOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state != nullptr) {
+    start_epoch_num_ = (*op_state)["epoch"].get<int32_t>();
+    start_batch_num_ = (*op_state)["batch"].get<int32_t>();
+  }
+  return Status::OK();
+}
+
 Status BatchOp::LaunchThreadsAndInitOp() {
   RETURN_UNEXPECTED_IF_NULL(tree_);
   RETURN_IF_NOT_OK(worker_queues_.Register(tree_->AllTasks()));
@@ -195,13 +418,17 @@ Status BatchOp::EoeReceived(int32_t) {
 Status BatchOp::MapColumns(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> *table_pair) {
   TensorBatchTable input_table;
   input_table.reserve(input_column_names_.size());
+  RETURN_UNEXPECTED_IF_NULL(column_name_map_);
+  std::vector<size_t> col_indices;
   for (std::string col_name : input_column_names_) {
-    if (column_name_map_.find(col_name) == column_name_map_.end()) {
+    auto itr = column_name_map_->find(col_name);
+    if (itr == column_name_map_->end()) {
       RETURN_STATUS_UNEXPECTED("column : '" + col_name + "' does not exist\n");
     }
     TensorBatch tensor_batch;
     tensor_batch.reserve(table_pair->first->size());
-    size_t col_idx = static_cast<size_t>(column_name_map_[col_name]);
+    size_t col_idx = static_cast<size_t>(itr->second);
+    col_indices.push_back(col_idx);
     for (size_t row_idx = 0; row_idx < table_pair->first->size(); row_idx++) {
       tensor_batch.push_back(std::move(table_pair->first->at(row_idx)[col_idx]));
     }
@@ -214,7 +441,7 @@ Status BatchOp::MapColumns(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>
 
   // Write back to TensorQTable
   for (size_t input_idx = 0; input_idx < input_column_names_.size(); input_idx++) {
-    size_t col_idx = static_cast<size_t>(column_name_map_[input_column_names_[input_idx]]);
+    size_t col_idx = col_indices[input_idx];
     size_t row_id = 0;
     for (TensorRow &row : *(table_pair->first)) {
       row[col_idx] = std::move(output_table[input_idx][row_id++]);
@@ -267,8 +494,9 @@ Status BatchOp::InvokeBatchMapFunc(TensorBatchTable *input, TensorBatchTable *ou
       for (size_t i = 0; i < input->size(); i++) {
         std::vector<py::array> np_batch;
         for (std::shared_ptr<Tensor> t : input->at(i)) {
+          // The rows may be shared, e.g. by a cache, so the function gets read only views of them
           py::array np_array;
-          RETURN_IF_NOT_OK(t->GetDataAsNumpy(&np_array));
+          RETURN_IF_NOT_OK(Tensor::ShareDataAsNumpy(t, &np_array, false));
           np_batch.push_back(std::move(np_array));
         }
         input_args[i] = np_batch;
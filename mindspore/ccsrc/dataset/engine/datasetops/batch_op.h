@@ -16,6 +16,7 @@
 #ifndef DATASET_ENGINE_DATASETOPS_BATCH_OP_H_
 #define DATASET_ENGINE_DATASETOPS_BATCH_OP_H_
 
+#include <map>
 #include <memory>
 #include <queue>
 #include <string>
@@ -31,13 +32,26 @@
 
 namespace mindspore {
 namespace dataset {
+class BatchSlotPool;
 class DataBuffer;
 
 using TensorBatch = std::vector<std::shared_ptr<Tensor>>;
 using TensorBatchTable = std::vector<TensorBatch>;
+// The columns to pad with the shape to pad them to and the value of the padding, see BatchPad. The unknown dims
+// of a shape are padded to the largest of the batch.
+using PadInfo = std::map<std::string, std::pair<TensorShape, float>>;
 
 class BatchOp : public ParallelOp {
  public:
+  // The bucketing of the rows by length, off when there is no boundary
+  struct Bucketing {
+    Bucketing() : pad_to_boundary(false) {}
+    std::string length_column;
+    std::vector<int32_t> boundaries;
+    std::vector<int32_t> batch_sizes;
+    bool pad_to_boundary;
+  };
+
   class Builder {
    public:
     // Builder constructor for Batch, batch size needs to be specified
@@ -99,6 +113,39 @@ class BatchOp : public ParallelOp {
       return *this;
     }
 
+    // set in place mode for batch op, default false
+    // @param bool in_place - T/F to allocate the batches before a child MapOp computes their rows, see in_place_
+    // @return Builder & reference to builder class object
+    Builder &SetInPlace(bool in_place) {
+      builder_in_place_ = in_place;
+      return *this;
+    }
+
+    // set the columns to pad, the other columns must have the same shape in a batch
+    // @param const PadInfo &pad_info - the columns to pad
+    // @return Builder & reference to builder class object
+    Builder &SetPadInfo(const PadInfo &pad_info) {
+      builder_pad_info_ = pad_info;
+      return *this;
+    }
+
+    // set the bucketing of the rows by their length, the batch size is then the batch size of the buckets
+    // @param const std::string &length_column - the column whose first dim is the length of a row
+    // @param const std::vector<int32_t> &boundaries - the increasing upper bounds, excluded, of the buckets
+    //     but the last one, which takes the longer rows
+    // @param const std::vector<int32_t> &batch_sizes - the batch size of each bucket, one more than the boundaries
+    // @param bool pad_to_boundary - T/F to pad the first dim of the padded columns to the boundary of the bucket
+    //     minus 1, the last bucket pads to the longest of the batch
+    // @return Builder & reference to builder class object
+    Builder &SetBucketing(const std::string &length_column, const std::vector<int32_t> &boundaries,
+                          const std::vector<int32_t> &batch_sizes, bool pad_to_boundary) {
+      builder_bucketing_.length_column = length_column;
+      builder_bucketing_.boundaries = boundaries;
+      builder_bucketing_.batch_sizes = batch_sizes;
+      builder_bucketing_.pad_to_boundary = pad_to_boundary;
+      return *this;
+    }
+
     // @param std::shared_ptr<BatchOp>  *ptr pointer to shared_ptr, actual return arg
     // @return Status - The error code return
     Status Build(std::shared_ptr<BatchOp> *);
@@ -109,6 +156,7 @@ class BatchOp : public ParallelOp {
     Status SanityCheck();
 
     bool builder_drop_;
+    bool builder_in_place_;
     int32_t builder_batch_size_;
     int32_t builder_num_workers_;
     int32_t builder_op_connector_size_;
@@ -116,6 +164,8 @@ class BatchOp : public ParallelOp {
 
     py::function builder_batch_size_func_;
     py::function builder_batch_map_func_;
+    PadInfo builder_pad_info_;
+    Bucketing builder_bucketing_;
   };
 
   enum batchCtrl : int8_t { kNoCtrl = 0, kEOE = 1, kEOF = 2, kQuit = 3 };
@@ -133,6 +183,7 @@ class BatchOp : public ParallelOp {
     int32_t batch_num_;        // i-th batch since the start of current epoch. i starts from 0
     int32_t total_batch_num_;  // i-th batch since the start of first epoch. i starts from 0
     batchCtrl ctrl_;           // No control=0, EOE=1, EOF=2, Quit=3
+    int32_t bucket_ = -1;      // the bucket of the rows when bucketing by length, not bound to python
     const int32_t get_batch_num() const { return batch_num_; }
     const int32_t get_epoch_num() const { return epoch_num_; }
   };
@@ -143,8 +194,12 @@ class BatchOp : public ParallelOp {
   // @param int32_t op_queue_size
   // @param int32_t rows_per_buf
   // @param int32_t num_workers
+  // @param bool in_place
+  // @param const PadInfo &pad_info
+  // @param const Bucketing &bucketing
   BatchOp(int32_t batch_size, bool drop, int32_t op_queue_size, int32_t num_workers, const std::vector<std::string> &,
-          py::function batch_size_func, py::function batch_map_func);
+          py::function batch_size_func, py::function batch_map_func, bool in_place = false,
+          const PadInfo &pad_info = PadInfo(), const Bucketing &bucketing = Bucketing());
 
   // BatchOp destructor
   ~BatchOp() {}
@@ -162,6 +217,14 @@ class BatchOp : public ParallelOp {
   // @param show_all - A bool to control if you want to show all info or just a summary
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "BatchOp"; }
+
+  // Getter
+  // @return T/F if the number of running workers can be tuned while the tree executes
+  bool AutoTunable() const override { return true; }
+
   // << Stream output operator overload
   // @notes This allows you to write the debug print info using stream operators
   // @param out - reference to the output stream being overloaded
@@ -176,6 +239,21 @@ class BatchOp : public ParallelOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // During tree prepare phase, the in place mode hands the batch slots to the child MapOp
+  // @return Status - The error code return
+  Status PrepareNodeAction() override;
+
+  // Base-class override. With a fixed batch size each batch holds the next batch size rows of the child.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return, an error with a batch size function
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override, the batches resume their numbering of the batch info.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
  private:
   // Worker thread for doing the memcpy of batch
   // @param int32_t param workerId
@@ -191,8 +269,37 @@ class BatchOp : public ParallelOp {
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
   // @param int32_t size - batch_size
+  // @param int32_t bucket - the bucket of the rows, -1 without bucketing
   // @return Status - The error code return
-  Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest, size_t size);
+  Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest, size_t size,
+                   int32_t bucket = -1);
+
+  // Finds the indices of the padded columns and of the length column, once the column names are known
+  // @return Status - The error code return
+  Status InitColumns();
+
+  // Adds a row to its bucket, the bucket is sent to a worker once it holds its batch size rows
+  // @param TensorRow &&row - the row
+  // @param int32_t epoch_num - the current epoch
+  // @param int32_t *batch_num - the number of the next batch
+  // @param int32_t *cnt - the number of items sent to the workers
+  // @return Status - The error code return
+  Status AddToBucket(TensorRow &&row, int32_t epoch_num, int32_t *batch_num, int32_t *cnt);
+
+  // Pads and batches a column of the rows, see pad_info_
+  // @param const TensorQTable &rows - the rows of the batch
+  // @param size_t col - the padded column
+  // @param int32_t bucket - the bucket of the rows, -1 without bucketing
+  // @param std::shared_ptr<Tensor> *batched - the batched column
+  // @return Status - The error code return
+  Status PadColumn(const TensorQTable &rows, size_t col, int32_t bucket, std::shared_ptr<Tensor> *batched) const;
+
+  // Check if a column of the rows is already lined up in one batch tensor, see in_place_
+  // @param const TensorQTable &rows - the rows of the batch
+  // @param size_t col - the column to check
+  // @param std::shared_ptr<Tensor> *batched - the batched column, a view of the batch tensor for a partial batch
+  // @return bool - T/F if the column does not need to be copied
+  static bool BatchedInPlace(const TensorQTable &rows, size_t col, std::shared_ptr<Tensor> *batched);
 
   // Function that calls pyfunc to perform map on batch
   // @param (std::pair<std::unique_ptr<TensorQTable>, batch_stats> *table_pair - contains un-batched tensor
@@ -226,13 +333,31 @@ class BatchOp : public ParallelOp {
   // Iterator for fetching
   std::unique_ptr<ChildIterator> child_iterator_;
   // Map of column_name: column_index
-  std::unordered_map<std::string, int32_t> column_name_map_;
+  std::shared_ptr<const ColumnNameMap> column_name_map_;
   // Internal queue for task distribution
   QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;
   // Function pointer of batch size function
   py::function batch_size_func_;
   // Function pointer of per batch map function
   py::function batch_map_func_;
+  // In place mode is when the batch tensors are allocated before their rows are computed. A child MapOp then
+  // computes its output column straight into the slots of the batch tensors and the rows are not copied.
+  // It needs a fixed batch size and no per batch map.
+  bool in_place_;
+  // The batch tensors being filled by the child in in place mode
+  std::shared_ptr<BatchSlotPool> batch_slots_;
+  // The epoch and the batch number of the first batch, not 0 when the tree resumes from a saved state
+  int32_t start_epoch_num_;
+  int32_t start_batch_num_;
+  // The columns to pad, they are batched by BatchPad instead of being copied row by row
+  PadInfo pad_info_;
+  // The index of the padded columns, their pad shape and pad value
+  std::map<size_t, std::pair<TensorShape, float>> pad_columns_;
+  // The bucketing by length and the index of the length column
+  Bucketing bucketing_;
+  size_t length_column_;
+  // The rows waiting in each bucket, only used by the main loop
+  std::vector<std::unique_ptr<TensorQTable>> buckets_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/datasetops/batch_slot_pool.h"
+
+namespace mindspore {
+namespace dataset {
+BatchSlotPool::BatchSlotPool(int32_t batch_size) : batch_size_(batch_size) {}
+
+BatchSlotPool::Batch *BatchSlotPool::Find(int64_t key) {
+  auto it = batches_.find(key);
+  if (it == batches_.end()) {
+    it = batches_.emplace(key, Batch{TensorRow(), batch_size_, 0}).first;
+  }
+  return &it->second;
+}
+
+Status BatchSlotPool::GetSlots(int64_t row, const std::vector<TensorShape> &shapes, const std::vector<DataType> &types,
+                               TensorRow *slots) {
+  RETURN_UNEXPECTED_IF_NULL(slots);
+  slots->clear();
+  if (shapes.size() != types.size()) {
+    RETURN_STATUS_UNEXPECTED("The shapes and the types of the row do not match.");
+  }
+  int64_t key = row / batch_size_;
+  std::unique_lock<std::mutex> lck(mux_);
+  Batch *batch = Find(key);
+  batch->handed++;
+  Status rc;
+  if (!shapes.empty()) {
+    // The first row which asks decides the shapes and the types of the batch. A partial batch is not known yet
+    // when the first row asks, so the full batch is allocated.
+    if (batch->tensors.empty()) {
+      for (size_t i = 0; i < shapes.size() && rc.IsOk(); i++) {
+        std::shared_ptr<Tensor> t;
+        rc = Tensor::CreateTensor(&t, TensorImpl::kFlexible, shapes[i].PrependDim(batch_size_), types[i]);
+        batch->tensors.push_back(std::move(t));
+      }
+    }
+    bool match = rc.IsOk() && batch->tensors.size() == shapes.size();
+    for (size_t i = 0; match && i < shapes.size(); i++) {
+      match = batch->tensors[i]->type() == types[i] && batch->tensors[i]->shape() == shapes[i].PrependDim(batch_size_);
+    }
+    for (size_t i = 0; match && i < shapes.size() && rc.IsOk(); i++) {
+      std::shared_ptr<Tensor> view;
+      rc = Tensor::CreateView(&view, batch->tensors[i], {row % batch_size_}, shapes[i]);
+      slots->push_back(std::move(view));
+    }
+  }
+  // The views keep the batch tensors alive once the batch is handed out
+  if (batch->handed >= batch->num_rows) {
+    (void)batches_.erase(key);
+  }
+  if (rc.IsError()) {
+    slots->clear();
+  }
+  return rc;
+}
+
+int64_t BatchSlotPool::EndOfEpoch(int64_t num_rows) {
+  if (num_rows % batch_size_ == 0) {
+    return num_rows;
+  }
+  int64_t key = num_rows / batch_size_;
+  std::unique_lock<std::mutex> lck(mux_);
+  Batch *batch = Find(key);
+  batch->num_rows = num_rows - key * batch_size_;
+  if (batch->handed >= batch->num_rows) {
+    (void)batches_.erase(key);
+  }
+  return (key + 1) * batch_size_;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_DATASETOPS_BATCH_SLOT_POOL_H_
+#define DATASET_ENGINE_DATASETOPS_BATCH_SLOT_POOL_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The batch tensors of a BatchOp, allocated before the rows of the batch are computed.
+// The op which produces the rows (a MapOp child of the BatchOp) asks for the slot of each of its rows and
+// computes the row straight into views of the batch tensors (see Tensor::CreateView). When all the rows
+// of a batch are such views, lined up in the same batch tensor, the BatchOp takes the batch tensor
+// without copying the rows. Any row which is not in its slot is copied by the BatchOp as usual.
+// The rows are numbered in the order the BatchOp receives them, and each epoch starts on a new batch.
+class BatchSlotPool {
+ public:
+  // Constructor
+  // @param batch_size - The number of rows of a batch
+  explicit BatchSlotPool(int32_t batch_size);
+
+  ~BatchSlotPool() = default;
+
+  // Gets the slots of a row in the batch tensors of its batch. The batch tensors are allocated by the first
+  // row of the batch which asks, with the shapes and types of that row. The producer must call it exactly once
+  // for every row, even if it does not use the slots, so that the pool knows when a batch is handed out.
+  // @param row - The number of the row
+  // @param shapes - The shapes of the columns of the row, empty if the row does not use the slots
+  // @param types - The types of the columns of the row
+  // @param slots - The views of the batch tensors for the row, empty if the row does not match the batch
+  // @return Status - The error code return
+  Status GetSlots(int64_t row, const std::vector<TensorShape> &shapes, const std::vector<DataType> &types,
+                  TensorRow *slots);
+
+  // Marks the end of an epoch. The batch holding the last row of the epoch is then a partial batch.
+  // @param num_rows - The number of the first row after the epoch
+  // @return The number of the first row of the next epoch, at the start of a batch
+  int64_t EndOfEpoch(int64_t num_rows);
+
+  // Getter
+  // @return The number of rows of a batch
+  int32_t batch_size() const { return batch_size_; }
+
+ private:
+  // A batch which is not fully handed out yet
+  struct Batch {
+    TensorRow tensors;  // The batch tensor of each column, empty until the first row asks
+    int64_t num_rows;   // The number of rows of the batch
+    int64_t handed;     // The number of rows which asked for their slots
+  };
+
+  // @param key - The number of the batch
+  // @return The batch, created if needed
+  Batch *Find(int64_t key);
+
+  int32_t batch_size_;
+  std::mutex mux_;
+  std::map<int64_t, Batch> batches_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_DATASETOPS_BATCH_SLOT_POOL_H_
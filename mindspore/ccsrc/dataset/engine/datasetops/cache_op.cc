@@ -0,0 +1,397 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/datasetops/cache_op.h"
+
+#include <securec.h>
+#include <unistd.h>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+#include "dataset/core/config_manager.h"
+#include "dataset/engine/data_buffer.h"
+#include "dataset/engine/db_connector.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/util/make_unique.h"
+#include "dataset/util/path.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+// Builder constructor. Creates the builder object.
+CacheOp::Builder::Builder() : build_memory_mb_(0) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  build_op_connector_size_ = cfg->op_connector_size();
+  build_rows_per_buffer_ = cfg->rows_per_buffer();
+}
+
+Status CacheOp::Builder::SanityCheck() const {
+  if (build_memory_mb_ <= 0) {
+    RETURN_STATUS_UNEXPECTED("Cache memory size must be greater than 0.");
+  }
+  if (build_rows_per_buffer_ <= 0) {
+    RETURN_STATUS_UNEXPECTED("Rows per buffer must be greater than 0.");
+  }
+  return Status::OK();
+}
+
+// The builder "build" method creates the final object.
+Status CacheOp::Builder::Build(std::shared_ptr<CacheOp> *ptr) {
+  RETURN_IF_NOT_OK(SanityCheck());
+  *ptr = std::make_shared<CacheOp>(build_memory_mb_, build_spill_dir_, build_session_name_, build_rows_per_buffer_,
+                                   build_op_connector_size_);
+  return Status::OK();
+}
+
+// Constructor of the CacheOp
+CacheOp::CacheOp(int32_t memory_mb, const std::string &spill_dir, const std::string &session_name,
+                 int32_t rows_per_buffer, int32_t op_connector_size)
+    : PipelineOp(op_connector_size),
+      memory_mb_(memory_mb),
+      spill_dir_(spill_dir),
+      rows_per_buffer_(rows_per_buffer),
+      buffer_counter_(0),
+      cache_ready_(false),
+      spill_size_(0),
+      session_name_(session_name),
+      shared_rows_(0) {}
+
+CacheOp::~CacheOp() {
+  if (spill_file_.is_open()) {
+    spill_file_.close();
+  }
+  if (!spill_path_.empty()) {
+    (void)std::remove(spill_path_.c_str());
+  }
+}
+
+// A print method typically used for debugging
+void CacheOp::Print(std::ostream &out, bool show_all) const {
+  // Call base class printer first
+  PipelineOp::Print(out, show_all);
+
+  // Then display our own stuff
+  out << "CacheOp:\n  Memory size (MB): " << memory_mb_ << "\n  Spill directory: " << spill_dir_
+      << "\n  Session name: " << session_name_ << "\n  Shared rows: " << shared_rows_
+      << "\n  Cached rows: " << rows_.size() << "\n  Spilled bytes: " << spill_size_;
+  out << "\n-------------------------\n\n";  // End the display with this line
+}
+
+// Base-class override for executing specific CacheOp configurations.
+Status CacheOp::PrepareNodeAction() {
+  // Run any common code from super class first before adding our own specific logic
+  RETURN_IF_NOT_OK(PipelineOp::PrepareNodeAction());
+
+  // The leaf operators of our subtree are on top of the repeat stack. They run a single epoch,
+  // the following ones are served by the cache.
+  std::set<const DatasetOp *> leaves;
+  CollectLeaves(this, &leaves);
+  std::shared_ptr<DatasetOp> leaf_op = tree_->PopFromRepeatStack();
+  while (leaf_op != nullptr) {
+    if (leaves.count(leaf_op.get()) == 0) {
+      // A leaf of another subtree, leave it to the repeat operator
+      tree_->AddToRepeatStack(leaf_op);
+      break;
+    }
+    leaf_op->set_control_flag(kDeOpLastRepeat);
+    leaf_op = tree_->PopFromRepeatStack();
+  }
+
+  // Then, stand for them in front of the repeat operator above us.
+  if (BitTest(tree_->PrepareFlags(), ExecutionTree::kDePrepRepeat)) {
+    BitSet(&op_ctrl_flags_, kDeOpRepeated);
+    tree_->AddToRepeatStack(shared_from_this());
+  }
+  return Status::OK();
+}
+
+void CacheOp::CollectLeaves(const DatasetOp *op, std::set<const DatasetOp *> *leaves) {
+  if (op->child_.empty()) {
+    (void)leaves->insert(op);
+  }
+  for (const auto &c : op->child_) {
+    CollectLeaves(c.get(), leaves);
+  }
+}
+
+// Class functor operator () override.
+// All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
+// provide the master loop that drives the logic for performing the work
+Status CacheOp::operator()() {
+  wp_.Register(tree_->AllTasks());
+  // Synchronize with TaskManager once the thread is launched.
+  TaskManager::FindMe()->Post();
+
+  if (!session_name_.empty()) {
+    RETURN_IF_NOT_OK(SharedCache::Open(session_name_, memory_mb_, &shared_));
+  }
+  child_iterator_ = mindspore::make_unique<ChildIterator>(this, 0, 0);
+
+  while (true) {
+    if (!cache_ready_) {
+      RETURN_IF_NOT_OK(FillEpoch());
+      // An empty subtree, there is no epoch to serve
+      if (!cache_ready_) {
+        break;
+      }
+    } else {
+      RETURN_IF_NOT_OK(ReplayEpoch());
+    }
+
+    MS_LOG(INFO) << "Cache operator sending EOE.";
+    auto eoe_buffer = mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE);
+    RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(eoe_buffer)));
+
+    if (!BitTest(op_ctrl_flags_, kDeOpRepeated) || BitTest(op_ctrl_flags_, kDeOpLastRepeat)) {
+      break;
+    }
+    // Sleep until the repeat operator above asks for the next epoch
+    RETURN_IF_NOT_OK(wp_.Wait());
+    wp_.Clear();
+  }
+
+  MS_LOG(INFO) << "Cache operator sending EOF.";
+  auto eof_buffer = mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
+  RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(eof_buffer)));
+  return Status::OK();
+}
+
+Status CacheOp::FillEpoch() {
+  MS_LOG(INFO) << "Cache operator filling the cache.";
+  if (shared_ != nullptr && !shared_->producer()) {
+    RETURN_IF_NOT_OK(ReadSharedEpoch());
+    if (shared_->state() == SharedCache::State::kReady) {
+      // Every row came from the producer, our subtree is left idle
+      cache_ready_ = (shared_rows_ > 0);
+      return Status::OK();
+    }
+    MS_LOG(WARNING) << "Cache session " << session_name_ << " holds " << shared_rows_
+                    << " rows only, the following rows are produced by this process.";
+  }
+
+  TensorRow new_row;
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  if (child_iterator_->eof_handled()) {
+    MS_LOG(INFO) << "Cache operator picked up EOF. No more epochs.";
+    return Status::OK();
+  }
+
+  // Share the column name mapping.  We'll use this when constructing output buffers later.
+  column_name_map_ = child_iterator_->shared_col_name_id_map();
+  if (shared_ != nullptr && shared_->producer()) {
+    RETURN_IF_NOT_OK(shared_->SetColumnMap(child_iterator_->col_name_id_map()));
+  }
+
+  // The rows already read from the cache session are skipped
+  int64_t skip_rows = shared_rows_;
+  int64_t row_id = 0;
+  auto table = mindspore::make_unique<TensorQTable>();
+  while (!new_row.empty()) {
+    if (row_id >= skip_rows) {
+      RETURN_IF_NOT_OK(KeepRow(row_id, new_row));
+      table->push_back(std::move(new_row));
+      if (table->size() == static_cast<size_t>(rows_per_buffer_)) {
+        RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+        table = mindspore::make_unique<TensorQTable>();
+      }
+    }
+    row_id++;
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  }
+  if (!table->empty()) {
+    RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+  }
+  if (shared_ != nullptr && shared_->producer() && shared_->state() == SharedCache::State::kFilling) {
+    shared_->Seal(false);
+  }
+
+  // The subtree ran its only epoch, take its eof before serving the next epochs
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  if (!child_iterator_->eof_handled()) {
+    RETURN_STATUS_UNEXPECTED("The subtree of the cache produced more than one epoch.");
+  }
+  if (spill_file_.is_open()) {
+    spill_file_.flush();
+  }
+  cache_ready_ = true;
+  MS_LOG(INFO) << "Cache operator cached " << rows_.size() << " rows, " << spill_size_ << " bytes spilled.";
+  return Status::OK();
+}
+
+Status CacheOp::ReadSharedEpoch() {
+  MS_LOG(INFO) << "Cache operator reading cache session " << session_name_ << ".";
+  TensorRow row;
+  RETURN_IF_NOT_OK(shared_->GetRow(shared_rows_, &row));
+  if (!row.empty()) {
+    ColumnNameMap column_name_map;
+    RETURN_IF_NOT_OK(shared_->GetColumnMap(&column_name_map));
+    column_name_map_ = std::make_shared<const ColumnNameMap>(std::move(column_name_map));
+  }
+  auto table = mindspore::make_unique<TensorQTable>();
+  while (!row.empty()) {
+    shared_rows_++;
+    table->push_back(std::move(row));
+    if (table->size() == static_cast<size_t>(rows_per_buffer_)) {
+      RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+      table = mindspore::make_unique<TensorQTable>();
+    }
+    RETURN_IF_NOT_OK(shared_->GetRow(shared_rows_, &row));
+  }
+  if (!table->empty()) {
+    RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+  }
+  return Status::OK();
+}
+
+Status CacheOp::KeepRow(int64_t row_id, const TensorRow &row) {
+  if (shared_ != nullptr && shared_->producer() && shared_->state() == SharedCache::State::kFilling) {
+    Status rc = shared_->Publish(row_id, row);
+    if (rc.IsOk()) {
+      shared_rows_++;
+      return Status::OK();
+    }
+    if (!rc.IsOutofMemory()) {
+      return rc;
+    }
+    // The readers take the following rows from their own subtree
+    shared_->Seal(true);
+  }
+  return CacheRow(row);
+}
+
+Status CacheOp::ReplayEpoch() {
+  MS_LOG(INFO) << "Cache operator serving an epoch from the cache.";
+  buffer_counter_ = 0;
+  auto table = mindspore::make_unique<TensorQTable>();
+  for (int64_t i = 0; i < shared_rows_; i++) {
+    TensorRow row;
+    RETURN_IF_NOT_OK(shared_->GetRow(i, &row));
+    table->push_back(std::move(row));
+    if (table->size() == static_cast<size_t>(rows_per_buffer_)) {
+      RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+      table = mindspore::make_unique<TensorQTable>();
+    }
+  }
+  for (const auto &cached : rows_) {
+    TensorRow row;
+    RETURN_IF_NOT_OK(RestoreRow(cached, &row));
+    table->push_back(std::move(row));
+    if (table->size() == static_cast<size_t>(rows_per_buffer_)) {
+      RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+      table = mindspore::make_unique<TensorQTable>();
+    }
+  }
+  if (!table->empty()) {
+    RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+  }
+  return Status::OK();
+}
+
+Status CacheOp::SendBuffer(std::unique_ptr<TensorQTable> table) {
+  auto new_buffer = mindspore::make_unique<DataBuffer>(buffer_counter_, DataBuffer::kDeBFlagNone);
+  new_buffer->set_tensor_table(std::move(table));
+  new_buffer->set_column_name_map(column_name_map_);
+  buffer_counter_++;
+  return out_connector_->Add(0, std::move(new_buffer));
+}
+
+Status CacheOp::CacheRow(const TensorRow &row) {
+  if (arena_ == nullptr) {
+    // Created on the first row, a shared cache may never need it
+    RETURN_IF_NOT_OK(Arena::CreateArena(&arena_, memory_mb_));
+  }
+  std::vector<CachedTensor> cached;
+  for (const auto &t : row) {
+    CachedTensor c{t->shape(), t->type(), nullptr, 0, t->SizeInBytes()};
+    if (c.size > 0) {
+      Status rc = arena_->Allocate(c.size, &c.addr);
+      if (rc.IsOutofMemory()) {
+        c.addr = nullptr;
+      } else {
+        RETURN_IF_NOT_OK(rc);
+      }
+      if (c.addr != nullptr) {
+        int ret_code = memcpy_s(c.addr, c.size, t->StartAddr(), c.size);
+        if (ret_code != 0) {
+          RETURN_STATUS_UNEXPECTED("Failed to copy a tensor into the cache.");
+        }
+      } else {
+        // The arena is full, the bytes go to the spill file
+        if (spill_dir_.empty()) {
+          RETURN_STATUS_UNEXPECTED("The cache of " + std::to_string(memory_mb_) +
+                                   " MB is full, give a larger memory size or a spill directory.");
+        }
+        if (!spill_file_.is_open()) {
+          Path path(spill_dir_);
+          path = path / ("cache_" + std::to_string(getpid()) + "_" + std::to_string(id()) + ".bin");
+          spill_path_ = path.toString();
+          spill_file_.open(spill_path_, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+          if (!spill_file_.is_open()) {
+            RETURN_STATUS_UNEXPECTED("Failed to open the spill file of the cache: " + spill_path_);
+          }
+          MS_LOG(INFO) << "Cache operator spilling to " << spill_path_ << ".";
+        }
+        c.offset = spill_size_;
+        (void)spill_file_.seekp(c.offset);
+        (void)spill_file_.write(reinterpret_cast<const char *>(t->StartAddr()), c.size);
+        if (!spill_file_.good()) {
+          RETURN_STATUS_UNEXPECTED("Failed to write the spill file of the cache: " + spill_path_);
+        }
+        spill_size_ += c.size;
+      }
+    }
+    cached.push_back(std::move(c));
+  }
+  rows_.push_back(std::move(cached));
+  return Status::OK();
+}
+
+Status CacheOp::RestoreRow(const std::vector<CachedTensor> &cached, TensorRow *row) {
+  row->clear();
+  for (const auto &c : cached) {
+    std::shared_ptr<Tensor> t;
+    if (c.addr != nullptr || c.size == 0) {
+      RETURN_IF_NOT_OK(Tensor::CreateTensor(&t, TensorImpl::kFlexible, c.shape, c.type,
+                                            static_cast<const unsigned char *>(c.addr)));
+    } else {
+      RETURN_IF_NOT_OK(Tensor::CreateTensor(&t, TensorImpl::kFlexible, c.shape, c.type));
+      (void)spill_file_.seekg(c.offset);
+      (void)spill_file_.read(reinterpret_cast<char *>(t->StartAddr()), c.size);
+      if (!spill_file_.good()) {
+        RETURN_STATUS_UNEXPECTED("Failed to read the spill file of the cache: " + spill_path_);
+      }
+    }
+    row->push_back(std::move(t));
+  }
+  return Status::OK();
+}
+
+Status CacheOp::EoeReceived(int32_t worker_id) {
+  state_ = OpState::kDeOpIdle;
+  return Status::OK();
+}
+
+Status CacheOp::EofReceived(int32_t worker_id) { return Status::OK(); }
+
+Status CacheOp::Reset() {
+  RETURN_IF_NOT_OK(PipelineOp::Reset());
+  wp_.Set();  // wake up master thread after reset is done
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,256 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
+#define DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
+
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/core/tensor_shape.h"
+#include "dataset/engine/cache/shared_cache.h"
+#include "dataset/engine/dataset_iterator.h"
+#include "dataset/engine/datasetops/pipeline_op.h"
+#include "dataset/util/arena.h"
+#include "dataset/util/status.h"
+#include "dataset/util/wait_post.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declare
+class ExecutionTree;
+
+class DataBuffer;
+
+// The CacheOp keeps a copy of the rows of its child during the first epoch, and serves the
+// following epochs from the copy instead of running its subtree again. The rows are copied into
+// an Arena of a fixed size, and the rows which do not fit are spilled to a file when a spill
+// directory is given.
+// In a repeat path, the CacheOp stands for the leaf operators of its subtree: they run a single
+// epoch, and the repeat operator above drives the CacheOp. Random operators below the cache are
+// therefore applied once, every epoch gets the same rows in the same order.
+// With a session name, the processes of a host share the cache through a SharedCache: the first one
+// runs its subtree and publishes the rows, the other ones read them instead of running their own
+// subtree. The rows which do not fit in the shared memory come from the subtree of each process.
+class CacheOp : public PipelineOp {
+ public:
+  // The nested builder class inside of the CacheOp is used to help manage all of the arguments
+  // for constructing it.
+  class Builder {
+   public:
+    // Builder constructor.  Creates the builder object.
+    // @note No default args
+    // @return This is a constructor.
+    Builder();
+
+    // Default destructor
+    ~Builder() = default;
+
+    // Setter method.
+    // @param memory_mb - The size of the in memory store in MB
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetMemoryMb(int32_t memory_mb) {
+      build_memory_mb_ = memory_mb;
+      return *this;
+    }
+
+    // Setter method.
+    // @param spill_dir - The directory of the spill file, empty if the rows must fit in memory
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSpillDir(const std::string &spill_dir) {
+      build_spill_dir_ = spill_dir;
+      return *this;
+    }
+
+    // Setter method.
+    // @param session_name - The name under which the processes of the host share the cache, empty for
+    //     a cache private to this pipeline
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSessionName(const std::string &session_name) {
+      build_session_name_ = session_name;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetRowsPerBuffer(int32_t rows_per_buffer) {
+      build_rows_per_buffer_ = rows_per_buffer;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetOpConnectorSize(int32_t op_connector_size) {
+      build_op_connector_size_ = op_connector_size;
+      return *this;
+    }
+
+    // The builder "build" method creates the final object.
+    // @return shared_ptr to the new CacheOp object
+    Status Build(std::shared_ptr<CacheOp> *);
+
+   private:
+    int32_t build_memory_mb_;
+    std::string build_spill_dir_;
+    std::string build_session_name_;
+    int32_t build_rows_per_buffer_;
+    int32_t build_op_connector_size_;
+
+    Status SanityCheck() const;
+  };
+
+  // Constructor of the CacheOp
+  // @note The builder class should be used to call it
+  // @param memory_mb - The size of the in memory store in MB
+  // @param spill_dir - The directory of the spill file, empty if the rows must fit in memory
+  // @param session_name - The name of the shared cache session, empty for a private cache
+  // @param rows_per_buffer - The requested number of rows per buffer
+  // @param op_connector_size - The output connector queue size
+  CacheOp(int32_t memory_mb, const std::string &spill_dir, const std::string &session_name, int32_t rows_per_buffer,
+          int32_t op_connector_size);
+
+  // Destructor
+  ~CacheOp();
+
+  // A print method typically used for debugging
+  // @param out - The output stream to write output to
+  // @param show_all - A bool to control if you want to show all info or just a summary
+  void Print(std::ostream &out, bool show_all) const override;
+
+  // << Stream output operator overload
+  // @notes This allows you to write the debug print info using stream operators
+  // @param out - reference to the output stream being overloaded
+  // @param co - reference to the CacheOp to display
+  // @return - the output stream must be returned
+  friend std::ostream &operator<<(std::ostream &out, const CacheOp &co) {
+    co.Print(out, false);
+    return out;
+  }
+
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "CacheOp"; }
+
+  // Class functor operator () override.
+  // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
+  // provide the master loop that drives the logic for performing the work
+  // @return Status - The error code return
+  Status operator()() override;
+
+  // Base-class override. The epochs after the first one are replayed from the cache, which is filled again if
+  // the tree resumes, so the state is not saved.
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override {
+    RETURN_STATUS_UNEXPECTED("CacheOp does not support saving the state of the pipeline.");
+  }
+
+  // Base-class override for special eoe handler.
+  // The CacheOp sends its own eoe at the end of each epoch it serves.
+  // @return Status - The error code return
+  Status EoeReceived(int32_t worker_id) override;
+
+  // Base-class override for special eof handler.
+  // The eof of the subtree comes after its only epoch, the CacheOp sends its own eof after its last epoch.
+  // @return Status - The error code return
+  Status EofReceived(int32_t worker_id) override;
+
+  // Base-class override for the reset. It wakes up the master loop for the next epoch.
+  // @return Status - The error code return
+  Status Reset() override;
+
+  // Base-class override. The subtree below the cache is not reset, it ran its only epoch.
+  // @return Status - The error code return
+  Status ResetSubtree() override { return Reset(); }
+
+  // Base-class override for executing specific CacheOp configurations. This code will be called
+  // during the execution tree prepare phase when it is visiting this operator.
+  // @return Status - The error code return
+  Status PrepareNodeAction() override;
+
+ private:
+  // The copy of a tensor. Its bytes are either in the arena, or in the spill file.
+  struct CachedTensor {
+    TensorShape shape;
+    DataType type;
+    void *addr;      // The bytes in the arena, nullptr if spilled
+    int64_t offset;  // The offset of the bytes in the spill file
+    dsize_t size;    // The number of bytes
+  };
+
+  // Copies a row of the first epoch into the store.
+  // @param row - The row
+  // @return Status - The error code return
+  Status CacheRow(const TensorRow &row);
+
+  // Keeps a row of the first epoch, in the shared cache while it has room, then in the private store.
+  // @param row_id - The position of the row in the epoch
+  // @param row - The row
+  // @return Status - The error code return
+  Status KeepRow(int64_t row_id, const TensorRow &row);
+
+  // Reader of a cache session. Sends the rows published by the producer.
+  // @return Status - The error code return
+  Status ReadSharedEpoch();
+
+  // Rebuilds a row of the store.
+  // @param cached - The copy of the row
+  // @param row - The new row
+  // @return Status - The error code return
+  Status RestoreRow(const std::vector<CachedTensor> &cached, TensorRow *row);
+
+  // Runs the first epoch: the rows of the child are sent and copied into the store.
+  // @return Status - The error code return
+  Status FillEpoch();
+
+  // Runs a following epoch: the rows are sent from the store.
+  // @return Status - The error code return
+  Status ReplayEpoch();
+
+  // Sends a table of rows as a buffer.
+  // @param table - The rows
+  // @return Status - The error code return
+  Status SendBuffer(std::unique_ptr<TensorQTable> table);
+
+  // Collects the leaf operators of a subtree.
+  // @param op - The root of the subtree
+  // @param leaves - The leaf operators
+  static void CollectLeaves(const DatasetOp *op, std::set<const DatasetOp *> *leaves);
+
+  int32_t memory_mb_;
+  std::string spill_dir_;
+  int32_t rows_per_buffer_;
+  int32_t buffer_counter_;                                    // For creating new buffer id's
+  bool cache_ready_;                                          // T/F if the store holds the whole epoch
+  std::shared_ptr<Arena> arena_;                              // The in memory store
+  std::string spill_path_;                                    // The spill file, empty until the first spill
+  std::fstream spill_file_;
+  int64_t spill_size_;                                        // The bytes written to the spill file
+  std::vector<std::vector<CachedTensor>> rows_;               // The rows of the store, in order
+  std::string session_name_;
+  std::unique_ptr<SharedCache> shared_;                       // The shared cache, nullptr for a private cache
+  int64_t shared_rows_;                                       // The first rows of the epoch, kept in shared_
+  std::shared_ptr<const ColumnNameMap> column_name_map_;  // A mapping between column index to column name.
+  std::unique_ptr<ChildIterator> child_iterator_;             // An iterator for fetching.
+  WaitPost wp_;                                               // Wakes up the master loop on reset
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
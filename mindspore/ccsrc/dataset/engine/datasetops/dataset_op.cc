@@ -21,6 +21,8 @@
 #include <utility>
 #include <string>
 
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
 #include "dataset/engine/execution_tree.h"
 #include "dataset/engine/datasetops/device_queue_op.h"
 #include "dataset/engine/data_buffer.h"
@@ -36,7 +38,8 @@ DatasetOp::DatasetOp(int32_t op_connector_size)
       operator_id_(kInvalidOperatorId),
       tree_(nullptr),
       state_(OpState::kDeOpIdle),
-      op_ctrl_flags_(kDeOpNone) {
+      op_ctrl_flags_(kDeOpNone),
+      lock_free_connector_(GlobalContext::config_manager()->lock_free_connector()) {
   // The operator starts out with an invalid operator id.  The only way to
   // get it out of invalid state is to assign the operator to an execution tree.
 }
@@ -68,6 +71,16 @@ Status DatasetOp::AddChild(std::shared_ptr<DatasetOp> child) {
 // Adds a parent operator to this operator
 void DatasetOp::AddParent(const DatasetOp *parent) { parent_.push_back(parent); }
 
+// Decides if the output connector can run unordered. Children are prepared before their parent, so the
+// connectors below this operator already exist.
+bool DatasetOp::OutputOrdered() const {
+  if (num_producers() > 1) {
+    bool input_unordered = !child_.empty() && child_[0]->out_connector_ && !child_[0]->out_connector_->ordered();
+    return !(input_unordered && num_consumers() == num_producers());
+  }
+  return parent_.empty() || parent_[0]->InputOrderRequired();
+}
+
 // Getter function to get a shared pointer to our childAdds a operator to become our child.
 std::shared_ptr<DatasetOp> DatasetOp::child(int32_t child_index) const {
   DS_ASSERT(child_index < static_cast<int>(child_.size()));
@@ -76,13 +89,22 @@ std::shared_ptr<DatasetOp> DatasetOp::child(int32_t child_index) const {
 }
 
 // Creates the connector within this operator
-void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
+void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers, bool ordered) {
   MS_LOG(INFO) << "Creating connector in tree operator: " << operator_id_ << ". Producer: " << num_producers
-               << ". Consumer: " << num_consumers << ".";
+               << ". Consumer: " << num_consumers << ". Ordered: " << ordered << ".";
   if (oc_queue_size_ > 0) {
+    bool auto_tune = (tree_ != nullptr && tree_->auto_tune() != nullptr);
+    // An auto tuned connector allocates room to grow, and starts at the configured size.
+    int32_t allocated_size = auto_tune ? oc_queue_size_ * kAutoTuneConnectorGrowth : oc_queue_size_;
     out_connector_ = mindspore::make_unique<DbConnector>(num_producers,  // The number of producers
                                                          num_consumers,  // Only one consumer (the training App)
-                                                         oc_queue_size_);
+                                                         allocated_size, lock_free_connector_, ordered);
+    if (auto_tune) {
+      out_connector_->set_queue_capacity(oc_queue_size_);
+    }
+    if (tree_ != nullptr && (tree_->profiler() != nullptr || auto_tune)) {
+      out_connector_->set_stats(std::make_shared<ConnectorStats>(num_producers, num_consumers));
+    }
   } else {
     // Some op's may choose not to have an output connector
     MS_LOG(INFO) << "Bypassed connector creation for tree operator: " << operator_id_ << ".";
@@ -178,9 +200,9 @@ Status DatasetOp::PrepareNodeAction() {
   // The consumer of the root node is assumed to be one thread.
   // If multiple threads are consuming from the root node, they will get the ordered data in round robin fashion.
   if (parent_.empty()) {
-    this->CreateConnector(num_producers(), 1);
+    this->CreateConnector(num_producers(), 1, OutputOrdered());
   } else {
-    this->CreateConnector(num_producers(), parent_[0]->num_consumers());
+    this->CreateConnector(num_producers(), parent_[0]->num_consumers(), OutputOrdered());
   }
   if (out_connector_) {
     RETURN_IF_NOT_OK(out_connector_->Register(tree_->AllTasks()));
@@ -192,6 +214,41 @@ Status DatasetOp::PrepareNodeAction() {
 // Getter function.  Base class does not have any special flags setting.
 uint32_t DatasetOp::PrepareFlags() const { return ExecutionTree::kDePrepNone; }
 
+// The operators with one output row per input row, in the same order, are at the same position as their child.
+Status DatasetOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  if (child_.size() != 1) {
+    RETURN_STATUS_UNEXPECTED(Name() + " does not support saving the state of the pipeline.");
+  }
+  if (!InputOrderRequired()) {
+    RETURN_STATUS_UNEXPECTED(Name() + " does not keep the order of the rows, its state can not be saved.");
+  }
+  return child_[0]->SaveState(pos, state);
+}
+
+nlohmann::json *DatasetOp::MutableOpState(nlohmann::json *state) const {
+  nlohmann::json *op_state = &(*state)["ops"][std::to_string(operator_id_)];
+  (*op_state)["name"] = Name();
+  return op_state;
+}
+
+Status DatasetOp::GetOpState(const nlohmann::json &state, const nlohmann::json **op_state) const {
+  *op_state = nullptr;
+  auto ops = state.find("ops");
+  if (ops == state.end()) {
+    return Status::OK();
+  }
+  auto itr = ops->find(std::to_string(operator_id_));
+  if (itr == ops->end()) {
+    return Status::OK();
+  }
+  if (itr->value("name", "") != Name()) {
+    RETURN_STATUS_UNEXPECTED("The saved state of operator " + std::to_string(operator_id_) + " is of " +
+                             itr->value("name", "") + ", not of " + Name() + ".");
+  }
+  *op_state = &(*itr);
+  return Status::OK();
+}
+
 // Derived classes may implement the reset function if the operator is stateful and needs
 // specific reset handling that is not contained in this common code version of the reset.
 Status DatasetOp::Reset() {
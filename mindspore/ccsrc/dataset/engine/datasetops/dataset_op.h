@@ -17,7 +17,9 @@
 #define DATASET_ENGINE_DATASETOPS_DATASET_OP_H_
 
 #include <memory>
+#include <string>
 #include <vector>
+#include <nlohmann/json.hpp>
 #include "dataset/core/constants.h"
 #include "dataset/engine/db_connector.h"
 #include "dataset/util/status.h"
@@ -34,6 +36,12 @@ class DataBuffer;
 class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // Allow execution tree to access internal members
   friend class ExecutionTree;
+  // Allow the profiler to read the connector counters
+  friend class Profiler;
+  // Allow the auto tune to resize the connectors
+  friend class AutoTune;
+  // Allow the cache to walk the subtree it stands for
+  friend class CacheOp;
 
  public:
   static constexpr int32_t kInvalidOperatorId = -1;
@@ -48,6 +56,13 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // Flags that control operator runtime behaviours
   enum OpState { kDeOpRunning = 0, kDeOpIdle = 1 };
 
+  // A position in the output of an operator: the passes (epochs) of the output which the consumer completed, and
+  // the rows it took from the current pass.
+  struct Position {
+    int64_t pass;
+    int64_t rows;
+  };
+
   // Constructor
   // @param op_connector_size - The size for the output connector of this operator.
   explicit DatasetOp(int32_t op_connector_size);
@@ -66,7 +81,8 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // Creates the connector within this operator
   // @param num_producers - number of threads that write into this connector
   // @param num_consumers - number of threads that read from this connector
-  void CreateConnector(int32_t num_producers, int32_t num_consumers);
+  // @param ordered - T/F if the connector preserves the order of the buffers
+  void CreateConnector(int32_t num_producers, int32_t num_consumers, bool ordered = true);
 
   // A print method typically used for debugging
   // @param out - The output stream to write output to
@@ -164,6 +180,10 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // @return The prepare flags
   virtual uint32_t PrepareFlags() const;
 
+  // Op name getter
+  // @return Name of the current Op
+  virtual std::string Name() const { return "DatasetOp"; }
+
   // Getter function
   // @return The number of workers in this op
   virtual int32_t num_workers() const = 0;
@@ -188,12 +208,57 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // @return Status
   virtual Status RegisterWorkerConnectors() { return Status::OK(); }
 
+  // Getter function
+  // @return T/F if this operator relies on the order of the buffers from its child. An operator which can
+  // consume an unordered connector must deliver every control buffer it receives from each of its consumer
+  // threads to the output connector.
+  virtual bool InputOrderRequired() const { return true; }
+
+  // Getter function
+  // @return The numa node of the device this operator sends the data to, -1 if there is none or it is unknown
+  virtual int32_t DeviceNumaNode() const { return -1; }
+
+  // Saves what this operator needs to resume its output at a position of the consumer, then the states of its
+  // children at the matching positions in their outputs. The base class keeps no state of its own and passes
+  // the position on to its only child, which fits the operators with one output row per input row.
+  // @notes Called by the consumer thread while the tree runs, only the settings and the atomics can be read.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree, each operator writes its own object, see MutableOpState
+  // @return Status - The error code return
+  virtual Status SaveState(const Position &pos, nlohmann::json *state) const;
+
+  // Restores the state written by SaveState into the tree of the same pipeline. Called after the tree is
+  // prepared and before it is launched. The base class keeps no state.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  virtual Status LoadState(const nlohmann::json &state) { return Status::OK(); }
+
+  // Setter function
+  // @param lock_free - T/F if the output connector of this operator is backed by lock free ring buffers.
+  // @notes Must be called before the tree is prepared. Defaults to the ConfigManager setting.
+  void set_lock_free_connector(bool lock_free) { lock_free_connector_ = lock_free; }
+
  protected:
   // Adds a parent operator to this operator
   // @notes External callers do not have access to this function.
   // @param parent - The parent node to add
   void AddParent(const DatasetOp *parent);
 
+  // Decides if the output connector can run unordered.  It can be unordered when a single producer
+  // feeds a parent that does not need ordered input, and it has to be unordered when every producer
+  // reads from an unordered input, since each of them then forwards its own control buffers.
+  // @return T/F if the output connector preserves the order
+  bool OutputOrdered() const;
+
+  // @param state - The state of the tree
+  // @return The object of this operator in the state of the tree, created by the first call
+  nlohmann::json *MutableOpState(nlohmann::json *state) const;
+
+  // @param state - The state of the tree
+  // @param op_state - The object of this operator, nullptr if the state has none
+  // @return Status - The error code return, an error if the object is of another kind of operator
+  Status GetOpState(const nlohmann::json &state, const nlohmann::json **op_state) const;
+
   std::vector<std::shared_ptr<DatasetOp>> child_;  // Child nodes
   std::vector<const DatasetOp *> parent_;          // Parent nodes. No ownership and read-only
   int32_t oc_queue_size_;                          // Capacity for each out_connector_
@@ -202,6 +267,7 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   OpState state_;                                  // The state of the operator, Running, Idle, Terminated
   uint32_t op_ctrl_flags_;                         // Flags for the operator
   std::unique_ptr<DbConnector> out_connector_;     // Output Connector
+  bool lock_free_connector_;                       // Use a lock free output connector
 
  private:
   // Sets the operator id.
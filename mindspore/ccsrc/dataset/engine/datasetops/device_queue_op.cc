@@ -15,22 +15,36 @@
  */
 #include "dataset/engine/datasetops/device_queue_op.h"
 
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "dataset/core/config_manager.h"
 #include "dataset/core/global_context.h"
 #include "dataset/engine/data_buffer.h"
 #include "dataset/engine/dataset_iterator.h"
+#include "dataset/util/cpu_placement.h"
 #include "dataset/util/status.h"
 #include "dataset/util/task_manager.h"
+#include "utils/metrics.h"
+#include "utils/timeline.h"
 
 #ifdef ENABLE_TDTQUE
 #include "tdt/tsd_client.h"
 #endif
 
+#ifdef ENABLE_GPUQUE
+#include <cuda_runtime_api.h>
+#endif
+
 namespace mindspore {
 namespace dataset {
+#ifdef ENABLE_TDTQUE
+// the rows translated ahead of the push, one is translated while the other is pushed
+constexpr int32_t kTdtBufferNum = 2;
+#endif
+
 DeviceQueueOp::DeviceQueueOp(std::string channel_name, DeviceType device_type, int32_t device_id, int32_t prefetch_size,
                              int32_t op_connector_size, int64_t num_batch)
     : PipelineOp(op_connector_size),
@@ -42,11 +56,30 @@ DeviceQueueOp::DeviceQueueOp(std::string channel_name, DeviceType device_type, i
 
 DeviceQueueOp::~DeviceQueueOp() {}
 
+int32_t DeviceQueueOp::DeviceNumaNode() const {
 #ifdef ENABLE_GPUQUE
-void ReleaseData(void *addr) {
-  if (addr != nullptr) {
-    free(addr);
+  if (device_type_ == DeviceType::GPU) {
+    // The bus id is of the form "0000:3b:00.0"
+    char bus_id[32] = {0};
+    if (cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), device_id_) == cudaSuccess) {
+      return CpuPlacement::PciDeviceNode(bus_id);
+    }
   }
+#endif
+  return -1;
+}
+
+#ifdef ENABLE_GPUQUE
+void ReleaseData(void *addr, const std::vector<std::shared_ptr<PinnedMemPool>> &pools) {
+  if (addr == nullptr) {
+    return;
+  }
+  for (auto &pool : pools) {
+    if (pool->Release(addr)) {
+      return;
+    }
+  }
+  free(addr);
 }
 #endif
 
@@ -66,6 +99,15 @@ Status DeviceQueueOp::EoeReceived(int32_t worker_id) {
 }
 
 Status DeviceQueueOp::operator()() {
+#ifdef ENABLE_TDTQUE
+  if (device_type_ == DeviceType::Ascend) {
+    // the worker must be launched before the post
+    tdtInstancePtr = TdtPlugin::GetInstance();
+    tdt_items_ = mindspore::make_unique<Queue<std::vector<DataItem>>>(kTdtBufferNum);
+    RETURN_IF_NOT_OK(tdt_items_->Register(tree_->AllTasks()));
+    RETURN_IF_NOT_OK(tree_->LaunchWorkers(1, std::bind(&DeviceQueueOp::TdtPushWorker, this, std::placeholders::_1)));
+  }
+#endif
   TaskManager::FindMe()->Post();
 
   if (device_type_ == DeviceType::Ascend) {
@@ -93,6 +135,9 @@ Status DeviceQueueOp::SendDataToAscend() {
   MS_LOG(INFO) << "Device queue, sending data to Ascend.";
   int64_t total_batch = 0;
   bool is_break_loop = false;
+  // the time the push waits for the pipeline, which is on the critical path once the device drains the channel
+  auto input_wait = MetricsRegistry::GetInstance().GetHistogram(
+    "mindspore_tdt_input_wait_us", "The microseconds the TDT push waits for the buffers of the dataset pipeline.");
 
   std::unique_ptr<DataBuffer> current_buffer;
   RETURN_IF_NOT_OK(GetNextInput(&current_buffer));
@@ -103,24 +148,52 @@ Status DeviceQueueOp::SendDataToAscend() {
       TensorRow currRow;
       for (int row_id = 0; row_id < current_buffer->NumRows() && !is_break_loop; row_id++) {
         RETURN_IF_NOT_OK(current_buffer->GetRow(row_id, &currRow));
-        auto status = tdtInstancePtr->hostPush(currRow, true, channel_name_);
-        if (status == TdtStatus::FAILED) {
-          return Status(StatusCode::kTDTPushFailure, "TDT Push Failed");
+        std::vector<DataItem> items;
+        if (tdtInstancePtr->translate(currRow, items) == TdtStatus::FAILED) {
+          return Status(StatusCode::kTDTPushFailure, "TDT Translate Failed");
+        }
+        // an empty row is not pushed, as it ends the push
+        if (!items.empty()) {
+          RETURN_IF_NOT_OK(tdt_items_->Add(std::move(items)));
         }
         total_batch++;
         if (num_batch_ > 0 && total_batch == num_batch_) {
           is_break_loop = true;
         }
       }
+      HistogramTimer timer(input_wait);
       RETURN_IF_NOT_OK(GetNextInput(&current_buffer));
     }
     RETURN_IF_NOT_OK(GetNextInput(&current_buffer));
   }
+  RETURN_IF_NOT_OK(tdt_items_->Add(std::vector<DataItem>()));
 
   MS_LOG(INFO) << "Device queue total batch is " << total_batch << ", number of batches is " << num_batch_ << ".";
 
   return Status::OK();
 }
+
+Status DeviceQueueOp::TdtPushWorker(int32_t worker_id) {
+  TaskManager::FindMe()->Post();
+  auto &registry = MetricsRegistry::GetInstance();
+  auto pending = registry.GetGauge("mindspore_tdt_pending_rows", "The translated rows waiting for the TDT push.");
+  auto push_time = registry.GetHistogram(
+    "mindspore_tdt_push_us", "The microseconds of the TDT pushes, long when the device channel is full.");
+  while (true) {
+    std::vector<DataItem> items;
+    RETURN_IF_NOT_OK(tdt_items_->PopFront(&items));
+    pending->Set(tdt_items_->size());
+    if (items.empty()) {
+      break;
+    }
+    HistogramTimer timer(push_time);
+    TimelineSpan span("DeviceQueueOp.push", "dataset");
+    if (tdtInstancePtr->hostPush(items, channel_name_) == TdtStatus::FAILED) {
+      return Status(StatusCode::kTDTPushFailure, "TDT Push Failed");
+    }
+  }
+  return Status::OK();
+}
 #endif
 
 #ifdef ENABLE_GPUQUE
@@ -141,19 +214,29 @@ Status DeviceQueueOp::SendDataToGPU() {
       for (int row_id = 0;
            row_id < current_buffer->NumRows() && !is_break_loop && !GpuBufferMgr::GetInstance().IsClosed(); row_id++) {
         RETURN_IF_NOT_OK(current_buffer->GetRow(row_id, &curr_row));
-        if (curr_row.size() < 2) {
+        if (curr_row.empty()) {
           return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Invalid tensor size");
         }
-        uint32_t feature_size = static_cast<uint32_t>(curr_row[0]->SizeInBytes());
-        uint32_t label_size = static_cast<uint32_t>(curr_row[1]->SizeInBytes());
+        std::vector<size_t> data_size;
+        for (auto &t : curr_row) {
+          data_size.push_back(static_cast<size_t>(t->SizeInBytes()));
+        }
         if (!is_open) {
-          handle = GpuBufferMgr::GetInstance().Open(0, channel_name_, feature_size, label_size, ReleaseData);
+          host_pools_.clear();
+          for (size_t i = 0; i < data_size.size(); i++) {
+            host_pools_.push_back(std::make_shared<PinnedMemPool>());
+          }
+          auto pools = host_pools_;
+          handle = GpuBufferMgr::GetInstance().Open(0, channel_name_, data_size,
+                                                    [pools](void *addr) { ReleaseData(addr, pools); });
           if (handle == INVALID_HANDLE) {
             return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "open failed");
           }
           is_open = true;
+          InitHostPools(handle, data_size);
         }
-        RETURN_IF_NOT_OK(RetryPushGPUData(feature_size, label_size, curr_row, handle));
+        TimelineSpan span("DeviceQueueOp.push", "dataset");
+        RETURN_IF_NOT_OK(RetryPushGPUData(data_size, curr_row, handle));
         total_batch++;
         if (num_batch_ > 0 && total_batch == num_batch_) {
           is_break_loop = true;
@@ -173,50 +256,73 @@ Status DeviceQueueOp::SendDataToGPU() {
   return Status::OK();
 }
 
-Status DeviceQueueOp::RetryPushGPUData(uint32_t feature_size, uint32_t label_size, const TensorRow &curr_row,
+Status DeviceQueueOp::RetryPushGPUData(const std::vector<size_t> &data_size, const TensorRow &curr_row,
                                        uint32_t handle) {
-  unsigned char *feature_addr = nullptr;
-  unsigned char *label_addr = nullptr;
-  while (true && !GpuBufferMgr::GetInstance().IsClosed()) {
-    RETURN_IF_NOT_OK(MallocForGPUData(&feature_addr, feature_size, &label_addr, label_size, curr_row));
-    auto ret = GpuBufferMgr::GetInstance().Push(handle, feature_addr, feature_size, label_addr, label_size, WAIT_TIME);
+  std::vector<device::DataItemGpu> items;
+  // The host buffers are filled once, a full queue only retries the push
+  RETURN_IF_NOT_OK(MallocForGPUData(&items, data_size, curr_row));
+  while (!GpuBufferMgr::GetInstance().IsClosed()) {
+    auto ret = GpuBufferMgr::GetInstance().Push(handle, items, WAIT_TIME);
     if (ret) {
-      free(feature_addr);
-      free(label_addr);
       MS_LOG(WARNING) << "Retry pushing data...";
       continue;
-    } else {
-      break;
     }
+    return Status::OK();
+  }
+  for (auto &item : items) {
+    ReleaseData(item.data_ptr_, host_pools_);
   }
   return Status::OK();
 }
 
-Status DeviceQueueOp::MallocForGPUData(unsigned char **feature_addr, uint32_t feature_size, unsigned char **label_addr,
-                                       uint32_t label_size, const TensorRow &curr_row) {
-  *feature_addr = (unsigned char *)malloc(feature_size);
-  if (*feature_addr == nullptr) {
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "feature memory malloc failed.");
+Status DeviceQueueOp::MallocForGPUData(std::vector<device::DataItemGpu> *items, const std::vector<size_t> &data_size,
+                                       const TensorRow &curr_row) {
+  items->clear();
+  for (size_t i = 0; i < curr_row.size(); i++) {
+    unsigned char *addr = nullptr;
+    Status rc = GetHostBuffer(i, data_size[i], &addr);
+    if (rc.IsOk() && memcpy_s(addr, data_size[i], curr_row[i]->StartAddr(), data_size[i]) != 0) {
+      MS_LOG(ERROR) << "memcpy_s of column " << i << " failed!";
+      ReleaseData(addr, host_pools_);
+      rc = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "memcpy_s failed.");
+    }
+    if (rc.IsError()) {
+      for (auto &item : *items) {
+        ReleaseData(item.data_ptr_, host_pools_);
+      }
+      items->clear();
+      return rc;
+    }
+    items->push_back({data_size[i], addr});
   }
-  (void)memset_s(*feature_addr, feature_size, 0, feature_size);
-  unsigned char *feature = curr_row[0]->StartAddr();
-  if (memcpy_s(*feature_addr, feature_size, feature, static_cast<uint32_t>(curr_row[0]->SizeInBytes())) != 0) {
-    MS_LOG(ERROR) << "Feature memcpy_s failed!";
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "feature memcpy_s failed.");
+  return Status::OK();
+}
+
+void DeviceQueueOp::InitHostPools(uint32_t handle, const std::vector<size_t> &sizes) {
+  // Every entry of the queue holds its host buffers until the device copy is done, plus the row being filled
+  size_t num_blocks = GpuBufferMgr::GetInstance().Capacity(handle) + 1;
+  for (size_t i = 0; i < sizes.size() && i < host_pools_.size(); i++) {
+    if (!host_pools_[i]->Init(sizes[i], num_blocks)) {
+      return;
+    }
   }
+  MS_LOG(INFO) << "Device queue, " << num_blocks << " page locked host buffers per column.";
+}
 
-  *label_addr = (unsigned char *)malloc(label_size);
-  if (*label_addr == nullptr) {
-    free(*feature_addr);
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "label memory malloc failed.");
+Status DeviceQueueOp::GetHostBuffer(size_t col, size_t size, unsigned char **addr) {
+  *addr = nullptr;
+  if (col < host_pools_.size() && host_pools_[col]->block_size() == size) {
+    // The blocks come back when the device copies of the queue entries are done
+    while (*addr == nullptr && !GpuBufferMgr::GetInstance().IsClosed()) {
+      *addr = static_cast<unsigned char *>(host_pools_[col]->Acquire(WAIT_TIME));
+    }
   }
-  (void)memset_s(*label_addr, label_size, 0, label_size);
-  unsigned char *label = curr_row[1]->StartAddr();
-  if (memcpy_s(*label_addr, label_size, label, static_cast<uint32_t>(curr_row[1]->SizeInBytes())) != 0) {
-    MS_LOG(ERROR) << "Label memcpy_s failed!";
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "label memcpy_s failed.");
+  if (*addr == nullptr) {
+    *addr = static_cast<unsigned char *>(malloc(size));
+    if (*addr == nullptr) {
+      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "host memory malloc failed.");
+    }
   }
-
   return Status::OK();
 }
 #endif
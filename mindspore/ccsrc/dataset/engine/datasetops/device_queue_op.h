@@ -25,12 +25,14 @@
 
 #ifdef ENABLE_TDTQUE
 #include "dataset/engine/tdt/tdt_plugin.h"
-
+#include "dataset/util/queue.h"
 #endif
 
 #ifdef ENABLE_GPUQUE
 #include "device/gpu/gpu_buffer_mgr.h"
+#include "device/gpu/pinned_mem_pool.h"
 using mindspore::device::GpuBufferMgr;
+using mindspore::device::PinnedMemPool;
 #endif
 
 namespace mindspore {
@@ -134,6 +136,14 @@ class DeviceQueueOp : public PipelineOp {
 
   Status operator()() override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "DeviceQueueOp"; }
+
+  // Getter
+  // @return The numa node of the device, found for the GPUs from their PCI bus ids, -1 if it is unknown
+  int32_t DeviceNumaNode() const override;
+
  private:
   //  Name: checkExceptions(DataBuffer);
   //  Description: Check whether the dataBuffer meets the condition for performing DeviceQueueOp
@@ -141,13 +151,28 @@ class DeviceQueueOp : public PipelineOp {
 
 #ifdef ENABLE_TDTQUE
   Status SendDataToAscend();
+  // Pushes the rows translated by the op, so the op takes and translates the next row during a push.
+  // @param worker_id - The id of the worker
+  // @return Status - The error code return
+  Status TdtPushWorker(int32_t worker_id);
 #endif
 
 #ifdef ENABLE_GPUQUE
   Status SendDataToGPU();
-  Status RetryPushGPUData(uint32_t feature_size, uint32_t label_size, const TensorRow &curr_row, uint32_t handle);
-  Status MallocForGPUData(unsigned char **feature_addr, uint32_t feature_size, unsigned char **label_addr,
-                          uint32_t label_size, const TensorRow &curr_row);
+  Status RetryPushGPUData(const std::vector<size_t> &data_size, const TensorRow &curr_row, uint32_t handle);
+  // Copies every column of the row into a host buffer, the descriptors of the GPU queue item.
+  Status MallocForGPUData(std::vector<device::DataItemGpu> *items, const std::vector<size_t> &data_size,
+                          const TensorRow &curr_row);
+  // Sizes the page locked host pools from the first row, one block of each column per entry of the GPU queue.
+  // @param handle - The handle of the opened GPU queue
+  // @param sizes - The size in bytes of each column of the first row
+  void InitHostPools(uint32_t handle, const std::vector<size_t> &sizes);
+  // Gets a host buffer for a column, from its page locked pool when the size matches, else from malloc.
+  // @param col - The column
+  // @param size - The size in bytes of the column
+  // @param addr - The buffer
+  // @return Status - The error code return
+  Status GetHostBuffer(size_t col, size_t size, unsigned char **addr);
 #endif
 
   Status SendDataToCPU();
@@ -159,6 +184,13 @@ class DeviceQueueOp : public PipelineOp {
 
 #ifdef ENABLE_TDTQUE
   std::shared_ptr<TdtPlugin> tdtInstancePtr;
+  // The translated rows waiting for the push, double buffered, an empty row ends the push
+  std::unique_ptr<Queue<std::vector<DataItem>>> tdt_items_;
+#endif
+
+#ifdef ENABLE_GPUQUE
+  // The page locked staging buffers of each column, shared with the release function of the GPU queue
+  std::vector<std::shared_ptr<PinnedMemPool>> host_pools_;
 #endif
 };
 }  // namespace dataset
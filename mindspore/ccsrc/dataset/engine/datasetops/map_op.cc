@@ -15,6 +15,7 @@
  */
 #include "dataset/engine/datasetops/map_op.h"
 #include <cstring>
+#include <deque>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -24,16 +25,22 @@
 #include "dataset/core/global_context.h"
 #include "dataset/core/tensor.h"
 #include "dataset/engine/data_buffer.h"
+#include "dataset/engine/datasetops/batch_slot_pool.h"
 #include "dataset/engine/db_connector.h"
 #include "dataset/engine/execution_tree.h"
+#include "dataset/kernels/image/image_op_fusion.h"
 #include "dataset/kernels/tensor_op.h"
 #include "utils/log_adapter.h"
+#include "dataset/util/executor.h"
+#include "dataset/util/random.h"
+#include "dataset/util/scratch_pool.h"
 #include "dataset/util/task_manager.h"
 
 namespace mindspore {
 namespace dataset {
 // Builder constructor. Creates the builder object.
-MapOp::Builder::Builder() : build_perf_mode_(true) {
+MapOp::Builder::Builder()
+    : build_perf_mode_(true), build_preserve_order_(true), build_fuse_tensor_ops_(true), build_batch_mode_(false) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_num_workers_ = cfg->num_parallel_workers();
   build_op_connector_size_ = cfg->op_connector_size();
@@ -51,26 +58,45 @@ Status MapOp::Builder::sanityCheck() const {
 // The builder "build" method creates the final object.
 Status MapOp::Builder::Build(std::shared_ptr<MapOp> *ptr) {
   RETURN_IF_NOT_OK(sanityCheck());
+  if (build_fuse_tensor_ops_) {
+    RETURN_IF_NOT_OK(FuseImageOps(&build_tensor_funcs_));
+  }
   *ptr = std::make_shared<MapOp>(std::move(build_in_col_names_), std::move(build_out_col_names_),
                                  std::move(build_tensor_funcs_), build_num_workers_, build_op_connector_size_,
-                                 build_perf_mode_);
+                                 build_perf_mode_, build_preserve_order_, build_batch_mode_);
   return Status::OK();
 }
 
 // Constructor of MapOp
 MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std::string> &out_col_names,
              std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size,
-             bool perf_mode)
+             bool perf_mode, bool preserve_order, bool batch_mode)
     : ParallelOp(num_workers, op_connector_size),
+      seed_(0),
       tfuncs_(std::move(tensor_funcs)),
       in_columns_(in_col_names),
       out_columns_(out_col_names),
-      perf_mode_(perf_mode) {
+      perf_mode_(perf_mode && preserve_order),
+      preserve_order_(preserve_order),
+      batch_mode_(batch_mode),
+      rows_mode_(false) {
   // If caller didn't specify the out_col_names, assume they are same as the in_columns.
   if (out_columns_.empty() || out_columns_[0].empty()) {
     out_columns_ = in_columns_;
   }
-  MS_LOG(DEBUG) << "Performance Mode in map operator is " << perf_mode_ << ".";
+  MS_LOG(DEBUG) << "Performance Mode in map operator is " << perf_mode_ << ". Preserve order is " << preserve_order_
+                << ". Batch mode is " << batch_mode_ << ".";
+  if (batch_mode_) {
+    for (const auto &op : tfuncs_) {
+      if (!op->BatchSupported()) {
+        MS_LOG(INFO) << "TensorOp " << *op << " has no batch kernel, it is computed row by row in batch mode.";
+      }
+    }
+  } else {
+    for (const auto &op : tfuncs_) {
+      rows_mode_ = rows_mode_ || op->RowsSupported();
+    }
+  }
 }
 
 // The number of threads consuming data from previous op's output Connector.
@@ -94,11 +120,28 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
   for (size_t i = 0; i < tfuncs_.size(); i++) {
     out << " " << tfuncs_[i];
   }
+  out << "\n  Batch mode: " << batch_mode_;
   out << "\n";
 }
 
 // This class functor will provide the master loop that drives the logic for performing the work
 Status MapOp::operator()() {
+  seed_ = GetSeed();
+  // The rows computed into batch slots wait for the parent, which would hold the threads of the Executor
+  if (perf_mode_ && batch_slots_ == nullptr && GlobalContext::config_manager()->work_stealing()) {
+    TaskManager::FindMe()->Post();
+    std::deque<std::pair<std::shared_ptr<ExecutorJob>, std::unique_ptr<DataBuffer>>> in_flight;
+    Status rc = ExecutorEntry(&in_flight);
+    // The jobs work on the buffers of this op, wait for those which already run even when interrupted
+    for (auto &job : in_flight) {
+      if (job.first != nullptr) {
+        job.first->Cancel();
+        (void)job.first->Wait(false);
+      }
+    }
+    return rc;
+  }
+
   if (perf_mode_) {
     // Create and register the local queues.
     local_queues_.Init(num_workers_, oc_queue_size_);
@@ -112,6 +155,8 @@ Status MapOp::operator()() {
 
   if (perf_mode_) {
     int64_t que_id = 0;
+    int64_t row = 0;
+    RowNumbers numbers = {0, 0, 0};
     std::unique_ptr<DataBuffer> buff;
     bool is_eof = false;
     // Draining output connector of the previous op and distribute it to local queues.
@@ -119,7 +164,21 @@ Status MapOp::operator()() {
     while (!is_eof) {
       RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(&buff, 0));
       is_eof = buff->eof();
-      RETURN_IF_NOT_OK(local_queues_[que_id]->Add(std::move(buff)));
+      // Number the rows in the order the parent receives them
+      numbers.first_row = row;
+      bool is_eoe = buff->eoe();
+      if (is_eoe && batch_slots_ != nullptr) {
+        row = batch_slots_->EndOfEpoch(row);
+      } else {
+        row += buff->NumRows();
+      }
+      RETURN_IF_NOT_OK(local_queues_[que_id]->Add(std::make_pair(std::move(buff), numbers)));
+      if (is_eoe) {
+        numbers.epoch++;
+        numbers.epoch_row = 0;
+      } else {
+        numbers.epoch_row += row - numbers.first_row;
+      }
       que_id = (que_id + 1) % num_workers_;
     }
   }
@@ -127,6 +186,59 @@ Status MapOp::operator()() {
   return Status::OK();
 }
 
+// In executor mode the main thread submits the buffers to the Executor instead of distributing them to the
+// workers, and forwards the results in order. At most num_workers_ buffers of the op are computed at once.
+Status MapOp::ExecutorEntry(
+  std::deque<std::pair<std::shared_ptr<ExecutorJob>, std::unique_ptr<DataBuffer>>> *in_flight) {
+  Executor *executor = Executor::GetInstance();
+  // The output goes to the producers of the Connector in turn, as if each buffer had been computed by a worker
+  int32_t out_id = 0;
+  auto forward_oldest = [this, in_flight, &out_id]() -> Status {
+    auto &oldest = in_flight->front();
+    if (oldest.first == nullptr) {
+      // An eoe or eof buffer
+      RETURN_IF_NOT_OK(oldest.second->eof() ? EofReceived(out_id) : EoeReceived(out_id));
+    } else {
+      RETURN_IF_NOT_OK(oldest.first->Wait());
+      RETURN_IF_NOT_OK(out_connector_->Add(out_id, std::move(oldest.second)));
+    }
+    in_flight->pop_front();
+    out_id = (out_id + 1) % num_workers_;
+    return Status::OK();
+  };
+
+  RowNumbers numbers = {0, 0, 0};
+  bool is_eof = false;
+  while (!is_eof) {
+    std::unique_ptr<DataBuffer> buff;
+    RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(&buff, 0));
+    is_eof = buff->eof();
+    std::shared_ptr<ExecutorJob> job;
+    if (buff->eoe()) {
+      numbers.epoch++;
+      numbers.epoch_row = 0;
+    } else if (!is_eof) {
+      while (in_flight->size() >= static_cast<size_t>(num_workers_)) {
+        RETURN_IF_NOT_OK(forward_oldest());
+      }
+      DataBuffer *in_buffer = buff.get();
+      RowNumbers buffer_numbers = numbers;
+      numbers.epoch_row += in_buffer->NumRows();
+      job = executor->Submit([this, in_buffer, buffer_numbers]() {
+        // Pool threads have no scratch pool of their own
+        return ComputeBuffer(in_buffer, nullptr, &buffer_numbers);
+      });
+    }
+    bool is_control = (job == nullptr);
+    in_flight->emplace_back(std::move(job), std::move(buff));
+    // The parent may wait for the eoe before the next epoch starts, it is not held back
+    while (is_control && !in_flight->empty()) {
+      RETURN_IF_NOT_OK(forward_oldest());
+    }
+  }
+  return Status::OK();
+}
+
 // Private function for worker/thread to loop continuously. It comprises the main
 // logic of MapOp: getting the data from previous Op, validating user specified column names,
 // applying a list of TensorOps to each of the data, process the results and then
@@ -139,6 +251,16 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   // rows at a per-buffer level. ChildIterator abstracts the concept of buffers making it
   // less convenient to use that interface for fetching.
   std::unique_ptr<DataBuffer> in_buffer;
+  SlotState slots = {0, {}, {}};
+  RowNumbers numbers = {0, 0, 0};
+
+  // The intermediate tensors of the rows of this worker come from its own scratch pool, see WorkerCompute
+  std::shared_ptr<ScratchPool> scratch;
+  int32_t scratch_size = GlobalContext::config_manager()->worker_scratch_size();
+  if (scratch_size > 0) {
+    RETURN_IF_NOT_OK(ScratchPool::CreateScratchPool(&scratch, scratch_size, GlobalContext::Instance()->mem_pool()));
+  }
+  MemoryPoolScope scratch_scope(scratch);
 
   // Loop until eof buffer is encountered
   while (true) {
@@ -146,7 +268,11 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     // When PerformanceMode is enabled, workers pop from the local queue.
     // Otherwise, workers pop from the first child output Connector.
     if (perf_mode_) {
-      RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(&in_buffer));
+      std::pair<std::unique_ptr<DataBuffer>, RowNumbers> numbered_buffer;
+      RETURN_IF_NOT_OK(local_queues_[worker_id]->PopFront(&numbered_buffer));
+      in_buffer = std::move(numbered_buffer.first);
+      numbers = numbered_buffer.second;
+      slots.row = numbers.first_row;
     } else {
       RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(&in_buffer, worker_id));
     }
@@ -163,31 +289,12 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       break;
     }
 
-    // Boolean mapping, true means to keep the column.
-    std::vector<bool> keep_input_columns;
-    // Indices of the columns to process.
-    std::vector<size_t> to_process_indices;
-    // The final column mapping after performing this map
-    std::unordered_map<std::string, int32_t> final_col_name_id_map;
-
-    // Thread local variables to avoid lock. When in_columns_ is empty and workers will write
-    // the name of the first column into input_columns (thread local) instead of in_columns_ (thread global).
-    std::vector<std::string> input_columns = in_columns_;
-    std::vector<std::string> output_columns = out_columns_;
-
-    // Initialize the above data structures
-    RETURN_IF_NOT_OK(WorkerEntryInit(in_buffer.get(), &keep_input_columns, &to_process_indices, &final_col_name_id_map,
-                                     &input_columns, &output_columns));
-
-    std::unique_ptr<TensorQTable> new_tensor_table(mindspore::make_unique<TensorQTable>());
-    // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), to_process_indices, new_tensor_table.get(), keep_input_columns,
-                                   &input_columns, &output_columns));
-
-    // Update column name to index mapping because tensorOp might add/remove column.
-    in_buffer->set_column_name_map(final_col_name_id_map);
-    // Replace the TensorTable in DataBuffer with the new one.
-    in_buffer->set_tensor_table(std::move(new_tensor_table));
+    // When the op is auto tuned, only the active workers compute at the same time.
+    RETURN_IF_NOT_OK(AcquireWorker());
+    Status rc = ComputeBuffer(in_buffer.get(), (batch_slots_ != nullptr) ? &slots : nullptr,
+                              perf_mode_ ? &numbers : nullptr);
+    ReleaseWorker();
+    RETURN_IF_NOT_OK(rc);
 
     // Push the buffer onto the connector for next operator to consume.
     RETURN_IF_NOT_OK(out_connector_->Add(static_cast<int>(worker_id), std::move(in_buffer)));
@@ -196,46 +303,124 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   return Status::OK();
 }
 
+Status MapOp::ComputeBuffer(DataBuffer *in_buffer, SlotState *slots, const RowNumbers *numbers) {
+  if (in_buffer->NumRows() == 0 || in_buffer->NumCols() == 0) {
+    RETURN_STATUS_UNEXPECTED("MapOp is getting an empty DataBuffer.");
+  }
+  // The columns to keep and to process, and the final column mapping after performing this map
+  std::shared_ptr<const ColumnLayout> layout;
+  RETURN_IF_NOT_OK(GetColumnLayout(in_buffer, &layout));
+
+  std::unique_ptr<TensorQTable> new_tensor_table(mindspore::make_unique<TensorQTable>());
+  // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
+  RETURN_IF_NOT_OK(WorkerCompute(in_buffer, layout->to_process_indices, new_tensor_table.get(),
+                                 layout->keep_input_columns, layout->input_columns, layout->output_columns, slots,
+                                 numbers));
+
+  // Update column name to index mapping because tensorOp might add/remove column.
+  in_buffer->set_column_name_map(layout->final_map);
+  // Replace the TensorTable in DataBuffer with the new one.
+  in_buffer->set_tensor_table(std::move(new_tensor_table));
+  return Status::OK();
+}
+
+Status MapOp::GetColumnLayout(const DataBuffer *in_buf, std::shared_ptr<const ColumnLayout> *layout) {
+  std::shared_ptr<const ColumnNameMap> in_map = in_buf->shared_column_name_map();
+  {
+    std::unique_lock<std::mutex> lck(layout_mux_);
+    if (layout_ != nullptr && SameColumns(in_map, layout_->in_map)) {
+      *layout = layout_;
+      return Status::OK();
+    }
+  }
+  // When in_columns_ is empty, the name of the first column is written into the input_columns of the layout
+  // instead of in_columns_.
+  auto new_layout = std::make_shared<ColumnLayout>();
+  new_layout->in_map = std::move(in_map);
+  new_layout->input_columns = in_columns_;
+  new_layout->output_columns = out_columns_;
+  std::unordered_map<std::string, int32_t> final_col_name_id_map;
+  RETURN_IF_NOT_OK(WorkerEntryInit(in_buf, &new_layout->keep_input_columns, &new_layout->to_process_indices,
+                                   &final_col_name_id_map, &new_layout->input_columns, &new_layout->output_columns));
+  new_layout->final_map = std::make_shared<const ColumnNameMap>(std::move(final_col_name_id_map));
+  std::unique_lock<std::mutex> lck(layout_mux_);
+  layout_ = new_layout;
+  *layout = std::move(new_layout);
+  return Status::OK();
+}
+
 Status MapOp::WorkerCompute(DataBuffer *in_buffer, const std::vector<size_t> &to_process_indices,
                             TensorQTable *new_tensor_table, const std::vector<bool> &keep_input_columns,
-                            std::vector<std::string> *input_columns, std::vector<std::string> *output_columns) {
+                            const std::vector<std::string> &input_columns,
+                            const std::vector<std::string> &output_columns, SlotState *slots,
+                            const RowNumbers *numbers) {
   // Getting number of rows and cols in this buffer.
   int32_t num_rows = in_buffer->NumRows();
+  std::shared_ptr<MemoryPool> scratch = ScratchPool::ThreadPool();
   int32_t num_cols = in_buffer->NumCols();
 
+  // to_process   : The rows of Tensors only holding cols in input_columns.
+  // result_rows  : The rows of Tensors to hold the result after Compute().
+  // cur_rows     : The rows of Tensors holding all the columns from DataBuffer.
+  std::vector<TensorRow> to_process(num_rows), result_rows(num_rows), cur_rows(num_rows);
   for (int32_t r = 0; r < num_rows; r++) {
-    // to_process   : A vector of Tensors only holding cols in input_columns.
-    // result_row;  : A vector of Tensors to hold the result after Compute().
-    // cur_row      : A vector of Tensors holding all the columns from DataBuffer.
-    TensorRow to_process, result_row, cur_row;
-    RETURN_IF_NOT_OK(in_buffer->PopRow(&cur_row));
-
+    RETURN_IF_NOT_OK(in_buffer->PopRow(&cur_rows[r]));
     // Populate the Tensor from the current row to be processed by TensorOp
     for (const auto &idx : to_process_indices) {
-      to_process.push_back(std::move(cur_row[idx]));
+      to_process[r].push_back(std::move(cur_rows[r][idx]));
     }
+  }
 
-    // Looping over multiple TensorOps supplied in to MapOp.
-    // The assumption is that the result of one TensorOp matches the required input to the next TensorOp.
-    for (size_t i = 0; i < tfuncs_.size(); i++) {
-      // TensorOp can operate on single col or multiple cols. MapOp always call compute for multiple cols.
-      // TensorOp base class will call the single column Compute() depending on the ops.
-      // Note: The columns of the result_row is not preallocated, the compute function of each tensor op are
-      // required to resize/push back the result_row
-      RETURN_IF_NOT_OK(tfuncs_[i]->Compute(to_process, &result_row));
-
-      // Assign result_row to to_process for the next TensorOp processing, except for the last TensorOp in the list.
-      if (i + 1 < tfuncs_.size()) {
-        to_process = std::move(result_row);
+  // Looping over multiple TensorOps supplied in to MapOp, TensorOp by TensorOp in rows mode, else row by row.
+  // The assumption is that the result of one TensorOp matches the required input to the next TensorOp.
+  size_t num_ops = tfuncs_.size();
+  int32_t num_passes = rows_mode_ ? 1 : num_rows;
+  for (int32_t pass = 0; pass < num_passes; pass++) {
+    for (size_t i = 0; i < num_ops; i++) {
+      // Only the results of the last TensorOp leave the row, they are not taken from the scratch pool
+      MemoryPoolScope scope(i + 1 < num_ops ? scratch : nullptr);
+      bool last_into_slots = slots != nullptr && i + 1 == num_ops;
+      if (rows_mode_ && tfuncs_[i]->RowsSupported() && !last_into_slots) {
+        RETURN_IF_NOT_OK(tfuncs_[i]->RowsCompute(to_process, &result_rows));
+        if (result_rows.size() != static_cast<size_t>(num_rows)) {
+          RETURN_STATUS_UNEXPECTED("Result of a tensorOp doesn't have a row per input row");
+        }
+      } else {
+        int32_t first = rows_mode_ ? 0 : pass;
+        int32_t last = rows_mode_ ? num_rows : pass + 1;
+        for (int32_t r = first; r < last; r++) {
+          // The random ops draw from the stream of the row when the main thread numbers the rows
+          std::unique_ptr<RowRandomScope> random_scope;
+          if (numbers != nullptr) {
+            random_scope = mindspore::make_unique<RowRandomScope>(seed_, numbers->epoch, numbers->epoch_row + r,
+                                                                  static_cast<uint32_t>(i));
+          }
+          RETURN_IF_NOT_OK(ComputeRow(i, to_process[r], slots, &result_rows[r]));
+        }
+      }
+
+      // Assign the results to to_process for the next TensorOp processing, except for the last TensorOp in the list.
+      if (i + 1 < num_ops) {
+        if (rows_mode_) {
+          to_process = std::move(result_rows);
+          result_rows.assign(num_rows, TensorRow());
+        } else {
+          to_process[pass] = std::move(result_rows[pass]);
+          result_rows[pass].clear();
+        }
       }
     }
+  }
 
-    if (output_columns->size() != result_row.size()) {
+  for (int32_t r = 0; r < num_rows; r++) {
+    TensorRow &result_row = result_rows[r];
+    TensorRow &cur_row = cur_rows[r];
+    if (output_columns.size() != result_row.size()) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "Result of a tensorOp doesn't match output column names");
     }
 
-    if (input_columns->size() == output_columns->size()) {
+    if (input_columns.size() == output_columns.size()) {
       for (size_t i = 0; i < result_row.size(); i++) {
         cur_row[to_process_indices[i]] = std::move(result_row[i]);
       }
@@ -256,6 +441,44 @@ Status MapOp::WorkerCompute(DataBuffer *in_buffer, const std::vector<size_t> &to
   return Status::OK();
 }
 
+Status MapOp::ComputeRow(size_t i, const TensorRow &to_process, SlotState *slots, TensorRow *result_row) {
+  // TensorOp can operate on single col or multiple cols. MapOp always call compute for multiple cols.
+  // TensorOp base class will call the single column Compute() depending on the ops.
+  // Note: The columns of the result_row is not preallocated, the compute function of each tensor op are
+  // required to resize/push back the result_row
+  // In batch mode the row holds a whole batch, see batch_mode_.
+  if (slots != nullptr && i + 1 == tfuncs_.size()) {
+    return ComputeIntoSlot(tfuncs_[i], to_process, slots, result_row);
+  } else if (batch_mode_) {
+    return tfuncs_[i]->BatchCompute(to_process, result_row);
+  }
+  return tfuncs_[i]->Compute(to_process, result_row);
+}
+
+Status MapOp::ComputeIntoSlot(const std::shared_ptr<TensorOp> &op, const TensorRow &to_process, SlotState *slots,
+                              TensorRow *result_row) {
+  if (to_process.size() != 1) {
+    RETURN_STATUS_UNEXPECTED("Computing into a batch slot needs a single input column.");
+  }
+  // Every row asks for its slot, the batch is only allocated once a row has shown the shape of the results.
+  TensorRow slot_row;
+  RETURN_IF_NOT_OK(batch_slots_->GetSlots(slots->row++, slots->shapes, slots->types, &slot_row));
+  // An op which does not write into the given output replaces it, the BatchOp then copies the row.
+  std::shared_ptr<Tensor> out = slot_row.empty() ? nullptr : slot_row[0];
+  RETURN_IF_NOT_OK(op->Compute(to_process[0], &out));
+  RETURN_UNEXPECTED_IF_NULL(out);
+  slots->shapes = {out->shape()};
+  slots->types = {out->type()};
+  result_row->clear();
+  result_row->push_back(std::move(out));
+  return Status::OK();
+}
+
+bool MapOp::BatchSlotsSupported() const {
+  return perf_mode_ && !batch_mode_ && in_columns_.size() <= 1 && out_columns_.size() <= 1 && !tfuncs_.empty() &&
+         tfuncs_.back()->OneToOne();
+}
+
 // Validating if each of the input_columns exists in the DataBuffer.
 Status MapOp::ValidateInColumns(const std::unordered_map<std::string, int32_t> &col_name_id_map,
                                 std::vector<std::string> *input_columns) {
@@ -274,11 +497,7 @@ Status MapOp::WorkerEntryInit(const DataBuffer *in_buf, std::vector<bool> *keep_
                               std::vector<size_t> *to_process_indices,
                               std::unordered_map<std::string, int32_t> *final_col_name_id_map,
                               std::vector<std::string> *input_columns, std::vector<std::string> *output_columns) {
-  int32_t num_rows = in_buf->NumRows();
   int32_t num_cols = in_buf->NumCols();
-  if (num_rows == 0 || num_cols == 0) {
-    RETURN_STATUS_UNEXPECTED("MapOp is getting an empty DataBuffer.");
-  }
   std::unordered_map<std::string, int32_t> col_name_id_map = in_buf->column_name_map();
   // Check if there is invalid column name in the inColumns.
   RETURN_IF_NOT_OK(ValidateInColumns(col_name_id_map, input_columns));
@@ -16,11 +16,14 @@
 #ifndef DATASET_ENGINE_DATASETOPS_MAP_OP_H_
 #define DATASET_ENGINE_DATASETOPS_MAP_OP_H_
 
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
+#include "dataset/engine/data_buffer.h"
 #include "dataset/engine/datasetops/parallel_op.h"
 #include "dataset/kernels/tensor_op.h"
 #include "dataset/util/queue.h"
@@ -28,7 +31,9 @@
 namespace mindspore {
 namespace dataset {
 // Forward declare
+class BatchSlotPool;
 class DataBuffer;
+class ExecutorJob;
 class ExecutionTree;
 
 // MapOp class implements the Map operator. It will apply a list of operations to each record specified by column names.
@@ -114,6 +119,29 @@ class MapOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetPreserveOrder(bool preserve_order) {
+      build_preserve_order_ = preserve_order;
+      return *this;
+    }
+
+    // Setter method.
+    // @param fuse_tensor_ops - T/F to replace the known chains of TensorOps by fused kernels.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetFuseTensorOps(bool fuse_tensor_ops) {
+      build_fuse_tensor_ops_ = fuse_tensor_ops;
+      return *this;
+    }
+
+    // Setter method.
+    // @param batch_mode - T/F if the input rows are whole batches, see batch_mode_.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetBatchMode(bool batch_mode) {
+      build_batch_mode_ = batch_mode;
+      return *this;
+    }
+
     // The builder "build" method creates the final object.
     // @param ptr The shared_ptr to the new MapOp object
     // @return Status
@@ -125,7 +153,10 @@ class MapOp : public ParallelOp {
     std::vector<std::shared_ptr<TensorOp>> build_tensor_funcs_;
     int32_t build_num_workers_;
     int32_t build_op_connector_size_;
-    bool build_perf_mode_;  // Default true.
+    bool build_perf_mode_;        // Default true.
+    bool build_preserve_order_;   // Default true.
+    bool build_fuse_tensor_ops_;  // Default true.
+    bool build_batch_mode_;       // Default false.
 
     // Check if the required parameters are set by the builder.
     // @return Status The error code return
@@ -139,9 +170,12 @@ class MapOp : public ParallelOp {
   // @param tensor_funcs A list of TensorOp pointers for MapOp to apply to each data.
   // @param num_workers The number of worker threads.
   // @param op_connector_size The size of each queue in the connector.
+  // @param perf_mode See perf_mode_.
+  // @param preserve_order See preserve_order_.
+  // @param batch_mode See batch_mode_.
   MapOp(const std::vector<std::string> &in_col_names, const std::vector<std::string> &out_col_names,
         std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size,
-        bool perf_mode);
+        bool perf_mode, bool preserve_order = true, bool batch_mode = false);
 
   // Destructor
   ~MapOp() = default;
@@ -151,6 +185,14 @@ class MapOp : public ParallelOp {
   // @param show_all A bool to control if you want to show all info or just a summary
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "MapOp"; }
+
+  // Getter
+  // @return T/F if the number of running workers can be tuned while the tree executes
+  bool AutoTunable() const override { return true; }
+
   // << Stream output operator overload
   // @notes This allows you to write the debug print info using stream operators
   // @param out reference to the output stream being overloaded
@@ -171,11 +213,33 @@ class MapOp : public ParallelOp {
   // @return the number of threads consuming data from previous op's output Connector.
   int32_t num_consumers() const override;
 
+  // Getter
+  // @return T/F if the workers need the buffers from the previous op in order.
+  bool InputOrderRequired() const override { return preserve_order_; }
+
+  // Getter
+  // @return T/F if the rows can be computed into the batch slots of a parent BatchOp, see batch_slots_.
+  bool BatchSlotsSupported() const;
+
+  // Setter, called by the parent BatchOp before the tree is launched.
+  // @param batch_slots - The batch tensors of the parent to compute the rows into
+  void set_batch_slots(std::shared_ptr<BatchSlotPool> batch_slots) { batch_slots_ = std::move(batch_slots); }
+
  private:
   // Local queues where worker threads can pop from.
   // Popping directly from the Connector can block if the previous designated threads haven't pop.
   // Setting the size of these queues to 0 is essentially the same as pulling directly from Connector.
-  QueueList<std::unique_ptr<DataBuffer>> local_queues_;
+  // Each buffer comes with the numbers of its rows, see RowNumbers.
+  struct RowNumbers {
+    int64_t first_row;  // The number of the first row since the launch, see batch_slots_
+    int32_t epoch;      // The epoch of the buffer
+    int64_t epoch_row;  // The number of the first row in its epoch
+  };
+  QueueList<std::pair<std::unique_ptr<DataBuffer>, RowNumbers>> local_queues_;
+
+  // The seed of the random streams of the rows. In Performance mode each row is computed in a RowRandomScope,
+  // the random TensorOps then draw the same numbers for a row whichever worker computes it.
+  uint32_t seed_;
 
   // Static variables to be ready by worker threads, no modification and readonly
   const std::vector<std::shared_ptr<TensorOp>> tfuncs_;
@@ -193,6 +257,49 @@ class MapOp : public ParallelOp {
   // cause additional blocking because pop calls to Connector from the threads are synchronized to enforce the order.
   bool perf_mode_;
 
+  // When the row order does not matter, the workers pull from an unordered lock free Connector and every
+  // worker forwards its own copy of the eoe/eof buffers. There is then nothing to gain from Performance
+  // mode, so it is turned off.
+  bool preserve_order_;
+
+  // Batch mode is when the map is placed after a BatchOp: every row of a DataBuffer holds a whole batch, with
+  // the rows of the batch stacked along the first dimension of each tensor. The TensorOps are then called
+  // through BatchCompute() once per batch, so the ops which have a batch kernel run a single loop over the
+  // whole batch and the others fall back to one Compute() per row of the batch.
+  bool batch_mode_;
+
+  // Rows mode is when one of the TensorOps works on all the rows of a DataBuffer at once (see
+  // TensorOp::RowsSupported), e.g. a Python function which takes the GIL once for all the rows. Each TensorOp is
+  // then applied on every row of the buffer before the next one, instead of all the TensorOps row by row.
+  bool rows_mode_;
+
+  // When the parent is a BatchOp in place mode, the last TensorOp writes each row straight into its slot of the
+  // batch tensors (see BatchSlotPool), so the BatchOp does not need to copy it. The main thread numbers the
+  // rows as it distributes the buffers, so this needs the Performance mode and a single 1-1 output column.
+  std::shared_ptr<BatchSlotPool> batch_slots_;
+
+  // The columns of the buffers with one column name mapping, resolved by the first of them and then shared by the
+  // workers until the mapping of the input changes.
+  struct ColumnLayout {
+    std::shared_ptr<const ColumnNameMap> in_map;     // The mapping of the input buffers
+    std::vector<bool> keep_input_columns;            // true for the columns not used by the TensorOps
+    std::vector<size_t> to_process_indices;          // Indices of the columns processed by the TensorOps
+    std::vector<std::string> input_columns;          // The names of the input columns, the first one if none given
+    std::vector<std::string> output_columns;         // The names of the output columns
+    std::shared_ptr<const ColumnNameMap> final_map;  // The mapping of the output buffers
+  };
+
+  // The layout of the last input mapping, guarded by layout_mux_
+  std::mutex layout_mux_;
+  std::shared_ptr<const ColumnLayout> layout_;
+
+  // The state of a worker which computes its rows into the batch slots
+  struct SlotState {
+    int64_t row;                      // The number of the next row of the worker
+    std::vector<TensorShape> shapes;  // The shapes of the last result, empty until the worker has one
+    std::vector<DataType> types;      // The types of the last result
+  };
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -201,6 +308,24 @@ class MapOp : public ParallelOp {
   // @return Status The error code return
   Status WorkerEntry(int32_t worker_id) override;  //  In: workerId assigned by tree_
 
+  // Private function for the main thread to compute the buffers on the Executor, see ConfigManager::work_stealing.
+  // @param in_flight The buffers being computed with their jobs, oldest first. An eoe or eof buffer has no job.
+  // @return Status The error code return
+  Status ExecutorEntry(std::deque<std::pair<std::shared_ptr<ExecutorJob>, std::unique_ptr<DataBuffer>>> *in_flight);
+
+  // Private function to compute a buffer in place, by a worker or by a job of the Executor.
+  // @param in_buffer The buffer, its tensor table is replaced by the results.
+  // @param slots The batch slots state of the current thread, nullptr if the rows are not computed into slots.
+  // @param numbers The numbers of the rows of the buffer, nullptr if the main thread does not number them.
+  // @return Status The error code return
+  Status ComputeBuffer(DataBuffer *in_buffer, SlotState *slots, const RowNumbers *numbers);
+
+  // Private function to get the column layout of a buffer, resolved again only when its mapping changed.
+  // @param in_buf The buffer.
+  // @param[out] layout The layout of the columns of the buffer.
+  // @return Status The error code return
+  Status GetColumnLayout(const DataBuffer *in_buf, std::shared_ptr<const ColumnLayout> *layout);
+
   // Private function for worker thread to perform TensorOp's compute function and get the result.
   // @param in_buffer A raw pointer to the DataBuffer. A raw pointer is fine because this function doesn't manage memory
   //     and is not shared with other threads.
@@ -209,9 +334,29 @@ class MapOp : public ParallelOp {
   // @param keep_input_columns Keeping track of which columns to keep (not used by TensorOp).
   // @param input_columns The vector of input column names used in the current thread.
   // @param output_columns The vector of output column names used in the current thread.
+  // @param slots The batch slots state of the current thread, nullptr if the rows are not computed into slots.
+  // @param numbers The numbers of the rows of the buffer, nullptr if the main thread does not number them.
   Status WorkerCompute(DataBuffer *in_buffer, const std::vector<size_t> &to_process_indices,
                        TensorQTable *new_tensor_table, const std::vector<bool> &keep_input_columns,
-                       std::vector<std::string> *input_columns, std::vector<std::string> *output_columns);
+                       const std::vector<std::string> &input_columns, const std::vector<std::string> &output_columns,
+                       SlotState *slots, const RowNumbers *numbers);
+
+  // Private function for worker thread to compute one TensorOp on one row.
+  // @param i The index of the TensorOp.
+  // @param to_process The input of the op.
+  // @param slots The batch slots state of the current thread, nullptr if the rows are not computed into slots.
+  // @param[out] result_row The result of the op.
+  // @return Status The error code return
+  Status ComputeRow(size_t i, const TensorRow &to_process, SlotState *slots, TensorRow *result_row);
+
+  // Private function for worker thread to compute the last TensorOp of a row into its batch slot.
+  // @param op The last TensorOp, a 1-1 op.
+  // @param to_process The input of the op.
+  // @param slots The batch slots state of the current thread.
+  // @param[out] result_row The result of the op, in its slot when the op writes into the given output.
+  // @return Status The error code return
+  Status ComputeIntoSlot(const std::shared_ptr<TensorOp> &op, const TensorRow &to_process, SlotState *slots,
+                         TensorRow *result_row);
 
   // Private function for validating if each of the user specified input column names
   // exist in the DataBuffer.
@@ -15,6 +15,7 @@
  */
 #include "dataset/engine/datasetops/parallel_op.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <map>
@@ -36,10 +37,13 @@ ParallelOp::ParallelOp(int32_t num_workers, int32_t op_connector_size)
       num_workers_(num_workers),
       num_producers_(num_workers),
       worker_connector_size_(1),
-      worker_connector_(nullptr) {}
+      worker_connector_(nullptr),
+      throttled_(false),
+      active_workers_(num_workers),
+      busy_workers_(0) {}
 
 // Creates the internal worker connector for the parallel op if the derived class wants to use it
-Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
+Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size, bool ordered) {
   if (worker_connector_size == 0) {
     RETURN_STATUS_UNEXPECTED("Worker connector size 0 is invalid.");
   }
@@ -48,7 +52,8 @@ Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
   // Instantiate the worker connector.  This is the internal connector, not the operators
   // output connector.  It has single master consuming from it (num producers is 1), and the number
   // of workers is the defined count from the op.
-  worker_connector_ = mindspore::make_unique<DbConnector>(num_workers_, num_producers_, worker_connector_size);
+  worker_connector_ =
+    mindspore::make_unique<DbConnector>(num_workers_, num_producers_, worker_connector_size, false, ordered);
 
   return Status::OK();
 }
@@ -78,10 +83,51 @@ Status ParallelOp::Reset() {
 
 // Register the internal worker connectors
 Status ParallelOp::RegisterWorkerConnectors() {
+  if (throttled_) {
+    RETURN_IF_NOT_OK(throttle_cv_.Register(tree_->AllTasks()->GetIntrpService()));
+  }
   if (worker_connector_) {
     return (worker_connector_->Register(tree_->AllTasks()));
   }
   return Status::OK();
 }
+
+// Turns on the worker throttle
+void ParallelOp::EnableWorkerThrottle() {
+  std::unique_lock<std::mutex> lck(throttle_mux_);
+  throttled_ = true;
+  active_workers_ = num_workers_;
+}
+
+// Changes the number of workers allowed to compute at the same time
+void ParallelOp::set_active_workers(int32_t active_workers) {
+  std::unique_lock<std::mutex> lck(throttle_mux_);
+  if (!throttled_) {
+    return;
+  }
+  active_workers_ = std::min(std::max(active_workers, 1), num_workers_);
+  throttle_cv_.NotifyAll();
+}
+
+// Blocks a worker until it is allowed to compute
+Status ParallelOp::AcquireWorker() {
+  if (!throttled_) {
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> lck(throttle_mux_);
+  RETURN_IF_NOT_OK(throttle_cv_.Wait(&lck, [this]() { return busy_workers_ < active_workers_; }));
+  ++busy_workers_;
+  return Status::OK();
+}
+
+// Marks the end of the compute step of a worker
+void ParallelOp::ReleaseWorker() {
+  if (!throttled_) {
+    return;
+  }
+  std::unique_lock<std::mutex> lck(throttle_mux_);
+  --busy_workers_;
+  throttle_cv_.NotifyAll();
+}
 }  // namespace dataset
 }  // namespace mindspore
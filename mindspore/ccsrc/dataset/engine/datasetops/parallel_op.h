@@ -16,10 +16,13 @@
 #ifndef DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 #define DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "dataset/core/constants.h"
 #include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/util/cond_var.h"
 #include "dataset/util/status.h"
 
 namespace mindspore {
@@ -46,8 +49,10 @@ class ParallelOp : public DatasetOp {
   // Creates the internal worker connector for the parallel op if the derived class wants to use it.
   // @notes This changes the number of producers of this op to 1, since it establishes a master/worker
   // relationship within the op, making all production flow through a single master.
+  // @param worker_connector_size - The capacity of the queue of each worker
+  // @param ordered - When false the master pops the buffers in the order the workers finish them, not round robin
   // @return Status - The error return code
-  Status CreateWorkerConnector(int32_t worker_connector_size);
+  Status CreateWorkerConnector(int32_t worker_connector_size, bool ordered = true);
 
   // A print method typically used for debugging
   // @param out - The output stream to write output to
@@ -98,16 +103,48 @@ class ParallelOp : public DatasetOp {
   // @return Status
   Status RegisterWorkerConnectors() override;
 
+  // Getter
+  // @return T/F if the number of running workers of this op can be tuned while the tree executes
+  virtual bool AutoTunable() const { return false; }
+
+  // Turns on the worker throttle. All num_workers_ threads are still launched, but only the active
+  // ones run their compute step at the same time. Must be called before the tree is launched.
+  void EnableWorkerThrottle();
+
+  // Setter
+  // @param active_workers - The number of workers allowed to compute at the same time, clamped
+  //     between 1 and num_workers_. No op unless the worker throttle is on.
+  void set_active_workers(int32_t active_workers);
+
+  // Getter
+  // @return The number of workers allowed to compute at the same time
+  int32_t active_workers() const { return throttled_ ? active_workers_.load() : num_workers_; }
+
  protected:
   // Interface for derived classes to implement. All derived classes must provide the entry
   // function with the main execution loop for worker threads.
   // @return Status - The error code return
   virtual Status WorkerEntry(int32_t workerId) = 0;
 
+  // Blocks a worker until it is allowed to compute. Returns immediately when the throttle is off.
+  // Every successful call must be paired with a ReleaseWorker().
+  // @return Status - The error code return
+  Status AcquireWorker();
+
+  // Marks the end of the compute step of a worker.
+  void ReleaseWorker();
+
   int32_t num_workers_;    // The number of worker threads
   int32_t num_producers_;  // The number of threads pushing to the out_connector_
   int32_t worker_connector_size_;
   std::unique_ptr<DbConnector> worker_connector_;  // The internal connector for worker threads
+
+ private:
+  bool throttled_;                       // Worker throttle is on
+  std::atomic<int32_t> active_workers_;  // Workers allowed to compute at the same time
+  int32_t busy_workers_;                 // Workers computing now
+  std::mutex throttle_mux_;
+  CondVar throttle_cv_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -66,29 +66,61 @@ Status ProjectOp::GetNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t w
   return Status::OK();
 }
 
-Status ProjectOp::Project(std::unique_ptr<DataBuffer> *data_buffer) {
-  std::unordered_map<std::string, int32_t> column_name_mapping = (*data_buffer)->column_name_map();
-  std::unordered_map<std::string, int32_t> new_column_name_mapping;
+Status ProjectOp::ResolveColumns(const std::shared_ptr<const ColumnNameMap> &in_column_map) {
+  const ColumnNameMap empty_map;
+  const ColumnNameMap &column_name_mapping = (in_column_map == nullptr) ? empty_map : *in_column_map;
+  auto new_column_name_mapping = std::make_shared<ColumnNameMap>();
   std::vector<int32_t> projected_column_indices;
   for (size_t i = 0; i < columns_to_project_.size(); i++) {
     std::string &current_column = columns_to_project_[i];
-    if (column_name_mapping.find(current_column) == column_name_mapping.end()) {
+    auto itr = column_name_mapping.find(current_column);
+    if (itr == column_name_mapping.end()) {
       std::string err_msg = "ProjectOp: column " + current_column + " does not exist in this buffer.";
       RETURN_STATUS_UNEXPECTED(err_msg);
     }
-    new_column_name_mapping[current_column] = i;
-    projected_column_indices.push_back(column_name_mapping[current_column]);
+    (*new_column_name_mapping)[current_column] = i;
+    projected_column_indices.push_back(itr->second);
+  }
+  // Projecting all the columns in their order leaves the rows as they are
+  bool identity = projected_column_indices.size() == column_name_mapping.size();
+  for (size_t i = 0; identity && i < projected_column_indices.size(); i++) {
+    identity = projected_column_indices[i] == static_cast<int32_t>(i);
+  }
+  identity_ = identity;
+  in_column_map_ = in_column_map;
+  out_column_map_ = std::move(new_column_name_mapping);
+  projected_column_indices_ = std::move(projected_column_indices);
+  return Status::OK();
+}
+
+Status ProjectOp::Project(std::unique_ptr<DataBuffer> *data_buffer) {
+  std::shared_ptr<const ColumnNameMap> new_column_name_mapping;
+  std::vector<int32_t> projected_column_indices;
+  bool identity = false;
+  {
+    std::shared_ptr<const ColumnNameMap> column_name_mapping = (*data_buffer)->shared_column_name_map();
+    std::unique_lock<std::mutex> lck(column_map_mux_);
+    if (out_column_map_ == nullptr || !SameColumns(column_name_mapping, in_column_map_)) {
+      RETURN_IF_NOT_OK(ResolveColumns(column_name_mapping));
+    }
+    new_column_name_mapping = out_column_map_;
+    projected_column_indices = projected_column_indices_;
+    identity = identity_;
   }
-  std::unique_ptr<TensorQTable> new_tensor_table = mindspore::make_unique<TensorQTable>();
-  while ((*data_buffer)->NumRows() > 0) {
-    TensorRow current_row;
-    RETURN_IF_NOT_OK((*data_buffer)->PopRow(&current_row));
-    TensorRow new_row;
-    (void)std::transform(projected_column_indices.begin(), projected_column_indices.end(), std::back_inserter(new_row),
-                         [&current_row](uint32_t x) { return current_row[x]; });
-    new_tensor_table->push_back(new_row);
+  if (!identity) {
+    // The rows are projected in place in the table of the buffer
+    std::unique_ptr<TensorQTable> tensor_table = (*data_buffer)->TakeTensorTable();
+    if (tensor_table != nullptr) {
+      for (TensorRow &current_row : *tensor_table) {
+        TensorRow new_row;
+        new_row.reserve(projected_column_indices.size());
+        (void)std::transform(projected_column_indices.begin(), projected_column_indices.end(),
+                             std::back_inserter(new_row), [&current_row](uint32_t x) { return current_row[x]; });
+        current_row = std::move(new_row);
+      }
+    }
+    (*data_buffer)->set_tensor_table(std::move(tensor_table));
   }
-  (*data_buffer)->set_tensor_table(std::move(new_tensor_table));
   (*data_buffer)->set_column_name_map(new_column_name_mapping);
   return Status::OK();
 }
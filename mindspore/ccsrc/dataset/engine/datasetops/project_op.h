@@ -17,9 +17,11 @@
 #define DATASET_ENGINE_DATASETOPS_PROJECT_OP_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "dataset/engine/data_buffer.h"
 #include "dataset/engine/datasetops/pipeline_op.h"
 
 namespace mindspore {
@@ -60,6 +62,10 @@ class ProjectOp : public PipelineOp {
   // @param show_all - A bool to control if you want to show all info or just a summary.
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "ProjectOp"; }
+
   // << Stream output operator overload.
   // @notes This allows you to write the debug print info using stream operators.
   // @param out - reference to the output stream being overloaded.
@@ -104,7 +110,21 @@ class ProjectOp : public PipelineOp {
  private:
   std::vector<std::string> columns_to_project_;
 
+  // The columns are resolved once per mapping of the input, not per buffer. The parent may pull from many
+  // workers, the mutex guards the resolved mapping.
+  std::mutex column_map_mux_;
+  std::shared_ptr<const ColumnNameMap> in_column_map_;
+  std::shared_ptr<const ColumnNameMap> out_column_map_;
+  std::vector<int32_t> projected_column_indices_;
+  // T/F if the projection keeps all the columns in their order, then only the mapping changes
+  bool identity_ = false;
+
   Status Project(std::unique_ptr<DataBuffer> *data_buffer);
+
+  // Finds the projected columns in a mapping of the input
+  // @param in_column_map - the mapping of the input buffer
+  // @return Status - The error code returned.
+  Status ResolveColumns(const std::shared_ptr<const ColumnNameMap> &in_column_map);
 };
 }  // namespace dataset
 }  // namespace mindspore
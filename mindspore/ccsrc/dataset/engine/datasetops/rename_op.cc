@@ -19,9 +19,7 @@
 #include <utility>
 #include <unordered_map>
 
-#include "dataset/core/config_manager.h"
 #include "dataset/core/constants.h"
-#include "dataset/core/global_context.h"
 #include "dataset/engine/data_buffer.h"
 #include "dataset/engine/db_connector.h"
 #include "utils/log_adapter.h"
@@ -30,13 +28,10 @@ namespace mindspore {
 namespace dataset {
 // builds
 RenameOp::Builder::Builder() {
-  // Some arguments to the RenameOp constructor have a default argument that is taken
-  // from the client config.
-  // The user may choose to change these values for the construction of the RenameOp by
-  // using the various builder set methods.
-
-  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
-  builder_op_connector_size_ = cfg->op_connector_size();
+  // A rename only changes the column name map of the buffers, by default it is done inlined in the thread of
+  // the parent, without a connector.
+  // The user may choose to give the RenameOp its own connector by using the builder set methods.
+  builder_op_connector_size_ = 0;
 }
 
 Status RenameOp::Builder::SanityCheck() const { return Status::OK(); }
@@ -63,6 +58,9 @@ RenameOp::~RenameOp() {}
 
 // main entry point for rename
 Status RenameOp::operator()() {
+  if (inlined()) {
+    RETURN_STATUS_UNEXPECTED("Logic error. RenameOp is an inlined operator.");
+  }
   TaskManager::FindMe()->Post();
   std::unique_ptr<DataBuffer> curr_buffer;
   RETURN_IF_NOT_OK(GetNextInput(&curr_buffer));
@@ -94,11 +92,55 @@ Status RenameOp::operator()() {
   return Status::OK();
 }
 
+Status RenameOp::GetNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t worker_id, bool retry_if_eoe) {
+  if (!inlined()) {
+    return PipelineOp::GetNextBuffer(p_buffer, worker_id, retry_if_eoe);
+  }
+  RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(p_buffer, worker_id, retry_if_eoe));
+  if (!((*p_buffer)->eoe()) && !((*p_buffer)->eof())) {
+    RETURN_IF_NOT_OK(RenameBuffer(p_buffer));
+  }
+  return Status::OK();
+}
+
+int32_t RenameOp::num_consumers() const {
+  if (!inlined()) {
+    return PipelineOp::num_consumers();
+  }
+  if (parent_.empty()) {
+    MS_LOG(INFO) << "Rename operator, no parent node, assuming it's the root and returning 1.";
+    return 1;
+  } else if (parent_[0] == nullptr) {
+    MS_LOG(INFO) << "Rename operator, pointer to the first parent is null. Returning 0.";
+    return 0;
+  } else {
+    return parent_[0]->num_consumers();
+  }
+}
+
+int32_t RenameOp::num_producers() const {
+  if (!inlined()) {
+    return PipelineOp::num_producers();
+  }
+  if (child_.empty() || child_[0] == nullptr) {
+    MS_LOG(INFO) << "Rename operator, pointer to child node is null. Returning 0.";
+    return 0;
+  } else {
+    return child_[0]->num_producers();
+  }
+}
+
 // renames buffer
 Status RenameOp::RenameBuffer(std::unique_ptr<DataBuffer> *input_buffer) {
+  std::shared_ptr<const ColumnNameMap> in_column_map = (*input_buffer)->shared_column_name_map();
+  std::unique_lock<std::mutex> lck(column_map_mux_);
+  if (out_column_map_ != nullptr && SameColumns(in_column_map, in_column_map_)) {
+    (*input_buffer)->set_column_name_map(out_column_map_);
+    return Status::OK();
+  }
   // iterate over my index in input vector, find the corresponding position
-  const std::unordered_map<std::string, int32_t> col_name_id_map = (*input_buffer)->column_name_map();
-  std::unordered_map<std::string, int32_t> new_col_name_id_map = {};
+  const ColumnNameMap &col_name_id_map = (*input_buffer)->column_name_map();
+  auto new_col_name_id_map = std::make_shared<ColumnNameMap>();
   // parameter for input check
   size_t found = 0;
 
@@ -118,11 +160,11 @@ Status RenameOp::RenameBuffer(std::unique_ptr<DataBuffer> *input_buffer) {
       int index = std::distance(in_columns_.begin(), it);
       MS_LOG(INFO) << "Rename operator index found " << index << " value " << id << ".";
 
-      new_col_name_id_map[out_columns_[index]] = id;
+      (*new_col_name_id_map)[out_columns_[index]] = id;
     } else {
       // not found
       MS_LOG(INFO) << "Rename operator index not found: " << id << " is the column id.";
-      new_col_name_id_map[name] = id;
+      (*new_col_name_id_map)[name] = id;
     }
   }
   // only checks number of renamed columns have been found, this input check doesn't check everything
@@ -131,7 +173,9 @@ Status RenameOp::RenameBuffer(std::unique_ptr<DataBuffer> *input_buffer) {
     std::string err_msg = "Renamed column doesn't exist in dataset";
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
-  (*input_buffer)->set_column_name_map(new_col_name_id_map);
+  in_column_map_ = std::move(in_column_map);
+  out_column_map_ = std::move(new_col_name_id_map);
+  (*input_buffer)->set_column_name_map(out_column_map_);
   return Status::OK();
 }
 
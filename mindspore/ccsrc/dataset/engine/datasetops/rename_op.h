@@ -17,10 +17,12 @@
 #define DATASET_ENGINE_DATASETOPS_RENAME_OP_H_
 
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <vector>
 #include "dataset/core/tensor.h"
+#include "dataset/engine/data_buffer.h"
 #include "dataset/engine/datasetops/pipeline_op.h"
 #include "dataset/util/status.h"
 
@@ -59,7 +61,8 @@ class RenameOp : public PipelineOp {
       return *this;
     }
 
-    // Setter method.
+    // Setter method. The default size of 0 makes an inlined operator which renames the buffers in the thread of
+    // its parent, a size above 0 gives the operator its own thread and connector.
     // @return Builder setter method returns reference to the builder.
     Builder &SetOpConnectorSize(int32_t op_connector_size) {
       builder_op_connector_size_ = op_connector_size;
@@ -81,7 +84,7 @@ class RenameOp : public PipelineOp {
   // Constructor for RenameOp
   // @param in_col_names names of columns to rename
   // @param out_col_names names of columns after rename
-  // @param op_connector_size connector size
+  // @param op_connector_size connector size, 0 for an inlined operator
   RenameOp(const std::vector<std::string> &in_col_names,   // In: Col names to consume
            const std::vector<std::string> &out_col_names,  // In: Col names to produce
            int32_t op_connector_size);
@@ -98,6 +101,10 @@ class RenameOp : public PipelineOp {
   // @param show_all if it should print everything
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "RenameOp"; }
+
   // Provide stream operator for displaying it
   friend std::ostream &operator<<(std::ostream &out, const RenameOp &ro) {
     ro.Print(out, false);
@@ -106,10 +113,25 @@ class RenameOp : public PipelineOp {
 
   // Class functor operator () override.
   // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
-  // provide the master loop that drives the logic for performing the work
+  // provide the master loop that drives the logic for performing the work. An inlined RenameOp is not
+  // launched, it is an error to call it.
   // @return Status - The error code return
   Status operator()() override;
 
+  // Base-class override. An inlined RenameOp gets a buffer from the child node and renames its columns, only
+  // the column name map of the buffer changes. The caller is typically our parent node.
+  // @param p_buffer - output pointer to the renamed buffer.
+  // @param worker_id - The worker id
+  // @param retry_if_eoe - Set this flag to true to allow calling pop() again after the first pop() returns EOE.
+  // @return Status - The error code return
+  Status GetNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t worker_id, bool retry_if_eoe) override;
+
+  // Base-class override. An inlined RenameOp returns the number of workers in the first parent.
+  int32_t num_consumers() const override;
+
+  // Base-class override. An inlined RenameOp returns the number of producers in the first child.
+  int32_t num_producers() const override;
+
  protected:
   // Rename core functionality
   // @param input_buffer buffer to run rename on
@@ -120,6 +142,12 @@ class RenameOp : public PipelineOp {
 
   // Variable to store the output column names
   std::vector<std::string> out_columns_;
+
+  // The mapping of the last input buffer and its renamed mapping, renamed again only when the input changes.
+  // An inlined RenameOp may be pulled from many workers of its parent, the mutex guards the mappings.
+  std::mutex column_map_mux_;
+  std::shared_ptr<const ColumnNameMap> in_column_map_;
+  std::shared_ptr<const ColumnNameMap> out_column_map_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -44,7 +44,8 @@ Status RepeatOp::Builder::Build(std::shared_ptr<RepeatOp> *ptr) {
 }
 
 // Constructor of the RepeatOp.
-RepeatOp::RepeatOp(int32_t count) : PipelineOp(0), max_repeats_(count), repeat_count_(0) {}
+RepeatOp::RepeatOp(int32_t count)
+    : PipelineOp(0), max_repeats_(count), repeat_count_(0), pass_rows_(0), rows_per_pass_(-1) {}
 
 // Destructor
 RepeatOp::~RepeatOp() {}
@@ -118,6 +119,8 @@ Status RepeatOp::GetNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t wo
   // Check if the last buf is next eof
   if (buf->eof()) {
     RETURN_IF_NOT_OK(EofReceived(worker_id));
+  } else if (rows_per_pass_ < 0) {
+    pass_rows_ += buf->NumRows();
   }
   *p_buffer = std::move(buf);
   return Status::OK();
@@ -126,6 +129,9 @@ Status RepeatOp::GetNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t wo
 // Base-class override for handling cases when an eoe is received.
 Status RepeatOp::EoeReceived(int32_t worker_id) {
   repeat_count_++;
+  if (rows_per_pass_ < 0) {
+    rows_per_pass_ = pass_rows_.load();
+  }
   MS_LOG(INFO) << "Repeat operator end of epoch message received. Repeat count is now: " << repeat_count_ << ".";
 
   // If we've reached the requested repeat count, then flag the leaf nodes
@@ -152,6 +158,50 @@ Status RepeatOp::EoeReceived(int32_t worker_id) {
 // ensure that it is not called by mistake (it will generate an error).
 Status RepeatOp::operator()() { RETURN_STATUS_UNEXPECTED("Logic error. RepeatOp is an inlined operator."); }
 
+Status RepeatOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  int64_t rows_per_pass = rows_per_pass_;
+  int64_t repeat = 0;
+  int64_t rows = pos.rows;
+  if (rows_per_pass > 0) {
+    repeat = pos.rows / rows_per_pass;
+    rows = pos.rows % rows_per_pass;
+    // The consumer took all the rows but not the eoe yet, it stays at the end of the last repeat
+    if (max_repeats_ != kInfiniteRepeat && repeat >= max_repeats_) {
+      repeat = max_repeats_ - 1;
+      rows = pos.rows - repeat * rows_per_pass;
+    }
+  }
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["repeat"] = repeat;
+  (*op_state)["rows_per_pass"] = rows_per_pass;
+  (*op_state)["offset"] = rows;
+  // An infinite repeat never ends its own pass
+  int64_t pass = (max_repeats_ == kInfiniteRepeat) ? repeat : pos.pass * max_repeats_ + repeat;
+  return child_[0]->SaveState(Position{pass, rows}, state);
+}
+
+Status RepeatOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  int32_t repeat = (*op_state)["repeat"].get<int32_t>();
+  if (repeat < 0 || (max_repeats_ != kInfiniteRepeat && repeat >= max_repeats_)) {
+    RETURN_STATUS_UNEXPECTED("The saved repeat " + std::to_string(repeat) + " is out of the repeat count.");
+  }
+  repeat_count_ = repeat;
+  rows_per_pass_ = (*op_state)["rows_per_pass"].get<int64_t>();
+  pass_rows_ = (*op_state)["offset"].get<int64_t>();
+  // The leaf nodes quit after the pass if it is the last one
+  if (max_repeats_ != kInfiniteRepeat && repeat_count_ == (max_repeats_ - 1)) {
+    for (size_t i = 0; i < leaf_ops_.size(); i++) {
+      leaf_ops_[i]->set_control_flag(kDeOpLastRepeat);
+    }
+  }
+  return Status::OK();
+}
+
 // Base-class override for handling cases when an eof is received.
 Status RepeatOp::EofReceived(int32_t worker_id) {
   MS_LOG(INFO) << "Repeat operator EOF received, do nothing now.";
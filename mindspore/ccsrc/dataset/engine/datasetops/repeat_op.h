@@ -16,6 +16,7 @@
 #ifndef DATASET_ENGINE_DATASETOPS_REPEAT_OP_H_
 #define DATASET_ENGINE_DATASETOPS_REPEAT_OP_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -64,6 +65,10 @@ class RepeatOp : public PipelineOp {
   // @param show_all - A bool to control if you want to show all info or just a summary
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "RepeatOp"; }
+
   // << Stream output operator overload
   // @notes This allows you to write the debug print info using stream operators
   // @param out - reference to the output stream being overloaded
@@ -118,10 +123,25 @@ class RepeatOp : public PipelineOp {
   // @param workerId - The worker id
   int32_t num_producers() const override;
 
+  // Base-class override. The position in the output is split into the repeat and the position in it, using the
+  // rows of a pass of the child. They are known once the child ended its first pass, before that the consumer is
+  // still in the first repeat.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override, resumes at the saved repeat.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
  private:
   int32_t max_repeats_;                               // The number of repeats that the user requested
   int32_t repeat_count_;                              // A counter for the current number of executed repeats
   std::vector<std::shared_ptr<DatasetOp>> leaf_ops_;  // List of leaf operators underneath this repeat.
+  std::atomic<int64_t> pass_rows_;                    // The rows of the child counted until its first eoe
+  std::atomic<int64_t> rows_per_pass_;                // The rows of a pass of the child, -1 until it is known
 };
 }  // namespace dataset
 }  // namespace mindspore
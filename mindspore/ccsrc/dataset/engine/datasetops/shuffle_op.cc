@@ -38,7 +38,8 @@ constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
 
 // Builder constructor. Creates the builder object.
-ShuffleOp::Builder::Builder() : build_shuffle_size_(0), build_reshuffle_each_epoch_(true) {
+ShuffleOp::Builder::Builder()
+    : build_shuffle_size_(0), build_shuffle_memory_mb_(0), build_reshuffle_each_epoch_(true) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_op_connector_size_ = cfg->op_connector_size();
   build_rows_per_buffer_ = cfg->rows_per_buffer();
@@ -49,6 +50,9 @@ Status ShuffleOp::Builder::SanityCheck() const {
   if (build_shuffle_size_ < 2) {
     RETURN_STATUS_UNEXPECTED("Shuffle buffer size must be greater than 1.");
   }
+  if (build_shuffle_memory_mb_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Shuffle buffer memory must not be negative.");
+  }
   return Status::OK();
 }
 
@@ -56,18 +60,23 @@ Status ShuffleOp::Builder::SanityCheck() const {
 Status ShuffleOp::Builder::Build(std::shared_ptr<ShuffleOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<ShuffleOp>(build_shuffle_size_, build_shuffle_seed_, build_op_connector_size_,
-                                     build_reshuffle_each_epoch_, build_rows_per_buffer_);
+                                     build_reshuffle_each_epoch_, build_rows_per_buffer_, build_shuffle_memory_mb_);
   return Status::OK();
 }
 
 // Constructor of the ShuffleOp
 ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-                     int32_t rows_per_buffer)
+                     int32_t rows_per_buffer, int32_t shuffle_memory_mb)
     : PipelineOp(op_connector_size),
       shuffle_size_(shuffle_size),
+      shuffle_memory_limit_(static_cast<int64_t>(shuffle_memory_mb) * 1024 * 1024),
+      shuffle_buffer_bytes_(0),
       shuffle_seed_(shuffle_seed),
       reshuffle_each_epoch_(reset_every_epoch),
       rng_(shuffle_seed),
+      pass_seeds_(1, shuffle_seed),
+      first_pass_(0),
+      skip_rows_(0),
       buffer_counter_(0),
       rows_per_buffer_(rows_per_buffer),
       shuffle_buffer_(mindspore::make_unique<TensorTable>()),
@@ -90,7 +99,12 @@ Status ShuffleOp::SelfReset() {
     shuffle_seed_ = distribution(random_device);
     rng_ = std::mt19937_64(shuffle_seed_);
   }
+  {
+    std::lock_guard<std::mutex> lock(seeds_mux_);
+    pass_seeds_.push_back(shuffle_seed_);
+  }
   shuffle_buffer_ = mindspore::make_unique<TensorTable>();
+  shuffle_buffer_bytes_ = 0;
   buffer_counter_ = 0;
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
@@ -104,31 +118,43 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
 
   // Then display our own stuff
   out << "ShuffleOp:\n  Shuffle size: " << shuffle_size_ << "\n  rows_per_buffer_: " << rows_per_buffer_
-      << "\n  shuffle_buffer_state_: " << shuffle_buffer_state_ << "\n  shuffle_seed_: " << shuffle_seed_;
+      << "\n  shuffle_buffer_state_: " << shuffle_buffer_state_ << "\n  shuffle_seed_: " << shuffle_seed_
+      << "\n  shuffle_memory_limit_: " << shuffle_memory_limit_;
   out << "\n-------------------------\n\n";  // End the display with this line
 }
 
 // Private function to add a new row to the shuffle buffer.
-Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
-  // If the last slot of our shuffle buffer was not the full size of the shuffle buffer then we are
-  // filling it during the initial fill codepath and thus growing it's size. In that case, we push
-  // back the new row to grow our shuffle buffer size by 1.
-  // If we are already at the full size, then we overwrite the last slot with our row (and the last
-  // slot better be empty because it should already have been swapped out during the random row
-  // selection that was done previously!)
-  if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
+Status ShuffleOp::AddRowToShuffleBuffer(size_t slot, TensorRow new_shuffle_row) {
+  // If the slot is past the end of our shuffle buffer then we are filling it during the initial fill
+  // codepath and thus growing it's size. In that case, we push back the new row to grow our shuffle
+  // buffer size by 1.
+  // Otherwise we overwrite the slot with our row (and the slot better be empty because it should
+  // already have been swapped out during the random row selection that was done previously!)
+  for (auto &t : new_shuffle_row) {
+    shuffle_buffer_bytes_ += t->SizeInBytes();
+  }
+  if (slot == shuffle_buffer_->size()) {
     shuffle_buffer_->push_back(std::move(new_shuffle_row));
-    shuffle_last_row_idx_ = (shuffle_buffer_->size()) - 1;
   } else {
-    if (!(*shuffle_buffer_)[shuffle_last_row_idx_].empty()) {
+    if (slot > shuffle_buffer_->size() || !(*shuffle_buffer_)[slot].empty()) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "Last row of shuffle buffer should not be occupied!");
     }
-    (*shuffle_buffer_)[shuffle_last_row_idx_] = std::move(new_shuffle_row);
+    (*shuffle_buffer_)[slot] = std::move(new_shuffle_row);
   }
   return Status::OK();
 }
 
+// Private function to take a row out of the shuffle buffer, leaving its slot empty.
+TensorRow ShuffleOp::TakeRowFromShuffleBuffer(size_t slot) {
+  TensorRow row = std::move((*shuffle_buffer_)[slot]);
+  (*shuffle_buffer_)[slot].clear();
+  for (auto &t : row) {
+    shuffle_buffer_bytes_ -= t->SizeInBytes();
+  }
+  return row;
+}
+
 // Class functor operator () override.
 // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
 // provide the master loop that drives the logic for performing the work
@@ -169,22 +195,15 @@ Status ShuffleOp::operator()() {
       // tensor table. We remove the data from the shuffle buffer, leaving that slot
       // in the table as an empty vector
       int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
-      new_buffer_table->push_back(std::move((*shuffle_buffer_)[random_slot]));
-
-      // Step 3)
-      // If the output tensor table is at the requested size, then create a buffer for it
-      // and send this buffer on it's way up the pipeline. Special case is if this is the
-      // last row then we also send it.
-      if (new_buffer_table->size() == rows_per_buffer_ || shuffle_last_row_idx_ == 0) {
-        auto new_buffer = mindspore::make_unique<DataBuffer>(buffer_counter_, DataBuffer::kDeBFlagNone);
-        new_buffer->set_tensor_table(std::move(new_buffer_table));
-        new_buffer->set_column_name_map(column_name_map_);
-        buffer_counter_++;
-        MS_LOG(DEBUG) << "Shuffle operator sending a buffer to output.";
-        RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(new_buffer)));
+      if (skip_rows_ > 0) {
+        // The row was consumed before the resume
+        (void)TakeRowFromShuffleBuffer(random_slot);
+        skip_rows_--;
+      } else {
+        new_buffer_table->push_back(TakeRowFromShuffleBuffer(random_slot));
       }
 
-      // Step 4)
+      // Step 3)
       // Take the last row from shuffle buffer, and swap it into the row position that was
       // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
       // tail of the shuffle buffer.
@@ -192,26 +211,39 @@ Status ShuffleOp::operator()() {
         (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
       }
 
-      // Step 5)
-      // Refill the last slot of the shuffle buffer with the next row from input if we are in the
-      // active state.
-      // If we are in the draining state, we do not need to fetch another row to replace the one we
-      // just drained.
-      if (shuffle_buffer_state_ == kShuffleStateActive) {
+      // Step 4)
+      // Refill the tail of the shuffle buffer with the next rows from input if we are in the
+      // active state. Without a memory bound, exactly one row replaces the one we just drained.
+      // With a memory bound, the shuffle buffer shrinks while its rows are over the bound, and
+      // grows back up to the shuffle size once they are under it.
+      // If we are in the draining state, we do not need to fetch another row and the tail index
+      // moves down by one.
+      int32_t num_rows = shuffle_last_row_idx_;  // The rows left in the shuffle buffer
+      while (shuffle_buffer_state_ == kShuffleStateActive && num_rows < shuffle_size_ &&
+             (num_rows == 0 || !ShuffleMemoryFull())) {
         TensorRow new_row;
         RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
 
         if (!new_row.empty()) {
-          RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
+          RETURN_IF_NOT_OK(AddRowToShuffleBuffer(num_rows, std::move(new_row)));
+          num_rows++;
         } else {
           shuffle_buffer_state_ = kShuffleStateDrain;
         }
       }
+      shuffle_last_row_idx_ = num_rows - 1;
 
-      // If we are draining, reposition (decrement) our tail index in the shuffle buffer since we
-      // just drained a row from it.
-      if (shuffle_buffer_state_ == kShuffleStateDrain) {
-        shuffle_last_row_idx_--;
+      // Step 5)
+      // If the output tensor table is at the requested size, then create a buffer for it
+      // and send this buffer on it's way up the pipeline. Special case is if this was the
+      // last row then we also send it.
+      if (new_buffer_table->size() == rows_per_buffer_ || (shuffle_last_row_idx_ < 0 && !new_buffer_table->empty())) {
+        auto new_buffer = mindspore::make_unique<DataBuffer>(buffer_counter_, DataBuffer::kDeBFlagNone);
+        new_buffer->set_tensor_table(std::move(new_buffer_table));
+        new_buffer->set_column_name_map(column_name_map_);
+        buffer_counter_++;
+        MS_LOG(DEBUG) << "Shuffle operator sending a buffer to output.";
+        RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(new_buffer)));
       }
     }
 
@@ -229,6 +261,39 @@ Status ShuffleOp::operator()() {
   return Status::OK();
 }
 
+Status ShuffleOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  uint32_t seed = 0;
+  {
+    std::lock_guard<std::mutex> lock(seeds_mux_);
+    if (pos.pass < first_pass_ || pos.pass - first_pass_ >= static_cast<int64_t>(pass_seeds_.size())) {
+      RETURN_STATUS_UNEXPECTED("ShuffleOp has no seed for pass " + std::to_string(pos.pass) + ".");
+    }
+    seed = pass_seeds_[pos.pass - first_pass_];
+  }
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["pass"] = pos.pass;
+  (*op_state)["seed"] = seed;
+  (*op_state)["skip"] = pos.rows;
+  return child_[0]->SaveState(Position{pos.pass, 0}, state);
+}
+
+Status ShuffleOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  shuffle_seed_ = (*op_state)["seed"].get<uint32_t>();
+  rng_ = std::mt19937_64(shuffle_seed_);
+  {
+    std::lock_guard<std::mutex> lock(seeds_mux_);
+    pass_seeds_.assign(1, shuffle_seed_);
+    first_pass_ = (*op_state)["pass"].get<int64_t>();
+  }
+  skip_rows_ = (*op_state)["skip"].get<int64_t>();
+  return Status::OK();
+}
+
 // Private function populate the shuffle buffer initially by fetching from the child output
 // connector until the shuffle buffer is full (or there is no more data coming).
 Status ShuffleOp::InitShuffleBuffer() {
@@ -259,14 +324,15 @@ Status ShuffleOp::InitShuffleBuffer() {
     RETURN_STATUS_UNEXPECTED("Unable to fetch a single row for shuffle buffer.");
   }
 
-  // Take a copy of the column name mapping.  We'll use this when constructing output buffers later.
-  column_name_map_ = child_iterator_->col_name_id_map();
+  // Share the column name mapping.  We'll use this when constructing output buffers later.
+  column_name_map_ = child_iterator_->shared_col_name_id_map();
 
   // Now fill the rest of the shuffle buffer until we are unable to get the next row or we reached
-  // the desired shuffle buffer size.
-  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
+  // the desired shuffle buffer size or its memory bound.
+  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1) &&
+         !ShuffleMemoryFull()) {
     // Add the previously fetched row
-    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
+    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(shuffle_buffer_->size(), std::move(new_row)));
 
     // Fetch the next row
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
@@ -274,13 +340,14 @@ Status ShuffleOp::InitShuffleBuffer() {
 
   // If we quit the loop due to being at the shuffle size, still need to add the last row here.
   if (!new_row.empty()) {
-    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
+    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(shuffle_buffer_->size(), std::move(new_row)));
     shuffle_buffer_state_ = kShuffleStateActive;  // Transition to the active state
   } else {
     // If init phase doesn't have more rows, then skip the active state and jump straight to the
     // shuffle buffer draining state
     shuffle_buffer_state_ = kShuffleStateDrain;
   }
+  shuffle_last_row_idx_ = static_cast<int32_t>(shuffle_buffer_->size()) - 1;
 
   MS_LOG(INFO) << "Shuffle operator finished intializing the shuffle buffer.";
   return Status::OK();
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
 #include <string>
@@ -72,6 +73,14 @@ class ShuffleOp : public PipelineOp {
       return *this;
     }
 
+    // Setter method.
+    // @param shuffle_memory_mb - The upper bound of the shuffle buffer in MB, 0 for no bound
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetShuffleMemoryMb(int32_t shuffle_memory_mb) {
+      build_shuffle_memory_mb_ = shuffle_memory_mb;
+      return *this;
+    }
+
     // Setter method.
     // @return Builder setter method returns reference to the builder.
     Builder &SetShuffleSeed(uint32_t shuffle_seed) {
@@ -108,6 +117,7 @@ class ShuffleOp : public PipelineOp {
     // The builder saves all ShuffleOp construction arguments internally.
     // The following are the arguments.
     int32_t build_shuffle_size_;
+    int32_t build_shuffle_memory_mb_;
     uint32_t build_shuffle_seed_;
     int32_t build_rows_per_buffer_;
     bool build_reshuffle_each_epoch_;
@@ -122,8 +132,10 @@ class ShuffleOp : public PipelineOp {
   // @param shuffle_seed - The seed to use for random number generation
   // @param op_connector_size - The output connector queue size
   // @param rows_per_buffer - The requested number of rows per buffer
+  // @param shuffle_memory_mb - The upper bound of the shuffle buffer in MB, 0 for no bound. The buffer holds
+  //     fewer than shuffle_size rows once the tensors it holds reach the bound, and at least one row.
   ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-            int32_t rows_per_buffer);
+            int32_t rows_per_buffer, int32_t shuffle_memory_mb = 0);
 
   // Destructor
   ~ShuffleOp() = default;
@@ -133,6 +145,10 @@ class ShuffleOp : public PipelineOp {
   // @param show_all - A bool to control if you want to show all info or just a summary
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "ShuffleOp"; }
+
   // << Stream output operator overload
   // @notes This allows you to write the debug print info using stream operators
   // @param out - reference to the output stream being overloaded
@@ -155,10 +171,34 @@ class ShuffleOp : public PipelineOp {
   // @return Status - The error code return
   Status EoeReceived(int32_t worker_id) override;
 
+  // Base-class override. The rows of a pass depend on the whole pass of the child, so the child resumes at the
+  // start of the pass and the shuffle replays it with the same seed, dropping the rows which were consumed.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
  private:
   // Private function to add a new row to the shuffle buffer.
+  // @param slot - The slot of the row, the first free slot at the tail of the shuffle buffer
+  // @param new_shuffle_row - The row
   // @return Status - The error code return
-  Status AddRowToShuffleBuffer(TensorRow new_shuffle_row);
+  Status AddRowToShuffleBuffer(size_t slot, TensorRow new_shuffle_row);
+
+  // Private function to take a row out of the shuffle buffer, leaving its slot empty.
+  // @param slot - The slot of the row
+  // @return The row
+  TensorRow TakeRowFromShuffleBuffer(size_t slot);
+
+  // @return T/F if the rows of the shuffle buffer reached the memory bound
+  bool ShuffleMemoryFull() const {
+    return shuffle_memory_limit_ > 0 && shuffle_buffer_bytes_ >= shuffle_memory_limit_;
+  }
 
   // Private function to populate the shuffle buffer initially by fetching from the child output
   // connector until the shuffle buffer is full (or there is no more data coming).
@@ -171,6 +211,8 @@ class ShuffleOp : public PipelineOp {
   Status SelfReset();
 
   int32_t shuffle_size_;  // User config for the size of the shuffle buffer (number of rows)
+  int64_t shuffle_memory_limit_;  // User config for the upper bound of the shuffle buffer (bytes), 0 if none
+  int64_t shuffle_buffer_bytes_;  // The bytes of the tensors held by the shuffle buffer
   uint32_t shuffle_seed_;
   bool reshuffle_each_epoch_;
   // rng_ is seeded initially with shuffle_seed_. mt19937 is used for its large period.
@@ -179,13 +221,18 @@ class ShuffleOp : public PipelineOp {
   // (ie uniform_int_distribution) because we will need to create up to |dataset| instances
   // of the distribution object in the common case of a perfect shuffle
   std::mt19937_64 rng_;
+  // The seeds of the passes from first_pass_ on, the consumer may still be in a pass before the current one
+  mutable std::mutex seeds_mux_;
+  std::vector<uint32_t> pass_seeds_;
+  int64_t first_pass_;
+  int64_t skip_rows_;  // The rows to drop from the output of the first pass after a resume
   int32_t buffer_counter_;   // For creating new buffer id's
   int32_t rows_per_buffer_;  // Number of rows to pack into output buffer
   // A single (potentially large) buffer of tensor rows for performing shuffling.
   std::unique_ptr<TensorTable> shuffle_buffer_;
   int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
-  std::unordered_map<std::string, int32_t> column_name_map_;  // A mapping between column index to column name.
+  std::shared_ptr<const ColumnNameMap> column_name_map_;  // A mapping between column index to column name.
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
 };
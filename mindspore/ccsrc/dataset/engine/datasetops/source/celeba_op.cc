@@ -79,9 +79,11 @@ CelebAOp::CelebAOp(int32_t num_workers, int32_t rows_per_buffer, const std::stri
       num_rows_exact_(0),
       num_samples_(num_samples),
       dataset_type_(dataset_type) {
+  ColumnNameMap col_name_map;
   for (int32_t index = 0; index < data_schema_->NumColumns(); index++) {
-    col_name_map_[data_schema_->column(index).name()] = index;
+    col_name_map[data_schema_->column(index).name()] = index;
   }
+  col_name_map_ = std::make_shared<const ColumnNameMap>(std::move(col_name_map));
 
   attr_info_queue_ = make_unique<Queue<std::vector<std::string>>>(queue_size);
   io_block_queues_.Init(num_workers_, queue_size);
@@ -414,12 +416,9 @@ Status CelebAOp::LoadTensorRow(const std::pair<std::string, std::vector<int32_t>
                                         TensorShape({1, (uint32_t)image_label.second.size()}),
                                         data_schema_->column(1).type()));
   RETURN_IF_NOT_OK(label->Zero());
-  for (uint32_t index = 0; index < image_label.second.size(); index++) {
-    if (image_label.second[index] == 1) {
-      label->SetItemAt<uint32_t>({0, static_cast<dsize_t>(index)}, 1);
-    } else {
-      label->SetItemAt<uint32_t>({0, static_cast<dsize_t>(index)}, 0);
-    }
+  auto label_itr = label->begin<uint32_t>({0, 0}, 1);
+  for (uint32_t index = 0; index < image_label.second.size(); index++, label_itr++) {
+    *label_itr = image_label.second[index] == 1 ? 1 : 0;
   }
   label->Squeeze();
 
@@ -433,6 +432,21 @@ void CelebAOp::Print(std::ostream &out, bool show_all) const {
       << "\nceleba dir: " << folder_path_ << "\n-------------------------\n";
 }
 
+Status CelebAOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["rows"] = pos.rows;
+  return sampler_->SaveState(pos, &(*op_state)["sampler"]);
+}
+
+Status CelebAOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  return sampler_->LoadState((*op_state)["sampler"]);
+}
+
 // Reset Sampler and wakeup Master thread (functor)
 Status CelebAOp::Reset() {
   RETURN_IF_NOT_OK(sampler_->Reset());
@@ -26,6 +26,7 @@
 #include <fstream>
 
 #include "dataset/util/status.h"
+#include "dataset/engine/data_buffer.h"
 #include "dataset/engine/data_schema.h"
 #include "dataset/engine/datasetops/parallel_op.h"
 #include "dataset/engine/datasetops/source/sampler/sampler.h"
@@ -164,6 +165,17 @@ class CelebAOp : public ParallelOp, RandomAccessOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // Base-class override. The position of the source is the position of its sampler.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
   // Method derived from RandomAccess Op, enable Sampler to get numRows
   // @param int64_t num - to return numRows
   // @return Status - The error code return
@@ -184,6 +196,10 @@ class CelebAOp : public ParallelOp, RandomAccessOp {
   // @param show_all
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "CelebAOp"; }
+
   // Method in operator(), to fill IOBlockQueue
   // @param std::unique_ptr<DataBuffer> sampler_buffer - to fill IOBlockQueue
   // @return Status - The error code return
@@ -232,7 +248,7 @@ class CelebAOp : public ParallelOp, RandomAccessOp {
   std::set<std::string> extensions_;  // extensions allowed
   std::unique_ptr<DataSchema> data_schema_;
   std::shared_ptr<Sampler> sampler_;
-  std::unordered_map<std::string, int32_t> col_name_map_;
+  std::shared_ptr<const ColumnNameMap> col_name_map_;
   std::unique_ptr<Queue<std::vector<std::string>>> attr_info_queue_;
   int64_t num_rows_in_attr_file_;  // rows number specified in attr file
   int64_t num_rows_exact_;         // exact rows number,maybe is less than rows_num_in_attr_file_
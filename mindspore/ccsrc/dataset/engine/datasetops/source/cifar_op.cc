@@ -86,10 +86,13 @@ CifarOp::CifarOp(CifarType type, int32_t num_works, int32_t rows_per_buf, const
       sampler_(std::move(sampler)),
       num_rows_(0),
       row_cnt_(0),
-      buf_cnt_(0) {
+      buf_cnt_(0),
+      index_ready_(false) {
+  ColumnNameMap col_name_map;
   for (uint32_t i = 0; i < data_schema_->NumColumns(); ++i) {
-    col_name_map_[data_schema_->column(i).name()] = i;
+    col_name_map[data_schema_->column(i).name()] = i;
   }
+  col_name_map_ = std::make_shared<const ColumnNameMap>(std::move(col_name_map));
   constexpr uint64_t kUtilQueueSize = 512;
   cifar_raw_data_block_ = make_unique<Queue<std::vector<unsigned char>>>(kUtilQueueSize);
   io_block_queues_.Init(num_workers_, queue_size);
@@ -150,16 +153,41 @@ Status CifarOp::LaunchThreadsAndInitOp() {
   }
   RETURN_IF_NOT_OK(io_block_queues_.Register(tree_->AllTasks()));
   wp_.Register(tree_->AllTasks());
-  RETURN_IF_NOT_OK(
-    tree_->AllTasks()->CreateAsyncTask("Get cifar data block", std::bind(&CifarOp::ReadCifarBlockDataAsync, this)));
+  // The data is read only once, GetRow may have done it already
+  std::unique_lock<std::mutex> lck(index_mux_);
+  bool parse = !index_ready_;
+  if (parse) {
+    RETURN_IF_NOT_OK(
+      tree_->AllTasks()->CreateAsyncTask("Get cifar data block", std::bind(&CifarOp::ReadCifarBlockDataAsync, this)));
+  }
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_workers_, std::bind(&CifarOp::WorkerEntry, this, std::placeholders::_1)));
   TaskManager::FindMe()->Post();
   // The order of the following 2 functions must not be changed!
-  RETURN_IF_NOT_OK(ParseCifarData());  // Parse cifar data and get num rows, blocking
-  RETURN_IF_NOT_OK(InitSampler());     // Pass numRows to Sampler
+  if (parse) {
+    RETURN_IF_NOT_OK(ParseCifarData());  // Parse cifar data and get num rows, blocking
+    index_ready_ = true;
+  }
+  lck.unlock();
+  RETURN_IF_NOT_OK(InitSampler());  // Pass numRows to Sampler
   return Status::OK();
 }
 
+Status CifarOp::GetRow(int64_t row_id, TensorRow *row) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  {
+    std::lock_guard<std::mutex> lck(index_mux_);
+    if (!index_ready_) {
+      RETURN_IF_NOT_OK(LoadIndex());
+      index_ready_ = true;
+    }
+  }
+  if (row_id < 0 || row_id >= num_rows_) {
+    RETURN_STATUS_UNEXPECTED("Invalid row id " + std::to_string(row_id) + ", the dataset has " +
+                             std::to_string(num_rows_) + " rows");
+  }
+  return LoadTensorRow(static_cast<uint64_t>(row_id), row);
+}
+
 // contains the main logic of pulling a IOBlock from IOBlockQueue, load a buffer and push the buffer to out_connector_
 // IMPORTANT: 1 IOBlock produces 1 DataBuffer
 Status CifarOp::WorkerEntry(int32_t worker_id) {
@@ -230,6 +258,22 @@ void CifarOp::Print(std::ostream &out, bool show_all) const {
       << "\nCifar Directory: " << folder_path_ << "\n-------------------------\n";
 }
 
+Status CifarOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["rows"] = pos.rows;
+  return sampler_->SaveState(pos, &(*op_state)["sampler"]);
+}
+
+Status CifarOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  row_cnt_ = (*op_state)["rows"].get<int64_t>();
+  return sampler_->LoadState((*op_state)["sampler"]);
+}
+
 // Reset Sampler and wakeup Master thread (functor)
 Status CifarOp::Reset() {
   RETURN_IF_NOT_OK(sampler_->Reset());
@@ -265,16 +309,32 @@ Status CifarOp::GetNumRowsInDataset(int64_t *num) const {
 Status CifarOp::ReadCifarBlockDataAsync() {
   TaskManager::FindMe()->Post();
   RETURN_IF_NOT_OK(GetCifarFiles());
+  auto add_block = [this](const std::vector<unsigned char> &block) {
+    return cifar_raw_data_block_->EmplaceBack(block);
+  };
   if (cifar_type_ == kCifar10) {
-    RETURN_IF_NOT_OK(ReadCifar10BlockData());
+    RETURN_IF_NOT_OK(ReadCifar10BlockData(add_block));
   } else {
-    RETURN_IF_NOT_OK(ReadCifar100BlockData());
+    RETURN_IF_NOT_OK(ReadCifar100BlockData(add_block));
   }
+  (void)cifar_raw_data_block_->EmplaceBack(std::vector<unsigned char>());  // end block
 
   return Status::OK();
 }
 
-Status CifarOp::ReadCifar10BlockData() {
+Status CifarOp::LoadIndex() {
+  // Without a tree, the blocks are parsed by the calling thread as they are read
+  RETURN_IF_NOT_OK(GetCifarFiles());
+  auto parse_block = [this](const std::vector<unsigned char> &block) { return ParseCifarBlock(block); };
+  if (cifar_type_ == kCifar10) {
+    RETURN_IF_NOT_OK(ReadCifar10BlockData(parse_block));
+  } else {
+    RETURN_IF_NOT_OK(ReadCifar100BlockData(parse_block));
+  }
+  return CountCifarRows();
+}
+
+Status CifarOp::ReadCifar10BlockData(const std::function<Status(const std::vector<unsigned char> &)> &add_block) {
   constexpr uint32_t num_cifar10_records = 10000;
   uint32_t block_size = (kCifarImageSize + 1) * kCifarBlockImageNum;  // about 2M
   std::vector<unsigned char> image_data(block_size * sizeof(unsigned char), 0);
@@ -290,16 +350,15 @@ Status CifarOp::ReadCifar10BlockData() {
       if (in.fail()) {
         RETURN_STATUS_UNEXPECTED("Fail to read cifar file" + file);
       }
-      (void)cifar_raw_data_block_->EmplaceBack(image_data);
+      RETURN_IF_NOT_OK(add_block(image_data));
     }
     in.close();
   }
-  (void)cifar_raw_data_block_->EmplaceBack(std::vector<unsigned char>());  // end block
 
   return Status::OK();
 }
 
-Status CifarOp::ReadCifar100BlockData() {
+Status CifarOp::ReadCifar100BlockData(const std::function<Status(const std::vector<unsigned char> &)> &add_block) {
   uint32_t num_cifar100_records = 0;                                  // test:10000, train:50000
   uint32_t block_size = (kCifarImageSize + 2) * kCifarBlockImageNum;  // about 2M
   std::vector<unsigned char> image_data(block_size * sizeof(unsigned char), 0);
@@ -327,11 +386,10 @@ Status CifarOp::ReadCifar100BlockData() {
       if (in.fail()) {
         RETURN_STATUS_UNEXPECTED("Fail to read cifar file" + file);
       }
-      (void)cifar_raw_data_block_->EmplaceBack(image_data);
+      RETURN_IF_NOT_OK(add_block(image_data));
     }
     in.close();
   }
-  (void)cifar_raw_data_block_->EmplaceBack(std::vector<unsigned char>());  // block end
   return Status::OK();
 }
 
@@ -360,38 +418,47 @@ Status CifarOp::GetCifarFiles() {
 Status CifarOp::ParseCifarData() {
   std::vector<unsigned char> block;
   RETURN_IF_NOT_OK(cifar_raw_data_block_->PopFront(&block));
-  uint32_t cur_block_index = 0;
   while (!block.empty()) {
-    for (uint32_t index = 0; index < kCifarBlockImageNum; ++index) {
-      std::vector<uint32_t> labels;
-      uint32_t label = block[cur_block_index++];
-      labels.push_back(label);
-      if (cifar_type_ == kCifar100) {
-        uint32_t fine_label = block[cur_block_index++];
-        labels.push_back(fine_label);
-      }
+    RETURN_IF_NOT_OK(ParseCifarBlock(block));
+    RETURN_IF_NOT_OK(cifar_raw_data_block_->PopFront(&block));
+  }
+  RETURN_IF_NOT_OK(CountCifarRows());
+  cifar_raw_data_block_->Reset();
+  return Status::OK();
+}
 
-      std::shared_ptr<Tensor> image_tensor;
-      RETURN_IF_NOT_OK(Tensor::CreateTensor(&image_tensor, data_schema_->column(0).tensorImpl(),
-                                            TensorShape({kCifarImageHeight, kCifarImageWidth, kCifarImageChannel}),
-                                            data_schema_->column(0).type()));
-      for (int ch = 0; ch < kCifarImageChannel; ++ch) {
-        for (int pix = 0; pix < kCifarImageHeight * kCifarImageWidth; ++pix) {
-          (image_tensor->StartAddr())[pix * kCifarImageChannel + ch] = block[cur_block_index++];
-        }
+Status CifarOp::ParseCifarBlock(const std::vector<unsigned char> &block) {
+  uint32_t cur_block_index = 0;
+  for (uint32_t index = 0; index < kCifarBlockImageNum; ++index) {
+    std::vector<uint32_t> labels;
+    uint32_t label = block[cur_block_index++];
+    labels.push_back(label);
+    if (cifar_type_ == kCifar100) {
+      uint32_t fine_label = block[cur_block_index++];
+      labels.push_back(fine_label);
+    }
+
+    std::shared_ptr<Tensor> image_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&image_tensor, data_schema_->column(0).tensorImpl(),
+                                          TensorShape({kCifarImageHeight, kCifarImageWidth, kCifarImageChannel}),
+                                          data_schema_->column(0).type()));
+    for (int ch = 0; ch < kCifarImageChannel; ++ch) {
+      for (int pix = 0; pix < kCifarImageHeight * kCifarImageWidth; ++pix) {
+        (image_tensor->StartAddr())[pix * kCifarImageChannel + ch] = block[cur_block_index++];
       }
-      cifar_image_label_pairs_.emplace_back(std::make_pair(image_tensor, labels));
     }
-    RETURN_IF_NOT_OK(cifar_raw_data_block_->PopFront(&block));
-    cur_block_index = 0;
+    cifar_image_label_pairs_.emplace_back(std::make_pair(image_tensor, labels));
   }
+  return Status::OK();
+}
+
+Status CifarOp::CountCifarRows() {
   cifar_image_label_pairs_.shrink_to_fit();
   num_rows_ = cifar_image_label_pairs_.size();
   num_samples_ = (num_samples_ == 0 || num_samples_ > num_rows_) ? num_rows_ : num_samples_;
   if (num_rows_ == 0) {
     RETURN_STATUS_UNEXPECTED("Init Cifar failed, not a single row read from dataset!");
   }
-  cifar_raw_data_block_->Reset();
   return Status::OK();
 }
 
@@ -16,8 +16,10 @@
 #ifndef DATASET_ENGINE_DATASETOPS_SOURCE_CIFAR_OP_H_
 #define DATASET_ENGINE_DATASETOPS_SOURCE_CIFAR_OP_H_
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -153,6 +155,17 @@ class CifarOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // Base-class override. The position of the source is the position of its sampler.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
   // Method derived from RandomAccess Op, enable Sampler to get numRows
   // @param uint64_t num - to return numRows
   // @return Status - The error code return
@@ -168,6 +181,10 @@ class CifarOp : public ParallelOp, public RandomAccessOp {
   // @param show_all
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "CifarOp"; }
+
   // Function to count the number of samples in the CIFAR dataset
   // @param dir path to the CIFAR directory
   // @param numSamples maximum number of samples requested
@@ -176,6 +193,12 @@ class CifarOp : public ParallelOp, public RandomAccessOp {
   // @return
   static Status CountTotalRows(const std::string &dir, int64_t numSamples, bool isCIFAR10, int64_t *count);
 
+  // Method derived from RandomAccess Op, loads one row by its id without a tree
+  // @param int64_t row_id - the id of the row in the dataset
+  // @param TensorRow *row - image & label read into this tensor row
+  // @return Status - The error code return
+  Status GetRow(int64_t row_id, TensorRow *row) override;
+
  private:
   // Initialize Sampler, calls sampler->Init() within
   // @return Status - The error code return
@@ -209,17 +232,32 @@ class CifarOp : public ParallelOp, public RandomAccessOp {
   Status GetCifarFiles();
 
   // Read cifar10 data as block
+  // @param add_block - called with each block read
   // @return
-  Status ReadCifar10BlockData();
+  Status ReadCifar10BlockData(const std::function<Status(const std::vector<unsigned char> &)> &add_block);
 
   // Read cifar100 data as block
+  // @param add_block - called with each block read
   // @return
-  Status ReadCifar100BlockData();
+  Status ReadCifar100BlockData(const std::function<Status(const std::vector<unsigned char> &)> &add_block);
 
   // Parse cifar data
   // @return
   Status ParseCifarData();
 
+  // Parse the images and labels of one block
+  // @param const std::vector<unsigned char> &block - the block read from a cifar file
+  // @return Status - The error code return
+  Status ParseCifarBlock(const std::vector<unsigned char> &block);
+
+  // Count the rows once all the blocks are parsed
+  // @return Status - The error code return
+  Status CountCifarRows();
+
+  // Read and parse all the cifar files in the calling thread, for GetRow
+  // @return Status - The error code return
+  Status LoadIndex();
+
   // Method derived from RandomAccess Op, enable Sampler to get all ids for each calss
   // @param (std::unordered_map<uint64_t, std::vector<uint64_t >> * map - key label, val all ids for this class
   // @return Status - The error code return
@@ -236,11 +274,13 @@ class CifarOp : public ParallelOp, public RandomAccessOp {
   int64_t buf_cnt_;
 
   WaitPost wp_;
-  std::unordered_map<std::string, int32_t> col_name_map_;
+  std::shared_ptr<const ColumnNameMap> col_name_map_;
   QueueList<std::unique_ptr<IOBlock>> io_block_queues_;
   std::unique_ptr<Queue<std::vector<unsigned char>>> cifar_raw_data_block_;
   std::vector<std::string> cifar_files_;
   std::vector<std::pair<std::shared_ptr<Tensor>, std::vector<uint32_t>>> cifar_image_label_pairs_;
+  std::mutex index_mux_;  // guards the parsing of the cifar files
+  bool index_ready_;      // the cifar files are parsed
 };
 }  // namespace dataset
 }  // namespace mindspore
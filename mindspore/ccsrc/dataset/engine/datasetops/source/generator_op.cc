@@ -73,10 +73,12 @@ Status GeneratorOp::Init() {
   // Reset BufferID
   buffer_id_ = 0;
   // Setup column names map.
-  if (column_names_map_.empty()) {
+  if (column_names_map_ == nullptr) {
+    ColumnNameMap column_names_map;
     for (int i = 0; i < column_names_.size(); ++i) {
-      (void)column_names_map_.insert(std::make_pair(column_names_[i], i));
+      (void)column_names_map.insert(std::make_pair(column_names_[i], i));
     }
+    column_names_map_ = std::make_shared<const ColumnNameMap>(std::move(column_names_map));
   }
   Status ret;
   {
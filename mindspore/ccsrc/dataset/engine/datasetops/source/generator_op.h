@@ -25,6 +25,7 @@
 #include <vector>
 #include "dataset/core/data_type.h"
 #include "dataset/core/tensor.h"
+#include "dataset/engine/data_buffer.h"
 #include "dataset/engine/data_schema.h"
 #include "dataset/engine/datasetops/pipeline_op.h"
 #include "dataset/util/wait_post.h"
@@ -111,6 +112,10 @@ class GeneratorOp : public PipelineOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "GeneratorOp"; }
+
   // Overrides base class reset method.  When an operator does a reset, it cleans up any state
   // info from it's previous execution and then initializes itself so that it can be executed
   // again.
@@ -125,7 +130,7 @@ class GeneratorOp : public PipelineOp {
   int32_t buffer_size_;
 
   py::object generator_;
-  std::unordered_map<std::string, int32_t> column_names_map_;
+  std::shared_ptr<const ColumnNameMap> column_names_map_;
   int32_t buffer_id_;
 
   WaitPost wp_;
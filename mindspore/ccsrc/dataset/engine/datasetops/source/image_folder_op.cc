@@ -15,6 +15,8 @@
  */
 #include "dataset/engine/datasetops/source/image_folder_op.h"
 
+#include <unistd.h>
+#include <cstdio>
 #include <fstream>
 
 #include "common/utils.h"
@@ -23,9 +25,12 @@
 #include "dataset/engine/datasetops/source/sampler/sequential_sampler.h"
 #include "dataset/engine/db_connector.h"
 #include "dataset/engine/execution_tree.h"
+#include "dataset/util/executor.h"
 
 namespace mindspore {
 namespace dataset {
+const char kIndexFileMagic[] = "MindDataImageFolderIndex 1";
+
 ImageFolderOp::Builder::Builder()
     : builder_decode_(false), builder_recursive_(false), builder_num_samples_(0), builder_sampler_(nullptr) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
@@ -48,7 +53,8 @@ Status ImageFolderOp::Builder::Build(std::shared_ptr<ImageFolderOp> *ptr) {
   *ptr = std::make_shared<ImageFolderOp>(builder_num_workers_, builder_rows_per_buffer_, builder_dir_,
                                          builder_op_connector_size_, builder_num_samples_, builder_recursive_,
                                          builder_decode_, builder_extensions_, builder_labels_to_read_,
-                                         std::move(builder_schema_), std::move(builder_sampler_));
+                                         std::move(builder_schema_), std::move(builder_sampler_),
+                                         builder_index_file_);
   return Status::OK();
 }
 
@@ -63,7 +69,7 @@ Status ImageFolderOp::Builder::SanityCheck() {
 ImageFolderOp::ImageFolderOp(int32_t num_wkrs, int32_t rows_per_buffer, std::string file_dir, int32_t queue_size,
                              int64_t num_samples, bool recursive, bool do_decode, const std::set<std::string> &exts,
                              const std::map<std::string, int32_t> &map, std::unique_ptr<DataSchema> data_schema,
-                             std::shared_ptr<Sampler> sampler)
+                             std::shared_ptr<Sampler> sampler, std::string index_file)
     : ParallelOp(num_wkrs, queue_size),
       rows_per_buffer_(rows_per_buffer),
       folder_path_(file_dir),
@@ -78,51 +84,77 @@ ImageFolderOp::ImageFolderOp(int32_t num_wkrs, int32_t rows_per_buffer, std::str
       row_cnt_(0),
       buf_cnt_(0),
       sampler_ind_(0),
-      dirname_offset_(0) {
+      dirname_offset_(0),
+      index_file_(std::move(index_file)),
+      index_ready_(false) {
+  ColumnNameMap col_name_map;
   for (int32_t i = 0; i < data_schema_->NumColumns(); ++i) {
-    col_name_map_[data_schema_->column(i).name()] = i;
+    col_name_map[data_schema_->column(i).name()] = i;
   }
-  folder_name_queue_ = make_unique<Queue<std::string>>(num_wkrs * queue_size);
-  image_name_queue_ = make_unique<Queue<FolderImagesPair>>(num_wkrs * queue_size);
+  col_name_map_ = std::make_shared<const ColumnNameMap>(std::move(col_name_map));
   io_block_queues_.Init(num_workers_, queue_size);
 }
 
-// Master thread that pulls the prescan worker's results.
-// Keep collecting results until all prescan workers quit
-// Then consolidate 2 level shuffles together into 1 giant vector
-// calculate numRows then return
-Status ImageFolderOp::PrescanMasterEntry(const std::string &filedir) {
-  std::vector<FolderImagesPair> v;
-  int64_t cnt = 0;
-  while (cnt != num_workers_) {  // count number of end signals
-    FolderImagesPair p;
-    RETURN_IF_NOT_OK(image_name_queue_->PopFront(&p));
-    if (p == nullptr) {
-      cnt++;
-    } else {
-      v.push_back(p);
-    }
-  }
-  std::sort(v.begin(), v.end(),
+// Consolidate the 2 level of sorting together into 1 giant vector, calculate numRows
+void ImageFolderOp::IndexFolders(std::vector<FolderImagesPair> *v) {
+  std::sort(v->begin(), v->end(),
             [](const FolderImagesPair &lhs, const FolderImagesPair &rhs) { return lhs->first < rhs->first; });
   // following loop puts the 2 level of shuffles together into 1 vector
-  for (size_t ind = 0; ind < v.size(); ++ind) {
-    while (v[ind]->second.empty() == false) {
-      DS_ASSERT(!(v[ind]->first.empty()));  // make sure that v[ind]->first.substr(1) is not out of bound
-      v[ind]->second.front()->second = class_index_.empty() ? ind : class_index_[v[ind]->first.substr(1)];
-      image_label_pairs_.push_back(v[ind]->second.front());
-      v[ind]->second.pop();
+  for (size_t ind = 0; ind < v->size(); ++ind) {
+    FolderImagesPair &p = (*v)[ind];
+    while (p->second.empty() == false) {
+      DS_ASSERT(!(p->first.empty()));  // make sure that p->first.substr(1) is not out of bound
+      p->second.front()->second = class_index_.empty() ? ind : class_index_[p->first.substr(1)];
+      image_label_pairs_.push_back(p->second.front());
+      p->second.pop();
     }
   }
   image_label_pairs_.shrink_to_fit();
   num_rows_ = image_label_pairs_.size();
   num_samples_ = (num_samples_ == 0 || num_samples_ > num_rows_) ? num_rows_ : num_samples_;
-  // free memory of two queues used for pre-scan
-  folder_name_queue_->Reset();
-  image_name_queue_->Reset();
+}
+
+Status ImageFolderOp::LoadIndex() {
+  std::lock_guard<std::mutex> lck(index_mux_);
+  if (index_ready_) {
+    return Status::OK();
+  }
+  std::vector<WalkedFolder> folders;
+  bool loaded = false;
+  if (!index_file_.empty()) {
+    RETURN_IF_NOT_OK(ReadIndexFile(&folders, &loaded));
+  }
+  if (!loaded) {
+    RETURN_IF_NOT_OK(WalkFolders(&folders));
+    if (!index_file_.empty()) {
+      // The listing is there already, the next runs walk the folders again if it can't be kept
+      Status rc = WriteIndexFile(folders);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Image folder operator can't write the index file: " << rc.ToString() << ".";
+      }
+    }
+  }
+  std::vector<FolderImagesPair> v;
+  for (const WalkedFolder &folder : folders) {
+    if (folder.images != nullptr) {
+      v.push_back(folder.images);
+    }
+  }
+  IndexFolders(&v);
+  index_ready_ = true;
   return Status::OK();
 }
 
+Status ImageFolderOp::GetRow(int64_t row_id, TensorRow *row) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  RETURN_IF_NOT_OK(LoadIndex());
+  if (row_id < 0 || row_id >= num_rows_) {
+    RETURN_STATUS_UNEXPECTED("Invalid row id " + std::to_string(row_id) + ", the dataset has " +
+                             std::to_string(num_rows_) + " rows");
+  }
+  return LoadTensorRow(image_label_pairs_[static_cast<size_t>(row_id)], row);
+}
+
 // Main logic, Register Queue with TaskGroup, launch all threads and do the functor's work
 Status ImageFolderOp::operator()() {
   RETURN_IF_NOT_OK(LaunchThreadsAndInitOp());
@@ -248,6 +280,22 @@ void ImageFolderOp::Print(std::ostream &out, bool show_all) const {
       << "\nImageFolder Directory: " << folder_path_ << "\n-------------------------\n";
 }
 
+Status ImageFolderOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["rows"] = pos.rows;
+  return sampler_->SaveState(pos, &(*op_state)["sampler"]);
+}
+
+Status ImageFolderOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  row_cnt_ = (*op_state)["rows"].get<int64_t>();
+  return sampler_->LoadState((*op_state)["sampler"]);
+}
+
 // Reset Sampler and wakeup Master thread (functor)
 Status ImageFolderOp::Reset() {
   RETURN_IF_NOT_OK(sampler_->Reset());
@@ -294,82 +342,188 @@ Status ImageFolderOp::GetClassIds(std::map<int32_t, std::vector<int64_t>> *cls_i
   return Status::OK();
 }
 
-// Worker Entry for pre-scanning all the folders and do the 1st level shuffle
-// Worker pull a file name from mFoldernameQueue (which is a Queue), walks all the images under that foldername
-// After walking is complete, sort all the file names (relative path to all jpeg files under the same directory )
-// (Sort is automatically conducted using a set which is implemented using a Red-Black Tree)
-// Add the sorted filenames in to a queue. The make a pair (foldername, queue<filenames>*),
-// foldername is used for 2nd level sorting.
-// FYI: 1st level sorting: sort all images under the same directory.
-// FYI: 2nd level sorting: sort all folder names
-// push this pair to mImagenameQueue (which is again a Queue)
-Status ImageFolderOp::PrescanWorkerEntry(int32_t worker_id) {
-  TaskManager::FindMe()->Post();
-  std::string folder_name;
-  RETURN_IF_NOT_OK(folder_name_queue_->PopFront(&folder_name));
-  while (folder_name.empty() == false) {
-    Path folder(folder_path_ + folder_name);
-    std::shared_ptr<Path::DirIterator> dirItr = Path::DirIterator::OpenDirectory(&folder);
-    if (folder.Exists() == false || dirItr == nullptr) {
-      RETURN_STATUS_UNEXPECTED("Error unable to open: " + folder_name);
-    }
-    std::set<std::string> imgs;  // use this for ordering
-    while (dirItr->hasNext()) {
-      Path file = dirItr->next();
-      if (extensions_.empty() || extensions_.find(file.Extension()) != extensions_.end()) {
-        (void)imgs.insert(file.toString().substr(dirname_offset_));
-      } else {
-        MS_LOG(INFO) << "Image folder operator unsupported file found: " << file.toString()
-                     << ", extension: " << file.Extension() << ".";
+// The walk is spread over the Executor, 1 job per folder. A job lists its folder once, sorts the images of a
+// class (1st level sorting, with a set which is implemented using a Red-Black Tree) and submits the jobs of the
+// subfolders. The classes are sorted by IndexFolders (2nd level sorting), so the order does not depend on which
+// job ends first.
+Status ImageFolderOp::WalkFolders(std::vector<WalkedFolder> *folders) {
+  Path dir(folder_path_);
+  if (dir.Exists() == false || dir.IsDirectory() == false) {
+    RETURN_STATUS_UNEXPECTED("Error unable to open: " + folder_path_);
+  }
+  dirname_offset_ = folder_path_.length();
+  WalkState state;
+  SubmitWalk(&state, "", false);
+  // A job submits the jobs of its subfolders before it ends, so the walk is over once the jobs are waited for
+  // in the order they were submitted. All of them are waited for since they work on this op, the jobs which
+  // have not started yet are skipped after an error.
+  Status rc;
+  for (size_t i = 0;; ++i) {
+    std::shared_ptr<ExecutorJob> job;
+    {
+      std::lock_guard<std::mutex> lck(state.mux);
+      if (i == state.jobs.size()) {
+        break;
       }
+      job = state.jobs[i];
     }
-    FolderImagesPair p = std::make_shared<std::pair<std::string, std::queue<ImageLabelPair>>>();
-    p->first = folder_name;
-    for (const std::string &img : imgs) {
-      p->second.push(std::make_shared<std::pair<std::string, int32_t>>(img, 0));
+    if (rc.IsError()) {
+      job->Cancel();
+    }
+    Status job_rc = job->Wait(rc.IsOk());
+    if (rc.IsOk() && job_rc.IsError()) {
+      rc = job_rc;
+      (void)job->Wait(false);  // it may still run after an interrupt
     }
-    RETURN_IF_NOT_OK(image_name_queue_->EmplaceBack(p));
-    RETURN_IF_NOT_OK(folder_name_queue_->PopFront(&folder_name));
   }
-  RETURN_IF_NOT_OK(image_name_queue_->EmplaceBack(nullptr));  // end signal
+  RETURN_IF_NOT_OK(rc);
+  *folders = std::move(state.folders);
+  std::sort(folders->begin(), folders->end(),
+            [](const WalkedFolder &lhs, const WalkedFolder &rhs) { return lhs.name < rhs.name; });
   return Status::OK();
 }
 
-// This helper function recursively walks all foldernames, and send each foldername to mFoldernameQueue
-// if mRecursive == false, don't go into folder of folders
-Status ImageFolderOp::RecursiveWalkFolder(Path *dir) {
-  std::shared_ptr<Path::DirIterator> dir_itr = Path::DirIterator::OpenDirectory(dir);
-  if (dir_itr == nullptr) {
-    RETURN_STATUS_UNEXPECTED("Error encountered when indexing files");
+void ImageFolderOp::SubmitWalk(WalkState *state, const std::string &folder_name, bool is_class) {
+  std::shared_ptr<ExecutorJob> job = Executor::GetInstance()->Submit(
+    [this, state, folder_name, is_class]() { return WalkFolder(state, folder_name, is_class); });
+  std::lock_guard<std::mutex> lck(state->mux);
+  state->jobs.push_back(std::move(job));
+}
+
+// if recursive_ == false, don't go into folder of folders
+Status ImageFolderOp::WalkFolder(WalkState *state, const std::string &folder_name, bool is_class) {
+  Path folder(folder_path_ + folder_name);
+  // The time is taken before the listing, a change during the walk shows in the next runs
+  WalkedFolder walked = {folder_name, folder.LastModified(), nullptr};
+  std::shared_ptr<Path::DirIterator> dir_itr = Path::DirIterator::OpenDirectory(&folder);
+  if (walked.mtime < 0 || dir_itr == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Error unable to open: " + folder_path_ + folder_name);
   }
+  bool walk_subfolders = recursive_ || folder_name.empty();
+  std::set<std::string> imgs;  // use this for ordering
   while (dir_itr->hasNext()) {
-    Path subdir = dir_itr->next();
-    if (subdir.IsDirectory()) {
-      if (class_index_.empty() ||
-          class_index_.find(subdir.toString().substr(dirname_offset_ + 1)) != class_index_.end()) {
-        RETURN_IF_NOT_OK(folder_name_queue_->EmplaceBack(subdir.toString().substr(dirname_offset_)));
+    Path file = dir_itr->next();
+    if (walk_subfolders && file.IsDirectory()) {
+      std::string subfolder = file.toString().substr(dirname_offset_);
+      SubmitWalk(state, subfolder,
+                 class_index_.empty() || class_index_.find(subfolder.substr(1)) != class_index_.end());
+    }
+    if (is_class == false) {
+      continue;
+    }
+    if (extensions_.empty() || extensions_.find(file.Extension()) != extensions_.end()) {
+      (void)imgs.insert(file.toString().substr(dirname_offset_));
+    } else {
+      MS_LOG(INFO) << "Image folder operator unsupported file found: " << file.toString()
+                   << ", extension: " << file.Extension() << ".";
+    }
+  }
+  if (is_class) {
+    walked.images = std::make_shared<std::pair<std::string, std::queue<ImageLabelPair>>>();
+    walked.images->first = folder_name;
+    for (const std::string &img : imgs) {
+      walked.images->second.push(std::make_shared<std::pair<std::string, int32_t>>(img, 0));
+    }
+  }
+  std::lock_guard<std::mutex> lck(state->mux);
+  state->folders.push_back(std::move(walked));
+  return Status::OK();
+}
+
+// The index file is made of lines:
+//   the magic line, then the options of IndexFileOptions()
+//   the number of folders walked, then for each of them: <mtime> <is_class> <number of images> <name>
+//   the images of the folder follow its line, 1 per line
+std::string ImageFolderOp::IndexFileOptions() const {
+  std::string options = folder_path_ + "\t" + (recursive_ ? "1" : "0") + "\t";
+  for (const std::string &ext : extensions_) {
+    options += ext + ",";
+  }
+  options += "\t";
+  for (const auto &p : class_index_) {
+    options += p.first + "=" + std::to_string(p.second) + ",";
+  }
+  return options;
+}
+
+Status ImageFolderOp::ReadIndexFile(std::vector<WalkedFolder> *folders, bool *loaded) {
+  *loaded = false;
+  std::ifstream in(index_file_);
+  if (!in.is_open()) {
+    MS_LOG(INFO) << "Image folder operator has no index file yet at " << index_file_ << ".";
+    return Status::OK();
+  }
+  std::string line;
+  std::string options;
+  int64_t num_folders = 0;
+  if (!std::getline(in, line) || line != kIndexFileMagic || !std::getline(in, options) ||
+      options != IndexFileOptions() || !(in >> num_folders)) {
+    MS_LOG(INFO) << "Image folder operator index file " << index_file_ << " is for other options, walks again.";
+    return Status::OK();
+  }
+  std::vector<WalkedFolder> v;
+  for (int64_t i = 0; i < num_folders; ++i) {
+    WalkedFolder folder;
+    int32_t is_class = 0;
+    int64_t num_images = 0;
+    if (!(in >> folder.mtime >> is_class >> num_images) || in.get() != ' ' || !std::getline(in, folder.name)) {
+      MS_LOG(INFO) << "Image folder operator index file " << index_file_ << " is truncated, walks again.";
+      return Status::OK();
+    }
+    // Only the folders are checked, adding or removing an image changes the time of its folder
+    if (Path(folder_path_ + folder.name).LastModified() != folder.mtime) {
+      MS_LOG(INFO) << "Image folder operator index file " << index_file_ << " is out of date, walks again.";
+      return Status::OK();
+    }
+    if (is_class != 0) {
+      folder.images = std::make_shared<std::pair<std::string, std::queue<ImageLabelPair>>>();
+      folder.images->first = folder.name;
+    }
+    for (int64_t j = 0; j < num_images; ++j) {
+      if (!std::getline(in, line)) {
+        MS_LOG(INFO) << "Image folder operator index file " << index_file_ << " is truncated, walks again.";
+        return Status::OK();
       }
-      if (recursive_ == true) {
-        RETURN_IF_NOT_OK(RecursiveWalkFolder(&subdir));
+      if (folder.images != nullptr) {
+        folder.images->second.push(std::make_shared<std::pair<std::string, int32_t>>(line, 0));
       }
     }
+    v.push_back(std::move(folder));
   }
+  *folders = std::move(v);
+  *loaded = true;
+  MS_LOG(INFO) << "Image folder operator read the listing of " << num_folders << " folders from " << index_file_
+               << ".";
   return Status::OK();
 }
 
-// A thread that calls RecursiveWalkFolder
-Status ImageFolderOp::startAsyncWalk() {
-  TaskManager::FindMe()->Post();
-  Path dir(folder_path_);
-  if (dir.Exists() == false || dir.IsDirectory() == false) {
-    RETURN_STATUS_UNEXPECTED("Error unable to open: " + folder_path_);
+Status ImageFolderOp::WriteIndexFile(const std::vector<WalkedFolder> &folders) {
+  auto plain = [](const std::string &name) { return name.find_first_of("\n\r") == std::string::npos; };
+  // The file is written aside then renamed, the runs which read it at the same time see the old or the new one
+  std::string tmp_file = index_file_ + ".tmp" + std::to_string(getpid());
+  std::ofstream out(tmp_file, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Can not open " + tmp_file);
   }
-  dirname_offset_ = folder_path_.length();
-  RETURN_IF_NOT_OK(RecursiveWalkFolder(&dir));
-  // send out num_workers_ end signal to mFoldernameQueue, 1 for each worker.
-  // Upon receiving end Signal, worker quits and set another end Signal to mImagenameQueue.
-  for (int32_t ind = 0; ind < num_workers_; ++ind) {
-    RETURN_IF_NOT_OK(folder_name_queue_->EmplaceBack(""));  // end signal
+  out << kIndexFileMagic << "\n" << IndexFileOptions() << "\n" << folders.size() << "\n";
+  bool ok = plain(IndexFileOptions());
+  for (const WalkedFolder &folder : folders) {
+    ok = ok && plain(folder.name);
+    size_t num_images = (folder.images == nullptr) ? 0 : folder.images->second.size();
+    out << folder.mtime << " " << (folder.images == nullptr ? 0 : 1) << " " << num_images << " " << folder.name
+        << "\n";
+    if (folder.images != nullptr) {
+      std::queue<ImageLabelPair> images = folder.images->second;
+      for (; !images.empty(); images.pop()) {
+        ok = ok && plain(images.front()->first);
+        out << images.front()->first << "\n";
+      }
+    }
+  }
+  out.close();
+  if (!ok || out.fail() || std::rename(tmp_file.c_str(), index_file_.c_str()) != 0) {
+    (void)std::remove(tmp_file.c_str());
+    RETURN_STATUS_UNEXPECTED(ok ? "Fail to write " + index_file_ : "A file name has a line break");
   }
   return Status::OK();
 }
@@ -380,22 +534,14 @@ Status ImageFolderOp::LaunchThreadsAndInitOp() {
   }
   // Registers QueueList and individual Queues for interrupt services
   RETURN_IF_NOT_OK(io_block_queues_.Register(tree_->AllTasks()));
-  RETURN_IF_NOT_OK(folder_name_queue_->Register(tree_->AllTasks()));
-  RETURN_IF_NOT_OK(image_name_queue_->Register(tree_->AllTasks()));
   wp_.Register(tree_->AllTasks());
-  // The following code launch 3 threads group
-  // 1) A thread that walks all folders and push the folder names to a util:Queue mFoldernameQueue.
-  // 2) Workers that pull foldername from mFoldernameQueue, walk it and return the sorted images to mImagenameQueue
-  // 3) Launch main workers that load DataBuffers by reading all images
-  RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask("walk dir", std::bind(&ImageFolderOp::startAsyncWalk, this)));
-  RETURN_IF_NOT_OK(
-    tree_->LaunchWorkers(num_workers_, std::bind(&ImageFolderOp::PrescanWorkerEntry, this, std::placeholders::_1)));
+  // Launch main workers that load DataBuffers by reading all images
   RETURN_IF_NOT_OK(
     tree_->LaunchWorkers(num_workers_, std::bind(&ImageFolderOp::WorkerEntry, this, std::placeholders::_1)));
   TaskManager::FindMe()->Post();
   // The order of the following 2 functions must not be changed!
-  RETURN_IF_NOT_OK(this->PrescanMasterEntry(folder_path_));  // Master thread of pre-scan workers, blocking
-  RETURN_IF_NOT_OK(this->InitSampler());                     // pass numRows to Sampler
+  RETURN_IF_NOT_OK(this->LoadIndex());    // walks all the folders, blocking
+  RETURN_IF_NOT_OK(this->InitSampler());  // pass numRows to Sampler
   return Status::OK();
 }
 
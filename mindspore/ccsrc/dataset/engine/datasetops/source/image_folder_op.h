@@ -18,6 +18,7 @@
 
 #include <deque>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <algorithm>
@@ -42,6 +43,8 @@
 namespace mindspore {
 namespace dataset {
 // Forward declares
+class ExecutorJob;
+
 template <typename T>
 class Queue;
 
@@ -140,6 +143,14 @@ class ImageFolderOp : public ParallelOp, public RandomAccessOp {
       return *this;
     }
 
+    // Setter method
+    // @param const std::string &index_file - the listing of the images is kept in this file for the next runs
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetIndexFile(const std::string &index_file) {
+      builder_index_file_ = index_file;
+      return *this;
+    }
+
     // Check validity of input args
     // @return - The error code return
     Status SanityCheck();
@@ -161,6 +172,7 @@ class ImageFolderOp : public ParallelOp, public RandomAccessOp {
     std::shared_ptr<Sampler> builder_sampler_;
     std::unique_ptr<DataSchema> builder_schema_;
     std::map<std::string, int32_t> builder_labels_to_read_;
+    std::string builder_index_file_;
   };
 
   // Constructor
@@ -170,35 +182,37 @@ class ImageFolderOp : public ParallelOp, public RandomAccessOp {
   // @param int32_t queue_size - connector queue size
   // @param std::set<std::string> exts - set of file extensions to read, if empty, read everything under the dir
   // @param td::unique_ptr<Sampler> sampler - sampler tells ImageFolderOp what to read
+  // @param std::string index_file - file which keeps the listing of the images, empty for none
   ImageFolderOp(int32_t num_wkrs, int32_t rows_per_buffer, std::string file_dir, int32_t queue_size,
                 int64_t num_samples, bool recursive, bool do_decode, const std::set<std::string> &exts,
                 const std::map<std::string, int32_t> &map, std::unique_ptr<DataSchema>,
-                std::shared_ptr<Sampler> sampler);
+                std::shared_ptr<Sampler> sampler, std::string index_file);
 
   // Destructor.
   ~ImageFolderOp() = default;
 
-  // Initialize ImageFOlderOp related var, calls the function to walk all files
-  // @param - std::string dir file directory to  ImageNetFolder
-  // @return - The error code return
-  Status PrescanMasterEntry(const std::string &dir);
-
   // Worker thread pulls a number of IOBlock from IOBlock Queue, make a buffer and push it to Connector
   // @param int32_t workerId - id of each worker
   // @return Status - The error code return
   Status WorkerEntry(int32_t worker_id) override;
 
-  // Worker thread pulls a number of IOBlock from IOBlock Queue, make a buffer and push it to Connector
-  // @param int32_t workerId - id of each worker
-  // @return Status - The error code return
-  Status PrescanWorkerEntry(int32_t worker_id);
-
   // Main Loop of ImageFolderOp
   // Master thread: Fill IOBlockQueue, then goes to sleep
   // Worker thread: pulls IOBlock from IOBlockQueue, work on it then put buffer to mOutConnector
   // @return Status - The error code return
   Status operator()() override;
 
+  // Base-class override. The position of the source is the position of its sampler.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
   // Method derived from RandomAccess Op, enable Sampler to get numRows
   // @param int64_t num - to return numRows
   // @return Status - The error code return
@@ -214,11 +228,21 @@ class ImageFolderOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status GetClassIds(std::map<int32_t, std::vector<int64_t>> *cls_ids) const override;
 
+  // Method derived from RandomAccess Op, loads one row by its id without a tree
+  // @param int64_t row_id - the id of the row in the dataset
+  // @param TensorRow *row - image & label read into this tensor row
+  // @return Status - The error code return
+  Status GetRow(int64_t row_id, TensorRow *row) override;
+
   // A print method typically used for debugging
   // @param out
   // @param show_all
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "ImageFolderOp"; }
+
   // This function is a hack! It is to return the num_class and num_rows the old storageOp does. The result
   // returned by this function may not be consistent with what image_folder_op is going to return
   // user this at your own risk!
@@ -242,14 +266,59 @@ class ImageFolderOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status LoadBuffer(const std::vector<int64_t> &keys, std::unique_ptr<DataBuffer> *db);
 
-  // @param std::string & dir - dir to walk all images
-  // @param int64_t * cnt - number of non folder files under the current dir
-  // @return
-  Status RecursiveWalkFolder(Path *dir);
+  // A folder seen by the walk
+  struct WalkedFolder {
+    std::string name;         // relative to the image folder, empty for the image folder itself
+    int64_t mtime;            // time of its last change when it was walked
+    FolderImagesPair images;  // its sorted images if it is a class, else nullptr
+  };
 
-  // start walking of all dirs
-  // @return
-  Status startAsyncWalk();
+  // What the jobs of a walk share
+  struct WalkState {
+    std::mutex mux;
+    std::vector<std::shared_ptr<ExecutorJob>> jobs;  // in the order they were submitted
+    std::vector<WalkedFolder> folders;
+  };
+
+  // Build the index of the images once, for the tree or for GetRow, whichever comes first
+  // @return Status - The error code return
+  Status LoadIndex();
+
+  // Walk all the folders in parallel, one Executor job per folder
+  // @param std::vector<WalkedFolder> *folders - the folders walked, sorted by name
+  // @return Status - The error code return
+  Status WalkFolders(std::vector<WalkedFolder> *folders);
+
+  // Queue the job which walks a folder
+  // @param WalkState *state - the state of the walk
+  // @param const std::string &folder_name - the folder, relative to the image folder
+  // @param bool is_class - the images of the folder are read
+  void SubmitWalk(WalkState *state, const std::string &folder_name, bool is_class);
+
+  // List a folder once, for its images if it is a class and for the subfolders to walk
+  // @param WalkState *state - the state of the walk
+  // @param const std::string &folder_name - the folder, relative to the image folder
+  // @param bool is_class - the images of the folder are read
+  // @return Status - The error code return
+  Status WalkFolder(WalkState *state, const std::string &folder_name, bool is_class);
+
+  // Sort the walked folders and put all their images in image_label_pairs_
+  // @param std::vector<FolderImagesPair> *v - the folders which are classes
+  void IndexFolders(std::vector<FolderImagesPair> *v);
+
+  // @return The options of the op which the listing depends on, as the first line of the index file
+  std::string IndexFileOptions() const;
+
+  // Read the listing from index_file_, if it was made with the same options and no folder changed since
+  // @param std::vector<WalkedFolder> *folders - the folders of the listing
+  // @param bool *loaded - T/F if the listing is up to date
+  // @return Status - The error code return
+  Status ReadIndexFile(std::vector<WalkedFolder> *folders, bool *loaded);
+
+  // Write the listing to index_file_
+  // @param const std::vector<WalkedFolder> &folders - the folders walked
+  // @return Status - The error code return
+  Status WriteIndexFile(const std::vector<WalkedFolder> &folders);
 
   // Called first when function is called
   // @return
@@ -275,10 +344,11 @@ class ImageFolderOp : public ParallelOp, public RandomAccessOp {
   int64_t dirname_offset_;
   WaitPost wp_;
   std::vector<ImageLabelPair> image_label_pairs_;
-  std::unordered_map<std::string, int32_t> col_name_map_;
+  std::shared_ptr<const ColumnNameMap> col_name_map_;
   QueueList<std::unique_ptr<IOBlock>> io_block_queues_;  // queues of IOBlocks
-  std::unique_ptr<Queue<std::string>> folder_name_queue_;
-  std::unique_ptr<Queue<FolderImagesPair>> image_name_queue_;
+  std::string index_file_;  // keeps the listing between runs, empty for none
+  std::mutex index_mux_;    // guards the walk of the folders
+  bool index_ready_;        // the folders are walked
 };
 }  // namespace dataset
 }  // namespace mindspore
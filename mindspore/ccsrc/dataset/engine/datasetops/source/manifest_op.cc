@@ -25,6 +25,7 @@
 #include "dataset/engine/datasetops/source/sampler/sequential_sampler.h"
 #include "dataset/engine/db_connector.h"
 #include "dataset/engine/execution_tree.h"
+#include "dataset/util/executor.h"
 
 namespace mindspore {
 namespace dataset {
@@ -74,10 +75,13 @@ ManifestOp::ManifestOp(int32_t num_works, int32_t rows_per_buffer, std::string f
       num_rows_(0),
       decode_(decode),
       usage_(usage),
-      buf_cnt_(0) {
+      buf_cnt_(0),
+      index_ready_(false) {
+  ColumnNameMap col_name_map;
   for (int32_t i = 0; i < data_schema_->NumColumns(); ++i) {
-    col_name_map_[data_schema_->column(i).name()] = i;
+    col_name_map[data_schema_->column(i).name()] = i;
   }
+  col_name_map_ = std::make_shared<const ColumnNameMap>(std::move(col_name_map));
   io_block_queues_.Init(num_workers_, queue_size);
   (void)std::transform(usage_.begin(), usage_.end(), usage_.begin(), ::tolower);
 }
@@ -145,12 +149,31 @@ Status ManifestOp::LaunchThreadsAndInitOp() {
   RETURN_IF_NOT_OK(
     tree_->LaunchWorkers(num_workers_, std::bind(&ManifestOp::WorkerEntry, this, std::placeholders::_1)));
   TaskManager::FindMe()->Post();
-  RETURN_IF_NOT_OK(ParseManifestFile());
-  RETURN_IF_NOT_OK(CountDatasetInfo());
+  RETURN_IF_NOT_OK(LoadIndex());
   RETURN_IF_NOT_OK(InitSampler());
   return Status::OK();
 }
 
+Status ManifestOp::LoadIndex() {
+  std::lock_guard<std::mutex> lck(index_mux_);
+  if (!index_ready_) {
+    RETURN_IF_NOT_OK(ParseManifestFile());
+    RETURN_IF_NOT_OK(CountDatasetInfo());
+    index_ready_ = true;
+  }
+  return Status::OK();
+}
+
+Status ManifestOp::GetRow(int64_t row_id, TensorRow *row) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  RETURN_IF_NOT_OK(LoadIndex());
+  if (row_id < 0 || row_id >= num_rows_) {
+    RETURN_STATUS_UNEXPECTED("Invalid row id " + std::to_string(row_id) + ", the dataset has " +
+                             std::to_string(num_rows_) + " rows");
+  }
+  return LoadTensorRow(image_labelname_[static_cast<size_t>(row_id)], row);
+}
+
 // contains the main logic of pulling a IOBlock from IOBlockQueue, load a buffer and push the buffer to out_connector_
 // IMPORTANT: 1 IOBlock produces 1 DataBuffer
 Status ManifestOp::WorkerEntry(int32_t worker_id) {
@@ -244,6 +267,22 @@ void ManifestOp::Print(std::ostream &out, bool show_all) const {
       << "\nManifest file: " << file_ << "\n-------------------------\n";
 }
 
+Status ManifestOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["rows"] = pos.rows;
+  return sampler_->SaveState(pos, &(*op_state)["sampler"]);
+}
+
+Status ManifestOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  row_cnt_ = (*op_state)["rows"].get<int64_t>();
+  return sampler_->LoadState((*op_state)["sampler"]);
+}
+
 // Reset Sampler and wakeup Master thread (functor)
 Status ManifestOp::Reset() {
   RETURN_IF_NOT_OK(sampler_->Reset());
@@ -305,17 +344,13 @@ Status ManifestOp::ParseManifestFile() {
   if (!file_handle.is_open()) {
     RETURN_STATUS_UNEXPECTED("Manifest file " + file_ + " can not open.");
   }
+  // The rows of the usage, their images are checked afterwards all at once
+  std::vector<std::pair<std::string, std::vector<std::string>>> rows;
   std::string line;
   while (getline(file_handle, line)) {
     try {
       nlohmann::json js = nlohmann::json::parse(line);
       std::string image_file_path = js.value("source", "");
-      // If image is not JPEG/PNG/GIF/BMP, drop it
-      bool valid = false;
-      RETURN_IF_NOT_OK(CheckImageType(image_file_path, &valid));
-      if (!valid) {
-        continue;
-      }
       std::string usage = js.value("usage", "");
       (void)std::transform(usage.begin(), usage.end(), usage.begin(), ::tolower);
       if (usage != usage_) {
@@ -331,14 +366,11 @@ Status ManifestOp::ParseManifestFile() {
           RETURN_STATUS_UNEXPECTED("Label name is not found in manifest file for " + image_file_path);
         }
         if (class_index_.empty() || class_index_.find(label_name) != class_index_.end()) {
-          if (label_index_.find(label_name) == label_index_.end()) {
-            label_index_[label_name] = 0;
-          }
           labels.emplace_back(label_name);
         }
       }
       if (!labels.empty()) {
-        image_labelname_.emplace_back(std::make_pair(image_file_path, labels));
+        rows.emplace_back(std::make_pair(image_file_path, labels));
       }
     } catch (const std::exception &err) {
       file_handle.close();
@@ -347,9 +379,57 @@ Status ManifestOp::ParseManifestFile() {
   }
   file_handle.close();
 
+  // If image is not JPEG/PNG/GIF/BMP, drop it
+  std::vector<uint8_t> valid;
+  RETURN_IF_NOT_OK(CheckImageTypes(rows, &valid));
+  for (size_t i = 0; i < rows.size(); ++i) {
+    if (valid[i] == 0) {
+      continue;
+    }
+    for (const std::string &label_name : rows[i].second) {
+      if (label_index_.find(label_name) == label_index_.end()) {
+        label_index_[label_name] = 0;
+      }
+    }
+    image_labelname_.emplace_back(std::move(rows[i]));
+  }
   return Status::OK();
 }
 
+// Each image is opened to read its header, which takes a round trip per image on a network file system. The
+// images are checked in parallel on the Executor, in chunks of consecutive rows.
+Status ManifestOp::CheckImageTypes(const std::vector<std::pair<std::string, std::vector<std::string>>> &rows,
+                                   std::vector<uint8_t> *valid) {
+  constexpr size_t kImagesPerJob = 256;
+  valid->assign(rows.size(), 0);
+  std::vector<std::shared_ptr<ExecutorJob>> jobs;
+  for (size_t begin = 0; begin < rows.size(); begin += kImagesPerJob) {
+    size_t end = std::min(begin + kImagesPerJob, rows.size());
+    jobs.push_back(Executor::GetInstance()->Submit([this, &rows, valid, begin, end]() {
+      for (size_t i = begin; i < end; ++i) {
+        bool is_valid = false;
+        RETURN_IF_NOT_OK(CheckImageType(rows[i].first, &is_valid));
+        (*valid)[i] = is_valid ? 1 : 0;
+      }
+      return Status::OK();
+    }));
+  }
+  // The first error in the order of the file is returned. All the jobs are waited for since they work on the
+  // rows, the jobs which have not started yet are skipped after an error.
+  Status rc;
+  for (auto &job : jobs) {
+    if (rc.IsError()) {
+      job->Cancel();
+    }
+    Status job_rc = job->Wait(rc.IsOk());
+    if (rc.IsOk() && job_rc.IsError()) {
+      rc = job_rc;
+      (void)job->Wait(false);  // it may still run after an interrupt
+    }
+  }
+  return rc;
+}
+
 // Only support JPEG/PNG/GIF/BMP
 Status ManifestOp::CheckImageType(const std::string &file_name, bool *valid) {
   std::ifstream file_handle;
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -165,6 +166,17 @@ class ManifestOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // Base-class override. The position of the source is the position of its sampler.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
   // Method derived from RandomAccess Op, enable Sampler to get numRows
   // @param int64_t num - to return numRows
   // @return Status - The error code return
@@ -180,11 +192,21 @@ class ManifestOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status GetClassIds(std::map<int32_t, std::vector<int64_t>> *cls_ids) const override;
 
+  // Method derived from RandomAccess Op, loads one row by its id without a tree
+  // @param int64_t row_id - the id of the row in the dataset
+  // @param TensorRow *row - image & label read into this tensor row
+  // @return Status - The error code return
+  Status GetRow(int64_t row_id, TensorRow *row) override;
+
   // A print method typically used for debugging
   // @param out
   // @param show_all
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "ManifestOp"; }
+
   static Status CountTotalRows(const std::string &file, int64_t numSamples, const py::dict &dict,
                                const std::string &usage, int64_t *count, int64_t *numClasses);
 
@@ -229,10 +251,21 @@ class ManifestOp : public ParallelOp, public RandomAccessOp {
   // @return
   Status CheckImageType(const std::string &file_name, bool *valid);
 
+  // Check the images of many rows in parallel
+  // @param rows - <imagefile, <label1, label2...>>
+  // @param std::vector<uint8_t> *valid - 1 for each row whose image is valid, else 0
+  // @return Status - The error code return
+  Status CheckImageTypes(const std::vector<std::pair<std::string, std::vector<std::string>>> &rows,
+                         std::vector<uint8_t> *valid);
+
   // Count label index,num rows and num samples
   // @return Status - The error code return
   Status CountDatasetInfo();
 
+  // Parse the manifest file once, for the tree or for GetRow, whichever comes first
+  // @return Status - The error code return
+  Status LoadIndex();
+
   int32_t rows_per_buffer_;
   int64_t io_block_pushed_;
   int64_t row_cnt_;
@@ -248,10 +281,12 @@ class ManifestOp : public ParallelOp, public RandomAccessOp {
   int64_t buf_cnt_;
 
   WaitPost wp_;
-  std::unordered_map<std::string, int32_t> col_name_map_;
+  std::shared_ptr<const ColumnNameMap> col_name_map_;
   QueueList<std::unique_ptr<IOBlock>> io_block_queues_;
   std::map<std::string, int32_t> label_index_;
   std::vector<std::pair<std::string, std::vector<std::string>>> image_labelname_;
+  std::mutex index_mux_;  // guards the parsing of the manifest file
+  bool index_ready_;      // the manifest file is parsed
 };
 }  // namespace dataset
 }  // namespace mindspore
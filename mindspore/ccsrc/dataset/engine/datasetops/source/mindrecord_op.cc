@@ -53,6 +53,8 @@ MindRecordOp::Builder::Builder() : build_dataset_file_("") {
   build_rows_per_buffer_ = cfg->rows_per_buffer();
   build_op_connector_queue_size_ = cfg->op_connector_size();
   build_block_reader_ = false;
+  build_mmap_mode_ = false;
+  build_prefetch_depth_ = 0;
   builder_num_workers_ = 0;
 }
 
@@ -65,9 +67,15 @@ Status MindRecordOp::Builder::Build(std::shared_ptr<MindRecordOp> *ptr) {
                   "Building a MindRecordOp that has not provided a file.");
   }
 
+  if (build_prefetch_depth_ < 0) {
+    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                  "Building a MindRecordOp with a negative prefetch depth.");
+  }
+
   new_mind_record_op = std::make_shared<MindRecordOp>(build_num_mind_record_workers_, build_rows_per_buffer_,
                                                       build_dataset_file_, build_op_connector_queue_size_,
-                                                      build_columns_to_load_, build_operators_, build_block_reader_);
+                                                      build_columns_to_load_, build_operators_, build_block_reader_,
+                                                      build_mmap_mode_, build_prefetch_depth_);
 
   RETURN_IF_NOT_OK(new_mind_record_op->Init());
 
@@ -80,7 +88,8 @@ Status MindRecordOp::Builder::SanityCheck() const { return Status::OK(); }
 // Constructor of the MindRecordOp.
 MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buffer, std::string dataset_file,
                            int32_t op_connector_queue_size, const std::vector<std::string> &columns_to_load,
-                           const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader)
+                           const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+                           const bool &mmap_mode, int32_t prefetch_depth)
     : ParallelOp(num_mind_record_workers, op_connector_queue_size),
       rows_per_buffer_(rows_per_buffer),
       dataset_file_(dataset_file),
@@ -88,11 +97,14 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
       operators_(operators),
       num_mind_record_workers_(num_mind_record_workers),
       block_reader_(block_reader),
+      mmap_mode_(mmap_mode),
+      prefetch_depth_(prefetch_depth),
       buffers_needed_(0),
       buf_cnt_(0),
       num_rows_(0),
       ended_worker_(0),
-      buffer_water_mark_(0) {
+      buffer_water_mark_(0),
+      columnar_reader_(true) {
   io_blk_queues_.Init(num_workers_, op_connector_queue_size);
   if (!block_reader_) return;
   for (int32_t i = 0; i < num_workers_; ++i) {
@@ -103,7 +115,9 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
   shard_reader_ = mindspore::make_unique<ShardReader>();
-  auto rc = shard_reader_->Open(dataset_file_, num_mind_record_workers_, columns_to_load_, operators_, block_reader_);
+  shard_reader_->set_prefetch_depth(prefetch_depth_);
+  auto rc = shard_reader_->Open(dataset_file_, num_mind_record_workers_, columns_to_load_, operators_, block_reader_,
+                                mmap_mode_);
 
   CHECK_FAIL_RETURN_UNEXPECTED(rc != MSRStatus::FAILED, "MindRecordOp init failed.");
 
@@ -152,9 +166,11 @@ Status MindRecordOp::Init() {
     data_schema_ = std::move(tmp_schema);
   }
 
+  ColumnNameMap column_name_mapping;
   for (int i = 0; i < static_cast<int>(columns_to_load_.size()); i++) {
-    column_name_mapping_[columns_to_load_[i]] = i;
+    column_name_mapping[columns_to_load_[i]] = i;
   }
+  column_name_mapping_ = std::make_shared<const ColumnNameMap>(std::move(column_name_mapping));
 
   num_rows_ = shard_reader_->get_num_rows();
   // Compute how many buffers we would need to accomplish rowsPerBuffer
@@ -169,8 +185,9 @@ Status MindRecordOp::SetColumnsBlob() {
   columns_blob_index_ = std::vector<int32_t>(columns_to_load_.size(), -1);
   int32_t iBlob = 0;
   for (uint32_t i = 0; i < columns_blob_.size(); ++i) {
-    if (column_name_mapping_.count(columns_blob_[i])) {
-      columns_blob_index_[column_name_mapping_[columns_blob_[i]]] = iBlob++;
+    auto itr = column_name_mapping_->find(columns_blob_[i]);
+    if (itr != column_name_mapping_->end()) {
+      columns_blob_index_[itr->second] = iBlob++;
     }
   }
   return Status::OK();
@@ -211,7 +228,7 @@ Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
   // load blob column
   if (columns_blob_index_[i_col] >= 0 && columns_blob.size() > 0) {
     int32_t pos = columns_blob_.size() == 1 ? -1 : columns_blob_index_[i_col];
-    RETURN_IF_NOT_OK(LoadBlob(&new_shape, &data, columns_blob, pos, cur_column));
+    RETURN_IF_NOT_OK(LoadBlob(&new_shape, &data, columns_blob.data(), columns_blob.size(), pos, cur_column));
   } else {
     switch (type.value()) {
       case DataType::DE_UINT8: {
@@ -246,9 +263,8 @@ Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
   return Status::OK();
 }
 
-Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data,
-                              const std::vector<uint8_t> &columns_blob, const int32_t pos,
-                              const ColDescriptor &column) {
+Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data, const uint8_t *columns_blob,
+                              uint64_t blob_size, const int32_t pos, const ColDescriptor &column) {
   const auto kColumnSize = column.type().SizeInBytes();
   if (kColumnSize == 0) {
     RETURN_STATUS_UNEXPECTED("column size is null");
@@ -256,13 +272,12 @@ Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data
   if (pos == -1) {
     if (column.hasShape()) {
       *new_shape = TensorShape::CreateUnknownRankShape();
-      RETURN_IF_NOT_OK(
-        column.MaterializeTensorShape(static_cast<int32_t>(columns_blob.size() / kColumnSize), new_shape));
+      RETURN_IF_NOT_OK(column.MaterializeTensorShape(static_cast<int32_t>(blob_size / kColumnSize), new_shape));
     } else {
-      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(columns_blob.size() / kColumnSize)};
+      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(blob_size / kColumnSize)};
       *new_shape = TensorShape(shapeDetails);
     }
-    *data = reinterpret_cast<const uint8_t *>(&(columns_blob[0]));
+    *data = columns_blob;
     return Status::OK();
   }
   auto uint64_from_bytes = [&](int64_t pos) {
@@ -286,7 +301,7 @@ Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data
     std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_bytes / kColumnSize)};
     *new_shape = TensorShape(shapeDetails);
   }
-  *data = reinterpret_cast<const uint8_t *>(&(columns_blob[iStart]));
+  *data = columns_blob + iStart;
   return Status::OK();
 }
 
@@ -489,6 +504,17 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   *fetched_buffer = mindspore::make_unique<DataBuffer>(buffer_id, DataBuffer::kDeBFlagNone);
   (*fetched_buffer)->set_column_name_map(column_name_mapping_);
   std::unique_ptr<TensorQTable> tensor_table = mindspore::make_unique<TensorQTable>();
+  if (!block_reader_ && columnar_reader_) {
+    mindrecord::ShardColumnarBatch batch;
+    if (shard_reader_->GetColumnarBatch(buffer_id * rows_per_buffer_, rows_per_buffer_, worker_id, &batch) ==
+        MSRStatus::SUCCESS) {
+      RETURN_IF_NOT_OK(LoadColumnarBatch(batch, tensor_table.get()));
+      (*fetched_buffer)->set_tensor_table(std::move(tensor_table));
+      return Status::OK();
+    }
+    MS_LOG(INFO) << "MindRecord operator reads the rows one by one instead of as columns.";
+    columnar_reader_ = false;
+  }
   for (int32_t i = 0; i < rows_per_buffer_; ++i) {
     ShardTuple tupled_buffer;
     if (block_reader_) {
@@ -522,6 +548,69 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   return Status::OK();
 }
 
+Status MindRecordOp::LoadColumnarBatch(const mindrecord::ShardColumnarBatch &batch,
+                                       TensorQTable *tensor_table) const {
+  std::vector<int32_t> label_index(columns_to_load_.size(), -1);
+  for (uint32_t j = 0; j < columns_to_load_.size(); ++j) {
+    for (uint32_t i = 0; i < batch.columns.size(); ++i) {
+      if (batch.columns[i].name == columns_to_load_[j]) {
+        label_index[j] = static_cast<int32_t>(i);
+        break;
+      }
+    }
+  }
+  for (uint32_t row = 0; row < batch.num_rows; ++row) {
+    TensorRow tensor_row;
+    for (uint32_t j = 0; j < columns_to_load_.size(); ++j) {
+      std::shared_ptr<Tensor> tensor;
+      RETURN_IF_NOT_OK(LoadColumnarFeature(&tensor, j, batch, row, label_index[j]));
+      tensor_row.push_back(std::move(tensor));
+    }
+    tensor_table->push_back(std::move(tensor_row));
+  }
+  return Status::OK();
+}
+
+Status MindRecordOp::LoadColumnarFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
+                                         const mindrecord::ShardColumnarBatch &batch, uint32_t row,
+                                         int32_t label_index) const {
+  TensorShape new_shape = TensorShape::CreateUnknownRankShape();
+  const unsigned char *data = nullptr;
+  const ColDescriptor &cur_column = data_schema_->column(i_col);
+  DataType type = cur_column.type();
+
+  auto blob_size = batch.blob_offsets[row + 1] - batch.blob_offsets[row];
+  if (columns_blob_index_[i_col] >= 0 && blob_size > 0) {
+    int32_t pos = columns_blob_.size() == 1 ? -1 : columns_blob_index_[i_col];
+    RETURN_IF_NOT_OK(
+      LoadBlob(&new_shape, &data, batch.blob_data.data() + batch.blob_offsets[row], blob_size, pos, cur_column));
+  } else {
+    if (label_index < 0) {
+      RETURN_STATUS_UNEXPECTED("Column " + columns_to_load_[i_col] + " is not read by the reader.");
+    }
+    const auto &values = batch.columns[label_index];
+    auto num_bytes = values.offsets[row + 1] - values.offsets[row];
+    auto type_size = type.SizeInBytes();
+    bool is_scalar = !values.is_array && values.type != "string";
+    if (type_size == 0 || num_bytes % type_size != 0 || (is_scalar && num_bytes != type_size)) {
+      RETURN_STATUS_UNEXPECTED("Column " + values.name + " does not match the type of its schema.");
+    }
+    if (values.type == "string" || (values.is_array && !cur_column.hasShape())) {
+      std::vector<dsize_t> shape_details = {static_cast<dsize_t>(num_bytes / type_size)};
+      new_shape = TensorShape(shape_details);
+    } else if (values.is_array) {
+      new_shape = TensorShape(cur_column.shape());
+    } else {
+      new_shape = TensorShape::CreateScalar();
+    }
+    data = values.data.data() + values.offsets[row];
+  }
+  // Create Tensor with given details
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(tensor, cur_column.tensorImpl(), new_shape, type, data));
+
+  return Status::OK();
+}
+
 Status MindRecordOp::SwitchLoadFeature(const DataType &type, std::shared_ptr<Tensor> *tensor, int32_t i_col,
                                        const std::vector<uint8_t> &columns_blob,
                                        const mindrecord::json &columns_json) const {
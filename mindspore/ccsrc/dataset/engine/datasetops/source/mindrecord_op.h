@@ -28,6 +28,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "dataset/engine/data_buffer.h"
 #include "dataset/engine/data_schema.h"
 #include "dataset/engine/datasetops/parallel_op.h"
 #include "dataset/engine/datasetops/source/io_block.h"
@@ -98,6 +99,16 @@ class MindRecordOp : public ParallelOp {
       return *this;
     }
 
+    Builder &SetMmapMode() {
+      build_mmap_mode_ = true;
+      return *this;
+    }
+
+    Builder &SetPrefetchDepth(int32_t prefetch_depth) {
+      build_prefetch_depth_ = prefetch_depth;
+      return *this;
+    }
+
     Status SanityCheck() const;
 
     static int32_t num_mind_record_workers() { return kDefaultMindRecordWorkers; }
@@ -114,6 +125,8 @@ class MindRecordOp : public ParallelOp {
     std::vector<std::string> build_columns_to_load_;
     std::vector<std::shared_ptr<ShardOperator>> build_operators_;
     bool build_block_reader_;
+    bool build_mmap_mode_;
+    int32_t build_prefetch_depth_;
   };
 
   // Constructor of the MindRecordOp.
@@ -124,9 +137,13 @@ class MindRecordOp : public ParallelOp {
   // @param op_connector_queue_size - The output connector queue size
   // @param columns_to_load - The list of columns to use (column name)
   // @param operators - ShardOperators for Shuffle, Category, Sample
+  // @param block_reader - T/F if the ShardReader reads whole pages instead of rows
+  // @param mmap_mode - T/F if the ShardReader reads the files through memory mappings
+  // @param prefetch_depth - The number of tasks the ShardReader reads ahead of the workers, 0 for its default
   MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buffer, std::string dataset_file,
                int32_t op_connector_queue_size, const std::vector<std::string> &columns_to_load,
-               const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader);
+               const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+               const bool &mmap_mode = false, int32_t prefetch_depth = 0);
 
   // Destructor
   ~MindRecordOp() override;
@@ -136,6 +153,10 @@ class MindRecordOp : public ParallelOp {
   // @param show_all - A bool to control if you want to show all info or just a summary
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "MindRecordOp"; }
+
   // << Stream output operator overload
   // @notes This allows you to write the debug print info using stream operators
   // @param out - reference to the output stream being overloaded
@@ -184,6 +205,8 @@ class MindRecordOp : public ParallelOp {
 
   bool block_reader() const { return block_reader_; }
 
+  bool mmap_mode() const { return mmap_mode_; }
+
   Status Init();
 
   Status SetColumnsBlob();
@@ -191,6 +214,20 @@ class MindRecordOp : public ParallelOp {
  private:
   Status GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_buffer, int64_t buffer_id, int32_t worker_id);
 
+  // Parses the rows of a columnar batch and puts them into the tensor table
+  // @param batch - the rows received from the reader as columns
+  // @param tensor_table - the table to put the rows in
+  Status LoadColumnarBatch(const mindrecord::ShardColumnarBatch &batch, TensorQTable *tensor_table) const;
+
+  // Parses a single cell of a columnar batch and puts the data into a tensor
+  // @param tensor - the tensor to put the parsed data in
+  // @param i_col - the id of column to parse
+  // @param batch - the rows received from the reader as columns
+  // @param row - the row of the cell in the batch
+  // @param label_index - the label column of the batch holding the column, -1 if none
+  Status LoadColumnarFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
+                             const mindrecord::ShardColumnarBatch &batch, uint32_t row, int32_t label_index) const;
+
   // Parses a single cell and puts the data into a tensor
   // @param tensor - the tensor to put the parsed data in
   // @param i_col - the id of column to parse
@@ -203,8 +240,8 @@ class MindRecordOp : public ParallelOp {
   Status SwitchLoadFeature(const DataType &type, std::shared_ptr<Tensor> *tensor, int32_t i_col,
                            const std::vector<uint8_t> &columns_blob, const mindrecord::json &columns_json) const;
 
-  static Status LoadBlob(TensorShape *new_shape, const unsigned char **data, const std::vector<uint8_t> &columns_blob,
-                         const int32_t pos, const ColDescriptor &column);
+  static Status LoadBlob(TensorShape *new_shape, const unsigned char **data, const uint8_t *columns_blob,
+                         uint64_t blob_size, const int32_t pos, const ColDescriptor &column);
 
   // Get shape and data (scalar or array) for tensor to be created (for floats and doubles)
   // @param new_shape - the shape of tensor to be created.
@@ -251,17 +288,20 @@ class MindRecordOp : public ParallelOp {
   std::vector<std::shared_ptr<ShardOperator>> operators_;  // ShardOperators to use
   int32_t num_mind_record_workers_;                        // number of workers to be spawned by ShardReader
   bool block_reader_;                                      // block reader switch
+  bool mmap_mode_;                                         // memory mapped reading switch
+  int32_t prefetch_depth_;                                 // tasks read ahead by ShardReader, 0 for its default
   int32_t buffers_needed_;                                 // Counter for the buffers that were fetched
   int64_t buf_cnt_;                                        // Buffer counter
   int32_t num_rows_;                                       // One more than the last row id in the range for this cache
   std::atomic<int32_t> ended_worker_;
   std::atomic<int32_t> buffer_water_mark_;
+  std::atomic<bool> columnar_reader_;  // rows read as columns, until the reader fails to
 
   std::unique_ptr<DataSchema> data_schema_;  // Data schema for column typing
   std::vector<std::string> columns_blob_;    // Blob Columns to load from dataset
   std::vector<int32_t> columns_blob_index_;  // Blob Columns to load from dataset
 
-  std::unordered_map<std::string, int32_t> column_name_mapping_;
+  std::shared_ptr<const ColumnNameMap> column_name_mapping_;  // Shared by all the buffers
   std::unique_ptr<ShardReader> shard_reader_;
   WaitPost shard_reader_wait_post_;
   QueueList<std::unique_ptr<IOBlock>> io_blk_queues_;
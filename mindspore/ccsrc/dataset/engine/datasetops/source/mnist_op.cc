@@ -74,10 +74,13 @@ MnistOp::MnistOp(int32_t num_workers, int32_t rows_per_buffer, std::string folde
       folder_path_(folder_path),
       rows_per_buffer_(rows_per_buffer),
       sampler_(std::move(sampler)),
-      data_schema_(std::move(data_schema)) {
+      data_schema_(std::move(data_schema)),
+      index_ready_(false) {
+  ColumnNameMap col_name_map;
   for (int32_t i = 0; i < data_schema_->NumColumns(); ++i) {
-    col_name_map_[data_schema_->column(i).name()] = i;
+    col_name_map[data_schema_->column(i).name()] = i;
   }
+  col_name_map_ = std::make_shared<const ColumnNameMap>(std::move(col_name_map));
   io_block_queues_.Init(num_workers, queue_size);
 }
 
@@ -195,6 +198,22 @@ void MnistOp::Print(std::ostream &out, bool show_all) const {
       << "\nMNIST Directory: " << folder_path_ << "\n-------------------------\n";
 }
 
+Status MnistOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["rows"] = pos.rows;
+  return sampler_->SaveState(pos, &(*op_state)["sampler"]);
+}
+
+Status MnistOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  row_cnt_ = (*op_state)["rows"].get<int64_t>();
+  return sampler_->LoadState((*op_state)["sampler"]);
+}
+
 // Reset Sampler and wakeup Master thread (functor)
 Status MnistOp::Reset() {
   RETURN_IF_NOT_OK(sampler_->Reset());
@@ -396,12 +415,31 @@ Status MnistOp::LaunchThreadsAndInitOp() {
   wp_.Register(tree_->AllTasks());
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_workers_, std::bind(&MnistOp::WorkerEntry, this, std::placeholders::_1)));
   TaskManager::FindMe()->Post();
-  RETURN_IF_NOT_OK(this->WalkAllFiles());
-  RETURN_IF_NOT_OK(this->ParseMnistData());
+  RETURN_IF_NOT_OK(this->LoadIndex());
   RETURN_IF_NOT_OK(this->InitSampler());  // handle shake with sampler
   return Status::OK();
 }
 
+Status MnistOp::LoadIndex() {
+  std::lock_guard<std::mutex> lck(index_mux_);
+  if (!index_ready_) {
+    RETURN_IF_NOT_OK(this->WalkAllFiles());
+    RETURN_IF_NOT_OK(this->ParseMnistData());
+    index_ready_ = true;
+  }
+  return Status::OK();
+}
+
+Status MnistOp::GetRow(int64_t row_id, TensorRow *row) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  RETURN_IF_NOT_OK(LoadIndex());
+  if (row_id < 0 || row_id >= num_rows_) {
+    RETURN_STATUS_UNEXPECTED("Invalid row id " + std::to_string(row_id) + ", the dataset has " +
+                             std::to_string(num_rows_) + " rows");
+  }
+  return LoadTensorRow(image_label_pairs_[row_id], row);
+}
+
 Status MnistOp::CountTotalRows(const std::string &dir, int64_t numSamples, int64_t *count) {
   // the logic of counting the number of samples is copied from ParseMnistData() and uses CheckReader()
   std::shared_ptr<MnistOp> op;
@@ -20,6 +20,7 @@
 #include <string>
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <utility>
@@ -147,6 +148,17 @@ class MnistOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // Base-class override. The position of the source is the position of its sampler.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
   // Method derived from RandomAccess Op, enable Sampler to get numRows
   // @param int64_t num - to return numRows
   // @return Status - The error code return
@@ -162,11 +174,21 @@ class MnistOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status GetClassIds(std::map<int32_t, std::vector<int64_t>> *cls_ids) const override;
 
+  // Method derived from RandomAccess Op, loads one row by its id without a tree
+  // @param int64_t row_id - the id of the row in the dataset
+  // @param TensorRow *row - image & label read into this tensor row
+  // @return Status - The error code return
+  Status GetRow(int64_t row_id, TensorRow *row) override;
+
   // A print method typically used for debugging
   // @param out
   // @param show_all
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "MnistOp"; }
+
   // Function to count the number of samples in the MNIST dataset
   // @param dir path to the MNSIT directory
   // @param numSamples maximum number of samples requested
@@ -235,6 +257,10 @@ class MnistOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status WalkAllFiles();
 
+  // Walk and parse the files once, for the tree or for GetRow, whichever comes first
+  // @return Status - The error code return
+  Status LoadIndex();
+
   // Called first when function is called
   // @return Status - The error code return
   Status LaunchThreadsAndInitOp();
@@ -253,10 +279,12 @@ class MnistOp : public ParallelOp, public RandomAccessOp {
   std::shared_ptr<Sampler> sampler_;
   std::unique_ptr<DataSchema> data_schema_;
   std::vector<MnistLabelPair> image_label_pairs_;
-  std::unordered_map<std::string, int32_t> col_name_map_;
+  std::shared_ptr<const ColumnNameMap> col_name_map_;
   std::vector<std::string> image_names_;
   std::vector<std::string> label_names_;
   QueueList<std::unique_ptr<IOBlock>> io_block_queues_;
+  std::mutex index_mux_;  // guards the parsing of the files
+  bool index_ready_;      // the files are parsed
 };
 }  // namespace dataset
 }  // namespace mindspore
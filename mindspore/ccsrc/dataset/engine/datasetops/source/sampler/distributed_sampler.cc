@@ -26,7 +26,10 @@ namespace dataset {
 DistributedSampler::DistributedSampler(int64_t num_dev, int64_t dev_id, bool shuffle, uint32_t seed)
     : Sampler(),
       cnt_(0),
-      seed_(seed == std::numeric_limits<uint32_t>::max() ? GetSeed() : seed),
+      start_seed_(seed == std::numeric_limits<uint32_t>::max() ? GetSeed() : seed),
+      start_pass_(0),
+      start_cnt_(0),
+      seed_(start_seed_),
       device_id_(dev_id),
       num_devices_(num_dev),
       shuffle_(shuffle) {}
@@ -35,16 +38,30 @@ Status DistributedSampler::Init(const RandomAccessOp *op) {
   RETURN_IF_NOT_OK(Sampler::Init(op));
   CHECK_FAIL_RETURN_UNEXPECTED(device_id_ < num_devices_ && device_id_ >= 0 && num_rows_ > 0 && num_samples_ > 0,
                                "fail to init DistributedSampler");
-  rnd_.seed(seed_++);
   samples_per_buffer_ = (num_rows_ + num_devices_ - 1) / num_devices_;  // equals to ceil(num_rows/num_devices)
   samples_per_buffer_ = num_samples_ < samples_per_buffer_ ? num_samples_ : samples_per_buffer_;
   if (shuffle_ == true) {
-    shuffle_vec_.reserve(num_rows_);
-    for (int64_t i = 0; i < num_rows_; i++) {
-      shuffle_vec_.push_back(i);
-    }
-    std::shuffle(shuffle_vec_.begin(), shuffle_vec_.end(), rnd_);
+    // Every device computes the same permutation from the same seed, and takes its own share of it
+    shuffle_vec_ = IndexPermutation(num_rows_, seed_);
   }
+  seed_++;
+  CHECK_FAIL_RETURN_UNEXPECTED(start_cnt_ <= samples_per_buffer_, "The saved position is out of the samples");
+  cnt_ = start_cnt_;
+  return Status::OK();
+}
+
+Status DistributedSampler::SaveState(const Position &pos, nlohmann::json *state) const {
+  (*state)["seed"] = static_cast<uint32_t>(start_seed_ + (pos.pass - start_pass_));
+  (*state)["pass"] = pos.pass;
+  (*state)["cnt"] = pos.rows;
+  return Status::OK();
+}
+
+Status DistributedSampler::LoadState(const nlohmann::json &state) {
+  start_seed_ = state["seed"].get<uint32_t>();
+  start_pass_ = state["pass"].get<int64_t>();
+  start_cnt_ = state["cnt"].get<int64_t>();
+  seed_ = start_seed_;
   return Status::OK();
 }
 
@@ -60,7 +77,7 @@ Status DistributedSampler::GetNextBuffer(std::unique_ptr<DataBuffer> *out_buffer
     int64_t *id_ptr = reinterpret_cast<int64_t *>(sample_ids->StartAddr());
     while (cnt_ < samples_per_buffer_) {
       int64_t next_id = (num_devices_ * (cnt_++) + device_id_) % num_rows_;
-      *(id_ptr++) = shuffle_ ? shuffle_vec_[static_cast<size_t>(next_id)] : next_id;
+      *(id_ptr++) = shuffle_ ? shuffle_vec_[next_id] : next_id;
     }
     TensorRow row(1, sample_ids);
     (*out_buffer)->set_tensor_table(make_unique<TensorQTable>(1, row));
@@ -71,10 +88,11 @@ Status DistributedSampler::GetNextBuffer(std::unique_ptr<DataBuffer> *out_buffer
 Status DistributedSampler::Reset() {
   CHECK_FAIL_RETURN_UNEXPECTED(cnt_ == samples_per_buffer_, "ERROR Reset() called early/late");
   cnt_ = 0;
-  rnd_.seed(seed_++);
+  start_cnt_ = 0;
   if (shuffle_ == true) {
-    std::shuffle(shuffle_vec_.begin(), shuffle_vec_.end(), rnd_);
+    shuffle_vec_ = IndexPermutation(num_rows_, seed_);
   }
+  seed_++;
   return Status::OK();
 }
 }  // namespace dataset
@@ -18,9 +18,8 @@
 
 #include <limits>
 #include <memory>
-#include <random>
-#include <vector>
 
+#include "dataset/engine/datasetops/source/sampler/index_permutation.h"
 #include "dataset/engine/datasetops/source/sampler/sampler.h"
 
 namespace mindspore {
@@ -50,14 +49,24 @@ class DistributedSampler : public Sampler {
   // @return - The error code return
   Status Reset() override;
 
+  // Base-class override. Each pass shuffles with the seed of the first pass plus the number of the pass.
+  // @return - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @return - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
  private:
   int64_t cnt_;  // number of samples that have already been filled in to buffer
+  uint32_t start_seed_;  // The seed of the first pass
+  int64_t start_pass_;   // The number of the first pass, not 0 after a resume
+  int64_t start_cnt_;    // The samples of the first pass which were taken before a resume
   uint32_t seed_;
   int64_t device_id_;
   int64_t num_devices_;
   bool shuffle_;
-  std::mt19937 rnd_;
-  std::vector<int64_t> shuffle_vec_;
+  IndexPermutation shuffle_vec_;  // computed per id instead of stored
 };
 }  // namespace dataset
 }  // namespace mindspore
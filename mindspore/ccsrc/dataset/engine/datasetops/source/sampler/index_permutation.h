@@ -0,0 +1,88 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_INDEX_PERMUTATION_H_
+#define DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_INDEX_PERMUTATION_H_
+
+#include <cstdint>
+
+#include "dataset/util/philox.h"
+
+namespace mindspore {
+namespace dataset {
+// A random permutation of [0, n) which is computed one index at a time instead of being stored, so a sampler
+// streams the ids of an epoch in O(1) memory whatever the number of rows.
+// The permutation is a balanced Feistel network over the smallest even number of bits which covers n, that
+// is a bijection of [0, 4^k). The values from n on are walked through the network again until they fall in
+// [0, n), which keeps it a bijection of [0, n). The domain is less than 4n, so a walk is short on average.
+class IndexPermutation {
+ public:
+  // @param n - The number of indices
+  // @param seed - The seed of the permutation
+  // @param epoch - Which permutation of the seed, a sampler gives a new one to each epoch
+  IndexPermutation(int64_t n = 0, uint32_t seed = 0, uint32_t epoch = 0) : n_(n), half_bits_(1) {
+    while (n_ > (int64_t{1} << (2 * half_bits_))) {
+      ++half_bits_;
+    }
+    half_mask_ = (uint64_t{1} << half_bits_) - 1;
+    Philox rnd((static_cast<uint64_t>(epoch) << 32) | seed, 0);
+    for (int i = 0; i < kRounds; ++i) {
+      keys_[i] = (static_cast<uint64_t>(rnd()) << 32) | rnd();
+    }
+  }
+
+  // @return The number of indices
+  int64_t size() const { return n_; }
+
+  // @param i - A position in [0, n)
+  // @return The index at that position
+  int64_t operator[](int64_t i) const {
+    uint64_t x = static_cast<uint64_t>(i);
+    do {
+      x = Encrypt(x);
+    } while (x >= static_cast<uint64_t>(n_));
+    return static_cast<int64_t>(x);
+  }
+
+ private:
+  static constexpr int kRounds = 4;
+
+  uint64_t Encrypt(uint64_t x) const {
+    uint64_t left = x >> half_bits_;
+    uint64_t right = x & half_mask_;
+    for (int i = 0; i < kRounds; ++i) {
+      uint64_t next = left ^ (Mix(right ^ keys_[i]) & half_mask_);
+      left = right;
+      right = next;
+    }
+    return (left << half_bits_) | right;
+  }
+
+  // The finalizer of splitmix64, every bit of the output depends on every bit of the input
+  static uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  int64_t n_;
+  int half_bits_;
+  uint64_t half_mask_;
+  uint64_t keys_[kRounds];
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_INDEX_PERMUTATION_H_
@@ -22,7 +22,10 @@ namespace mindspore {
 namespace dataset {
 RandomSampler::RandomSampler(bool replacement, int64_t num_samples, int64_t samples_per_buffer)
     : Sampler(samples_per_buffer),
-      seed_(GetSeed()),
+      start_seed_(GetSeed()),
+      start_pass_(0),
+      start_id_(0),
+      seed_(start_seed_),
       replacement_(replacement),
       user_num_samples_(num_samples),
       next_id_(0),
@@ -40,7 +43,7 @@ Status RandomSampler::GetNextBuffer(std::unique_ptr<DataBuffer> *out_buffer) {
     RETURN_IF_NOT_OK(CreateSamplerTensor(&sampleIds, last_id - next_id_));
     int64_t *id_ptr = reinterpret_cast<int64_t *>(sampleIds->StartAddr());
     for (int64_t i = 0; i < (last_id - next_id_); i++) {
-      *(id_ptr + i) = replacement_ ? (*dist)(rnd_) : shuffled_ids_[static_cast<size_t>(i + next_id_)];
+      *(id_ptr + i) = replacement_ ? (*dist)(rnd_) : shuffled_ids_[i + next_id_];
     }
     next_id_ = last_id;
     TensorRow row(1, sampleIds);
@@ -55,25 +58,45 @@ Status RandomSampler::Init(const RandomAccessOp *op) {
   CHECK_FAIL_RETURN_UNEXPECTED(num_samples_ > 0 && num_rows_ > 0, "Fail to init RandomSampler");
   samples_per_buffer_ = samples_per_buffer_ > num_samples_ ? num_samples_ : samples_per_buffer_;
   if (replacement_ == false) {
-    shuffled_ids_.reserve(num_rows_);
-    for (int64_t i = 0; i < num_rows_; i++) {
-      shuffled_ids_.push_back(i);
-    }
-    std::shuffle(shuffled_ids_.begin(), shuffled_ids_.end(), rnd_);
+    shuffled_ids_ = IndexPermutation(num_rows_, seed_);
   } else {
     dist = make_unique<std::uniform_int_distribution<int64_t>>(0, num_rows_ - 1);
   }
   rnd_.seed(seed_++);
+  CHECK_FAIL_RETURN_UNEXPECTED(start_id_ <= num_samples_, "The saved position is out of the samples");
+  next_id_ = start_id_;
+  if (replacement_) {
+    // The ids with replacement are drawn one after the other, the generator replays the skipped draws
+    for (int64_t i = 0; i < start_id_; i++) {
+      (void)(*dist)(rnd_);
+    }
+  }
+  return Status::OK();
+}
+
+Status RandomSampler::SaveState(const Position &pos, nlohmann::json *state) const {
+  (*state)["seed"] = static_cast<uint32_t>(start_seed_ + (pos.pass - start_pass_));
+  (*state)["pass"] = pos.pass;
+  (*state)["next_id"] = pos.rows;
+  return Status::OK();
+}
+
+Status RandomSampler::LoadState(const nlohmann::json &state) {
+  start_seed_ = state["seed"].get<uint32_t>();
+  start_pass_ = state["pass"].get<int64_t>();
+  start_id_ = state["next_id"].get<int64_t>();
+  seed_ = start_seed_;
   return Status::OK();
 }
 
 Status RandomSampler::Reset() {
   CHECK_FAIL_RETURN_UNEXPECTED(next_id_ == num_samples_, "ERROR Reset() called early/late");
   next_id_ = 0;
-  rnd_.seed(seed_++);
+  start_id_ = 0;
   if (replacement_ == false) {
-    std::shuffle(shuffled_ids_.begin(), shuffled_ids_.end(), rnd_);
+    shuffled_ids_ = IndexPermutation(num_rows_, seed_);
   }
+  rnd_.seed(seed_++);
   return Status::OK();
 }
 }  // namespace dataset
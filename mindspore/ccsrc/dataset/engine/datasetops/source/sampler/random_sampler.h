@@ -20,6 +20,7 @@
 #include <memory>
 #include <vector>
 
+#include "dataset/engine/datasetops/source/sampler/index_permutation.h"
 #include "dataset/engine/datasetops/source/sampler/sampler.h"
 
 namespace mindspore {
@@ -51,11 +52,22 @@ class RandomSampler : public Sampler {
   // @return - The error code return
   Status Reset() override;
 
+  // Base-class override. Each pass draws from the seed of the first pass plus the number of the pass.
+  // @return - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @return - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
  private:
+  uint32_t start_seed_;  // The seed of the first pass
+  int64_t start_pass_;   // The number of the first pass, not 0 after a resume
+  int64_t start_id_;     // The first id of the first pass
   uint32_t seed_;
   bool replacement_;
   int64_t user_num_samples_;
-  std::vector<int64_t> shuffled_ids_;  // only used for NO REPLACEMENT
+  IndexPermutation shuffled_ids_;  // only used for NO REPLACEMENT, computed per id instead of stored
   int64_t next_id_;
   std::mt19937 rnd_;
   std::unique_ptr<std::uniform_int_distribution<int64_t>> dist;
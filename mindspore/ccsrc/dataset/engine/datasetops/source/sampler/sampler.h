@@ -60,6 +60,17 @@ class RandomAccessOp {
     RETURN_STATUS_UNEXPECTED("GetClassIds needs to be override to support PK");
   }
 
+  // Loads one row by its id, without launching the op in a tree. The ids follow the order of the rows in the
+  // dataset, the sampler is not applied. The index of the dataset is built by the first call.
+  // @param int64_t row_id - the id of the row, from 0 to the number of rows in the dataset
+  // @param TensorRow *row - the loaded row
+  // @return - The error code return
+  virtual Status GetRow(int64_t row_id, TensorRow *row) {
+    // CI complains row not used if the following line is not added
+    CHECK_FAIL_RETURN_UNEXPECTED(row != nullptr, "row == nullptr");
+    RETURN_STATUS_UNEXPECTED("function GetRow needs to be overridden to support random access");
+  }
+
   // default destructor
   virtual ~RandomAccessOp() = default;
 };
@@ -110,6 +121,21 @@ class Sampler : public DatasetOp {
   // @return
   Status CreateSamplerTensor(std::shared_ptr<Tensor> *sample_ids, int64_t num_elements);
 
+  // Base-class override. A sampler is not in the tree, its source keeps the state of the sampler in its own.
+  // @param pos - The pass of the source and the ids it took from the pass
+  // @param state - The object of the sampler in the state of its source
+  // @return - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override {
+    RETURN_STATUS_UNEXPECTED("This sampler does not support saving the state of the pipeline.");
+  }
+
+  // Base-class override. Called before Init, which moves the sampler to the saved position.
+  // @param state - The object of the sampler in the state of its source
+  // @return - The error code return
+  Status LoadState(const nlohmann::json &state) override {
+    RETURN_STATUS_UNEXPECTED("This sampler does not support restoring the state of the pipeline.");
+  }
+
  protected:
   int64_t num_rows_;
   int64_t num_samples_;
@@ -19,7 +19,7 @@
 
 namespace mindspore {
 namespace dataset {
-SequentialSampler::SequentialSampler(int64_t samples_per_buffer) : Sampler(samples_per_buffer), next_id_(0) {}
+SequentialSampler::SequentialSampler(int64_t samples_per_buffer) : Sampler(samples_per_buffer), next_id_(0), start_id_(0) {}
 
 Status SequentialSampler::GetNextBuffer(std::unique_ptr<DataBuffer> *out_buffer) {
   if (next_id_ > num_samples_) {
@@ -46,6 +46,18 @@ Status SequentialSampler::Init(const RandomAccessOp *op) {
   RETURN_IF_NOT_OK(op->GetNumSamples(&num_samples_));
   CHECK_FAIL_RETURN_UNEXPECTED(num_samples_ > 0 && samples_per_buffer_ > 0, "Fail to init Sequential Sampler");
   samples_per_buffer_ = samples_per_buffer_ > num_samples_ ? num_samples_ : samples_per_buffer_;
+  CHECK_FAIL_RETURN_UNEXPECTED(start_id_ <= num_samples_, "The saved position is out of the samples");
+  next_id_ = start_id_;
+  return Status::OK();
+}
+
+Status SequentialSampler::SaveState(const Position &pos, nlohmann::json *state) const {
+  (*state)["next_id"] = pos.rows;
+  return Status::OK();
+}
+
+Status SequentialSampler::LoadState(const nlohmann::json &state) {
+  start_id_ = state["next_id"].get<int64_t>();
   return Status::OK();
 }
 
@@ -47,8 +47,17 @@ class SequentialSampler : public Sampler {
   // @return - The error code return
   Status GetNextBuffer(std::unique_ptr<DataBuffer> *out_buffer) override;
 
+  // Base-class override. The ids are the same in every pass.
+  // @return - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @return - The error code return
+  Status LoadState(const nlohmann::json &state) override;
+
  private:
   int64_t next_id_;
+  int64_t start_id_;  // The first id of the first pass, set by a resume
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -17,7 +17,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <queue>
 #include <random>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -26,6 +28,9 @@
 
 namespace mindspore {
 namespace dataset {
+// The fewest weights per thread for which the alias tables are built by several threads
+constexpr int64_t kAliasRowsPerThread = 1 << 20;
+
 //  Constructor.
 WeightedRandomSampler::WeightedRandomSampler(const std::vector<double> &weights, int64_t num_samples, bool replacement,
                                              int64_t samples_per_buffer)
@@ -49,9 +54,76 @@ Status WeightedRandomSampler::Init(const RandomAccessOp *op) {
     exp_dist_ = mindspore::make_unique<std::exponential_distribution<>>(1);
     InitOnePassSampling();
   } else {
-    discrete_dist_ = mindspore::make_unique<std::discrete_distribution<int64_t>>(weights_.begin(), weights_.end());
+    RETURN_IF_NOT_OK(InitAliasTables());
+  }
+
+  return Status::OK();
+}
+
+// Builds the alias tables with the method of Vose, "A linear algorithm for generating random numbers with a given
+// distribution". The scaling of the weights is split between threads for the large tables, the pairing of the
+// small and large columns is a single linear pass.
+Status WeightedRandomSampler::InitAliasTables() {
+  const int64_t n = static_cast<int64_t>(weights_.size());
+  CHECK_FAIL_RETURN_UNEXPECTED(n > 0, "Fail to init WeightedRandomSampler, no weights");
+  double total = 0;
+  for (double w : weights_) {
+    CHECK_FAIL_RETURN_UNEXPECTED(w >= 0, "Fail to init WeightedRandomSampler, negative weight");
+    total += w;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(total > 0, "Fail to init WeightedRandomSampler, all weights are zero");
+
+  // Scale the weights so that their mean is 1
+  alias_prob_.resize(n);
+  alias_.assign(n, 0);
+  const double scale = static_cast<double>(n) / total;
+  auto scale_range = [this, scale](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      alias_prob_[i] = weights_[i] * scale;
+    }
+  };
+  int64_t num_threads = std::min<int64_t>(std::thread::hardware_concurrency(), n / kAliasRowsPerThread);
+  if (num_threads > 1) {
+    std::vector<std::thread> threads;
+    int64_t chunk = (n + num_threads - 1) / num_threads;
+    for (int64_t begin = chunk; begin < n; begin += chunk) {
+      threads.emplace_back(scale_range, begin, std::min(n, begin + chunk));
+    }
+    scale_range(0, chunk);
+    for (auto &t : threads) {
+      t.join();
+    }
+  } else {
+    scale_range(0, n);
   }
 
+  // Each small column is filled up by a large one, which gives it away as its alias
+  std::vector<int64_t> small;
+  std::vector<int64_t> large;
+  for (int64_t i = 0; i < n; i++) {
+    (alias_prob_[i] < 1.0 ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    int64_t s = small.back();
+    int64_t l = large.back();
+    small.pop_back();
+    alias_[s] = l;
+    alias_prob_[l] -= 1.0 - alias_prob_[s];
+    if (alias_prob_[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // What is left is 1 up to the rounding errors
+  for (int64_t i : large) {
+    alias_prob_[i] = 1.0;
+  }
+  for (int64_t i : small) {
+    alias_prob_[i] = 1.0;
+  }
+
+  column_dist_ = mindspore::make_unique<std::uniform_int_distribution<int64_t>>(0, n - 1);
+  coin_dist_ = mindspore::make_unique<std::uniform_real_distribution<double>>(0.0, 1.0);
   return Status::OK();
 }
 
@@ -59,15 +131,22 @@ Status WeightedRandomSampler::Init(const RandomAccessOp *op) {
 void WeightedRandomSampler::InitOnePassSampling() {
   exp_dist_->reset();
   onepass_ids_.clear();
-  std::vector<std::pair<double, int64_t>> val_idx;
+  // Keep the `numSamples` smallest keys in a max heap, so the memory is O(numSamples) instead of O(numRows).
+  std::priority_queue<std::pair<double, int64_t>> val_idx;
   for (size_t i = 0; i < weights_.size(); i++) {
-    val_idx.emplace_back(std::make_pair((*exp_dist_)(rand_gen_) / weights_[i], i));
+    std::pair<double, int64_t> key((*exp_dist_)(rand_gen_) / weights_[i], i);
+    if (val_idx.size() < static_cast<size_t>(num_samples_)) {
+      val_idx.push(key);
+    } else if (key < val_idx.top()) {
+      val_idx.pop();
+      val_idx.push(key);
+    }
   }
 
-  // Partial sort the first `numSamples` elements.
-  std::partial_sort(val_idx.begin(), val_idx.begin() + num_samples_, val_idx.end());
-  for (int64_t i = 0; i < num_samples_; i++) {
-    onepass_ids_.push_back(val_idx[i].second);
+  // The heap gives the largest key first, the ids are drawn from the smallest.
+  while (!val_idx.empty()) {
+    onepass_ids_.push_front(val_idx.top().second);
+    val_idx.pop();
   }
 }
 
@@ -79,7 +158,8 @@ Status WeightedRandomSampler::Reset() {
   if (!replacement_) {
     InitOnePassSampling();
   } else {
-    discrete_dist_->reset();
+    column_dist_->reset();
+    coin_dist_->reset();
   }
   return Status::OK();
 }
@@ -116,7 +196,8 @@ Status WeightedRandomSampler::GetNextBuffer(std::unique_ptr<DataBuffer> *out_buf
     while (sample_id_ < last_id) {
       int64_t genId;
       if (replacement_) {
-        genId = (*discrete_dist_)(rand_gen_);
+        int64_t column = (*column_dist_)(rand_gen_);
+        genId = (*coin_dist_)(rand_gen_) < alias_prob_[column] ? column : alias_[column];
       } else {
         // Draw sample without replacement.
         genId = onepass_ids_.front();
@@ -19,6 +19,7 @@
 #include <deque>
 #include <limits>
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "dataset/engine/datasetops/source/sampler/sampler.h"
@@ -69,8 +70,18 @@ class WeightedRandomSampler : public Sampler {
   // Random engine and device
   std::mt19937 rand_gen_;
 
-  // Discrete distribution for generating weighted random numbers with replacement.
-  std::unique_ptr<std::discrete_distribution<int64_t>> discrete_dist_;
+  // Walker's alias tables for generating weighted random numbers with replacement in O(1) per draw.
+  // Id i is kept with probability alias_prob_[i], or else replaced by alias_[i].
+  std::vector<double> alias_prob_;
+  std::vector<int64_t> alias_;
+
+  // Picks the column of the alias tables and the coin of a draw.
+  std::unique_ptr<std::uniform_int_distribution<int64_t>> column_dist_;
+  std::unique_ptr<std::uniform_real_distribution<double>> coin_dist_;
+
+  // Builds the alias tables of the weights, once per sampler since the weights do not change.
+  // @return Status - The error code return
+  Status InitAliasTables();
 
   // Exponential distribution for generating weighted random numbers without replacement.
   // based on "Accelerating weighted random sampling without replacement" by Kirill Muller.
@@ -23,7 +23,9 @@
 #include <chrono>
 #include <cstdint>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -136,6 +138,8 @@ StorageOp::StorageOp(int32_t num_workers, int32_t worker_connector_size, int32_t
                      int32_t op_connector_size, std::vector<std::string> columns_to_load,
                      std::string data_distribution_file, int32_t batch_size, bool drop_remainder)
     : ParallelOp(num_workers, op_connector_size),
+      actions_posted_(0),
+      action_window_(0),
       worker_conn_size_(worker_connector_size),
       rows_per_buffer_(rows_per_buffer),
       num_rows_(0),
@@ -162,7 +166,7 @@ Status StorageOp::InitOp(const std::string &dataset_files_dir, const std::string
   dataset_usage_ = dataset_usage;
 
   // Storage ops require the internal master/worker connector.  create it here
-  RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_conn_size_));
+  RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_conn_size_, false));
 
   // Get parameter for distribution.
   RETURN_IF_NOT_OK(LoadParallelConfig());
@@ -194,7 +198,7 @@ Status StorageOp::InitOp(int32_t num_rows, const std::string &dataset_files_dir,
   dataset_usage_ = dataset_usage;
 
   // Storage ops require the internal master/worker connector.  create it here
-  RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_conn_size_));
+  RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_conn_size_, false));
 
   // Get parameter for distribution.
   RETURN_IF_NOT_OK(LoadParallelConfig());
@@ -221,7 +225,7 @@ Status StorageOp::InitOp(const std::vector<std::string> &files_list, const std::
   schema_file_ = schema_file;
 
   // Storage ops require the internal master/worker connector.  create it here
-  RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_conn_size_));
+  RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_conn_size_, false));
 
   // Get parameter for distribution.
   RETURN_IF_NOT_OK(LoadParallelConfig());
@@ -289,23 +293,17 @@ Status StorageOp::init() {
     data_buffers_.push_back(std::move(new_data_buffer));
   }
 
-  // Instantiate the action queues.  If this was a re-entrant call then these already exist.
-  // We cannot drop and recreate them because there are threads waiting on them currently.
-  // They should be empty anyway in a reset codepath
-  if (action_queue_.empty()) {
-    // The max size of these queues should ensure they will never get full and they support
-    // precisely the amount of data that we know they will hold (the total number of buffers).
-    // There needs to be one queue for each worker, to support the Connector design for how
-    // data will be fetched and pushed into a Connector in parallel.
-    //
-    // Say the total buffers is 5, and we have 2 workers.
-    // To support this, we'd need 1 queue of size 2 and the other of size 3.
-    // For simplicity, we'll make both of them 3 so they are the same size.
-    int32_t action_queue_size = (buffers_needed / num_workers_) + 1;
-    for (int32_t i = 0; i < num_workers_; ++i) {
-      auto new_queue = mindspore::make_unique<Queue<int32_t>>(action_queue_size);
-      action_queue_.push_back(std::move(new_queue));
-    }
+  // Instantiate the action queue.  If this was a re-entrant call then it already exists.
+  // We cannot drop and recreate it because there are threads waiting on it currently.
+  // It should be empty anyway in a reset codepath
+  if (action_queue_ == nullptr) {
+    // All the workers take their next buffer id from this one queue, so a worker that is done with
+    // a cheap buffer moves on while another one is still waiting on a slow read.  The master only
+    // posts a window of ids ahead of the buffer it sends up next: each worker may be loading one
+    // buffer, reading the next one, and have its worker connector queue full.  The queue also has
+    // room for the end-of-data message of every worker.
+    action_window_ = num_workers_ * (worker_conn_size_ + 2);
+    action_queue_ = mindspore::make_unique<ActionQueue>(action_window_ + num_workers_);
   }
 
   // Extract the list of buffer id's from the vector and use this as our starting action
@@ -354,7 +352,16 @@ Status StorageOp::PostEndOfData() {
 
   // For each worker we add the message so that they can all get the memo
   for (int32_t i = 0; i < num_workers_; ++i) {
-    RETURN_IF_NOT_OK(action_queue_[i]->Add(kEndOfActions));
+    RETURN_IF_NOT_OK(action_queue_->Add(kEndOfActions));
+  }
+  return Status::OK();
+}
+
+// Private helper method.  This one posts the next buffer id of the action order, if there is one left.
+Status StorageOp::PostNextAction() {
+  if (actions_posted_ < static_cast<int32_t>(action_order_.size())) {
+    RETURN_IF_NOT_OK(action_queue_->Add(action_order_[actions_posted_]));
+    actions_posted_++;
   }
   return Status::OK();
 }
@@ -363,46 +370,25 @@ Status StorageOp::PostEndOfData() {
 Status StorageOp::FillActionQueue(bool randomize) {
   // We only support adding the new list of id's to the queue if we are sure the old list
   // of actions is already done.  This might change in the future though
-  for (int32_t i = 0; i < num_workers_; ++i) {
-    if (!(action_queue_[i]->empty())) {
-      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
-                    "Attempt to get buffer id's into a queue, but the queue not empty!");
-    }
+  if (!action_queue_->empty()) {
+    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                  "Attempt to get buffer id's into a queue, but the queue not empty!");
   }
-  if (!data_buffers_.empty()) {
-    // Add buffer id's to the queue. Buffer id's in our vector are just numbers from 0 up, so
-    // basically just a list of consecutive numbers starting from 0 (incremented by 1).
-    // If randomize is requested, the list of id's will be jumbled up (so not consecutive
-    // order)
-    if (!randomize) {
-      // Round robin of filling each worker with the buffer id's
-      int32_t curr_worker = 0;
-      for (int32_t i = 0; i < data_buffers_.size(); ++i) {
-        RETURN_IF_NOT_OK(action_queue_[curr_worker]->Add(i));
-        curr_worker++;
-        if (curr_worker == num_workers_) {
-          curr_worker = 0;
-        }
-      }
-    } else {
-      std::vector<int32_t> random_ids;
-      int32_t i;
-      for (i = 0; i < data_buffers_.size(); ++i) {
-        random_ids.push_back(i);
-      }
-      uint32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
-      std::shuffle(random_ids.begin(), random_ids.end(), std::default_random_engine(seed));
-
-      // Round robin of filling each worker with the buffer id's from randomized list
-      int32_t curr_worker = 0;
-      for (i = 0; i < random_ids.size(); ++i) {
-        RETURN_IF_NOT_OK(action_queue_[curr_worker]->Add(random_ids[i]));
-        curr_worker++;
-        if (curr_worker == num_workers_) {
-          curr_worker = 0;
-        }
-      }
-    }
+  // Buffer id's in our vector are just numbers from 0 up, so basically just a list of consecutive
+  // numbers starting from 0 (incremented by 1).  If randomize is requested, the list of id's will be
+  // jumbled up (so not consecutive order).  The master sends the buffers up in this order, whichever
+  // worker loads them.
+  action_order_.resize(data_buffers_.size());
+  for (int32_t i = 0; i < action_order_.size(); ++i) {
+    action_order_[i] = i;
+  }
+  if (randomize) {
+    uint32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+    std::shuffle(action_order_.begin(), action_order_.end(), std::default_random_engine(seed));
+  }
+  actions_posted_ = 0;
+  for (int32_t i = 0; i < action_window_; ++i) {
+    RETURN_IF_NOT_OK(PostNextAction());
   }
   return Status::OK();
 }
@@ -435,6 +421,18 @@ Status StorageOp::GetBuffer(int32_t buffer_id, std::unique_ptr<DataBuffer> *ptr)
   return Status::OK();
 }
 
+// Reads the raw data of a buffer ahead of its load.  This is run asynchronously by the worker that
+// will load the buffer, while it loads the buffer before it.
+Status StorageOp::FetchBuffer(int32_t buffer_id) {
+  if (static_cast<size_t>(buffer_id) >= data_buffers_.size() || data_buffers_[buffer_id] == nullptr) {
+    std::ostringstream ss;
+    ss << "Error.  Buffer id " << buffer_id << " is out of range.";
+    std::string err_msg = ss.str();
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return data_buffers_[buffer_id]->Fetch();
+}
+
 // Class functor operator () override.
 // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
 // provide the master loop that drives the logic for performing the work
@@ -444,37 +442,49 @@ Status StorageOp::operator()() {
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(num_workers_, std::bind(&StorageOp::WorkerEntry, this, std::placeholders::_1)));
   // Handshake with TaskManager to synchronize thread creation
   TaskManager::FindMe()->Post();
-  int32_t num_buffers_to_fetch = data_buffers_.size();
 
   // The storage op is the bottom node in the tree, so it does not listen to an input
   // queue from an operator below us. Instead, we'll will read from the internal queue
   // that our workers produce into, and then push that into output queue.
+  // The workers finish the buffers in any order, so the ones that come ahead of their turn are
+  // held here until the buffers before them in the action order are sent up.
   bool done = false;
-  std::unique_ptr<DataBuffer> fetched_buffer;
+  std::map<int32_t, std::unique_ptr<DataBuffer>> loaded_buffers;
   while (!done) {
-    // Get the next buffer. We are single thread master so thread id hard coded to 0
-    // on the connector pop.  Count this buffer towards our count, and then push
-    // it up to the output connector.
+    // Get the next buffer from whichever worker loaded it. We are single thread master so thread id
+    // hard coded to 0 on the connector pop.  The action order is only read after a buffer is popped,
+    // since after an end of epoch a reset from the repeat op refills it.
+    std::unique_ptr<DataBuffer> fetched_buffer;
     RETURN_IF_NOT_OK(worker_connector_->PopWithRetry(0, &fetched_buffer));
-    buffers_fetched_++;
-    int32_t buffer_id = fetched_buffer->id();
-
-    if (buffers_fetched_ == 1) {
-      num_buffers_to_fetch = static_cast<int32_t>(data_buffers_.size());
-    }
-
-    // There should be 2 holders of this buffer currently. We have one in the mDataBuffers
-    // table, and then ourselves right now with fetchedBuffer.
-    // Reduce the shared_ptr ref count of this buffer by removing it from the mDataBuffers
-    // table first before we push the buffer to output connector.
-    data_buffers_[buffer_id].reset();
-    MS_LOG(INFO) << "StorageOp master: Consumed buffer " << buffer_id << " from internal worker connector.";
-    RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(fetched_buffer)));
-    MS_LOG(INFO) << "StorageOp master: pushed buffer " << buffer_id << " to output connector.";
-
-    // Now, check our loop exit conditions and perform appropriate end of data handling if
-    // we've reached the end of our scan.
-    if (buffers_fetched_ == num_buffers_to_fetch) {
+    int32_t loaded_id = fetched_buffer->id();
+    MS_LOG(INFO) << "StorageOp master: Consumed buffer " << loaded_id << " from internal worker connector.";
+    loaded_buffers[loaded_id] = std::move(fetched_buffer);
+
+    // Send up all the buffers that are now next in the action order.
+    auto next = loaded_buffers.find(action_order_[buffers_fetched_]);
+    while (!done && next != loaded_buffers.end()) {
+      int32_t buffer_id = next->first;
+      fetched_buffer = std::move(next->second);
+      (void)loaded_buffers.erase(next);
+      buffers_fetched_++;
+
+      // There should be 2 holders of this buffer currently. We have one in the mDataBuffers
+      // table, and then ourselves right now with fetchedBuffer.
+      // Reduce the shared_ptr ref count of this buffer by removing it from the mDataBuffers
+      // table first before we push the buffer to output connector.
+      data_buffers_[buffer_id].reset();
+      RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(fetched_buffer)));
+      MS_LOG(INFO) << "StorageOp master: pushed buffer " << buffer_id << " to output connector.";
+
+      // One more buffer id may go to the workers now that the window moved on.
+      RETURN_IF_NOT_OK(PostNextAction());
+
+      // Now, check our loop exit conditions and perform appropriate end of data handling if
+      // we've reached the end of our scan.
+      if (buffers_fetched_ < static_cast<int32_t>(action_order_.size())) {
+        next = loaded_buffers.find(action_order_[buffers_fetched_]);
+        continue;
+      }
       MS_LOG(INFO) << "StorageOp master: Reached end of data.";
 
       // If we are not inside of a Repeat path in the tree, or we are in a repeat path but
@@ -499,17 +509,10 @@ Status StorageOp::operator()() {
         std::unique_ptr<DataBuffer> eoe_buffer = mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE);
         RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(eoe_buffer)));
 
-        // reset our buffer count and go to loop again.
+        // reset our buffer count and go to loop again.  Every buffer of the epoch was sent up, so
+        // there is none held back.
         buffers_fetched_ = 0;
-
-        // This is a bit of a cheat.  Only the repeat op should perform resetting actions
-        // against us (currently).  However, if we go to block/wait on the worker_connector_
-        // right now before the reset is done (driven from the repeat op), then we end
-        // up using stale connector index info and blocking on the wrong thing, causing
-        // invalid order during the next epoch.
-        // For now then, do a quick reset of just the connector queue so that we block
-        // at a safe starting point in the connector.
-        worker_connector_->Reset();
+        break;
       }
     }
   }
@@ -524,22 +527,42 @@ Status StorageOp::WorkerEntry(int32_t worker_id) {
   // Handshake with TaskManager to synchronize the creation
   TaskManager::FindMe()->Post();
 
-  // While there is still some actions to perform
-  RETURN_IF_NOT_OK(action_queue_[worker_id]->PopFront(&next_action_id));
+  // While there is still some actions to perform.  The read of a buffer runs in the background
+  // while the buffer taken before it is parsed.
+  RETURN_IF_NOT_OK(action_queue_->PopFront(&next_action_id));
+  std::future<Status> fetch;
+  if (next_action_id != kEndOfActions) {
+    fetch = std::async(std::launch::async, &StorageOp::FetchBuffer, this, next_action_id);
+  }
   while (next_action_id != kEndOfActions) {
+    int32_t action_id = next_action_id;
+    RETURN_IF_NOT_OK(fetch.get());
+
+    // Start reading the buffer after this one if there is already one waiting.  Never wait for it
+    // here: the master may be waiting for the buffer this worker holds before it posts more ids.
+    bool prefetched = action_queue_->TryPopFront(&next_action_id);
+    if (prefetched && next_action_id != kEndOfActions) {
+      fetch = std::async(std::launch::async, &StorageOp::FetchBuffer, this, next_action_id);
+    }
+
     // Drive a load of this buffer and get a pointer to the buffer after it's loaded in
     std::unique_ptr<DataBuffer> dB;
-    RETURN_IF_NOT_OK(this->GetBuffer(next_action_id, &dB));
-    MS_LOG(INFO) << "Worker: Loaded buffer " << next_action_id << ".";
+    RETURN_IF_NOT_OK(this->GetBuffer(action_id, &dB));
+    MS_LOG(INFO) << "Worker: Loaded buffer " << action_id << ".";
 
     // Add the buffer to the internal queue for master to consume from later.
     // This could end up blocking if the queue is full in which case it waits here
     // until the master can drain a buffer off the queue.
     RETURN_IF_NOT_OK(worker_connector_->Add(worker_id, std::move(dB)));
-    MS_LOG(INFO) << "Worker: Pushed buffer " << next_action_id << " to internal worker connector.";
+    MS_LOG(INFO) << "Worker: Pushed buffer " << action_id << " to internal worker connector.";
 
     // Get the next action id and loop
-    RETURN_IF_NOT_OK(action_queue_[worker_id]->PopFront(&next_action_id));
+    if (!prefetched) {
+      RETURN_IF_NOT_OK(action_queue_->PopFront(&next_action_id));
+      if (next_action_id != kEndOfActions) {
+        fetch = std::async(std::launch::async, &StorageOp::FetchBuffer, this, next_action_id);
+      }
+    }
   }
   MS_LOG(INFO) << "Worker: Received end-of-data message.  Worker complete.";
   return Status::OK();
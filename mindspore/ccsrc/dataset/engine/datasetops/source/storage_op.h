@@ -39,8 +39,8 @@ class Queue;
 // A type for a container of DataBuffer shared_ptr's
 using DataBuffers = std::vector<std::unique_ptr<DataBuffer>>;
 
-// A type for the queue of buffer id's for workers to fetch.
-using ActionQueue = std::vector<std::unique_ptr<Queue<int32_t>>>;
+// A type for the queue of buffer id's for workers to fetch. All the workers take their next id from the same queue.
+using ActionQueue = Queue<int32_t>;
 
 // Forward declare
 class DataBuffer;
@@ -246,6 +246,10 @@ class StorageOp : public ParallelOp {
   // @param show_all - A bool to control if you want to show all info or just a summary
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "StorageOp"; }
+
   // << Stream output operator overload
   // @notes This allows you to write the debug print info using stream operators
   // @param out - reference to the output stream being overloaded
@@ -276,6 +280,12 @@ class StorageOp : public ParallelOp {
   // @return Status - The error code return
   Status GetBuffer(int32_t buffer_id, std::unique_ptr<DataBuffer> *ptr);
 
+  // Reads the raw data of a buffer ahead of its load, so the read overlaps with the load of the
+  // buffer before it. This is run asynchronously by the worker that will load the buffer.
+  // @param buffer_id - The buffer id to fetch.
+  // @return Status - The error code return
+  Status FetchBuffer(int32_t buffer_id);
+
   // Overrides base class reset method.  When an operator does a reset, it cleans up any state
   // info from it's previous execution and then initializes itself so that it can be executed
   // again.
@@ -347,6 +357,12 @@ class StorageOp : public ParallelOp {
   // @param randomize - T/F if the id's in the action queue should be randomized or sequential.
   Status FillActionQueue(bool randomize);
 
+  // Private helper method.  This one adds the next buffer id of the action order to the action queue,
+  // if there is one left.  The master keeps a window of buffer ids ahead of the one it sends up next,
+  // so the buffers it holds back to restore the order are bounded by the window.
+  // @return Status - The error code return
+  Status PostNextAction();
+
   // Private helper method.  This one encapsulates some common construction/reset tasks and is
   // designed to be re-entrant so that you can re-init a previously used StorageOp without needing
   // to redo the storage client handshake.
@@ -362,7 +378,10 @@ class StorageOp : public ParallelOp {
 
   DataBuffers data_buffers_;                     // A vector of pointers to buffers
   std::shared_ptr<StorageClient> store_client_;  // The client for interacting with storage
-  ActionQueue action_queue_;                     // The queues of buffer id's for workers to fetch.
+  std::unique_ptr<ActionQueue> action_queue_;    // The queue of buffer id's for workers to fetch.
+  std::vector<int32_t> action_order_;            // The buffer id's in the order the master sends them up.
+  int32_t actions_posted_;                       // The number of buffer id's of action_order_ already posted.
+  int32_t action_window_;                        // The number of buffer id's posted ahead of the master.
   int32_t worker_conn_size_;                     // connector size for internal worker queue
   int32_t rows_per_buffer_;                      // The number of requested rows per buffer.
   int32_t num_rows_;                             // One more than the last row id in the range for this cache
@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/utils.h"
 #include "utils/log_adapter.h"
@@ -36,12 +37,14 @@ TFBuffer::TFBuffer(
   uint32_t id,                                           // In: The id for this buffer
   BufferFlags flags,                                     // In: The flags for this buffer
   const std::shared_ptr<StorageClient> &storage_client)  // In: Storage client that is related to this buffer type
-    : DataBuffer(id, flags), storage_client_(storage_client) {
+    : DataBuffer(id, flags), fetched_(false), storage_client_(storage_client) {
   // Initializing mColumnNameMap from the schema file
   const DataSchema *the_schema = storage_client_->schema();
+  ColumnNameMap column_name_map;
   for (int32_t i = 0; i < the_schema->NumColumns(); ++i) {
-    column_name_map_[the_schema->column(i).name()] = i;
+    column_name_map[the_schema->column(i).name()] = i;
   }
+  set_column_name_map(std::make_shared<const ColumnNameMap>(std::move(column_name_map)));
 }
 
 // destructor
@@ -57,12 +60,10 @@ void TFBuffer::Print(std::ostream &out,      // In: The output stream to print t
   DataBuffer::Print(out, show_all);
 }
 
-// Name: load()
-// Description: populates the DataBuffer with data
+// Name: fetch()
+// Description: reads the serialized records of the buffer from the files, without parsing them.
 //              Overrides base-class method.
-Status TFBuffer::Load() {
-  const DataSchema *the_schema = storage_client_->schema();
-  uint32_t num_columns = the_schema->NumColumns();
+Status TFBuffer::Fetch() {
   uint32_t num_rows_requested = storage_client_->rows_per_buffer();
   uint32_t remaining_rows = storage_client_->num_rows() > buffer_id_ * storage_client_->rows_per_buffer()
                               ? storage_client_->num_rows() - buffer_id_ * storage_client_->rows_per_buffer()
@@ -71,17 +72,41 @@ Status TFBuffer::Load() {
     num_rows_requested = remaining_rows;
   }
 
+  records_.clear();
+  while (records_.size() < num_rows_requested &&
+         (cur_reader_.peek() != EOF || storage_client_->IsMoreData(buffer_id_))) {
+    std::string record;
+    RETURN_IF_NOT_OK(ReadRecord(&record));
+    records_.push_back(std::move(record));
+  }
+  cur_reader_.close();
+  fetched_ = true;
+  return Status::OK();
+}
+
+// Name: load()
+// Description: populates the DataBuffer with data
+//              Overrides base-class method.
+Status TFBuffer::Load() {
+  if (!fetched_) {
+    RETURN_IF_NOT_OK(Fetch());
+  }
+  const DataSchema *the_schema = storage_client_->schema();
+  uint32_t num_columns = the_schema->NumColumns();
+
   // Construct the Tensor table for this buffer.
   tensor_table_ = mindspore::make_unique<TensorQTable>();
 
   // At each position in the tensor table, instantiate the shared pointer to it's Tensor.
-  uint32_t row = 0;
-  while (row < num_rows_requested && (cur_reader_.peek() != EOF || storage_client_->IsMoreData(buffer_id_))) {
+  for (const auto &record : records_) {
     TensorRow new_row;
 
-    // Read the data from storage into a tf_file format
+    // Parse the data read from storage into a tf_file format
     dataengine::Example tf_file;
-    RETURN_IF_NOT_OK(ParseSingleExample(&tf_file));
+    if (!tf_file.ParseFromString(record)) {
+      std::string err_msg = "parse tf_file failed";
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
     for (uint32_t col = 0; col < num_columns; ++col) {
       std::shared_ptr<Tensor> new_t;
       const ColDescriptor current_col = the_schema->column(col);
@@ -97,17 +122,17 @@ Status TFBuffer::Load() {
 
     // Add the new row of tensors to the end of our tensor table
     tensor_table_->push_back(new_row);
-    row++;
   }
-  cur_reader_.close();
+  std::vector<std::string>().swap(records_);
+  fetched_ = false;
   return Status::OK();
 }
 
-// Name: ParseSingleExample()
+// Name: ReadRecord()
 // Description: Drives the calls to TFClient for fetching the tf_file info from
-//              the tf_file files.  Returns a single row of data from the tf_file
+//              the tf_file files.  Returns a single serialized row of data from the tf_file
 //              files.
-Status TFBuffer::ParseSingleExample(dataengine::Example *ptr) {
+Status TFBuffer::ReadRecord(std::string *record) {
   if (cur_reader_.peek() == EOF) {
     auto client = std::dynamic_pointer_cast<TFClient>(storage_client_);
     if (client == nullptr) {
@@ -130,10 +155,9 @@ Status TFBuffer::ParseSingleExample(dataengine::Example *ptr) {
   //  uint32    masked crc of data
   // read length
   if (cur_reader_.peek() == EOF) {
-    MS_LOG(ERROR) << "ParseSingleExample failed";
+    MS_LOG(ERROR) << "ReadRecord failed";
   }
 
-  dataengine::Example tf_file;
   try {
     uint64_t record_length = 0;
     (void)cur_reader_.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(uint64_t)));
@@ -142,22 +166,15 @@ Status TFBuffer::ParseSingleExample(dataengine::Example *ptr) {
     (void)cur_reader_.ignore(static_cast<std::streamsize>(sizeof(uint32_t)));
 
     // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(record_length);
-    (void)cur_reader_.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
+    record->resize(record_length);
+    (void)cur_reader_.read(&(*record)[0], static_cast<std::streamsize>(record_length));
 
     // ignore crc footer
     (void)cur_reader_.ignore(static_cast<std::streamsize>(sizeof(uint32_t)));
-
-    if (!tf_file.ParseFromString(serialized_example)) {
-      std::string err_msg = "parse tf_file failed";
-      RETURN_STATUS_UNEXPECTED(err_msg);
-    }
   } catch (const std::exception &err) {
     std::string err_msg = "Please check if the data file is complete!";
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
-  *ptr = tf_file;
   return Status::OK();
 }
 
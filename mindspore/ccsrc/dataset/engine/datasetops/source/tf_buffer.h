@@ -54,17 +54,24 @@ class TFBuffer : public DataBuffer {
   //              Overrides base-class method.
   Status Load() override;
 
+  // Name: fetch()
+  // Description: reads the serialized records of the buffer from the files, without parsing them.
+  //              Overrides base-class method.
+  Status Fetch() override;
+
  private:
   std::ifstream cur_reader_;
   FileInfo cur_f_info_;
+  std::vector<std::string> records_;  // The serialized examples read by the fetch and not yet parsed.
+  bool fetched_;
 
   std::shared_ptr<StorageClient> storage_client_;  // The storage client for populating the buffer initially.
 
-  // Name: ParseSingleExample()
+  // Name: ReadRecord()
   // Description: Drives the calls to TFClient for fetching the tf_file info from
-  //              the tf_file files.  Returns a single row of data from the tf_file
+  //              the tf_file files.  Returns a single serialized row of data from the tf_file
   //              files.
-  Status ParseSingleExample(dataengine::Example *ptr);
+  Status ReadRecord(std::string *record);
 
   // Name: LoadFeature()
   // Description: Given the column type of the tf record and the values list,
@@ -15,9 +15,14 @@
  */
 #include "dataset/engine/datasetops/source/tf_reader_op.h"
 
+#include <unistd.h>
+#include <algorithm>
 #include <cmath>
 #include <condition_variable>
+#include <cstdio>
+#include <fstream>
 #include <future>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -46,8 +51,156 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// Serves the chunks read ahead for a worker as the stream buffer of the file being parsed.
+class ReadaheadStreamBuf : public std::streambuf {
+ public:
+  explicit ReadaheadStreamBuf(Queue<std::unique_ptr<ReadaheadChunk>> *queue) : queue_(queue), done_(false) {}
+
+  // @return Status - the error of the read or of the queue, if any
+  const Status &rc() const { return rc_; }
+
+ protected:
+  int_type underflow() override {
+    while (gptr() == egptr()) {
+      if (done_) {
+        return traits_type::eof();
+      }
+      Status rc = queue_->PopFront(&chunk_);
+      if (rc.IsError() || chunk_->rc.IsError()) {
+        rc_ = rc.IsError() ? rc : chunk_->rc;
+        done_ = true;
+        return traits_type::eof();
+      }
+      done_ = chunk_->last;
+      char *p = &chunk_->data[0];
+      setg(p, p, p + chunk_->data.size());
+    }
+    return traits_type::to_int_type(*gptr());
+  }
+
+ private:
+  Queue<std::unique_ptr<ReadaheadChunk>> *queue_;
+  std::unique_ptr<ReadaheadChunk> chunk_;  // The chunk being parsed
+  bool done_;                              // T/F if the last chunk of the file was popped
+  Status rc_;
+};
+
+// The first line of the index of a tf_file file
+const char kTFIndexFileMagic[] = "MindDataTFRecordIndex 1";
+
+// Protobuf wire types
+constexpr uint32_t kWireVarint = 0;
+constexpr uint32_t kWireFixed64 = 1;
+constexpr uint32_t kWireLengthDelimited = 2;
+constexpr uint32_t kWireFixed32 = 5;
+
+// A cursor over protobuf wire format bytes, to find fields without deserializing the message.
+class WireReader {
+ public:
+  WireReader(const unsigned char *start, int64_t len) : p_(start), end_(start + len) {}
+
+  bool Done() const { return p_ >= end_; }
+
+  // @return false if the bytes are malformed
+  bool ReadVarint(uint64_t *v) {
+    *v = 0;
+    for (int shift = 0; shift < 64 && p_ < end_; shift += 7) {
+      uint8_t b = *p_++;
+      *v |= static_cast<uint64_t>(b & 0x7f) << shift;
+      if ((b & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadTag(uint32_t *field, uint32_t *wire_type) {
+    uint64_t tag = 0;
+    if (!ReadVarint(&tag)) {
+      return false;
+    }
+    *field = static_cast<uint32_t>(tag >> 3);
+    *wire_type = static_cast<uint32_t>(tag & 0x7);
+    return true;
+  }
+
+  bool ReadLengthDelimited(const unsigned char **start, int64_t *len) {
+    uint64_t n = 0;
+    if (!ReadVarint(&n) || n > static_cast<uint64_t>(end_ - p_)) {
+      return false;
+    }
+    *start = p_;
+    *len = static_cast<int64_t>(n);
+    p_ += n;
+    return true;
+  }
+
+  // Skips the value of a field
+  bool Skip(uint32_t wire_type) {
+    uint64_t v = 0;
+    const unsigned char *start = nullptr;
+    int64_t len = 0;
+    switch (wire_type) {
+      case kWireVarint:
+        return ReadVarint(&v);
+      case kWireFixed64:
+        return Advance(sizeof(uint64_t));
+      case kWireLengthDelimited:
+        return ReadLengthDelimited(&start, &len);
+      case kWireFixed32:
+        return Advance(sizeof(uint32_t));
+      default:
+        return false;
+    }
+  }
+
+ private:
+  bool Advance(int64_t n) {
+    if (n > end_ - p_) {
+      return false;
+    }
+    p_ += n;
+    return true;
+  }
+
+  const unsigned char *p_;
+  const unsigned char *end_;
+};
+
+// The size each bytes value of a column is padded to
+// @param current_col - the column descriptor
+// @param max_size - the size of the largest value of the cell
+// @param pad_size - the padded size
+// @return Status - the error code returned.
+Status BytesPadSize(const ColDescriptor &current_col, int64_t max_size, int64_t *pad_size) {
+  *pad_size = max_size;
+  // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
+  if (current_col.hasShape()) {
+    TensorShape cur_shape = current_col.shape();
+    if (cur_shape.Size() >= 2 && cur_shape[0] == TensorShape::kDimUnknown) {
+      int64_t new_pad_size = 1;
+      for (int i = 1; i < cur_shape.Size(); ++i) {
+        if (cur_shape[i] == TensorShape::kDimUnknown) {
+          std::string err_msg = "More than one unknown dimension in the shape of column: " + current_col.name();
+          RETURN_STATUS_UNEXPECTED(err_msg);
+        }
+        new_pad_size *= cur_shape[i];
+      }
+      *pad_size = new_pad_size;
+    }
+  }
+  return Status::OK();
+}
+}  // namespace
+
 TFReaderOp::Builder::Builder()
-    : builder_device_id_(0), builder_num_devices_(1), builder_total_rows_(0), builder_equal_rows_per_shard_(false) {
+    : builder_device_id_(0),
+      builder_num_devices_(1),
+      builder_total_rows_(0),
+      builder_equal_rows_per_shard_(false),
+      builder_readahead_chunks_(0),
+      builder_write_index_files_(false) {
   std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
   builder_num_workers_ = config_manager->num_parallel_workers();
   builder_worker_connector_size_ = config_manager->worker_connector_size();
@@ -66,14 +219,19 @@ Status TFReaderOp::Builder::ValidateInputs() const {
                  : "";
   }
   err_msg += builder_device_id_ >= builder_num_devices_ || builder_num_devices_ < 1 ? "Wrong sharding configs\n" : "";
+  err_msg += builder_readahead_chunks_ < 0 ? "Number of readahead chunks is smaller than 0\n" : "";
   return err_msg.empty() ? Status::OK() : Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, err_msg);
 }
 
 Status TFReaderOp::Builder::Build(std::shared_ptr<TFReaderOp> *out_tf_reader_op) {
   RETURN_IF_NOT_OK(ValidateInputs());
 
-  // Throttle the number of workers if we have more workers than files!
-  if (static_cast<size_t>(builder_num_workers_) > builder_dataset_files_list_.size()) {
+  // Throttle the number of workers if we have more workers than files! The records of the indexed files are
+  // split across the workers, they all have some.
+  bool indexed = builder_write_index_files_ ||
+                 std::all_of(builder_dataset_files_list_.begin(), builder_dataset_files_list_.end(),
+                             [](const std::string &file) { return Path(file + kTFIndexFileSuffix).Exists(); });
+  if (!indexed && static_cast<size_t>(builder_num_workers_) > builder_dataset_files_list_.size()) {
     builder_num_workers_ = builder_dataset_files_list_.size();
     MS_LOG(WARNING) << "TFReader operator parallelism reduced to " << builder_num_workers_ << " workers.";
   }
@@ -81,7 +239,8 @@ Status TFReaderOp::Builder::Build(std::shared_ptr<TFReaderOp> *out_tf_reader_op)
   std::shared_ptr<TFReaderOp> new_tf_reader_op = std::make_shared<TFReaderOp>(
     builder_num_workers_, builder_worker_connector_size_, builder_rows_per_buffer_, builder_total_rows_,
     builder_dataset_files_list_, std::move(builder_data_schema_), builder_op_connector_size_, builder_columns_to_load_,
-    builder_shuffle_files_, builder_num_devices_, builder_device_id_, builder_equal_rows_per_shard_);
+    builder_shuffle_files_, builder_num_devices_, builder_device_id_, builder_equal_rows_per_shard_,
+    builder_readahead_chunks_, builder_write_index_files_);
 
   RETURN_IF_NOT_OK(new_tf_reader_op->Init());
   *out_tf_reader_op = std::move(new_tf_reader_op);
@@ -92,7 +251,8 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
                        int64_t total_num_rows, std::vector<std::string> dataset_files_list,
                        std::unique_ptr<DataSchema> data_schema, int32_t op_connector_size,
                        std::vector<std::string> columns_to_load, bool shuffle_files, int32_t num_device,
-                       int32_t device_id, bool equal_rows_per_shard)
+                       int32_t device_id, bool equal_rows_per_shard, int32_t readahead_chunks,
+                       bool write_index_files)
     : ParallelOp(num_workers, op_connector_size),
       device_id_(device_id),
       num_devices_(num_device),
@@ -105,9 +265,14 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       data_schema_(std::move(data_schema)),
       filename_index_(make_unique<StringIndex>()),
       load_io_block_queue_(true),
+      readahead_chunks_(readahead_chunks),
       num_rows_(0),
       num_rows_per_shard_(0),
-      equal_rows_per_shard_(equal_rows_per_shard) {
+      equal_rows_per_shard_(equal_rows_per_shard),
+      start_pass_(0),
+      skip_rows_(0),
+      write_index_files_(write_index_files),
+      pieces_per_file_(1) {
   worker_connector_size_ = worker_connector_size;
 }
 
@@ -123,6 +288,14 @@ Status TFReaderOp::Init() {
   // Build the index with our files such that each file corresponds to a key id.
   RETURN_IF_NOT_OK(filename_index_->insert(dataset_files_list_));
 
+  RETURN_IF_NOT_OK(LoadIndexFiles());
+  int64_t num_files = static_cast<int64_t>(dataset_files_list_.size());
+  if (!filename_offsets_.empty()) {
+    int64_t files_per_device = (num_files + num_devices_ - 1) / num_devices_;
+    files_per_device = std::max<int64_t>(1, files_per_device);
+    pieces_per_file_ = static_cast<int32_t>(std::max<int64_t>(1, num_workers_ / files_per_device));
+  }
+
   // The creation of the internal connector has been delayed until now, since we may have adjusted the
   // number of workers.  Now that the worker count is established, create the connector now in the
   // parallel op base.
@@ -131,8 +304,13 @@ Status TFReaderOp::Init() {
   jagged_buffer_connector_ = mindspore::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_);
 
   // temporary: make size large enough to hold all files + EOE to avoid hangs
-  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(dataset_files_list_.size() / num_workers_)) + 1;
+  int64_t num_blocks = num_files * pieces_per_file_;
+  int32_t safe_queue_size = static_cast<int32_t>((num_blocks + num_workers_ - 1) / num_workers_) + 1;
   io_block_queues_.Init(num_workers_, safe_queue_size);
+  if (readahead_chunks_ > 0) {
+    // One more for the io block which comes before the chunks of each file
+    readahead_queues_.Init(num_workers_, readahead_chunks_ + 1);
+  }
   dataset_files_list_.clear();  // no longer need the original list of files
 
   return Status::OK();
@@ -145,7 +323,9 @@ Status TFReaderOp::CalculateNumRowsPerShard() {
 
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
     std::vector<std::string> file(1, it.value());
-    int64_t num = CountTotalRowsSectioned(file, 0, 1);
+    const std::vector<int64_t> *offsets = FileOffsets(it.value());
+    int64_t num =
+      (offsets != nullptr) ? static_cast<int64_t>(offsets->size()) - 1 : CountTotalRowsSectioned(file, 0, 1);
     filename_numrows_[it.value()] = num;
     num_rows_ += num;
   }
@@ -164,6 +344,14 @@ Status TFReaderOp::operator()() {
   // launch one thread, responsible for filling mIOBlockQueue
   RETURN_IF_NOT_OK(tree_->LaunchWorkers(1, std::bind(&TFReaderOp::WaitToFillIOBlockQueue, this)));
 
+  // launch num_workers_ readahead threads, responsible for reading the files of the IOBlockQueue
+  // ahead of the workers
+  if (readahead_chunks_ > 0) {
+    RETURN_IF_NOT_OK(readahead_queues_.Register(tree_->AllTasks()));
+    RETURN_IF_NOT_OK(
+      tree_->LaunchWorkers(num_workers_, std::bind(&TFReaderOp::ReadaheadEntry, this, std::placeholders::_1)));
+  }
+
   // launch num_workers_ worker threads, responsible for pulling from the IOBlockQueue and reading
   // data from disk into buffers
   RETURN_IF_NOT_OK(
@@ -199,6 +387,15 @@ Status TFReaderOp::operator()() {
         }
 
         rows_read += fetched_buffer->NumRows();
+        // Drop the rows which were consumed before a resume
+        while (skip_rows_ > 0 && fetched_buffer->NumRows() > 0) {
+          TensorRow skipped_row;
+          RETURN_IF_NOT_OK(fetched_buffer->PopRow(&skipped_row));
+          skip_rows_--;
+        }
+        if (fetched_buffer->NumRows() == 0) {
+          continue;
+        }
         fetched_buffer->set_id(buffer_id);
         buffer_id++;
         RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(fetched_buffer)));
@@ -241,7 +438,7 @@ Status TFReaderOp::WorkerEntry(int32_t worker_id) {
   TaskManager::FindMe()->Post();
 
   std::unique_ptr<FilenameBlock> io_block;
-  RETURN_IF_NOT_OK(PopIoBlockQueue(worker_id, &io_block));
+  RETURN_IF_NOT_OK(NextIoBlock(worker_id, &io_block));
 
   while (!io_block->eof()) {
     if (!io_block->eoe()) {
@@ -256,9 +453,90 @@ Status TFReaderOp::WorkerEntry(int32_t worker_id) {
       RETURN_IF_NOT_OK(jagged_buffer_connector_->Add(worker_id, std::move(eoe_buffer)));
     }
 
+    RETURN_IF_NOT_OK(NextIoBlock(worker_id, &io_block));
+  }
+
+  return Status::OK();
+}
+
+Status TFReaderOp::NextIoBlock(int32_t worker_id, std::unique_ptr<FilenameBlock> *out_block) {
+  if (readahead_chunks_ == 0) {
+    return PopIoBlockQueue(worker_id, out_block);
+  }
+  std::unique_ptr<ReadaheadChunk> chunk;
+  RETURN_IF_NOT_OK(readahead_queues_[worker_id]->PopFront(&chunk));
+  if (chunk->io_block == nullptr) {
+    RETURN_STATUS_UNEXPECTED("TFReader readahead queue out of order.");
+  }
+  *out_block = std::move(chunk->io_block);
+  return Status::OK();
+}
+
+// The entry point of the readahead threads.
+Status TFReaderOp::ReadaheadEntry(int32_t worker_id) {
+  // must be called first if called by worker spawned by taskgroup
+  TaskManager::FindMe()->Post();
+
+  std::unique_ptr<FilenameBlock> io_block;
+  RETURN_IF_NOT_OK(PopIoBlockQueue(worker_id, &io_block));
+  while (true) {
+    bool eof = io_block->eof();
+    std::string filename;
+    int64_t begin = 0;
+    int64_t end = -1;
+    if (!eof && !io_block->eoe()) {
+      RETURN_IF_NOT_OK(io_block->GetFilename(&filename, *filename_index_));
+      // Only the records of the block are read from an indexed file
+      const std::vector<int64_t> *offsets = FileOffsets(filename);
+      if (offsets != nullptr && io_block->GetStartOffset() != kInvalidOffset) {
+        int64_t last = static_cast<int64_t>(offsets->size()) - 1;
+        begin = (*offsets)[std::min(io_block->GetStartOffset(), last)];
+        end = (*offsets)[std::min(io_block->GetEndOffset(), last)];
+      }
+    }
+    auto head = mindspore::make_unique<ReadaheadChunk>();
+    head->io_block = std::move(io_block);
+    RETURN_IF_NOT_OK(readahead_queues_[worker_id]->Add(std::move(head)));
+    if (eof) {
+      break;
+    }
+    if (!filename.empty()) {
+      RETURN_IF_NOT_OK(ReadAhead(filename, begin, end, worker_id));
+    }
     RETURN_IF_NOT_OK(PopIoBlockQueue(worker_id, &io_block));
   }
+  return Status::OK();
+}
 
+// Reads the bytes [begin, end) of a tf_file file in chunks into the readahead queue of a worker.
+Status TFReaderOp::ReadAhead(const std::string &filename, int64_t begin, int64_t end, int32_t worker_id) {
+  std::ifstream reader(filename, std::ios::in | std::ios::binary);
+  if (begin > 0) {
+    (void)reader.seekg(static_cast<std::streamoff>(begin));
+  }
+  int64_t remaining = (end < 0) ? std::numeric_limits<int64_t>::max() : end - begin;
+  bool last = false;
+  while (!last) {
+    auto chunk = mindspore::make_unique<ReadaheadChunk>();
+    if (!reader.is_open()) {
+      chunk->rc = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "failed to open file: " + filename);
+      last = true;
+    } else {
+      int64_t size = std::min(kTFReadaheadChunkSize, remaining);
+      chunk->data.resize(static_cast<size_t>(size));
+      if (size > 0) {
+        (void)reader.read(&chunk->data[0], static_cast<std::streamsize>(size));
+        chunk->data.resize(static_cast<size_t>(reader.gcount()));
+      }
+      if (reader.bad()) {
+        chunk->rc = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "failed to read file: " + filename);
+      }
+      remaining -= static_cast<int64_t>(chunk->data.size());
+      last = !reader.good() || remaining <= 0;
+    }
+    chunk->last = last;
+    RETURN_IF_NOT_OK(readahead_queues_[worker_id]->Add(std::move(chunk)));
+  }
   return Status::OK();
 }
 
@@ -319,6 +597,31 @@ bool TFReaderOp::NeedPushFileToblockQueue(const std::string &file_name, int64_t
   return push;
 }
 
+Status TFReaderOp::PushFileBlocks(int64_t key, const std::string &file_name, int64_t start_offset,
+                                  int64_t end_offset, int32_t *queue_index) {
+  const std::vector<int64_t> *offsets = FileOffsets(file_name);
+  if (offsets == nullptr || pieces_per_file_ == 1) {
+    auto ioBlock = make_unique<FilenameBlock>(key, start_offset, end_offset, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(ioBlock)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+    return Status::OK();
+  }
+  if (start_offset == kInvalidOffset) {
+    start_offset = 0;
+    end_offset = static_cast<int64_t>(offsets->size()) - 1;
+  }
+  // A block holds at least a full buffer
+  int64_t piece_rows = (end_offset - start_offset + pieces_per_file_ - 1) / pieces_per_file_;
+  piece_rows = std::max(rows_per_buffer_, piece_rows);
+  for (int64_t begin = start_offset; begin < end_offset; begin += piece_rows) {
+    auto ioBlock = make_unique<FilenameBlock>(key, begin, std::min(begin + piece_rows, end_offset),
+                                              IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(ioBlock)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+  }
+  return Status::OK();
+}
+
 Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
   int32_t queue_index = 0;
   int32_t key_index = 0;
@@ -336,19 +639,16 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock = make_unique<FilenameBlock>(*it, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          auto file_it = filename_index_->Search(*it);
+          RETURN_IF_NOT_OK(PushFileBlocks(*it, file_it.value(), kInvalidOffset, kInvalidOffset, &queue_index));
         }
       } else {
         // Do an index lookup using that key to get the filename.
         auto file_it = filename_index_->Search(*it);
         std::string file_name = file_it.value();
         if (NeedPushFileToblockQueue(file_name, &start_offset, &end_offset, pre_count)) {
-          auto ioBlock = make_unique<FilenameBlock>(*it, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
+          RETURN_IF_NOT_OK(PushFileBlocks(*it, file_name, start_offset, end_offset, &queue_index));
           MS_LOG(DEBUG) << "File name " << *it << " start offset " << start_offset << " end_offset " << end_offset;
-          queue_index = (queue_index + 1) % num_workers_;
         }
 
         pre_count += filename_numrows_[file_name];
@@ -382,16 +682,12 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock = make_unique<FilenameBlock>(it.key(), kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFileBlocks(it.key(), it.value(), kInvalidOffset, kInvalidOffset, &queue_index));
         }
       } else {
         std::string file_name = it.value();
         if (NeedPushFileToblockQueue(file_name, &start_offset, &end_offset, pre_count)) {
-          auto ioBlock = make_unique<FilenameBlock>(it.key(), start_offset, end_offset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFileBlocks(it.key(), file_name, start_offset, end_offset, &queue_index));
         }
 
         pre_count += filename_numrows_[file_name];
@@ -421,6 +717,12 @@ Status TFReaderOp::WaitToFillIOBlockQueue() {
     }
   }
   uint32_t seed = 0;
+  // The keys are shuffled again in each pass, a resume replays the shuffles of the passes before it
+  if (shuffle_files_) {
+    for (int64_t i = 0; i < start_pass_; i++) {
+      shuffleKeys(&i_keys, num_devices_ == 1 ? GetSeed() : ++seed);
+    }
+  }
   while (true) {
     RETURN_IF_NOT_OK(io_block_queue_wait_post_.Wait());
     io_block_queue_wait_post_.Clear();
@@ -460,24 +762,44 @@ Status TFReaderOp::PushIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock
 // Reads a tf_file file and loads the data into multiple buffers.
 Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_offset, const int64_t end_offset,
                             const int32_t &worker_id) {
-  std::ifstream reader;
-  reader.open(filename);
-  if (!reader) {
-    RETURN_STATUS_UNEXPECTED("failed to open file: " + filename);
+  // With readahead, the bytes come from the chunks read by the readahead thread of this worker
+  ReadaheadStreamBuf readahead((readahead_chunks_ > 0) ? readahead_queues_[worker_id].get() : nullptr);
+  std::ifstream file_reader;
+  std::istream reader(&readahead);
+  // The rows of an indexed file start at the offset of the first record of the block, the readahead thread
+  // seeks there itself
+  const std::vector<int64_t> *offsets = FileOffsets(filename);
+  bool seek = offsets != nullptr && start_offset != kInvalidOffset;
+  if (readahead_chunks_ == 0) {
+    file_reader.open(filename);
+    if (!file_reader) {
+      RETURN_STATUS_UNEXPECTED("failed to open file: " + filename);
+    }
+    if (seek) {
+      int64_t last = static_cast<int64_t>(offsets->size()) - 1;
+      (void)file_reader.seekg(static_cast<std::streamoff>((*offsets)[std::min(start_offset, last)]));
+    }
+    (void)reader.rdbuf(file_reader.rdbuf());
   }
 
   int64_t rows_read = 0;
-  int64_t rows_total = 0;
+  int64_t rows_total = seek ? start_offset : 0;
   std::unique_ptr<DataBuffer> current_buffer =
     mindspore::make_unique<DataBuffer>(0, DataBuffer::BufferFlags::kDeBFlagNone);
-  std::unordered_map<std::string, int32_t> column_name_map;
+  // All the buffers of the file share one column name map
+  auto column_names = std::make_shared<ColumnNameMap>();
   for (int32_t i = 0; i < data_schema_->NumColumns(); ++i) {
-    column_name_map[data_schema_->column(i).name()] = i;
+    (*column_names)[data_schema_->column(i).name()] = i;
   }
+  std::shared_ptr<const ColumnNameMap> column_name_map = std::move(column_names);
   current_buffer->set_column_name_map(column_name_map);
   std::unique_ptr<TensorQTable> new_tensor_table = make_unique<TensorQTable>();
 
   while (reader.peek() != EOF) {
+    // the rows after the block are not read
+    if (start_offset != kInvalidOffset && rows_total >= end_offset) {
+      break;
+    }
     // read length
     int64_t record_length = 0;
     (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
@@ -485,18 +807,21 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
     // ignore crc header
     (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
 
-    // read serialized Example
-    std::string serialized_example;
-    serialized_example.resize(record_length);
-    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
+    // read serialized Example, the record tensor is the base of the cells which are views on it
     if (start_offset == kInvalidOffset || (rows_total >= start_offset && rows_total < end_offset)) {
-      dataengine::Example tf_file;
-      if (!tf_file.ParseFromString(serialized_example)) {
-        std::string errMsg = "parse tfrecord failed";
-        RETURN_STATUS_UNEXPECTED(errMsg);
+      std::shared_ptr<Tensor> record;
+      RETURN_IF_NOT_OK(Tensor::CreateTensor(&record, TensorImpl::kFlexible, TensorShape({record_length}),
+                                            DataType(DataType::DE_UINT8)));
+      if (record_length > 0) {
+        (void)reader.read(reinterpret_cast<char *>(record->StartAddr()), static_cast<std::streamsize>(record_length));
       }
-      RETURN_IF_NOT_OK(LoadExample(&tf_file, &new_tensor_table, rows_read));
+      RETURN_IF_NOT_OK(AcquireWorker());
+      Status rc = LoadExample(record, *column_name_map, &new_tensor_table, rows_read);
+      ReleaseWorker();
+      RETURN_IF_NOT_OK(rc);
       rows_read++;
+    } else {
+      (void)reader.ignore(static_cast<std::streamsize>(record_length));
     }
     // ignore crc footer
     (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
@@ -513,6 +838,12 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
     }
   }
 
+  // the chunks left of the file are popped, the next item of the readahead queue is the next io block
+  if (readahead_chunks_ > 0) {
+    (void)reader.ignore(std::numeric_limits<std::streamsize>::max());
+  }
+  RETURN_IF_NOT_OK(readahead.rc());
+
   if (rows_read > 0) {
     current_buffer->set_tensor_table(std::move(new_tensor_table));
     RETURN_IF_NOT_OK(jagged_buffer_connector_->Add(worker_id, std::move(current_buffer)));
@@ -522,23 +853,142 @@ Status TFReaderOp::LoadFile(const std::string &filename, const int64_t start_off
 }
 
 // Parses a single row and puts the data into a tensor table.
-Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, std::unique_ptr<TensorQTable> *tensor_table,
-                               int64_t row) {
+Status TFReaderOp::LoadExample(const std::shared_ptr<Tensor> &record,
+                               const std::unordered_map<std::string, int32_t> &column_name_map,
+                               std::unique_ptr<TensorQTable> *tensor_table, int64_t row) {
   int32_t num_columns = data_schema_->NumColumns();
   TensorRow newRow(num_columns, nullptr);
   (*tensor_table)->push_back(std::move(newRow));
 
+  // Example { Features features = 1; }, Features { map<string, Feature> feature = 1; } and each map entry
+  // is { string key = 1; Feature value = 2; }. Only the entries of the schema columns are kept.
+  std::vector<const unsigned char *> features(num_columns, nullptr);
+  std::vector<int64_t> feature_lens(num_columns, 0);
+  std::vector<bool> found(num_columns, false);
+  const std::string err_msg = "parse tfrecord failed";
+  WireReader example(record->StartAddr(), record->SizeInBytes());
+  uint32_t field = 0;
+  uint32_t wire_type = 0;
+  while (!example.Done()) {
+    if (!example.ReadTag(&field, &wire_type)) {
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
+    if (field != 1 || wire_type != kWireLengthDelimited) {
+      if (!example.Skip(wire_type)) {
+        RETURN_STATUS_UNEXPECTED(err_msg);
+      }
+      continue;
+    }
+    const unsigned char *features_start = nullptr;
+    int64_t features_len = 0;
+    if (!example.ReadLengthDelimited(&features_start, &features_len)) {
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
+    WireReader entries(features_start, features_len);
+    while (!entries.Done()) {
+      const unsigned char *entry_start = nullptr;
+      int64_t entry_len = 0;
+      if (!entries.ReadTag(&field, &wire_type)) {
+        RETURN_STATUS_UNEXPECTED(err_msg);
+      }
+      if (field != 1 || wire_type != kWireLengthDelimited) {
+        if (!entries.Skip(wire_type)) {
+          RETURN_STATUS_UNEXPECTED(err_msg);
+        }
+        continue;
+      }
+      if (!entries.ReadLengthDelimited(&entry_start, &entry_len)) {
+        RETURN_STATUS_UNEXPECTED(err_msg);
+      }
+      // Within an entry, the last occurrence of a field wins as with a full parse
+      WireReader entry(entry_start, entry_len);
+      const unsigned char *key = nullptr;
+      int64_t key_len = 0;
+      const unsigned char *value = nullptr;
+      int64_t value_len = 0;
+      while (!entry.Done()) {
+        if (!entry.ReadTag(&field, &wire_type)) {
+          RETURN_STATUS_UNEXPECTED(err_msg);
+        }
+        bool ok = false;
+        if (field == 1 && wire_type == kWireLengthDelimited) {
+          ok = entry.ReadLengthDelimited(&key, &key_len);
+        } else if (field == 2 && wire_type == kWireLengthDelimited) {
+          ok = entry.ReadLengthDelimited(&value, &value_len);
+        } else {
+          ok = entry.Skip(wire_type);
+        }
+        if (!ok) {
+          RETURN_STATUS_UNEXPECTED(err_msg);
+        }
+      }
+      if (key == nullptr) {
+        continue;
+      }
+      auto itr = column_name_map.find(std::string(reinterpret_cast<const char *>(key), key_len));
+      if (itr != column_name_map.end()) {
+        features[itr->second] = value;
+        feature_lens[itr->second] = value_len;
+        found[itr->second] = true;
+      }
+    }
+  }
+
   for (int32_t col = 0; col < num_columns; ++col) {
     const ColDescriptor current_col = data_schema_->column(col);
-    const dataengine::Features &example_features = tf_file->features();
-    const google::protobuf::Map<std::string, dataengine::Feature> &feature_map = example_features.feature();
-    const dataengine::Feature &column_values_list = feature_map.at(current_col.name());
-    RETURN_IF_NOT_OK(LoadFeature(tensor_table, column_values_list, current_col, row, col));
+    if (!found[col]) {
+      RETURN_STATUS_UNEXPECTED("Column " + current_col.name() + " is not in the tfrecord.");
+    }
+    RETURN_IF_NOT_OK(
+      LoadFeatureBytes(record, features[col], feature_lens[col], tensor_table, current_col, row, col));
   }
 
   return Status::OK();
 }
 
+// Parses the serialized Feature of a single cell and puts the data into a tensor table.
+Status TFReaderOp::LoadFeatureBytes(const std::shared_ptr<Tensor> &record, const unsigned char *feature,
+                                    int64_t feature_len, const std::unique_ptr<TensorQTable> *tensor_table,
+                                    const ColDescriptor &current_col, int64_t row, int32_t col) {
+  // Feature { oneof kind { BytesList bytes_list = 1; ... } } and BytesList { repeated bytes value = 1; }.
+  // A cell made of a single bytes value which needs no padding is a view on the record.
+  if (current_col.type() == DataType::DE_UINT8) {
+    WireReader kind(feature, feature_len);
+    uint32_t field = 0;
+    uint32_t wire_type = 0;
+    const unsigned char *list = nullptr;
+    int64_t list_len = 0;
+    if (kind.ReadTag(&field, &wire_type) && field == 1 && wire_type == kWireLengthDelimited &&
+        kind.ReadLengthDelimited(&list, &list_len) && kind.Done()) {
+      WireReader values(list, list_len);
+      const unsigned char *value = nullptr;
+      int64_t value_len = 0;
+      if (values.ReadTag(&field, &wire_type) && field == 1 && wire_type == kWireLengthDelimited &&
+          values.ReadLengthDelimited(&value, &value_len) && values.Done() && value_len > 0) {
+        int64_t pad_size = 0;
+        RETURN_IF_NOT_OK(BytesPadSize(current_col, value_len, &pad_size));
+        if (pad_size == value_len) {
+          TensorShape current_shape = TensorShape::CreateScalar();
+          RETURN_IF_NOT_OK(current_col.MaterializeTensorShape(value_len, &current_shape));
+          std::shared_ptr<Tensor> ts;
+          dsize_t offset = value - record->StartAddr();
+          RETURN_IF_NOT_OK(Tensor::CreateView(&ts, record, {offset}, current_shape));
+          (**tensor_table)[row][col] = std::move(ts);
+          return Status::OK();
+        }
+      }
+    }
+  }
+
+  // The other cells are deserialized, on their own
+  dataengine::Feature column_values_list;
+  if (!column_values_list.ParseFromArray(feature, static_cast<int>(feature_len))) {
+    std::string err_msg = "parse tfrecord failed";
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return LoadFeature(tensor_table, column_values_list, current_col, row, col);
+}
+
 // Parses a single cell and puts the data into a tensor table.
 Status TFReaderOp::LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table,
                                const dataengine::Feature &column_values_list, const ColDescriptor &current_col,
@@ -596,6 +1046,24 @@ Status TFReaderOp::LoadFeature(const std::unique_ptr<TensorQTable> *tensor_table
   return Status::OK();
 }
 
+Status TFReaderOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["pass"] = pos.pass;
+  (*op_state)["skip"] = pos.rows;
+  return Status::OK();
+}
+
+Status TFReaderOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  start_pass_ = (*op_state)["pass"].get<int64_t>();
+  skip_rows_ = (*op_state)["skip"].get<int64_t>();
+  return Status::OK();
+}
+
 // Overrides base class reset method. Cleans up any state info from it's previous execution and
 // reinitializes itself so that it can be executed again, as if it was just created.
 Status TFReaderOp::Reset() {
@@ -627,23 +1095,8 @@ Status TFReaderOp::LoadBytesList(const ColDescriptor &current_col, const dataeng
 
   *num_elements = bytes_list.value_size();
 
-  int64_t pad_size = max_size;
-
-  // if user provides a shape in the form of [-1, d1, 2d, ... , dn], we need to pad to d1 * d2 * ... * dn
-  if (current_col.hasShape()) {
-    TensorShape cur_shape = current_col.shape();
-    if (cur_shape.Size() >= 2 && cur_shape[0] == TensorShape::kDimUnknown) {
-      int64_t new_pad_size = 1;
-      for (int i = 1; i < cur_shape.Size(); ++i) {
-        if (cur_shape[i] == TensorShape::kDimUnknown) {
-          std::string err_msg = "More than one unknown dimension in the shape of column: " + current_col.name();
-          RETURN_STATUS_UNEXPECTED(err_msg);
-        }
-        new_pad_size *= cur_shape[i];
-      }
-      pad_size = new_pad_size;
-    }
-  }
+  int64_t pad_size = 0;
+  RETURN_IF_NOT_OK(BytesPadSize(current_col, static_cast<int64_t>(max_size), &pad_size));
 
   // know how many elements there are and the total bytes, create tensor here:
   TensorShape current_shape = TensorShape::CreateScalar();
@@ -900,6 +1353,11 @@ Status TFReaderOp::CountTotalRows(int64_t *out_total_rows, const std::vector<std
 int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &filenames, int64_t begin, int64_t end) {
   int64_t rows_read = 0;
   for (int i = begin; i < end; i++) {
+    std::vector<int64_t> offsets;
+    if (ReadIndexFile(filenames[i], &offsets)) {
+      rows_read += static_cast<int64_t>(offsets.size()) - 1;
+      continue;
+    }
     std::ifstream reader;
     reader.open(filenames[i]);
     if (!reader) {
@@ -926,5 +1384,116 @@ int64_t TFReaderOp::CountTotalRowsSectioned(const std::vector<std::string> &file
 
   return rows_read;
 }
+
+Status TFReaderOp::ScanRecordOffsets(const std::string &filename, std::vector<int64_t> *offsets) {
+  std::ifstream reader(filename, std::ios::in | std::ios::binary);
+  if (!reader.is_open()) {
+    RETURN_STATUS_UNEXPECTED("failed to open file: " + filename);
+  }
+  offsets->clear();
+  int64_t offset = 0;
+  while (reader.peek() != EOF) {
+    offsets->push_back(offset);
+    int64_t record_length = 0;
+    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+    // skip the crc header, the record and the crc footer
+    (void)reader.ignore(static_cast<std::streamsize>(record_length + 2 * sizeof(int32_t)));
+    if (!reader.good() && !reader.eof()) {
+      RETURN_STATUS_UNEXPECTED("failed to read file: " + filename);
+    }
+    offset += static_cast<int64_t>(sizeof(int64_t) + 2 * sizeof(int32_t)) + record_length;
+  }
+  reader.clear();
+  (void)reader.seekg(0, std::ios::end);
+  if (static_cast<int64_t>(reader.tellg()) != offset) {
+    RETURN_STATUS_UNEXPECTED("The last record of " + filename + " is truncated");
+  }
+  offsets->push_back(offset);
+  return Status::OK();
+}
+
+// The index of a tf_file file has:
+//   the magic line
+//   the time the file was modified, and its number of records
+//   the offset of each record, then the size of the file, one per line
+bool TFReaderOp::ReadIndexFile(const std::string &filename, std::vector<int64_t> *offsets) {
+  std::string index_file = filename + kTFIndexFileSuffix;
+  std::ifstream in(index_file);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::string line;
+  int64_t mtime = 0;
+  int64_t num_records = 0;
+  if (!std::getline(in, line) || line != kTFIndexFileMagic || !(in >> mtime >> num_records) || num_records < 0) {
+    MS_LOG(INFO) << "TFReader operator index file " << index_file << " is of an unknown format.";
+    return false;
+  }
+  if (Path(filename).LastModified() != mtime) {
+    MS_LOG(INFO) << "TFReader operator index file " << index_file << " is out of date.";
+    return false;
+  }
+  std::vector<int64_t> v(static_cast<size_t>(num_records) + 1);
+  for (auto &offset : v) {
+    if (!(in >> offset)) {
+      MS_LOG(INFO) << "TFReader operator index file " << index_file << " is truncated.";
+      return false;
+    }
+  }
+  std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!file.is_open() || static_cast<int64_t>(file.tellg()) != v.back()) {
+    MS_LOG(INFO) << "TFReader operator index file " << index_file << " is out of date.";
+    return false;
+  }
+  *offsets = std::move(v);
+  return true;
+}
+
+Status TFReaderOp::WriteIndexFile(const std::string &filename, const std::vector<int64_t> &offsets) {
+  std::string index_file = filename + kTFIndexFileSuffix;
+  // The file is written aside then renamed, the runs which read it at the same time see the old or the new one
+  std::string tmp_file = index_file + ".tmp" + std::to_string(getpid());
+  std::ofstream out(tmp_file, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Can not open " + tmp_file);
+  }
+  out << kTFIndexFileMagic << "\n" << Path(filename).LastModified() << " " << offsets.size() - 1 << "\n";
+  for (int64_t offset : offsets) {
+    out << offset << "\n";
+  }
+  out.close();
+  if (out.fail() || std::rename(tmp_file.c_str(), index_file.c_str()) != 0) {
+    (void)std::remove(tmp_file.c_str());
+    RETURN_STATUS_UNEXPECTED("Fail to write " + index_file);
+  }
+  return Status::OK();
+}
+
+Status TFReaderOp::CreateIndexFile(const std::string &filename, int64_t *num_rows) {
+  std::vector<int64_t> offsets;
+  RETURN_IF_NOT_OK(ScanRecordOffsets(filename, &offsets));
+  RETURN_IF_NOT_OK(WriteIndexFile(filename, offsets));
+  *num_rows = static_cast<int64_t>(offsets.size()) - 1;
+  return Status::OK();
+}
+
+Status TFReaderOp::LoadIndexFiles() {
+  for (const std::string &file : dataset_files_list_) {
+    std::vector<int64_t> offsets;
+    if (ReadIndexFile(file, &offsets)) {
+      filename_offsets_[file] = std::move(offsets);
+    } else if (write_index_files_) {
+      RETURN_IF_NOT_OK(ScanRecordOffsets(file, &offsets));
+      Status rc = WriteIndexFile(file, offsets);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "TFReader operator can not write the index of " << file << ": " << rc.ToString() << ".";
+      }
+      filename_offsets_[file] = std::move(offsets);
+    }
+  }
+  MS_LOG(INFO) << "TFReader operator has the index of " << filename_offsets_.size() << " of "
+               << dataset_files_list_.size() << " files.";
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
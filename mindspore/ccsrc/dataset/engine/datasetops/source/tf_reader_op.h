@@ -21,6 +21,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 #include <map>
@@ -51,6 +52,21 @@ class FilenameBlock;
 
 using StringIndex = AutoIndexObj<std::string>;
 
+// Size of the chunks in which the tf_file files are read ahead of the workers
+constexpr int64_t kTFReadaheadChunkSize = 1048576;
+
+// The suffix of the sidecar index of a tf_file file, which holds the byte offsets of its records
+constexpr char kTFIndexFileSuffix[] = ".index";
+
+// An item of the readahead queue of a worker. Each io block of the worker is followed, for a file, by
+// the chunks of the file, the last one flagged.
+struct ReadaheadChunk {
+  std::unique_ptr<FilenameBlock> io_block;  // The io block, nullptr for the chunks of a file
+  std::string data;                         // The bytes of the chunk
+  bool last = false;                        // T/F if this is the last chunk of the file
+  Status rc;                                // The error of the read, if any
+};
+
 class TFReaderOp : public ParallelOp {
  public:
   class Builder {
@@ -153,6 +169,24 @@ class TFReaderOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @param readahead_chunks - The number of chunk reads of a worker outstanding ahead of its parse, 0
+    //     for a worker reading its files itself
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetReadaheadChunks(int32_t readahead_chunks) {
+      builder_readahead_chunks_ = readahead_chunks;
+      return *this;
+    }
+
+    // Setter method.
+    // @param write_index_files - T/F if the files without an up to date index are scanned when the op is built,
+    //     and their index is written beside them for the next runs
+    // @return Builder - setter method returns reference to the builder.
+    Builder &SetWriteIndexFiles(bool write_index_files) {
+      builder_write_index_files_ = write_index_files;
+      return *this;
+    }
+
    private:
     std::unique_ptr<DataSchema> builder_data_schema_;
     int32_t builder_device_id_;
@@ -166,6 +200,8 @@ class TFReaderOp : public ParallelOp {
     std::vector<std::string> builder_columns_to_load_;
     bool builder_shuffle_files_;
     bool builder_equal_rows_per_shard_;
+    int32_t builder_readahead_chunks_;
+    bool builder_write_index_files_;
   };
 
   // Constructor of TFReaderOp (2)
@@ -180,10 +216,13 @@ class TFReaderOp : public ParallelOp {
   // @param columns_to_load - the names of the columns to load data from.
   // @param shuffle_files - whether or not to shuffle the files before reading data.
   // @param equal_rows_per_shard - whether or not to get equal rows for each process.
+  // @param readahead_chunks - number of chunk reads of a worker outstanding ahead of its parse, 0 to disable.
+  // @param write_index_files - whether or not to write the index of the files which have none.
   TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64_t rows_per_buffer, int64_t total_num_rows,
              std::vector<std::string> dataset_files_list, std::unique_ptr<DataSchema> data_schema,
              int32_t op_connector_size, std::vector<std::string> columns_to_load, bool shuffle_files,
-             int32_t num_devices, int32_t device_id, bool equal_rows_per_shard);
+             int32_t num_devices, int32_t device_id, bool equal_rows_per_shard, int32_t readahead_chunks = 0,
+             bool write_index_files = false);
 
   // Default destructor
   ~TFReaderOp() = default;
@@ -198,11 +237,31 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status operator()() override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "TFReaderOp"; }
+
+  // Getter
+  // @return T/F if the number of running workers can be tuned while the tree executes
+  bool AutoTunable() const override { return true; }
+
   // Overrides base class reset method. Cleans up any state info from it's previous execution and
   // reinitializes itself so that it can be executed again, as if it was just created.
   // @return Status - the error code returned.
   Status Reset() override;
 
+  // Base-class override. The rows of a pass come from the files in the order of the pass, the shuffles of the
+  // files are replayed up to the saved pass and the rows consumed in it are dropped.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - the error code returned.
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
+
+  // Base-class override.
+  // @param state - The state of the tree
+  // @return Status - the error code returned.
+  Status LoadState(const nlohmann::json &state) override;
+
   // Getter method
   int64_t rows_per_buffer() const { return rows_per_buffer_; }
 
@@ -217,6 +276,14 @@ class TFReaderOp : public ParallelOp {
   static Status CountTotalRows(int64_t *out_total_rows, const std::vector<std::string> &filenames, int64_t threads = 1,
                                bool estimate = false);
 
+  // Scans a tf_file file and writes its index beside it, in the file name followed by kTFIndexFileSuffix. With
+  // an up to date index the rows of the file are counted without reading it, and its records can be split
+  // across the workers.
+  // @param filename - the tf_file file.
+  // @param num_rows - output parameter which contains the number of rows of the file.
+  // @return Status - the error code returned.
+  static Status CreateIndexFile(const std::string &filename, int64_t *num_rows);
+
  private:
   // The entry point for when workers are launched.
   // @param worker_id - the id of the worker that is executing this function.
@@ -246,6 +313,26 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status PopIoBlockQueue(int32_t index, std::unique_ptr<FilenameBlock> *out_block);
 
+  // Gets the next io block of a worker, from the readahead queue of the worker when the files are read ahead.
+  // @param worker_id - the id of the worker.
+  // @param out_block - the io block.
+  // @return Status - the error code returned.
+  Status NextIoBlock(int32_t worker_id, std::unique_ptr<FilenameBlock> *out_block);
+
+  // The entry point of the readahead threads. The readahead thread of a worker takes the io blocks of the
+  // worker and reads their files in chunks, up to readahead_chunks_ ahead of the worker.
+  // @param worker_id - the id of the worker served by this thread.
+  // @return Status - the error code returned.
+  Status ReadaheadEntry(int32_t worker_id);
+
+  // Reads the bytes [begin, end) of a tf_file file in chunks into the readahead queue of a worker.
+  // @param filename - the tf_file file to read.
+  // @param begin - the offset of the first byte.
+  // @param end - one greater than the offset of the last byte, -1 for the end of the file.
+  // @param worker_id - the id of the worker.
+  // @return Status - the error code returned.
+  Status ReadAhead(const std::string &filename, int64_t begin, int64_t end, int32_t worker_id);
+
   // Pushes an element to a queue in IOBlockQueue.
   // @param index - the index of the queue to push to.
   // @param io_block - the element to push onto the queue.
@@ -261,12 +348,27 @@ class TFReaderOp : public ParallelOp {
   Status LoadFile(const std::string &filename, const int64_t start_offset, const int64_t end_offset,
                   const int32_t &worker_id);
 
-  // Parses a single row and puts the data into a tensor table.
-  // @param tf_file - the row to be parsed.
+  // Parses a single row and puts the data into a tensor table. The wire format of the record is scanned
+  // for the features of the schema columns, the other features are skipped without being parsed.
+  // @param record - the serialized Example, as a DE_UINT8 tensor.
+  // @param column_name_map - the index of each schema column by name.
   // @param tensor_table - the tensor table to put the parsed data in.
   // @param row - the id of the row filled in the tensor table.
   // @return Status - the error code returned.
-  Status LoadExample(const dataengine::Example *tf_file, std::unique_ptr<TensorQTable> *tensor_table, int64_t row);
+  Status LoadExample(const std::shared_ptr<Tensor> &record,
+                     const std::unordered_map<std::string, int32_t> &column_name_map,
+                     std::unique_ptr<TensorQTable> *tensor_table, int64_t row);
+
+  // Parses the serialized Feature of a single cell and puts the data into a tensor table. A DE_UINT8 cell
+  // made of one bytes value which needs no padding is a view on the record instead of a copy.
+  // @param record - the serialized Example the feature belongs to.
+  // @param feature - the start of the serialized Feature in the record.
+  // @param feature_len - the length of the serialized Feature.
+  // @param current_col - the column descriptor containing the expected shape and type of the data.
+  // @return Status - the error code returned.
+  Status LoadFeatureBytes(const std::shared_ptr<Tensor> &record, const unsigned char *feature, int64_t feature_len,
+                          const std::unique_ptr<TensorQTable> *tensor_table, const ColDescriptor &current_col,
+                          int64_t row, int32_t col);
 
   // Parses a single cell and puts the data into a tensor table.
   // @param tensor_table - the tensor table to put the parsed data in.
@@ -333,6 +435,46 @@ class TFReaderOp : public ParallelOp {
   // @return int63_t - the total number of rows of files read.
   static int64_t CountTotalRowsSectioned(const std::vector<std::string> &filenames, const int64_t begin,
                                          const int64_t end);
+
+  // Reads the byte offsets of the records of a tf_file file.
+  // @param filename - the tf_file file.
+  // @param offsets - the offset of each record, then the size of the file.
+  // @return Status - the error code returned, an error if the file is truncated.
+  static Status ScanRecordOffsets(const std::string &filename, std::vector<int64_t> *offsets);
+
+  // Reads the sidecar index of a tf_file file.
+  // @param filename - the tf_file file.
+  // @param offsets - the offset of each record, then the size of the file.
+  // @return T/F if the file has an index, which is up to date.
+  static bool ReadIndexFile(const std::string &filename, std::vector<int64_t> *offsets);
+
+  // Writes the sidecar index of a tf_file file.
+  // @param filename - the tf_file file.
+  // @param offsets - the offset of each record, then the size of the file.
+  // @return Status - the error code returned.
+  static Status WriteIndexFile(const std::string &filename, const std::vector<int64_t> &offsets);
+
+  // Loads the indexes of the files, and scans and writes the missing ones if asked to.
+  // @return Status - the error code returned.
+  Status LoadIndexFiles();
+
+  // Pushes the rows [start_offset, end_offset) of a file to the block queues. The rows of an indexed file are
+  // split into pieces_per_file_ blocks, for consecutive workers.
+  // @param key - the key of the file.
+  // @param file_name - the file.
+  // @param start_offset - the first row, kInvalidOffset for the whole file.
+  // @param end_offset - one greater than the last row.
+  // @param queue_index - the queue of the first block, moved past the last one.
+  // @return Status - the error code returned.
+  Status PushFileBlocks(int64_t key, const std::string &file_name, int64_t start_offset, int64_t end_offset,
+                        int32_t *queue_index);
+
+  // @param file_name - the file.
+  // @return The record offsets of the file, nullptr if it has no index.
+  const std::vector<int64_t> *FileOffsets(const std::string &file_name) const {
+    auto it = filename_offsets_.find(file_name);
+    return it == filename_offsets_.end() ? nullptr : &it->second;
+  }
   // Fill IO block queue if shuffle is true
   // @param i_keys - shuffle keys.
   // @return Status - the error code returned.
@@ -372,12 +514,20 @@ class TFReaderOp : public ParallelOp {
 
   std::unique_ptr<JaggedConnector> jagged_buffer_connector_;
   QueueList<std::unique_ptr<FilenameBlock>> io_block_queues_;
+  int32_t readahead_chunks_;
+  QueueList<std::unique_ptr<ReadaheadChunk>> readahead_queues_;
   WaitPost io_block_queue_wait_post_;
   std::mutex load_io_block_queue_mutex_;
   std::map<std::string, int64_t> filename_numrows_;
   int64_t num_rows_;
   int64_t num_rows_per_shard_;
   bool equal_rows_per_shard_;
+  int64_t start_pass_;  // The pass to start from, not 0 after a resume
+  int64_t skip_rows_;   // The rows to drop from the start of the first pass after a resume
+  bool write_index_files_;
+  // The record offsets of the indexed files, then their size. Filled by Init, read only afterwards.
+  std::map<std::string, std::vector<int64_t>> filename_offsets_;
+  int32_t pieces_per_file_;  // The blocks an indexed file is split into, so that every worker has some
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -71,9 +71,11 @@ VOCOp::VOCOp(int32_t num_workers, int32_t rows_per_buffer, const std::string &fo
       rows_per_buffer_(rows_per_buffer),
       sampler_(std::move(sampler)),
       data_schema_(std::move(data_schema)) {
+  ColumnNameMap col_name_map;
   for (int32_t i = 0; i < data_schema_->NumColumns(); ++i) {
-    col_name_map_[data_schema_->column(i).name()] = i;
+    col_name_map[data_schema_->column(i).name()] = i;
   }
+  col_name_map_ = std::make_shared<const ColumnNameMap>(std::move(col_name_map));
   io_block_queues_.Init(num_workers_, queue_size);
 }
 
@@ -138,6 +140,22 @@ void VOCOp::Print(std::ostream &out, bool show_all) const {
       << "\nVOC Directory: " << folder_path_ << "\n-------------------\n";
 }
 
+Status VOCOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  nlohmann::json *op_state = MutableOpState(state);
+  (*op_state)["rows"] = pos.rows;
+  return sampler_->SaveState(pos, &(*op_state)["sampler"]);
+}
+
+Status VOCOp::LoadState(const nlohmann::json &state) {
+  const nlohmann::json *op_state = nullptr;
+  RETURN_IF_NOT_OK(GetOpState(state, &op_state));
+  if (op_state == nullptr) {
+    return Status::OK();
+  }
+  row_cnt_ = (*op_state)["rows"].get<int64_t>();
+  return sampler_->LoadState((*op_state)["sampler"]);
+}
+
 Status VOCOp::Reset() {
   RETURN_IF_NOT_OK(sampler_->Reset());
   row_cnt_ = 0;
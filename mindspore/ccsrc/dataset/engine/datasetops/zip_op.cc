@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "dataset/engine/datasetops/zip_op.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 #include <utility>
 #include "dataset/core/constants.h"
 #include "dataset/engine/data_buffer.h"
@@ -50,165 +53,154 @@ ZipOp::ZipOp(int32_t rows_per_buffer, int32_t op_connector_size)
       rows_per_buffer_(rows_per_buffer),
       buffer_id_(0),
       draining_(false),
-      eof_(false) {}
+      eof_(false),
+      zipped_cols_(0) {}
 
 // destructor
 ZipOp::~ZipOp() {}
 
 // Entry point for Zip, called by launch()
+Status ZipOp::SaveState(const Position &pos, nlohmann::json *state) const {
+  for (const auto &child : child_) {
+    RETURN_IF_NOT_OK(child->SaveState(pos, state));
+  }
+  return Status::OK();
+}
+
 Status ZipOp::operator()() {
   // The children_num_ parameter needs to be put here
   children_num_ = child_.size();
   // Synchronize with TaskManager once the thread is created.
   TaskManager::FindMe()->Post();
 
-  // initialize the iterators
-  for (int32_t i = 0; i < children_num_; ++i) {
-    // magic number 0 since Zip is not a parallel Op
-    child_iterators_.push_back(mindspore::make_unique<ChildIterator>(this, 0, i));
-  }
+  child_tables_.resize(children_num_);
+  child_maps_.resize(children_num_);
+  child_eoe_.assign(children_num_, false);
 
   // Loop until eof is true
   while (!eof_) {
-    // Create tensor table and prepare it by fetching and packing the first zipped row into it.
-    std::unique_ptr<TensorQTable> curr_table = mindspore::make_unique<TensorQTable>();
-    RETURN_IF_NOT_OK(prepare(curr_table.get()));
-
-    // If an eof got picked up during the above prepare, then we're done
-    if (eof_) {
-      break;
-    }
+    MS_LOG(DEBUG) << "Zip operator prepares for new epoch.";
+    draining_ = false;
+    buffer_id_ = 0;
     while (!draining_) {
-      // 1. If a previous loop iteration sent the current table out, then create a new one.
-      if (curr_table == nullptr) {
-        curr_table = mindspore::make_unique<TensorQTable>();
-      }
+      // 1 zip the rows all the children have. Note: draining mode might get turned on if any of the child
+      // inputs were done
+      std::unique_ptr<TensorQTable> curr_table;
+      RETURN_IF_NOT_OK(ZipRows(&curr_table));
 
-      // 2 fill the table.  Note: draining mode might get turned on if any of the child inputs were done
-      RETURN_IF_NOT_OK(fillBuffer(curr_table.get()));
-
-      // 3 create and update buffer and send it to the out connector
-      if (!curr_table->empty()) {
+      // 2 create and update buffer and send it to the out connector
+      if (curr_table != nullptr && !curr_table->empty()) {
         std::unique_ptr<DataBuffer> curr_buffer =
           mindspore::make_unique<DataBuffer>(buffer_id_, DataBuffer::kDeBFlagNone);
         curr_buffer->set_tensor_table(std::move(curr_table));
         curr_buffer->set_column_name_map(col_name_id_map_);
         MS_LOG(DEBUG) << "Zip operator finished one buffer, pushing, rows " << curr_buffer->NumRows() << ", cols "
-                      << curr_buffer->NumCols() << ", map " << col_name_id_map_.size() << ".";
+                      << curr_buffer->NumCols() << ", map " << col_name_id_map_->size() << ".";
         RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(curr_buffer)));
         buffer_id_++;
       }
     }
 
-    // 4 handle drain state.
-    if (draining_) {
-      MS_LOG(DEBUG) << "Zip operator is now draining child inputs.";
-      RETURN_IF_NOT_OK(drainPipeline());
-      // Now that we have drained child inputs, send the eoe up.
-      RETURN_IF_NOT_OK(
-        out_connector_->Add(0, std::move(mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE))));
+    // If an eof got picked up, then we're done
+    if (eof_) {
+      break;
     }
+
+    // 3 handle drain state.
+    MS_LOG(DEBUG) << "Zip operator is now draining child inputs.";
+    RETURN_IF_NOT_OK(drainPipeline());
+    // Now that we have drained child inputs, send the eoe up.
+    RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE))));
   }
 
-  // 5 handle eof
+  // 4 handle eof
   // propagate eof here.
   MS_LOG(INFO) << "Zip operator got EOF, propagating.";
   RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF))));
   return Status::OK();
 }
 
-// Handles preprocessing of the main loop, used when starting new epoch
-Status ZipOp::prepare(TensorQTable *const table) {
-  MS_LOG(DEBUG) << "Zip operator prepares for new epoch.";
-  draining_ = false;
-  buffer_id_ = 0;
-  if (table == nullptr) {
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "ZipOp prepare phase requires a tensor table.");
-  }
-  // fill initial row
-  TensorRow new_row;
-  RETURN_IF_NOT_OK(getNextTensorRow(&new_row));
-
-  // If the first row fetching resulted in eof, then we are done.
-  if (eof_) {
-    return Status::OK();
-  }
-  if (new_row.empty()) {
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "ZipOp prepare phase got empty row!");
+Status ZipOp::FetchChild(int32_t child) {
+  std::unique_ptr<DataBuffer> buffer;
+  // Skip the buffers which hold no row
+  do {
+    RETURN_IF_NOT_OK(GetNextInput(&buffer, 0, child));
+    if (buffer->eoe() || buffer->eof()) {
+      // If we did not get a buffer from any of the children, then it's the end of an epoch and we can move
+      // to drain state.
+      MS_LOG(INFO) << "Zip operator child " << child << " reached the end of its epoch.";
+      draining_ = true;
+      child_eoe_[child] = buffer->eoe();
+      // If we picked up an eof here, then we are completely done.
+      eof_ = buffer->eof();
+      return Status::OK();
+    }
+  } while (buffer->NumRows() == 0);
+  if (!SameColumns(buffer->shared_column_name_map(), child_maps_[child])) {
+    child_maps_[child] = buffer->shared_column_name_map();
+    col_name_id_map_.reset();
   }
+  child_tables_[child] = buffer->TakeTensorTable();
+  return Status::OK();
+}
 
-  // Pack this first row into our tensor table
-  table->push_back(std::move(new_row));
-
-  // At this point we have at least 1 row produced, so all child iterators have their column names such that we
-  // can produce our column name map now.
-  col_name_id_map_ = {};
+Status ZipOp::UpdateColumnMap() {
+  auto zipped_map = std::make_shared<ColumnNameMap>();
   for (int32_t i = 0; i < children_num_; ++i) {
-    // Initializing col_name_id_map_ from the first data buffer.
-    const std::unordered_map<std::string, int32_t> col_name_id_map = child_iterators_[i]->col_name_id_map();
-    int32_t colsCurrent = col_name_id_map_.size();
-    // the update code below shouldn't do anything bad if the column name already exists.
-    for (const auto &pair : col_name_id_map) {
-      std::string name = pair.first;
-      int32_t old_id = pair.second;
+    RETURN_UNEXPECTED_IF_NULL(child_maps_[i]);
+    int32_t colsCurrent = zipped_map->size();
+    for (const auto &pair : *child_maps_[i]) {
       // check if name already exists in column name descriptor
-      if (col_name_id_map_.count(name) == 1) {
+      if (zipped_map->count(pair.first) == 1) {
         RETURN_STATUS_UNEXPECTED("key already exists when zipping datasets");
       }
-      col_name_id_map_[name] = old_id + colsCurrent;
+      (*zipped_map)[pair.first] = pair.second + colsCurrent;
     }
   }
+  zipped_cols_ = zipped_map->size();
+  col_name_id_map_ = std::move(zipped_map);
   return Status::OK();
 }
 
-// fillBuffer always expects a new table to fill
-Status ZipOp::fillBuffer(TensorQTable *const table) {
-  if (table == nullptr) {
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "ZipOp fillBuffer null table pointer.");
+Status ZipOp::ZipRows(std::unique_ptr<TensorQTable> *table) {
+  size_t num_rows = (rows_per_buffer_ > 0) ? static_cast<size_t>(rows_per_buffer_) : SIZE_MAX;
+  for (int32_t i = 0; i < children_num_; ++i) {
+    if (child_tables_[i] == nullptr || child_tables_[i]->empty()) {
+      RETURN_IF_NOT_OK(FetchChild(i));
+      if (draining_) {
+        return Status::OK();
+      }
+    }
+    num_rows = std::min(num_rows, child_tables_[i]->size());
   }
-  TensorRow new_row;
-  while (table->size() < static_cast<size_t>(rows_per_buffer_)) {
-    RETURN_IF_NOT_OK(getNextTensorRow(&new_row));
-    // Early exit the loop if we got empty row from any of our child iterations
-    if (new_row.empty()) {
-      return Status::OK();
+  if (col_name_id_map_ == nullptr) {
+    RETURN_IF_NOT_OK(UpdateColumnMap());
+  }
+  // The rows of the first child are the zipped rows
+  if (child_tables_[0]->size() == num_rows) {
+    *table = std::move(child_tables_[0]);
+  } else {
+    *table = mindspore::make_unique<TensorQTable>();
+    for (size_t j = 0; j < num_rows; ++j) {
+      (*table)->push_back(std::move(child_tables_[0]->front()));
+      child_tables_[0]->pop_front();
     }
-    // else we got a row so pack it into the tensor table.
-    table->push_back(std::move(new_row));
   }
-  return Status::OK();
-}
-
-// fetches next zip buffer row (merged row)
-Status ZipOp::getNextTensorRow(TensorRow *const new_zip_row) {
-  // iterate over all iterators and generate a row
-  for (int32_t i = 0; i < children_num_; ++i) {
-    TensorRow new_row = {};
-    RETURN_IF_NOT_OK((child_iterators_[i])->FetchNextTensorRow(&new_row));
-    // add each new row to iterator, check if row is empty, if row from iterator is empty return empty row
-    if (new_row.empty()) {
-      // If we did not get a row from any of the children, then it's the end of an epoch and we can move
-      // to drain state.
-      MS_LOG(INFO) << "Zip operator child iterator produced empty row.";
-      draining_ = true;
-      new_zip_row->clear();
-      // If we picked up an eof here, then we are completely done.
-      if ((child_iterators_[i])->eof_handled()) {
-        MS_LOG(INFO) << "Zip operator iterator got EOF.";
-        eof_ = true;
-      }
-      return Status::OK();
-    } else {
-      MS_LOG(DEBUG) << "Zip operator got row from child " << i << ". Num cols: " << new_row.size() << ".";
-      // if row isn't empty then we can append the fetched row with new_zip_row
-      new_zip_row->insert(new_zip_row->end(), new_row.begin(), new_row.end());
+  for (TensorRow &row : **table) {
+    row.reserve(zipped_cols_);
+  }
+  for (int32_t i = 1; i < children_num_; ++i) {
+    TensorQTable &child_table = *child_tables_[i];
+    for (TensorRow &row : **table) {
+      TensorRow &child_row = child_table.front();
+      (void)std::move(child_row.begin(), child_row.end(), std::back_inserter(row));
+      child_table.pop_front();
     }
   }
-  MS_LOG(DEBUG) << "Zip operator builds a zipped row. Number of columns in row: " << new_zip_row->size() << ".";
   return Status::OK();
 }
 
-// drain end of epoch messages from iterator for this epoch
+// drain end of epoch messages from the children for this epoch
 Status ZipOp::drainPipeline() {
   // we don't need to drain if we reached eof
   if (eof_) {
@@ -216,8 +208,20 @@ Status ZipOp::drainPipeline() {
                   "ZipOp draining should not be done if already at eof!");
   }
   for (int32_t con = 0; con < children_num_; ++con) {
+    child_tables_[con].reset();
+    // Draining a child that is already at its eoe state will not result in any action.
+    if (child_eoe_[con]) {
+      child_eoe_[con] = false;
+      continue;
+    }
     MS_LOG(DEBUG) << "Zip operator draining child at " << con << ".";
-    RETURN_IF_NOT_OK(child_iterators_[con]->Drain());
+    std::unique_ptr<DataBuffer> buffer;
+    do {
+      RETURN_IF_NOT_OK(GetNextInput(&buffer, 0, con));
+    } while (!buffer->eoe() && !buffer->eof());
+    if (buffer->eof()) {
+      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "Zip operator picked up EOF in drain.");
+    }
   }
   // at this point all connectors don't contain end of epoch messages. next iteration should be clean
   return Status::OK();
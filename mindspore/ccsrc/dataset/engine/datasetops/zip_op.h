@@ -23,7 +23,7 @@
 #include <vector>
 
 #include "dataset/core/tensor.h"
-#include "dataset/engine/dataset_iterator.h"
+#include "dataset/engine/data_buffer.h"
 #include "dataset/engine/datasetops/pipeline_op.h"
 #include "dataset/util/status.h"
 
@@ -92,6 +92,10 @@ class ZipOp : public PipelineOp {
   // @param show_all if it should print everything
   void Print(std::ostream &out, bool show_all) const override;
 
+  // Op name getter
+  // @return Name of the current Op
+  std::string Name() const override { return "ZipOp"; }
+
   // Provide stream operator for displaying it
   friend std::ostream &operator<<(std::ostream &out, const ZipOp &zo) {
     zo.Print(out, false);
@@ -104,40 +108,55 @@ class ZipOp : public PipelineOp {
   // @return Status - The error code return
   Status operator()() override;
 
- private:
-  // Handles preprocessing of the main loop, used when starting new epoch
-  Status prepare(TensorQTable *const table);
+  // Base-class override. Each zipped row takes one row of every child.
+  // @param pos - The position in the output of this operator
+  // @param state - The state of the tree
+  // @return Status - The error code return
+  Status SaveState(const Position &pos, nlohmann::json *state) const override;
 
-  // This function calls takes a table repeatedly adds rows to it.
-  // @param table a table of tensors to be moved into a buffer
-  Status fillBuffer(TensorQTable *const table);
+ private:
+  // Refills the rows of a child once they are all zipped, with the whole table of its next buffer
+  // @param child - the index of the child
+  // @return Status - The error code return, turns on draining_ (and eof_) when the child ends its epoch
+  Status FetchChild(int32_t child);
 
-  // Special handle case where an empty row has been received from child iterator
-  // @note we need to drain eoe signals from all children connectors.
-  // @details when this function is called, then we encountered eoe at child iterator
-  // we have to drain rows from other child iterators until we hit eoe from all other child iterators
-  Status drainPipeline();
+  // Rebuilds the zipped column name map when the map of a child changed
+  // @return Status - The error code return
+  Status UpdateColumnMap();
 
-  // Merges 1 row from each childIterator together
-  // @param new_zip_row input and output, will return a non-empty row if all rows from childConnectors are non-empty
-  // @param updateColumnMapping generates a new column name to index mapping (mColNameIdMap) if set to true
-  // @details merge rows from iterator together. This is the main functionality for ZipOp
-  //          this function takes one row and fills it with tensors from rows fetched
-  //          from childIterators.
+  // Zips the rows which all the children have, at most rows_per_buffer_ of them. This is the main
+  // functionality for ZipOp, it works on whole tables: the rows of the first child are extended in place with
+  // the tensors moved out of the rows of the other children, and the table of the first child becomes the
+  // zipped table when it holds exactly the rows to zip.
   // @example:
-  //   Zips multiple rows at a time, the output is store in newZipRow
+  //   Zips multiple rows at a time
   //       1    a     T
   //       \    |     /
   //         1, a, T
-  Status getNextTensorRow(TensorRow *const new_zip_row);
+  // @param table - the zipped rows, empty when a child ended its epoch
+  // @return Status - The error code return
+  Status ZipRows(std::unique_ptr<TensorQTable> *table);
+
+  // Special handle case where a child has ended its epoch
+  // @note we need to drain eoe signals from all children connectors.
+  // @details when this function is called, then we encountered eoe from a child
+  // we have to drain buffers from the other children until we hit eoe from all of them
+  Status drainPipeline();
 
   int32_t children_num_;
   int32_t rows_per_buffer_;
   int32_t buffer_id_;
   bool draining_;
   bool eof_;
-  std::unordered_map<std::string, int32_t> col_name_id_map_;
-  std::vector<std::unique_ptr<ChildIterator>> child_iterators_;
+  std::shared_ptr<const ColumnNameMap> col_name_id_map_;  // shared by all the buffers of an epoch
+  // The rows of the last buffer of each child which are not zipped yet
+  std::vector<std::unique_ptr<TensorQTable>> child_tables_;
+  // The column name map of the last buffer of each child
+  std::vector<std::shared_ptr<const ColumnNameMap>> child_maps_;
+  // T/F if a child has sent its eoe in the current epoch
+  std::vector<bool> child_eoe_;
+  // The number of columns of a zipped row
+  size_t zipped_cols_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -16,16 +16,25 @@
 #ifndef DATASET_ENGINE_DB_CONNECTOR_H_
 #define DATASET_ENGINE_DB_CONNECTOR_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
+#include <vector>
 #include "dataset/engine/connector.h"
 #include "dataset/engine/data_buffer.h"
+#include "dataset/engine/perf/connector_stats.h"
 #include "dataset/core/constants.h"
 
 namespace mindspore {
 namespace dataset {
 // DbConnector is a derived class from Connector with added logic to handle EOE and EOF.
 // The Connector class itself is responsible to ensure deterministic order on every run.
+//
+// When the DbConnector is unordered, a control buffer (EOE or EOF) can no longer be placed in between the
+// data buffers of other producers. Instead, every producer must push its own control buffer. The
+// DbConnector collects one control buffer from each producer queue before it releases it, and then
+// delivers it once to every consumer, so every consumer thread sees the epoch boundary after all the
+// data of the epoch has been popped.
 class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
  public:
   // Constructor of DbConnector
@@ -34,8 +43,22 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each internal queue.
-  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
+  // @param lock_free Use RingBuffer's instead of blocking queues.
+  // @param ordered Preserve the order of the buffers. See the requirement on control buffers above.
+  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false,
+              bool ordered = true)
+      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity, lock_free, ordered),
+        end_of_file_(false),
+        ctrl_seq_(0),
+        ctrl_seen_(n_consumers, 0),
+        parked_(n_producers),
+        busy_(n_producers),
+        num_parked_(0) {
+    for (int32_t i = 0; i < n_producers; i++) {
+      parked_[i] = false;
+      busy_[i] = false;
+    }
+  }
 
   // Destructor of DbConnector
   ~DbConnector() = default;
@@ -45,7 +68,17 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A rvalue reference to an element to be passed/added/pushed.
   Status Add(int32_t worker_id, std::unique_ptr<DataBuffer> &&el) noexcept {
-    return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
+    if (stats_ == nullptr) {
+      return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
+    }
+    ConnectorStats::Clock::time_point start = ConnectorStats::Clock::now();
+    int64_t rows = (el != nullptr) ? el->NumRows() : 0;
+    if (el != nullptr && el->eoe()) {
+      stats_->RecordEoe();
+    }
+    Status rc = Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el));
+    stats_->RecordPush(worker_id, start, rows);
+    return rc;
   }
 
   // Get a unique_ptr<DataBuffer> from the DbConnector.
@@ -56,40 +89,137 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param worker_id The id of a worker thread calling this method.
   // @param result The address of a unique_ptr<DataBuffer> where the popped element will be placed.
   // @param retry_if_eoe A flag to allow the same thread invoke pop() again if the current pop returns eoe buffer.
+  //     It has no effect on an unordered DbConnector.
   Status PopWithRetry(int32_t worker_id, std::unique_ptr<DataBuffer> *result, bool retry_if_eoe = false) noexcept {
+    if (stats_ == nullptr) {
+      return PopImpl(worker_id, result, retry_if_eoe);
+    }
+    ConnectorStats::Clock::time_point start = ConnectorStats::Clock::now();
+    Status rc = PopImpl(worker_id, result, retry_if_eoe);
+    stats_->RecordPop(worker_id, start);
+    return rc;
+  }
+
+  // Setter
+  // @param stats - The profiling counters to update from now on. nullptr turns the profiling off.
+  void set_stats(std::shared_ptr<ConnectorStats> stats) { stats_ = std::move(stats); }
+
+  // Getter
+  // @return The profiling counters of this DbConnector, or nullptr when it is not profiled.
+  std::shared_ptr<ConnectorStats> stats() const { return stats_; }
+
+ private:
+  // The actual PopWithRetry().
+  Status PopImpl(int32_t worker_id, std::unique_ptr<DataBuffer> *result, bool retry_if_eoe) {
     if (result == nullptr) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "[ERROR] nullptr detected when getting data from db connector");
+    }
+    if (!ordered_) {
+      return PopUnordered(worker_id, result);
+    }
+    std::unique_lock<std::mutex> lk;
+    RETURN_IF_NOT_OK(AcquireTurn(worker_id, &lk));
+    // Once an EOF message is encountered this flag will be set and we can return early.
+    if (end_of_file_) {
+      *result = mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
     } else {
-      std::unique_lock<std::mutex> lk(m_);
-      RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
-      // Once an EOF message is encountered this flag will be set and we can return early.
-      if (end_of_file_) {
-        *result = mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
-      } else {
-        RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
-        if (*result == nullptr) {
-          return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
-                        "[ERROR] nullptr detected when getting data from db connector");
-        }
-        // Setting the internal flag once the first EOF is encountered.
-        if ((*result)->eof()) {
-          end_of_file_ = true;
-        }
-        pop_from_ = (pop_from_ + 1) % num_producers_;
+      RETURN_IF_NOT_OK(PopFromQueue(pop_from_, result));
+      if (*result == nullptr) {
+        return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                      "[ERROR] nullptr detected when getting data from db connector");
       }
-      // Do not increment expect_consumer_ when result is eoe and retry_if_eoe is set.
-      if (!((*result)->eoe() && retry_if_eoe)) {
-        expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
+      // Setting the internal flag once the first EOF is encountered.
+      if ((*result)->eof()) {
+        end_of_file_ = true;
       }
+      pop_from_ = (pop_from_ + 1) % num_producers_;
     }
-    cv_.NotifyAll();
+    // Do not increment expect_consumer_ when result is eoe and retry_if_eoe is set.
+    ReleaseTurn(&lk, !((*result)->eoe() && retry_if_eoe));
     return Status::OK();
   }
 
- private:
+  // The unordered version of PopWithRetry().
+  Status PopUnordered(int32_t worker_id, std::unique_ptr<DataBuffer> *result) {
+    return WaitFor([this, worker_id, result]() { return TryPopUnordered(worker_id, result); });
+  }
+
+  // One non blocking attempt of PopUnordered().
+  // @return T/F if a buffer is returned in result.
+  bool TryPopUnordered(int32_t worker_id, std::unique_ptr<DataBuffer> *result) {
+    // Deliver the last released EOE if this consumer has not seen it yet.
+    int64_t seq = ctrl_seq_.load(std::memory_order_acquire);
+    if (ctrl_seen_[worker_id] < seq) {
+      ctrl_seen_[worker_id] = seq;
+      *result = mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE);
+      return true;
+    }
+    if (end_of_file_) {
+      *result = mindspore::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
+      return true;
+    }
+    auto start = static_cast<int32_t>(next_scan_.fetch_add(1, std::memory_order_relaxed) % num_producers_);
+    for (int32_t offset = 0; offset < num_producers_; offset++) {
+      int32_t qid = (start + offset) % num_producers_;
+      // A queue is popped by one consumer at a time, so nobody can pop beyond its control buffer.
+      if (parked_[qid].load(std::memory_order_acquire) || busy_[qid].exchange(true, std::memory_order_acquire)) {
+        continue;
+      }
+      std::unique_ptr<DataBuffer> buf;
+      bool popped = !parked_[qid].load(std::memory_order_acquire) && rings_[qid]->TryPopFront(&buf);
+      bool released = false;
+      if (popped && (buf->eoe() || buf->eof())) {
+        parked_[qid].store(true, std::memory_order_release);
+        if (num_parked_.fetch_add(1, std::memory_order_acq_rel) + 1 == num_producers_) {
+          ReleaseControl(buf->eof());
+          released = true;
+        }
+      }
+      busy_[qid].store(false, std::memory_order_release);
+      if (popped && !buf->eoe() && !buf->eof()) {
+        *result = std::move(buf);
+        return true;
+      }
+      // Stop scanning so that the released control buffer is delivered before anything that follows it.
+      if (released) {
+        return TryPopUnordered(worker_id, result);
+      }
+    }
+    return false;
+  }
+
+  // Called by the consumer that collects the last control buffer from the producers.
+  // @param eof T/F if the control buffer is EOF.
+  void ReleaseControl(bool eof) {
+    if (eof) {
+      end_of_file_ = true;
+      return;
+    }
+    // Publish the EOE before any producer queue is reopened.
+    (void)ctrl_seq_.fetch_add(1, std::memory_order_acq_rel);
+    num_parked_.store(0, std::memory_order_relaxed);
+    for (int32_t i = 0; i < num_producers_; i++) {
+      parked_[i].store(false, std::memory_order_release);
+    }
+  }
+
   // A flag to indicate the end of stream has been encountered.
-  bool end_of_file_;
+  std::atomic<bool> end_of_file_;
+
+  // The following members are only used by an unordered DbConnector.
+  // Number of EOE's released so far.
+  std::atomic<int64_t> ctrl_seq_;
+  // Number of EOE's delivered to each consumer. Each entry is only touched by its own consumer.
+  std::vector<int64_t> ctrl_seen_;
+  // A producer queue is parked once its control buffer has been popped.
+  std::vector<std::atomic<bool>> parked_;
+  // Ownership of each producer queue by a popping consumer.
+  std::vector<std::atomic<bool>> busy_;
+  std::atomic<int32_t> num_parked_;
+
+  // Profiling counters.
+  std::shared_ptr<ConnectorStats> stats_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -15,10 +15,15 @@
  */
 #include "dataset/engine/execution_tree.h"
 #include <iostream>
+#include <map>
 #include <string>
+#include <nlohmann/json.hpp>
+#include <vector>
 #include "dataset/engine/datasetops/dataset_op.h"
 #include "dataset/engine/datasetops/shuffle_op.h"
+#include "dataset/util/cpu_placement.h"
 #include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace dataset {
@@ -111,6 +116,12 @@ Status ExecutionTree::Launch() {
       // Set the state of the Operator as running. This only matters in Leaf ops, CacheOp and TakeOp
     }
   }
+  if (profiler_ != nullptr) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("Pipeline profiler", std::ref(*profiler_)));
+  }
+  if (auto_tune_ != nullptr) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("Pipeline auto tune", std::ref(*auto_tune_)));
+  }
   tree_state_ = kDeTStateExecuting;
   return Status::OK();
 }
@@ -153,6 +164,10 @@ Status ExecutionTree::Prepare() {
       " Expected state: " + std::to_string(static_cast<int>(kDeTStatePrepare));
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
+  // The worker throttles of the tuned ops must be on before their resources get registered
+  if (auto_tune_ != nullptr) {
+    auto_tune_->PrepareTree();
+  }
   // Start the recursive prepare
   RETURN_IF_NOT_OK(this->PrepareNode(root_));
   tree_state_ = kDeTStateReady;
@@ -189,6 +204,112 @@ Status ExecutionTree::PrepareNode(const std::shared_ptr<DatasetOp> &dataset_op)
   return Status::OK();
 }
 
+// Turns on the per operator profiling of this tree. Must be called before the tree is prepared.
+Status ExecutionTree::EnableProfiling(int32_t interval_ms) {
+  if (tree_state_ == kDeTStateReady || tree_state_ == kDeTStateExecuting) {
+    RETURN_STATUS_UNEXPECTED("Profiling must be enabled before the tree is prepared.");
+  }
+  if (interval_ms <= 0) {
+    RETURN_STATUS_UNEXPECTED("Profiling interval must be positive, got: " + std::to_string(interval_ms));
+  }
+  profiler_ = mindspore::make_unique<Profiler>(this, interval_ms);
+  return Status::OK();
+}
+
+// Turns on the runtime tuning of the worker counts and connector sizes of this tree.
+Status ExecutionTree::EnableAutoTune(int32_t interval_ms) {
+  if (tree_state_ == kDeTStateReady || tree_state_ == kDeTStateExecuting) {
+    RETURN_STATUS_UNEXPECTED("Auto tune must be enabled before the tree is prepared.");
+  }
+  if (interval_ms <= 0) {
+    RETURN_STATUS_UNEXPECTED("Auto tune interval must be positive, got: " + std::to_string(interval_ms));
+  }
+  auto_tune_ = mindspore::make_unique<AutoTune>(this, interval_ms);
+  return Status::OK();
+}
+
+// Pins the threads of this tree to a set of cpus.
+Status ExecutionTree::SetCpuPlacement(const std::string &policy, const std::string &reserved_cpus) {
+  if (root_ == nullptr || tree_state_ == kDeTStateExecuting) {
+    RETURN_STATUS_UNEXPECTED("Cpu placement must be set after the root is assigned and before the launch.");
+  }
+  std::vector<int32_t> allowed = CpuPlacement::AllowedCpus();
+  std::vector<int32_t> cpus;
+  if (policy == "none") {
+    cpus = allowed;
+  } else if (policy == "device") {
+    int32_t node = -1;
+    for (auto itr = this->begin(); itr != this->end() && node < 0; ++itr) {
+      node = itr->DeviceNumaNode();
+    }
+    std::map<int32_t, std::vector<int32_t>> node_cpus = CpuPlacement::NodeCpus();
+    auto found = node_cpus.find(node);
+    if (found == node_cpus.end()) {
+      MS_LOG(WARNING) << "The numa node of the device is unknown, the dataset threads are not bound to a node.";
+      cpus = allowed;
+    } else {
+      MS_LOG(INFO) << "The dataset threads run on the cpus of numa node " << node << ".";
+      cpus = found->second;
+    }
+  } else {
+    cpus = CpuPlacement::ParseCpuList(policy);
+    if (cpus.empty()) {
+      RETURN_STATUS_UNEXPECTED("Invalid cpu placement: " + policy);
+    }
+  }
+  // Only the cpus the process may run on and which are not reserved
+  cpus = CpuPlacement::Exclude(cpus, CpuPlacement::Exclude(cpus, allowed));
+  cpus = CpuPlacement::Exclude(cpus, CpuPlacement::ParseCpuList(reserved_cpus));
+  if (cpus.empty()) {
+    RETURN_STATUS_UNEXPECTED("No cpu is left for the dataset threads with the placement " + policy +
+                             " and the reserved cpus " + reserved_cpus);
+  }
+  // The threads may already run on every allowed cpu
+  tg_->set_cpus(cpus == allowed ? std::vector<int32_t>() : cpus);
+  return Status::OK();
+}
+
+// The version of the state layout
+constexpr int32_t kTreeStateVersion = 1;
+
+Status ExecutionTree::SaveState(int64_t rows, std::string *state) const {
+  if (root_ == nullptr || tree_state_ != kDeTStateExecuting) {
+    RETURN_STATUS_UNEXPECTED("The state can only be saved while the tree executes.");
+  }
+  nlohmann::json js;
+  js["version"] = kTreeStateVersion;
+  js["rows"] = rows;
+  // The root runs a single pass
+  RETURN_IF_NOT_OK(root_->SaveState(DatasetOp::Position{0, rows}, &js));
+  *state = js.dump();
+  return Status::OK();
+}
+
+Status ExecutionTree::LoadState(const std::string &state, int64_t *rows) {
+  if (tree_state_ != kDeTStateReady) {
+    RETURN_STATUS_UNEXPECTED("The state can only be loaded into a tree which is prepared and not launched.");
+  }
+  nlohmann::json js;
+  try {
+    js = nlohmann::json::parse(state);
+  } catch (const std::exception &err) {
+    RETURN_STATUS_UNEXPECTED("Invalid state of the pipeline: " + std::string(err.what()));
+  }
+  if (js.value("version", 0) != kTreeStateVersion || !js.contains("rows")) {
+    RETURN_STATUS_UNEXPECTED("The state of the pipeline is of an unknown version.");
+  }
+  try {
+    for (auto itr = this->begin(); itr != this->end(); ++itr) {
+      RETURN_IF_NOT_OK(itr->LoadState(js));
+    }
+    *rows = js["rows"].get<int64_t>();
+  } catch (const std::exception &err) {
+    RETURN_STATUS_UNEXPECTED("Invalid state of the pipeline: " + std::string(err.what()));
+  }
+  MS_LOG(INFO) << "Execution tree resumes after " << *rows << " rows.";
+  return Status::OK();
+}
+
 // Adds an operator to the repeat stack during prepare phase.
 void ExecutionTree::AddToRepeatStack(std::shared_ptr<DatasetOp> dataset_op) { repeat_stack_.push(dataset_op); }
 
@@ -21,6 +21,8 @@
 #include <stack>
 #include <vector>
 #include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/engine/perf/auto_tune.h"
+#include "dataset/engine/perf/profiling.h"
 #include "dataset/util/status.h"
 
 namespace mindspore {
@@ -177,6 +179,46 @@ class ExecutionTree {
   // @return raw pointer to the TaskGroup
   TaskGroup *AllTasks() const { return tg_.get(); }
 
+  // Turns on the per operator profiling of this tree. Must be called before the tree is prepared.
+  // @param interval_ms - The sampling interval in milli seconds
+  // @return Status - The error code return
+  Status EnableProfiling(int32_t interval_ms);
+
+  // Getter method
+  // @return raw pointer to the profiler, or nullptr if the profiling is off
+  Profiler *profiler() const { return profiler_.get(); }
+
+  // Turns on the runtime tuning of the worker counts and connector sizes of this tree during the first
+  // epoch. Must be called before the tree is prepared.
+  // @param interval_ms - The sampling interval in milli seconds
+  // @return Status - The error code return
+  Status EnableAutoTune(int32_t interval_ms);
+
+  // Getter method
+  // @return raw pointer to the auto tune, or nullptr if the auto tune is off
+  AutoTune *auto_tune() const { return auto_tune_.get(); }
+
+  // Pins the threads of this tree to a set of cpus. Must be called after the root is assigned and before the
+  // tree is launched.
+  // @param policy - "none" for all the cpus, "device" for the cpus of the numa node of the device the tree feeds,
+  //     or a cpu list such as "0-15,32-47"
+  // @param reserved_cpus - A cpu list the threads never run on, e.g. the cpus of the compute kernels
+  // @return Status - The error code return
+  Status SetCpuPlacement(const std::string &policy, const std::string &reserved_cpus);
+
+  // Saves the state of the operators for the consumer of the root, so that the same pipeline can resume from
+  // there in a new tree. See DatasetOp::SaveState.
+  // @param rows - The rows the consumer took from the root
+  // @param state - The serialized state
+  // @return Status - The error code return, an error if an operator of the tree can not save its state
+  Status SaveState(int64_t rows, std::string *state) const;
+
+  // Restores a state saved by SaveState. Must be called after the tree is prepared and before it is launched.
+  // @param state - The serialized state
+  // @param rows - The rows the consumer already took from the root, where it resumes its count
+  // @return Status - The error code return
+  Status LoadState(const std::string &state, int64_t *rows);
+
  private:
   std::unique_ptr<TaskGroup> tg_;                        // Class for worker management
   std::shared_ptr<DatasetOp> root_;                      // The root node of the tree
@@ -184,6 +226,8 @@ class ExecutionTree {
   uint32_t prepare_flags_;                               // Flags used during tree prepare
   TreeState tree_state_;                                 // Tracking the current tree state
   std::stack<std::shared_ptr<DatasetOp>> repeat_stack_;  // A stack used during prepare phase
+  std::unique_ptr<Profiler> profiler_;                   // Pipeline profiler, only when profiling is enabled
+  std::unique_ptr<AutoTune> auto_tune_;                  // Runtime tuning, only when auto tune is enabled
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/perf/auto_tune.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/engine/datasetops/parallel_op.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/engine/perf/connector_stats.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// The tuning thread never sleeps longer than this at once, so it notices an interrupt quickly.
+constexpr int32_t kAutoTuneSliceMs = 10;
+}  // namespace
+
+// Constructor
+AutoTune::AutoTune(ExecutionTree *tree, int32_t interval_ms) : tree_(tree), interval_ms_(interval_ms), samples_(0) {}
+
+// Turns on the worker throttle of the tunable ops
+void AutoTune::PrepareTree() {
+  ops_.clear();
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    std::shared_ptr<DatasetOp> op = itr.get();
+    auto parallel_op = std::dynamic_pointer_cast<ParallelOp>(op);
+    if (parallel_op == nullptr || !parallel_op->AutoTunable() || parallel_op->num_workers() <= 1) {
+      continue;
+    }
+    parallel_op->EnableWorkerThrottle();
+    DatasetOp *child = op->child_.empty() ? nullptr : op->child_[0].get();
+    ops_.push_back({parallel_op.get(), child, 0.0, 0.0, 0, 0});
+  }
+}
+
+// The entry point of the tuning thread
+Status AutoTune::operator()() {
+  TaskManager::FindMe()->Post();
+  while (!ops_.empty()) {
+    int32_t slept_ms = 0;
+    while (slept_ms < interval_ms_) {
+      if (this_thread::is_interrupted()) {
+        return Status::OK();
+      }
+      int32_t slice = std::min(kAutoTuneSliceMs, interval_ms_ - slept_ms);
+      std::this_thread::sleep_for(std::chrono::milliseconds(slice));
+      slept_ms += slice;
+    }
+    if (FirstEpochDone()) {
+      break;
+    }
+    Step();
+  }
+  for (const auto &t : ops_) {
+    DbConnector *out = t.op->out_connector_.get();
+    MS_LOG(INFO) << "Auto tune settled " << t.op->Name() << "(" << t.op->id() << ") on " << t.op->active_workers()
+                 << " of " << t.op->num_workers() << " workers and a connector size of "
+                 << ((out != nullptr) ? out->queue_capacity() : 0) << ".";
+  }
+  return Status::OK();
+}
+
+// Samples the connectors and, at the end of a window, tunes the ops
+void AutoTune::Step() {
+  for (auto &t : ops_) {
+    // A missing connector gives no signal. Count it as half full so that it never triggers a decision.
+    double in_occupancy = 0.5;
+    DbConnector *in = (t.child != nullptr) ? t.child->out_connector_.get() : nullptr;
+    if (in != nullptr && in->capacity() > 0) {
+      in_occupancy = static_cast<double>(in->size()) / in->capacity();
+    }
+    double out_occupancy = 0.5;
+    int32_t depth = 0;
+    DbConnector *out = t.op->out_connector_.get();
+    if (out != nullptr && out->capacity() > 0) {
+      depth = out->size();
+      out_occupancy = static_cast<double>(depth) / out->capacity();
+    }
+    if (samples_ == 0) {
+      t.in_occupancy = 0.0;
+      t.out_occupancy = 0.0;
+      t.min_depth = depth;
+      t.max_depth = depth;
+    }
+    t.in_occupancy += in_occupancy;
+    t.out_occupancy += out_occupancy;
+    t.min_depth = std::min(t.min_depth, depth);
+    t.max_depth = std::max(t.max_depth, depth);
+  }
+  if (++samples_ < kAutoTuneWindow) {
+    return;
+  }
+  for (auto &t : ops_) {
+    Tune(&t);
+  }
+  samples_ = 0;
+}
+
+// Applies one tuning decision on an op at the end of a window
+void AutoTune::Tune(TunedOp *t) {
+  double in_occupancy = t->in_occupancy / kAutoTuneWindow;
+  double out_occupancy = t->out_occupancy / kAutoTuneWindow;
+  int32_t active = t->op->active_workers();
+  if (in_occupancy >= kAutoTuneHighWater && out_occupancy <= kAutoTuneLowWater) {
+    t->op->set_active_workers(active + 1);
+  } else if (in_occupancy <= kAutoTuneLowWater && out_occupancy >= kAutoTuneHighWater) {
+    t->op->set_active_workers(active - 1);
+  }
+  DbConnector *out = t->op->out_connector_.get();
+  if (out != nullptr && t->min_depth == 0 && t->max_depth >= out->capacity()) {
+    int32_t queue_capacity = out->queue_capacity();
+    if (queue_capacity < out->max_queue_capacity()) {
+      out->set_queue_capacity(queue_capacity * 2);
+    }
+  }
+  if (t->op->active_workers() != active) {
+    MS_LOG(DEBUG) << "Auto tune " << t->op->Name() << "(" << t->op->id() << "): input " << in_occupancy
+                  << ", output " << out_occupancy << ", active workers " << active << " -> "
+                  << t->op->active_workers() << ".";
+  }
+}
+
+// @return T/F if every tuned op has produced an end of epoch
+bool AutoTune::FirstEpochDone() const {
+  for (const auto &t : ops_) {
+    DbConnector *out = t.op->out_connector_.get();
+    if (out != nullptr && out->stats() != nullptr && out->stats()->eoes() == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace dataset
+}  // namespace mindspore
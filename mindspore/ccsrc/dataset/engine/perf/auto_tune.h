@@ -0,0 +1,93 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <cstdint>
+#include <vector>
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declares
+class ExecutionTree;
+class DatasetOp;
+class ParallelOp;
+
+// The output connectors of a tuned tree allocate this many times their configured size, so that they can grow.
+constexpr int32_t kAutoTuneConnectorGrowth = 4;
+// Number of samples averaged before each tuning decision.
+constexpr int32_t kAutoTuneWindow = 5;
+// A connector above this occupancy is considered full, below kAutoTuneLowWater it is considered starved.
+constexpr double kAutoTuneHighWater = 0.75;
+constexpr double kAutoTuneLowWater = 0.25;
+
+// Runtime tuning of the worker counts and the connector sizes of an ExecutionTree.
+// During the first epoch, the occupancy of the input and output connectors of every tunable ParallelOp
+// (see ParallelOp::AutoTunable) is sampled at a fixed interval. At the end of each window:
+//  - An op with a full input and a starved output is the bottleneck and gets one more active worker.
+//  - An op with a starved input and a full output is over provisioned and gives one worker back, so that
+//    the host cores are left to the ops which need them.
+//  - An output connector which went from empty to full within the window is bursty and doubles its size.
+// The op's num_workers is the upper bound of its active workers, and the connector can grow up to
+// kAutoTuneConnectorGrowth times the configured op_connector_size. Tuning stops once every tuned op has
+// produced its first end of epoch and the final settings are kept for the following epochs.
+class AutoTune {
+ public:
+  // Constructor
+  // @param tree - The tree to tune. No ownership.
+  // @param interval_ms - The sampling interval in milli seconds.
+  AutoTune(ExecutionTree *tree, int32_t interval_ms);
+
+  ~AutoTune() = default;
+
+  // Turns on the worker throttle of the tunable ops. Called by the tree before the prepare phase.
+  void PrepareTree();
+
+  // The entry point of the tuning thread. It runs until the first epoch is over or the tree is interrupted.
+  // @return Status - The error code return
+  Status operator()();
+
+ private:
+  // The tuning state of one op
+  struct TunedOp {
+    ParallelOp *op;        // The op to tune
+    DatasetOp *child;      // Its first child, nullptr for a leaf
+    double in_occupancy;   // Sum of the input occupancy samples of the window
+    double out_occupancy;  // Sum of the output occupancy samples of the window
+    int32_t min_depth;     // The lowest output depth seen in the window
+    int32_t max_depth;     // The highest output depth seen in the window
+  };
+
+  // Samples the connectors and, at the end of a window, tunes the ops.
+  void Step();
+
+  // Applies one tuning decision on an op at the end of a window.
+  // @param t - The op and its samples
+  void Tune(TunedOp *t);
+
+  // @return T/F if every tuned op has produced an end of epoch
+  bool FirstEpochDone() const;
+
+  ExecutionTree *tree_;
+  int32_t interval_ms_;
+  int32_t samples_;  // Samples taken in the current window
+  std::vector<TunedOp> ops_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_PERF_AUTO_TUNE_H_
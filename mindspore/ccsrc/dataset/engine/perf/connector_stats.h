@@ -0,0 +1,125 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_PERF_CONNECTOR_STATS_H_
+#define DATASET_ENGINE_PERF_CONNECTOR_STATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace dataset {
+// Counters collected by a DbConnector while the pipeline is profiled.
+// The producer side tells how long the workers of the producing op were blocked in Add(), and how many rows
+// they produced. The consumer side tells how long the workers of the consuming op were blocked in Pop().
+// All the counters are updated with relaxed atomics since each worker only touches its own slot.
+class ConnectorStats {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Constructor
+  // @param num_producers - number of threads that write into the connector
+  // @param num_consumers - number of threads that read from the connector
+  ConnectorStats(int32_t num_producers, int32_t num_consumers)
+      : push_us_(num_producers), rows_(num_producers), buffers_(num_producers), pop_us_(num_consumers), eoes_(0) {
+    Reset();
+  }
+
+  ~ConnectorStats() = default;
+
+  // Records one Add() call of a producer.
+  // @param producer_id - The worker id of the producer
+  // @param start - When the producer started to wait
+  // @param rows - The number of rows in the added buffer
+  void RecordPush(int32_t producer_id, const Clock::time_point &start, int64_t rows) {
+    if (producer_id < 0 || producer_id >= static_cast<int32_t>(push_us_.size())) {
+      return;
+    }
+    (void)push_us_[producer_id].fetch_add(ElapsedUs(start), std::memory_order_relaxed);
+    (void)rows_[producer_id].fetch_add(rows, std::memory_order_relaxed);
+    (void)buffers_[producer_id].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Records one Pop() call of a consumer.
+  // @param consumer_id - The worker id of the consumer
+  // @param start - When the consumer started to wait
+  void RecordPop(int32_t consumer_id, const Clock::time_point &start) {
+    if (consumer_id < 0 || consumer_id >= static_cast<int32_t>(pop_us_.size())) {
+      return;
+    }
+    (void)pop_us_[consumer_id].fetch_add(ElapsedUs(start), std::memory_order_relaxed);
+  }
+
+  // Records an end of epoch buffer going through the connector.
+  void RecordEoe() { (void)eoes_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Clears all the counters.
+  void Reset() {
+    eoes_ = 0;
+    for (size_t i = 0; i < push_us_.size(); i++) {
+      push_us_[i] = 0;
+      rows_[i] = 0;
+      buffers_[i] = 0;
+    }
+    for (size_t i = 0; i < pop_us_.size(); i++) {
+      pop_us_[i] = 0;
+    }
+  }
+
+  int32_t num_producers() const { return static_cast<int32_t>(push_us_.size()); }
+
+  int32_t num_consumers() const { return static_cast<int32_t>(pop_us_.size()); }
+
+  // @return Total time in micro seconds the producer was blocked in Add()
+  int64_t push_us(int32_t producer_id) const { return push_us_[producer_id].load(std::memory_order_relaxed); }
+
+  // @return Total number of rows added by the producer
+  int64_t rows(int32_t producer_id) const { return rows_[producer_id].load(std::memory_order_relaxed); }
+
+  // @return Total number of buffers added by the producer
+  int64_t buffers(int32_t producer_id) const { return buffers_[producer_id].load(std::memory_order_relaxed); }
+
+  // @return Total time in micro seconds the consumer was blocked in Pop()
+  int64_t pop_us(int32_t consumer_id) const { return pop_us_[consumer_id].load(std::memory_order_relaxed); }
+
+  // @return Number of end of epoch buffers added by all the producers
+  int64_t eoes() const { return eoes_.load(std::memory_order_relaxed); }
+
+  // @return Total number of rows added by all the producers
+  int64_t total_rows() const {
+    int64_t total = 0;
+    for (size_t i = 0; i < rows_.size(); i++) {
+      total += rows(static_cast<int32_t>(i));
+    }
+    return total;
+  }
+
+ private:
+  static int64_t ElapsedUs(const Clock::time_point &start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  }
+
+  std::vector<std::atomic<int64_t>> push_us_;
+  std::vector<std::atomic<int64_t>> rows_;
+  std::vector<std::atomic<int64_t>> buffers_;
+  std::vector<std::atomic<int64_t>> pop_us_;
+  std::atomic<int64_t> eoes_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_PERF_CONNECTOR_STATS_H_
@@ -0,0 +1,199 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/perf/profiling.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+#include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/engine/perf/connector_stats.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// The sampler never sleeps longer than this at once, so it notices an interrupt quickly.
+constexpr int32_t kSamplerSliceMs = 10;
+
+double UsToMs(int64_t us) { return static_cast<double>(us) / 1000.0; }
+}  // namespace
+
+// Constructor
+Profiler::Profiler(ExecutionTree *tree, int32_t interval_ms)
+    : tree_(tree), interval_ms_(interval_ms), start_(Clock::now()) {}
+
+// The entry point of the sampler thread.
+Status Profiler::operator()() {
+  TaskManager::FindMe()->Post();
+  start_ = Clock::now();
+  while (true) {
+    int32_t slept_ms = 0;
+    while (slept_ms < interval_ms_) {
+      if (this_thread::is_interrupted()) {
+        // Take a last sample so that the summary reflects the end of the run.
+        Sample();
+        return Status::OK();
+      }
+      int32_t slice = std::min(kSamplerSliceMs, interval_ms_ - slept_ms);
+      std::this_thread::sleep_for(std::chrono::milliseconds(slice));
+      slept_ms += slice;
+    }
+    Sample();
+  }
+}
+
+int64_t Profiler::ElapsedUs() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_).count();
+}
+
+// Takes one sample of all the operators of the tree.
+void Profiler::Sample() {
+  TreeSample sample;
+  sample.timestamp_us = ElapsedUs();
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    OpSample op_sample = {0, 0};
+    DbConnector *connector = itr->out_connector_.get();
+    if (connector != nullptr) {
+      op_sample.queue_depth = connector->size();
+      if (connector->stats() != nullptr) {
+        op_sample.rows = connector->stats()->total_rows();
+      }
+    }
+    sample.ops.push_back(op_sample);
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  if (samples_.size() >= kProfilerMaxSamples) {
+    (void)samples_.erase(samples_.begin());
+  }
+  samples_.push_back(std::move(sample));
+}
+
+// Writes the per operator summary and all the samples as json.
+Status Profiler::DumpJson(const std::string &path) {
+  int64_t duration_us = ElapsedUs();
+  nlohmann::json js;
+  js["samplingIntervalMs"] = interval_ms_;
+  js["durationMs"] = UsToMs(duration_us);
+  std::unique_lock<std::mutex> lck(mux_);
+  std::vector<double> timestamps;
+  for (const auto &sample : samples_) {
+    timestamps.push_back(UsToMs(sample.timestamp_us));
+  }
+  js["timestampsMs"] = timestamps;
+  nlohmann::json ops = nlohmann::json::array();
+  int32_t op_index = 0;
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr, ++op_index) {
+    nlohmann::json op;
+    op["opId"] = itr->id();
+    op["opType"] = itr->Name();
+    op["numWorkers"] = itr->num_workers();
+    op["parentId"] = itr->parent_.empty() ? -1 : itr->parent_[0]->id();
+    std::vector<int32_t> children;
+    for (const auto &c : itr->child_) {
+      children.push_back(c->id());
+    }
+    op["childrenId"] = children;
+    std::vector<int32_t> depth;
+    for (const auto &sample : samples_) {
+      if (op_index < sample.ops.size()) {
+        depth.push_back(sample.ops[op_index].queue_depth);
+      }
+    }
+    op["queueDepth"] = depth;
+    DbConnector *out = itr->out_connector_.get();
+    op["queueCapacity"] = (out != nullptr) ? out->capacity() : 0;
+    std::shared_ptr<ConnectorStats> out_stats = (out != nullptr) ? out->stats() : nullptr;
+    std::shared_ptr<ConnectorStats> in_stats = nullptr;
+    if (!itr->child_.empty() && itr->child_[0]->out_connector_ != nullptr) {
+      in_stats = itr->child_[0]->out_connector_->stats();
+    }
+    int64_t rows = (out_stats != nullptr) ? out_stats->total_rows() : 0;
+    op["rows"] = rows;
+    op["rowsPerSec"] = (duration_us > 0) ? rows * 1000000.0 / duration_us : 0.0;
+    // Worker i of an op is both producer i of its own connector and consumer i of its child's connector.
+    int32_t num_threads = std::max(out_stats != nullptr ? out_stats->num_producers() : 0,
+                                   in_stats != nullptr ? in_stats->num_consumers() : 0);
+    nlohmann::json workers = nlohmann::json::array();
+    for (int32_t i = 0; i < num_threads; i++) {
+      int64_t pop_us = (in_stats != nullptr && i < in_stats->num_consumers()) ? in_stats->pop_us(i) : 0;
+      int64_t push_us = (out_stats != nullptr && i < out_stats->num_producers()) ? out_stats->push_us(i) : 0;
+      nlohmann::json worker;
+      worker["workerId"] = i;
+      worker["popWaitMs"] = UsToMs(pop_us);
+      worker["pushWaitMs"] = UsToMs(push_us);
+      worker["computeMs"] = UsToMs(std::max<int64_t>(duration_us - pop_us - push_us, 0));
+      worker["rows"] = (out_stats != nullptr && i < out_stats->num_producers()) ? out_stats->rows(i) : 0;
+      workers.push_back(worker);
+    }
+    op["workers"] = workers;
+    ops.push_back(op);
+  }
+  js["ops"] = ops;
+  std::ofstream o(path, std::ios::out | std::ios::trunc);
+  if (!o.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open the profiling file: " + path);
+  }
+  o << js.dump(2) << std::endl;
+  o.close();
+  return Status::OK();
+}
+
+// Writes the samples as counter events in the chrome trace event format.
+Status Profiler::DumpChromeTrace(const std::string &path) {
+  nlohmann::json events = nlohmann::json::array();
+  std::vector<std::string> names;
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    std::string name = itr->Name() + "(" + std::to_string(itr->id()) + ")";
+    names.push_back(name);
+    nlohmann::json meta;
+    meta["name"] = "thread_name";
+    meta["ph"] = "M";
+    meta["pid"] = 0;
+    meta["tid"] = itr->id();
+    meta["args"]["name"] = name;
+    events.push_back(meta);
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  for (const auto &sample : samples_) {
+    for (size_t i = 0; i < sample.ops.size() && i < names.size(); i++) {
+      nlohmann::json ev;
+      ev["name"] = names[i];
+      ev["ph"] = "C";
+      ev["ts"] = sample.timestamp_us;
+      ev["pid"] = 0;
+      ev["args"]["queueDepth"] = sample.ops[i].queue_depth;
+      ev["args"]["rows"] = sample.ops[i].rows;
+      events.push_back(ev);
+    }
+  }
+  nlohmann::json js;
+  js["traceEvents"] = events;
+  js["displayTimeUnit"] = "ms";
+  std::ofstream o(path, std::ios::out | std::ios::trunc);
+  if (!o.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open the trace file: " + path);
+  }
+  o << js.dump() << std::endl;
+  o.close();
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
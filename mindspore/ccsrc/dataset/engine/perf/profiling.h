@@ -0,0 +1,98 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_PERF_PROFILING_H_
+#define DATASET_ENGINE_PERF_PROFILING_H_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declares
+class ExecutionTree;
+class DatasetOp;
+
+// The maximum number of samples kept by the profiler. Older samples are dropped beyond this.
+constexpr int32_t kProfilerMaxSamples = 100000;
+
+// Per operator profiler of an ExecutionTree.
+// Once enabled, every output connector created during the tree prepare phase carries a set of ConnectorStats, so
+// the time each worker is blocked on its input and on its output is accumulated as the pipeline runs. A sampler
+// thread launched with the tree records the depth of every connector and the cumulative number of rows produced
+// by every operator at a fixed interval.
+// The result can be written as a json summary (DumpJson) or as a chrome://tracing file (DumpChromeTrace).
+class Profiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Constructor
+  // @param tree - The tree to profile. No ownership.
+  // @param interval_ms - The sampling interval in milli seconds.
+  Profiler(ExecutionTree *tree, int32_t interval_ms);
+
+  ~Profiler() = default;
+
+  // The entry point of the sampler thread. It runs until the tree is interrupted.
+  // @return Status - The error code return
+  Status operator()();
+
+  // Takes one sample of all the operators of the tree.
+  void Sample();
+
+  // Writes the per operator summary and all the samples as json.
+  // @param path - The file to write
+  // @return Status - The error code return
+  Status DumpJson(const std::string &path);
+
+  // Writes the samples as counter events in the chrome trace event format.
+  // @param path - The file to write
+  // @return Status - The error code return
+  Status DumpChromeTrace(const std::string &path);
+
+  // Getter
+  // @return The sampling interval in milli seconds
+  int32_t interval_ms() const { return interval_ms_; }
+
+ private:
+  // One sample of one operator
+  struct OpSample {
+    int32_t queue_depth;  // Number of buffers waiting in the output connector
+    int64_t rows;         // Cumulative number of rows produced
+  };
+
+  // One sample of all the operators of the tree, in the tree iterator order.
+  struct TreeSample {
+    int64_t timestamp_us;  // Since the profiler started
+    std::vector<OpSample> ops;
+  };
+
+  // @return Micro seconds passed since the profiler started
+  int64_t ElapsedUs() const;
+
+  ExecutionTree *tree_;
+  int32_t interval_ms_;
+  Clock::time_point start_;
+  std::mutex mux_;
+  std::vector<TreeSample> samples_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_PERF_PROFILING_H_
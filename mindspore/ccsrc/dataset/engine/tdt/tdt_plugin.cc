@@ -36,6 +36,10 @@ TdtStatus TdtPlugin::hostPush(TensorRow ts_row, bool is_wait, std::string channe
     MS_LOG(ERROR) << "TDT converting tensor failed!";
     return FAILED;
   }
+  return hostPush(items, channel_name);
+}
+
+TdtStatus TdtPlugin::hostPush(const std::vector<DataItem> &items, const std::string &channel_name) {
   if (tdt::TdtHostPushData(channel_name, items) != 0) {
     MS_LOG(ERROR) << "TDT pushing data failed!";
     return FAILED;
@@ -110,7 +114,7 @@ TdtStatus TdtPlugin::translate(const TensorRow &ts_row, std::vector<DataItem> &i
     data_item.tensorShape_ = dataShapes;
     data_item.tensorType_ = datatype;
     data_item.dataLen_ = ts->SizeInBytes();
-    data_item.dataPtr_ = std::shared_ptr<void>(reinterpret_cast<void *>(ts->StartAddr()), [](void *elem) {});
+    data_item.dataPtr_ = std::shared_ptr<void>(reinterpret_cast<void *>(ts->StartAddr()), [ts](void *elem) {});
     items.emplace_back(data_item);
     MS_LOG(INFO) << "TDT data type is " << datatype << ", data shape is " << dataShapes << ", data length is "
                  << ts->Size() << ".";
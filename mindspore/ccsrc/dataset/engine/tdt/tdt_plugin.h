@@ -39,13 +39,17 @@ class TdtPlugin {
 
   TdtStatus hostPush(TensorRow ts_row, bool is_wait, std::string channel_name);
 
+  // Push the items translated before, it blocks while the channel is full.
+  TdtStatus hostPush(const std::vector<DataItem> &items, const std::string &channel_name);
+
+  // The items hand the buffers of the tensors over without a copy, they keep the tensors alive until TDT drops them.
+  TdtStatus translate(const TensorRow &ts_row, std::vector<DataItem> &items);
+
  private:
   TdtPlugin() {}
 
   TdtStatus getTdtType(DataType d_type, std::string &datatype);
 
-  TdtStatus translate(const TensorRow &ts_row, std::vector<DataItem> &items);
-
   void *tdt_handle_ = nullptr;
 };
 }  // namespace dataset
@@ -15,6 +15,7 @@
  */
 
 #include "dataset/kernels/data/data_utils.h"
+#include <algorithm>
 #include <vector>
 #include "dataset/core/constants.h"
 #include "dataset/core/tensor.h"
@@ -104,6 +105,72 @@ Status OneHotEncoding(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *ou
   }
 }
 
+namespace {
+template <typename T>
+Status BatchOneHotKernel(const std::shared_ptr<Tensor> &input, const std::shared_ptr<Tensor> &output,
+                         dsize_t num_classes) {
+  const T *in = reinterpret_cast<const T *>(input->StartAddr());
+  T *out = reinterpret_cast<T *>(output->StartAddr());
+  if (in == nullptr || out == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Failed to create memory for Tensor.");
+  }
+  dsize_t num_rows = input->Size();
+  for (dsize_t i = 0; i < num_rows; i++) {
+    // Negative signed labels become large unsigned ones
+    uint64_t class_idx = static_cast<uint64_t>(in[i]);
+    if (class_idx >= static_cast<uint64_t>(num_classes)) {
+      RETURN_STATUS_UNEXPECTED("One_hot index values are not in range");
+    }
+    out[i * num_classes + static_cast<dsize_t>(class_idx)] = 1;
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status BatchOneHotEncoding(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                           dsize_t num_classes) {
+  if (!(input->Rank() == 1 || (input->Rank() == 2 && input->shape()[1] == 1))) {
+    RETURN_STATUS_UNEXPECTED("Batch one hot only supports batches of scalars.");
+  }
+  if (!input->type().IsInt()) {
+    RETURN_STATUS_UNEXPECTED("One hot does not support input of this type.");
+  }
+  std::shared_ptr<Tensor> out;
+  TensorShape out_shape({input->shape()[0], num_classes});
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, TensorImpl::kFlexible, out_shape, input->type()));
+  RETURN_IF_NOT_OK(out->Zero());
+  switch (input->type().value()) {
+    case DataType::DE_INT8:
+      RETURN_IF_NOT_OK(BatchOneHotKernel<int8_t>(input, out, num_classes));
+      break;
+    case DataType::DE_UINT8:
+      RETURN_IF_NOT_OK(BatchOneHotKernel<uint8_t>(input, out, num_classes));
+      break;
+    case DataType::DE_INT16:
+      RETURN_IF_NOT_OK(BatchOneHotKernel<int16_t>(input, out, num_classes));
+      break;
+    case DataType::DE_UINT16:
+      RETURN_IF_NOT_OK(BatchOneHotKernel<uint16_t>(input, out, num_classes));
+      break;
+    case DataType::DE_INT32:
+      RETURN_IF_NOT_OK(BatchOneHotKernel<int32_t>(input, out, num_classes));
+      break;
+    case DataType::DE_UINT32:
+      RETURN_IF_NOT_OK(BatchOneHotKernel<uint32_t>(input, out, num_classes));
+      break;
+    case DataType::DE_INT64:
+      RETURN_IF_NOT_OK(BatchOneHotKernel<int64_t>(input, out, num_classes));
+      break;
+    case DataType::DE_UINT64:
+      RETURN_IF_NOT_OK(BatchOneHotKernel<uint64_t>(input, out, num_classes));
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("One hot does not support input of this type.");
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
 template <typename FROM, typename TO>
 void Cast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   auto in_itr = input->begin<FROM>();
@@ -160,7 +227,11 @@ void CastFrom(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 
 // Type cast operator
 Status TypeCast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const DataType &data_type) {
-  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), data_type));
+  // Cast into the given view when it fits
+  if (*output == nullptr || (*output)->view_base() == nullptr || (*output)->shape() != input->shape() ||
+      (*output)->type() != data_type) {
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), data_type));
+  }
 
   static_cast<void>((*output)->StartAddr());
   switch (input->type().value()) {
@@ -210,7 +281,10 @@ Status TypeCast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *o
 Status ToFloat16(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   // initiate new tensor for type cast
   DataType new_type = DataType("float16");
-  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), new_type));
+  if (*output == nullptr || (*output)->view_base() == nullptr || (*output)->shape() != input->shape() ||
+      (*output)->type() != new_type) {
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), new_type));
+  }
   static_cast<void>((*output)->StartAddr());
 
   auto in_itr = input->begin<float>();
@@ -220,5 +294,129 @@ Status ToFloat16(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
 
   return Status::OK();
 }
+namespace {
+template <typename T>
+void FillAs(const std::shared_ptr<Tensor> &tensor, float value) {
+  T *data = reinterpret_cast<T *>(tensor->StartAddr());
+  std::fill(data, data + tensor->Size(), static_cast<T>(value));
+}
+
+Status FillWithValue(const std::shared_ptr<Tensor> &tensor, float value) {
+  switch (tensor->type().value()) {
+    case DataType::DE_BOOL:
+      FillAs<bool>(tensor, value);
+      break;
+    case DataType::DE_INT8:
+      FillAs<int8_t>(tensor, value);
+      break;
+    case DataType::DE_UINT8:
+      FillAs<uint8_t>(tensor, value);
+      break;
+    case DataType::DE_INT16:
+      FillAs<int16_t>(tensor, value);
+      break;
+    case DataType::DE_UINT16:
+      FillAs<uint16_t>(tensor, value);
+      break;
+    case DataType::DE_INT32:
+      FillAs<int32_t>(tensor, value);
+      break;
+    case DataType::DE_UINT32:
+      FillAs<uint32_t>(tensor, value);
+      break;
+    case DataType::DE_INT64:
+      FillAs<int64_t>(tensor, value);
+      break;
+    case DataType::DE_UINT64:
+      FillAs<uint64_t>(tensor, value);
+      break;
+    case DataType::DE_FLOAT16:
+      FillAs<float16>(tensor, value);
+      break;
+    case DataType::DE_FLOAT32:
+      FillAs<float>(tensor, value);
+      break;
+    case DataType::DE_FLOAT64:
+      FillAs<double>(tensor, value);
+      break;
+    case DataType::DE_UNKNOWN:
+      RETURN_STATUS_UNEXPECTED("BatchPad does not support input of this type.");
+  }
+  return Status::OK();
+}
+
+// Copies a row into the front of a padded slot, one memcpy per run of the last dim.
+// The strides are in bytes, the last one is the size of the type.
+void CopyIntoPadded(const uchar *src, const std::vector<dsize_t> &src_shape, const std::vector<dsize_t> &src_strides,
+                    uchar *dst, const std::vector<dsize_t> &dst_strides, size_t dim) {
+  if (dim + 1 >= src_shape.size()) {
+    dsize_t bytes = src_shape.empty() ? src_strides.back() : src_shape[dim] * src_strides[dim];
+    (void)memcpy_s(dst, static_cast<size_t>(bytes), src, static_cast<size_t>(bytes));
+    return;
+  }
+  for (dsize_t i = 0; i < src_shape[dim]; i++) {
+    CopyIntoPadded(src + i * src_strides[dim], src_shape, src_strides, dst + i * dst_strides[dim], dst_strides,
+                   dim + 1);
+  }
+}
+
+// @return The strides in bytes of a row major shape, with one more entry for a rank of 0
+std::vector<dsize_t> ByteStrides(const std::vector<dsize_t> &shape, dsize_t type_size) {
+  std::vector<dsize_t> strides(std::max<size_t>(shape.size(), 1), type_size);
+  for (size_t i = shape.size(); i > 1; i--) {
+    strides[i - 2] = strides[i - 1] * shape[i - 1];
+  }
+  return strides;
+}
+}  // namespace
+
+Status BatchPad(const std::vector<std::shared_ptr<Tensor>> &rows, const TensorShape &pad_shape, float pad_value,
+                std::shared_ptr<Tensor> *output) {
+  if (rows.empty()) {
+    RETURN_STATUS_UNEXPECTED("BatchPad needs at least one row.");
+  }
+  const DataType type = rows[0]->type();
+  const dsize_t rank = rows[0]->Rank();
+  if (pad_shape.known() || pad_shape.Rank() > 0) {
+    CHECK_FAIL_RETURN_UNEXPECTED(pad_shape.Rank() == rank, "The rank of the pad shape " + pad_shape.ToString() +
+                                                             " does not match the rows " +
+                                                             rows[0]->shape().ToString());
+  }
+  // The unknown dims are padded to the largest of the rows
+  std::vector<dsize_t> shape(static_cast<size_t>(rank), 0);
+  for (const std::shared_ptr<Tensor> &row : rows) {
+    CHECK_FAIL_RETURN_UNEXPECTED(row->type() == type && row->Rank() == rank,
+                                 "The rows to pad have different types or ranks.");
+    for (dsize_t i = 0; i < rank; i++) {
+      shape[i] = std::max(shape[i], row->shape()[i]);
+    }
+  }
+  for (dsize_t i = 0; i < pad_shape.Rank(); i++) {
+    if (pad_shape[i] != TensorShape::kDimUnknown) {
+      CHECK_FAIL_RETURN_UNEXPECTED(shape[i] <= pad_shape[i], "A row is larger than the pad shape " +
+                                                                pad_shape.ToString());
+      shape[i] = pad_shape[i];
+    }
+  }
+  TensorShape padded(shape);
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible,
+                                        padded.PrependDim(static_cast<dsize_t>(rows.size())), type));
+  if (pad_value == 0) {
+    RETURN_IF_NOT_OK((*output)->Zero());
+  } else {
+    RETURN_IF_NOT_OK(FillWithValue(*output, pad_value));
+  }
+  std::vector<dsize_t> dst_strides = ByteStrides(shape, type.SizeInBytes());
+  dsize_t slot_bytes = padded.NumOfElements() * type.SizeInBytes();
+  uchar *dst = (*output)->StartAddr();
+  for (const std::shared_ptr<Tensor> &row : rows) {
+    std::vector<dsize_t> src_shape = row->shape().AsVector();
+    if (row->Size() > 0) {
+      CopyIntoPadded(row->StartAddr(), src_shape, ByteStrides(src_shape, type.SizeInBytes()), dst, dst_strides, 0);
+    }
+    dst += slot_bytes;
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -36,6 +36,13 @@ namespace dataset {
 // @param num_classes: Number of classes to.
 Status OneHotEncoding(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, dsize_t num_classes);
 
+// Returns the one hot encoding of a batch of labels.
+// @param input: Tensor of shape <N> or <N,1> and any int type, one label per row of the batch.
+// @param output: Tensor. The shape of the output tensor is <N, numClasses> and the type is same as input.
+// @param num_classes: Number of classes to.
+Status BatchOneHotEncoding(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                           dsize_t num_classes);
+
 Status OneHotEncodingUnsigned(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                               dsize_t num_classes, int64_t index);
 
@@ -48,6 +55,7 @@ Status OneHotEncodingSigned(const std::shared_ptr<Tensor> &input, std::shared_pt
 // @param output Tensor. The shape of the output tensor is same as input with the type changed.
 // @param data_type: type of data to cast data to
 // @note: this operation will do a memcpy and if the value is truncated then precision will be lost
+// @note: the result is written into *output when it already holds a view of the right shape and type
 
 template <typename T>
 void CastFrom(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
@@ -58,6 +66,15 @@ void Cast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output)
 Status ToFloat16(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
 
 Status TypeCast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const DataType &data_type);
+// Pads a column of the rows of a batch to one shape and batches it. The padding of a slot is filled with the pad
+// value, then each row is copied to the front of its slot.
+// @param rows: the tensors of the column, one per row, of the same type and rank.
+// @param pad_shape: the shape to pad the rows to, its unknown dims are padded to the largest of the rows.
+//                   A shape of unknown rank pads all the dims to the largest.
+// @param pad_value: the value of the padding, cast to the type of the rows.
+// @param output: Tensor. The shape of the output tensor is <rows, padded shape> and the type is same as the rows.
+Status BatchPad(const std::vector<std::shared_ptr<Tensor>> &rows, const TensorShape &pad_shape, float pad_value,
+                std::shared_ptr<Tensor> *output);
 }  // namespace dataset
 }  // namespace mindspore
 
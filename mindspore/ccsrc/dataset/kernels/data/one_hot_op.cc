@@ -27,6 +27,15 @@ Status OneHotOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   return s;
 }
 
+Status OneHotOp::BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  // A batch of scalar labels, else row by row. A single class is squeezed away by Compute().
+  if (num_classes_ <= 1 || input->Rank() < 1 || input->Rank() > 2 || (input->Rank() == 2 && input->shape()[1] != 1)) {
+    return TensorOp::BatchCompute(input, output);
+  }
+  return BatchOneHotEncoding(input, output, num_classes_);
+}
+
 Status OneHotOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
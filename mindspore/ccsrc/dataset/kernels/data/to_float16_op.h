@@ -39,6 +39,13 @@ class ToFloat16Op : public TensorOp {
   // @return Status - The error code return
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  // Element wise, the whole batch is computed in one pass.
+  Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    return Compute(input, output);
+  }
+
+  bool BatchSupported() const override { return true; }
+
   void Print(std::ostream &out) const override { out << "ToFloat16Op"; }
 
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
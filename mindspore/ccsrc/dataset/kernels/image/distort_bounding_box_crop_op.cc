@@ -59,14 +59,20 @@ Status DistortBoundingBoxCropOp::Compute(const std::vector<std::shared_ptr<Tenso
   int h_in = input[0]->shape()[0];
   int w_in = input[0]->shape()[1];
 
+  // walk the coordinates of the boxes along the axis 0
+  std::vector<Tensor::StridedIterator<float>> coords;
+  for (uint64_t i = 1; i < input.size(); i++) {
+    auto itr = input[i]->begin<float>({0}, 0);
+    CHECK_FAIL_RETURN_UNEXPECTED(num_boxes == 0 || itr, "The boxes are not 1D tensors");
+    coords.push_back(itr);
+  }
   std::vector<cv::Rect> bounding_boxes;
   for (int64_t i = 0; i < num_boxes; ++i) {
     // bbox coordinates are floats relative to the image width and height
-    float y_min, y_max, x_min, x_max;
-    RETURN_IF_NOT_OK(input[1]->GetItemAt<float>(&y_min, {i}));
-    RETURN_IF_NOT_OK(input[2]->GetItemAt<float>(&y_max, {i}));
-    RETURN_IF_NOT_OK(input[3]->GetItemAt<float>(&x_min, {i}));
-    RETURN_IF_NOT_OK(input[4]->GetItemAt<float>(&x_max, {i}));
+    float y_min = coords[0][i];
+    float y_max = coords[1][i];
+    float x_min = coords[2][i];
+    float x_max = coords[3][i];
     bounding_boxes.emplace_back(static_cast<int>(x_min * w_in), static_cast<int>(y_min * h_in),
                                 static_cast<int>((x_max - x_min) * w_in), static_cast<int>((y_max - y_min) * h_in));
   }
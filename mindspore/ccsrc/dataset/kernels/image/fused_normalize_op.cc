@@ -0,0 +1,354 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/image/fused_normalize_op.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+#include <string>
+#include <utility>
+
+#include "dataset/core/cv_tensor.h"
+#include "dataset/kernels/data/data_utils.h"
+#include "dataset/kernels/image/hwc_to_chw_op.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/image/rescale_op.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+#if defined(__x86_64__)
+// The AVX2 kernels are compiled for that target only, and picked at run time when the cpu supports it
+#define FUSED_NORMALIZE_AVX2 __attribute__((target("avx2,f16c")))
+
+FUSED_NORMALIZE_AVX2 inline void StoreAvx2(float *dst, __m256 v) { _mm256_storeu_ps(dst, v); }
+
+FUSED_NORMALIZE_AVX2 inline void StoreAvx2(float16 *dst, __m256 v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+// dst[i] = v[i] * a + b for the 16 bytes of v.
+template <typename O>
+FUSED_NORMALIZE_AVX2 inline void AffineAvx2(__m128i v, __m256 a, __m256 b, O *dst) {
+  __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v));
+  __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+  StoreAvx2(dst, _mm256_add_ps(_mm256_mul_ps(lo, a), b));
+  StoreAvx2(dst + 8, _mm256_add_ps(_mm256_mul_ps(hi, a), b));
+}
+
+// Splits 16 interleaved 3 channel pixels at a time into their planes, then scales and shifts them.
+// @return The number of pixels done, the caller finishes the tail
+template <typename O>
+FUSED_NORMALIZE_AVX2 int64_t Uint8Hwc3ToChwAvx2(const uint8_t *in, O *out, int64_t hw, const float *scale,
+                                                const float *shift) {
+  // Byte k of a plane comes from one of the three 16 byte loads, the -1 lanes are zeroed
+  const __m128i r0 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i r1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+  const __m128i r2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+  const __m128i g0 = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i g1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+  const __m128i g2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+  const __m128i b0 = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i b1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+  const __m128i b2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+  const __m256 a[3] = {_mm256_set1_ps(scale[0]), _mm256_set1_ps(scale[1]), _mm256_set1_ps(scale[2])};
+  const __m256 b[3] = {_mm256_set1_ps(shift[0]), _mm256_set1_ps(shift[1]), _mm256_set1_ps(shift[2])};
+  int64_t p = 0;
+  for (; p + 16 <= hw; p += 16) {
+    const __m128i *src = reinterpret_cast<const __m128i *>(in + 3 * p);
+    __m128i v0 = _mm_loadu_si128(src);
+    __m128i v1 = _mm_loadu_si128(src + 1);
+    __m128i v2 = _mm_loadu_si128(src + 2);
+    __m128i red = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, r0), _mm_shuffle_epi8(v1, r1)),
+                               _mm_shuffle_epi8(v2, r2));
+    __m128i green = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, g0), _mm_shuffle_epi8(v1, g1)),
+                                 _mm_shuffle_epi8(v2, g2));
+    __m128i blue = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, b0), _mm_shuffle_epi8(v1, b1)),
+                                _mm_shuffle_epi8(v2, b2));
+    AffineAvx2(red, a[0], b[0], out + p);
+    AffineAvx2(green, a[1], b[1], out + hw + p);
+    AffineAvx2(blue, a[2], b[2], out + 2 * hw + p);
+  }
+  return p;
+}
+#elif defined(__aarch64__)
+inline void StoreNeon(float *dst, float32x4_t v) { vst1q_f32(dst, v); }
+
+inline void StoreNeon(float16 *dst, float32x4_t v) { vst1_f16(reinterpret_cast<float16_t *>(dst), vcvt_f16_f32(v)); }
+
+// dst[i] = v[i] * a + b for the 16 bytes of v.
+template <typename O>
+inline void AffineNeon(uint8x16_t v, float32x4_t a, float32x4_t b, O *dst) {
+  uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+  uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+  StoreNeon(dst, vmlaq_f32(b, vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), a));
+  StoreNeon(dst + 4, vmlaq_f32(b, vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), a));
+  StoreNeon(dst + 8, vmlaq_f32(b, vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), a));
+  StoreNeon(dst + 12, vmlaq_f32(b, vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), a));
+}
+
+// Splits 16 interleaved 3 channel pixels at a time into their planes, then scales and shifts them.
+// @return The number of pixels done, the caller finishes the tail
+template <typename O>
+int64_t Uint8Hwc3ToChwNeon(const uint8_t *in, O *out, int64_t hw, const float *scale, const float *shift) {
+  int64_t p = 0;
+  for (; p + 16 <= hw; p += 16) {
+    uint8x16x3_t px = vld3q_u8(in + 3 * p);
+    for (int k = 0; k < 3; k++) {
+      AffineNeon(px.val[k], vdupq_n_f32(scale[k]), vdupq_n_f32(shift[k]), out + k * hw + p);
+    }
+  }
+  return p;
+}
+#endif
+
+// The vectorized part of the HWC to CHW kernel, none for most input types.
+// @return The number of pixels done
+template <typename T, typename O>
+int64_t AffineToChwSimd(const T *, O *, int64_t, int64_t, const float *, const float *) {
+  return 0;
+}
+
+template <typename O>
+int64_t AffineToChwSimd(const uint8_t *in, O *out, int64_t hw, int64_t c, const float *scale, const float *shift) {
+  if (c != 3) {
+    return 0;
+  }
+#if defined(__x86_64__)
+  static const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+  return avx2 ? Uint8Hwc3ToChwAvx2(in, out, hw, scale, shift) : 0;
+#elif defined(__aarch64__)
+  return Uint8Hwc3ToChwNeon(in, out, hw, scale, shift);
+#else
+  return 0;
+#endif
+}
+
+// out[i] = in[i] * scale[c] + shift[c] over an image of hw pixels and c channels.
+template <typename T, typename O>
+void AffineKernel(const T *in, O *out, int64_t hw, int64_t c, const float *scale, const float *shift,
+                  bool hwc_to_chw) {
+  if (hwc_to_chw) {
+    int64_t done = AffineToChwSimd(in, out, hw, c, scale, shift);
+    for (int64_t k = 0; k < c; k++) {
+      const T *src = in + k;
+      O *dst = out + k * hw;
+      float a = scale[k];
+      float b = shift[k];
+      for (int64_t p = done; p < hw; p++) {
+        dst[p] = static_cast<O>(static_cast<float>(src[p * c]) * a + b);
+      }
+    }
+  } else {
+    for (int64_t p = 0; p < hw; p++) {
+      for (int64_t k = 0; k < c; k++) {
+        out[p * c + k] = static_cast<O>(static_cast<float>(in[p * c + k]) * scale[k] + shift[k]);
+      }
+    }
+  }
+}
+
+// Applies the kernel on num_images consecutive images.
+template <typename T, typename O>
+void AffineKernel(const std::shared_ptr<Tensor> &input, const std::shared_ptr<Tensor> &output, int64_t num_images,
+                  int64_t hw, int64_t c, const std::vector<float> &scale, const std::vector<float> &shift,
+                  bool hwc_to_chw) {
+  const T *in = reinterpret_cast<const T *>(input->StartAddr());
+  O *out = reinterpret_cast<O *>(output->StartAddr());
+  for (int64_t n = 0; n < num_images; n++) {
+    AffineKernel<T, O>(in + n * hw * c, out + n * hw * c, hw, c, scale.data(), shift.data(), hwc_to_chw);
+  }
+}
+
+// Picks the kernel of the input type.
+// @return T/F if the input type is handled
+template <typename O>
+bool AffineKernel(const std::shared_ptr<Tensor> &input, const std::shared_ptr<Tensor> &output, int64_t num_images,
+                  int64_t hw, int64_t c, const std::vector<float> &scale, const std::vector<float> &shift,
+                  bool hwc_to_chw) {
+  switch (input->type().value()) {
+    case DataType::DE_UINT8:
+      AffineKernel<uint8_t, O>(input, output, num_images, hw, c, scale, shift, hwc_to_chw);
+      return true;
+    case DataType::DE_INT8:
+      AffineKernel<int8_t, O>(input, output, num_images, hw, c, scale, shift, hwc_to_chw);
+      return true;
+    case DataType::DE_UINT16:
+      AffineKernel<uint16_t, O>(input, output, num_images, hw, c, scale, shift, hwc_to_chw);
+      return true;
+    case DataType::DE_INT16:
+      AffineKernel<int16_t, O>(input, output, num_images, hw, c, scale, shift, hwc_to_chw);
+      return true;
+    case DataType::DE_INT32:
+      AffineKernel<int32_t, O>(input, output, num_images, hw, c, scale, shift, hwc_to_chw);
+      return true;
+    case DataType::DE_FLOAT32:
+      AffineKernel<float, O>(input, output, num_images, hw, c, scale, shift, hwc_to_chw);
+      return true;
+    case DataType::DE_FLOAT64:
+      AffineKernel<double, O>(input, output, num_images, hw, c, scale, shift, hwc_to_chw);
+      return true;
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+FusedNormalizeOp::FusedNormalizeOp(std::vector<std::shared_ptr<TensorOp>> ops, DataType output_type)
+    : ops_(std::move(ops)), scale_(1, 1.0f), shift_(1, 0.0f), hwc_to_chw_(false), output_type_(output_type) {
+  // Fold the chain in double, then keep the result in float as the original ops do.
+  std::vector<double> scale(1, 1.0);
+  std::vector<double> shift(1, 0.0);
+  for (const auto &op : ops_) {
+    if (auto rescale = std::dynamic_pointer_cast<RescaleOp>(op)) {
+      // y = x * r + s
+      for (size_t k = 0; k < scale.size(); k++) {
+        scale[k] = scale[k] * rescale->rescale();
+        shift[k] = shift[k] * rescale->rescale() + rescale->shift();
+      }
+    } else if (auto normalize = std::dynamic_pointer_cast<NormalizeOp>(op)) {
+      // y = (x - mean[c]) / std[c], on 3 channels
+      if (scale.size() == 1) {
+        scale.assign(3, scale[0]);
+        shift.assign(3, shift[0]);
+      }
+      for (size_t k = 0; k < scale.size(); k++) {
+        double mean = normalize->mean(static_cast<int32_t>(k));
+        double stddev = normalize->stddev(static_cast<int32_t>(k));
+        scale[k] = scale[k] / stddev;
+        shift[k] = (shift[k] - mean) / stddev;
+      }
+    } else if (std::dynamic_pointer_cast<HwcToChwOp>(op) != nullptr) {
+      hwc_to_chw_ = true;
+    }
+  }
+  scale_.assign(scale.begin(), scale.end());
+  shift_.assign(shift.begin(), shift.end());
+}
+
+bool FusedNormalizeOp::Fusible(const std::shared_ptr<TensorOp> &op, bool *last) {
+  *last = false;
+  if (std::dynamic_pointer_cast<RescaleOp>(op) != nullptr || std::dynamic_pointer_cast<NormalizeOp>(op) != nullptr) {
+    return true;
+  }
+  if (std::dynamic_pointer_cast<HwcToChwOp>(op) != nullptr) {
+    *last = true;
+    return true;
+  }
+  return false;
+}
+
+void FusedNormalizeOp::Print(std::ostream &out) const {
+  out << "FusedNormalizeOp:";
+  for (const auto &op : ops_) {
+    out << " " << *op;
+  }
+}
+
+Status FusedNormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  const TensorShape &shape = input->shape();
+  int64_t channels = scale_.size();
+  if (shape.Rank() == 3) {
+    channels = shape[2];
+  } else if (hwc_to_chw_ || scale_.size() > 1) {
+    // Let the original ops report the error
+    return ComputeUnfused(input, output);
+  }
+  if (scale_.size() > 1 && channels != static_cast<int64_t>(scale_.size())) {
+    return ComputeUnfused(input, output);
+  }
+  TensorShape out_shape = hwc_to_chw_ ? TensorShape{shape[2], shape[0], shape[1]} : shape;
+  bool done = false;
+  RETURN_IF_NOT_OK(Apply(input, 1, channels, out_shape, TensorImpl::kCv, output, &done));
+  return done ? Status::OK() : ComputeUnfused(input, output);
+}
+
+Status FusedNormalizeOp::BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  // A batch of HWC images, else row by row
+  const TensorShape &shape = input->shape();
+  if (shape.Rank() != 4 || (scale_.size() > 1 && shape[3] != static_cast<int64_t>(scale_.size()))) {
+    return TensorOp::BatchCompute(input, output);
+  }
+  TensorShape out_shape = hwc_to_chw_ ? TensorShape{shape[0], shape[3], shape[1], shape[2]} : shape;
+  bool done = false;
+  RETURN_IF_NOT_OK(Apply(input, shape[0], shape[3], out_shape, TensorImpl::kFlexible, output, &done));
+  return done ? Status::OK() : TensorOp::BatchCompute(input, output);
+}
+
+Status FusedNormalizeOp::Apply(const std::shared_ptr<Tensor> &input, int64_t num_images, int64_t channels,
+                               const TensorShape &out_shape, TensorImpl impl, std::shared_ptr<Tensor> *output,
+                               bool *done) {
+  *done = false;
+  int64_t hw = (channels > 0 && num_images > 0) ? input->Size() / (channels * num_images) : 0;
+  std::vector<float> scale(channels, scale_[0]);
+  std::vector<float> shift(channels, shift_[0]);
+  if (scale_.size() > 1) {
+    scale = scale_;
+    shift = shift_;
+  }
+  // Write into the given view when it fits
+  std::shared_ptr<Tensor> out = *output;
+  if (out == nullptr || out->view_base() == nullptr || out->shape() != out_shape || out->type() != output_type_) {
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, impl, out_shape, output_type_));
+  }
+  bool handled = (output_type_ == DataType::DE_FLOAT16)
+                   ? AffineKernel<float16>(input, out, num_images, hw, channels, scale, shift, hwc_to_chw_)
+                   : AffineKernel<float>(input, out, num_images, hw, channels, scale, shift, hwc_to_chw_);
+  if (!handled) {
+    // The caller falls back to the original ops
+    return Status::OK();
+  }
+  *output = std::move(out);
+  *done = true;
+  return Status::OK();
+}
+
+Status FusedNormalizeOp::ComputeUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> in = input;
+  for (const auto &op : ops_) {
+    std::shared_ptr<Tensor> out;
+    RETURN_IF_NOT_OK(op->Compute(in, &out));
+    in = std::move(out);
+  }
+  if (in->type() != output_type_) {
+    return TypeCast(in, output, output_type_);
+  }
+  *output = std::move(in);
+  return Status::OK();
+}
+
+Status FusedNormalizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> in = inputs;
+  for (const auto &op : ops_) {
+    std::vector<TensorShape> out;
+    RETURN_IF_NOT_OK(op->OutputShape(in, out));
+    in = std::move(out);
+  }
+  outputs = std::move(in);
+  return Status::OK();
+}
+
+Status FusedNormalizeOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = output_type_;
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+#define DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+
+#include <memory>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/kernels/tensor_op.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// A chain of RescaleOp and NormalizeOp, optionally followed by a HwcToChwOp, executed as one kernel.
+// Each op of such a chain is a per channel affine transform, so the whole chain folds into a single
+// out = in * scale[c] + shift[c] that is written in float, directly in CHW order when the chain ends with
+// a HwcToChwOp. This saves the intermediate tensors and their memory passes. The uint8 3 channel to CHW case,
+// the usual one of image pipelines, is vectorized with AVX2 or NEON, and the output may be float16 instead.
+// Inputs the kernel does not handle (type or shape) are passed through the original chain of ops.
+class FusedNormalizeOp : public TensorOp {
+ public:
+  // Constructor
+  // @param ops - The chain of ops to fuse. Only RescaleOp, NormalizeOp and a trailing HwcToChwOp are accepted.
+  // @param output_type - The type of the output, DE_FLOAT32 or DE_FLOAT16
+  explicit FusedNormalizeOp(std::vector<std::shared_ptr<TensorOp>> ops,
+                            DataType output_type = DataType(DataType::DE_FLOAT32));
+
+  ~FusedNormalizeOp() override = default;
+
+  // Checks if an op can be part of the chain.
+  // @param op - The op to check
+  // @param last - T/F if the op may only end the chain (HwcToChwOp)
+  // @return T/F if the op can be fused
+  static bool Fusible(const std::shared_ptr<TensorOp> &op, bool *last);
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  bool BatchSupported() const override { return true; }
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+ private:
+  // Runs the fused kernel on consecutive HWC images.
+  // @param input - The images
+  // @param num_images - The number of images in the input
+  // @param channels - The number of channels of each image
+  // @param out_shape - The shape of the output
+  // @param impl - The implementation of the output tensor
+  // @param output - The result
+  // @param done - T/F if the kernel handled the input type, else the caller falls back to the original ops
+  // @return Status - The error code return
+  Status Apply(const std::shared_ptr<Tensor> &input, int64_t num_images, int64_t channels,
+               const TensorShape &out_shape, TensorImpl impl, std::shared_ptr<Tensor> *output, bool *done);
+
+  // Runs the original chain of ops.
+  Status ComputeUnfused(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  std::vector<std::shared_ptr<TensorOp>> ops_;  // The original chain
+  std::vector<float> scale_;                    // Per channel scale, a single value applies to all channels
+  std::vector<float> shift_;                    // Per channel shift, a single value applies to all channels
+  bool hwc_to_chw_;                             // The chain ends with a HwcToChwOp
+  DataType output_type_;                        // The type of the output
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
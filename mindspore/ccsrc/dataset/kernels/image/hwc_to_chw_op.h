@@ -30,6 +30,11 @@ class HwcToChwOp : public TensorOp {
   void Print(std::ostream &out) const override { out << "HwcToChw"; }
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  bool BatchSupported() const override { return true; }
+
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 };
 }  // namespace dataset
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/image/image_op_fusion.h"
+
+#include <typeinfo>
+#include <utility>
+
+#include "dataset/kernels/image/decode_op.h"
+#include "dataset/kernels/image/fused_normalize_op.h"
+#include "dataset/kernels/image/random_crop_and_resize_op.h"
+#include "dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+Status FuseImageOps(std::vector<std::shared_ptr<TensorOp>> *ops) {
+  if (ops == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Null list of TensorOps to fuse.");
+  }
+  std::vector<std::shared_ptr<TensorOp>> fused;
+  size_t i = 0;
+  while (i < ops->size()) {
+    const std::shared_ptr<TensorOp> &op = (*ops)[i];
+    if (op == nullptr) {
+      RETURN_STATUS_UNEXPECTED("Null TensorOp in the list to fuse.");
+    }
+
+    // Decode + RandomCropAndResize. A subclass of RandomCropAndResizeOp does not qualify.
+    auto decode = std::dynamic_pointer_cast<DecodeOp>(op);
+    if (decode != nullptr && decode->is_rgb_format() && i + 1 < ops->size() && (*ops)[i + 1] != nullptr &&
+        typeid(*(*ops)[i + 1]) == typeid(RandomCropAndResizeOp)) {
+      auto crop = std::dynamic_pointer_cast<RandomCropAndResizeOp>((*ops)[i + 1]);
+      fused.push_back(std::make_shared<RandomCropDecodeResizeOp>(*crop));
+      MS_LOG(INFO) << "Fused DecodeOp and RandomCropAndResizeOp into RandomCropDecodeResizeOp.";
+      i += 2;
+      continue;
+    }
+
+    // Rescale/Normalize chain, optionally closed by a HwcToChw
+    size_t j = i;
+    bool last = false;
+    while (j < ops->size() && (*ops)[j] != nullptr && FusedNormalizeOp::Fusible((*ops)[j], &last)) {
+      j++;
+      if (last) {
+        break;
+      }
+    }
+    // A single op is left as it is. A HwcToChw can only close a chain, so it never starts one.
+    if (j - i >= 2) {
+      std::vector<std::shared_ptr<TensorOp>> chain(ops->begin() + i, ops->begin() + j);
+      auto fused_op = std::make_shared<FusedNormalizeOp>(std::move(chain));
+      MS_LOG(INFO) << "Fused " << (j - i) << " TensorOps into " << *fused_op << ".";
+      fused.push_back(std::move(fused_op));
+      i = j;
+      continue;
+    }
+    fused.push_back(op);
+    i++;
+  }
+  *ops = std::move(fused);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
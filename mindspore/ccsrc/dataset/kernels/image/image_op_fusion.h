@@ -0,0 +1,39 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_IMAGE_IMAGE_OP_FUSION_H_
+#define DATASET_KERNELS_IMAGE_IMAGE_OP_FUSION_H_
+
+#include <memory>
+#include <vector>
+
+#include "dataset/kernels/tensor_op.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Replaces the known chains of consecutive TensorOps of a MapOp by single kernels:
+//  - DecodeOp (rgb) followed by RandomCropAndResizeOp becomes a RandomCropDecodeResizeOp, which only
+//    decodes the cropped region of a jpeg.
+//  - Two or more of RescaleOp, NormalizeOp and a trailing HwcToChwOp become a FusedNormalizeOp, which
+//    writes the float result in one pass.
+// The ops given are not modified, the fused list shares the ops which are not part of a chain.
+// @param ops - The list of ops to fuse, in place.
+// @return Status - The error code return
+Status FuseImageOps(std::vector<std::shared_ptr<TensorOp>> *ops);
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_KERNELS_IMAGE_IMAGE_OP_FUSION_H_
@@ -268,7 +268,10 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
 }
 
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_denom) {
+  if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 && scale_denom != kMaxJpegScaleDenom) {
+    RETURN_STATUS_UNEXPECTED("Jpeg scale is not valid");
+  }
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -282,6 +285,9 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->StartAddr(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    // the inverse DCT outputs the downscaled blocks directly
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale_denom;
     jpeg_calc_output_dimensions(&cinfo);
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
@@ -289,9 +295,17 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
     crop_w = cinfo.output_width;
     crop_h = cinfo.output_height;
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo.image_height) {
     return DestroyDecompressAndReturnError("Crop window is not valid");
+  } else if (scale_denom > 1) {
+    // the crop window in the downscaled image, rounded outwards
+    int x_end = std::min((crop_x + crop_w + scale_denom - 1) / scale_denom, static_cast<int>(cinfo.output_width));
+    int y_end = std::min((crop_y + crop_h + scale_denom - 1) / scale_denom, static_cast<int>(cinfo.output_height));
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = x_end - crop_x;
+    crop_h = y_end - crop_y;
   }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
@@ -389,6 +403,71 @@ Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output)
   }
 }
 
+namespace {
+template <typename T>
+void BatchHwcToChwKernel(const T *in, T *out, dsize_t num_images, dsize_t hw, dsize_t c) {
+  for (dsize_t n = 0; n < num_images; n++) {
+    const T *src = in + n * hw * c;
+    T *dst = out + n * hw * c;
+    for (dsize_t k = 0; k < c; k++) {
+      for (dsize_t p = 0; p < hw; p++) {
+        dst[k * hw + p] = src[p * c + k];
+      }
+    }
+  }
+}
+
+template <typename T>
+void BatchNormalizeKernel(const T *in, float *out, dsize_t num_pixels, const float scale[3], const float shift[3]) {
+  for (dsize_t p = 0; p < num_pixels; p++) {
+    out[3 * p] = static_cast<float>(in[3 * p]) * scale[0] + shift[0];
+    out[3 * p + 1] = static_cast<float>(in[3 * p + 1]) * scale[1] + shift[1];
+    out[3 * p + 2] = static_cast<float>(in[3 * p + 2]) * scale[2] + shift[2];
+  }
+}
+}  // namespace
+
+Status BatchHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  if (input->Rank() != 4) {
+    RETURN_STATUS_UNEXPECTED("The shape is incorrect: the batch is not of shape <N,H,W,C>");
+  }
+  dsize_t num_images = input->shape()[0];
+  dsize_t height = input->shape()[1];
+  dsize_t width = input->shape()[2];
+  dsize_t num_channels = input->shape()[3];
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, TensorImpl::kFlexible,
+                                        TensorShape{num_images, num_channels, height, width}, input->type()));
+  // Only the size of the elements matters to move them
+  const uchar *in_addr = input->StartAddr();
+  uchar *out_addr = out->StartAddr();
+  if (in_addr == nullptr || out_addr == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Failed to create memory for Tensor.");
+  }
+  dsize_t hw = height * width;
+  switch (input->type().SizeInBytes()) {
+    case 1:
+      BatchHwcToChwKernel(in_addr, out_addr, num_images, hw, num_channels);
+      break;
+    case 2:
+      BatchHwcToChwKernel(reinterpret_cast<const uint16_t *>(in_addr), reinterpret_cast<uint16_t *>(out_addr),
+                          num_images, hw, num_channels);
+      break;
+    case 4:
+      BatchHwcToChwKernel(reinterpret_cast<const uint32_t *>(in_addr), reinterpret_cast<uint32_t *>(out_addr),
+                          num_images, hw, num_channels);
+      break;
+    case 8:
+      BatchHwcToChwKernel(reinterpret_cast<const uint64_t *>(in_addr), reinterpret_cast<uint64_t *>(out_addr),
+                          num_images, hw, num_channels);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("HwcToChw does not support input of this type.");
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
 Status SwapRedAndBlue(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(std::move(input));
@@ -528,6 +607,36 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   }
 }
 
+Status BatchNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float mean[3],
+                      const float std[3]) {
+  if (input->Rank() != 4 || input->shape()[3] != 3) {
+    RETURN_STATUS_UNEXPECTED("The shape is incorrect: the batch is not of shape <N,H,W,3>");
+  }
+  // (x - mean) / std as one multiply-add per element
+  float scale[3], shift[3];
+  for (int i = 0; i < 3; i++) {
+    scale[i] = 1.0f / std[i];
+    shift[i] = -mean[i] / std[i];
+  }
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, TensorImpl::kFlexible, input->shape(), DataType(DataType::DE_FLOAT32)));
+  const uchar *in_addr = input->StartAddr();
+  float *out_addr = reinterpret_cast<float *>(out->StartAddr());
+  if (in_addr == nullptr || out_addr == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Failed to create memory for Tensor.");
+  }
+  dsize_t num_pixels = input->Size() / 3;
+  if (input->type() == DataType::DE_UINT8) {
+    BatchNormalizeKernel(in_addr, out_addr, num_pixels, scale, shift);
+  } else if (input->type() == DataType::DE_FLOAT32) {
+    BatchNormalizeKernel(reinterpret_cast<const float *>(in_addr), out_addr, num_pixels, scale, shift);
+  } else {
+    RETURN_STATUS_UNEXPECTED("Batch normalize only supports uint8 and float32 as input.");
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
 Status AdjustBrightness(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float &alpha) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
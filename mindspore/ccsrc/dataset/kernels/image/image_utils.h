@@ -106,8 +106,16 @@ bool HasJpegMagic(const unsigned char *data, size_t data_size);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+// Largest downscale of a jpeg decode in the DCT domain, libjpeg decodes at 1/1, 1/2, 1/4 and 1/8 of the size
+constexpr int kMaxJpegScaleDenom = 8;
+
+// Decodes the crop window of a jpeg image only
+// @param input: Tensor containing the not decoded jpeg bytes
+// @param output: Decoded crop Tensor of shape <h,w,3> and type DE_UINT8, <h,w> divided by scale_denom and rounded up
+// @param x, y, w, h: The crop window in the full size image, all 0 to decode the whole image
+// @param scale_denom: 1, 2, 4 or 8, the decode is downscaled by that much, far cheaper than a resize afterwards
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_denom = 1);
 // Returns Rescaled image
 // @param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 // @param rescale: rescale parameter
@@ -129,6 +137,11 @@ Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *outpu
 // @param output: Tensor of shape <C,H,W> or <H,W> and same input type.
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
 
+// Swaps the channels of a batch of images, i.e. converts NHWC to NCHW
+// @param input: Tensor of shape <N,H,W,C> and any type.
+// @param output: Tensor of shape <N,C,H,W> and same input type.
+Status BatchHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
 // Swap the red and blue pixels (RGB <-> BGR)
 // @param input: Tensor of shape <H,W,3> and any OpenCv compatible type, see CVTensor.
 // @param output: Swapped image of same shape and type
@@ -167,6 +180,14 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                  const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
 
+// Returns a Normalized batch of images
+// @param input: Tensor of shape <N,H,W,3> in RGB order and type DE_UINT8 or DE_FLOAT32.
+// @param mean: the mean of each channel in RGB order
+// @param std:  the std of each channel in RGB order
+// @param output: Normalized Tensor of same input shape and type DE_FLOAT32
+Status BatchNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float mean[3],
+                      const float std[3]);
+
 // Returns image with adjusted brightness.
 // @param input: Tensor of shape <H,W,3> in RGB order and any OpenCv compatible type, see CVTensor.
 // @param alpha: Alpha value to adjust brightness by. Should be a positive number.
@@ -46,6 +46,21 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
   return Normalize(input, output, mean_, std_);
 }
 
+Status NormalizeOp::BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  // A batch of RGB images of the types the batch kernel handles, else row by row
+  if (input->Rank() != 4 || input->shape()[3] != 3 ||
+      (input->type() != DataType::DE_UINT8 && input->type() != DataType::DE_FLOAT32)) {
+    return TensorOp::BatchCompute(input, output);
+  }
+  float mean[3], std[3];
+  for (int32_t i = 0; i < 3; i++) {
+    mean[i] = this->mean(i);
+    std[i] = stddev(i);
+  }
+  return BatchNormalize(input, output, mean, std);
+}
+
 void NormalizeOp::Print(std::ostream &out) const {
   out << "NormalizeOp, mean: " << mean_->mat().at<float>(0) << ", " << mean_->mat().at<float>(1) << ", "
       << mean_->mat().at<float>(2) << "std: " << std_->mat().at<float>(0) << ", " << std_->mat().at<float>(1) << ", "
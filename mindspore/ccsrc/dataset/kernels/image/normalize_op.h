@@ -35,6 +35,18 @@ class NormalizeOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  bool BatchSupported() const override { return true; }
+
+  // @param channel - 0 for red, 1 for green, 2 for blue
+  // @return The mean of the channel
+  float mean(int32_t channel) const { return mean_->mat().at<float>(channel); }
+
+  // @param channel - 0 for red, 1 for green, 2 for blue
+  // @return The standard deviation of the channel
+  float stddev(int32_t channel) const { return std_->mat().at<float>(channel); }
+
  private:
   std::shared_ptr<CVTensor> mean_;
   std::shared_ptr<CVTensor> std_;
@@ -23,6 +23,7 @@
 
 #include "dataset/core/tensor.h"
 #include "dataset/kernels/tensor_op.h"
+#include "dataset/util/random.h"
 #include "dataset/util/status.h"
 
 namespace mindspore {
@@ -58,7 +59,7 @@ class RandomColorAdjustOp : public TensorOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
  private:
-  std::mt19937 rnd_;
+  RandomEngine rnd_;
   float bright_factor_start_;
   float bright_factor_end_;
   float contrast_factor_start_;
@@ -23,6 +23,7 @@
 #include "dataset/core/tensor.h"
 #include "dataset/kernels/image/image_utils.h"
 #include "dataset/kernels/tensor_op.h"
+#include "dataset/util/random.h"
 #include "dataset/util/status.h"
 
 namespace mindspore {
@@ -57,7 +58,7 @@ class RandomCropAndResizeOp : public TensorOp {
   int32_t target_width_;
   std::uniform_real_distribution<float> rnd_scale_;
   std::uniform_real_distribution<float> rnd_aspect_;
-  std::mt19937 rnd_;
+  RandomEngine rnd_;
   InterpolationMode interpolation_;
   int32_t max_iter_;
 };
@@ -60,8 +60,15 @@ Status RandomCropDecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, s
     int crop_width = 0;
     (void)GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width);
 
+    // decode at the smallest scale which is still at least the target size, the resize does the rest
+    int scale_denom = 1;
+    while (scale_denom < kMaxJpegScaleDenom && crop_width / (scale_denom * 2) >= target_width_ &&
+           crop_height / (scale_denom * 2) >= target_height_) {
+      scale_denom *= 2;
+    }
+
     std::shared_ptr<Tensor> decoded;
-    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height));
+    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height, scale_denom));
     return Resize(decoded, output, target_height_, target_width_, 0.0, 0.0, interpolation_);
   }
 }
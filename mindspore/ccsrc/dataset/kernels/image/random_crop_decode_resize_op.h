@@ -35,6 +35,10 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
                            float scale_ub = kDefScaleUb, float aspect_lb = kDefAspectLb, float aspect_ub = kDefAspectUb,
                            InterpolationMode interpolation = kDefInterpolation, int32_t max_iter = kDefMaxIter);
 
+  // Builds the op out of a RandomCropAndResizeOp that follows a DecodeOp. The settings and the state of the
+  // random generator are copied, so that the crops are the same as the ones of the separate ops.
+  explicit RandomCropDecodeResizeOp(const RandomCropAndResizeOp &rhs) : RandomCropAndResizeOp(rhs) {}
+
   ~RandomCropDecodeResizeOp() override = default;
 
   void Print(std::ostream &out) const override {
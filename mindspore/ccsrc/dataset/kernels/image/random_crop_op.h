@@ -23,6 +23,7 @@
 #include "dataset/core/tensor.h"
 #include "dataset/kernels/tensor_op.h"
 #include "dataset/kernels/image/image_utils.h"
+#include "dataset/util/random.h"
 #include "dataset/util/status.h"
 
 namespace mindspore {
@@ -64,7 +65,7 @@ class RandomCropOp : public TensorOp {
   uint8_t fill_r_ = 0;
   uint8_t fill_g_ = 0;
   uint8_t fill_b_ = 0;
-  std::mt19937 rnd_;
+  RandomEngine rnd_;
 };
 }  // namespace dataset
 }  // namespace mindspore
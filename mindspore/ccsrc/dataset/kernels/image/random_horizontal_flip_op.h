@@ -48,7 +48,7 @@ class RandomHorizontalFlipOp : public TensorOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
  private:
-  std::mt19937 rnd_;
+  RandomEngine rnd_;
   std::bernoulli_distribution distribution_;
 };
 }  // namespace dataset
@@ -46,7 +46,7 @@ class RandomResizeOp : public ResizeOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
  private:
-  std::mt19937 random_generator_;
+  RandomEngine random_generator_;
   std::uniform_int_distribution<int> distribution_{0, 3};
 };
 }  // namespace dataset
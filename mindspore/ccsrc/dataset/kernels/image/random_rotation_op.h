@@ -22,6 +22,7 @@
 
 #include "dataset/core/tensor.h"
 #include "dataset/kernels/tensor_op.h"
+#include "dataset/util/random.h"
 #include "dataset/util/status.h"
 #include "dataset/kernels/image/image_utils.h"
 
@@ -79,7 +80,7 @@ class RandomRotationOp : public TensorOp {
   uint8_t fill_g_;
   uint8_t fill_b_;
   std::uniform_real_distribution<float> distribution_{-1.0, 1.0};
-  std::mt19937 rnd_;
+  RandomEngine rnd_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -42,7 +42,7 @@ class RandomVerticalFlipOp : public TensorOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
  private:
-  std::mt19937 rnd_;
+  RandomEngine rnd_;
   std::bernoulli_distribution distribution_;
 };
 }  // namespace dataset
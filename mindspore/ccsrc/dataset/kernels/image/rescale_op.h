@@ -38,6 +38,10 @@ class RescaleOp : public TensorOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
 
+  float rescale() const { return rescale_; }
+
+  float shift() const { return shift_; }
+
  private:
   float rescale_;
   float shift_;
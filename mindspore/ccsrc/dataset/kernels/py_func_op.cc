@@ -25,61 +25,146 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+Status ShapeMisMatch() {
+  return Status(StatusCode::kShapeMisMatch, "PyFunc should return a numpy array or a numpy array tuple");
+}
+}  // namespace
+
 Status PyFuncOp::Compute(const std::vector<std::shared_ptr<Tensor>> &input,
                          std::vector<std::shared_ptr<Tensor>> *output) {
   IO_CHECK_VECTOR(input, output);
-  Status ret = Status(StatusCode::kOK, "PyFunc Call Succeed");
-  {
-    // Acquire Python GIL
-    py::gil_scoped_acquire gil_acquire;
-    if (Py_IsInitialized() == 0) {
-      ret = Status(StatusCode::kPythonInterpreterFailure, "Python Interpreter is finalized");
-      goto ComputeReturn;
+  if (batched_) {
+    std::vector<TensorRow> output_rows;
+    RETURN_IF_NOT_OK(RowsCompute({input}, &output_rows));
+    *output = std::move(output_rows[0]);
+    return Status::OK();
+  }
+  // Acquire Python GIL
+  py::gil_scoped_acquire gil_acquire;
+  if (Py_IsInitialized() == 0) {
+    return Status(StatusCode::kPythonInterpreterFailure, "Python Interpreter is finalized");
+  }
+  try {
+    return CallRow(input, output);
+  } catch (const py::error_already_set &e) {
+    return Status(StatusCode::kPyFuncException, e.what());
+  }
+}
+
+Status PyFuncOp::RowsCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  if (output == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Output rows are null.");
+  }
+  output->clear();
+  if (input.empty()) {
+    return Status::OK();
+  }
+  // A single acquisition of the GIL for all the rows
+  py::gil_scoped_acquire gil_acquire;
+  if (Py_IsInitialized() == 0) {
+    return Status(StatusCode::kPythonInterpreterFailure, "Python Interpreter is finalized");
+  }
+  try {
+    if (batched_) {
+      return CallRows(input, output);
     }
-    try {
-      // Transform input tensor vector into numpy array vector
-      py::tuple input_args(input.size());
-      for (size_t i = 0; i < input.size(); i++) {
-        py::array new_data;
-        RETURN_IF_NOT_OK(input.at(i)->GetDataAsNumpy(&new_data));
-        // possible memcpy here
-        input_args[i] = new_data;
-      }
-      // Invoke python function
-      py::object ret_py_obj = this->py_func_ptr_(*input_args);
-      // Process the return value
-      if (py::isinstance<py::array>(ret_py_obj)) {
-        // In case of a n-1 mapping, the return value will be a numpy array
-        std::shared_ptr<Tensor> out;
-        RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, ret_py_obj.cast<py::array>()));
-        output->push_back(out);
-      } else if (py::isinstance<py::tuple>(ret_py_obj)) {
-        // In case of a n-m mapping, the return value will be a tuple of numpy arrays
-        py::tuple ret_py_tuple = ret_py_obj.cast<py::tuple>();
-        // Iterate over two containers simultaneously for memory copy
-        for (size_t i = 0; i < ret_py_tuple.size(); i++) {
-          py::object ret_py_ele = ret_py_tuple[i];
-          if (!py::isinstance<py::array>(ret_py_ele)) {
-            goto ShapeMisMatch;
-          }
-          std::shared_ptr<Tensor> out;
-          RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, ret_py_ele.cast<py::array>()));
-          output->push_back(out);
-        }
-      } else {
-        goto ShapeMisMatch;
-      }
-    } catch (const py::error_already_set &e) {
-      ret = Status(StatusCode::kPyFuncException, e.what());
+    output->resize(input.size());
+    for (size_t r = 0; r < input.size(); r++) {
+      RETURN_IF_NOT_OK(CallRow(input[r], &(*output)[r]));
     }
+  } catch (const py::error_already_set &e) {
+    return Status(StatusCode::kPyFuncException, e.what());
   }
+  return Status::OK();
+}
 
-ComputeReturn:
-  return ret;
+Status PyFuncOp::CallRow(const TensorRow &input, TensorRow *output) {
+  // Transform input tensor vector into numpy array vector
+  py::tuple input_args(input.size());
+  for (size_t i = 0; i < input.size(); i++) {
+    // The tensor may be shared with other rows, e.g. by a cache, so the function gets a read only view of it
+    py::array new_data;
+    RETURN_IF_NOT_OK(Tensor::ShareDataAsNumpy(input.at(i), &new_data, false));
+    input_args[i] = new_data;
+  }
+  // Invoke python function
+  py::object ret_py_obj = this->py_func_ptr_(*input_args);
+  // Process the return value
+  if (py::isinstance<py::array>(ret_py_obj)) {
+    // In case of a n-1 mapping, the return value will be a numpy array
+    std::shared_ptr<Tensor> out;
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, ret_py_obj.cast<py::array>()));
+    output->push_back(out);
+  } else if (py::isinstance<py::tuple>(ret_py_obj)) {
+    // In case of a n-m mapping, the return value will be a tuple of numpy arrays
+    py::tuple ret_py_tuple = ret_py_obj.cast<py::tuple>();
+    // Iterate over two containers simultaneously for memory copy
+    for (size_t i = 0; i < ret_py_tuple.size(); i++) {
+      py::object ret_py_ele = ret_py_tuple[i];
+      if (!py::isinstance<py::array>(ret_py_ele)) {
+        return ShapeMisMatch();
+      }
+      std::shared_ptr<Tensor> out;
+      RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, ret_py_ele.cast<py::array>()));
+      output->push_back(out);
+    }
+  } else {
+    return ShapeMisMatch();
+  }
+  return Status::OK();
+}
 
-ShapeMisMatch:
-  ret = Status(StatusCode::kShapeMisMatch, "PyFunc should return a numpy array or a numpy array tuple");
-  goto ComputeReturn;
+Status PyFuncOp::CallRows(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  size_t num_rows = input.size();
+  size_t num_cols = input[0].size();
+  // One list of views per input column
+  py::tuple input_args(num_cols);
+  for (size_t c = 0; c < num_cols; c++) {
+    py::list column(num_rows);
+    for (size_t r = 0; r < num_rows; r++) {
+      if (input[r].size() != num_cols) {
+        RETURN_STATUS_UNEXPECTED("The rows given to PyFunc do not have the same columns.");
+      }
+      py::array view;
+      RETURN_IF_NOT_OK(Tensor::ShareDataAsNumpy(input[r][c], &view, false));
+      column[r] = view;
+    }
+    input_args[c] = column;
+  }
+  py::object ret_py_obj = this->py_func_ptr_(*input_args);
+  // A list for a n-1 mapping, a tuple of lists for a n-m mapping
+  std::vector<py::list> output_columns;
+  if (py::isinstance<py::list>(ret_py_obj)) {
+    output_columns.push_back(ret_py_obj.cast<py::list>());
+  } else if (py::isinstance<py::tuple>(ret_py_obj)) {
+    py::tuple ret_py_tuple = ret_py_obj.cast<py::tuple>();
+    for (size_t i = 0; i < ret_py_tuple.size(); i++) {
+      py::object ret_py_ele = ret_py_tuple[i];
+      if (!py::isinstance<py::list>(ret_py_ele)) {
+        return Status(StatusCode::kShapeMisMatch, "Batched PyFunc should return a list or a tuple of lists");
+      }
+      output_columns.push_back(ret_py_ele.cast<py::list>());
+    }
+  } else {
+    return Status(StatusCode::kShapeMisMatch, "Batched PyFunc should return a list or a tuple of lists");
+  }
+  output->assign(num_rows, TensorRow());
+  for (auto &column : output_columns) {
+    if (column.size() != num_rows) {
+      return Status(StatusCode::kShapeMisMatch, "Batched PyFunc should return a result for every row");
+    }
+    for (size_t r = 0; r < num_rows; r++) {
+      py::object ret_py_ele = column[r];
+      if (!py::isinstance<py::array>(ret_py_ele)) {
+        return ShapeMisMatch();
+      }
+      std::shared_ptr<Tensor> out;
+      RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, ret_py_ele.cast<py::array>()));
+      (*output)[r].push_back(std::move(out));
+    }
+  }
+  return Status::OK();
 }
 }  // namespace dataset
 }  // namespace mindspore
@@ -28,7 +28,10 @@ namespace mindspore {
 namespace dataset {
 class __attribute__((visibility("hidden"))) PyFuncOp : public TensorOp {
  public:
-  explicit PyFuncOp(py::function func) : py_func_ptr_(std::move(func)) {}
+  // @param func - The Python function
+  // @param batched - Whether the function takes all the rows of a DataBuffer at once: each argument is then a list
+  //     with the column of every row, and the function returns a list, or a tuple of lists, with a result per row.
+  explicit PyFuncOp(py::function func, bool batched = false) : py_func_ptr_(std::move(func)), batched_(batched) {}
 
   ~PyFuncOp() override = default;
 
@@ -39,8 +42,21 @@ class __attribute__((visibility("hidden"))) PyFuncOp : public TensorOp {
   Status Compute(const std::vector<std::shared_ptr<Tensor>> &input,
                  std::vector<std::shared_ptr<Tensor>> *output) override;
 
+  // Computes all the rows of a DataBuffer under a single acquisition of the GIL, with a single call of the
+  // function in batched mode.
+  Status RowsCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) override;
+
+  bool RowsSupported() const override { return true; }
+
  private:
+  // Calls the function on one row, the GIL is held.
+  Status CallRow(const TensorRow &input, TensorRow *output);
+
+  // Calls the function once on all the rows, the GIL is held.
+  Status CallRows(const std::vector<TensorRow> &input, std::vector<TensorRow> *output);
+
   py::function py_func_ptr_;
+  bool batched_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -49,6 +49,103 @@ Status TensorOp::Compute(const std::vector<std::shared_ptr<Tensor>> &input,
                 "Is this TensorOp oneToOne? If no, please implement this Compute() in the derived class.");
 }
 
+// Name: BatchCompute()
+// Description: This BatchCompute() take 1 batched Tensor and produce 1 batched Tensor.
+//              The default computes the batch row by row.
+Status TensorOp::BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  std::vector<std::shared_ptr<Tensor>> out;
+  RETURN_IF_NOT_OK(ComputePerRow({input}, &out));
+  if (out.size() != 1) {
+    RETURN_STATUS_UNEXPECTED("Wrong BatchCompute() function is called. This is not 1-1 TensorOp.");
+  }
+  *output = std::move(out[0]);
+  return Status::OK();
+}
+
+// Name: BatchCompute()
+// Description: This BatchCompute() take multiple batched Tensors from different columns and produce multiple
+//              batched Tensors too. The default computes the batch row by row.
+Status TensorOp::BatchCompute(const std::vector<std::shared_ptr<Tensor>> &input,
+                              std::vector<std::shared_ptr<Tensor>> *output) {
+  IO_CHECK_VECTOR(input, output);
+  if (OneToOne()) {
+    output->resize(1);
+    return BatchCompute(input[0], &(*output)[0]);
+  }
+  return ComputePerRow(input, output);
+}
+
+// Name: RowsCompute()
+// Description: This RowsCompute() take all the rows of a DataBuffer and produce as many rows.
+//              The default computes them one by one.
+Status TensorOp::RowsCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output) {
+  if (output == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Output rows are null.");
+  }
+  output->clear();
+  output->resize(input.size());
+  for (size_t r = 0; r < input.size(); r++) {
+    RETURN_IF_NOT_OK(Compute(input[r], &(*output)[r]));
+  }
+  return Status::OK();
+}
+
+Status TensorOp::ComputePerRow(const std::vector<std::shared_ptr<Tensor>> &input,
+                               std::vector<std::shared_ptr<Tensor>> *output) {
+  IO_CHECK_VECTOR(input, output);
+  if (input.empty()) {
+    RETURN_STATUS_UNEXPECTED("No input to compute.");
+  }
+  dsize_t batch_size = -1;
+  for (auto &t : input) {
+    if (t->Rank() < 1 || (batch_size != -1 && t->shape()[0] != batch_size)) {
+      RETURN_STATUS_UNEXPECTED("The inputs of BatchCompute() are not batches of the same size.");
+    }
+    batch_size = t->shape()[0];
+  }
+
+  output->clear();
+  for (dsize_t r = 0; r < batch_size; r++) {
+    // Copy out the row of every input
+    std::vector<std::shared_ptr<Tensor>> row, result;
+    for (auto &t : input) {
+      uchar *start_addr = nullptr;
+      TensorShape row_shape({-1});
+      RETURN_IF_NOT_OK(t->StartAddrOfIndex({r}, &start_addr, &row_shape));
+      std::shared_ptr<Tensor> row_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateTensor(&row_tensor, TensorImpl::kFlexible, row_shape, t->type(), start_addr));
+      row.push_back(std::move(row_tensor));
+    }
+    RETURN_IF_NOT_OK(Compute(row, &result));
+
+    // The first row decides the shape and the type of the batched outputs
+    if (r == 0) {
+      for (auto &t : result) {
+        std::vector<dsize_t> batch_shape = {batch_size};
+        for (dsize_t d = 0; d < t->Rank(); d++) {
+          batch_shape.push_back(t->shape()[d]);
+        }
+        std::shared_ptr<Tensor> batch_tensor;
+        RETURN_IF_NOT_OK(
+          Tensor::CreateTensor(&batch_tensor, TensorImpl::kFlexible, TensorShape(batch_shape), t->type()));
+        output->push_back(std::move(batch_tensor));
+      }
+    }
+    if (result.size() != output->size()) {
+      RETURN_STATUS_UNEXPECTED("The rows of the batch produce a different number of outputs.");
+    }
+    for (size_t i = 0; i < result.size(); i++) {
+      if (result[i]->type() != (*output)[i]->type()) {
+        RETURN_STATUS_UNEXPECTED("The rows of the batch produce outputs of different types.");
+      }
+      // InsertTensor checks that the row shape matches the batch
+      RETURN_IF_NOT_OK((*output)[i]->InsertTensor({r}, result[i]));
+    }
+  }
+  return Status::OK();
+}
+
 void TensorOp::Print(std::ostream &out) const { out << "TensorOp" << std::endl; }
 
 Status TensorOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
@@ -65,6 +65,8 @@ class TensorOp {
   }
 
   // Perform an operation on one Tensor and produce one Tensor. This is for 1-to-1 column MapOp
+  // If *output already holds a view (see Tensor::CreateView) of the shape and type of the result, the op may write
+  // the result into it instead of allocating a new one (see MapOp batch slots), otherwise *output is replaced.
   // @param input  shares the ownership of the Tensor (increase the ref count).
   // @param output the address to a shared_ptr where the result will be placed.
   // @return Status
@@ -78,6 +80,39 @@ class TensorOp {
   virtual Status Compute(const std::vector<std::shared_ptr<Tensor>> &input,
                          std::vector<std::shared_ptr<Tensor>> *output);
 
+  // Perform an operation on one batched Tensor and produce one batched Tensor. This is for 1-to-1 column MapOp in
+  // batch mode. The rows of the batch are stacked along the first dimension of the input.
+  // The default runs Compute() on every row of the batch and stacks the results, the derived classes which can work on
+  // the whole batch at once override it.
+  // @param input  shares the ownership of the Tensor (increase the ref count).
+  // @param output the address to a shared_ptr where the result will be placed.
+  // @return Status
+  virtual Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  // Perform an operation on batched Tensors from multiple columns, and produce multiple batched Tensors.
+  // This is for m-to-n column MapOp in batch mode.
+  // @param input is a vector of shared_ptr to Tensor (pass by const reference).
+  // @param output is the address to an empty vector of shared_ptr to Tensor.
+  // @return Status
+  virtual Status BatchCompute(const std::vector<std::shared_ptr<Tensor>> &input,
+                              std::vector<std::shared_ptr<Tensor>> *output);
+
+  // Returns true if BatchCompute() works on the whole batch instead of falling back to one Compute() per row.
+  // @return true/false
+  virtual bool BatchSupported() const { return false; }
+
+  // Perform an operation on all the rows of a DataBuffer at once, the i-th output row is the result of the i-th
+  // input row. MapOp calls it instead of one Compute() per row when RowsSupported() is true.
+  // The default runs Compute() on every row.
+  // @param input is a vector of rows, each holding the Tensors of the input columns.
+  // @param output is the address to an empty vector of rows.
+  // @return Status
+  virtual Status RowsCompute(const std::vector<TensorRow> &input, std::vector<TensorRow> *output);
+
+  // Returns true if RowsCompute() has a cost per call to save, e.g. taking the Python GIL.
+  // @return true/false
+  virtual bool RowsSupported() const { return false; }
+
   // Returns true oif the TensorOp takes one input and returns one output.
   // @return true/false
   bool OneToOne() { return NumInput() == 1 && NumOutput() == 1; }
@@ -103,6 +138,13 @@ class TensorOp {
   // @param outputs out: vector of the types of the output tensors to be filled.
   // @return Status
   virtual Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs);
+
+ protected:
+  // Splits the batched input Tensors along their first dimension, runs Compute() on every row and stacks the results.
+  // @param input is a vector of shared_ptr to the batched Tensors, all of them with the same batch size.
+  // @param output is the address to an empty vector of shared_ptr to Tensor.
+  // @return Status
+  Status ComputePerRow(const std::vector<std::shared_ptr<Tensor>> &input, std::vector<std::shared_ptr<Tensor>> *output);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/text/pad_mask_op.h"
+
+#include <cstring>
+
+#include "dataset/kernels/text/text_utils.h"
+
+namespace mindspore {
+namespace dataset {
+const double PadMaskOp::kDefPadValue = 0;
+
+Status PadMaskOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (!input->shape().known()) {
+    RETURN_STATUS_UNEXPECTED("PadMask needs a tensor of a known shape.");
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), DataType(DataType::DE_INT32)));
+  dsize_t num_elements = input->Size();
+  if (num_elements == 0) {
+    return Status::OK();
+  }
+  const unsigned char *in = input->StartAddr();
+  auto *out = reinterpret_cast<int32_t *>((*output)->StartAddr());
+  if (in == nullptr || out == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Failed to create memory for Tensor.");
+  }
+
+  // Compare the bytes of the elements, so every type is masked without a cast
+  std::vector<uchar> pad;
+  RETURN_IF_NOT_OK(ValueToBytes(pad_value_, input->type(), &pad));
+  size_t element_bytes = pad.size();
+  for (dsize_t i = 0; i < num_elements; i++) {
+    out[i] = std::memcmp(in + i * element_bytes, pad.data(), element_bytes) == 0 ? 0 : 1;
+  }
+  return Status::OK();
+}
+
+Status PadMaskOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_INT32);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
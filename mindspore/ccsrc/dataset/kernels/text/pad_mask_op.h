@@ -0,0 +1,55 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_TEXT_PAD_MASK_OP_H_
+#define DATASET_KERNELS_TEXT_PAD_MASK_OP_H_
+
+#include <memory>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/kernels/tensor_op.h"
+
+namespace mindspore {
+namespace dataset {
+// Generate the int32 mask of a padded tensor, which is 0 for the elements equal to the pad value and 1 for the others.
+// e.g. [5,6,0,0] --> [1,1,0,0], like the input mask of BERT.
+class PadMaskOp : public TensorOp {
+ public:
+  static const double kDefPadValue;
+
+  explicit PadMaskOp(double pad_value = kDefPadValue) : pad_value_(pad_value) {}
+
+  ~PadMaskOp() override = default;
+
+  void Print(std::ostream &out) const override { out << "PadMaskOp"; }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  // Element wise, the whole batch is computed in one pass.
+  Status BatchCompute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    return Compute(input, output);
+  }
+
+  bool BatchSupported() const override { return true; }
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+ private:
+  double pad_value_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_KERNELS_TEXT_PAD_MASK_OP_H_
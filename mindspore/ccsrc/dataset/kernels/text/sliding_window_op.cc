@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/text/sliding_window_op.h"
+
+#include <algorithm>
+
+namespace mindspore {
+namespace dataset {
+Status SlidingWindowOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (width_ <= 0) {
+    RETURN_STATUS_UNEXPECTED("The width of SlidingWindow should be positive.");
+  }
+  if (input->Rank() < 1 || !input->shape().known()) {
+    RETURN_STATUS_UNEXPECTED("SlidingWindow needs a tensor of a known shape with at least one dimension.");
+  }
+  const TensorShape &shape = input->shape();
+  dsize_t num_windows = std::max<dsize_t>(shape[0] - width_ + 1, 0);
+  std::vector<dsize_t> out_dims = {num_windows, width_};
+  for (dsize_t i = 1; i < shape.Rank(); i++) {
+    out_dims.push_back(shape[i]);
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, TensorShape(out_dims), input->type()));
+  if ((*output)->SizeInBytes() == 0) {
+    return Status::OK();
+  }
+
+  // Every window is a contiguous copy, the next one starts one row later
+  dsize_t row_bytes = shape.Stride(0) * input->type().SizeInBytes();
+  dsize_t window_bytes = width_ * row_bytes;
+  const unsigned char *in = input->StartAddr();
+  unsigned char *out = (*output)->StartAddr();
+  if (in == nullptr || out == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Failed to create memory for Tensor.");
+  }
+  for (dsize_t w = 0; w < num_windows; w++) {
+    int ret_code = memcpy_s(out + w * window_bytes, window_bytes, in + w * row_bytes, window_bytes);
+    if (ret_code != 0) {
+      RETURN_STATUS_UNEXPECTED("Failed to copy the window of SlidingWindow.");
+    }
+  }
+  return Status::OK();
+}
+
+Status SlidingWindowOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  if (inputs[0].Rank() >= 1) {
+    std::vector<dsize_t> out_dims = {inputs[0][0] < 0 ? -1 : std::max<dsize_t>(inputs[0][0] - width_ + 1, 0), width_};
+    for (dsize_t i = 1; i < inputs[0].Rank(); i++) {
+      out_dims.push_back(inputs[0][i]);
+    }
+    outputs.emplace_back(out_dims);
+  }
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+}  // namespace dataset
+}  // namespace mindspore
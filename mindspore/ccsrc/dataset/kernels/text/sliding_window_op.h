@@ -0,0 +1,46 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_TEXT_SLIDING_WINDOW_OP_H_
+#define DATASET_KERNELS_TEXT_SLIDING_WINDOW_OP_H_
+
+#include <memory>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/kernels/tensor_op.h"
+
+namespace mindspore {
+namespace dataset {
+// Stack the windows of width elements along the axis 0, e.g. [1,2,3,4] with width 3 --> [[1,2,3],[2,3,4]].
+// A tensor shorter than the width has no window.
+class SlidingWindowOp : public TensorOp {
+ public:
+  explicit SlidingWindowOp(int32_t width) : width_(width) {}
+
+  ~SlidingWindowOp() override = default;
+
+  void Print(std::ostream &out) const override { out << "SlidingWindowOp"; }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+ private:
+  int32_t width_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_KERNELS_TEXT_SLIDING_WINDOW_OP_H_
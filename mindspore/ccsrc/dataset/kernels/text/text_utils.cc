@@ -0,0 +1,140 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/text/text_utils.h"
+
+#include "dataset/kernels/data/data_utils.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr uint32_t kInvalidCodePoint = 0xFFFD;
+
+bool IsControl(uint32_t c) { return c < 0x20 || (c >= 0x7F && c <= 0x9F) || c == kInvalidCodePoint; }
+}  // namespace
+
+Status TensorToText(const std::shared_ptr<Tensor> &input, std::string *text) {
+  RETURN_UNEXPECTED_IF_NULL(input);
+  if (input->type() != DataType::DE_UINT8 && input->type() != DataType::DE_INT8) {
+    RETURN_STATUS_UNEXPECTED("The text should be the UTF-8 bytes in a tensor of uint8 or int8.");
+  }
+  if (input->Rank() > 1) {
+    RETURN_STATUS_UNEXPECTED("The text should be a 1D tensor.");
+  }
+  text->clear();
+  if (input->SizeInBytes() > 0) {
+    const unsigned char *data = input->StartAddr();
+    RETURN_UNEXPECTED_IF_NULL(data);
+    text->assign(reinterpret_cast<const char *>(data), static_cast<size_t>(input->SizeInBytes()));
+  }
+  return Status::OK();
+}
+
+Status IdsToTensor(const std::vector<int32_t> &ids, std::shared_ptr<Tensor> *output) {
+  return Tensor::CreateTensor(output, TensorImpl::kFlexible, TensorShape({static_cast<dsize_t>(ids.size())}),
+                              DataType(DataType::DE_INT32), reinterpret_cast<const unsigned char *>(ids.data()));
+}
+
+uint32_t NextCodePoint(const std::string &text, size_t *pos) {
+  auto c = static_cast<uint8_t>(text[*pos]);
+  size_t len = 0;
+  if (c < 0x80) {
+    len = 1;
+  } else if ((c >> 5) == 0x6) {
+    len = 2;
+  } else if ((c >> 4) == 0xE) {
+    len = 3;
+  } else if ((c >> 3) == 0x1E) {
+    len = 4;
+  }
+  if (len == 0 || *pos + len > text.size()) {
+    (*pos)++;
+    return kInvalidCodePoint;
+  }
+  uint32_t code_point = (len == 1) ? c : (c & (0x7Fu >> len));
+  for (size_t i = 1; i < len; i++) {
+    auto b = static_cast<uint8_t>(text[*pos + i]);
+    if ((b & 0xC0) != 0x80) {
+      (*pos)++;
+      return kInvalidCodePoint;
+    }
+    code_point = (code_point << 6) | (b & 0x3F);
+  }
+  *pos += len;
+  return code_point;
+}
+
+bool IsWhitespace(uint32_t c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == 0x0B || c == 0x0C || c == 0x85 || c == 0xA0 ||
+         c == 0x1680 || (c >= 0x2000 && c <= 0x200A) || c == 0x2028 || c == 0x2029 || c == 0x202F || c == 0x205F ||
+         c == 0x3000;
+}
+
+bool IsPunctuation(uint32_t c) {
+  // The ASCII symbols are taken as punctuations, as "$" or "^" are not in the punctuation category of Unicode.
+  if ((c >= 33 && c <= 47) || (c >= 58 && c <= 64) || (c >= 91 && c <= 96) || (c >= 123 && c <= 126)) {
+    return true;
+  }
+  return (c >= 0xA1 && c <= 0xBF) || (c >= 0x2010 && c <= 0x2027) || (c >= 0x2030 && c <= 0x205E) ||
+         (c >= 0x3001 && c <= 0x303F) || (c >= 0xFF01 && c <= 0xFF0F) || (c >= 0xFF1A && c <= 0xFF20) ||
+         (c >= 0xFF3B && c <= 0xFF40) || (c >= 0xFF5B && c <= 0xFF65);
+}
+
+bool IsCJKCharacter(uint32_t c) {
+  return (c >= 0x4E00 && c <= 0x9FFF) || (c >= 0x3400 && c <= 0x4DBF) || (c >= 0x20000 && c <= 0x2A6DF) ||
+         (c >= 0x2A700 && c <= 0x2CEAF) || (c >= 0xF900 && c <= 0xFAFF) || (c >= 0x2F800 && c <= 0x2FA1F);
+}
+
+void SplitWords(const std::string &text, bool lower_case, bool split_punctuation, std::vector<std::string> *words) {
+  std::string word;
+  auto end_word = [&word, words]() {
+    if (!word.empty()) {
+      words->push_back(word);
+      word.clear();
+    }
+  };
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t start = pos;
+    uint32_t c = NextCodePoint(text, &pos);
+    if (IsWhitespace(c)) {
+      end_word();
+    } else if (IsControl(c)) {
+      continue;
+    } else if (split_punctuation && (IsPunctuation(c) || IsCJKCharacter(c))) {
+      end_word();
+      words->push_back(text.substr(start, pos - start));
+    } else if (lower_case && c >= 'A' && c <= 'Z') {
+      word.push_back(static_cast<char>(c - 'A' + 'a'));
+    } else {
+      (void)word.append(text, start, pos - start);
+    }
+  }
+  end_word();
+}
+
+Status ValueToBytes(double value, const DataType &type, std::vector<uchar> *bytes) {
+  std::shared_ptr<Tensor> value_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(&value_tensor, TensorImpl::kFlexible, TensorShape::CreateScalar(),
+                                        DataType(DataType::DE_FLOAT64), reinterpret_cast<const uchar *>(&value)));
+  std::shared_ptr<Tensor> cast;
+  RETURN_IF_NOT_OK(TypeCast(value_tensor, &cast, type));
+  const uchar *data = cast->StartAddr();
+  RETURN_UNEXPECTED_IF_NULL(data);
+  bytes->assign(data, data + cast->SizeInBytes());
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_TEXT_TEXT_UTILS_H_
+#define DATASET_KERNELS_TEXT_TEXT_UTILS_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dataset/core/data_type.h"
+#include "dataset/core/tensor.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The text is kept as the UTF-8 bytes in a 1D tensor of DE_UINT8 or DE_INT8, as the bytes columns are read.
+// @param input
+// @param text the bytes of the tensor
+// @return Status
+Status TensorToText(const std::shared_ptr<Tensor> &input, std::string *text);
+
+// Create a 1D DE_INT32 tensor of the ids.
+// @param ids
+// @param output
+// @return Status
+Status IdsToTensor(const std::vector<int32_t> &ids, std::shared_ptr<Tensor> *output);
+
+// Decode the UTF-8 character starting at text[*pos] and move *pos to the next character.
+// An invalid byte is taken as a character by itself.
+// @param text
+// @param pos in: the start of the character, out: the start of the next one
+// @return the code point
+uint32_t NextCodePoint(const std::string &text, size_t *pos);
+
+bool IsWhitespace(uint32_t c);
+
+bool IsPunctuation(uint32_t c);
+
+// The CJK ideographs are words by themselves, as they are not separated by spaces.
+bool IsCJKCharacter(uint32_t c);
+
+// Split the text into words by the whitespaces, dropping the control characters. The ASCII letters are lower cased
+// if lower_case is true. If split_punctuation is true, every punctuation and CJK character is a word by itself.
+// @param text
+// @param lower_case
+// @param split_punctuation
+// @param words
+void SplitWords(const std::string &text, bool lower_case, bool split_punctuation, std::vector<std::string> *words);
+
+// Get the bytes of the value as an element of the type, to fill or compare the elements without a cast.
+// @param value
+// @param type
+// @param bytes
+// @return Status
+Status ValueToBytes(double value, const DataType &type, std::vector<uchar> *bytes);
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_KERNELS_TEXT_TEXT_UTILS_H_
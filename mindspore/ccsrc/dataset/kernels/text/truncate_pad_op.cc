@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/text/truncate_pad_op.h"
+
+#include <algorithm>
+
+#include "dataset/kernels/text/text_utils.h"
+
+namespace mindspore {
+namespace dataset {
+const double TruncatePadOp::kDefPadValue = 0;
+
+Status TruncatePadOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (length_ < 0) {
+    RETURN_STATUS_UNEXPECTED("The length of TruncatePad should not be negative.");
+  }
+  if (input->Rank() < 1 || !input->shape().known()) {
+    RETURN_STATUS_UNEXPECTED("TruncatePad needs a tensor of a known shape with at least one dimension.");
+  }
+  const TensorShape &shape = input->shape();
+  std::vector<dsize_t> out_dims = shape.AsVector();
+  out_dims[0] = length_;
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, TensorShape(out_dims), input->type()));
+  dsize_t out_bytes = (*output)->SizeInBytes();
+  if (out_bytes == 0) {
+    return Status::OK();
+  }
+  const unsigned char *in = input->StartAddr();
+  unsigned char *out = (*output)->StartAddr();
+  if (out == nullptr || (in == nullptr && input->SizeInBytes() > 0)) {
+    RETURN_STATUS_UNEXPECTED("Failed to create memory for Tensor.");
+  }
+
+  // Copy the kept rows at once, then fill the padded elements with the bytes of the pad value
+  dsize_t copy_bytes = std::min<dsize_t>(shape[0], length_) * shape.Stride(0) * input->type().SizeInBytes();
+  if (copy_bytes > 0 && memcpy_s(out, out_bytes, in, copy_bytes) != 0) {
+    RETURN_STATUS_UNEXPECTED("Failed to copy the data of TruncatePad.");
+  }
+  if (copy_bytes < out_bytes) {
+    std::vector<uchar> pad;
+    RETURN_IF_NOT_OK(ValueToBytes(pad_value_, input->type(), &pad));
+    for (dsize_t pos = copy_bytes; pos < out_bytes; pos += pad.size()) {
+      std::copy(pad.begin(), pad.end(), out + pos);
+    }
+  }
+  return Status::OK();
+}
+
+Status TruncatePadOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  if (inputs[0].Rank() >= 1) {
+    std::vector<dsize_t> out_dims = inputs[0].AsVector();
+    out_dims[0] = length_;
+    outputs.emplace_back(out_dims);
+  }
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+}  // namespace dataset
+}  // namespace mindspore
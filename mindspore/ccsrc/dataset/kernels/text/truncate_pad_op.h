@@ -0,0 +1,51 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_TEXT_TRUNCATE_PAD_OP_H_
+#define DATASET_KERNELS_TEXT_TRUNCATE_PAD_OP_H_
+
+#include <memory>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/kernels/tensor_op.h"
+
+namespace mindspore {
+namespace dataset {
+// Truncate or pad the tensor along the axis 0 to the length, so the sequences of a batch have the same shape.
+// e.g. [1,2,3] with length 5 --> [1,2,3,0,0], with length 2 --> [1,2]
+class TruncatePadOp : public TensorOp {
+ public:
+  static const double kDefPadValue;
+
+  // @param length
+  // @param pad_value the value of the padded elements, cast to the type of the tensor
+  explicit TruncatePadOp(int32_t length, double pad_value = kDefPadValue) : length_(length), pad_value_(pad_value) {}
+
+  ~TruncatePadOp() override = default;
+
+  void Print(std::ostream &out) const override { out << "TruncatePadOp"; }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+ private:
+  int32_t length_;
+  double pad_value_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_KERNELS_TEXT_TRUNCATE_PAD_OP_H_
@@ -0,0 +1,55 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/text/vocab.h"
+
+#include <fstream>
+
+namespace mindspore {
+namespace dataset {
+constexpr int32_t Vocab::kNoId;
+
+Vocab::Vocab(const std::vector<std::string> &words) {
+  word2id_.reserve(words.size());
+  for (size_t i = 0; i < words.size(); i++) {
+    // The first one wins if a word is repeated
+    (void)word2id_.emplace(words[i], static_cast<int32_t>(i));
+  }
+}
+
+Status Vocab::FromFile(const std::string &path, std::shared_ptr<Vocab> *vocab) {
+  std::ifstream file_handle(path);
+  if (!file_handle.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open the vocab file: " + path);
+  }
+  std::vector<std::string> words;
+  std::string line;
+  while (std::getline(file_handle, line)) {
+    // Drop the line end of the files saved on windows
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    words.push_back(line);
+  }
+  *vocab = std::make_shared<Vocab>(words);
+  return Status::OK();
+}
+
+int32_t Vocab::Lookup(const std::string &word) const {
+  auto itr = word2id_.find(word);
+  return itr == word2id_.end() ? kNoId : itr->second;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_TEXT_VOCAB_H_
+#define DATASET_KERNELS_TEXT_VOCAB_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// A hash table from the words to their ids. It is not changed after it is created, so the tokenizers of all the
+// MapOp workers share it.
+class Vocab {
+ public:
+  static constexpr int32_t kNoId = -1;
+
+  // The id of a word is its index in the list
+  // @param words
+  explicit Vocab(const std::vector<std::string> &words);
+
+  ~Vocab() = default;
+
+  // Load a vocab file with one word per line, like the vocab files of BERT.
+  // @param path
+  // @param vocab
+  // @return Status
+  static Status FromFile(const std::string &path, std::shared_ptr<Vocab> *vocab);
+
+  // Return the id of the word, or kNoId if it is not in the vocab
+  // @param word
+  // @return int32_t
+  int32_t Lookup(const std::string &word) const;
+
+  size_t size() const { return word2id_.size(); }
+
+ private:
+  std::unordered_map<std::string, int32_t> word2id_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_KERNELS_TEXT_VOCAB_H_
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/text/whitespace_tokenizer_op.h"
+
+#include "dataset/kernels/text/text_utils.h"
+
+namespace mindspore {
+namespace dataset {
+const char WhitespaceTokenizerOp::kDefUnknownToken[] = "[UNK]";
+const bool WhitespaceTokenizerOp::kDefLowerCase = false;
+
+WhitespaceTokenizerOp::WhitespaceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &unknown_token,
+                                             bool lower_case)
+    : vocab_(vocab), unknown_id_(Vocab::kNoId), lower_case_(lower_case), split_punctuation_(false) {
+  if (vocab_ != nullptr) {
+    unknown_id_ = vocab_->Lookup(unknown_token);
+  }
+}
+
+Status WhitespaceTokenizerOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  RETURN_UNEXPECTED_IF_NULL(vocab_);
+  std::string text;
+  RETURN_IF_NOT_OK(TensorToText(input, &text));
+  std::vector<std::string> words;
+  SplitWords(text, lower_case_, split_punctuation_, &words);
+  std::vector<int32_t> ids;
+  ids.reserve(words.size());
+  for (const auto &word : words) {
+    RETURN_IF_NOT_OK(AddWordIds(word, &ids));
+  }
+  return IdsToTensor(ids, output);
+}
+
+Status WhitespaceTokenizerOp::AddWordIds(const std::string &word, std::vector<int32_t> *ids) const {
+  int32_t id = vocab_->Lookup(word);
+  if (id == Vocab::kNoId) {
+    return AddUnknownId(word, ids);
+  }
+  ids->push_back(id);
+  return Status::OK();
+}
+
+Status WhitespaceTokenizerOp::AddUnknownId(const std::string &word, std::vector<int32_t> *ids) const {
+  if (unknown_id_ == Vocab::kNoId) {
+    RETURN_STATUS_UNEXPECTED("The word is not in the vocab and there is no unknown token: " + word);
+  }
+  ids->push_back(unknown_id_);
+  return Status::OK();
+}
+
+Status WhitespaceTokenizerOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  if (inputs[0].Rank() <= 1) outputs.emplace_back(TensorShape({-1}));
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+
+Status WhitespaceTokenizerOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_INT32);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
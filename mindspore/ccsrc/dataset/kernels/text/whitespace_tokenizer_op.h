@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_TEXT_WHITESPACE_TOKENIZER_OP_H_
+#define DATASET_KERNELS_TEXT_WHITESPACE_TOKENIZER_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/kernels/tensor_op.h"
+#include "dataset/kernels/text/vocab.h"
+
+namespace mindspore {
+namespace dataset {
+// Split the UTF-8 text of a 1D uint8 tensor by the whitespaces and look the words up in the vocab, the output is a
+// 1D int32 tensor of the ids. The words not in the vocab get the id of the unknown token.
+class WhitespaceTokenizerOp : public TensorOp {
+ public:
+  static const char kDefUnknownToken[];
+  static const bool kDefLowerCase;
+
+  // @param vocab
+  // @param unknown_token the token of the words not in the vocab, an error is raised for them if it is not in the
+  //     vocab either
+  // @param lower_case lower case the ASCII letters before the lookup
+  explicit WhitespaceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
+                                 const std::string &unknown_token = kDefUnknownToken,
+                                 bool lower_case = kDefLowerCase);
+
+  ~WhitespaceTokenizerOp() override = default;
+
+  void Print(std::ostream &out) const override { out << "WhitespaceTokenizerOp"; }
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+ protected:
+  // Append the ids of a word
+  // @param word
+  // @param ids
+  // @return Status
+  virtual Status AddWordIds(const std::string &word, std::vector<int32_t> *ids) const;
+
+  // Append the id of the unknown token
+  // @param word the word for the error message
+  // @param ids
+  // @return Status
+  Status AddUnknownId(const std::string &word, std::vector<int32_t> *ids) const;
+
+  std::shared_ptr<Vocab> vocab_;
+  int32_t unknown_id_;
+  bool lower_case_;
+  bool split_punctuation_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_KERNELS_TEXT_WHITESPACE_TOKENIZER_OP_H_
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/text/wordpiece_tokenizer_op.h"
+
+namespace mindspore {
+namespace dataset {
+const bool WordpieceTokenizerOp::kDefLowerCase = true;
+const int32_t WordpieceTokenizerOp::kDefMaxBytesPerWord = 100;
+const char WordpieceTokenizerOp::kSuffixIndicator[] = "##";
+
+WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &unknown_token,
+                                           bool lower_case, int32_t max_bytes_per_word)
+    : WhitespaceTokenizerOp(vocab, unknown_token, lower_case), max_bytes_per_word_(max_bytes_per_word) {
+  split_punctuation_ = true;
+}
+
+Status WordpieceTokenizerOp::AddWordIds(const std::string &word, std::vector<int32_t> *ids) const {
+  if (word.size() > static_cast<size_t>(max_bytes_per_word_)) {
+    return AddUnknownId(word, ids);
+  }
+  size_t num_ids = ids->size();
+  size_t start = 0;
+  while (start < word.size()) {
+    // Find the longest piece in the vocab, which ends at the boundary of a UTF-8 character
+    int32_t id = Vocab::kNoId;
+    size_t end = word.size();
+    for (; end > start; end--) {
+      if (end < word.size() && (static_cast<uint8_t>(word[end]) & 0xC0) == 0x80) {
+        continue;
+      }
+      std::string piece = word.substr(start, end - start);
+      id = vocab_->Lookup(start > 0 ? kSuffixIndicator + piece : piece);
+      if (id != Vocab::kNoId) {
+        break;
+      }
+    }
+    if (id == Vocab::kNoId) {
+      ids->resize(num_ids);
+      return AddUnknownId(word, ids);
+    }
+    ids->push_back(id);
+    start = end;
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
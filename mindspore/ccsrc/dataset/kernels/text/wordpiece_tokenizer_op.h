@@ -0,0 +1,58 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_TEXT_WORDPIECE_TOKENIZER_OP_H_
+#define DATASET_KERNELS_TEXT_WORDPIECE_TOKENIZER_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/kernels/text/whitespace_tokenizer_op.h"
+#include "dataset/kernels/text/vocab.h"
+
+namespace mindspore {
+namespace dataset {
+// The tokenizer of BERT. The text is split by the whitespaces, the punctuations and the CJK characters, and every word
+// is split into the longest pieces in the vocab from its start, the pieces after the first one are prefixed by "##".
+// A word which can not be split in this way gets the id of the unknown token.
+class WordpieceTokenizerOp : public WhitespaceTokenizerOp {
+ public:
+  static const bool kDefLowerCase;
+  static const int32_t kDefMaxBytesPerWord;
+  static const char kSuffixIndicator[];
+
+  // @param vocab
+  // @param unknown_token
+  // @param lower_case
+  // @param max_bytes_per_word the longer words are unknown
+  explicit WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
+                                const std::string &unknown_token = kDefUnknownToken,
+                                bool lower_case = kDefLowerCase, int32_t max_bytes_per_word = kDefMaxBytesPerWord);
+
+  ~WordpieceTokenizerOp() override = default;
+
+  void Print(std::ostream &out) const override { out << "WordpieceTokenizerOp"; }
+
+ protected:
+  Status AddWordIds(const std::string &word, std::vector<int32_t> *ids) const override;
+
+ private:
+  int32_t max_bytes_per_word_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_KERNELS_TEXT_WORDPIECE_TOKENIZER_OP_H_
@@ -0,0 +1,295 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_BTREE_OLC_H_
+#define DATASET_UTIL_BTREE_OLC_H_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dataset/util/allocator.h"
+#include "dataset/util/btree.h"
+#include "dataset/util/list.h"
+#include "dataset/util/lock.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// A B+ tree for many concurrent writers with optimistic lock coupling. Instead of the tree wide RWLock of
+// BPlusTree, each node has a version lock. The searches and the descent of the inserts take no lock, they
+// validate the version of each node they read and restart when a node changed under them. An insert locks
+// only the leaf which takes the key, or a full node and its parent to split it. The full nodes are split on
+// the way down, so a split never goes up more than one level.
+// An optimistic read may see a node in the middle of a change before it fails its validation, hence the keys
+// must be trivially copyable. The values are copied into the tree once and never move, a search copies one
+// out after the validation. Keys are never removed.
+// @tparam K
+// @tparam V
+// @tparam C
+// @tparam T
+template <typename K, typename V, typename C = std::less<K>, typename T = BPlusTreeTraits>
+class OlcBPlusTree {
+ public:
+  static_assert(std::is_trivially_copyable<K>::value, "The keys of an OlcBPlusTree are read optimistically");
+
+  using IndexRc = typename BPlusTree<K, V, C, T>::IndexRc;
+  using key_type = K;
+  using value_type = V;
+  using key_compare = C;
+  using slot_type = typename T::slot_type;
+  using traits = T;
+  using value_allocator = Allocator<value_type>;
+
+  explicit OlcBPlusTree(const value_allocator &alloc);
+
+  ~OlcBPlusTree() noexcept;
+
+  OlcBPlusTree(const OlcBPlusTree &) = delete;
+
+  OlcBPlusTree(OlcBPlusTree &&) = delete;
+
+  OlcBPlusTree &operator=(const OlcBPlusTree &) = delete;
+
+  OlcBPlusTree &operator=(OlcBPlusTree &&) = delete;
+
+  key_compare key_comp() const { return key_less_; }
+
+  size_t size() const { return stats_.size_; }
+
+  bool empty() const { return (size() == 0); }
+
+  // @return The number of leaves
+  uint32_t leaves() const { return stats_.leaves_; }
+
+  // @return The number of levels above the leaves
+  uint32_t level() const { return stats_.level_; }
+
+  // Inserts a key, safe to call from many threads at once.
+  // @param key
+  // @param value
+  // @return Status - The error code return, kDuplicateKey if the key is in the tree already
+  Status DoInsert(const key_type &key, const value_type &value);
+
+  // Builds the tree bottom up from the pairs of a sorted range, much faster than inserting them one by one.
+  // The tree must be empty and not used by other threads until the load returns.
+  // @param first - The first std::pair<key_type, value_type>, the keys are strictly increasing
+  // @param last - The end of the range
+  // @return Status - The error code return
+  template <typename Iter>
+  Status BulkLoad(Iter first, Iter last);
+
+  // Looks up a key, safe to call while other threads insert.
+  // @param key
+  // @param value - A copy of the value of the key
+  // @return T/F if the key is in the tree
+  bool Search(const key_type &key, value_type *value) const;
+
+  // Statistics
+  struct tree_stats {
+    std::atomic<uint64_t> size_;
+    std::atomic<uint32_t> leaves_;
+    std::atomic<uint32_t> inner_nodes_;
+    std::atomic<uint32_t> level_;
+
+    tree_stats() : size_(0), leaves_(0), inner_nodes_(0), level_(0) {}
+  };
+
+ private:
+  // The part of a node (leaf or inner) which the optimistic readers look at first
+  class BaseNode {
+   public:
+    friend class OlcBPlusTree;
+
+    explicit BaseNode(bool leaf) : leaf_(leaf), slotuse_(0) {}
+
+    bool is_leafnode() const { return leaf_; }
+
+   protected:
+    VersionLock lock_;
+    const bool leaf_;
+    slot_type slotuse_;
+
+   private:
+    Node<BaseNode> lru_;
+  };
+
+  // Definition of inner node which fans to either inner node or leaf node. The keys are sorted, the child i
+  // holds the keys from keys_[i - 1] up to keys_[i] excluded.
+  class InnerNode : public BaseNode {
+   public:
+    friend class OlcBPlusTree;
+
+    using alloc_type = typename value_allocator::template rebind<InnerNode>::other;
+
+    bool is_full() const { return (this->slotuse_ == traits::kInnerSlots); }
+
+    // Adds the new right sibling of a child which was split.
+    void InsertChild(const key_type &split_key, BaseNode *child, const key_compare &key_less);
+
+    InnerNode() : BaseNode::BaseNode(false) {}
+
+    ~InnerNode() = default;
+
+    key_type keys_[traits::kInnerSlots];
+    BaseNode *data_[traits::kInnerSlots + 1] = {nullptr};
+  };
+
+  // Definition of a leaf node which contains the key/value pair. The keys are sorted.
+  class LeafNode : public BaseNode {
+   public:
+    friend class OlcBPlusTree;
+
+    using alloc_type = typename value_allocator::template rebind<LeafNode>::other;
+    Node<LeafNode> link_;
+
+    bool is_full() const { return (this->slotuse_ == traits::kLeafSlots); }
+
+    IndexRc InsertIntoSlot(const key_type &key, value_type *value, const key_compare &key_less);
+
+    LeafNode() : BaseNode::BaseNode(true) {}
+
+    ~LeafNode() = default;
+
+    key_type keys_[traits::kLeafSlots];
+    value_type *data_[traits::kLeafSlots] = {nullptr};
+  };
+
+  // The retries of an insert or a search after which it yields to the writers it waits for
+  static constexpr int32_t kRetriesBeforeYield = 16;
+
+  value_allocator alloc_;
+  // Guards all_ and leaf_nodes_
+  SpinLock list_lock_;
+  // Guards the creation of the first root
+  SpinLock root_lock_;
+  // All the leaf nodes. Used by the iterator to traverse all the key/values.
+  List<LeafNode> leaf_nodes_;
+  // All the nodes (inner + leaf). Used by the destructor to free the memory of all the nodes.
+  List<BaseNode> all_;
+  // Pointer to the root of the tree.
+  std::atomic<BaseNode *> root_;
+  // Key comparison object
+  key_compare key_less_;
+  // Stat
+  tree_stats stats_;
+
+  bool Equal(const key_type &a, const key_type &b) const { return !key_less_(a, b) && !key_less_(b, a); }
+
+  static Status IndexRc2Status(IndexRc rc);
+
+  IndexRc AllocateInner(InnerNode **p);
+
+  IndexRc AllocateLeaf(LeafNode **p);
+
+  IndexRc AllocateValue(const value_type &value, value_type **p);
+
+  void FreeValue(value_type *p);
+
+  // @return The branch of an inner node to follow for a key. The slot use is read optimistically, it is
+  // bounded so that a torn read stays in the node.
+  slot_type FindBranch(const InnerNode *inner, const key_type &key) const {
+    slot_type n = std::min(inner->slotuse_, static_cast<slot_type>(traits::kInnerSlots));
+    return static_cast<slot_type>(std::upper_bound(inner->keys_, inner->keys_ + n, key, key_less_) - inner->keys_);
+  }
+
+  // @return The slot of the first key of a leaf which is not less than a key
+  slot_type FindSlot(const LeafNode *leaf, const key_type &key) const {
+    slot_type n = std::min(leaf->slotuse_, static_cast<slot_type>(traits::kLeafSlots));
+    return static_cast<slot_type>(std::lower_bound(leaf->keys_, leaf->keys_ + n, key, key_less_) - leaf->keys_);
+  }
+
+  // One optimistic pass of an insert, kRetry when a node changed under it or after a split.
+  IndexRc TryInsert(const key_type &key, value_type *value);
+
+  // Splits a full node with its parent locked, then asks for a retry.
+  IndexRc SplitNode(InnerNode *parent, uint64_t parent_version, BaseNode *node, uint64_t version,
+                    const key_type &key);
+
+  IndexRc SplitInner(InnerNode *node, const key_type &key, key_type *split_key, InnerNode **split_node);
+
+  IndexRc SplitLeaf(LeafNode *node, const key_type &key, key_type *split_key, LeafNode **split_node);
+
+  // One optimistic pass of a search, kRetry when a node changed under it.
+  IndexRc TrySearch(const key_type &key, value_type **value) const;
+
+ public:
+  // Walks the key/values in order. It must not run alongside the inserts.
+  class ConstIterator : public std::iterator<std::forward_iterator_tag, value_type> {
+   public:
+    using reference = const OlcBPlusTree::value_type &;
+    using pointer = const OlcBPlusTree::value_type *;
+
+    ConstIterator(const LeafNode *leaf, slot_type slot) : cur_(leaf), slot_(slot) { SkipEmpty(); }
+
+    ~ConstIterator() = default;
+
+    pointer operator->() const { return cur_->data_[slot_]; }
+
+    reference operator*() const { return *(cur_->data_[slot_]); }
+
+    const key_type &key() const { return cur_->keys_[slot_]; }
+
+    const value_type &value() const { return *(cur_->data_[slot_]); }
+
+    // Prefix++
+    ConstIterator &operator++() {
+      ++slot_;
+      SkipEmpty();
+      return *this;
+    }
+
+    // Postfix++
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const ConstIterator &x) const { return (x.cur_ == cur_) && (x.slot_ == slot_); }
+
+    bool operator!=(const ConstIterator &x) const { return (x.cur_ != cur_) || (x.slot_ != slot_); }
+
+   private:
+    // Moves past the end of a leaf to the next one
+    void SkipEmpty() {
+      while (cur_ != nullptr && slot_ >= cur_->slotuse_) {
+        cur_ = cur_->link_.next;
+        slot_ = 0;
+      }
+    }
+
+    const typename OlcBPlusTree::LeafNode *cur_;
+    slot_type slot_;
+  };
+
+  ConstIterator begin() const { return ConstIterator(leaf_nodes_.head, 0); }
+
+  ConstIterator end() const { return ConstIterator(nullptr, 0); }
+
+  ConstIterator cbegin() const { return begin(); }
+
+  ConstIterator cend() const { return end(); }
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#include "btree_olc_impl.tpp"
+
+#endif  // DATASET_UTIL_BTREE_OLC_H_
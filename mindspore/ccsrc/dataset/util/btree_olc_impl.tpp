@@ -0,0 +1,487 @@
+/* Copyright 2019 Huawei Technologies Co., Ltd.All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_BTREE_OLC_IMPL_H_
+#define DATASET_UTIL_BTREE_OLC_IMPL_H_
+
+#include "btree_olc.h"
+
+namespace mindspore {
+namespace dataset {
+template <typename K, typename V, typename C, typename T>
+void OlcBPlusTree<K, V, C, T>::InnerNode::InsertChild(const key_type &split_key, BaseNode *child,
+                                                      const key_compare &key_less) {
+  DS_ASSERT(!is_full());
+  slot_type slot =
+    static_cast<slot_type>(std::upper_bound(keys_, keys_ + this->slotuse_, split_key, key_less) - keys_);
+  std::copy_backward(keys_ + slot, keys_ + this->slotuse_, keys_ + this->slotuse_ + 1);
+  std::copy_backward(data_ + slot + 1, data_ + this->slotuse_ + 1, data_ + this->slotuse_ + 2);
+  keys_[slot] = split_key;
+  data_[slot + 1] = child;
+  ++this->slotuse_;
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::LeafNode::InsertIntoSlot(
+  const key_type &key, value_type *value, const key_compare &key_less) {
+  DS_ASSERT(!is_full());
+  slot_type slot = static_cast<slot_type>(std::lower_bound(keys_, keys_ + this->slotuse_, key, key_less) - keys_);
+  if (slot < this->slotuse_ && !key_less(key, keys_[slot])) {
+    return IndexRc::kDuplicateKey;
+  }
+  std::copy_backward(keys_ + slot, keys_ + this->slotuse_, keys_ + this->slotuse_ + 1);
+  std::copy_backward(data_ + slot, data_ + this->slotuse_, data_ + this->slotuse_ + 1);
+  keys_[slot] = key;
+  data_[slot] = value;
+  ++this->slotuse_;
+  return IndexRc::kOk;
+}
+
+template <typename K, typename V, typename C, typename T>
+Status OlcBPlusTree<K, V, C, T>::IndexRc2Status(IndexRc rc) {
+  if (rc == IndexRc::kOk) {
+    return Status(StatusCode::kOK);
+  } else if (rc == IndexRc::kOutOfMemory) {
+    return Status(StatusCode::kOutOfMemory);
+  } else if (rc == IndexRc::kDuplicateKey) {
+    return Status(StatusCode::kDuplicateKey);
+  } else {
+    RETURN_STATUS_UNEXPECTED(std::to_string(static_cast<int>(rc)));
+  }
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::AllocateInner(InnerNode **p) {
+  if (p == nullptr) {
+    return IndexRc::kNullPointer;
+  }
+  typename InnerNode::alloc_type alloc(alloc_);
+  InnerNode *ptr = nullptr;
+  try {
+    ptr = alloc.allocate(1);
+  } catch (std::bad_alloc &e) {
+    return IndexRc::kOutOfMemory;
+  } catch (std::exception &e) {
+    return IndexRc::kUnexpectedError;
+  }
+  *p = new (ptr) InnerNode();
+  LockGuard lck(&list_lock_);
+  all_.Prepend(ptr);
+  stats_.inner_nodes_++;
+  return IndexRc::kOk;
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::AllocateLeaf(LeafNode **p) {
+  if (p == nullptr) {
+    return IndexRc::kNullPointer;
+  }
+  typename LeafNode::alloc_type alloc(alloc_);
+  LeafNode *ptr = nullptr;
+  try {
+    ptr = alloc.allocate(1);
+  } catch (std::bad_alloc &e) {
+    return IndexRc::kOutOfMemory;
+  } catch (std::exception &e) {
+    return IndexRc::kUnexpectedError;
+  }
+  *p = new (ptr) LeafNode();
+  LockGuard lck(&list_lock_);
+  all_.Prepend(ptr);
+  stats_.leaves_++;
+  return IndexRc::kOk;
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::AllocateValue(const value_type &value,
+                                                                                   value_type **p) {
+  if (p == nullptr) {
+    return IndexRc::kNullPointer;
+  }
+  value_allocator alloc(alloc_);
+  value_type *ptr = nullptr;
+  try {
+    ptr = alloc.allocate(1);
+    *p = new (ptr) value_type(value);
+  } catch (std::bad_alloc &e) {
+    if (ptr != nullptr) {
+      alloc.deallocate(ptr, 1);
+    }
+    return IndexRc::kOutOfMemory;
+  } catch (std::exception &e) {
+    if (ptr != nullptr) {
+      alloc.deallocate(ptr, 1);
+    }
+    return IndexRc::kUnexpectedError;
+  }
+  return IndexRc::kOk;
+}
+
+template <typename K, typename V, typename C, typename T>
+void OlcBPlusTree<K, V, C, T>::FreeValue(value_type *p) {
+  value_allocator alloc(alloc_);
+  p->~value_type();
+  alloc.deallocate(p, 1);
+}
+
+template <typename K, typename V, typename C, typename T>
+OlcBPlusTree<K, V, C, T>::OlcBPlusTree(const value_allocator &alloc)
+    : alloc_(alloc), leaf_nodes_(&LeafNode::link_), all_(&BaseNode::lru_), root_(nullptr) {}
+
+template <typename K, typename V, typename C, typename T>
+OlcBPlusTree<K, V, C, T>::~OlcBPlusTree() noexcept {
+  // We have a list of all the nodes allocated. Traverse them and free all the memory
+  BaseNode *n = all_.head;
+  BaseNode *t = nullptr;
+  while (n) {
+    t = n->lru_.next;
+    all_.Remove(n);
+    if (n->is_leafnode()) {
+      auto *leaf = static_cast<LeafNode *>(n);
+      for (slot_type i = 0; i < leaf->slotuse_; i++) {
+        FreeValue(leaf->data_[i]);
+      }
+      typename LeafNode::alloc_type alloc(alloc_);
+      leaf->~LeafNode();
+      alloc.deallocate(leaf, 1);
+    } else {
+      auto *in = static_cast<InnerNode *>(n);
+      typename InnerNode::alloc_type alloc(alloc_);
+      in->~InnerNode();
+      alloc.deallocate(in, 1);
+    }
+    n = t;
+  }
+  root_ = nullptr;
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::SplitInner(InnerNode *node, const key_type &key,
+                                                                                key_type *split_key,
+                                                                                InnerNode **split_node) {
+  InnerNode *new_inner = nullptr;
+  RETURN_IF_BAD_RC(AllocateInner(&new_inner));
+  slot_type n = node->slotuse_;
+  // In append mode the keys after the last one go to a new right node, which leaves the left one full.
+  slot_type mid = (traits::kAppendMode && !key_less_(key, node->keys_[n - 1])) ? n - 1 : n >> 1;
+  *split_key = node->keys_[mid];
+  // The split key moves up, the right node takes the keys after it and their children
+  std::copy(node->keys_ + mid + 1, node->keys_ + n, new_inner->keys_);
+  std::copy(node->data_ + mid + 1, node->data_ + n + 1, new_inner->data_);
+  new_inner->slotuse_ = n - mid - 1;
+  node->slotuse_ = mid;
+  *split_node = new_inner;
+  return IndexRc::kOk;
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::SplitLeaf(LeafNode *node, const key_type &key,
+                                                                               key_type *split_key,
+                                                                               LeafNode **split_node) {
+  LeafNode *new_leaf = nullptr;
+  RETURN_IF_BAD_RC(AllocateLeaf(&new_leaf));
+  slot_type n = node->slotuse_;
+  slot_type mid = n >> 1;
+  if (traits::kAppendMode && key_less_(node->keys_[n - 1], key)) {
+    // Split high. The new leaf is left empty for the key and the ones after it.
+    mid = n;
+    *split_key = key;
+  } else {
+    *split_key = node->keys_[mid];
+  }
+  std::copy(node->keys_ + mid, node->keys_ + n, new_leaf->keys_);
+  std::copy(node->data_ + mid, node->data_ + n, new_leaf->data_);
+  new_leaf->slotuse_ = n - mid;
+  node->slotuse_ = mid;
+  {
+    LockGuard lck(&list_lock_);
+    leaf_nodes_.InsertAfter(node, new_leaf);
+  }
+  *split_node = new_leaf;
+  return IndexRc::kOk;
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::SplitNode(InnerNode *parent,
+                                                                               uint64_t parent_version,
+                                                                               BaseNode *node, uint64_t version,
+                                                                               const key_type &key) {
+  // Lock the parent before the node, as every writer does, and only if nothing changed since the descent read
+  // them. The parent is not full, else it would have been split on the way down.
+  if (parent != nullptr && !parent->lock_.Upgrade(parent_version)) {
+    return IndexRc::kRetry;
+  }
+  if (!node->lock_.Upgrade(version)) {
+    if (parent != nullptr) {
+      parent->lock_.Unlock();
+    }
+    return IndexRc::kRetry;
+  }
+  IndexRc rc = IndexRc::kOk;
+  InnerNode *new_root = nullptr;
+  if (parent == nullptr) {
+    // Another writer may have grown the tree since we read the root
+    if (node != root_.load(std::memory_order_acquire)) {
+      rc = IndexRc::kRetry;
+    } else {
+      rc = AllocateInner(&new_root);
+    }
+  }
+  key_type split_key = key_type();
+  BaseNode *split_node = nullptr;
+  if (rc == IndexRc::kOk) {
+    if (node->is_leafnode()) {
+      LeafNode *new_leaf = nullptr;
+      rc = SplitLeaf(static_cast<LeafNode *>(node), key, &split_key, &new_leaf);
+      split_node = new_leaf;
+    } else {
+      InnerNode *new_inner = nullptr;
+      rc = SplitInner(static_cast<InnerNode *>(node), key, &split_key, &new_inner);
+      split_node = new_inner;
+    }
+  }
+  if (rc == IndexRc::kOk) {
+    if (parent != nullptr) {
+      parent->InsertChild(split_key, split_node, key_less_);
+    } else {
+      new_root->keys_[0] = split_key;
+      new_root->data_[0] = node;
+      new_root->data_[1] = split_node;
+      new_root->slotuse_ = 1;
+      root_.store(new_root, std::memory_order_release);
+      stats_.level_++;
+    }
+    // The key is inserted on the retry
+    rc = IndexRc::kRetry;
+  }
+  node->lock_.Unlock();
+  if (parent != nullptr) {
+    parent->lock_.Unlock();
+  }
+  return rc;
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::TryInsert(const key_type &key,
+                                                                               value_type *value) {
+  BaseNode *node = root_.load(std::memory_order_acquire);
+  uint64_t version = node->lock_.ReadLock();
+  if (node != root_.load(std::memory_order_acquire)) {
+    return IndexRc::kRetry;
+  }
+  InnerNode *parent = nullptr;
+  uint64_t parent_version = 0;
+  while (!node->is_leafnode()) {
+    auto *inner = static_cast<InnerNode *>(node);
+    if (inner->is_full()) {
+      return SplitNode(parent, parent_version, node, version, key);
+    }
+    // The parent still points to this node
+    if (parent != nullptr && !parent->lock_.Validate(parent_version)) {
+      return IndexRc::kRetry;
+    }
+    BaseNode *child = inner->data_[FindBranch(inner, key)];
+    if (!inner->lock_.Validate(version)) {
+      return IndexRc::kRetry;
+    }
+    parent = inner;
+    parent_version = version;
+    node = child;
+    version = node->lock_.ReadLock();
+  }
+  auto *leaf = static_cast<LeafNode *>(node);
+  if (leaf->is_full()) {
+    return SplitNode(parent, parent_version, node, version, key);
+  }
+  if (!leaf->lock_.Upgrade(version)) {
+    return IndexRc::kRetry;
+  }
+  if (parent != nullptr && !parent->lock_.Validate(parent_version)) {
+    leaf->lock_.Unlock();
+    return IndexRc::kRetry;
+  }
+  IndexRc rc = leaf->InsertIntoSlot(key, value, key_less_);
+  leaf->lock_.Unlock();
+  return rc;
+}
+
+template <typename K, typename V, typename C, typename T>
+Status OlcBPlusTree<K, V, C, T>::DoInsert(const key_type &key, const value_type &value) {
+  if (root_.load(std::memory_order_acquire) == nullptr) {
+    LockGuard lck(&root_lock_);
+    // Check again after we get the lock. Other thread may have created the root node already.
+    if (root_.load(std::memory_order_acquire) == nullptr) {
+      LeafNode *leaf = nullptr;
+      IndexRc rc = AllocateLeaf(&leaf);
+      if (rc != IndexRc::kOk) {
+        return IndexRc2Status(rc);
+      }
+      {
+        LockGuard list_lck(&list_lock_);
+        leaf_nodes_.Append(leaf);
+      }
+      root_.store(leaf, std::memory_order_release);
+    }
+  }
+  // The value is copied once, the retries and the splits only move its pointer.
+  value_type *ptr_value = nullptr;
+  IndexRc rc = AllocateValue(value, &ptr_value);
+  if (rc != IndexRc::kOk) {
+    return IndexRc2Status(rc);
+  }
+  for (int32_t retries = 0;; ++retries) {
+    rc = TryInsert(key, ptr_value);
+    if (rc != IndexRc::kRetry) {
+      break;
+    }
+    if (retries >= kRetriesBeforeYield) {
+      std::this_thread::yield();
+    }
+  }
+  if (rc != IndexRc::kOk) {
+    FreeValue(ptr_value);
+    return IndexRc2Status(rc);
+  }
+  (void)stats_.size_++;
+  return Status::OK();
+}
+
+template <typename K, typename V, typename C, typename T>
+template <typename Iter>
+Status OlcBPlusTree<K, V, C, T>::BulkLoad(Iter first, Iter last) {
+  if (root_.load(std::memory_order_acquire) != nullptr) {
+    RETURN_STATUS_UNEXPECTED("Bulk load needs an empty tree.");
+  }
+  using pair_type = typename std::iterator_traits<Iter>::value_type;
+  auto out_of_order = std::adjacent_find(
+    first, last, [this](const pair_type &a, const pair_type &b) { return !key_less_(a.first, b.first); });
+  if (out_of_order != last) {
+    RETURN_STATUS_UNEXPECTED("Bulk load needs strictly increasing keys.");
+  }
+  // Unless the keys are appended afterwards, leave a quarter of each node free for the inserts after the load
+  const slot_type leaf_fill = traits::kAppendMode ? traits::kLeafSlots : std::max(1, traits::kLeafSlots * 3 / 4);
+  const slot_type inner_fill = traits::kAppendMode ? traits::kInnerSlots : std::max(1, traits::kInnerSlots * 3 / 4);
+  // The nodes of one level, with the smallest key under each
+  std::vector<std::pair<key_type, BaseNode *>> nodes;
+  LeafNode *leaf = nullptr;
+  uint64_t num_keys = 0;
+  for (auto it = first; it != last; ++it) {
+    if (leaf == nullptr || leaf->slotuse_ == leaf_fill) {
+      RETURN_IF_NOT_OK(IndexRc2Status(AllocateLeaf(&leaf)));
+      nodes.emplace_back(it->first, leaf);
+    }
+    value_type *ptr_value = nullptr;
+    RETURN_IF_NOT_OK(IndexRc2Status(AllocateValue(it->second, &ptr_value)));
+    leaf->keys_[leaf->slotuse_] = it->first;
+    leaf->data_[leaf->slotuse_] = ptr_value;
+    ++leaf->slotuse_;
+    ++num_keys;
+  }
+  if (nodes.empty()) {
+    return Status::OK();
+  }
+  {
+    LockGuard lck(&list_lock_);
+    for (auto &node : nodes) {
+      leaf_nodes_.Append(static_cast<LeafNode *>(node.second));
+    }
+  }
+  // Build the inner levels bottom up until one node is left
+  uint32_t level = 0;
+  while (nodes.size() > 1) {
+    std::vector<std::pair<key_type, BaseNode *>> parents;
+    for (size_t i = 0; i < nodes.size(); i += inner_fill + 1) {
+      InnerNode *inner = nullptr;
+      RETURN_IF_NOT_OK(IndexRc2Status(AllocateInner(&inner)));
+      size_t end = std::min(nodes.size(), i + inner_fill + 1);
+      inner->data_[0] = nodes[i].second;
+      for (size_t j = i + 1; j < end; j++) {
+        inner->keys_[inner->slotuse_] = nodes[j].first;
+        inner->data_[inner->slotuse_ + 1] = nodes[j].second;
+        ++inner->slotuse_;
+      }
+      parents.emplace_back(nodes[i].first, inner);
+    }
+    nodes.swap(parents);
+    ++level;
+  }
+  stats_.level_ = level;
+  stats_.size_ += num_keys;
+  root_.store(nodes[0].second, std::memory_order_release);
+  return Status::OK();
+}
+
+template <typename K, typename V, typename C, typename T>
+typename OlcBPlusTree<K, V, C, T>::IndexRc OlcBPlusTree<K, V, C, T>::TrySearch(const key_type &key,
+                                                                               value_type **value) const {
+  const BaseNode *node = root_.load(std::memory_order_acquire);
+  if (node == nullptr) {
+    return IndexRc::kKeyNotFound;
+  }
+  uint64_t version = node->lock_.ReadLock();
+  if (node != root_.load(std::memory_order_acquire)) {
+    return IndexRc::kRetry;
+  }
+  while (!node->is_leafnode()) {
+    auto *inner = static_cast<const InnerNode *>(node);
+    const BaseNode *child = inner->data_[FindBranch(inner, key)];
+    if (!inner->lock_.Validate(version)) {
+      return IndexRc::kRetry;
+    }
+    uint64_t child_version = child->lock_.ReadLock();
+    // The child was not split between the two reads, its keys are still the ones of the branch
+    if (!inner->lock_.Validate(version)) {
+      return IndexRc::kRetry;
+    }
+    node = child;
+    version = child_version;
+  }
+  auto *leaf = static_cast<const LeafNode *>(node);
+  slot_type slot = FindSlot(leaf, key);
+  value_type *found = nullptr;
+  if (slot < std::min(leaf->slotuse_, static_cast<slot_type>(traits::kLeafSlots)) && Equal(leaf->keys_[slot], key)) {
+    found = leaf->data_[slot];
+  }
+  if (!leaf->lock_.Validate(version)) {
+    return IndexRc::kRetry;
+  }
+  *value = found;
+  return found != nullptr ? IndexRc::kOk : IndexRc::kKeyNotFound;
+}
+
+template <typename K, typename V, typename C, typename T>
+bool OlcBPlusTree<K, V, C, T>::Search(const key_type &key, value_type *value) const {
+  IndexRc rc;
+  value_type *found = nullptr;
+  for (int32_t retries = 0;; ++retries) {
+    rc = TrySearch(key, &found);
+    if (rc != IndexRc::kRetry) {
+      break;
+    }
+    if (retries >= kRetriesBeforeYield) {
+      std::this_thread::yield();
+    }
+  }
+  if (rc != IndexRc::kOk) {
+    return false;
+  }
+  // The values never change once inserted, no need to validate the copy
+  if (value != nullptr) {
+    *value = *found;
+  }
+  return true;
+}
+}  // namespace dataset
+}  // namespace mindspore
+#endif
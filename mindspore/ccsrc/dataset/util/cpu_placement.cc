@@ -0,0 +1,129 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/util/cpu_placement.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace mindspore {
+namespace dataset {
+std::vector<int32_t> CpuPlacement::ParseCpuList(const std::string &list) {
+  std::vector<int32_t> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty() || range[0] < '0' || range[0] > '9') {
+      continue;
+    }
+    size_t dash = range.find('-');
+    int32_t first = std::atoi(range.substr(0, dash).c_str());
+    int32_t last = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+    for (int32_t cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::map<int32_t, std::vector<int32_t>> CpuPlacement::NodeCpus() {
+  const std::string root = "/sys/devices/system/node";
+  std::map<int32_t, std::vector<int32_t>> node_cpus;
+  DIR *dir = opendir(root.c_str());
+  if (dir == nullptr) {
+    return node_cpus;
+  }
+  struct dirent *entry = nullptr;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string name(entry->d_name);
+    if (name.compare(0, 4, "node") != 0 || name.size() == 4 || name[4] < '0' || name[4] > '9') {
+      continue;
+    }
+    std::ifstream in(root + "/" + name + "/cpulist");
+    std::string list;
+    if (in && std::getline(in, list)) {
+      node_cpus[std::atoi(name.c_str() + 4)] = ParseCpuList(list);
+    }
+  }
+  closedir(dir);
+  return node_cpus;
+}
+
+std::vector<int32_t> CpuPlacement::AllowedCpus() {
+  std::vector<int32_t> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    return cpus;
+  }
+  for (int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &set)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+int32_t CpuPlacement::PciDeviceNode(const std::string &bus_id) {
+  // The sysfs names are in lower case, the drivers may give the bus ids in upper case
+  std::string name = bus_id;
+  std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+  std::ifstream in("/sys/bus/pci/devices/" + name + "/numa_node");
+  int32_t node = -1;
+  if (!(in >> node)) {
+    return -1;
+  }
+  // A host without numa shows -1
+  return node;
+}
+
+Status CpuPlacement::PinCurrentThread(const std::vector<int32_t> &cpus) {
+  if (cpus.empty()) {
+    return Status::OK();
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int32_t cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  if (rc != 0) {
+    RETURN_STATUS_UNEXPECTED("Failed to pin the thread: " + std::string(strerror(rc)));
+  }
+  return Status::OK();
+}
+
+std::vector<int32_t> CpuPlacement::Exclude(const std::vector<int32_t> &cpus, const std::vector<int32_t> &excluded) {
+  std::vector<int32_t> result;
+  for (int32_t cpu : cpus) {
+    if (std::find(excluded.begin(), excluded.end(), cpu) == excluded.end()) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_CPU_PLACEMENT_H_
+#define DATASET_UTIL_CPU_PLACEMENT_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// The cpus of the host as the kernel shows them, and the pinning of the threads to a set of them.
+// The cpu lists are in the format of the kernel, e.g. "0-3,8,10-11".
+class CpuPlacement {
+ public:
+  // @param list - A cpu list, the malformed ranges are skipped
+  // @return The cpus of the list in increasing order, without duplicates
+  static std::vector<int32_t> ParseCpuList(const std::string &list);
+
+  // @return The cpus of each numa node of the host by node id, empty if the host shows no nodes
+  static std::map<int32_t, std::vector<int32_t>> NodeCpus();
+
+  // @return The cpus the current process may run on
+  static std::vector<int32_t> AllowedCpus();
+
+  // @param bus_id - The PCI bus id of a device, e.g. "0000:3b:00.0"
+  // @return The numa node of the device, -1 if it is unknown
+  static int32_t PciDeviceNode(const std::string &bus_id);
+
+  // Pins the current thread.
+  // @param cpus - The cpus the thread may run on, the thread is left as is when empty
+  // @return Status - The error code return
+  static Status PinCurrentThread(const std::vector<int32_t> &cpus);
+
+  // Removes the cpus of a list from another one.
+  // @param cpus - The cpus to keep
+  // @param excluded - The cpus to remove
+  // @return The cpus of cpus which are not in excluded
+  static std::vector<int32_t> Exclude(const std::vector<int32_t> &cpus, const std::vector<int32_t> &excluded);
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_UTIL_CPU_PLACEMENT_H_
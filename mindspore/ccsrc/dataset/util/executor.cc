@@ -0,0 +1,166 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/util/executor.h"
+
+#include <chrono>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include "dataset/util/make_unique.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// The executor and the queue of the current thread when it is a pool thread
+thread_local Executor *tls_executor = nullptr;
+thread_local int32_t tls_queue = -1;
+}  // namespace
+
+Status ExecutorJob::Wait(bool interruptible) {
+  // A pool thread runs the other jobs while it waits, the job may be in a queue behind them
+  while (tls_executor != nullptr && !done_) {
+    std::shared_ptr<ExecutorJob> other = tls_executor->TakeJob(tls_queue);
+    if (other != nullptr) {
+      other->Run();
+    } else {
+      std::unique_lock<std::mutex> lck(mux_);
+      (void)cv_.wait_for(lck, std::chrono::milliseconds(1), [this]() { return done_.load(); });
+    }
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  if (interruptible && TaskManager::FindMe() != nullptr) {
+    RETURN_IF_NOT_OK(interruptible_wait(&cv_, &lck, [this]() { return done_.load(); }));
+  } else {
+    cv_.wait(lck, [this]() { return done_.load(); });
+  }
+  return rc_;
+}
+
+void ExecutorJob::Run() {
+  Status rc;
+  if (!cancelled_) {
+    try {
+      rc = f_();
+    } catch (const std::exception &e) {
+      rc = Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, e.what());
+    }
+  }
+  // Release what the function holds before the waiter is woken up
+  f_ = nullptr;
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    rc_ = rc;
+    done_ = true;
+  }
+  cv_.notify_all();
+}
+
+Executor::Executor(int32_t num_threads) : pending_(0), next_queue_(0), stop_(false) {
+  if (num_threads <= 0) {
+    num_threads = static_cast<int32_t>(std::thread::hardware_concurrency());
+  }
+  num_threads = num_threads > 0 ? num_threads : 1;
+  for (int32_t i = 0; i < num_threads; i++) {
+    queues_.push_back(mindspore::make_unique<WorkQueue>());
+  }
+  for (int32_t i = 0; i < num_threads; i++) {
+    threads_.emplace_back(&Executor::ThreadLoop, this, i);
+  }
+  MS_LOG(INFO) << "Executor started with " << num_threads << " threads.";
+}
+
+Executor::~Executor() {
+  {
+    std::unique_lock<std::mutex> lck(idle_mux_);
+    stop_ = true;
+  }
+  idle_cv_.notify_all();
+  for (auto &t : threads_) {
+    t.join();
+  }
+}
+
+Executor *Executor::GetInstance() {
+  // Never destroyed, the jobs of the trees left at the exit of the process must not run their operators'
+  // destructors twice
+  static Executor *instance = new Executor();
+  return instance;
+}
+
+std::shared_ptr<ExecutorJob> Executor::Submit(std::function<Status()> f) {
+  auto job = std::make_shared<ExecutorJob>(std::move(f));
+  int32_t id = (tls_executor == this) ? tls_queue : static_cast<int32_t>(next_queue_++ % queues_.size());
+  {
+    std::unique_lock<std::mutex> lck(queues_[id]->mux);
+    queues_[id]->jobs.push_back(job);
+  }
+  {
+    // Under the lock, so a thread which has just found no job is either woken up or sees the count
+    std::unique_lock<std::mutex> lck(idle_mux_);
+    pending_++;
+  }
+  idle_cv_.notify_one();
+  return job;
+}
+
+std::shared_ptr<ExecutorJob> Executor::TakeJob(int32_t id) {
+  std::shared_ptr<ExecutorJob> job;
+  {
+    // The newest job of the own queue
+    WorkQueue &own = *queues_[id];
+    std::unique_lock<std::mutex> lck(own.mux);
+    if (!own.jobs.empty()) {
+      job = std::move(own.jobs.back());
+      own.jobs.pop_back();
+    }
+  }
+  size_t num_queues = queues_.size();
+  for (size_t i = 1; job == nullptr && i < num_queues; i++) {
+    // The oldest job of the next queues
+    WorkQueue &victim = *queues_[(id + i) % num_queues];
+    std::unique_lock<std::mutex> lck(victim.mux);
+    if (!victim.jobs.empty()) {
+      job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+    }
+  }
+  if (job != nullptr) {
+    pending_--;
+  }
+  return job;
+}
+
+void Executor::ThreadLoop(int32_t id) {
+  tls_executor = this;
+  tls_queue = id;
+  while (true) {
+    std::shared_ptr<ExecutorJob> job = TakeJob(id);
+    if (job != nullptr) {
+      job->Run();
+      continue;
+    }
+    std::unique_lock<std::mutex> lck(idle_mux_);
+    idle_cv_.wait(lck, [this]() { return stop_ || pending_ > 0; });
+    if (stop_ && pending_ == 0) {
+      break;
+    }
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_EXECUTOR_H_
+#define DATASET_UTIL_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// A function submitted to an Executor, with its result once it has run.
+class ExecutorJob {
+ public:
+  friend class Executor;
+
+  explicit ExecutorJob(std::function<Status()> f) : f_(std::move(f)), done_(false), cancelled_(false) {}
+
+  ~ExecutorJob() = default;
+
+  // Waits until the job has run, or has been skipped after a Cancel(). A pool thread runs the other queued jobs
+  // meanwhile, so the jobs may wait for the jobs they submit.
+  // @param interruptible - T/F if the wait returns early when the calling Task is interrupted. The job may then
+  //     still be running, so a caller which owns what the job works on waits again with interruptible false.
+  // @return Status - The result of the function, or the interrupt
+  Status Wait(bool interruptible = true);
+
+  // Skips the job if it has not started yet, a running job runs to its end.
+  void Cancel() { cancelled_ = true; }
+
+  // @return T/F if the job has run or has been skipped
+  bool Done() const { return done_; }
+
+ private:
+  // Runs the function, or skips it if the job is cancelled
+  void Run();
+
+  std::function<Status()> f_;
+  std::atomic<bool> done_;
+  std::atomic<bool> cancelled_;
+  Status rc_;
+  std::mutex mux_;
+  std::condition_variable cv_;
+};
+
+// A fixed pool of threads, one per core, shared by the operators of all the trees instead of a thread per worker
+// of each operator. Each thread has its own double ended queue of jobs. It takes its newest job first while the
+// data of the job is still in its caches, and when its queue is empty it steals the oldest job of another queue,
+// so the load is balanced without a queue shared by every thread.
+// The pool threads are not Tasks of a TaskGroup: the Task which submits a job waits for it, and its own
+// interrupt and error handling stays as it is. A job must not block on the pipeline (e.g. on a Connector),
+// it would hold a thread of the pool that the other jobs may need.
+class Executor {
+ public:
+  friend class ExecutorJob;
+
+  // @param num_threads - The number of threads of the pool, 0 for one per core
+  explicit Executor(int32_t num_threads = 0);
+
+  // Destructor. Runs the jobs left in the queues, then stops the threads.
+  ~Executor();
+
+  Executor(const Executor &) = delete;
+
+  Executor &operator=(const Executor &) = delete;
+
+  // @return The executor shared by the whole process, created on its first use
+  static Executor *GetInstance();
+
+  // Queues a function. A pool thread queues its jobs into its own queue, the other threads spread theirs over
+  // the queues in turn.
+  // @param f - The function, its Status is the result of the job
+  // @return The job to wait for
+  std::shared_ptr<ExecutorJob> Submit(std::function<Status()> f);
+
+  // @return The number of threads of the pool
+  int32_t num_threads() const { return static_cast<int32_t>(threads_.size()); }
+
+ private:
+  struct WorkQueue {
+    std::mutex mux;
+    std::deque<std::shared_ptr<ExecutorJob>> jobs;
+  };
+
+  // The loop of a pool thread
+  // @param id - The queue of the thread
+  void ThreadLoop(int32_t id);
+
+  // Takes the newest job of a queue, or else steals the oldest job of another one
+  // @param id - The queue to start from
+  // @return The job, nullptr if every queue is empty
+  std::shared_ptr<ExecutorJob> TakeJob(int32_t id);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<int64_t> pending_;   // The jobs in the queues
+  std::atomic<uint32_t> next_queue_;
+  std::mutex idle_mux_;
+  std::condition_variable idle_cv_;
+  bool stop_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_UTIL_EXECUTOR_H_
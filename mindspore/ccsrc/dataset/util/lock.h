@@ -16,9 +16,12 @@
 #ifndef DATASET_UTIL_LOCK_H_
 #define DATASET_UTIL_LOCK_H_
 
+#include <atomic>
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
+#include <thread>
 #include "dataset/util/make_unique.h"
 
 namespace mindspore {
@@ -49,6 +52,62 @@ class SpinLock {
   std::atomic<int> val_;
 };
 
+// A version lock for optimistic lock coupling. A reader takes no lock: it remembers the version, reads, and
+// validates that the version is unchanged, otherwise it restarts. A writer locks the version and bumps it on
+// unlock, so that the readers which saw the data before the change fail their validation.
+class VersionLock {
+ public:
+  VersionLock() : version_(0) {}
+
+  VersionLock(const VersionLock &) = delete;
+
+  VersionLock(VersionLock &&) = delete;
+
+  ~VersionLock() = default;
+
+  VersionLock &operator=(const VersionLock &) = delete;
+
+  VersionLock &operator=(VersionLock &&) = delete;
+
+  // Waits until no writer holds the lock.
+  // @return The version to validate the reads against
+  uint64_t ReadLock() const {
+    uint64_t v = version_.load(std::memory_order_acquire);
+    for (int32_t spin = 0; (v & kLocked) != 0; ++spin) {
+      if (spin >= kSpinsBeforeYield) {
+        std::this_thread::yield();
+      }
+      v = version_.load(std::memory_order_acquire);
+    }
+    return v;
+  }
+
+  // @param v - The version of ReadLock
+  // @return T/F if nothing changed since ReadLock, the reads in between are then valid
+  bool Validate(uint64_t v) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version_.load(std::memory_order_relaxed) == v;
+  }
+
+  // Turns a read into a write if nothing changed since ReadLock.
+  // @param v - The version of ReadLock
+  // @return T/F if the lock is now held exclusive
+  bool Upgrade(uint64_t v) { return version_.compare_exchange_strong(v, v + kLocked, std::memory_order_acquire); }
+
+  void LockExclusive() {
+    while (!Upgrade(ReadLock())) {
+    }
+  }
+
+  void Unlock() noexcept { version_.fetch_add(kLocked, std::memory_order_release); }
+
+ private:
+  // The lock bit, adding it twice gives the next version
+  static constexpr uint64_t kLocked = 2;
+  static constexpr int32_t kSpinsBeforeYield = 64;
+  std::atomic<uint64_t> version_;
+};
+
 // C++11 has no shared mutex. The following class is an alternative. It favors writer and is suitable for the case
 // where writer is rare.
 class RWLock {
@@ -0,0 +1,292 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/util/numa_pool.h"
+
+#include <sched.h>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <new>
+#include <string>
+#include "./securec.h"
+#include "dataset/util/cpu_placement.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr uint32_t kBlockSignature = 0x4e554d41;
+// The header keeps the user memory cache line aligned
+constexpr size_t kHeaderSize = 64;
+// Free blocks of a size class a thread keeps at most
+constexpr size_t kThreadCacheDepth = 64;
+
+struct BlockHeader {
+  uint32_t sig;
+  int32_t size_class;  // -1 for the blocks above the largest class
+  int32_t node;
+  uint64_t size;  // The bytes of the block, header included
+};
+static_assert(sizeof(BlockHeader) <= kHeaderSize, "Block header does not fit");
+
+BlockHeader *HeaderOf(void *p) { return reinterpret_cast<BlockHeader *>(reinterpret_cast<char *>(p) - kHeaderSize); }
+
+void *UserOf(BlockHeader *hdr) { return reinterpret_cast<char *>(hdr) + kHeaderSize; }
+
+// @return The smallest class which holds n bytes and the header, kNumClasses if none does
+int32_t SizeClassOf(size_t n) {
+  if (n > std::numeric_limits<size_t>::max() - kHeaderSize) {
+    return NumaPool::kNumClasses;
+  }
+  size_t need = n + kHeaderSize;
+  int32_t k = 0;
+  size_t sz = NumaPool::kMinBlockSize;
+  while (k < NumaPool::kNumClasses && sz < need) {
+    sz <<= 1;
+    ++k;
+  }
+  return k;
+}
+
+size_t ClassSize(int32_t k) { return NumaPool::kMinBlockSize << k; }
+}  // namespace
+
+constexpr int NumaPool::kNumClasses;
+constexpr size_t NumaPool::kMinBlockSize;
+constexpr int64_t NumaPool::kThreadCacheSize;
+constexpr int64_t NumaPool::kNodeCacheSize;
+
+// The free blocks a thread keeps for the last pool it used. The blocks are all of the node of the thread.
+struct NumaPool::ThreadCache {
+  ~ThreadCache() { Unbind(); }
+
+  // Gives the blocks back to their pool, or to the system if the pool is gone
+  void Unbind() {
+    std::shared_ptr<NumaPool> owner = pool.lock();
+    if (owner != nullptr) {
+      owner->Flush(this);
+    } else {
+      for (auto &list : blocks) {
+        for (void *block : list) {
+          free(block);
+        }
+        list.clear();
+      }
+      bytes = 0;
+    }
+    pool.reset();
+    raw = nullptr;
+  }
+
+  std::weak_ptr<NumaPool> pool;
+  const NumaPool *raw = nullptr;
+  int32_t node = 0;
+  int64_t bytes = 0;
+  std::vector<void *> blocks[kNumClasses];
+};
+
+Status NumaPool::CreateNumaPool(std::shared_ptr<MemoryPool> *out_pool) {
+  if (out_pool == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Output pool is null");
+  }
+  std::shared_ptr<NumaPool> pool(new (std::nothrow) NumaPool());
+  if (pool == nullptr) {
+    return Status(StatusCode::kOutOfMemory);
+  }
+  *out_pool = std::move(pool);
+  return Status::OK();
+}
+
+NumaPool::NumaPool() { InitNodes(); }
+
+NumaPool::~NumaPool() {
+  for (auto &node : nodes_) {
+    for (auto &list : node->blocks) {
+      for (void *block : list) {
+        free(block);
+      }
+    }
+  }
+}
+
+void NumaPool::InitNodes() {
+  std::map<int32_t, std::vector<int32_t>> node_cpus = CpuPlacement::NodeCpus();
+  // The node ids may have holes, the caches are indexed densely in the order of the ids
+  int32_t index = 0;
+  for (const auto &node : node_cpus) {
+    for (int32_t cpu : node.second) {
+      if (cpu >= static_cast<int32_t>(cpu_to_node_.size())) {
+        cpu_to_node_.resize(cpu + 1, 0);
+      }
+      cpu_to_node_[cpu] = index;
+    }
+    ++index;
+  }
+  int32_t num_nodes = index > 0 ? index : 1;
+  for (int32_t i = 0; i < num_nodes; ++i) {
+    nodes_.push_back(std::unique_ptr<NodeCache>(new NodeCache()));
+  }
+}
+
+int32_t NumaPool::CurrentNode() const {
+  int cpu = sched_getcpu();
+  if (cpu < 0 || cpu >= static_cast<int>(cpu_to_node_.size())) {
+    return 0;
+  }
+  return cpu_to_node_[cpu];
+}
+
+NumaPool::ThreadCache *NumaPool::GetThreadCache() {
+  static thread_local ThreadCache thread_cache;
+  ThreadCache *cache = &thread_cache;
+  // A new pool may reuse the address of a destroyed one, the weak pointer tells them apart
+  if (cache->raw == this && !cache->pool.expired()) {
+    return cache;
+  }
+  cache->Unbind();
+  std::weak_ptr<NumaPool> self;
+  try {
+    self = shared_from_this();
+  } catch (const std::bad_weak_ptr &e) {
+    return nullptr;
+  }
+  cache->pool = self;
+  cache->raw = this;
+  cache->node = CurrentNode();
+  return cache;
+}
+
+void NumaPool::Flush(ThreadCache *cache) {
+  for (int32_t k = 0; k < kNumClasses; ++k) {
+    for (void *block : cache->blocks[k]) {
+      ReleaseToNode(block, cache->node, k);
+    }
+    cache->blocks[k].clear();
+  }
+  cache->bytes = 0;
+}
+
+void NumaPool::ReleaseToNode(void *block, int32_t node, int32_t size_class) {
+  auto size = static_cast<int64_t>(ClassSize(size_class));
+  NodeCache *cache = nodes_[node].get();
+  {
+    std::lock_guard<std::mutex> lck(cache->mux);
+    if (cache->bytes + size <= kNodeCacheSize) {
+      cache->blocks[size_class].push_back(block);
+      cache->bytes += size;
+      return;
+    }
+  }
+  free(block);
+}
+
+Status NumaPool::Allocate(size_t n, void **p) {
+  if (p == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Output pointer is null");
+  }
+  int32_t k = SizeClassOf(n);
+  void *block = nullptr;
+  int32_t node = 0;
+  if (k < kNumClasses) {
+    ThreadCache *cache = GetThreadCache();
+    if (cache != nullptr && !cache->blocks[k].empty()) {
+      block = cache->blocks[k].back();
+      cache->blocks[k].pop_back();
+      cache->bytes -= static_cast<int64_t>(ClassSize(k));
+      node = cache->node;
+    } else {
+      // The thread may have moved since it filled its cache
+      node = CurrentNode();
+      if (cache != nullptr && cache->node != node) {
+        Flush(cache);
+        cache->node = node;
+      }
+      NodeCache *shared = nodes_[node].get();
+      std::lock_guard<std::mutex> lck(shared->mux);
+      if (!shared->blocks[k].empty()) {
+        block = shared->blocks[k].back();
+        shared->blocks[k].pop_back();
+        shared->bytes -= static_cast<int64_t>(ClassSize(k));
+      }
+    }
+  }
+  if (block == nullptr) {
+    // The pages of a new block are placed on the node of the thread which writes them first, that is this one
+    if (k == kNumClasses && n > std::numeric_limits<size_t>::max() - kHeaderSize) {
+      return Status(StatusCode::kOutOfMemory);
+    }
+    size_t size = k < kNumClasses ? ClassSize(k) : n + kHeaderSize;
+    RETURN_IF_NOT_OK(DeMalloc(size, &block, false));
+    auto *hdr = reinterpret_cast<BlockHeader *>(block);
+    hdr->sig = kBlockSignature;
+    hdr->size_class = k < kNumClasses ? k : -1;
+    hdr->node = k < kNumClasses ? CurrentNode() : 0;
+    hdr->size = size;
+  }
+  *p = UserOf(reinterpret_cast<BlockHeader *>(block));
+  return Status::OK();
+}
+
+void NumaPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  BlockHeader *hdr = HeaderOf(p);
+  if (hdr->sig != kBlockSignature) {
+    MS_LOG(ERROR) << "Block " << p << " does not come from a numa pool.";
+    return;
+  }
+  int32_t k = hdr->size_class;
+  if (k < 0) {
+    free(hdr);
+    return;
+  }
+  auto size = static_cast<int64_t>(ClassSize(k));
+  ThreadCache *cache = GetThreadCache();
+  // A block of another node goes back to its own node, the thread cache only serves local blocks
+  if (cache != nullptr && hdr->node == cache->node && cache->blocks[k].size() < kThreadCacheDepth &&
+      cache->bytes + size <= kThreadCacheSize) {
+    cache->blocks[k].push_back(hdr);
+    cache->bytes += size;
+    return;
+  }
+  ReleaseToNode(hdr, hdr->node, k);
+}
+
+Status NumaPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  if (p == nullptr || *p == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Pointer to reallocate is null");
+  }
+  BlockHeader *hdr = HeaderOf(*p);
+  if (new_sz <= hdr->size - kHeaderSize) {
+    // The block already holds the new size
+    return Status::OK();
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+  if (err) {
+    Deallocate(q);
+    RETURN_STATUS_UNEXPECTED(std::to_string(err));
+  }
+  Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+
+uint64_t NumaPool::get_max_size() const { return std::numeric_limits<uint64_t>::max(); }
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_NUMA_POOL_H_
+#define DATASET_UTIL_NUMA_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// A memory pool of power of two size classes which keeps the freed blocks for reuse, first in a cache of the
+// freeing thread, which takes no lock, then in a cache of the numa node the block was allocated on.
+// Linux places a page on the node of the thread which touches it first, so a block is local to the node of the
+// thread which allocated it. Reusing it from the cache of that node only keeps the tensor buffers local to the
+// workers which fill them, whichever thread frees them. The node of a cpu is read from sysfs, a host without
+// numa information is a single node. Blocks above the largest class go to malloc and free.
+class NumaPool : public MemoryPool, public std::enable_shared_from_this<NumaPool> {
+ public:
+  // Number of size classes, from kMinBlockSize on
+  static constexpr int kNumClasses = 19;
+  static constexpr size_t kMinBlockSize = 256;
+  // Bytes of free blocks a thread and a node keep at most
+  static constexpr int64_t kThreadCacheSize = 64 * 1048576L;
+  static constexpr int64_t kNodeCacheSize = 1024 * 1048576L;
+
+  static Status CreateNumaPool(std::shared_ptr<MemoryPool> *out_pool);
+
+  NumaPool(const NumaPool &) = delete;
+
+  NumaPool &operator=(const NumaPool &) = delete;
+
+  ~NumaPool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override;
+
+  int PercentFree() const override { return 100; }
+
+  // @return The number of numa nodes of the host
+  int32_t num_nodes() const { return static_cast<int32_t>(nodes_.size()); }
+
+  // @return The numa node of the cpu the calling thread runs on
+  int32_t CurrentNode() const;
+
+ private:
+  struct NodeCache {
+    std::mutex mux;
+    std::vector<void *> blocks[kNumClasses];
+    int64_t bytes = 0;
+  };
+
+  struct ThreadCache;
+
+  NumaPool();
+
+  // Reads the cpus of each node from sysfs
+  void InitNodes();
+
+  // Gives the cached blocks of a thread back to the node caches, at thread exit or when it uses another pool
+  void Flush(ThreadCache *cache);
+
+  // Frees a block into the cache of its node, or to the system when that cache is full
+  void ReleaseToNode(void *block, int32_t node, int32_t size_class);
+
+  // @return The cache of the calling thread bound to this pool, nullptr while the pool is being destroyed
+  ThreadCache *GetThreadCache();
+
+  std::vector<std::unique_ptr<NodeCache>> nodes_;
+  std::vector<int32_t> cpu_to_node_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_UTIL_NUMA_POOL_H_
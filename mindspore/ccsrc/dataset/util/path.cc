@@ -127,6 +127,16 @@ bool Path::IsDirectory() {
   }
 }
 
+int64_t Path::LastModified() {
+  struct stat sb;
+  int rc = stat(common::SafeCStr(path_), &sb);
+  if (rc == -1) {
+    return -1;
+  }
+  constexpr int64_t kNsPerSec = 1000000000;
+  return static_cast<int64_t>(sb.st_mtim.tv_sec) * kNsPerSec + static_cast<int64_t>(sb.st_mtim.tv_nsec);
+}
+
 Status Path::CreateDirectory() {
   if (!Exists()) {
     int rc = mkdir(common::SafeCStr(path_), 0700);
@@ -82,6 +82,9 @@ class Path {
 
   bool IsDirectory();
 
+  // @return The time of the last change in ns since the epoch, -1 if it can't be queried
+  int64_t LastModified();
+
   Status CreateDirectory();
 
   Status CreateDirectories();
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_PHILOX_H_
+#define DATASET_UTIL_PHILOX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace mindspore {
+namespace dataset {
+// The Philox4x32-10 counter based generator of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3".
+// The numbers are a function of a 64 bit key and a 128 bit counter, so a stream is reproduced from its key and
+// counter whichever thread draws it, with no state shared between the streams.
+// Satisfies the UniformRandomBitGenerator requirements, it can replace std::mt19937 with the std distributions.
+class Philox {
+ public:
+  using result_type = uint32_t;
+
+  // @param key - The seed of the stream
+  // @param stream - Which stream of the key, the high half of the counter
+  // @param substream - Which part of the stream, the stream has 2^32 blocks of 4 numbers per part
+  Philox(uint64_t key, uint64_t stream, uint32_t substream = 0)
+      : key_{static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)} {
+    counter_[0] = 0;
+    counter_[1] = substream;
+    counter_[2] = static_cast<uint32_t>(stream);
+    counter_[3] = static_cast<uint32_t>(stream >> 32);
+  }
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()() {
+    if (used_ == kBlockSize) {
+      NextBlock();
+    }
+    return block_[used_++];
+  }
+
+  // Draws n numbers at once, the same as n calls of operator()
+  // @param out - The numbers
+  // @param n - How many
+  void Fill(result_type *out, size_t n) {
+    while (n > 0 && used_ < kBlockSize) {
+      *out++ = block_[used_++];
+      --n;
+    }
+    while (n >= kBlockSize) {
+      Block(out);
+      out += kBlockSize;
+      n -= kBlockSize;
+    }
+    if (n > 0) {
+      NextBlock();
+      while (n-- > 0) {
+        *out++ = block_[used_++];
+      }
+    }
+  }
+
+  // Draws n floats uniform in [lo, hi)
+  void FillUniform(float *out, size_t n, float lo, float hi) {
+    constexpr float kScale = 1.0f / 16777216.0f;
+    for (size_t i = 0; i < n; ++i) {
+      // The top 24 bits are exact in a float
+      out[i] = lo + (hi - lo) * static_cast<float>((*this)() >> 8) * kScale;
+    }
+  }
+
+ private:
+  static constexpr int kBlockSize = 4;
+  static constexpr uint32_t kMul0 = 0xD2511F53;
+  static constexpr uint32_t kMul1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+  // Computes the block of the counter into out and steps the counter
+  void Block(result_type *out) {
+    uint32_t c[kBlockSize] = {counter_[0], counter_[1], counter_[2], counter_[3]};
+    uint32_t k0 = key_[0];
+    uint32_t k1 = key_[1];
+    for (int round = 0; round < 10; ++round) {
+      uint64_t p0 = static_cast<uint64_t>(kMul0) * c[0];
+      uint64_t p1 = static_cast<uint64_t>(kMul1) * c[2];
+      uint32_t next[kBlockSize] = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<uint32_t>(p1),
+                                   static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<uint32_t>(p0)};
+      for (int i = 0; i < kBlockSize; ++i) {
+        c[i] = next[i];
+      }
+      k0 += kWeyl0;
+      k1 += kWeyl1;
+    }
+    for (int i = 0; i < kBlockSize; ++i) {
+      out[i] = c[i];
+    }
+    if (++counter_[0] == 0) {
+      ++counter_[1];
+    }
+  }
+
+  void NextBlock() {
+    Block(block_);
+    used_ = 0;
+  }
+
+  uint32_t key_[2];
+  uint32_t counter_[kBlockSize];
+  result_type block_[kBlockSize] = {0, 0, 0, 0};
+  int used_ = kBlockSize;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_UTIL_PHILOX_H_
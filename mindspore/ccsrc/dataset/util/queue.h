@@ -69,6 +69,7 @@ class Queue {
 
   explicit Queue(int sz)
       : sz_(sz),
+        limit_(sz),
         arr_(nullptr),
         head_(0),
         tail_(0),
@@ -93,7 +94,20 @@ class Queue {
     return (v >= 0) ? v : 0;
   }
 
-  int capacity() const { return sz_; }
+  // The number of elements the queue holds before a producer blocks. It can be lowered at runtime by
+  // set_capacity() but never above the allocated size.
+  int capacity() const { return limit_; }
+
+  // The number of slots allocated at construction.
+  int max_capacity() const { return sz_; }
+
+  // Changes the capacity of the queue, clamped between 1 and the allocated size.
+  // Elements beyond a lowered capacity stay in the queue and producers block until it drains.
+  void set_capacity(int sz) noexcept {
+    std::unique_lock<std::mutex> _lock(mux_);
+    limit_ = (sz < 1) ? 1 : ((static_cast<uint64_t>(sz) > sz_) ? sz_ : static_cast<uint64_t>(sz));
+    full_cv_.NotifyAll();
+  }
 
   bool empty() const { return head_ == tail_; }
 
@@ -103,7 +117,7 @@ class Queue {
   Status Add(const_reference ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
       uint32_t k = tail_++ % sz_;
       arr_[k] = ele;
@@ -118,7 +132,7 @@ class Queue {
   Status Add(T &&ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
       uint32_t k = tail_++ % sz_;
       arr_[k] = std::forward<T>(ele);
@@ -134,7 +148,7 @@ class Queue {
   Status EmplaceBack(Ts &&... args) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
       uint32_t k = tail_++ % sz_;
       new (&(arr_[k])) T(std::forward<Ts>(args)...);
@@ -165,6 +179,21 @@ class Queue {
     return rc;
   }
 
+  // Consumer that does not wait. Returns false when the queue is empty.
+  bool TryPopFront(pointer p) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    if (empty()) {
+      return false;
+    }
+    uint32_t k = head_++ % sz_;
+    *p = std::move(arr_[k]);
+    if (std::is_destructible<T>::value) {
+      arr_[k].~T();
+    }
+    full_cv_.NotifyAll();
+    return true;
+  }
+
   void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, invoke its destructor one by one.
@@ -192,6 +221,7 @@ class Queue {
 
  private:
   uint64_t sz_;
+  uint64_t limit_;
   pointer arr_;
   uint64_t head_;
   uint64_t tail_;
@@ -13,9 +13,6 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#ifndef DATASET_UTIL_RANDOM_H_
-#define DATASET_UTIL_RANDOM_H_
-
 #include "dataset/util/random.h"
 
 #include <limits>
@@ -39,7 +36,18 @@ uint32_t GetSeed() {
 
   return seed;
 }
+
+namespace {
+thread_local Philox *g_row_random = nullptr;
+}  // namespace
+
+RowRandomScope::RowRandomScope(uint32_t seed, uint32_t epoch, int64_t row, uint32_t op)
+    : philox_((static_cast<uint64_t>(epoch) << 32) | seed, static_cast<uint64_t>(row), op), prev_(g_row_random) {
+  g_row_random = &philox_;
+}
+
+RowRandomScope::~RowRandomScope() { g_row_random = prev_; }
+
+Philox *RowRandomScope::Current() { return g_row_random; }
 }  // namespace dataset
 }  // namespace mindspore
-
-#endif  // DATASET_UTIL_RANDOM_H_
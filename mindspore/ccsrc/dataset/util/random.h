@@ -15,9 +15,65 @@
  */
 #ifndef DATASET_UTIL_RANDOM_H_
 #define DATASET_UTIL_RANDOM_H_
+
+#include <cstdint>
+#include <random>
+
+#include "dataset/util/philox.h"
+
 namespace mindspore {
 namespace dataset {
 uint32_t GetSeed();
+
+// The random stream of the row a MapOp worker computes. While a scope is alive, the RandomEngine of the random
+// ops draw on the calling thread from a Philox stream keyed by (seed, epoch, row), so the augmentations of a row
+// are the same whichever worker computes it and however many workers there are, with no lock between them.
+class RowRandomScope {
+ public:
+  // @param seed - The seed of the pipeline
+  // @param epoch - The epoch of the row
+  // @param row - The number of the row in its epoch
+  // @param op - The index of the op in the MapOp, each op of the row draws from its own part of the stream
+  RowRandomScope(uint32_t seed, uint32_t epoch, int64_t row, uint32_t op = 0);
+
+  RowRandomScope(const RowRandomScope &) = delete;
+
+  RowRandomScope &operator=(const RowRandomScope &) = delete;
+
+  ~RowRandomScope();
+
+  // @return The stream of the row of the calling thread, nullptr outside of a scope
+  static Philox *Current();
+
+ private:
+  Philox philox_;
+  Philox *prev_;
+};
+
+// The generator of the random TensorOps. It draws from the stream of the row in a RowRandomScope, else from a
+// std::mt19937 of the op, seeded with seed().
+class RandomEngine {
+ public:
+  using result_type = uint32_t;
+
+  RandomEngine() = default;
+
+  // Seeds the generator used outside of a RowRandomScope
+  // @param seed - The seed
+  void seed(uint32_t seed) { fallback_.seed(seed); }
+
+  static constexpr result_type min() { return Philox::min(); }
+
+  static constexpr result_type max() { return Philox::max(); }
+
+  result_type operator()() {
+    Philox *row = RowRandomScope::Current();
+    return row != nullptr ? (*row)() : static_cast<result_type>(fallback_());
+  }
+
+ private:
+  std::mt19937 fallback_;
+};
 }  // namespace dataset
 }  // namespace mindspore
 
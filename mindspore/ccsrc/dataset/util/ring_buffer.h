@@ -0,0 +1,249 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_RING_BUFFER_H_
+#define DATASET_UTIL_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dataset/util/intrp_resource.h"
+#include "dataset/util/services.h"
+#include "dataset/util/status.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+// Number of busy polls before a blocked RingBuffer call starts yielding its cpu.
+constexpr int32_t kRingBufferSpinCount = 64;
+
+// A bounded multi-producer multi-consumer queue without any lock.
+// Each slot carries a sequence number which tells a producer (or a consumer) whether the slot is
+// free (or filled) for the position it has claimed, so producers only contend on tail_ and consumers
+// only contend on head_.  Blocking Add()/PopFront() are built on top of TryAdd()/TryPopFront() by
+// polling with back off, and they honour the same interrupt protocol as Queue.
+template <typename T>
+class RingBuffer : public IntrpResource {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_reference = const T &;
+
+  explicit RingBuffer(int sz)
+      : sz_(sz), limit_(sz), slots_(sz), head_(0), tail_(0), my_name_(Services::GetUniqueID()), svc_(nullptr) {
+    for (uint64_t i = 0; i < sz_; i++) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    MS_LOG(DEBUG) << "Create ring buffer with uuid " << my_name_ << " of size " << sz_ << ".";
+  }
+
+  ~RingBuffer() override {
+    if (svc_ != nullptr) {
+      (void)svc_->Deregister(my_name_);
+      svc_ = nullptr;
+    }
+  }
+
+  RingBuffer(const RingBuffer &) = delete;
+
+  RingBuffer &operator=(const RingBuffer &) = delete;
+
+  // Approximated number of elements in the buffer. Only exact when there are no concurrent callers.
+  int size() const {
+    int64_t v = static_cast<int64_t>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+    return (v >= 0) ? static_cast<int>(v) : 0;
+  }
+
+  // The number of elements the buffer holds before a producer fails (or blocks).
+  int capacity() const { return static_cast<int>(limit_.load(std::memory_order_relaxed)); }
+
+  // The number of slots allocated at construction.
+  int max_capacity() const { return static_cast<int>(sz_); }
+
+  // Changes the capacity of the buffer, clamped between 1 and the allocated size.
+  // @note The limit is checked before a slot is claimed, so concurrent producers may overshoot it a little.
+  void set_capacity(int sz) noexcept {
+    uint64_t limit = (sz < 1) ? 1 : ((static_cast<uint64_t>(sz) > sz_) ? sz_ : static_cast<uint64_t>(sz));
+    limit_.store(limit, std::memory_order_relaxed);
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Producer. Returns false immediately if the buffer is full.
+  bool TryAdd(T &&ele) noexcept {
+    if (limit_.load(std::memory_order_relaxed) < sz_ && size() >= capacity()) {
+      return false;
+    }
+    uint64_t pos = 0;
+    Slot *slot = ClaimSlot(&tail_, 0, &pos);
+    if (slot == nullptr) {
+      return false;
+    }
+    slot->data = std::move(ele);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer. Returns false immediately if the buffer is empty.
+  bool TryPopFront(pointer p) noexcept {
+    uint64_t pos = 0;
+    Slot *slot = ClaimSlot(&head_, 1, &pos);
+    if (slot == nullptr) {
+      return false;
+    }
+    *p = std::move(slot->data);
+    slot->data = T();
+    slot->seq.store(pos + sz_, std::memory_order_release);
+    return true;
+  }
+
+  // Producer. Block when full.
+  Status Add(const_reference ele) noexcept {
+    T copy(ele);
+    return Add(std::move(copy));
+  }
+
+  // Producer. Block when full.
+  Status Add(T &&ele) noexcept {
+    return WaitFor([this, &ele]() -> bool { return TryAdd(std::move(ele)); });
+  }
+
+  // Consumer. Block when empty.
+  Status PopFront(pointer p) noexcept {
+    return WaitFor([this, p]() -> bool { return TryPopFront(p); });
+  }
+
+  // Drop all the elements and rewind the positions.
+  // @note Not thread safe. All producers and consumers must be quiesced.
+  void ResetQue() noexcept {
+    for (uint64_t i = 0; i < sz_; i++) {
+      slots_[i].data = T();
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    ResetIntrpState();
+  }
+
+  Status Register(TaskGroup *vg) {
+    std::shared_ptr<IntrpService> svc = vg->GetIntrpService();
+    Status rc = svc->Register(my_name_, this);
+    if (rc.IsOk()) {
+      svc_ = svc;
+    }
+    return rc;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    T data;
+  };
+
+  // Claim the next slot from the counter *cursor. A slot at position pos is ready for a producer
+  // when its sequence number is pos, and ready for a consumer when it is pos + 1.
+  // @param cursor Either tail_ (producers) or head_ (consumers).
+  // @param ready_offset 0 for producers, 1 for consumers.
+  // @param pos The claimed position.
+  // @return The claimed slot or nullptr if the buffer is full (or empty).
+  Slot *ClaimSlot(std::atomic<uint64_t> *cursor, uint64_t ready_offset, uint64_t *pos) noexcept {
+    uint64_t cur = cursor->load(std::memory_order_relaxed);
+    while (true) {
+      Slot *slot = &slots_[cur % sz_];
+      uint64_t seq = slot->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq - (cur + ready_offset));
+      if (diff == 0) {
+        if (cursor->compare_exchange_weak(cur, cur + 1, std::memory_order_relaxed)) {
+          *pos = cur;
+          return slot;
+        }
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        cur = cursor->load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Poll f until it succeeds. Spin first, then give up the cpu between polls.
+  Status WaitFor(const std::function<bool()> &f) noexcept {
+    int32_t spin = 0;
+    while (!f()) {
+      if (Interrupted()) {
+        return Status(StatusCode::kInterrupted);
+      }
+      RETURN_IF_INTERRUPTED();
+      if (spin < kRingBufferSpinCount) {
+        ++spin;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    return Status::OK();
+  }
+
+  uint64_t sz_;
+  std::atomic<uint64_t> limit_;
+  std::vector<Slot> slots_;
+  // Consumers and producers update different ends of the buffer. Keep them on separate cache lines.
+  alignas(64) std::atomic<uint64_t> head_;
+  alignas(64) std::atomic<uint64_t> tail_;
+  std::string my_name_;
+  std::shared_ptr<IntrpService> svc_;
+};
+
+// A container of ring buffers with [] operator accessors. This is the RingBuffer counterpart of QueueList.
+template <typename T>
+class RingBufferList {
+ public:
+  RingBufferList() {}
+
+  ~RingBufferList() = default;
+
+  void Init(int num_queues, int capacity) {
+    ring_list_.reserve(num_queues);
+    for (int i = 0; i < num_queues; i++) {
+      ring_list_.emplace_back(mindspore::make_unique<RingBuffer<T>>(capacity));
+    }
+  }
+
+  Status Register(TaskGroup *vg) {
+    if (vg == nullptr) {
+      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                    "Null task group during RingBufferList registration.");
+    }
+    for (int i = 0; i < ring_list_.size(); ++i) {
+      RETURN_IF_NOT_OK(ring_list_[i]->Register(vg));
+    }
+    return Status::OK();
+  }
+
+  int size() const { return ring_list_.size(); }
+
+  std::unique_ptr<RingBuffer<T>> &operator[](const int index) { return ring_list_[index]; }
+
+ private:
+  std::vector<std::unique_ptr<RingBuffer<T>>> ring_list_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_UTIL_RING_BUFFER_H_
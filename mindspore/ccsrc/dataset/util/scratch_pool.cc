@@ -0,0 +1,98 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_ARENA_H_
+#include "dataset/util/scratch_pool.h"
+#include <utility>
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+thread_local std::shared_ptr<MemoryPool> g_thread_pool;
+}  // namespace
+
+ScratchPool::ScratchPool(std::shared_ptr<Arena> arena, size_t size_in_bytes, std::shared_ptr<MemoryPool> fallback)
+    : arena_(std::move(arena)), size_in_bytes_(size_in_bytes), fallback_(std::move(fallback)) {
+  base_ = static_cast<const char *>(arena_->get_base_addr());
+}
+
+Status ScratchPool::CreateScratchPool(std::shared_ptr<ScratchPool> *p, size_t size_in_MB,
+                                      std::shared_ptr<MemoryPool> fallback) {
+  if (p == nullptr || fallback == nullptr) {
+    RETURN_STATUS_UNEXPECTED("p or fallback is null");
+  }
+  std::shared_ptr<Arena> arena;
+  RETURN_IF_NOT_OK(Arena::CreateArena(&arena, size_in_MB));
+  auto pool = new (std::nothrow) ScratchPool(std::move(arena), size_in_MB * 1048576L, std::move(fallback));
+  if (pool == nullptr) {
+    return Status(StatusCode::kOutOfMemory);
+  }
+  p->reset(pool);
+  return Status::OK();
+}
+
+bool ScratchPool::Owns(const void *p) const {
+  const char *q = static_cast<const char *>(p);
+  return q >= base_ && q < base_ + size_in_bytes_;
+}
+
+Status ScratchPool::Allocate(size_t n, void **p) {
+  if (arena_->Allocate(n, p).IsOk()) {
+    return Status::OK();
+  }
+  return fallback_->Allocate(n, p);
+}
+
+Status ScratchPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  if (!Owns(*p)) {
+    return fallback_->Reallocate(p, old_sz, new_sz);
+  }
+  if (arena_->Reallocate(p, old_sz, new_sz).IsOk()) {
+    return Status::OK();
+  }
+  // Move the block out of the arena
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(fallback_->Allocate(new_sz, &q));
+  errno_t err = memcpy_s(q, new_sz, *p, old_sz);
+  if (err) {
+    fallback_->Deallocate(q);
+    RETURN_STATUS_UNEXPECTED(std::to_string(err));
+  }
+  arena_->Deallocate(*p);
+  *p = q;
+  return Status::OK();
+}
+
+void ScratchPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  if (Owns(p)) {
+    arena_->Deallocate(p);
+  } else {
+    fallback_->Deallocate(p);
+  }
+}
+
+std::shared_ptr<MemoryPool> ScratchPool::ThreadPool() { return g_thread_pool; }
+
+MemoryPoolScope::MemoryPoolScope(std::shared_ptr<MemoryPool> pool) : prev_(std::move(g_thread_pool)) {
+  g_thread_pool = std::move(pool);
+}
+
+MemoryPoolScope::~MemoryPoolScope() { g_thread_pool = std::move(prev_); }
+}  // namespace dataset
+}  // namespace mindspore
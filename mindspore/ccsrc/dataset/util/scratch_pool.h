@@ -0,0 +1,89 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_SCRATCH_POOL_H_
+#define DATASET_UTIL_SCRATCH_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "dataset/util/arena.h"
+#include "dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+// A memory pool for the intermediate tensors of the rows of one worker thread.
+// Image ops create a new tensor for every output, and system sized images go to mmap/munmap and page faults on
+// each malloc/free. The scratch pool keeps recycling the pages of an Arena instead, and falls back to another
+// pool when the arena is full or too small, e.g. once tensors which left the row still hold arena blocks.
+// A pool is installed for the tensors created by a thread with a MemoryPoolScope.
+class ScratchPool : public MemoryPool {
+ public:
+  // Creates a scratch pool.
+  // @param p - The new pool
+  // @param size_in_MB - The size of the arena
+  // @param fallback - The pool of the allocations which do not fit in the arena
+  // @return Status - The error code return
+  static Status CreateScratchPool(std::shared_ptr<ScratchPool> *p, size_t size_in_MB,
+                                  std::shared_ptr<MemoryPool> fallback);
+
+  ~ScratchPool() override = default;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override { return fallback_->get_max_size(); }
+
+  int PercentFree() const override { return arena_->PercentFree(); }
+
+  // @return The pool installed for the tensors created by the calling thread, nullptr for the global pool
+  static std::shared_ptr<MemoryPool> ThreadPool();
+
+ private:
+  friend class MemoryPoolScope;
+
+  ScratchPool(std::shared_ptr<Arena> arena, size_t size_in_bytes, std::shared_ptr<MemoryPool> fallback);
+
+  // @return T/F if the block comes from the arena
+  bool Owns(const void *p) const;
+
+  std::shared_ptr<Arena> arena_;
+  const char *base_;
+  size_t size_in_bytes_;
+  std::shared_ptr<MemoryPool> fallback_;
+};
+
+// Installs a pool for the tensors created by the calling thread, until the scope ends.
+class MemoryPoolScope {
+ public:
+  // @param pool - The pool to install, nullptr for the global pool
+  explicit MemoryPoolScope(std::shared_ptr<MemoryPool> pool);
+
+  ~MemoryPoolScope();
+
+  MemoryPoolScope(const MemoryPoolScope &) = delete;
+
+  MemoryPoolScope &operator=(const MemoryPoolScope &) = delete;
+
+ private:
+  std::shared_ptr<MemoryPool> prev_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_UTIL_SCRATCH_POOL_H_
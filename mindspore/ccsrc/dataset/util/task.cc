@@ -15,6 +15,7 @@
  */
 #include "dataset/util/task.h"
 #include "common/utils.h"
+#include "dataset/util/cpu_placement.h"
 #include "dataset/util/task_manager.h"
 #include "dataset/util/de_error.h"
 #include "utils/log_adapter.h"
@@ -33,6 +34,11 @@ void Task::operator()() {
     // the TaskGroup pointer and register. We move the registration logic to here (after we spawn) so we can
     // get the thread id.
     TaskGroup *vg = MyTaskGroup();
+    // A thread which can not be pinned still runs, only slower
+    Status pin_rc = CpuPlacement::PinCurrentThread(vg->cpus());
+    if (pin_rc.IsError()) {
+      MS_LOG(WARNING) << my_name_ << " " << pin_rc.ToString();
+    }
     rc_ = vg->GetIntrpService()->Register(ss.str(), this);
     if (rc_.IsOk()) {
       // Now we can run the given task.
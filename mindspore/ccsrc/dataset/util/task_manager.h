@@ -23,6 +23,8 @@
 #include <memory>
 #include <string>
 #include <set>
+#include <utility>
+#include <vector>
 #include "dataset/util/allocator.h"
 #include "dataset/util/intrp_service.h"
 #include "dataset/util/lock.h"
@@ -132,6 +134,14 @@ class TaskGroup : public Service {
 
   std::shared_ptr<IntrpService> GetIntrpService();
 
+  // Setter, the Tasks created afterwards pin their threads to these cpus, see CpuPlacement.
+  // @param cpus - The cpus, empty to leave the threads unpinned
+  void set_cpus(std::vector<int32_t> cpus) { cpus_ = std::move(cpus); }
+
+  // Getter
+  // @return The cpus of the threads of the group, empty if they are not pinned
+  const std::vector<int32_t> &cpus() const { return cpus_; }
+
  private:
   Status rc_;
   // Can't use rw_lock_ as we will lead to deadlatch. Create another mutex to serialize access to rc_.
@@ -139,6 +149,7 @@ class TaskGroup : public Service {
   RWLock rw_lock_;
   List<Task> grp_list_;
   std::shared_ptr<IntrpService> intrp_svc_;
+  std::vector<int32_t> cpus_;
 };
 
 namespace this_thread {
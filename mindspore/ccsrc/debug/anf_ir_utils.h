@@ -115,6 +115,7 @@ std::string GetFuncGraphProtoString(const FuncGraphPtr& func_graph);
 void DumpIRProto(const FuncGraphPtr& func_graph, const std::string& suffix);
 
 std::string GetOnnxProtoString(const FuncGraphPtr& func_graph);
+bool ExportOnnxFile(const FuncGraphPtr& func_graph, const std::string& file_name, bool external_data);
 std::string GetNodeType(const AnfNodePtr& nd);
 }  // namespace mindspore
 
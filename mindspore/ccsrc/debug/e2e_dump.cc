@@ -15,9 +15,12 @@
  */
 #include "debug/e2e_dump.h"
 #include <limits.h>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <string>
 #include <nlohmann/json.hpp>
+#include "device/convert_tensor_utils.h"
 #include "utils/log_adapter.h"
 #include "utils/system/file_system.h"
 #include "utils/system/env.h"
@@ -27,6 +30,33 @@
 using json = nlohmann::json;
 
 namespace mindspore {
+namespace {
+// the data queued to the writer thread at most, the step waits for the writer thread beyond it
+const size_t kMaxPendingDumpBytes = 1UL << 30;
+
+template <typename T>
+void GetTypedStatistics(const T* data, size_t elem_num, DumpStatistics* statistics) {
+  double sum = 0;
+  size_t count = 0;
+  for (size_t i = 0; i < elem_num; ++i) {
+    auto value = static_cast<double>(data[i]);
+    if (std::isnan(value)) {
+      statistics->nan_count++;
+      continue;
+    }
+    if (std::isinf(value)) {
+      statistics->inf_count++;
+      continue;
+    }
+    statistics->min = count == 0 ? value : std::min(statistics->min, value);
+    statistics->max = count == 0 ? value : std::max(statistics->max, value);
+    sum += value;
+    count++;
+  }
+  statistics->mean = count == 0 ? 0 : sum / count;
+}
+}  // namespace
+
 Dump::Dump()
     : dump_enable_(false),
       trans_flag_(false),
@@ -34,7 +64,28 @@ Dump::Dump()
       dump_net_name_("net_name"),
       dump_mode_(0),
       dump_iter_(0),
-      cur_iter_(0) {}
+      cur_iter_(0),
+      sample_interval_(1),
+      async_dump_(false),
+      statistics_only_(false) {}
+
+Dump::~Dump() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  dump_cond_.notify_one();
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
+  }
+}
+
+bool Dump::IsIterNeedDump() const {
+  if (dump_iter_ != 0) {
+    return cur_iter_ == dump_iter_;
+  }
+  return cur_iter_ % sample_interval_ == 0;
+}
 
 bool Dump::IsKernelNeedDump(const std::string& kernel_name) {
   if (dump_mode_ == 0) {
@@ -75,6 +126,9 @@ bool Dump::ParseDumpConfig(const string& dump_config_file) {
     if (!IsConfigValid(dumpSettings)) {
       return false;
     }
+    if (!ParseOptionalConfig(dumpSettings)) {
+      return false;
+    }
   }
   return true;
 }
@@ -118,6 +172,29 @@ bool Dump::IsConfigValid(const nlohmann::json& dumpSettings) {
   return true;
 }
 
+bool Dump::ParseOptionalConfig(const nlohmann::json& dumpSettings) {
+  auto sample_interval = dumpSettings.find("sample_interval");
+  if (sample_interval != dumpSettings.end()) {
+    if (!sample_interval->is_number_unsigned() || sample_interval->get<uint32_t>() == 0) {
+      MS_LOG(ERROR) << "sample_interval in Dump config json should be a positive integer.";
+      dump_enable_ = false;
+      return false;
+    }
+    sample_interval_ = sample_interval->get<uint32_t>();
+  }
+  auto async_dump = dumpSettings.find("async");
+  auto statistics_only = dumpSettings.find("statistics_only");
+  if ((async_dump != dumpSettings.end() && !async_dump->is_boolean()) ||
+      (statistics_only != dumpSettings.end() && !statistics_only->is_boolean())) {
+    MS_LOG(ERROR) << "async and statistics_only in Dump config json should be boolean.";
+    dump_enable_ = false;
+    return false;
+  }
+  async_dump_ = async_dump != dumpSettings.end() && async_dump->get<bool>();
+  statistics_only_ = statistics_only != dumpSettings.end() && statistics_only->get<bool>();
+  return true;
+}
+
 bool Dump::SetDumpConfFromJsonFile() {
   const char* config_path_str = std::getenv("MINDSPORE_CONFIG_PATH");
   if (config_path_str != nullptr) {
@@ -171,6 +248,129 @@ bool Dump::DumpToFile(const std::string& filename, const void* data, size_t len)
   return true;
 }
 
+bool Dump::DumpTensor(const std::string& filename, std::vector<uint8_t>&& data, TypeId type_id) {
+  if (!async_dump_) {
+    return WriteTensor({filename, std::move(data), type_id});
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!writer_thread_.joinable()) {
+    writer_thread_ = std::thread(&Dump::WriterLoop, this);
+  }
+  // a tensor larger than the limit is queued once the others are written
+  written_cond_.wait(lock, [this, &data] {
+    return pending_bytes_ == 0 || pending_bytes_ + data.size() <= kMaxPendingDumpBytes;
+  });
+  pending_bytes_ += data.size();
+  pending_dumps_.push_back({filename, std::move(data), type_id});
+  dump_cond_.notify_one();
+  return true;
+}
+
+void Dump::WaitDumpFinished() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  written_cond_.wait(lock, [this] { return pending_dumps_.empty() && !writing_; });
+}
+
+void Dump::WriterLoop() {
+  while (true) {
+    PendingDump dump;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      dump_cond_.wait(lock, [this] { return !pending_dumps_.empty() || stopped_; });
+      if (pending_dumps_.empty()) {
+        return;
+      }
+      dump = std::move(pending_dumps_.front());
+      pending_dumps_.pop_front();
+      writing_ = true;
+    }
+    if (!WriteTensor(dump)) {
+      MS_LOG(ERROR) << "Dump " << dump.filename << " failed.";
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_bytes_ -= dump.data.size();
+      writing_ = false;
+    }
+    written_cond_.notify_all();
+  }
+}
+
+bool Dump::WriteTensor(const PendingDump& dump) {
+  if (!statistics_only_) {
+    return DumpToFile(dump.filename, dump.data.data(), dump.data.size());
+  }
+  DumpStatistics statistics;
+  if (!GetStatistics(dump.data.data(), dump.data.size(), dump.type_id, &statistics)) {
+    MS_LOG(WARNING) << "The statistics of " << TypeIdLabel(dump.type_id) << " are not supported, skip "
+                    << dump.filename;
+    return true;
+  }
+  return WriteStatistics(dump.filename, statistics, dump.type_id);
+}
+
+bool Dump::WriteStatistics(const std::string& filename, const DumpStatistics& statistics, TypeId type_id) {
+  auto path_split_pos = filename.find_last_of('/');
+  auto dir = path_split_pos == std::string::npos ? std::string(".") : filename.substr(0, path_split_pos);
+  auto name = path_split_pos == std::string::npos ? filename : filename.substr(path_split_pos + 1);
+  std::string realpath;
+  if (!GetRealPath(dir + "/statistics.csv", &realpath)) {
+    MS_LOG(ERROR) << "get real path failed.";
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(statistics_mutex_);
+  bool exist = std::ifstream(realpath).good();
+  std::ofstream fd(realpath, std::ios::app | std::ios::out);
+  if (!fd.is_open()) {
+    MS_LOG(ERROR) << "open file " << realpath << " fail.";
+    return false;
+  }
+  if (!exist) {
+    fd << "name,type,min,max,mean,nan_count,inf_count\n";
+  }
+  fd << name << ',' << TypeIdLabel(type_id) << ',' << statistics.min << ',' << statistics.max << ','
+     << statistics.mean << ',' << statistics.nan_count << ',' << statistics.inf_count << '\n';
+  fd.close();
+  return true;
+}
+
+bool Dump::GetStatistics(const void* data, size_t len, TypeId type_id, DumpStatistics* statistics) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(statistics);
+  switch (type_id) {
+    case kNumberTypeFloat16: {
+      std::vector<float> float_data(len / sizeof(uint16_t));
+      device::HalfToFloat(float_data.data(), data, float_data.size());
+      GetTypedStatistics(float_data.data(), float_data.size(), statistics);
+      return true;
+    }
+    case kNumberTypeFloat32:
+      GetTypedStatistics(static_cast<const float*>(data), len / sizeof(float), statistics);
+      return true;
+    case kNumberTypeFloat64:
+      GetTypedStatistics(static_cast<const double*>(data), len / sizeof(double), statistics);
+      return true;
+    case kNumberTypeBool:
+    case kNumberTypeUInt8:
+      GetTypedStatistics(static_cast<const uint8_t*>(data), len / sizeof(uint8_t), statistics);
+      return true;
+    case kNumberTypeInt8:
+      GetTypedStatistics(static_cast<const int8_t*>(data), len / sizeof(int8_t), statistics);
+      return true;
+    case kNumberTypeInt16:
+      GetTypedStatistics(static_cast<const int16_t*>(data), len / sizeof(int16_t), statistics);
+      return true;
+    case kNumberTypeInt32:
+      GetTypedStatistics(static_cast<const int32_t*>(data), len / sizeof(int32_t), statistics);
+      return true;
+    case kNumberTypeInt64:
+      GetTypedStatistics(static_cast<const int64_t*>(data), len / sizeof(int64_t), statistics);
+      return true;
+    default:
+      return false;
+  }
+}
+
 bool Dump::GetRealPath(const std::string& inpath, std::string* outpath) {
   MS_EXCEPTION_IF_NULL(outpath);
   auto path_split_pos = inpath.find_last_of('/');
@@ -16,18 +16,32 @@
 #ifndef MINDSPORE_E2E_DUMP_H
 #define MINDSPORE_E2E_DUMP_H
 #include <stdint.h>
+#include <condition_variable>
+#include <deque>
 #include <string>
 #include <vector>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <nlohmann/json.hpp>
+#include "ir/dtype/type.h"
 
 namespace mindspore {
+// The statistics of a dumped tensor, the nan and inf are left out of the min, max and mean
+struct DumpStatistics {
+  double min = 0;
+  double max = 0;
+  double mean = 0;
+  size_t nan_count = 0;
+  size_t inf_count = 0;
+};
+
 class Dump {
  public:
   Dump();
 
-  ~Dump() = default;
+  ~Dump();
 
   bool dump_enable() const { return dump_enable_; }
 
@@ -43,12 +57,27 @@ class Dump {
 
   uint32_t cur_iter() const { return cur_iter_; }
 
+  uint32_t sample_interval() const { return sample_interval_; }
+
+  // whether the current iteration is dumped, the one of dump_iter, or one of every sample_interval iterations
+  bool IsIterNeedDump() const;
+
   bool IsKernelNeedDump(const std::string& kernel_name);
 
   bool SetDumpConfFromJsonFile();
 
   static bool DumpToFile(const std::string& filename, const void* data, size_t len);
 
+  // Write the data copied from the device to the file, or only its statistics to statistics.csv in the same
+  // directory in the statistics mode. The data is written by the writer thread if the dump is asynchronous, which
+  // holds at most kMaxPendingDumpBytes of data, the step waits for it beyond that.
+  bool DumpTensor(const std::string& filename, std::vector<uint8_t>&& data, TypeId type_id);
+
+  // Wait for the data queued to the writer thread written
+  void WaitDumpFinished();
+
+  static bool GetStatistics(const void* data, size_t len, TypeId type_id, DumpStatistics* statistics);
+
  protected:
   bool dump_enable_;
   bool trans_flag_;
@@ -57,6 +86,9 @@ class Dump {
   uint32_t dump_mode_;
   uint32_t dump_iter_;
   uint32_t cur_iter_;
+  uint32_t sample_interval_;
+  bool async_dump_;
+  bool statistics_only_;
   std::vector<std::string> dump_kernels_;
 
   static bool GetRealPath(const std::string& inpath, std::string* outpath);
@@ -67,6 +99,29 @@ class Dump {
   bool ParseDumpConfig(const std::string& dump_config_file);
   bool IsConfigExist(const nlohmann::json& dumpSettings);
   bool IsConfigValid(const nlohmann::json& dumpSettings);
+  bool ParseOptionalConfig(const nlohmann::json& dumpSettings);
+
+  struct PendingDump {
+    std::string filename;
+    std::vector<uint8_t> data;
+    TypeId type_id;
+  };
+  bool WriteTensor(const PendingDump& dump);
+  bool WriteStatistics(const std::string& filename, const DumpStatistics& statistics, TypeId type_id);
+  void WriterLoop();
+
+  std::thread writer_thread_;
+  std::mutex mutex_;
+  // notified when a dump is queued or the writer is stopped
+  std::condition_variable dump_cond_;
+  // notified when the writer thread has written a dump
+  std::condition_variable written_cond_;
+  std::deque<PendingDump> pending_dumps_;
+  size_t pending_bytes_ = 0;
+  bool writing_ = false;
+  bool stopped_ = false;
+  // statistics.csv is appended by the step or the writer thread
+  std::mutex statistics_mutex_;
 };
 
 using DumpConfPtr = std::shared_ptr<Dump>;
@@ -17,6 +17,8 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <numeric>
 #include "runtime/mem.h"
 #include "device/kernel_runtime_manager.h"
 #include "device/convert_tensor_utils.h"
@@ -210,6 +212,32 @@ bool AscendDeviceAddress::SyncHostToDevice(const std::vector<int> &shape, size_t
   return sync_ok;
 }
 
+bool AscendDeviceAddress::SyncDeviceToDevice(const DeviceAddress *src_device_addr) const {
+  MS_EXCEPTION_IF_NULL(src_device_addr);
+  if (src_device_addr->format() != format_ || src_device_addr->type_id() != type_id_ ||
+      src_device_addr->GetSize() != size_) {
+    return false;
+  }
+  SyncMemory(ptr_, src_device_addr->GetPtr(), size_, RT_MEMCPY_DEVICE_TO_DEVICE);
+  return true;
+}
+
+bool AscendDeviceAddress::SyncDeviceToHostRaw(void *host_ptr, size_t size) const {
+  if (size != size_) {
+    return false;
+  }
+  SyncMemory(host_ptr, ptr_, size_, RT_MEMCPY_DEVICE_TO_HOST);
+  return true;
+}
+
+bool AscendDeviceAddress::SyncHostToDeviceRaw(const void *host_ptr, size_t size) const {
+  if (size != size_) {
+    return false;
+  }
+  SyncMemory(ptr_, host_ptr, size_, RT_MEMCPY_HOST_TO_DEVICE);
+  return true;
+}
+
 bool AscendDeviceAddress::ConvertFormatAndSyncHostToDevice(const std::vector<int> &shape, size_t size,
                                                            mindspore::TypeId type, const void *host_ptr) const {
   bool sync_ok = false;
@@ -270,7 +298,8 @@ AscendDeviceAddress::~AscendDeviceAddress() {
 
 #ifdef ENABLE_DUMP_E2E
 bool AscendDeviceAddress::DumpMemToFile(bool trans_flag, const std::string &filepath, const std::string &host_fmt,
-                                        const std::vector<int> &host_shape, TypeId host_type) const {
+                                        const std::vector<int> &host_shape, TypeId host_type, Dump *dump) const {
+  MS_EXCEPTION_IF_NULL(dump);
   bool ret = false;
   if (filepath.empty()) {
     MS_LOG(ERROR) << "Dump file path is null!";
@@ -288,14 +317,15 @@ bool AscendDeviceAddress::DumpMemToFile(bool trans_flag, const std::string &file
   if (trans_flag) {
     std::string path = filepath + '_' + shape + '_' + TypeIdLabel(host_type) + '_' + host_fmt + file_extension;
     MS_LOG(INFO) << "E2E Dump path is " << path;
-    mindspore::tensor::TensorPtr out_tensor = std::make_shared<tensor::Tensor>(host_type, host_shape);
-    size_t host_size = out_tensor->data().nbytes();
-    ret = SyncDeviceToHost(host_shape, host_size, host_type, out_tensor->data_c(true));
+    size_t host_size =
+      std::accumulate(host_shape.begin(), host_shape.end(), trans::TypeIdSize(host_type), std::multiplies<size_t>());
+    auto host_tmp = std::vector<uint8_t>(host_size);
+    ret = SyncDeviceToHost(host_shape, host_size, host_type, host_tmp.data());
     if (!ret) {
       MS_LOG(ERROR) << "Copy device mem to host failed";
       return ret;
     }
-    ret = mindspore::Dump::DumpToFile(path, out_tensor->data_c(false), host_size);
+    ret = dump->DumpTensor(path, std::move(host_tmp), host_type);
   } else {
     auto host_tmp = std::vector<uint8_t>(size_);
     auto ret_rt_memcpy = rtMemcpy(host_tmp.data(), size_, ptr_, size_, RT_MEMCPY_DEVICE_TO_HOST);
@@ -305,7 +335,7 @@ bool AscendDeviceAddress::DumpMemToFile(bool trans_flag, const std::string &file
     std::string path =
       filepath + '_' + shape + '_' + TypeIdToType(type_id_)->ToString() + '_' + format_ + file_extension;
     MS_LOG(INFO) << "E2E Dump path is " << path;
-    ret = mindspore::Dump::DumpToFile(path, host_tmp.data(), size_);
+    ret = dump->DumpTensor(path, std::move(host_tmp), type_id_);
   }
 
   return ret;
@@ -25,6 +25,7 @@
 #include "ir/dtype.h"
 
 namespace mindspore {
+class Dump;
 namespace device {
 namespace ascend {
 class AscendDeviceAddress : public DeviceAddress {
@@ -35,9 +36,13 @@ class AscendDeviceAddress : public DeviceAddress {
   ~AscendDeviceAddress() override;
   bool SyncDeviceToHost(const std::vector<int> &shape, size_t size, TypeId type, void *host_ptr) const override;
   bool SyncHostToDevice(const std::vector<int> &shape, size_t size, TypeId type, const void *host_ptr) const override;
+  bool SyncDeviceToDevice(const DeviceAddress *src_device_addr) const override;
+  bool SyncDeviceToHostRaw(void *host_ptr, size_t size) const override;
+  bool SyncHostToDeviceRaw(const void *host_ptr, size_t size) const override;
 #ifdef ENABLE_DUMP_E2E
+  // copy the memory to host, and dump it by the dump, which may write it asynchronously
   bool DumpMemToFile(bool dump_mode, const std::string &filepath, const std::string &host_fmt,
-                     const std::vector<int> &host_shape, TypeId host_type) const;
+                     const std::vector<int> &host_shape, TypeId host_type, Dump *dump) const;
 #endif
  private:
   bool SyncDeviceToHostAndConvertFormat(const std::vector<int> &shape, size_t size, TypeId type, void *host_ptr) const;
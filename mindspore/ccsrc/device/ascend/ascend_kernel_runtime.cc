@@ -28,6 +28,8 @@
 #include "device/ascend/profiling/profiling_manager.h"
 #include "hccl/hcom.h"
 #include "runtime/context.h"
+#include "runtime/mem.h"
+#include "runtime/stream.h"
 #include "device/ascend/ascend_stream_assign.h"
 #include "device/ascend/ascend_memory_allocator.h"
 #include "framework/ge_runtime/model_runner.h"
@@ -37,6 +39,7 @@
 #include "kernel/tbe/tbe_utils.h"
 #include "kernel/tbe/tbe_python_funcs.h"
 #include "pre_activate/mem_reuse/mem_reuse_checker.h"
+#include "utils/timeline.h"
 
 using mindspore::device::ascend::ProfilingManager;
 using mindspore::device::ascend::ProfilingUtils;
@@ -53,10 +56,14 @@ static const size_t PRAMATER_OUTPUT_INDEX = 0;
 
 AscendKernelRuntime::~AscendKernelRuntime() { graph_model_map_.clear(); }
 
-void AscendKernelRuntime::ClearGraphModelMap() {
-  for (auto &iter : graph_model_id_map_) {
-    MS_LOG(INFO) << "Ge UnloadModel " << iter.second;
-    auto ret = ge::model_runner::ModelRunner::Instance().UnloadModel(iter.second);
+void AscendKernelRuntime::ClearGraphModelMap() { EvictModels(0); }
+
+void AscendKernelRuntime::EvictModels(size_t keep_num) {
+  while (loaded_models_.size() > keep_num) {
+    auto model_id = GetGraphModelId(loaded_models_.back());
+    loaded_models_.pop_back();
+    MS_LOG(INFO) << "Ge UnloadModel " << model_id;
+    auto ret = ge::model_runner::ModelRunner::Instance().UnloadModel(model_id);
     if (!ret) {
       MS_LOG(ERROR) << "UnloadModel failed";
     }
@@ -87,6 +94,7 @@ void AscendKernelRuntime::ReleaseDeviceRes() {
   }
 
   FreeDeviceMemory();
+  ReleaseSwapResource();
   (void)DestroyHccl();
   (void)ResetDevice();
   (void)ProfilingManager::GetInstance().StopProfiling();
@@ -158,7 +166,7 @@ void DumpOutput(mindspore::session::KernelGraph *graph, const string &dump_path,
       std::vector<int> int_shapes;
       (void)std::transform(shape.begin(), shape.end(), std::back_inserter(int_shapes),
                            [](size_t inner_item) { return SizeToInt(inner_item); });
-      auto ret = ascend_addr->DumpMemToFile(trans_flag, filepath, format, int_shapes, type);
+      auto ret = ascend_addr->DumpMemToFile(trans_flag, filepath, format, int_shapes, type, dump_conf.get());
       if (!ret) {
         MS_LOG(ERROR) << "DumpMemToFile Failed: flag:" << trans_flag << ", path:" << filepath
                       << ", host_format:" << format << ".!";
@@ -189,7 +197,7 @@ void DumpParameters(mindspore::session::KernelGraph *graph, const string &dump_p
     std::vector<int> int_shapes;
     (void)std::transform(shape.begin(), shape.end(), std::back_inserter(int_shapes),
                          [](size_t inner_item) { return SizeToInt(inner_item); });
-    auto ret = ascend_addr->DumpMemToFile(trans_flag, filepath, format, int_shapes, type);
+    auto ret = ascend_addr->DumpMemToFile(trans_flag, filepath, format, int_shapes, type, dump_conf.get());
     if (!ret) {
       MS_LOG(ERROR) << "DumpMemToFile Failed: flag:" << trans_flag << ", path:" << filepath
                     << ", host_format:" << format << ".!";
@@ -212,10 +220,8 @@ bool AscendKernelRuntime::DumpData(mindspore::session::KernelGraph *graph) {
     return true;
   }
   uint32_t cur_iter = dump_conf->cur_iter();
-  if (dump_conf->dump_iter() != 0) {
-    if (cur_iter != dump_conf->dump_iter()) {
-      return true;
-    }
+  if (!dump_conf->IsIterNeedDump()) {
+    return true;
   }
   MS_LOG(INFO) << "cur iter is " << cur_iter;
   std::string net_name = dump_conf->dump_net_name();
@@ -322,6 +328,14 @@ bool AscendKernelRuntime::LoadTask(const session::KernelGraph *graph) {
     return true;
   }
 
+  if (std::find(loaded_models_.begin(), loaded_models_.end(), graph) != loaded_models_.end()) {
+    return true;
+  }
+  return LoadModel(graph);
+}
+
+bool AscendKernelRuntime::LoadModel(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
   auto task_iter = graph_model_map_.find(graph);
   if (task_iter == graph_model_map_.end()) {
     MS_LOG(ERROR) << "task not exist";
@@ -331,14 +345,27 @@ bool AscendKernelRuntime::LoadTask(const session::KernelGraph *graph) {
   auto model_id = GetGraphModelId(graph);
   std::shared_ptr<ge::ModelListener> listener;
   MS_LOG(INFO) << "LoadDavinciModel mode_id:" << model_id;
-  bool status =
-    ge::model_runner::ModelRunner::Instance().LoadDavinciModel(device_id_, 0, model_id, task_iter->second, listener);
+  auto &model_runner = ge::model_runner::ModelRunner::Instance();
+  bool status = model_runner.LoadDavinciModel(device_id_, 0, model_id, task_iter->second, listener);
+  if (!status && !loaded_models_.empty()) {
+    // the device memory is most likely taken by the other models, which are loaded again when they run
+    MS_LOG(WARNING) << "Load model " << model_id << " failed, unload the " << loaded_models_.size()
+                    << " loaded models and load it again";
+    EvictModels(0);
+    status = model_runner.LoadDavinciModel(device_id_, 0, model_id, task_iter->second, listener);
+  }
   if (!status) {
     MS_LOG(INFO) << "load task failed";
     return false;
   }
+  loaded_models_.push_front(graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (context_ptr->max_device_models() > 0) {
+    EvictModels(context_ptr->max_device_models());
+  }
   if (ProfilingManager::GetInstance().IsProfiling()) {
-    std::vector<uint32_t> task_ids = ge::model_runner::ModelRunner::Instance().GetTaskIdList(model_id);
+    std::vector<uint32_t> task_ids = model_runner.GetTaskIdList(model_id);
     ProfilingUtils::ReportProfilingData(graph->graph_id(), task_ids);
   }
   return true;
@@ -350,12 +377,32 @@ bool AscendKernelRuntime::RunTask(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(context_ptr);
   ge::InputData input_tensors = ge::InputData();
   ge::OutputData *output_tensors = nullptr;
+  // the model evicted is loaded again from its tasks kept, which don't need to be generated again
+  auto loaded_iter = std::find(loaded_models_.begin(), loaded_models_.end(), graph);
+  if (loaded_iter == loaded_models_.end()) {
+    MS_LOG(INFO) << "Load the evicted model of graph " << graph->graph_id() << " again";
+    if (!LoadModel(graph)) {
+      MS_LOG(ERROR) << "Load the model of graph " << graph->graph_id() << " failed";
+      return false;
+    }
+  } else {
+    loaded_models_.splice(loaded_models_.begin(), loaded_models_, loaded_iter);
+  }
   auto model_id = GetGraphModelId(graph);
+  // the kernels of the sunk graph are run by the model, so all of its time is the device compute of the step stats
+  auto &step_stats = StepStats::GetInstance();
+  uint64_t start_us = step_stats.started() ? Timeline::NowUs() : 0;
   bool status = ge::model_runner::ModelRunner::Instance().RunModel(model_id, input_tensors, output_tensors);
   if (!status) {
     MS_LOG(INFO) << "run task failed";
     return false;
   }
+  if (start_us != 0) {
+    if (!SyncStream()) {
+      return false;
+    }
+    step_stats.Add(kStepDeviceCompute, Timeline::NowUs() - start_us);
+  }
   return true;
 }
 
@@ -367,6 +414,100 @@ bool AscendKernelRuntime::SyncStream() {
   return true;
 }
 
+bool AscendKernelRuntime::SupportMemSwap() const {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // the sunk tasks are not launched one by one, there is no place to issue the swaps
+  return !context_ptr->enable_task_sink();
+}
+
+bool AscendKernelRuntime::InitSwapResource(size_t event_num) {
+  if (swap_stream_ == nullptr) {
+    auto ret = rtStreamCreate(&swap_stream_, 0);
+    if (ret != RT_ERROR_NONE) {
+      MS_LOG(ERROR) << "rtStreamCreate for the swap stream, ret[" << ret << "]";
+      swap_stream_ = nullptr;
+      return false;
+    }
+  }
+  while (swap_events_.size() < event_num) {
+    rtEvent_t swap_event = nullptr;
+    rtEvent_t compute_event = nullptr;
+    if (rtEventCreate(&swap_event) != RT_ERROR_NONE || rtEventCreate(&compute_event) != RT_ERROR_NONE) {
+      MS_LOG(ERROR) << "rtEventCreate for the swap failed";
+      return false;
+    }
+    swap_events_.push_back(swap_event);
+    compute_events_.push_back(compute_event);
+  }
+  return true;
+}
+
+uint8_t *AscendKernelRuntime::MallocSwapHostMem(size_t size) {
+  void *host_ptr = nullptr;
+  auto ret = rtMallocHost(&host_ptr, size);
+  if (ret != RT_ERROR_NONE) {
+    MS_LOG(ERROR) << "rtMallocHost size[" << size << "], ret[" << ret << "]";
+    return nullptr;
+  }
+  swap_host_mems_.push_back(host_ptr);
+  return static_cast<uint8_t *>(host_ptr);
+}
+
+bool AscendKernelRuntime::SwapMemAsync(void *dst, const void *src, size_t size, bool to_host, size_t event_id) {
+  if (event_id >= swap_events_.size()) {
+    MS_LOG(ERROR) << "The swap event id " << event_id << " is out of the event size " << swap_events_.size();
+    return false;
+  }
+  // the swap stream waits for the kernels launched to the compute stream before
+  if (rtEventRecord(compute_events_[event_id], stream_) != RT_ERROR_NONE ||
+      rtStreamWaitEvent(swap_stream_, compute_events_[event_id]) != RT_ERROR_NONE) {
+    MS_LOG(ERROR) << "Sync the swap stream with the compute stream failed";
+    return false;
+  }
+  auto kind = to_host ? RT_MEMCPY_DEVICE_TO_HOST : RT_MEMCPY_HOST_TO_DEVICE;
+  if (rtMemcpyAsync(dst, size, src, size, kind, swap_stream_) != RT_ERROR_NONE) {
+    MS_LOG(ERROR) << "rtMemcpyAsync of the swap failed, size[" << size << "]";
+    return false;
+  }
+  if (rtEventRecord(swap_events_[event_id], swap_stream_) != RT_ERROR_NONE) {
+    MS_LOG(ERROR) << "rtEventRecord of the swap failed";
+    return false;
+  }
+  return true;
+}
+
+bool AscendKernelRuntime::WaitSwapEvent(size_t event_id) {
+  if (event_id >= swap_events_.size()) {
+    MS_LOG(ERROR) << "The swap event id " << event_id << " is out of the event size " << swap_events_.size();
+    return false;
+  }
+  if (rtStreamWaitEvent(stream_, swap_events_[event_id]) != RT_ERROR_NONE) {
+    MS_LOG(ERROR) << "rtStreamWaitEvent for the swap failed";
+    return false;
+  }
+  return true;
+}
+
+void AscendKernelRuntime::ReleaseSwapResource() {
+  for (auto &event : swap_events_) {
+    (void)rtEventDestroy(event);
+  }
+  for (auto &event : compute_events_) {
+    (void)rtEventDestroy(event);
+  }
+  swap_events_.clear();
+  compute_events_.clear();
+  for (auto &host_ptr : swap_host_mems_) {
+    (void)rtFreeHost(host_ptr);
+  }
+  swap_host_mems_.clear();
+  if (swap_stream_ != nullptr) {
+    (void)rtStreamDestroy(swap_stream_);
+    swap_stream_ = nullptr;
+  }
+}
+
 bool AscendKernelRuntime::InitDevice() {
   int device_count = 0;
   auto ret = rtGetDeviceCount(&device_count);
@@ -488,23 +629,16 @@ bool AscendKernelRuntime::DestroyHccl() {
 
 bool AscendKernelRuntime::MallocDeviceMemory() {
   device_mem_size_ = ASCEND_MEM_SIZE_BYTE;
-  MS_EXCEPTION_IF_NULL(MsContext::GetInstance());
-  if (MsContext::GetInstance()->enable_dynamic_mem_pool()) {
-    static_mem_offset_ = FloatToSize(device_mem_size_ * GRAPH_INIT_DAVINCI_MEM_RATIO);
-    device_mem_pool_size_ = FloatToSize(device_mem_size_ * (1 - GRAPH_INIT_DAVINCI_MEM_RATIO));
-    auto ret = rtMalloc(reinterpret_cast<void **>(&device_mem_pool_base_), device_mem_pool_size_, RT_MEMORY_HBM);
-    if (ret != RT_ERROR_NONE) {
-      MS_EXCEPTION(DeviceProcessError) << "rtMalloc mem size[" << device_mem_pool_size_ << "] fail, ret[" << ret << "]";
-    }
-    AscendMemoryAllocator::GetInstance().set_device_mem_pool_base(device_mem_pool_base_);
-    AscendMemoryAllocator::GetInstance().set_device_mem_pool_size(device_mem_pool_size_);
-  } else {
-    static_mem_offset_ = device_mem_size_;
-  }
   auto ret = rtMalloc(reinterpret_cast<void **>(&device_mem_base_), device_mem_size_, RT_MEMORY_HBM);
   if (ret != RT_ERROR_NONE) {
     MS_EXCEPTION(DeviceProcessError) << "rtMalloc mem size[" << device_mem_size_ << "] fail, ret[" << ret << "]";
   }
+  // The graphs and the memory pool take the memory from the same device memory as they need it.
+  mem_segments_.Init(device_mem_base_, device_mem_size_);
+  MS_EXCEPTION_IF_NULL(MsContext::GetInstance());
+  if (MsContext::GetInstance()->enable_dynamic_mem_pool()) {
+    AscendMemoryAllocator::GetInstance().set_mem_segments(&mem_segments_);
+  }
   return true;
 }
 
@@ -516,13 +650,49 @@ void AscendKernelRuntime::FreeDeviceMemory() {
     }
     device_mem_base_ = nullptr;
   }
-  if (device_mem_pool_base_ != nullptr) {
-    auto ret = rtFree(device_mem_pool_base_);
-    if (ret != RT_ERROR_NONE) {
-      MS_LOG(ERROR) << "rtFree mem size[" << device_mem_pool_size_ << "] fail, ret[" << ret << "]";
-    }
-    device_mem_pool_base_ = nullptr;
+  mem_segments_.Init(nullptr, 0);
+}
+
+size_t AscendKernelRuntime::CompactDeviceMemory() {
+  MS_EXCEPTION_IF_NULL(MsContext::GetInstance());
+  if (!MsContext::GetInstance()->enable_dynamic_mem_pool()) {
+    return 0;
+  }
+  return AscendMemoryAllocator::GetInstance().ReleaseIdleMemBlock();
+}
+
+uint8_t *AscendKernelRuntime::MallocStaticMem(size_t size, bool communication_mem) {
+  size_t align_size = communication_mem ? GetCommunicationAlignSize(size) : GetCommonAlignSize(size);
+  auto addr = mem_segments_.AllocSegment(align_size);
+  if (addr == nullptr && CompactDeviceMemory() > 0) {
+    addr = mem_segments_.AllocSegment(align_size);
+  }
+  if (addr == nullptr) {
+    MS_LOG(EXCEPTION) << "Out of memory!!! total[" << device_mem_size_ << "](dynamic[" << mem_segments_.dynamic_size()
+                      << "] static and memory pool[" << mem_segments_.segment_size() << "])"
+                      << " malloc [" << align_size << "] failed!";
   }
+  total_static_size_ += align_size;
+  return communication_mem ? addr + mem_align_size_ : addr;
+}
+
+uint8_t *AscendKernelRuntime::MallocDynamicMem(size_t size, bool communication_mem) {
+  size_t align_size = communication_mem ? GetCommunicationAlignSize(size) : GetCommonAlignSize(size);
+  uint64_t offset = dynamic_mem_offset_;
+  auto new_offset = dynamic_mem_offset_ + align_size;
+  // The dynamic memory of the graphs only grows into the memory the static memory and the memory pool don't use.
+  bool reserved = mem_segments_.ReserveDynamic(new_offset);
+  if (!reserved && CompactDeviceMemory() > 0) {
+    reserved = mem_segments_.ReserveDynamic(new_offset);
+  }
+  if (!reserved) {
+    MS_LOG(EXCEPTION) << "Out of memory!!! total[" << device_mem_size_ << "](dynamic[" << mem_segments_.dynamic_size()
+                      << "] static and memory pool[" << mem_segments_.segment_size() << "])"
+                      << " malloc [" << align_size << "] failed!";
+  }
+  total_dynamic_size_ += align_size;
+  dynamic_mem_offset_ = new_offset;
+  return communication_mem ? device_mem_base_ + offset + mem_align_size_ : device_mem_base_ + offset;
 }
 
 void AscendKernelRuntime::FreeHostMemory() { dynamic_mem_offset_ = 0; }
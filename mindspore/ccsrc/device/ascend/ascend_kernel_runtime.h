@@ -15,14 +15,17 @@
  */
 #ifndef MINDSPORE_CCSRC_DEVICE_ASCEND_ASCEND_KERNEL_RUNTIME_H_
 #define MINDSPORE_CCSRC_DEVICE_ASCEND_ASCEND_KERNEL_RUNTIME_H_
+#include <list>
 #include <memory>
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include "device/kernel_runtime.h"
 #include "runtime/context.h"
+#include "runtime/event.h"
 #include "framework/ge_runtime/davinci_model.h"
 #include "device/kernel_runtime_manager.h"
+#include "pre_activate/mem_reuse/mem_segment_allocator.h"
 
 using ge::model_runner::TaskInfo;
 using std::unordered_map;
@@ -46,6 +49,13 @@ class AscendKernelRuntime : public KernelRuntime {
                                        TypeId type_id) override;
   bool SyncStream() override;
   void MallocOpMemory(const DeviceAddressPtr address, size_t size, int flag) override;
+  uint8_t *MallocStaticMem(size_t size, bool communication_mem) override;
+  uint8_t *MallocDynamicMem(size_t size, bool communication_mem) override;
+  bool SupportMemSwap() const override;
+  bool InitSwapResource(size_t event_num) override;
+  uint8_t *MallocSwapHostMem(size_t size) override;
+  bool SwapMemAsync(void *dst, const void *src, size_t size, bool to_host, size_t event_id) override;
+  bool WaitSwapEvent(size_t event_id) override;
 
  private:
   bool InitDevice();
@@ -55,14 +65,28 @@ class AscendKernelRuntime : public KernelRuntime {
   bool DestroyHccl();
   bool MallocDeviceMemory();
   void FreeDeviceMemory();
+  // Give the memory blocks the memory pool doesn't use back to the graphs, return the size released.
+  size_t CompactDeviceMemory();
   void ClearGraphModelMap();
+  void ReleaseSwapResource();
   void ReleaseDeviceRes() override;
   uint32_t GetGraphModelId(const session::KernelGraph *kernel_graph);
+  bool LoadModel(const session::KernelGraph *graph);
+  void EvictModels(size_t keep_num);
   rtContext_t rt_context_{nullptr};
+  // the memory swap copies on its own stream, an event pair syncs it with the compute stream for each copy
+  rtStream_t swap_stream_{nullptr};
+  vector<rtEvent_t> swap_events_;
+  vector<rtEvent_t> compute_events_;
+  vector<void *> swap_host_mems_;
   bool initialized_{false};
   unordered_map<const session::KernelGraph *, vector<std::shared_ptr<TaskInfo>>> task_map_;
   unordered_map<const session::KernelGraph *, std::shared_ptr<ge::model_runner::DavinciModel>> graph_model_map_;
   unordered_map<const session::KernelGraph *, uint32_t> graph_model_id_map_;
+  // the graphs whose models are loaded on the device, the most recently run first
+  std::list<const session::KernelGraph *> loaded_models_;
+  // the device memory shared by the static and the dynamic memory of the graphs and the dynamic memory pool
+  MemSegmentAllocator mem_segments_;
 };
 
 MS_REG_KERNEL_RUNTIME(kAscendDevice, AscendKernelRuntime);
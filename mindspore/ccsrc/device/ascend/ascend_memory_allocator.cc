@@ -21,35 +21,20 @@
 namespace mindspore {
 namespace device {
 namespace ascend {
-const uint64_t MEM_SIZE = 20;
-const uint64_t MEM_SIZE_BYTE = (MEM_SIZE << 30);
-
-AscendMemoryAllocator::AscendMemoryAllocator() {
-  hasMalloc_ = false;
-  free_mem_size_ = FloatToSize(MEM_SIZE_BYTE * (1 - GRAPH_INIT_DAVINCI_MEM_RATIO));
-  total_mem_size_ = free_mem_size_;
-}
-
 size_t AscendMemoryAllocator::AllocDeviceMem(size_t size, DeviceMemPtr* addr) {
-  if (hasMalloc_) {
-    MS_LOG(EXCEPTION) << "Has alloc memory pool memory !";
-  }
-  if (size == 0 || size > free_mem_size_) {
-    MS_LOG(EXCEPTION) << "Failed to alloc memory pool memory !";
-  }
-  *addr = device_mem_pool_base_;
+  MS_EXCEPTION_IF_NULL(mem_segments_);
+  *addr = mem_segments_->AllocSegment(size);
   if (*addr == nullptr) {
-    MS_LOG(EXCEPTION) << "Device memory pool base is nullptr, failed to alloc memory pool memory!";
+    MS_LOG(EXCEPTION) << "Failed to alloc memory pool memory size[" << size << "], the free device memory size is "
+                      << mem_segments_->free_size() << ".";
   }
-  hasMalloc_ = true;
-  free_mem_size_ -= size;
   return size;
 }
 
 bool AscendMemoryAllocator::FreeDeviceMem(const DeviceMemPtr& addr) {
   MS_EXCEPTION_IF_NULL(addr);
-  hasMalloc_ = false;
-  free_mem_size_ = total_mem_size_;
+  MS_EXCEPTION_IF_NULL(mem_segments_);
+  mem_segments_->FreeSegment(addr);
   return true;
 }
 
@@ -60,16 +45,17 @@ size_t AscendMemoryAllocator::AlignMemorySize(size_t size) const {
   return ((size + DYNAMIC_MEM_ALIGN_SIZE + 31) / DYNAMIC_MEM_ALIGN_SIZE) * DYNAMIC_MEM_ALIGN_SIZE;
 }
 
-size_t AscendMemoryAllocator::mem_alloc_unit_size() const { return free_mem_size_ - 512; }
-
-void AscendMemoryAllocator::set_device_mem_pool_base(uint8_t* device_mem_pool_base) {
-  MS_EXCEPTION_IF_NULL(device_mem_pool_base);
-  device_mem_pool_base_ = device_mem_pool_base;
+size_t AscendMemoryAllocator::free_mem_size() {
+  MS_EXCEPTION_IF_NULL(mem_segments_);
+  // Leave the room the size of a memory block grows by when it is aligned.
+  auto max_free_size = mem_segments_->max_free_size();
+  return max_free_size > 2 * DYNAMIC_MEM_ALIGN_SIZE ? max_free_size - 2 * DYNAMIC_MEM_ALIGN_SIZE : 0;
 }
 
-size_t AscendMemoryAllocator::free_mem_size() { return free_mem_size_; }
-
-size_t AscendMemoryAllocator::total_mem_size() { return total_mem_size_; }
+size_t AscendMemoryAllocator::total_mem_size() {
+  MS_EXCEPTION_IF_NULL(mem_segments_);
+  return mem_segments_->size();
+}
 }  // namespace ascend
 }  // namespace device
 }  // namespace mindspore
@@ -19,21 +19,19 @@
 
 #include <memory>
 #include "pre_activate/mem_reuse/mem_dynamic_allocator.h"
+#include "pre_activate/mem_reuse/mem_segment_allocator.h"
 
 namespace mindspore {
 namespace device {
 namespace ascend {
-// The fraction of total ascend memory used to compute the graph.
-static const float GRAPH_INIT_DAVINCI_MEM_RATIO = 0.8;
-
+// The memory blocks of the pool are segments of the device memory the graphs use, taken as the pool grows.
 class AscendMemoryAllocator : public DynamicMemPoolBestFit {
  public:
   ~AscendMemoryAllocator() override = default;
 
   size_t AllocDeviceMem(size_t size, DeviceMemPtr* addr) override;
   bool FreeDeviceMem(const DeviceMemPtr& addr) override;
-  void set_device_mem_pool_base(uint8_t* device_mem_pool_base);
-  void set_device_mem_pool_size(uint64_t device_mem_pool_size) { device_mem_pool_size_ = device_mem_pool_size; }
+  void set_mem_segments(MemSegmentAllocator* mem_segments) { mem_segments_ = mem_segments; }
   size_t free_mem_size() override;
   size_t total_mem_size() override;
 
@@ -45,18 +43,12 @@ class AscendMemoryAllocator : public DynamicMemPoolBestFit {
  protected:
   // The real size by memory alloc aligned.
   size_t AlignMemorySize(size_t size) const override;
-  // Get the minimum memory unit size using for dynamic extend.
-  size_t mem_alloc_unit_size() const override;
 
  private:
-  AscendMemoryAllocator();
+  AscendMemoryAllocator() = default;
   AscendMemoryAllocator(const AscendMemoryAllocator&) = delete;
   AscendMemoryAllocator& operator=(const AscendMemoryAllocator&) = delete;
-  bool hasMalloc_;
-  uint8_t* device_mem_pool_base_{nullptr};
-  uint64_t device_mem_pool_size_{0};
-  size_t free_mem_size_;
-  size_t total_mem_size_;
+  MemSegmentAllocator* mem_segments_{nullptr};
 };
 }  // namespace ascend
 }  // namespace device
@@ -17,9 +17,13 @@
 #include "device/ascend/ascend_stream_assign.h"
 
 #include <algorithm>
+#include <map>
+#include <set>
 #include <utility>
 
 #include "ir/manager.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
 #include "utils/context/ms_context.h"
 #include "common/utils.h"
 #include "session/anf_runtime_algorithm.h"
@@ -27,6 +31,7 @@
 #include "predict/generator/utils/ir_model_util.h"
 #include "device/kernel_info.h"
 #include "pre_activate/common/helper.h"
+#include "utils/metrics.h"
 
 namespace mindspore {
 namespace device {
@@ -34,6 +39,114 @@ namespace ascend {
 const uint32_t kHcomMaxTask = 5;
 const uint32_t kCommonMaxTask = 350;
 const uint32_t kIndependFirstStreamId = 1024;
+// the least kernels of a branch run on a stream of its own, which costs at least the events to fork and join it
+const size_t kBranchMinKernelNum = 3;
+const size_t kMaxBranchStreamNum = 4;
+
+namespace {
+bool IsStreamControlNode(const CNodePtr &node) {
+  auto name = AnfAlgo::GetCNodeName(node);
+  return name == "Send" || name == "Recv" || name == "StreamActive" || name == "StreamSwitch" ||
+         name == kAtomicAddrCleanOpName;
+}
+
+// collect the kernels and the parameters a node reads, through the virtual nodes and the nop nodes
+void CollectInputs(const AnfNodePtr &node, std::set<AnfNodePtr> *kernels, std::set<AnfNodePtr> *params) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (node->isa<Parameter>()) {
+    (void)params->insert(node);
+    return;
+  }
+  if (!node->isa<CNode>()) {
+    return;
+  }
+  if (AnfAlgo::IsRealKernel(node) && !opt::IsNopNode(node)) {
+    (void)kernels->insert(node);
+    return;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+    CollectInputs(cnode->input(i), kernels, params);
+  }
+}
+
+// The indexes of the kernels each kernel of the execution order depends on. The kernels using the same parameter
+// keep their order, as some of them update it in place.
+std::vector<std::vector<size_t>> GetDependIndexes(const std::vector<CNodePtr> &cnodes) {
+  std::unordered_map<AnfNodePtr, size_t> index_map;
+  std::unordered_map<AnfNodePtr, size_t> last_param_user;
+  std::vector<std::vector<size_t>> depends(cnodes.size());
+  for (size_t i = 0; i < cnodes.size(); ++i) {
+    std::set<AnfNodePtr> kernels;
+    std::set<AnfNodePtr> params;
+    auto &inputs = cnodes[i]->inputs();
+    for (size_t j = 1; j < inputs.size(); ++j) {
+      CollectInputs(inputs[j], &kernels, &params);
+    }
+    for (auto &kernel : kernels) {
+      auto iter = index_map.find(kernel);
+      if (iter != index_map.end()) {
+        depends[i].push_back(iter->second);
+      }
+    }
+    for (auto &param : params) {
+      auto iter = last_param_user.find(param);
+      if (iter != last_param_user.end()) {
+        depends[i].push_back(iter->second);
+      }
+      last_param_user[param] = i;
+    }
+    std::sort(depends[i].begin(), depends[i].end());
+    (void)depends[i].erase(std::unique(depends[i].begin(), depends[i].end()), depends[i].end());
+    index_map[cnodes[i]] = i;
+  }
+  return depends;
+}
+
+// the kernels ordered by the control depends, which are not seen in the inputs of the kernels
+void GetControlDependInputs(const std::shared_ptr<session::KernelGraph> &graph_ptr, std::set<AnfNodePtr> *kernels,
+                            std::set<AnfNodePtr> *params) {
+  MS_EXCEPTION_IF_NULL(graph_ptr);
+  for (auto &node : TopoSort(graph_ptr->get_return())) {
+    if (!AnfAlgo::CheckPrimitiveType(node, prim::kPrimControlDepend)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    CollectInputs(cnode->input(kControlDependPriorIndex), kernels, params);
+    CollectInputs(cnode->input(kControlDependBehindIndex), kernels, params);
+  }
+}
+
+// the streams each stream has waited for, by the number of their kernels waited for
+using StreamClock = std::map<uint32_t, size_t>;
+
+void MergeClock(const StreamClock &from, StreamClock *to) {
+  for (auto &item : from) {
+    auto &count = (*to)[item.first];
+    count = std::max(count, item.second);
+  }
+}
+
+size_t WaitedCount(const StreamClock &clock, uint32_t stream_id) {
+  auto iter = clock.find(stream_id);
+  return iter == clock.end() ? 0 : iter->second;
+}
+
+size_t HcomInputBytes(const CNodePtr &cnode) {
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(cnode); ++i) {
+    auto shape = AnfAlgo::GetPrevNodeOutputInferShape(cnode, i);
+    size_t bytes = GetTypeByte(TypeIdToType(AnfAlgo::GetPrevNodeOutputInferDataType(cnode, i)));
+    for (auto dim : shape) {
+      bytes *= dim;
+    }
+    total_bytes += bytes;
+  }
+  return total_bytes;
+}
+}  // namespace
 
 bool AscendStreamAssign::IsHcom(const CNodePtr &apply_kernel) {
   MS_EXCEPTION_IF_NULL(apply_kernel);
@@ -54,6 +167,7 @@ void AscendStreamAssign::ResetNew() {
   inner_parallel_streams_.clear();
   processed_parallel_streams_.clear();
   hcom_stream_list_.clear();
+  branch_parent_map_.clear();
 }
 
 void AscendStreamAssign::AssignIndependentStreamId(const CNodePtr &cur_cnode_ptr, uint32_t processing_logic_id) {
@@ -200,6 +314,129 @@ void AscendStreamAssign::AssignAllNodesStream(const shared_ptr<session::KernelGr
   MS_LOG(INFO) << "stream nums:common:" << total_common_stream_num_ << ",independ:" << total_independ_stream_num_;
 }
 
+void AscendStreamAssign::AssignBranchStreams(const shared_ptr<session::KernelGraph> &graph_ptr) {
+  MS_EXCEPTION_IF_NULL(graph_ptr);
+  auto cnodes = graph_ptr->execution_order();
+  size_t node_num = cnodes.size();
+  auto depends = GetDependIndexes(cnodes);
+  // the kernels of the longest paths from the sources to each kernel and from each kernel to the sinks
+  std::vector<size_t> from_source(node_num, 1);
+  std::vector<size_t> to_sink(node_num, 1);
+  std::vector<std::vector<size_t>> users(node_num);
+  for (size_t i = 0; i < node_num; ++i) {
+    for (auto j : depends[i]) {
+      from_source[i] = std::max(from_source[i], from_source[j] + 1);
+      users[j].push_back(i);
+    }
+  }
+  for (size_t i = node_num; i > 0; --i) {
+    for (auto user : users[i - 1]) {
+      to_sink[i - 1] = std::max(to_sink[i - 1], to_sink[user] + 1);
+    }
+  }
+  // one critical path stays on the common streams, the first kernel of the longest path in the order is its source
+  size_t path_len = 0;
+  size_t cur = node_num;
+  for (size_t i = 0; i < node_num; ++i) {
+    if (from_source[i] + to_sink[i] > path_len) {
+      path_len = from_source[i] + to_sink[i];
+      cur = i;
+    }
+  }
+  std::vector<bool> on_path(node_num, false);
+  while (cur < node_num) {
+    on_path[cur] = true;
+    auto next = std::find_if(users[cur].begin(), users[cur].end(),
+                             [&to_sink, cur](size_t user) { return to_sink[user] + 1 == to_sink[cur]; });
+    cur = next == users[cur].end() ? node_num : *next;
+  }
+
+  std::set<AnfNodePtr> control_kernels;
+  std::set<AnfNodePtr> control_params;
+  GetControlDependInputs(graph_ptr, &control_kernels, &control_params);
+  auto is_candidate = [&](size_t i) {
+    auto &cnode = cnodes[i];
+    if (on_path[i] || AnfAlgo::GetStreamId(cnode) >= kIndependFirstStreamId || IsHcom(cnode) ||
+        IsStreamControlNode(cnode) || AnfAlgo::GetCNodeName(cnode) == kGetNextOpName ||
+        control_kernels.count(cnode) != 0) {
+      return false;
+    }
+    std::set<AnfNodePtr> kernels;
+    std::set<AnfNodePtr> params;
+    for (size_t j = 1; j < cnode->inputs().size(); ++j) {
+      CollectInputs(cnode->input(j), &kernels, &params);
+    }
+    return std::none_of(params.begin(), params.end(),
+                        [&control_params](const AnfNodePtr &param) { return control_params.count(param) != 0; });
+  };
+  // the branches are the connected candidates on the same stream, the first kernel staying on the stream activates
+  // it before any of them
+  std::vector<bool> candidates(node_num, false);
+  std::vector<size_t> roots(node_num);
+  std::map<uint32_t, size_t> first_stay;
+  std::function<size_t(size_t)> find_root = [&roots, &find_root](size_t i) {
+    return roots[i] == i ? i : (roots[i] = find_root(roots[i]));
+  };
+  for (size_t i = 0; i < node_num; ++i) {
+    roots[i] = i;
+    candidates[i] = is_candidate(i);
+    auto stream_id = AnfAlgo::GetStreamId(cnodes[i]);
+    if (!candidates[i]) {
+      (void)first_stay.insert(std::make_pair(stream_id, i));
+      continue;
+    }
+    for (auto j : depends[i]) {
+      if (candidates[j] && AnfAlgo::GetStreamId(cnodes[j]) == stream_id) {
+        roots[find_root(j)] = find_root(i);
+      }
+    }
+  }
+  std::vector<std::vector<size_t>> branches;
+  std::unordered_map<size_t, size_t> root_branch_map;
+  for (size_t i = 0; i < node_num; ++i) {
+    if (!candidates[i]) {
+      continue;
+    }
+    auto iter = root_branch_map.find(find_root(i));
+    if (iter == root_branch_map.end()) {
+      iter = root_branch_map.insert(std::make_pair(find_root(i), branches.size())).first;
+      branches.emplace_back();
+    }
+    branches[iter->second].push_back(i);
+  }
+
+  // the branch streams of a stream are reused by its later branches, the one whose last kernel is the earliest first
+  using BranchStream = std::pair<uint32_t, size_t>;
+  std::map<uint32_t, std::vector<BranchStream>> branch_streams;
+  for (auto &branch : branches) {
+    auto parent_id = AnfAlgo::GetStreamId(cnodes[branch.front()]);
+    auto stay_iter = first_stay.find(parent_id);
+    if (branch.size() < kBranchMinKernelNum || stay_iter == first_stay.end() || stay_iter->second > branch.front()) {
+      continue;
+    }
+    auto &streams = branch_streams[parent_id];
+    auto stream_iter = std::min_element(streams.begin(), streams.end(),
+                                        [](const BranchStream &lhs, const BranchStream &rhs) {
+                                          return lhs.second < rhs.second;
+                                        });
+    bool all_busy = stream_iter == streams.end() || stream_iter->second > branch.front();
+    if (streams.size() < kMaxBranchStreamNum && all_busy) {
+      streams.emplace_back(independent_id_, 0);
+      branch_parent_map_[independent_id_] = parent_id;
+      independent_id_++;
+      stream_iter = streams.end() - 1;
+    }
+    for (auto i : branch) {
+      AnfAlgo::SetStreamId(stream_iter->first, cnodes[i].get());
+    }
+    stream_iter->second = branch.back();
+    MS_LOG(INFO) << "branch of " << branch.size() << " kernels from node[" << cnodes[branch.front()]->DebugString()
+                 << "] runs on stream[" << stream_iter->first << "] from stream[" << parent_id << "]";
+  }
+  total_independ_stream_num_ = independent_id_ - kIndependFirstStreamId;
+  MS_LOG(INFO) << "critical path kernel nums:" << path_len - 1 << ", branch stream nums:" << branch_parent_map_.size();
+}
+
 vector<uint32_t> AscendStreamAssign::TransLogicToPhysic(const vector<uint32_t> &logic_ids) {
   vector<uint32_t> physic_ids;
   for (auto &id : logic_ids) {
@@ -273,6 +510,9 @@ void AscendStreamAssign::FindAllReduceParallel(const shared_ptr<session::KernelG
     cur_cnode_ptr = cnode_ptr_list[i];
     MS_EXCEPTION_IF_NULL(cur_cnode_ptr);
     uint32_t cur_stream_id = AnfAlgo::GetStreamId(cur_cnode_ptr);
+    if (IsBranchStream(cur_stream_id)) {
+      continue;
+    }
     if (i == 0) {
       pre_cnode_ptr = cur_cnode_ptr;
       pre_stream_id = cur_stream_id;
@@ -296,11 +536,25 @@ void AscendStreamAssign::InsertSendRecvForHcomParallel(const shared_ptr<mindspor
   auto cnode_ptr_list = graph_ptr->execution_order();
   vector<CNodePtr> cnodes = cnode_ptr_list;
   uint32_t cur_event_id = 0;
+  // the bytes of the hcom ops, and of the ones with compute kernels to run along with before their results are used
+  size_t hcom_bytes = 0;
+  size_t overlap_bytes = 0;
+  size_t overlap_kernels = 0;
   auto it = cnodes.begin();
   while (it != cnodes.end() && (it + 1) != cnodes.end()) {
     MS_EXCEPTION_IF_NULL(*it);
     MS_EXCEPTION_IF_NULL(*(it + 1));
+    if (IsHcom(*it)) {
+      hcom_bytes += HcomInputBytes(*it);
+    }
     if (IsHcom(*it) && !IsHcom(*(it + 1))) {
+      size_t run_bytes = 0;
+      for (auto hcom = it; IsHcom(*hcom); --hcom) {
+        run_bytes += HcomInputBytes(*hcom);
+        if (hcom == cnodes.begin()) {
+          break;
+        }
+      }
       CNodePtr send_cnode_ptr = CreateSendApplyKernel(graph_ptr, cur_event_id, AnfAlgo::GetStreamId(*it));
       it = cnodes.insert(it + 1, send_cnode_ptr);
 
@@ -312,6 +566,14 @@ void AscendStreamAssign::InsertSendRecvForHcomParallel(const shared_ptr<mindspor
         continue;
       }
 
+      auto kernels = std::count_if(it + 1, target, [this](const CNodePtr &cnode) {
+        return !IsHcom(cnode) && !IsStreamControlNode(cnode);
+      });
+      if (kernels > 0) {
+        overlap_bytes += run_bytes;
+        overlap_kernels += static_cast<size_t>(kernels);
+      }
+
       // deal recv op
       uint32_t stream_id = AnfAlgo::GetStreamId(*target);
       CNodePtr recv_cnode_ptr = CreateRecvApplyKernel(graph_ptr, cur_event_id, stream_id);
@@ -323,6 +585,19 @@ void AscendStreamAssign::InsertSendRecvForHcomParallel(const shared_ptr<mindspor
   graph_ptr->set_execution_order(cnodes);
   total_event_num_ = cur_event_id;
   MS_LOG(INFO) << "after insert send/recv for hcom parallel, total event nums[" << total_event_num_ << "]";
+  if (hcom_bytes != 0) {
+    auto overlap_permille = static_cast<int64_t>(overlap_bytes * 1000 / hcom_bytes);
+    MS_LOG(INFO) << "hcom bytes[" << hcom_bytes << "], overlapped bytes[" << overlap_bytes << "], overlapped kernels["
+                 << overlap_kernels << "]";
+    auto &registry = MetricsRegistry::GetInstance();
+    registry
+      .GetGauge("mindspore_hcom_overlap_permille",
+                "The permille of the hcom bytes of the last graph overlapped by the compute kernels.")
+      ->Set(overlap_permille);
+    registry
+      .GetGauge("mindspore_hcom_overlap_kernels", "The compute kernels of the last graph running along with hcom.")
+      ->Set(static_cast<int64_t>(overlap_kernels));
+  }
   MS_LOG(INFO) << "end";
 }
 
@@ -417,6 +692,149 @@ void AscendStreamAssign::InsertActiveNew(const std::shared_ptr<session::KernelGr
   MS_LOG(INFO) << "end";
 }
 
+void AscendStreamAssign::InsertActiveForBranch(const std::shared_ptr<session::KernelGraph> &graph_ptr) {
+  MS_EXCEPTION_IF_NULL(graph_ptr);
+  std::vector<CNodePtr> update_cnode_list;
+  std::set<uint32_t> activated_streams;
+  for (auto &cur_cnode_ptr : graph_ptr->execution_order()) {
+    MS_EXCEPTION_IF_NULL(cur_cnode_ptr);
+    uint32_t cur_stream_id = AnfAlgo::GetStreamId(cur_cnode_ptr);
+    auto iter = branch_parent_map_.find(cur_stream_id);
+    if (iter != branch_parent_map_.end() && activated_streams.insert(cur_stream_id).second) {
+      // the parent stream activates the branch stream before its first kernel, and its atomic clean
+      MS_LOG(INFO) << "Insert active op for branch stream id[" << cur_stream_id << "], self stream id[" << iter->second
+                   << "]";
+      CNodePtr active_ptr = KernelAdjust::GetInstance().CreateSteamActiveOp(graph_ptr);
+      AnfAlgo::SetStreamId(iter->second, active_ptr.get());
+      AnfAlgo::SetNodeAttr(kAttrActiveStreamList, MakeValue<std::vector<uint32_t>>({cur_stream_id}), active_ptr);
+      auto pos = update_cnode_list.end();
+      if (!update_cnode_list.empty() && AnfAlgo::GetCNodeName(update_cnode_list.back()) == kAtomicAddrCleanOpName) {
+        --pos;
+      }
+      (void)update_cnode_list.insert(pos, active_ptr);
+    }
+    update_cnode_list.emplace_back(cur_cnode_ptr);
+  }
+  graph_ptr->set_execution_order(update_cnode_list);
+}
+
+void AscendStreamAssign::InsertSendRecvForBranch(const std::shared_ptr<session::KernelGraph> &graph_ptr) {
+  MS_LOG(INFO) << "start";
+  MS_EXCEPTION_IF_NULL(graph_ptr);
+  auto cnodes = graph_ptr->execution_order();
+  size_t node_num = cnodes.size();
+  auto depends = GetDependIndexes(cnodes);
+  // the clocks of the streams and of each kernel after it runs, a dependency waited for by the stream already, also
+  // through the events or the activations of the others, needs no event
+  std::map<uint32_t, StreamClock> stream_clocks;
+  std::vector<StreamClock> node_clocks(node_num);
+  std::unordered_map<uint32_t, StreamClock> event_clocks;
+  std::map<uint32_t, size_t> last_nodes;
+  std::vector<std::vector<CNodePtr>> recvs_before(node_num);
+  std::vector<std::vector<CNodePtr>> sends_after(node_num);
+  uint32_t cur_event_id = total_event_num_;
+  auto insert_event = [&](size_t send_index, uint32_t recv_stream_id, std::vector<CNodePtr> *recvs) {
+    auto send_stream_id = AnfAlgo::GetStreamId(cnodes[send_index]);
+    sends_after[send_index].push_back(CreateSendApplyKernel(graph_ptr, cur_event_id, send_stream_id));
+    recvs->push_back(CreateRecvApplyKernel(graph_ptr, cur_event_id, recv_stream_id));
+    MergeClock(node_clocks[send_index], &stream_clocks[recv_stream_id]);
+    ++cur_event_id;
+  };
+
+  // the branches join the last common stream before its trailing stream control op, or at the end
+  size_t join_index = node_num;
+  for (size_t i = node_num; i > 0; --i) {
+    auto stream_id = AnfAlgo::GetStreamId(cnodes[i - 1]);
+    if (stream_id < kIndependFirstStreamId && !IsBranchStream(stream_id)) {
+      join_index = i - 1;
+      break;
+    }
+  }
+  if (join_index == node_num) {
+    MS_LOG(EXCEPTION) << "no common stream to join the branch streams";
+  }
+  uint32_t join_stream_id = AnfAlgo::GetStreamId(cnodes[join_index]);
+  bool join_before = IsStreamControlNode(cnodes[join_index]);
+  std::vector<CNodePtr> join_recvs;
+  auto join_branches = [&]() {
+    for (auto &last_node : last_nodes) {
+      auto branch_id = last_node.first;
+      if (IsBranchStream(branch_id) &&
+          WaitedCount(stream_clocks[join_stream_id], branch_id) < WaitedCount(stream_clocks[branch_id], branch_id)) {
+        insert_event(last_node.second, join_stream_id, &join_recvs);
+      }
+    }
+  };
+
+  for (size_t i = 0; i < node_num; ++i) {
+    auto &cnode = cnodes[i];
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto stream_id = AnfAlgo::GetStreamId(cnode);
+    if (i == join_index && join_before) {
+      join_branches();
+    }
+    auto &clock = stream_clocks[stream_id];
+    for (auto j : depends[i]) {
+      auto depend_stream_id = AnfAlgo::GetStreamId(cnodes[j]);
+      if (depend_stream_id != stream_id &&
+          WaitedCount(clock, depend_stream_id) < WaitedCount(node_clocks[j], depend_stream_id)) {
+        insert_event(j, stream_id, &recvs_before[i]);
+      }
+    }
+    clock[stream_id]++;
+    last_nodes[stream_id] = i;
+    auto name = AnfAlgo::GetCNodeName(cnode);
+    if (name == "Send") {
+      event_clocks[GetValue<uint32_t>(AnfAlgo::GetCNodePrimitive(cnode)->GetAttr(kAttrEventId))] = clock;
+    } else if (name == "Recv") {
+      MergeClock(event_clocks[GetValue<uint32_t>(AnfAlgo::GetCNodePrimitive(cnode)->GetAttr(kAttrEventId))], &clock);
+    } else if (name == "StreamActive" || name == "StreamSwitch") {
+      auto primitive = AnfAlgo::GetCNodePrimitive(cnode);
+      MS_EXCEPTION_IF_NULL(primitive);
+      std::vector<uint32_t> active_ids;
+      if (primitive->HasAttr(kAttrActiveStreamList)) {
+        active_ids = GetValue<std::vector<uint32_t>>(primitive->GetAttr(kAttrActiveStreamList));
+      }
+      if (primitive->HasAttr(kAttrTrueBranchStream)) {
+        active_ids.push_back(GetValue<uint32_t>(primitive->GetAttr(kAttrTrueBranchStream)));
+      }
+      // the kernels of a stream activated for the first time run after the activation
+      for (auto active_id : active_ids) {
+        if (stream_clocks[active_id].empty()) {
+          stream_clocks[active_id] = clock;
+        }
+      }
+    }
+    node_clocks[i] = clock;
+  }
+  if (!join_before) {
+    join_branches();
+  }
+
+  std::vector<CNodePtr> update_cnode_list;
+  for (size_t i = 0; i < node_num; ++i) {
+    if (i == join_index && join_before) {
+      (void)update_cnode_list.insert(update_cnode_list.end(), join_recvs.begin(), join_recvs.end());
+    }
+    // the recv ops go before the atomic clean of the kernel, which cleans its outputs
+    auto pos = update_cnode_list.end();
+    if (!recvs_before[i].empty() && !update_cnode_list.empty() &&
+        AnfAlgo::GetCNodeName(update_cnode_list.back()) == kAtomicAddrCleanOpName) {
+      --pos;
+    }
+    (void)update_cnode_list.insert(pos, recvs_before[i].begin(), recvs_before[i].end());
+    update_cnode_list.push_back(cnodes[i]);
+    (void)update_cnode_list.insert(update_cnode_list.end(), sends_after[i].begin(), sends_after[i].end());
+  }
+  if (!join_before) {
+    (void)update_cnode_list.insert(update_cnode_list.end(), join_recvs.begin(), join_recvs.end());
+  }
+  graph_ptr->set_execution_order(update_cnode_list);
+  MS_LOG(INFO) << "events for branch streams[" << cur_event_id - total_event_num_ << "]";
+  total_event_num_ = cur_event_id;
+  MS_LOG(INFO) << "end";
+}
+
 void AscendStreamAssign::UpdateStreamId(const shared_ptr<session::KernelGraph> &graph_ptr) {
   MS_LOG(INFO) << "start";
   MS_EXCEPTION_IF_NULL(graph_ptr);
@@ -466,6 +884,13 @@ void AscendStreamAssign::UpdateStreamId(const shared_ptr<session::KernelGraph> &
     }
   }
 
+  // update branch_parent_map_
+  std::unordered_map<uint32_t, uint32_t> branch_parent_map;
+  for (auto &branch : branch_parent_map_) {
+    branch_parent_map[branch.first - kIndependFirstStreamId + total_common_stream_num_] = branch.second;
+  }
+  branch_parent_map_.swap(branch_parent_map);
+
   // update independent_id_
   independent_id_ = independent_id_ - kIndependFirstStreamId + total_common_stream_num_;
   MS_LOG(INFO) << "end";
@@ -475,10 +900,19 @@ void AscendStreamAssign::AssignStreamNew(const shared_ptr<session::KernelGraph>
   if (IsTaskSink()) {
     ResetNew();
     AssignAllNodesStream(graph_ptr);
+    auto ms_context = MsContext::GetInstance();
+    MS_EXCEPTION_IF_NULL(ms_context);
+    if (ms_context->enable_branch_streams()) {
+      AssignBranchStreams(graph_ptr);
+    }
     FindAllReduceParallel(graph_ptr);
     InsertActiveNew(graph_ptr);
+    InsertActiveForBranch(graph_ptr);
     InsertSendRecvForHcomParallel(graph_ptr);
     InsertSendRecvForIndependent(graph_ptr);
+    if (!branch_parent_map_.empty()) {
+      InsertSendRecvForBranch(graph_ptr);
+    }
     UpdateStreamId(graph_ptr);
 
     MS_LOG(INFO) << "after finish stream assign";
@@ -687,6 +1121,15 @@ std::vector<uint32_t> AscendStreamAssign::GetHcomStreams() {
   return hcom_stream_list_;
 }
 
+std::vector<uint32_t> AscendStreamAssign::GetBranchStreams() const {
+  std::vector<uint32_t> branch_streams;
+  for (auto &branch : branch_parent_map_) {
+    branch_streams.push_back(branch.first);
+  }
+  std::sort(branch_streams.begin(), branch_streams.end());
+  return branch_streams;
+}
+
 uint32_t AscendStreamAssign::GetTotalStreamNum() const { return total_common_stream_num_ + total_independ_stream_num_; }
 
 void AscendStreamAssign::PrintGraphExeOrders(const shared_ptr<mindspore::session::KernelGraph> &graph_ptr) {
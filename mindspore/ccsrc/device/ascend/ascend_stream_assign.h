@@ -64,6 +64,8 @@ class AscendStreamAssign {
   const std::unordered_map<uint32_t, uint32_t> GetPhysicMap() { return logic_to_physic_map_; }
   std::vector<uint32_t> GetWaitStreams();
   std::vector<uint32_t> GetHcomStreams();
+  // the streams running the branches off the critical path, each of them may run in parallel with all the others
+  std::vector<uint32_t> GetBranchStreams() const;
 
  private:
   AscendStreamAssign() = default;
@@ -97,6 +99,10 @@ class AscendStreamAssign {
   vector<uint32_t> GetParallelStream(uint32_t cur_stream_id, uint32_t stream_acitve_id);
   void InsertSendRecvForIndependent(const std::shared_ptr<session::KernelGraph>& graph_ptr);
   void InsertSendRecvForHcomParallel(const std::shared_ptr<session::KernelGraph>& graph_ptr);
+  bool IsBranchStream(uint32_t stream_id) const { return branch_parent_map_.count(stream_id) != 0; }
+  void AssignBranchStreams(const std::shared_ptr<session::KernelGraph>& graph_ptr);
+  void InsertActiveForBranch(const std::shared_ptr<session::KernelGraph>& graph_ptr);
+  void InsertSendRecvForBranch(const std::shared_ptr<session::KernelGraph>& graph_ptr);
 
   uint32_t total_common_stream_num_{0};
   uint32_t total_independ_stream_num_{0};
@@ -112,6 +118,7 @@ class AscendStreamAssign {
   std::vector<std::vector<uint32_t>> inner_parallel_streams_{};
   std::vector<uint32_t> processed_parallel_streams_{};
   std::vector<uint32_t> hcom_stream_list_{};
+  std::unordered_map<uint32_t, uint32_t> branch_parent_map_{};  // key: branch stream id, value: parent stream id
   // new policy end
 };
 }  // namespace ascend
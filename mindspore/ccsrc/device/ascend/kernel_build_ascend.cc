@@ -20,6 +20,7 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <future>
 
 #include "device/ascend/kernel_select_ascend.h"
 #include "device/kernel_info.h"
@@ -85,12 +86,17 @@ static bool KernelBuildParallelCompile(const mindspore::session::KernelGraph *ke
       }
     }
   }
+  // the other kernels are built while the tbe kernels are compiled by the processes, they don't call the python
+  // and only write the kernel mods of their own nodes
+  auto other_build = std::async(std::launch::async, [&other_nodes]() {
+    for (const auto &anf_node : other_nodes) {
+      kernel::KernelModPtr kernel_mod_ptr = SerialCompileImpl(anf_node);
+      MS_EXCEPTION_IF_NULL(kernel_mod_ptr);
+      AnfAlgo::SetKernelMod(kernel_mod_ptr, anf_node.get());
+    }
+  });
   bool ret = kernel::TbeOpParallelBuild(tbe_nodes);
-  for (const auto &anf_node : other_nodes) {
-    kernel::KernelModPtr kernel_mod_ptr = SerialCompileImpl(anf_node);
-    MS_EXCEPTION_IF_NULL(kernel_mod_ptr);
-    AnfAlgo::SetKernelMod(kernel_mod_ptr, anf_node.get());
-  }
+  other_build.get();
   return ret;
 }
 
@@ -196,6 +202,19 @@ bool KernelBuild(const mindspore::session::KernelGraph *kernel_graph_ptr) {
   return ret;
 }
 
+void KernelEarlyBuild(const mindspore::session::KernelGraph *kernel_graph_ptr) {
+  MS_EXCEPTION_IF_NULL(kernel_graph_ptr);
+  std::vector<AnfNodePtr> tbe_nodes;
+  for (const auto &anf_node : kernel_graph_ptr->execution_order()) {
+    MS_EXCEPTION_IF_NULL(anf_node);
+    if (AnfAlgo::IsRealKernel(anf_node) && AnfAlgo::GetKernelType(anf_node) == KernelType::TBE_KERNEL &&
+        AnfAlgo::GetKernelMod(anf_node) == nullptr) {
+      tbe_nodes.push_back(anf_node);
+    }
+  }
+  kernel::TbeOpEarlyBuild(tbe_nodes);
+}
+
 void KernelBuildPreprocess(mindspore::session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   std::vector<CNodePtr> new_nodes;
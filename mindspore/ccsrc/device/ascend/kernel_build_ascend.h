@@ -26,6 +26,10 @@ namespace ascend {
  * @brief kernel build for ascend.
  */
 bool KernelBuild(const mindspore::session::KernelGraph *kernel_graph_ptr);
+/**
+ * @brief start compiling the tbe kernels of a graph whose formats are final, joined by the next kernel build.
+ */
+void KernelEarlyBuild(const mindspore::session::KernelGraph *kernel_graph_ptr);
 /**
  * @brief preporcess of kernel build for ascend, e.g. inserting clear_zero node for maxpool, bn.
  * Must DO these changes just before kernel build, and after all of other optimizations on AnfGraph
@@ -18,7 +18,10 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <map>
+#include <mutex>
 #include <set>
+#include <sstream>
 #include <unordered_map>
 #include "kernel/oplib/oplib.h"
 #include "kernel/kernel_query.h"
@@ -501,11 +504,90 @@ void SelectKernel(const CNodePtr &kernel_node, bool precision_reduce, const std:
   // Set format and data type for input tensor.
   SetTensorDeviceInfo(*selected_kernel_info_ptr, kernel_node);
 }
+
+struct SelectDecision {
+  kernel::KernelBuildInfoPtr kernel_info;
+  bool precision_reduce;
+  std::vector<TypeId> node_datatype;
+};
+
+// the kernels selected for the nodes, by the keys of the nodes
+std::unordered_map<std::string, SelectDecision> select_decisions;
+std::mutex select_decisions_mutex;
+constexpr size_t kMaxSelectDecisionNum = 8192;
+
+void AppendShape(const std::vector<size_t> &shape, std::ostringstream *key) {
+  for (auto dim : shape) {
+    *key << dim << ",";
+  }
+}
+
+// The selection only reads the op and attributes of a node and the formats, types and shapes around it, so the
+// nodes alike share one decision instead of querying and scoring the kernels each.
+std::string SelectDecisionKey(const CNodePtr &kernel_node) {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  std::ostringstream key;
+  key << AnfAlgo::GetCNodeName(kernel_node) << "|" << context_ptr->execution_mode() << "|"
+      << context_ptr->auto_mixed_precision_flag();
+  auto primitive = AnfAlgo::GetCNodePrimitive(kernel_node);
+  MS_EXCEPTION_IF_NULL(primitive);
+  std::map<std::string, std::string> attrs;
+  for (auto &attr : primitive->attrs()) {
+    attrs[attr.first] = attr.second == nullptr ? "" : attr.second->ToString();
+  }
+  for (auto &attr : attrs) {
+    key << "|" << attr.first << "=" << attr.second;
+  }
+  for (size_t input_index = 0; input_index < AnfAlgo::GetInputTensorNum(kernel_node); ++input_index) {
+    auto input_node = AnfAlgo::GetInputNode(kernel_node, input_index);
+    MS_EXCEPTION_IF_NULL(input_node);
+    bool is_weight = input_node->isa<Parameter>() && AnfAlgo::IsParameterWeight(input_node->cast<ParameterPtr>());
+    key << "|i" << is_weight << input_node->isa<ValueNode>() << AnfAlgo::IsFeatureMapInput(kernel_node, input_index)
+        << AnfAlgo::GetPrevNodeOutputFormat(kernel_node, input_index) << ":"
+        << AnfAlgo::GetPrevNodeOutputDeviceDataType(kernel_node, input_index) << ":"
+        << AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, input_index) << ":";
+    AppendShape(AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, input_index), &key);
+  }
+  for (size_t output_index = 0; output_index < AnfAlgo::GetOutputTensorNum(kernel_node); ++output_index) {
+    key << "|o" << AnfAlgo::GetOutputInferDataType(kernel_node, output_index) << ":";
+    AppendShape(AnfAlgo::GetOutputInferShape(kernel_node, output_index), &key);
+  }
+  return key.str();
+}
+
+// the passes after the selection change the kernel infos of the nodes in place, so each node gets a copy of its own
+bool UseSelectDecision(const std::string &key, const CNodePtr &kernel_node) {
+  SelectDecision decision;
+  {
+    std::lock_guard<std::mutex> lock(select_decisions_mutex);
+    auto iter = select_decisions.find(key);
+    if (iter == select_decisions.end()) {
+      return false;
+    }
+    decision = iter->second;
+  }
+  auto kernel_info = std::make_shared<kernel::KernelBuildInfo>(*decision.kernel_info);
+  SelectKernel(kernel_node, decision.precision_reduce, decision.node_datatype, kernel_info);
+  return true;
+}
+
+void SaveSelectDecision(const std::string &key, const kernel::KernelBuildInfoPtr &kernel_info, bool precision_reduce,
+                        const std::vector<TypeId> &node_datatype) {
+  std::lock_guard<std::mutex> lock(select_decisions_mutex);
+  if (select_decisions.size() < kMaxSelectDecisionNum) {
+    select_decisions[key] = {std::make_shared<kernel::KernelBuildInfo>(*kernel_info), precision_reduce, node_datatype};
+  }
+}
 }  // namespace
 
 void SelectKernelInfo(const CNodePtr &kernel_node) {
   std::vector<std::shared_ptr<kernel::KernelBuildInfo>> kernel_info_list;
   MS_EXCEPTION_IF_NULL(kernel_node);
+  auto decision_key = SelectDecisionKey(kernel_node);
+  if (UseSelectDecision(decision_key, kernel_node)) {
+    return;
+  }
   kernel::KernelQuery(kernel_node, &kernel_info_list);
   std::vector<int> most_match_counts = {-1, -1, -1, -1, -1};
   int selected_index = -1;
@@ -553,6 +635,7 @@ void SelectKernelInfo(const CNodePtr &kernel_node) {
   }
   std::shared_ptr<kernel::KernelBuildInfo> selected_kernel_info_ptr = kernel_info_list[index];
   MS_EXCEPTION_IF_NULL(selected_kernel_info_ptr);
+  SaveSelectDecision(decision_key, selected_kernel_info_ptr, precision_reduce, node_mix_precision_datatype);
   SelectKernel(kernel_node, precision_reduce, node_mix_precision_datatype, selected_kernel_info_ptr);
 }
 
@@ -32,6 +32,9 @@ class CPUKernelFactory {
   static CPUKernelFactory &Get();
   void Register(const std::string &kernel_name, CPUKernelCreator &&kernel_creator);
   std::shared_ptr<CPUKernel> Create(const std::string &kernel_name);
+  bool IsRegistered(const std::string &kernel_name) const {
+    return kernel_creators_.find(kernel_name) != kernel_creators_.end();
+  }
 
  private:
   CPUKernelFactory() = default;
@@ -25,6 +25,7 @@
 #include "device/cpu/cpu_device_address.h"
 #include "utils/context/ms_context.h"
 #include "utils/config_manager.h"
+#include "utils/timeline.h"
 #include "common/utils.h"
 #include "session/anf_runtime_algorithm.h"
 #include "operator/ops.h"
@@ -39,6 +40,9 @@ void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   AssignKernelOutputAddress(kernel_graph);
   resource_manager_.MemPlan(kernel_graph);
   resource_manager_.MemMalloc(kernel_graph);
+  resource_manager_.GenAddressRefPlan(kernel_graph);
+  GenLaunchPlan(kernel_graph);
+  ScheduleParallelLaunch(kernel_graph);
 }
 
 void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph) {
@@ -222,49 +226,108 @@ void CPUKernelRuntime::BindInputOutput(const session::KernelGraph *kernel_graph,
   }
 }
 
-void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list) {
+void CPUKernelRuntime::GenLaunchPlan(const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto &launch_plan = launch_plans_[kernel_graph];
+  launch_plan.clear();
+  auto add_address = [](DeviceAddress *device_address, std::vector<DeviceAddress *> *addrs, AddressPtrList *args) {
+    MS_EXCEPTION_IF_NULL(device_address);
+    addrs->push_back(device_address);
+    args->push_back(std::make_shared<kernel::Address>());
+  };
+  for (const auto &kernel : kernel_graph->execution_order()) {
+    KernelLaunchInfo launch_info;
+    launch_info.kernel = kernel;
+    launch_info.kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(launch_info.kernel_mod);
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      add_address(AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get(), &launch_info.input_addrs,
+                  &launch_info.inputs);
+    }
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      add_address(AnfAlgo::GetMutableOutputAddr(kernel, i).get(), &launch_info.output_addrs, &launch_info.outputs);
+    }
+    for (size_t i = 0; i < launch_info.kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      add_address(AnfAlgo::GetWorkspaceAddr(kernel, i), &launch_info.workspace_addrs, &launch_info.workspaces);
+    }
+    launch_plan.push_back(std::move(launch_info));
+  }
+}
+
+void CPUKernelRuntime::UpdateRuntimeAddress(DeviceAddress *address, const kernel::AddressPtr &runtime_address) {
   MS_EXCEPTION_IF_NULL(address);
-  kernel::AddressPtr input = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(input);
+  MS_EXCEPTION_IF_NULL(runtime_address);
   if (address->ptr_ == nullptr) {
     address->ptr_ = resource_manager_.MemMalloc(address->size_);
   }
   MS_EXCEPTION_IF_NULL(address->ptr_);
-  input->addr = address->ptr_;
-  input->size = address->size_;
-  input_list->push_back(input);
+  runtime_address->addr = address->ptr_;
+  runtime_address->size = address->size_;
+}
+
+void CPUKernelRuntime::ScheduleParallelLaunch(const session::KernelGraph *kernel_graph) {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  size_t thread_num = context_ptr->cpu_inter_op_threads();
+  if (thread_num <= 1) {
+    return;
+  }
+  if (parallel_executor_ == nullptr || parallel_executor_->thread_num() != thread_num) {
+    parallel_executor_.reset(new CPUParallelExecutor(thread_num));
+  }
+  parallel_executor_->Schedule(kernel_graph, launch_plans_[kernel_graph]);
+}
+
+bool CPUKernelRuntime::LaunchKernel(KernelLaunchInfo *launch_info, size_t kernel_index) {
+  MS_EXCEPTION_IF_NULL(launch_info);
+  for (size_t i = 0; i < launch_info->input_addrs.size(); ++i) {
+    UpdateRuntimeAddress(launch_info->input_addrs[i], launch_info->inputs[i]);
+  }
+  for (size_t i = 0; i < launch_info->output_addrs.size(); ++i) {
+    UpdateRuntimeAddress(launch_info->output_addrs[i], launch_info->outputs[i]);
+  }
+  for (size_t i = 0; i < launch_info->workspace_addrs.size(); ++i) {
+    UpdateRuntimeAddress(launch_info->workspace_addrs[i], launch_info->workspaces[i]);
+  }
+  auto &timeline = Timeline::GetInstance();
+  auto &step_stats = StepStats::GetInstance();
+  uint64_t start_us = timeline.started() || step_stats.started() ? Timeline::NowUs() : 0;
+  auto ret = launch_info->kernel_mod->Launch(launch_info->inputs, launch_info->workspaces, launch_info->outputs, 0);
+  if (start_us != 0) {
+    auto end_us = Timeline::NowUs();
+    if (timeline.started()) {
+      timeline.Record(launch_info->kernel->fullname_with_scope(), "cpu_kernel", start_us, end_us);
+    }
+    if (step_stats.started()) {
+      step_stats.Add(KernelStepPhase(launch_info->kernel), end_us - start_us);
+    }
+  }
+  resource_manager_.DecreaseAddressRefCount(kernel_index);
+  return ret;
 }
 
 bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   resource_manager_.ResetAddressRefCount(kernel_graph);
-  auto kernels = kernel_graph->execution_order();
-  for (const auto &kernel : kernels) {
-    std::vector<kernel::AddressPtr> kernel_inputs;
-    std::vector<kernel::AddressPtr> kernel_workspaces;
-    std::vector<kernel::AddressPtr> kernel_outputs;
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_inputs);
-    }
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_outputs);
-    }
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_workspaces);
-    }
-    auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
-    resource_manager_.DecreaseAddressRefCount(kernel);
-    if (!ret) {
+  // the inputs and the outputs of the graph are bound to the tensors of each run, so only the device addresses are
+  // resolved by the plan and their pointers are read here
+  auto iter = launch_plans_.find(kernel_graph);
+  if (iter == launch_plans_.end()) {
+    GenLaunchPlan(kernel_graph);
+    iter = launch_plans_.find(kernel_graph);
+  }
+  auto &launch_plan = iter->second;
+  // the memory malloced by the kernels is not shared by the threads, they run in the order then
+  if (parallel_executor_ != nullptr && parallel_executor_->IsScheduled(kernel_graph) &&
+      !resource_manager_.dynamic_malloc()) {
+    parallel_executor_->Run(kernel_graph,
+                            [this, &launch_plan](size_t index) { return LaunchKernel(&launch_plan[index], index); });
+    return true;
+  }
+  for (size_t i = 0; i < launch_plan.size(); ++i) {
+    if (!LaunchKernel(&launch_plan[i], i)) {
       MS_LOG(EXCEPTION) << "Launch kernel failed.";
     }
   }
@@ -23,6 +23,7 @@
 #include "device/kernel_runtime.h"
 #include "session/kernel_graph.h"
 #include "device/cpu/cpu_resource_manager.h"
+#include "device/cpu/cpu_parallel_executor.h"
 #include "utils/any.h"
 namespace mindspore {
 namespace device {
@@ -49,8 +50,12 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignValueNodeAddress(session::KernelGraph *kernel_graph);
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
-  void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  void GenLaunchPlan(const session::KernelGraph *kernel_graph);
+  void UpdateRuntimeAddress(DeviceAddress *address, const kernel::AddressPtr &runtime_address);
+  void ScheduleParallelLaunch(const session::KernelGraph *kernel_graph);
+  bool LaunchKernel(KernelLaunchInfo *launch_info, size_t kernel_index);
   CPUResourceManager resource_manager_;
+  std::unique_ptr<CPUParallelExecutor> parallel_executor_{nullptr};
 };
 }  // namespace cpu
 }  // namespace device
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/cpu_parallel_executor.h"
+#include <exception>
+#include <set>
+#include <utility>
+#include "session/anf_runtime_algorithm.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+CPUParallelExecutor::CPUParallelExecutor(size_t thread_num) {
+  for (size_t i = 1; i < thread_num; ++i) {
+    workers_.emplace_back(&CPUParallelExecutor::WorkerLoop, this);
+  }
+}
+
+CPUParallelExecutor::~CPUParallelExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void CPUParallelExecutor::Schedule(const session::KernelGraph *graph, const KernelLaunchPlan &launch_plan) {
+  MS_EXCEPTION_IF_NULL(graph);
+  std::set<const DeviceAddress *> weights;
+  for (auto &input : graph->inputs()) {
+    MS_EXCEPTION_IF_NULL(input);
+    if (input->isa<Parameter>() && AnfAlgo::IsParameterWeight(input->cast<ParameterPtr>())) {
+      weights.insert(AnfAlgo::GetOutputAddr(input, 0));
+    }
+  }
+  size_t kernel_num = launch_plan.size();
+  std::vector<std::set<size_t>> predecessors(kernel_num);
+  // the last kernel writing each address and the ones reading it since then
+  std::unordered_map<const DeviceAddress *, size_t> writers;
+  std::unordered_map<const DeviceAddress *, std::vector<size_t>> readers;
+  auto read = [&](const DeviceAddress *address, size_t index) {
+    auto iter = writers.find(address);
+    if (iter != writers.end()) {
+      (void)predecessors[index].insert(iter->second);
+    }
+    readers[address].push_back(index);
+  };
+  auto write = [&](const DeviceAddress *address, size_t index) {
+    auto iter = writers.find(address);
+    if (iter != writers.end()) {
+      (void)predecessors[index].insert(iter->second);
+    }
+    for (auto reader : readers[address]) {
+      (void)predecessors[index].insert(reader);
+    }
+    readers[address].clear();
+    writers[address] = index;
+  };
+  for (size_t i = 0; i < kernel_num; ++i) {
+    auto &launch_info = launch_plan[i];
+    for (auto address : launch_info.input_addrs) {
+      if (weights.count(address) > 0) {
+        write(address, i);
+      } else {
+        read(address, i);
+      }
+    }
+    for (auto address : launch_info.workspace_addrs) {
+      write(address, i);
+    }
+    for (auto address : launch_info.output_addrs) {
+      write(address, i);
+    }
+  }
+
+  auto &dependency = dependencies_[graph];
+  dependency.successors.assign(kernel_num, {});
+  dependency.dependency_nums.assign(kernel_num, 0);
+  dependency.roots.clear();
+  for (size_t i = 0; i < kernel_num; ++i) {
+    predecessors[i].erase(i);
+    for (auto predecessor : predecessors[i]) {
+      dependency.successors[predecessor].push_back(i);
+    }
+    dependency.dependency_nums[i] = predecessors[i].size();
+    if (predecessors[i].empty()) {
+      dependency.roots.push_back(i);
+    }
+  }
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " has " << kernel_num << " kernels and "
+               << dependency.roots.size() << " of them don't depend on the others";
+}
+
+void CPUParallelExecutor::Run(const session::KernelGraph *graph, const std::function<bool(size_t)> &launch) {
+  auto iter = dependencies_.find(graph);
+  if (iter == dependencies_.end()) {
+    MS_LOG(EXCEPTION) << "The kernels of the graph are not scheduled.";
+  }
+  if (iter->second.successors.empty()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  launch_ = &launch;
+  dependency_ = &iter->second;
+  pending_nums_ = dependency_->dependency_nums;
+  ready_.assign(dependency_->roots.begin(), dependency_->roots.end());
+  kernel_num_ = dependency_->successors.size();
+  finished_ = 0;
+  running_ = 0;
+  failed_ = false;
+  error_.clear();
+  cond_.notify_all();
+  while (!RunDone()) {
+    if (!ready_.empty()) {
+      LaunchReadyKernel(&lock);
+    } else {
+      cond_.wait(lock);
+    }
+  }
+  launch_ = nullptr;
+  dependency_ = nullptr;
+  if (failed_) {
+    MS_LOG(EXCEPTION) << error_;
+  }
+}
+
+void CPUParallelExecutor::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cond_.wait(lock, [this]() { return stop_ || !ready_.empty(); });
+    if (stop_) {
+      return;
+    }
+    LaunchReadyKernel(&lock);
+  }
+}
+
+void CPUParallelExecutor::LaunchReadyKernel(std::unique_lock<std::mutex> *lock) {
+  size_t index = ready_.front();
+  ready_.pop_front();
+  ++running_;
+  lock->unlock();
+  bool ret = false;
+  std::string error = "Launch kernel failed.";
+  try {
+    ret = (*launch_)(index);
+  } catch (const std::exception &e) {
+    error = e.what();
+  }
+  lock->lock();
+  --running_;
+  if (!ret) {
+    if (!failed_) {
+      failed_ = true;
+      error_ = error;
+    }
+    ready_.clear();
+  } else if (!failed_) {
+    ++finished_;
+    for (auto successor : dependency_->successors[index]) {
+      if (--pending_nums_[successor] == 0) {
+        ready_.push_back(successor);
+      }
+    }
+  }
+  if (!ready_.empty() || RunDone()) {
+    cond_.notify_all();
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_PARALLEL_EXECUTOR_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_CPU_PARALLEL_EXECUTOR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "device/kernel_runtime.h"
+#include "session/kernel_graph.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+struct KernelDependency {
+  // the kernels depending on each kernel
+  std::vector<std::vector<size_t>> successors;
+  std::vector<size_t> dependency_nums;
+  std::vector<size_t> roots;
+};
+
+// Run the kernels of the launch plans by their dependencies on a pool of threads, a kernel is launched once the ones
+// it depends on are done. The calling thread runs the kernels too, so there are thread_num - 1 threads in the pool.
+class CPUParallelExecutor {
+ public:
+  explicit CPUParallelExecutor(size_t thread_num);
+  ~CPUParallelExecutor();
+  size_t thread_num() const { return workers_.size() + 1; }
+  bool IsScheduled(const session::KernelGraph *graph) const { return dependencies_.count(graph) > 0; }
+  // Build the dependencies of the kernels of the plan by the device addresses they read and write, the weights
+  // are taken as written by the kernels using them as the optimizers update them in place.
+  void Schedule(const session::KernelGraph *graph, const KernelLaunchPlan &launch_plan);
+  // Launch the kernels of the graph by their index in the plan, the first failure is raised after the launched
+  // kernels are done and the ones not launched yet are dropped.
+  void Run(const session::KernelGraph *graph, const std::function<bool(size_t)> &launch);
+
+ private:
+  void WorkerLoop();
+  void LaunchReadyKernel(std::unique_lock<std::mutex> *lock);
+  bool RunDone() const { return finished_ == kernel_num_ || (failed_ && running_ == 0); }
+
+  std::unordered_map<const session::KernelGraph *, KernelDependency> dependencies_;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool stop_{false};
+  // the state of the running graph, guarded by the mutex
+  const std::function<bool(size_t)> *launch_{nullptr};
+  const KernelDependency *dependency_{nullptr};
+  std::vector<size_t> pending_nums_;
+  std::deque<size_t> ready_;
+  size_t kernel_num_{0};
+  size_t finished_{0};
+  size_t running_{0};
+  bool failed_{false};
+  std::string error_;
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_CPU_PARALLEL_EXECUTOR_H_
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "device/cpu/cpu_resource_manager.h"
+#include <utility>
 #include "session/anf_runtime_algorithm.h"
+#include "operator/ops.h"
 
 namespace mindspore {
 namespace device {
@@ -32,9 +34,15 @@ void CPUResourceManager::MemFree() {
     free(iter.first);
   }
   dynamic_mem_.clear();
+  for (auto &&iter : free_mem_) {
+    for (auto ptr : iter.second) {
+      free(ptr);
+    }
+  }
+  free_mem_.clear();
 }
 
-void CPUResourceManager::MemPlan(const session::KernelGraph *graph) {
+void CPUResourceManager::MemPlan(session::KernelGraph *graph) {
   mem_plan_.MemPlan(graph);
   size_t graph_mem_size = mem_plan_.GetGraphMemSize(graph);
   if (graph_mem_size > mem_size_) {
@@ -58,6 +66,13 @@ void CPUResourceManager::MemMalloc(const session::KernelGraph *graph) {
 }
 
 void *CPUResourceManager::MemMalloc(size_t mem_size) {
+  auto free_iter = free_mem_.find(mem_size);
+  if (free_iter != free_mem_.end() && !free_iter->second.empty()) {
+    void *ptr = free_iter->second.back();
+    free_iter->second.pop_back();
+    dynamic_mem_[ptr] = mem_size;
+    return ptr;
+  }
   void *ptr = malloc(mem_size);
   if (ptr != nullptr) {
     dynamic_mem_[ptr] = mem_size;
@@ -70,59 +85,110 @@ void *CPUResourceManager::MemMalloc(size_t mem_size) {
 void CPUResourceManager::MemFree(void *ptr) {
   auto iter = dynamic_mem_.find(ptr);
   if (iter != dynamic_mem_.end()) {
+    free_mem_[iter->second].push_back(ptr);
     (void)dynamic_mem_.erase(iter);
-    free(ptr);
   }
 }
 
-void CPUResourceManager::ResetAddressRefCount(const session::KernelGraph *graph) {
-  if (!dynamic_malloc_) {
+void CPUResourceManager::CollectGraphOutputAddrs(const AnfNodePtr &node, size_t index,
+                                                 std::unordered_set<DeviceAddress *> *addrs) {
+  auto item_with_index = AnfAlgo::VisitKernelWithReturnType(node, index);
+  auto item = item_with_index.first;
+  MS_EXCEPTION_IF_NULL(item);
+  if (!item->isa<CNode>()) {
     return;
   }
+  if (AnfAlgo::CheckPrimitiveType(item, prim::kPrimMakeTuple)) {
+    auto make_tuple = item->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(make_tuple);
+    for (size_t i = 1; i < make_tuple->inputs().size(); ++i) {
+      CollectGraphOutputAddrs(make_tuple->input(i), 0, addrs);
+    }
+    return;
+  }
+  if (AnfAlgo::OutputAddrExist(item, item_with_index.second)) {
+    (void)addrs->insert(AnfAlgo::GetMutableOutputAddr(item, item_with_index.second).get());
+  }
+}
+
+void CPUResourceManager::GenAddressRefPlan(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  // the outputs of the graph are bound to the output tensors, the parameters and the value nodes to the inputs, they
+  // are never freed by the kernels
+  std::unordered_set<DeviceAddress *> graph_output_addrs;
+  for (const auto &output : graph->outputs()) {
+    CollectGraphOutputAddrs(output, 0, &graph_output_addrs);
+  }
+
+  auto &plan = ref_plans_[graph];
+  plan = AddressRefPlan();
+  std::unordered_map<DeviceAddress *, size_t> address_ids;
+  auto add_address = [&plan, &address_ids](DeviceAddress *address, std::vector<size_t> *ids) {
+    MS_EXCEPTION_IF_NULL(address);
+    auto iter = address_ids.find(address);
+    if (iter == address_ids.end()) {
+      iter = address_ids.emplace(address, plan.addresses.size()).first;
+      plan.addresses.push_back(address);
+      plan.init_counts.push_back(0);
+    }
+    plan.init_counts[iter->second]++;
+    ids->push_back(iter->second);
+  };
+  for (const auto &kernel : graph->execution_order()) {
     MS_EXCEPTION_IF_NULL(kernel);
+    std::vector<size_t> ids;
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
-      auto address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      address->ref_count_++;
+      auto prev_node = AnfAlgo::GetPrevNodeOutput(kernel, i).first;
+      MS_EXCEPTION_IF_NULL(prev_node);
+      if (!prev_node->isa<CNode>()) {
+        continue;
+      }
+      auto address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
+      if (graph_output_addrs.find(address) == graph_output_addrs.end()) {
+        add_address(address, &ids);
+      }
     }
 
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
     for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      address->ref_count_++;
+      add_address(AnfAlgo::GetWorkspaceAddr(kernel, i), &ids);
     }
+    plan.kernel_address_ids.push_back(std::move(ids));
   }
+  plan.counts = plan.init_counts;
 }
 
-void CPUResourceManager::DecreaseAddressRefCount(const AnfNodePtr &kernel) {
+void CPUResourceManager::ResetAddressRefCount(const session::KernelGraph *graph) {
+  running_plan_ = nullptr;
   if (!dynamic_malloc_) {
     return;
   }
-  MS_EXCEPTION_IF_NULL(kernel);
-  size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-  for (size_t i = 0; i < input_num; ++i) {
-    auto address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i);
-    MS_EXCEPTION_IF_NULL(address);
-    address->ref_count_--;
-    if (address->ref_count_ == 0 && address->ptr_ != nullptr) {
-      MemFree(address->ptr_);
-      address->ptr_ = nullptr;
-    }
+  MS_EXCEPTION_IF_NULL(graph);
+  auto iter = ref_plans_.find(graph);
+  if (iter == ref_plans_.end()) {
+    GenAddressRefPlan(graph);
+    iter = ref_plans_.find(graph);
   }
+  running_plan_ = &iter->second;
+  running_plan_->counts.assign(running_plan_->init_counts.begin(), running_plan_->init_counts.end());
+}
 
-  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-  MS_EXCEPTION_IF_NULL(kernel_mod);
-  for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-    auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-    MS_EXCEPTION_IF_NULL(address);
-    address->ref_count_--;
-    if (address->ref_count_ == 0 && address->ptr_ != nullptr) {
+void CPUResourceManager::DecreaseAddressRefCount(size_t kernel_index) {
+  if (running_plan_ == nullptr) {
+    return;
+  }
+  if (kernel_index >= running_plan_->kernel_address_ids.size()) {
+    MS_LOG(EXCEPTION) << "The kernel index " << kernel_index << " is out of the ref plan of "
+                      << running_plan_->kernel_address_ids.size() << " kernels";
+  }
+  for (auto id : running_plan_->kernel_address_ids[kernel_index]) {
+    if (--running_plan_->counts[id] != 0) {
+      continue;
+    }
+    auto address = running_plan_->addresses[id];
+    if (address->ptr_ != nullptr) {
       MemFree(address->ptr_);
       address->ptr_ = nullptr;
     }
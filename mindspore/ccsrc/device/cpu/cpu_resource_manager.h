@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include "session/kernel_graph.h"
 #include "device/device_address.h"
 #include "device/cpu/cpu_simple_mem_plan.h"
@@ -29,21 +30,38 @@ class CPUResourceManager {
   CPUResourceManager() = default;
   ~CPUResourceManager();
 
-  void MemPlan(const session::KernelGraph *graph);
+  void MemPlan(session::KernelGraph *graph);
   void MemMalloc(const session::KernelGraph *graph);
+  void GenAddressRefPlan(const session::KernelGraph *graph);
   void ResetAddressRefCount(const session::KernelGraph *graph);
-  void DecreaseAddressRefCount(const AnfNodePtr &kernel);
+  // kernel_index is the index of the kernel in the execution order of the graph reset last
+  void DecreaseAddressRefCount(size_t kernel_index);
   void *MemMalloc(size_t mem_size);
   void MemFree(void *ptr);
+  bool dynamic_malloc() const { return dynamic_malloc_; }
 
  private:
+  // The addresses freed by the kernels consuming them under the dynamic malloc, each one gets an id in the graph. The
+  // counts of a step are copied from init_counts, so nothing is looked up by the nodes at runtime.
+  struct AddressRefPlan {
+    std::vector<DeviceAddress *> addresses;
+    std::vector<int32_t> init_counts;
+    std::vector<int32_t> counts;
+    // the ids of the inputs and the workspaces of each kernel, by the execution order
+    std::vector<std::vector<size_t>> kernel_address_ids;
+  };
   void MemFree();
+  void CollectGraphOutputAddrs(const AnfNodePtr &node, size_t index, std::unordered_set<DeviceAddress *> *addrs);
   CPUSimpleMemPlan mem_plan_;
 
   size_t mem_size_{0};
   uint8_t *mem_ptr_{nullptr};
   bool dynamic_malloc_{false};
   std::unordered_map<void *, size_t> dynamic_mem_;
+  // the freed dynamic memory by its size, it's reused by the next malloc of the same size
+  std::unordered_map<size_t, std::vector<void *>> free_mem_;
+  std::unordered_map<const session::KernelGraph *, AddressRefPlan> ref_plans_;
+  AddressRefPlan *running_plan_{nullptr};
 };
 }  // namespace cpu
 }  // namespace device
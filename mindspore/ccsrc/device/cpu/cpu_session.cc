@@ -16,6 +16,7 @@
 
 #include "device/cpu/cpu_session.h"
 #include <algorithm>
+#include <set>
 #include "ir/meta_tensor.h"
 #include "ir/anf.h"
 #include "kernel/kernel.h"
@@ -24,9 +25,21 @@
 #include "device/kernel_runtime.h"
 #include "predict/predict.h"
 #include "device/cpu/cpu_kernel_factory.h"
+#include "device/cpu/kernel/mkldnn/mkl_cpu_kernel.h"
+#include "operator/ops.h"
+#include "utils/context/ms_context.h"
 
 namespace mindspore {
 namespace session {
+namespace {
+bool IsInt8Kernel(const CNodePtr &kernel_node) {
+  static const std::set<std::string> int8_kernels = {prim::kPrimConv2D->name(), prim::kPrimMatMul->name()};
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  return context->cpu_int8_calibration_steps() > 0 && int8_kernels.count(AnfAlgo::GetCNodeName(kernel_node)) > 0;
+}
+}  // namespace
+
 GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs) {
   auto graph_id = graph_sum_;
   auto graph = ConstructKernelGraph(lst, outputs);
@@ -34,6 +47,7 @@ GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
   MS_LOG(INFO) << "set kernel info";
   SetKernelInfo(graph.get());
   predictmodel::StepConvertGraph(graph);
+  device::cpu::MarkMKLLayoutOutputs(graph.get());
   MS_LOG(INFO) << "build kernel";
   BuildKernel(graph.get());
   MS_LOG(INFO) << "assign kernel address";
@@ -41,6 +55,10 @@ GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
   return graph_id;
 }
 
+bool CPUSession::HasKernel(const CNodePtr &node) const {
+  return device::cpu::CPUKernelFactory::Get().IsRegistered(AnfAlgo::GetCNodeName(node));
+}
+
 void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) {
   auto &kernel_graph = graphs_[graph_id];
   MS_EXCEPTION_IF_NULL(kernel_graph);
@@ -100,6 +118,8 @@ void CPUSession::SetKernelInfo(const KernelGraph *kernel_graph) {
     builder->SetOutputsFormat(output_formats);
     builder->SetOutputsDeviceType(output_types);
     AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), kernel_node.get());
+    // the inputs and outputs stay in float, the int8 kernels quantize and dequantize them inside
+    AnfAlgo::SetNodeAttr(device::cpu::INT8_KERNEL, MakeValue(IsInt8Kernel(kernel_node)), kernel_node);
   }
 }
 
@@ -109,6 +129,9 @@ void CPUSession::BuildKernel(const KernelGraph *kernel_graph) {
   for (const auto &kernel_node : kernel_nodes) {
     MS_EXCEPTION_IF_NULL(kernel_node);
     std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+    if (AnfAlgo::GetNodeAttr<bool>(kernel_node, device::cpu::INT8_KERNEL)) {
+      kernel_name += device::cpu::INT8_KERNEL_SUFFIX;
+    }
     MS_LOG(INFO) << "Cpu building operator[" << kernel_name << "].";
     std::shared_ptr<device::cpu::CPUKernel> cpu_kernel = device::cpu::CPUKernelFactory::Get().Create(kernel_name);
     if (cpu_kernel == nullptr) {
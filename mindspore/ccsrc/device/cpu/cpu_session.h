@@ -34,6 +34,7 @@ class CPUSession : public SessionBasic {
   }
   GraphId CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs) override;
   void RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) override;
+  bool HasKernel(const CNodePtr &node) const override;
 
  private:
   void SetKernelInfo(const KernelGraph *kernel_graph);
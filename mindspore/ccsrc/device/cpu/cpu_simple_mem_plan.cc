@@ -14,12 +14,59 @@
  * limitations under the License.
  */
 #include "device/cpu/cpu_simple_mem_plan.h"
+#include <memory>
 #include "session/anf_runtime_algorithm.h"
+#include "pre_activate/mem_reuse/mem_reuse_allocator.h"
+#include "pre_activate/mem_reuse/mem_reuse_planner.h"
+#include "pre_activate/mem_reuse/mem_reuse_scheduler.h"
+#include "utils/context/ms_context.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
+void CPUSimpleMemPlan::MemPlan(session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  (void)graph_mem_reuse_.erase(graph);
+  // the reuse follows the execution order, the kernels run out of it by the inter op threads
+  if (context_ptr->enable_mem_reuse() && context_ptr->cpu_inter_op_threads() <= 1) {
+    graph_mem_size_[graph] = ReuseMemPlan(graph);
+  } else {
+    graph_mem_size_[graph] = SimpleMemPlan(graph);
+  }
+}
+
+size_t CPUSimpleMemPlan::ReuseMemPlan(session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  // reorder the kernels for a lower peak before the lifetimes are taken from the execution order
+  memreuse::MemReuseScheduler mem_reuse_scheduler;
+  mem_reuse_scheduler.Schedule(graph);
+  auto mem_reuse_util_ptr = std::make_shared<memreuse::MemReuseUtil>();
+  if (!mem_reuse_util_ptr->InitDynamicKernelRef(graph)) {
+    MS_LOG(EXCEPTION) << "Init kernel reference count failed";
+  }
+  mem_reuse_util_ptr->SetKernelDefMap();
+  mem_reuse_util_ptr->SetReuseRefCount();
+  mem_reuse_util_ptr->SetWorkSpaceList();
+  mem_reuse_util_ptr->SetGraphOutputRefCount();
+  // plan before the best fit reuse, which consumes the refcounts
+  memreuse::StaticMemPlanner static_mem_planner;
+  static_mem_planner.Plan(mem_reuse_util_ptr.get());
+  memreuse::BestFitMemReuse bestfit_mem_reuse;
+  bestfit_mem_reuse.Reuse(mem_reuse_util_ptr.get());
+  size_t total_mem_size = bestfit_mem_reuse.GetAllocatedSize();
+  if (static_mem_planner.planned_size() < total_mem_size) {
+    static_mem_planner.Apply();
+    total_mem_size = static_mem_planner.planned_size();
+  }
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " reuse memory size [" << total_mem_size << "], no reuse size ["
+               << SimpleMemPlan(graph) << "], lower bound [" << static_mem_planner.lower_bound() << "]";
+  graph_mem_reuse_[graph] = mem_reuse_util_ptr;
+  return total_mem_size;
+}
+
+size_t CPUSimpleMemPlan::SimpleMemPlan(const session::KernelGraph *graph) const {
   MS_EXCEPTION_IF_NULL(graph);
   size_t total_mem_size = 0;
   auto kernels = graph->execution_order();
@@ -53,14 +100,51 @@ void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
       }
     }
   }
-  graph_mem_size_[graph] = total_mem_size;
+  return total_mem_size;
 }
 
 size_t CPUSimpleMemPlan::GetGraphMemSize(const session::KernelGraph *graph) { return graph_mem_size_[graph]; }
 
+void CPUSimpleMemPlan::ReuseMemAssign(const session::KernelGraph *graph, const memreuse::MemReuseUtil &mem_reuse_util,
+                                      uint8_t *base_ptr) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto assign = [base_ptr](const memreuse::KernelRefs &refs, const CNodePtr &kernel, size_t index,
+                           DeviceAddress *address) {
+    MS_EXCEPTION_IF_NULL(address);
+    if (address->ptr_ != nullptr) {
+      return;
+    }
+    auto iter = refs.find(kernel.get());
+    if (iter == refs.end() || index >= iter->second.size()) {
+      MS_LOG(EXCEPTION) << "The memory of the kernel [" << kernel->fullname_with_scope() << "] index [" << index
+                        << "] isn't planned";
+    }
+    address->ptr_ = base_ptr + iter->second[index]->offset_;
+  };
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      assign(mem_reuse_util.kernel_output_refs_, kernel, i, AnfAlgo::GetMutableOutputAddr(kernel, i).get());
+    }
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      assign(mem_reuse_util.kernel_workspace_refs_, kernel, i, AnfAlgo::GetWorkspaceAddr(kernel, i));
+    }
+  }
+}
+
 void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(base_ptr);
+  auto reuse_iter = graph_mem_reuse_.find(graph);
+  if (reuse_iter != graph_mem_reuse_.end()) {
+    MS_EXCEPTION_IF_NULL(reuse_iter->second);
+    ReuseMemAssign(graph, *reuse_iter->second, base_ptr);
+    (void)graph_mem_reuse_.erase(reuse_iter);
+    return;
+  }
   uint8_t *mem_ptr = base_ptr;
   auto kernels = graph->execution_order();
   for (const auto &kernel : kernels) {
@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include "session/kernel_graph.h"
 #include "device/device_address.h"
+#include "pre_activate/mem_reuse/mem_reuse.h"
 
 namespace mindspore {
 namespace device {
@@ -29,12 +30,20 @@ class CPUSimpleMemPlan {
   CPUSimpleMemPlan() = default;
   ~CPUSimpleMemPlan() = default;
 
-  void MemPlan(const session::KernelGraph *graph);
+  void MemPlan(session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
   size_t GetGraphMemSize(const session::KernelGraph *graph);
 
  private:
+  // Plan the offsets of the kernel outputs and workspaces by their lifetimes, the parameters are left to be bound
+  // to the input tensors
+  size_t ReuseMemPlan(session::KernelGraph *graph);
+  size_t SimpleMemPlan(const session::KernelGraph *graph) const;
+  void ReuseMemAssign(const session::KernelGraph *graph, const memreuse::MemReuseUtil &mem_reuse_util,
+                      uint8_t *base_ptr) const;
   std::unordered_map<const session::KernelGraph *, size_t> graph_mem_size_;
+  // the plans waiting for MemAssign, only the offsets in them are used
+  std::unordered_map<const session::KernelGraph *, memreuse::MemReuseUtilPtr> graph_mem_reuse_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/cpu_thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include "utils/context/ms_context.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+struct LoopState {
+  std::atomic<size_t> next_block{0};
+  size_t done_blocks{0};
+  std::mutex mutex;
+  std::condition_variable cond;
+};
+}  // namespace
+
+CPUThreadPool::CPUThreadPool() {
+  size_t core_num = std::thread::hardware_concurrency();
+  for (size_t i = 1; i < core_num; ++i) {
+    workers_.emplace_back(&CPUThreadPool::WorkerLoop, this);
+  }
+  MS_LOG(INFO) << "The cpu kernels run by " << thread_num() << " threads";
+}
+
+CPUThreadPool::~CPUThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void CPUThreadPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (stop_) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+void CPUThreadPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &task) {
+  if (count == 0) {
+    return;
+  }
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  size_t inter_op_threads = std::max(context_ptr->cpu_inter_op_threads(), 1U);
+  size_t max_block_num = std::max(thread_num() / inter_op_threads, static_cast<size_t>(1));
+  grain = std::max(grain, static_cast<size_t>(1));
+  size_t block_num = std::min((count + grain - 1) / grain, max_block_num);
+  if (block_num <= 1) {
+    task(0, count);
+    return;
+  }
+  size_t block_size = (count + block_num - 1) / block_num;
+  block_num = (count + block_size - 1) / block_size;
+  // The helpers starting after all the blocks are taken return without touching the task, so it's safe to refer to
+  // the task of the caller which returns once the taken blocks are done.
+  auto state = std::make_shared<LoopState>();
+  auto run_blocks = [state, &task, count, block_num, block_size]() {
+    size_t done = 0;
+    for (size_t block = state->next_block++; block < block_num; block = state->next_block++) {
+      size_t start = block * block_size;
+      task(start, std::min(start + block_size, count));
+      ++done;
+    }
+    if (done > 0) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->done_blocks += done;
+      if (state->done_blocks == block_num) {
+        state->cond.notify_all();
+      }
+    }
+  };
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 1; i < block_num; ++i) {
+      tasks_.emplace_back(run_blocks);
+    }
+  }
+  cond_.notify_all();
+  run_blocks();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cond.wait(lock, [&state, block_num]() { return state->done_blocks == block_num; });
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_CPU_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The number of elements below which a loop of the light kernels is not split
+constexpr size_t kParallelGrain = 16384;
+
+// the rows of row_size elements taken by a block at least
+inline size_t RowGrain(size_t row_size) {
+  return row_size == 0 ? kParallelGrain : (kParallelGrain + row_size - 1) / row_size;
+}
+
+// The threads shared by the parallel loops of the cpu kernels, a thread for each core. The calling thread runs the
+// blocks of its loop too, so the loops of the kernels launched by the inter op threads at the same time don't wait for
+// each other.
+class CPUThreadPool {
+ public:
+  static CPUThreadPool &GetInstance() {
+    static CPUThreadPool instance;
+    return instance;
+  }
+  // Run task(start, end) over [0, count) by the blocks of grain elements at least, and return when all of them are
+  // done. The cores are split among the inter op threads. The task mustn't throw.
+  void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &task);
+  size_t thread_num() const { return workers_.size() + 1; }
+
+ private:
+  CPUThreadPool();
+  ~CPUThreadPool();
+  CPUThreadPool(const CPUThreadPool &) = delete;
+  CPUThreadPool &operator=(const CPUThreadPool &) = delete;
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<std::function<void()>> tasks_;
+  bool stop_{false};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_CPU_THREAD_POOL_H_
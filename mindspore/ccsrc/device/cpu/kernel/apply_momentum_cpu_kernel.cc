@@ -16,6 +16,8 @@
 #include "device/cpu/kernel/apply_momentum_cpu_kernel.h"
 #include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
 #include "device/cpu/cpu_device_address.h"
+#include "device/cpu/kernel/cpu_simd_utils.h"
+#include "device/cpu/cpu_thread_pool.h"
 #include "common/utils.h"
 
 namespace mindspore {
@@ -38,10 +40,9 @@ bool ApplyMomentumCPUKernel::Launch(const std::vector<kernel::AddressPtr> &input
   auto gradient = reinterpret_cast<float *>(inputs[3]->addr);
   float moment = reinterpret_cast<float *>(inputs[4]->addr)[0];
   size_t elem_num = inputs[0]->size / sizeof(float);
-  for (size_t i = 0; i < elem_num; ++i) {
-    accumulate[i] = accumulate[i] * moment + gradient[i];
-    weight[i] -= accumulate[i] * learning_rate;
-  }
+  CPUThreadPool::GetInstance().ParallelFor(elem_num, kParallelGrain, [&](size_t start, size_t end) {
+    MomentumUpdate(weight + start, accumulate + start, gradient + start, learning_rate, moment, end - start);
+  });
   return true;
 }
 }  // namespace cpu
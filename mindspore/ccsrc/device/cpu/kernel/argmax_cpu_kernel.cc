@@ -15,6 +15,7 @@
  */
 #include "device/cpu/kernel/argmax_cpu_kernel.h"
 #include "device/cpu/cpu_device_address.h"
+#include "device/cpu/cpu_thread_pool.h"
 
 namespace mindspore {
 namespace device {
@@ -48,20 +49,21 @@ bool ArgmaxCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   }
   auto input = reinterpret_cast<float *>(inputs[0]->addr);
   auto output = reinterpret_cast<int *>(outputs[0]->addr);
-  size_t row_start = 0;
-  for (size_t i = 0; i < batch_size_; ++i) {
-    size_t max_index = 0;
-    float max_value = input[row_start];
-    for (size_t j = 1; j < class_num_; ++j) {
-      size_t index = row_start + j;
-      if (input[index] > max_value) {
-        max_value = input[index];
-        max_index = j;
+  size_t grain = RowGrain(class_num_);
+  CPUThreadPool::GetInstance().ParallelFor(batch_size_, grain, [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      const float *row = input + i * class_num_;
+      size_t max_index = 0;
+      float max_value = row[0];
+      for (size_t j = 1; j < class_num_; ++j) {
+        if (row[j] > max_value) {
+          max_value = row[j];
+          max_index = j;
+        }
       }
+      output[i] = SizeToInt(max_index);
     }
-    output[i] = SizeToInt(max_index);
-    row_start += class_num_;
-  }
+  });
   return true;
 }
 }  // namespace cpu
@@ -15,6 +15,8 @@
  */
 
 #include "device/cpu/kernel/bias_add_cpu_kernel.h"
+#include "device/cpu/kernel/cpu_simd_utils.h"
+#include "device/cpu/cpu_thread_pool.h"
 
 namespace mindspore {
 namespace device {
@@ -51,31 +53,24 @@ bool BiasAddCpuKernel::Launch(const std::vector<AddressPtr> &inputs, const std::
   auto bias_addr = reinterpret_cast<float *>(inputs[1]->addr);
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
 
+  size_t c_num = input_shape_[1];
   if (data_shape_ == 4) {
-    size_t h_size = input_shape_[3];
-    size_t c_size = input_shape_[2] * h_size;
-    size_t n_size = input_shape_[1] * c_size;
+    // the rows of hw elements of each n and c get the same bias
     size_t hw_size = input_shape_[2] * input_shape_[3];
-    size_t n_offset = 0;
-    for (size_t n = 0; n < input_shape_[0]; ++n) {
-      size_t c_offset = 0;
-      for (size_t c = 0; c < input_shape_[1]; ++c) {
-        for (size_t hw = 0; hw < hw_size; ++hw) {
-          size_t offset = n_offset + c_offset + hw;
-          output_addr[offset] = src_addr[offset] + bias_addr[c];
-        }
-        c_offset += c_size;
+    size_t grain = RowGrain(hw_size);
+    CPUThreadPool::GetInstance().ParallelFor(input_shape_[0] * c_num, grain, [&](size_t start, size_t end) {
+      for (size_t row = start; row < end; ++row) {
+        size_t offset = row * hw_size;
+        AddScalar(src_addr + offset, bias_addr[row % c_num], output_addr + offset, hw_size);
       }
-      n_offset += n_size;
-    }
+    });
   } else {
-    size_t n_offset = 0;
-    for (size_t n = 0; n < input_shape_[0]; ++n) {
-      for (size_t c = 0; c < input_shape_[1]; ++c) {
-        output_addr[n_offset + c] = src_addr[n_offset + c] + bias_addr[c];
+    size_t grain = RowGrain(c_num);
+    CPUThreadPool::GetInstance().ParallelFor(input_shape_[0], grain, [&](size_t start, size_t end) {
+      for (size_t n = start; n < end; ++n) {
+        AddVector(src_addr + n * c_num, bias_addr, output_addr + n * c_num, c_num);
       }
-      n_offset += input_shape_[1];
-    }
+    });
   }
   return true;
 }
@@ -15,6 +15,8 @@
  */
 
 #include "device/cpu/kernel/bias_add_grad_cpu_kernel.h"
+#include "device/cpu/kernel/cpu_simd_utils.h"
+#include "device/cpu/cpu_thread_pool.h"
 
 namespace mindspore {
 namespace device {
@@ -35,33 +37,32 @@ bool BiasAddGradCpuKernel::Launch(const std::vector<AddressPtr> &inputs, const s
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
   auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
 
+  size_t n_num = input_shape_[0];
+  size_t c_num = input_shape_[1];
   if (input_shape_.size() == 4) {
-    size_t h_size = input_shape_[3];
-    size_t c_size = h_size * input_shape_[2];
-    size_t n_size = c_size * input_shape_[1];
+    // each channel sums its rows of hw elements over the n
     size_t hw_size = input_shape_[2] * input_shape_[3];
-    size_t c_offset = 0;
-    for (size_t c = 0; c < input_shape_[1]; ++c) {
-      output_addr[c] = 0;
-      size_t n_offset = 0;
-      for (size_t n = 0; n < input_shape_[0]; ++n) {
-        for (size_t hw = 0; hw < hw_size; ++hw) {
-          size_t offset = c_offset + n_offset + hw;
-          output_addr[c] += input_addr[offset];
+    size_t grain = RowGrain(n_num * hw_size);
+    CPUThreadPool::GetInstance().ParallelFor(c_num, grain, [&](size_t start, size_t end) {
+      for (size_t c = start; c < end; ++c) {
+        float sum = 0;
+        for (size_t n = 0; n < n_num; ++n) {
+          sum += Sum(input_addr + (n * c_num + c) * hw_size, hw_size);
         }
-        n_offset += n_size;
+        output_addr[c] = sum;
       }
-      c_offset += c_size;
-    }
+    });
   } else if (input_shape_.size() == 2) {
-    for (size_t c = 0; c < input_shape_[1]; ++c) {
-      output_addr[c] = 0;
-      size_t n_offset = 0;
-      for (size_t n = 0; n < input_shape_[0]; ++n) {
-        output_addr[c] += input_addr[c + n_offset];
-        n_offset += input_shape_[1];
+    // the blocks of the channels accumulate the rows, so that the reads are contiguous
+    size_t grain = RowGrain(n_num);
+    CPUThreadPool::GetInstance().ParallelFor(c_num, grain, [&](size_t start, size_t end) {
+      for (size_t c = start; c < end; ++c) {
+        output_addr[c] = 0;
       }
-    }
+      for (size_t n = 0; n < n_num; ++n) {
+        Accumulate(input_addr + n * c_num + start, output_addr + start, end - start);
+      }
+    });
   }
   return true;
 }
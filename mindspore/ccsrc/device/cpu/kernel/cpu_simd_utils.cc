@@ -0,0 +1,301 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/cpu_simd_utils.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+#if defined(__x86_64__)
+// The kernels are compiled for those targets only, and picked at run time when the cpu supports them
+#define SIMD_AVX2 __attribute__((target("avx2,fma")))
+#define SIMD_AVX512 __attribute__((target("avx512f")))
+
+enum SimdLevel { kSimdNone = 0, kSimdAvx2, kSimdAvx512 };
+
+SimdLevel GetSimdLevel() {
+  static const SimdLevel level = __builtin_cpu_supports("avx512f")
+                                   ? kSimdAvx512
+                                   : (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") ? kSimdAvx2
+                                                                                                      : kSimdNone);
+  return level;
+}
+
+SIMD_AVX512 size_t MomentumUpdateAvx512(float *weight, float *accumulate, const float *gradient, float learning_rate,
+                                        float moment, size_t size) {
+  const __m512 lr = _mm512_set1_ps(learning_rate);
+  const __m512 m = _mm512_set1_ps(moment);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m512 acc = _mm512_fmadd_ps(_mm512_loadu_ps(accumulate + i), m, _mm512_loadu_ps(gradient + i));
+    _mm512_storeu_ps(accumulate + i, acc);
+    _mm512_storeu_ps(weight + i, _mm512_fnmadd_ps(acc, lr, _mm512_loadu_ps(weight + i)));
+  }
+  return i;
+}
+
+SIMD_AVX2 size_t MomentumUpdateAvx2(float *weight, float *accumulate, const float *gradient, float learning_rate,
+                                    float moment, size_t size) {
+  const __m256 lr = _mm256_set1_ps(learning_rate);
+  const __m256 m = _mm256_set1_ps(moment);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256 acc = _mm256_fmadd_ps(_mm256_loadu_ps(accumulate + i), m, _mm256_loadu_ps(gradient + i));
+    _mm256_storeu_ps(accumulate + i, acc);
+    _mm256_storeu_ps(weight + i, _mm256_fnmadd_ps(acc, lr, _mm256_loadu_ps(weight + i)));
+  }
+  return i;
+}
+
+SIMD_AVX512 size_t AddScalarAvx512(const float *src, float value, float *dst, size_t size) {
+  const __m512 v = _mm512_set1_ps(value);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(src + i), v));
+  }
+  return i;
+}
+
+SIMD_AVX2 size_t AddScalarAvx2(const float *src, float value, float *dst, size_t size) {
+  const __m256 v = _mm256_set1_ps(value);
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(src + i), v));
+  }
+  return i;
+}
+
+SIMD_AVX512 size_t AddVectorAvx512(const float *src, const float *bias, float *dst, size_t size) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    _mm512_storeu_ps(dst + i, _mm512_add_ps(_mm512_loadu_ps(src + i), _mm512_loadu_ps(bias + i)));
+  }
+  return i;
+}
+
+SIMD_AVX2 size_t AddVectorAvx2(const float *src, const float *bias, float *dst, size_t size) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(src + i), _mm256_loadu_ps(bias + i)));
+  }
+  return i;
+}
+
+SIMD_AVX512 size_t SumAvx512(const float *src, size_t size, float *sum) {
+  __m512 acc = _mm512_setzero_ps();
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    acc = _mm512_add_ps(acc, _mm512_loadu_ps(src + i));
+  }
+  alignas(64) float lanes[16];
+  _mm512_store_ps(lanes, acc);
+  *sum = 0;
+  for (float lane : lanes) {
+    *sum += lane;
+  }
+  return i;
+}
+
+SIMD_AVX2 size_t SumAvx2(const float *src, size_t size, float *sum) {
+  __m256 acc = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    acc = _mm256_add_ps(acc, _mm256_loadu_ps(src + i));
+  }
+  __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+  half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+  half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+  *sum = _mm_cvtss_f32(half);
+  return i;
+}
+
+SIMD_AVX512 size_t EqualCountAvx512(const int *left, const int *right, size_t size, size_t *count) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __mmask16 mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(left + i), _mm512_loadu_si512(right + i));
+    *count += static_cast<size_t>(__builtin_popcount(mask));
+  }
+  return i;
+}
+
+SIMD_AVX2 size_t EqualCountAvx2(const int *left, const int *right, size_t size, size_t *count) {
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(left + i));
+    __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(right + i));
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs)));
+    *count += static_cast<size_t>(__builtin_popcount(mask));
+  }
+  return i;
+}
+#elif defined(__aarch64__)
+size_t MomentumUpdateNeon(float *weight, float *accumulate, const float *gradient, float learning_rate, float moment,
+                          size_t size) {
+  const float32x4_t lr = vdupq_n_f32(learning_rate);
+  const float32x4_t m = vdupq_n_f32(moment);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    float32x4_t acc = vmlaq_f32(vld1q_f32(gradient + i), vld1q_f32(accumulate + i), m);
+    vst1q_f32(accumulate + i, acc);
+    vst1q_f32(weight + i, vmlsq_f32(vld1q_f32(weight + i), acc, lr));
+  }
+  return i;
+}
+
+size_t AddScalarNeon(const float *src, float value, float *dst, size_t size) {
+  const float32x4_t v = vdupq_n_f32(value);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(src + i), v));
+  }
+  return i;
+}
+
+size_t AddVectorNeon(const float *src, const float *bias, float *dst, size_t size) {
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(src + i), vld1q_f32(bias + i)));
+  }
+  return i;
+}
+
+size_t SumNeon(const float *src, size_t size, float *sum) {
+  float32x4_t acc = vdupq_n_f32(0);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    acc = vaddq_f32(acc, vld1q_f32(src + i));
+  }
+  *sum = vaddvq_f32(acc);
+  return i;
+}
+
+size_t EqualCountNeon(const int *left, const int *right, size_t size, size_t *count) {
+  // the lanes of the equal elements are all ones, that is -1, subtracting them counts them
+  uint32x4_t acc = vdupq_n_u32(0);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    acc = vsubq_u32(acc, vceqq_s32(vld1q_s32(left + i), vld1q_s32(right + i)));
+  }
+  *count += vaddvq_u32(acc);
+  return i;
+}
+#endif
+}  // namespace
+
+void MomentumUpdate(float *weight, float *accumulate, const float *gradient, float learning_rate, float moment,
+                    size_t size) {
+  size_t i = 0;
+#if defined(__x86_64__)
+  auto level = GetSimdLevel();
+  if (level == kSimdAvx512) {
+    i = MomentumUpdateAvx512(weight, accumulate, gradient, learning_rate, moment, size);
+  } else if (level == kSimdAvx2) {
+    i = MomentumUpdateAvx2(weight, accumulate, gradient, learning_rate, moment, size);
+  }
+#elif defined(__aarch64__)
+  i = MomentumUpdateNeon(weight, accumulate, gradient, learning_rate, moment, size);
+#endif
+  for (; i < size; ++i) {
+    accumulate[i] = accumulate[i] * moment + gradient[i];
+    weight[i] -= accumulate[i] * learning_rate;
+  }
+}
+
+void AddScalar(const float *src, float value, float *dst, size_t size) {
+  size_t i = 0;
+#if defined(__x86_64__)
+  auto level = GetSimdLevel();
+  if (level == kSimdAvx512) {
+    i = AddScalarAvx512(src, value, dst, size);
+  } else if (level == kSimdAvx2) {
+    i = AddScalarAvx2(src, value, dst, size);
+  }
+#elif defined(__aarch64__)
+  i = AddScalarNeon(src, value, dst, size);
+#endif
+  for (; i < size; ++i) {
+    dst[i] = src[i] + value;
+  }
+}
+
+void AddVector(const float *src, const float *bias, float *dst, size_t size) {
+  size_t i = 0;
+#if defined(__x86_64__)
+  auto level = GetSimdLevel();
+  if (level == kSimdAvx512) {
+    i = AddVectorAvx512(src, bias, dst, size);
+  } else if (level == kSimdAvx2) {
+    i = AddVectorAvx2(src, bias, dst, size);
+  }
+#elif defined(__aarch64__)
+  i = AddVectorNeon(src, bias, dst, size);
+#endif
+  for (; i < size; ++i) {
+    dst[i] = src[i] + bias[i];
+  }
+}
+
+void Accumulate(const float *src, float *dst, size_t size) { AddVector(dst, src, dst, size); }
+
+float Sum(const float *src, size_t size) {
+  float sum = 0;
+  size_t i = 0;
+#if defined(__x86_64__)
+  auto level = GetSimdLevel();
+  if (level == kSimdAvx512) {
+    i = SumAvx512(src, size, &sum);
+  } else if (level == kSimdAvx2) {
+    i = SumAvx2(src, size, &sum);
+  }
+#elif defined(__aarch64__)
+  i = SumNeon(src, size, &sum);
+#endif
+  for (; i < size; ++i) {
+    sum += src[i];
+  }
+  return sum;
+}
+
+size_t EqualCount(const int *left, const int *right, size_t size) {
+  size_t count = 0;
+  size_t i = 0;
+#if defined(__x86_64__)
+  auto level = GetSimdLevel();
+  if (level == kSimdAvx512) {
+    i = EqualCountAvx512(left, right, size, &count);
+  } else if (level == kSimdAvx2) {
+    i = EqualCountAvx2(left, right, size, &count);
+  }
+#elif defined(__aarch64__)
+  i = EqualCountNeon(left, right, size, &count);
+#endif
+  for (; i < size; ++i) {
+    if (left[i] == right[i]) {
+      ++count;
+    }
+  }
+  return count;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,45 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_SIMD_UTILS_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_SIMD_UTILS_H_
+
+#include <cstddef>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The loops of the native cpu kernels over the contiguous elements. They're vectorized by AVX-512 or AVX2 as the cpu
+// supports at run time on x86, by NEON on arm, and the tails are done by the scalar loops.
+
+// accumulate = accumulate * moment + gradient, weight -= accumulate * learning_rate
+void MomentumUpdate(float *weight, float *accumulate, const float *gradient, float learning_rate, float moment,
+                    size_t size);
+// dst = src + value
+void AddScalar(const float *src, float value, float *dst, size_t size);
+// dst = src + bias
+void AddVector(const float *src, const float *bias, float *dst, size_t size);
+// dst += src
+void Accumulate(const float *src, float *dst, size_t size);
+// the sum of src, the order of the additions is not the one of the elements
+float Sum(const float *src, size_t size);
+// the number of i that left[i] == right[i]
+size_t EqualCount(const int *left, const int *right, size_t size);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_SIMD_UTILS_H_
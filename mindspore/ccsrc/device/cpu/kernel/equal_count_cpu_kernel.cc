@@ -14,7 +14,10 @@
  * limitations under the License.
  */
 #include "device/cpu/kernel/equal_count_cpu_kernel.h"
+#include <atomic>
 #include "device/cpu/cpu_device_address.h"
+#include "device/cpu/kernel/cpu_simd_utils.h"
+#include "device/cpu/cpu_thread_pool.h"
 
 namespace mindspore {
 namespace device {
@@ -30,17 +33,15 @@ bool EqualCountCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs[0]->size != inputs[1]->size) {
     MS_LOG(EXCEPTION) << "input or output size!";
   }
-  int count = 0;
   auto left = reinterpret_cast<int *>(inputs[0]->addr);
   auto right = reinterpret_cast<int *>(inputs[1]->addr);
   size_t elem_num = inputs[0]->size / sizeof(int);
-  for (size_t i = 0; i < elem_num; i++) {
-    if (left[i] == right[i]) {
-      count++;
-    }
-  }
+  std::atomic<size_t> count{0};
+  CPUThreadPool::GetInstance().ParallelFor(elem_num, kParallelGrain, [&](size_t start, size_t end) {
+    count += EqualCount(left + start, right + start, end - start);
+  });
   auto output = reinterpret_cast<int *>(outputs[0]->addr);
-  output[0] = count;
+  output[0] = SizeToInt(count);
   return true;
 }
 }  // namespace cpu
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/layer_norm_cpu_kernel.h"
+#include <cmath>
+#include "device/cpu/kernel/cpu_simd_utils.h"
+#include "device/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr float kLayerNormEpsilon = 1e-12;
+constexpr size_t kLayerNormInputNum = 3;
+constexpr size_t kLayerNormOutputNum = 3;
+}  // namespace
+
+void LayerNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto input_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  int rank = SizeToInt(input_shape.size());
+  int begin_norm_axis = AnfAlgo::GetNodeAttr<int>(kernel_node, BEGIN_NORM_AXIS);
+  int begin_params_axis = AnfAlgo::GetNodeAttr<int>(kernel_node, BEGIN_PARAMS_AXIS);
+  begin_norm_axis = begin_norm_axis < 0 ? begin_norm_axis + rank : begin_norm_axis;
+  begin_params_axis = begin_params_axis < 0 ? begin_params_axis + rank : begin_params_axis;
+  if (begin_norm_axis < 0 || begin_norm_axis >= rank || begin_params_axis < 0 || begin_params_axis >= rank) {
+    MS_LOG(EXCEPTION) << "layer norm axis " << begin_norm_axis << " and " << begin_params_axis
+                      << " are out of the rank " << rank;
+  }
+  row_num_ = 1;
+  col_num_ = 1;
+  param_num_ = 1;
+  for (int i = 0; i < rank; ++i) {
+    if (i < begin_norm_axis) {
+      row_num_ *= input_shape[i];
+    } else {
+      col_num_ *= input_shape[i];
+    }
+    if (i >= begin_params_axis) {
+      param_num_ *= input_shape[i];
+    }
+  }
+}
+
+bool LayerNormCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != kLayerNormInputNum || outputs.size() != kLayerNormOutputNum) {
+    MS_LOG(EXCEPTION) << "layer norm error input output size!";
+  }
+  auto x = reinterpret_cast<float *>(inputs[0]->addr);
+  auto gamma = reinterpret_cast<float *>(inputs[1]->addr);
+  auto beta = reinterpret_cast<float *>(inputs[2]->addr);
+  auto y = reinterpret_cast<float *>(outputs[0]->addr);
+  auto mean = reinterpret_cast<float *>(outputs[1]->addr);
+  auto variance = reinterpret_cast<float *>(outputs[2]->addr);
+  if (col_num_ == 0) {
+    return true;
+  }
+  CPUThreadPool::GetInstance().ParallelFor(row_num_, RowGrain(col_num_), [&](size_t start, size_t end) {
+    for (size_t row = start; row < end; ++row) {
+      size_t offset = row * col_num_;
+      // two passes over the row, which is in the cache for the following ones
+      float row_mean = Sum(x + offset, col_num_) / col_num_;
+      float square_sum = 0.0f;
+      for (size_t j = 0; j < col_num_; ++j) {
+        float diff = x[offset + j] - row_mean;
+        square_sum += diff * diff;
+      }
+      float row_variance = square_sum / col_num_;
+      float rstd = 1.0f / std::sqrt(row_variance + kLayerNormEpsilon);
+      for (size_t j = 0; j < col_num_; ++j) {
+        size_t param = (offset + j) % param_num_;
+        y[offset + j] = (x[offset + j] - row_mean) * rstd * gamma[param] + beta[param];
+      }
+      mean[row] = row_mean;
+      variance[row] = row_variance;
+    }
+  });
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_LAYER_NORM_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_LAYER_NORM_CPU_KERNEL_H_
+
+#include <vector>
+#include <memory>
+#include "device/cpu/cpu_kernel.h"
+#include "device/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Normalizes the rows of the axes from begin_norm_axis on, the gamma and beta are of the axes from begin_params_axis
+// on. The outputs are y and the mean and variance of the rows, as the gpu kernel.
+class LayerNormCPUKernel : public CPUKernel {
+ public:
+  LayerNormCPUKernel() = default;
+  ~LayerNormCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  size_t row_num_{0};
+  size_t col_num_{0};
+  size_t param_num_{0};
+};
+
+MS_REG_CPU_KERNEL(LayerNorm, LayerNormCPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_LAYER_NORM_CPU_KERNEL_H_
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/mkldnn/batch_norm_cpu_kernel.h"
+#include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
+#include "device/cpu/cpu_device_address.h"
+#include "common/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kBatchNormInputNum = 5;
+constexpr size_t kBatchNormOutputNum = 6;
+
+void CopyParam(void *dst, const void *src, size_t size) {
+  auto ret = memcpy_s(dst, size, src, size);
+  if (ret != 0) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+  }
+}
+}  // namespace
+
+void BatchNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  if (src_shape.size() != 4 && src_shape.size() != 2) {
+    MS_LOG(EXCEPTION) << "batch norm only support nchw or nc input!";
+  }
+  channel_ = src_shape[1];
+  is_training_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, IS_TRAINING);
+  auto epsilon = AnfAlgo::GetNodeAttr<float>(kernel_node, EPSILON);
+  dnnl::memory::desc src_desc = src_shape.size() == 4 ? GetInputMemDesc(kernel_node, 0) : GetDefaultMemDesc(src_shape);
+
+  auto flags = dnnl::normalization_flags::use_scale_shift;
+  if (!is_training_) {
+    flags = flags | dnnl::normalization_flags::use_global_stats;
+  }
+  auto prop_kind = is_training_ ? dnnl::prop_kind::forward_training : dnnl::prop_kind::forward_inference;
+  dnnl::batch_normalization_forward::desc desc =
+    dnnl::batch_normalization_forward::desc(prop_kind, src_desc, epsilon, flags);
+  auto prim_desc = dnnl::batch_normalization_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::batch_normalization_forward>(desc, prim_desc);
+
+  AddArgument(DNNL_ARG_SRC, src_desc);
+  AddArgument(DNNL_ARG_MEAN, prim_desc.mean_desc());
+  AddArgument(DNNL_ARG_VARIANCE, prim_desc.variance_desc());
+  // the scale and the offset are packed by the launches
+  AddArgument(DNNL_ARG_SCALE_SHIFT, prim_desc.weights_desc(), true);
+  AddReorderedArgument(DNNL_ARG_DST, prim_desc.dst_desc(), GetOutputMemDesc(kernel_node, prim_desc.dst_desc()), false);
+}
+
+bool BatchNormCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < kBatchNormInputNum || outputs.size() < kBatchNormOutputNum) {
+    MS_LOG(EXCEPTION) << "batch norm error input output size!";
+  }
+  size_t param_size = channel_ * sizeof(float);
+  auto scale_shift = reinterpret_cast<char *>(arguments_[DNNL_ARG_SCALE_SHIFT].get_data_handle());
+  MS_EXCEPTION_IF_NULL(scale_shift);
+  CopyParam(scale_shift, inputs[1]->addr, param_size);
+  CopyParam(scale_shift + param_size, inputs[2]->addr, param_size);
+  SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
+  SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+  if (is_training_) {
+    SetArgumentHandle(DNNL_ARG_MEAN, outputs[1]->addr);
+    SetArgumentHandle(DNNL_ARG_VARIANCE, outputs[2]->addr);
+  } else {
+    SetArgumentHandle(DNNL_ARG_MEAN, inputs[3]->addr);
+    SetArgumentHandle(DNNL_ARG_VARIANCE, inputs[4]->addr);
+    CopyParam(outputs[1]->addr, inputs[3]->addr, param_size);
+    CopyParam(outputs[2]->addr, inputs[4]->addr, param_size);
+  }
+  ExecutePrimitive();
+  CopyParam(outputs[3]->addr, outputs[1]->addr, param_size);
+  CopyParam(outputs[4]->addr, outputs[2]->addr, param_size);
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/mkldnn/concat_cpu_kernel.h"
+#include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
+#include "device/cpu/cpu_device_address.h"
+#include "common/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+void ConcatCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  input_num_ = AnfAlgo::GetInputTensorNum(kernel_node);
+  if (input_num_ == 0) {
+    MS_LOG(EXCEPTION) << "concat has no input!";
+  }
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  int axis = AnfAlgo::GetNodeAttr<int>(kernel_node, AXIS);
+  int rank = SizeToInt(dst_shape.size());
+  if (axis < -rank || axis >= rank) {
+    MS_LOG(EXCEPTION) << "concat axis " << axis << " is out of the rank " << rank;
+  }
+  axis = axis < 0 ? axis + rank : axis;
+
+  // the inputs are read in their layouts, the dst gets the one of the input 0
+  std::vector<dnnl::memory::desc> src_descs;
+  for (size_t i = 0; i < input_num_; ++i) {
+    src_descs.emplace_back(GetInputMemDesc(kernel_node, i));
+  }
+  auto prim_desc = dnnl::concat::primitive_desc(axis, src_descs, MKLKernelEngine::Get().engine());
+  primitive_ = MKLKernelEngine::Get().CreateConcat(axis, src_descs, prim_desc);
+  for (size_t i = 0; i < input_num_; ++i) {
+    AddArgument(DNNL_ARG_MULTIPLE_SRC + SizeToInt(i), src_descs[i]);
+  }
+  AddReorderedArgument(DNNL_ARG_DST, prim_desc.dst_desc(), GetOutputMemDesc(kernel_node, prim_desc.dst_desc()), false);
+}
+
+bool ConcatCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                             const std::vector<kernel::AddressPtr> & /*workspace*/,
+                             const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < input_num_ || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "concat error input output size!";
+  }
+  for (size_t i = 0; i < input_num_; ++i) {
+    SetArgumentHandle(DNNL_ARG_MULTIPLE_SRC + SizeToInt(i), inputs[i]->addr);
+  }
+  SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+  ExecutePrimitive();
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
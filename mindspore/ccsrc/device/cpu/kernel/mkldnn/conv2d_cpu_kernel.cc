@@ -30,16 +30,17 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (src_shape.size() != 4 || weight_shape.size() != 4) {
     MS_LOG(EXCEPTION) << "conv2d only support nchw input!";
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  // the primitive picks the blocked layouts, the src and dst are reordered unless they're kept between the kernels
+  dnnl::memory::desc src_desc = GetAnyMemDesc(src_shape);
+  dnnl::memory::desc weights_desc = GetAnyMemDesc(weight_shape);
+  dnnl::memory::desc dst_desc = GetAnyMemDesc(dst_shape);
 
   int kernel_size = SizeToInt(weight_shape[3]);
   int stride = AnfAlgo::GetNodeAttr<int>(kernel_node, STRIDE);
   int dilation = AnfAlgo::GetNodeAttr<int>(kernel_node, DILATION);
 
-  dnnl::memory::dims strides{stride, stride};
-  dnnl::memory::dims dilates{dilation - 1, dilation - 1};
+  strides_ = {stride, stride};
+  dilates_ = {dilation - 1, dilation - 1};
   std::vector<int> int_padding_l;
   std::vector<int> int_padding_r;
 
@@ -48,18 +49,20 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (int_padding_l.size() != 2 || int_padding_r.size() != 2) {
     MS_LOG(EXCEPTION) << "get padding failed";
   }
-  dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
-  dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
+  padding_l_ = {int_padding_l[0], int_padding_l[1]};
+  padding_r_ = {int_padding_r[0], int_padding_r[1]};
   dnnl::convolution_forward::desc desc =
     dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+                                    weights_desc, dst_desc, strides_, dilates_, padding_l_, padding_r_);
 
   auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::convolution_forward>(desc, prim_desc);
 
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
+  src_addr_desc_ = GetInputMemDesc(kernel_node, 0);
+  AddReorderedArgument(DNNL_ARG_SRC, prim_desc.src_desc(), src_addr_desc_, true);
+  AddReorderedArgument(DNNL_ARG_WEIGHTS, prim_desc.weights_desc(), GetDefaultMemDesc(weight_shape), true);
+  AddReorderedArgument(DNNL_ARG_DST, prim_desc.dst_desc(), GetOutputMemDesc(kernel_node, prim_desc.dst_desc()),
+                       false);
 }
 
 bool Conv2dCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
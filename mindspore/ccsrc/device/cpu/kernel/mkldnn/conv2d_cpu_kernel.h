@@ -32,6 +32,14 @@ class Conv2dCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ protected:
+  dnnl::memory::dims strides_;
+  dnnl::memory::dims dilates_;
+  dnnl::memory::dims padding_l_;
+  dnnl::memory::dims padding_r_;
+  // the layout of the input address, plain or kept by the kernel producing it
+  dnnl::memory::desc src_addr_desc_;
 };
 
 MS_REG_CPU_KERNEL(Conv2D, Conv2dCPUKernel);
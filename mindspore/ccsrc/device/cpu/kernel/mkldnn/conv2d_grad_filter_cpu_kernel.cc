@@ -60,7 +60,8 @@ void Conv2dGradFilterCPUKernel::InitKernel(const CNodePtr &kernel_node) {
 
   auto backward_prim_desc = dnnl::convolution_backward_weights::primitive_desc(
     backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::convolution_backward_weights>(backward_prim_desc);
+  primitive_ =
+    MKLKernelEngine::Get().CreatePrimitive<dnnl::convolution_backward_weights>(backward_desc, backward_prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_DIFF_DST, dst_desc);
@@ -59,7 +59,8 @@ void Conv2dGradInputCPUKernel::InitKernel(const CNodePtr &kernel_node) {
 
   auto backward_prim_desc =
     dnnl::convolution_backward_data::primitive_desc(backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::convolution_backward_data>(backward_prim_desc);
+  primitive_ =
+    MKLKernelEngine::Get().CreatePrimitive<dnnl::convolution_backward_data>(backward_desc, backward_prim_desc);
 
   AddArgument(DNNL_ARG_DIFF_SRC, src_desc);
   AddArgument(DNNL_ARG_DIFF_DST, dst_desc);
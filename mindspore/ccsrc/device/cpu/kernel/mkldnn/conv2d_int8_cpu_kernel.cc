@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/mkldnn/conv2d_int8_cpu_kernel.h"
+#include "common/utils.h"
+#include "utils/context/ms_context.h"
+#include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// the masks of the scales, by the dim 1 of the dst and the dim 0 of the weights, the output channels both
+constexpr int kDstChannelMask = 1 << 1;
+constexpr int kWeightChannelMask = 1 << 0;
+constexpr int kTensorMask = 0;
+}  // namespace
+
+void Conv2dInt8CPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  Conv2dCPUKernel::InitKernel(kernel_node);
+  src_shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  weight_shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  dst_shape_ = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  calibrator_.set_steps(context->cpu_int8_calibration_steps());
+}
+
+void Conv2dInt8CPUKernel::InitInt8Primitive(const float *weight) {
+  MS_EXCEPTION_IF_NULL(weight);
+  using tag = dnnl::memory::format_tag;
+  using dt = dnnl::memory::data_type;
+  auto &engine = MKLKernelEngine::Get().engine();
+  float src_scale = calibrator_.scale();
+  size_t channel_num = weight_shape_[0];
+  size_t channel_size = weight_shape_[1] * weight_shape_[2] * weight_shape_[3];
+  std::vector<float> weight_scales = ChannelScales(weight, channel_num, channel_size, channel_size, 1);
+  std::vector<float> output_scales(channel_num);
+  for (size_t i = 0; i < channel_num; ++i) {
+    output_scales[i] = 1.0f / (src_scale * weight_scales[i]);
+  }
+
+  dnnl::memory::dims src_dims(src_shape_.begin(), src_shape_.end());
+  dnnl::memory::dims weight_dims(weight_shape_.begin(), weight_shape_.end());
+  dnnl::memory::dims dst_dims(dst_shape_.begin(), dst_shape_.end());
+  dnnl::memory::desc src_desc(src_dims, calibrator_.is_unsigned() ? dt::u8 : dt::s8, tag::any);
+  dnnl::memory::desc weights_desc(weight_dims, dt::s8, tag::any);
+  dnnl::memory::desc dst_desc(dst_dims, dt::f32, tag::any);
+  dnnl::convolution_forward::desc desc =
+    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_inference, dnnl::algorithm::convolution_direct, src_desc,
+                                    weights_desc, dst_desc, strides_, dilates_, padding_l_, padding_r_);
+  dnnl::primitive_attr attr;
+  attr.set_output_scales(kDstChannelMask, output_scales);
+  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, attr, engine);
+  // not cached by the engine, the scales of the attr are not in the desc
+  int8_primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
+
+  dnnl::memory weight_memory(GetDefaultMemDesc(weight_shape_), engine, const_cast<float *>(weight));
+  int8_weights_ = dnnl::memory(prim_desc.weights_desc(), engine);
+  dnnl::primitive_attr weight_attr;
+  weight_attr.set_output_scales(kWeightChannelMask, weight_scales);
+  auto weight_reorder = std::make_shared<dnnl::reorder>(dnnl::reorder::primitive_desc(weight_memory, int8_weights_,
+                                                                                       weight_attr));
+  MKLKernelEngine::Get().Execute(weight_reorder, {{DNNL_ARG_FROM, weight_memory}, {DNNL_ARG_TO, int8_weights_}});
+
+  src_memory_ = dnnl::memory(src_addr_desc_, engine, nullptr);
+  int8_src_ = dnnl::memory(prim_desc.src_desc(), engine);
+  dnnl::primitive_attr src_attr;
+  src_attr.set_output_scales(kTensorMask, {src_scale});
+  src_reorder_ = std::make_shared<dnnl::reorder>(dnnl::reorder::primitive_desc(src_memory_, int8_src_, src_attr));
+
+  dst_memory_ = dnnl::memory(output_mem_desc(), engine, nullptr);
+  if (prim_desc.dst_desc() == output_mem_desc()) {
+    int8_dst_ = dst_memory_;
+  } else {
+    int8_dst_ = dnnl::memory(prim_desc.dst_desc(), engine);
+    dst_reorder_ = std::make_shared<dnnl::reorder>(int8_dst_, dst_memory_);
+  }
+  MS_LOG(INFO) << "conv2d runs in int8, the input is " << (calibrator_.is_unsigned() ? "u8" : "s8")
+               << " of the scale " << src_scale;
+}
+
+bool Conv2dInt8CPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                 const std::vector<kernel::AddressPtr> &workspace,
+                                 const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 2 || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "error input output size!";
+  }
+  if (calibrator_.calibrating()) {
+    calibrator_.Record(reinterpret_cast<float *>(inputs[0]->addr), inputs[0]->size / sizeof(float));
+    return Conv2dCPUKernel::Launch(inputs, workspace, outputs);
+  }
+  if (int8_primitive_ == nullptr) {
+    InitInt8Primitive(reinterpret_cast<float *>(inputs[1]->addr));
+  }
+  src_memory_.set_data_handle(inputs[0]->addr);
+  dst_memory_.set_data_handle(outputs[0]->addr);
+  MKLKernelEngine::Get().Execute(src_reorder_, {{DNNL_ARG_FROM, src_memory_}, {DNNL_ARG_TO, int8_src_}});
+  MKLKernelEngine::Get().Execute(
+    int8_primitive_, {{DNNL_ARG_SRC, int8_src_}, {DNNL_ARG_WEIGHTS, int8_weights_}, {DNNL_ARG_DST, int8_dst_}});
+  if (dst_reorder_ != nullptr) {
+    MKLKernelEngine::Get().Execute(dst_reorder_, {{DNNL_ARG_FROM, int8_dst_}, {DNNL_ARG_TO, dst_memory_}});
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_CONV2D_INT8_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_CONV2D_INT8_CPU_KERNEL_H_
+
+#include <vector>
+#include <memory>
+#include "device/cpu/kernel/mkldnn/conv2d_cpu_kernel.h"
+#include "device/cpu/kernel/mkldnn/int8_calibrator.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Conv2D in int8 after the calibration launches in float. The input is quantized by a reorder at each launch, the
+// weights are quantized by the output channels once, and the output is dequantized to float by the output scales
+// of the primitive.
+class Conv2dInt8CPUKernel : public Conv2dCPUKernel {
+ public:
+  Conv2dInt8CPUKernel() = default;
+  ~Conv2dInt8CPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  void InitInt8Primitive(const float *weight);
+
+  Int8Calibrator calibrator_;
+  std::vector<size_t> src_shape_;
+  std::vector<size_t> weight_shape_;
+  std::vector<size_t> dst_shape_;
+  std::shared_ptr<dnnl::primitive> int8_primitive_{nullptr};
+  std::shared_ptr<dnnl::primitive> src_reorder_{nullptr};
+  std::shared_ptr<dnnl::primitive> dst_reorder_{nullptr};
+  dnnl::memory src_memory_;
+  dnnl::memory dst_memory_;
+  dnnl::memory int8_src_;
+  dnnl::memory int8_weights_;
+  dnnl::memory int8_dst_;
+};
+
+MS_REG_CPU_KERNEL(Conv2DInt8, Conv2dInt8CPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_CONV2D_INT8_CPU_KERNEL_H_
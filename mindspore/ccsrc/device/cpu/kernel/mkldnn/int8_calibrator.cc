@@ -0,0 +1,84 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/mkldnn/int8_calibrator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr float kInt8Max = 127.0f;
+constexpr float kUint8Max = 255.0f;
+
+template <typename T>
+void QuantizeImpl(const float *src, float scale, float min, float max, T *dst, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    float value = std::nearbyint(src[i] * scale);
+    dst[i] = static_cast<T>(std::min(std::max(value, min), max));
+  }
+}
+}  // namespace
+
+void Int8Calibrator::Record(const float *data, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  auto range = std::minmax_element(data, data + size);
+  if (step_ == 0) {
+    min_ = *range.first;
+    max_ = *range.second;
+  } else {
+    min_ = std::min(min_, *range.first);
+    max_ = std::max(max_, *range.second);
+  }
+  ++step_;
+}
+
+float Int8Calibrator::scale() const {
+  float abs_max = std::max(std::fabs(min_), std::fabs(max_));
+  if (abs_max == 0.0f) {
+    return 1.0f;
+  }
+  return (is_unsigned() ? kUint8Max : kInt8Max) / abs_max;
+}
+
+std::vector<float> ChannelScales(const float *data, size_t channel_num, size_t stride, size_t size,
+                                 size_t inner_stride) {
+  std::vector<float> scales(channel_num, 1.0f);
+  for (size_t c = 0; c < channel_num; ++c) {
+    float abs_max = 0.0f;
+    for (size_t i = 0; i < size; ++i) {
+      abs_max = std::max(abs_max, std::fabs(data[c * stride + i * inner_stride]));
+    }
+    if (abs_max > 0.0f) {
+      scales[c] = kInt8Max / abs_max;
+    }
+  }
+  return scales;
+}
+
+void Quantize(const float *src, float scale, uint8_t *dst, size_t size) {
+  QuantizeImpl(src, scale, 0.0f, kUint8Max, dst, size);
+}
+
+void Quantize(const float *src, float scale, int8_t *dst, size_t size) {
+  QuantizeImpl(src, scale, -kInt8Max, kInt8Max, dst, size);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_INT8_CALIBRATOR_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_INT8_CALIBRATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The post training calibration of the input of an int8 kernel. The kernel runs in float for the first steps, and
+// the range of its input over them gives the scale of the quantization. The input is quantized to u8 when it has no
+// negative value, the inputs following the relu get the full range so.
+class Int8Calibrator {
+ public:
+  Int8Calibrator() = default;
+  ~Int8Calibrator() = default;
+  void set_steps(size_t steps) { steps_ = steps; }
+  bool calibrating() const { return step_ < steps_; }
+  // add the input of a float launch to the range
+  void Record(const float *data, size_t size);
+  bool is_unsigned() const { return min_ >= 0.0f; }
+  // the quantized value is the float one multiplied by the scale
+  float scale() const;
+
+ private:
+  size_t steps_{0};
+  size_t step_{0};
+  float min_{0.0f};
+  float max_{0.0f};
+};
+
+// the symmetric s8 scales of the channels, channel c is data[c * stride + i * inner_stride] for i in [0, size)
+std::vector<float> ChannelScales(const float *data, size_t channel_num, size_t stride, size_t size,
+                                 size_t inner_stride);
+// dst = saturate(round(src * scale)), the int8 kernels quantize the inputs by it
+void Quantize(const float *src, float scale, uint8_t *dst, size_t size);
+void Quantize(const float *src, float scale, int8_t *dst, size_t size);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_INT8_CALIBRATOR_H_
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/mkldnn/lstm_cpu_kernel.h"
+#include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
+#include "device/cpu/cpu_device_address.h"
+#include "common/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr int kGateNum = 4;
+constexpr size_t kLstmInputNum = 4;
+constexpr size_t kLstmOutputNum = 3;
+}  // namespace
+
+void LstmCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src_h_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  if (src_shape.size() != 3 || src_h_shape.size() != 3) {
+    MS_LOG(EXCEPTION) << "lstm only support 3-D input!";
+  }
+  input_size_ = AnfAlgo::GetNodeAttr<int>(kernel_node, INPUT_SIZE);
+  hidden_size_ = AnfAlgo::GetNodeAttr<int>(kernel_node, HIDDEN_SIZE);
+  num_layers_ = AnfAlgo::GetNodeAttr<int>(kernel_node, NUM_LAYERS);
+  has_bias_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, HAS_BIAS);
+  bool bidirectional = AnfAlgo::GetNodeAttr<bool>(kernel_node, BIDIRECTIONAL);
+  num_directions_ = bidirectional ? 2 : 1;
+  if (SizeToInt(src_shape[2]) != input_size_) {
+    MS_LOG(EXCEPTION) << "lstm input size " << src_shape[2] << " is not the attr input_size " << input_size_;
+  }
+  if (num_layers_ > 1 && input_size_ != hidden_size_ * num_directions_) {
+    // the layers run by one primitive take the inputs of the same size
+    MS_LOG(EXCEPTION) << "lstm of " << num_layers_ << " layers only support input_size " << input_size_
+                      << " equal to hidden_size * num_directions " << hidden_size_ * num_directions_;
+  }
+  size_t gate_size = IntToSize(kGateNum * hidden_size_);
+  size_t weight_size = gate_size * IntToSize(input_size_ + hidden_size_ + (has_bias_ ? 2 : 0));
+  weight_size *= IntToSize(num_layers_ * num_directions_);
+  auto weight_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 3);
+  size_t weight_num =
+    std::accumulate(weight_shape.begin(), weight_shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  if (weight_num != weight_size) {
+    MS_LOG(EXCEPTION) << "lstm weight size " << weight_num << " is not the one of the attrs " << weight_size;
+  }
+  int seq_len = SizeToInt(src_shape[0]);
+  int batch = SizeToInt(src_shape[1]);
+  dnnl::memory::dims src_dims = {seq_len, batch, input_size_};
+  dnnl::memory::dims state_dims = {num_layers_, num_directions_, batch, hidden_size_};
+  dnnl::memory::dims weights_dims = {num_layers_, num_directions_, input_size_, kGateNum, hidden_size_};
+  dnnl::memory::dims weights_h_dims = {num_layers_, num_directions_, hidden_size_, kGateNum, hidden_size_};
+  dnnl::memory::dims bias_dims = {num_layers_, num_directions_, kGateNum, hidden_size_};
+  dnnl::memory::dims dst_dims = {seq_len, batch, hidden_size_ * num_directions_};
+  using tag = dnnl::memory::format_tag;
+  using dt = dnnl::memory::data_type;
+  dnnl::memory::desc src_desc(src_dims, dt::f32, tag::tnc);
+  dnnl::memory::desc state_desc(state_dims, dt::f32, tag::ldnc);
+  dnnl::memory::desc weights_desc(weights_dims, dt::f32, tag::ldigo);
+  dnnl::memory::desc weights_h_desc(weights_h_dims, dt::f32, tag::ldigo);
+  dnnl::memory::desc bias_desc(bias_dims, dt::f32, tag::ldgo);
+  dnnl::memory::desc dst_desc(dst_dims, dt::f32, tag::tnc);
+
+  auto direction =
+    bidirectional ? dnnl::rnn_direction::bidirectional_concat : dnnl::rnn_direction::unidirectional_left2right;
+  dnnl::lstm_forward::desc desc =
+    dnnl::lstm_forward::desc(dnnl::prop_kind::forward_inference, direction, src_desc, state_desc, state_desc,
+                             weights_desc, weights_h_desc, bias_desc, dst_desc, state_desc, state_desc);
+  auto prim_desc = dnnl::lstm_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::lstm_forward>(desc, prim_desc);
+
+  AddArgument(DNNL_ARG_SRC_LAYER, src_desc);
+  AddArgument(DNNL_ARG_SRC_ITER, state_desc);
+  AddArgument(DNNL_ARG_SRC_ITER_C, state_desc);
+  // the weights are packed from the flat weight by the launches, as the weight may be updated between them
+  AddArgument(DNNL_ARG_WEIGHTS_LAYER, weights_desc, true);
+  AddArgument(DNNL_ARG_WEIGHTS_ITER, weights_h_desc, true);
+  AddArgument(DNNL_ARG_BIAS, bias_desc, true);
+  AddArgument(DNNL_ARG_DST_LAYER, dst_desc);
+  AddArgument(DNNL_ARG_DST_ITER, state_desc);
+  AddArgument(DNNL_ARG_DST_ITER_C, state_desc);
+}
+
+void LstmCPUKernel::PackWeights(const float *weight) {
+  MS_EXCEPTION_IF_NULL(weight);
+  auto weights_layer = reinterpret_cast<float *>(arguments_[DNNL_ARG_WEIGHTS_LAYER].get_data_handle());
+  auto weights_iter = reinterpret_cast<float *>(arguments_[DNNL_ARG_WEIGHTS_ITER].get_data_handle());
+  auto bias = reinterpret_cast<float *>(arguments_[DNNL_ARG_BIAS].get_data_handle());
+  MS_EXCEPTION_IF_NULL(weights_layer);
+  MS_EXCEPTION_IF_NULL(weights_iter);
+  MS_EXCEPTION_IF_NULL(bias);
+  size_t gate_size = IntToSize(kGateNum * hidden_size_);
+  size_t input_size = IntToSize(input_size_);
+  size_t hidden_size = IntToSize(hidden_size_);
+  const float *src = weight;
+  for (int i = 0; i < num_layers_ * num_directions_; ++i) {
+    // the w of (gate_size, in) is transposed to (in, gate_size) of the ldigo
+    float *dst = weights_layer + IntToSize(i) * input_size * gate_size;
+    for (size_t g = 0; g < gate_size; ++g) {
+      for (size_t k = 0; k < input_size; ++k) {
+        dst[k * gate_size + g] = src[g * input_size + k];
+      }
+    }
+    src += gate_size * input_size;
+    dst = weights_iter + IntToSize(i) * hidden_size * gate_size;
+    for (size_t g = 0; g < gate_size; ++g) {
+      for (size_t k = 0; k < hidden_size; ++k) {
+        dst[k * gate_size + g] = src[g * hidden_size + k];
+      }
+    }
+    src += gate_size * hidden_size;
+    // mkl has one bias of the gates, the sum of b_ih and b_hh
+    dst = bias + IntToSize(i) * gate_size;
+    for (size_t g = 0; g < gate_size; ++g) {
+      dst[g] = has_bias_ ? src[g] + src[gate_size + g] : 0.0f;
+    }
+    if (has_bias_) {
+      src += 2 * gate_size;
+    }
+  }
+}
+
+bool LstmCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                           const std::vector<kernel::AddressPtr> & /*workspace*/,
+                           const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < kLstmInputNum || outputs.size() < kLstmOutputNum) {
+    MS_LOG(EXCEPTION) << "lstm error input output size!";
+  }
+  PackWeights(reinterpret_cast<float *>(inputs[3]->addr));
+  SetArgumentHandle(DNNL_ARG_SRC_LAYER, inputs[0]->addr);
+  SetArgumentHandle(DNNL_ARG_SRC_ITER, inputs[1]->addr);
+  SetArgumentHandle(DNNL_ARG_SRC_ITER_C, inputs[2]->addr);
+  SetArgumentHandle(DNNL_ARG_DST_LAYER, outputs[0]->addr);
+  SetArgumentHandle(DNNL_ARG_DST_ITER, outputs[1]->addr);
+  SetArgumentHandle(DNNL_ARG_DST_ITER_C, outputs[2]->addr);
+  ExecutePrimitive();
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
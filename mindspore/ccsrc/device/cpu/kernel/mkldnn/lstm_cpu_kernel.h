@@ -0,0 +1,57 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_LSTM_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_LSTM_CPU_KERNEL_H_
+
+#include <vector>
+#include <memory>
+#include "device/cpu/kernel/mkldnn/mkl_cpu_kernel.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The forward lstm of the inputs x (seq_len, batch, input_size), h and c (num_layers * num_directions, batch,
+// hidden_size) and the flat weight. The weight has the blocks of the layers in turn, each of them has the blocks of
+// its directions, and each of these is w_ih (4 * hidden_size, layer_input_size), w_hh (4 * hidden_size, hidden_size)
+// and, with has_bias, b_ih and b_hh (4 * hidden_size), the gates are in the order i, f, g, o.
+class LstmCPUKernel : public MKLCPUKernel {
+ public:
+  LstmCPUKernel() = default;
+  ~LstmCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  // rearrange the flat weight to the ldigo weights and the ldgo bias of mkl
+  void PackWeights(const float *weight);
+
+  int input_size_{0};
+  int hidden_size_{0};
+  int num_layers_{0};
+  int num_directions_{1};
+  bool has_bias_{false};
+};
+
+MS_REG_CPU_KERNEL(LSTM, LstmCPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_LSTM_CPU_KERNEL_H_
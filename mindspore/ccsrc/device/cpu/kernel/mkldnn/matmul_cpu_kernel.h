@@ -33,7 +33,7 @@ class MatMulCPUKernel : public MKLCPUKernel {
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
 
- private:
+ protected:
   char trans_a_{TRANSPOSE_NO};
   char trans_b_{TRANSPOSE_NO};
   dnnl_dim_t dim_m_{0};
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/mkldnn/matmul_int8_cpu_kernel.h"
+#include "common/utils.h"
+#include "utils/context/ms_context.h"
+#include "device/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+void MatMulInt8CPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MatMulCPUKernel::InitKernel(kernel_node);
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  calibrator_.set_steps(context->cpu_int8_calibration_steps());
+  size_t a_size = static_cast<size_t>(dim_m_ * dim_k_);
+  workspace_size_list_.emplace_back(a_size);
+  workspace_size_list_.emplace_back(static_cast<size_t>(dim_m_ * dim_n_) * sizeof(int32_t));
+}
+
+void MatMulInt8CPUKernel::QuantizeWeight(const float *weight) {
+  MS_EXCEPTION_IF_NULL(weight);
+  size_t n = static_cast<size_t>(dim_n_);
+  size_t k = static_cast<size_t>(dim_k_);
+  // the column j of the output is of the row j of b (n, k) or the column j of b (k, n)
+  if (trans_b_ == TRANSPOSE_YES) {
+    weight_scales_ = ChannelScales(weight, n, k, k, 1);
+  } else {
+    weight_scales_ = ChannelScales(weight, n, 1, k, n);
+  }
+  int8_weight_.resize(n * k);
+  for (size_t i = 0; i < n * k; ++i) {
+    size_t column = trans_b_ == TRANSPOSE_YES ? i / k : i % n;
+    Quantize(weight + i, weight_scales_[column], int8_weight_.data() + i, 1);
+  }
+  MS_LOG(INFO) << "matmul runs in int8, the input a is " << (calibrator_.is_unsigned() ? "u8" : "s8")
+               << " of the scale " << calibrator_.scale();
+}
+
+bool MatMulInt8CPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                 const std::vector<kernel::AddressPtr> &workspace,
+                                 const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 2 || workspace.size() < 2 || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "matmul error input output size!";
+  }
+  auto input_a = reinterpret_cast<float *>(inputs[0]->addr);
+  if (calibrator_.calibrating()) {
+    calibrator_.Record(input_a, static_cast<size_t>(dim_m_ * dim_k_));
+    return MatMulCPUKernel::Launch(inputs, workspace, outputs);
+  }
+  if (int8_weight_.empty()) {
+    QuantizeWeight(reinterpret_cast<float *>(inputs[1]->addr));
+  }
+  dnnl_dim_t lda = trans_a_ == TRANSPOSE_NO ? dim_k_ : dim_m_;
+  dnnl_dim_t ldb = trans_b_ == TRANSPOSE_NO ? dim_n_ : dim_k_;
+  size_t a_size = static_cast<size_t>(dim_m_ * dim_k_);
+  size_t n = static_cast<size_t>(dim_n_);
+  float a_scale = calibrator_.scale();
+  auto int32_output = reinterpret_cast<int32_t *>(workspace[1]->addr);
+  const int32_t output_offset = 0;
+  CPUThreadPool &pool = CPUThreadPool::GetInstance();
+  if (calibrator_.is_unsigned()) {
+    auto int8_a = reinterpret_cast<uint8_t *>(workspace[0]->addr);
+    pool.ParallelFor(a_size, kParallelGrain, [&](size_t start, size_t end) {
+      Quantize(input_a + start, a_scale, int8_a + start, end - start);
+    });
+    (void)dnnl_gemm_u8s8s32(trans_a_, trans_b_, 'F', dim_m_, dim_n_, dim_k_, 1.f, int8_a, lda, 0, int8_weight_.data(),
+                            ldb, 0, 0.f, int32_output, dim_n_, &output_offset);
+  } else {
+    auto int8_a = reinterpret_cast<int8_t *>(workspace[0]->addr);
+    pool.ParallelFor(a_size, kParallelGrain, [&](size_t start, size_t end) {
+      Quantize(input_a + start, a_scale, int8_a + start, end - start);
+    });
+    (void)dnnl_gemm_s8s8s32(trans_a_, trans_b_, 'F', dim_m_, dim_n_, dim_k_, 1.f, int8_a, lda, 0, int8_weight_.data(),
+                            ldb, 0, 0.f, int32_output, dim_n_, &output_offset);
+  }
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  pool.ParallelFor(static_cast<size_t>(dim_m_), RowGrain(n), [&](size_t start, size_t end) {
+    for (size_t i = start * n; i < end * n; ++i) {
+      output[i] = static_cast<float>(int32_output[i]) / (a_scale * weight_scales_[i % n]);
+    }
+  });
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
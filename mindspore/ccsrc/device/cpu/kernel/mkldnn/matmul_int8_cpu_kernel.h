@@ -0,0 +1,54 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_MATMUL_INT8_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_MATMUL_INT8_CPU_KERNEL_H_
+
+#include <vector>
+#include <memory>
+#include "device/cpu/kernel/mkldnn/matmul_cpu_kernel.h"
+#include "device/cpu/kernel/mkldnn/int8_calibrator.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// MatMul in int8 after the calibration launches in float. The input a is quantized to the workspace 0 at each
+// launch, the input b is quantized by the columns of the output once, and the int32 products in the workspace 1 are
+// dequantized to float by the scales of the columns.
+class MatMulInt8CPUKernel : public MatMulCPUKernel {
+ public:
+  MatMulInt8CPUKernel() = default;
+  ~MatMulInt8CPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  void QuantizeWeight(const float *weight);
+
+  Int8Calibrator calibrator_;
+  std::vector<int8_t> int8_weight_;
+  std::vector<float> weight_scales_;
+};
+
+MS_REG_CPU_KERNEL(MatMulInt8, MatMulInt8CPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_MATMUL_INT8_CPU_KERNEL_H_
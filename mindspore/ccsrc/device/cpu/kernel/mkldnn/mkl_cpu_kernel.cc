@@ -17,12 +17,99 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <set>
+#include <unordered_map>
 #include "common/utils.h"
 #include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
+#include "operator/ops.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+bool IsSameInputShapes(const CNodePtr &kernel_node) {
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  for (size_t i = 1; i < input_num; ++i) {
+    if (AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i) != AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CollectGraphOutputs(const AnfNodePtr &node, std::set<AnfNodePtr> *outputs) {
+  auto item_with_index = AnfAlgo::VisitKernelWithReturnType(node, 0);
+  auto &item = item_with_index.first;
+  MS_EXCEPTION_IF_NULL(item);
+  if (item->isa<CNode>() && AnfAlgo::GetCNodeName(item) == prim::kPrimMakeTuple->name()) {
+    auto cnode = item->cast<CNodePtr>();
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      CollectGraphOutputs(cnode->input(i), outputs);
+    }
+    return;
+  }
+  (void)outputs->insert(item);
+}
+}  // namespace
+
+bool IsMKLLayoutInput(const CNodePtr &kernel_node, size_t input_index) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto name = AnfAlgo::GetCNodeName(kernel_node);
+  if (name == prim::kPrimConv2D->name() || name == prim::kPrimRelu->name() || name == prim::kPrimMaxPool->name() ||
+      name == prim::kPrimBatchNorm->name()) {
+    return input_index == 0 && AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0).size() == 4;
+  }
+  if (name == prim::kPrimTensorAdd->name()) {
+    return IsSameInputShapes(kernel_node) && AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0).size() == 4;
+  }
+  if (name == prim::kPrimConcat->name()) {
+    return AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0).size() == 4;
+  }
+  return false;
+}
+
+bool IsMKLLayoutOutput(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto name = AnfAlgo::GetCNodeName(kernel_node);
+  if (name == prim::kPrimConv2D->name()) {
+    return true;
+  }
+  return IsMKLLayoutInput(kernel_node, 0);
+}
+
+void MarkMKLLayoutOutputs(const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  std::set<AnfNodePtr> graph_outputs;
+  for (auto &output : kernel_graph->outputs()) {
+    CollectGraphOutputs(output, &graph_outputs);
+  }
+  // whether all the kernels reading the output 0 of a kernel take it in the mkl layouts
+  std::unordered_map<AnfNodePtr, bool> layout_outputs;
+  auto &kernels = kernel_graph->execution_order();
+  for (auto &kernel : kernels) {
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      auto input = AnfAlgo::VisitKernel(AnfAlgo::GetInputNode(kernel, i), 0);
+      bool layout_input = input.second == 0 && IsMKLLayoutInput(kernel, i);
+      auto iter = layout_outputs.find(input.first);
+      if (iter == layout_outputs.end()) {
+        layout_outputs[input.first] = layout_input;
+      } else {
+        iter->second = iter->second && layout_input;
+      }
+    }
+  }
+  size_t kept_num = 0;
+  for (auto &kernel : kernels) {
+    auto iter = layout_outputs.find(kernel);
+    bool keep = iter != layout_outputs.end() && iter->second && graph_outputs.count(kernel) == 0 &&
+                IsMKLLayoutOutput(kernel);
+    AnfAlgo::SetNodeAttr(KEEP_MKL_LAYOUT, MakeValue(keep), kernel);
+    kept_num += keep ? 1 : 0;
+  }
+  MS_LOG(INFO) << "The outputs of " << kept_num << " kernels are kept in the mkl layouts";
+}
+
 void MKLCPUKernel::GetPadding(const CNodePtr &kernel_node, const std::string &pad_mode,
                               const std::vector<size_t> &src_shape, int kernel_size, int stride,
                               std::vector<int> *padding_l, std::vector<int> *padding_r) {
@@ -87,18 +174,92 @@ dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &sh
   return mem_desc;
 }
 
+dnnl::memory::desc MKLCPUKernel::GetAnyMemDesc(const std::vector<size_t> &shape) {
+  dnnl::memory::dims dims;
+  dims.insert(dims.end(), shape.begin(), shape.end());
+  return dnnl::memory::desc(dims, dnnl::memory::data_type::f32, dnnl::memory::format_tag::any);
+}
+
+dnnl::memory::desc MKLCPUKernel::GetInputMemDesc(const CNodePtr &kernel_node, size_t input_index) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto input = AnfAlgo::VisitKernel(AnfAlgo::GetInputNode(kernel_node, input_index), 0);
+  MS_EXCEPTION_IF_NULL(input.first);
+  if (input.second == 0 && input.first->isa<CNode>() && AnfAlgo::HasNodeAttr(KEEP_MKL_LAYOUT, input.first) &&
+      AnfAlgo::GetNodeAttr<bool>(input.first, KEEP_MKL_LAYOUT)) {
+    // the kernels are built in the execution order, so the one producing the input is built
+    auto mkl_kernel = dynamic_cast<MKLCPUKernel *>(AnfAlgo::GetKernelMod(input.first));
+    if (mkl_kernel != nullptr) {
+      auto &mem_desc = mkl_kernel->output_mem_desc();
+      if (input_index < input_size_list_.size()) {
+        input_size_list_[input_index] = mem_desc.get_size();
+      }
+      return mem_desc;
+    }
+  }
+  return GetDefaultMemDesc(AnfAlgo::GetInputDeviceShape(kernel_node, input_index));
+}
+
+dnnl::memory::desc MKLCPUKernel::GetOutputMemDesc(const CNodePtr &kernel_node, const dnnl::memory::desc &prim_desc) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (AnfAlgo::HasNodeAttr(KEEP_MKL_LAYOUT, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, KEEP_MKL_LAYOUT)) {
+    output_mem_desc_ = prim_desc;
+    if (!output_size_list_.empty()) {
+      output_size_list_[0] = prim_desc.get_size();
+    }
+  } else {
+    output_mem_desc_ = GetDefaultMemDesc(AnfAlgo::GetOutputDeviceShape(kernel_node, 0));
+  }
+  return output_mem_desc_;
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
 
+void MKLCPUKernel::AddReorderedArgument(int arg_key, const dnnl::memory::desc &prim_desc,
+                                        const dnnl::memory::desc &addr_desc, bool is_input) {
+  if (prim_desc == addr_desc) {
+    AddArgument(arg_key, addr_desc);
+    return;
+  }
+  auto prim_memory = MKLKernelEngine::Get().CreateMemory(prim_desc, true);
+  auto addr_memory = MKLKernelEngine::Get().CreateMemory(addr_desc);
+  arguments_[arg_key] = prim_memory;
+  addr_memories_[arg_key] = addr_memory;
+  ArgumentReorder reorder;
+  reorder.arg_key = arg_key;
+  if (is_input) {
+    reorder.reorder = MKLKernelEngine::Get().CreateReorder(addr_memory, prim_memory);
+    reorder.arguments = {{DNNL_ARG_FROM, addr_memory}, {DNNL_ARG_TO, prim_memory}};
+    input_reorders_.push_back(reorder);
+  } else {
+    reorder.reorder = MKLKernelEngine::Get().CreateReorder(prim_memory, addr_memory);
+    reorder.arguments = {{DNNL_ARG_FROM, prim_memory}, {DNNL_ARG_TO, addr_memory}};
+    output_reorders_.push_back(reorder);
+  }
+}
+
 void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
+  auto addr_iter = addr_memories_.find(arg_key);
+  if (addr_iter != addr_memories_.end()) {
+    addr_iter->second.set_data_handle(ptr);
+    return;
+  }
   auto arg_iter = arguments_.find(arg_key);
   if (arg_iter != arguments_.end()) {
     arg_iter->second.set_data_handle(ptr);
   }
 }
 
-void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
+void MKLCPUKernel::ExecutePrimitive() {
+  for (auto &reorder : input_reorders_) {
+    MKLKernelEngine::Get().Execute(reorder.reorder, reorder.arguments);
+  }
+  MKLKernelEngine::Get().Execute(primitive_, arguments_);
+  for (auto &reorder : output_reorders_) {
+    MKLKernelEngine::Get().Execute(reorder.reorder, reorder.arguments);
+  }
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
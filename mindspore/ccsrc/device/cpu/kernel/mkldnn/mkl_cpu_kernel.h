@@ -23,25 +23,55 @@
 #include "dnnl.hpp"
 #include "device/cpu/cpu_kernel.h"
 #include "device/cpu/cpu_kernel_factory.h"
+#include "session/kernel_graph.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+// The mkl kernels reading the output of another one in the layout picked by its primitive, the blocked layouts like
+// nChw16c are kept between them, and the data are reordered from or to the plain layouts at the boundaries only
+bool IsMKLLayoutInput(const CNodePtr &kernel_node, size_t input_index);
+bool IsMKLLayoutOutput(const CNodePtr &kernel_node);
+// Set KEEP_MKL_LAYOUT to the mkl kernels whose output 0 is read by the IsMKLLayoutInput only, before they're built
+void MarkMKLLayoutOutputs(const session::KernelGraph *kernel_graph);
+
 class MKLCPUKernel : public CPUKernel {
  public:
   MKLCPUKernel() = default;
   ~MKLCPUKernel() override = default;
+  const dnnl::memory::desc &output_mem_desc() const { return output_mem_desc_; }
 
  protected:
+  struct ArgumentReorder {
+    int arg_key;
+    std::shared_ptr<dnnl::primitive> reorder;
+    std::unordered_map<int, dnnl::memory> arguments;
+  };
   void GetPadding(const CNodePtr &kernel_node, const std::string &pad_mode, const std::vector<size_t> &src_shape,
                   int kernel_size, int stride, std::vector<int> *padding_l, std::vector<int> *padding_r);
   void AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc = false);
+  // The primitive runs on the memory of prim_desc, which is reordered from or to the address of addr_desc at each
+  // launch when they're not the same
+  void AddReorderedArgument(int arg_key, const dnnl::memory::desc &prim_desc, const dnnl::memory::desc &addr_desc,
+                            bool is_input);
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  // the desc letting the primitive pick the layout
+  dnnl::memory::desc GetAnyMemDesc(const std::vector<size_t> &shape);
+  // the layout of the input, the one kept by the mkl kernel producing it or the plain one
+  dnnl::memory::desc GetInputMemDesc(const CNodePtr &kernel_node, size_t input_index);
+  // the layout of the output 0, the one of the primitive if it's kept or the plain one
+  dnnl::memory::desc GetOutputMemDesc(const CNodePtr &kernel_node, const dnnl::memory::desc &prim_desc);
   void ExecutePrimitive();
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
+
+ private:
+  std::unordered_map<int, dnnl::memory> addr_memories_;
+  std::vector<ArgumentReorder> input_reorders_;
+  std::vector<ArgumentReorder> output_reorders_;
+  dnnl::memory::desc output_mem_desc_;
 };
 }  // namespace cpu
 }  // namespace device
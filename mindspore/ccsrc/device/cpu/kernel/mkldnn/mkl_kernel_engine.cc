@@ -23,8 +23,41 @@ namespace cpu {
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  // a stream for each thread, the kernels may be launched by the inter op threads at the same time
+  thread_local dnnl::stream stream(engine_);
+  primitive->execute(stream, arguments);
+  (void)stream.wait();
+}
+
+std::shared_ptr<dnnl::primitive> MKLKernelEngine::GetPrimitive(
+  const std::string &key, const std::function<std::shared_ptr<dnnl::primitive>()> &creator) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = primitives_.find(key);
+  if (iter != primitives_.end()) {
+    return iter->second;
+  }
+  auto primitive = creator();
+  MS_EXCEPTION_IF_NULL(primitive);
+  primitives_[key] = primitive;
+  MS_LOG(DEBUG) << "Created the mkl primitive " << primitives_.size();
+  return primitive;
+}
+
+std::shared_ptr<dnnl::primitive> MKLKernelEngine::CreateConcat(int axis,
+                                                               const std::vector<dnnl::memory::desc> &src_descs,
+                                                               const dnnl::concat::primitive_desc &pd) {
+  std::string key = DescKey(typeid(dnnl::concat).name(), axis);
+  for (auto &src_desc : src_descs) {
+    key += DescKey("", src_desc.data);
+  }
+  return GetPrimitive(key, [&pd]() { return std::make_shared<dnnl::concat>(pd); });
+}
+
+std::shared_ptr<dnnl::primitive> MKLKernelEngine::CreateReorder(const dnnl::memory &from, const dnnl::memory &to) {
+  auto from_desc = from.get_desc();
+  auto to_desc = to.get_desc();
+  std::string key = DescKey(typeid(dnnl::reorder).name(), from_desc.data) + DescKey("", to_desc.data);
+  return GetPrimitive(key, [&from, &to]() { return std::make_shared<dnnl::reorder>(from, to); });
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
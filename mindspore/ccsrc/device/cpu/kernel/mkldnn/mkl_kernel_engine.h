@@ -16,9 +16,13 @@
 #ifndef MINDSPORE_MKL_KERNEL_ENGINE_H_
 #define MINDSPORE_MKL_KERNEL_ENGINE_H_
 
+#include <functional>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <typeinfo>
 #include "dnnl.hpp"
 #include "common/utils.h"
 
@@ -40,11 +44,32 @@ class MKLKernelEngine {
   void Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                const std::unordered_map<int, dnnl::memory> &arguments);
 
+  // The primitives are cached by their op descs, which have the kinds, shapes, data types, layouts and attrs of
+  // them, so the kernels of the same ones in the graphs share the code generated by the creation. The primitives
+  // don't hold the data, they may be executed by the threads at the same time.
+  template <typename Primitive, typename Desc>
+  std::shared_ptr<dnnl::primitive> CreatePrimitive(const Desc &desc, const typename Primitive::primitive_desc &pd) {
+    return GetPrimitive(DescKey(typeid(Primitive).name(), desc.data),
+                        [&pd]() { return std::make_shared<Primitive>(pd); });
+  }
+  std::shared_ptr<dnnl::primitive> CreateConcat(int axis, const std::vector<dnnl::memory::desc> &src_descs,
+                                                const dnnl::concat::primitive_desc &pd);
+  std::shared_ptr<dnnl::primitive> CreateReorder(const dnnl::memory &from, const dnnl::memory &to);
+
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  template <typename Data>
+  static std::string DescKey(const std::string &kind, const Data &data) {
+    // the descs are zero initialized before they're set, the bytes equal only when the descs do
+    return kind + std::string(reinterpret_cast<const char *>(&data), sizeof(Data));
+  }
+  std::shared_ptr<dnnl::primitive> GetPrimitive(const std::string &key,
+                                                const std::function<std::shared_ptr<dnnl::primitive>()> &creator);
+
+  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0) {}
   ~MKLKernelEngine() = default;
   dnnl::engine engine_;
-  dnnl::stream stream_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<dnnl::primitive>> primitives_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -40,7 +40,7 @@ void MulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   dnnl::memory::desc dst_mem_desc = GetDefaultMemDesc(dst_shape);
   dnnl::binary::desc desc = dnnl::binary::desc(dnnl::algorithm::binary_mul, src0_mem_desc, src1_mem_desc, dst_mem_desc);
   auto prim_desc = dnnl::binary::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::binary>(prim_desc);
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::binary>(desc, prim_desc);
   AddArgument(DNNL_ARG_SRC_0, src0_mem_desc);
   AddArgument(DNNL_ARG_SRC_1, src1_mem_desc);
   AddArgument(DNNL_ARG_DST, dst_mem_desc);
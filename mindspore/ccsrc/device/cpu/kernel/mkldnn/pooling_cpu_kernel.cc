@@ -27,8 +27,8 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc src_desc = GetInputMemDesc(kernel_node, 0);
+  dnnl::memory::desc dst_desc = GetAnyMemDesc(dst_shape);
   std::vector<int> kernel_sizes = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, KSIZE);
   std::vector<int> strides = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDES);
   if (kernel_sizes.size() != 4 || strides.size() != 4) {
@@ -49,10 +49,11 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     dnnl::pooling_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::pooling_max, src_desc, dst_desc,
                                 strides_dims, kernels_dims, padding_l, padding_r);
   auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::pooling_forward>(prim_desc);
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::pooling_forward>(desc, prim_desc);
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
-  AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc());
+  AddReorderedArgument(DNNL_ARG_DST, prim_desc.dst_desc(), GetOutputMemDesc(kernel_node, prim_desc.dst_desc()), false);
+  // the jit kernels of the blocked layouts write the indices of the max to the workspace
+  AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc(), true);
 }
 
 bool PoolingCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -27,15 +27,15 @@ void ReluCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (src_shape.size() != 4 && src_shape.size() != 2) {
     MS_LOG(EXCEPTION) << "relu kernel dims invalid " << src_shape.size();
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  dnnl::memory::desc src_desc = src_shape.size() == 4 ? GetInputMemDesc(kernel_node, 0) : GetDefaultMemDesc(src_shape);
 
   dnnl::eltwise_forward::desc desc =
     dnnl::eltwise_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::eltwise_relu, src_desc, 0.0);
   auto prim_desc = dnnl::eltwise_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::eltwise_forward>(prim_desc);
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::eltwise_forward>(desc, prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, src_desc);
+  AddReorderedArgument(DNNL_ARG_DST, prim_desc.dst_desc(), GetOutputMemDesc(kernel_node, prim_desc.dst_desc()), false);
 }
 
 bool ReluCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -37,7 +37,7 @@ void ReluGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     dnnl::eltwise_backward::desc(dnnl::algorithm::eltwise_relu, src_desc, src_desc, 0.0, 0.0);
   auto backward_prim_desc =
     dnnl::eltwise_backward::primitive_desc(backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::eltwise_backward>(backward_prim_desc);
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::eltwise_backward>(backward_desc, backward_prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_DIFF_SRC, src_desc);
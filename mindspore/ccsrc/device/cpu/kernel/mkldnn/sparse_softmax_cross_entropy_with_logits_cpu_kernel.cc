@@ -51,7 +51,7 @@ void SparseSoftmaxCrossEntropyWithLogitsCPUKernel::InitKernel(const CNodePtr &ke
 
   dnnl::softmax_forward::desc desc = dnnl::softmax_forward::desc(dnnl::prop_kind::forward_training, mem_desc, 1);
   auto prim_desc = dnnl::softmax_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::softmax_forward>(prim_desc);
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::softmax_forward>(desc, prim_desc);
 
   AddArgument(DNNL_ARG_SRC, mem_desc);
   AddArgument(DNNL_ARG_DST, mem_desc);
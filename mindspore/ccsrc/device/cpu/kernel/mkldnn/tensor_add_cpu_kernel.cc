@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/kernel/mkldnn/tensor_add_cpu_kernel.h"
+#include <utility>
+#include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
+#include "device/cpu/cpu_device_address.h"
+#include "common/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// whether src broadcasts to dst, they have the same rank
+bool IsBroadcastShape(const std::vector<size_t> &src, const std::vector<size_t> &dst) {
+  for (size_t i = 0; i < src.size(); ++i) {
+    if (src[i] != dst[i]) {
+      if (src[i] != 1) {
+        MS_LOG(EXCEPTION) << "tensor add input shape can't be broadcast, dim " << i << " is " << src[i] << " vs "
+                          << dst[i];
+      }
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+void TensorAddCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<size_t> src0_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> src1_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  if (dst_shape.empty()) {
+    dst_shape.emplace_back(1);
+  }
+  if (src0_shape == dst_shape && src1_shape == dst_shape) {
+    // the same layout for the inputs and the output, the input 1 is reordered to the one of the input 0 if needed
+    dnnl::memory::desc src_desc = GetInputMemDesc(kernel_node, 0);
+    dnnl::binary::desc desc = dnnl::binary::desc(dnnl::algorithm::binary_add, src_desc, src_desc, src_desc);
+    auto prim_desc = dnnl::binary::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::binary>(desc, prim_desc);
+    AddArgument(DNNL_ARG_SRC_0, src_desc);
+    AddReorderedArgument(DNNL_ARG_SRC_1, src_desc, GetInputMemDesc(kernel_node, 1), true);
+    AddReorderedArgument(DNNL_ARG_DST, src_desc, GetOutputMemDesc(kernel_node, src_desc), false);
+    return;
+  }
+  // numpy broadcasting, the lower rank input gets the leading dims of 1
+  (void)src0_shape.insert(src0_shape.begin(), dst_shape.size() - src0_shape.size(), 1);
+  (void)src1_shape.insert(src1_shape.begin(), dst_shape.size() - src1_shape.size(), 1);
+  bool broadcast0 = IsBroadcastShape(src0_shape, dst_shape);
+  bool broadcast1 = IsBroadcastShape(src1_shape, dst_shape);
+  if (broadcast0 && broadcast1) {
+    MS_LOG(EXCEPTION) << "tensor add only support one of the inputs broadcast";
+  }
+  // mkl broadcasts the src 1 only, the add is commutative
+  swap_inputs_ = broadcast0;
+  if (swap_inputs_) {
+    std::swap(src0_shape, src1_shape);
+  }
+  dnnl::memory::desc src0_desc = GetDefaultMemDesc(src0_shape);
+  dnnl::memory::desc src1_desc = GetDefaultMemDesc(src1_shape);
+  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::binary::desc desc = dnnl::binary::desc(dnnl::algorithm::binary_add, src0_desc, src1_desc, dst_desc);
+  auto prim_desc = dnnl::binary::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  primitive_ = MKLKernelEngine::Get().CreatePrimitive<dnnl::binary>(desc, prim_desc);
+  AddArgument(DNNL_ARG_SRC_0, src0_desc);
+  AddArgument(DNNL_ARG_SRC_1, src1_desc);
+  AddArgument(DNNL_ARG_DST, dst_desc);
+}
+
+bool TensorAddCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 2 || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "tensor add error input output size!";
+  }
+  SetArgumentHandle(DNNL_ARG_SRC_0, inputs[swap_inputs_ ? 1 : 0]->addr);
+  SetArgumentHandle(DNNL_ARG_SRC_1, inputs[swap_inputs_ ? 0 : 1]->addr);
+  SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+  ExecutePrimitive();
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
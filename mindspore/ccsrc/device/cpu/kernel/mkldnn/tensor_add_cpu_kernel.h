@@ -0,0 +1,48 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_TENSOR_ADD_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_TENSOR_ADD_CPU_KERNEL_H_
+
+#include <vector>
+#include <memory>
+#include "device/cpu/kernel/mkldnn/mkl_cpu_kernel.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The inputs of the same shapes are added in the layout of the input 0, or one of them is broadcast to the other
+class TensorAddCPUKernel : public MKLCPUKernel {
+ public:
+  TensorAddCPUKernel() = default;
+  ~TensorAddCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  // the input 0 is the one broadcast, it's passed as the src 1
+  bool swap_inputs_{false};
+};
+
+MS_REG_CPU_KERNEL(TensorAdd, TensorAddCPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_TENSOR_ADD_CPU_KERNEL_H_
@@ -54,6 +54,11 @@ class DeviceAddress {
   virtual bool SyncDeviceToHost(const std::vector<int> &shape, size_t size, TypeId type, void *host_ptr) const = 0;
   virtual bool SyncHostToDevice(const std::vector<int> &shape, size_t size, TypeId type,
                                 const void *host_ptr) const = 0;
+  // copy the data of the same format, type and size on the device, false if it is not copied
+  virtual bool SyncDeviceToDevice(const DeviceAddress *) const { return false; }
+  // copy the whole data in the format and the type of the device, false if it is not copied
+  virtual bool SyncDeviceToHostRaw(void *, size_t) const { return false; }
+  virtual bool SyncHostToDeviceRaw(const void *, size_t) const { return false; }
   const void *GetPtr() const { return ptr_; }
   size_t GetSize() const { return size_; }
   std::string format() const { return format_; }
@@ -22,64 +22,62 @@
 
 namespace mindspore {
 namespace device {
-GpuQueue::GpuQueue(void *addr, size_t feature_size, size_t label_size, size_t capacity)
-    : buffer_(addr),
-      head_(0),
-      tail_(0),
-      feature_size_(feature_size),
-      label_size_(label_size),
-      capacity_(capacity),
-      stream_(0),
-      node_info_(nullptr) {
+GpuQueue::GpuQueue(void *addr, const std::vector<size_t> &shape, size_t capacity)
+    : buffer_(addr), head_(0), tail_(0), shape_(shape), len_(0), capacity_(capacity), stream_(0), node_info_(nullptr) {
   CHECK_CUDA_RET_WITH_ERROR(cudaStreamCreate(&stream_), "Cuda Create Stream Failed");
   node_info_ = mindspore::make_unique<NodeInfo[]>(capacity);
+  for (auto size : shape_) {
+    len_ += size;
+  }
 }
 
 GpuQueue::~GpuQueue() { buffer_ = nullptr; }
 
-BlockQueueStatus_T GpuQueue::Push(void *feature_addr, size_t feature_size, void *label_addr, size_t label_size) {
-  if ((feature_addr == nullptr) || (label_addr == nullptr)) {
-    MS_LOG(ERROR) << "input nullptr";
+BlockQueueStatus_T GpuQueue::Push(const std::vector<DataItemGpu> &data) {
+  if (data.size() != shape_.size()) {
+    MS_LOG(ERROR) << "Data input error. Input data columns: " << data.size() << ", with " << shape_.size()
+                  << " expect";
     return ERROR_INPUT;
   }
-  if ((feature_size != feature_size_) || (label_size != label_size_)) {
-    MS_LOG(ERROR) << "Data input error. Input data size: (" << feature_size << ", " << label_size << "), with ("
-                  << feature_size_ << ", " << label_size_ << ") expect";
-    return ERROR_INPUT;
+  for (size_t i = 0; i < data.size(); i++) {
+    if (data[i].data_ptr_ == nullptr) {
+      MS_LOG(ERROR) << "input nullptr";
+      return ERROR_INPUT;
+    }
+    if (data[i].data_len_ > shape_[i]) {
+      MS_LOG(ERROR) << "Data input error. Input data size of column " << i << ": " << data[i].data_len_
+                    << ", with at most " << shape_[i] << " expect";
+      return ERROR_INPUT;
+    }
   }
-  void *feature_start_addr = reinterpret_cast<unsigned char *>(buffer_) + tail_ * (feature_size + label_size);
-  if (feature_start_addr == nullptr) {
-    MS_LOG(ERROR) << "feature start addr is nullptr";
-    return INTERNAL_ERROR;
+  unsigned char *addr = reinterpret_cast<unsigned char *>(buffer_) + tail_ * len_;
+  for (size_t i = 0; i < data.size(); i++) {
+    CHECK_CUDA_RET_WITH_ERROR(
+      cudaMemcpyAsync(addr, data[i].data_ptr_, data[i].data_len_, cudaMemcpyHostToDevice, stream_),
+      "Cuda Memcpy Error");
+    addr += shape_[i];
   }
-  CHECK_CUDA_RET_WITH_ERROR(
-    cudaMemcpyAsync(feature_start_addr, feature_addr, feature_size, cudaMemcpyHostToDevice, stream_),
-    "Cuda Memcpy Error");
-  void *label_start_addr = reinterpret_cast<unsigned char *>(feature_start_addr) + feature_size;
-  if (label_start_addr == nullptr) {
-    MS_LOG(ERROR) << "label start addr is nullptr";
-    return INTERNAL_ERROR;
-  }
-  CHECK_CUDA_RET_WITH_ERROR(cudaMemcpyAsync(label_start_addr, label_addr, label_size, cudaMemcpyHostToDevice, stream_),
-                            "Cuda Memcpy Error");
+  // The host data may be page locked, then the copies are really asynchronous and Front waits for this event
+  // before the host data is released
   node_info_[tail_].event_.reset(new cudaEvent_t());
   CHECK_CUDA_RET_WITH_ERROR(cudaEventCreate(&(*(node_info_[tail_].event_))), "Cuda Create Event Failed");
-  node_info_[tail_].host_feature_addr_ = feature_addr;
-  node_info_[tail_].host_label_addr_ = label_addr;
+  CHECK_CUDA_RET_WITH_ERROR(cudaEventRecord(*(node_info_[tail_].event_), stream_), "Cuda Record Event Failed");
+  node_info_[tail_].data_ = data;
   tail_ = (tail_ + 1) % (capacity_);
   return SUCCESS;
 }
 
-BlockQueueStatus_T GpuQueue::Front(void **feature_addr, size_t *feature_size, void **label_addr,
-                                   size_t *label_size) const {
+BlockQueueStatus_T GpuQueue::Front(std::vector<DataItemGpu> *data) const {
   CHECK_CUDA_RET_WITH_ERROR(cudaEventSynchronize(*(node_info_[head_].event_)), "Cuda Event Syn Failed");
   CHECK_CUDA_RET_WITH_ERROR(cudaEventDestroy(*(node_info_[head_].event_)), "Cuda Destroy Event Failed");
-  *feature_addr = (unsigned char *)buffer_ + head_ * (feature_size_ + label_size_);
-  *feature_size = feature_size_;
-  *label_addr = (unsigned char *)buffer_ + head_ * (feature_size_ + label_size_) + feature_size_;
-  *label_size = label_size_;
-  host_release_(node_info_[head_].host_feature_addr_);
-  host_release_(node_info_[head_].host_label_addr_);
+  data->clear();
+  unsigned char *addr = reinterpret_cast<unsigned char *>(buffer_) + head_ * len_;
+  for (size_t i = 0; i < shape_.size(); i++) {
+    auto &item = node_info_[head_].data_[i];
+    data->push_back({item.data_len_, addr});
+    addr += shape_[i];
+    host_release_(item.data_ptr_);
+  }
   return SUCCESS;
 }
 
@@ -101,26 +99,31 @@ bool GpuQueue::Destroy() {
   }
 }
 
-BlockQueueStatus_T BlockingQueue::Create(void *addr, size_t feature_size, size_t label_size, size_t capacity) {
+BlockQueueStatus_T BlockingQueue::Create(void *addr, const std::vector<size_t> &shape, size_t capacity) {
   if (addr == nullptr) {
     MS_LOG(ERROR) << "addr is nullptr";
     return INTERNAL_ERROR;
   }
-  queue_ = std::make_shared<GpuQueue>(addr, feature_size, label_size, capacity);
+  if (shape.empty()) {
+    MS_LOG(ERROR) << "shape is empty";
+    return ERROR_INPUT;
+  }
+  queue_ = std::make_shared<GpuQueue>(addr, shape, capacity);
   return SUCCESS;
 }
 
 void BlockingQueue::RegisterRelease(const std::function<void(void *)> &func) { queue_->RegisterRelease(func); }
 
-BlockQueueStatus_T BlockingQueue::Push(void *feature_addr, size_t feature_size, void *label_addr, size_t label_size,
-                                       unsigned int timeout_in_sec) {
+size_t BlockingQueue::Capacity() const { return queue_ == nullptr ? 0 : queue_->Capacity(); }
+
+BlockQueueStatus_T BlockingQueue::Push(const std::vector<DataItemGpu> &data, unsigned int timeout_in_sec) {
   std::unique_lock<std::mutex> locker(mutex_);
   if (queue_->IsFull()) {
     if (not_full_cond_.wait_for(locker, std::chrono::seconds(timeout_in_sec)) == std::cv_status::timeout) {
       return TIMEOUT;
     }
   }
-  auto ret = queue_->Push(feature_addr, feature_size, label_addr, label_size);
+  auto ret = queue_->Push(data);
   if (ret) {
     return ret;
   }
@@ -128,15 +131,14 @@ BlockQueueStatus_T BlockingQueue::Push(void *feature_addr, size_t feature_size,
   return SUCCESS;
 }
 
-BlockQueueStatus_T BlockingQueue::Front(void **feature_addr, size_t *feature_size, void **label_addr,
-                                        size_t *label_size) {
+BlockQueueStatus_T BlockingQueue::Front(std::vector<DataItemGpu> *data) {
   std::unique_lock<std::mutex> locker(mutex_);
   bool timeout = not_empty_cond_.wait_for(locker, std::chrono::seconds(30), [this] { return !queue_->IsEmpty(); });
   if (!timeout) {
     return TIMEOUT;
   }
 
-  return queue_->Front(feature_addr, feature_size, label_addr, label_size);
+  return queue_->Front(data);
 }
 
 BlockQueueStatus_T BlockingQueue::Pop() {
@@ -72,6 +72,15 @@ bool CudaDriver::CopyDeviceMemToHost(const HostMemPtr &dst, const DeviceMemPtr &
   return true;
 }
 
+bool CudaDriver::CopyDeviceMemToDevice(const DeviceMemPtr &dst, const void *src, size_t size) {
+  auto ret = cudaMemcpy(dst, src, size, cudaMemcpyDeviceToDevice);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaMemcpy failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
 size_t CudaDriver::total_mem_size() {
   size_t free;
   size_t total;
@@ -122,6 +131,119 @@ bool CudaDriver::SyncStream(const DeviceStream &stream) {
   return true;
 }
 
+bool CudaDriver::CreateEvent(DeviceEvent *event, bool disable_timing) {
+  auto ret = cudaEventCreateWithFlags(reinterpret_cast<cudaEvent_t *>(event),
+                                      disable_timing ? cudaEventDisableTiming : cudaEventDefault);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaEventCreate failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
+bool CudaDriver::DestroyEvent(const DeviceEvent &event) {
+  auto ret = cudaEventDestroy((cudaEvent_t)event);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaEventDestroy failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
+bool CudaDriver::RecordEvent(const DeviceEvent &event, const DeviceStream &stream) {
+  auto ret = cudaEventRecord((cudaEvent_t)event, (cudaStream_t)stream);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaEventRecord failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
+bool CudaDriver::StreamWaitEvent(const DeviceStream &stream, const DeviceEvent &event) {
+  auto ret = cudaStreamWaitEvent((cudaStream_t)stream, (cudaEvent_t)event, 0);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaStreamWaitEvent failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
+bool CudaDriver::QueryEvent(const DeviceEvent &event) {
+  auto ret = cudaEventQuery((cudaEvent_t)event);
+  if (ret == cudaSuccess) {
+    return true;
+  }
+  if (ret != cudaErrorNotReady) {
+    MS_LOG(ERROR) << "cudaEventQuery failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+  }
+  return false;
+}
+
+bool CudaDriver::ElapsedTime(float *milliseconds, const DeviceEvent &start, const DeviceEvent &end) {
+  auto ret = cudaEventElapsedTime(milliseconds, (cudaEvent_t)start, (cudaEvent_t)end);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaEventElapsedTime failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
+#if CUDART_VERSION >= 10010
+bool CudaDriver::BeginStreamCapture(const DeviceStream &stream) {
+  auto ret = cudaStreamBeginCapture((cudaStream_t)stream, cudaStreamCaptureModeRelaxed);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaStreamBeginCapture failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
+bool CudaDriver::EndStreamCapture(const DeviceStream &stream, DeviceGraphExec *graph_exec) {
+  cudaGraph_t graph = nullptr;
+  auto ret = cudaStreamEndCapture((cudaStream_t)stream, &graph);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaStreamEndCapture failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  ret = cudaGraphInstantiate(reinterpret_cast<cudaGraphExec_t *>(graph_exec), graph, nullptr, nullptr, 0);
+  (void)cudaGraphDestroy(graph);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaGraphInstantiate failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
+bool CudaDriver::LaunchGraph(const DeviceGraphExec &graph_exec, const DeviceStream &stream) {
+  auto ret = cudaGraphLaunch((cudaGraphExec_t)graph_exec, (cudaStream_t)stream);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaGraphLaunch failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+
+bool CudaDriver::DestroyGraph(const DeviceGraphExec &graph_exec) {
+  auto ret = cudaGraphExecDestroy((cudaGraphExec_t)graph_exec);
+  if (ret != cudaSuccess) {
+    MS_LOG(ERROR) << "cudaGraphExecDestroy failed, ret[" << static_cast<int>(ret) << "], " << cudaGetErrorString(ret);
+    return false;
+  }
+  return true;
+}
+#else
+bool CudaDriver::BeginStreamCapture(const DeviceStream &) {
+  MS_LOG(WARNING) << "The CUDA graph needs CUDA 10.1 at least.";
+  return false;
+}
+
+bool CudaDriver::EndStreamCapture(const DeviceStream &, DeviceGraphExec *) { return false; }
+
+bool CudaDriver::LaunchGraph(const DeviceGraphExec &, const DeviceStream &) { return false; }
+
+bool CudaDriver::DestroyGraph(const DeviceGraphExec &) { return false; }
+#endif
+
 int CudaDriver::device_count() {
   int dev_count;
   auto ret = cudaGetDeviceCount(&dev_count);
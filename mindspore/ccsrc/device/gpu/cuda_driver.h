@@ -26,6 +26,7 @@ typedef void *DeviceStream;
 typedef void *DeviceEvent;
 typedef void *HostMemPtr;
 typedef void *DeviceMemPtr;
+typedef void *DeviceGraphExec;
 
 class CudaDriver {
  public:
@@ -35,6 +36,7 @@ class CudaDriver {
   static bool FreeDeviceMem(const DeviceMemPtr &addr);
   static bool CopyHostMemToDevice(const DeviceMemPtr &dst, const void *src, size_t size);
   static bool CopyDeviceMemToHost(const HostMemPtr &dst, const DeviceMemPtr &src, size_t size);
+  static bool CopyDeviceMemToDevice(const DeviceMemPtr &dst, const void *src, size_t size);
   static size_t total_mem_size();
   static size_t free_mem_size();
 
@@ -43,6 +45,23 @@ class CudaDriver {
   static bool CreateStream(DeviceStream *stream);
   static bool DestroyStream(const DeviceStream &stream);
   static bool SyncStream(const DeviceStream &stream);
+  // the events without timing are lighter for the synchronization between the streams
+  static bool CreateEvent(DeviceEvent *event, bool disable_timing = true);
+  static bool DestroyEvent(const DeviceEvent &event);
+  static bool RecordEvent(const DeviceEvent &event, const DeviceStream &stream);
+  static bool StreamWaitEvent(const DeviceStream &stream, const DeviceEvent &event);
+  // Whether the work recorded by the event is completed, without blocking
+  static bool QueryEvent(const DeviceEvent &event);
+  // The milliseconds between two completed events with timing
+  static bool ElapsedTime(float *milliseconds, const DeviceEvent &start, const DeviceEvent &end);
+
+  // Encapsulate the cuda APIs associated with the graphs, which need CUDA 10.1 at least.
+  // The work issued to the stream between the begin and the end of the capture is recorded instead of run, and
+  // instantiated to the graph_exec which replays it with one launch.
+  static bool BeginStreamCapture(const DeviceStream &stream);
+  static bool EndStreamCapture(const DeviceStream &stream, DeviceGraphExec *graph_exec);
+  static bool LaunchGraph(const DeviceGraphExec &graph_exec, const DeviceStream &stream);
+  static bool DestroyGraph(const DeviceGraphExec &graph_exec);
 
   // Encapsulate the cuda APIs associated with device management.
   static int device_count();
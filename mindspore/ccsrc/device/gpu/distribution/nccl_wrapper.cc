@@ -38,22 +38,27 @@ void NCCLWrapper::set_rank(int rank_id, int rank_size) {
 }
 
 void NCCLWrapper::InitNCCLComm() {
-  CHECK_RET(ncclCommInitRank(&comm_, rank_size_, unique_id_, rank_id_), ncclSuccess,
-            "Failed to init nccl communicator.");
+  std::call_once(comm_init_flag_, [this]() {
+    CHECK_RET(ncclCommInitRank(&comm_, rank_size_, unique_id_, rank_id_), ncclSuccess,
+              "Failed to init nccl communicator.");
+  });
 }
 
 ncclResult_t NCCLWrapper::AllReduce(const void *input_addr, void *output_addr, size_t count, ncclDataType_t data_type,
                                     ncclRedOp_t reduce_type, cudaStream_t stream) {
+  InitNCCLComm();
   return ncclAllReduce(input_addr, output_addr, count, data_type, reduce_type, comm_, stream);
 }
 
 ncclResult_t NCCLWrapper::AllGather(const void *input_addr, void *output_addr, size_t count, ncclDataType_t data_type,
                                     cudaStream_t stream) {
+  InitNCCLComm();
   return ncclAllGather(input_addr, output_addr, count, data_type, comm_, stream);
 }
 
 ncclResult_t NCCLWrapper::ReduceScatter(const void *input_addr, void *output_addr, size_t count,
                                         ncclDataType_t data_type, ncclRedOp_t reduce_type, cudaStream_t stream) {
+  InitNCCLComm();
   return ncclReduceScatter(input_addr, output_addr, count, data_type, reduce_type, comm_, stream);
 }
 }  // namespace gpu
@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <nccl.h>
+#include <mutex>
 #include "device/gpu/distribution/collective_common.h"
 
 namespace mindspore {
@@ -33,6 +34,7 @@ class NCCLWrapper {
   ncclUniqueId nccl_unique_id() const;
   void set_nccl_unique_id(ncclUniqueId unique_id);
   void set_rank(int rank_id, int rank_size);
+  // Create the communicator, only the first call does. The collectives call it, so it is created on first use.
   void InitNCCLComm();
   ncclResult_t AllReduce(const void *input_addr, void *output_addr, size_t count, ncclDataType_t datatype,
                          ncclRedOp_t op, cudaStream_t stream);
@@ -50,6 +52,7 @@ class NCCLWrapper {
   int rank_size_;
   ncclUniqueId unique_id_;
   ncclComm_t comm_;
+  std::once_flag comm_init_flag_;
 };
 }  // namespace gpu
 }  // namespace device
@@ -40,6 +40,14 @@ bool GPUDeviceAddress::SyncHostToDevice(const std::vector<int> &, size_t, TypeId
   return GPUDeviceManager::GetInstance().CopyHostMemToDevice(ptr_, host_ptr, size_);
 }
 
+bool GPUDeviceAddress::SyncDeviceToDevice(const DeviceAddress *src_device_addr) const {
+  MS_EXCEPTION_IF_NULL(src_device_addr);
+  if (src_device_addr->type_id() != type_id_ || src_device_addr->GetSize() != size_) {
+    return false;
+  }
+  return GPUDeviceManager::GetInstance().CopyDeviceMemToDevice(ptr_, src_device_addr->GetPtr(), size_);
+}
+
 GPUDeviceAddress::~GPUDeviceAddress() {
   if (ptr_ == nullptr) {
     return;
@@ -39,6 +39,10 @@ void GPUDeviceManager::ReleaseDevice() {
   if (stream_ != nullptr) {
     CHECK_OP_RET_WITH_ERROR(CudaDriver::DestroyStream(stream_), "Failed to destroy cuda stream.");
   }
+  for (const auto& stream : gpu_streams_) {
+    CHECK_OP_RET_WITH_ERROR(CudaDriver::DestroyStream(stream), "Failed to destroy cuda stream.");
+  }
+  gpu_streams_.clear();
   if (cudnn_handle_ != nullptr) {
     CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroy(cudnn_handle_), "Failed to destroy cudnn handle");
   }
@@ -50,6 +54,22 @@ void GPUDeviceManager::ReleaseDevice() {
 
 const DeviceStream& GPUDeviceManager::default_stream() const { return stream_; }
 
+bool GPUDeviceManager::CreateStream(DeviceStream* stream) {
+  if (!CudaDriver::CreateStream(stream)) {
+    MS_LOG(ERROR) << "Failed to create CUDA stream.";
+    return false;
+  }
+  gpu_streams_.push_back(*stream);
+  return true;
+}
+
+void GPUDeviceManager::SetHandleStream(const DeviceStream& stream) {
+  CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetStream(cudnn_handle_, reinterpret_cast<cudaStream_t>(stream)),
+                              "Failed to set stream for cuDNN handle.");
+  CHECK_CUBLAS_RET_WITH_EXCEPT(cublasSetStream(cublas_handle_, reinterpret_cast<cudaStream_t>(stream)),
+                               "Failed to set stream for cuBLAS handle.");
+}
+
 int GPUDeviceManager::device_count() const { return CudaDriver::device_count(); }
 
 bool GPUDeviceManager::set_cur_device_id(uint32_t device_id) {
@@ -81,6 +101,10 @@ bool GPUDeviceManager::CopyDeviceMemToHost(const HostMemPtr& dst, const DeviceMe
 bool GPUDeviceManager::CopyHostMemToDevice(const DeviceMemPtr& dst, const void* src, size_t size) const {
   return CudaDriver::CopyHostMemToDevice(dst, src, size);
 }
+
+bool GPUDeviceManager::CopyDeviceMemToDevice(const DeviceMemPtr& dst, const void* src, size_t size) const {
+  return CudaDriver::CopyDeviceMemToDevice(dst, src, size);
+}
 }  // namespace gpu
 }  // namespace device
 }  // namespace mindspore
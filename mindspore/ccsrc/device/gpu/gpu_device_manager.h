@@ -20,6 +20,7 @@
 #include <cudnn.h>
 #include <cublas_v2.h>
 #include <memory>
+#include <vector>
 #include "device/gpu/cuda_driver.h"
 #include "device/gpu/gpu_memory_allocator.h"
 
@@ -37,11 +38,16 @@ class GPUDeviceManager {
   bool is_device_id_init() const;
 
   const DeviceStream& default_stream() const;
+  // Create one more stream, which is destroyed with the device
+  bool CreateStream(DeviceStream* stream);
+  // Bind the cuDNN and cuBLAS handles to the stream of the kernels launched next
+  void SetHandleStream(const DeviceStream& stream);
   const cudnnHandle_t& GetCudnnHandle() const;
   const cublasHandle_t& GetCublasHandle() const;
 
   bool CopyDeviceMemToHost(const HostMemPtr& dst, const DeviceMemPtr& src, size_t size) const;
   bool CopyHostMemToDevice(const DeviceMemPtr& dst, const void* src, size_t size) const;
+  bool CopyDeviceMemToDevice(const DeviceMemPtr& dst, const void* src, size_t size) const;
   bool SyncStream(const DeviceStream& stream) const;
 
   static GPUDeviceManager& GetInstance() {
@@ -58,6 +64,9 @@ class GPUDeviceManager {
   // default cuda stream used for all the kernels.
   DeviceStream stream_{nullptr};
 
+  // the other streams, such as the communication stream.
+  std::vector<DeviceStream> gpu_streams_;
+
   // handle used for cudnn kernels.
   cudnnHandle_t cudnn_handle_{nullptr};
 
@@ -28,6 +28,7 @@ namespace device {
 namespace gpu {
 namespace py = pybind11;
 void GpuBuild(const KernelGraphPtr &kernel_graph) {
+  kernel::UnpackKernelBundle(kernel::kGpuKernelMeta);
   kernel::KernelMeta *bin_map = kernel::KernelMeta::GetInstance();
   if (!bin_map->ReadIndex(kernel::kGpuKernelMeta)) {
     MS_LOG(INFO) << "kernel cache miss, cache directory will be created later.";
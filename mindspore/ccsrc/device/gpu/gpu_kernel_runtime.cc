@@ -15,14 +15,19 @@
  */
 
 #include "device/gpu/gpu_kernel_runtime.h"
+#include <algorithm>
+#include <set>
 #include "device/gpu/gpu_device_address.h"
 #include "device/gpu/cuda_driver.h"
 #include "device/gpu/gpu_buffer_mgr.h"
 #include "device/gpu/gpu_device_manager.h"
 #include "device/gpu/gpu_memory_allocator.h"
+#include "device/gpu/gpu_stream_assign.h"
 #include "device/gpu/distribution/collective_init.h"
 #include "utils/convert_utils.h"
 #include "utils/context/ms_context.h"
+#include "utils/metrics.h"
+#include "utils/timeline.h"
 #include "device/kernel_runtime_manager.h"
 #include "device/gpu/gpu_common.h"
 #include "common/utils.h"
@@ -30,6 +35,15 @@
 namespace mindspore {
 namespace device {
 namespace gpu {
+namespace {
+const std::set<std::string> kCommunicationOpSet = {kAllReduceOpName, kAllGatherOpName, kReduceScatterOpName};
+// the first run lets the kernels finish their lazy initializations before the capture
+constexpr size_t kCudaGraphCaptureRun = 2;
+// the kernels reading the host data or talking to the other devices at each launch
+const std::set<std::string> kUncapturedOpSet = {kGetNextOpName, kAllReduceOpName, kAllGatherOpName,
+                                                kReduceScatterOpName};
+}  // namespace
+
 bool GPUKernelRuntime::SyncStream() { return GPUDeviceManager::GetInstance().SyncStream(stream_); }
 
 bool GPUKernelRuntime::Init() {
@@ -56,14 +70,7 @@ bool GPUKernelRuntime::Init() {
     MallocDeviceMemory();
   }
 
-  const void *collective_handle_ = CollectiveInitializer::instance().collective_handle();
-  bool collective_inited = CollectiveInitializer::instance().collective_inited();
-  if (collective_inited && collective_handle_ != nullptr) {
-    auto init_nccl_comm_funcptr =
-      reinterpret_cast<InitNCCLComm>(dlsym(const_cast<void *>(collective_handle_), "InitNCCLComm"));
-    MS_EXCEPTION_IF_NULL(init_nccl_comm_funcptr);
-    (*init_nccl_comm_funcptr)();
-  }
+  // The nccl communicator is not created here, the first collective kernel launched creates it.
   device_init_ = true;
   return ret;
 }
@@ -98,6 +105,7 @@ bool GPUKernelRuntime::InitDevice() {
     MS_LOG(ERROR) << "No default CUDA stream found.";
     return false;
   }
+  handle_stream_ = stream_;
   return true;
 }
 
@@ -121,6 +129,8 @@ void GPUKernelRuntime::ReleaseDeviceRes() {
     }
     CHECK_OP_RET_WITH_EXCEPT(GpuBufferMgr::GetInstance().Destroy(), "Could not destroy gpu data queue.");
   }
+  ReleaseStreamResource();
+  ReleaseCudaGraphs();
   GPUDeviceManager::GetInstance().ReleaseDevice();
   if (device_mem_base_ != nullptr) {
     if (!GPUMemoryAllocator::GetInstance().FreeDeviceMem(device_mem_base_)) {
@@ -137,6 +147,9 @@ void *GPUKernelRuntime::AllocTensorMemDynamic(size_t size) {
 }
 
 void GPUKernelRuntime::FreeTensorMemDynamic(void *device_ptr) {
+  if (mem_timeline_ != nullptr) {
+    mem_timeline_->Free(device_ptr);
+  }
   GPUMemoryAllocator::GetInstance().FreeTensorMem(device_ptr);
 }
 
@@ -146,10 +159,16 @@ void GPUKernelRuntime::AssignMemory(session::KernelGraph *graph) {
   AssignStaticMemory(graph);
   bool is_enable_mem_reuse = context_ptr->enable_mem_reuse();
   bool is_enable_dynamic_mem = context_ptr->enable_dynamic_mem_pool();
-  if (is_enable_dynamic_mem) {
+  if (is_enable_dynamic_mem && is_enable_mem_reuse && context_ptr->enable_graph_static_memory()) {
+    // Use the memory reuse in one piece of the dynamic memory pool.
+    (void)static_mem_graphs_.insert(graph->graph_id());
+    ReuseAssignDynamicMemory(graph);
+  } else if (is_enable_dynamic_mem) {
     // Use the dynamic memory pool.
+    (void)static_mem_graphs_.erase(graph->graph_id());
     InitKernelRefCount(graph);
     InitKernelOutputAddress(graph);
+    InitKernelStreams(graph);
   } else if (is_enable_mem_reuse) {
     // Use the memory reuse.
     ReuseAssignDynamicMemory(graph);
@@ -157,17 +176,23 @@ void GPUKernelRuntime::AssignMemory(session::KernelGraph *graph) {
     // Normal way.
     AssignDynamicMemory(graph);
   }
+  ResetLaunchPlan(graph);
 }
 
 bool GPUKernelRuntime::Run(session::KernelGraph *graph) {
   bool ret;
   auto context_ptr = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context_ptr);
-  bool is_enable_dynamic_mem = context_ptr->enable_dynamic_mem_pool();
+  bool is_enable_dynamic_mem = IsDynamicMemGraph(graph);
   struct timeval start_time, end_time;
   (void)gettimeofday(&start_time, nullptr);
   if (is_enable_dynamic_mem) {
     ret = LaunchKernelDynamic(graph);
+  } else if (context_ptr->enable_cuda_graph() && !StepStats::GetInstance().started()) {
+    // the step stats time the kernels one by one, which the replay of a cuda graph doesn't
+    ret = LaunchKernelGraph(graph);
+  } else if (IsAsyncRun()) {
+    ret = LaunchKernelMod(*graph);
   } else {
     ret = LaunchKernel(graph);
   }
@@ -179,6 +204,118 @@ bool GPUKernelRuntime::Run(session::KernelGraph *graph) {
   return ret;
 }
 
+bool GPUKernelRuntime::RunSteps(session::KernelGraph *graph, size_t steps) {
+  bool ret = true;
+  for (size_t step = 0; ret && step < steps; ++step) {
+    async_step_ = step + 1 < steps;
+    ret = Run(graph);
+  }
+  async_step_ = false;
+  if (!ret) {
+    MS_LOG(ERROR) << "Run the steps of graph " << graph->graph_id() << " failed.";
+    // the failed step may leave the launched ones running
+    (void)SyncAllStreams();
+  }
+  return ret;
+}
+
+bool GPUKernelRuntime::LaunchKernelGraph(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto &graph_info = cuda_graphs_[graph->graph_id()];
+  if (graph_info.graph_exec == nullptr) {
+    if (!graph_info.capturable || ++graph_info.run_count < kCudaGraphCaptureRun) {
+      return LaunchKernel(graph);
+    }
+    if (!IsCudaGraphCapturable(graph) || !CaptureCudaGraph(graph, &graph_info.graph_exec)) {
+      graph_info.capturable = false;
+      graph_info.graph_exec = nullptr;
+      MS_LOG(WARNING) << "Graph " << graph->graph_id() << " is not captured, launch its kernels one by one.";
+      return LaunchKernel(graph);
+    }
+    MS_LOG(INFO) << "Capture " << graph->execution_order().size() << " kernels of graph " << graph->graph_id()
+                 << " into a CUDA graph.";
+  }
+  if (!CudaDriver::LaunchGraph(graph_info.graph_exec, stream_)) {
+    MS_LOG(ERROR) << "Launch the CUDA graph failed.";
+    return false;
+  }
+  if (!SyncStream()) {
+    MS_LOG(ERROR) << "SyncStream failed.";
+    return false;
+  }
+  return true;
+}
+
+bool GPUKernelRuntime::IsCudaGraphCapturable(const session::KernelGraph *graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto &kernels = graph->execution_order();
+  return std::none_of(kernels.begin(), kernels.end(), [](const CNodePtr &kernel) {
+    return kUncapturedOpSet.find(AnfAlgo::GetCNodeName(kernel)) != kUncapturedOpSet.end();
+  });
+}
+
+bool GPUKernelRuntime::CaptureCudaGraph(const session::KernelGraph *graph, DeviceGraphExec *graph_exec) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(graph_exec);
+  if (!CudaDriver::BeginStreamCapture(stream_)) {
+    return false;
+  }
+  bool launched = false;
+  try {
+    launched = LaunchKernelMod(*graph);
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "A kernel can not be captured: " << e.what();
+  }
+  // the capture is ended anyway, to get the stream out of the capture mode
+  if (!CudaDriver::EndStreamCapture(stream_, graph_exec)) {
+    return false;
+  }
+  if (!launched) {
+    (void)CudaDriver::DestroyGraph(*graph_exec);
+    return false;
+  }
+  return true;
+}
+
+void GPUKernelRuntime::ReleaseCudaGraphs() {
+  for (auto &iter : cuda_graphs_) {
+    if (iter.second.graph_exec != nullptr) {
+      CHECK_OP_RET_WITH_ERROR(CudaDriver::DestroyGraph(iter.second.graph_exec), "Failed to destroy CUDA graph.");
+    }
+  }
+  cuda_graphs_.clear();
+}
+
+bool GPUKernelRuntime::IsAsyncRun() const {
+  if (async_step_) {
+    return true;
+  }
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // the copies to the host by cudaMemcpy wait for the kernels on the blocking streams, so the outputs of the single
+  // ops are read after they're done
+  return context_ptr->enable_pynative_infer() && context_ptr->enable_pynative_async();
+}
+
+bool GPUKernelRuntime::IsDynamicMemGraph(const session::KernelGraph *graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  return context_ptr->enable_dynamic_mem_pool() && static_mem_graphs_.count(graph->graph_id()) == 0;
+}
+
+uint8_t *GPUKernelRuntime::MallocDynamicMem(size_t size, bool communication_mem) {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // the memory planned for a graph is kept from the pool as long as the graph
+  if (context_ptr->enable_dynamic_mem_pool()) {
+    auto device_ptr = AllocTensorMemDynamic(size);
+    MS_EXCEPTION_IF_NULL(device_ptr);
+    return AddressOffset(device_ptr, 0);
+  }
+  return KernelRuntime::MallocDynamicMem(size, communication_mem);
+}
+
 uint8_t *GPUKernelRuntime::MallocStaticMem(size_t size, bool) {
   auto context_ptr = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(context_ptr);
@@ -241,31 +378,290 @@ void GPUKernelRuntime::InitKernelOutputAddress(const session::KernelGraph *graph
 
 bool GPUKernelRuntime::LaunchKernelDynamic(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
+  if (MsContext::GetInstance()->save_graphs_flag() && mem_timeline_graphs_.insert(graph->graph_id()).second) {
+    mem_timeline_ = std::make_shared<memreuse::MemTimeline>("dynamic");
+  }
   // The inputs and outputs memory of communication kernel are special, so separate processing.
   AllocCommunicationOpDynamicRes(graph);
 
   auto &kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  // the single op graphs are not assigned by AssignMemory
+  auto iter = graph_kernel_streams_.find(graph->graph_id());
+  if (iter == graph_kernel_streams_.end() || iter->second.size() != kernels.size()) {
+    InitKernelStreams(graph);
+    iter = graph_kernel_streams_.find(graph->graph_id());
+  }
+  auto &kernel_streams = iter->second;
+  auto &timeline = Timeline::GetInstance();
+  auto &step_stats = StepStats::GetInstance();
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    auto &kernel = kernels[i];
     auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
     MS_EXCEPTION_IF_NULL(kernel_mod);
+    FreePendingMem(false);
     AddressPtrList kernel_inputs;
     AddressPtrList kernel_workspaces;
     AddressPtrList kernel_outputs;
     AllocKernelDynamicRes(*kernel_mod, kernel, &kernel_inputs, &kernel_workspaces, &kernel_outputs);
-    if (!kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, reinterpret_cast<uintptr_t>(stream_))) {
+    if (mem_timeline_ != nullptr) {
+      mem_timeline_->RecordKernel(kernel->fullname_with_scope());
+    }
+    uint64_t start_us = 0;
+    if (timeline.started() || step_stats.started()) {
+      // the streams are synchronized around the kernel, so that its span is the time it runs on the device
+      (void)SyncAllStreams();
+      start_us = Timeline::NowUs();
+    }
+    if (!LaunchKernelOnStream(kernel_mod, kernel_streams[i], kernel_inputs, kernel_workspaces, kernel_outputs)) {
       MS_LOG(ERROR) << "Launch kernel failed.";
+      mem_timeline_ = nullptr;
       return false;
     }
+    if (start_us != 0) {
+      (void)SyncAllStreams();
+      auto end_us = Timeline::NowUs();
+      if (timeline.started()) {
+        auto track = kernel_streams[i].stream == communication_stream_
+                       ? std::string("GPU communication stream")
+                       : "GPU stream " + std::to_string(AnfAlgo::GetStreamId(kernel));
+        timeline.Record(kernel->fullname_with_scope(), "gpu_kernel", start_us, end_us, track);
+      }
+      if (step_stats.started()) {
+        step_stats.Add(KernelStepPhase(kernel), end_us - start_us);
+      }
+    }
     FreeKernelDynamicRes(kernel, kernel_workspaces);
   }
+  if (mem_timeline_ != nullptr) {
+    (void)mem_timeline_->Save(memreuse::MemTimelineFilePath("dynamic", graph->graph_id()));
+    mem_timeline_ = nullptr;
+  }
 
-  if (!SyncStream()) {
+  if (IsAsyncRun()) {
+    FreePendingMem(false);
+    return true;
+  }
+  if (!SyncAllStreams()) {
     MS_LOG(ERROR) << "SyncStream failed.";
     return false;
   }
+  FreePendingMem(true);
+  ObserveCommunicationTime(kernel_streams);
   return true;
 }
 
+void GPUKernelRuntime::ObserveCommunicationTime(const std::vector<KernelStreamInfo> &kernel_streams) {
+  static auto allreduce_time = MetricsRegistry::GetInstance().GetHistogram(
+    "mindspore_allreduce_time_us", "The device time of the communication kernels in microseconds.");
+  const float kUSecondInMSecond = 1000;
+  for (auto &stream_info : kernel_streams) {
+    float milliseconds = 0;
+    if (stream_info.time_start_event != nullptr &&
+        CudaDriver::ElapsedTime(&milliseconds, stream_info.time_start_event, stream_info.time_end_event)) {
+      allreduce_time->Observe(static_cast<int64_t>(milliseconds * kUSecondInMSecond));
+    }
+  }
+}
+
+void GPUKernelRuntime::InitKernelStreams(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto &kernels = graph->execution_order();
+  std::unordered_set<AnfNodePtr> kernel_set(kernels.begin(), kernels.end());
+  std::unordered_map<AnfNodePtr, size_t> kernel_index;
+  std::vector<KernelStreamInfo> kernel_streams(kernels.size());
+  // the last kernel launched on each stream
+  std::unordered_map<DeviceStream, size_t> last_kernels;
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(kernels[i]);
+    kernel_index[kernels[i]] = i;
+    auto &stream_info = kernel_streams[i];
+    stream_info.stream = GetKernelStream(kernels[i]);
+    if (stream_info.stream != stream_) {
+      stream_info.default_stream_event = CreateEvent();
+    }
+    if (stream_info.stream == communication_stream_) {
+      stream_info.time_start_event = CreateEvent(false);
+      stream_info.time_end_event = CreateEvent(false);
+    }
+    auto wait_kernel = [this, &kernel_streams, &stream_info](size_t input_idx) {
+      // the kernels not on stream_ have waited for stream_ already
+      auto &input_info = kernel_streams[input_idx];
+      if (input_info.stream == stream_info.stream || input_info.stream == stream_) {
+        return;
+      }
+      if (input_info.event == nullptr) {
+        input_info.event = CreateEvent();
+      }
+      auto &wait_events = stream_info.wait_events;
+      if (std::find(wait_events.begin(), wait_events.end(), input_info.event) == wait_events.end()) {
+        wait_events.push_back(input_info.event);
+      }
+    };
+    for (auto &input_kernel : GetInputKernels(kernels[i], kernel_set)) {
+      auto index_iter = kernel_index.find(input_kernel);
+      if (index_iter != kernel_index.end()) {
+        wait_kernel(index_iter->second);
+      }
+    }
+    // the kernels with side effects wait for all the streams, as in the serial launch
+    if (stream_info.stream == stream_ && IsDefaultStreamKernel(graph, kernels[i])) {
+      for (auto &iter : last_kernels) {
+        wait_kernel(iter.second);
+      }
+    }
+    last_kernels[stream_info.stream] = i;
+  }
+  graph_kernel_streams_[graph->graph_id()] = kernel_streams;
+}
+
+DeviceStream GPUKernelRuntime::GetKernelStream(const CNodePtr &kernel) {
+  if (kCommunicationOpSet.find(AnfAlgo::GetCNodeName(kernel)) != kCommunicationOpSet.end()) {
+    if (communication_stream_ == nullptr) {
+      CHECK_OP_RET_WITH_EXCEPT(GPUDeviceManager::GetInstance().CreateStream(&communication_stream_),
+                               "Failed to create the communication stream.");
+    }
+    return communication_stream_;
+  }
+  auto stream_id = AnfAlgo::GetStreamId(kernel);
+  if (stream_id == 0) {
+    return stream_;
+  }
+  auto iter = compute_streams_.find(stream_id);
+  if (iter != compute_streams_.end()) {
+    return iter->second;
+  }
+  DeviceStream stream = nullptr;
+  CHECK_OP_RET_WITH_EXCEPT(GPUDeviceManager::GetInstance().CreateStream(&stream),
+                           "Failed to create the compute stream.");
+  compute_streams_[stream_id] = stream;
+  return stream;
+}
+
+DeviceEvent GPUKernelRuntime::CreateEvent(bool disable_timing) {
+  DeviceEvent event = nullptr;
+  CHECK_OP_RET_WITH_EXCEPT(CudaDriver::CreateEvent(&event, disable_timing), "Failed to create CUDA event.");
+  events_.push_back(event);
+  return event;
+}
+
+bool GPUKernelRuntime::LaunchKernelOnStream(mindspore::kernel::KernelMod *kernel_mod,
+                                            const KernelStreamInfo &stream_info, const AddressPtrList &kernel_inputs,
+                                            const AddressPtrList &kernel_workspaces,
+                                            const AddressPtrList &kernel_outputs) {
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  auto stream = stream_info.stream;
+  if (stream_info.default_stream_event != nullptr) {
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::RecordEvent(stream_info.default_stream_event, stream_),
+                             "Failed to record CUDA event.");
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::StreamWaitEvent(stream, stream_info.default_stream_event),
+                             "Failed to wait CUDA event.");
+  }
+  for (auto &event : stream_info.wait_events) {
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::StreamWaitEvent(stream, event), "Failed to wait CUDA event.");
+  }
+  // the cuDNN and cuBLAS kernels run on the stream of their handles
+  if (stream != handle_stream_ && stream != communication_stream_) {
+    GPUDeviceManager::GetInstance().SetHandleStream(stream);
+    handle_stream_ = stream;
+  }
+  if (stream_info.time_start_event != nullptr) {
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::RecordEvent(stream_info.time_start_event, stream),
+                             "Failed to record CUDA event.");
+  }
+  if (!kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, reinterpret_cast<uintptr_t>(stream))) {
+    return false;
+  }
+  if (stream_info.time_end_event != nullptr) {
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::RecordEvent(stream_info.time_end_event, stream),
+                             "Failed to record CUDA event.");
+  }
+  if (stream_info.event != nullptr) {
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::RecordEvent(stream_info.event, stream), "Failed to record CUDA event.");
+  }
+  if (stream != stream_) {
+    RecordMemStream(kernel_inputs, stream);
+    RecordMemStream(kernel_workspaces, stream);
+    RecordMemStream(kernel_outputs, stream);
+  }
+  return true;
+}
+
+void GPUKernelRuntime::RecordMemStream(const AddressPtrList &addresses, const DeviceStream &stream) {
+  for (auto &address : addresses) {
+    if (address != nullptr && address->addr != nullptr) {
+      (void)mem_streams_[address->addr].insert(stream);
+    }
+  }
+}
+
+void GPUKernelRuntime::FreeTensorMemStreamOrdered(void *device_ptr) {
+  auto iter = mem_streams_.find(device_ptr);
+  if (iter == mem_streams_.end()) {
+    // the later kernels on stream_ are ordered after the users, the ones on the other streams wait for stream_
+    FreeTensorMemDynamic(device_ptr);
+    return;
+  }
+  std::vector<DeviceEvent> events;
+  for (auto &stream : iter->second) {
+    DeviceEvent event = nullptr;
+    if (idle_events_.empty()) {
+      event = CreateEvent();
+    } else {
+      event = idle_events_.back();
+      idle_events_.pop_back();
+    }
+    CHECK_OP_RET_WITH_EXCEPT(CudaDriver::RecordEvent(event, stream), "Failed to record CUDA event.");
+    events.push_back(event);
+  }
+  (void)mem_streams_.erase(iter);
+  pending_mems_.emplace_back(device_ptr, events);
+}
+
+void GPUKernelRuntime::FreePendingMem(bool sync) {
+  size_t kept = 0;
+  for (size_t i = 0; i < pending_mems_.size(); ++i) {
+    auto &events = pending_mems_[i].second;
+    if (sync || std::all_of(events.begin(), events.end(), CudaDriver::QueryEvent)) {
+      FreeTensorMemDynamic(pending_mems_[i].first);
+      idle_events_.insert(idle_events_.end(), events.begin(), events.end());
+      continue;
+    }
+    if (kept != i) {
+      pending_mems_[kept] = std::move(pending_mems_[i]);
+    }
+    ++kept;
+  }
+  pending_mems_.resize(kept);
+  if (sync) {
+    mem_streams_.clear();
+  }
+}
+
+bool GPUKernelRuntime::SyncAllStreams() {
+  bool ret = SyncStream();
+  for (auto &iter : compute_streams_) {
+    ret = GPUDeviceManager::GetInstance().SyncStream(iter.second) && ret;
+  }
+  if (communication_stream_ != nullptr) {
+    ret = GPUDeviceManager::GetInstance().SyncStream(communication_stream_) && ret;
+  }
+  return ret;
+}
+
+void GPUKernelRuntime::ReleaseStreamResource() {
+  for (auto &event : events_) {
+    CHECK_OP_RET_WITH_ERROR(CudaDriver::DestroyEvent(event), "Failed to destroy CUDA event.");
+  }
+  events_.clear();
+  idle_events_.clear();
+  pending_mems_.clear();
+  mem_streams_.clear();
+  graph_kernel_streams_.clear();
+  // the streams are destroyed with the device
+  compute_streams_.clear();
+  communication_stream_ = nullptr;
+}
+
 void GPUKernelRuntime::AllocKernelDynamicRes(const mindspore::kernel::KernelMod &kernel_mod,
                                              const mindspore::AnfNodePtr &kernel, AddressPtrList *kernel_inputs,
                                              AddressPtrList *kernel_workspaces, AddressPtrList *kernel_outputs) {
@@ -293,6 +689,9 @@ void GPUKernelRuntime::AllocKernelDynamicRes(const mindspore::kernel::KernelMod
       device_ptr = AllocTensorMemDynamic(output_sizes[i]);
       MS_EXCEPTION_IF_NULL(device_ptr);
       device_address->ptr_ = device_ptr;
+      if (mem_timeline_ != nullptr) {
+        mem_timeline_->Alloc(device_ptr, output_sizes[i], kernel->fullname_with_scope(), false, i);
+      }
     }
     kernel::AddressPtr output = std::make_shared<kernel::Address>();
     MS_EXCEPTION_IF_NULL(output);
@@ -309,6 +708,9 @@ void GPUKernelRuntime::AllocKernelDynamicRes(const mindspore::kernel::KernelMod
     }
     auto device_ptr = AllocTensorMemDynamic(workspace_sizes[i]);
     MS_EXCEPTION_IF_NULL(device_ptr);
+    if (mem_timeline_ != nullptr) {
+      mem_timeline_->Alloc(device_ptr, workspace_sizes[i], kernel->fullname_with_scope(), true, i);
+    }
     kernel::AddressPtr workspace = std::make_shared<kernel::Address>();
     MS_EXCEPTION_IF_NULL(workspace);
     workspace->addr = device_ptr;
@@ -320,13 +722,13 @@ void GPUKernelRuntime::AllocKernelDynamicRes(const mindspore::kernel::KernelMod
 void GPUKernelRuntime::AllocCommunicationOpDynamicRes(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
   auto &kernels = graph->execution_order();
+  // Each fused allreduce is a bucket of the gradients, which is reduced on the communication stream.
   for (auto &kernel : kernels) {
     MS_EXCEPTION_IF_NULL(kernel);
     auto kernel_name = AnfAlgo::GetCNodeName(kernel);
     if (kernel_name == kAllReduceOpName) {
       AllocCommunicationOpInputDynamicRes(kernel);
       AllocCommunicationOpOutputDynamicRes(kernel);
-      return;
     }
   }
 }
@@ -334,7 +736,8 @@ void GPUKernelRuntime::AllocCommunicationOpDynamicRes(const session::KernelGraph
 void GPUKernelRuntime::AllocCommunicationOpInputDynamicRes(const mindspore::AnfNodePtr &kernel) {
   MS_EXCEPTION_IF_NULL(kernel);
   // The reference count of communication kernel input is not 0.
-  if (communication_op_input_ref_count_ != 0) {
+  auto &input_ref_count = communication_op_input_ref_count_[kernel.get()];
+  if (input_ref_count != 0) {
     MS_LOG(ERROR) << "The reference count of communication kernel input is not 0.";
     return;
   }
@@ -356,10 +759,14 @@ void GPUKernelRuntime::AllocCommunicationOpInputDynamicRes(const mindspore::AnfN
 
   auto device_mem_ptr = AllocTensorMemDynamic(total);
   MS_EXCEPTION_IF_NULL(device_mem_ptr);
+  if (mem_timeline_ != nullptr) {
+    // the one piece of the inputs of the communication kernel
+    mem_timeline_->Alloc(device_mem_ptr, total, kernel->fullname_with_scope(), false, 0);
+  }
   for (const auto &iter : addr_size) {
     MS_EXCEPTION_IF_NULL(iter.first);
     iter.first->set_ptr(device_mem_ptr);
-    communication_op_input_ref_count_++;
+    input_ref_count++;
     device_mem_ptr = AddressOffset(device_mem_ptr, iter.second);
   }
 }
@@ -367,7 +774,8 @@ void GPUKernelRuntime::AllocCommunicationOpInputDynamicRes(const mindspore::AnfN
 void GPUKernelRuntime::AllocCommunicationOpOutputDynamicRes(const mindspore::AnfNodePtr &kernel) {
   MS_EXCEPTION_IF_NULL(kernel);
   // The reference count of communication kernel output is not 0.
-  if (communication_op_output_ref_count_ != 0) {
+  auto &output_ref_count = communication_op_output_ref_count_[kernel.get()];
+  if (output_ref_count != 0) {
     MS_LOG(ERROR) << "The reference count of communication kernel output is not 0.";
     return;
   }
@@ -391,10 +799,14 @@ void GPUKernelRuntime::AllocCommunicationOpOutputDynamicRes(const mindspore::Anf
 
   auto device_mem_ptr = AllocTensorMemDynamic(total);
   MS_EXCEPTION_IF_NULL(device_mem_ptr);
+  if (mem_timeline_ != nullptr) {
+    // the one piece of the outputs of the communication kernel
+    mem_timeline_->Alloc(device_mem_ptr, total, kernel->fullname_with_scope(), false, 0);
+  }
   for (const auto &iter : addr_size) {
     MS_EXCEPTION_IF_NULL(iter.first);
     iter.first->set_ptr(device_mem_ptr);
-    communication_op_output_ref_count_++;
+    output_ref_count++;
     device_mem_ptr = AddressOffset(device_mem_ptr, iter.second);
   }
 }
@@ -421,7 +833,7 @@ void GPUKernelRuntime::FreeKernelDynamicRes(const mindspore::AnfNodePtr &kernel,
         auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i);
         MS_EXCEPTION_IF_NULL(device_address);
         MS_EXCEPTION_IF_NULL(device_address->ptr_);
-        FreeTensorMemDynamic(device_address->ptr_);
+        FreeTensorMemStreamOrdered(device_address->ptr_);
         device_address->ptr_ = nullptr;
       }
     }
@@ -432,7 +844,7 @@ void GPUKernelRuntime::FreeKernelDynamicRes(const mindspore::AnfNodePtr &kernel,
     auto workspace = kernel_workspaces[i];
     if (workspace != nullptr) {
       MS_EXCEPTION_IF_NULL(workspace->addr);
-      FreeTensorMemDynamic(workspace->addr);
+      FreeTensorMemStreamOrdered(workspace->addr);
       workspace->addr = nullptr;
     }
   }
@@ -443,12 +855,13 @@ void GPUKernelRuntime::FreeCommunicationOpDynamicRes(const mindspore::AnfNodePtr
   MS_EXCEPTION_IF_NULL(kernel);
   // The inputs memory of communication kernel is one piece memory, need release together.
   if (AnfAlgo::GetCNodeName(kernel) == kAllReduceOpName) {
-    communication_op_input_ref_count_--;
-    if (communication_op_input_ref_count_ == 0) {
+    auto &input_ref_count = communication_op_input_ref_count_[kernel.get()];
+    input_ref_count--;
+    if (input_ref_count == 0) {
       auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, 0);
       MS_EXCEPTION_IF_NULL(device_address);
       MS_EXCEPTION_IF_NULL(device_address->ptr_);
-      FreeTensorMemDynamic(device_address->ptr_);
+      FreeTensorMemStreamOrdered(device_address->ptr_);
       device_address->ptr_ = nullptr;
     }
     *is_communication_op = true;
@@ -465,12 +878,13 @@ void GPUKernelRuntime::FreeCommunicationOpDynamicRes(const mindspore::AnfNodePtr
   auto kernel_input = AnfAlgo::VisitKernel(input_node, 0);
   // The outputs memory of communication kernel is one piece memory, need release together.
   if (AnfAlgo::GetCNodeName(kernel_input.first) == kAllReduceOpName) {
-    communication_op_output_ref_count_--;
-    if (communication_op_output_ref_count_ == 0) {
+    auto &output_ref_count = communication_op_output_ref_count_[kernel_input.first.get()];
+    output_ref_count--;
+    if (output_ref_count == 0) {
       auto device_address = AnfAlgo::GetMutableOutputAddr(kernel_input.first, 0);
       MS_EXCEPTION_IF_NULL(device_address);
       MS_EXCEPTION_IF_NULL(device_address->ptr_);
-      FreeTensorMemDynamic(device_address->ptr_);
+      FreeTensorMemStreamOrdered(device_address->ptr_);
       device_address->ptr_ = nullptr;
     }
     *is_communication_op = true;
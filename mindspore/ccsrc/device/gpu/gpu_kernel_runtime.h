@@ -21,7 +21,10 @@
 #include <memory>
 #include <vector>
 #include <utility>
+#include <unordered_map>
+#include <unordered_set>
 #include "device/kernel_runtime.h"
+#include "device/gpu/cuda_driver.h"
 #include "device/kernel_runtime_manager.h"
 
 namespace mindspore {
@@ -36,6 +39,8 @@ class GPUKernelRuntime : public KernelRuntime {
   void FreeHostMemory() override;
   void AssignMemory(session::KernelGraph *graph) override;
   bool Run(session::KernelGraph *graph) override;
+  // The steps are ordered by the streams, only the last one syncs them
+  bool RunSteps(session::KernelGraph *graph, size_t steps) override;
 
  protected:
   DeviceAddressPtr CreateDeviceAddress(void *device_ptr, size_t device_size, const string &format,
@@ -47,6 +52,7 @@ class GPUKernelRuntime : public KernelRuntime {
   void FreeTensorMemDynamic(void *device_ptr) override;
   void MallocOpMemory(const DeviceAddressPtr address, size_t size, int flag) override;
   uint8_t *MallocStaticMem(size_t size, bool communication_mem) override;
+  uint8_t *MallocDynamicMem(size_t size, bool communication_mem) override;
 
  private:
   GPUKernelRuntime(const GPUKernelRuntime &);
@@ -54,6 +60,14 @@ class GPUKernelRuntime : public KernelRuntime {
   bool InitDevice();
   void MallocDeviceMemory();
   bool device_init_{false};
+  // Whether the kernels of the graph allocate and free their memory from the dynamic memory pool at each launch
+  bool IsDynamicMemGraph(const session::KernelGraph *graph) const;
+  // the single ops of PyNative mode and the steps of a loop sink but the last return once launched without the sync
+  // of the streams
+  bool IsAsyncRun() const;
+  bool async_step_{false};
+  // the graphs planned by the memory reuse while the dynamic memory pool is enabled
+  std::unordered_set<uint32_t> static_mem_graphs_;
 
   // The related functions and members for using dynamic memory pool.
   void InitKernelRefCount(const session::KernelGraph *graph);
@@ -67,8 +81,66 @@ class GPUKernelRuntime : public KernelRuntime {
   void AllocCommunicationOpOutputDynamicRes(const mindspore::AnfNodePtr &kernel);
   void FreeKernelDynamicRes(const mindspore::AnfNodePtr &kernel, const AddressPtrList &kernel_workspaces);
   void FreeCommunicationOpDynamicRes(const mindspore::AnfNodePtr &kernel, size_t input_idx, bool *is_communication_op);
-  size_t communication_op_input_ref_count_{0};
-  size_t communication_op_output_ref_count_{0};
+  // The inputs and outputs of each communication kernel not freed yet, by the kernel, they are in one piece of memory
+  std::unordered_map<AnfNode *, size_t> communication_op_input_ref_count_;
+  std::unordered_map<AnfNode *, size_t> communication_op_output_ref_count_;
+
+  // The related functions and members for launching the kernels on several streams. The communication kernels are
+  // on their own stream, the others on the compute streams by their stream ids, stream_ is the compute stream 0.
+  // The memory is allocated in the execution order; the memory used only on stream_ is freed at once, the memory
+  // used on the other streams is freed after the events recorded on them have passed. The kernels on the other
+  // streams wait for stream_ before they start, so they never use the memory stream_ is still using.
+  struct KernelStreamInfo {
+    DeviceStream stream{nullptr};
+    // recorded after the kernel, for the kernels on the other streams using its outputs
+    DeviceEvent event{nullptr};
+    // recorded on stream_ before the kernel, if the kernel is not on stream_
+    DeviceEvent default_stream_event{nullptr};
+    std::vector<DeviceEvent> wait_events;
+    // recorded around the communication kernel, to time it on the device
+    DeviceEvent time_start_event{nullptr};
+    DeviceEvent time_end_event{nullptr};
+  };
+  void InitKernelStreams(const session::KernelGraph *graph);
+  DeviceStream GetKernelStream(const CNodePtr &kernel);
+  DeviceEvent CreateEvent(bool disable_timing = true);
+  bool LaunchKernelOnStream(mindspore::kernel::KernelMod *kernel_mod, const KernelStreamInfo &stream_info,
+                            const AddressPtrList &kernel_inputs, const AddressPtrList &kernel_workspaces,
+                            const AddressPtrList &kernel_outputs);
+  void RecordMemStream(const AddressPtrList &addresses, const DeviceStream &stream);
+  // Free the memory once the kernels on all the streams using it have passed
+  void FreeTensorMemStreamOrdered(void *device_ptr);
+  // Free the pending memory whose events have passed, or all of it after the streams are synchronized
+  void FreePendingMem(bool sync);
+  bool SyncAllStreams();
+  // Observe the device time of the communication kernels, whose events have passed after the streams are synchronized
+  void ObserveCommunicationTime(const std::vector<KernelStreamInfo> &kernel_streams);
+  void ReleaseStreamResource();
+  std::unordered_map<uint32_t, std::vector<KernelStreamInfo>> graph_kernel_streams_;
+  std::unordered_map<uint32_t, DeviceStream> compute_streams_;
+  DeviceStream communication_stream_{nullptr};
+  DeviceStream handle_stream_{nullptr};
+  // the streams other than stream_ using the memory in the current run
+  std::unordered_map<void *, std::unordered_set<DeviceStream>> mem_streams_;
+  std::vector<std::pair<void *, std::vector<DeviceEvent>>> pending_mems_;
+  std::vector<DeviceEvent> idle_events_;
+  std::vector<DeviceEvent> events_;
+  // the memory timeline of the dynamic memory pool recorded in the first run of a graph, if the graphs are saved
+  std::shared_ptr<memreuse::MemTimeline> mem_timeline_{nullptr};
+  std::unordered_set<uint32_t> mem_timeline_graphs_;
+
+  // The related functions and members for replaying the kernels of a graph with a CUDA graph. The addresses of the
+  // kernels are fixed by the static memory, so the launches captured at the second run are replayed in the later runs.
+  struct CudaGraphInfo {
+    size_t run_count{0};
+    bool capturable{true};
+    DeviceGraphExec graph_exec{nullptr};
+  };
+  bool LaunchKernelGraph(const session::KernelGraph *graph);
+  bool IsCudaGraphCapturable(const session::KernelGraph *graph) const;
+  bool CaptureCudaGraph(const session::KernelGraph *graph, DeviceGraphExec *graph_exec);
+  void ReleaseCudaGraphs();
+  std::unordered_map<uint32_t, CudaGraphInfo> cuda_graphs_;
 };
 MS_REG_KERNEL_RUNTIME(kGPUDevice, GPUKernelRuntime);
 }  // namespace gpu
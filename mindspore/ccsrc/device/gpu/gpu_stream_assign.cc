@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/gpu/gpu_stream_assign.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace gpu {
+namespace {
+// the compute streams, including the default one
+constexpr uint32_t kMaxComputeStreamNum = 4;
+}  // namespace
+
+std::vector<AnfNodePtr> GetInputKernels(const CNodePtr &kernel, const std::unordered_set<AnfNodePtr> &kernel_set) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  std::vector<AnfNodePtr> input_kernels;
+  std::unordered_set<AnfNodePtr> visited;
+  // visited in the order of the inputs
+  std::vector<AnfNodePtr> todo(kernel->inputs().rbegin(), kernel->inputs().rend() - 1);
+  while (!todo.empty()) {
+    auto node = todo.back();
+    todo.pop_back();
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    if (kernel_set.find(node) != kernel_set.end()) {
+      input_kernels.push_back(node);
+    } else if (node->isa<CNode>()) {
+      auto &inputs = node->cast<CNodePtr>()->inputs();
+      todo.insert(todo.end(), inputs.rbegin(), inputs.rend() - 1);
+    }
+  }
+  return input_kernels;
+}
+
+bool IsDefaultStreamKernel(const session::KernelGraph *graph, const CNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto kernel_name = AnfAlgo::GetCNodeName(kernel);
+  if (kOptOpeatorSet.find(kernel_name) != kOptOpeatorSet.end() || kernel_name == kGetNextOpName) {
+    return true;
+  }
+  for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(kernel); ++i) {
+    if (graph->IsInRefOutputMap(std::make_pair(kernel, i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void GPUStreamAssign::AssignStream(const std::shared_ptr<session::KernelGraph> &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto &kernels = graph->execution_order();
+  std::unordered_set<AnfNodePtr> kernel_set(kernels.begin(), kernels.end());
+  std::unordered_map<AnfNodePtr, uint32_t> kernel_streams;
+  // the kernels whose streams are gone on with by one of their users
+  std::unordered_set<AnfNodePtr> continued;
+  uint32_t branch_num = 0;
+  stream_num_ = 1;
+  for (auto &kernel : kernels) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    uint32_t stream_id = 0;
+    auto input_kernels = GetInputKernels(kernel, kernel_set);
+    if (!IsDefaultStreamKernel(graph.get(), kernel) && !input_kernels.empty()) {
+      auto iter = std::find_if(input_kernels.begin(), input_kernels.end(),
+                               [&continued](const AnfNodePtr &input) { return continued.count(input) == 0; });
+      if (iter != input_kernels.end()) {
+        stream_id = kernel_streams[*iter];
+        (void)continued.insert(*iter);
+      } else {
+        stream_id = branch_num % (kMaxComputeStreamNum - 1) + 1;
+        branch_num++;
+      }
+    }
+    kernel_streams[kernel] = stream_id;
+    stream_num_ = std::max(stream_num_, stream_id + 1);
+    AnfAlgo::SetStreamId(stream_id, kernel.get());
+  }
+  MS_LOG(INFO) << "Assign " << kernels.size() << " kernels of graph " << graph->graph_id() << " to " << stream_num_
+               << " compute streams, branch num: " << branch_num;
+}
+}  // namespace gpu
+}  // namespace device
+}  // namespace mindspore
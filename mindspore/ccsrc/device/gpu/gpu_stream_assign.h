@@ -0,0 +1,53 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_GPU_GPU_STREAM_ASSIGN_H_
+#define MINDSPORE_CCSRC_DEVICE_GPU_GPU_STREAM_ASSIGN_H_
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include "session/kernel_graph.h"
+
+namespace mindspore {
+namespace device {
+namespace gpu {
+// The kernels of the execution order which the kernel waits for: the producers of its inputs, found through the
+// nodes out of the execution order, such as TupleGetItem, MakeTuple, Depend and ControlDepend
+std::vector<AnfNodePtr> GetInputKernels(const CNodePtr &kernel, const std::unordered_set<AnfNodePtr> &kernel_set);
+
+// The kernels with side effects, such as the optimizers writing the parameters in place, are kept on the default
+// stream, and they wait for all the other streams
+bool IsDefaultStreamKernel(const session::KernelGraph *graph, const CNodePtr &kernel);
+
+// Assigns the independent branches of a graph to several compute streams by the stream ids of the kernels, in the
+// execution order. A kernel goes on with the stream of its first input that no kernel has gone on with, a kernel
+// whose inputs are all gone on with starts a new branch on the next stream.
+class GPUStreamAssign {
+ public:
+  GPUStreamAssign() = default;
+  ~GPUStreamAssign() = default;
+  void AssignStream(const std::shared_ptr<session::KernelGraph> &graph);
+  uint32_t stream_num() const { return stream_num_; }
+
+ private:
+  uint32_t stream_num_{1};
+};
+}  // namespace gpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_GPU_GPU_STREAM_ASSIGN_H_
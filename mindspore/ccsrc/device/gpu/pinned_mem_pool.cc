@@ -0,0 +1,78 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/gpu/pinned_mem_pool.h"
+#include <cuda_runtime_api.h>
+#include <chrono>
+#include "device/gpu/gpu_common.h"
+
+namespace mindspore {
+namespace device {
+PinnedMemPool::~PinnedMemPool() {
+  for (auto addr : blocks_) {
+    CHECK_CUDA_RET_WITH_ERROR(cudaFreeHost(addr), "Cuda Free Host Failed");
+  }
+  blocks_.clear();
+  free_blocks_.clear();
+}
+
+bool PinnedMemPool::Init(size_t block_size, size_t num_blocks) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  if (IsInit() || block_size == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < num_blocks; ++i) {
+    void *addr = nullptr;
+    auto ret = cudaHostAlloc(&addr, block_size, cudaHostAllocDefault);
+    if (ret != cudaSuccess) {
+      MS_LOG(WARNING) << "Page locked memory of " << num_blocks << " x " << block_size
+                      << " bytes is not available, pageable memory is used instead: " << cudaGetErrorString(ret);
+      for (auto block : blocks_) {
+        CHECK_CUDA_RET_WITH_ERROR(cudaFreeHost(block), "Cuda Free Host Failed");
+      }
+      blocks_.clear();
+      free_blocks_.clear();
+      return false;
+    }
+    (void)blocks_.insert(addr);
+    free_blocks_.push_back(addr);
+  }
+  block_size_ = block_size;
+  return true;
+}
+
+void *PinnedMemPool::Acquire(unsigned int timeout_in_sec) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  if (!not_empty_cond_.wait_for(locker, std::chrono::seconds(timeout_in_sec),
+                                [this] { return !free_blocks_.empty(); })) {
+    return nullptr;
+  }
+  void *addr = free_blocks_.back();
+  free_blocks_.pop_back();
+  return addr;
+}
+
+bool PinnedMemPool::Release(void *addr) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  if (blocks_.count(addr) == 0) {
+    return false;
+  }
+  free_blocks_.push_back(addr);
+  not_empty_cond_.notify_one();
+  return true;
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_GPU_PINNED_MEM_POOL_H_
+#define MINDSPORE_CCSRC_DEVICE_GPU_PINNED_MEM_POOL_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace mindspore {
+namespace device {
+// A pool of page locked host blocks of the same size. The host data pushed into a GpuQueue is copied to the
+// device asynchronously, which needs page locked memory to overlap with the computation on the device. The blocks
+// are allocated once and reused, instead of allocating host memory for every push.
+class PinnedMemPool {
+ public:
+  PinnedMemPool() : block_size_(0) {}
+  ~PinnedMemPool();
+
+  // Allocates the blocks of the pool. It is called once, before any Acquire.
+  // @param block_size - The size of a block in bytes
+  // @param num_blocks - The number of blocks
+  // @return T/F if the blocks are allocated, the pool is not used if the page locked memory runs out
+  bool Init(size_t block_size, size_t num_blocks);
+
+  inline bool IsInit() const { return block_size_ != 0; }
+  inline size_t block_size() const { return block_size_; }
+
+  // Takes a free block, waiting until one is released.
+  // @param timeout_in_sec - The longest wait
+  // @return The block, nullptr on timeout
+  void *Acquire(unsigned int timeout_in_sec);
+
+  // Gives a block back to the pool. It can be called from any thread.
+  // @param addr - The block
+  // @return T/F if the address is a block of the pool
+  bool Release(void *addr);
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable not_empty_cond_;
+  std::set<void *> blocks_;
+  std::vector<void *> free_blocks_;
+  size_t block_size_;
+
+  PinnedMemPool(const PinnedMemPool &) = delete;
+  PinnedMemPool &operator=(const PinnedMemPool &) = delete;
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_GPU_PINNED_MEM_POOL_H_
@@ -22,6 +22,7 @@
 #include "common/trans.h"
 #include "utils/utils.h"
 #include "utils/context/ms_context.h"
+#include "utils/timeline.h"
 #include "operator/ops.h"
 #include "pipeline/parse/python_adapter.h"
 #include "session/kernel_graph.h"
@@ -32,13 +33,15 @@
 using mindspore::kernel::Address;
 using mindspore::kernel::AddressPtr;
 using mindspore::memreuse::BestFitMemReuse;
+using mindspore::memreuse::MemReuseScheduler;
 using mindspore::memreuse::MemReuseUtilPtr;
+using mindspore::memreuse::MemTimeline;
+using mindspore::memreuse::StaticMemPlanner;
 
 namespace mindspore {
 namespace device {
 KernelRuntime::~KernelRuntime() {
   device_mem_base_ = nullptr;
-  device_mem_pool_base_ = nullptr;
 #ifdef ENABLE_DUMP_E2E
   dump_conf_ptr_ = nullptr;
 #endif
@@ -128,11 +131,13 @@ void KernelRuntime::AssignMemory(session::KernelGraph *graph) {
     AssignDynamicMemory(graph);
   }
   UpdateRefNodeOutputMem(graph);
+  ResetLaunchPlan(graph);
 }
 
 void KernelRuntime::RunOpAssignMemory(const std::vector<tensor::TensorPtr> &input_tensors,
                                       const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
+  (void)launch_plans_.erase(graph);
   // assign memory for input nodes
   RunOpAssignInputMemory(input_tensors, graph);
   for (const auto &cnode : graph->execution_order()) {
@@ -460,15 +465,49 @@ void KernelRuntime::AssignDynamicMemory(const session::KernelGraph *graph) {
 void KernelRuntime::ReuseAssignDynamicMemory(session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
   dynamic_mem_offset_ = 0;
+  // reorder the kernels for a lower peak before the reuse infos are taken from the execution order
+  MemReuseScheduler mem_reuse_scheduler;
+  mem_reuse_scheduler.Schedule(graph);
   MemReuseUtilPtr mem_reuse_util_ptr = std::make_shared<memreuse::MemReuseUtil>();
   MS_EXCEPTION_IF_NULL(mem_reuse_util_ptr);
   // set all infos
   mem_reuse_util_ptr->SetAllInfo(graph);
+  // the swaps split the lifetimes of the swapped tensors before the reuse
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  MemSwapManagerPtr mem_swap_manager = nullptr;
+  (void)mem_swap_managers_.erase(graph);
+  if (context_ptr->enable_mem_swap()) {
+    if (SupportMemSwap()) {
+      mem_swap_manager = std::make_shared<MemSwapManager>();
+      mem_swap_manager->Plan(graph, mem_reuse_util_ptr.get());
+    } else {
+      MS_LOG(WARNING) << "The memory swap is not supported by the device or the task sink, it is disabled.";
+    }
+  }
+  // plan before the best fit reuse, which consumes the refcounts
+  std::shared_ptr<MemTimeline> mem_timeline = nullptr;
+  if (context_ptr->save_graphs_flag()) {
+    mem_timeline = std::make_shared<MemTimeline>("static");
+    mem_timeline->InitStatic(mem_reuse_util_ptr.get());
+  }
+  auto static_mem_planner = std::make_shared<StaticMemPlanner>();
+  MS_EXCEPTION_IF_NULL(static_mem_planner);
+  static_mem_planner->Plan(mem_reuse_util_ptr.get());
   auto bestfit_mem_reuse = std::make_shared<BestFitMemReuse>();
   MS_EXCEPTION_IF_NULL(bestfit_mem_reuse);
   bestfit_mem_reuse->Reuse(mem_reuse_util_ptr.get());
   size_t total_allocated_size = bestfit_mem_reuse->GetAllocatedSize();
+  MS_LOG(INFO) << "BestFitReuseSize [" << total_allocated_size << "], StaticPlanSize ["
+               << static_mem_planner->planned_size() << "], LowerBound [" << static_mem_planner->lower_bound() << "]";
+  if (static_mem_planner->planned_size() < total_allocated_size) {
+    static_mem_planner->Apply();
+    total_allocated_size = static_mem_planner->planned_size();
+  }
   MS_LOG(INFO) << "TotalReuseDynamicSize [" << total_allocated_size << "]";
+  if (mem_timeline != nullptr) {
+    (void)mem_timeline->Save(memreuse::MemTimelineFilePath("static", graph->graph_id()));
+  }
   auto base_ptr = MallocDynamicMem(total_allocated_size, false);
   reuse_mem_base_ = base_ptr;
   mem_reuse_util_ptr_ = mem_reuse_util_ptr;
@@ -477,6 +516,24 @@ void KernelRuntime::ReuseAssignDynamicMemory(session::KernelGraph *graph) {
     AssignNodeOutputMem(kReuseDynamicMem, kernel, kGetAllOuts);
     AssignReuseWorkSpaceMem(kernel);
   }
+  if (mem_swap_manager != nullptr && !mem_swap_manager->empty()) {
+    InitMemSwap(graph, mem_swap_manager);
+  }
+}
+
+void KernelRuntime::InitMemSwap(const session::KernelGraph *graph, const MemSwapManagerPtr &mem_swap_manager) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(mem_swap_manager);
+  // an event for the swap out and one for the swap in of each tensor
+  if (!InitSwapResource(2 * mem_swap_manager->swaps().size())) {
+    MS_LOG(EXCEPTION) << "Init the swap resource failed!";
+  }
+  auto host_mem_base = MallocSwapHostMem(mem_swap_manager->host_size());
+  if (host_mem_base == nullptr) {
+    MS_LOG(EXCEPTION) << "Malloc the host memory of the swap failed, size [" << mem_swap_manager->host_size() << "]";
+  }
+  mem_swap_manager->Assign(mem_reuse_util_ptr_.get(), reuse_mem_base_, host_mem_base);
+  mem_swap_managers_[graph] = mem_swap_manager;
 }
 
 void KernelRuntime::AssignReuseWorkSpaceMem(const AnfNodePtr &node) {
@@ -524,6 +581,24 @@ bool KernelRuntime::IsCommunicationOp(const AnfNodePtr &node) {
   return false;
 }
 
+StepPhase KernelRuntime::KernelStepPhase(const CNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  auto kernel_name = AnfAlgo::GetCNodeName(kernel);
+  if (kernel_name == kGetNextOpName) {
+    return kStepDataWait;
+  }
+  if (IsCommunicationOp(kernel) || kernel_name == kAllGatherOpName || kernel_name == kReduceScatterOpName ||
+      kernel_name == kBroadcastOpName) {
+    return kStepCommunication;
+  }
+  // the kernels of the optimizer cell are in its scope, such as Default/optimizer-Momentum
+  auto full_name = kernel->fullname_with_scope();
+  if (full_name.find("/optimizer-") != std::string::npos || full_name.find("/optimizer/") != std::string::npos) {
+    return kStepOptimizer;
+  }
+  return kStepDeviceCompute;
+}
+
 uint8_t *KernelRuntime::CalDeviceMem(const AnfNodePtr &node, size_t size, int flag, size_t index) {
   MS_EXCEPTION_IF_NULL(node);
   auto context_ptr = MsContext::GetInstance();
@@ -563,51 +638,41 @@ uint8_t *KernelRuntime::CalDeviceMem(const AnfNodePtr &node, size_t size, int fl
   return ptr;
 }
 
-void KernelRuntime::GenLaunchArgs(const mindspore::kernel::KernelMod &kernel_mod, const mindspore::AnfNodePtr &kernel,
-                                  AddressPtrList *kernel_inputs, AddressPtrList *const kernel_workspaces,
-                                  AddressPtrList *kernel_outputs) {
+void KernelRuntime::GenLaunchArgs(const AnfNodePtr &kernel, KernelLaunchInfo *launch_info) {
   MS_EXCEPTION_IF_NULL(kernel);
-  MS_EXCEPTION_IF_NULL(kernel_inputs);
-  MS_EXCEPTION_IF_NULL(kernel_workspaces);
-  MS_EXCEPTION_IF_NULL(kernel_outputs);
+  MS_EXCEPTION_IF_NULL(launch_info);
   auto cnode = kernel->cast<CNodePtr>();
   MS_EXCEPTION_IF_NULL(cnode);
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  launch_info->kernel = cnode;
+  launch_info->kernel_mod = kernel_mod;
   if (AnfAlgo::GetCNodeName(cnode) == kAtomicAddrCleanOpName) {
-    return GenAddrCleanLaunchArgs(cnode, kernel_inputs);
-  }
-  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(kernel); ++i) {
-    auto real_input = AnfAlgo::GetRealInputIndex(kernel, i);
-    auto device_address = AnfAlgo::GetPrevNodeOutputAddr(kernel, real_input);
-    kernel::AddressPtr input = std::make_shared<kernel::Address>();
-    MS_EXCEPTION_IF_NULL(input);
-    input->addr = device_address->ptr_;
-    MS_EXCEPTION_IF_NULL(input->addr);
-    input->size = device_address->size_;
-    kernel_inputs->emplace_back(input);
-  }
-
-  for (size_t i = 0; i < kernel_mod.GetOutputSizeList().size(); ++i) {
-    auto device_address = AnfAlgo::GetOutputAddr(kernel, i);
-    kernel::AddressPtr output = std::make_shared<kernel::Address>();
-    MS_EXCEPTION_IF_NULL(output);
-    output->addr = device_address->ptr_;
-    MS_EXCEPTION_IF_NULL(output->addr);
-    output->size = device_address->size_;
-    kernel_outputs->emplace_back(output);
-  }
-
-  for (size_t i = 0; i < kernel_mod.GetWorkspaceSizeList().size(); ++i) {
-    auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-    kernel::AddressPtr workspace = std::make_shared<kernel::Address>();
-    MS_EXCEPTION_IF_NULL(workspace);
-    workspace->addr = device_address->ptr_;
-    MS_EXCEPTION_IF_NULL(workspace->addr);
-    workspace->size = device_address->size_;
-    kernel_workspaces->emplace_back(workspace);
+    GenAddrCleanLaunchArgs(cnode, launch_info);
+  } else {
+    for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(kernel); ++i) {
+      auto real_input = AnfAlgo::GetRealInputIndex(kernel, i);
+      launch_info->input_addrs.push_back(AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, real_input).get());
+    }
+    for (size_t i = 0; i < kernel_mod->GetOutputSizeList().size(); ++i) {
+      launch_info->output_addrs.push_back(AnfAlgo::GetMutableOutputAddr(kernel, i).get());
+    }
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      launch_info->workspace_addrs.push_back(AnfAlgo::GetWorkspaceAddr(kernel, i));
+    }
   }
+  auto gen_args = [](const std::vector<DeviceAddress *> &addrs, AddressPtrList *args) {
+    for (auto device_address : addrs) {
+      MS_EXCEPTION_IF_NULL(device_address);
+      args->push_back(std::make_shared<kernel::Address>());
+    }
+  };
+  gen_args(launch_info->input_addrs, &launch_info->inputs);
+  gen_args(launch_info->workspace_addrs, &launch_info->workspaces);
+  gen_args(launch_info->output_addrs, &launch_info->outputs);
 }
 
-void KernelRuntime::GenAddrCleanLaunchArgs(const CNodePtr &cnode, AddressPtrList *kernel_inputs) {
+void KernelRuntime::GenAddrCleanLaunchArgs(const CNodePtr &cnode, KernelLaunchInfo *launch_info) {
   if (cnode->inputs().size() != 2) {
     MS_LOG(EXCEPTION) << "atomic Addr clean Node Input nodes not equal 2.";
   }
@@ -616,13 +681,7 @@ void KernelRuntime::GenAddrCleanLaunchArgs(const CNodePtr &cnode, AddressPtrList
   if (AnfAlgo::HasNodeAttr(kAttrAutomicOutputIndexs, pre_node)) {
     auto clean_output_indexs = AnfAlgo::GetNodeAttr<std::vector<size_t>>(pre_node, kAttrAutomicOutputIndexs);
     for (auto index : clean_output_indexs) {
-      auto device_address = AnfAlgo::GetOutputAddr(pre_node, index);
-      kernel::AddressPtr input = std::make_shared<kernel::Address>();
-      MS_EXCEPTION_IF_NULL(input);
-      input->addr = device_address->ptr_;
-      MS_EXCEPTION_IF_NULL(input->addr);
-      input->size = device_address->size_;
-      kernel_inputs->emplace_back(input);
+      launch_info->input_addrs.push_back(AnfAlgo::GetMutableOutputAddr(pre_node, index).get());
     }
     MS_LOG(INFO) << "AtomicAddClean clean output size:" << clean_output_indexs.size();
   }
@@ -630,37 +689,117 @@ void KernelRuntime::GenAddrCleanLaunchArgs(const CNodePtr &cnode, AddressPtrList
   if (AnfAlgo::HasNodeAttr(kAttrAutomicWorkspaceSize, pre_node)) {
     auto clean_workspaces = AnfAlgo::GetNodeAttr<int>(pre_node, kAttrAutomicWorkspaceSize);
     if (clean_workspaces != 0) {
-      auto device_address = AnfAlgo::GetWorkspaceAddr(pre_node, 0);
-      kernel::AddressPtr workspace = std::make_shared<kernel::Address>();
-      MS_EXCEPTION_IF_NULL(workspace);
-      workspace->addr = device_address->ptr_;
-      MS_EXCEPTION_IF_NULL(workspace->addr);
-      workspace->size = device_address->size_;
-      kernel_inputs->emplace_back(workspace);
+      launch_info->input_addrs.push_back(AnfAlgo::GetWorkspaceAddr(pre_node, 0));
     }
     MS_LOG(INFO) << "AtomicAddClean clean workspace size" << clean_workspaces;
   }
 }
 
-bool KernelRuntime::LaunchKernelMod(const session::KernelGraph &graph) {
+void KernelRuntime::UpdateLaunchArgs(KernelLaunchInfo *launch_info) {
+  MS_EXCEPTION_IF_NULL(launch_info);
+  auto update_args = [](const std::vector<DeviceAddress *> &addrs, const AddressPtrList &args) {
+    for (size_t i = 0; i < addrs.size(); ++i) {
+      args[i]->addr = addrs[i]->ptr_;
+      MS_EXCEPTION_IF_NULL(args[i]->addr);
+      args[i]->size = addrs[i]->size_;
+    }
+  };
+  update_args(launch_info->input_addrs, launch_info->inputs);
+  update_args(launch_info->workspace_addrs, launch_info->workspaces);
+  update_args(launch_info->output_addrs, launch_info->outputs);
+}
+
+void KernelRuntime::GenLaunchPlan(const session::KernelGraph &graph, KernelLaunchPlan *launch_plan) {
+  MS_EXCEPTION_IF_NULL(launch_plan);
   auto &kernels = graph.execution_order();
-  for (const auto &kernel : kernels) {
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
+  launch_plan->clear();
+  launch_plan->resize(kernels.size());
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    GenLaunchArgs(kernels[i], &(*launch_plan)[i]);
+  }
+}
+
+void KernelRuntime::ResetLaunchPlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  launch_plans_[graph].clear();
+}
+
+bool KernelRuntime::LaunchSwapBeforeKernel(const MemSwapManager &mem_swap_manager,
+                                           const KernelSwapInfo &kernel_swap_info, AddressPtrList *kernel_inputs) {
+  MS_EXCEPTION_IF_NULL(kernel_inputs);
+  auto &swaps = mem_swap_manager.swaps();
+  for (auto idx : kernel_swap_info.wait_swap_out) {
+    if (!WaitSwapEvent(2 * idx)) {
+      MS_LOG(ERROR) << "Wait for the swap out " << idx << " failed.";
+      return false;
+    }
+  }
+  for (auto idx : kernel_swap_info.swap_in) {
+    auto &swap = swaps[idx];
+    if (!SwapMemAsync(swap.swap_in_ptr, swap.host_ptr, swap.size, false, 2 * idx + 1)) {
+      MS_LOG(ERROR) << "Swap in " << idx << " failed.";
+      return false;
+    }
+  }
+  for (auto idx : kernel_swap_info.wait_swap_in) {
+    if (!WaitSwapEvent(2 * idx + 1)) {
+      MS_LOG(ERROR) << "Wait for the swap in " << idx << " failed.";
+      return false;
+    }
+  }
+  for (auto &item : kernel_swap_info.swap_inputs) {
+    if (item.first >= kernel_inputs->size()) {
+      MS_LOG(EXCEPTION) << "The swapped input index " << item.first << " is out of the input size "
+                        << kernel_inputs->size();
+    }
+    (*kernel_inputs)[item.first]->addr = swaps[item.second].swap_in_ptr;
+  }
+  return true;
+}
 
-    AddressPtrList kernel_inputs;
-    AddressPtrList kernel_workspaces;
-    AddressPtrList kernel_outputs;
-    GenLaunchArgs(*kernel_mod, kernel, &kernel_inputs, &kernel_workspaces, &kernel_outputs);
+bool KernelRuntime::LaunchSwapAfterKernel(const MemSwapManager &mem_swap_manager,
+                                          const KernelSwapInfo &kernel_swap_info) {
+  auto &swaps = mem_swap_manager.swaps();
+  for (auto idx : kernel_swap_info.swap_out) {
+    auto &swap = swaps[idx];
+    if (!SwapMemAsync(swap.host_ptr, swap.device_ptr, swap.size, true, 2 * idx)) {
+      MS_LOG(ERROR) << "Swap out " << idx << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool KernelRuntime::LaunchKernelMod(const session::KernelGraph &graph) {
+  auto &kernels = graph.execution_order();
+  auto swap_iter = mem_swap_managers_.find(&graph);
+  MemSwapManagerPtr mem_swap_manager = swap_iter == mem_swap_managers_.end() ? nullptr : swap_iter->second;
+  KernelLaunchPlan temp_launch_plan;
+  auto plan_iter = launch_plans_.find(&graph);
+  auto &launch_plan = plan_iter == launch_plans_.end() ? temp_launch_plan : plan_iter->second;
+  if (launch_plan.size() != kernels.size()) {
+    GenLaunchPlan(graph, &launch_plan);
+  }
+  for (size_t i = 0; i < launch_plan.size(); ++i) {
+    auto &launch_info = launch_plan[i];
+    auto &kernel = launch_info.kernel;
+    UpdateLaunchArgs(&launch_info);
+    auto kernel_swap_info = mem_swap_manager == nullptr ? nullptr : mem_swap_manager->kernel_swap_info(i);
+    if (kernel_swap_info != nullptr &&
+        !LaunchSwapBeforeKernel(*mem_swap_manager, *kernel_swap_info, &launch_info.inputs)) {
+      return false;
+    }
     struct timeval start_time, end_time;
     (void)gettimeofday(&start_time, nullptr);
-    auto ret =
-      kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, reinterpret_cast<uintptr_t>(stream_));
+    auto ret = launch_info.kernel_mod->Launch(launch_info.inputs, launch_info.workspaces, launch_info.outputs,
+                                              reinterpret_cast<uintptr_t>(stream_));
     if (!ret) {
       MS_LOG(ERROR) << "Launch kernel failed.";
       return false;
     } else {
-      if (AnfAlgo::GetKernelType(kernel) == TBE_KERNEL && !SyncStream()) {
+      // the step stats time all the kernels
+      auto &step_stats = StepStats::GetInstance();
+      if ((AnfAlgo::GetKernelType(kernel) == TBE_KERNEL || step_stats.started()) && !SyncStream()) {
         MS_LOG(EXCEPTION) << "SyncStream failed.";
       }
       (void)gettimeofday(&end_time, nullptr);
@@ -668,6 +807,18 @@ bool KernelRuntime::LaunchKernelMod(const session::KernelGraph &graph) {
       uint64_t cost = kUSecondInSecond * static_cast<uint64_t>(end_time.tv_sec - start_time.tv_sec);
       cost += static_cast<uint64_t>(end_time.tv_usec - start_time.tv_usec);
       MS_LOG(DEBUG) << "d " << kernel->fullname_with_scope() << " in  " << cost << " us";
+      if (step_stats.started()) {
+        step_stats.Add(KernelStepPhase(kernel), cost);
+      }
+      // the spans of the tbe kernels are the time they run, as the stream is synchronized after them
+      auto &timeline = Timeline::GetInstance();
+      if (timeline.started()) {
+        auto end_us = Timeline::NowUs();
+        timeline.Record(kernel->fullname_with_scope(), "device_kernel", end_us - cost, end_us, "device stream");
+      }
+    }
+    if (kernel_swap_info != nullptr && !LaunchSwapAfterKernel(*mem_swap_manager, *kernel_swap_info)) {
+      return false;
     }
   }
   return true;
@@ -732,6 +883,16 @@ uint8_t *KernelRuntime::MallocDynamicMem(size_t size, bool communication_mem) {
   }
 }
 
+bool KernelRuntime::RunSteps(session::KernelGraph *graph, size_t steps) {
+  for (size_t step = 0; step < steps; ++step) {
+    if (!Run(graph)) {
+      MS_LOG(ERROR) << "Run step " << step << " of " << steps << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
 bool KernelRuntime::LaunchKernel(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
   if (!LaunchKernelMod(*graph)) {
@@ -20,9 +20,14 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include "pre_activate/mem_reuse/mem_reuse.h"
 #include "pre_activate/mem_reuse/mem_reuse_allocator.h"
+#include "pre_activate/mem_reuse/mem_reuse_planner.h"
+#include "pre_activate/mem_reuse/mem_reuse_scheduler.h"
+#include "pre_activate/mem_reuse/mem_timeline.h"
 #include "device/device_address.h"
+#include "device/mem_swap_manager.h"
 #include "ir/meta_tensor.h"
 #include "predict/generator/utils/ir_model_util.h"
 #ifdef ENABLE_DUMP_E2E
@@ -32,6 +37,7 @@
 #include "session/anf_runtime_algorithm.h"
 #include "kernel/kernel.h"
 #include "utils/context/ms_context.h"
+#include "utils/step_stats.h"
 
 // using mindspore::session::KernelGraph;
 using mindspore::tensor::Tensor;
@@ -47,6 +53,20 @@ const int kDynamicMem = 1;
 const int kReuseDynamicMem = 2;
 const int kGetAllOuts = -1;
 
+// The launch args of a kernel resolved from the graph once. The device addresses may be rebound between the steps,
+// so the pointers of the args are read from them before each launch.
+struct KernelLaunchInfo {
+  CNodePtr kernel;
+  kernel::KernelMod *kernel_mod{nullptr};
+  std::vector<DeviceAddress *> input_addrs;
+  std::vector<DeviceAddress *> workspace_addrs;
+  std::vector<DeviceAddress *> output_addrs;
+  AddressPtrList inputs;
+  AddressPtrList workspaces;
+  AddressPtrList outputs;
+};
+using KernelLaunchPlan = std::vector<KernelLaunchInfo>;
+
 class KernelRuntime {
  public:
   KernelRuntime() = default;
@@ -55,6 +75,8 @@ class KernelRuntime {
   virtual void AssignMemory(session::KernelGraph *graph);
   void RunOpAssignMemory(const std::vector<tensor::TensorPtr> &input_tensors, const session::KernelGraph *graph);
   virtual bool Run(session::KernelGraph *graph);
+  // Run the graph for the steps of the loop sink in turn
+  virtual bool RunSteps(session::KernelGraph *graph, size_t steps);
   virtual bool DumpData(session::KernelGraph *graph);
   virtual bool RunTask(const session::KernelGraph *graph);
   virtual bool GenTask(const session::KernelGraph *graph);
@@ -84,12 +106,14 @@ class KernelRuntime {
   void UpdateRefNodeOutputMem(const session::KernelGraph *graph);
   void UpdateCommunicationOpInputMem(const AnfNodePtr &node);
   bool IsCommunicationOp(const AnfNodePtr &node);
+  // the phase of a step the time of the kernel is added to
+  StepPhase KernelStepPhase(const CNodePtr &kernel);
   size_t GetCommonAlignSize(size_t input_size) const;
   size_t GetCommunicationAlignSize(size_t input_size) const;
 
   uint8_t *CalDeviceMem(const AnfNodePtr &node, size_t size, int flag, size_t index);
   virtual uint8_t *MallocStaticMem(size_t size, bool communication_mem);
-  uint8_t *MallocDynamicMem(size_t size, bool communication_mem);
+  virtual uint8_t *MallocDynamicMem(size_t size, bool communication_mem);
 #ifdef ENABLE_DUMP_E2E
   bool SetDumpConf();
 #endif
@@ -98,14 +122,35 @@ class KernelRuntime {
   // Free memory use the dynamic memory pool.
   virtual void FreeTensorMemDynamic(void *device_ptr);
   virtual void MallocOpMemory(const DeviceAddressPtr address, size_t size, int flag);
+  // The swap of the dynamic memory to the host, for GPU and D to impl
+  virtual bool SupportMemSwap() const { return false; }
+  virtual bool InitSwapResource(size_t /*event_num*/) { return false; }
+  virtual uint8_t *MallocSwapHostMem(size_t /*size*/) { return nullptr; }
+  // Copy on the swap stream after the kernels launched before, then record the event on the swap stream
+  virtual bool SwapMemAsync(void * /*dst*/, const void * /*src*/, size_t /*size*/, bool /*to_host*/,
+                            size_t /*event_id*/) {
+    return false;
+  }
+  // The kernels launched after it wait for the event recorded on the swap stream
+  virtual bool WaitSwapEvent(size_t /*event_id*/) { return false; }
+  // Launch the kernels of the graph in the execution order without the sync of the stream
+  bool LaunchKernelMod(const session::KernelGraph &graph);
+  // The launch plan of the graph is built by its first launch after the memory is assigned, the graphs of the single
+  // ops don't keep one as their input addresses are replaced by each run
+  void ResetLaunchPlan(const session::KernelGraph *graph);
+  // Fill the args by the current pointers of the device addresses
+  static void UpdateLaunchArgs(KernelLaunchInfo *launch_info);
 
  private:
   void AssignStaticMemoryOutput(const session::KernelGraph *graph);
   void AssignStaticMemoryValueNode(session::KernelGraph *graph);
-  void GenLaunchArgs(const mindspore::kernel::KernelMod &kernel_mod, const AnfNodePtr &kernel,
-                     AddressPtrList *kernel_inputs, AddressPtrList *kernel_workspaces, AddressPtrList *kernel_outputs);
-  bool LaunchKernelMod(const session::KernelGraph &graph);
-  void GenAddrCleanLaunchArgs(const CNodePtr &cnode, AddressPtrList *kernel_inputs);
+  void GenLaunchArgs(const AnfNodePtr &kernel, KernelLaunchInfo *launch_info);
+  void GenLaunchPlan(const session::KernelGraph &graph, KernelLaunchPlan *launch_plan);
+  void InitMemSwap(const session::KernelGraph *graph, const MemSwapManagerPtr &mem_swap_manager);
+  bool LaunchSwapBeforeKernel(const MemSwapManager &mem_swap_manager, const KernelSwapInfo &kernel_swap_info,
+                              AddressPtrList *kernel_inputs);
+  bool LaunchSwapAfterKernel(const MemSwapManager &mem_swap_manager, const KernelSwapInfo &kernel_swap_info);
+  void GenAddrCleanLaunchArgs(const CNodePtr &cnode, KernelLaunchInfo *launch_info);
   size_t CountNodeDeviceMemorySize(const AnfNodePtr &node, size_t output_index);
   void RunOpAssignInputMemory(const std::vector<tensor::TensorPtr> &input_tensors, const session::KernelGraph *graph);
   void RunOpAssignOutputMemory(const AnfNodePtr &kernel);
@@ -115,9 +160,7 @@ class KernelRuntime {
  protected:
   uint32_t device_id_{0};
   uint8_t *device_mem_base_{nullptr};
-  uint8_t *device_mem_pool_base_{nullptr};
   uint64_t device_mem_size_{0};
-  uint64_t device_mem_pool_size_{0};
   uint64_t dynamic_mem_offset_{0};
   uint64_t static_mem_offset_{0};
   const uint64_t mem_align_size_ = 512;
@@ -128,9 +171,11 @@ class KernelRuntime {
   size_t total_static_size_ = 0;
   size_t total_dynamic_size_ = 0;
   MemReuseUtilPtr mem_reuse_util_ptr_{nullptr};
+  std::unordered_map<const session::KernelGraph *, KernelLaunchPlan> launch_plans_;
 
  private:
   uint8_t *reuse_mem_base_{nullptr};
+  std::unordered_map<const session::KernelGraph *, MemSwapManagerPtr> mem_swap_managers_;
 };
 using KernelRuntimePtr = std::shared_ptr<KernelRuntime>;
 }  // namespace device
@@ -0,0 +1,233 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/mem_swap_manager.h"
+#include <algorithm>
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+using mindspore::memreuse::KernelRefCount;
+using mindspore::memreuse::KernelRefCountPtr;
+using mindspore::memreuse::MemReuseUtil;
+
+namespace mindspore {
+namespace device {
+namespace {
+// a smaller tensor is not worth the transfer
+constexpr size_t kMinSwapSize = 1 << 20;
+// the kernels between the swap out and the next use at least
+constexpr size_t kMinSwapDistance = 16;
+// the swap in is issued so many kernels before the use, for the copy to overlap with them
+constexpr size_t kSwapInAdvance = 4;
+
+size_t AlignHostSize(size_t size) {
+  return (size + memreuse::kDefaultMemAlignSize - 1) / memreuse::kDefaultMemAlignSize * memreuse::kDefaultMemAlignSize;
+}
+}  // namespace
+
+std::set<KernelRefCount *> MemSwapManager::FindUnswappableRefs(const session::KernelGraph *graph,
+                                                               MemReuseUtil *mem_reuse_util_ptr) const {
+  std::set<KernelRefCount *> refs;
+  auto add_output = [&refs, mem_reuse_util_ptr](const AnfNodePtr &kernel, size_t index) {
+    auto iter = mem_reuse_util_ptr->kernel_output_refs_.find(kernel.get());
+    if (iter != mem_reuse_util_ptr->kernel_output_refs_.end() && index < iter->second.size()) {
+      (void)refs.insert(iter->second[index].get());
+    }
+  };
+  auto add_kernel = [&refs, &add_output, mem_reuse_util_ptr](const CNodePtr &kernel) {
+    for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(kernel); ++i) {
+      auto ref = mem_reuse_util_ptr->GetKernelInputRef(kernel, i);
+      if (ref != nullptr) {
+        (void)refs.insert(ref.get());
+      }
+    }
+    for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(kernel); ++i) {
+      add_output(kernel, i);
+    }
+  };
+  for (auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    // the communication kernels take the memory of their inputs and outputs out of the memory reuse
+    if (AnfAlgo::GetKernelType(kernel) == HCCL_KERNEL || AnfAlgo::GetCNodeName(kernel) == kAllReduceOpName) {
+      add_kernel(kernel);
+      continue;
+    }
+    // the ref outputs share the memory of the inputs
+    for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(kernel); ++i) {
+      if (graph->IsInRefOutputMap(std::make_pair(kernel, i))) {
+        add_kernel(kernel);
+        break;
+      }
+    }
+  }
+  // the graph outputs are in the static memory
+  for (auto &node : AnfAlgo::GetAllOutput(graph->output(), {prim::kPrimTupleGetItem})) {
+    auto item_with_index = AnfAlgo::VisitKernelWithReturnType(node, 0);
+    MS_EXCEPTION_IF_NULL(item_with_index.first);
+    if (item_with_index.first->isa<CNode>()) {
+      add_output(item_with_index.first, item_with_index.second);
+    }
+  }
+  return refs;
+}
+
+void MemSwapManager::AddSwap(const session::KernelGraph *graph, MemReuseUtil *mem_reuse_util_ptr, MemSwapInfo swap) {
+  auto &ref = swap.ref;
+  auto swap_in_ref = std::make_shared<KernelRefCount>();
+  swap_in_ref->stream_id_ = ref->stream_id_;
+  swap_in_ref->SetKernelRefCountInfo(SizeToInt(mem_reuse_util_ptr->total_refs_list_.size()), ref->size_,
+                                     memreuse::kDynamicRefCount);
+  mem_reuse_util_ptr->total_refs_list_.push_back(swap_in_ref);
+  swap.swap_in_ref = swap_in_ref;
+  auto swap_idx = swaps_.size();
+  auto defs = mem_reuse_util_ptr->kernel_def_ptr_list();
+  auto &kernels = graph->execution_order();
+  // the swap in writes the new block, it is live from the kernel issuing the swap in
+  auto in_def = defs[swap.in_kernel];
+  auto outputs = in_def->output_refs();
+  outputs.push_back(swap_in_ref);
+  in_def->set_output_refs(outputs);
+  for (size_t i = swap.use_kernel; i < defs.size(); ++i) {
+    auto inputs = defs[i]->input_refs();
+    auto iter = std::find(inputs.begin(), inputs.end(), ref);
+    if (iter == inputs.end()) {
+      continue;
+    }
+    *iter = swap_in_ref;
+    defs[i]->set_input_refs(inputs);
+    auto &kernel_inputs = defs[i]->inputs_[kernels[i].get()];
+    std::replace(kernel_inputs.begin(), kernel_inputs.end(), ref, swap_in_ref);
+    ref->ref_count_--;
+    ref->ref_count_dynamic_use_--;
+    swap_in_ref->ref_count_++;
+    swap_in_ref->ref_count_dynamic_use_++;
+    // the launch args of these inputs are taken from the new block
+    auto &kernel_swap_info = kernel_swap_infos_[i];
+    for (size_t j = 0; j < AnfAlgo::GetInputTensorNum(kernels[i]); ++j) {
+      auto real_input = AnfAlgo::GetRealInputIndex(kernels[i], j);
+      if (mem_reuse_util_ptr->GetKernelInputRef(kernels[i], real_input) == ref) {
+        kernel_swap_info.swap_inputs.emplace_back(j, swap_idx);
+      }
+    }
+  }
+  swap.host_offset = host_size_;
+  host_size_ += AlignHostSize(swap.size);
+  kernel_swap_infos_[swap.out_kernel].swap_out.push_back(swap_idx);
+  kernel_swap_infos_[swap.in_kernel].swap_in.push_back(swap_idx);
+  kernel_swap_infos_[swap.use_kernel].wait_swap_in.push_back(swap_idx);
+  swaps_.push_back(swap);
+}
+
+void MemSwapManager::Plan(const session::KernelGraph *graph, MemReuseUtil *mem_reuse_util_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(mem_reuse_util_ptr);
+  swaps_.clear();
+  kernel_swap_infos_.clear();
+  host_size_ = 0;
+  auto unswappable_refs = FindUnswappableRefs(graph, mem_reuse_util_ptr);
+  // the kernels writing or reading each tensor, in the execution order
+  std::unordered_map<KernelRefCount *, std::vector<size_t>> ref_kernels;
+  auto defs = mem_reuse_util_ptr->kernel_def_ptr_list();
+  for (size_t i = 0; i < defs.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(defs[i]);
+    auto touch = [&ref_kernels, i](const KernelRefCountPtr &ref) {
+      auto &kernels = ref_kernels[ref.get()];
+      if (kernels.empty() || kernels.back() != i) {
+        kernels.push_back(i);
+      }
+    };
+    auto outputs = defs[i]->output_refs();
+    auto inputs = defs[i]->input_refs();
+    (void)std::for_each(outputs.begin(), outputs.end(), touch);
+    (void)std::for_each(inputs.begin(), inputs.end(), touch);
+  }
+  // the new refs of the swaps are added to the list
+  auto refs = mem_reuse_util_ptr->total_refs_list();
+  for (auto &ref : refs) {
+    MS_EXCEPTION_IF_NULL(ref);
+    if (ref->reftype() != memreuse::kDynamicRefCount || ref->size_ < kMinSwapSize ||
+        unswappable_refs.count(ref.get()) != 0) {
+      continue;
+    }
+    // swap in the longest idle time of the tensor
+    auto &kernels = ref_kernels[ref.get()];
+    MemSwapInfo swap;
+    for (size_t i = 1; i < kernels.size(); ++i) {
+      auto distance = kernels[i] - kernels[i - 1];
+      if (distance >= kMinSwapDistance && distance > swap.use_kernel - swap.out_kernel) {
+        swap.out_kernel = kernels[i - 1];
+        swap.use_kernel = kernels[i];
+      }
+    }
+    if (swap.use_kernel == 0) {
+      continue;
+    }
+    swap.ref = ref;
+    swap.size = ref->size_;
+    swap.in_kernel = swap.use_kernel - kSwapInAdvance;
+    AddSwap(graph, mem_reuse_util_ptr, swap);
+  }
+  MS_LOG(INFO) << "Swap " << swaps_.size() << " tensors of graph " << graph->graph_id() << " to host, host size: ["
+               << host_size_ << "]";
+}
+
+void MemSwapManager::Assign(const MemReuseUtil *mem_reuse_util_ptr, uint8_t *device_mem_base,
+                            uint8_t *host_mem_base) {
+  MS_EXCEPTION_IF_NULL(mem_reuse_util_ptr);
+  MS_EXCEPTION_IF_NULL(device_mem_base);
+  MS_EXCEPTION_IF_NULL(host_mem_base);
+  std::set<KernelRefCount *> swap_in_refs;
+  for (auto &swap : swaps_) {
+    (void)swap_in_refs.insert(swap.swap_in_ref.get());
+  }
+  auto defs = mem_reuse_util_ptr->kernel_def_ptr_list();
+  for (size_t idx = 0; idx < swaps_.size(); ++idx) {
+    auto &swap = swaps_[idx];
+    swap.device_ptr = device_mem_base + swap.ref->offset_;
+    swap.swap_in_ptr = device_mem_base + swap.swap_in_ref->offset_;
+    swap.host_ptr = host_mem_base + swap.host_offset;
+    auto begin = swap.ref->offset_;
+    auto end = begin + swap.ref->size_;
+    // the swap ins are on the swap stream after the swap out, only the kernels have to wait for it
+    auto is_reused = [&swap_in_refs, begin, end](const KernelRefCountPtr &ref) {
+      return swap_in_refs.count(ref.get()) == 0 && ref->offset_ < end && begin < ref->offset_ + ref->size_;
+    };
+    swap.reuse_kernel = kInvalidSwapKernel;
+    for (size_t i = swap.out_kernel + 1; i < defs.size(); ++i) {
+      auto outputs = defs[i]->output_refs();
+      bool reused = std::any_of(outputs.begin(), outputs.end(), is_reused);
+      for (auto &item : defs[i]->wk_space_) {
+        reused = reused || std::any_of(item.second.begin(), item.second.end(), is_reused);
+      }
+      if (reused) {
+        swap.reuse_kernel = i;
+        kernel_swap_infos_[i].wait_swap_out.push_back(idx);
+        break;
+      }
+    }
+  }
+}
+
+const KernelSwapInfo *MemSwapManager::kernel_swap_info(size_t kernel_idx) const {
+  auto iter = kernel_swap_infos_.find(kernel_idx);
+  if (iter == kernel_swap_infos_.end()) {
+    return nullptr;
+  }
+  return &iter->second;
+}
+}  // namespace device
+}  // namespace mindspore
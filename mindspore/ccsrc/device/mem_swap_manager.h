@@ -0,0 +1,91 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_MEM_SWAP_MANAGER_H_
+#define MINDSPORE_CCSRC_DEVICE_MEM_SWAP_MANAGER_H_
+#include <limits>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "pre_activate/mem_reuse/kernel_refcount.h"
+#include "pre_activate/mem_reuse/mem_reuse.h"
+#include "session/kernel_graph.h"
+
+namespace mindspore {
+namespace device {
+constexpr size_t kInvalidSwapKernel = std::numeric_limits<size_t>::max();
+
+// A tensor swapped to the host between two of its uses. It is copied to the host after the kernel out_kernel, and
+// copied back to a new device block before the kernel in_kernel. The kernels from use_kernel on read the new block.
+struct MemSwapInfo {
+  memreuse::KernelRefCountPtr ref;
+  memreuse::KernelRefCountPtr swap_in_ref;
+  size_t size{0};
+  uint8_t *device_ptr{nullptr};
+  uint8_t *swap_in_ptr{nullptr};
+  size_t host_offset{0};
+  uint8_t *host_ptr{nullptr};
+  size_t out_kernel{0};
+  size_t in_kernel{0};
+  size_t use_kernel{0};
+  // the first kernel writing the memory of ref after the swap out, it waits for the swap out
+  size_t reuse_kernel{kInvalidSwapKernel};
+};
+
+// The swaps to issue around the launch of one kernel, by their indexes in the swaps
+struct KernelSwapInfo {
+  std::vector<size_t> wait_swap_out;
+  std::vector<size_t> swap_in;
+  std::vector<size_t> wait_swap_in;
+  std::vector<size_t> swap_out;
+  // the inputs read from the swapped in blocks: input index, swap index
+  std::vector<std::pair<size_t, size_t>> swap_inputs;
+};
+
+// Swaps the long lived tensors of a graph to the host memory when the device memory is not enough. The tensors idle
+// for many kernels, such as the forward activations waiting for the backward pass, are copied to the host on a swap
+// stream while the compute stream goes on, and prefetched back a few kernels before they are used again.
+class MemSwapManager {
+ public:
+  MemSwapManager() = default;
+  ~MemSwapManager() = default;
+  // Find the swaps on the refcounts, and split the lifetime of each swapped tensor in mem_reuse_util_ptr into the
+  // one before the swap out and the one after the swap in, before the memory reuse takes it
+  void Plan(const session::KernelGraph *graph, memreuse::MemReuseUtil *mem_reuse_util_ptr);
+  // Set the addresses of the swaps and find the kernels waiting for the swap outs, after the memory reuse has
+  // assigned the offsets
+  void Assign(const memreuse::MemReuseUtil *mem_reuse_util_ptr, uint8_t *device_mem_base, uint8_t *host_mem_base);
+  bool empty() const { return swaps_.empty(); }
+  const std::vector<MemSwapInfo> &swaps() const { return swaps_; }
+  // The size of the host memory keeping all swapped tensors
+  size_t host_size() const { return host_size_; }
+  const KernelSwapInfo *kernel_swap_info(size_t kernel_idx) const;
+
+ private:
+  // The tensors whose memory is not assigned by the memory reuse alone, or is shared with another tensor
+  std::set<memreuse::KernelRefCount *> FindUnswappableRefs(const session::KernelGraph *graph,
+                                                           memreuse::MemReuseUtil *mem_reuse_util_ptr) const;
+  void AddSwap(const session::KernelGraph *graph, memreuse::MemReuseUtil *mem_reuse_util_ptr, MemSwapInfo swap);
+  std::vector<MemSwapInfo> swaps_;
+  std::unordered_map<size_t, KernelSwapInfo> kernel_swap_infos_;
+  size_t host_size_{0};
+};
+using MemSwapManagerPtr = std::shared_ptr<MemSwapManager>;
+}  // namespace device
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_DEVICE_MEM_SWAP_MANAGER_H_
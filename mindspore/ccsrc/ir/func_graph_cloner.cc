@@ -17,6 +17,7 @@
 #include "ir/func_graph_cloner.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "ir/manager.h"
 #include "operator/ops.h"
@@ -26,6 +27,18 @@
 
 // namespace to support intermediate representation definition
 namespace mindspore {
+namespace {
+std::atomic<size_t> g_cloned_func_graphs{0};
+std::atomic<size_t> g_cloned_nodes{0};
+}  // namespace
+
+CloneStats GetCloneStats() {
+  CloneStats stats;
+  stats.func_graphs = g_cloned_func_graphs.load();
+  stats.nodes = g_cloned_nodes.load();
+  return stats;
+}
+
 Cloner::Cloner(const FuncGraphPtrList& func_graphs, bool clone_all_valuenodes, bool clone_all_child_graphs,
                bool clone_all_used_graphs, const TraceInfoPtr& relation, const TraceInfoPtr& target_relation)
     : clone_all_valuenodes_(clone_all_valuenodes),
@@ -74,6 +87,7 @@ void Cloner::CloneParameter(const AnfNodePtr& node, const FuncGraphPtr& target,
   ScopePtr scope = (node->scope() != kDefaultScope) ? node->scope() : this->scope();
   new_param->set_scope(scope);
   repl_node_[node] = new_param;
+  ++g_cloned_nodes;
   TraceManager::EndTrace();
 }
 
@@ -88,6 +102,7 @@ void Cloner::CloneCNode(const AnfNodePtr& node, const FuncGraphPtr& target) {
   new_node->set_scope(scope);
   repl_node_[old_node] = new_node;
   nodes_.emplace_back(old_node, new_node);
+  ++g_cloned_nodes;
   TraceManager::EndTrace();
 }
 
@@ -212,6 +227,7 @@ void Cloner::SetFuncGraphInfo(const FuncGraphPtr& func_graph, FuncGraphPtr* cons
   (*target_func_graph)->set_kwonlyargs_count(func_graph->kwonlyargs_count());
   (*target_func_graph)->set_hyper_param_count(func_graph->hyper_param_count());
   (*target_func_graph)->set_is_generate(func_graph->is_generated());
+  ++g_cloned_func_graphs;
   TraceManager::EndTrace();
 }
 
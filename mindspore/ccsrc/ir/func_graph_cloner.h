@@ -129,6 +129,14 @@ ClonerPtr SpecializerClone(const FuncGraphPtr& func_graph, const TraceInfoPtr& r
 
 FuncGraphPtr TransformableClone(const FuncGraphPtr& func_graph,
                                 const TraceInfoPtr& relation = std::make_shared<TraceTransform>());
+
+// The graphs and the nodes cloned since the start of the process, the pipeline logs what each action clones.
+struct CloneStats {
+  size_t func_graphs{0};
+  size_t nodes{0};
+};
+
+CloneStats GetCloneStats();
 }  // namespace mindspore
 
 #endif  // MINDSPORE_CCSRC_IR_FUNC_GRAPH_CLONER_H_
@@ -327,15 +327,15 @@ void FuncGraphManager::MaybeDropFuncGraphs(const FuncGraphSet& func_graphs, bool
   }
 }
 
-void FuncGraphManager::ProcessEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FuncGraphManager::ProcessEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp,
+                                   EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(inp);
   if (direction == kDecEdge) {
     MS_LOG(DEBUG) << "Remove node " << node->ToString() << " input[" << index << "] " << inp->ToString();
     auto& users_node = node_users_[inp];
-    if (!users_node.contains(make_pair(node, index))) {
+    if (!users_node.erase(make_pair(node, index))) {
       return;
     }
-    (void)users_node.erase(make_pair(node, index));
     signals_->DropEdge(node, index, inp);
   } else {
     MS_LOG(DEBUG) << "Add node " << node->ToString() << " input[" << index << "] " << inp->ToString();
@@ -627,7 +627,7 @@ NodesCollector::NodesCollector(const FuncGraphManager* const m) : DepCollector(m
   manager_->signals()->DropNode.connect(this, &NodesCollector::OnDropNode);
 }
 
-void NodesCollector::OnAddNode(AnfNodePtr n) {
+void NodesCollector::OnAddNode(const AnfNodePtr& n) {
   if (nodes_analysis_.find(n->func_graph()) == nodes_analysis_.end()) {
     nodes_analysis_[n->func_graph()] = AnfNodeSet();
   }
@@ -635,7 +635,7 @@ void NodesCollector::OnAddNode(AnfNodePtr n) {
   nodes_analysis_[n->func_graph()].add(n);
 }
 
-void NodesCollector::OnDropNode(AnfNodePtr n) {
+void NodesCollector::OnDropNode(const AnfNodePtr& n) {
   (void)nodes_analysis_[n->func_graph()].erase(n);
   auto graph = n->func_graph();
   // Remove the node from order list.
@@ -644,7 +644,7 @@ void NodesCollector::OnDropNode(AnfNodePtr n) {
   }
 }
 
-void NodesCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void NodesCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   // change the owner of node except for the src's return node
   for (auto& it : nodes_analysis_[src]) {
     nodes_analysis_[dst].add(it);
@@ -652,14 +652,18 @@ void NodesCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
   (void)nodes_analysis_.erase(src);
 }
 
-void DepCollector::OnAddEdge(AnfNodePtr node, int index, AnfNodePtr inp) { OnModEdge(node, index, inp, kIncEdge); }
+void DepCollector::OnAddEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp) {
+  OnModEdge(node, index, inp, kIncEdge);
+}
 
 DepCollector::DepCollector(const FuncGraphManager* const manager) : FuncGraphAnalysis(manager) {
   MS_EXCEPTION_IF_NULL(manager_);
   manager_->signals()->InvalidateCollector.connect(this, &DepCollector::OnInvalidateCollector);
 }
 
-void DepCollector::OnDropEdge(AnfNodePtr node, int index, AnfNodePtr inp) { OnModEdge(node, index, inp, kDecEdge); }
+void DepCollector::OnDropEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp) {
+  OnModEdge(node, index, inp, kDecEdge);
+}
 
 bool CounterAnfNodeCollector::Inc(const FuncGraphPtr& func_graph, const AnfNodePtr& key, int count = 1) {
   auto& d = count_nodes_map_[func_graph];
@@ -740,14 +744,15 @@ bool CounterFuncGraphCollector::Mod(const FuncGraphPtr& func_graph, const FuncGr
   }
 }
 
-void ValueNodesCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+void ValueNodesCollector::OnModEdge(const AnfNodePtr& node, int, const AnfNodePtr& inp,
+                                    EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(node);
   if (inp->isa<ValueNode>()) {
     (void)Mod(node->func_graph(), inp, direction);
   }
 }
 
-void ValueNodesCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void ValueNodesCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   for (auto& it : count_nodes_map_[src]) {
     (void)Inc(dst, it.first, it.second);
   }
@@ -755,20 +760,21 @@ void ValueNodesCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
 }
 
 // if inp is a graph ValueNode, this graph's FuncGraphValueNodesCollector's value is inp self
-void FuncGraphValueNodesCollector::OnModEdge(AnfNodePtr, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FuncGraphValueNodesCollector::OnModEdge(const AnfNodePtr&, int, const AnfNodePtr& inp,
+                                             EdgeProcessDirection direction) {
   if (IsValueNode<FuncGraph>(inp)) {
     (void)Mod(GetValueNode<FuncGraphPtr>(inp), inp, direction);
   }
 }
 
-void FuncGraphValueNodesCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void FuncGraphValueNodesCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   for (auto& it : count_nodes_map_[src]) {
     (void)Inc(dst, it.first, it.second);
   }
   (void)count_nodes_map_.erase(src);
 }
 
-void FVDirectCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FVDirectCollector::OnModEdge(const AnfNodePtr& node, int, const AnfNodePtr& inp, EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(node);
   MS_EXCEPTION_IF_NULL(inp);
   FuncGraphPtr fg1 = node->func_graph();
@@ -778,7 +784,7 @@ void FVDirectCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProc
   }
 }
 
-void FVDirectCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void FVDirectCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   for (auto& it : count_nodes_map_[src]) {
     FuncGraphPtr fg2 = it.first->func_graph();
     if (fg2 != dst) {
@@ -788,13 +794,29 @@ void FVDirectCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
   (void)count_nodes_map_.erase(src);
 }
 
-static FuncGraphPtr ParentProxy(const FuncGraphPtr& fg) {
-  FuncGraphPtr gn = std::make_shared<FuncGraph>();
-  (void)gn->transforms().insert(std::make_pair("proxy", FuncGraphTransform(fg)));
-  return gn;
+// The graphs reaching fg by the calls, their used graphs total, recursion and J total may change with the graphs
+// used by fg. The other analyses don't change if the parents of the graphs don't.
+static void InvalidateCallers(const FuncGraphManager* const manager, const FuncGraphPtr& fg) {
+  MS_EXCEPTION_IF_NULL(manager);
+  auto& users = manager->func_graph_users();
+  FuncGraphSet callers;
+  callers.add(fg);
+  std::vector<FuncGraphPtr> todo = {fg};
+  while (!todo.empty()) {
+    auto curr = todo.back();
+    todo.pop_back();
+    for (auto& user : users[curr]) {
+      if (!callers.contains(user.first)) {
+        callers.add(user.first);
+        todo.push_back(user.first);
+      }
+    }
+  }
+  manager->signals()->InvalidateCallers(callers);
 }
 
-void FuncGraphChildDirect::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FuncGraphChildDirect::OnModEdge(const AnfNodePtr& node, int, const AnfNodePtr& inp,
+                                     EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(node);
   MS_EXCEPTION_IF_NULL(inp);
   FuncGraphPtr fg1 = node->func_graph();
@@ -804,7 +826,7 @@ void FuncGraphChildDirect::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeP
   }
 }
 
-void FuncGraphChildDirect::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void FuncGraphChildDirect::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   for (auto& it : count_func_graphs_map_[src]) {
     FuncGraphPtr fg = it.first;
     if (fg != dst) {
@@ -814,14 +836,31 @@ void FuncGraphChildDirect::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
   (void)count_func_graphs_map_.erase(src);
 }
 
-void FuncGraphParentsDirectCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+FuncGraphPtr FuncGraphParentsDirectCollector::ParentProxy(const FuncGraphPtr& fg, const FuncGraphPtr& used) {
+  for (auto& dep : count_func_graphs_map_[fg]) {
+    auto proxy = dep.first->transforms().find("proxy");
+    if (proxy != dep.first->transforms().end() && proxy->second.func_graph() == used) {
+      return dep.first;
+    }
+  }
+  FuncGraphPtr gn = std::make_shared<FuncGraph>();
+  (void)gn->transforms().insert(std::make_pair("proxy", FuncGraphTransform(used)));
+  return gn;
+}
+
+void FuncGraphParentsDirectCollector::OnModEdge(const AnfNodePtr& node, int, const AnfNodePtr& inp,
+                                                EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(node);
   FuncGraphPtr fg1 = node->func_graph();
   // possible chirld parent
   if (IsValueNode<FuncGraph>(inp)) {
     FuncGraphPtr fg2 = GetValueNode<FuncGraphPtr>(inp);
-    if (Mod(fg1, ParentProxy(fg2), direction)) {
+    // the proxy is kept by the uses of fg2 in fg1, so it's only changed when fg1 starts or stops using fg2
+    bool used_changed = Mod(fg1, ParentProxy(fg1, fg2), direction);
+    if (!manager_->func_graph_parents_total(fg2).empty()) {
       manager_->signals()->InvalidateComputer();
+    } else if (used_changed) {
+      InvalidateCallers(manager_, fg1);
     }
   }
   // from fv
@@ -834,7 +873,7 @@ void FuncGraphParentsDirectCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr
   }
 }
 
-void FuncGraphParentsDirectCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void FuncGraphParentsDirectCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   for (auto& it : count_func_graphs_map_[src]) {
     if (it.first != dst) {
       (void)Inc(dst, it.first, it.second);
@@ -843,14 +882,15 @@ void FuncGraphParentsDirectCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraph
   (void)count_func_graphs_map_.erase(src);
 }
 
-void FuncGraphsUsedCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FuncGraphsUsedCollector::OnModEdge(const AnfNodePtr& node, int, const AnfNodePtr& inp,
+                                        EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(node);
   if (IsValueNode<FuncGraph>(inp)) {
     (void)Mod(node->func_graph(), GetValueNode<FuncGraphPtr>(inp), direction);
   }
 }
 
-void FuncGraphsUsedCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void FuncGraphsUsedCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   // all graph use in src need to change to dst, so meger the to dst use
   for (auto& it : count_func_graphs_map_[src]) {
     (void)Inc(dst, it.first, it.second);
@@ -859,41 +899,46 @@ void FuncGraphsUsedCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst)
   (void)count_func_graphs_map_.erase(src);
 }
 
-void FuncGraphUsersCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FuncGraphUsersCollector::OnModEdge(const AnfNodePtr& node, int, const AnfNodePtr& inp,
+                                        EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(node);
   if (IsValueNode<FuncGraph>(inp)) {
     (void)Mod(GetValueNode<FuncGraphPtr>(inp), node->func_graph(), direction);
   }
 }
 
-void FuncGraphUsersCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr) {
+void FuncGraphUsersCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr&) {
   // all graph use in src need to change to dst, so add dst user
   (void)count_func_graphs_map_.erase(src);
 }
 
-void FuncGraphUserNodesCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FuncGraphUserNodesCollector::OnModEdge(const AnfNodePtr& node, int, const AnfNodePtr& inp,
+                                            EdgeProcessDirection direction) {
   MS_EXCEPTION_IF_NULL(node);
   if (IsValueNode<FuncGraph>(inp)) {
     (void)Mod(GetValueNode<FuncGraphPtr>(inp), node, direction);
   }
 }
 
-void FuncGraphUserNodesCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void FuncGraphUserNodesCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   for (auto& it : count_nodes_map_[src]) {
     (void)Inc(dst, it.first, it.second);
   }
   (void)count_nodes_map_.erase(src);
 }
 
-void FuncGraphJDirectCollector::OnModEdge(AnfNodePtr node, int, AnfNodePtr inp, EdgeProcessDirection direction) {
+void FuncGraphJDirectCollector::OnModEdge(const AnfNodePtr& node, int, const AnfNodePtr& inp,
+                                          EdgeProcessDirection direction) {
   if (IsValueNode<FuncGraph>(inp) && IsPrimitiveCNode(node, prim::kPrimJ)) {
-    (void)Mod(node->func_graph(), GetValueNode<FuncGraphPtr>(inp), direction);
+    if (Mod(node->func_graph(), GetValueNode<FuncGraphPtr>(inp), direction)) {
+      InvalidateCallers(manager_, node->func_graph());
+    }
     MS_LOG(DEBUG) << "" << node->func_graph()->ToString() << " users func graph "
                   << GetValueNode<FuncGraphPtr>(inp)->ToString() << " which contains J(func_graph), dir: " << direction;
   }
 }
 
-void FuncGraphJDirectCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) {
+void FuncGraphJDirectCollector::OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) {
   // all graph use in src need to change to dst, so meger the to dst use
   for (auto& it : count_func_graphs_map_[src]) {
     (void)Inc(dst, it.first, it.second);
@@ -904,6 +949,7 @@ void FuncGraphJDirectCollector::OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr ds
 DepComputer::DepComputer(const FuncGraphManager* const manager) : FuncGraphAnalysis(manager) {
   MS_EXCEPTION_IF_NULL(manager_);
   manager_->signals()->InvalidateComputer.connect(this, &DepComputer::OnInvalidateComputer);
+  manager_->signals()->InvalidateCallers.connect(this, &DepComputer::OnInvalidateCallers);
   validate_ = false;
 }
 
@@ -87,15 +87,17 @@ FuncGraphManagerPtr Manage(const std::vector<FuncGraphPtr>& func_graphs, bool ma
 FuncGraphManagerPtr MakeManager(const std::vector<FuncGraphPtr>& func_graphs = {}, bool manage = true);
 
 struct Signals {
-  Signal<void(FuncGraphPtr)> AddFuncGraph;
-  Signal<void(FuncGraphPtr)> DropFuncGraph;
-  Signal<void(AnfNodePtr)> AddNode;
-  Signal<void(AnfNodePtr)> DropNode;
-  Signal<void(AnfNodePtr, int, AnfNodePtr)> AddEdge;
-  Signal<void(AnfNodePtr, int, AnfNodePtr)> DropEdge;
-  Signal<void(FuncGraphPtr, FuncGraphPtr)> MoveAllCNode;
+  Signal<void(const FuncGraphPtr&)> AddFuncGraph;
+  Signal<void(const FuncGraphPtr&)> DropFuncGraph;
+  Signal<void(const AnfNodePtr&)> AddNode;
+  Signal<void(const AnfNodePtr&)> DropNode;
+  Signal<void(const AnfNodePtr&, int, const AnfNodePtr&)> AddEdge;
+  Signal<void(const AnfNodePtr&, int, const AnfNodePtr&)> DropEdge;
+  Signal<void(const FuncGraphPtr&, const FuncGraphPtr&)> MoveAllCNode;
   Signal<void()> InvalidateCollector;
   Signal<void()> InvalidateComputer;
+  // the graphs calling the ones whose used graphs changed, the parents of the graphs didn't change
+  Signal<void(const FuncGraphSet&)> InvalidateCallers;
 };
 
 enum EdgeProcessDirection { kDecEdge = -1, kIncEdge = 1 };
@@ -112,23 +114,23 @@ class FuncGraphAnalysis {
 
   virtual size_t size() const { return 0; }
 
-  virtual void OnAddFuncGraph(FuncGraphPtr) {}
+  virtual void OnAddFuncGraph(const FuncGraphPtr&) {}
 
-  virtual void OnDropFuncGraph(FuncGraphPtr) {}
+  virtual void OnDropFuncGraph(const FuncGraphPtr&) {}
 
-  virtual void OnMoveAllCNode(FuncGraphPtr, FuncGraphPtr) {}
+  virtual void OnMoveAllCNode(const FuncGraphPtr&, const FuncGraphPtr&) {}
 
  protected:
   // subclass can reset their own member;
   virtual void ExtraReset() {}
 
-  virtual void OnAddNode(AnfNodePtr n) {}
+  virtual void OnAddNode(const AnfNodePtr& n) {}
 
-  virtual void OnDropNode(AnfNodePtr n) {}
+  virtual void OnDropNode(const AnfNodePtr& n) {}
 
-  virtual void OnAddEdge(AnfNodePtr, int, AnfNodePtr) {}
+  virtual void OnAddEdge(const AnfNodePtr&, int, const AnfNodePtr&) {}
 
-  virtual void OnDropEdge(AnfNodePtr, int, AnfNodePtr) {}
+  virtual void OnDropEdge(const AnfNodePtr&, int, const AnfNodePtr&) {}
 
   const FuncGraphManager* manager_;
   bool include_func_graph_none_;
@@ -147,10 +149,10 @@ class DepCollector : public FuncGraphAnalysis {
 
  protected:
   // inherit from FuncGraphAnalysis
-  void OnAddEdge(AnfNodePtr node, int index, AnfNodePtr inp) override;
-  void OnDropEdge(AnfNodePtr node, int index, AnfNodePtr inp) override;
+  void OnAddEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp) override;
+  void OnDropEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp) override;
   // subclass can override;
-  virtual void OnModEdge(AnfNodePtr, int, AnfNodePtr, EdgeProcessDirection) {}
+  virtual void OnModEdge(const AnfNodePtr&, int, const AnfNodePtr&, EdgeProcessDirection) {}
 };
 
 class NodesCollector final : public DepCollector {
@@ -160,18 +162,18 @@ class NodesCollector final : public DepCollector {
 
   const FuncGraphToAnfNodeMap& nodes_analysis() const { return nodes_analysis_; }
   size_t size() const override { return nodes_analysis_.size(); }
-  void OnAddFuncGraph(FuncGraphPtr fg) override { nodes_analysis_[fg] = AnfNodeSet(); }
+  void OnAddFuncGraph(const FuncGraphPtr& fg) override { nodes_analysis_[fg] = AnfNodeSet(); }
 
-  void OnDropFuncGraph(FuncGraphPtr fg) override { (void)nodes_analysis_.erase(fg); }
+  void OnDropFuncGraph(const FuncGraphPtr& fg) override { (void)nodes_analysis_.erase(fg); }
 
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
 
   FuncGraphToAnfNodeMap nodes_analysis_;
 
  protected:
   void ExtraReset() override { nodes_analysis_.clear(); }
-  void OnAddNode(AnfNodePtr n) override;
-  void OnDropNode(AnfNodePtr n) override;
+  void OnAddNode(const AnfNodePtr& n) override;
+  void OnDropNode(const AnfNodePtr& n) override;
 };
 
 class CounterFuncGraphCollector : public DepCollector {
@@ -181,8 +183,8 @@ class CounterFuncGraphCollector : public DepCollector {
   FuncGraphToFuncGraphCounterMap& count_func_graphs_map() { return count_func_graphs_map_; }
   // inherit from FuncGraphAnalysis
   size_t size() const override { return count_func_graphs_map_.size(); }
-  void OnAddFuncGraph(FuncGraphPtr fg) final { count_func_graphs_map_[fg] = OrderedMap<FuncGraphPtr, int>(); }
-  void OnDropFuncGraph(FuncGraphPtr fg) final { (void)count_func_graphs_map_.erase(fg); }
+  void OnAddFuncGraph(const FuncGraphPtr& fg) final { count_func_graphs_map_[fg] = OrderedMap<FuncGraphPtr, int>(); }
+  void OnDropFuncGraph(const FuncGraphPtr& fg) final { (void)count_func_graphs_map_.erase(fg); }
   bool Inc(const FuncGraphPtr& func_graph, const FuncGraphPtr& key, int count);
   bool Dec(const FuncGraphPtr& func_graph, const FuncGraphPtr& key, int count);
   bool Mod(const FuncGraphPtr& func_graph, const FuncGraphPtr& key, int count);
@@ -200,8 +202,8 @@ class CounterAnfNodeCollector : public DepCollector {
   FuncGraphToAnfNodeCounterMap& count_nodes_map() { return count_nodes_map_; }
 
   size_t size() const override { return count_nodes_map_.size(); }
-  void OnAddFuncGraph(FuncGraphPtr fg) final { count_nodes_map_[fg] = OrderedMap<AnfNodePtr, int>(); }
-  void OnDropFuncGraph(FuncGraphPtr fg) final { (void)count_nodes_map_.erase(fg); }
+  void OnAddFuncGraph(const FuncGraphPtr& fg) final { count_nodes_map_[fg] = OrderedMap<AnfNodePtr, int>(); }
+  void OnDropFuncGraph(const FuncGraphPtr& fg) final { (void)count_nodes_map_.erase(fg); }
 
   bool Inc(const FuncGraphPtr& func_graph, const AnfNodePtr& key, int count);
   bool Dec(const FuncGraphPtr& func_graph, const AnfNodePtr& key, int count);
@@ -217,41 +219,41 @@ class ValueNodesCollector final : public CounterAnfNodeCollector {
  public:
   explicit ValueNodesCollector(const FuncGraphManager* m) : CounterAnfNodeCollector(m) {}
   ~ValueNodesCollector() override = default;
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
 };
 
 class FuncGraphValueNodesCollector final : public CounterAnfNodeCollector {
  public:
   explicit FuncGraphValueNodesCollector(const FuncGraphManager* m) : CounterAnfNodeCollector(m) {}
   ~FuncGraphValueNodesCollector() override = default;
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
 };
 
 class FVDirectCollector final : public CounterAnfNodeCollector {
  public:
   explicit FVDirectCollector(const FuncGraphManager* m) : CounterAnfNodeCollector(m) {}
   ~FVDirectCollector() override = default;
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
 };
 
 class FuncGraphChildDirect final : public CounterFuncGraphCollector {
  public:
   explicit FuncGraphChildDirect(const FuncGraphManager* m) : CounterFuncGraphCollector(m) {}
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
 
   ~FuncGraphChildDirect() override = default;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
 };
 
 // graph's all parents, parentsdirect have a map, which key is graph, value is this graph's all direct and proxy
@@ -262,53 +264,57 @@ class FuncGraphParentsDirectCollector final : public CounterFuncGraphCollector {
  public:
   explicit FuncGraphParentsDirectCollector(const FuncGraphManager* m) : CounterFuncGraphCollector(m) {}
   ~FuncGraphParentsDirectCollector() override = default;
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
+
+ private:
+  // the proxy of the used graph in the parents of fg, a new one if fg doesn't use it yet
+  FuncGraphPtr ParentProxy(const FuncGraphPtr& fg, const FuncGraphPtr& used);
 };
 
 // graph's all used graphs: key is g, value is g used graph
 class FuncGraphsUsedCollector final : public CounterFuncGraphCollector {
  public:
   explicit FuncGraphsUsedCollector(const FuncGraphManager* m) : CounterFuncGraphCollector(m) {}
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
   ~FuncGraphsUsedCollector() override = default;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
 };
 
 // graph's all user graphs: key is g, value is graphs who used g
 class FuncGraphUsersCollector final : public CounterFuncGraphCollector {
  public:
   explicit FuncGraphUsersCollector(const FuncGraphManager* m) : CounterFuncGraphCollector(m) {}
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
   ~FuncGraphUsersCollector() override = default;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
 };
 
 // graph's all user cnodes: key is g, value is cnodes who used g
 class FuncGraphUserNodesCollector final : public CounterAnfNodeCollector {
  public:
   explicit FuncGraphUserNodesCollector(const FuncGraphManager* m) : CounterAnfNodeCollector(m) {}
-  void OnMoveAllCNode(FuncGraphPtr src, FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
   ~FuncGraphUserNodesCollector() override = default;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
 };
 
 class FuncGraphJDirectCollector final : public CounterFuncGraphCollector {
  public:
   explicit FuncGraphJDirectCollector(const FuncGraphManager* m) : CounterFuncGraphCollector(m) {}
-  void OnMoveAllCNode(FuncGraphPtr src, const FuncGraphPtr dst) override;
+  void OnMoveAllCNode(const FuncGraphPtr& src, const FuncGraphPtr& dst) override;
   ~FuncGraphJDirectCollector() override = default;
 
  protected:
-  void OnModEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction) override;
+  void OnModEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction) override;
 };
 
 using FuncGraphToFuncGraphSetMap = OrderedMap<FuncGraphPtr, FuncGraphSet>;
@@ -327,6 +333,9 @@ class DepComputer : public FuncGraphAnalysis {
 
   void OnInvalidateComputer() { Reset(); }
 
+  // only the analyses computed by the used graphs drop the results of the callers
+  virtual void OnInvalidateCallers(const FuncGraphSet&) {}
+
   void Recompute();
 
   void Recompute(const FuncGraphPtr& fg);
@@ -335,9 +344,10 @@ class DepComputer : public FuncGraphAnalysis {
 
   bool IsValidate(const FuncGraphPtr& fg) { return func_graphs_validate_[fg]; }
 
-  void OnAddFuncGraph(FuncGraphPtr) final { Reset(); }
+  // the new graph has no edges yet, the results of the other graphs stay valid, the global ones are recomputed
+  void OnAddFuncGraph(const FuncGraphPtr&) final { validate_ = false; }
 
-  void OnDropFuncGraph(FuncGraphPtr) final { Reset(); }
+  void OnDropFuncGraph(const FuncGraphPtr&) final { Reset(); }
 
  protected:
   // subclass do the real compute
@@ -472,6 +482,13 @@ class FuncGraphsUsedTotalComputer final : public DepComputer {
 
   FuncGraphToFuncGraphSetMap func_graph_used_total_analysis_;
 
+  void OnInvalidateCallers(const FuncGraphSet& callers) override {
+    for (auto& fg : callers) {
+      (void)func_graph_used_total_analysis_.erase(fg);
+      (void)func_graphs_validate_.erase(fg);
+    }
+  }
+
  protected:
   void ExtraReset() override { func_graph_used_total_analysis_.clear(); }
 
@@ -496,6 +513,15 @@ class RecursiveComputer final : public DepComputer {
   RecursiveMap recursive_map_;
   FuncGraphToBoolMap recursive_analysis_;
 
+  void OnInvalidateCallers(const FuncGraphSet& callers) override {
+    for (auto& fg : callers) {
+      (void)recursive_analysis_.erase(fg);
+      (void)func_graphs_validate_.erase(fg);
+    }
+    // the cycles are found from any graph of them
+    recursive_map_.clear();
+  }
+
  protected:
   void ExtraReset() override {
     recursive_analysis_.clear();
@@ -516,6 +542,13 @@ class FuncGraphJTotalComputer final : public DepComputer {
 
   FuncGraphToBoolMap j_total_analysis_;
 
+  void OnInvalidateCallers(const FuncGraphSet& callers) override {
+    for (auto& fg : callers) {
+      (void)j_total_analysis_.erase(fg);
+      (void)func_graphs_validate_.erase(fg);
+    }
+  }
+
  protected:
   void ExtraReset() override { j_total_analysis_.clear(); }
 
@@ -621,7 +654,7 @@ class FuncGraphManager : public std::enable_shared_from_this<FuncGraphManager> {
 
  private:
   void AddIntoManaged(const FuncGraphPtr& fg);
-  void ProcessEdge(AnfNodePtr node, int index, AnfNodePtr inp, EdgeProcessDirection direction);
+  void ProcessEdge(const AnfNodePtr& node, int index, const AnfNodePtr& inp, EdgeProcessDirection direction);
   void ProcessInputs(const AnfNodePtr& node, EdgeProcessDirection direction);
   void AcquireNodes(const std::vector<AnfNodePtr>& nodes);
   FuncGraphSetPtr MaybeDropNodes(const std::vector<AnfNodePtr>& nodes);
@@ -16,17 +16,21 @@
 
 #include "ir/meta_tensor.h"
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <numeric>
 #include <vector>
 #include <sstream>
 #include <string>
 
+#include "common/trans.h"
 #include "device/device_address.h"
 #include "pybind_api/api_register.h"
 #include "pybind_api/export_flags.h"
 #include "pynative/pynative_execute.h"
 #include "pipeline/static_analysis/abstract_value.h"
+#include "utils/utils.h"
 
 namespace mindspore {
 
@@ -165,7 +169,21 @@ Tensor::Tensor(const py::float_& input, const TypePtr& data_type) { init(py::arr
 Tensor::Tensor(const py::int_& input, const TypePtr& data_type) { init(py::array(input), data_type); }
 
 Tensor::Tensor(const Tensor& tensor, const TypePtr& data_type)
-    : MetaTensor(tensor), device_address_(tensor.device_address()) {
+    : MetaTensor(tensor),
+      device_address_(tensor.device_address_),
+      lazy_host_data_(tensor.lazy_host_data_),
+      device_content_(tensor.device_content_) {
+  if (data_type != nullptr && data_type->type_id() != tensor.data_type()) {
+    // the data is converted on host, so the copy has its own host data
+    if (lazy_host_data_ != nullptr) {
+      lazy_host_data_->Sync();
+      lazy_host_data_ = nullptr;
+    }
+    if (device_content_ != nullptr) {
+      device_content_->Sync();
+      device_content_ = nullptr;
+    }
+  }
   init(tensor.data_, data_type);
 }
 
@@ -173,7 +191,9 @@ Tensor& Tensor::operator=(const Tensor& tensor) {
   if (this != &tensor) {
     MetaTensor::operator=(tensor);
     dirty_ = tensor.is_dirty();
-    device_address_ = tensor.device_address();
+    device_address_ = tensor.device_address_;
+    lazy_host_data_ = tensor.lazy_host_data_;
+    device_content_ = tensor.device_content_;
     data_ = tensor.data_;
   }
   return *this;
@@ -194,7 +214,7 @@ bool Tensor::ValueEqualPy(const py::object& other) const {
 bool Tensor::ValueEqual(const Tensor& other) const {
   auto equal = [&other, this]() -> bool {
     auto np = py::module::import("numpy");
-    auto equal = np.attr("equal")(data_, other.data_);
+    auto equal = np.attr("equal")(data(), other.data());
     auto all_equal = np.attr("all")(equal);
     return all_equal.cast<bool>();
   };
@@ -213,13 +233,27 @@ py::tuple Tensor::GetPyTupleShape() const {
   return dims;
 }
 
-py::array Tensor::data() const { return data_; }
+py::array Tensor::data() const {
+  if (lazy_host_data_ != nullptr) {
+    lazy_host_data_->Sync();
+  }
+  if (device_content_ != nullptr) {
+    device_content_->Sync();
+  }
+  return data_;
+}
 
 int Tensor::data_type_c() const { return static_cast<int>(data_type_); }
 
 std::vector<int> Tensor::shape_c(void) const { return shape(); }
 
 void* Tensor::data_c(bool writable) {
+  if (lazy_host_data_ != nullptr) {
+    lazy_host_data_->Sync();
+  }
+  if (device_content_ != nullptr) {
+    device_content_->Sync();
+  }
   // operand of bit operation should be unsigned int.
   unsigned int flags = ((unsigned int)data_.flags()) & pybind11::detail::npy_api::NPY_ARRAY_C_CONTIGUOUS_;
   bool is_c_contiguous = (flags != 0) ? true : false;
@@ -229,6 +263,11 @@ void* Tensor::data_c(bool writable) {
     DataBuf2Contiguous(data_, &data_c);
     data_ = data_c;
   }
+  // the array borrowed from python may be read only, it is copied only when it is to be written
+  unsigned int writeable = ((unsigned int)data_.flags()) & pybind11::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+  if (writable && writeable == 0) {
+    data_ = py::array(data_.attr("copy")());
+  }
   return data_.request(writable).ptr;
 }
 
@@ -449,14 +488,134 @@ std::string Tensor::ToStringRepr() const {
   return buf.str();
 }
 
+void LazyHostData::Sync() {
+  if (synced_ || device_address_ == nullptr) {
+    return;
+  }
+  if (!device_address_->SyncDeviceToHost(shape_, size_, data_type_, host_ptr_)) {
+    MS_LOG(EXCEPTION) << "SyncDeviceToHost of the lazy output failed.";
+  }
+  synced_ = true;
+}
+
+void LazyHostData::Release() {
+  Sync();
+  device_address_ = nullptr;
+}
+
+void Tensor::set_device_address(const DeviceAddressPtr& device_address) {
+  if (lazy_host_data_ != nullptr) {
+    lazy_host_data_->Sync();
+    lazy_host_data_ = nullptr;
+  }
+  device_address_ = device_address;
+}
+
+LazyHostDataPtr Tensor::SetLazyHostData(const DeviceAddressPtr& device_address) {
+  device_address_ = nullptr;
+  lazy_host_data_ = std::make_shared<LazyHostData>(device_address, shape(), data_type(), data_c(true),
+                                                   static_cast<size_t>(data_.nbytes()));
+  return lazy_host_data_;
+}
+
 py::array Tensor::data_sync() {
+  if (lazy_host_data_ != nullptr) {
+    return data();
+  }
   if (device_address_ != nullptr) {
+    // the device has the latest data, the loaded content is out of date
+    device_content_ = nullptr;
     if (!device_address_->SyncDeviceToHost(this->shape(), static_cast<size_t>(this->data().nbytes()), this->data_type(),
                                            this->data_c(true))) {
       MS_LOG(EXCEPTION) << "SyncDeviceToHost when asnumpy.";
     }
   }
-  return data_;
+  return data();
+}
+
+void DeviceContent::Sync() {
+  if (synced_) {
+    return;
+  }
+  std::vector<size_t> host_shape;
+  (void)std::transform(shape_.begin(), shape_.end(), std::back_inserter(host_shape), IntToSize);
+  if (host_shape.empty()) {
+    host_shape.emplace_back(1);
+  }
+  bool host_format = format_ == kOpFormat_DEFAULT || format_ == kOpFormat_NCHW;
+  std::vector<size_t> device_shape = host_shape;
+  if (format_ == kOpFormat_FRAC_NZ) {
+    device_shape = trans::TransShapeToDevice(host_shape, format_);
+  } else if (!host_format) {
+    host_shape = trans::TransShapeTo4d(host_shape);
+    device_shape = trans::TransShapeToDevice(host_shape, format_);
+  }
+  if (trans::ShapeSize(device_shape) * trans::TypeIdSize(type_id_) != content_.size()) {
+    MS_LOG(EXCEPTION) << "The device content of " << content_.size() << " bytes does not match the shape " << shape_
+                      << " in format " << format_ << ".";
+  }
+  auto host_content = std::vector<uint8_t>(trans::ShapeSize(host_shape) * trans::TypeIdSize(type_id_));
+  const trans::FormatArgs format_args{content_.data(), content_.size(), kOpFormat_NCHW, format_,
+                                      host_shape,      device_shape,    type_id_};
+  if (host_format) {
+    (void)std::copy(content_.begin(), content_.end(), host_content.begin());
+  } else if (!trans::TransFormatFromDeviceToHost(format_args, host_content.data())) {
+    MS_LOG(EXCEPTION) << "Trans the device content from format " << format_ << " failed.";
+  }
+  if (type_id_ == data_type_) {
+    (void)std::copy(host_content.begin(), host_content.end(), static_cast<uint8_t*>(host_ptr_));
+  } else {
+    const trans::TypeIdArgs type_args{host_content.data(), trans::ShapeSize(host_shape), type_id_, data_type_};
+    if (!trans::TransDataType(type_args, host_ptr_)) {
+      MS_LOG(EXCEPTION) << "Trans the device content from type " << TypeIdLabel(type_id_) << " failed.";
+    }
+  }
+  synced_ = true;
+}
+
+py::object Tensor::GetDeviceContent() const {
+  if (device_content_ != nullptr && device_address_ == nullptr) {
+    return py::make_tuple(device_content_->format(), TypeIdToType(device_content_->type_id()),
+                          py::bytes(device_content_->content()));
+  }
+  auto device_address = this->device_address();
+  if (device_address == nullptr || device_address->format() == kOpFormat_DEFAULT ||
+      device_address->format() == kOpFormat_NCHW) {
+    return py::none();
+  }
+  auto size = device_address->GetSize();
+  auto content = py::reinterpret_steal<py::bytes>(PyBytes_FromStringAndSize(nullptr, SizeToLong(size)));
+  if (!device_address->SyncDeviceToHostRaw(PyBytes_AsString(content.ptr()), size)) {
+    return py::none();
+  }
+  return py::make_tuple(device_address->format(), TypeIdToType(device_address->type_id()), content);
+}
+
+void Tensor::SetDeviceContent(const std::string& format, const TypePtr& type_ptr, const py::bytes& content) {
+  MS_EXCEPTION_IF_NULL(type_ptr);
+  lazy_host_data_ = nullptr;
+  device_content_ = nullptr;
+  device_address_ = nullptr;
+  dirty_ = true;
+  device_content_ = std::make_shared<DeviceContent>(format, type_ptr->type_id(), std::string(content), shape(),
+                                                    data_type(), data_c(true));
+}
+
+bool Tensor::LoadDeviceContent(const DeviceAddressPtr& device_address) {
+  if (device_content_ == nullptr || device_address == nullptr) {
+    return false;
+  }
+  if (device_address->format() != device_content_->format() ||
+      device_address->type_id() != device_content_->type_id()) {
+    return false;
+  }
+  const auto& content = device_content_->content();
+  if (!device_address->SyncHostToDeviceRaw(content.data(), content.size())) {
+    return false;
+  }
+  // the host data is still converted from the content on demand, until it is synced from the device
+  set_device_address(device_address);
+  return true;
 }
 
 REGISTER_PYBIND_DEFINE(Tensor, ([](const py::module* m) {
@@ -538,6 +697,22 @@ REGISTER_PYBIND_DEFINE(Tensor, ([](const py::module* m) {
                                  >>> data.shape()
                                  (3, 3)
                              )mydelimiter")
+                           .def("device_content", &Tensor::GetDeviceContent, R"mydelimiter(
+                             Get the data as the device keeps it, for the checkpoint saved in the device format.
+
+                             Returns:
+                                 tuple, the format, the data type and the bytes of the data on the device, or None if
+                                 the tensor is not on the device or the device keeps it in the host format.
+                             )mydelimiter")
+                           .def("set_device_content", &Tensor::SetDeviceContent, py::arg("format"), py::arg("dtype"),
+                                py::arg("content"), R"mydelimiter(
+                             Set the data as the device keeps it, which is copied to the device without conversion.
+
+                             Arg:
+                                 format (str): The format of the data on the device, such as FracZ.
+                                 dtype (:class:`mindspore.dtype`): The data type of the data on the device.
+                                 content (bytes): The data on the device.
+                             )mydelimiter")
                            .def("__str__", &Tensor::ToString)
                            .def("__repr__", &Tensor::ToStringRepr)
                            .def("__eq__", &Tensor::ValueEqualPy)
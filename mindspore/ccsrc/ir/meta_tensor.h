@@ -253,6 +253,65 @@ class MetaTensor : public Value {
   DeviceInfo device_info_;
 };
 
+// The host data of a graph output left on the device, which is synced to host on demand only. It is shared by the
+// copies of the tensor, which share the host data too, so the data is synced once for all of them. The session
+// releases it before the device memory is written again, after which the host data is the one to use.
+class LazyHostData {
+ public:
+  LazyHostData(const DeviceAddressPtr& device_address, const std::vector<int>& shape, TypeId data_type,
+               void* host_ptr, size_t size)
+      : device_address_(device_address), shape_(shape), data_type_(data_type), host_ptr_(host_ptr), size_(size) {}
+  ~LazyHostData() = default;
+
+  // the device address while the data is still on the device, otherwise nullptr
+  DeviceAddressPtr device_address() const { return device_address_; }
+  // copy the data to host if it is not yet
+  void Sync();
+  // sync the data and forget the device address
+  void Release();
+
+ private:
+  DeviceAddressPtr device_address_;
+  std::vector<int> shape_;
+  TypeId data_type_;
+  void* host_ptr_;
+  size_t size_;
+  bool synced_{false};
+};
+using LazyHostDataPtr = std::shared_ptr<LazyHostData>;
+
+// The data of a tensor in the format and the type the device keeps it in, as a checkpoint saved in the device format
+// has it. It is copied to the device as it is when the device keeps the tensor in the same format and type, and it is
+// converted to the host data on demand only. It is shared by the copies of the tensor, as their host data is.
+class DeviceContent {
+ public:
+  DeviceContent(const std::string& format, TypeId type_id, std::string&& content, const std::vector<int>& shape,
+                TypeId data_type, void* host_ptr)
+      : format_(format),
+        type_id_(type_id),
+        content_(std::move(content)),
+        shape_(shape),
+        data_type_(data_type),
+        host_ptr_(host_ptr) {}
+  ~DeviceContent() = default;
+
+  const std::string& format() const { return format_; }
+  TypeId type_id() const { return type_id_; }
+  const std::string& content() const { return content_; }
+  // convert the content to the host data if it is not yet
+  void Sync();
+
+ private:
+  std::string format_;
+  TypeId type_id_;
+  std::string content_;
+  std::vector<int> shape_;
+  TypeId data_type_;
+  void* host_ptr_;
+  bool synced_{false};
+};
+using DeviceContentPtr = std::shared_ptr<DeviceContent>;
+
 // Tensor entity class
 class Tensor : public MetaTensor {
  public:
@@ -416,13 +475,26 @@ class Tensor : public MetaTensor {
  public:
   bool is_dirty() const { return dirty_; }
   void set_dirty(const bool dirty) { dirty_ = dirty; }
-  DeviceAddressPtr device_address() const { return device_address_; }
-  void set_device_address(const DeviceAddressPtr& device_address) { device_address_ = device_address; }
+  DeviceAddressPtr device_address() const {
+    return lazy_host_data_ != nullptr ? lazy_host_data_->device_address() : device_address_;
+  }
+  void set_device_address(const DeviceAddressPtr& device_address);
   py::array data_sync();
+  // leave the data of a graph output on the device until it is asked for on host
+  LazyHostDataPtr SetLazyHostData(const DeviceAddressPtr& device_address);
+  LazyHostDataPtr lazy_host_data() const { return lazy_host_data_; }
+  // the (format, dtype, bytes) of the data as the device keeps it, or None if the device keeps the host format
+  py::object GetDeviceContent() const;
+  // take the data in the device format, the host data is converted from it on demand
+  void SetDeviceContent(const std::string& format, const TypePtr& type_ptr, const py::bytes& content);
+  // copy the data in the device format to the device address as it is, false if the device keeps another format
+  bool LoadDeviceContent(const DeviceAddressPtr& device_address);
 
  private:
   bool dirty_{true};
   DeviceAddressPtr device_address_{nullptr};
+  LazyHostDataPtr lazy_host_data_{nullptr};
+  DeviceContentPtr device_content_{nullptr};
 };
 
 using TensorPtr = std::shared_ptr<Tensor>;
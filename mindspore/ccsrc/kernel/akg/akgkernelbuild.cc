@@ -36,6 +36,7 @@
 #include "utils/any.h"
 #include "utils/utils.h"
 #include "transform/convert.h"
+#include "ir/meta_tensor.h"
 #include "session/anf_runtime_algorithm.h"
 #include "kernel/akg/akg_kernel_attrs_process.h"
 
@@ -55,6 +56,7 @@ constexpr auto kValue = "value";
 constexpr auto KInpputNames = "input_names";
 constexpr auto KInput = "input";
 constexpr auto KDtype = "dtype";
+constexpr auto kOpDesc = "op_desc";
 int AkgKernelBuild::op_cnt_ = 0;
 std::mutex AkgKernelBuild::op_cnt_mtx_;
 
@@ -485,10 +487,146 @@ KernelPackPtr AkgKernelBuild::OpBuild(const std::string &node_json, const AnfNod
   return new_kernel_pack;
 }
 
+bool GetScalarValue(const AnfNodePtr &node, float *const value) {
+  MS_EXCEPTION_IF_NULL(value);
+  if (!node->isa<ValueNode>()) {
+    return false;
+  }
+  auto tensor = node->cast<ValueNodePtr>()->value()->cast<tensor::TensorPtr>();
+  if (tensor == nullptr || tensor->DataSize() != 1) {
+    return false;
+  }
+  if (tensor->data_type() == kNumberTypeFloat32) {
+    *value = *static_cast<float *>(tensor->data_c());
+    return true;
+  }
+  if (tensor->data_type() == kNumberTypeFloat16) {
+    *value = static_cast<float>(*static_cast<float16 *>(tensor->data_c()));
+    return true;
+  }
+  return false;
+}
+
+bool AkgKernelBuild::GenerateCompositeKernelJson(const std::vector<AnfNodePtr> &anf_nodes,
+                                                 const std::vector<AnfNodePtr> &input_list, const AnfNodePtr &output,
+                                                 nlohmann::json *const composite_json) {
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(composite_json);
+  std::unordered_map<AnfNodePtr, std::string> tensor_names;
+  for (size_t i = 0; i < input_list.size(); ++i) {
+    tensor_names[input_list[i]] = "input_" + std::to_string(i);
+  }
+  std::unordered_map<AnfNodePtr, nlohmann::json> input_descs;
+  nlohmann::json op_descs;
+  size_t const_cnt = 0;
+  for (size_t i = 0; i < anf_nodes.size(); ++i) {
+    auto cnode = anf_nodes[i]->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    std::string op_name = AnfAlgo::GetCNodeName(cnode);
+    auto it = kAkgKernelAttrsProcessMap.find(op_name);
+    if (it != kAkgKernelAttrsProcessMap.end()) {
+      it->second(cnode);
+    }
+    nlohmann::json op_json;
+    if (!GenerateSingleKernelJson(cnode, op_name, &op_json)) {
+      MS_LOG(ERROR) << "Op[" << op_name << "] create single kernel json failed.";
+      return false;
+    }
+    // the id counts the builds, it would make the json of the same subgraph differ
+    (void)op_json.erase("id");
+    if (op_json[kInputDesc].size() + 1 != cnode->inputs().size()) {
+      MS_LOG(ERROR) << "Op[" << op_name << "] has " << cnode->inputs().size() - 1 << " inputs but "
+                    << op_json[kInputDesc].size() << " input descs.";
+      return false;
+    }
+    for (size_t input_i = 0; input_i < op_json[kInputDesc].size(); ++input_i) {
+      auto input = cnode->input(input_i + 1);
+      auto &input_desc = op_json[kInputDesc][input_i][0];
+      float value = 0;
+      if (tensor_names.find(input) != tensor_names.end()) {
+        input_desc[kTensorName] = tensor_names[input];
+        (void)input_descs.emplace(input, input_desc);
+      } else if (GetScalarValue(input, &value)) {
+        input_desc[kTensorName] = "const_" + std::to_string(const_cnt++);
+        input_desc[kValue] = value;
+      } else {
+        MS_LOG(ERROR) << "The input " << input_i << " of op[" << op_name << "] is out of the graph kernel.";
+        return false;
+      }
+    }
+    if (op_json[kOutputDesc].size() != 1) {
+      MS_LOG(ERROR) << "Op[" << op_name << "] of the graph kernel has " << op_json[kOutputDesc].size() << " outputs.";
+      return false;
+    }
+    tensor_names[cnode] = "output_" + std::to_string(i);
+    op_json[kOutputDesc][0][kTensorName] = tensor_names[cnode];
+    op_descs.push_back(op_json);
+  }
+  if (tensor_names.find(output) == tensor_names.end() || op_descs.empty()) {
+    MS_LOG(ERROR) << "The output of the graph kernel is not computed by its nodes.";
+    return false;
+  }
+
+  nlohmann::json inputs_json;
+  for (const auto &input : input_list) {
+    if (input_descs.find(input) == input_descs.end()) {
+      MS_LOG(ERROR) << "The input " << input->DebugString() << " of the graph kernel is not used by its nodes.";
+      return false;
+    }
+    inputs_json.push_back(nlohmann::json::array({input_descs[input]}));
+  }
+  nlohmann::json outputs_json;
+  for (const auto &op_json : op_descs) {
+    if (op_json[kOutputDesc][0][kTensorName] == tensor_names[output]) {
+      outputs_json.push_back(op_json[kOutputDesc][0]);
+    }
+  }
+  (*composite_json)["composite"] = true;
+  (*composite_json)["platform"] = "AKG";
+  (*composite_json)["process"] = AkgKernelBuild::GetProcessor(output);
+  (*composite_json)[kInputDesc] = inputs_json;
+  (*composite_json)[kOutputDesc] = outputs_json;
+  (*composite_json)[kOpDesc] = op_descs;
+  size_t hash_id = std::hash<std::string>()(composite_json->dump());
+  (*composite_json)["op"] = std::string(kGraphKernelOpName) + "_" + std::to_string(hash_id);
+  return true;
+}
+
+KernelPackPtr AkgKernelBuild::BuildCompositeByJson(const AnfNodePtr &anf_node, std::vector<size_t> *const input_size,
+                                                   std::vector<size_t> *const output_size) {
+  MS_EXCEPTION_IF_NULL(anf_node);
+  auto primitive = AnfAlgo::GetCNodePrimitive(anf_node);
+  MS_EXCEPTION_IF_NULL(primitive);
+  auto json_value = primitive->GetAttr(kAttrCompositeJson);
+  if (json_value == nullptr) {
+    MS_LOG(ERROR) << "Graph kernel " << anf_node->fullname_with_scope() << " has no composite json.";
+    return nullptr;
+  }
+  json_info_ = GetValue<std::string>(json_value);
+  auto composite_json = nlohmann::json::parse(json_info_);
+  json_name_ = composite_json["op"];
+  MS_LOG(INFO) << "Akg start compile graph kernel " << json_name_ << ", full scope name is "
+               << anf_node->fullname_with_scope();
+  // the cache is looked up by the json name, which is the hash of the subgraph
+  auto kernel_pack = OpBuild(json_info_, anf_node);
+  if (kernel_pack == nullptr) {
+    MS_LOG(ERROR) << "Akg build failed graph kernel, json:" << json_info_;
+    return nullptr;
+  }
+  if (!GetIOSize(composite_json, input_size, output_size)) {
+    MS_LOG(ERROR) << "Cal mem size failed.";
+    return nullptr;
+  }
+  return kernel_pack;
+}
+
 KernelPackPtr AkgKernelBuild::BuildByJson(const AnfNodePtr &anf_node, std::vector<size_t> *const input_size,
                                           std::vector<size_t> *const output_size) {
   MS_EXCEPTION_IF_NULL(anf_node);
   std::string op_name = AnfAlgo::GetCNodeName(anf_node);
+  if (op_name == kGraphKernelOpName) {
+    return BuildCompositeByJson(anf_node, input_size, output_size);
+  }
   auto it = kAkgKernelAttrsProcessMap.find(op_name);
   if (it != kAkgKernelAttrsProcessMap.end()) {
     it->second(anf_node);
@@ -37,8 +37,14 @@ class AkgKernelBuild {
 
   KernelPackPtr BuildByJson(const AnfNodePtr &anf_node, std::vector<size_t> *const input_size,
                             std::vector<size_t> *const output_size);
+  // the json of the graph kernel of the nodes in the order of their computation, whose tensors are linked by their
+  // names, the constant inputs of the nodes are folded into it
+  bool GenerateCompositeKernelJson(const std::vector<AnfNodePtr> &anf_nodes, const std::vector<AnfNodePtr> &input_list,
+                                   const AnfNodePtr &output, nlohmann::json *const composite_json);
 
  private:
+  KernelPackPtr BuildCompositeByJson(const AnfNodePtr &anf_node, std::vector<size_t> *const input_size,
+                                     std::vector<size_t> *const output_size);
   bool CreateInputDescJson(const AnfNodePtr &anf_node, nlohmann::json *const inputs_json);
   bool CreateOutputDescJson(const AnfNodePtr &anf_node, nlohmann::json *const outputs_json);
   bool CreateAttrDescJson(const AnfNodePtr &anf_node, const std::string &op_name,
@@ -19,10 +19,14 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <mutex>
+#include <set>
+#include <cstring>
 #include "runtime/rt.h"
 #include "nlohmann/json.hpp"
 #include "session/anf_runtime_algorithm.h"
 #include "common/utils.h"
+#include "pipeline/parse/python_adapter.h"
 
 namespace mindspore {
 namespace kernel {
@@ -115,6 +119,31 @@ bool IsAtomicNode(const CNodePtr &kernel_node) {
   return atomic_flag;
 }
 
+constexpr auto kKernelBundleEnv = "MS_KERNEL_BUNDLE";
+constexpr auto kKernelBundleModule = "mindspore._extends.kernel_bundle";
+constexpr auto kUnpackKernelBundleFunc = "unpack_kernel_bundle";
+
+void UnpackKernelBundle(const std::string &kernel_meta_dir) {
+  static std::mutex unpacked_mutex;
+  static std::set<std::string> unpacked_dirs;
+  const char *bundle_path = getenv(kKernelBundleEnv);
+  if (bundle_path == nullptr || strlen(bundle_path) == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(unpacked_mutex);
+  if (!unpacked_dirs.insert(kernel_meta_dir).second) {
+    return;
+  }
+  py::object ret = parse::python_adapter::CallPyFn(kKernelBundleModule, kUnpackKernelBundleFunc,
+                                                   std::string(bundle_path), kernel_meta_dir);
+  auto count = py::isinstance<py::int_>(ret) ? py::cast<int>(ret) : -1;
+  if (count < 0) {
+    MS_LOG(WARNING) << "Kernel bundle[" << bundle_path << "] can not be used, the kernels will be compiled.";
+    return;
+  }
+  MS_LOG(INFO) << "Unpacked " << count << " kernels of bundle[" << bundle_path << "] into[" << kernel_meta_dir << "].";
+}
+
 bool KernelMeta::ReadIndex(const std::string &bin_dir) {
   DIR *dir = opendir(bin_dir.c_str());
   if (dir == nullptr) {
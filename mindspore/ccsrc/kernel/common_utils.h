@@ -66,6 +66,8 @@ class KernelMeta {
   std::unordered_map<std::string, std::string> kernel_meta_map_;
 };
 
+// Unpack the kernel bundle named by MS_KERNEL_BUNDLE into a kernel meta dir, once per dir, before its index is read.
+void UnpackKernelBundle(const std::string &kernel_meta_dir);
 bool CheckCache(const std::string &kernel_name);
 KernelPackPtr SearchCache(const std::string &kernel_name, const std::string &processor);
 KernelPackPtr InsertCache(const std::string &kernel_name, const std::string &processor);
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_ARRAYS_UNSORTED_SEGMENT_SUM_GPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_ARRAYS_UNSORTED_SEGMENT_SUM_GPU_KERNEL_H_
+
+#include <vector>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/unsorted_segment_sum_impl.cuh"
+
+namespace mindspore {
+namespace kernel {
+// The scatter-add of the rows of x to the segments, it's the dense gradient of GatherV2 on the axis 0. The
+// num_segments input is turned to the attr by the pass ConvertConstInputToAttr.
+template <typename T, typename S>
+class UnsortedSegmentSumGpuKernel : public GpuKernel {
+ public:
+  UnsortedSegmentSumGpuKernel() : ids_num_(1), inner_size_(1), num_segments_(0) {}
+  ~UnsortedSegmentSumGpuKernel() override = default;
+
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
+              const std::vector<AddressPtr> &outputs, uintptr_t stream_ptr) override {
+    T *input_addr = GetDeviceAddress<T>(inputs, 0);
+    S *ids_addr = GetDeviceAddress<S>(inputs, 1);
+    T *output_addr = GetDeviceAddress<T>(outputs, 0);
+    UnsortedSegmentSum(ids_num_, inner_size_, num_segments_, input_addr, ids_addr, output_addr,
+                       reinterpret_cast<cudaStream_t>(stream_ptr));
+    return true;
+  }
+  bool Init(const CNodePtr &kernel_node) override {
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    if (input_num != 2) {
+      MS_LOG(EXCEPTION) << "Argument number is " << input_num << ", but UnsortedSegmentSumGpuKernel needs 2.";
+    }
+    auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+    auto ids_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+    if (ids_shape.size() > input_shape.size()) {
+      MS_LOG(EXCEPTION) << "The rank of segment_ids " << ids_shape.size() << " is larger than the rank of x "
+                        << input_shape.size();
+    }
+    int num_segments = GetAttr<int>(kernel_node, "num_segments");
+    if (num_segments <= 0) {
+      MS_LOG(EXCEPTION) << "The num_segments " << num_segments << " should be positive";
+    }
+    num_segments_ = IntToSize(num_segments);
+    for (size_t i = 0; i < ids_shape.size(); i++) {
+      ids_num_ *= ids_shape[i];
+    }
+    for (size_t i = ids_shape.size(); i < input_shape.size(); i++) {
+      inner_size_ *= input_shape[i];
+    }
+    InitSizeLists();
+    return true;
+  }
+
+ protected:
+  void InitSizeLists() override {
+    input_size_list_.push_back(ids_num_ * inner_size_ * sizeof(T));
+    input_size_list_.push_back(ids_num_ * sizeof(S));
+    output_size_list_.push_back(num_segments_ * inner_size_ * sizeof(T));
+  }
+
+ private:
+  size_t ids_num_;
+  size_t inner_size_;
+  size_t num_segments_;
+
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_ARRAYS_UNSORTED_SEGMENT_SUM_GPU_KERNEL_H_
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_BLOCK_REDUCE_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_BLOCK_REDUCE_H_
+
+#include <cuda_runtime.h>
+
+// The reductions of the rows handled by one block each, included by the .cu files only
+constexpr int kWarpSize = 32;
+constexpr int kMaxRowThreads = 256;
+constexpr size_t kMaxRowBlocks = 65535;
+
+// the threads of a block for a row of row_size elements, a multiple of the warp size
+inline int RowThreads(size_t row_size) {
+  size_t threads = (row_size + kWarpSize - 1) / kWarpSize * kWarpSize;
+  return threads < kMaxRowThreads ? static_cast<int>(threads) : kMaxRowThreads;
+}
+
+// the blocks going over the rows, one row by a block at a time
+inline size_t RowBlocks(size_t row_num) { return row_num < kMaxRowBlocks ? row_num : kMaxRowBlocks; }
+
+struct SumOp {
+  template <typename T>
+  __device__ __forceinline__ T operator()(T lhs, T rhs) const {
+    return lhs + rhs;
+  }
+};
+
+struct MaxOp {
+  template <typename T>
+  __device__ __forceinline__ T operator()(T lhs, T rhs) const {
+    return lhs > rhs ? lhs : rhs;
+  }
+};
+
+struct MinOp {
+  template <typename T>
+  __device__ __forceinline__ T operator()(T lhs, T rhs) const {
+    return lhs < rhs ? lhs : rhs;
+  }
+};
+
+template <typename T, typename Op>
+__device__ __forceinline__ T WarpReduce(T value, Op op) {
+  for (int offset = kWarpSize / 2; offset > 0; offset /= 2) {
+    value = op(value, __shfl_xor_sync(0xffffffff, value, offset));
+  }
+  return value;
+}
+
+// every thread of the block gets the result, blockDim.x is a multiple of the warp size, identity is the value not
+// changing the result of op
+template <typename T, typename Op>
+__device__ __forceinline__ T BlockReduce(T value, Op op, T identity) {
+  __shared__ T warp_results[kMaxRowThreads / kWarpSize];
+  value = WarpReduce(value, op);
+  int warp_num = blockDim.x / kWarpSize;
+  if (warp_num == 1) {
+    return value;
+  }
+  int lane = threadIdx.x % kWarpSize;
+  int warp = threadIdx.x / kWarpSize;
+  if (lane == 0) {
+    warp_results[warp] = value;
+  }
+  __syncthreads();
+  value = lane < warp_num ? warp_results[lane] : identity;
+  value = WarpReduce(value, op);
+  // the shared results may be written by the next reduction
+  __syncthreads();
+  return value;
+}
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_BLOCK_REDUCE_H_
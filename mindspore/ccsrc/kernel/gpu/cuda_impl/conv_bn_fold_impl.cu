@@ -0,0 +1,59 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kernel/gpu/cuda_impl/conv_bn_fold_impl.cuh"
+
+template <typename T>
+__global__ void FoldFilterKernel(const size_t size, const size_t channel_size, const T *filter, const T *scale,
+                                 const T *variance, const float epsilon, T *folded_filter) {
+  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < size; pos += blockDim.x * gridDim.x) {
+    size_t channel = pos / channel_size;
+    float factor = static_cast<float>(scale[channel]) * rsqrtf(static_cast<float>(variance[channel]) + epsilon);
+    folded_filter[pos] = static_cast<T>(static_cast<float>(filter[pos]) * factor);
+  }
+  return;
+}
+
+template <typename T>
+__global__ void FoldBiasKernel(const size_t channel_num, const T *scale, const T *bias, const T *mean,
+                               const T *variance, const float epsilon, T *folded_bias) {
+  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < channel_num; pos += blockDim.x * gridDim.x) {
+    float factor = static_cast<float>(scale[pos]) * rsqrtf(static_cast<float>(variance[pos]) + epsilon);
+    folded_bias[pos] = static_cast<T>(static_cast<float>(bias[pos]) - static_cast<float>(mean[pos]) * factor);
+  }
+  return;
+}
+
+template <typename T>
+void FoldBatchNorm(const size_t channel_num, const size_t channel_size, const T *filter, const T *scale, const T *bias,
+                   const T *mean, const T *variance, const float epsilon, T *folded_filter, T *folded_bias,
+                   cudaStream_t cuda_stream) {
+  size_t size = channel_num * channel_size;
+  FoldFilterKernel<<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(size, channel_size, filter, scale, variance,
+                                                                      epsilon, folded_filter);
+  FoldBiasKernel<<<GET_BLOCKS(channel_num), GET_THREADS, 0, cuda_stream>>>(channel_num, scale, bias, mean, variance,
+                                                                           epsilon, folded_bias);
+  return;
+}
+
+template void FoldBatchNorm<float>(const size_t channel_num, const size_t channel_size, const float *filter,
+                                   const float *scale, const float *bias, const float *mean, const float *variance,
+                                   const float epsilon, float *folded_filter, float *folded_bias,
+                                   cudaStream_t cuda_stream);
+template void FoldBatchNorm<half>(const size_t channel_num, const size_t channel_size, const half *filter,
+                                  const half *scale, const half *bias, const half *mean, const half *variance,
+                                  const float epsilon, half *folded_filter, half *folded_bias,
+                                  cudaStream_t cuda_stream);
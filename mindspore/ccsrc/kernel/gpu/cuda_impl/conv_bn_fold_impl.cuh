@@ -0,0 +1,30 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_CONV_BN_FOLD_IMPL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_CONV_BN_FOLD_IMPL_H_
+
+#include "device/gpu/cuda_common.h"
+
+// Fold the inference BatchNorm following a convolution into its filter and a bias: the filter of the output channel
+// c is scaled by scale[c] / sqrt(variance[c] + epsilon), and the bias is bias[c] - mean[c] times the same factor.
+// channel_size is the number of the filter elements of an output channel.
+template <typename T>
+void FoldBatchNorm(const size_t channel_num, const size_t channel_size, const T *filter, const T *scale, const T *bias,
+                   const T *mean, const T *variance, const float epsilon, T *folded_filter, T *folded_bias,
+                   cudaStream_t cuda_stream);
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_CONV_BN_FOLD_IMPL_H_
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "crop_resize_normalize_impl.cuh"
+
+__device__ __forceinline__ float Pixel(const unsigned char *image, const int *box, size_t width, size_t channel,
+                                       int y, int x, size_t c) {
+  return static_cast<float>(image[((box[1] + y) * width + box[0] + x) * channel + c]);
+}
+
+__global__ void CropResizeNormalizeKernel(size_t size, const unsigned char *input, const int *boxes,
+                                          const float *mean_std, size_t height, size_t width, size_t channel,
+                                          size_t out_height, size_t out_width, float *output) {
+  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < size; pos += blockDim.x * gridDim.x) {
+    size_t out_x = pos % out_width;
+    size_t out_y = pos / out_width % out_height;
+    size_t c = pos / (out_width * out_height) % channel;
+    size_t n = pos / (out_width * out_height * channel);
+    const int *box = boxes + 4 * n;
+
+    // half pixel centers, as the cpu resize does
+    float src_x = (out_x + 0.5f) * box[2] / out_width - 0.5f;
+    float src_y = (out_y + 0.5f) * box[3] / out_height - 0.5f;
+    src_x = fminf(fmaxf(src_x, 0.0f), box[2] - 1.0f);
+    src_y = fminf(fmaxf(src_y, 0.0f), box[3] - 1.0f);
+    int x0 = static_cast<int>(src_x);
+    int y0 = static_cast<int>(src_y);
+    int x1 = min(x0 + 1, box[2] - 1);
+    int y1 = min(y0 + 1, box[3] - 1);
+    float dx = src_x - x0;
+    float dy = src_y - y0;
+
+    const unsigned char *image = input + n * height * width * channel;
+    float top = Pixel(image, box, width, channel, y0, x0, c) * (1.0f - dx) +
+                Pixel(image, box, width, channel, y0, x1, c) * dx;
+    float bottom = Pixel(image, box, width, channel, y1, x0, c) * (1.0f - dx) +
+                   Pixel(image, box, width, channel, y1, x1, c) * dx;
+    float value = top * (1.0f - dy) + bottom * dy;
+    output[pos] = (value - mean_std[c]) / mean_std[channel + c];
+  }
+}
+
+void CropResizeNormalize(const unsigned char *input, const int *boxes, const float *mean_std, size_t batch,
+                         size_t height, size_t width, size_t channel, size_t out_height, size_t out_width,
+                         float *output, cudaStream_t cuda_stream) {
+  size_t size = batch * channel * out_height * out_width;
+  CropResizeNormalizeKernel<<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(
+    size, input, boxes, mean_std, height, width, channel, out_height, out_width, output);
+  return;
+}
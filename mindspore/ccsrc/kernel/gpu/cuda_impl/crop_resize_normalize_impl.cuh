@@ -0,0 +1,28 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_CROP_RESIZE_NORMALIZE_IMPL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_CROP_RESIZE_NORMALIZE_IMPL_H_
+#include "device/gpu/cuda_common.h"
+
+// Crops every image of a <N,H,W,C> uint8 batch to its box (x, y, w, h), resizes the crops bilinearly to
+// <out_height,out_width> and normalizes them per channel, the float output is <N,C,out_height,out_width>.
+// mean_std holds the C means followed by the C standard deviations.
+void CropResizeNormalize(const unsigned char *input, const int *boxes, const float *mean_std, size_t batch,
+                         size_t height, size_t width, size_t channel, size_t out_height, size_t out_width,
+                         float *output, cudaStream_t cuda_stream);
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_CROP_RESIZE_NORMALIZE_IMPL_H_
@@ -18,6 +18,7 @@
 #include <stdint.h>
 #include <cuda_runtime.h>
 #include "cross_entropy_impl.cuh"
+#include "block_reduce.cuh"
 
 template <typename T, typename S>
 __global__ void CrossEntropyWithSparseKernel(const T *logits, const S *labels, const size_t batch_size,
@@ -86,6 +87,44 @@ __global__ void CrossEntropyGradWithoutSparseKernel(const T *logits, const S *la
   return;
 }
 
+// one block for a row, the loss is of the first label of 1 as CrossEntropyWithoutSparseKernel
+template <typename T, typename S>
+__global__ void SoftmaxCrossEntropyWithoutSparseKernel(const T *logits, const S *labels, const size_t batch_size,
+                                                       const size_t class_num, T *losses, T *grad) {
+  T epsilon = 1e-6;
+  for (size_t row = blockIdx.x; row < batch_size; row += gridDim.x) {
+    size_t offset = row * class_num;
+    float max_logit = -HUGE_VALF;
+    for (size_t j = threadIdx.x; j < class_num; j += blockDim.x) {
+      max_logit = fmaxf(max_logit, static_cast<float>(logits[offset + j]));
+    }
+    max_logit = BlockReduce(max_logit, MaxOp(), -HUGE_VALF);
+    float exp_sum = 0.0f;
+    size_t label = class_num;
+    for (size_t j = threadIdx.x; j < class_num; j += blockDim.x) {
+      exp_sum += expf(static_cast<float>(logits[offset + j]) - max_logit);
+      if (label == class_num && fabs(labels[offset + j] - 1.0) <= 1e-8) {
+        label = j;
+      }
+    }
+    exp_sum = BlockReduce(exp_sum, SumOp(), 0.0f);
+    label = BlockReduce(label, MinOp(), class_num);
+    for (size_t j = threadIdx.x; j < class_num; j += blockDim.x) {
+      T prob = static_cast<T>(expf(static_cast<float>(logits[offset + j]) - max_logit) / exp_sum);
+      if (j == label) {
+        grad[offset + j] = (prob - 1) / batch_size;
+        losses[row] = -logf(prob <= 0 ? prob + epsilon : prob);
+      } else {
+        grad[offset + j] = prob / batch_size;
+      }
+    }
+    if (threadIdx.x == 0 && label == class_num) {
+      losses[row] = -logf(epsilon);
+    }
+  }
+  return;
+}
+
 template <typename T, typename S>
 void CrossEntropyWithSparse(const T *logits, const S *labels, const size_t batch_size, const size_t class_num, T *loss,
                             cudaStream_t cuda_stream) {
@@ -116,6 +155,14 @@ void CrossEntropyGradWithoutSparse(const T *logits, const S *labels, const size_
   return;
 }
 
+template <typename T, typename S>
+void SoftmaxCrossEntropyWithoutSparse(const T *logits, const S *labels, const size_t batch_size, const size_t class_num,
+                                      T *losses, T *grad, cudaStream_t cuda_stream) {
+  SoftmaxCrossEntropyWithoutSparseKernel<<<RowBlocks(batch_size), RowThreads(class_num), 0, cuda_stream>>>(
+    logits, labels, batch_size, class_num, losses, grad);
+  return;
+}
+
 template void CrossEntropyWithSparse<float, int>(const float *logits, const int *labels, const size_t batch_size,
                                                  const size_t class_num, float *loss, cudaStream_t cuda_stream);
 template void CrossEntropyWithSparse<float, int64_t>(const float *logits, const int64_t *labels,
@@ -131,3 +178,6 @@ template void CrossEntropyWithoutSparse<float, float>(const float *logits, const
 template void CrossEntropyGradWithoutSparse<float, float>(const float *logits, const float *labels,
                                                           const size_t batch_size, const size_t class_num, float *grad,
                                                           cudaStream_t cuda_stream);
+template void SoftmaxCrossEntropyWithoutSparse<float, float>(const float *logits, const float *labels,
+                                                             const size_t batch_size, const size_t class_num,
+                                                             float *losses, float *grad, cudaStream_t cuda_stream);
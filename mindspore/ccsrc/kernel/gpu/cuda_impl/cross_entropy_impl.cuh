@@ -35,4 +35,9 @@ template <typename T, typename S>
 void CrossEntropyGradWithoutSparse(const T *logits, const S *labels, const size_t batch_size, const size_t class_num,
                                    T *grad, cudaStream_t cuda_stream);
 
+// the softmax of the logits is computed in the registers, the losses and the grads are taken in one pass
+template <typename T, typename S>
+void SoftmaxCrossEntropyWithoutSparse(const T *logits, const S *labels, const size_t batch_size, const size_t class_num,
+                                      T *losses, T *grad, cudaStream_t cuda_stream);
+
 #endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_CROSSENTROPY_H_
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fused_elemwise_impl.cuh"
+template <typename T>
+__device__ __forceinline__ float ToFloat(T value) {
+  return static_cast<float>(value);
+}
+template <>
+__device__ __forceinline__ float ToFloat(half value) {
+  return __half2float(value);
+}
+template <typename T>
+__device__ __forceinline__ T FromFloat(float value) {
+  return static_cast<T>(value);
+}
+template <>
+__device__ __forceinline__ half FromFloat(float value) {
+  return __float2half(value);
+}
+
+__device__ __forceinline__ float FusedElemwiseOp(int op_type, float lhs, float rhs) {
+  switch (op_type) {
+    case FUSED_ELEMWISE_OP_EXP:
+      return expf(lhs);
+    case FUSED_ELEMWISE_OP_LOG:
+      return logf(lhs);
+    case FUSED_ELEMWISE_OP_NEG:
+      return -lhs;
+    case FUSED_ELEMWISE_OP_RECIPROCAL:
+      return 1.0f / lhs;
+    case FUSED_ELEMWISE_OP_RELU:
+      return lhs > 0.0f ? lhs : 0.0f;
+    case FUSED_ELEMWISE_OP_ADD:
+      return lhs + rhs;
+    case FUSED_ELEMWISE_OP_SUB:
+      return lhs - rhs;
+    case FUSED_ELEMWISE_OP_MUL:
+      return lhs * rhs;
+    case FUSED_ELEMWISE_OP_DIV:
+      return lhs / rhs;
+    default:
+      return 0.0f;
+  }
+}
+
+// the intermediate results stay in the registers of the thread, computed in float for half too
+template <typename T>
+__global__ void FusedElemwiseKernel(const FusedElemwiseProgram program, T *output, size_t count) {
+  float regs[mindspore::kMaxFusedElemwiseInputNum + mindspore::kMaxFusedElemwiseOpNum];
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < (count); i += blockDim.x * gridDim.x) {
+    for (int j = 0; j < program.input_num; ++j) {
+      const T *input = static_cast<const T *>(program.inputs[j]);
+      regs[j] = ToFloat(input[program.broadcast[j] ? 0 : i]);
+    }
+    for (int j = 0; j < program.op_num; ++j) {
+      float rhs = program.rhs[j] < 0 ? 0.0f : regs[program.rhs[j]];
+      regs[program.input_num + j] = FusedElemwiseOp(program.op_types[j], regs[program.lhs[j]], rhs);
+    }
+    output[i] = FromFloat<T>(regs[program.input_num + program.op_num - 1]);
+  }
+  return;
+}
+
+template <typename T>
+void FusedElemwise(const FusedElemwiseProgram &program, T *output, size_t count, cudaStream_t cuda_stream) {
+  FusedElemwiseKernel<<<GET_BLOCKS(count), GET_THREADS, 0, cuda_stream>>>(program, output, count);
+  return;
+}
+
+template void FusedElemwise<float>(const FusedElemwiseProgram &program, float *output, size_t count,
+                                   cudaStream_t cuda_stream);
+template void FusedElemwise<half>(const FusedElemwiseProgram &program, half *output, size_t count,
+                                  cudaStream_t cuda_stream);
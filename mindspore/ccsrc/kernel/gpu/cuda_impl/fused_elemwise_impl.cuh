@@ -0,0 +1,53 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_FUSED_ELEMWISE_IMPL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_FUSED_ELEMWISE_IMPL_H_
+
+#include "device/gpu/cuda_common.h"
+#include "utils/utils.h"
+
+enum FusedElemwiseOpType {
+  FUSED_ELEMWISE_OP_EXP = 0,
+  FUSED_ELEMWISE_OP_LOG,
+  FUSED_ELEMWISE_OP_NEG,
+  FUSED_ELEMWISE_OP_RECIPROCAL,
+  FUSED_ELEMWISE_OP_RELU,
+  FUSED_ELEMWISE_OP_ADD,
+  FUSED_ELEMWISE_OP_SUB,
+  FUSED_ELEMWISE_OP_MUL,
+  FUSED_ELEMWISE_OP_DIV,
+  FUSED_ELEMWISE_OP_INVALID_TYPE = 255
+};
+
+// The ops of a fused elementwise kernel in the order of the computation. The operands are the registers of one
+// element: the inputs first, then the result of each op. The output is the result of the last op.
+struct FusedElemwiseProgram {
+  int input_num;
+  int op_num;
+  int op_types[mindspore::kMaxFusedElemwiseOpNum];
+  int lhs[mindspore::kMaxFusedElemwiseOpNum];
+  // -1 for the unary ops
+  int rhs[mindspore::kMaxFusedElemwiseOpNum];
+  // the inputs of one element, broadcast to the whole output
+  bool broadcast[mindspore::kMaxFusedElemwiseInputNum];
+  const void *inputs[mindspore::kMaxFusedElemwiseInputNum];
+};
+
+template <typename T>
+void FusedElemwise(const FusedElemwiseProgram &program, T *output, size_t count, cudaStream_t cuda_stream);
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_FUSED_ELEMWISE_IMPL_H_
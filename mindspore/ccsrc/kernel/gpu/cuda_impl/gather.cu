@@ -16,23 +16,24 @@
 
 #include <iostream>
 #include "kernel/gpu/cuda_impl/gather.cuh"
+#include "kernel/gpu/cuda_impl/vector_copy.cuh"
 #include "device/gpu/cuda_common.h"
+// T is CopyVector when the rows of output_dim2 elements are moved by the vectors, zero is the 0 of T
 template <typename T, typename S>
-__global__ void GatherKernel(T *input, S *indices, T *output, size_t output_dim0, size_t output_dim1,
-                             size_t output_dim2, size_t input_dim1) {
-  int num = output_dim0 * output_dim1 * output_dim2;
-  int i, j, k;
-  for (int write_index = blockIdx.x * blockDim.x + threadIdx.x; write_index < num;
+__global__ void GatherKernel(const T *input, const S *indices, T *output, size_t output_dim0, size_t output_dim1,
+                             size_t output_dim2, size_t input_dim1, const T zero) {
+  size_t num = output_dim0 * output_dim1 * output_dim2;
+  for (size_t write_index = blockIdx.x * blockDim.x + threadIdx.x; write_index < num;
        write_index += blockDim.x * gridDim.x) {
-    i = write_index / (output_dim1 * output_dim2) % output_dim0;
-    j = write_index / output_dim2 % output_dim1;
-    k = write_index % output_dim2;
-
-    if ((indices[j] >= 0) && (indices[j] < input_dim1)) {
-      int read_index = i * input_dim1 * output_dim2 + indices[j] * output_dim2 + k;
+    size_t i = write_index / (output_dim1 * output_dim2);
+    size_t j = write_index / output_dim2 % output_dim1;
+    size_t k = write_index % output_dim2;
+    S index = indices[j];
+    if ((index >= 0) && (static_cast<size_t>(index) < input_dim1)) {
+      size_t read_index = (i * input_dim1 + index) * output_dim2 + k;
       output[write_index] = input[read_index];
     } else {
-      output[write_index] = 0;
+      output[write_index] = zero;
     }
   }
 
@@ -41,9 +42,17 @@ __global__ void GatherKernel(T *input, S *indices, T *output, size_t output_dim0
 template <typename T, typename S>
 void Gather(T *input, S *indices, T *output, size_t output_dim0, size_t output_dim1, size_t output_dim2,
             size_t input_dim1, cudaStream_t stream) {
-  int size = output_dim0 * output_dim1 * output_dim2;
+  if (CanCopyByVector(input, output, output_dim2 * sizeof(T))) {
+    size_t vector_dim2 = output_dim2 * sizeof(T) / kCopyVectorBytes;
+    size_t size = output_dim0 * output_dim1 * vector_dim2;
+    GatherKernel<<<GET_BLOCKS(size), GET_THREADS, 0, stream>>>(
+      reinterpret_cast<const CopyVector *>(input), indices, reinterpret_cast<CopyVector *>(output), output_dim0,
+      output_dim1, vector_dim2, input_dim1, make_float4(0, 0, 0, 0));
+    return;
+  }
+  size_t size = output_dim0 * output_dim1 * output_dim2;
   GatherKernel<<<GET_BLOCKS(size), GET_THREADS, 0, stream>>>(input, indices, output, output_dim0, output_dim1,
-                                                             output_dim2, input_dim1);
+                                                             output_dim2, input_dim1, static_cast<T>(0));
   return;
 }
 
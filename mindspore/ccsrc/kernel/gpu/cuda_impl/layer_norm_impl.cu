@@ -0,0 +1,175 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "layer_norm_impl.cuh"
+#include "block_reduce.cuh"
+
+// the same as the one of the Ascend kernel
+constexpr float kLayerNormEpsilon = 1e-12;
+// the elements of a param summed by one thread in the partial sums of dgamma and dbeta
+constexpr size_t kParamGradChunkSize = 64;
+constexpr size_t kMaxParamGradChunkNum = 1024;
+constexpr int kParamGradThreads = 256;
+
+size_t ParamGradChunkNum(const size_t row_num, const size_t col_num, const size_t param_num) {
+  size_t elem_num = row_num * col_num / param_num;
+  size_t chunk_num = (elem_num + kParamGradChunkSize - 1) / kParamGradChunkSize;
+  return chunk_num < kMaxParamGradChunkNum ? chunk_num : kMaxParamGradChunkNum;
+}
+
+// one pass over the row for the sums of x and x * x, the second one reads the row from the cache
+template <typename T>
+__global__ void LayerNormKernel(const size_t row_num, const size_t col_num, const size_t param_num, const T *x,
+                                const T *gamma, const T *beta, T *y, T *mean, T *variance) {
+  for (size_t row = blockIdx.x; row < row_num; row += gridDim.x) {
+    size_t offset = row * col_num;
+    float sum = 0.0f;
+    float square_sum = 0.0f;
+    for (size_t j = threadIdx.x; j < col_num; j += blockDim.x) {
+      float value = static_cast<float>(x[offset + j]);
+      sum += value;
+      square_sum += value * value;
+    }
+    sum = BlockReduce(sum, SumOp(), 0.0f);
+    square_sum = BlockReduce(square_sum, SumOp(), 0.0f);
+    float row_mean = sum / col_num;
+    float row_variance = fmaxf(square_sum / col_num - row_mean * row_mean, 0.0f);
+    float rstd = rsqrtf(row_variance + kLayerNormEpsilon);
+    for (size_t j = threadIdx.x; j < col_num; j += blockDim.x) {
+      size_t param = (offset + j) % param_num;
+      float value = (static_cast<float>(x[offset + j]) - row_mean) * rstd;
+      y[offset + j] = static_cast<T>(value * static_cast<float>(gamma[param]) + static_cast<float>(beta[param]));
+    }
+    if (threadIdx.x == 0) {
+      mean[row] = static_cast<T>(row_mean);
+      variance[row] = static_cast<T>(row_variance);
+    }
+  }
+  return;
+}
+
+// dx = rstd * (g - mean(g) - x_hat * mean(g * x_hat)), g = dy * gamma, over the row
+template <typename T>
+__global__ void LayerNormInputGradKernel(const size_t row_num, const size_t col_num, const size_t param_num,
+                                         const T *x, const T *dy, const T *variance, const T *mean, const T *gamma,
+                                         T *dx) {
+  for (size_t row = blockIdx.x; row < row_num; row += gridDim.x) {
+    size_t offset = row * col_num;
+    float row_mean = static_cast<float>(mean[row]);
+    float rstd = rsqrtf(static_cast<float>(variance[row]) + kLayerNormEpsilon);
+    float sum = 0.0f;
+    float x_hat_sum = 0.0f;
+    for (size_t j = threadIdx.x; j < col_num; j += blockDim.x) {
+      float g = static_cast<float>(dy[offset + j]) * static_cast<float>(gamma[(offset + j) % param_num]);
+      sum += g;
+      x_hat_sum += g * (static_cast<float>(x[offset + j]) - row_mean) * rstd;
+    }
+    sum = BlockReduce(sum, SumOp(), 0.0f) / col_num;
+    x_hat_sum = BlockReduce(x_hat_sum, SumOp(), 0.0f) / col_num;
+    for (size_t j = threadIdx.x; j < col_num; j += blockDim.x) {
+      float g = static_cast<float>(dy[offset + j]) * static_cast<float>(gamma[(offset + j) % param_num]);
+      float x_hat = (static_cast<float>(x[offset + j]) - row_mean) * rstd;
+      dx[offset + j] = static_cast<T>(rstd * (g - sum - x_hat * x_hat_sum));
+    }
+  }
+  return;
+}
+
+// the threads go over the params, the blocks of y over the chunks of the elements of the params
+template <typename T>
+__global__ void LayerNormParamGradPartialKernel(const size_t col_num, const size_t param_num, const size_t elem_num,
+                                                const size_t chunk_size, const T *x, const T *dy, const T *variance,
+                                                const T *mean, float *dgamma_part, float *dbeta_part) {
+  size_t param = blockIdx.x * blockDim.x + threadIdx.x;
+  if (param >= param_num) {
+    return;
+  }
+  size_t begin = blockIdx.y * chunk_size;
+  size_t end = begin + chunk_size < elem_num ? begin + chunk_size : elem_num;
+  float dgamma = 0.0f;
+  float dbeta = 0.0f;
+  for (size_t k = begin; k < end; ++k) {
+    size_t i = k * param_num + param;
+    size_t row = i / col_num;
+    float x_hat = (static_cast<float>(x[i]) - static_cast<float>(mean[row])) *
+                  rsqrtf(static_cast<float>(variance[row]) + kLayerNormEpsilon);
+    dgamma += static_cast<float>(dy[i]) * x_hat;
+    dbeta += static_cast<float>(dy[i]);
+  }
+  dgamma_part[blockIdx.y * param_num + param] = dgamma;
+  dbeta_part[blockIdx.y * param_num + param] = dbeta;
+  return;
+}
+
+template <typename T>
+__global__ void LayerNormParamGradKernel(const size_t param_num, const size_t chunk_num, const float *dgamma_part,
+                                         const float *dbeta_part, T *dgamma, T *dbeta) {
+  for (size_t param = blockIdx.x * blockDim.x + threadIdx.x; param < param_num; param += blockDim.x * gridDim.x) {
+    float dgamma_sum = 0.0f;
+    float dbeta_sum = 0.0f;
+    for (size_t c = 0; c < chunk_num; ++c) {
+      dgamma_sum += dgamma_part[c * param_num + param];
+      dbeta_sum += dbeta_part[c * param_num + param];
+    }
+    dgamma[param] = static_cast<T>(dgamma_sum);
+    dbeta[param] = static_cast<T>(dbeta_sum);
+  }
+  return;
+}
+
+template <typename T>
+void LayerNorm(const size_t row_num, const size_t col_num, const size_t param_num, const T *x, const T *gamma,
+               const T *beta, T *y, T *mean, T *variance, cudaStream_t cuda_stream) {
+  LayerNormKernel<<<RowBlocks(row_num), RowThreads(col_num), 0, cuda_stream>>>(row_num, col_num, param_num, x, gamma,
+                                                                               beta, y, mean, variance);
+  return;
+}
+
+size_t LayerNormGradWorkspaceNum(const size_t row_num, const size_t col_num, const size_t param_num) {
+  return 2 * ParamGradChunkNum(row_num, col_num, param_num) * param_num;
+}
+
+template <typename T>
+void LayerNormGrad(const size_t row_num, const size_t col_num, const size_t param_num, const T *x, const T *dy,
+                   const T *variance, const T *mean, const T *gamma, T *dx, T *dgamma, T *dbeta, float *workspace,
+                   cudaStream_t cuda_stream) {
+  LayerNormInputGradKernel<<<RowBlocks(row_num), RowThreads(col_num), 0, cuda_stream>>>(
+    row_num, col_num, param_num, x, dy, variance, mean, gamma, dx);
+  size_t elem_num = row_num * col_num / param_num;
+  size_t chunk_num = ParamGradChunkNum(row_num, col_num, param_num);
+  size_t chunk_size = (elem_num + chunk_num - 1) / chunk_num;
+  float *dgamma_part = workspace;
+  float *dbeta_part = workspace + chunk_num * param_num;
+  dim3 blocks((param_num + kParamGradThreads - 1) / kParamGradThreads, chunk_num);
+  LayerNormParamGradPartialKernel<<<blocks, kParamGradThreads, 0, cuda_stream>>>(
+    col_num, param_num, elem_num, chunk_size, x, dy, variance, mean, dgamma_part, dbeta_part);
+  LayerNormParamGradKernel<<<GET_BLOCKS(param_num), GET_THREADS, 0, cuda_stream>>>(param_num, chunk_num, dgamma_part,
+                                                                                   dbeta_part, dgamma, dbeta);
+  return;
+}
+
+template void LayerNorm<float>(const size_t row_num, const size_t col_num, const size_t param_num, const float *x,
+                               const float *gamma, const float *beta, float *y, float *mean, float *variance,
+                               cudaStream_t cuda_stream);
+template void LayerNorm<half>(const size_t row_num, const size_t col_num, const size_t param_num, const half *x,
+                              const half *gamma, const half *beta, half *y, half *mean, half *variance,
+                              cudaStream_t cuda_stream);
+template void LayerNormGrad<float>(const size_t row_num, const size_t col_num, const size_t param_num, const float *x,
+                                   const float *dy, const float *variance, const float *mean, const float *gamma,
+                                   float *dx, float *dgamma, float *dbeta, float *workspace, cudaStream_t cuda_stream);
+template void LayerNormGrad<half>(const size_t row_num, const size_t col_num, const size_t param_num, const half *x,
+                                  const half *dy, const half *variance, const half *mean, const half *gamma, half *dx,
+                                  half *dgamma, half *dbeta, float *workspace, cudaStream_t cuda_stream);
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_LAYER_NORM_IMPL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_LAYER_NORM_IMPL_H_
+
+#include "device/gpu/cuda_common.h"
+
+// The input is normalized over the col_num elements of each of the row_num rows, the element i takes the gamma and
+// beta i % param_num. The mean and the variance are of the rows.
+template <typename T>
+void LayerNorm(const size_t row_num, const size_t col_num, const size_t param_num, const T *x, const T *gamma,
+               const T *beta, T *y, T *mean, T *variance, cudaStream_t cuda_stream);
+
+// the floats of the workspace of LayerNormGrad, keeping the partial sums of dgamma and dbeta
+size_t LayerNormGradWorkspaceNum(const size_t row_num, const size_t col_num, const size_t param_num);
+
+template <typename T>
+void LayerNormGrad(const size_t row_num, const size_t col_num, const size_t param_num, const T *x, const T *dy,
+                   const T *variance, const T *mean, const T *gamma, T *dx, T *dgamma, T *dbeta, float *workspace,
+                   cudaStream_t cuda_stream);
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_LAYER_NORM_IMPL_H_
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <float.h>
+#include "kernel/gpu/cuda_impl/loss_scale_impl.cuh"
+
+// the threads of a block of NumericStatus, reduced in the shared memory, so it is a power of 2
+constexpr int kNumericStatusThreads = 256;
+
+__device__ void AtomicMinFloat(float *address, float value) {
+  int *address_as_int = reinterpret_cast<int *>(address);
+  int old = *address_as_int;
+  while (value < __int_as_float(old)) {
+    int assumed = old;
+    old = atomicCAS(address_as_int, assumed, __float_as_int(value));
+    if (old == assumed) {
+      break;
+    }
+  }
+}
+
+__device__ void AtomicMaxFloat(float *address, float value) {
+  int *address_as_int = reinterpret_cast<int *>(address);
+  int old = *address_as_int;
+  while (value > __int_as_float(old)) {
+    int assumed = old;
+    old = atomicCAS(address_as_int, assumed, __float_as_int(value));
+    if (old == assumed) {
+      break;
+    }
+  }
+}
+
+template <typename T>
+__global__ void CheckOverflowKernel(const CheckOverflowTensors<T> tensors, bool *overflow) {
+  size_t t = 0;
+  while (t + 1 < tensors.tensor_num && blockIdx.x >= tensors.block_offset[t + 1]) {
+    t++;
+  }
+  size_t begin = (blockIdx.x - tensors.block_offset[t]) * kCheckOverflowChunkSize;
+  size_t end = begin + kCheckOverflowChunkSize < tensors.size[t] ? begin + kCheckOverflowChunkSize : tensors.size[t];
+  const T *input = tensors.input[t];
+  bool found = false;
+  for (size_t i = begin + threadIdx.x; i < end; i += blockDim.x) {
+    found = found || !isfinite(static_cast<float>(input[i]));
+  }
+  // all the writers write true, so the race between them is harmless
+  if (found) {
+    *overflow = true;
+  }
+  return;
+}
+
+__global__ void NumericStatusInitKernel(const size_t tensor_num, float *status) {
+  for (size_t t = threadIdx.x; t < tensor_num; t += blockDim.x) {
+    float *row = status + t * kNumericStatusSize;
+    row[0] = 0;
+    row[1] = 0;
+    row[2] = FLT_MAX;
+    row[3] = -FLT_MAX;
+    row[4] = 0;
+  }
+  return;
+}
+
+// each block reduces its chunk in the shared memory, then updates the status of the tensor atomically
+template <typename T>
+__global__ void NumericStatusKernel(const CheckOverflowTensors<T> tensors, float *status) {
+  __shared__ float shared[kNumericStatusSize][kNumericStatusThreads];
+  size_t t = 0;
+  while (t + 1 < tensors.tensor_num && blockIdx.x >= tensors.block_offset[t + 1]) {
+    t++;
+  }
+  size_t begin = (blockIdx.x - tensors.block_offset[t]) * kCheckOverflowChunkSize;
+  size_t end = begin + kCheckOverflowChunkSize < tensors.size[t] ? begin + kCheckOverflowChunkSize : tensors.size[t];
+  const T *input = tensors.input[t];
+  float nan_count = 0;
+  float inf_count = 0;
+  float min_value = FLT_MAX;
+  float max_value = -FLT_MAX;
+  float sum = 0;
+  for (size_t i = begin + threadIdx.x; i < end; i += blockDim.x) {
+    float value = static_cast<float>(input[i]);
+    if (isnan(value)) {
+      nan_count += 1;
+    } else if (isinf(value)) {
+      inf_count += 1;
+    } else {
+      min_value = fminf(min_value, value);
+      max_value = fmaxf(max_value, value);
+      sum += value;
+    }
+  }
+  shared[0][threadIdx.x] = nan_count;
+  shared[1][threadIdx.x] = inf_count;
+  shared[2][threadIdx.x] = min_value;
+  shared[3][threadIdx.x] = max_value;
+  shared[4][threadIdx.x] = sum;
+  __syncthreads();
+  for (unsigned int stride = blockDim.x / 2; stride > 0; stride /= 2) {
+    if (threadIdx.x < stride) {
+      shared[0][threadIdx.x] += shared[0][threadIdx.x + stride];
+      shared[1][threadIdx.x] += shared[1][threadIdx.x + stride];
+      shared[2][threadIdx.x] = fminf(shared[2][threadIdx.x], shared[2][threadIdx.x + stride]);
+      shared[3][threadIdx.x] = fmaxf(shared[3][threadIdx.x], shared[3][threadIdx.x + stride]);
+      shared[4][threadIdx.x] += shared[4][threadIdx.x + stride];
+    }
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) {
+    float *row = status + t * kNumericStatusSize;
+    atomicAdd(&row[0], shared[0][0]);
+    atomicAdd(&row[1], shared[1][0]);
+    AtomicMinFloat(&row[2], shared[2][0]);
+    AtomicMaxFloat(&row[3], shared[3][0]);
+    atomicAdd(&row[4], shared[4][0]);
+  }
+  return;
+}
+
+// the sums are divided to the means, the min and max of the tensors without finite elements are set to 0
+template <typename T>
+__global__ void NumericStatusFinishKernel(const CheckOverflowTensors<T> tensors, float *status) {
+  for (size_t t = threadIdx.x; t < tensors.tensor_num; t += blockDim.x) {
+    float *row = status + t * kNumericStatusSize;
+    float finite_count = static_cast<float>(tensors.size[t]) - row[0] - row[1];
+    if (finite_count > 0) {
+      row[4] = row[4] / finite_count;
+    } else {
+      row[2] = 0;
+      row[3] = 0;
+      row[4] = 0;
+    }
+  }
+  return;
+}
+
+__global__ void UpdateLossScaleKernel(const bool *overflow, float *loss_scale, int *cur_iter, int *last_overflow_iter,
+                                      const float scale_factor, const int scale_window, bool *output) {
+  bool is_overflow = overflow[0];
+  int iter = cur_iter[0];
+  if (is_overflow) {
+    loss_scale[0] = fmaxf(loss_scale[0] / scale_factor, 1.0f);
+    last_overflow_iter[0] = iter;
+  } else if (iter - last_overflow_iter[0] >= scale_window) {
+    loss_scale[0] = loss_scale[0] * scale_factor;
+    last_overflow_iter[0] = iter;
+  }
+  cur_iter[0] = iter + 1;
+  output[0] = is_overflow;
+  return;
+}
+
+template <typename T>
+void CheckOverflow(const CheckOverflowTensors<T> &tensors, bool *overflow, cudaStream_t cuda_stream) {
+  size_t block_num = tensors.block_offset[tensors.tensor_num];
+  if (block_num == 0) {
+    return;
+  }
+  CheckOverflowKernel<<<block_num, GET_THREADS, 0, cuda_stream>>>(tensors, overflow);
+  return;
+}
+
+template <typename T>
+void NumericStatus(const CheckOverflowTensors<T> &tensors, float *status, cudaStream_t cuda_stream) {
+  NumericStatusInitKernel<<<1, kNumericStatusThreads, 0, cuda_stream>>>(tensors.tensor_num, status);
+  size_t block_num = tensors.block_offset[tensors.tensor_num];
+  if (block_num > 0) {
+    NumericStatusKernel<<<block_num, kNumericStatusThreads, 0, cuda_stream>>>(tensors, status);
+  }
+  NumericStatusFinishKernel<<<1, kNumericStatusThreads, 0, cuda_stream>>>(tensors, status);
+  return;
+}
+
+void UpdateLossScale(const bool *overflow, float *loss_scale, int *cur_iter, int *last_overflow_iter,
+                     const float scale_factor, const int scale_window, bool *output, cudaStream_t cuda_stream) {
+  UpdateLossScaleKernel<<<1, 1, 0, cuda_stream>>>(overflow, loss_scale, cur_iter, last_overflow_iter, scale_factor,
+                                                  scale_window, output);
+  return;
+}
+
+template void CheckOverflow<float>(const CheckOverflowTensors<float> &tensors, bool *overflow,
+                                   cudaStream_t cuda_stream);
+template void CheckOverflow<half>(const CheckOverflowTensors<half> &tensors, bool *overflow, cudaStream_t cuda_stream);
+template void NumericStatus<float>(const CheckOverflowTensors<float> &tensors, float *status,
+                                   cudaStream_t cuda_stream);
+template void NumericStatus<half>(const CheckOverflowTensors<half> &tensors, float *status, cudaStream_t cuda_stream);
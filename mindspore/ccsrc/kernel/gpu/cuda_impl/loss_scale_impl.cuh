@@ -0,0 +1,53 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_LOSS_SCALE_IMPL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_LOSS_SCALE_IMPL_H_
+
+#include "device/gpu/cuda_common.h"
+
+// the tensors checked by one launch of CheckOverflow, bounded by the size of the kernel args
+constexpr size_t kMaxCheckOverflowTensorNum = 64;
+// the elements of a tensor checked by one block
+constexpr size_t kCheckOverflowChunkSize = 4096;
+
+template <typename T>
+struct CheckOverflowTensors {
+  size_t tensor_num;
+  const T *input[kMaxCheckOverflowTensorNum];
+  size_t size[kMaxCheckOverflowTensorNum];
+  // the first block of each tensor, the last one is the number of the blocks
+  size_t block_offset[kMaxCheckOverflowTensorNum + 1];
+};
+
+// overflow is set to true if any element of the tensors is inf or nan, it is left alone otherwise
+template <typename T>
+void CheckOverflow(const CheckOverflowTensors<T> &tensors, bool *overflow, cudaStream_t cuda_stream);
+
+// The columns of the numeric status of a tensor: the counts of nan and inf, and the min, max and mean of the finite
+// elements, which are 0 if there are none
+constexpr size_t kNumericStatusSize = 5;
+
+// the rows of status are the numeric status of the tensors, in the same launches as CheckOverflow
+template <typename T>
+void NumericStatus(const CheckOverflowTensors<T> &tensors, float *status, cudaStream_t cuda_stream);
+
+// The dynamic loss scale: on overflow the loss scale is divided by scale_factor down to 1, after scale_window steps
+// without overflow it is multiplied by scale_factor. The overflow is copied to the output.
+void UpdateLossScale(const bool *overflow, float *loss_scale, int *cur_iter, int *last_overflow_iter,
+                     const float scale_factor, const int scale_window, bool *output, cudaStream_t cuda_stream);
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_LOSS_SCALE_IMPL_H_
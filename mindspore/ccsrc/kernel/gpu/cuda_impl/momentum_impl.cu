@@ -31,9 +31,36 @@ void MomentumUpdateVariable(const size_t size, T *variable, T *accumulation, con
                                                                                   learning_rate, gradient, momentum);
   return;
 }
+template <typename T>
+__global__ void FusedMomentumUpdateVariableKernel(const FusedMomentumTensors<T> tensors) {
+  size_t t = 0;
+  while (t + 1 < tensors.tensor_num && blockIdx.x >= tensors.block_offset[t + 1]) {
+    t++;
+  }
+  size_t begin = (blockIdx.x - tensors.block_offset[t]) * kFusedMomentumChunkSize;
+  size_t end = begin + kFusedMomentumChunkSize < tensors.size[t] ? begin + kFusedMomentumChunkSize : tensors.size[t];
+  T *variable = tensors.variable[t];
+  T *accumulation = tensors.accumulation[t];
+  const T *gradient = tensors.gradient[t];
+  const T learning_rate = tensors.learning_rate[t][0];
+  const T momentum = tensors.momentum[t][0];
+  for (size_t i = begin + threadIdx.x; i < end; i += blockDim.x) {
+    accumulation[i] = momentum * accumulation[i] + gradient[i];
+    variable[i] -= learning_rate * accumulation[i];
+  }
+  return;
+}
+template <typename T>
+void FusedMomentumUpdateVariable(const FusedMomentumTensors<T> &tensors, cudaStream_t cuda_stream) {
+  size_t block_num = tensors.block_offset[tensors.tensor_num];
+  FusedMomentumUpdateVariableKernel<<<block_num, GET_THREADS, 0, cuda_stream>>>(tensors);
+  return;
+}
 template void MomentumUpdateVariable<float>(const size_t size, float *variable, float *accumulation,
                                             const float *learning_rate, const float *gradient, const float *momentum,
                                             cudaStream_t cuda_stream);
 template void MomentumUpdateVariable<half>(const size_t size, half *variable, half *accumulation,
                                            const half *learning_rate, const half *gradient, const half *momentum,
                                            cudaStream_t cuda_stream);
+template void FusedMomentumUpdateVariable<float>(const FusedMomentumTensors<float> &tensors, cudaStream_t cuda_stream);
+template void FusedMomentumUpdateVariable<half>(const FusedMomentumTensors<half> &tensors, cudaStream_t cuda_stream);
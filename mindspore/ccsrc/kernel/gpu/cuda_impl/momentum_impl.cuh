@@ -22,4 +22,25 @@ template <typename T>
 void MomentumUpdateVariable(const size_t size, T *variable, T *accumulation, const T *learning_rate, const T *gradient,
                             const T *momentum, cudaStream_t cuda_stream);
 
+// the tensors updated by one launch of the fused momentum, bounded by the size of the kernel args
+constexpr size_t kMaxFusedMomentumTensorNum = 32;
+// the elements of a tensor updated by one block
+constexpr size_t kFusedMomentumChunkSize = 4096;
+
+template <typename T>
+struct FusedMomentumTensors {
+  size_t tensor_num;
+  T *variable[kMaxFusedMomentumTensorNum];
+  T *accumulation[kMaxFusedMomentumTensorNum];
+  const T *learning_rate[kMaxFusedMomentumTensorNum];
+  const T *gradient[kMaxFusedMomentumTensorNum];
+  const T *momentum[kMaxFusedMomentumTensorNum];
+  size_t size[kMaxFusedMomentumTensorNum];
+  // the first block of each tensor, the last one is the number of the blocks
+  size_t block_offset[kMaxFusedMomentumTensorNum + 1];
+};
+
+template <typename T>
+void FusedMomentumUpdateVariable(const FusedMomentumTensors<T> &tensors, cudaStream_t cuda_stream);
+
 #endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMP_MOMENTUMIMPL_H_
@@ -19,21 +19,57 @@
 #include <stdint.h>
 #include <algorithm>
 #include "kernel/gpu/cuda_impl/slice_impl.cuh"
+#include "kernel/gpu/cuda_impl/vector_copy.cuh"
 
+struct Slice4DInfo {
+  int in_shape[4];
+  int begin[4];
+  int size[4];
+};
+
+__device__ __forceinline__ size_t SliceInputPos(size_t pos, const Slice4DInfo& info) {
+  size_t l = pos % info.size[3];
+  pos /= info.size[3];
+  size_t k = pos % info.size[2];
+  pos /= info.size[2];
+  size_t j = pos % info.size[1];
+  size_t i = pos / info.size[1];
+  return (((i + info.begin[0]) * info.in_shape[1] + j + info.begin[1]) * info.in_shape[2] + k + info.begin[2]) *
+           info.in_shape[3] +
+         l + info.begin[3];
+}
+// one launch for all the elements of the slice, T is CopyVector when the rows are moved by the vectors
 template <typename T>
-__global__ void Slice(const T* input, int p, int start, int length, T* output) {
-  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < (length); pos += blockDim.x * gridDim.x) {
-    output[p + pos] = input[start + pos];
+__global__ void Slice(const size_t size, const T* input, const Slice4DInfo info, T* output) {
+  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < size; pos += blockDim.x * gridDim.x) {
+    output[pos] = input[SliceInputPos(pos, info)];
   }
   return;
 }
 template <typename T>
-__global__ void SliceGrad(const T* dy, int p, int start, int length, T* output) {
-  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < (length); pos += blockDim.x * gridDim.x) {
-    output[start + pos] = dy[p + pos];
+__global__ void SliceGrad(const size_t size, const T* dy, const Slice4DInfo info, T* dx) {
+  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < size; pos += blockDim.x * gridDim.x) {
+    dx[SliceInputPos(pos, info)] = dy[pos];
   }
   return;
 }
+// the last dims are in the vectors if all of them are aligned to the vectors
+template <typename T>
+bool GetSlice4DInfo(const void* input, const void* output, const std::vector<int>& in_shape,
+                    const std::vector<int>& begin, const std::vector<int>& size, Slice4DInfo* info, size_t* count) {
+  const int vector_size = static_cast<int>(kCopyVectorBytes / sizeof(T));
+  bool by_vector = CanCopyByVector(input, output, size[3] * sizeof(T)) && in_shape[3] % vector_size == 0 &&
+                   begin[3] % vector_size == 0;
+  *count = 1;
+  for (size_t i = 0; i < 4; i++) {
+    int scale = (by_vector && i == 3) ? vector_size : 1;
+    info->in_shape[i] = in_shape[i] / scale;
+    info->begin[i] = begin[i] / scale;
+    info->size[i] = size[i] / scale;
+    *count *= info->size[i];
+  }
+  return by_vector;
+}
 template <typename T>
 __global__ void StridedSlice(const T* input, int p, int start, int begin, int stride, int ended, T* output) {
   for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < ((ended - 1 - begin) / stride) + 1;
@@ -66,37 +102,25 @@ void FillDeviceArray(const size_t input_size, T* addr, const float value, cudaSt
 template <typename T>
 void CalSlice(const size_t input_size, const T* input, const std::vector<int> in_shape, const std::vector<int> begin,
               const std::vector<int> size, T* output, cudaStream_t cuda_stream) {
-  int block = in_shape[1] * in_shape[2] * in_shape[3];
-  int map = in_shape[2] * in_shape[3];
-  int w = in_shape[3];
-  int length = size[3];
-  int p = 0;
-  for (int i = begin[0]; i < size[0] + begin[0]; i++) {
-    for (int j = begin[1]; j < size[1] + begin[1]; j++) {
-      for (int k = begin[2]; k < size[2] + begin[2]; k++) {
-        Slice<<<GET_BLOCKS(input_size), GET_THREADS, 0, cuda_stream>>>(input, p, i * block + j * map + k * w + begin[3],
-                                                                       length, output);
-        p = p + size[3];
-      }
-    }
+  Slice4DInfo info;
+  size_t count = 0;
+  if (GetSlice4DInfo<T>(input, output, in_shape, begin, size, &info, &count)) {
+    Slice<<<GET_BLOCKS(count), GET_THREADS, 0, cuda_stream>>>(count, reinterpret_cast<const CopyVector*>(input), info,
+                                                              reinterpret_cast<CopyVector*>(output));
+  } else {
+    Slice<<<GET_BLOCKS(count), GET_THREADS, 0, cuda_stream>>>(count, input, info, output);
   }
 }
 template <typename T>
 void CalSliceGrad(const size_t input_size, const T* dy, const std::vector<int> in_shape, const std::vector<int> begin,
                   const std::vector<int> size, T* output, cudaStream_t cuda_stream) {
-  int block = in_shape[1] * in_shape[2] * in_shape[3];
-  int map = in_shape[2] * in_shape[3];
-  int w = in_shape[3];
-  int length = size[3];
-  int p = 0;
-  for (int i = begin[0]; i < size[0] + begin[0]; i++) {
-    for (int j = begin[1]; j < size[1] + begin[1]; j++) {
-      for (int k = begin[2]; k < size[2] + begin[2]; k++) {
-        SliceGrad<<<GET_BLOCKS(input_size), GET_THREADS, 0, cuda_stream>>>(
-          dy, p, i * block + j * map + k * w + begin[3], length, output);
-        p = p + size[3];
-      }
-    }
+  Slice4DInfo info;
+  size_t count = 0;
+  if (GetSlice4DInfo<T>(output, dy, in_shape, begin, size, &info, &count)) {
+    SliceGrad<<<GET_BLOCKS(count), GET_THREADS, 0, cuda_stream>>>(count, reinterpret_cast<const CopyVector*>(dy), info,
+                                                                  reinterpret_cast<CopyVector*>(output));
+  } else {
+    SliceGrad<<<GET_BLOCKS(count), GET_THREADS, 0, cuda_stream>>>(count, dy, info, output);
   }
 }
 template <typename T>
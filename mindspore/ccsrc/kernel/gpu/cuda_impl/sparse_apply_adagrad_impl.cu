@@ -0,0 +1,104 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <climits>
+#include "kernel/gpu/cuda_impl/sparse_apply_adagrad_impl.cuh"
+
+template <typename S>
+__device__ __forceinline__ bool IsValidRow(S index, size_t var_rows) {
+  return index >= 0 && static_cast<size_t>(index) < var_rows;
+}
+
+// only the slots of the rows in the indices are touched, so the row_slot needn't be cleared as a whole
+template <typename S>
+__global__ void ResetRowSlotKernel(const size_t var_rows, const size_t indices_num, const S *indices, int *row_slot) {
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < indices_num; i += blockDim.x * gridDim.x) {
+    if (IsValidRow(indices[i], var_rows)) {
+      row_slot[indices[i]] = INT_MAX;
+    }
+  }
+  return;
+}
+
+template <typename S>
+__global__ void FindRowSlotKernel(const size_t var_rows, const size_t indices_num, const S *indices, int *row_slot) {
+  for (size_t i = blockIdx.x * blockDim.x + threadIdx.x; i < indices_num; i += blockDim.x * gridDim.x) {
+    if (IsValidRow(indices[i], var_rows)) {
+      (void)atomicMin(row_slot + indices[i], static_cast<int>(i));
+    }
+  }
+  return;
+}
+
+template <typename T, typename S>
+__global__ void SumGradientKernel(const size_t var_rows, const size_t inner_size, const size_t indices_num,
+                                  const T *gradient, const S *indices, const int *row_slot, T *grad_sum) {
+  size_t num = indices_num * inner_size;
+  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < num; pos += blockDim.x * gridDim.x) {
+    S index = indices[pos / inner_size];
+    if (IsValidRow(index, var_rows)) {
+      size_t slot = static_cast<size_t>(row_slot[index]);
+      atomicAdd(grad_sum + slot * inner_size + pos % inner_size, gradient[pos]);
+    }
+  }
+  return;
+}
+
+template <typename T, typename S>
+__global__ void SparseApplyAdagradKernel(const size_t var_rows, const size_t inner_size, const size_t indices_num,
+                                         const float lr, T *variable, T *accumulation, const S *indices,
+                                         const int *row_slot, const T *grad_sum) {
+  size_t num = indices_num * inner_size;
+  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < num; pos += blockDim.x * gridDim.x) {
+    size_t i = pos / inner_size;
+    S index = indices[i];
+    if (!IsValidRow(index, var_rows) || static_cast<size_t>(row_slot[index]) != i) {
+      continue;
+    }
+    size_t var_pos = static_cast<size_t>(index) * inner_size + pos % inner_size;
+    T grad = grad_sum[pos];
+    T accum = accumulation[var_pos] + grad * grad;
+    accumulation[var_pos] = accum;
+    variable[var_pos] -= lr * grad * rsqrtf(accum);
+  }
+  return;
+}
+
+template <typename T, typename S>
+void SparseApplyAdagrad(const size_t var_rows, const size_t inner_size, const size_t indices_num, const float lr,
+                        T *variable, T *accumulation, const T *gradient, const S *indices, int *row_slot, T *grad_sum,
+                        cudaStream_t cuda_stream) {
+  size_t size = indices_num * inner_size;
+  if (size == 0) {
+    return;
+  }
+  (void)cudaMemsetAsync(grad_sum, 0, size * sizeof(T), cuda_stream);
+  ResetRowSlotKernel<<<GET_BLOCKS(indices_num), GET_THREADS, 0, cuda_stream>>>(var_rows, indices_num, indices,
+                                                                                row_slot);
+  FindRowSlotKernel<<<GET_BLOCKS(indices_num), GET_THREADS, 0, cuda_stream>>>(var_rows, indices_num, indices,
+                                                                               row_slot);
+  SumGradientKernel<<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(var_rows, inner_size, indices_num, gradient,
+                                                                        indices, row_slot, grad_sum);
+  SparseApplyAdagradKernel<<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(
+    var_rows, inner_size, indices_num, lr, variable, accumulation, indices, row_slot, grad_sum);
+  return;
+}
+
+template void SparseApplyAdagrad<float, int>(const size_t var_rows, const size_t inner_size, const size_t indices_num,
+                                             const float lr, float *variable, float *accumulation,
+                                             const float *gradient, const int *indices, int *row_slot,
+                                             float *grad_sum, cudaStream_t cuda_stream);
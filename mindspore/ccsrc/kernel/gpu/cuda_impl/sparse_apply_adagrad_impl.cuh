@@ -0,0 +1,31 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_SPARSE_APPLY_ADAGRAD_IMPL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_SPARSE_APPLY_ADAGRAD_IMPL_H_
+
+#include "device/gpu/cuda_common.h"
+// Update the rows of the variable and accumulation [var_rows, inner_size] by the sparse gradient, the values of
+// [indices_num, inner_size] and the rows they belong to. The values of the repeated indices are summed up first, so
+// each row is updated once as by the dense gradient. The first row of the indices is kept in the row_slot of
+// [var_rows], and grad_sum of [indices_num, inner_size] holds the summed values.
+template <typename T, typename S>
+void SparseApplyAdagrad(const size_t var_rows, const size_t inner_size, const size_t indices_num, const float lr,
+                        T *variable, T *accumulation, const T *gradient, const S *indices, int *row_slot, T *grad_sum,
+                        cudaStream_t cuda_stream);
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_SPARSE_APPLY_ADAGRAD_IMPL_H_
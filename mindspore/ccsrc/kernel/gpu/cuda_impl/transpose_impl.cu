@@ -15,51 +15,178 @@
  */
 
 #include <cuda_runtime.h>
+#include <algorithm>
+#include <numeric>
 #include "transpose_impl.cuh"
+#include "vector_copy.cuh"
 #include "device/gpu/cuda_common.h"
-template <typename T>
-__global__ void Transpose(const int size, const T* input, const int* input_shape, const int* input_axis,
-                          const int shape_size, T* output) {
-  int pos_size;
-  int temp_pos;
-  int newpos;
-  int newpos_size;
-  int pos_array[TRANSPOSE_MAX_DIMENSION];
 
-  // for example 4-D: pos = posArray[0] * input_shape[1] * input_shape[2] * input_shape[3] +
-  //                        posArray[1] * input_shape[2] * input_shape[3] +
-  //                        posArray[2] * input_shape[3] +
-  //                        posArray[3]
+constexpr int kTileDim = 32;
+constexpr int kTileRows = 8;
+constexpr int kMaxGridDimYZ = 65535;
+// the ranks with the index computation unrolled
+constexpr int kMaxUnrolledRank = 6;
+
+struct TransposeInfo {
+  int rank;
+  // the output position is split into the coordinates by the output strides, the coordinate of the output axis d
+  // steps the input by input_strides[d]
+  int output_strides[TRANSPOSE_MAX_DIMENSION];
+  int input_strides[TRANSPOSE_MAX_DIMENSION];
+};
+
+template <typename T, int kRank>
+__global__ void Transpose(const int size, const T* input, const TransposeInfo info, T* output) {
+  const int rank = kRank > 0 ? kRank : info.rank;
   for (int pos = blockIdx.x * blockDim.x + threadIdx.x; pos < size; pos += blockDim.x * gridDim.x) {
-    temp_pos = pos;
-    pos_size = size / input_shape[0];
-    pos_array[0] = temp_pos / pos_size;
-    for (int i = 1; i < shape_size; i++) {
-      temp_pos -= pos_array[i - 1] * pos_size;
-      pos_size = pos_size / input_shape[i];
-      pos_array[i] = temp_pos / pos_size;
+    int remain = pos;
+    int input_pos = 0;
+#pragma unroll
+    for (int i = 0; i < rank; i++) {
+      int coordinate = remain / info.output_strides[i];
+      remain -= coordinate * info.output_strides[i];
+      input_pos += coordinate * info.input_strides[i];
     }
+    output[pos] = input[input_pos];
+  }
+  return;
+}
 
-    newpos = pos_array[input_axis[shape_size - 1]];
-    newpos_size = 1;
-    for (int j = shape_size - 2; j >= 0; j--) {
-      newpos_size *= input_shape[input_axis[j + 1]];
-      newpos += pos_array[input_axis[j]] * newpos_size;
+// the batch of the matrices of rows x cols to cols x rows, both the reads and the writes are coalesced
+template <typename T>
+__global__ void TransposeTiled(const T* input, const int batch, const int rows, const int cols, T* output) {
+  __shared__ T tile[kTileDim][kTileDim + 1];
+  for (int b = blockIdx.z; b < batch; b += gridDim.z) {
+    const T* matrix_input = input + b * rows * cols;
+    T* matrix_output = output + b * rows * cols;
+    int col = blockIdx.x * kTileDim + threadIdx.x;
+    int row = blockIdx.y * kTileDim + threadIdx.y;
+    for (int i = 0; i < kTileDim; i += kTileRows) {
+      if (col < cols && row + i < rows) {
+        tile[threadIdx.y + i][threadIdx.x] = matrix_input[(row + i) * cols + col];
+      }
     }
-
-    output[newpos] = input[pos];
+    __syncthreads();
+    col = blockIdx.y * kTileDim + threadIdx.x;
+    row = blockIdx.x * kTileDim + threadIdx.y;
+    for (int i = 0; i < kTileDim; i += kTileRows) {
+      if (col < rows && row + i < cols) {
+        matrix_output[(row + i) * rows + col] = tile[threadIdx.x][threadIdx.y + i];
+      }
+    }
+    __syncthreads();
   }
   return;
 }
+
+// drops the axes of 1 and merges the axes kept adjacent, 4-D (0, 2, 3, 1) becomes 3-D (0, 2, 1) for example
+void SimplifyTranspose(const std::vector<int>& shape, const std::vector<int>& axis, std::vector<int>* new_shape,
+                       std::vector<int>* new_axis) {
+  std::vector<int> kept_axis(shape.size(), -1);
+  std::vector<int> dims;
+  for (size_t i = 0; i < shape.size(); i++) {
+    if (shape[i] != 1) {
+      kept_axis[i] = static_cast<int>(dims.size());
+      dims.push_back(shape[i]);
+    }
+  }
+  // the runs of the adjacent input axes, in the output order
+  std::vector<std::vector<int>> runs;
+  for (auto i : axis) {
+    int kept = kept_axis[i];
+    if (kept < 0) {
+      continue;
+    }
+    if (!runs.empty() && runs.back().back() + 1 == kept) {
+      runs.back().push_back(kept);
+    } else {
+      runs.push_back({kept});
+    }
+  }
+  std::vector<int> input_order(runs.size());
+  std::iota(input_order.begin(), input_order.end(), 0);
+  std::sort(input_order.begin(), input_order.end(),
+            [&runs](int lhs, int rhs) { return runs[lhs].front() < runs[rhs].front(); });
+  std::vector<int> run_axis(runs.size());
+  new_shape->clear();
+  for (size_t i = 0; i < input_order.size(); i++) {
+    auto& run = runs[input_order[i]];
+    run_axis[input_order[i]] = static_cast<int>(i);
+    new_shape->push_back(std::accumulate(run.begin(), run.end(), 1, [&dims](int dim, int j) { return dim * dims[j]; }));
+  }
+  *new_axis = run_axis;
+}
+
+template <typename T>
+void LaunchTranspose(const int size, const T* input, const std::vector<int>& shape, const std::vector<int>& axis,
+                     T* output, cudaStream_t cuda_stream) {
+  TransposeInfo info;
+  info.rank = static_cast<int>(shape.size());
+  std::vector<int> input_strides(shape.size(), 1);
+  for (int i = info.rank - 2; i >= 0; i--) {
+    input_strides[i] = input_strides[i + 1] * shape[i + 1];
+  }
+  int output_stride = 1;
+  for (int i = info.rank - 1; i >= 0; i--) {
+    info.output_strides[i] = output_stride;
+    info.input_strides[i] = input_strides[axis[i]];
+    output_stride *= shape[axis[i]];
+  }
+  switch (info.rank) {
+    case 3:
+      Transpose<T, 3><<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(size, input, info, output);
+      break;
+    case 4:
+      Transpose<T, 4><<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(size, input, info, output);
+      break;
+    case 5:
+      Transpose<T, 5><<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(size, input, info, output);
+      break;
+    case kMaxUnrolledRank:
+      Transpose<T, kMaxUnrolledRank><<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(size, input, info, output);
+      break;
+    default:
+      Transpose<T, 0><<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(size, input, info, output);
+      break;
+  }
+}
+
 template <typename T>
-void CalTranspose(const int size, const T* input, const int* input_shape, const int* input_axis, const int shape_size,
-                  T* output, cudaStream_t cuda_stream) {
-  Transpose<<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(size, input, input_shape, input_axis, shape_size,
-                                                               output);
+void CalTranspose(const int size, const T* input, const std::vector<int>& input_shape,
+                  const std::vector<int>& input_axis, T* output, cudaStream_t cuda_stream) {
+  std::vector<int> shape;
+  std::vector<int> axis;
+  SimplifyTranspose(input_shape, input_axis, &shape, &axis);
+  size_t rank = shape.size();
+  if (rank <= 1) {
+    (void)cudaMemcpyAsync(output, input, size * sizeof(T), cudaMemcpyDeviceToDevice, cuda_stream);
+    return;
+  }
+  // the last two axes swapped, with the others kept ahead of them
+  if ((rank == 2 || (rank == 3 && axis[0] == 0)) && axis[rank - 1] == static_cast<int>(rank) - 2) {
+    int batch = rank == 3 ? shape[0] : 1;
+    int rows = shape[rank - 2];
+    int cols = shape[rank - 1];
+    if ((rows + kTileDim - 1) / kTileDim <= kMaxGridDimYZ) {
+      dim3 blocks((cols + kTileDim - 1) / kTileDim, (rows + kTileDim - 1) / kTileDim, std::min(batch, kMaxGridDimYZ));
+      dim3 threads(kTileDim, kTileRows);
+      TransposeTiled<<<blocks, threads, 0, cuda_stream>>>(input, batch, rows, cols, output);
+      return;
+    }
+  }
+  // the last axis kept, the rows are moved by the vectors
+  int vector_size = static_cast<int>(kCopyVectorBytes / sizeof(T));
+  if (axis[rank - 1] == static_cast<int>(rank) - 1 && CanCopyByVector(input, output, shape[rank - 1] * sizeof(T))) {
+    shape[rank - 1] /= vector_size;
+    LaunchTranspose(size / vector_size, reinterpret_cast<const CopyVector*>(input), shape, axis,
+                    reinterpret_cast<CopyVector*>(output), cuda_stream);
+    return;
+  }
+  LaunchTranspose(size, input, shape, axis, output, cuda_stream);
   return;
 }
 
-template void CalTranspose<float>(const int size, const float* input, const int* input_shape, const int* input_axis,
-                                  const int shape_size, float* output, cudaStream_t cuda_stream);
-template void CalTranspose<half>(const int size, const half* input, const int* input_shape, const int* input_axis,
-                                 const int shape_size, half* output, cudaStream_t cuda_stream);
+template void CalTranspose<float>(const int size, const float* input, const std::vector<int>& input_shape,
+                                  const std::vector<int>& input_axis, float* output, cudaStream_t cuda_stream);
+template void CalTranspose<half>(const int size, const half* input, const std::vector<int>& input_shape,
+                                 const std::vector<int>& input_axis, half* output, cudaStream_t cuda_stream);
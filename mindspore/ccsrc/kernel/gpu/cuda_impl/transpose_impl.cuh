@@ -17,9 +17,14 @@
 #ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_TRANSPOSE_H_
 #define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_TRANSPOSE_H_
 
+#include <cuda_runtime.h>
+#include <vector>
+
 #define TRANSPOSE_MAX_DIMENSION 100
+// The axes kept adjacent by the transpose are merged and the axes of 1 dropped first, the swaps of the last two
+// axes, like NCHW <-> NHWC, go through the tiles in the shared memory
 template <typename T>
-void CalTranspose(const int size, const T* input, const int* input_shape, const int* input_axis, const int shape_size,
-                  T* output, cudaStream_t cuda_stream);
+void CalTranspose(const int size, const T* input, const std::vector<int>& input_shape,
+                  const std::vector<int>& input_axis, T* output, cudaStream_t cuda_stream);
 
 #endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_TRANSPOSE_H_
@@ -0,0 +1,52 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "kernel/gpu/cuda_impl/unsorted_segment_sum_impl.cuh"
+
+template <typename T, typename S>
+__global__ void UnsortedSegmentSumKernel(const size_t ids_num, const size_t inner_size, const size_t num_segments,
+                                         const T *input, const S *segment_ids, T *output) {
+  size_t num = ids_num * inner_size;
+  for (size_t pos = blockIdx.x * blockDim.x + threadIdx.x; pos < num; pos += blockDim.x * gridDim.x) {
+    S segment = segment_ids[pos / inner_size];
+    if (segment < 0 || static_cast<size_t>(segment) >= num_segments) {
+      continue;
+    }
+    atomicAdd(output + static_cast<size_t>(segment) * inner_size + pos % inner_size, input[pos]);
+  }
+  return;
+}
+
+template <typename T, typename S>
+void UnsortedSegmentSum(const size_t ids_num, const size_t inner_size, const size_t num_segments, const T *input,
+                        const S *segment_ids, T *output, cudaStream_t cuda_stream) {
+  (void)cudaMemsetAsync(output, 0, num_segments * inner_size * sizeof(T), cuda_stream);
+  size_t size = ids_num * inner_size;
+  if (size == 0) {
+    return;
+  }
+  UnsortedSegmentSumKernel<<<GET_BLOCKS(size), GET_THREADS, 0, cuda_stream>>>(ids_num, inner_size, num_segments,
+                                                                               input, segment_ids, output);
+  return;
+}
+
+template void UnsortedSegmentSum<float, int>(const size_t ids_num, const size_t inner_size, const size_t num_segments,
+                                             const float *input, const int *segment_ids, float *output,
+                                             cudaStream_t cuda_stream);
+template void UnsortedSegmentSum<int, int>(const size_t ids_num, const size_t inner_size, const size_t num_segments,
+                                           const int *input, const int *segment_ids, int *output,
+                                           cudaStream_t cuda_stream);
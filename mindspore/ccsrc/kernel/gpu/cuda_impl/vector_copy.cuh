@@ -0,0 +1,35 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_VECTOR_COPY_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_VECTOR_COPY_H_
+
+#include <cuda_runtime.h>
+#include <stdint.h>
+
+// The kernels only moving the elements, like transpose, slice and gather, move them by the 128-bit vectors when the
+// addresses and the contiguous bytes are aligned to them, included by the .cu files only
+using CopyVector = float4;
+constexpr size_t kCopyVectorBytes = sizeof(CopyVector);
+
+inline bool IsVectorAligned(const void *addr) { return reinterpret_cast<uintptr_t>(addr) % kCopyVectorBytes == 0; }
+
+// the contiguous bytes are the ones moved together, the bytes of a row for example
+inline bool CanCopyByVector(const void *input, const void *output, size_t contiguous_bytes) {
+  return IsVectorAligned(input) && IsVectorAligned(output) && contiguous_bytes % kCopyVectorBytes == 0;
+}
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDA_IMPL_VECTOR_COPY_H_
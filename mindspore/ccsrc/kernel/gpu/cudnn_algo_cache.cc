@@ -0,0 +1,288 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kernel/gpu/cudnn_algo_cache.h"
+#include <cuda_runtime_api.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "device/gpu/cuda_common.h"
+#include "device/gpu/gpu_common.h"
+#include "kernel/common_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// the persistent kernels need the recurrent weights to fit in the registers and shared memory of the device
+constexpr int kPersistRnnMaxHiddenSize = 256;
+constexpr int kPersistRnnMinMajorSm = 6;
+
+std::string CachePath() { return std::string(kGpuKernelMeta) + "cudnn_algo" + kInfoSuffix; }
+
+// the algorithms timed on one device don't hold for the others
+const std::string &DeviceKey() {
+  static std::string device_key;
+  if (!device_key.empty()) {
+    return device_key;
+  }
+  int device_id = 0;
+  cudaDeviceProp prop;
+  if (cudaGetDevice(&device_id) != cudaSuccess || cudaGetDeviceProperties(&prop, device_id) != cudaSuccess) {
+    device_key = "unknown";
+  } else {
+    device_key = prop.name;
+    std::replace(device_key.begin(), device_key.end(), ' ', '_');
+    device_key += "_sm" + std::to_string(prop.major) + std::to_string(prop.minor);
+  }
+  device_key += "_cudnn" + std::to_string(CUDNN_VERSION);
+  return device_key;
+}
+
+void AppendTensorDesc(cudnnTensorDescriptor_t desc, std::ostringstream *key) {
+  cudnnDataType_t data_type;
+  int n, c, h, w, n_stride, c_stride, h_stride, w_stride;
+  CHECK_CUDNN_RET_WITH_EXCEPT(
+    cudnnGetTensor4dDescriptor(desc, &data_type, &n, &c, &h, &w, &n_stride, &c_stride, &h_stride, &w_stride),
+    "cudnnGetTensor4dDescriptor failed");
+  *key << ":" << data_type << "," << n << "," << c << "," << h << "," << w;
+}
+
+void AppendFilterDesc(cudnnFilterDescriptor_t desc, std::ostringstream *key) {
+  cudnnDataType_t data_type;
+  cudnnTensorFormat_t format;
+  int k, c, h, w;
+  CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetFilter4dDescriptor(desc, &data_type, &format, &k, &c, &h, &w),
+                              "cudnnGetFilter4dDescriptor failed");
+  *key << ":" << data_type << "," << format << "," << k << "," << c << "," << h << "," << w;
+}
+
+void AppendConvDesc(cudnnConvolutionDescriptor_t desc, std::ostringstream *key) {
+  int pad_h, pad_w, stride_h, stride_w, dilation_h, dilation_w, group;
+  cudnnConvolutionMode_t mode;
+  cudnnDataType_t compute_type;
+  CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetConvolution2dDescriptor(desc, &pad_h, &pad_w, &stride_h, &stride_w, &dilation_h,
+                                                              &dilation_w, &mode, &compute_type),
+                              "cudnnGetConvolution2dDescriptor failed");
+  CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetConvolutionGroupCount(desc, &group), "cudnnGetConvolutionGroupCount failed");
+  *key << ":" << pad_h << "," << pad_w << "," << stride_h << "," << stride_w << "," << dilation_h << ","
+       << dilation_w << "," << mode << "," << compute_type << "," << group;
+}
+
+template <typename AlgoPerf, int kAlgoCount, typename FindFunc, typename GetFunc>
+CudnnAlgoPerf SelectConvAlgo(const std::string &key, cudnnConvolutionDescriptor_t conv_desc, cudnnDataType_t data_type,
+                             const FindFunc &find, const GetFunc &get) {
+  auto &cache = CudnnAlgoCache::GetInstance();
+  CudnnAlgoPerf perf;
+  if (!cache.Search(key, &perf)) {
+    auto math_type = data_type == CUDNN_DATA_HALF ? CUDNN_TENSOR_OP_MATH : CUDNN_DEFAULT_MATH;
+    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetConvolutionMathType(conv_desc, math_type),
+                                "cudnnSetConvolutionMathType failed");
+    std::vector<AlgoPerf> results(kAlgoCount);
+    int returned_algo_count = 0;
+    auto status = find(kAlgoCount, &returned_algo_count, results.data());
+    // the results are sorted by the time, the algorithms not supported come last
+    auto end = results.begin() + std::min(std::max(returned_algo_count, 0), kAlgoCount);
+    auto iter = std::find_if(results.begin(), end,
+                             [](const AlgoPerf &result) { return result.status == CUDNN_STATUS_SUCCESS; });
+    if (status == CUDNN_STATUS_SUCCESS && iter != end) {
+      perf.algo = static_cast<int>(iter->algo);
+      perf.math_type = static_cast<int>(iter->mathType);
+      cache.Insert(key, perf);
+    } else {
+      // the heuristics aren't cached, the algorithm is timed again by the next run
+      MS_LOG(WARNING) << "Find the convolution algorithm of [" << key << "] failed: " << cudnnGetErrorString(status)
+                      << ", the heuristics are used.";
+      CHECK_CUDNN_RET_WITH_EXCEPT(get(1, &returned_algo_count, results.data()),
+                                  "Get the convolution algorithm failed");
+      perf.algo = static_cast<int>(results[0].algo);
+      perf.math_type = static_cast<int>(results[0].mathType);
+    }
+  }
+  CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetConvolutionMathType(conv_desc, static_cast<cudnnMathType_t>(perf.math_type)),
+                              "cudnnSetConvolutionMathType failed");
+  return perf;
+}
+
+cudnnDataType_t GetDataType(cudnnTensorDescriptor_t desc) {
+  cudnnDataType_t data_type;
+  int n, c, h, w, n_stride, c_stride, h_stride, w_stride;
+  CHECK_CUDNN_RET_WITH_EXCEPT(
+    cudnnGetTensor4dDescriptor(desc, &data_type, &n, &c, &h, &w, &n_stride, &c_stride, &h_stride, &w_stride),
+    "cudnnGetTensor4dDescriptor failed");
+  return data_type;
+}
+
+cudnnStatus_t TrySetLstmDescriptor(cudnnHandle_t handle, const LstmDescInfo &info, cudnnRNNAlgo_t algo,
+                                   cudnnDropoutDescriptor_t dropout_desc, int seq_len,
+                                   const cudnnTensorDescriptor_t *x_desc, cudnnRNNDescriptor_t rnn_desc) {
+  cudnnDirectionMode_t direction = info.bidirectional ? CUDNN_BIDIRECTIONAL : CUDNN_UNIDIRECTIONAL;
+  auto status = cudnnSetRNNDescriptor(handle, rnn_desc, info.hidden_size, info.num_layers, dropout_desc,
+                                      CUDNN_LINEAR_INPUT, direction, CUDNN_LSTM, algo, info.data_type);
+  if (status != CUDNN_STATUS_SUCCESS) {
+    return status;
+  }
+  status = cudnnSetRNNBiasMode(rnn_desc, info.has_bias ? CUDNN_RNN_DOUBLE_BIAS : CUDNN_RNN_NO_BIAS);
+  if (status != CUDNN_STATUS_SUCCESS) {
+    return status;
+  }
+  // the algorithms not supported by the shapes fail here rather than at the launch
+  size_t size = 0;
+  status = cudnnGetRNNWorkspaceSize(handle, rnn_desc, seq_len, x_desc, &size);
+  if (status != CUDNN_STATUS_SUCCESS) {
+    return status;
+  }
+  return cudnnGetRNNTrainingReserveSize(handle, rnn_desc, seq_len, x_desc, &size);
+}
+}  // namespace
+
+bool CudnnAlgoCache::Search(const std::string &key, CudnnAlgoPerf *perf) {
+  MS_EXCEPTION_IF_NULL(perf);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!loaded_) {
+    Load();
+  }
+  auto iter = algos_.find(key);
+  if (iter == algos_.end()) {
+    return false;
+  }
+  *perf = iter->second;
+  return true;
+}
+
+void CudnnAlgoCache::Insert(const std::string &key, const CudnnAlgoPerf &perf) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  algos_[key] = perf;
+  // the dir is shared with the akg kernels, which may not have created it
+  (void)mkdir(kGpuKernelMeta, S_IRWXG | S_IRWXU);
+  std::ofstream file(CachePath(), std::ios::app);
+  if (!file.is_open()) {
+    MS_LOG(INFO) << "Open the cudnn algorithm cache file " << CachePath() << " failed, the algorithm isn't saved.";
+    return;
+  }
+  file << key << " " << perf.algo << " " << perf.math_type << std::endl;
+}
+
+void CudnnAlgoCache::Load() {
+  loaded_ = true;
+  std::ifstream file(CachePath());
+  if (!file.is_open()) {
+    return;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    std::string key;
+    CudnnAlgoPerf perf;
+    if (fields >> key >> perf.algo >> perf.math_type) {
+      algos_[key] = perf;
+    }
+  }
+  MS_LOG(INFO) << "Load " << algos_.size() << " cudnn algorithms from " << CachePath();
+}
+
+cudnnConvolutionFwdAlgo_t SelectConvForwardAlgo(cudnnHandle_t handle, cudnnTensorDescriptor_t x_desc,
+                                                cudnnFilterDescriptor_t w_desc, cudnnConvolutionDescriptor_t conv_desc,
+                                                cudnnTensorDescriptor_t y_desc) {
+  std::ostringstream key;
+  key << "Conv2D:" << DeviceKey();
+  AppendTensorDesc(x_desc, &key);
+  AppendFilterDesc(w_desc, &key);
+  AppendConvDesc(conv_desc, &key);
+  AppendTensorDesc(y_desc, &key);
+  auto perf = SelectConvAlgo<cudnnConvolutionFwdAlgoPerf_t, CUDNN_CONVOLUTION_FWD_ALGO_COUNT>(
+    key.str(), conv_desc, GetDataType(x_desc),
+    [&](int requested, int *returned, cudnnConvolutionFwdAlgoPerf_t *results) {
+      return cudnnFindConvolutionForwardAlgorithm(handle, x_desc, w_desc, conv_desc, y_desc, requested, returned,
+                                                  results);
+    },
+    [&](int requested, int *returned, cudnnConvolutionFwdAlgoPerf_t *results) {
+      return cudnnGetConvolutionForwardAlgorithm_v7(handle, x_desc, w_desc, conv_desc, y_desc, requested, returned,
+                                                    results);
+    });
+  return static_cast<cudnnConvolutionFwdAlgo_t>(perf.algo);
+}
+
+cudnnConvolutionBwdFilterAlgo_t SelectConvBackwardFilterAlgo(cudnnHandle_t handle, cudnnTensorDescriptor_t x_desc,
+                                                             cudnnTensorDescriptor_t dy_desc,
+                                                             cudnnConvolutionDescriptor_t conv_desc,
+                                                             cudnnFilterDescriptor_t dw_desc) {
+  std::ostringstream key;
+  key << "Conv2DBackpropFilter:" << DeviceKey();
+  AppendTensorDesc(x_desc, &key);
+  AppendTensorDesc(dy_desc, &key);
+  AppendConvDesc(conv_desc, &key);
+  AppendFilterDesc(dw_desc, &key);
+  auto perf = SelectConvAlgo<cudnnConvolutionBwdFilterAlgoPerf_t, CUDNN_CONVOLUTION_BWD_FILTER_ALGO_COUNT>(
+    key.str(), conv_desc, GetDataType(x_desc),
+    [&](int requested, int *returned, cudnnConvolutionBwdFilterAlgoPerf_t *results) {
+      return cudnnFindConvolutionBackwardFilterAlgorithm(handle, x_desc, dy_desc, conv_desc, dw_desc, requested,
+                                                         returned, results);
+    },
+    [&](int requested, int *returned, cudnnConvolutionBwdFilterAlgoPerf_t *results) {
+      return cudnnGetConvolutionBackwardFilterAlgorithm_v7(handle, x_desc, dy_desc, conv_desc, dw_desc, requested,
+                                                           returned, results);
+    });
+  return static_cast<cudnnConvolutionBwdFilterAlgo_t>(perf.algo);
+}
+
+cudnnConvolutionBwdDataAlgo_t SelectConvBackwardDataAlgo(cudnnHandle_t handle, cudnnFilterDescriptor_t w_desc,
+                                                         cudnnTensorDescriptor_t dy_desc,
+                                                         cudnnConvolutionDescriptor_t conv_desc,
+                                                         cudnnTensorDescriptor_t dx_desc) {
+  std::ostringstream key;
+  key << "Conv2DBackpropInput:" << DeviceKey();
+  AppendFilterDesc(w_desc, &key);
+  AppendTensorDesc(dy_desc, &key);
+  AppendConvDesc(conv_desc, &key);
+  AppendTensorDesc(dx_desc, &key);
+  auto perf = SelectConvAlgo<cudnnConvolutionBwdDataAlgoPerf_t, CUDNN_CONVOLUTION_BWD_DATA_ALGO_COUNT>(
+    key.str(), conv_desc, GetDataType(dy_desc),
+    [&](int requested, int *returned, cudnnConvolutionBwdDataAlgoPerf_t *results) {
+      return cudnnFindConvolutionBackwardDataAlgorithm(handle, w_desc, dy_desc, conv_desc, dx_desc, requested,
+                                                       returned, results);
+    },
+    [&](int requested, int *returned, cudnnConvolutionBwdDataAlgoPerf_t *results) {
+      return cudnnGetConvolutionBackwardDataAlgorithm_v7(handle, w_desc, dy_desc, conv_desc, dx_desc, requested,
+                                                         returned, results);
+    });
+  return static_cast<cudnnConvolutionBwdDataAlgo_t>(perf.algo);
+}
+
+cudnnRNNAlgo_t SetLstmDescriptor(cudnnHandle_t handle, const LstmDescInfo &info, float dropout,
+                                 cudnnDropoutDescriptor_t dropout_desc, int seq_len,
+                                 const cudnnTensorDescriptor_t *x_desc, cudnnRNNDescriptor_t rnn_desc) {
+  // the dropout between the layers isn't done by the persistent kernels
+  bool persist = GET_MAJOR_SM >= kPersistRnnMinMajorSm && info.hidden_size <= kPersistRnnMaxHiddenSize &&
+                 (info.num_layers == 1 || dropout == 0);
+  if (persist) {
+    auto status =
+      TrySetLstmDescriptor(handle, info, CUDNN_RNN_ALGO_PERSIST_STATIC, dropout_desc, seq_len, x_desc, rnn_desc);
+    if (status == CUDNN_STATUS_SUCCESS) {
+      return CUDNN_RNN_ALGO_PERSIST_STATIC;
+    }
+    MS_LOG(INFO) << "The persistent lstm of hidden size " << info.hidden_size << " isn't supported: "
+                 << cudnnGetErrorString(status) << ", the standard algorithm is used.";
+  }
+  CHECK_CUDNN_RET_WITH_EXCEPT(
+    TrySetLstmDescriptor(handle, info, CUDNN_RNN_ALGO_STANDARD, dropout_desc, seq_len, x_desc, rnn_desc),
+    "set rnn_desc failed");
+  return CUDNN_RNN_ALGO_STANDARD;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_CUDNN_ALGO_CACHE_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_CUDNN_ALGO_CACHE_H_
+
+#include <cudnn.h>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mindspore {
+namespace kernel {
+struct CudnnAlgoPerf {
+  int algo{0};
+  int math_type{0};
+};
+
+// The convolution algorithms found by timing them with cudnnFind*, by the shapes of the convolution and the device.
+// They're saved to the gpu kernel meta dir, so that the later runs don't time them again.
+class CudnnAlgoCache {
+ public:
+  static CudnnAlgoCache &GetInstance() {
+    static CudnnAlgoCache instance;
+    return instance;
+  }
+  bool Search(const std::string &key, CudnnAlgoPerf *perf);
+  void Insert(const std::string &key, const CudnnAlgoPerf &perf);
+
+ private:
+  CudnnAlgoCache() = default;
+  ~CudnnAlgoCache() = default;
+  CudnnAlgoCache(const CudnnAlgoCache &) = delete;
+  CudnnAlgoCache &operator=(const CudnnAlgoCache &) = delete;
+  void Load();
+
+  bool loaded_{false};
+  std::mutex mutex_;
+  std::unordered_map<std::string, CudnnAlgoPerf> algos_;
+};
+
+// Select the fastest algorithm of the convolution, the math type of the conv desc is set to the one of the
+// algorithm. The tensor op math is tried for float16, it falls back to the heuristics if the timing fails.
+cudnnConvolutionFwdAlgo_t SelectConvForwardAlgo(cudnnHandle_t handle, cudnnTensorDescriptor_t x_desc,
+                                                cudnnFilterDescriptor_t w_desc, cudnnConvolutionDescriptor_t conv_desc,
+                                                cudnnTensorDescriptor_t y_desc);
+cudnnConvolutionBwdFilterAlgo_t SelectConvBackwardFilterAlgo(cudnnHandle_t handle, cudnnTensorDescriptor_t x_desc,
+                                                             cudnnTensorDescriptor_t dy_desc,
+                                                             cudnnConvolutionDescriptor_t conv_desc,
+                                                             cudnnFilterDescriptor_t dw_desc);
+cudnnConvolutionBwdDataAlgo_t SelectConvBackwardDataAlgo(cudnnHandle_t handle, cudnnFilterDescriptor_t w_desc,
+                                                         cudnnTensorDescriptor_t dy_desc,
+                                                         cudnnConvolutionDescriptor_t conv_desc,
+                                                         cudnnTensorDescriptor_t dx_desc);
+
+struct LstmDescInfo {
+  int hidden_size;
+  int num_layers;
+  bool bidirectional;
+  bool has_bias;
+  cudnnDataType_t data_type;
+};
+
+// Set the rnn desc of the lstm, the persistent static algorithm is used for the small hidden sizes, which keeps the
+// recurrent weights on chip through the time steps. The forward and the grads must run by the same algorithm as the
+// reserve space is laid out by it, they get the same one as the choice depends on the shapes and the attrs only.
+cudnnRNNAlgo_t SetLstmDescriptor(cudnnHandle_t handle, const LstmDescInfo &info, float dropout,
+                                 cudnnDropoutDescriptor_t dropout_desc, int seq_len,
+                                 const cudnnTensorDescriptor_t *x_desc, cudnnRNNDescriptor_t rnn_desc);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_CUDNN_ALGO_CACHE_H_
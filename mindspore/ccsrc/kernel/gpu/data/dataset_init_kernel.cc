@@ -23,7 +23,7 @@ namespace mindspore {
 namespace kernel {
 using mindspore::device::GpuBufferMgr;
 
-DatasetInitKernel::DatasetInitKernel() : feature_size_(0), label_size_(0) {}
+DatasetInitKernel::DatasetInitKernel() : total_bytes_(0) {}
 
 const std::vector<size_t> &DatasetInitKernel::GetInputSizeList() const { return input_size_list_; }
 
@@ -47,23 +47,20 @@ size_t DatasetInitKernel::TensorSize(std::vector<int> &shape) const {
 bool DatasetInitKernel::Init(const CNodePtr &kernel_node) {
   queue_name_ = GetAttr<std::string>(kernel_node, "queue_name");
   auto shapes = GetAttr<const std::vector<std::vector<int>>>(kernel_node, "shapes");
-  auto data_num = shapes.size();
-  if (data_num != 2) {
-    MS_LOG(EXCEPTION) << "Invalid Shapes " << data_num;
-  }
-
-  auto &feature_Shapes = shapes[0];
-  auto size = TensorSize(feature_Shapes);
-  feature_size_ = size * sizeof(float);
-
   auto types = GetAttr<const std::vector<TypePtr>>(kernel_node, "types");
-  if ((types[1]->type_id() != kNumberTypeInt32) && (types[1]->type_id() != kNumberTypeInt64)) {
-    MS_LOG(EXCEPTION) << "Invalid types " << types[1]->type_id();
+  if (shapes.size() == 0 || shapes.size() != types.size()) {
+    MS_LOG(EXCEPTION) << "Invalid shapes: " << shapes.size() << ", types: " << types.size();
   }
 
-  size_t label_unit = (types[1]->type_id() == kNumberTypeInt32) ? sizeof(int32_t) : sizeof(int64_t);
-  size = TensorSize(shapes[1]);
-  label_size_ = size * label_unit;
+  for (size_t i = 0; i < shapes.size(); i++) {
+    size_t unit = GetTypeByte(types[i]);
+    if (unit == 0) {
+      MS_LOG(EXCEPTION) << "Invalid types " << types[i]->type_id();
+    }
+    size_t size = TensorSize(shapes[i]) * unit;
+    sizes_.push_back(size);
+    total_bytes_ += size;
+  }
   return true;
 }
 
@@ -72,17 +69,15 @@ void DatasetInitKernel::InitSizeLists() { return; }
 bool DatasetInitKernel::Launch(const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
                                const std::vector<AddressPtr> &, uintptr_t) {
   void *addr = nullptr;
-  size_t len = (feature_size_ + label_size_) * buffer_q_capacity_;
+  size_t len = total_bytes_ * buffer_q_capacity_;
 
   if (!device::gpu::GPUMemoryAllocator::GetInstance().AllocBufferQueueMem(len, &addr)) {
     MS_LOG(EXCEPTION) << "Memory not enough: failed to allocate GPU buffer queue memory[" << len << "].";
   }
 
-  auto status =
-    GpuBufferMgr::GetInstance().Create(0, queue_name_, addr, feature_size_, label_size_, buffer_q_capacity_);
+  auto status = GpuBufferMgr::GetInstance().Create(0, queue_name_, addr, sizes_, buffer_q_capacity_);
   if (status) {
-    MS_LOG(EXCEPTION) << "Init Dataset Failed: " << queue_name_ << ", " << feature_size_ << ", " << label_size_ << ", "
-                      << status;
+    MS_LOG(EXCEPTION) << "Init Dataset Failed: " << queue_name_ << ", " << total_bytes_ << ", " << status;
   }
 
   return true;
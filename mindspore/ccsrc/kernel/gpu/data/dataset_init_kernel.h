@@ -43,8 +43,8 @@ class DatasetInitKernel : public GpuKernel {
   size_t TensorSize(std::vector<int> &) const;
 
   std::string queue_name_;
-  size_t feature_size_;
-  size_t label_size_;
+  std::vector<size_t> sizes_;  // The size in bytes of each column
+  size_t total_bytes_;
 
   std::vector<size_t> input_size_list_;
   std::vector<size_t> output_size_list_;
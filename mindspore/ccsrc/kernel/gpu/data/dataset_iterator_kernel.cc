@@ -22,6 +22,7 @@
 
 #include "device/gpu/gpu_buffer_mgr.h"
 #include "device/gpu/gpu_common.h"
+#include "utils/metrics.h"
 
 namespace mindspore {
 namespace kernel {
@@ -29,7 +30,7 @@ using mindspore::device::GpuBufferMgr;
 using mindspore::device::HandleMgr;
 
 DatasetIteratorKernel::DatasetIteratorKernel()
-    : output_num_(0), handle_(HandleMgr::INVALID_HANDLE), feature_size_(0), label_size_(0) {}
+    : output_num_(0), handle_(HandleMgr::INVALID_HANDLE) {}
 
 DatasetIteratorKernel::~DatasetIteratorKernel() { GpuBufferMgr::GetInstance().Close(handle_); }
 
@@ -56,48 +57,45 @@ bool DatasetIteratorKernel::Init(const CNodePtr &kernel_node) {
   output_num_ = GetAttr<int>(kernel_node, "output_num");
   queue_name_ = GetAttr<std::string>(kernel_node, "shared_name");
   auto shapes = GetAttr<const std::vector<std::vector<int>>>(kernel_node, "shapes");
-  auto data_num = shapes.size();
-  if (data_num != 2) {
-    MS_LOG(EXCEPTION) << "Invalid Shapes " << data_num;
-  }
-
-  auto &feature_Shapes = shapes[0];
-  auto size = TensorSize(feature_Shapes);
-  feature_size_ = size * sizeof(float);
-
   auto types = GetAttr<const std::vector<TypePtr>>(kernel_node, "types");
-  if ((types[1]->type_id() != kNumberTypeInt32) && (types[1]->type_id() != kNumberTypeInt64)) {
-    MS_LOG(EXCEPTION) << "Invalid types " << types[1]->type_id();
+  if (shapes.size() == 0 || shapes.size() != types.size()) {
+    MS_LOG(EXCEPTION) << "Invalid shapes: " << shapes.size() << ", types: " << types.size();
   }
 
-  size_t label_unit = (types[1]->type_id() == kNumberTypeInt32) ? sizeof(int32_t) : sizeof(int64_t);
-  size = TensorSize(shapes[1]);
-  label_size_ = size * label_unit;
+  for (size_t i = 0; i < shapes.size(); i++) {
+    size_t unit = GetTypeByte(types[i]);
+    if (unit == 0) {
+      MS_LOG(EXCEPTION) << "Invalid types " << types[i]->type_id();
+    }
+    sizes_.push_back(TensorSize(shapes[i]) * unit);
+  }
 
   InitSizeLists();
 
-  handle_ = GpuBufferMgr::GetInstance().Open(0, queue_name_, feature_size_, label_size_);
+  handle_ = GpuBufferMgr::GetInstance().Open(0, queue_name_, sizes_);
   if (handle_ == HandleMgr::INVALID_HANDLE) {
-    MS_LOG(EXCEPTION) << "Gpu Queue(" << queue_name_ << ") Open Failed: feature_size(" << feature_size_
-                      << "), label_size(" << label_size_ << ")";
+    MS_LOG(EXCEPTION) << "Gpu Queue(" << queue_name_ << ") Open Failed: " << sizes_.size() << " columns";
   }
 
   return true;
 }
 
 void DatasetIteratorKernel::InitSizeLists() {
-  output_size_list_.push_back(feature_size_);
-  output_size_list_.push_back(label_size_);
+  for (auto size : sizes_) {
+    output_size_list_.push_back(size);
+  }
 }
 
 bool DatasetIteratorKernel::Launch(const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
                                    const std::vector<AddressPtr> &outputs, uintptr_t) {
-  void *feature_addr{nullptr}, *label_addr{nullptr};
-  size_t feature_size{0}, label_size{0};
+  std::vector<device::DataItemGpu> data;
 
+  static auto data_wait_time = MetricsRegistry::GetInstance().GetHistogram(
+    "mindspore_data_wait_time_us", "The time of the steps blocked for the data of the device queue.");
+  HistogramTimer timer(data_wait_time);
   int repeat = 0;
   while (true) {
-    auto ret = GpuBufferMgr::GetInstance().Front(handle_, &feature_addr, &feature_size, &label_addr, &label_size);
+    auto ret = GpuBufferMgr::GetInstance().Front(handle_, &data);
     if (ret == device::SUCCESS) {
       break;
     }
@@ -116,17 +114,23 @@ bool DatasetIteratorKernel::Launch(const std::vector<AddressPtr> &, const std::v
     MS_LOG(ERROR) << "Get data failed, errcode " << ret;
     return false;
   }
+  timer.Stop();
 
-  if (feature_size != feature_size_ || label_size != label_size_) {
-    MS_LOG(ERROR) << "DatasetIteratorKernel: Front Error: " << feature_addr << ", " << feature_size << ", "
-                  << label_addr << ", " << label_size;
+  if (data.size() != sizes_.size() || data.size() > outputs.size()) {
+    MS_LOG(ERROR) << "DatasetIteratorKernel: Front Error: " << data.size() << " columns, with " << sizes_.size()
+                  << " expect";
     return false;
   }
-
-  CHECK_CUDA_RET_WITH_EXCEPT(cudaMemcpy(outputs[0]->addr, feature_addr, feature_size, cudaMemcpyDeviceToDevice),
-                             "Cuda Memcpy Failed");
-  CHECK_CUDA_RET_WITH_EXCEPT(cudaMemcpy(outputs[1]->addr, label_addr, label_size, cudaMemcpyDeviceToDevice),
-                             "Cuda Memcpy Failed");
+  for (size_t i = 0; i < data.size(); i++) {
+    if (data[i].data_len_ != sizes_[i]) {
+      MS_LOG(ERROR) << "DatasetIteratorKernel: Front Error: column " << i << ": " << data[i].data_ptr_ << ", "
+                    << data[i].data_len_ << ", with " << sizes_[i] << " expect";
+      return false;
+    }
+    CHECK_CUDA_RET_WITH_EXCEPT(
+      cudaMemcpy(outputs[i]->addr, data[i].data_ptr_, data[i].data_len_, cudaMemcpyDeviceToDevice),
+      "Cuda Memcpy Failed");
+  }
 
   (void)GpuBufferMgr::GetInstance().Pop(handle_);
 
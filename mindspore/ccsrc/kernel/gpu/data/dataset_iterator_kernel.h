@@ -46,8 +46,7 @@ class DatasetIteratorKernel : public GpuKernel {
   int output_num_;
   unsigned int handle_;
 
-  size_t feature_size_;
-  size_t label_size_;
+  std::vector<size_t> sizes_;  // The size in bytes of each output
 
   std::vector<size_t> input_size_list_;
   std::vector<size_t> output_size_list_;
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_DATA_RANDOM_CROP_RESIZE_NORMALIZE_GPU_KERNEL_H
+#define MINDSPORE_CCSRC_KERNEL_GPU_DATA_RANDOM_CROP_RESIZE_NORMALIZE_GPU_KERNEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/crop_resize_normalize_impl.cuh"
+
+namespace mindspore {
+namespace kernel {
+// The per sample augmentation of a decoded batch after its transfer to the device, so that it does not take the
+// host cores: a random crop of the area and aspect ranges, a bilinear resize and a per channel normalization.
+// The crop boxes are drawn on the host, the same way as the RandomCropAndResize op of the dataset does.
+class RandomCropResizeNormalizeGpuKernel : public GpuKernel {
+ public:
+  RandomCropResizeNormalizeGpuKernel()
+      : batch_(0), height_(0), width_(0), channel_(0), out_height_(0), out_width_(0), max_iter_(10) {}
+  ~RandomCropResizeNormalizeGpuKernel() override = default;
+
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs, uintptr_t stream_ptr) override {
+    const unsigned char *input = GetDeviceAddress<unsigned char>(inputs, 0);
+    int *boxes = GetDeviceAddress<int>(workspace, 0);
+    float *mean_std = GetDeviceAddress<float>(workspace, 1);
+    float *output = GetDeviceAddress<float>(outputs, 0);
+    for (size_t i = 0; i < batch_; i++) {
+      GetCropBox(&boxes_[4 * i]);
+    }
+    CHECK_CUDA_RET_WITH_EXCEPT(cudaMemcpyAsync(boxes, &boxes_[0], workspace_size_list_[0], cudaMemcpyHostToDevice,
+                                               reinterpret_cast<cudaStream_t>(stream_ptr)),
+                               "cudaMemcpyAsync boxes failed");
+    CHECK_CUDA_RET_WITH_EXCEPT(cudaMemcpyAsync(mean_std, &mean_std_[0], workspace_size_list_[1],
+                                               cudaMemcpyHostToDevice, reinterpret_cast<cudaStream_t>(stream_ptr)),
+                               "cudaMemcpyAsync mean_std failed");
+    CropResizeNormalize(input, boxes, mean_std, batch_, height_, width_, channel_, out_height_, out_width_, output,
+                        reinterpret_cast<cudaStream_t>(stream_ptr));
+    return true;
+  }
+
+  bool Init(const CNodePtr &kernel_node) override {
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    if (input_num != 1) {
+      MS_LOG(ERROR) << "Input number is " << input_num << ", but RandomCropResizeNormalize needs 1 input.";
+      return false;
+    }
+    auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+    if (input_shape.size() != 4) {
+      MS_LOG(ERROR) << "Input is " << input_shape.size() << "-D, but RandomCropResizeNormalize needs a NHWC batch.";
+      return false;
+    }
+    batch_ = input_shape[0];
+    height_ = input_shape[1];
+    width_ = input_shape[2];
+    channel_ = input_shape[3];
+    auto size = GetAttr<std::vector<int>>(kernel_node, "size");
+    auto scale = GetAttr<std::vector<float>>(kernel_node, "scale");
+    auto ratio = GetAttr<std::vector<float>>(kernel_node, "ratio");
+    auto mean = GetAttr<std::vector<float>>(kernel_node, "mean");
+    auto std = GetAttr<std::vector<float>>(kernel_node, "std");
+    if (size.size() != 2 || scale.size() != 2 || ratio.size() != 2 || mean.size() != channel_ ||
+        std.size() != channel_) {
+      MS_LOG(ERROR) << "The attrs of RandomCropResizeNormalize do not match a " << channel_ << " channel input.";
+      return false;
+    }
+    out_height_ = IntToSize(size[0]);
+    out_width_ = IntToSize(size[1]);
+    rnd_scale_ = std::uniform_real_distribution<float>(scale[0], scale[1]);
+    rnd_aspect_ = std::uniform_real_distribution<float>(ratio[0], ratio[1]);
+    rnd_.seed(IntToUint(GetAttr<int>(kernel_node, "seed")));
+    mean_std_ = mean;
+    mean_std_.insert(mean_std_.end(), std.begin(), std.end());
+    boxes_.resize(4 * batch_);
+    InitSizeLists();
+    return true;
+  }
+
+ protected:
+  void InitSizeLists() override {
+    input_size_list_.push_back(batch_ * height_ * width_ * channel_ * sizeof(unsigned char));
+    output_size_list_.push_back(batch_ * channel_ * out_height_ * out_width_ * sizeof(float));
+    workspace_size_list_.push_back(boxes_.size() * sizeof(int));
+    workspace_size_list_.push_back(mean_std_.size() * sizeof(float));
+  }
+
+ private:
+  // Draws the box (x, y, w, h) of a sample, falls back to the whole aspect when no draw fits in max_iter_ tries
+  void GetCropBox(int *box) {
+    int h_in = SizeToInt(height_);
+    int w_in = SizeToInt(width_);
+    int crop_width = w_in;
+    int crop_height = h_in;
+    bool crop_success = false;
+    for (int i = 0; i < max_iter_; i++) {
+      float scale = rnd_scale_(rnd_);
+      float aspect = rnd_aspect_(rnd_);
+      crop_width = static_cast<int>(std::round(std::sqrt(h_in * w_in * scale / aspect)));
+      crop_height = static_cast<int>(std::round(crop_width * aspect));
+      if (crop_width > 0 && crop_height > 0 && crop_width <= w_in && crop_height <= h_in) {
+        crop_success = true;
+        break;
+      }
+    }
+    if (!crop_success) {
+      float scale = rnd_scale_(rnd_);
+      crop_width = std::max(1, std::min(w_in, static_cast<int>(std::round(w_in * std::sqrt(scale)))));
+      crop_height = std::max(1, std::min(h_in, static_cast<int>(std::round(h_in * std::sqrt(scale)))));
+    }
+    box[0] = std::uniform_int_distribution<int>(0, w_in - crop_width)(rnd_);
+    box[1] = std::uniform_int_distribution<int>(0, h_in - crop_height)(rnd_);
+    box[2] = crop_width;
+    box[3] = crop_height;
+  }
+
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+
+  size_t batch_;
+  size_t height_;
+  size_t width_;
+  size_t channel_;
+  size_t out_height_;
+  size_t out_width_;
+  int max_iter_;
+  std::mt19937 rnd_;
+  std::uniform_real_distribution<float> rnd_scale_;
+  std::uniform_real_distribution<float> rnd_aspect_;
+  std::vector<int> boxes_;
+  std::vector<float> mean_std_;  // The means of the channels followed by their standard deviations
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_DATA_RANDOM_CROP_RESIZE_NORMALIZE_GPU_KERNEL_H
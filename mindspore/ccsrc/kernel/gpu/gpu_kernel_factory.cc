@@ -141,5 +141,9 @@ bool GpuKernelFactory::SearchRegistered(const std::string &kernel_name, const Ke
   std::pair<bool, size_t> ret_pair = GpuKernelAttrCheck(kernel_name, kernel_build_info.get());
   return ret_pair.first;
 }
+
+bool GpuKernelFactory::IsRegistered(const std::string &kernel_name) const {
+  return map_kernel_name_to_creater_.find(kernel_name) != map_kernel_name_to_creater_.end();
+}
 }  // namespace kernel
 }  // namespace mindspore
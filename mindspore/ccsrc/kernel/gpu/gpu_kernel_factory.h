@@ -41,6 +41,9 @@ class GpuKernelFactory {
 
   bool SearchRegistered(const std::string &kernel_name, const KernelBuildInfoPtr &kernel_info);
 
+  // Whether a kernel is registered by the name, whatever its types are.
+  bool IsRegistered(const std::string &kernel_name) const;
+
   std::string SupportedTypeList(const std::string &kernel_name);
 
  private:
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_FUSED_ELEMWISE_GPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_FUSED_ELEMWISE_GPU_KERNEL_H_
+
+#include <cuda_runtime_api.h>
+#include <vector>
+#include <string>
+#include <map>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/fused_elemwise_impl.cuh"
+
+namespace mindspore {
+namespace kernel {
+const std::map<std::string, FusedElemwiseOpType> kFusedElemwiseOpTypeMap = {
+  {"Exp", FUSED_ELEMWISE_OP_EXP},
+  {"Log", FUSED_ELEMWISE_OP_LOG},
+  {"Neg", FUSED_ELEMWISE_OP_NEG},
+  {"Reciprocal", FUSED_ELEMWISE_OP_RECIPROCAL},
+  {"ReLU", FUSED_ELEMWISE_OP_RELU},
+  {"TensorAdd", FUSED_ELEMWISE_OP_ADD},
+  {"Sub", FUSED_ELEMWISE_OP_SUB},
+  {"Mul", FUSED_ELEMWISE_OP_MUL},
+  {"RealDiv", FUSED_ELEMWISE_OP_DIV},
+};
+
+// The chain of the elementwise ops fused by the pass ElemwiseFusion, evaluated for each element in one kernel
+template <typename T>
+class FusedElemwiseGpuKernel : public GpuKernel {
+ public:
+  FusedElemwiseGpuKernel() : program_(), output_size_(sizeof(T)) {}
+  ~FusedElemwiseGpuKernel() override = default;
+
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs, uintptr_t stream_ptr) override {
+    VARIABLE_NOT_USED(workspace);
+    FusedElemwiseProgram program = program_;
+    for (int i = 0; i < program.input_num; ++i) {
+      program.inputs[i] = GetDeviceAddress<T>(inputs, IntToSize(i));
+    }
+    T *output_addr = GetDeviceAddress<T>(outputs, 0);
+    FusedElemwise(program, output_addr, output_size_ / sizeof(T), reinterpret_cast<cudaStream_t>(stream_ptr));
+    return true;
+  }
+  bool Init(const CNodePtr &kernel_node) override {
+    auto op_names = GetAttr<std::vector<std::string>>(kernel_node, kAttrFusedOps);
+    auto lhs = GetAttr<std::vector<int>>(kernel_node, kAttrFusedOpLhs);
+    auto rhs = GetAttr<std::vector<int>>(kernel_node, kAttrFusedOpRhs);
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    if (input_num == 0 || input_num > kMaxFusedElemwiseInputNum) {
+      MS_LOG(ERROR) << "Input number is " << input_num << ", but fused elemwise op supports 1 to "
+                    << kMaxFusedElemwiseInputNum << " inputs.";
+      return false;
+    }
+    if (op_names.empty() || op_names.size() > kMaxFusedElemwiseOpNum || lhs.size() != op_names.size() ||
+        rhs.size() != op_names.size()) {
+      MS_LOG(ERROR) << "Op number is " << op_names.size() << ", but fused elemwise op supports 1 to "
+                    << kMaxFusedElemwiseOpNum << " ops with " << lhs.size() << " lhs and " << rhs.size() << " rhs.";
+      return false;
+    }
+    program_.input_num = SizeToInt(input_num);
+    program_.op_num = SizeToInt(op_names.size());
+    for (size_t i = 0; i < op_names.size(); ++i) {
+      auto iter = kFusedElemwiseOpTypeMap.find(op_names[i]);
+      if (iter == kFusedElemwiseOpTypeMap.end()) {
+        MS_LOG(EXCEPTION) << "Fused elemwise operation " << op_names[i] << " is not supported.";
+      }
+      // the operands are computed before the op
+      int reg_num = program_.input_num + SizeToInt(i);
+      if (lhs[i] < 0 || lhs[i] >= reg_num || rhs[i] < -1 || rhs[i] >= reg_num) {
+        MS_LOG(EXCEPTION) << "The operands " << lhs[i] << ", " << rhs[i] << " of fused elemwise operation "
+                          << op_names[i] << " are out of the range " << reg_num;
+      }
+      program_.op_types[i] = iter->second;
+      program_.lhs[i] = lhs[i];
+      program_.rhs[i] = rhs[i];
+    }
+    auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+    for (size_t i = 0; i < output_shape.size(); i++) {
+      output_size_ *= output_shape[i];
+    }
+    for (size_t i = 0; i < input_num; ++i) {
+      auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i);
+      size_t input_size = sizeof(T);
+      for (size_t j = 0; j < input_shape.size(); j++) {
+        input_size *= input_shape[j];
+      }
+      if (input_size != output_size_ && input_size != sizeof(T)) {
+        MS_LOG(ERROR) << "Input " << i << " size is " << input_size << ", but fused elemwise op needs the output size "
+                      << output_size_ << " or one element.";
+        return false;
+      }
+      program_.broadcast[i] = input_size != output_size_;
+      input_size_list_.push_back(input_size);
+    }
+    InitSizeLists();
+    return true;
+  }
+
+ protected:
+  void InitSizeLists() override { output_size_list_.push_back(output_size_); }
+
+ private:
+  FusedElemwiseProgram program_;
+  size_t output_size_;
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_FUSED_ELEMWISE_GPU_KERNEL_H_
@@ -38,7 +38,8 @@ class MatMulGpuKernel : public GpuKernel {
         transpose_x1_(CUBLAS_OP_N),
         transpose_x2_(CUBLAS_OP_N),
         handle_(nullptr),
-        cudaDataType_(CUDA_R_32F) {}
+        cudaDataType_(CUDA_R_32F),
+        algo_(CUBLAS_GEMM_DEFAULT) {}
   ~MatMulGpuKernel() = default;
   const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
   const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
@@ -62,16 +63,19 @@ class MatMulGpuKernel : public GpuKernel {
       auto input2_slice = input2_addr + i * k_ * n_;
       auto output_slice = output_addr + i * m_ * n_;
 
-      CHECK_CUBLAS_RET_WITH_EXCEPT(cublasSgemmEx(handle_, transpose_x2_, transpose_x1_, SizeToInt(n_), SizeToInt(m_),
-                                                 SizeToInt(k_), &alpha, input2_slice, cudaDataType_, lda, input1_slice,
-                                                 cudaDataType_, ldb, &beta, output_slice, cudaDataType_, SizeToInt(n_)),
-                                   "cublasSgemm Call Fail");
+      CHECK_CUBLAS_RET_WITH_EXCEPT(
+        cublasGemmEx(handle_, transpose_x2_, transpose_x1_, SizeToInt(n_), SizeToInt(m_), SizeToInt(k_), &alpha,
+                     input2_slice, cudaDataType_, lda, input1_slice, cudaDataType_, ldb, &beta, output_slice,
+                     cudaDataType_, SizeToInt(n_), CUDA_R_32F, algo_),
+        "cublasGemmEx Call Fail");
     }
     return true;
   }
   bool Init(const CNodePtr &kernel_node) override {
     handle_ = device::gpu::GPUDeviceManager::GetInstance().GetCublasHandle();
     cudaDataType_ = kCudaDtypeMap[TypeIdLabel(AnfAlgo::GetInputDeviceDataType(kernel_node, 0))];
+    // float16 runs on the tensor cores, accumulating in float32. float32 keeps its precision with the default algo.
+    algo_ = (cudaDataType_ == CUDA_R_16F) ? CUBLAS_GEMM_DEFAULT_TENSOR_OP : CUBLAS_GEMM_DEFAULT;
     auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
     auto dims = output_shape.size();
     if (dims < 2) {
@@ -122,6 +126,7 @@ class MatMulGpuKernel : public GpuKernel {
 
   cublasHandle_t handle_;
   cudaDataType_t cudaDataType_;
+  cublasGemmAlgo_t algo_;
   std::vector<size_t> input_size_list_;
   std::vector<size_t> output_size_list_;
   std::vector<size_t> workspace_size_list_;
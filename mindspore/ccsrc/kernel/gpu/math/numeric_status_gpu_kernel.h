@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_MATH_NUMERIC_STATUS_GPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_MATH_NUMERIC_STATUS_GPU_KERNEL_H_
+
+#include <vector>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/loss_scale_impl.cuh"
+namespace mindspore {
+namespace kernel {
+// The numeric status of the tensors, such as the outputs or the gradients of a step, in the launches packing them
+// like CheckOverflow; the output is a float32 tensor of (tensor number, kNumericStatusSize)
+template <typename T>
+class NumericStatusGpuKernel : public GpuKernel {
+ public:
+  NumericStatusGpuKernel() = default;
+  ~NumericStatusGpuKernel() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
+              const std::vector<AddressPtr> &outputs, uintptr_t stream_ptr) override {
+    float *status = GetDeviceAddress<float>(outputs, 0);
+    size_t input_idx = 0;
+    for (auto &launch : launches_) {
+      float *launch_status = status + input_idx * kNumericStatusSize;
+      for (size_t i = 0; i < launch.tensor_num; ++i) {
+        launch.input[i] = GetDeviceAddress<T>(inputs, input_idx);
+        input_idx++;
+      }
+      NumericStatus(launch, launch_status, reinterpret_cast<cudaStream_t>(stream_ptr));
+    }
+    return true;
+  }
+  bool Init(const CNodePtr &kernel_node) override {
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+    if (output_num != 1) {
+      MS_LOG(ERROR) << "Output number is " << output_num << ", but NumericStatusGpuKernel needs 1 output.";
+      return false;
+    }
+    for (size_t t = 0; t < input_num; ++t) {
+      if (t % kMaxCheckOverflowTensorNum == 0) {
+        launches_.emplace_back();
+        launches_.back().tensor_num = 0;
+        launches_.back().block_offset[0] = 0;
+      }
+      auto &launch = launches_.back();
+      size_t size = 1;
+      auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, t);
+      for (size_t i = 0; i < shape.size(); i++) {
+        size *= shape[i];
+      }
+      input_size_list_.push_back(size * sizeof(T));
+      launch.size[launch.tensor_num] = size;
+      launch.block_offset[launch.tensor_num + 1] =
+        launch.block_offset[launch.tensor_num] + (size + kCheckOverflowChunkSize - 1) / kCheckOverflowChunkSize;
+      launch.tensor_num++;
+    }
+    output_size_list_.push_back(input_num * kNumericStatusSize * sizeof(float));
+    return true;
+  }
+
+ protected:
+  void InitSizeLists() override {}
+
+ private:
+  std::vector<CheckOverflowTensors<T>> launches_;
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_MATH_NUMERIC_STATUS_GPU_KERNEL_H_
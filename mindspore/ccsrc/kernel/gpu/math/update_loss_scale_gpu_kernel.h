@@ -0,0 +1,78 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_MATH_UPDATE_LOSS_SCALE_GPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_MATH_UPDATE_LOSS_SCALE_GPU_KERNEL_H_
+
+#include <vector>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/loss_scale_impl.cuh"
+namespace mindspore {
+namespace kernel {
+// The dynamic loss scale update of DynamicLossScaleUpdateCell in one launch. The inputs are the loss scale, the
+// current step and the last overflow step, updated in place, and the overflow of the step.
+class UpdateLossScaleGpuKernel : public GpuKernel {
+ public:
+  UpdateLossScaleGpuKernel() : scale_factor_(2.0), scale_window_(1000) {}
+  ~UpdateLossScaleGpuKernel() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
+              const std::vector<AddressPtr> &outputs, uintptr_t stream_ptr) override {
+    float *loss_scale = GetDeviceAddress<float>(inputs, 0);
+    int *cur_iter = GetDeviceAddress<int>(inputs, 1);
+    int *last_overflow_iter = GetDeviceAddress<int>(inputs, 2);
+    bool *overflow = GetDeviceAddress<bool>(inputs, 3);
+    bool *output = GetDeviceAddress<bool>(outputs, 0);
+    UpdateLossScale(overflow, loss_scale, cur_iter, last_overflow_iter, scale_factor_, scale_window_, output,
+                    reinterpret_cast<cudaStream_t>(stream_ptr));
+    return true;
+  }
+  bool Init(const CNodePtr &kernel_node) override {
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    if (input_num != 4) {
+      MS_LOG(ERROR) << "Input number is " << input_num << ", but UpdateLossScaleGpuKernel needs 4 inputs.";
+      return false;
+    }
+    scale_factor_ = GetAttr<float>(kernel_node, "scale_factor");
+    scale_window_ = GetAttr<int>(kernel_node, "scale_window");
+    InitSizeLists();
+    return true;
+  }
+
+ protected:
+  void InitSizeLists() override {
+    input_size_list_.push_back(sizeof(float));
+    input_size_list_.push_back(sizeof(int));
+    input_size_list_.push_back(sizeof(int));
+    input_size_list_.push_back(sizeof(bool));
+    output_size_list_.push_back(sizeof(bool));
+  }
+
+ private:
+  float scale_factor_;
+  int scale_window_;
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_MATH_UPDATE_LOSS_SCALE_GPU_KERNEL_H_
@@ -0,0 +1,253 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_NN_CONV2D_BN_RELU_GPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_NN_CONV2D_BN_RELU_GPU_KERNEL_H_
+
+#include <vector>
+#include <string>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/conv_bn_fold_impl.cuh"
+#include "kernel/gpu/kernel_constants.h"
+
+namespace mindspore {
+namespace kernel {
+// Conv2D, the inference BatchNorm and ReLU in one cudnnConvolutionBiasActivationForward. The inputs are x, the filter
+// and the scale, bias, mean and variance of the BatchNorm, which is folded into the filter and the bias on each launch
+// since the parameters may be changed between the runs. The padding of the convolution is symmetric.
+template <typename T>
+class Conv2dBNReluGpuKernel : public GpuKernel {
+ public:
+  Conv2dBNReluGpuKernel()
+      : cudnn_handle_(nullptr),
+        input_desc_(nullptr),
+        output_desc_(nullptr),
+        filter_desc_(nullptr),
+        bias_desc_(nullptr),
+        conv_desc_(nullptr),
+        activation_desc_(nullptr),
+        conv_algorithm_(CUDNN_CONVOLUTION_FWD_ALGO_IMPLICIT_PRECOMP_GEMM),
+        cudnn_data_type_(CUDNN_DATA_FLOAT),
+        epsilon_(1e-5),
+        channel_num_(0),
+        channel_size_(0),
+        is_null_input_(false),
+        input_size_(0),
+        filter_size_(0),
+        bias_size_(0),
+        output_size_(0),
+        workspace_size_(0) {}
+  ~Conv2dBNReluGpuKernel() override { DestroyResource(); }
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs, uintptr_t stream_ptr) override {
+    if (is_null_input_) {
+      return true;
+    }
+    T *input_addr = GetDeviceAddress<T>(inputs, 0);
+    T *filter_addr = GetDeviceAddress<T>(inputs, 1);
+    T *scale_addr = GetDeviceAddress<T>(inputs, 2);
+    T *bias_addr = GetDeviceAddress<T>(inputs, 3);
+    T *mean_addr = GetDeviceAddress<T>(inputs, 4);
+    T *variance_addr = GetDeviceAddress<T>(inputs, 5);
+    T *output_addr = GetDeviceAddress<T>(outputs, 0);
+    T *folded_filter_addr = GetDeviceAddress<T>(workspace, 0);
+    T *folded_bias_addr = GetDeviceAddress<T>(workspace, 1);
+    void *workspace_addr = nullptr;
+    if (workspace_size_ != 0) {
+      workspace_addr = GetDeviceAddress<void>(workspace, 2);
+    }
+    FoldBatchNorm(channel_num_, channel_size_, filter_addr, scale_addr, bias_addr, mean_addr, variance_addr, epsilon_,
+                  folded_filter_addr, folded_bias_addr, reinterpret_cast<cudaStream_t>(stream_ptr));
+
+    // z is not used with alpha2 0, the output is passed for it
+    const float alpha1 = 1;
+    const float alpha2 = 0;
+    CHECK_CUDNN_RET_WITH_EXCEPT(
+      cudnnConvolutionBiasActivationForward(cudnn_handle_, &alpha1, input_desc_, input_addr, filter_desc_,
+                                            folded_filter_addr, conv_desc_, conv_algorithm_, workspace_addr,
+                                            workspace_size_, &alpha2, output_desc_, output_addr, bias_desc_,
+                                            folded_bias_addr, activation_desc_, output_desc_, output_addr),
+      "cudnnConvolutionBiasActivationForward failed");
+    return true;
+  }
+  bool Init(const CNodePtr &kernel_node) override {
+    InitResource();
+    if (!CheckParam(kernel_node)) {
+      return false;
+    }
+    auto in_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+    auto filter_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+    auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+    is_null_input_ = CHECK_NULL_INPUT(in_shape);
+    if (is_null_input_) {
+      MS_LOG(WARNING) << "Conv2dBNReluGpuKernel input is null.";
+      InitSizeLists();
+      return true;
+    }
+    channel_num_ = filter_shape[0];
+    channel_size_ = filter_shape[1] * filter_shape[2] * filter_shape[3];
+    epsilon_ = GetAttr<float>(kernel_node, "epsilon");
+    Set4DDesc(in_shape, filter_shape, output_shape);
+    SetConvDesc(kernel_node);
+    CHECK_CUDNN_RET_WITH_EXCEPT(
+      cudnnSetActivationDescriptor(activation_desc_, CUDNN_ACTIVATION_RELU, CUDNN_PROPAGATE_NAN, 0.0),
+      "cudnnSetActivationDescriptor failed");
+    InitSizeLists();
+    return true;
+  }
+
+ protected:
+  void InitResource() override {
+    cudnn_handle_ = device::gpu::GPUDeviceManager::GetInstance().GetCudnnHandle();
+    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnCreateTensorDescriptor(&input_desc_), "cudnnCreateTensorDescriptor failed");
+    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnCreateTensorDescriptor(&output_desc_), "cudnnCreateTensorDescriptor failed");
+    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnCreateTensorDescriptor(&bias_desc_), "cudnnCreateTensorDescriptor failed");
+    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnCreateFilterDescriptor(&filter_desc_), "cudnnCreateFilterDescriptor failed");
+    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnCreateConvolutionDescriptor(&conv_desc_),
+                                "cudnnCreateConvolutionDescriptor failed");
+    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnCreateActivationDescriptor(&activation_desc_),
+                                "cudnnCreateActivationDescriptor failed");
+  }
+
+  void InitSizeLists() override {
+    if (!is_null_input_) {
+      CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetTensorSizeInBytes(input_desc_, &input_size_),
+                                  "cudnnGetTensorSizeInBytes failed");
+      CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetFilterSizeInBytes(filter_desc_, &filter_size_),
+                                  "cudnnGetFilterSizeInBytes failed");
+      CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetTensorSizeInBytes(bias_desc_, &bias_size_),
+                                  "cudnnGetTensorSizeInBytes failed");
+      CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetTensorSizeInBytes(output_desc_, &output_size_),
+                                  "cudnnGetTensorSizeInBytes failed");
+      CHECK_CUDNN_RET_WITH_EXCEPT(
+        cudnnGetConvolutionForwardWorkspaceSize(cudnn_handle_, input_desc_, filter_desc_, conv_desc_, output_desc_,
+                                                conv_algorithm_, &workspace_size_),
+        "cudnnGetConvolutionForwardWorkspaceSize failed");
+    }
+    input_size_list_.push_back(input_size_);
+    input_size_list_.push_back(filter_size_);
+    for (size_t i = 0; i < 4; i++) {
+      input_size_list_.push_back(bias_size_);  // scale, bias, mean and variance
+    }
+    output_size_list_.push_back(output_size_);
+    workspace_size_list_.push_back(filter_size_);  // folded filter
+    workspace_size_list_.push_back(bias_size_);    // folded bias
+    workspace_size_list_.push_back(workspace_size_);
+  }
+
+ private:
+  void DestroyResource() noexcept {
+    CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroyActivationDescriptor(activation_desc_),
+                               "cudnnDestroyActivationDescriptor failed");
+    CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroyConvolutionDescriptor(conv_desc_),
+                               "cudnnDestroyConvolutionDescriptor failed");
+    CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroyFilterDescriptor(filter_desc_), "cudnnDestroyFilterDescriptor failed");
+    CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroyTensorDescriptor(bias_desc_), "cudnnDestroyTensorDescriptor failed");
+    CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroyTensorDescriptor(output_desc_), "cudnnDestroyTensorDescriptor failed");
+    CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroyTensorDescriptor(input_desc_), "cudnnDestroyTensorDescriptor failed");
+  }
+  bool CheckParam(const CNodePtr &kernel_node) {
+    cudnn_data_type_ = kCudnnDtypeMap[TypeIdLabel(AnfAlgo::GetInputDeviceDataType(kernel_node, 0))];
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    if (input_num != 6) {
+      MS_LOG(ERROR) << "Input number is " << input_num << ", but Conv2dBNReluGpuKernel needs 6 inputs.";
+      return false;
+    }
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+    if (output_num != 1) {
+      MS_LOG(ERROR) << "Output number is " << output_num << ", but Conv2dBNReluGpuKernel needs 1 output.";
+      return false;
+    }
+    return true;
+  }
+  void SetConvDesc(const CNodePtr &kernel_node) {
+    int pad_height = GetAttr<int>(kernel_node, "pad");
+    int pad_width = pad_height;
+    int stride = GetAttr<int>(kernel_node, "stride");
+    int dilation = GetAttr<int>(kernel_node, "dilation");
+    auto pad_mode = GetAttr<std::string>(kernel_node, "pad_mode");
+    if (pad_mode == kSamePadModeUpperCase || pad_mode == kSamePadModeLowerCase) {
+      auto pad_list = GetAttr<std::vector<int>>(kernel_node, "pad_list");
+      if (pad_list[0] != pad_list[1] || pad_list[2] != pad_list[3]) {
+        MS_LOG(EXCEPTION) << "Conv2dBNReluGpuKernel needs the symmetric padding.";
+      }
+      pad_height = pad_list[0];
+      pad_width = pad_list[2];
+    } else if (pad_mode == kValidPadModeUpperCase || pad_mode == kValidPadModeLowerCase) {
+      pad_height = 0;
+      pad_width = 0;
+    }
+    // the bias and the activation are in float for float16, the pseudo half config of cudnn
+    CHECK_CUDNN_RET_WITH_EXCEPT(
+      cudnnSetConvolution2dDescriptor(conv_desc_, pad_height, pad_width, stride, stride, dilation, dilation,
+                                      CUDNN_CROSS_CORRELATION, CUDNN_DATA_FLOAT),
+      "cudnnSetConvolution2dDescriptor failed");
+    if (cudnn_data_type_ == CUDNN_DATA_HALF) {
+      CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetConvolutionMathType(conv_desc_, CUDNN_TENSOR_OP_MATH),
+                                  "cudnnSetConvolutionMathType failed");
+    }
+  }
+  void Set4DDesc(const std::vector<size_t> &in_shape, const std::vector<size_t> &filter_shape,
+                 const std::vector<size_t> &output_shape) {
+    CHECK_CUDNN_RET_WITH_EXCEPT(
+      cudnnSetTensor4dDescriptor(input_desc_, CUDNN_TENSOR_NCHW, cudnn_data_type_, SizeToInt(in_shape[0]),
+                                 SizeToInt(in_shape[1]), SizeToInt(in_shape[2]), SizeToInt(in_shape[3])),
+      "cudnnSetTensor4dDescriptor failed");
+    CHECK_CUDNN_RET_WITH_EXCEPT(
+      cudnnSetFilter4dDescriptor(filter_desc_, cudnn_data_type_, CUDNN_TENSOR_NCHW, SizeToInt(filter_shape[0]),
+                                 SizeToInt(filter_shape[1]), SizeToInt(filter_shape[2]), SizeToInt(filter_shape[3])),
+      "cudnnSetFilter4dDescriptor failed");
+    CHECK_CUDNN_RET_WITH_EXCEPT(
+      cudnnSetTensor4dDescriptor(bias_desc_, CUDNN_TENSOR_NCHW, cudnn_data_type_, 1, SizeToInt(filter_shape[0]), 1, 1),
+      "cudnnSetTensor4dDescriptor failed");
+    CHECK_CUDNN_RET_WITH_EXCEPT(
+      cudnnSetTensor4dDescriptor(output_desc_, CUDNN_TENSOR_NCHW, cudnn_data_type_, SizeToInt(output_shape[0]),
+                                 SizeToInt(output_shape[1]), SizeToInt(output_shape[2]), SizeToInt(output_shape[3])),
+      "cudnnSetTensor4dDescriptor failed");
+  }
+
+  cudnnHandle_t cudnn_handle_;
+  cudnnTensorDescriptor_t input_desc_;
+  cudnnTensorDescriptor_t output_desc_;
+  cudnnFilterDescriptor_t filter_desc_;
+  cudnnTensorDescriptor_t bias_desc_;
+  cudnnConvolutionDescriptor_t conv_desc_;
+  cudnnActivationDescriptor_t activation_desc_;
+  // the only algorithm of cudnnConvolutionBiasActivationForward supporting ReLU
+  cudnnConvolutionFwdAlgo_t conv_algorithm_;
+  cudnnDataType_t cudnn_data_type_;
+  float epsilon_;
+  size_t channel_num_;
+  size_t channel_size_;
+  bool is_null_input_;
+  size_t input_size_;
+  size_t filter_size_;
+  size_t bias_size_;
+  size_t output_size_;
+  size_t workspace_size_;
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_NN_CONV2D_BN_RELU_GPU_KERNEL_H_
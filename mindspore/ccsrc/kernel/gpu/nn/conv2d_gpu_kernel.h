@@ -23,6 +23,7 @@
 #include "kernel/gpu/gpu_kernel.h"
 #include "kernel/gpu/gpu_kernel_factory.h"
 #include "kernel/gpu/cuda_impl/pad_impl.cuh"
+#include "kernel/gpu/cudnn_algo_cache.h"
 #include "kernel/gpu/kernel_constants.h"
 
 namespace mindspore {
@@ -252,14 +253,8 @@ class Conv2dGpuFwdKernel : public GpuKernel {
                                     CUDNN_CONVOLUTION_FWD_SPECIFY_WORKSPACE_LIMIT, 0, &conv_algorithm_),
                                   "cudnnGetConvolutionForwardAlgorithm failed");
     } else {
-      constexpr int requested_algo_count = 1;
-      int returned_algo_count;
-      cudnnConvolutionFwdAlgoPerf_t perf_results;
-      CHECK_CUDNN_RET_WITH_EXCEPT(
-        cudnnGetConvolutionForwardAlgorithm_v7(cudnn_handle_, input_descriptor_real, filter_desc_, conv_desc_,
-                                               output_desc_, requested_algo_count, &returned_algo_count, &perf_results),
-        "cudnnGetConvolutionForwardAlgorithm_v7 failed");
-      conv_algorithm_ = perf_results.algo;
+      conv_algorithm_ =
+        SelectConvForwardAlgo(cudnn_handle_, input_descriptor_real, filter_desc_, conv_desc_, output_desc_);
     }
   }
   cudnnHandle_t cudnn_handle_;
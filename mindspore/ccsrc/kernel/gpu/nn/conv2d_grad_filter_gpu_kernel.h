@@ -23,6 +23,7 @@
 #include "kernel/gpu/gpu_kernel.h"
 #include "kernel/gpu/gpu_kernel_factory.h"
 #include "kernel/gpu/cuda_impl/pad_impl.cuh"
+#include "kernel/gpu/cudnn_algo_cache.h"
 #include "kernel/gpu/kernel_constants.h"
 
 namespace mindspore {
@@ -238,14 +239,7 @@ class ConvGradFilterGpuBkwKernel : public GpuKernel {
                                                    CUDNN_CONVOLUTION_BWD_FILTER_SPECIFY_WORKSPACE_LIMIT, 0, &algo_),
         "GetConvolutionBackwardFilterAlgorithm failed");
     } else {
-      constexpr int requested_algo_count = 1;
-      int returned_algo_count;
-      cudnnConvolutionBwdFilterAlgoPerf_t perf_results;
-      CHECK_CUDNN_RET_WITH_EXCEPT(
-        cudnnGetConvolutionBackwardFilterAlgorithm_v7(cudnn_handle_, x_desc_real, dy_desc_, conv_desc_, dw_desc_,
-                                                      requested_algo_count, &returned_algo_count, &perf_results),
-        "GetConvolutionBackwardFilterAlgorithm failed");
-      algo_ = perf_results.algo;
+      algo_ = SelectConvBackwardFilterAlgo(cudnn_handle_, x_desc_real, dy_desc_, conv_desc_, dw_desc_);
     }
   }
   void GetFilterShape(const CNodePtr &kernel_node, std::vector<int> *filter_shape) {
@@ -23,6 +23,7 @@
 #include "kernel/gpu/gpu_kernel.h"
 #include "kernel/gpu/gpu_kernel_factory.h"
 #include "kernel/gpu/cuda_impl/pad_impl.cuh"
+#include "kernel/gpu/cudnn_algo_cache.h"
 #include "kernel/gpu/kernel_constants.h"
 
 namespace mindspore {
@@ -238,14 +239,7 @@ class ConvGradInputGpuBkwKernel : public GpuKernel {
                                                  CUDNN_CONVOLUTION_BWD_DATA_SPECIFY_WORKSPACE_LIMIT, 0, &algo_),
         "cudnnGetConvolutionBackwardDataAlgorithm failed");
     } else {
-      constexpr int requested_algo_count = 1;
-      int returned_algo_count;
-      cudnnConvolutionBwdDataAlgoPerf_t perf_results;
-      CHECK_CUDNN_RET_WITH_EXCEPT(
-        cudnnGetConvolutionBackwardDataAlgorithm_v7(cudnn_handle_, w_desc_, dy_desc_, conv_desc_, dx_desc_real,
-                                                    requested_algo_count, &returned_algo_count, &perf_results),
-        "cudnnGetConvolutionBackwardDataAlgorithm_v7 failed");
-      algo_ = perf_results.algo;
+      algo_ = SelectConvBackwardDataAlgo(cudnn_handle_, w_desc_, dy_desc_, conv_desc_, dx_desc_real);
     }
   }
   void GetInputShape(const CNodePtr &kernel_node, std::vector<int> *input_shape) {
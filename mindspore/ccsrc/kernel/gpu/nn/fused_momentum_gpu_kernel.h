@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_NN_FUSED_MOMENTUM_GPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_NN_FUSED_MOMENTUM_GPU_KERNEL_H_
+
+#include <vector>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/momentum_impl.cuh"
+namespace mindspore {
+namespace kernel {
+constexpr size_t kMomentumInputNum = 5;
+
+// The ApplyMomentum of many parameters fused by the pass ApplyMomentumFusion, the inputs are the variable,
+// accumulation, learning rate, gradient and momentum of each parameter in turn
+template <typename T>
+class FusedMomentumGpuKernel : public GpuKernel {
+ public:
+  FusedMomentumGpuKernel() = default;
+  ~FusedMomentumGpuKernel() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
+              uintptr_t stream_ptr) override {
+    size_t input_idx = 0;
+    for (auto &launch : launches_) {
+      for (size_t i = 0; i < launch.tensor_num; ++i) {
+        launch.variable[i] = GetDeviceAddress<T>(inputs, input_idx);
+        launch.accumulation[i] = GetDeviceAddress<T>(inputs, input_idx + 1);
+        launch.learning_rate[i] = GetDeviceAddress<T>(inputs, input_idx + 2);
+        launch.gradient[i] = GetDeviceAddress<T>(inputs, input_idx + 3);
+        launch.momentum[i] = GetDeviceAddress<T>(inputs, input_idx + 4);
+        input_idx += kMomentumInputNum;
+      }
+      FusedMomentumUpdateVariable(launch, reinterpret_cast<cudaStream_t>(stream_ptr));
+    }
+    return true;
+  }
+  bool Init(const CNodePtr &kernel_node) override {
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    if (input_num == 0 || input_num % kMomentumInputNum != 0) {
+      MS_LOG(ERROR) << "Input number is " << input_num << ", but fused momentum needs 5 inputs for each parameter.";
+      return false;
+    }
+    size_t tensor_num = input_num / kMomentumInputNum;
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+    if (output_num != tensor_num) {
+      MS_LOG(ERROR) << "Output number is " << output_num << ", but fused momentum needs " << tensor_num << " outputs.";
+      return false;
+    }
+    for (size_t t = 0; t < tensor_num; ++t) {
+      if (t % kMaxFusedMomentumTensorNum == 0) {
+        launches_.emplace_back();
+        launches_.back().tensor_num = 0;
+        launches_.back().block_offset[0] = 0;
+      }
+      auto &launch = launches_.back();
+      size_t input_idx = t * kMomentumInputNum;
+      size_t variable_size = sizeof(T);
+      auto variable_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, input_idx);
+      for (size_t i = 0; i < variable_shape.size(); i++) {
+        variable_size *= variable_shape[i];
+      }
+      // the variable, accumulation and gradient have the same shape
+      input_size_list_.push_back(variable_size);
+      input_size_list_.push_back(variable_size);
+      input_size_list_.push_back(sizeof(T));
+      input_size_list_.push_back(variable_size);
+      input_size_list_.push_back(sizeof(T));
+      output_size_list_.push_back(0);
+
+      size_t size = variable_size / sizeof(T);
+      launch.size[launch.tensor_num] = size;
+      launch.block_offset[launch.tensor_num + 1] =
+        launch.block_offset[launch.tensor_num] + (size + kFusedMomentumChunkSize - 1) / kFusedMomentumChunkSize;
+      launch.tensor_num++;
+    }
+    MS_LOG(INFO) << "Fused momentum updates " << tensor_num << " parameters in " << launches_.size() << " launches";
+    return true;
+  }
+
+ protected:
+  void InitSizeLists() override {}
+
+ private:
+  std::vector<FusedMomentumTensors<T>> launches_;
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_NN_FUSED_MOMENTUM_GPU_KERNEL_H_
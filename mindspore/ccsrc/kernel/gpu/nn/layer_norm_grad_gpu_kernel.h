@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_NN_LAYER_NORM_GRAD_GPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_NN_LAYER_NORM_GRAD_GPU_KERNEL_H_
+
+#include <vector>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/layer_norm_impl.cuh"
+
+namespace mindspore {
+namespace kernel {
+// The inputs are x, dy, variance, mean and gamma, the outputs are dx, dgamma and dbeta
+template <typename T>
+class LayerNormGradGpuKernel : public GpuKernel {
+ public:
+  LayerNormGradGpuKernel() : row_num_(0), col_num_(0), param_num_(0), mean_var_size_(0), is_null_input_(false) {}
+  ~LayerNormGradGpuKernel() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs, uintptr_t stream_ptr) override {
+    if (is_null_input_) {
+      return true;
+    }
+    auto x = GetDeviceAddress<T>(inputs, 0);
+    auto dy = GetDeviceAddress<T>(inputs, 1);
+    auto variance = GetDeviceAddress<T>(inputs, 2);
+    auto mean = GetDeviceAddress<T>(inputs, 3);
+    auto gamma = GetDeviceAddress<T>(inputs, 4);
+    auto dx = GetDeviceAddress<T>(outputs, 0);
+    auto dgamma = GetDeviceAddress<T>(outputs, 1);
+    auto dbeta = GetDeviceAddress<T>(outputs, 2);
+    auto param_grad_part = GetDeviceAddress<float>(workspace, 0);
+    LayerNormGrad(row_num_, col_num_, param_num_, x, dy, variance, mean, gamma, dx, dgamma, dbeta, param_grad_part,
+                  reinterpret_cast<cudaStream_t>(stream_ptr));
+    return true;
+  }
+  bool Init(const CNodePtr &kernel_node) override {
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    if (input_num != 5) {
+      MS_LOG(ERROR) << "Input number is " << input_num << ", but layer norm grad needs 5 inputs.";
+      return false;
+    }
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel_node);
+    if (output_num != 3) {
+      MS_LOG(ERROR) << "Output number is " << output_num << ", but layer norm grad needs 3 outputs.";
+      return false;
+    }
+    auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+    is_null_input_ = CHECK_NULL_INPUT(input_shape);
+    if (is_null_input_) {
+      MS_LOG(WARNING) << "LayerNormGradGpuKernel input is null";
+      InitSizeLists();
+      return true;
+    }
+    int rank = SizeToInt(input_shape.size());
+    int begin_norm_axis = GetAttr<int>(kernel_node, "begin_norm_axis");
+    int begin_params_axis = GetAttr<int>(kernel_node, "begin_params_axis");
+    begin_norm_axis = begin_norm_axis < 0 ? begin_norm_axis + rank : begin_norm_axis;
+    begin_params_axis = begin_params_axis < 0 ? begin_params_axis + rank : begin_params_axis;
+    row_num_ = 1;
+    col_num_ = 1;
+    param_num_ = 1;
+    for (int i = 0; i < rank; ++i) {
+      if (i < begin_norm_axis) {
+        row_num_ *= input_shape[i];
+      } else {
+        col_num_ *= input_shape[i];
+      }
+      if (i >= begin_params_axis) {
+        param_num_ *= input_shape[i];
+      }
+    }
+    mean_var_size_ = sizeof(T);
+    for (auto dim : AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 2)) {
+      mean_var_size_ *= dim;
+    }
+    InitSizeLists();
+    return true;
+  }
+
+ protected:
+  void InitSizeLists() override {
+    size_t input_size = row_num_ * col_num_ * sizeof(T);
+    input_size_list_.push_back(input_size);
+    input_size_list_.push_back(input_size);
+    input_size_list_.push_back(mean_var_size_);
+    input_size_list_.push_back(mean_var_size_);
+    input_size_list_.push_back(param_num_ * sizeof(T));
+    output_size_list_.push_back(input_size);
+    output_size_list_.push_back(param_num_ * sizeof(T));
+    output_size_list_.push_back(param_num_ * sizeof(T));
+    if (!is_null_input_) {
+      workspace_size_list_.push_back(LayerNormGradWorkspaceNum(row_num_, col_num_, param_num_) * sizeof(float));
+    }
+  }
+
+ private:
+  size_t row_num_;
+  size_t col_num_;
+  size_t param_num_;
+  size_t mean_var_size_;
+  bool is_null_input_;
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_NN_LAYER_NORM_GRAD_GPU_KERNEL_H_
@@ -24,6 +24,7 @@
 #include "kernel/gpu/gpu_kernel_factory.h"
 #include "dataset/util/make_unique.h"
 #include "kernel/gpu/kernel_constants.h"
+#include "kernel/gpu/cudnn_algo_cache.h"
 
 namespace mindspore {
 namespace kernel {
@@ -103,10 +104,6 @@ class LstmGpuKernel : public GpuKernel {
     bidirectional_ = GetAttr<bool>(kernel_node, "bidirectional");
     dropout_ = GetAttr<float>(kernel_node, "dropout");
 
-    cudnnRNNInputMode_t input_mode = CUDNN_LINEAR_INPUT;
-    cudnnDirectionMode_t direction = bidirectional_ ? CUDNN_BIDIRECTIONAL : CUDNN_UNIDIRECTIONAL;
-    cudnnRNNMode_t rnn_mode = CUDNN_LSTM;
-    cudnnRNNAlgo_t algo = CUDNN_RNN_ALGO_STANDARD;
     CreateTensorDescGrp();
     int hx_dims[3]{num_layers_ * (bidirectional_ ? 2 : 1), batch_size_, hidden_size_};
     CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetTensorNdDescriptorEx(hx_desc_, CUDNN_TENSOR_NCHW, cudnn_data_type_, 3, hx_dims),
@@ -119,11 +116,8 @@ class LstmGpuKernel : public GpuKernel {
                                 "set cy_desc failed");
     CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetDropoutDescriptor(dropout_desc_, handle_, dropout_, nullptr, 0, 0),
                                 "set dropout_desc failed");
-    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetRNNDescriptor(handle_, rnn_desc_, hidden_size_, num_layers_, dropout_desc_,
-                                                      input_mode, direction, rnn_mode, algo, cudnn_data_type_),
-                                "set rnn_desc failed");
-    cudnnRNNBiasMode_t bias_mode = has_bias_ ? CUDNN_RNN_DOUBLE_BIAS : CUDNN_RNN_NO_BIAS;
-    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetRNNBiasMode(rnn_desc_, bias_mode), "set bias_mode failed");
+    LstmDescInfo info{hidden_size_, num_layers_, bidirectional_, has_bias_, cudnn_data_type_};
+    (void)SetLstmDescriptor(handle_, info, dropout_, dropout_desc_, seq_len_, x_desc_.get(), rnn_desc_);
     auto weight_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 3);
     size_t weight_size = weight_shape[0] * weight_shape[1] * weight_shape[2] * sizeof(T);
     CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetRNNParamsSize(handle_, rnn_desc_, x_desc_[0], &weight_size_, cudnn_data_type_),
@@ -131,7 +125,7 @@ class LstmGpuKernel : public GpuKernel {
     if (weight_size != weight_size_) {
       MS_LOG(EXCEPTION) << "weight size: " << weight_size << " error, expect: " << weight_size_ << " .";
     }
-    int w_dims[3] = {SizeToInt(weight_size_ / 4), 1, 1};
+    int w_dims[3] = {SizeToInt(weight_size_ / sizeof(T)), 1, 1};
     CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetFilterNdDescriptor(w_desc_, cudnn_data_type_, CUDNN_TENSOR_NCHW, 3, w_dims),
                                 "set w_desc failed");
     CHECK_CUDNN_RET_WITH_EXCEPT(
@@ -23,6 +23,7 @@
 #include "kernel/gpu/gpu_kernel.h"
 #include "kernel/gpu/gpu_kernel_factory.h"
 #include "kernel/gpu/kernel_constants.h"
+#include "kernel/gpu/cudnn_algo_cache.h"
 #include "dataset/util/make_unique.h"
 
 namespace mindspore {
@@ -91,9 +92,6 @@ class LstmGradDataGpuKernel : public GpuKernel {
                            dx_desc_.get(), dx_addr, dhx_desc_, dhx_addr, dcx_desc_, dcx_addr, workspace_addr,
                            workspace_size_list_[0], reserved_addr, reserved_size_),
       "launch lstm back data kernel failed");
-
-    CHECK_CUDA_RET_WITH_EXCEPT(cudaStreamSynchronize(reinterpret_cast<cudaStream_t>(stream_ptr)),
-                               "stream synchronize failed.");
     return true;
   }
   void GetAttrs(const CNodePtr &kernel_node) {
@@ -111,10 +109,6 @@ class LstmGradDataGpuKernel : public GpuKernel {
     seq_len_ = SizeToInt(input_shape[0]);
     batch_size_ = SizeToInt(input_shape[1]);
     GetAttrs(kernel_node);
-    cudnnRNNInputMode_t input_mode = CUDNN_LINEAR_INPUT;
-    cudnnDirectionMode_t direction = bidirectional_ ? CUDNN_BIDIRECTIONAL : CUDNN_UNIDIRECTIONAL;
-    cudnnRNNMode_t rnn_mode = CUDNN_LSTM;
-    cudnnRNNAlgo_t algo = CUDNN_RNN_ALGO_STANDARD;
     CreateTensorDescGrp();
     int hx_dims[3]{num_layers_ * (bidirectional_ ? 2 : 1), batch_size_, hidden_size_};
     CHECK_CUDNN_RET_WITH_EXCEPT(
@@ -131,11 +125,8 @@ class LstmGradDataGpuKernel : public GpuKernel {
       cudnnSetTensorNdDescriptorEx(dcx_desc_, CUDNN_TENSOR_NCHW, cudnn_data_type_, 3, hx_dims), "set dcx_desc_ failed");
     CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetDropoutDescriptor(dropout_desc_, handle_, dropout_, nullptr, 0, 0),
                                 "set dropout_desc failed");
-    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetRNNDescriptor(handle_, rnn_desc_, hidden_size_, num_layers_, dropout_desc_,
-                                                      input_mode, direction, rnn_mode, algo, cudnn_data_type_),
-                                "set rnn_desc failed");
-    cudnnRNNBiasMode_t bias_mode = has_bias_ ? CUDNN_RNN_DOUBLE_BIAS : CUDNN_RNN_NO_BIAS;
-    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetRNNBiasMode(rnn_desc_, bias_mode), "set bias_mode failed");
+    LstmDescInfo info{hidden_size_, num_layers_, bidirectional_, has_bias_, cudnn_data_type_};
+    (void)SetLstmDescriptor(handle_, info, dropout_, dropout_desc_, seq_len_, dx_desc_.get(), rnn_desc_);
     auto weight_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 4);
     size_t weight_size = weight_shape[0] * weight_shape[1] * weight_shape[2] * sizeof(T);
     CHECK_CUDNN_RET_WITH_EXCEPT(cudnnGetRNNParamsSize(handle_, rnn_desc_, dx_desc_[0], &weight_size_, cudnn_data_type_),
@@ -143,7 +134,7 @@ class LstmGradDataGpuKernel : public GpuKernel {
     if (weight_size != weight_size_) {
       MS_LOG(EXCEPTION) << "weight size: " << weight_size << " error, expect: " << weight_size_ << " .";
     }
-    int w_dims[3] = {SizeToInt(weight_size_ / 4), 1, 1};
+    int w_dims[3] = {SizeToInt(weight_size_ / sizeof(T)), 1, 1};
     CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetFilterNdDescriptor(w_desc_, cudnn_data_type_, CUDNN_TENSOR_NCHW, 3, w_dims),
                                 "set w_desc failed");
     CHECK_CUDNN_RET_WITH_EXCEPT(
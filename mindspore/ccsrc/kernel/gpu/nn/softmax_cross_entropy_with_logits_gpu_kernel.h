@@ -22,7 +22,6 @@
 #include "kernel/gpu/gpu_kernel.h"
 #include "kernel/gpu/gpu_kernel_factory.h"
 #include "kernel/gpu/cuda_impl/cross_entropy_impl.cuh"
-#include "kernel/gpu/kernel_constants.h"
 
 namespace mindspore {
 namespace kernel {
@@ -30,28 +29,19 @@ template <typename T, typename S>
 class SoftmaxCrossEntropyWithLogitsGpuKernel : public GpuKernel {
  public:
   SoftmaxCrossEntropyWithLogitsGpuKernel()
-      : cudnn_handle_(nullptr),
-        logits_descriptor_(nullptr),
-        softmax_output_descriptor_(nullptr),
-        algo_(CUDNN_SOFTMAX_ACCURATE),
-        mode_(CUDNN_SOFTMAX_MODE_INSTANCE),
-        cudnn_data_type_(CUDNN_DATA_FLOAT),
-        is_null_input_(false),
+      : is_null_input_(false),
         logits_size_(0),
         labels_size_(0),
         output1_size_(0),
         output2_size_(0),
-        softmax_output_logits_size_(0),
         batch_size_(0),
-        channel_size_(0),
-        height_(0),
-        width_(0) {}
-  ~SoftmaxCrossEntropyWithLogitsGpuKernel() override { DestroyResource(); }
+        channel_size_(0) {}
+  ~SoftmaxCrossEntropyWithLogitsGpuKernel() override = default;
 
   const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
   const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
   const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
-  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &,
               const std::vector<AddressPtr> &outputs, uintptr_t stream_ptr) override {
     if (is_null_input_) {
       return true;
@@ -60,23 +50,11 @@ class SoftmaxCrossEntropyWithLogitsGpuKernel : public GpuKernel {
     S *labels_addr = GetDeviceAddress<S>(inputs, 1);
     T *output1_addr = GetDeviceAddress<T>(outputs, 0);
     T *output2_addr = GetDeviceAddress<T>(outputs, 1);
-    T *softmax_output_logits = GetDeviceAddress<T>(workspace, 0);
-
-    const float alpha = 1;
-    const float beta = 0;
-    CHECK_CUDNN_RET_WITH_EXCEPT(
-      cudnnSoftmaxForward(cudnn_handle_, algo_, mode_, &alpha, logits_descriptor_, logits_addr, &beta,
-                          softmax_output_descriptor_, softmax_output_logits),
-      "cudnnSoftmaxForward failed.");
-
-    CrossEntropyWithoutSparse(softmax_output_logits, labels_addr, batch_size_, channel_size_, output1_addr,
-                              reinterpret_cast<cudaStream_t>(stream_ptr));
-    CrossEntropyGradWithoutSparse(softmax_output_logits, labels_addr, batch_size_, channel_size_, output2_addr,
-                                  reinterpret_cast<cudaStream_t>(stream_ptr));
+    SoftmaxCrossEntropyWithoutSparse(logits_addr, labels_addr, batch_size_, channel_size_, output1_addr, output2_addr,
+                                     reinterpret_cast<cudaStream_t>(stream_ptr));
     return true;
   }
   bool Init(const CNodePtr &kernel_node) override {
-    InitResource();
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
     if (input_num != 2) {
       MS_LOG(ERROR) << "Input number is " << input_num
@@ -89,43 +67,20 @@ class SoftmaxCrossEntropyWithLogitsGpuKernel : public GpuKernel {
                     << ", but SoftmaxCrossEntropyWithLogitsGpuKernel needs 2 output.";
       return false;
     }
-    cudnn_data_type_ = kCudnnDtypeMap[TypeIdLabel(AnfAlgo::GetInputDeviceDataType(kernel_node, 0))];
-
     InferInputOutputSize(kernel_node);
-    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnSetTensor4dDescriptor(logits_descriptor_, CUDNN_TENSOR_NCHW, cudnn_data_type_,
-                                                           batch_size_, channel_size_, height_, width_),
-                                "cudnnSetTensor4dDescriptor failed.");
-    CHECK_CUDNN_RET_WITH_EXCEPT(
-      cudnnSetTensor4dDescriptor(softmax_output_descriptor_, CUDNN_TENSOR_NCHW, cudnn_data_type_, batch_size_,
-                                 channel_size_, height_, width_),
-      "cudnnSetTensor4dDescriptor failed.");
     InitSizeLists();
     return true;
   }
 
  protected:
-  void InitResource() override {
-    cudnn_handle_ = device::gpu::GPUDeviceManager::GetInstance().GetCudnnHandle();
-    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnCreateTensorDescriptor(&logits_descriptor_),
-                                "cudnnCreateTensorDescriptor failed.");
-    CHECK_CUDNN_RET_WITH_EXCEPT(cudnnCreateTensorDescriptor(&softmax_output_descriptor_),
-                                "cudnnCreateTensorDescriptor failed.");
-  }
   void InitSizeLists() override {
     input_size_list_.push_back(logits_size_);
     input_size_list_.push_back(labels_size_);
     output_size_list_.push_back(output1_size_);
     output_size_list_.push_back(output2_size_);
-    workspace_size_list_.push_back(softmax_output_logits_size_);
   }
 
  private:
-  void DestroyResource() noexcept {
-    CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroyTensorDescriptor(softmax_output_descriptor_),
-                               "cudnnDestroyTensorDescriptor failed.");
-    CHECK_CUDNN_RET_WITH_ERROR(cudnnDestroyTensorDescriptor(logits_descriptor_),
-                               "cudnnDestroyTensorDescriptor failed.");
-  }
   void InferInputOutputSize(const CNodePtr &kernel_node) {
     auto logits_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
     is_null_input_ = CHECK_NULL_INPUT(logits_shape);
@@ -149,9 +104,7 @@ class SoftmaxCrossEntropyWithLogitsGpuKernel : public GpuKernel {
       batch_size_ *= logits_shape[i];
     }
     channel_size_ = logits_shape[logits_dims - 1];
-    height_ = 1;
-    width_ = 1;
-    logits_size_ = sizeof(T) * batch_size_ * channel_size_ * height_ * width_;
+    logits_size_ = sizeof(T) * batch_size_ * channel_size_;
 
     labels_size_ = 1;
     size_t labels_dims = labels_shape.size();
@@ -162,7 +115,6 @@ class SoftmaxCrossEntropyWithLogitsGpuKernel : public GpuKernel {
 
     output1_size_ = logits_size_ / logits_shape[logits_dims - 1];
     output2_size_ = logits_size_;
-    softmax_output_logits_size_ = logits_size_;
     return;
   }
   void CheckShapeValidation(const std::vector<size_t> &logits_shape, const std::vector<size_t> &labels_shape) {
@@ -180,26 +132,17 @@ class SoftmaxCrossEntropyWithLogitsGpuKernel : public GpuKernel {
     return;
   }
 
-  cudnnHandle_t cudnn_handle_;
-  cudnnTensorDescriptor_t logits_descriptor_;
-  cudnnTensorDescriptor_t softmax_output_descriptor_;
-  cudnnSoftmaxAlgorithm_t algo_;
-  cudnnSoftmaxMode_t mode_;
-  cudnnDataType_t cudnn_data_type_;
   bool is_null_input_;
 
   size_t logits_size_;
   size_t labels_size_;
   size_t output1_size_;
   size_t output2_size_;
-  size_t softmax_output_logits_size_;
   std::vector<size_t> input_size_list_;
   std::vector<size_t> output_size_list_;
   std::vector<size_t> workspace_size_list_;
   size_t batch_size_;
   size_t channel_size_;
-  size_t height_;
-  size_t width_;
 };
 }  // namespace kernel
 }  // namespace mindspore
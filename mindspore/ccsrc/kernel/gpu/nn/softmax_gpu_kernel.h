@@ -38,7 +38,6 @@ class SoftmaxGpuKernel : public GpuKernel {
         is_null_input_(false),
         input_size_(0),
         output_size_(0),
-        workspace_size_(0),
         axis_(0),
         shape_size_(0),
         batch_size_(0),
@@ -60,9 +59,6 @@ class SoftmaxGpuKernel : public GpuKernel {
     T *output_addr = GetDeviceAddress<T>(outputs, 0);
     T *transpose_input_addr = GetDeviceAddress<T>(workspace, 0);
     T *transpose_output_addr = GetDeviceAddress<T>(workspace, 1);
-    int *input_shape = GetDeviceAddress<int>(workspace, 2);
-    int *transpose_shape = GetDeviceAddress<int>(workspace, 3);
-    int *transpose_axis = GetDeviceAddress<int>(workspace, 4);
     const float alpha = 1;
     const float beta = 0;
 
@@ -71,23 +67,14 @@ class SoftmaxGpuKernel : public GpuKernel {
                                                       input_addr, &beta, output_descriptor_, output_addr),
                                   "cudnnSoftmaxForward failed");
     } else {
-      CHECK_CUDA_RET_WITH_EXCEPT(cudaMemcpyAsync(input_shape, &input_shape_[0], workspace_size_, cudaMemcpyHostToDevice,
-                                                 reinterpret_cast<cudaStream_t>(stream_ptr)),
-                                 "cudaMemcpyAsync input_shape failed");
-      CHECK_CUDA_RET_WITH_EXCEPT(cudaMemcpyAsync(transpose_shape, &transpose_shape_[0], workspace_size_,
-                                                 cudaMemcpyHostToDevice, reinterpret_cast<cudaStream_t>(stream_ptr)),
-                                 "cudaMemcpyAsync input_shape failed");
-      CHECK_CUDA_RET_WITH_EXCEPT(cudaMemcpyAsync(transpose_axis, &transpose_axis_[0], workspace_size_,
-                                                 cudaMemcpyHostToDevice, reinterpret_cast<cudaStream_t>(stream_ptr)),
-                                 "cudaMemcpyAsync input_axis failed");
       int size = SizeToInt(input_size_ / sizeof(T));
-      CalTranspose(size, input_addr, input_shape, transpose_axis, shape_size_, transpose_input_addr,
+      CalTranspose(size, input_addr, input_shape_, transpose_axis_, transpose_input_addr,
                    reinterpret_cast<cudaStream_t>(stream_ptr));
       CHECK_CUDNN_RET_WITH_EXCEPT(
         cudnnSoftmaxForward(cudnn_handle_, algo_, mode_, &alpha, input_descriptor_, transpose_input_addr, &beta,
                             output_descriptor_, transpose_output_addr),
         "cudnnSoftmaxForward failed");
-      CalTranspose(size, transpose_output_addr, transpose_shape, transpose_axis, shape_size_, output_addr,
+      CalTranspose(size, transpose_output_addr, transpose_shape_, transpose_axis_, output_addr,
                    reinterpret_cast<cudaStream_t>(stream_ptr));
     }
     return true;
@@ -144,9 +131,6 @@ class SoftmaxGpuKernel : public GpuKernel {
     output_size_list_.push_back(output_size_);
     workspace_size_list_.push_back(input_size_);
     workspace_size_list_.push_back(output_size_);
-    workspace_size_list_.push_back(workspace_size_);
-    workspace_size_list_.push_back(workspace_size_);
-    workspace_size_list_.push_back(workspace_size_);
     return;
   }
 
@@ -181,7 +165,6 @@ class SoftmaxGpuKernel : public GpuKernel {
     width_ = 1;
     input_size_ = sizeof(T) * batch_size_ * channel_size_ * height_ * width_;
     output_size_ = input_size_;
-    workspace_size_ = IntToSize(shape_size_) * sizeof(int);
   }
 
   cudnnHandle_t cudnn_handle_;
@@ -193,7 +176,6 @@ class SoftmaxGpuKernel : public GpuKernel {
   bool is_null_input_;
   size_t input_size_;
   size_t output_size_;
-  size_t workspace_size_;
   std::vector<size_t> input_size_list_;
   std::vector<size_t> output_size_list_;
   std::vector<size_t> workspace_size_list_;
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_CCSRC_KERNEL_GPU_NN_SPARSE_APPLY_ADAGRAD_GPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_GPU_NN_SPARSE_APPLY_ADAGRAD_GPU_KERNEL_H_
+
+#include <vector>
+#include "kernel/gpu/gpu_kernel.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/gpu/cuda_impl/sparse_apply_adagrad_impl.cuh"
+namespace mindspore {
+namespace kernel {
+// The adagrad update of the rows of var picked by the indices, the gradient is given by the values of these rows
+// only, so the dense gradient of [vocab, dim] of an embedding isn't built.
+template <typename T, typename S>
+class SparseApplyAdagradGpuKernel : public GpuKernel {
+ public:
+  SparseApplyAdagradGpuKernel() : var_rows_(1), inner_size_(1), indices_num_(1), lr_(0) {}
+  ~SparseApplyAdagradGpuKernel() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &, uintptr_t stream_ptr) override {
+    T *variable = GetDeviceAddress<T>(inputs, 0);
+    T *accumulation = GetDeviceAddress<T>(inputs, 1);
+    T *gradient = GetDeviceAddress<T>(inputs, 2);
+    S *indices = GetDeviceAddress<S>(inputs, 3);
+    int *row_slot = GetDeviceAddress<int>(workspace, 0);
+    T *grad_sum = GetDeviceAddress<T>(workspace, 1);
+    SparseApplyAdagrad(var_rows_, inner_size_, indices_num_, lr_, variable, accumulation, gradient, indices, row_slot,
+                       grad_sum, reinterpret_cast<cudaStream_t>(stream_ptr));
+    return true;
+  }
+  bool Init(const CNodePtr &kernel_node) override {
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+    if (input_num != 4) {
+      MS_LOG(ERROR) << "Input number is " << input_num << ", but sparse apply adagrad needs 4 inputs.";
+      return false;
+    }
+    auto variable_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+    auto indices_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 3);
+    if (variable_shape.empty() || indices_shape.size() != 1) {
+      MS_LOG(ERROR) << "Sparse apply adagrad needs the var of rank >= 1 and the indices of rank 1, but got "
+                    << variable_shape.size() << " and " << indices_shape.size();
+      return false;
+    }
+    var_rows_ = variable_shape[0];
+    for (size_t i = 1; i < variable_shape.size(); i++) {
+      inner_size_ *= variable_shape[i];
+    }
+    indices_num_ = indices_shape[0];
+    lr_ = GetAttr<float>(kernel_node, "lr");
+    InitSizeLists();
+    return true;
+  }
+
+ protected:
+  void InitSizeLists() override {
+    input_size_list_.push_back(var_rows_ * inner_size_ * sizeof(T));
+    input_size_list_.push_back(var_rows_ * inner_size_ * sizeof(T));
+    input_size_list_.push_back(indices_num_ * inner_size_ * sizeof(T));
+    input_size_list_.push_back(indices_num_ * sizeof(S));
+    output_size_list_.push_back(0);
+    // one int of a row of var, which is far smaller than the dense gradient
+    workspace_size_list_.push_back(var_rows_ * sizeof(int));
+    workspace_size_list_.push_back(indices_num_ * inner_size_ * sizeof(T));
+  }
+
+ private:
+  size_t var_rows_;
+  size_t inner_size_;
+  size_t indices_num_;
+  float lr_;
+
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_GPU_NN_SPARSE_APPLY_ADAGRAD_GPU_KERNEL_H_
@@ -49,6 +49,7 @@ constexpr auto kFormat = "format";
 constexpr auto kNeedCompile = "need_compile";
 constexpr auto kShape = "shape";
 std::vector<std::shared_ptr<OpInfo>> OpLib::op_info_;
+std::unordered_map<std::string, std::shared_ptr<OpInfo>> OpLib::op_info_index_;
 
 string ImplTypeToStr(OpImplyType impl_type) {
   switch (impl_type) {
@@ -129,6 +130,7 @@ bool OpLib::DecodeOpInfo(const nlohmann::json& obj, const mindspore::kernel::OpI
     return false;
   }
   op_info_.push_back(op_info);
+  (void)op_info_index_.emplace(IndexKey(op_info->op_name(), imply_type), op_info);
   return true;
 }
 
@@ -204,11 +206,9 @@ std::shared_ptr<OpInfo> OpLib::FindOp(const std::string& op_name, OpImplyType im
                   << "current op num:" << op_info_.size();
     return nullptr;
   }
-  for (const auto& op_info : op_info_) {
-    MS_EXCEPTION_IF_NULL(op_info);
-    if (op_info->op_name() == op_name && op_info->imply_type() == imply_type) {
-      return op_info;
-    }
+  auto iter = op_info_index_.find(IndexKey(op_name, imply_type));
+  if (iter != op_info_index_.end()) {
+    return iter->second;
   }
   MS_LOG(DEBUG) << "FindOp failed: opname:" << op_name << "imply_type:" << ImplTypeToStr(imply_type)
                 << "current op num:" << op_info_.size();
@@ -237,12 +237,17 @@ bool OpLib::GetRefInfo(const std::shared_ptr<OpInfo>& op_info) {
   return true;
 }
 
+std::string OpLib::IndexKey(const std::string& op_name, OpImplyType imply_type) {
+  return ImplTypeToStr(imply_type) + "." + op_name;
+}
+
 bool OpLib::CheckRepetition(const std::shared_ptr<OpInfo>& op_info) {
   MS_EXCEPTION_IF_NULL(op_info);
-  for (const auto& exist_op_info : op_info_) {
+  auto iter = op_info_index_.find(IndexKey(op_info->op_name(), op_info->imply_type()));
+  if (iter != op_info_index_.end()) {
+    auto& exist_op_info = iter->second;
     MS_EXCEPTION_IF_NULL(exist_op_info);
-    if (exist_op_info->op_name() == op_info->op_name() && exist_op_info->imply_type() == op_info->imply_type() &&
-        exist_op_info->impl_path() != op_info->impl_path()) {
+    if (exist_op_info->impl_path() != op_info->impl_path()) {
       MS_LOG(DEBUG) << "Has already exist, drop the latter one, op name:" << op_info->op_name()
                     << "op type:" << ImplTypeToStr(op_info->imply_type());
       return false;
@@ -19,6 +19,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 #include "kernel/oplib/opinfo.h"
 
@@ -33,6 +34,8 @@ class OpLib {
 
  protected:
   static std::vector<std::shared_ptr<OpInfo>> op_info_;
+  // the first op info registered of each op name and imply type, which FindOp returns
+  static std::unordered_map<std::string, std::shared_ptr<OpInfo>> op_info_index_;
 
  private:
   static bool DecodeOpInfo(const nlohmann::json& obj, const OpImplyType imply_type, const std::string& impl_path);
@@ -42,6 +45,7 @@ class OpLib {
                                 const std::shared_ptr<OpInfo>& op_info);
   static bool GetRefInfo(const std::shared_ptr<OpInfo>& op_info);
   static bool CheckRepetition(const std::shared_ptr<OpInfo>& op_info);
+  static std::string IndexKey(const std::string& op_name, OpImplyType imply_type);
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -16,6 +16,13 @@
 
 #include "kernel/tbe/tbe_kernel_parallel_build.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <thread>
 #include <memory>
 #include <map>
 #include <set>
@@ -32,6 +39,7 @@
 #include "kernel/tbe/tbe_python_funcs.h"
 #include "kernel/tbe/tbe_convert_utils.h"
 #include "kernel/tbe/tbe_utils.h"
+#include "utils/metrics.h"
 
 namespace mindspore {
 namespace kernel {
@@ -40,11 +48,123 @@ constexpr auto kParallelCompileModule = "mindspore._extends.parallel_compile.tbe
 constexpr auto kCreateParallelCompiler = "create_tbe_parallel_compiler";
 constexpr auto kStartCompileOp = "start_compile_op";
 constexpr auto kWaitOne = "wait_one";
+constexpr auto kLockSuffix = ".lock";
+// a lock older than it is left by a process that died, the kernel is built again
+constexpr time_t kKernelLockTimeout = 1800;
+constexpr int kPublishPollMs = 200;
+
+namespace {
+// the compiler waits its tasks in the order they are started, so the early ones are joined before any other build
+std::shared_ptr<ParallelBuildManager> early_build_manager = nullptr;
+
+struct PublishWaitInfo {
+  AnfNodePtr node;
+  nlohmann::json kernel_json;
+  std::string json_name;
+  std::vector<size_t> input_size_list;
+  std::vector<size_t> output_size_list;
+};
+
+void WaitAllTasks(const std::shared_ptr<ParallelBuildManager> &build_manger) {
+  while (!build_manger->IsAllTaskFinish()) {
+    int task_id = -1;
+    char *task_result = nullptr;
+    auto ret = build_manger->WaitOne(&task_id, &task_result);
+    if (!ret) {
+      MS_EXCEPTION(ArgumentError) << "Build Failed. wait one ret:" << ret << ", task id:" << task_id;
+    }
+
+    if ((task_result != nullptr) && (strcmp(task_result, "Success") != 0)) {
+      MS_EXCEPTION(ArgumentError) << "task compile Failed, task id:" << task_id << ", cause:" << task_result;
+    }
+    (void)build_manger->TaskFinishProcess(task_id);
+  }
+}
+
+// take the kernels built by the other processes from the cache, the ones they failed to publish are built here
+void WaitPublishedKernels(const std::shared_ptr<ParallelBuildManager> &build_manger,
+                          std::vector<PublishWaitInfo> *wait_list) {
+  while (!wait_list->empty()) {
+    std::vector<PublishWaitInfo> waiting;
+    for (auto &info : *wait_list) {
+      if (build_manger->IsKernelLocked(info.json_name)) {
+        waiting.push_back(std::move(info));
+        continue;
+      }
+      const std::string &processor = tbe::GetProcessor(info.node);
+      if (build_manger->SearchInCache(info.json_name, processor, info.input_size_list, info.output_size_list,
+                                      info.node.get())) {
+        MS_LOG(INFO) << "Use kernel published by the other process, kernel json name:" << info.json_name;
+        continue;
+      }
+      if (!build_manger->LockKernel(info.json_name)) {
+        waiting.push_back(std::move(info));
+        continue;
+      }
+      auto task_id = build_manger->StartCompileOp(info.kernel_json);
+      build_manger->SaveTaskInfo(task_id, info.node, info.json_name, info.input_size_list, info.output_size_list);
+    }
+    WaitAllTasks(build_manger);
+    *wait_list = std::move(waiting);
+    if (!wait_list->empty()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(kPublishPollMs));
+    }
+  }
+}
+}  // namespace
+
+void TbeOpEarlyBuild(const std::vector<AnfNodePtr> &anf_nodes) {
+  TbeUtils::LoadCache();
+  if (early_build_manager == nullptr) {
+    early_build_manager = std::make_shared<ParallelBuildManager>();
+  }
+  size_t started = 0;
+  for (const auto &anf_node : anf_nodes) {
+    tbe::TbeAdapter::SetTbeAttrsForTransDataOp(anf_node);
+    nlohmann::json kernel_json;
+    TbeKernelJsonCreator creator(SINGLE_BUILD);
+    if (!creator.GenTbeSingleKernelJson(anf_node, &kernel_json)) {
+      continue;
+    }
+    const std::string &json_name = creator.json_name();
+    // the kernels cached or being built are left to the build
+    if (TbeUtils::SearchCache(json_name, tbe::GetProcessor(anf_node)) != nullptr ||
+        !early_build_manager->LockKernel(json_name)) {
+      continue;
+    }
+    std::vector<size_t> input_size_list;
+    std::vector<size_t> output_size_list;
+    (void)TbeKernelBuild::GetIOSize(kernel_json, &input_size_list, &output_size_list);
+    auto task_id = early_build_manager->StartCompileOp(kernel_json);
+    early_build_manager->SaveTaskInfo(task_id, anf_node, json_name, input_size_list, output_size_list);
+    started++;
+  }
+  MS_LOG(INFO) << "Start building " << started << " kernels early.";
+}
+
+void JoinTbeOpEarlyBuild() {
+  if (early_build_manager == nullptr) {
+    return;
+  }
+  while (!early_build_manager->IsAllTaskFinish()) {
+    int task_id = -1;
+    char *task_result = nullptr;
+    (void)early_build_manager->WaitOne(&task_id, &task_result);
+    // the kernel failed is built again by the build, which reports the error
+    if ((task_result != nullptr) && (strcmp(task_result, "Success") != 0)) {
+      MS_LOG(INFO) << "Early build of task " << task_id << " failed: " << task_result;
+    }
+    (void)early_build_manager->TaskFinishProcess(task_id, false);
+  }
+  early_build_manager = nullptr;
+}
 
 bool TbeOpParallelBuild(std::vector<AnfNodePtr> anf_nodes) {
+  JoinTbeOpEarlyBuild();
   auto build_manger = std::make_shared<ParallelBuildManager>();
   MS_EXCEPTION_IF_NULL(build_manger);
   set<std::string> processed_kernel;
+  std::vector<PublishWaitInfo> wait_list;
   for (const auto &anf_node : anf_nodes) {
     // gen kernel json
     tbe::TbeAdapter::SetTbeAttrsForTransDataOp(anf_node);
@@ -74,28 +194,72 @@ bool TbeOpParallelBuild(std::vector<AnfNodePtr> anf_nodes) {
       continue;
     }
     (void)processed_kernel.insert(json_name);
+    // another process sharing the kernel meta dir is building it
+    if (!build_manger->LockKernel(json_name)) {
+      wait_list.push_back({anf_node, kernel_json, json_name, input_size_list, output_size_list});
+      continue;
+    }
     // op build
     auto task_id = build_manger->StartCompileOp(kernel_json);
     build_manger->SaveTaskInfo(task_id, anf_node, json_name, input_size_list, output_size_list);
   }
-  while (!build_manger->IsAllTaskFinish()) {
-    int task_id = -1;
-    char *task_result = nullptr;
-    auto ret = build_manger->WaitOne(&task_id, &task_result);
-    if (!ret) {
-      MS_EXCEPTION(ArgumentError) << "Build Failed. wait one ret:" << ret << ", task id:" << task_id;
-    }
-
-    if ((task_result != nullptr) && (strcmp(task_result, "Success") != 0)) {
-      MS_EXCEPTION(ArgumentError) << "task compile Failed, task id:" << task_id << ", cause:" << task_result;
-    }
-    (void)build_manger->TaskFinishProcess(task_id);
-  }
+  WaitAllTasks(build_manger);
+  WaitPublishedKernels(build_manger, &wait_list);
   return build_manger->GenSameOpKernelMod();
 }
 
 ParallelBuildManager::ParallelBuildManager() { tbe_parallel_compiler_ = TbePythonFuncs::TbeParallelCompiler(); }
 
+ParallelBuildManager::~ParallelBuildManager() {
+  // the locks of the kernels failed to build, the other processes build them then
+  auto locked_kernels = locked_kernels_;
+  for (const auto &json_name : locked_kernels) {
+    UnlockKernel(json_name);
+  }
+}
+
+bool ParallelBuildManager::LockKernel(const std::string &json_name) {
+  if (!TbeUtils::IsKernelMetaShared()) {
+    return true;
+  }
+  std::string lock_path = TbeUtils::KernelMetaDir() + json_name + kLockSuffix;
+  int fd = open(lock_path.c_str(), O_CREAT | O_EXCL | O_WRONLY, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return false;
+  }
+  (void)close(fd);
+  (void)locked_kernels_.insert(json_name);
+  MS_LOG(INFO) << "Lock kernel " << json_name << " to build it";
+  return true;
+}
+
+void ParallelBuildManager::UnlockKernel(const std::string &json_name) {
+  if (locked_kernels_.erase(json_name) == 0) {
+    return;
+  }
+  std::string lock_path = TbeUtils::KernelMetaDir() + json_name + kLockSuffix;
+  if (remove(lock_path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Remove the kernel lock " << lock_path << " failed.";
+  }
+}
+
+bool ParallelBuildManager::IsKernelLocked(const std::string &json_name) const {
+  if (!TbeUtils::IsKernelMetaShared()) {
+    return false;
+  }
+  std::string lock_path = TbeUtils::KernelMetaDir() + json_name + kLockSuffix;
+  struct stat lock_stat;
+  if (stat(lock_path.c_str(), &lock_stat) != 0) {
+    return false;
+  }
+  if (time(nullptr) - lock_stat.st_mtime > kKernelLockTimeout) {
+    MS_LOG(WARNING) << "The kernel lock " << lock_path << " is timeout, remove it.";
+    (void)remove(lock_path.c_str());
+    return false;
+  }
+  return true;
+}
+
 int32_t ParallelBuildManager::StartCompileOp(const nlohmann::json &kernel_json) const {
   PyObject *pRes = nullptr;
   PyObject *pArgs = PyTuple_New(1);
@@ -160,6 +324,8 @@ std::pair<int32_t, KernelModPtr> ParallelBuildManager::TaskFinishProcess(int32_t
   auto json_name = task_iter->second.json_name;
   auto processor = task_iter->second.processor;
   auto kernel_pack = TbeUtils::InsertCache(json_name, processor);
+  // the kernel is published to the other processes, or they build it when it failed
+  UnlockKernel(json_name);
   if (kernel_pack == nullptr) {
     if (set_kernel_mod) {
       MS_EXCEPTION(ArgumentError) << "build kernel name:" << task_iter->second.json_name << " failed.";
@@ -209,7 +375,12 @@ bool ParallelBuildManager::GenSameOpKernelMod() const {
 bool ParallelBuildManager::SearchInCache(const std::string &json_name, const std::string &processor,
                                          const std::vector<size_t> &input_size_list,
                                          const std::vector<size_t> &output_size_list, mindspore::AnfNode *node) const {
+  static auto cache_hits = MetricsRegistry::GetInstance().GetCounter("mindspore_kernel_cache_hits_total",
+                                                                    "The kernels found in the kernel cache.");
+  static auto cache_misses = MetricsRegistry::GetInstance().GetCounter("mindspore_kernel_cache_misses_total",
+                                                                      "The kernels not found in the kernel cache.");
   auto cached_kernel_pack = TbeUtils::SearchCache(json_name, processor);
+  (cached_kernel_pack != nullptr ? cache_hits : cache_misses)->Add();
   if (cached_kernel_pack != nullptr) {
     MS_LOG(INFO) << "Find cached kernel, kernel json name" << json_name;
     auto kernel_mod_ptr = GenKernelMod(json_name, processor, input_size_list, output_size_list, cached_kernel_pack);
@@ -20,6 +20,7 @@
 #include <utility>
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 #include "kernel/kernel.h"
 #include "pybind11/stl.h"
@@ -27,6 +28,10 @@
 namespace mindspore {
 namespace kernel {
 bool TbeOpParallelBuild(std::vector<AnfNodePtr> anf_nodes);
+// Start compiling the kernels of the nodes whose formats are final, while the graph is still optimized and its memory
+// assigned. The kernels are put into the cache and taken from it by the next build, which joins them first.
+void TbeOpEarlyBuild(const std::vector<AnfNodePtr> &anf_nodes);
+void JoinTbeOpEarlyBuild();
 
 struct KernelBuildTaskInfo {
   AnfNode *node;
@@ -40,7 +45,7 @@ struct KernelBuildTaskInfo {
 class ParallelBuildManager {
  public:
   ParallelBuildManager();
-  ~ParallelBuildManager() = default;
+  ~ParallelBuildManager();
   int32_t StartCompileOp(const nlohmann::json &kernel_json) const;
   void SaveTaskInfo(int32_t task_id, const AnfNodePtr &anf_node, const std::string &json_name,
                     const std::vector<size_t> &input_size_list, const std::vector<size_t> &output_size_list,
@@ -58,7 +63,14 @@ class ParallelBuildManager {
   KernelModPtr GenKernelMod(const string &json_name, const string &processor, const vector<size_t> &input_size_list,
                             const vector<size_t> &output_size_list, const KernelPackPtr &kernel_pack) const;
 
+  // The lock of a kernel in the shared kernel meta dir is held by the process building it, the others wait for it
+  // to be published to the cache. They're always taken when the dir isn't shared.
+  bool LockKernel(const std::string &json_name);
+  void UnlockKernel(const std::string &json_name);
+  bool IsKernelLocked(const std::string &json_name) const;
+
  private:
+  std::set<std::string> locked_kernels_;
   PyObject *tbe_parallel_compiler_;
   std::map<int32_t, KernelBuildTaskInfo> task_map_;
   std::vector<KernelBuildTaskInfo> same_op_list_;
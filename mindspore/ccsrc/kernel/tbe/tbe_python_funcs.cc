@@ -108,9 +108,13 @@ std::string TbePythonFuncs::OpSelectFormat(const nlohmann::json &kernel_json) {
     return res_json_str;
   }
 
+  std::string json_str = kernel_json.dump();
+  if (TbeUtils::SearchQueryCache(kOpSelectFormatFunc, json_str, &res_json_str)) {
+    return res_json_str;
+  }
+
   // assembly Args
   pArg = PyTuple_New(1);
-  std::string json_str = kernel_json.dump();
   (void)PyTuple_SetItem(pArg, 0, Py_BuildValue("s", json_str.c_str()));
   if (pArg == nullptr) {
     MS_LOG(ERROR) << "Failed to generate parameter from kernel_json to PyObject.";
@@ -133,6 +137,7 @@ std::string TbePythonFuncs::OpSelectFormat(const nlohmann::json &kernel_json) {
   char *pstr = nullptr;
   (void)PyArg_Parse(pRet, "s", &pstr);
   res_json_str = pstr;
+  TbeUtils::SaveQueryCache(kOpSelectFormatFunc, json_str, res_json_str);
   return res_json_str;
 }
 
@@ -145,9 +150,14 @@ bool TbePythonFuncs::CheckSupported(const nlohmann::json &kernel_json) {
     MS_LOG(ERROR) << "TbePythonFuncs Initialize Failed !";
     return ret;
   }
+  std::string json_str = kernel_json.dump();
+  std::string cached_ret;
+  if (TbeUtils::SearchQueryCache(kCheckSupportedFunc, json_str, &cached_ret)) {
+    return cached_ret == "1";
+  }
+
   // assembly Args
   pArg = PyTuple_New(1);
-  std::string json_str = kernel_json.dump();
   PyObject *arg1 = Py_BuildValue("s", json_str.c_str());
   (void)PyTuple_SetItem(pArg, 0, arg1);
   if (pArg == nullptr) {
@@ -168,6 +178,7 @@ bool TbePythonFuncs::CheckSupported(const nlohmann::json &kernel_json) {
                                 << "], function args: " << PyObjectToStr(pArg);
   }
   ret = PyObject_IsTrue(pRes) != 0;
+  TbeUtils::SaveQueryCache(kCheckSupportedFunc, json_str, ret ? "1" : "0");
   return ret;
 }
 
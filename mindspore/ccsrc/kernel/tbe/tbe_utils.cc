@@ -18,6 +18,9 @@
 
 #include <sys/types.h>
 #include <dirent.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
 #include <vector>
 #include <string>
 #include <utility>
@@ -25,8 +28,12 @@
 #include <functional>
 #include <iostream>
 #include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 
 #include "kernel/oplib/oplib.h"
+#include "kernel/common_utils.h"
 #include "utils/utils.h"
 #include "session/anf_runtime_algorithm.h"
 #include "common/utils.h"
@@ -40,15 +47,17 @@ namespace mindspore {
 namespace kernel {
 namespace tbe {
 constexpr auto kCceKernelMeta = "./kernel_meta/";
+constexpr auto kCompilerCachePathEnv = "MS_COMPILER_CACHE_PATH";
 constexpr auto kJsonSuffix = ".json";
 constexpr auto kInfoSuffix = ".info";
+constexpr auto kQuerySuffix = ".query";
 
 uintptr_t KernelManager::kernel_stub_gen_ = 0;
 std::unordered_map<string, KernelMetaPtr> KernelManager::info_table_ = {};
 
 void TbeUtils::SaveJsonInfo(const std::string &json_name, const std::string &info) {
   char real_path[PATH_MAX] = {0};
-  std::string path = kCceKernelMeta + json_name + kInfoSuffix;
+  std::string path = KernelMetaDir() + json_name + kInfoSuffix;
   if (path.size() > PATH_MAX) {
     MS_LOG(ERROR) << "file path: " << path << "is too long.";
     return;
@@ -78,16 +87,33 @@ void TbeUtils::SaveJsonInfo(const std::string &json_name, const std::string &inf
 void TbeUtils::LoadCache() {
   static bool has_load = false;
   if (!has_load) {
+    UnpackKernelBundle(KernelMetaDir());
     KernelMeta *bin_map = KernelMeta::GetInstance();
-    if (bin_map != nullptr && !bin_map->ReadIndex(kCceKernelMeta)) {
-      MS_LOG(INFO) << "Cache initialize failed[" << kCceKernelMeta << "]";
+    if (bin_map != nullptr && !bin_map->ReadIndex(KernelMetaDir())) {
+      MS_LOG(INFO) << "Cache initialize failed[" << KernelMetaDir() << "]";
     } else {
-      MS_LOG(INFO) << "Cache initialize to " << kCceKernelMeta;
+      MS_LOG(INFO) << "Cache initialize to " << KernelMetaDir();
     }
     has_load = true;
   }
 }
 
+std::string TbeUtils::KernelMetaDir() {
+  static const std::string dir = []() {
+    const char *cache_path = getenv(kCompilerCachePathEnv);
+    if (cache_path == nullptr || std::string(cache_path).empty()) {
+      return std::string(kCceKernelMeta);
+    }
+    return std::string(cache_path) + "/kernel_meta/";
+  }();
+  return dir;
+}
+
+bool TbeUtils::IsKernelMetaShared() {
+  const char *cache_path = getenv(kCompilerCachePathEnv);
+  return cache_path != nullptr && !std::string(cache_path).empty();
+}
+
 KernelPackPtr TbeUtils::SearchCache(const std::string &kernel_name, const std::string &processor) {
   // search cache.
   KernelMeta *bin_map = KernelMeta::GetInstance();
@@ -106,6 +132,72 @@ KernelPackPtr TbeUtils::InsertCache(const std::string &kernel_name, const std::s
   return SearchCache(kernel_name, processor);
 }
 
+namespace {
+// the results already read or saved by the process, the nodes alike ask the same queries many times in a graph
+std::unordered_map<std::string, std::string> query_results;
+std::mutex query_results_mutex;
+
+std::string QueryCachePath(const std::string &func_name, const std::string &query) {
+  std::ostringstream path;
+  path << TbeUtils::KernelMetaDir() << func_name << "_" << std::hex << std::hash<std::string>()(query) << kQuerySuffix;
+  return path.str();
+}
+
+void SaveQueryResult(const std::string &func_name, const std::string &query, const std::string &result) {
+  std::lock_guard<std::mutex> lock(query_results_mutex);
+  query_results[func_name + "\n" + query] = result;
+}
+}  // namespace
+
+bool TbeUtils::SearchQueryCache(const std::string &func_name, const std::string &query, std::string *result) {
+  MS_EXCEPTION_IF_NULL(result);
+  {
+    std::lock_guard<std::mutex> lock(query_results_mutex);
+    auto iter = query_results.find(func_name + "\n" + query);
+    if (iter != query_results.end()) {
+      *result = iter->second;
+      return true;
+    }
+  }
+  std::ifstream fin(QueryCachePath(func_name, query));
+  if (!fin) {
+    return false;
+  }
+  // the first line is the query, the hashes of the different queries may be the same
+  std::string cached_query;
+  if (!std::getline(fin, cached_query) || cached_query != query || !std::getline(fin, *result)) {
+    return false;
+  }
+  MS_LOG(DEBUG) << "Find cached " << func_name << " result: " << *result;
+  SaveQueryResult(func_name, query, *result);
+  return true;
+}
+
+void TbeUtils::SaveQueryCache(const std::string &func_name, const std::string &query, const std::string &result) {
+  SaveQueryResult(func_name, query, result);
+  // the queries and the results are dumped in one line json
+  if (query.find('\n') != std::string::npos || result.find('\n') != std::string::npos) {
+    return;
+  }
+  std::string path = QueryCachePath(func_name, query);
+  if (path.size() > PATH_MAX) {
+    MS_LOG(DEBUG) << "file path: " << path << " is too long.";
+    return;
+  }
+  // written to a file of the process first, the processes sharing the dir never read a half written one
+  std::string tmp_path = path + "." + std::to_string(getpid());
+  std::ofstream fout(tmp_path);
+  if (!fout.is_open()) {
+    return;
+  }
+  fout << query << "\n" << result << std::endl;
+  fout.close();
+  if (rename(tmp_path.c_str(), path.c_str()) != 0) {
+    MS_LOG(DEBUG) << "rename file: " << tmp_path << " to " << path << " fail.";
+    (void)remove(tmp_path.c_str());
+  }
+}
+
 int KernelManager::BinaryRegister(const mindspore::kernel::FlexArray &kernel_buffer, void **module,
                                   const string &magic) {
   static std::map<string, uint32_t> magic_maps = {{"RT_DEV_BINARY_MAGIC_ELF", RT_DEV_BINARY_MAGIC_ELF},
@@ -231,7 +323,7 @@ KernelPackPtr KernelMeta::GetKernelPack(const std::string &kernel_name, const st
     ret = kernel_pack_iter->second;
   } else {
     // 2. kernel file has been create, but pack does not been created.
-    std::string cce_json = kCceKernelMeta;
+    std::string cce_json = TbeUtils::KernelMetaDir();
     (void)cce_json.append(kernel_name).append(kJsonSuffix);
     ret = std::make_shared<KernelPack>();
     if (!ret->LoadKernelMeta(cce_json, processor)) {
@@ -43,9 +43,21 @@ class TbeUtils {
 
   static void LoadCache();
 
+  // The kernel meta dir is kernel_meta in the dir set by MS_COMPILER_CACHE_PATH, or in the working dir if it's not
+  // set. The processes of a job may share the dir on a shared file system, each kernel is built by one of them.
+  static std::string KernelMetaDir();
+
+  static bool IsKernelMetaShared();
+
   static KernelPackPtr SearchCache(const std::string &kernel_name, const std::string &processor);
 
   static KernelPackPtr InsertCache(const std::string &kernel_name, const std::string &processor);
+
+  // The results of the python queries of the kernel selection are saved to the kernel meta dir with the query and
+  // kept in memory, func_name names the query, the entry is only hit by the same query string
+  static bool SearchQueryCache(const std::string &func_name, const std::string &query, std::string *result);
+
+  static void SaveQueryCache(const std::string &func_name, const std::string &query, const std::string &result);
 };
 
 struct KernelMetaInfo {
@@ -74,6 +74,8 @@ void BindShardWriter(py::module *m) {
     .def("open_for_append", &ShardWriter::OpenForAppend)
     .def("set_header_size", &ShardWriter::set_header_size)
     .def("set_page_size", &ShardWriter::set_page_size)
+    .def("set_compression", &ShardWriter::set_compression)
+    .def("set_flush_budget", &ShardWriter::set_flush_budget)
     .def("set_shard_header", &ShardWriter::SetShardHeader)
     .def("write_raw_data",
          (MSRStatus(ShardWriter::*)(std::map<uint64_t, std::vector<py::handle>> &, vector<vector<uint8_t>> &, bool)) &
@@ -81,6 +83,9 @@ void BindShardWriter(py::module *m) {
     .def("write_raw_nlp_data", (MSRStatus(ShardWriter::*)(std::map<uint64_t, std::vector<py::handle>> &,
                                                           std::map<uint64_t, std::vector<py::handle>> &, bool)) &
                                  ShardWriter::WriteRawData)
+    .def("write_raw_data_from_files",
+         (MSRStatus(ShardWriter::*)(std::vector<py::handle> &, const std::vector<std::string> &, int, bool)) &
+           ShardWriter::WriteRawDataFromFiles)
     .def("commit", &ShardWriter::Commit);
 }
 
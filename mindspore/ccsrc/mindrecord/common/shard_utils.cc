@@ -15,6 +15,7 @@
  */
 
 #include "mindrecord/include/common/shard_utils.h"
+#include <zlib.h>
 #include "common/utils.h"
 #include "./securec.h"
 
@@ -176,5 +177,38 @@ uint32_t GetMaxThreadNum() {
   }
   return thread_num;
 }
+
+MSRStatus CompressBlob(const std::vector<uint8_t> &blob, std::vector<uint8_t> &compressed) {
+  uint64_t length = blob.size();
+  uLongf compressed_length = compressBound(length);
+  compressed.resize(kInt64Len + compressed_length);
+  if (memcpy_s(&compressed[0], kInt64Len, &length, kInt64Len) != EOK) {
+    MS_LOG(ERROR) << "Failed to copy the blob length";
+    return FAILED;
+  }
+  // the fastest level, the blobs are mostly decoded images which only deflate a little
+  if (compress2(&compressed[kInt64Len], &compressed_length, blob.data(), length, Z_BEST_SPEED) != Z_OK) {
+    MS_LOG(ERROR) << "Failed to compress the blob";
+    return FAILED;
+  }
+  compressed.resize(kInt64Len + compressed_length);
+  return SUCCESS;
+}
+
+MSRStatus DecompressBlob(const uint8_t *data, uint64_t length, std::vector<uint8_t> &blob) {
+  uint64_t blob_length = 0;
+  if (length < kInt64Len || memcpy_s(&blob_length, kInt64Len, data, kInt64Len) != EOK) {
+    MS_LOG(ERROR) << "Compressed blob is truncated";
+    return FAILED;
+  }
+  blob.resize(blob_length);
+  uLongf decompressed_length = blob_length;
+  if (uncompress(blob.data(), &decompressed_length, data + kInt64Len, length - kInt64Len) != Z_OK ||
+      decompressed_length != blob_length) {
+    MS_LOG(ERROR) << "Failed to decompress the blob";
+    return FAILED;
+  }
+  return SUCCESS;
+}
 }  // namespace mindrecord
 }  // namespace mindspore
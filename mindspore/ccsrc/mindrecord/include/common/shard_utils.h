@@ -86,6 +86,16 @@ const int kMaxPageSize = 1 << 28;  // 256MB
 // used by value length / schema id length / statistic id length ...
 const uint64_t kInt64Len = 8;
 
+// blob compression, recorded in the shard header
+const char kCompressionNone[] = "none";
+const char kCompressionZlib[] = "zlib";
+
+// row directory, a sidecar of each shard file which lets the readers skip the index database
+const char kRowDirectorySuffix[] = ".dir";
+const uint64_t kRowDirectoryMagic = 0x3152494452534dULL;  // "MSRDIR1"
+// row id, row group id, blob offset and end, raw page id, raw offset and end
+const int kRowDirectoryFields = 7;
+
 // Minimum file size
 const uint64_t kMinFileSize = kInt64Len;
 
@@ -97,6 +107,8 @@ const int kMaxConsumerCount = 128;
 
 const int kMaxSchemaCount = 1;
 const int kMaxThreadCount = 32;
+// Rows whose blob files are read at a time by WriteRawDataFromFiles
+const size_t kFileBatchRows = 1024;
 const int kMaxFieldCount = 100;
 
 // Minimum free disk size
@@ -156,6 +168,19 @@ std::pair<MSRStatus, uint64_t> GetDiskSize(const std::string &str_dir, const Dis
 /// \brief get the max hardware concurrency
 /// \return max concurrency
 uint32_t GetMaxThreadNum();
+
+/// \brief compress one blob, the result starts with the uncompressed length
+/// \param[in] blob the blob
+/// \param[out] compressed the compressed blob
+/// \return SUCCESS/FAILED
+MSRStatus CompressBlob(const std::vector<uint8_t> &blob, std::vector<uint8_t> &compressed);
+
+/// \brief decompress a blob made by CompressBlob
+/// \param[in] data the compressed blob
+/// \param[in] length the size of the compressed blob
+/// \param[out] blob the blob
+/// \return SUCCESS/FAILED
+MSRStatus DecompressBlob(const uint8_t *data, uint64_t length, std::vector<uint8_t> &blob);
 }  // namespace mindrecord
 }  // namespace mindspore
 
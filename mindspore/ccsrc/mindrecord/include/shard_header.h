@@ -117,6 +117,10 @@ class ShardHeader {
 
   void set_page_size(const uint64_t &page_size) { page_size_ = page_size; }
 
+  std::string get_compression() const { return compression_; }
+
+  void set_compression(const std::string &compression) { compression_ = compression; }
+
   const string get_version() { return version_; }
 
   std::vector<std::string> SerializeHeader();
@@ -170,6 +174,7 @@ class ShardHeader {
   uint32_t shard_count_;
   uint64_t header_size_;
   uint64_t page_size_;
+  std::string compression_ = kCompressionNone;  // compression of the blobs
   string version_ = "2.0";
 
   std::shared_ptr<Index> index_;
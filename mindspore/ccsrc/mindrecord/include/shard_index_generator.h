@@ -17,11 +17,15 @@
 #ifndef MINDRECORD_INCLUDE_SHARD_INDEX_GENERATOR_H_
 #define MINDRECORD_INCLUDE_SHARD_INDEX_GENERATOR_H_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -54,7 +58,7 @@ class ShardIndexGenerator {
   /// \return the type of field
   static std::string TakeFieldType(const std::string &field_path, json schema);
 
-  /// \brief create databases for indexes
+  /// \brief create databases for indexes, one thread per shard up to the hardware concurrency
   MSRStatus WriteToDatabase();
 
  private:
@@ -86,8 +90,7 @@ class ShardIndexGenerator {
   /// \param data
   /// \return
   MSRStatus BindParamaterExecuteSQL(
-    sqlite3 *db, const std::string &sql,
-    const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
+    sqlite3_stmt *stmt, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
 
   INDEX_FIELDS GenerateIndexFields(const std::vector<json> &schema_detail);
 
@@ -96,6 +99,23 @@ class ShardIndexGenerator {
 
   MSRStatus CreateShardNameTable(sqlite3 *db, const std::string &shard_name);
 
+  /// \brief create the indexes of the table once it is loaded, cheaper than keeping them up to date row by row
+  MSRStatus CreateTableIndexes(sqlite3 *db);
+
+  /// \brief thread entry, creates the databases of the shards left until all are done or one fails
+  void DatabaseWriter();
+
+  /// \brief create the database of one shard
+  MSRStatus WriteShardDatabase(int shard_no);
+
+  /// \brief add the directory entries of the rows of one raw page
+  void AddRowDirectory(const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data,
+                       std::vector<std::array<uint64_t, kRowDirectoryFields>> &directory);
+
+  /// \brief write the row directory of one shard next to its database, rows in ROW_ID order
+  MSRStatus WriteRowDirectory(const std::string &shard_address,
+                              std::vector<std::array<uint64_t, kRowDirectoryFields>> &directory);
+
   MSRStatus AddBlobPageInfo(std::vector<std::tuple<std::string, std::string, std::string>> &row_data,
                             const std::shared_ptr<Page> cur_blob_page, uint64_t &cur_blob_page_offset,
                             std::fstream &in);
@@ -110,6 +130,11 @@ class ShardIndexGenerator {
   uint64_t header_size_;
   int schema_count_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
+
+  std::atomic<int> task_{0};                 // next shard whose database is created
+  std::atomic<bool> write_success_{true};   // no database failed so far
+  std::atomic<int64_t> raw_pages_done_{0};  // raw pages indexed over all the shards, for the progress
+  int64_t raw_pages_total_ = 0;             // raw pages of all the shards
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_PAGE_CACHE_H_
+#define MINDRECORD_INCLUDE_SHARD_PAGE_CACHE_H_
+
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace mindrecord {
+// The environment variable of the memory budget of the page cache in MB, the cache is off if it is unset or 0
+const char kPageCacheSizeEnv[] = "MS_MINDRECORD_PAGE_CACHE_SIZE";
+// Pages seen but not cached whose last access is remembered for the admission
+const size_t kMaxGhostPages = 1 << 16;
+
+using CachedPage = std::shared_ptr<const std::vector<uint8_t>>;
+
+/// \brief The blob pages read by all the ShardReaders of the process, as they are on disk, keyed by the file and the
+///        page id. The least recently used pages are evicted to keep to the memory budget, and a page is only admitted
+///        once it is accessed again within the bytes the budget holds, so a scan of the files larger than the budget
+///        does not flush the pages that are reused.
+class ShardPageCache {
+ public:
+  ~ShardPageCache() = default;
+
+  ShardPageCache(const ShardPageCache &) = delete;
+
+  ShardPageCache &operator=(const ShardPageCache &) = delete;
+
+  /// \brief the cache of the process, whose budget is read from MS_MINDRECORD_PAGE_CACHE_SIZE
+  static ShardPageCache &GetInstance();
+
+  /// \brief set the memory budget, the pages beyond it are evicted
+  /// \param[in] capacity the budget in bytes, 0 turns the cache off
+  void set_capacity(uint64_t capacity);
+
+  uint64_t get_capacity();
+
+  /// \brief whether the pages are looked up at all
+  bool enabled();
+
+  /// \brief look up a page and record the access of the given bytes of it
+  /// \param[in] file_key the key of the file, from FileKey
+  /// \param[in] page_id the id of the page in the file
+  /// \param[in] access_bytes the bytes read by the access, by which the reuse distance grows
+  /// \param[out] admit whether the page is missing and should be inserted once it is read
+  /// \return the page, or nullptr if it is not cached
+  CachedPage Lookup(const std::string &file_key, int64_t page_id, uint64_t access_bytes, bool *admit);
+
+  /// \brief insert a page admitted by Lookup
+  void Insert(const std::string &file_key, int64_t page_id, CachedPage page);
+
+  /// \brief the key of a file, which changes once the file is written again
+  static std::string FileKey(const std::string &file_path);
+
+  /// \brief drop all the pages and the access history
+  void Clear();
+
+  uint64_t get_hits();
+
+  uint64_t get_misses();
+
+ private:
+  ShardPageCache() = default;
+
+  struct Entry {
+    CachedPage page;
+    std::list<std::string>::iterator lru_pos;
+  };
+
+  void EvictTo(uint64_t capacity);
+
+  std::mutex mutex_;
+  uint64_t capacity_ = 0;
+  uint64_t size_ = 0;
+  // the bytes accessed so far, the reuse distance of a page is the growth of it between two accesses
+  uint64_t clock_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  std::list<std::string> lru_;  // the most recently used first
+  std::unordered_map<std::string, Entry> pages_;
+  std::unordered_map<std::string, uint64_t> ghosts_;  // the clock at the last access of the pages not cached
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_PAGE_CACHE_H_
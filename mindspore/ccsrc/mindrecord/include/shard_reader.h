@@ -19,11 +19,13 @@
 
 #include <dirent.h>
 #include <signal.h>
+#include <sys/mman.h>
 #include <sys/prctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <fstream>
@@ -44,6 +46,7 @@
 #include "mindrecord/include/shard_error.h"
 #include "mindrecord/include/shard_index_generator.h"
 #include "mindrecord/include/shard_operator.h"
+#include "mindrecord/include/shard_page_cache.h"
 #include "mindrecord/include/shard_reader.h"
 #include "mindrecord/include/shard_sample.h"
 #include "mindrecord/include/shard_shuffle.h"
@@ -59,6 +62,23 @@ using TASK_RETURN_CONTENT = std::pair<MSRStatus, std::vector<std::tuple<std::vec
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
 const int kNumPageInBuffer = 16;  // page buffer size in block-reader mode
 
+/// \brief the values of one label column for some rows, stored in the type of its schema field, chars for strings
+struct ShardColumnValues {
+  std::string name;
+  std::string type;               // int32, int64, float32, float64 or string
+  bool is_array = false;          // the field has a shape, each row holds an array of values
+  std::vector<uint8_t> data;      // the values of the rows back to back
+  std::vector<uint64_t> offsets;  // the rows + 1 byte offsets of the values of each row in data
+};
+
+/// \brief a batch of rows as columns, read without a json per row
+struct ShardColumnarBatch {
+  uint32_t num_rows = 0;
+  std::vector<uint8_t> blob_data;          // the blobs of the rows back to back
+  std::vector<uint64_t> blob_offsets;      // the rows + 1 offsets of the blob of each row in blob_data
+  std::vector<ShardColumnValues> columns;  // the label columns, in the order of the selected columns
+};
+
 class ShardReader {
  public:
   ShardReader();
@@ -71,10 +91,12 @@ class ShardReader {
   /// \param[in] selected_columns column list to be populated
   /// \param[in] operators operators applied to data, operator type is shuffle, sample or category
   /// \param[in] block_reader block-reader mode if true, otherwise row-reader mode
+  /// \param[in] mmap_mode read the files through memory mappings if true, otherwise through file streams
   /// \return MSRStatus the status of MSRStatus
   MSRStatus Open(const std::string &file_path, int n_consumer = 4,
                  const std::vector<std::string> &selected_columns = {},
-                 const std::vector<std::shared_ptr<ShardOperator>> &operators = {}, const bool &block_reader = false);
+                 const std::vector<std::shared_ptr<ShardOperator>> &operators = {}, const bool &block_reader = false,
+                 const bool &mmap_mode = false);
 
   /// \brief open files and initialize reader, python API
   /// \param[in] file_path the path of ONE file, any file in dataset is fine
@@ -172,6 +194,15 @@ class ShardReader {
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<uint8_t>, json>> GetNextById(const int64_t &task_id, const int32_t &consumer_id);
 
+  /// \brief return the rows from a row id as columns, in row-reader mode of CV data only
+  /// \param[in] task_id the id of the first row
+  /// \param[in] num_rows the number of rows, fewer are returned at the end of the rows
+  /// \param[in] consumer_id the id of the consumer reading the rows
+  /// \param[out] batch the blobs and the label columns of the rows
+  /// \return MSRStatus FAILED if the rows can not be read or the labels do not fit their schema as columns
+  MSRStatus GetColumnarBatch(const int64_t &task_id, const int32_t &num_rows, const int32_t &consumer_id,
+                             ShardColumnarBatch *batch);
+
   /// \brief return a batch in block-reader mode, given that one is ready
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<uint8_t>, json>> GetBlockNext();
@@ -192,6 +223,12 @@ class ShardReader {
   /// \return null
   void set_all_in_index(bool all_in_index) { all_in_index_ = all_in_index; }
 
+  /// \brief set the number of tasks read ahead of the consumers, row groups in block-reader mode and rows in
+  ///        row-reader mode, must be called before Open
+  /// \param[in] prefetch_depth the number of tasks, kNumPageInBuffer if not set
+  /// \return null
+  void set_prefetch_depth(int prefetch_depth) { prefetch_depth_ = prefetch_depth; }
+
   /// \brief get NLP flag
   bool get_nlp_flag();
 
@@ -199,6 +236,9 @@ class ShardReader {
   /// \brief sqlite call back function
   static int SelectCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names);
 
+  /// \brief open the index database of every shard, unless they are open already
+  MSRStatus OpenDatabases();
+
  private:
   /// \brief wrap up labels to json format
   MSRStatus ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
@@ -208,6 +248,14 @@ class ShardReader {
   /// \brief read all rows for specified columns
   ROW_GROUPS ReadAllRowGroup(std::vector<std::string> &columns);
 
+  /// \brief T/F if every shard has a row directory to create the tasks from instead of its index database
+  bool HasRowDirectories() const;
+
+  /// \brief read all rows in one shard from its row directory, labels from the raw pages
+  MSRStatus ReadRowDirectory(int shard_id, const std::vector<std::string> &columns,
+                             std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                             std::vector<std::vector<json>> &column_values);
+
   /// \brief read all rows in one shard
   MSRStatus ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
@@ -270,6 +318,12 @@ class ShardReader {
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
+  /// \brief read the blob of one task, appended to blob
+  MSRStatus ReadTaskBlob(int task_id, uint32_t consumer_id, std::vector<uint8_t> &blob);
+
+  /// \brief convert the labels of all the tasks to label_columns_, once
+  MSRStatus BuildLabelColumns();
+
   /// \brief get all the column names by schema
   vector<std::string> GetAllColumns();
 
@@ -282,17 +336,53 @@ class ShardReader {
 
   MSRStatus ReadBlob(const int &shard_id, const uint64_t &page_offset, const int &page_length, const int &buf_id);
 
+  /// \brief get a page from the page cache of the process, reading it through fs if it is admitted
+  /// \param[in] access_bytes the bytes of the page the caller reads
+  /// \param[out] page the page, or nullptr if it is not cached and the caller reads from the file itself
+  MSRStatus ReadCachedPage(const std::shared_ptr<std::fstream> &fs, int shard_id, int64_t page_id,
+                           uint64_t page_length, uint64_t access_bytes, CachedPage *page);
+
+  /// \brief decompress the blobs of a page in buffer to block_blobs_
+  MSRStatus DecompressPage(const int &buf_id);
+
+  /// \brief map all the shard files read only, unmap them all on failure
+  MSRStatus MapFiles();
+
+  /// \brief unmap the shard files
+  void UnmapFiles();
+
+  /// \brief hint the kernel on the access pattern of the mappings, sequential unless the tasks are permuted
+  void AdviseMaps();
+
+  /// \brief hint the kernel to read the blobs of the tasks up to prefetch_depth_ after task_id, each task once
+  void Prefetch(int task_id);
+
+  /// \brief hint the kernel to read ahead a file range, it is read asynchronously while the consumers work
+  void PrefetchRange(int shard_id, uint64_t offset, uint64_t length);
+
+  /// \brief hint the kernel to read ahead the blob of one task
+  void PrefetchTask(int task_id);
+
  protected:
   uint64_t header_size_;                       // header size
   uint64_t page_size_;                         // page size
   int shard_count_;                            // number of shards
   std::shared_ptr<ShardHeader> shard_header_;  // shard header
   bool nlp_ = false;                           // NLP data
+  bool compressed_ = false;                    // blobs compressed by the writer
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
   std::vector<string> file_paths_;                                               // file paths
+  std::vector<string> page_cache_keys_;                                          // file keys in the page cache
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  bool mmap_mode_ = false;                                                       // files read through mappings
+  std::vector<std::pair<uint8_t *, uint64_t>> file_maps_;                        // mapping and size of each file
+  std::vector<int> hint_fds_;                                                    // read ahead handle of each file
+  int prefetch_depth_ = kNumPageInBuffer;                                        // tasks read ahead of consumers
+  std::atomic<int> prefetch_id_;                                                 // first task not hinted yet
+  bool use_directory_ = false;                                                   // tasks created from row directories
+  bool index_required_ = false;                                                  // index databases opened regardless
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -302,6 +392,11 @@ class ShardReader {
   ShardTask tasks_;                                        // shard task
   std::mutex shard_locker_;                                // locker of shard
 
+  // the labels of the tasks as columns, in the order of the task list, built by the first columnar batch
+  std::once_flag label_columns_once_;
+  MSRStatus label_columns_status_ = FAILED;
+  std::vector<ShardColumnValues> label_columns_;
+
   // flags
   bool all_in_index_ = true;  // if all columns are stored in index-table
   bool interrupt_ = false;    // reader interrupted
@@ -327,6 +422,9 @@ class ShardReader {
   std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>> delivery_block_;
   std::unordered_set<int> delivery_block_set_;  // set of delivered pages
   std::vector<std::vector<uint8_t>> buf_;       // page buffer
+  std::vector<const uint8_t *> blob_pages_;     // pages within the mappings in mmap mode, instead of buf_
+  // decompressed blobs of each page in buffer, when the blobs are compressed
+  std::vector<std::vector<std::vector<uint8_t>>> block_blobs_;
   // Block reader mode end
 };
 }  // namespace mindrecord
@@ -18,20 +18,29 @@
 #define MINDRECORD_INCLUDE_SHARD_SHUFFLE_H_
 
 #include <random>
+#include <vector>
 #include "mindrecord/include/shard_operator.h"
 
 namespace mindspore {
 namespace mindrecord {
 class ShardShuffle : public ShardOperator {
  public:
-  explicit ShardShuffle(uint32_t seed = 0);
+  /// \brief shuffle the rows, or the row groups then the rows within windows of consecutive rows
+  /// \param[in] seed the seed, the same on every rank so that the ranks sample the same permutation
+  /// \param[in] block_window 0 to shuffle the rows across all the row groups, otherwise the number of rows
+  ///        shuffled together once the row groups are shuffled, which keeps the page reads near sequential
+  explicit ShardShuffle(uint32_t seed = 0, uint32_t block_window = 0);
 
   ~ShardShuffle() override{};
 
   MSRStatus operator()(ShardTask &tasks) override;
 
  private:
+  /// \brief shuffle the row groups, then the rows within each window
+  void ShuffleBlocks(ShardTask &tasks);
+
   uint32_t shuffle_seed_;
+  uint32_t block_window_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
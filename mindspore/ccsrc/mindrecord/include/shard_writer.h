@@ -21,10 +21,15 @@
 #include <unistd.h>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <functional>
+#include <future>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -75,6 +80,18 @@ class ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   MSRStatus set_page_size(const uint64_t &page_size);
 
+  /// \brief Set the compression of the blobs, before the shard header
+  /// \param[in] compression kCompressionNone or kCompressionZlib
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus set_compression(const std::string &compression);
+
+  /// \brief Set the memory budget of the rows serialized ahead of the disk writes, before the first write.
+  ///        With a budget the rows are written by a background thread while the next ones are serialized,
+  ///        WriteRawData then takes the blob data and reports the write errors on the next call or on Commit
+  /// \param[in] flush_budget bytes of rows waiting for the disk, 0 to write them before WriteRawData returns
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus set_flush_budget(const uint64_t &flush_budget);
+
   /// \brief Set shard header
   /// \param[in] header_data the info of header
   ///        WARNING, only called when file is empty
@@ -105,10 +122,51 @@ class ShardWriter {
   MSRStatus WriteRawData(std::map<uint64_t, std::vector<py::handle>> &raw_data,
                          std::map<uint64_t, std::vector<py::handle>> &blob_data, bool sign = true);
 
+  /// \brief write raw data whose only blob field is the content of a file, the files are read by worker threads
+  ///        while the rows read before are written
+  /// \param[in] raw_data the vector of raw json data, without the blob field
+  /// \param[in] file_names the file holding the blob field of each row
+  /// \param[in] num_workers the number of threads reading the files
+  /// \param[in] sign validate data or not
+  /// \return MSRStatus the status of MSRStatus to judge if write successfully
+  MSRStatus WriteRawDataFromFiles(std::vector<json> &raw_data, const std::vector<std::string> &file_names,
+                                  int num_workers, bool sign = true);
+
+  /// \brief write raw data whose only blob field is the content of a file for call from python, the GIL is released
+  ///        once the raw data is converted
+  /// \param[in] raw_data the vector of raw json data, python-handle format
+  /// \param[in] file_names the file holding the blob field of each row
+  /// \param[in] num_workers the number of threads reading the files
+  /// \param[in] sign validate data or not
+  /// \return MSRStatus the status of MSRStatus to judge if write successfully
+  MSRStatus WriteRawDataFromFiles(std::vector<py::handle> &raw_data, const std::vector<std::string> &file_names,
+                                  int num_workers, bool sign = true);
+
  private:
+  // rows serialized by WriteRawData and waiting to be written to disk
+  struct RowBatch {
+    std::vector<std::vector<uint8_t>> blob_data;
+    std::vector<std::vector<uint8_t>> bin_raw_data;
+    std::vector<uint64_t> raw_data_size;
+    std::vector<uint64_t> blob_data_size;
+    uint64_t bytes;
+  };
+
   /// \brief write shard header data to disk
   MSRStatus WriteShardHeader();
 
+  /// \brief write one batch of rows to disk
+  MSRStatus FlushBatch(RowBatch &batch);
+
+  /// \brief hand one batch of rows to the flush thread, waits while the budget is used up
+  MSRStatus QueueBatch(std::shared_ptr<RowBatch> batch);
+
+  /// \brief flush thread, writes the queued batches in order
+  void FlushWorker();
+
+  /// \brief wait for the queued batches to be written and stop the flush thread
+  MSRStatus StopFlush();
+
   /// \brief erase error data
   void DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data, std::vector<std::vector<uint8_t>> &blob_data);
 
@@ -183,10 +241,17 @@ class ShardWriter {
   std::vector<std::pair<int, int>> BreakIntoShards();
 
   /// \brief calculate raw data size row by row
-  MSRStatus SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data);
+  MSRStatus SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                           std::vector<uint64_t> &raw_data_size);
 
   /// \brief calculate blob data size row by row
-  MSRStatus SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data);
+  MSRStatus SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data, std::vector<uint64_t> &blob_data_size);
+
+  /// \brief compress the blobs in place with multi threads
+  MSRStatus CompressBlobData(std::vector<std::vector<uint8_t>> &blob_data);
+
+  /// \brief compress the blobs of rows [start, end)
+  void CompressBlobRange(int start, int end, std::vector<std::vector<uint8_t>> &blob_data);
 
   /// \brief populate last raw page pointer
   void SetLastRawPage(const int &shard_id, std::shared_ptr<Page> &last_raw_page);
@@ -205,6 +270,7 @@ class ShardWriter {
   int shard_count_;        // number of files
   uint64_t header_size_;   // header size
   uint64_t page_size_;     // page size
+  std::string compression_ = kCompressionNone;  // compression of the blobs
   uint32_t row_count_;     // count of rows
   uint32_t schema_count_;  // count of schemas
 
@@ -219,6 +285,15 @@ class ShardWriter {
 
   std::mutex check_mutex_;  // mutex for data check
   std::atomic<bool> flag_{false};
+
+  uint64_t flush_budget_ = 0;                          // bytes of rows serialized ahead of the disk writes
+  uint64_t flush_bytes_ = 0;                           // bytes of the queued batches
+  std::deque<std::shared_ptr<RowBatch>> flush_queue_;  // batches waiting for the disk, the first one is written
+  std::thread flush_thread_;                           // writes the queued batches
+  std::mutex flush_mutex_;                             // mutex for the queue
+  std::condition_variable cv_flush_;                   // queue changed
+  bool flush_stop_ = false;                            // no more batches once the queue is drained
+  std::atomic<bool> flush_failed_{false};              // a queued batch could not be written
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -164,6 +164,21 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CheckDatabase(const std::st
   }
 }
 
+MSRStatus ShardIndexGenerator::CreateTableIndexes(sqlite3 *db) {
+  std::string sql = "CREATE UNIQUE INDEX INDEXES_KEY ON INDEXES(ROW_ID";
+  for (uint64_t i = 0; i < fields_.size(); ++i) sql += ",INC_" + std::to_string(i);
+  sql += ");";
+  if (ExecuteSQL(sql, db, "create key index successfully.") != SUCCESS) {
+    return FAILED;
+  }
+  // the readers look the rows of a blob page up
+  sql = "CREATE INDEX INDEXES_PAGE_ID_BLOB ON INDEXES(PAGE_ID_BLOB);";
+  if (ExecuteSQL(sql, db, "create page index successfully.") != SUCCESS) {
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardIndexGenerator::CreateShardNameTable(sqlite3 *db, const std::string &shard_name) {
   // create shard_name table
   std::string sql = "DROP TABLE IF EXISTS SHARD_NAME;";
@@ -195,7 +210,12 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no
     return {FAILED, nullptr};
   }
   sqlite3 *db = ret1.second;
-  std::string sql = "DROP TABLE IF EXISTS INDEXES;";
+  // the database is rebuilt from the shard file whenever it is lost, no need for a journal during the load
+  std::string sql = "PRAGMA synchronous = OFF; PRAGMA journal_mode = OFF;";
+  if (ExecuteSQL(sql, db, "set pragma successfully.") != SUCCESS) {
+    return {FAILED, nullptr};
+  }
+  sql = "DROP TABLE IF EXISTS INDEXES;";
   if (ExecuteSQL(sql, db, "drop table successfully.") != SUCCESS) {
     return {FAILED, nullptr};
   }
@@ -221,9 +241,8 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no
     }
     sql += ",INC_" + std::to_string(field_no++) + " INT, " + ret.second + " " + type;
   }
-  sql += ", PRIMARY KEY(ROW_ID";
-  for (uint64_t i = 0; i < fields_.size(); ++i) sql += ",INC_" + std::to_string(i);
-  sql += "));";
+  // the key is a unique index built by CreateTableIndexes after the load
+  sql += ");";
   if (ExecuteSQL(sql, db, "create table successfully.") != SUCCESS) {
     return {FAILED, nullptr};
   }
@@ -285,13 +304,7 @@ std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateRawSQL(
 }
 
 MSRStatus ShardIndexGenerator::BindParamaterExecuteSQL(
-  sqlite3 *db, const std::string &sql,
-  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
-  sqlite3_stmt *stmt = nullptr;
-  if (sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, 0) != SQLITE_OK) {
-    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql;
-    return FAILED;
-  }
+  sqlite3_stmt *stmt, const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
   for (auto &row : data) {
     for (auto &field : row) {
       const auto &place_holder = std::get<0>(field);
@@ -328,7 +341,6 @@ MSRStatus ShardIndexGenerator::BindParamaterExecuteSQL(
     }
     (void)sqlite3_reset(stmt);
   }
-  (void)sqlite3_finalize(stmt);
   return SUCCESS;
 }
 
@@ -478,25 +490,42 @@ MSRStatus ShardIndexGenerator::ExcuteTransaction(const int &shard_no, const std:
   std::string shard_address = shard_header_.get_shard_address_by_id(shard_no);
   if (shard_address.empty()) {
     MS_LOG(ERROR) << "Shard address is null";
+    (void)sqlite3_close(db.second);
+    return FAILED;
+  }
+
+  // One statement for all the rows of the shard
+  auto sql = GenerateRawSQL(fields_);
+  if (sql.first != SUCCESS) {
+    (void)sqlite3_close(db.second);
+    return FAILED;
+  }
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db.second, common::SafeCStr(sql.second), -1, &stmt, 0) != SQLITE_OK) {
+    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql.second;
+    (void)sqlite3_close(db.second);
     return FAILED;
   }
 
   std::fstream in;
   in.open(common::SafeCStr(shard_address), std::ios::in | std::ios::binary);
   (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+  MSRStatus ret = SUCCESS;
+  std::vector<std::array<uint64_t, kRowDirectoryFields>> directory;
   for (int raw_page_id : raw_page_ids) {
-    auto sql = GenerateRawSQL(fields_);
-    if (sql.first != SUCCESS) {
-      return FAILED;
-    }
     auto data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in);
-    if (data.first != SUCCESS) {
-      return FAILED;
-    }
-    if (BindParamaterExecuteSQL(db.second, sql.second, data.second) == FAILED) {
-      return FAILED;
+    if (data.first != SUCCESS || BindParamaterExecuteSQL(stmt, data.second) == FAILED) {
+      ret = FAILED;
+      break;
     }
-    MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
+    AddRowDirectory(data.second, directory);
+    MS_LOG(DEBUG) << "Insert " << data.second.size() << " rows to index db.";
+    auto done = ++raw_pages_done_;
+    MS_LOG(INFO) << "Index progress: " << done << "/" << raw_pages_total_ << " raw pages.";
+  }
+  (void)sqlite3_finalize(stmt);
+  if (ret == SUCCESS) {
+    ret = CreateTableIndexes(db.second);
   }
   (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
   in.close();
@@ -506,45 +535,129 @@ MSRStatus ShardIndexGenerator::ExcuteTransaction(const int &shard_no, const std:
     MS_LOG(ERROR) << "Close database failed";
     return FAILED;
   }
+  if (ret != SUCCESS) {
+    return FAILED;
+  }
+  return WriteRowDirectory(shard_address, directory);
+}
+
+void ShardIndexGenerator::AddRowDirectory(
+  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data,
+  std::vector<std::array<uint64_t, kRowDirectoryFields>> &directory) {
+  static const std::map<std::string, int> kDirectoryColumns = {
+    {":ROW_ID", 0},      {":ROW_GROUP_ID", 1},    {":PAGE_OFFSET_BLOB", 2},    {":PAGE_OFFSET_BLOB_END", 3},
+    {":PAGE_ID_RAW", 4}, {":PAGE_OFFSET_RAW", 5}, {":PAGE_OFFSET_RAW_END", 6}};
+  for (const auto &row : data) {
+    std::array<uint64_t, kRowDirectoryFields> entry{};
+    for (const auto &field : row) {
+      auto it = kDirectoryColumns.find(std::get<0>(field));
+      if (it != kDirectoryColumns.end()) {
+        entry[it->second] = std::stoull(std::get<2>(field));
+      }
+    }
+    directory.push_back(entry);
+  }
+}
+
+MSRStatus ShardIndexGenerator::WriteRowDirectory(const std::string &shard_address,
+                                                 std::vector<std::array<uint64_t, kRowDirectoryFields>> &directory) {
+  std::sort(directory.begin(), directory.end(),
+            [](const std::array<uint64_t, kRowDirectoryFields> &a, const std::array<uint64_t, kRowDirectoryFields> &b) {
+              return a[0] < b[0];
+            });
+  std::ofstream out(common::SafeCStr(shard_address + kRowDirectorySuffix),
+                    std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!out.is_open()) {
+    MS_LOG(ERROR) << "Row directory could not be opened";
+    return FAILED;
+  }
+  uint64_t rows = directory.size();
+  (void)out.write(reinterpret_cast<const char *>(&kRowDirectoryMagic), kInt64Len);
+  (void)out.write(reinterpret_cast<const char *>(&rows), kInt64Len);
+  if (!directory.empty()) {
+    (void)out.write(reinterpret_cast<const char *>(directory.data()), rows * kRowDirectoryFields * kInt64Len);
+  }
+  out.close();
+  if (out.fail()) {
+    MS_LOG(ERROR) << "Row directory write failed";
+    return FAILED;
+  }
   return SUCCESS;
 }
 
+MSRStatus ShardIndexGenerator::WriteShardDatabase(int shard_no) {
+  // Create database
+  auto db = CreateDatabase(shard_no);
+  if (db.first != SUCCESS || db.second == nullptr) {
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Init index db for shard: " << shard_no << " successfully.";
+
+  // Pre-processing page information
+  auto total_pages = shard_header_.GetLastPageId(shard_no) + 1;
+
+  std::map<int, int> blob_id_to_page_id;
+  std::vector<int> raw_page_ids;
+  for (uint64_t i = 0; i < total_pages; ++i) {
+    std::shared_ptr<Page> cur_page = shard_header_.GetPage(shard_no, i).first;
+    if (cur_page->get_page_type() == "RAW_DATA") {
+      raw_page_ids.push_back(i);
+    } else if (cur_page->get_page_type() == "BLOB_DATA") {
+      blob_id_to_page_id[cur_page->get_page_type_id()] = i;
+    }
+  }
+
+  if (ExcuteTransaction(shard_no, db, raw_page_ids, blob_id_to_page_id) != SUCCESS) {
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Generate index db for shard: " << shard_no << " successfully.";
+  return SUCCESS;
+}
+
+void ShardIndexGenerator::DatabaseWriter() {
+  int shard_no = task_++;
+  while (shard_no < shard_header_.get_shard_count() && write_success_) {
+    if (WriteShardDatabase(shard_no) != SUCCESS) {
+      write_success_ = false;
+      return;
+    }
+    shard_no = task_++;
+  }
+}
+
 MSRStatus ShardIndexGenerator::WriteToDatabase() {
   fields_ = shard_header_.get_fields();
   page_size_ = shard_header_.get_page_size();
   header_size_ = shard_header_.get_header_size();
   schema_count_ = shard_header_.get_schema_count();
-  if (shard_header_.get_shard_count() <= kMaxShardCount) {
-    // Create one database per shard
-    for (int shard_no = 0; shard_no < shard_header_.get_shard_count(); ++shard_no) {
-      // Create database
-      auto db = CreateDatabase(shard_no);
-      if (db.first != SUCCESS || db.second == nullptr) {
-        return FAILED;
-      }
-      MS_LOG(INFO) << "Init index db for shard: " << shard_no << " successfully.";
-
-      // Pre-processing page information
-      auto total_pages = shard_header_.GetLastPageId(shard_no) + 1;
-
-      std::map<int, int> blob_id_to_page_id;
-      std::vector<int> raw_page_ids;
-      for (uint64_t i = 0; i < total_pages; ++i) {
-        std::shared_ptr<Page> cur_page = shard_header_.GetPage(shard_no, i).first;
-        if (cur_page->get_page_type() == "RAW_DATA") {
-          raw_page_ids.push_back(i);
-        } else if (cur_page->get_page_type() == "BLOB_DATA") {
-          blob_id_to_page_id[cur_page->get_page_type_id()] = i;
-        }
-      }
+  if (shard_header_.get_shard_count() > kMaxShardCount) {
+    return SUCCESS;
+  }
 
-      if (ExcuteTransaction(shard_no, db, raw_page_ids, blob_id_to_page_id) != SUCCESS) {
-        return FAILED;
+  int shard_count = shard_header_.get_shard_count();
+  raw_pages_total_ = 0;
+  for (int shard_no = 0; shard_no < shard_count; ++shard_no) {
+    auto total_pages = shard_header_.GetLastPageId(shard_no) + 1;
+    for (int64_t i = 0; i < total_pages; ++i) {
+      if (shard_header_.GetPage(shard_no, i).first->get_page_type() == "RAW_DATA") {
+        raw_pages_total_++;
       }
-      MS_LOG(INFO) << "Generate index db for shard: " << shard_no << " successfully.";
     }
   }
-  return SUCCESS;
+  task_ = 0;
+  write_success_ = true;
+  raw_pages_done_ = 0;
+
+  // Create one database per shard, the shards are independent of each other
+  int thread_num = std::min({static_cast<int>(GetMaxThreadNum()), kMaxThreadCount, shard_count});
+  std::vector<std::thread> threads;
+  for (int x = 0; x < thread_num; ++x) {
+    threads.emplace_back(&ShardIndexGenerator::DatabaseWriter, this);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return write_success_ ? SUCCESS : FAILED;
 }
 }  // namespace mindrecord
 }  // namespace mindspore
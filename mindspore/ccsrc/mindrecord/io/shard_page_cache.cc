@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mindrecord/include/shard_page_cache.h"
+#include <sys/stat.h>
+#include <cstdlib>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace mindrecord {
+ShardPageCache &ShardPageCache::GetInstance() {
+  static ShardPageCache *instance = []() {
+    auto cache = new ShardPageCache();
+    const char *size_mb = std::getenv(kPageCacheSizeEnv);
+    if (size_mb != nullptr) {
+      cache->capacity_ = std::strtoull(size_mb, nullptr, 10) << 20;
+      MS_LOG(INFO) << "The MindRecord page cache holds " << cache->capacity_ << " bytes.";
+    }
+    return cache;
+  }();
+  return *instance;
+}
+
+void ShardPageCache::set_capacity(uint64_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  EvictTo(capacity_);
+  if (capacity_ == 0) {
+    ghosts_.clear();
+  }
+}
+
+uint64_t ShardPageCache::get_capacity() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+bool ShardPageCache::enabled() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_ > 0;
+}
+
+CachedPage ShardPageCache::Lookup(const std::string &file_key, int64_t page_id, uint64_t access_bytes, bool *admit) {
+  *admit = false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_ == 0) {
+    return nullptr;
+  }
+  clock_ += access_bytes;
+  auto key = file_key + "#" + std::to_string(page_id);
+  auto iter = pages_.find(key);
+  if (iter != pages_.end()) {
+    lru_.splice(lru_.begin(), lru_, iter->second.lru_pos);
+    ++hits_;
+    return iter->second.page;
+  }
+  ++misses_;
+
+  // a page is admitted once it is reused within the bytes the cache holds, where an lru cache keeps it
+  auto ghost = ghosts_.find(key);
+  if (ghost != ghosts_.end() && clock_ - ghost->second <= capacity_) {
+    *admit = true;
+    (void)ghosts_.erase(ghost);
+    return nullptr;
+  }
+  ghosts_[key] = clock_;
+  if (ghosts_.size() > kMaxGhostPages) {
+    // the pages accessed longer ago than the budget are never admitted by their last access
+    for (auto it = ghosts_.begin(); it != ghosts_.end();) {
+      it = clock_ - it->second > capacity_ ? ghosts_.erase(it) : std::next(it);
+    }
+    if (ghosts_.size() > kMaxGhostPages) {
+      ghosts_.clear();
+    }
+  }
+  return nullptr;
+}
+
+void ShardPageCache::Insert(const std::string &file_key, int64_t page_id, CachedPage page) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (page == nullptr || page->size() > capacity_) {
+    return;
+  }
+  auto key = file_key + "#" + std::to_string(page_id);
+  if (pages_.find(key) != pages_.end()) {
+    return;
+  }
+  lru_.push_front(key);
+  size_ += page->size();
+  pages_[key] = Entry{std::move(page), lru_.begin()};
+  EvictTo(capacity_);
+}
+
+void ShardPageCache::EvictTo(uint64_t capacity) {
+  while (size_ > capacity && !lru_.empty()) {
+    auto iter = pages_.find(lru_.back());
+    size_ -= iter->second.page->size();
+    (void)pages_.erase(iter);
+    lru_.pop_back();
+  }
+}
+
+std::string ShardPageCache::FileKey(const std::string &file_path) {
+  struct stat file_stat;
+  if (stat(file_path.c_str(), &file_stat) != 0) {
+    return file_path;
+  }
+  return file_path + "@" + std::to_string(file_stat.st_mtime) + ":" + std::to_string(file_stat.st_size);
+}
+
+void ShardPageCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EvictTo(0);
+  ghosts_.clear();
+  clock_ = 0;
+  hits_ = 0;
+  misses_ = 0;
+}
+
+uint64_t ShardPageCache::get_hits() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+uint64_t ShardPageCache::get_misses() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
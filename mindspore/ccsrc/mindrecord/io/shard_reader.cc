@@ -15,6 +15,9 @@
  */
 
 #include "mindrecord/include/shard_reader.h"
+#include <fcntl.h>
+#include <limits>
+#include <type_traits>
 #include "common/utils.h"
 
 using mindspore::LogStream;
@@ -36,6 +39,7 @@ ShardReader::ShardReader() {
   row_id_ = 0;
   num_blocks_ = 0;
   block_reader_ = false;
+  prefetch_id_ = 0;
 }
 
 MSRStatus ShardReader::Init(const std::string &file_path) {
@@ -50,7 +54,38 @@ MSRStatus ShardReader::Init(const std::string &file_path) {
   header_size_ = shard_header_->get_header_size();
   page_size_ = shard_header_->get_page_size();
   file_paths_ = shard_header_->get_shard_addresses();
+  page_cache_keys_.clear();
+  for (const auto &file : file_paths_) {
+    page_cache_keys_.push_back(ShardPageCache::FileKey(file));
+  }
+  auto compression = shard_header_->get_compression();
+  if (compression != kCompressionNone && compression != kCompressionZlib) {
+    MS_LOG(ERROR) << "Unsupported blob compression: " << compression;
+    return FAILED;
+  }
+  compressed_ = compression != kCompressionNone;
 
+  // the index databases are only opened once they are queried when the row directories are there
+  use_directory_ = !index_required_ && HasRowDirectories();
+  if (!use_directory_ && OpenDatabases() == FAILED) {
+    return FAILED;
+  }
+
+  num_rows_ = 0;
+  auto row_group_summary = ReadRowGroupSummary();
+  for (const auto &rg : row_group_summary) {
+    num_rows_ += std::get<3>(rg);
+  }
+
+  MS_LOG(INFO) << "Get meta from mindrecord file & index file successfully.";
+
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::OpenDatabases() {
+  if (!database_paths_.empty()) {
+    return SUCCESS;
+  }
   for (const auto &file : file_paths_) {
     sqlite3 *db = nullptr;
     // sqlite3_open create a database if not found, use sqlite3_open_v2 instead of it
@@ -82,16 +117,16 @@ MSRStatus ShardReader::Init(const std::string &file_path) {
     }
     database_paths_.push_back(db);
   }
+  return SUCCESS;
+}
 
-  num_rows_ = 0;
-  auto row_group_summary = ReadRowGroupSummary();
-  for (const auto &rg : row_group_summary) {
-    num_rows_ += std::get<3>(rg);
+bool ShardReader::HasRowDirectories() const {
+  for (const auto &file : file_paths_) {
+    if (access(common::SafeCStr(file + kRowDirectorySuffix), R_OK) != 0) {
+      return false;
+    }
   }
-
-  MS_LOG(INFO) << "Get meta from mindrecord file & index file successfully.";
-
-  return SUCCESS;
+  return !file_paths_.empty();
 }
 
 MSRStatus ShardReader::CheckColumnList(const std::vector<std::string> &selected_columns) {
@@ -153,6 +188,102 @@ MSRStatus ShardReader::Open(int n_consumer) {
   return SUCCESS;
 }
 
+MSRStatus ShardReader::MapFiles() {
+  file_maps_.clear();
+  for (const auto &file : file_paths_) {
+    int fd = open(common::SafeCStr(file), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "File could not opened";
+      UnmapFiles();
+      return FAILED;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      MS_LOG(ERROR) << "File could not be sized";
+      (void)close(fd);
+      UnmapFiles();
+      return FAILED;
+    }
+    auto size = static_cast<uint64_t>(file_stat.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping holds its own reference on the file
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      MS_LOG(ERROR) << "File could not be mapped";
+      UnmapFiles();
+      return FAILED;
+    }
+    file_maps_.emplace_back(static_cast<uint8_t *>(addr), size);
+    MS_LOG(INFO) << "Map shard file successfully.";
+  }
+  return SUCCESS;
+}
+
+void ShardReader::UnmapFiles() {
+  for (auto &file_map : file_maps_) {
+    (void)munmap(file_map.first, file_map.second);
+  }
+  file_maps_.clear();
+}
+
+void ShardReader::AdviseMaps() {
+  bool sequential = true;
+  for (size_t i = 0; i < tasks_.permutation_.size(); ++i) {
+    if (tasks_.permutation_[i] != static_cast<int>(i)) {
+      sequential = false;
+      break;
+    }
+  }
+  for (auto &file_map : file_maps_) {
+    (void)madvise(file_map.first, file_map.second, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+  }
+}
+
+void ShardReader::Prefetch(int task_id) {
+  int end = std::min(task_id + 1 + prefetch_depth_, static_cast<int>(tasks_.Size()));
+  int begin = prefetch_id_;
+  // claim the range [begin, end) so that each task is hinted by one consumer only
+  while (begin < end && !prefetch_id_.compare_exchange_weak(begin, end)) {
+  }
+  for (int id = std::max(begin, task_id + 1); id < end; ++id) {
+    PrefetchTask(id);
+  }
+}
+
+void ShardReader::PrefetchRange(int shard_id, uint64_t offset, uint64_t length) {
+  if (mmap_mode_) {
+    auto &file_map = file_maps_[shard_id];
+    if (offset + length > file_map.second) {
+      return;
+    }
+    // madvise wants a page aligned start
+    auto page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    auto start = offset / page * page;
+    (void)madvise(file_map.first + start, offset + length - start, MADV_WILLNEED);
+  } else if (shard_id < static_cast<int>(hint_fds_.size()) && hint_fds_[shard_id] >= 0) {
+    (void)posix_fadvise(hint_fds_[shard_id], static_cast<off_t>(offset), static_cast<off_t>(length),
+                        POSIX_FADV_WILLNEED);
+  }
+}
+
+void ShardReader::PrefetchTask(int task_id) {
+  auto task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+  auto shard_id = std::get<0>(std::get<0>(task));
+  auto group_id = std::get<1>(std::get<0>(task));
+  auto addr = std::get<1>(task);
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  if (SUCCESS != ret.first) {
+    return;
+  }
+  auto page_offset = header_size_ + page_size_ * (ret.second->get_page_id());
+  if (block_reader_) {
+    // the whole blob page, its row group brief is only queried once the task is picked up
+    PrefetchRange(shard_id, page_offset, page_size_);
+  } else {
+    PrefetchRange(shard_id, page_offset + addr[0], addr[1] - addr[0]);
+  }
+}
+
 void ShardReader::FileStreamsOperator() {
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; --i) {
     if (file_streams_[i] != nullptr) {
@@ -171,6 +302,13 @@ void ShardReader::FileStreamsOperator() {
       (void)sqlite3_close(database_paths_[i]);
     }
   }
+  for (auto &fd : hint_fds_) {
+    if (fd >= 0) {
+      (void)close(fd);
+    }
+  }
+  hint_fds_.clear();
+  UnmapFiles();
 }
 
 ShardReader::~ShardReader() { Close(); }
@@ -305,10 +443,127 @@ MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql,
   return ConvertLabelToJson(labels, fs, offsets, shard_id, columns, column_values);
 }
 
+MSRStatus ShardReader::ReadRowDirectory(int shard_id, const std::vector<std::string> &columns,
+                                        std::vector<std::vector<std::vector<uint64_t>>> &offsets,
+                                        std::vector<std::vector<json>> &column_values) {
+  std::string file_name = file_paths_[shard_id];
+  std::ifstream dir(common::SafeCStr(file_name + kRowDirectorySuffix), std::ios::in | std::ios::binary);
+  uint64_t magic = 0;
+  uint64_t rows = 0;
+  (void)dir.read(reinterpret_cast<char *>(&magic), kInt64Len);
+  (void)dir.read(reinterpret_cast<char *>(&rows), kInt64Len);
+  if (!dir.good() || magic != kRowDirectoryMagic) {
+    MS_LOG(WARNING) << "Row directory of " << file_name << " is not readable.";
+    return FAILED;
+  }
+
+  // a directory left behind by an older index does not cover the rows of the header
+  uint64_t expected_rows = 0;
+  auto last_page_id = shard_header_->GetLastPageId(shard_id);
+  for (int64_t page_id = 0; page_id <= last_page_id; ++page_id) {
+    const auto &page = shard_header_->GetPage(shard_id, page_id).first;
+    if (page->get_page_type() == kPageTypeBlob) {
+      expected_rows += page->get_end_row_id() - page->get_start_row_id();
+    }
+  }
+  if (rows != expected_rows) {
+    MS_LOG(WARNING) << "Row directory of " << file_name << " does not match its header.";
+    return FAILED;
+  }
+  std::vector<std::array<uint64_t, kRowDirectoryFields>> directory(rows);
+  if (rows > 0) {
+    (void)dir.read(reinterpret_cast<char *>(directory.data()), rows * kRowDirectoryFields * kInt64Len);
+  }
+  if (!dir.good()) {
+    MS_LOG(WARNING) << "Row directory of " << file_name << " is truncated.";
+    return FAILED;
+  }
+  dir.close();
+
+  std::fstream fs;
+  fs.open(common::SafeCStr(file_name), std::ios::in | std::ios::binary);
+  if (fs.fail()) {
+    MS_LOG(ERROR) << "File could not opened";
+    return FAILED;
+  }
+  std::vector<uint8_t> raw;
+  uint64_t raw_begin = 0;
+  for (uint64_t i = 0; i < rows; ++i) {
+    const auto &entry = directory[i];
+    offsets[shard_id].emplace_back(std::vector<uint64_t>{static_cast<uint64_t>(shard_id), entry[1],
+                                                         entry[2] + kInt64Len, entry[3]});
+    // read the labels of the rows of a raw page at once, they are contiguous
+    if (i == 0 || entry[4] != directory[i - 1][4]) {
+      uint64_t j = i;
+      while (j + 1 < rows && directory[j + 1][4] == entry[4]) {
+        ++j;
+      }
+      raw_begin = entry[5];
+      if (directory[j][6] < raw_begin) {
+        MS_LOG(ERROR) << "Row directory of " << file_name << " is corrupted.";
+        return FAILED;
+      }
+      raw.resize(directory[j][6] - raw_begin);
+      auto &io_seekg = fs.seekg(page_size_ * entry[4] + header_size_ + raw_begin, std::ios::beg);
+      if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+        MS_LOG(ERROR) << "File seekg failed";
+        return FAILED;
+      }
+      auto &io_read = fs.read(reinterpret_cast<char *>(raw.data()), raw.size());
+      if (!io_read.good() || io_read.fail() || io_read.bad()) {
+        MS_LOG(ERROR) << "File read failed";
+        return FAILED;
+      }
+    }
+    uint64_t label_start = entry[5] + kInt64Len - raw_begin;
+    uint64_t label_end = entry[6] - raw_begin;
+    if (label_start > label_end || label_end > raw.size()) {
+      MS_LOG(ERROR) << "Row directory of " << file_name << " is corrupted.";
+      return FAILED;
+    }
+    json label_json = json::from_msgpack(std::vector<uint8_t>(raw.begin() + label_start, raw.begin() + label_end));
+    json tmp;
+    if (!columns.empty()) {
+      for (auto &col : columns) {
+        if (label_json.find(col) != label_json.end()) {
+          tmp[col] = label_json[col];
+        }
+      }
+    } else {
+      tmp = label_json;
+    }
+    column_values[shard_id].emplace_back(tmp);
+  }
+  MS_LOG(INFO) << "Get " << rows << " records from shard " << shard_id << " row directory.";
+  return SUCCESS;
+}
+
 ROW_GROUPS ShardReader::ReadAllRowGroup(std::vector<std::string> &columns) {
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
   std::vector<std::vector<std::vector<uint64_t>>> offsets(shard_count_, std::vector<std::vector<uint64_t>>{});
   std::vector<std::vector<json>> column_values(shard_count_, std::vector<json>{});
+  if (use_directory_) {
+    std::vector<MSRStatus> status(shard_count_, SUCCESS);
+    std::vector<std::thread> thread_read_dir = std::vector<std::thread>(shard_count_);
+    for (int x = 0; x < shard_count_; x++) {
+      thread_read_dir[x] = std::thread([this, x, &columns, &offsets, &column_values, &status]() {
+        status[x] = ReadRowDirectory(x, columns, offsets, column_values);
+      });
+    }
+    for (int x = 0; x < shard_count_; x++) {
+      thread_read_dir[x].join();
+    }
+    if (std::all_of(status.begin(), status.end(), [](MSRStatus ret) { return ret == SUCCESS; })) {
+      return std::make_tuple(SUCCESS, std::move(offsets), std::move(column_values));
+    }
+    // fall back to the index databases
+    use_directory_ = false;
+    offsets.assign(shard_count_, std::vector<std::vector<uint64_t>>{});
+    column_values.assign(shard_count_, std::vector<json>{});
+    if (OpenDatabases() == FAILED) {
+      return std::make_tuple(FAILED, std::move(offsets), std::move(column_values));
+    }
+  }
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
       fields += ',';
@@ -649,7 +904,8 @@ MSRStatus ShardReader::CountTotalRows(const std::string &file_path, int64_t *cou
 
 MSRStatus ShardReader::Open(const std::string &file_path, int n_consumer,
                             const std::vector<std::string> &selected_columns,
-                            const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader) {
+                            const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+                            const bool &mmap_mode) {
   // Open file and set header by ShardReader
   if (Init(file_path) == FAILED) {
     return FAILED;
@@ -685,17 +941,47 @@ MSRStatus ShardReader::Open(const std::string &file_path, int n_consumer,
 
   operators_ = operators;
 
+  // the blocks and the categories are looked up in the index databases
+  bool has_category = std::any_of(operators.begin(), operators.end(), [](const std::shared_ptr<ShardOperator> &op) {
+    return std::dynamic_pointer_cast<ShardCategory>(op) != nullptr;
+  });
+  if ((block_reader || has_category) && OpenDatabases() == FAILED) {
+    return FAILED;
+  }
+
+  // Fall back to the file streams when the files can not be mapped, e.g. on a file system without mmap support
+  mmap_mode_ = mmap_mode && MapFiles() == SUCCESS;
+  if (mmap_mode && !mmap_mode_) {
+    MS_LOG(WARNING) << "Shard files could not be mapped, read them by file streams instead.";
+  }
+  if (!mmap_mode_) {
+    // the streams hide their descriptors, read ahead hints go through a handle of their own
+    for (const auto &file : file_paths_) {
+      hint_fds_.push_back(open(common::SafeCStr(file), O_RDONLY));
+    }
+  }
+  if (prefetch_depth_ <= 0) {
+    prefetch_depth_ = kNumPageInBuffer;
+  }
+
   if (block_reader) {
     block_reader_ = true;
-    if (Open() == FAILED) {
+    if (!mmap_mode_ && Open() == FAILED) {
       return FAILED;
     }
     delivery_block_ = std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>>(
-      kNumPageInBuffer, std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>{});
-    buf_ = std::vector<std::vector<uint8_t>>(kNumPageInBuffer, std::vector<uint8_t>(page_size_));
+      prefetch_depth_, std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>{});
+    if (mmap_mode_) {
+      blob_pages_ = std::vector<const uint8_t *>(prefetch_depth_, nullptr);
+    } else {
+      buf_ = std::vector<std::vector<uint8_t>>(prefetch_depth_, std::vector<uint8_t>(page_size_));
+    }
+    if (compressed_) {
+      block_blobs_ = std::vector<std::vector<std::vector<uint8_t>>>(prefetch_depth_);
+    }
   } else {
     block_reader_ = false;
-    if (Open(n_consumer) == FAILED) {
+    if (!mmap_mode_ && Open(n_consumer) == FAILED) {
       return FAILED;
     }
   }
@@ -722,6 +1008,12 @@ MSRStatus ShardReader::OpenPy(const std::string &file_path, const int &n_consume
     MS_LOG(ERROR) << "Illegal column list";
     return FAILED;
   }
+  bool has_category = std::any_of(operators.begin(), operators.end(), [](const std::shared_ptr<ShardOperator> &op) {
+    return std::dynamic_pointer_cast<ShardCategory>(op) != nullptr;
+  });
+  if (has_category && OpenDatabases() == FAILED) {
+    return FAILED;
+  }
   if (Open(n_consumer) == FAILED) {
     return FAILED;
   }
@@ -744,6 +1036,9 @@ MSRStatus ShardReader::Launch(bool isSimpleReader) {
   // Sort row group by (group_id, shard_id), prepare for parallel reading
   std::sort(row_group_summary.begin(), row_group_summary.end(), ResortRowGroups);
   CreateTasks(row_group_summary, operators_);
+  if (mmap_mode_) {
+    AdviseMaps();
+  }
   MS_LOG(INFO) << "Launching read threads";
 
   if (isSimpleReader) return SUCCESS;
@@ -898,30 +1193,9 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   // Pick up task from task list
   auto task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
 
-  auto shard_id = std::get<0>(std::get<0>(task));
-  auto group_id = std::get<1>(std::get<0>(task));
-  auto addr = std::get<1>(task);
-  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
-  if (SUCCESS != ret.first) {
-    return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
-  }
-  const std::shared_ptr<Page> &page = ret.second;
   // Pack image list
-  std::vector<uint8_t> images(addr[1] - addr[0]);
-  auto file_offset = header_size_ + page_size_ * (page->get_page_id()) + addr[0];
-
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
-  }
-
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
+  std::vector<uint8_t> images;
+  if (ReadTaskBlob(task_id, consumer_id, images) != SUCCESS) {
     return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
 
@@ -951,6 +1225,82 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   return std::make_pair(SUCCESS, std::move(batch));
 }
 
+MSRStatus ShardReader::ReadTaskBlob(int task_id, uint32_t consumer_id, std::vector<uint8_t> &blob) {
+  const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+  auto shard_id = std::get<0>(std::get<0>(task));
+  auto group_id = std::get<1>(std::get<0>(task));
+  const auto &addr = std::get<1>(task);
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  if (SUCCESS != ret.first) {
+    return FAILED;
+  }
+  const std::shared_ptr<Page> &page = ret.second;
+  Prefetch(task_id);
+  auto length = addr[1] - addr[0];
+  auto file_offset = header_size_ + page_size_ * (page->get_page_id()) + addr[0];
+
+  std::vector<uint8_t> raw;
+  const uint8_t *src = nullptr;
+  // the mappings are shared through the page cache of the system already
+  CachedPage cached_page;
+  if (!mmap_mode_ && ReadCachedPage(file_streams_random_[consumer_id][shard_id], shard_id, page->get_page_id(),
+                                    page->get_page_size(), length, &cached_page) == FAILED) {
+    return FAILED;
+  }
+  if (cached_page != nullptr) {
+    if (addr[1] > cached_page->size()) {
+      MS_LOG(ERROR) << "Blob is out of the cached page " << page->get_page_id() << " of shard " << shard_id;
+      return FAILED;
+    }
+    src = cached_page->data() + addr[0];
+  } else if (mmap_mode_) {
+    auto &file_map = file_maps_[shard_id];
+    if (file_offset + length > file_map.second) {
+      MS_LOG(ERROR) << "File read failed";
+      return FAILED;
+    }
+    // decompressed or copied straight out of the mapping
+    src = file_map.first + file_offset;
+  } else {
+    // read to the end of the blob, unless it is decompressed from elsewhere
+    auto &dst = compressed_ ? raw : blob;
+    auto start = dst.size();
+    dst.resize(start + length);
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return FAILED;
+    }
+
+    auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(dst.data() + start),
+                                                                       length);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return FAILED;
+    }
+    if (!compressed_) {
+      return SUCCESS;
+    }
+    src = raw.data();
+  }
+
+  if (!compressed_) {
+    blob.insert(blob.end(), src, src + length);
+    return SUCCESS;
+  }
+  if (blob.empty()) {
+    return DecompressBlob(src, length, blob);
+  }
+  std::vector<uint8_t> decompressed;
+  if (DecompressBlob(src, length, decompressed) == FAILED) {
+    return FAILED;
+  }
+  blob.insert(blob.end(), decompressed.begin(), decompressed.end());
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
   // Set thread name
   auto thread_id = kThreadName + std::to_string(consumer_id);
@@ -988,6 +1338,25 @@ MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
 
 MSRStatus ShardReader::ReadBlob(const int &shard_id, const uint64_t &page_offset, const int &page_length,
                                 const int &buf_id) {
+  if (mmap_mode_) {
+    if (page_offset + page_length > file_maps_[shard_id].second) {
+      MS_LOG(ERROR) << "File read failed";
+      return FAILED;
+    }
+    blob_pages_[buf_id] = file_maps_[shard_id].first + page_offset;
+    return SUCCESS;
+  }
+
+  CachedPage cached_page;
+  auto page_id = static_cast<int64_t>((page_offset - header_size_) / page_size_);
+  if (ReadCachedPage(file_streams_[shard_id], shard_id, page_id, page_length, page_length, &cached_page) == FAILED) {
+    return FAILED;
+  }
+  if (cached_page != nullptr && cached_page->size() >= static_cast<uint64_t>(page_length)) {
+    (void)std::copy(cached_page->begin(), cached_page->begin() + page_length, buf_[buf_id].begin());
+    return SUCCESS;
+  }
+
   auto &io_seekg = file_streams_[shard_id]->seekg(page_offset, std::ios::beg);
   if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
     MS_LOG(ERROR) << "File seekg failed";
@@ -1004,6 +1373,46 @@ MSRStatus ShardReader::ReadBlob(const int &shard_id, const uint64_t &page_offset
   return SUCCESS;
 }
 
+MSRStatus ShardReader::ReadCachedPage(const std::shared_ptr<std::fstream> &fs, int shard_id, int64_t page_id,
+                                      uint64_t page_length, uint64_t access_bytes, CachedPage *page) {
+  *page = nullptr;
+  auto &cache = ShardPageCache::GetInstance();
+  bool admit = false;
+  *page = cache.Lookup(page_cache_keys_[shard_id], page_id, access_bytes, &admit);
+  if (!admit) {
+    return SUCCESS;
+  }
+
+  auto data = std::make_shared<std::vector<uint8_t>>(page_length);
+  auto &io_seekg = fs->seekg(header_size_ + page_size_ * page_id, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    MS_LOG(ERROR) << "File seekg failed";
+    fs->close();
+    return FAILED;
+  }
+  auto &io_read = fs->read(reinterpret_cast<char *>(data->data()), page_length);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    MS_LOG(ERROR) << "File read failed";
+    fs->close();
+    return FAILED;
+  }
+  *page = data;
+  cache.Insert(page_cache_keys_[shard_id], page_id, *page);
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::DecompressPage(const int &buf_id) {
+  const uint8_t *blob_page = mmap_mode_ ? blob_pages_[buf_id] : buf_[buf_id].data();
+  auto &offsets = (*delivery_block_[buf_id]).first;
+  block_blobs_[buf_id] = std::vector<std::vector<uint8_t>>(offsets.size());
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    if (DecompressBlob(blob_page + offsets[i][0], offsets[i][1] - offsets[i][0], block_blobs_[buf_id][i]) == FAILED) {
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
   // Set thread name
   auto thread_id = kThreadName + std::to_string(consumer_id);
@@ -1026,6 +1435,9 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
       continue;
     }
 
+    // Keep the pages of the next tasks in flight while this one waits for a free buffer
+    Prefetch(task_id);
+
     // Pick up task from task list
     auto task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
 
@@ -1048,13 +1460,13 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
     // Hanging if maximum map size exceeded otherwise, set batch data in buffer
     {
       std::unique_lock<std::mutex> lck(mtx_delivery_);
-      cv_delivery_.wait(lck, [task_id, this] { return interrupt_ || task_id < deliver_id_ + kNumPageInBuffer; });
+      cv_delivery_.wait(lck, [task_id, this] { return interrupt_ || task_id < deliver_id_ + prefetch_depth_; });
       if (interrupt_) {
         return SUCCESS;
       }
     }
 
-    auto buf_id = task_id % kNumPageInBuffer;
+    auto buf_id = task_id % prefetch_depth_;
     delivery_block_[buf_id] =
       std::make_shared<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>(offset_and_labels);
 
@@ -1063,6 +1475,11 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
       return FAILED;
     }
 
+    // Decompress the blobs of the page here, in parallel with the other consumers
+    if (compressed_ && DecompressPage(buf_id) != SUCCESS) {
+      return FAILED;
+    }
+
     {
       std::unique_lock<std::mutex> lck(mtx_delivery_);
       delivery_block_set_.insert(task_id);
@@ -1073,12 +1490,17 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
 
 std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardReader::GetRowFromBuffer(int buf_id,
                                                                                                    int rowId) {
-  auto &blob_page = buf_[buf_id];
+  const uint8_t *blob_page = mmap_mode_ ? blob_pages_[buf_id] : buf_[buf_id].data();
   auto &offsets = (*delivery_block_[buf_id]).first;
   auto &labels = (*delivery_block_[buf_id]).second;
   auto &addr_start = offsets[rowId][0];
   auto &addr_end = offsets[rowId][1];
-  std::vector<uint8_t> images(blob_page.begin() + addr_start, blob_page.begin() + addr_end);
+  std::vector<uint8_t> images;
+  if (compressed_) {
+    images = std::move(block_blobs_[buf_id][rowId]);
+  } else {
+    images.assign(blob_page + addr_start, blob_page + addr_end);
+  }
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
   batch.emplace_back(std::move(images), std::move(labels[rowId]));
   return std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
@@ -1097,7 +1519,7 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetBlockNext()
       return std::vector<std::tuple<std::vector<uint8_t>, json>>();
     }
   }
-  auto buf_id = deliver_id_ % kNumPageInBuffer;
+  auto buf_id = deliver_id_ % prefetch_depth_;
   auto res = GetRowFromBuffer(buf_id, row_id_);
 
   row_id_++;
@@ -1150,6 +1572,147 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetNextById(con
   return std::move(ret.second);
 }
 
+namespace {
+template <typename T>
+bool AppendLabelNumber(const json &value, std::vector<uint8_t> *data) {
+  if (!value.is_number()) {
+    return false;
+  }
+  T number = 0;
+  if (std::is_integral<T>::value) {
+    if (!value.is_number_integer()) {
+      return false;
+    }
+    auto integer = value.get<int64_t>();
+    if (integer < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+        integer > static_cast<int64_t>(std::numeric_limits<T>::max())) {
+      return false;
+    }
+    number = static_cast<T>(integer);
+  } else {
+    number = value.get<T>();
+  }
+  auto bytes = reinterpret_cast<const uint8_t *>(&number);
+  data->insert(data->end(), bytes, bytes + sizeof(T));
+  return true;
+}
+
+template <typename T>
+bool AppendLabelNumbers(const json &value, bool is_array, std::vector<uint8_t> *data) {
+  if (!is_array) {
+    return AppendLabelNumber<T>(value, data);
+  }
+  if (!value.is_array()) {
+    return false;
+  }
+  for (const auto &element : value) {
+    if (!AppendLabelNumber<T>(element, data)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool AppendLabelValue(const json &value, ShardColumnValues *column) {
+  if (column->type == "int32") {
+    return AppendLabelNumbers<int32_t>(value, column->is_array, &column->data);
+  } else if (column->type == "int64") {
+    return AppendLabelNumbers<int64_t>(value, column->is_array, &column->data);
+  } else if (column->type == "float32") {
+    return AppendLabelNumbers<float>(value, column->is_array, &column->data);
+  } else if (column->type == "float64") {
+    return AppendLabelNumbers<double>(value, column->is_array, &column->data);
+  } else if (column->type == "string" && !column->is_array && value.is_string()) {
+    const auto &str = value.get_ref<const std::string &>();
+    column->data.insert(column->data.end(), str.begin(), str.end());
+    return true;
+  }
+  return false;
+}
+}  // namespace
+
+MSRStatus ShardReader::BuildLabelColumns() {
+  auto schemas = shard_header_->get_schemas();
+  if (nlp_ || block_reader_ || schemas.empty()) {
+    return FAILED;
+  }
+  json schema = schemas[0]->GetSchema()["schema"];
+  auto blob_fields = get_blob_fields().second;
+  std::vector<std::string> names = selected_columns_;
+  if (names.empty()) {
+    for (auto it = schema.begin(); it != schema.end(); ++it) {
+      if (std::find(blob_fields.begin(), blob_fields.end(), it.key()) == blob_fields.end()) {
+        names.push_back(it.key());
+      }
+    }
+  }
+  std::vector<ShardColumnValues> columns(names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    auto field = schema.find(names[i]);
+    if (field == schema.end() || field->find("type") == field->end()) {
+      return FAILED;
+    }
+    auto &column = columns[i];
+    column.name = names[i];
+    column.type = (*field)["type"].get<std::string>();
+    column.is_array = field->find("shape") != field->end();
+    column.offsets.reserve(tasks_.Size() + 1);
+    column.offsets.push_back(0);
+    for (size_t task_id = 0; task_id < tasks_.Size(); ++task_id) {
+      const auto &label = std::get<2>(tasks_.get_task_by_id(task_id));
+      auto value = label.find(column.name);
+      if (value == label.end() || !AppendLabelValue(*value, &column)) {
+        MS_LOG(INFO) << "Column " << column.name << " can not be read as a column of " << column.type << ".";
+        return FAILED;
+      }
+      column.offsets.push_back(column.data.size());
+    }
+  }
+  label_columns_ = std::move(columns);
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::GetColumnarBatch(const int64_t &task_id, const int32_t &num_rows, const int32_t &consumer_id,
+                                        ShardColumnarBatch *batch) {
+  if (batch == nullptr || interrupt_) {
+    return FAILED;
+  }
+  std::call_once(label_columns_once_, [this]() { label_columns_status_ = BuildLabelColumns(); });
+  if (label_columns_status_ != SUCCESS) {
+    return FAILED;
+  }
+  auto end_id = std::min(task_id + num_rows, static_cast<int64_t>(tasks_.Size()));
+  batch->num_rows = end_id > task_id ? static_cast<uint32_t>(end_id - task_id) : 0;
+  batch->blob_data.clear();
+  batch->blob_offsets.assign(1, 0);
+  batch->blob_offsets.reserve(batch->num_rows + 1);
+  batch->columns.resize(label_columns_.size());
+  for (size_t i = 0; i < label_columns_.size(); ++i) {
+    auto &column = batch->columns[i];
+    column.name = label_columns_[i].name;
+    column.type = label_columns_[i].type;
+    column.is_array = label_columns_[i].is_array;
+    column.data.clear();
+    column.offsets.assign(1, 0);
+    column.offsets.reserve(batch->num_rows + 1);
+  }
+  for (auto id = task_id; id < end_id; ++id) {
+    if (ReadTaskBlob(static_cast<int>(id), static_cast<uint32_t>(consumer_id), batch->blob_data) != SUCCESS) {
+      return FAILED;
+    }
+    batch->blob_offsets.push_back(batch->blob_data.size());
+    auto row = tasks_.permutation_[id];
+    for (size_t i = 0; i < label_columns_.size(); ++i) {
+      const auto &values = label_columns_[i];
+      auto &column = batch->columns[i];
+      column.data.insert(column.data.end(), values.data.begin() + values.offsets[row],
+                         values.data.begin() + values.offsets[row + 1]);
+      column.offsets.push_back(column.data.size());
+    }
+  }
+  return SUCCESS;
+}
+
 std::vector<std::tuple<std::vector<uint8_t>, pybind11::object>> ShardReader::GetNextPy() {
   auto res = GetNext();
   vector<std::tuple<std::vector<uint8_t>, pybind11::object>> jsonData;
@@ -1167,11 +1730,13 @@ void ShardReader::Reset() {
     std::lock_guard<std::mutex> lck(mtx_delivery_);
     task_id_ = 0;
     deliver_id_ = 0;
+    prefetch_id_ = 0;
   }
   cv_delivery_.notify_all();
 }
 
 void ShardReader::ShuffleTask() {
+  prefetch_id_ = 0;
   for (const auto &op : operators_) {
     if (block_reader_ || !std::dynamic_pointer_cast<ShardShuffle>(op)) continue;
     if (SUCCESS != (*op)(tasks_)) {
@@ -28,7 +28,11 @@ using mindspore::MsLogLevel::INFO;
 
 namespace mindspore {
 namespace mindrecord {
-ShardSegment::ShardSegment() { set_all_in_index(false); }
+ShardSegment::ShardSegment() {
+  set_all_in_index(false);
+  // the categories are queried from the index databases
+  index_required_ = true;
+}
 
 std::pair<MSRStatus, vector<std::string>> ShardSegment::GetCategoryFields() {
   // Skip if already populated
@@ -226,6 +230,13 @@ std::pair<MSRStatus, std::vector<uint8_t>> ShardSegment::PackImages(int group_id
     return {FAILED, {}};
   }
 
+  if (compressed_) {
+    std::vector<uint8_t> blob;
+    if (DecompressBlob(images.data(), images.size(), blob) == FAILED) {
+      return {FAILED, {}};
+    }
+    return {SUCCESS, std::move(blob)};
+  }
   return {SUCCESS, std::move(images)};
 }
 
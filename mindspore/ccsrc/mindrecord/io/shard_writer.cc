@@ -35,6 +35,7 @@ ShardWriter::ShardWriter()
       schema_count_(1) {}
 
 ShardWriter::~ShardWriter() {
+  (void)StopFlush();
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
     file_streams_[i]->close();
   }
@@ -89,6 +90,8 @@ MSRStatus ShardWriter::Open(const std::vector<std::string> &paths, bool append)
         return FAILED;
       }
     }
+    // the row directory is rebuilt along with the index, a stale one would hide the new rows from the readers
+    (void)remove(common::SafeCStr(file + kRowDirectorySuffix));
     MS_LOG(INFO) << "Open shard file successfully.";
     file_streams_.push_back(fs);
   }
@@ -113,6 +116,11 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
   if (ret == FAILED) {
     return FAILED;
   }
+  // appended rows are compressed the same way as the existing ones
+  ret = set_compression(shard_header_->get_compression());
+  if (ret == FAILED) {
+    return FAILED;
+  }
   ret = Open(paths, true);
   if (ret == FAILED) {
     MS_LOG(ERROR) << "Open file failed";
@@ -122,6 +130,11 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
 }
 
 MSRStatus ShardWriter::Commit() {
+  // the pages of the queued rows go into the header
+  if (StopFlush() == FAILED) {
+    MS_LOG(ERROR) << "Write raw data failed";
+    return FAILED;
+  }
   if (WriteShardHeader() == FAILED) {
     MS_LOG(ERROR) << "Write metadata failed";
     return FAILED;
@@ -130,6 +143,15 @@ MSRStatus ShardWriter::Commit() {
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::set_flush_budget(const uint64_t &flush_budget) {
+  if (flush_thread_.joinable()) {
+    MS_LOG(ERROR) << "Flush budget should be set before the first write";
+    return FAILED;
+  }
+  flush_budget_ = flush_budget;
+  return SUCCESS;
+}
+
 MSRStatus ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data) {
   MSRStatus ret = header_data->InitByFiles(file_paths_);
   if (ret == FAILED) {
@@ -166,6 +188,7 @@ MSRStatus ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data)
   shard_header_ = header_data;
   shard_header_->set_header_size(header_size_);
   shard_header_->set_page_size(page_size_);
+  shard_header_->set_compression(compression_);
   return SUCCESS;
 }
 
@@ -198,6 +221,16 @@ MSRStatus ShardWriter::set_page_size(const uint64_t &page_size) {
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::set_compression(const std::string &compression) {
+  if (compression != kCompressionNone && compression != kCompressionZlib) {
+    MS_LOG(ERROR) << "Compression should be " << kCompressionNone << " or " << kCompressionZlib << ".";
+    return FAILED;
+  }
+
+  compression_ = compression;
+  return SUCCESS;
+}
+
 void ShardWriter::DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data,
                                   std::vector<std::vector<uint8_t>> &blob_data) {
   // get wrong data location
@@ -436,6 +469,11 @@ void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>>
 
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data,
                                     std::vector<std::vector<uint8_t>> &blob_data, bool sign) {
+  if (flush_failed_) {
+    MS_LOG(ERROR) << "Write previous raw data failed";
+    return FAILED;
+  }
+
   // check the free disk size
   auto st_space = GetDiskSize(file_paths_[0], kFreeSize);
   if (st_space.first != SUCCESS || st_space.second < kMinFreeDiskSize) {
@@ -477,27 +515,116 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
   }
 
   // Set row size of raw data
-  if (SetRawDataSize(bin_raw_data) == FAILED) {
+  std::vector<uint64_t> raw_data_size;
+  if (SetRawDataSize(bin_raw_data, raw_data_size) == FAILED) {
     MS_LOG(ERROR) << "Set raw data size failed";
     return FAILED;
   }
 
+  // Compress blob data, the pages and the index only see the compressed sizes
+  if (compression_ != kCompressionNone && CompressBlobData(blob_data) == FAILED) {
+    MS_LOG(ERROR) << "Compress blob data failed";
+    return FAILED;
+  }
+
   // Set row size of blob data
-  if (SetBlobDataSize(blob_data) == FAILED) {
+  std::vector<uint64_t> blob_data_size;
+  if (SetBlobDataSize(blob_data, blob_data_size) == FAILED) {
     MS_LOG(ERROR) << "Set blob data size failed";
     return FAILED;
   }
 
-  // Write data to disk with multi threads
-  if (ParallelWriteData(blob_data, bin_raw_data) == FAILED) {
+  if (flush_budget_ == 0) {
+    // Write data to disk with multi threads
+    raw_data_size_ = std::move(raw_data_size);
+    blob_data_size_ = std::move(blob_data_size);
+    if (ParallelWriteData(blob_data, bin_raw_data) == FAILED) {
+      MS_LOG(ERROR) << "Parallel write data failed";
+      return FAILED;
+    }
+    MS_LOG(INFO) << "Write " << bin_raw_data.size() << " records successfully.";
+    return SUCCESS;
+  }
+
+  // Write data to disk in the background while the caller serializes the next rows
+  auto batch = std::make_shared<RowBatch>();
+  batch->bytes = std::accumulate(raw_data_size.begin(), raw_data_size.end(), uint64_t(0)) +
+                 std::accumulate(blob_data_size.begin(), blob_data_size.end(), uint64_t(0));
+  batch->blob_data = std::move(blob_data);
+  batch->bin_raw_data = std::move(bin_raw_data);
+  batch->raw_data_size = std::move(raw_data_size);
+  batch->blob_data_size = std::move(blob_data_size);
+  return QueueBatch(batch);
+}
+
+MSRStatus ShardWriter::FlushBatch(RowBatch &batch) {
+  raw_data_size_ = std::move(batch.raw_data_size);
+  blob_data_size_ = std::move(batch.blob_data_size);
+  if (ParallelWriteData(batch.blob_data, batch.bin_raw_data) == FAILED) {
     MS_LOG(ERROR) << "Parallel write data failed";
     return FAILED;
   }
-  MS_LOG(INFO) << "Write " << bin_raw_data.size() << " records successfully.";
+  MS_LOG(INFO) << "Write " << batch.bin_raw_data.size() << " records successfully.";
+  return SUCCESS;
+}
 
+MSRStatus ShardWriter::QueueBatch(std::shared_ptr<RowBatch> batch) {
+  std::unique_lock<std::mutex> lck(flush_mutex_);
+  if (!flush_thread_.joinable()) {
+    flush_stop_ = false;
+    flush_thread_ = std::thread(&ShardWriter::FlushWorker, this);
+  }
+  // a batch over the budget on its own is taken once the queue is drained
+  cv_flush_.wait(lck, [this, &batch] {
+    return flush_failed_ || flush_queue_.empty() || flush_bytes_ + batch->bytes <= flush_budget_;
+  });
+  if (flush_failed_) {
+    MS_LOG(ERROR) << "Write previous raw data failed";
+    return FAILED;
+  }
+  flush_bytes_ += batch->bytes;
+  flush_queue_.push_back(batch);
+  lck.unlock();
+  cv_flush_.notify_all();
   return SUCCESS;
 }
 
+void ShardWriter::FlushWorker() {
+  while (true) {
+    std::shared_ptr<RowBatch> batch;
+    {
+      std::unique_lock<std::mutex> lck(flush_mutex_);
+      cv_flush_.wait(lck, [this] { return flush_stop_ || !flush_queue_.empty(); });
+      if (flush_queue_.empty()) {
+        return;
+      }
+      // the batch stays in the queue and in the budget while it is written
+      batch = flush_queue_.front();
+    }
+    if (!flush_failed_ && FlushBatch(*batch) == FAILED) {
+      flush_failed_ = true;
+    }
+    {
+      std::lock_guard<std::mutex> lck(flush_mutex_);
+      flush_queue_.pop_front();
+      flush_bytes_ -= batch->bytes;
+    }
+    cv_flush_.notify_all();
+  }
+}
+
+MSRStatus ShardWriter::StopFlush() {
+  if (flush_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lck(flush_mutex_);
+      flush_stop_ = true;
+    }
+    cv_flush_.notify_all();
+    flush_thread_.join();
+  }
+  return flush_failed_ ? FAILED : SUCCESS;
+}
+
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>> &raw_data,
                                     std::map<uint64_t, std::vector<py::handle>> &blob_data, bool sign) {
   std::map<uint64_t, std::vector<json>> raw_data_json;
@@ -550,6 +677,85 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>>
   return WriteRawData(raw_data_json, blob_data, sign);
 }
 
+namespace {
+// read the files of the rows [start, end) to blobs, each worker reading every num_workers-th file
+MSRStatus ReadBlobFiles(const std::vector<std::string> &file_names, size_t start, size_t end, int num_workers,
+                        std::vector<std::vector<uint8_t>> *blobs) {
+  blobs->assign(end - start, std::vector<uint8_t>());
+  std::atomic<bool> failed(false);
+  std::vector<std::thread> workers;
+  for (int worker = 0; worker < num_workers; ++worker) {
+    workers.emplace_back([&, worker]() {
+      for (size_t i = start + worker; i < end && !failed; i += num_workers) {
+        std::ifstream in(common::SafeCStr(file_names[i]), std::ios::in | std::ios::binary | std::ios::ate);
+        if (!in.is_open()) {
+          MS_LOG(ERROR) << "Failed to open file " << file_names[i];
+          failed = true;
+          return;
+        }
+        auto &blob = (*blobs)[i - start];
+        blob.resize(static_cast<size_t>(in.tellg()));
+        (void)in.seekg(0, std::ios::beg);
+        (void)in.read(reinterpret_cast<char *>(blob.data()), blob.size());
+        if (!in.good()) {
+          MS_LOG(ERROR) << "Failed to read file " << file_names[i];
+          failed = true;
+          return;
+        }
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return failed ? FAILED : SUCCESS;
+}
+}  // namespace
+
+MSRStatus ShardWriter::WriteRawDataFromFiles(std::vector<json> &raw_data, const std::vector<std::string> &file_names,
+                                             int num_workers, bool sign) {
+  if (raw_data.size() != file_names.size()) {
+    MS_LOG(ERROR) << "The number of rows " << raw_data.size() << " is not the number of files " << file_names.size();
+    return FAILED;
+  }
+  num_workers = std::max(1, std::min(num_workers, kMaxThreadCount));
+  const size_t row_count = raw_data.size();
+  std::vector<std::vector<uint8_t>> blobs;
+  size_t start = 0;
+  size_t end = std::min(kFileBatchRows, row_count);
+  if (ReadBlobFiles(file_names, start, end, num_workers, &blobs) == FAILED) {
+    return FAILED;
+  }
+  while (start < row_count) {
+    // the files of the next rows are read while these are written
+    size_t next_end = std::min(end + kFileBatchRows, row_count);
+    std::vector<std::vector<uint8_t>> next_blobs;
+    auto next_read = std::async(std::launch::async, ReadBlobFiles, std::cref(file_names), end, next_end, num_workers,
+                                &next_blobs);
+    std::map<uint64_t, std::vector<json>> rows;
+    rows[0] = std::vector<json>(std::make_move_iterator(raw_data.begin() + start),
+                                std::make_move_iterator(raw_data.begin() + end));
+    auto ret = WriteRawData(rows, blobs, sign);
+    if (next_read.get() == FAILED || ret == FAILED) {
+      return FAILED;
+    }
+    blobs = std::move(next_blobs);
+    start = end;
+    end = next_end;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::WriteRawDataFromFiles(std::vector<py::handle> &raw_data,
+                                             const std::vector<std::string> &file_names, int num_workers, bool sign) {
+  std::vector<json> raw_data_json;
+  raw_data_json.reserve(raw_data.size());
+  (void)std::transform(raw_data.begin(), raw_data.end(), std::back_inserter(raw_data_json),
+                       [](const py::handle &obj) { return nlohmann::detail::ToJsonImpl(obj); });
+  py::gil_scoped_release release;
+  return WriteRawDataFromFiles(raw_data_json, file_names, num_workers, sign);
+}
+
 MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
                                          const std::vector<std::vector<uint8_t>> &bin_raw_data) {
   auto shards = BreakIntoShards();
@@ -914,8 +1120,10 @@ MSRStatus ShardWriter::FlushRawChunk(const std::shared_ptr<std::fstream> &out,
 // Allocate data to shards evenly
 std::vector<std::pair<int, int>> ShardWriter::BreakIntoShards() {
   std::vector<std::pair<int, int>> shards;
-  int row_in_shard = row_count_ / shard_count_;
-  int remains = row_count_ % shard_count_;
+  // the rows of the batch being written, row_count_ may already be the one of the next batch
+  int row_count = static_cast<int>(raw_data_size_.size());
+  int row_in_shard = row_count / shard_count_;
+  int remains = row_count % shard_count_;
 
   std::vector<int> v_list(shard_count_);
   std::iota(v_list.begin(), v_list.end(), 0);
@@ -1008,31 +1216,63 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
   return flag_ == true ? FAILED : SUCCESS;
 }
 
-MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  raw_data_size_ = std::vector<uint64_t>(row_count_, 0);
+MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data,
+                                      std::vector<uint64_t> &raw_data_size) {
+  raw_data_size = std::vector<uint64_t>(row_count_, 0);
   for (uint32_t i = 0; i < row_count_; ++i) {
-    raw_data_size_[i] = std::accumulate(
+    raw_data_size[i] = std::accumulate(
       bin_raw_data.begin() + (i * schema_count_), bin_raw_data.begin() + (i * schema_count_) + schema_count_, 0,
       [](uint64_t accumulator, const std::vector<uint8_t> &row) { return accumulator + kInt64Len + row.size(); });
   }
-  if (*std::max_element(raw_data_size_.begin(), raw_data_size_.end()) > page_size_) {
+  if (*std::max_element(raw_data_size.begin(), raw_data_size.end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
   }
   return SUCCESS;
 }
 
-MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data) {
-  blob_data_size_ = std::vector<uint64_t>(row_count_);
-  (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size_.begin(),
+MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data,
+                                       std::vector<uint64_t> &blob_data_size) {
+  blob_data_size = std::vector<uint64_t>(row_count_);
+  (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size.begin(),
                        [](const std::vector<uint8_t> &row) { return kInt64Len + row.size(); });
-  if (*std::max_element(blob_data_size_.begin(), blob_data_size_.end()) > page_size_) {
+  if (*std::max_element(blob_data_size.begin(), blob_data_size.end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
   }
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::CompressBlobData(std::vector<std::vector<uint8_t>> &blob_data) {
+  int row_count = static_cast<int>(blob_data.size());
+  uint32_t thread_num = std::min(GetMaxThreadNum(), static_cast<uint32_t>(kMaxThreadCount));
+  int group_num = ceil(row_count * 1.0 / thread_num);
+  std::vector<std::thread> thread_set;
+  for (uint32_t x = 0; x < thread_num; ++x) {
+    int start_num = x * group_num;
+    int end_num = ((x + 1) * group_num > row_count) ? row_count : (x + 1) * group_num;
+    if (start_num >= end_num) {
+      continue;
+    }
+    thread_set.emplace_back(&ShardWriter::CompressBlobRange, this, start_num, end_num, std::ref(blob_data));
+  }
+  for (auto &thread : thread_set) {
+    thread.join();
+  }
+  return flag_ == true ? FAILED : SUCCESS;
+}
+
+void ShardWriter::CompressBlobRange(int start, int end, std::vector<std::vector<uint8_t>> &blob_data) {
+  for (int i = start; i < end; ++i) {
+    std::vector<uint8_t> compressed;
+    if (CompressBlob(blob_data[i], compressed) == FAILED) {
+      flag_ = true;
+      return;
+    }
+    blob_data[i] = std::move(compressed);
+  }
+}
+
 void ShardWriter::SetLastRawPage(const int &shard_id, std::shared_ptr<Page> &last_raw_page) {
   // Get last raw page
   auto last_raw_page_id = shard_header_->GetLastPageIdByType(shard_id, kPageTypeRaw);
@@ -53,6 +53,10 @@ MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers) {
       ParseShardAddress(header["shard_addresses"]);
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
+      // files written before the blob compression have no such field
+      if (header.find("compression") != header.end()) {
+        compression_ = header["compression"].get<std::string>();
+      }
     }
     ParsePage(header["page"]);
   }
@@ -324,8 +328,12 @@ std::vector<std::string> ShardHeader::SerializeHeader() {
   }
   if (shard_count_ <= kMaxShardCount) {
     for (int shardId = 0; shardId < shard_count_; shardId++) {
-      string s;
-      s += "{\"header_size\":" + std::to_string(header_size_) + ",";
+      string s = "{";
+      // left out of plain files, which older readers can still open
+      if (compression_ != kCompressionNone) {
+        s += "\"compression\":\"" + compression_ + "\",";
+      }
+      s += "\"header_size\":" + std::to_string(header_size_) + ",";
       s += "\"index_fields\":" + index + ",";
       s += "\"page\":" + pages[shardId] + ",";
       s += "\"page_size\":" + std::to_string(page_size_) + ",";
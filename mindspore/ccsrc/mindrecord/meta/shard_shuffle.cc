@@ -17,15 +17,49 @@
 #include "mindrecord/include/shard_shuffle.h"
 
 #include <algorithm>
+#include <map>
+#include <tuple>
 
 namespace mindspore {
 namespace mindrecord {
-ShardShuffle::ShardShuffle(uint32_t seed) : shuffle_seed_(seed) {}
+ShardShuffle::ShardShuffle(uint32_t seed, uint32_t block_window) : shuffle_seed_(seed), block_window_(block_window) {}
+
+void ShardShuffle::ShuffleBlocks(ShardTask &tasks) {
+  // the rows of each row group, in the order of the task list
+  std::map<std::tuple<int, int>, size_t> block_ids;
+  std::vector<std::vector<int>> blocks;
+  for (uint32_t i = 0; i < tasks.Size(); i++) {
+    const auto &key = std::get<0>(tasks.get_task_by_id(i));
+    auto it = block_ids.find(key);
+    if (it == block_ids.end()) {
+      it = block_ids.emplace(key, blocks.size()).first;
+      blocks.emplace_back();
+    }
+    blocks[it->second].push_back(static_cast<int>(i));
+  }
+
+  std::default_random_engine engine(shuffle_seed_);
+  std::shuffle(blocks.begin(), blocks.end(), engine);
+  tasks.permutation_.clear();
+  for (const auto &block : blocks) {
+    tasks.permutation_.insert(tasks.permutation_.end(), block.begin(), block.end());
+  }
+  for (size_t start = 0; start < tasks.permutation_.size(); start += block_window_) {
+    auto end = std::min(start + block_window_, tasks.permutation_.size());
+    std::shuffle(tasks.permutation_.begin() + start, tasks.permutation_.begin() + end, engine);
+  }
+}
 
 MSRStatus ShardShuffle::operator()(ShardTask &tasks) {
   if (tasks.categories < 1) {
     return FAILED;
   }
+  // the categories are interleaved row by row, the row groups are only shuffled without them
+  if (block_window_ > 0 && tasks.categories == 1) {
+    ShuffleBlocks(tasks);
+    shuffle_seed_++;
+    return SUCCESS;
+  }
   uint32_t individual_size = tasks.Size() / tasks.categories;
   std::vector<std::vector<int>> new_permutations(tasks.categories, std::vector<int>(individual_size));
   for (uint32_t i = 0; i < tasks.categories; i++) {
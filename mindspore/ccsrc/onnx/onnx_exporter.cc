@@ -291,8 +291,10 @@ class OnnxExporter {
   ~OnnxExporter() {}
 
   std::string GetOnnxProtoString(const FuncGraphPtr& func_graph);
+  bool ExportOnnxFile(const FuncGraphPtr& func_graph, const std::string& file_name, bool external_data);
 
  private:
+  void BuildModel(const FuncGraphPtr& func_graph);
   void InitModelInfo();
 
   void ExportFuncGraph(const FuncGraphPtr& func_graph, onnx::GraphProto* graph_proto);
@@ -305,6 +307,7 @@ class OnnxExporter {
   static onnx::TensorProto_DataType GetOnnxDataType(TypeId type_id);
   void SetValueInfoType(const AnfNodePtr& node, onnx::ValueInfoProto* value_proto, bool is_output = false);
   void SetTensorProtoInfo(const ParameterPtr& param, onnx::TensorProto* tensor_proto);
+  void SetInitializerData(const py::array& npy_data, onnx::TensorProto* initializer_proto);
 
   void MatchAndMark(const FuncGraphPtr& func_graph, const std::vector<AnfNodePtr>& nodes,
                     std::unordered_map<AnfNodePtr, OpMergedInfo>* op_merged_infos_ptr);
@@ -351,19 +354,67 @@ class OnnxExporter {
   onnx::ModelProto model_;
 
   size_t onnx_node_index_ = 0;
+
+  // the side file of the initializers in the external data format, which is not open when they are in the model
+  std::ofstream external_data_out_;
+  std::string external_data_location_;
+  size_t external_data_offset_ = 0;
 };
 
 std::string OnnxExporter::GetOnnxProtoString(const FuncGraphPtr& func_graph) {
   if (func_graph == nullptr) {
     return "";
   }
+  BuildModel(func_graph);
+  return model_.SerializeAsString();
+}
+
+// The model is written to the file without an intermediate string. With external data the initializers are written to
+// the side file as the parameters are visited, so the model stays small and may describe more than 2GB of weights.
+bool OnnxExporter::ExportOnnxFile(const FuncGraphPtr& func_graph, const std::string& file_name, bool external_data) {
+  if (func_graph == nullptr) {
+    return false;
+  }
+  if (external_data) {
+    std::string data_file = file_name + ".data";
+    // the location of the external data is relative to the directory of the model
+    auto pos = data_file.find_last_of('/');
+    external_data_location_ = pos == std::string::npos ? data_file : data_file.substr(pos + 1);
+    external_data_offset_ = 0;
+    external_data_out_.open(data_file, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!external_data_out_.is_open()) {
+      MS_LOG(ERROR) << "Open file " << data_file << " failed.";
+      return false;
+    }
+  }
+  BuildModel(func_graph);
+  if (external_data) {
+    external_data_out_.close();
+    if (external_data_out_.fail()) {
+      MS_LOG(ERROR) << "Write the external data of " << file_name << " failed.";
+      return false;
+    }
+  }
+  std::ofstream model_out(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!model_out.is_open()) {
+    MS_LOG(ERROR) << "Open file " << file_name << " failed.";
+    return false;
+  }
+  if (!model_.SerializeToOstream(&model_out)) {
+    MS_LOG(ERROR) << "Write the ONNX model to " << file_name << " failed.";
+    return false;
+  }
+  MS_LOG(INFO) << "Export the ONNX model to " << file_name << ", external data size " << external_data_offset_;
+  return true;
+}
+
+void OnnxExporter::BuildModel(const FuncGraphPtr& func_graph) {
   ResetNodeIndex();
   OpConvertRegistry::GetSingleton().Clear();
   OpConvertRegistry::RegisterAllOpConverters();
   InitModelInfo();
   onnx::GraphProto* graph_proto = model_.mutable_graph();
   ExportFuncGraph(func_graph, graph_proto);
-  return model_.SerializeAsString();
 }
 
 void OnnxExporter::InitModelInfo() {
@@ -415,11 +466,37 @@ void OnnxExporter::ExportParameters(const FuncGraphPtr& func_graph, onnx::GraphP
     if (py::isinstance<tensor::Tensor>(data)) {
       auto method = data.attr("asnumpy");
       py::array npy_data = method();
-      initializer_proto->set_raw_data(npy_data.request(true).ptr, static_cast<size_t>(npy_data.nbytes()));
+      SetInitializerData(npy_data, initializer_proto);
     }
   }
 }
 
+void OnnxExporter::SetInitializerData(const py::array& npy_data, onnx::TensorProto* const initializer_proto) {
+  auto size = static_cast<size_t>(npy_data.nbytes());
+  if (!external_data_out_.is_open()) {
+    initializer_proto->set_raw_data(npy_data.data(), size);
+    return;
+  }
+  // the offsets are aligned to the page size as the format recommends, so the data can be mapped
+  const size_t kExternalDataAlign = 4096;
+  size_t padding = (kExternalDataAlign - external_data_offset_ % kExternalDataAlign) % kExternalDataAlign;
+  std::string zeros(padding, '\0');
+  (void)external_data_out_.write(zeros.data(), static_cast<std::streamsize>(padding));
+  external_data_offset_ += padding;
+  (void)external_data_out_.write(static_cast<const char*>(npy_data.data()), static_cast<std::streamsize>(size));
+
+  initializer_proto->set_data_location(onnx::TensorProto_DataLocation_EXTERNAL);
+  std::vector<std::pair<std::string, std::string>> entries = {{"location", external_data_location_},
+                                                              {"offset", std::to_string(external_data_offset_)},
+                                                              {"length", std::to_string(size)}};
+  for (auto& entry : entries) {
+    onnx::StringStringEntryProto* entry_proto = initializer_proto->add_external_data();
+    entry_proto->set_key(entry.first);
+    entry_proto->set_value(entry.second);
+  }
+  external_data_offset_ += size;
+}
+
 onnx::TensorProto_DataType OnnxExporter::GetOnnxDataType(TypeId type_id) {
   // clang-format off
   static std::unordered_map<int, onnx::TensorProto_DataType> type_map = {
@@ -903,4 +980,9 @@ std::string GetOnnxProtoString(const FuncGraphPtr& func_graph) {
   OnnxExporter exporter;
   return exporter.GetOnnxProtoString(func_graph);
 }
+
+bool ExportOnnxFile(const FuncGraphPtr& func_graph, const std::string& file_name, bool external_data) {
+  OnnxExporter exporter;
+  return exporter.ExportOnnxFile(func_graph, file_name, external_data);
+}
 }  // namespace mindspore
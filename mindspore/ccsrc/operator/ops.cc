@@ -166,6 +166,7 @@ const PrimitivePtr kPrimPoolingGrad = std::make_shared<Primitive>("PoolingGrad")
 const PrimitivePtr kPrimMaxPool = std::make_shared<Primitive>("MaxPool");
 const PrimitivePtr kPrimMaxPoolGrad = std::make_shared<Primitive>("MaxPoolGrad");
 const PrimitivePtr kPrimFusedBatchNorm = std::make_shared<Primitive>("FusedBatchNorm");
+const PrimitivePtr kPrimBatchNorm = std::make_shared<Primitive>("BatchNorm");
 const PrimitivePtr kPrimConv2D = std::make_shared<Primitive>("Conv2D");
 const PrimitivePtr kPrimFusedBatchNormGrad = std::make_shared<Primitive>("FusedBatchNormGrad");
 const PrimitivePtr kPrimReluGrad = std::make_shared<Primitive>("ReluGrad");
@@ -38,6 +38,7 @@ namespace mindspore {
 namespace ad {
 std::unordered_map<FuncGraphPtr, DFunctorPtr> DFunctor::func_graph_to_functor_;
 std::unordered_map<AnfNodePtr, AdjointPtr> DFunctor::anfnode_to_adjoin_definition_;
+std::unordered_map<FuncGraphPtr, FuncGraphPtr> DFunctor::k_prim_to_clone_;
 
 DFunctor::DFunctor(const FuncGraphPtr &primal_graph, const pipeline::ResourceBasePtr &resources)
     : primal_graph_(primal_graph), resources_(resources), need_cut_(false), is_top_(false) {
@@ -60,6 +61,7 @@ void DFunctor::Init(const DFunctorPtr &functor, bool is_top) {
 void DFunctor::Clear() {
   func_graph_to_functor_.clear();
   anfnode_to_adjoin_definition_.clear();
+  k_prim_to_clone_.clear();
 }
 
 void DFunctor::BackPropagateFv(const AnfNodePtr &fv, const AnfNodePtr &din) {
@@ -365,8 +367,12 @@ AnfNodePtr DFunctor::MapToK(const AnfNodePtr &primal) {
     }
     auto k_prim = g_k_prims.KPrimitive(value_node, resources_);
     if (k_prim != nullptr) {
-      k_prim = BasicClone(k_prim);
-      return NewValueNode(k_prim);
+      // The uses of a primitive in one grad share the clone of its K graph, it's closed and not changed in place.
+      auto iter = k_prim_to_clone_.find(k_prim);
+      if (iter == k_prim_to_clone_.end()) {
+        iter = k_prim_to_clone_.emplace(k_prim, BasicClone(k_prim)).first;
+      }
+      return NewValueNode(iter->second);
     }
     // When failed to find k_prim, try k_meta.
     auto k_meta = g_k_prims.KMetaFuncGraph(prim);
@@ -100,6 +100,7 @@ class DFunctor {
   bool is_top_;
   static std::unordered_map<FuncGraphPtr, std::shared_ptr<DFunctor>> func_graph_to_functor_;
   static std::unordered_map<AnfNodePtr, AdjointPtr> anfnode_to_adjoin_definition_;
+  static std::unordered_map<FuncGraphPtr, FuncGraphPtr> k_prim_to_clone_;
 };
 
 // D Functor's rules to map primitive object.
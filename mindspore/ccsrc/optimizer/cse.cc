@@ -18,7 +18,7 @@
 
 #include "optimizer/cse.h"
 #include <vector>
-#include <set>
+#include <algorithm>
 #include <unordered_map>
 #include "./common.h"
 
@@ -41,49 +41,26 @@ BasePtr AbsOf(const AnfNodePtr &node) {
 }
 
 namespace {
-void BuildOrderGroup(const FuncGraphManagerPtr manager, std::vector<std::size_t> *const order_group,
-                     std::unordered_map<std::size_t, std::vector<AnfNodePtr>> *groups) {
-  MS_EXCEPTION_IF_NULL(order_group);
-
-  std::unordered_map<AnfNodePtr, std::size_t> hashes;
-  for (FuncGraphPtr fg : manager->func_graphs()) {
-    MS_EXCEPTION_IF_NULL(fg);
-    std::vector<AnfNodePtr> toposet = TopoSort(fg->get_return());
-    for (auto node : toposet) {
-      MS_EXCEPTION_IF_NULL(node);
-      if (hashes.find(node) != hashes.end()) {
-        continue;
-      }
-
-      std::size_t h = 0;
-      if (node->isa<ValueNode>()) {
-        ValueNodePtr value_node = node->cast<ValueNodePtr>();
-        auto value = value_node->value();
-        MS_EXCEPTION_IF_NULL(value);
-        h = hash_combine(value->hash(), (AbsOf(value_node)->hash()));
-      } else if (node->isa<CNode>()) {
-        auto cnode = node->cast<CNodePtr>();
-        auto &inputs = cnode->inputs();
-        size_t init = 0;
-        h = std::accumulate(inputs.begin(), inputs.end(), init, [&hashes](std::size_t hash, const AnfNodePtr &node_in) {
-          return hash_combine(hash, hashes[node_in]);
-        });
-      } else if (node->isa<Parameter>()) {
-        h = node->hash();
-      } else {
-        MS_LOG(ERROR) << "Unknow node type";
-      }
-
-      hashes[node] = h;
-      if (groups->find(h) == groups->end()) {
-        std::vector<AnfNodePtr> innervec({node});
-        (*groups)[h] = innervec;
-        order_group->emplace_back(h);
-      } else {
-        (*groups)[h].push_back(node);
-      }
-    }
+std::size_t NodeHash(const AnfNodePtr &node, const std::unordered_map<AnfNodePtr, std::size_t> &hashes) {
+  if (node->isa<ValueNode>()) {
+    ValueNodePtr value_node = node->cast<ValueNodePtr>();
+    auto value = value_node->value();
+    MS_EXCEPTION_IF_NULL(value);
+    return hash_combine(value->hash(), (AbsOf(value_node)->hash()));
+  }
+  if (node->isa<CNode>()) {
+    auto &inputs = node->cast<CNodePtr>()->inputs();
+    size_t init = 0;
+    return std::accumulate(inputs.begin(), inputs.end(), init, [&hashes](std::size_t hash, const AnfNodePtr &node_in) {
+      auto iter = hashes.find(node_in);
+      return hash_combine(hash, iter == hashes.end() ? 0 : iter->second);
+    });
+  }
+  if (node->isa<Parameter>()) {
+    return node->hash();
   }
+  MS_LOG(ERROR) << "Unknow node type";
+  return 0;
 }
 }  // namespace
 
@@ -125,62 +102,44 @@ bool CSE::CheckReplace(const AnfNodePtr &main, const AnfNodePtr &node) const {
   return replace;
 }
 
-bool CSE::DoReplace(const FuncGraphManagerPtr manager, const std::vector<std::size_t> &order_group,
-                    std::unordered_map<std::size_t, std::vector<AnfNodePtr>> *groups) const {
-  bool changes = false;
-  std::set<size_t> clear_set;
-  for (auto &h : order_group) {
-    std::vector<AnfNodePtr> &group = (*groups)[h];
-    // If there are more than 2 node in that group, they may be same common expression can be eliminated.
-    if (group.size() > 1) {
-      for (size_t k = 0; k < group.size() - 1; k++) {
-        AnfNodePtr main = group[k];
-        MS_EXCEPTION_IF_NULL(main);
-
-        // When all node in group has been replaced
-        // or a valuenode node, skip compare in group
-        if ((k + 1 + clear_set.size() == group.size()) || (k > 0 && main->isa<ValueNode>())) {
-          break;
-        }
-
-        // skip node has been replaced
-        if (clear_set.find(k) != clear_set.end()) {
-          continue;
-        }
-
-        // Compare with rest elements in this group.
-        for (size_t i = k + 1; i < group.size(); i++) {
-          auto node = group[i];
-          MS_EXCEPTION_IF_NULL(node);
+bool CSE::Cse(const FuncGraphPtr root, const FuncGraphManagerPtr manager) const {
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->AddFuncGraph(root);
 
-          if (clear_set.find(i) != clear_set.end()) {
-            continue;
-          }
-          if (main->func_graph() != node->func_graph()) {
-            continue;
-          }
-          if (CheckReplace(node, main)) {
-            changes = true;
-            (void)manager->Replace(node, main);
-            (void)clear_set.insert(i);
-          }
-        }
+  // The nodes are visited after their inputs, which have been replaced by their mains then, so the hash of a node is
+  // built from the ones of its inputs once. A node is replaced by the first main of its hash equal to it.
+  std::unordered_map<AnfNodePtr, std::size_t> hashes;
+  std::unordered_map<std::size_t, std::vector<AnfNodePtr>> mains;
+  bool changes = false;
+  // the graphs not used any more are dropped by the replacement
+  auto func_graphs = manager->func_graphs();
+  for (auto &fg : func_graphs) {
+    MS_EXCEPTION_IF_NULL(fg);
+    if (!manager->func_graphs().contains(fg)) {
+      continue;
+    }
+    std::vector<AnfNodePtr> toposet = TopoSort(fg->get_return());
+    for (auto &node : toposet) {
+      MS_EXCEPTION_IF_NULL(node);
+      if (hashes.find(node) != hashes.end() || !manager->all_nodes().contains(node)) {
+        continue;
+      }
+      std::size_t h = NodeHash(node, hashes);
+      hashes[node] = h;
+      auto &group = mains[h];
+      auto main = std::find_if(group.begin(), group.end(), [this, &node, &manager](const AnfNodePtr &main_node) {
+        return main_node->func_graph() == node->func_graph() && manager->all_nodes().contains(main_node) &&
+               CheckReplace(node, main_node);
+      });
+      if (main == group.end()) {
+        group.push_back(node);
+        continue;
       }
-      clear_set.clear();
+      changes = true;
+      (void)manager->Replace(node, *main);
     }
   }
-
   return changes;
 }
-
-bool CSE::Cse(const FuncGraphPtr root, const FuncGraphManagerPtr manager) const {
-  MS_EXCEPTION_IF_NULL(manager);
-  manager->AddFuncGraph(root);
-
-  std::unordered_map<std::size_t, std::vector<AnfNodePtr>> groups;
-  std::vector<std::size_t> order_group;
-  BuildOrderGroup(manager, &order_group, &groups);
-  return DoReplace(manager, order_group, &groups);
-}
 }  // namespace opt
 }  // namespace mindspore
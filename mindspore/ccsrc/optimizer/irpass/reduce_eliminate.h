@@ -36,7 +36,7 @@ using abstract::ShapePtr;
 // {ReduceLike, X, axis}
 class ReduceOneEliminater : public AnfVisitor {
  public:
-  AnfNodePtr operator()(const OptimizerPtr &, const AnfNodePtr &node) override {
+  AnfNodePtr operator()(const OptimizerPtr &optimizer, const AnfNodePtr &node) override {
     Reset();
     PrimitivePtr prim;
     if (IsPrimitiveCNode(node, prim::kPrimReduceMean) || IsPrimitiveCNode(node, prim::kPrimReduceAll) ||
@@ -47,6 +47,9 @@ class ReduceOneEliminater : public AnfVisitor {
       if (!is_axis_one_) {
         return nullptr;
       }
+      if (optimizer != nullptr) {
+        optimizer->MarkShapeSpecialized();
+      }
 
       // consider keep_dims
       auto keep_dims = prim->GetAttr("keep_dims");
@@ -35,7 +35,7 @@ using abstract::ShapePtr;
 // {reshape_op, X, Shape}
 class ReshapeSameShapeEliminater : public AnfVisitor {
  public:
-  AnfNodePtr operator()(const OptimizerPtr &, const AnfNodePtr &node) override {
+  AnfNodePtr operator()(const OptimizerPtr &optimizer, const AnfNodePtr &node) override {
     Reset();
     AnfVisitor::Match(prim::kPrimReshape, {IsNode, IsVNode})(node);
 
@@ -55,6 +55,9 @@ class ReshapeSameShapeEliminater : public AnfVisitor {
       auto elements = GetValue<std::vector<int>>(tgt_shape);
       auto shape = src_shape->cast<ShapePtr>();
       if (shape->shape() == elements) {
+        if (optimizer != nullptr) {
+          optimizer->MarkShapeSpecialized();
+        }
         return x_;
       }
     }
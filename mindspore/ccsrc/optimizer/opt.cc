@@ -34,7 +34,7 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const TransformFuncType& transform, const std::string& name,
                                  const PrimitivePtr& prim) {
   auto fn = [prim](const AnfNodePtr& node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn);
+  return std::make_shared<Substitution>(transform, name, fn, std::vector<std::string>{prim->name()});
 }
 
 SubstitutionPtr MakeSubstitution(const TransformFuncType& transform, const std::string& name,
@@ -52,7 +52,10 @@ SubstitutionPtr MakeSubstitution(const TransformFuncType& transform, const std::
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn);
+  std::vector<std::string> prim_names;
+  (void)std::transform(prims.begin(), prims.end(), std::back_inserter(prim_names),
+                       [](const PrimitivePtr& prim) { return prim->name(); });
+  return std::make_shared<Substitution>(transform, name, fn, prim_names);
 }
 
 SubstitutionPtr MakeSubstitution(const TransformFuncType& transform, const std::string& name,
@@ -78,8 +81,43 @@ AnfNodePtr Substitution::operator()(const OptimizerPtr& optimizer, const AnfNode
   return result;
 }
 
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr>& patterns, bool is_once)
+    : list_(patterns), is_once_(is_once) {
+  for (auto& substitution : list_) {
+    for (auto& prim_name : substitution->prim_names_) {
+      (void)prim_candidates_[prim_name];
+    }
+  }
+  for (auto& substitution : list_) {
+    if (substitution->prim_names_.empty()) {
+      any_candidates_.push_back(substitution);
+      for (auto& iter : prim_candidates_) {
+        iter.second.push_back(substitution);
+      }
+      continue;
+    }
+    for (auto& prim_name : substitution->prim_names_) {
+      auto& candidates = prim_candidates_[prim_name];
+      if (candidates.empty() || candidates.back() != substitution) {
+        candidates.push_back(substitution);
+      }
+    }
+  }
+}
+
+const std::vector<SubstitutionPtr>& SubstitutionList::Candidates(const AnfNodePtr& node) const {
+  auto prim = GetCNodePrimitive(node);
+  if (prim != nullptr) {
+    auto iter = prim_candidates_.find(prim->name());
+    if (iter != prim_candidates_.end()) {
+      return iter->second;
+    }
+  }
+  return any_candidates_;
+}
+
 bool SubstitutionList::ApplyTransform(const OptimizerPtr& optimizer, const AnfNodePtr& root_node,
-                                      const SubstitutionPtr& transform) const {
+                                      const CandidatesFuncType& candidates) const {
   FuncGraphManagerPtr manager = optimizer->manager();
   std::unordered_set<AnfNodePtr> seen_node;
   std::deque<AnfNodePtr> todo{root_node};
@@ -95,12 +133,12 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr& optimizer, const AnfNo
     }
     (void)seen_node.insert(node);
 
-    // select nodes that this transform can be applied.
-    bool is_match = transform->predicate_(node);
-
-    // apply transform on this node
+    // apply the first transform matching this node and changing it
     bool change = false;
-    if (is_match) {
+    for (auto& transform : candidates(node)) {
+      if (!transform->predicate_(node)) {
+        continue;
+      }
       auto ret = (*transform)(optimizer, node);
       if (ret != nullptr && ret != node) {
         change = true;
@@ -112,6 +150,7 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr& optimizer, const AnfNo
         MsProfile::StatTime("replace." + transform->name_, GetTime() - t);
 #endif
         node = ret;
+        break;
       }
     }
 
@@ -148,20 +187,29 @@ bool SubstitutionList::operator()(const FuncGraphPtr& func_graph, const Optimize
   FuncGraphManagerPtr manager = optimizer->manager();
   manager->AddFuncGraph(func_graph);
 
-  bool loop = false;
   bool changes = false;
-
-  do {
-    loop = false;
+  if (is_once_) {
+    // each transform goes over the graph once, in the order of the list
     for (auto const& transform : list_) {
-      auto change = ApplyTransform(optimizer, func_graph->output(), transform);
+      std::vector<SubstitutionPtr> candidates{transform};
+      auto change = ApplyTransform(optimizer, func_graph->output(),
+                                   [&candidates](const AnfNodePtr&) -> const std::vector<SubstitutionPtr>& {
+                                     return candidates;
+                                   });
       changes = changes || change;
-      loop = loop || change;
     }
+    return changes;
+  }
 
-    if (is_once_) {
-      break;
-    }
+  // Every node tries the transforms of its primitive in one go over the graph, the users of the changed nodes are
+  // revisited. It's repeated for the changes not reaching the nodes by the edges, e.g. a called graph gets inlinable.
+  bool loop = false;
+  do {
+    loop = ApplyTransform(optimizer, func_graph->output(),
+                          [this](const AnfNodePtr& node) -> const std::vector<SubstitutionPtr>& {
+                            return Candidates(node);
+                          });
+    changes = changes || loop;
   } while (loop);
 
   return changes;
@@ -20,6 +20,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 #include "ir/anf.h"
 #include "ir/func_graph.h"
@@ -41,8 +42,11 @@ class Substitution {
   TransformFuncType transform_{nullptr};
   std::string name_;
   PredicateFuncType predicate_{nullptr};
-  explicit Substitution(const TransformFuncType &transform, const std::string &name, const PredicateFuncType &predicate)
-      : transform_(transform), name_(name), predicate_(predicate) {}
+  // the primitives of the cnodes the predicate may match, it's tried on every node if there are none
+  std::vector<std::string> prim_names_;
+  explicit Substitution(const TransformFuncType &transform, const std::string &name, const PredicateFuncType &predicate,
+                        const std::vector<std::string> &prim_names = {})
+      : transform_(transform), name_(name), predicate_(predicate), prim_names_(prim_names) {}
   ~Substitution() = default;
   AnfNodePtr operator()(const OptimizerPtr &optimizer, const AnfNodePtr &node) const;
 };
@@ -57,15 +61,21 @@ SubstitutionPtr MakeSubstitution(const TransformFuncType &transform, const std::
 
 class SubstitutionList {
  public:
-  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false)
-      : list_(patterns), is_once_(is_once) {}
+  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
-  bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  using CandidatesFuncType = std::function<const std::vector<SubstitutionPtr> &(const AnfNodePtr &)>;
+  // go over the nodes reached from node, each one is changed by the first of its candidates matching it
+  bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node,
+                      const CandidatesFuncType &candidates) const;
+  const std::vector<SubstitutionPtr> &Candidates(const AnfNodePtr &node) const;
   std::vector<SubstitutionPtr> list_;
+  // the substitutions tried on the cnodes of each primitive, and the ones tried on any node, in the order of the list
+  std::unordered_map<std::string, std::vector<SubstitutionPtr>> prim_candidates_;
+  std::vector<SubstitutionPtr> any_candidates_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
 };
@@ -144,7 +144,11 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
               changes = true;
             }
           };
-          use_profile ? (WITH(MsProfile::GetProfile()->Step(pass_names_[i])) opt_func) : opt_func();
+          auto stat_func = [&opt_func, i, this]() {
+            WITH_PASS_STAT("opt." + name_ + "." + pass_names_[i],
+                           [this]() -> size_t { return manager()->all_nodes().size(); }) opt_func;
+          };
+          use_profile ? (WITH(MsProfile::GetProfile()->Step(pass_names_[i])) stat_func) : opt_func();
 #ifdef DEBUG
           MS_LOG(DEBUG) << "" << name_ << " round " << counter << " OptPass " << pass_names_[i] << " end.";
           auto fg_name = name_ + "_r" + std::to_string(counter) + "_" + std::to_string(i) + "_" + pass_names_[i];
@@ -178,6 +182,13 @@ class Optimizer : public std::enable_shared_from_this<Optimizer> {
     MS_LOG(EXCEPTION) << "No ResourceBase exists.";
   }
 
+  // The passes changing the graph by the shapes of the nodes mark it, the graph then is only valid for them.
+  void MarkShapeSpecialized() {
+    if (resource_ != nullptr) {
+      resource_->SetResult(pipeline::kShapeSpecialized, true);
+    }
+  }
+
   const std::string name() const { return name_; }
 
  private:
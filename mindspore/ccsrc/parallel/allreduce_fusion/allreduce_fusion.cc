@@ -19,12 +19,16 @@
 #include <unordered_set>
 #include <string>
 #include <memory>
+#include <algorithm>
 #include "utils/log_adapter.h"
 #include "parallel/status.h"
 #include "ir/func_graph.h"
+#include "ir/dtype/type.h"
+#include "pipeline/static_analysis/abstract_value.h"
 #include "parallel/step_parallel.h"
 #include "parallel/graph_util/node_info.h"
 #include "parallel/costmodel_context.h"
+#include "parallel/tensor_layout/tensor_layout.h"
 
 namespace mindspore {
 namespace parallel {
@@ -379,10 +383,112 @@ Status AllreduceFusion::SetFusionByBackwardCompAndAllreduceTime() {
   return SUCCESS;
 }
 
+double ParameterBytes(const AnfNodePtr& para) {
+  auto para_ptr = para->cast<ParameterPtr>();
+  MS_EXCEPTION_IF_NULL(para_ptr);
+  MS_EXCEPTION_IF_NULL(para_ptr->tensor_layout());
+  double para_size = static_cast<double>(para_ptr->tensor_layout()->slice_shape().size());
+  auto abstract = para_ptr->abstract();
+  if ((abstract != nullptr) && abstract->isa<abstract::AbstractTensor>()) {
+    auto element = abstract->cast<abstract::AbstractTensorPtr>()->element();
+    MS_EXCEPTION_IF_NULL(element);
+    size_t type_byte = GetTypeByte(element->BuildType());
+    if (type_byte > 0) {
+      return para_size * static_cast<double>(type_byte);
+    }
+  }
+  return para_size * static_cast<double>(sizeof(float));
+}
+
+// Each bucket is the AllReduce of the gradients ready when the backward computation reaches its depend_feat_size,
+// and the AllReduces run one after another. The AllReduce time not hidden by the backward computation is the tail
+// after the end of the backward computation.
+void AllreduceFusion::ComputeExpectedOverlap(const std::vector<std::pair<double, double>>& buckets) {
+  auto cost_model_context = CostModelContext::GetInstance();
+  double inherent_time = cost_model_context->costmodel_allreduce_fusion_allreduce_inherent_time();
+  double bandwidth = cost_model_context->costmodel_allreduce_fusion_allreduce_bandwidth();
+  double computation_time_parameter = cost_model_context->costmodel_allreduce_fusion_computation_time_parameter();
+  double backward_time = allreduce_graph_.max() * computation_time_parameter;
+  double allreduce_time = 0;
+  double allreduce_end_time = 0;
+  for (auto& bucket : buckets) {
+    double time = inherent_time + bucket.second * bandwidth;
+    allreduce_end_time = std::max(allreduce_end_time, bucket.first * computation_time_parameter) + time;
+    allreduce_time += time;
+  }
+  if (allreduce_time <= 0) {
+    return;
+  }
+  double tail_time = std::max(allreduce_end_time - backward_time, 0.0);
+  expected_overlap_ratio_ = std::max(allreduce_time - tail_time, 0.0) / allreduce_time;
+  MS_LOG(INFO) << "AllReduce fusion by size: " << buckets.size() << " buckets, backward computation time "
+               << backward_time << ", AllReduce time " << allreduce_time << ", tail time " << tail_time
+               << ", expected overlap ratio " << expected_overlap_ratio_;
+}
+
+Status AllreduceFusion::SetFusionBySize() {
+  auto bucket_size = CostModelContext::GetInstance()->costmodel_allreduce_fusion_bucket_size();
+  if (bucket_size <= 0) {
+    MS_LOG(INFO) << "'costmodel_allreduce_fusion_bucket_size' is " << bucket_size << ". Bypass ProcessAllreduceFusion";
+    return SUCCESS;
+  }
+  allreduce_graph_.SortArnode();
+  if (allreduce_graph_.RemoveExtraParas() != SUCCESS) {
+    MS_LOG(ERROR) << "RemoveExtraParas failed!";
+    return FAILED;
+  }
+  // The gradients are ready in the ascending order of depend_feat_size in the backward computation, each bucket is
+  // closed once its gradients reach bucket_size, so that its fused AllReduce starts before the later gradients.
+  // The pair of each bucket is its ready depend_feat_size and its parameter size.
+  std::vector<std::pair<double, double>> buckets;
+  std::vector<AnfNodePtr> paras;
+  double bucket_bytes = 0;
+  double bucket_para_size = 0;
+  double bucket_depend_feat_size = 0;
+  int32_t fusion = 1;
+  auto set_bucket_fusion = [&]() -> Status {
+    if (FindMirrorAndSetFusion(paras, fusion) != SUCCESS) {
+      MS_LOG(ERROR) << "FindMirrorAndSetFusion failed";
+      return FAILED;
+    }
+    MS_LOG(INFO) << "Fusion " << fusion << ": " << paras.size() << " parameters, " << bucket_bytes << " bytes";
+    buckets.emplace_back(bucket_depend_feat_size, bucket_para_size);
+    fusion++;
+    paras.clear();
+    bucket_bytes = 0;
+    bucket_para_size = 0;
+    return SUCCESS;
+  };
+  const auto& arnode_vec = allreduce_graph_.arnode_vec();
+  for (auto arnode = arnode_vec.rbegin(); arnode != arnode_vec.rend(); ++arnode) {
+    if (arnode->paras().empty()) {
+      continue;
+    }
+    for (auto& para : arnode->paras()) {
+      paras.push_back(para);
+      bucket_bytes += ParameterBytes(para);
+    }
+    bucket_para_size += arnode->curr_para_size();
+    bucket_depend_feat_size = arnode->depend_feat_size();
+    if ((bucket_bytes >= bucket_size) && (set_bucket_fusion() != SUCCESS)) {
+      return FAILED;
+    }
+  }
+  if (!paras.empty() && (set_bucket_fusion() != SUCCESS)) {
+    return FAILED;
+  }
+  ComputeExpectedOverlap(buckets);
+  MS_LOG(DEBUG) << "AllreduceGraph SetFusionBySize succeed.";
+  return SUCCESS;
+}
+
 Status AllreduceFusion::SetFusionByAlgorithm(int32_t algorithm) {
   if (algorithm == 1) {
     return SetFusionByBackwardCompTime();
   }
+  if (algorithm == 3) {
+    return SetFusionBySize();
+  }
   return SetFusionByBackwardCompAndAllreduceTime();
 }
 
@@ -392,7 +498,7 @@ Status AllreduceFusion::ProcessAllreduceFusion(const CNodePtr& ret) {
     return FAILED;
   }
   auto algorithm = CostModelContext::GetInstance()->costmodel_allreduce_fusion_algorithm();
-  if (algorithm < 1 || algorithm > 2) {
+  if (algorithm < 1 || algorithm > 3) {
     MS_LOG(INFO) << "'costmodel_allreduce_fusion_algorithm' is " << algorithm << ". Bypass ProcessAllreduceFusion";
     return SUCCESS;
   }
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_PARALLEL_ALLREDUCE_FUSION_ALLREDUCE_FUSION_H_
 
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include "ir/anf.h"
 #include "parallel/status.h"
@@ -34,6 +35,7 @@ constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_TAIL_TIME = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALLREDUCE_INHERENT_TIME = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALLREDUCE_BANDWIDTH = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_COMPUTATION_TIME_PARAMETER = 0.1;
+constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_BUCKET_SIZE = 25.0 * 1024 * 1024;
 
 constexpr char FUSION[] = "fusion";
 constexpr char PARAMETER[] = "parameter";
@@ -49,9 +51,12 @@ class AllreduceFusion {
         tail_time_(0),
         allreduce_inherent_time_(0),
         allreduce_bandwidth_(0),
-        computation_time_parameter_(0) {}
+        computation_time_parameter_(0),
+        expected_overlap_ratio_(0) {}
   virtual ~AllreduceFusion() = default;
   Status ProcessAllreduceFusion(const CNodePtr& ret);
+  // The expected part of the AllReduce time hidden by the backward computation, only set by the fusion by size
+  double expected_overlap_ratio() const { return expected_overlap_ratio_; }
 
  private:
   Status AddNodeToGraph();
@@ -64,6 +69,8 @@ class AllreduceFusion {
   Status SetFusionByBackwardCompTime();
   Status SetFusionByBackwardCompAndAllreduceTime();
   Status GetSetFusionByBackwardCompAndAllreduceTimeParams();
+  Status SetFusionBySize();
+  void ComputeExpectedOverlap(const std::vector<std::pair<double, double>>& buckets);
 
   AllreduceGraph allreduce_graph_;
   CNodePtr ret_;
@@ -73,6 +80,7 @@ class AllreduceFusion {
   double allreduce_inherent_time_;
   double allreduce_bandwidth_;
   double computation_time_parameter_;
+  double expected_overlap_ratio_;
 };
 }  // namespace parallel
 }  // namespace mindspore
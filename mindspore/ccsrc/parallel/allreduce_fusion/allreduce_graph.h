@@ -64,6 +64,8 @@ class AllreduceGraph {
   CNodePtr head_cnode() const { return head_cnode_; }
   Status set_head_cnode(const CNodePtr& node);
   double max() const { return max_; }
+  // The AllreduceNodes sorted by SortArnode, in the descending order of depend_feat_size
+  const std::vector<AllreduceNode>& arnode_vec() const { return arnode_vec_; }
 
  private:
   CNodePtr head_cnode_;
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/auto_parallel/cost_calibration.h"
+
+#include <fstream>
+#include <memory>
+#include <nlohmann/json.hpp>
+
+#include "parallel/device_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+const char DEVICE_NUM[] = "device_num";
+const char REFERENCE[] = "reference";
+const char OPERATORS[] = "operators";
+const char REDISTRIBUTION[] = "redistribution";
+const char COMPUTATION[] = "computation";
+const char COMMUNICATION[] = "communication";
+
+double GetTimePerByte(const nlohmann::json& entry, const char* key, double reference) {
+  if (!entry.contains(key)) {
+    return reference;
+  }
+  double value = entry.at(key).get<double>();
+  if (value <= 0) {
+    MS_LOG(EXCEPTION) << "The '" << key << "' of the cost calibration must be positive, but got " << value << ".";
+  }
+  return value;
+}
+
+OperatorCalibration ParseCalibration(const nlohmann::json& entry, const OperatorCalibration& reference) {
+  OperatorCalibration result;
+  result.computation_scale =
+    GetTimePerByte(entry, COMPUTATION, reference.computation_scale) / reference.computation_scale;
+  result.communication_scale =
+    GetTimePerByte(entry, COMMUNICATION, reference.communication_scale) / reference.communication_scale;
+  return result;
+}
+}  // namespace
+
+std::shared_ptr<CostCalibration> CostCalibration::inst_ = nullptr;
+
+std::shared_ptr<CostCalibration> CostCalibration::GetInstance() {
+  if (inst_ == nullptr) {
+    inst_.reset(new (std::nothrow) CostCalibration());
+  }
+  return inst_;
+}
+
+void CostCalibration::Clear() {
+  operators_.clear();
+  redistribution_ = OperatorCalibration();
+  has_redistribution_ = false;
+}
+
+void CostCalibration::Load(const std::string& file) {
+  Clear();
+  if (file.empty()) {
+    return;
+  }
+  std::ifstream fin(file);
+  if (!fin.is_open()) {
+    MS_LOG(EXCEPTION) << "Open the cost calibration file " << file << " failed.";
+  }
+  nlohmann::json database;
+  try {
+    fin >> database;
+  } catch (const std::exception& e) {
+    MS_LOG(EXCEPTION) << "Parse the cost calibration file " << file << " failed: " << e.what();
+  }
+  if (database.contains(DEVICE_NUM)) {
+    auto device_num = database.at(DEVICE_NUM).get<size_t>();
+    MS_EXCEPTION_IF_NULL(g_device_manager);
+    auto stage_device_num = g_device_manager->GetDeviceListByStageId(0).size();
+    if (device_num != stage_device_num) {
+      MS_LOG(WARNING) << "The cost calibration file " << file << " is measured on " << device_num
+                      << " devices, but there are " << stage_device_num << " devices, it is ignored.";
+      return;
+    }
+  }
+  // The scales of the reference are computed as time per byte first, and then the entries are divided by them.
+  OperatorCalibration reference;
+  if (database.contains(REFERENCE)) {
+    reference.computation_scale = GetTimePerByte(database.at(REFERENCE), COMPUTATION, 1.0);
+    reference.communication_scale = GetTimePerByte(database.at(REFERENCE), COMMUNICATION, 1.0);
+  }
+  if (database.contains(OPERATORS)) {
+    for (auto& item : database.at(OPERATORS).items()) {
+      operators_[item.key()] = ParseCalibration(item.value(), reference);
+    }
+  }
+  if (database.contains(REDISTRIBUTION)) {
+    redistribution_ = ParseCalibration(database.at(REDISTRIBUTION), reference);
+    has_redistribution_ = true;
+  }
+  MS_LOG(INFO) << "Loaded the cost calibration of " << operators_.size() << " operators from " << file << ".";
+}
+
+const OperatorCalibration& CostCalibration::GetOperatorCalibration(const std::string& op_type) const {
+  auto iter = operators_.find(op_type);
+  if (iter == operators_.end()) {
+    return default_;
+  }
+  return iter->second;
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_AUTO_PARALLEL_COST_CALIBRATION_H_
+#define PARALLEL_AUTO_PARALLEL_COST_CALIBRATION_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace mindspore {
+namespace parallel {
+// The measured speed of an operator type, relative to the reference the analytical costs are calibrated on. The
+// costs computed by the OperatorCost of the operator are multiplied by these scales.
+struct OperatorCalibration {
+  double computation_scale = 1.0;
+  double communication_scale = 1.0;
+};
+
+// The cost database measured on a device type and topology. It is a json file:
+//   {
+//     "device_num": 8,
+//     "reference": {"computation": 1.0e-10, "communication": 4.0e-10},
+//     "operators": {"MatMul": {"computation": 2.5e-11, "communication": 3.2e-10}, ...},
+//     "redistribution": {"communication": 5.0e-10}
+//   }
+// where each value is the measured time per byte of the analytical cost: the time of a benchmarked kernel or
+// collective divided by the cost its OperatorCost gives for the same shapes. The values are divided by the
+// reference ones, so the calibrated costs stay in bytes of the reference and the other cost model parameters keep
+// their meaning. A missing operator or value uses the reference. The database is ignored if its 'device_num' is not
+// the number of devices of stage 0.
+class CostCalibration {
+ public:
+  ~CostCalibration() = default;
+  CostCalibration(const CostCalibration&) = delete;
+  CostCalibration& operator=(const CostCalibration&) = delete;
+  static std::shared_ptr<CostCalibration> GetInstance();
+
+  // Load the database in 'file', an empty path clears it. Raise an exception if the file cannot be parsed.
+  void Load(const std::string& file);
+  void Clear();
+  bool empty() const { return operators_.empty() && !has_redistribution_; }
+  const OperatorCalibration& GetOperatorCalibration(const std::string& op_type) const;
+  const OperatorCalibration& redistribution_calibration() const { return redistribution_; }
+
+ private:
+  CostCalibration() = default;
+  static std::shared_ptr<CostCalibration> inst_;
+
+  std::unordered_map<std::string, OperatorCalibration> operators_;
+  OperatorCalibration default_;
+  OperatorCalibration redistribution_;
+  bool has_redistribution_ = false;
+};
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // PARALLEL_AUTO_PARALLEL_COST_CALIBRATION_H_
@@ -109,5 +109,15 @@ void RefineForPracticalCost(const CostPtr& origin_cost, bool is_redistribution)
     }
   }
 }
+
+void CalibrateForMeasuredCost(const CostPtr& origin_cost, const OperatorCalibration& calibration) {
+  MS_EXCEPTION_IF_NULL(origin_cost);
+  origin_cost->memory_cost_ *= calibration.computation_scale;
+  origin_cost->communication_cost_ *= calibration.communication_scale;
+  origin_cost->communication_without_parameter_ *= calibration.communication_scale;
+  origin_cost->communication_with_partial_para_ *= calibration.communication_scale;
+  origin_cost->communication_redis_forward_ *= calibration.communication_scale;
+  origin_cost->communication_redis_backward_ *= calibration.communication_scale;
+}
 }  // namespace parallel
 }  // namespace mindspore
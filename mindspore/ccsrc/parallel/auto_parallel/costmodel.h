@@ -24,6 +24,7 @@
 #include <utility>
 #include "parallel/strategy.h"
 #include "parallel/tensor_layout/tensor_info.h"
+#include "parallel/auto_parallel/cost_calibration.h"
 
 namespace mindspore {
 namespace parallel {
@@ -298,6 +299,7 @@ using FinalSingleDecisionPtr = std::shared_ptr<FinalSingleDecision>;
 void Simplify(CostPtrList* clist);
 void SimplifyForDreasingCommunicationWithPartialPara(CostPtrList* clist);
 void RefineForPracticalCost(const CostPtr&, bool is_redistribution);
+void CalibrateForMeasuredCost(const CostPtr&, const OperatorCalibration& calibration);
 }  // namespace parallel
 }  // namespace mindspore
 
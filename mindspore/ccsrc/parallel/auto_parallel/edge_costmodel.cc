@@ -26,6 +26,8 @@
 
 namespace mindspore {
 namespace parallel {
+std::unordered_map<std::string, CostPtr> Edge::redistribution_cost_cache_;
+
 Status Edge::InitEdgeCost() {
   bool has_available_cost = false;
   for (auto& swc : prev_op_->GetStrategyCost()) {
@@ -61,20 +63,30 @@ Status Edge::InitEdgeCost() {
       auto target_output_lyt = target_output.second[prev_op_output_index_].tensor_layout();
       auto target_output_str = target_output.first;
       auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
+      std::string output_key = target_output_lyt.ToString() + ListToString(prev_op_->global_device_list()) + "/" +
+                               std::to_string(type_length) + "->";
       for (auto& target_input : next_op_input_) {
         auto target_input_lyt = target_input.second[next_op_input_index_].tensor_layout();
         auto target_input_str = target_input.first;
         CostPtr cost;
-        if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, &cost) != SUCCESS) {
-          MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
+        std::string cache_key = output_key + target_input_lyt.ToString();
+        auto cache_iter = redistribution_cost_cache_.find(cache_key);
+        if (cache_iter != redistribution_cost_cache_.end()) {
+          cost = std::make_shared<Cost>(*cache_iter->second);
+        } else {
+          if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, &cost) != SUCCESS) {
+            MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
+          }
+          MS_EXCEPTION_IF_NULL(cost);
+          MS_LOG(DEBUG) << "The redistribution cost: memory_cost: " << cost->memory_cost_
+                        << ", communication_cost: " << cost->communication_cost_
+                        << ", communication_without_parameter_: " << cost->communication_without_parameter_
+                        << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
+          CalibrateForMeasuredCost(cost, CostCalibration::GetInstance()->redistribution_calibration());
+          // refine communication cost calculation for practice
+          RefineForPracticalCost(cost, true);
+          redistribution_cost_cache_[cache_key] = std::make_shared<Cost>(*cost);
         }
-        MS_EXCEPTION_IF_NULL(cost);
-        MS_LOG(DEBUG) << "The redistribution cost: memory_cost: " << cost->memory_cost_
-                      << ", communication_cost: " << cost->communication_cost_
-                      << ", communication_without_parameter_: " << cost->communication_without_parameter_
-                      << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
-        // refine communication cost calculation for practice
-        RefineForPracticalCost(cost, true);
         CostPtrKey ck = {target_output_str, target_input_str};
         CostPtrList cl;
         cl.push_back(cost);
@@ -114,18 +126,20 @@ Status Edge::GetRedistributionCost(const TensorLayout& prev_op_output_layout, co
     MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
   }
 
-  double comm_cost = tensor_redistribution.comm_cost();
-  double forward_comm_cost = tensor_redistribution.forward_comm_cost();
-  double backward_comm_cost = tensor_redistribution.backward_comm_cost();
+  // the latency of the collectives is already in bytes, it is added once for each phase
+  double comm_latency = tensor_redistribution.comm_latency();
+  double comm_cost = type_length * tensor_redistribution.comm_cost() + 2.0 * comm_latency;
+  double forward_comm_cost = type_length * tensor_redistribution.forward_comm_cost() + comm_latency;
+  double backward_comm_cost = type_length * tensor_redistribution.backward_comm_cost() + comm_latency;
   double mem_cost = tensor_redistribution.mem_cost();
 
-  *cost = std::make_shared<Cost>(type_length * mem_cost, type_length * comm_cost);
-  (*cost)->communication_without_parameter_ = type_length * comm_cost;
+  *cost = std::make_shared<Cost>(type_length * mem_cost, comm_cost);
+  (*cost)->communication_without_parameter_ = comm_cost;
   (*cost)->communication_with_partial_para_ =
     (*cost)->communication_without_parameter_ +
     COST_MODEL_GAMMA * ((*cost)->communication_cost_ - (*cost)->communication_without_parameter_);
-  (*cost)->communication_redis_forward_ = type_length * forward_comm_cost;
-  (*cost)->communication_redis_backward_ = type_length * backward_comm_cost;
+  (*cost)->communication_redis_forward_ = forward_comm_cost;
+  (*cost)->communication_redis_backward_ = backward_comm_cost;
   return Status::SUCCESS;
 }
 
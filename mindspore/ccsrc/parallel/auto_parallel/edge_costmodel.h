@@ -22,6 +22,7 @@
 #include <utility>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include "common/utils.h"
 #include "parallel/tensor_layout/tensor_layout.h"
 #include "parallel/tensor_layout/tensor_info.h"
@@ -85,6 +86,9 @@ class Edge {
   // and the op_list to carry out the redistribution.
   Status GetRedistributionCost(const TensorLayout& prev_op_output_layout, const TensorLayout& next_op_input_layout,
                                size_t, CostPtr* cost);
+  // The edges between repeated layers share the same pairs of layouts, so the refined redistribution costs are cached
+  // across the edges. The cache is cleared before the edges of a graph are constructed.
+  static void ClearRedistributionCostCache() { redistribution_cost_cache_.clear(); }
 
   void set_pre_op_output(const std::vector<std::pair<std::shared_ptr<Strategy>, std::vector<TensorInfo>>>& output_set) {
     pre_op_output_ = output_set;
@@ -139,6 +143,8 @@ class Edge {
   std::string edge_name_;
   std::shared_ptr<OperatorInfo> prev_op_, next_op_;
   std::map<CostPtrKey, CostPtrList> cost_map_;
+  // the key is the layouts, the device list and the type length of a redistribution
+  static std::unordered_map<std::string, CostPtr> redistribution_cost_cache_;
   // pre_op_output_
   std::vector<std::pair<std::shared_ptr<Strategy>, std::vector<TensorInfo>>> pre_op_output_;
   std::vector<std::pair<std::shared_ptr<Strategy>, std::vector<TensorInfo>>> next_op_input_;
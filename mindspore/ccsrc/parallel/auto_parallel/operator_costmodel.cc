@@ -398,7 +398,7 @@ double ReshapeCost::GetForwardCommCost(const std::vector<TensorInfo>& inputs, co
   if (tensor_redistribution.ComputeCost() == FAILED) {
     MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
   }
-  return (inputs_type_lengths_[0] * tensor_redistribution.comm_cost());
+  return (inputs_type_lengths_[0] * tensor_redistribution.comm_cost() + 2.0 * tensor_redistribution.comm_latency());
 }
 
 // return the per device communication cost in the backward phase.
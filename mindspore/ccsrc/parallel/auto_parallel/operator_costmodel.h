@@ -21,6 +21,7 @@
 #include <memory>
 #include "parallel/tensor_layout/tensor_info.h"
 #include "parallel/device_manager.h"
+#include "parallel/auto_parallel/cost_calibration.h"
 
 namespace mindspore {
 namespace parallel {
@@ -56,6 +57,9 @@ class OperatorCost {
   void SetInputAndOutputTypeLength(const std::vector<size_t>& input_lengths, const std::vector<size_t>& output_lengths);
   std::vector<size_t> inputs_type_lengths() const { return inputs_type_lengths_; }
   std::vector<size_t> outputs_type_lengths() const { return outputs_type_lengths_; }
+  // the measured speed of the operator's type, which scales the costs below, see CostCalibration
+  void set_calibration(const OperatorCalibration& calibration) { calibration_ = calibration; }
+  const OperatorCalibration& calibration() const { return calibration_; }
 
   // per device communication cost
   virtual double GetCommCost(const std::vector<TensorInfo>& inputs, const std::vector<TensorInfo>& outputs,
@@ -78,6 +82,7 @@ class OperatorCost {
   // for each input and output, the followings record the number of bytes of each element
   std::vector<size_t> inputs_type_lengths_;
   std::vector<size_t> outputs_type_lengths_;
+  OperatorCalibration calibration_;
 };
 
 class MatMulCost : public OperatorCost {
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/auto_parallel/pipeline_stage.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "utils/convert_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+Status PartitionPipelineStages(const std::vector<double>& op_costs, int32_t stage_num, std::vector<int32_t>* stage_ids) {
+  MS_EXCEPTION_IF_NULL(stage_ids);
+  size_t op_num = op_costs.size();
+  if ((stage_num <= 0) || (IntToSize(stage_num) > op_num)) {
+    MS_LOG(ERROR) << "The stage number " << stage_num << " must be in [1, " << op_num << "].";
+    return FAILED;
+  }
+  auto stages = IntToSize(stage_num);
+  // prefix[i] is the total cost of the first i operators
+  std::vector<double> prefix(op_num + 1, 0.0);
+  for (size_t i = 0; i < op_num; ++i) {
+    prefix[i + 1] = prefix[i] + op_costs[i];
+  }
+  // bottleneck[s][i] is the minimal largest stage cost of the first i operators in s + 1 stages, and split[s][i] is
+  // the number of operators in the first s stages of that partition
+  const double inf = std::numeric_limits<double>::max();
+  std::vector<std::vector<double>> bottleneck(stages, std::vector<double>(op_num + 1, inf));
+  std::vector<std::vector<size_t>> split(stages, std::vector<size_t>(op_num + 1, 0));
+  for (size_t i = 1; i <= op_num; ++i) {
+    bottleneck[0][i] = prefix[i];
+  }
+  for (size_t s = 1; s < stages; ++s) {
+    for (size_t i = s + 1; i <= op_num; ++i) {
+      for (size_t j = s; j < i; ++j) {
+        double cost = std::max(bottleneck[s - 1][j], prefix[i] - prefix[j]);
+        if (cost < bottleneck[s][i]) {
+          bottleneck[s][i] = cost;
+          split[s][i] = j;
+        }
+      }
+    }
+  }
+
+  stage_ids->assign(op_num, 0);
+  size_t end = op_num;
+  for (size_t s = stages - 1; s > 0; --s) {
+    size_t begin = split[s][end];
+    std::fill(stage_ids->begin() + SizeToLong(begin), stage_ids->begin() + SizeToLong(end), SizeToInt(s));
+    end = begin;
+  }
+  MS_LOG(INFO) << "Partitioned " << op_num << " operators into " << stage_num << " pipeline stages, the largest cost "
+               << "of a stage is " << bottleneck[stages - 1][op_num] << ".";
+  return SUCCESS;
+}
+
+std::vector<MicroBatchStep> OneForwardOneBackwardSchedule(int32_t stage_id, int32_t stage_num,
+                                                          int32_t micro_batch_num) {
+  if ((stage_id < 0) || (stage_id >= stage_num) || (micro_batch_num <= 0)) {
+    MS_LOG(EXCEPTION) << "Invalid pipeline stage " << stage_id << " of " << stage_num << " stages with "
+                      << micro_batch_num << " micro-batches.";
+  }
+  std::vector<MicroBatchStep> schedule;
+  int32_t warmup = std::min(stage_num - stage_id, micro_batch_num);
+  int32_t next_forward = 0;
+  int32_t next_backward = 0;
+  for (; next_forward < warmup; ++next_forward) {
+    schedule.push_back({true, next_forward});
+  }
+  while (next_backward < micro_batch_num) {
+    schedule.push_back({false, next_backward++});
+    if (next_forward < micro_batch_num) {
+      schedule.push_back({true, next_forward++});
+    }
+  }
+  return schedule;
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,46 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_AUTO_PARALLEL_PIPELINE_STAGE_H_
+#define PARALLEL_AUTO_PARALLEL_PIPELINE_STAGE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "parallel/status.h"
+
+namespace mindspore {
+namespace parallel {
+// Partition the operators, given in topological order by their computation costs, into 'stage_num' contiguous
+// pipeline stages, such that the largest total cost of a stage is minimized. The stage of each operator is returned
+// in 'stage_ids', which is non-decreasing. The stages are the ones of the 'stage_map' of the DeviceManager, so the
+// strategies of the operators of a stage are searched on its devices.
+Status PartitionPipelineStages(const std::vector<double>& op_costs, int32_t stage_num, std::vector<int32_t>* stage_ids);
+
+struct MicroBatchStep {
+  bool forward;
+  int32_t micro_batch;
+};
+
+// The micro-batch schedule of stage 'stage_id' under 1F1B: the stage runs the forward of 'stage_num - stage_id'
+// micro-batches (at most 'micro_batch_num') to fill the pipeline, then alternates one backward and one forward, and
+// drains the remaining backwards. The gradients are accumulated over the micro-batches and applied once.
+std::vector<MicroBatchStep> OneForwardOneBackwardSchedule(int32_t stage_id, int32_t stage_num,
+                                                          int32_t micro_batch_num);
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // PARALLEL_AUTO_PARALLEL_PIPELINE_STAGE_H_
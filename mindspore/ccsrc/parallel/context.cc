@@ -32,6 +32,7 @@ namespace parallel {
 std::vector<std::string> PARALLEL_MODE_LIST = {STAND_ALONE, DATA_PARALLEL, HYBRID_PARALLEL, SEMI_AUTO_PARALLEL,
                                                AUTO_PARALLEL};
 std::vector<std::string> STRATEGY_SEARCH_MODE_LIST = {DYNAMIC_PROGRAMMING, RECURSIVE_PROGRAMMING};
+std::vector<std::string> GRADIENT_COMPRESSION_LIST = {NO_COMPRESSION, FP16_COMPRESSION, TOPK_COMPRESSION};
 
 std::shared_ptr<ParallelContext> ParallelContext::inst_context_ = nullptr;
 
@@ -56,6 +57,12 @@ void ParallelContext::Reset() {
   parallel_mode_ = STAND_ALONE;
   parameter_broadcast_ = false;
   parameter_broadcast_is_set_ = false;
+  enable_parallel_optimizer_ = false;
+  enable_hierarchical_allreduce_ = false;
+  devices_per_node_ = DEFAULT_DEVICES_PER_NODE;
+  gradient_compression_ = NO_COMPRESSION;
+  topk_compression_ratio_ = DEFAULT_TOPK_COMPRESSION_RATIO;
+  enable_alltoall_ = false;
 }
 
 void ParallelContext::set_device_num(int32_t device_num) {
@@ -98,6 +105,37 @@ bool ParallelContext::set_strategy_search_mode(const std::string& strategy_searc
   return true;
 }
 
+void ParallelContext::set_enable_parallel_optimizer(bool enable_parallel_optimizer) {
+  enable_parallel_optimizer_ = enable_parallel_optimizer;
+}
+
+void ParallelContext::set_enable_hierarchical_allreduce(bool enable_hierarchical_allreduce) {
+  enable_hierarchical_allreduce_ = enable_hierarchical_allreduce;
+}
+
+void ParallelContext::set_devices_per_node(int32_t devices_per_node) { devices_per_node_ = devices_per_node; }
+
+bool ParallelContext::set_gradient_compression(const std::string& gradient_compression) {
+  auto iter = std::find(GRADIENT_COMPRESSION_LIST.begin(), GRADIENT_COMPRESSION_LIST.end(), gradient_compression);
+  if (iter == GRADIENT_COMPRESSION_LIST.end()) {
+    MS_LOG(INFO) << "Invalid gradient compression: " << gradient_compression;
+    return false;
+  }
+  gradient_compression_ = gradient_compression;
+  return true;
+}
+
+bool ParallelContext::set_topk_compression_ratio(float topk_compression_ratio) {
+  if ((topk_compression_ratio <= 0) || (topk_compression_ratio > 1)) {
+    MS_LOG(INFO) << "Invalid topk compression ratio: " << topk_compression_ratio;
+    return false;
+  }
+  topk_compression_ratio_ = topk_compression_ratio;
+  return true;
+}
+
+void ParallelContext::set_enable_alltoall(bool enable_alltoall) { enable_alltoall_ = enable_alltoall; }
+
 void ParallelContext::set_parameter_broadcast(bool parameter_broadcast) {
   parameter_broadcast_ = parameter_broadcast;
   parameter_broadcast_is_set_ = true;
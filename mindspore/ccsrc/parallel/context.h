@@ -38,6 +38,14 @@ constexpr char SEMI_AUTO_PARALLEL[] = "semi_auto_parallel";
 constexpr char DYNAMIC_PROGRAMMING[] = "dynamic_programming";
 constexpr char RECURSIVE_PROGRAMMING[] = "recursive_programming";
 
+// An Ascend server holds 8 devices
+constexpr int32_t DEFAULT_DEVICES_PER_NODE = 8;
+
+constexpr char NO_COMPRESSION[] = "none";
+constexpr char FP16_COMPRESSION[] = "fp16";
+constexpr char TOPK_COMPRESSION[] = "topk";
+constexpr float DEFAULT_TOPK_COMPRESSION_RATIO = 0.01;
+
 class ParallelContext {
  public:
   ~ParallelContext() = default;
@@ -73,6 +81,29 @@ class ParallelContext {
   void set_parameter_broadcast(bool parameter_broadcast);
   bool parameter_broadcast() const { return parameter_broadcast_; }
 
+  // In data parallel, shard the optimizer states of the parameters across the devices
+  void set_enable_parallel_optimizer(bool enable_parallel_optimizer);
+  bool enable_parallel_optimizer() const { return enable_parallel_optimizer_; }
+
+  // All-reduce the gradients of the parameters by a reduce-scatter in each node, an allreduce across the nodes and
+  // an all-gather in each node, the nodes hold 'devices_per_node' consecutive ranks
+  void set_enable_hierarchical_allreduce(bool enable_hierarchical_allreduce);
+  bool enable_hierarchical_allreduce() const { return enable_hierarchical_allreduce_; }
+  void set_devices_per_node(int32_t devices_per_node);
+  int32_t devices_per_node() const { return devices_per_node_; }
+
+  // In data parallel, compress the gradients all-reduced: "fp16" all-reduces them in float16, "topk" all-gathers
+  // the largest 'topk_compression_ratio' of their elements, and both keep the compression error as a residual which
+  // is added to the gradients of the next step
+  bool set_gradient_compression(const std::string& gradient_compression);
+  std::string gradient_compression() const { return gradient_compression_; }
+  bool set_topk_compression_ratio(float topk_compression_ratio);
+  float topk_compression_ratio() const { return topk_compression_ratio_; }
+
+  // Redistribute the tensors by all-to-all, where an all-gather would be followed by a split of another dimension
+  void set_enable_alltoall(bool enable_alltoall);
+  bool enable_alltoall() const { return enable_alltoall_; }
+
   bool device_num_is_set() const { return device_num_is_set_; }
   bool global_rank_is_set() const { return global_rank_is_set_; }
   bool parameter_broadcast_is_set() const { return parameter_broadcast_is_set_; }
@@ -96,6 +127,12 @@ class ParallelContext {
   std::string parallel_mode_;
   std::string strategy_search_mode_;
   bool parameter_broadcast_;
+  bool enable_parallel_optimizer_;
+  bool enable_hierarchical_allreduce_;
+  int32_t devices_per_node_;
+  std::string gradient_compression_;
+  float topk_compression_ratio_;
+  bool enable_alltoall_;
   bool device_num_is_set_;
   bool global_rank_is_set_;
   bool parameter_broadcast_is_set_;
@@ -46,6 +46,13 @@ void CostModelContext::ResetCostModel() {
   costmodel_communi_threshold_ = DEFAULT_COST_MODEL_COMMUNI_THRESHOLD;
   costmodel_communi_const_ = DEFAULT_COST_MODEL_COMMUNI_CONST;
   costmodel_communi_bias_ = DEFAULT_COST_MODEL_COMMUNI_BIAS;
+  costmodel_calibration_file_ = "";
+  costmodel_devices_per_node_ = 0;
+  costmodel_nodes_per_rack_ = 0;
+  costmodel_intra_rack_bandwidth_ratio_ = 1.0;
+  costmodel_inter_rack_bandwidth_ratio_ = 1.0;
+  costmodel_intra_rack_latency_ = 0.0;
+  costmodel_inter_rack_latency_ = 0.0;
   costmodel_allreduce_fusion_algorithm_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALGORITHM;
   costmodel_allreduce_fusion_times_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_TIMES;
   costmodel_allreduce_fusion_tail_percent_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_TAIL_PERCENT;
@@ -54,6 +61,7 @@ void CostModelContext::ResetCostModel() {
   costmodel_allreduce_fusion_allreduce_bandwidth_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALLREDUCE_BANDWIDTH;
   costmodel_allreduce_fusion_computation_time_parameter_ =
     DEFAULT_COST_MODEL_ALLREDUCE_FUSION_COMPUTATION_TIME_PARAMETER;
+  costmodel_allreduce_fusion_bucket_size_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_BUCKET_SIZE;
 }
 
 void CostModelContext::ResetAlgoParameters() {
@@ -84,6 +92,34 @@ void CostModelContext::set_costmodel_communi_const(double cm_communi_const) {
 
 void CostModelContext::set_costmodel_communi_bias(double cm_communi_bias) { costmodel_communi_bias_ = cm_communi_bias; }
 
+void CostModelContext::set_costmodel_calibration_file(const std::string& calibration_file) {
+  costmodel_calibration_file_ = calibration_file;
+}
+
+void CostModelContext::set_costmodel_devices_per_node(int32_t devices_per_node) {
+  costmodel_devices_per_node_ = devices_per_node;
+}
+
+void CostModelContext::set_costmodel_nodes_per_rack(int32_t nodes_per_rack) {
+  costmodel_nodes_per_rack_ = nodes_per_rack;
+}
+
+void CostModelContext::set_costmodel_intra_rack_bandwidth_ratio(double intra_rack_bandwidth_ratio) {
+  costmodel_intra_rack_bandwidth_ratio_ = intra_rack_bandwidth_ratio;
+}
+
+void CostModelContext::set_costmodel_inter_rack_bandwidth_ratio(double inter_rack_bandwidth_ratio) {
+  costmodel_inter_rack_bandwidth_ratio_ = inter_rack_bandwidth_ratio;
+}
+
+void CostModelContext::set_costmodel_intra_rack_latency(double intra_rack_latency) {
+  costmodel_intra_rack_latency_ = intra_rack_latency;
+}
+
+void CostModelContext::set_costmodel_inter_rack_latency(double inter_rack_latency) {
+  costmodel_inter_rack_latency_ = inter_rack_latency;
+}
+
 void CostModelContext::set_costmodel_allreduce_fusion_algorithm(int32_t algorithm) {
   costmodel_allreduce_fusion_algorithm_ = algorithm;
 }
@@ -112,6 +148,10 @@ void CostModelContext::set_costmodel_allreduce_fusion_computation_time_parameter
   costmodel_allreduce_fusion_computation_time_parameter_ = computation_time_parameter;
 }
 
+void CostModelContext::set_costmodel_allreduce_fusion_bucket_size(double bucket_size) {
+  costmodel_allreduce_fusion_bucket_size_ = bucket_size;
+}
+
 void CostModelContext::set_tensor_slice_alignment_enable(bool ts_align) { tensor_slice_alignment_enable_ = ts_align; }
 
 void CostModelContext::set_tensor_slice_alignment_size(size_t ts_align_size) {
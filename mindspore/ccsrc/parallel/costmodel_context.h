@@ -67,6 +67,29 @@ class CostModelContext {
   void set_costmodel_communi_bias(double);
   double costmodel_communi_bias() const { return costmodel_communi_bias_; }
 
+  // COST_MODEL_CALIBRATION_FILE
+  void set_costmodel_calibration_file(const std::string&);
+  const std::string& costmodel_calibration_file() const { return costmodel_calibration_file_; }
+
+  // COST_MODEL_TOPOLOGY: the hierarchical topology of the devices, see DeviceTopology
+  void set_costmodel_devices_per_node(int32_t);
+  int32_t costmodel_devices_per_node() const { return costmodel_devices_per_node_; }
+
+  void set_costmodel_nodes_per_rack(int32_t);
+  int32_t costmodel_nodes_per_rack() const { return costmodel_nodes_per_rack_; }
+
+  void set_costmodel_intra_rack_bandwidth_ratio(double);
+  double costmodel_intra_rack_bandwidth_ratio() const { return costmodel_intra_rack_bandwidth_ratio_; }
+
+  void set_costmodel_inter_rack_bandwidth_ratio(double);
+  double costmodel_inter_rack_bandwidth_ratio() const { return costmodel_inter_rack_bandwidth_ratio_; }
+
+  void set_costmodel_intra_rack_latency(double);
+  double costmodel_intra_rack_latency() const { return costmodel_intra_rack_latency_; }
+
+  void set_costmodel_inter_rack_latency(double);
+  double costmodel_inter_rack_latency() const { return costmodel_inter_rack_latency_; }
+
   void set_costmodel_allreduce_fusion_algorithm(int32_t);
   int32_t costmodel_allreduce_fusion_algorithm() const { return costmodel_allreduce_fusion_algorithm_; }
 
@@ -94,6 +117,9 @@ class CostModelContext {
     return costmodel_allreduce_fusion_computation_time_parameter_;
   }
 
+  void set_costmodel_allreduce_fusion_bucket_size(double);
+  double costmodel_allreduce_fusion_bucket_size() const { return costmodel_allreduce_fusion_bucket_size_; }
+
   // TENSOR_SLICE_ALIGNMENT_ENABLE
   void set_tensor_slice_alignment_enable(bool);
   bool tensor_slice_alignment_enable() const { return tensor_slice_alignment_enable_; }
@@ -138,6 +164,17 @@ class CostModelContext {
   // COST_MODEL_COMMUNI_BIAS
   double costmodel_communi_bias_;
 
+  // COST_MODEL_CALIBRATION_FILE
+  std::string costmodel_calibration_file_;
+
+  // COST_MODEL_TOPOLOGY
+  int32_t costmodel_devices_per_node_;
+  int32_t costmodel_nodes_per_rack_;
+  double costmodel_intra_rack_bandwidth_ratio_;
+  double costmodel_inter_rack_bandwidth_ratio_;
+  double costmodel_intra_rack_latency_;
+  double costmodel_inter_rack_latency_;
+
   int32_t costmodel_allreduce_fusion_algorithm_;
 
   int32_t costmodel_allreduce_fusion_times_;
@@ -152,6 +189,8 @@ class CostModelContext {
 
   double costmodel_allreduce_fusion_computation_time_parameter_;
 
+  double costmodel_allreduce_fusion_bucket_size_;
+
   // TENSOR_SLICE_ALIGNMENT_ENABLE
   bool tensor_slice_alignment_enable_;
 
@@ -121,6 +121,63 @@ std::shared_ptr<Device> GetListMemberByIndex(size_t index, const std::list<std::
   return result;
 }
 
+TopologyLevel DeviceTopology::GetLevel(int32_t rank_span) const {
+  if ((devices_per_node <= 0) || (rank_span <= devices_per_node)) {
+    return INTRA_NODE;
+  }
+  if ((nodes_per_rack <= 0) || (rank_span <= devices_per_node * nodes_per_rack)) {
+    return INTRA_RACK;
+  }
+  return INTER_RACK;
+}
+
+double DeviceTopology::CommunicationCost(double bytes, TopologyLevel level) const {
+  if (bytes <= 0.0) {
+    return 0.0;
+  }
+  return bytes / bandwidth_ratio[level] + latency[level];
+}
+
+// E.g. ranks = [0, 1, 2, 3, 4, 5, 6, 7], rank = 5, devices_per_node = 4,
+// therefore intra_ranks = [4, 5, 6, 7] and inter_ranks = [1, 5].
+Status SplitRanksByNode(const RankList& ranks, int32_t rank, int32_t devices_per_node, RankList* intra_ranks,
+                        RankList* inter_ranks) {
+  MS_EXCEPTION_IF_NULL(intra_ranks);
+  MS_EXCEPTION_IF_NULL(inter_ranks);
+  if (devices_per_node <= 0) {
+    MS_LOG(ERROR) << "The devices per node must be positive, but got " << devices_per_node;
+    return Status::FAILED;
+  }
+  std::map<int32_t, std::vector<int32_t>> node_ranks;
+  for (auto& group_rank : ranks) {
+    node_ranks[group_rank / devices_per_node].push_back(group_rank);
+  }
+  auto local_node = node_ranks.find(rank / devices_per_node);
+  if ((local_node == node_ranks.end()) || (node_ranks.size() == 1) || (local_node->second.size() == 1)) {
+    return Status::FAILED;
+  }
+  auto local_ranks = local_node->second;
+  std::sort(local_ranks.begin(), local_ranks.end());
+  auto position = std::find(local_ranks.begin(), local_ranks.end(), rank);
+  if (position == local_ranks.end()) {
+    return Status::FAILED;
+  }
+  size_t index = LongToSize(position - local_ranks.begin());
+  intra_ranks->clear();
+  inter_ranks->clear();
+  for (auto& node : node_ranks) {
+    if (node.second.size() != local_ranks.size()) {
+      MS_LOG(INFO) << "The group has " << node.second.size() << " ranks in node " << node.first << " but "
+                   << local_ranks.size() << " ranks in node " << local_node->first;
+      return Status::FAILED;
+    }
+    std::sort(node.second.begin(), node.second.end());
+    inter_ranks->push_back(node.second[index]);
+  }
+  (void)intra_ranks->insert(intra_ranks->end(), local_ranks.begin(), local_ranks.end());
+  return Status::SUCCESS;
+}
+
 // E.g. devices = [4, 5, 2, 1, 7, 8, 10], stage_map = [4, 3],
 // therefore the stage_devices_ = [[4, 5, 2, 1], [7, 8, 10]].
 Status DeviceManager::Init(const RankList& devices, int32_t global_device_rank, const RankList& stage_map,
@@ -305,6 +362,21 @@ std::string DeviceManager::FindRankListNameByHashName(const std::string& hash_na
   return iter->second;
 }
 
+Status DeviceManager::GetGroupRanks(const std::string& group_name, RankList* ranks) {
+  MS_EXCEPTION_IF_NULL(ranks);
+  Group* group = nullptr;
+  if (gm_.FindGroup(group_name, &group) != Status::SUCCESS) {
+    MS_LOG(ERROR) << "Can not find the group " << group_name;
+    return Status::FAILED;
+  }
+  MS_EXCEPTION_IF_NULL(group);
+  ranks->clear();
+  for (auto& device : group->GetDevicesList()) {
+    ranks->push_back(device.rank());
+  }
+  return Status::SUCCESS;
+}
+
 std::string HashName(const std::string& origin_name) { return std::to_string(std::hash<string>{}(origin_name)); }
 
 // Group name is generated using the increasing ranks of the devices.
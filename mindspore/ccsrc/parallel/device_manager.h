@@ -24,6 +24,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "utils/convert_utils.h"
 #include "common/utils.h"
@@ -76,6 +77,31 @@ void CheckGlobalDeviceManager();
 
 std::string HashName(const std::string& rank_list_name);
 
+enum TopologyLevel { INTRA_NODE = 0, INTRA_RACK, INTER_RACK, TOPOLOGY_LEVEL_NUM };
+
+// The hierarchical topology of the devices, in which consecutive ranks share a node and consecutive nodes share a
+// rack. The communication bandwidth of each level is given relative to the intra-node one, and the latency of
+// a collective on each level is given in bytes of the intra-node bandwidth. 'devices_per_node' 0 means the
+// devices are fully connected, and all collectives are costed as intra-node ones.
+struct DeviceTopology {
+  int32_t devices_per_node = 0;
+  int32_t nodes_per_rack = 0;
+  double bandwidth_ratio[TOPOLOGY_LEVEL_NUM] = {1.0, 1.0, 1.0};
+  double latency[TOPOLOGY_LEVEL_NUM] = {0.0, 0.0, 0.0};
+
+  // The level of the links used by a group of devices whose ranks span 'rank_span' consecutive ranks.
+  TopologyLevel GetLevel(int32_t rank_span) const;
+  // The cost of a collective moving 'bytes' on the links of 'level', in bytes of the intra-node bandwidth.
+  double CommunicationCost(double bytes, TopologyLevel level) const;
+};
+
+// Split the ranks of a group by the nodes, each of which holds 'devices_per_node' consecutive ranks. 'intra_ranks'
+// are the ranks of the group in the node of 'rank', and 'inter_ranks' are the ranks of the group in the other nodes
+// at the same position as 'rank' in its node. It fails if the group is in one node, has one rank in each node, or
+// has different numbers of ranks in the nodes, where the hierarchical collectives do not apply.
+Status SplitRanksByNode(const RankList& ranks, int32_t rank, int32_t devices_per_node, RankList* intra_ranks,
+                        RankList* inter_ranks);
+
 class DeviceManager {
   // This class is used to manage the abstract devices, including group-related and stage-related management.
  public:
@@ -94,6 +120,7 @@ class DeviceManager {
   std::string GenerateGroupNameByRanks(RankList dev_ranks);
   Group CreateGroup(const std::string& group_name, const std::list<Device>& devices);
   Group CreateGroup(const RankList& dev_ranks);
+  Status InitGroups(const std::vector<std::string>& group_names) { return gm_.InitGroups(group_names); }
   std::shared_ptr<Stage> GetStageById(int32_t stage_id);
 
   size_t DeviceNum() const { return devices_.size(); }
@@ -106,6 +133,9 @@ class DeviceManager {
   void Clear();
   std::string world_group() const { return gm_.world_group(); }
   std::string FindRankListNameByHashName(const std::string& hash_name);
+  Status GetGroupRanks(const std::string& group_name, RankList* ranks);
+  void set_topology(const DeviceTopology& topology) { topology_ = topology; }
+  const DeviceTopology& topology() const { return topology_; }
 
  private:
   std::list<std::shared_ptr<Device>> devices_;
@@ -123,6 +153,7 @@ class DeviceManager {
   int32_t local_rank_;
   int32_t global_rank_;
   int32_t stage_num_;
+  DeviceTopology topology_;
 };
 }  // namespace parallel
 }  // namespace mindspore
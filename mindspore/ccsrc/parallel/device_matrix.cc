@@ -149,6 +149,21 @@ Status DeviceMatrix::GetDevicesByTensorMap(const Shape& tensor_map, RankList* ra
   return SUCCESS;
 }
 
+int32_t GetRankSpanAlongDims(const Shape& dev_shape, const std::vector<size_t>& dims) {
+  int32_t span = 1;
+  for (auto dim : dims) {
+    if (dim >= dev_shape.size()) {
+      MS_LOG(EXCEPTION) << "The dimension " << dim << " is out of the size of the device shape!";
+    }
+    int32_t stride = 1;
+    for (size_t i = dim + 1; i < dev_shape.size(); i++) {
+      stride = stride * dev_shape[i];
+    }
+    span += (dev_shape[dim] - 1) * stride;
+  }
+  return span;
+}
+
 std::string ShapeToString(const Shape& shape) {
   std::string str = "[";
   for (size_t i = 0; i < shape.size(); ++i) {
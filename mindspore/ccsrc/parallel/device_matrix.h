@@ -49,6 +49,10 @@ class DeviceMatrix {
   std::list<RankList> group_list_;
 };
 
+// The number of consecutive ranks spanned by the groups of devices along 'dims' of 'dev_shape', where the last
+// dimension of 'dev_shape' is the contiguous one. E.g. dev_shape = [2, 4], dims = [0], the group is [0, 4] and
+// the span is 5.
+int32_t GetRankSpanAlongDims(const Shape& dev_shape, const std::vector<size_t>& dims);
 std::string ShapeToString(const Shape& shape);
 std::string ListToString(const std::list<int32_t>& list);
 }  // namespace parallel
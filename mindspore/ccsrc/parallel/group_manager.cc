@@ -18,6 +18,9 @@
 
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "parallel/device_manager.h"
 #include "parallel/ops_info/ops_utils.h"
@@ -99,16 +102,70 @@ Status GroupManager::CreateGroup(const std::string &group_name, const std::list<
     vector<uint32_t> ranks;
     (void)std::transform(std::begin(devices), std::end(devices), std::back_inserter(ranks),
                          [](const Device dev) { return (uint32_t)dev.rank(); });
-    // Create group through the CommManager interface
-    bool ret = CommManager::GetInstance().CreateGroupSync(group_name, ranks);
-    if (!ret) {
-      MS_LOG(ERROR) << "Create group failed, group name is " << group_name;
-      return Status::FAILED;
-    }
+    // The communicator is created through the CommManager interface when the group is used
+    pending_groups_[group_name] = ranks;
+    MS_LOG(INFO) << "Create group success, group name is " << group_name << ", its communicator is created on use";
+    return Status::SUCCESS;
+  }
+}
 
-    MS_LOG(INFO) << "Create group success, group name is " << group_name;
+Status GroupManager::InitGroup(const std::string &name) { return InitGroups({name}); }
+
+Status GroupManager::InitGroups(const std::vector<std::string> &names) {
+  std::vector<std::pair<std::string, std::vector<uint32_t>>> todo;
+  for (auto &name : names) {
+    auto it = pending_groups_.find(name);
+    if (it != pending_groups_.end()) {
+      todo.push_back(*it);
+      (void)pending_groups_.erase(it);
+    }
+  }
+  if (todo.empty()) {
     return Status::SUCCESS;
   }
+  // Creating a communicator waits for all the devices of the group. Every device creates its groups in the order of
+  // the names, so the first group not created is started by all its devices and none of the threads wait forever.
+  std::sort(todo.begin(), todo.end());
+
+  std::vector<char> results(todo.size(), 0);
+  std::vector<double> costs(todo.size(), 0.0);
+  std::atomic<size_t> next(0);
+  auto create_groups = [&todo, &results, &costs, &next]() {
+    for (size_t i = next++; i < todo.size(); i = next++) {
+      auto start = std::chrono::steady_clock::now();
+      results[i] = CommManager::GetInstance().CreateGroupSync(todo[i].first, todo[i].second) ? 1 : 0;
+      costs[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+  };
+  size_t thread_num = std::min(todo.size(), MAX_GROUP_INIT_THREADS);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    threads.emplace_back(create_groups);
+  }
+  create_groups();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  Status status = Status::SUCCESS;
+  double total_cost = 0.0;
+  for (size_t i = 0; i < todo.size(); ++i) {
+    total_cost += costs[i];
+    if (results[i] == 0) {
+      MS_LOG(ERROR) << "Create group failed, group name is " << todo[i].first;
+      status = Status::FAILED;
+      continue;
+    }
+    MS_LOG(INFO) << "Create communicator of group " << todo[i].first << " with " << todo[i].second.size()
+                 << " devices, used time: " << costs[i] << " ms";
+  }
+  MS_LOG(INFO) << "Created the communicators of " << todo.size() << " groups by " << thread_num
+               << " threads, the sum of their used time: " << total_cost << " ms";
+  return status;
+}
+
+bool GroupManager::IsGroupInitialized(const std::string &name) const {
+  return groups_.find(name) != groups_.end() && pending_groups_.find(name) == pending_groups_.end();
 }
 
 Status GroupManager::DestroyGroup(mindspore::parallel::Group *const group) {
@@ -119,6 +176,10 @@ Status GroupManager::DestroyGroup(mindspore::parallel::Group *const group) {
     return Status::FAILED;
   }
   (void)groups_.erase(it);
+  // There is no communicator to destroy if the group was never used
+  if (pending_groups_.erase(name) != 0) {
+    return Status::SUCCESS;
+  }
   bool ret = CommManager::GetInstance().DestroyGroup(name);
   if (!ret) {
     return Status::FAILED;
@@ -129,12 +190,16 @@ Status GroupManager::DestroyGroup(mindspore::parallel::Group *const group) {
 Status GroupManager::DestroyAllGroups() {
   for (auto &it : groups_) {
     std::string name = it.first;
+    if (pending_groups_.find(name) != pending_groups_.end()) {
+      continue;
+    }
     bool ret = CommManager::GetInstance().DestroyGroup(name);
     if (!ret) {
       return Status::FAILED;
     }
   }
   groups_.clear();
+  pending_groups_.clear();
   return Status::SUCCESS;
 }
 
@@ -144,6 +209,9 @@ Status GroupManager::GetRankID(const std::string &name, unsigned int *const rank
     MS_LOG(ERROR) << "Could not find group name :" << name;
     return Status::FAILED;
   }
+  if (InitGroup(name) != Status::SUCCESS) {
+    return Status::FAILED;
+  }
   bool ret = CommManager::GetInstance().GetRankID(name, rank_id);
   if (!ret) {
     return Status::FAILED;
@@ -157,6 +225,9 @@ Status GroupManager::GetRankSize(const std::string &name, unsigned int *const ra
     MS_LOG(ERROR) << "Could not find group name :" << name;
     return Status::FAILED;
   }
+  if (InitGroup(name) != Status::SUCCESS) {
+    return Status::FAILED;
+  }
   bool ret = CommManager::GetInstance().GetRankSize(name, rank_size);
   if (!ret) {
     return Status::FAILED;
@@ -21,6 +21,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "parallel/device.h"
 #include "parallel/status.h"
@@ -30,6 +31,8 @@ namespace parallel {
 constexpr char HCCL_WORLD_GROUP[] = "hccl_world_group";
 constexpr char NCCL_WORLD_GROUP[] = "nccl_world_group";
 constexpr char UNDEFINED_WORLD_GROUP[] = "undefined_world_group";
+// The max number of threads creating the communicators of the groups
+constexpr size_t MAX_GROUP_INIT_THREADS = 8;
 
 // Devices that need communication should in the same group. These classes are used to
 // create and destroy group among devices.
@@ -60,13 +63,21 @@ class GroupManager {
   Status GetRankID(const std::string& name, unsigned int* rank_id);
   Status GetRankSize(const std::string& name, unsigned int* rank_size);
   Status FindGroup(const std::string& name, Group** group);
+  // Create the communicators of the groups that are not created yet, the independent groups concurrently.
+  Status InitGroups(const std::vector<std::string>& names);
+  bool IsGroupInitialized(const std::string& name) const;
   std::string world_group() const { return world_group_; }
   void set_world_group(const std::string& name) { world_group_ = name; }
   void Clear();
 
  private:
+  Status InitGroup(const std::string& name);
+
   // the key is group name (name_)
   std::map<std::string, Group> groups_;
+  // The communicator of a group is only created when the group is used, since the strategy search creates many
+  // groups for the strategies it does not choose. These are the groups created but not used yet, with their ranks.
+  std::map<std::string, std::vector<uint32_t>> pending_groups_;
   std::string world_group_;
 };
 }  // namespace parallel
@@ -601,6 +601,9 @@ Status MatMulBase::SetCostUnderStrategy(const mindspore::parallel::StrategyPtr&
   result->communication_with_partial_para_ =
     result->communication_without_parameter_ +
     COST_MODEL_GAMMA * (communication_cost - result->communication_without_parameter_);
+  WeightCommCostForTopology(relica_inputs_tensor_vector, result);
+  // scale the analytical cost by the measured speed of the operator
+  CalibrateForMeasuredCost(result, matmulcost_ptr->calibration());
 
   // Breaking ties for preferring data parallelization
   BreakingTiesForPerferringDataParallel(strategy, result);
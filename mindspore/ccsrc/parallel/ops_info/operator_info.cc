@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <numeric>
 #include <vector>
 #include <utility>
 #include <memory>
@@ -259,6 +260,52 @@ OperatorVector CreateMirrorOps(const std::string& group_name, size_t dev_num) {
   return op_for_weight;
 }
 
+// The gradient is reduce-scattered in the node, all-reduced across the nodes on 1/N of the data, and all-gathered in
+// the node, the sub-groups of the mirror group are created by the GroupManager. Only hccl supports the sub-groups,
+// the gradient is all-reduced in the mirror group otherwise.
+void SetHierarchicalAllReduce(const Shape& slice_shape, Operator* mirror_op) {
+  MS_EXCEPTION_IF_NULL(mirror_op);
+  auto parallel_context = ParallelContext::GetInstance();
+  if (!parallel_context->enable_hierarchical_allreduce()) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  if (g_device_manager->backend() != HCCL_BACKEND) {
+    MS_LOG(INFO) << "The hierarchical allreduce is not supported by " << g_device_manager->backend();
+    return;
+  }
+  OperatorAttrs& attrs = mirror_op->second.first;
+  auto group_attr = std::find_if(attrs.begin(), attrs.end(), [](const Attr& attr) { return attr.first == GROUP; });
+  if (group_attr == attrs.end()) {
+    MS_LOG(EXCEPTION) << "The mirror op has no group attr";
+  }
+  std::string group_name = GetValue<std::string>(group_attr->second);
+  RankList group_ranks;
+  if (group_name == g_device_manager->world_group()) {
+    group_ranks = g_device_manager->GetDeviceListByStageId(0);
+  } else if (g_device_manager->GetGroupRanks(group_name, &group_ranks) != SUCCESS) {
+    return;
+  }
+  RankList intra_ranks, inter_ranks;
+  if (SplitRanksByNode(group_ranks, g_device_manager->global_rank(), parallel_context->devices_per_node(),
+                       &intra_ranks, &inter_ranks) != SUCCESS) {
+    return;
+  }
+  int32_t slice_size = std::accumulate(slice_shape.begin(), slice_shape.end(), 1, std::multiplies<int32_t>());
+  if (slice_size % SizeToInt(intra_ranks.size()) != 0) {
+    MS_LOG(INFO) << "The parameter slice of " << slice_size << " elements can not be reduce-scattered in "
+                 << intra_ranks.size() << " devices";
+    return;
+  }
+  Group intra_group = g_device_manager->CreateGroup(intra_ranks);
+  Group inter_group = g_device_manager->CreateGroup(inter_ranks);
+  attrs.push_back(std::make_pair(INTRA_GROUP, MakeValue(intra_group.name())));
+  attrs.push_back(std::make_pair(INTER_GROUP, MakeValue(inter_group.name())));
+  attrs.push_back(std::make_pair(INTRA_DEV_NUM, MakeValue(SizeToInt(intra_ranks.size()))));
+  MS_LOG(INFO) << "The gradient of the group " << group_name << " is all-reduced hierarchically, the intra-node "
+               << "group is " << intra_group.name() << ", the inter-node group is " << inter_group.name();
+}
+
 Status OperatorInfo::CreateGroupByTensorMap(const Shape& tensor_map, std::vector<Group>* group) {
   if (group == nullptr) {
     MS_LOG(ERROR) << "The group is null.";
@@ -1042,6 +1089,9 @@ Status OperatorInfo::SetCostUnderStrategyBase(const StrategyPtr& strategy) {
   result->communication_with_partial_para_ =
     result->communication_without_parameter_ +
     COST_MODEL_GAMMA * (communication_cost - result->communication_without_parameter_);
+  WeightCommCostForTopology(inputs_tensor_info_, result);
+  // scale the analytical cost by the measured speed of the operator
+  CalibrateForMeasuredCost(result, GetOperatorCost()->calibration());
 
   // Breaking ties for preferring data parallelization
   BreakingTiesForPerferringDataParallel(strategy, result);
@@ -1225,8 +1275,75 @@ void OperatorInfo::BreakingTiesForPerferringDataParallel(const StrategyPtr& stra
   }
 }
 
+namespace {
+// Mark the device dimensions which split the tensor. A tensor laid out on another device arrangement splits none.
+void MarkSplitDeviceDims(const TensorInfo& tensor_info, const Shape& dev_shape, std::vector<bool>* split_dims) {
+  TensorLayout layout = tensor_info.tensor_layout();
+  if (layout.device_arrangement().array() != dev_shape) {
+    return;
+  }
+  for (auto map : layout.tensor_map().array()) {
+    if ((map >= 0) && (IntToSize(map) < dev_shape.size())) {
+      (*split_dims)[dev_shape.size() - 1 - IntToSize(map)] = true;
+    }
+  }
+}
+}  // namespace
+
+// The forward collectives of an operator are along the device dimensions which split the inputs but not the outputs,
+// and the gradients of the parameters are reduced along the device dimensions which do not split them. Each part is
+// weighted by the level of the links its groups span.
+void OperatorInfo::WeightCommCostForTopology(const std::vector<TensorInfo>& inputs, const CostPtr& cost) const {
+  CheckGlobalDeviceManager();
+  const DeviceTopology& topology = g_device_manager->topology();
+  if ((topology.devices_per_node <= 0) || inputs.empty()) {
+    return;
+  }
+  Shape dev_shape = inputs[0].tensor_layout().device_arrangement().array();
+  std::vector<bool> inputs_split(dev_shape.size(), false);
+  std::vector<bool> outputs_split(dev_shape.size(), false);
+  for (auto& input : inputs) {
+    MarkSplitDeviceDims(input, dev_shape, &inputs_split);
+  }
+  for (auto& output : outputs_tensor_info_) {
+    MarkSplitDeviceDims(output, dev_shape, &outputs_split);
+  }
+  std::vector<size_t> forward_dims;
+  std::vector<size_t> backward_dims;
+  for (size_t i = 0; i < dev_shape.size(); ++i) {
+    if (dev_shape[i] <= 1) {
+      continue;
+    }
+    if (inputs_split[i] && !outputs_split[i]) {
+      forward_dims.push_back(i);
+    }
+    bool not_split_parameter = false;
+    for (size_t j = 0; (j < inputs.size()) && (j < is_parameter_.size()); ++j) {
+      if (!is_parameter_[j]) {
+        continue;
+      }
+      std::vector<bool> parameter_split(dev_shape.size(), false);
+      MarkSplitDeviceDims(inputs[j], dev_shape, &parameter_split);
+      not_split_parameter = not_split_parameter || !parameter_split[i];
+    }
+    if (not_split_parameter) {
+      backward_dims.push_back(i);
+    }
+  }
+
+  double forward_cost = topology.CommunicationCost(
+    cost->communication_without_parameter_, topology.GetLevel(GetRankSpanAlongDims(dev_shape, forward_dims)));
+  double backward_cost =
+    topology.CommunicationCost(cost->communication_cost_ - cost->communication_without_parameter_,
+                               topology.GetLevel(GetRankSpanAlongDims(dev_shape, backward_dims)));
+  cost->communication_cost_ = forward_cost + backward_cost;
+  cost->communication_without_parameter_ = forward_cost;
+  cost->communication_with_partial_para_ = forward_cost + COST_MODEL_GAMMA * backward_cost;
+}
+
 double OperatorInfo::GetForwardMemoryCostFromCNode() {
-  return GetOperatorCost()->GetForwardMemoryCost(inputs_tensor_info_, outputs_tensor_info_, 0);
+  return GetOperatorCost()->GetForwardMemoryCost(inputs_tensor_info_, outputs_tensor_info_, 0) *
+         GetOperatorCost()->calibration().computation_scale;
 }
 
 }  // namespace parallel
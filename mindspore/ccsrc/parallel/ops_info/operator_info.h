@@ -176,6 +176,8 @@ class OperatorInfo {
   Status InferSliceShape(const Strategys& inputs_strategy, const Strategys& outputs_strategy,
                          Shapes* inputs_slice_shape, Shapes* outputs_slice_shape);
   void BreakingTiesForPerferringDataParallel(const StrategyPtr&, const CostPtr&);
+  // Weight the communication cost by the topology level of the links the collectives of the operator use
+  void WeightCommCostForTopology(const std::vector<TensorInfo>& inputs, const CostPtr& cost) const;
 
   std::string name_;
   Shapes inputs_shape_;
@@ -234,6 +236,8 @@ Operator CreateVirtualDivOp(int32_t div_num);
 Operator CreateAllReduceOp(const std::string& reduce_op, const std::string& group);
 Operator CreateGetTensorSliceOp(const TensorLayout& tensor_layout);
 OperatorVector CreateMirrorOps(const std::string& group_name, size_t dev_num);
+// Let the MirrorOp all-reduce the gradient of the parameter slice hierarchically, if it is enabled and applies
+void SetHierarchicalAllReduce(const Shape& slice_shape, Operator* mirror_op);
 int32_t ComputeRepeatDeviceNumByTensorMap(const Shape& dev_matrix_shape, const Shape& tensor_map);
 std::shared_ptr<std::vector<std::vector<int32_t>>> GenerateBatchStrategiesBySplitFlag(
   const Shapes& shapes, const std::vector<bool>& split_flag_list);
@@ -105,6 +105,9 @@ constexpr char DEFAULT_INPUT[] = "default_input";
 constexpr char DTYPE[] = "dtype";
 constexpr char DEV_NUM[] = "dev_num";
 constexpr char MEAN_FLAG[] = "mean_flag";
+constexpr char INTRA_GROUP[] = "intra_group";
+constexpr char INTER_GROUP[] = "inter_group";
+constexpr char INTRA_DEV_NUM[] = "intra_dev_num";
 constexpr char TYPES[] = "types";
 constexpr char SHAPES[] = "shapes";
 constexpr char GETNEXT_NUM[] = "output_num";
@@ -32,12 +32,14 @@
 #include "optimizer/optimizer.h"
 #include "pipeline/pipeline.h"
 #include "pipeline/parse/python_adapter.h"
+#include "parallel/auto_parallel/cost_calibration.h"
 #include "parallel/auto_parallel/edge_costmodel.h"
 #include "parallel/auto_parallel/graph_costmodel.h"
 #include "parallel/step_parallel.h"
 #include "parallel/auto_parallel/dp_algo_costmodel.h"
 #include "parallel/ops_info/tmp_identity_info.h"
 #include "parallel/context.h"
+#include "parallel/strategy_checkpoint/parallel_strategy_checkpoint.h"
 #include "parallel/auto_parallel/rec_core/rec_partition.h"
 #include "parallel/auto_parallel/rec_core/rec_parse_graph.h"
 #include "parallel/auto_parallel/rec_core/rec_generate_strategy.h"
@@ -150,7 +152,7 @@ bool StepAutoParallel(const FuncGraphPtr &root, const opt::OptimizerPtr &) {
 
   // search parallelization strategy
   if (strategy_search_mode == DYNAMIC_PROGRAMMING) {
-    if (ParallelStrategySearch(all_nodes, root) != SUCCESS) {
+    if (ParallelStrategySearch(all_nodes, root, RestoreSearchedStrategy(all_nodes)) != SUCCESS) {
       MS_LOG(EXCEPTION) << "Auto-parallel strategy search failed when using DP searching mode";
     }
   } else if (strategy_search_mode == RECURSIVE_PROGRAMMING) {
@@ -345,7 +347,47 @@ bool IsAutoParallelCareNode(const CNodePtr &cnode) {
   return IsParallelCareNode(cnode) && IsSplittableOperator(prim->name());
 }
 
-OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &cnode) {
+// The name of the operator in the strategy checkpoint, it is empty if the strategy of the operator is not saved
+std::string GetCheckpointNodeName(const CNodePtr &cnode) {
+  PrimitivePtr prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+  MS_EXCEPTION_IF_NULL(prim);
+  if (prim->instance_name().empty()) {
+    return "";
+  }
+  MS_EXCEPTION_IF_NULL(cnode->scope());
+  return cnode->scope()->name() + std::string(CONNSYMBOL) + prim->instance_name();
+}
+
+StrategyMap RestoreSearchedStrategy(const std::vector<AnfNodePtr> &all_nodes) {
+  StrategyMap restored_strategies;
+  if (!StrategyCheckpoint::GetInstance().CheckPointOn() || !StrategyCheckpoint::GetInstance().CheckPointExit()) {
+    return restored_strategies;
+  }
+  StrategyMap saved_strategies;
+  FingerprintMap saved_fingerprints;
+  if (StrategyCheckpoint::GetInstance().Load(&saved_strategies, &saved_fingerprints) != SUCCESS) {
+    MS_LOG(WARNING) << "Load strategy checkpoint failed, the strategies are searched again";
+    return restored_strategies;
+  }
+  // The checkpoint is kept, so that the following runs of the same model reuse it too
+  for (auto &node : all_nodes) {
+    auto cnode = node->cast<CNodePtr>();
+    if ((cnode == nullptr) || !IsValueNode<Primitive>(cnode->input(0)) || !IsAutoParallelCareNode(cnode)) {
+      continue;
+    }
+    std::string node_name = GetCheckpointNodeName(cnode);
+    auto fingerprint = saved_fingerprints.find(node_name);
+    if ((fingerprint == saved_fingerprints.end()) || (fingerprint->second != OperatorFingerprint(cnode))) {
+      continue;
+    }
+    restored_strategies[node_name] = saved_strategies[node_name];
+  }
+  MS_LOG(INFO) << "Restored the strategies of " << restored_strategies.size() << " operators from the checkpoint";
+  return restored_strategies;
+}
+
+OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &cnode,
+                                      const StrategyPtr &restored_strategy) {
   auto attrs = prim->attrs();
   std::vector<Shapes> shape_list = ExtractShape(cnode);
   if (shape_list.empty()) {
@@ -366,6 +408,9 @@ OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &
     MS_LOG(ERROR) << "Setting the lengths of inputs and outputs failed for operator: " << operator_info->name();
     return nullptr;
   }
+  // Set the measured speed of this operator type, which scales the costs of the strategies
+  operator_info->GetOperatorCost()->set_calibration(
+    CostCalibration::GetInstance()->GetOperatorCalibration(prim->name()));
   // When the 'inputs' contains numerical values for some operators, these values should be extracted from
   // ANF graph
   auto &inputs = cnode->inputs();
@@ -386,6 +431,10 @@ OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &
     // Compute split_flag_list_, indicating which input has batch dimension. This is ONLY used for preparation for
     // BatchParallelInfo operator
     operator_info->ComputeBatchSplitFlagList();
+    // The operator is unchanged since its strategy was searched, then the strategy is the only candidate
+    if ((restored_strategy != nullptr) && (operator_info->SetCostUnderStrategy(restored_strategy) == SUCCESS)) {
+      return operator_info;
+    }
     if (operator_info->GenerateStrategies(0) != SUCCESS) {
       MS_LOG(ERROR) << "Strategy search for Operator " << operator_info->name() << " failed.";
       return nullptr;
@@ -419,10 +468,31 @@ OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &
   return operator_info;
 }
 
-Status ConstructCostGraphNodes(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &) {
+// Set the hierarchical topology of the devices, by which the communication costs are weighted
+void SetDeviceTopology() {
+  auto context = CostModelContext::GetInstance();
+  DeviceTopology topology;
+  topology.devices_per_node = context->costmodel_devices_per_node();
+  topology.nodes_per_rack = context->costmodel_nodes_per_rack();
+  topology.bandwidth_ratio[INTRA_RACK] = context->costmodel_intra_rack_bandwidth_ratio();
+  topology.bandwidth_ratio[INTER_RACK] = context->costmodel_inter_rack_bandwidth_ratio();
+  topology.latency[INTRA_RACK] = context->costmodel_intra_rack_latency();
+  topology.latency[INTER_RACK] = context->costmodel_inter_rack_latency();
+  if ((topology.bandwidth_ratio[INTRA_RACK] <= 0) || (topology.bandwidth_ratio[INTER_RACK] <= 0)) {
+    MS_LOG(EXCEPTION) << "The bandwidth ratios of the device topology must be positive, but got "
+                      << topology.bandwidth_ratio[INTRA_RACK] << " and " << topology.bandwidth_ratio[INTER_RACK];
+  }
+  CheckGlobalDeviceManager();
+  g_device_manager->set_topology(topology);
+}
+
+Status ConstructCostGraphNodes(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &,
+                               const StrategyMap &restored_strategies) {
   MS_LOG(INFO) << "Constructing nodes for cost graph begins.";
   entire_costgraph = std::make_shared<CostGraph>();
   entire_costgraph->SetDeviceMemoryAndCostParameter();
+  CostCalibration::GetInstance()->Load(CostModelContext::GetInstance()->costmodel_calibration_file());
+  SetDeviceTopology();
   bool new_operator = true, first_operator = true;
   std::string first_operator_cnode;
   size_t current_op_index = 0;
@@ -448,7 +518,12 @@ Status ConstructCostGraphNodes(const std::vector<AnfNodePtr> &all_nodes, const F
       new_operator = false;
     }
     if (new_operator) {
-      auto operator_info = CreateTheOperatorInfo(prim, cnode);
+      StrategyPtr restored_strategy = nullptr;
+      auto restored = restored_strategies.find(GetCheckpointNodeName(cnode));
+      if (restored != restored_strategies.end()) {
+        restored_strategy = restored->second;
+      }
+      auto operator_info = CreateTheOperatorInfo(prim, cnode, restored_strategy);
       if (operator_info == nullptr) {
         return FAILED;
       }
@@ -495,6 +570,7 @@ Status ConstructCostGraphNodes(const std::vector<AnfNodePtr> &all_nodes, const F
 void ConstructCostGraphEdges(const std::vector<AnfNodePtr> &all_nodes) {
   // Step 2
   MS_LOG(INFO) << "Constructing edges for cost graph begins.";
+  Edge::ClearRedistributionCostCache();
   for (auto &node : all_nodes) {
     auto cnode = node->cast<CNodePtr>();
     bool bool_result_cnode = (cnode == nullptr) || !IsValueNode<Primitive>(cnode->input(0));
@@ -822,7 +898,19 @@ void AugmentCostGraph(const std::vector<AnfNodePtr> &all_nodes) {
   }
 }
 
-Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root) {
+// Whether each operator has only one candidate strategy, which is configured or restored from the checkpoint
+bool IsStrategyDetermined() {
+  for (auto &op : entire_costgraph->GetOperators()) {
+    auto strategy_cost = op->GetStrategyCost();
+    if ((strategy_cost.size() != 1) || strategy_cost[0]->cost_list.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root,
+                              const StrategyMap &restored_strategies) {
   // There are 4 meta-steps to determine the parallelization strategy for the ANF graph.
   // Step 1: Traverse the ANF graph, and create NODEs for costgraph:
   //      create the OperatorInfo object for each primitive, and enumerate the parallelization strategies
@@ -841,46 +929,58 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   //      tensor layout. Note that there may be several connected components in the costgraph, and the DP algorithm
   //      runs on each of them.
   //
+  // The operators unchanged since the strategy checkpoint was saved only have their saved strategies as the
+  // candidates. If all operators are unchanged, Step 2 to Step 4 are skipped.
+  //
   // OUTPUT: the determined strategy for each operator.
 
   // Step 1
-  if (ConstructCostGraphNodes(all_nodes, root) == SUCCESS) {
+  if (ConstructCostGraphNodes(all_nodes, root, restored_strategies) == SUCCESS) {
     MS_LOG(INFO) << "Constructing nodes for cost graph succeeded. There are " << entire_costgraph->GetOperators().size()
                  << " operators.";
   } else {
     MS_LOG(EXCEPTION) << "Constructing nodes for cost graph failed.";
   }
 
-  // Step 2
-  ConstructCostGraphEdges(all_nodes);
-  MS_LOG(INFO) << "Constructing edges for cost graph succeeded. There are " << entire_costgraph->GetOperators().size()
-               << " operators, and " << entire_costgraph->GetNumPairs() << " edges.",
+  if (!restored_strategies.empty() && IsStrategyDetermined()) {
+    for (auto &op : entire_costgraph->GetOperators()) {
+      auto strategy_cost = op->GetStrategyCost()[0];
+      op->SetSelectedStrategyAndCost(strategy_cost->strategy_ptr, strategy_cost->cost_list[0]);
+    }
+    MS_LOG(INFO) << "All strategies are restored from the checkpoint, the strategy search is skipped.";
+  } else {
+    // Step 2
+    ConstructCostGraphEdges(all_nodes);
+    MS_LOG(INFO) << "Constructing edges for cost graph succeeded. There are "
+                 << entire_costgraph->GetOperators().size() << " operators, and " << entire_costgraph->GetNumPairs()
+                 << " edges.";
 
     // Step 3: Augment the costgraph.
     AugmentCostGraph(all_nodes);
-  MS_LOG(INFO) << "After the augmenting procedure, there are " << entire_costgraph->GetOperators().size()
-               << " operators, and " << entire_costgraph->GetNumPairs() << " edges.";
-
-  // Step 3.1: Correcting calculation for memory reuse
-  if (entire_costgraph->ComputeOpsAndEdgesParameterInvolved() == SUCCESS) {
-    // Correcting operators' memory usage
-    if (entire_costgraph->CorrectOpsStrategyCostForMemoryReuse() != SUCCESS) {
-      MS_LOG(EXCEPTION) << "Correcting operators' cost for memory reuse failed.";
-    }
-    // Correcting edges' memory usage
-    if (entire_costgraph->CorrectEdgesStrategyCostForMemoryReuse() != SUCCESS) {
-      MS_LOG(EXCEPTION) << "Correcting edges' cost for memory reuse failed.";
+    MS_LOG(INFO) << "After the augmenting procedure, there are " << entire_costgraph->GetOperators().size()
+                 << " operators, and " << entire_costgraph->GetNumPairs() << " edges.";
+
+    // Step 3.1: Correcting calculation for memory reuse
+    if (entire_costgraph->ComputeOpsAndEdgesParameterInvolved() == SUCCESS) {
+      // Correcting operators' memory usage
+      if (entire_costgraph->CorrectOpsStrategyCostForMemoryReuse() != SUCCESS) {
+        MS_LOG(EXCEPTION) << "Correcting operators' cost for memory reuse failed.";
+      }
+      // Correcting edges' memory usage
+      if (entire_costgraph->CorrectEdgesStrategyCostForMemoryReuse() != SUCCESS) {
+        MS_LOG(EXCEPTION) << "Correcting edges' cost for memory reuse failed.";
+      }
+    } else {
+      MS_LOG(EXCEPTION) << "Computing operators' parameter_involved failed.";
     }
-  } else {
-    MS_LOG(EXCEPTION) << "Computing operators' parameter_involved failed.";
-  }
 
-  // Step 4: run DP algorithm on the costgraph.
-  if (GetStrategy(entire_costgraph) != SUCCESS) {
-    MS_LOG(ERROR) << "Strategy search for cost-graph fails";
-    return FAILED;
+    // Step 4: run DP algorithm on the costgraph.
+    if (GetStrategy(entire_costgraph) != SUCCESS) {
+      MS_LOG(ERROR) << "Strategy search for cost-graph fails";
+      return FAILED;
+    }
+    MS_LOG(INFO) << "Searching strategy succeeded.";
   }
-  MS_LOG(INFO) << "Searching strategy succeeded.";
 
   if (entire_costgraph->InitSelectedStrategy() == SUCCESS) {
     MS_LOG(INFO) << "Init selected strategy succeeded.";
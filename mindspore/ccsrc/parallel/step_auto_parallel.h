@@ -25,6 +25,7 @@
 #include "optimizer/opt.h"
 #include "pipeline/pipeline.h"
 #include "parallel/status.h"
+#include "parallel/strategy_checkpoint/parallel_strategy_checkpoint.h"
 
 namespace mindspore {
 namespace parallel {
@@ -41,13 +42,20 @@ std::vector<bool> ExtractInputParameterByNode(const CNodePtr &node);
 
 std::vector<std::vector<size_t>> ExtractInputAndOutputTypeLengthByNode(const CNodePtr &node);
 
-Status ConstructCostGraphNodes(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root);
+void SetDeviceTopology();
+
+// Restore the strategies of the operators unchanged since the strategy checkpoint was saved
+StrategyMap RestoreSearchedStrategy(const std::vector<AnfNodePtr> &all_nodes);
+
+Status ConstructCostGraphNodes(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root,
+                               const StrategyMap &restored_strategies = StrategyMap());
 
 void ConstructCostGraphEdges(const std::vector<AnfNodePtr> &all_nodes);
 
 void AugmentCostGraph(const std::vector<AnfNodePtr> &all_nodes);
 
-Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root);
+Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root,
+                              const StrategyMap &restored_strategies = StrategyMap());
 
 Status ParallelStrategyRecSearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root);
 
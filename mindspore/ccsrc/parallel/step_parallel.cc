@@ -29,6 +29,8 @@
 
 #include "parallel/graph_util/graph_info.h"
 #include "ir/meta_tensor.h"
+#include "ir/dtype/type.h"
+#include "pipeline/static_analysis/abstract_value.h"
 #include "optimizer/optimizer.h"
 #include "parallel/dynamic_creator.h"
 #include "parallel/ops_info/matmul_info.h"
@@ -49,6 +51,8 @@ namespace mindspore {
 namespace parallel {
 const std::set<std::string> COMMUNICATION_OPS = {ALL_REDUCE, ALL_GATHER, ALL_TO_ALL, REDUCE_SCATTER};
 const std::set<std::string> INVALID_LOSS_OPS = {GET_NEXT, VIRTUALLOSS};
+// the bytes each device receives by the redistribution operators in the forward of a step
+static double redistribution_comm_bytes = 0.0;
 
 void SetCommunicationOpGroupLabel(std::vector<AnfNodePtr> new_node_input) {
   if (new_node_input.empty()) {
@@ -318,6 +322,17 @@ void Redistribution(const std::pair<AnfNodePtr, int>& node_pair, const OperatorI
     MS_LOG(EXCEPTION) << "Failure:InferTensorRedistribution failed";
   }
   MS_LOG(DEBUG) << "Redistribution size " << redistribution_oplist_ptr->first.size();
+  size_t type_byte = sizeof(float);
+  auto abstract = middle_node->abstract();
+  if ((abstract != nullptr) && abstract->isa<abstract::AbstractTensor>()) {
+    auto element = abstract->cast<abstract::AbstractTensorPtr>()->element();
+    MS_EXCEPTION_IF_NULL(element);
+    size_t element_byte = GetTypeByte(element->BuildType());
+    if (element_byte > 0) {
+      type_byte = element_byte;
+    }
+  }
+  redistribution_comm_bytes += tensor_redistribution.forward_comm_elements() * static_cast<double>(type_byte);
   if (!redistribution_oplist_ptr->first.empty()) {
     // insert node before next node
     InsertRedistribution(redistribution_oplist_ptr, next_node, func_graph, node_pair.second, pre_node);
@@ -869,6 +884,12 @@ void BackwardCommunication(const OperatorInfoPtr& distribute_operator, const CNo
   MS_EXCEPTION_IF_NULL(node);
   MirrorOps mirror_ops = distribute_operator->mirror_ops();
   VirtualDivOp virtual_div_op = distribute_operator->virtual_div_op();
+  std::vector<TensorInfo> inputs_tensor_info = distribute_operator->inputs_tensor_info();
+  for (size_t index = 0; (index < mirror_ops.size()) && (index < inputs_tensor_info.size()); ++index) {
+    for (auto& op : mirror_ops[index]) {
+      SetHierarchicalAllReduce(inputs_tensor_info[index].slice_shape(), &op);
+    }
+  }
   // insert mirror op
   if (!mirror_ops.empty()) {
     MS_LOG(INFO) << "insert mirror op for " << distribute_operator->name();
@@ -1098,6 +1119,21 @@ std::vector<Shapes> ExtractShape(const CNodePtr& node) {
   return shape_all;
 }
 
+std::string OperatorFingerprint(const CNodePtr& node) {
+  MS_EXCEPTION_IF_NULL(node);
+  PrimitivePtr prim = GetValueNode<PrimitivePtr>(node->input(0));
+  MS_EXCEPTION_IF_NULL(prim);
+  CheckGlobalDeviceManager();
+  std::string fingerprint = prim->name() + "@" + std::to_string(g_device_manager->GetDeviceListByStageId(0).size());
+  for (auto& shapes : ExtractShape(node)) {
+    fingerprint += "|";
+    for (auto& shape : shapes) {
+      fingerprint += ShapeToString(shape);
+    }
+  }
+  return fingerprint;
+}
+
 std::pair<AnfNodePtr, int> FindParallelCareNode(const AnfNodePtr& node) {
   MS_EXCEPTION_IF_NULL(node);
   FuncGraphPtr func_graph = node->func_graph();
@@ -1828,6 +1864,7 @@ void CheckpointStrategy(const FuncGraphPtr& func_graph) {
   MS_EXCEPTION_IF_NULL(func_graph);
   MS_LOG(INFO) << "Save strategy to checkpoint begin";
   StrategyMap straMap;
+  FingerprintMap fingerprintMap;
   auto ret = func_graph->get_return();
   auto all_nodes = DeepScopedGraphSearch(ret);
   for (auto& node : all_nodes) {
@@ -1848,9 +1885,10 @@ void CheckpointStrategy(const FuncGraphPtr& func_graph) {
       MS_EXCEPTION_IF_NULL(node->scope());
       std::string node_name = node->scope()->name() + std::string(CONNSYMBOL) + instance_name;
       straMap[node_name] = strategyPtr;
+      fingerprintMap[node_name] = OperatorFingerprint(cnode);
     }
   }
-  if (StrategyCheckpoint::GetInstance().Save(straMap) != SUCCESS) {
+  if (StrategyCheckpoint::GetInstance().Save(straMap, fingerprintMap) != SUCCESS) {
     MS_LOG(EXCEPTION) << "Save strategy checkpoint failed";
   }
 }
@@ -2096,6 +2134,29 @@ Status ParallelInit() {
   return SUCCESS;
 }
 
+void InitCommunicationGroups(const FuncGraphPtr& root) {
+  MS_EXCEPTION_IF_NULL(root);
+  std::vector<std::string> group_names;
+  std::vector<AnfNodePtr> all_nodes = DeepScopedGraphSearch(root->get_return());
+  for (auto& node : all_nodes) {
+    auto cnode = node->cast<CNodePtr>();
+    if ((cnode == nullptr) || !IsValueNode<Primitive>(cnode->input(0))) {
+      continue;
+    }
+    PrimitivePtr prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+    for (auto& attr_name : {GROUP, INTRA_GROUP, INTER_GROUP}) {
+      ValuePtr value = prim->GetAttr(attr_name);
+      if ((value != nullptr) && value->isa<StringImm>()) {
+        group_names.push_back(value->cast<StringImmPtr>()->value());
+      }
+    }
+  }
+  MS_EXCEPTION_IF_NULL(g_device_manager);
+  if (g_device_manager->InitGroups(group_names) != SUCCESS) {
+    MS_LOG(EXCEPTION) << "Create the communicators of the groups failed";
+  }
+}
+
 bool StepParallel(const FuncGraphPtr& root, const opt::OptimizerPtr& optimizer) {
   MS_EXCEPTION_IF_NULL(root);
   MS_EXCEPTION_IF_NULL(optimizer);
@@ -2114,6 +2175,7 @@ bool StepParallel(const FuncGraphPtr& root, const opt::OptimizerPtr& optimizer)
 
   MS_LOG(INFO) << "Now entering step parallel";
   DumpGraph(root, std::string(STEP_PARALLEL_BEGIN));
+  redistribution_comm_bytes = 0.0;
 
   pipeline::ResourceBasePtr res = optimizer->resource();
   MS_EXCEPTION_IF_NULL(res);
@@ -2161,6 +2223,11 @@ bool StepParallel(const FuncGraphPtr& root, const opt::OptimizerPtr& optimizer)
 
   // ForwardCommunication BackwardCommunication TensorRedistribution
   ParallelCommunication(root, all_nodes, manager);
+  MS_LOG(INFO) << "The redistribution operators communicate " << redistribution_comm_bytes
+               << " bytes per device in the forward of each step";
+
+  // Only the groups the graph ends up with get a communicator, not those of the strategies not chosen
+  InitCommunicationGroups(root);
 
   DumpGraph(root, std::string(STEP_PARALLEL_END));
 
@@ -101,6 +101,10 @@ std::vector<AnfNodePtr> FindParameterByRefKeyNode(const AnfNodePtr& node, const
 // Extract shape from anfnode
 std::vector<Shapes> ExtractShape(const CNodePtr& node);
 
+// The operator type, the shapes and the device number the strategy of the operator is determined by, used to check
+// whether a strategy in the strategy checkpoint is still the one searched for the operator
+std::string OperatorFingerprint(const CNodePtr& node);
+
 std::pair<AnfNodePtr, int> FindParallelCareNode(const AnfNodePtr& node);
 
 // Find finally sub graph
@@ -133,6 +137,9 @@ void ReshapeInit(const std::vector<AnfNodePtr>& all_nodes);
 void ParallelCommunication(const FuncGraphPtr& root, const std::vector<AnfNodePtr>& all_nodes,
                            const FuncGraphManagerPtr& manager);
 
+// Create the communicators of the groups used by the communication operators of the graph
+void InitCommunicationGroups(const FuncGraphPtr& root);
+
 void RestoreStrategy(const FuncGraphPtr& func_graph);
 
 void CheckpointStrategy(const FuncGraphPtr& func_graph);
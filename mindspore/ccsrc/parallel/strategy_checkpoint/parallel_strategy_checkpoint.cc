@@ -47,7 +47,7 @@ Status StrategyCheckpoint::RemoveCheckPoint() const {
   return FAILED;
 }
 
-Status StrategyCheckpoint::Load(StrategyMap* strategy_map) {
+Status StrategyCheckpoint::Load(StrategyMap* strategy_map, FingerprintMap* fingerprint_map) {
   if (strategy_map == nullptr) {
     MS_LOG(EXCEPTION) << "Failure:strategy_map is nullptr";
   }
@@ -77,18 +77,25 @@ Status StrategyCheckpoint::Load(StrategyMap* strategy_map) {
 
     StrategyPtr strategy = NewStrategy(stage, strategy_inputs);
     (*strategy_map)[node_name] = strategy;
+    if ((fingerprint_map != nullptr) && parallel_strategy_item.has_fingerprint()) {
+      (*fingerprint_map)[node_name] = parallel_strategy_item.fingerprint();
+    }
     current_train_time_ = (int32_t)parallel_strategy_map.train_time();
   }
   return SUCCESS;
 }
 
-Status StrategyCheckpoint::Save(const StrategyMap& strategy_map) {
+Status StrategyCheckpoint::Save(const StrategyMap& strategy_map, const FingerprintMap& fingerprint_map) {
   straspb::ParallelStrategyMap parallel_strategy_map;
   parallel_strategy_map.set_train_time(IntToUint(++current_train_time_));
   for (auto& node_stra : strategy_map) {
     straspb::ParallelStrategyItem* parallel_strategy_item = parallel_strategy_map.add_parallel_strategy_item();
     MS_EXCEPTION_IF_NULL(parallel_strategy_item);
     parallel_strategy_item->set_node_name(node_stra.first);
+    auto fingerprint = fingerprint_map.find(node_stra.first);
+    if (fingerprint != fingerprint_map.end()) {
+      parallel_strategy_item->set_fingerprint(fingerprint->second);
+    }
     straspb::ParallelStrategys* parallel_strategys = parallel_strategy_item->mutable_parallel_strategys();
     MS_EXCEPTION_IF_NULL(parallel_strategys);
     parallel_strategys->set_stage(IntToUint(node_stra.second->GetInputStage()));
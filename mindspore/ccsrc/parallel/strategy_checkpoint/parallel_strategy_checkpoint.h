@@ -27,6 +27,8 @@ namespace parallel {
 constexpr char DEFAULT_CHECKPOINT_PATH[] = "./strategys.ckpt";
 
 using StrategyMap = std::unordered_map<std::string, StrategyPtr>;
+// The fingerprints of the operators the strategies are saved for, used to check whether an operator is unchanged
+using FingerprintMap = std::unordered_map<std::string, std::string>;
 class StrategyCheckpoint {
  public:
   StrategyCheckpoint() : path_(DEFAULT_CHECKPOINT_PATH), current_train_time_(1) {
@@ -44,8 +46,8 @@ class StrategyCheckpoint {
   ~StrategyCheckpoint() = default;
   bool CheckPointExit() const;
   Status RemoveCheckPoint() const;
-  Status Load(StrategyMap* strategy_map);
-  Status Save(const StrategyMap& strategy_map);
+  Status Load(StrategyMap* strategy_map, FingerprintMap* fingerprint_map = nullptr);
+  Status Save(const StrategyMap& strategy_map, const FingerprintMap& fingerprint_map = FingerprintMap());
 
   static StrategyCheckpoint& GetInstance();
   int32_t GetTrainTimes() const { return train_times_; }
@@ -18,6 +18,7 @@
 
 #include <utility>
 
+#include "parallel/context.h"
 #include "parallel/device_manager.h"
 
 namespace mindspore {
@@ -34,6 +35,7 @@ Status RedistributionOperatorInfer::Init(const TensorLayout& tensor_layout, cons
   }
 
   cur_tensor_layout_ = tensor_layout;
+  in_tensor_layout_ = tensor_layout;
   out_tensor_map_ = out_tensor_map;
   dev_list_ = std::move(dev_list);
 
@@ -90,6 +92,67 @@ Status RedistributionOperatorInfer::InferRedistributionOperator() {
       }
     }
   }
+  return OptimizeOperatorList();
+}
+
+OperatorList MergeRedistributionOperators(const OperatorList& operator_list, bool enable_alltoall) {
+  OperatorList merged;
+  for (auto& op_cost : operator_list) {
+    if (merged.empty()) {
+      merged.push_back(op_cost);
+      continue;
+    }
+    const OperatorR& prev = merged.back().first;
+    const OperatorR& op = op_cost.first;
+    if ((prev.second.size() < 3) || (op.second.size() < 3)) {
+      merged.push_back(op_cost);
+      continue;
+    }
+    // SplitByAxis: {split_count, tensor_dim, dev_dim}, ConcatByAxis: {tensor_dim, dev_dim, split_count}
+    if ((prev.first == SPLIT_BY_AXIS) && (op.first == CONCAT_BY_AXIS) && (prev.second[1] == op.second[0]) &&
+        (prev.second[2] == op.second[1])) {
+      merged.pop_back();
+      continue;
+    }
+    if ((prev.first == CONCAT_BY_AXIS) && (op.first == SPLIT_BY_AXIS) && (prev.second[1] == op.second[2])) {
+      if (prev.second[0] == op.second[1]) {
+        merged.pop_back();
+        continue;
+      }
+      if (enable_alltoall) {
+        // PermuteByAxis: {split_count, split_dim, concat_dim, dev_dim}
+        Args args = {op.second[0], op.second[1], prev.second[0], op.second[2]};
+        merged.back().first = std::make_pair(PERMUTE_BY_AXIS, args);
+        continue;
+      }
+    }
+    merged.push_back(op_cost);
+  }
+  return merged;
+}
+
+Status RedistributionOperatorInfer::OptimizeOperatorList() {
+  OperatorList merged = MergeRedistributionOperators(operator_list_, ParallelContext::GetInstance()->enable_alltoall());
+  if (merged.size() == operator_list_.size()) {
+    return Status::SUCCESS;
+  }
+  MS_LOG(INFO) << "The redistribution operators are merged from " << operator_list_.size() << " to " << merged.size();
+  if (!construct_op_flag_) {
+    operator_list_ = merged;
+    return Status::SUCCESS;
+  }
+  // construct the operators of the merged list from the input layout again
+  operator_list_.clear();
+  operator_vector_.clear();
+  output_info_vector_.clear();
+  cur_tensor_layout_ = in_tensor_layout_;
+  constructor_.UpdateTensorShape(cur_tensor_layout_.slice_shape().array());
+  for (auto& op_cost : merged) {
+    if (InsertOperator(op_cost.first.first, op_cost.first.second) == Status::FAILED) {
+      MS_LOG(ERROR) << "Insert the merged operator " << op_cost.first.first << " failed";
+      return Status::FAILED;
+    }
+  }
   return Status::SUCCESS;
 }
 
@@ -217,8 +280,8 @@ Status RedistributionOperatorInfer::TransferSplitByAxis(Args args) {
 }
 
 Status RedistributionOperatorInfer::TransferPermuteByAxis(Args args) {
-  if (args.size() < 3) {
-    MS_LOG(ERROR) << "args size should not be less than 3!";
+  if (args.size() < 4) {
+    MS_LOG(ERROR) << "args size should not be less than 4!";
     return Status::FAILED;
   }
   if (constructor_.AlltoAllOP(args) != Status::SUCCESS) {
@@ -229,7 +292,7 @@ Status RedistributionOperatorInfer::TransferPermuteByAxis(Args args) {
   }
   uint32_t index = IntToUint(args[1]);
   int32_t val = args[2];
-  int32_t out_dim = out_tensor_map_.GetDimByIdx(index);
+  int32_t out_dim = args[3];
 
   if (cur_tensor_layout_.UpdateTensorMap(IntToUint(val), NONE) == Status::FAILED) {
     return Status::FAILED;
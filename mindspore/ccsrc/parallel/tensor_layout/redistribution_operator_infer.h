@@ -38,6 +38,11 @@ using OperatorR = std::pair<OperatorName, Args>;
 using OperatorC = std::pair<OperatorR, Shape>;
 using OperatorList = std::vector<OperatorC>;
 
+// Cancel the adjacent SplitByAxis and ConcatByAxis which are inverse of each other, and if 'enable_alltoall', replace
+// a ConcatByAxis followed by a SplitByAxis of another tensor dimension along the same device dimension with a
+// PermuteByAxis, which is an all-to-all instead of an all-gather.
+OperatorList MergeRedistributionOperators(const OperatorList& operator_list, bool enable_alltoall);
+
 class RedistributionOperatorInfer {
  public:
   const int NONE = -1;
@@ -57,6 +62,7 @@ class RedistributionOperatorInfer {
   Status TransferPermuteByAxis(Args args);
   Status TransferConcatByAxis(Args args);
   Status InsertOperator(OperatorName name, Args args);
+  Status OptimizeOperatorList();
 
   OperatorList operator_list_;
   OperatorVector operator_vector_;
@@ -66,6 +72,7 @@ class RedistributionOperatorInfer {
   Map in_tensor_map_;
   Map out_tensor_map_;
   TensorLayout cur_tensor_layout_;
+  TensorLayout in_tensor_layout_;
   ConstructOperator constructor_;
   RankList dev_list_;
   bool construct_op_flag_;
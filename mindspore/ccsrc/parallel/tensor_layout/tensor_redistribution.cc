@@ -76,6 +76,20 @@ RedistributionOpListPtr TensorRedistribution::InferTensorRedistributionOperatorL
     operator_vector = operator_infer.operator_vector();
     output_info_vector = operator_infer.output_info_vector();
     operator_list_ = operator_infer.operator_list();
+    dev_mat_ = from_layout.device_arrangement().array();
+  }
+  forward_comm_elements_ = 0.0;
+  for (auto& op_cost : operator_list_) {
+    const Args& args = op_cost.first.second;
+    double prod = std::accumulate(op_cost.second.begin(), op_cost.second.end(), static_cast<double>(1.0),
+                                  std::multiplies<double>());
+    if ((op_cost.first.first == CONCAT_BY_AXIS) && (args.size() >= 3)) {
+      // all_gather receives the slices of the other devices
+      forward_comm_elements_ += prod * (args[2] - 1);
+    } else if ((op_cost.first.first == PERMUTE_BY_AXIS) && (args.size() >= 1) && (args[0] > 0)) {
+      // all_to_all keeps one of the 'split_count' blocks
+      forward_comm_elements_ += prod * (args[0] - 1) / args[0];
+    }
   }
 
   // Step 3: Infer reshape and insert operators
@@ -138,12 +152,30 @@ Status TensorRedistribution::InferReshape(const TensorLayout& from_layout, const
   return Status::SUCCESS;
 }
 
+// The level of the links used by a collective along the device dimension 'reverse_dev_dim' (counted from the last
+// one), or along the whole device arrangement if it is -1.
+TopologyLevel TensorRedistribution::GetCommLevel(const DeviceTopology& topology, int32_t reverse_dev_dim) const {
+  std::vector<size_t> dims;
+  if ((reverse_dev_dim >= 0) && (IntToSize(reverse_dev_dim) < dev_mat_.size())) {
+    dims.push_back(dev_mat_.size() - 1 - IntToSize(reverse_dev_dim));
+  } else {
+    for (size_t i = 0; i < dev_mat_.size(); ++i) {
+      dims.push_back(i);
+    }
+  }
+  return topology.GetLevel(GetRankSpanAlongDims(dev_mat_, dims));
+}
+
 Status TensorRedistribution::ComputeCost() {
   RedistributionOpListPtr redistribution_oplist_ptr = InferTensorRedistributionOperatorList();
   if (redistribution_oplist_ptr == nullptr) {
     MS_LOG(ERROR) << "Failure: InferTensorRedistribution failed";
     return Status::FAILED;
   }
+  DeviceTopology topology;
+  if (g_device_manager != nullptr) {
+    topology = g_device_manager->topology();
+  }
   // Compute redistribution communication cost and memory cost
   for (auto& op_cost : operator_list_) {
     OperatorR op = op_cost.first;
@@ -155,9 +187,13 @@ Status TensorRedistribution::ComputeCost() {
       // The shape does not change after PermuteByAxis operation.
       // communication cost = all_to_all + all_to_all = 2 * slice_shape
       // memory cost = slice_shape
-      forward_comm_cost_ += prod;
-      backward_comm_cost_ += prod;
-      comm_cost_ += 2.0 * prod;
+      // the all_to_all is costed on the links spanned by the whole device arrangement
+      TopologyLevel level = GetCommLevel(topology, -1);
+      double comm_cost = prod / topology.bandwidth_ratio[level];
+      forward_comm_cost_ += comm_cost;
+      backward_comm_cost_ += comm_cost;
+      comm_cost_ += 2.0 * comm_cost;
+      comm_latency_ += topology.latency[level];
       mem_cost_ += prod;
     } else if (str == CONCAT_BY_AXIS) {
       // communication cost = all_gather + reduce_scatter = before_slice_shape + after_slice_shape
@@ -167,10 +203,14 @@ Status TensorRedistribution::ComputeCost() {
         return Status::FAILED;
       }
       double dev_num = op.second[2];
+      // the group of the all_gather is along the device dimension op.second[1]
+      TopologyLevel level = GetCommLevel(topology, op.second[1]);
+      double bandwidth_ratio = topology.bandwidth_ratio[level];
       // here, communication cost = all_gather + reduce_scatter
-      forward_comm_cost_ += prod * dev_num;
-      backward_comm_cost_ += prod;
-      comm_cost_ += prod * (dev_num + 1.0);
+      forward_comm_cost_ += prod * dev_num / bandwidth_ratio;
+      backward_comm_cost_ += prod / bandwidth_ratio;
+      comm_cost_ += prod * (dev_num + 1.0) / bandwidth_ratio;
+      comm_latency_ += topology.latency[level];
       int32_t concat_dim = op.second[0];
       if (concat_dim == 0) {
         // memory cost = all_gather
@@ -25,6 +25,7 @@
 #include <utility>
 
 #include "ir/value.h"
+#include "parallel/device_manager.h"
 #include "parallel/status.h"
 #include "parallel/tensor_layout/tensor_layout.h"
 #include "parallel/ops_info/operator_info.h"
@@ -41,7 +42,9 @@ class TensorRedistribution {
         comm_cost_(0.0),
         forward_comm_cost_(0.0),
         backward_comm_cost_(0.0),
+        comm_latency_(0.0),
         mem_cost_(0.0),
+        forward_comm_elements_(0.0),
         construct_op_flag_(construct_op_flag),
         keep_reshape_(keep_reshape) {}
   Status Init(const TensorLayout& from, const TensorLayout& to, const RankList& dev_list);
@@ -54,8 +57,13 @@ class TensorRedistribution {
   double mem_cost() const { return mem_cost_; }
   double forward_comm_cost() const { return forward_comm_cost_; }
   double backward_comm_cost() const { return backward_comm_cost_; }
+  // The latency of the collectives of each phase under the device topology, in bytes rather than elements
+  double comm_latency() const { return comm_latency_; }
+  // The number of elements each device receives by the operators in 'operator_list_' in forward
+  double forward_comm_elements() const { return forward_comm_elements_; }
 
  private:
+  TopologyLevel GetCommLevel(const DeviceTopology& topology, int32_t reverse_dev_dim) const;
   Status InferReshape(const TensorLayout& from_layout, const TensorLayout& to_layout,
                       OperatorVector* const operator_vector, OutPutInfoVector* const output_info_vector);
 
@@ -64,12 +72,16 @@ class TensorRedistribution {
   TensorLayout from_;
   TensorLayout to_;
   RankList dev_list_;
+  // the device arrangement the operators in 'operator_list_' are inferred on
+  Shape dev_mat_;
   OperatorList operator_list_;
   bool reshape_flag_;
   double comm_cost_;
   double forward_comm_cost_;
   double backward_comm_cost_;
+  double comm_latency_;
   double mem_cost_;
+  double forward_comm_elements_;
   bool construct_op_flag_;
   bool keep_reshape_;
 };
@@ -34,6 +34,7 @@
 #include "pipeline/remove_value_node_dup.h"
 #include "optimizer/optimizer.h"
 #include "vm/transform.h"
+#include "utils/context/ms_context.h"
 
 namespace mindspore {
 namespace pipeline {
@@ -41,6 +42,11 @@ using CompileGraphs = compile::CompileGraphs;
 using abstract::AnalysisResult;
 using mindspore::abstract::AnalysisContextPtr;
 
+namespace {
+// the primitives giving the values of the shapes of the tensors
+const std::vector<std::string> kShapeValuePrims = {"Shape", "Size", "array_len"};
+}  // namespace
+
 abstract::AnalysisResult AbstractAnalyze(const ResourcePtr& res, const FuncGraphPtr& func_graph,
                                          const abstract::AbstractBasePtrList& args_spec, bool clear) {
   MS_LOG(DEBUG) << "AbstractAnalyze start";
@@ -61,6 +67,9 @@ abstract::AnalysisResult AbstractAnalyze(const ResourcePtr& res, const FuncGraph
     }
   }
   auto ret = engine->Run(func_graph, args_spec);
+  if (engine->HasEvaluatedPrim(kShapeValuePrims)) {
+    res->SetResult(kShapeSpecialized, true);
+  }
   MS_LOG(DEBUG) << "AbstractAnalyze end";
   return ret;
 }
@@ -294,6 +303,46 @@ bool RemoveValueNodeDuplicationsAction(const ResourcePtr& res) {
 
 bool ValidateAction(const ResourcePtr& res) { return ValidatePass(res); }
 
+bool KeepShapeGenericGraphAction(const ResourcePtr& res) {
+  MS_EXCEPTION_IF_NULL(MsContext::GetInstance());
+  if (!MsContext::GetInstance()->enable_shape_respecialize() || res->HasResult(kShapeSpecialized)) {
+    return true;
+  }
+  if (res->func_graph() == nullptr) {
+    MS_LOG(EXCEPTION) << "Keep shape generic graph error";
+  }
+  // the backend may change the graph, the clone is kept
+  res->SetResult(kShapeGenericGraph, BasicClone(res->func_graph()));
+  return true;
+}
+
+bool ShapeRespecializeAction(const ResourcePtr& res) {
+  if (!res->HasResult(kShapeGenericGraph)) {
+    MS_LOG(EXCEPTION) << "Shape respecialize error";
+  }
+  FuncGraphPtr func_graph = BasicClone(res->GetResult(kShapeGenericGraph).cast<FuncGraphPtr>());
+  MS_EXCEPTION_IF_NULL(func_graph);
+  abstract::AbstractBasePtrList args_spec = res->args_spec();
+  for (const auto& param : func_graph->parameters()) {
+    auto param_node = std::static_pointer_cast<Parameter>(param);
+    if (param_node->has_default()) {
+      AbstractBasePtr ptr =
+        abstract::FromValue(parse::data_converter::PyDataToValue(param_node->default_param()), true);
+      args_spec.push_back(ptr);
+    }
+  }
+  if (args_spec.size() != func_graph->parameters().size()) {
+    MS_LOG(EXCEPTION) << "The graph has " << func_graph->parameters().size() << " parameters, but got "
+                      << args_spec.size() << " arguments.";
+  }
+  auto manager = res->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->AddFuncGraph(func_graph);
+  // only the abstracts of the optimized graph are inferred again for the new shapes
+  res->set_func_graph(Renormalize(res, func_graph, args_spec));
+  return true;
+}
+
 static std::vector<ActionItem> CommonPipeline() {
   std::vector<ActionItem> actions;
 
@@ -327,6 +376,9 @@ std::vector<ActionItem> VmPipeline() {
 
   actions.emplace_back(std::make_pair("validate", ValidateAction));
 
+  // keep the optimized graph for the inputs of other shapes
+  actions.emplace_back(std::make_pair("keep_shape_generic_graph", KeepShapeGenericGraphAction));
+
   // compile the ANF graph
   actions.emplace_back(std::make_pair("task_emit", TaskEmitAction));
 
@@ -335,5 +387,18 @@ std::vector<ActionItem> VmPipeline() {
 
   return actions;
 }
+
+std::vector<ActionItem> VmRespecializePipeline() {
+  std::vector<ActionItem> actions;
+
+  // Evaluate the shapes of the graph optimized for the inputs of other shapes
+  actions.emplace_back(std::make_pair("shape_respecialize", ShapeRespecializeAction));
+
+  actions.emplace_back(std::make_pair("validate", ValidateAction));
+  actions.emplace_back(std::make_pair("task_emit", TaskEmitAction));
+  actions.emplace_back(std::make_pair("execute", ExecuteAction));
+
+  return actions;
+}
 }  // namespace pipeline
 }  // namespace mindspore
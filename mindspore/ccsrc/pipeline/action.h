@@ -37,9 +37,13 @@ bool GeOptimizeAction(const ResourcePtr& res);
 bool VmOptimizeAction(const ResourcePtr& res);
 bool TaskEmitAction(const ResourcePtr& res);
 bool ExecuteAction(const ResourcePtr& res);
+bool KeepShapeGenericGraphAction(const ResourcePtr& res);
+bool ShapeRespecializeAction(const ResourcePtr& res);
 
 std::vector<ActionItem> GePipeline();
 std::vector<ActionItem> VmPipeline();
+// compile by the graph optimized for the inputs of other shapes, kept in the result kShapeGenericGraph
+std::vector<ActionItem> VmRespecializePipeline();
 abstract::AnalysisResult AbstractAnalyze(const ResourcePtr& res, const FuncGraphPtr& func_graph,
                                          const abstract::AbstractBasePtrList& args_spec, bool clear = false);
 FuncGraphPtr ProgramSpecialize(const ResourcePtr& res, const FuncGraphPtr& func_graph,
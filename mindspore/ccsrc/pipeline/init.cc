@@ -26,6 +26,8 @@
 #include "pipeline/parse/python_adapter.h"
 #include "utils/summary/event_writer.h"
 #include "utils/config_manager.h"
+#include "utils/metrics.h"
+#include "utils/step_stats.h"
 #include "parallel/context.h"
 #include "parallel/device_manager.h"
 #include "parallel/costmodel_context.h"
@@ -65,6 +67,8 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("get_func_graph", &ExecutorPy::GetFuncGraph, py::arg("phase") = py::str(""), "Get graph pointer.")
     .def("get_func_graph_proto", &ExecutorPy::GetFuncGraphProto, py::arg("phase") = py::str(""),
          py::arg("type") = py::str("onnx_ir"), "Get graph proto string by specifying ir type.")
+    .def("export_onnx", &ExecutorPy::ExportOnnx, py::arg("phase"), py::arg("file_name"),
+         py::arg("external_data") = py::bool_(false), "Export the graph to an ONNX model file.")
     .def("compile", &ExecutorPy::Compile, py::arg("obj"), py::arg("args"), py::arg("phase") = py::str(""),
          py::arg("use_vm") = py::bool_(false), "Compile obj by executor.")
     .def("get_parameter_layout", &ExecutorPy::GetParameterLayout, py::arg("phase") = py::str("train"),
@@ -136,16 +140,67 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("set_loop_sink_flag", &mindspore::MsContext::set_loop_sink_flag, "Set whether to enable loop sink.")
     .def("get_enable_mem_reuse", &mindspore::MsContext::enable_mem_reuse, "Get whether to enable mem reuse.")
     .def("set_enable_mem_reuse", &mindspore::MsContext::set_enable_mem_reuse, "Set whether to enable mem reuse.")
+    .def("get_enable_recompute", &mindspore::MsContext::enable_recompute, "Get whether to enable recompute.")
+    .def("set_enable_recompute", &mindspore::MsContext::set_enable_recompute, "Set whether to enable recompute.")
+    .def("get_enable_mem_swap", &mindspore::MsContext::enable_mem_swap, "Get whether to enable mem swap.")
+    .def("set_enable_mem_swap", &mindspore::MsContext::set_enable_mem_swap, "Set whether to enable mem swap.")
+    .def("get_enable_cuda_graph", &mindspore::MsContext::enable_cuda_graph, "Get whether to enable cuda graph.")
+    .def("set_enable_cuda_graph", &mindspore::MsContext::set_enable_cuda_graph, "Set whether to enable cuda graph.")
+    .def("get_enable_graph_kernel", &mindspore::MsContext::enable_graph_kernel, "Get whether to enable graph kernel.")
+    .def("set_enable_graph_kernel", &mindspore::MsContext::set_enable_graph_kernel,
+         "Set whether to enable graph kernel.")
+    .def("get_enable_graph_static_memory", &mindspore::MsContext::enable_graph_static_memory,
+         "Get whether to enable graph static memory.")
+    .def("set_enable_graph_static_memory", &mindspore::MsContext::set_enable_graph_static_memory,
+         "Set whether to enable graph static memory.")
+    .def("get_enable_gpu_multi_stream", &mindspore::MsContext::enable_gpu_multi_stream,
+         "Get whether to enable gpu multi stream.")
+    .def("set_enable_gpu_multi_stream", &mindspore::MsContext::set_enable_gpu_multi_stream,
+         "Set whether to enable gpu multi stream.")
+    .def("get_enable_branch_streams", &mindspore::MsContext::enable_branch_streams,
+         "Get whether to enable branch streams.")
+    .def("set_enable_branch_streams", &mindspore::MsContext::set_enable_branch_streams,
+         "Set whether to enable branch streams.")
+    .def("get_enable_pynative_async", &mindspore::MsContext::enable_pynative_async,
+         "Get whether to enable pynative async.")
+    .def("set_enable_pynative_async", &mindspore::MsContext::set_enable_pynative_async,
+         "Set whether to enable pynative async.")
+    .def("get_enable_shape_respecialize", &mindspore::MsContext::enable_shape_respecialize,
+         "Get whether to enable shape respecialize.")
+    .def("set_enable_shape_respecialize", &mindspore::MsContext::set_enable_shape_respecialize,
+         "Set whether to enable shape respecialize.")
+    .def("get_cpu_inter_op_threads", &mindspore::MsContext::cpu_inter_op_threads,
+         "Get the number of threads running the cpu kernels.")
+    .def("set_cpu_inter_op_threads", &mindspore::MsContext::set_cpu_inter_op_threads,
+         "Set the number of threads running the cpu kernels.")
+    .def("get_cpu_int8_calibration_steps", &mindspore::MsContext::cpu_int8_calibration_steps,
+         "Get the number of float launches calibrating the cpu int8 kernels.")
+    .def("set_cpu_int8_calibration_steps", &mindspore::MsContext::set_cpu_int8_calibration_steps,
+         "Set the number of float launches calibrating the cpu int8 kernels.")
+    .def("get_max_device_models", &mindspore::MsContext::max_device_models,
+         "Get the max number of task sink models loaded on the device.")
+    .def("set_max_device_models", &mindspore::MsContext::set_max_device_models,
+         "Set the max number of task sink models loaded on the device.")
     .def("get_save_ms_model_flag", &mindspore::MsContext::save_ms_model_flag, "Get whether to save ms model.")
     .def("set_save_ms_model_flag", &mindspore::MsContext::set_save_ms_model_flag, "Set whether to save ms model.")
     .def("get_save_ms_model_path", &mindspore::MsContext::save_ms_model_path, "Get path to save ms model.")
     .def("set_save_ms_model_path", &mindspore::MsContext::set_save_ms_model_path, "Set path to save ms model")
+    .def("get_save_ms_model_fp16_flag", &mindspore::MsContext::save_ms_model_fp16_flag,
+         "Get whether to save ms model in float16.")
+    .def("set_save_ms_model_fp16_flag", &mindspore::MsContext::set_save_ms_model_fp16_flag,
+         "Set whether to save ms model in float16.")
     .def("get_enable_gpu_summary", &mindspore::MsContext::enable_gpu_summary, "Get whether to enable gpu summary.")
     .def("set_enable_gpu_summary", &mindspore::MsContext::set_enable_gpu_summary, "Set whether to enable gpu summary.")
     .def("get_enable_dump", &mindspore::MsContext::enable_dump, "Get whether to enable dump.")
     .def("set_enable_dump", &mindspore::MsContext::set_enable_dump, "Set whether to enable dump.")
     .def("get_save_dump_path", &mindspore::MsContext::save_dump_path, "Get path to dump.")
     .def("set_save_dump_path", &mindspore::MsContext::set_save_dump_path, "Set path to dump.")
+    .def("get_enable_timeline", &mindspore::MsContext::enable_timeline, "Get whether to enable timeline.")
+    .def("set_enable_timeline", &mindspore::MsContext::set_enable_timeline, "Set whether to enable timeline.")
+    .def("get_save_timeline_path", &mindspore::MsContext::save_timeline_path, "Get path to save timeline.")
+    .def("set_save_timeline_path", &mindspore::MsContext::set_save_timeline_path, "Set path to save timeline.")
+    .def("get_enable_step_stats", &mindspore::MsContext::enable_step_stats, "Get whether to enable step stats.")
+    .def("set_enable_step_stats", &mindspore::MsContext::set_enable_step_stats, "Set whether to enable step stats.")
     .def("get_enable_dynamic_mem_pool", &mindspore::MsContext::enable_dynamic_mem_pool,
          "Get whether to enable dynamic mem pool.")
     .def("set_enable_dynamic_mem_pool", &mindspore::MsContext::set_enable_dynamic_mem_pool,
@@ -186,6 +241,22 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("get_parameter_broadcast_is_set", &ParallelContext::parameter_broadcast_is_set,
          "Get parameter broadcast is set.")
     .def("set_parameter_broadcast", &ParallelContext::set_parameter_broadcast, "Set parameter broadcast.")
+    .def("get_enable_parallel_optimizer", &ParallelContext::enable_parallel_optimizer,
+         "Get enable parallel optimizer.")
+    .def("set_enable_parallel_optimizer", &ParallelContext::set_enable_parallel_optimizer,
+         "Set enable parallel optimizer.")
+    .def("get_enable_hierarchical_allreduce", &ParallelContext::enable_hierarchical_allreduce,
+         "Get enable hierarchical allreduce.")
+    .def("set_enable_hierarchical_allreduce", &ParallelContext::set_enable_hierarchical_allreduce,
+         "Set enable hierarchical allreduce.")
+    .def("get_devices_per_node", &ParallelContext::devices_per_node, "Get devices per node.")
+    .def("set_devices_per_node", &ParallelContext::set_devices_per_node, "Set devices per node.")
+    .def("get_gradient_compression", &ParallelContext::gradient_compression, "Get gradient compression.")
+    .def("set_gradient_compression", &ParallelContext::set_gradient_compression, "Set gradient compression.")
+    .def("get_topk_compression_ratio", &ParallelContext::topk_compression_ratio, "Get topk compression ratio.")
+    .def("set_topk_compression_ratio", &ParallelContext::set_topk_compression_ratio, "Set topk compression ratio.")
+    .def("get_enable_alltoall", &ParallelContext::enable_alltoall, "Get enable alltoall.")
+    .def("set_enable_alltoall", &ParallelContext::set_enable_alltoall, "Set enable alltoall.")
     .def("reset", &ParallelContext::Reset, "Reset auto parallel context.");
 
   (void)py::class_<CostModelContext, std::shared_ptr<CostModelContext>>(m, "CostModelContext")
@@ -221,6 +292,34 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the parameter cost_model_communi_bias of the DP algorithm.")
     .def("get_costmodel_communi_bias", &CostModelContext::costmodel_communi_bias,
          "Get the parameter cost_model_communi_bias of the DP algorithm.")
+    .def("set_costmodel_calibration_file", &CostModelContext::set_costmodel_calibration_file,
+         "Set the cost calibration file of the DP algorithm.")
+    .def("get_costmodel_calibration_file", &CostModelContext::costmodel_calibration_file,
+         "Get the cost calibration file of the DP algorithm.")
+    .def("set_costmodel_devices_per_node", &CostModelContext::set_costmodel_devices_per_node,
+         "Set the devices per node of the device topology.")
+    .def("get_costmodel_devices_per_node", &CostModelContext::costmodel_devices_per_node,
+         "Get the devices per node of the device topology.")
+    .def("set_costmodel_nodes_per_rack", &CostModelContext::set_costmodel_nodes_per_rack,
+         "Set the nodes per rack of the device topology.")
+    .def("get_costmodel_nodes_per_rack", &CostModelContext::costmodel_nodes_per_rack,
+         "Get the nodes per rack of the device topology.")
+    .def("set_costmodel_intra_rack_bandwidth_ratio", &CostModelContext::set_costmodel_intra_rack_bandwidth_ratio,
+         "Set the intra rack bandwidth ratio of the device topology.")
+    .def("get_costmodel_intra_rack_bandwidth_ratio", &CostModelContext::costmodel_intra_rack_bandwidth_ratio,
+         "Get the intra rack bandwidth ratio of the device topology.")
+    .def("set_costmodel_inter_rack_bandwidth_ratio", &CostModelContext::set_costmodel_inter_rack_bandwidth_ratio,
+         "Set the inter rack bandwidth ratio of the device topology.")
+    .def("get_costmodel_inter_rack_bandwidth_ratio", &CostModelContext::costmodel_inter_rack_bandwidth_ratio,
+         "Get the inter rack bandwidth ratio of the device topology.")
+    .def("set_costmodel_intra_rack_latency", &CostModelContext::set_costmodel_intra_rack_latency,
+         "Set the intra rack latency of the device topology.")
+    .def("get_costmodel_intra_rack_latency", &CostModelContext::costmodel_intra_rack_latency,
+         "Get the intra rack latency of the device topology.")
+    .def("set_costmodel_inter_rack_latency", &CostModelContext::set_costmodel_inter_rack_latency,
+         "Set the inter rack latency of the device topology.")
+    .def("get_costmodel_inter_rack_latency", &CostModelContext::costmodel_inter_rack_latency,
+         "Get the inter rack latency of the device topology.")
     .def("set_costmodel_allreduce_fusion_algorithm", &CostModelContext::set_costmodel_allreduce_fusion_algorithm,
          "Set the parameter gradient AllReduce fusion algorithm.")
     .def("get_costmodel_allreduce_fusion_algorithm", &CostModelContext::costmodel_allreduce_fusion_algorithm,
@@ -255,6 +354,10 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("get_costmodel_allreduce_fusion_computation_time_parameter",
          &CostModelContext::costmodel_allreduce_fusion_computation_time_parameter,
          "Get the parameter gradient AllReduce fusion computation time parameter.")
+    .def("set_costmodel_allreduce_fusion_bucket_size", &CostModelContext::set_costmodel_allreduce_fusion_bucket_size,
+         "Set the parameter gradient AllReduce fusion bucket size.")
+    .def("get_costmodel_allreduce_fusion_bucket_size", &CostModelContext::costmodel_allreduce_fusion_bucket_size,
+         "Get the parameter gradient AllReduce fusion bucket size.")
     .def("set_tensor_slice_align_enable", &CostModelContext::set_tensor_slice_alignment_enable,
          "Set the parameter tensor_slice_align_enable in strategy generation.")
     .def("get_tensor_slice_align_enable", &CostModelContext::tensor_slice_alignment_enable,
@@ -290,16 +393,27 @@ PYBIND11_MODULE(_c_expression, m) {
     .def(py::init<const std::string&>())
     .def("GetFileName", &EventWriter::GetFileName, "Get the file name.")
     .def("Open", &EventWriter::Open, "Open the write file.")
-    .def("Write", &EventWriter::Write, "Write the serialize event.")
+    // the writer may wait for its writer thread, the other python threads run meanwhile
+    .def("Write", &EventWriter::Write, py::call_guard<py::gil_scoped_release>(), "Write the serialize event.")
     .def("EventCount", &EventWriter::GetWriteEventCount, "Write event count.")
-    .def("Flush", &EventWriter::Flush, "Flush the event.")
-    .def("Close", &EventWriter::Close, "Close the write.")
-    .def("Shut", &EventWriter::Shut, "Final close the write.");
+    .def("Flush", &EventWriter::Flush, py::call_guard<py::gil_scoped_release>(), "Flush the event.")
+    .def("Close", &EventWriter::Close, py::call_guard<py::gil_scoped_release>(), "Close the write.")
+    .def("Shut", &EventWriter::Shut, py::call_guard<py::gil_scoped_release>(), "Final close the write.");
 
   (void)py::class_<OpLib, std::shared_ptr<OpLib>>(m, "Oplib")
     .def(py::init())
     .def("reg_op", &OpLib::RegOp, "Register op info.");
 
+  (void)m.def(
+    "collect_metrics", []() { return mindspore::MetricsRegistry::GetInstance().Collect(); },
+    "Collect the values of the metrics.");
+  (void)m.def(
+    "metrics_prometheus_text", []() { return mindspore::MetricsRegistry::GetInstance().PrometheusText(); },
+    "Get the metrics in the text exposition format of Prometheus.");
+  (void)m.def(
+    "get_step_stats", []() { return mindspore::StepStats::GetInstance().Steps(); },
+    "Get the microseconds of the phases of the steps recorded.");
+
   (void)m.def("init_gpu_collective", &mindspore::device::gpu::CollectiveInitializer::InitCollective,
               "Init gpu collective communication mode.");
   (void)m.def("finalize_gpu_collective", &mindspore::device::gpu::CollectiveInitializer::FinalizeCollective,
@@ -294,6 +294,68 @@ bool ConvertData(const py::object& obj, ValuePtr* const data, bool use_signature
   return ret;
 }
 
+namespace {
+// Get the key the graph parsed from obj is shared by and the cell instance the graph is bound to, or an empty key.
+std::string GetParseCacheKey(const py::object& obj, const std::string& python_mod_get_parse_method,
+                             py::object* const instance) {
+  py::module mod = python_adapter::GetPyModule(PYTHON_MOD_PARSE_MODULE);
+  py::object method = obj;
+  if (data_converter::GetObjType(obj) == RESOLVE_TYPE_CLASS_INSTANCE) {
+    py::object parse_method = python_adapter::GetPyObjAttr(obj, PYTHON_EXTERN_PARSE_METHOD);
+    method = python_adapter::CallPyModFn(mod, python_mod_get_parse_method, obj, parse_method);
+  }
+  py::object key = python_adapter::CallPyModFn(mod, PYTHON_MOD_GET_PARSE_CACHE_KEY, method);
+  if (py::isinstance<py::none>(key)) {
+    return "";
+  }
+  py::tuple key_tuple = key.cast<py::tuple>();
+  *instance = key_tuple[1];
+  return py::cast<std::string>(key_tuple[0]);
+}
+
+std::string GetScopeName(const py::object& instance) {
+  py::object scope_name = python_adapter::CallPyFn(PYTHON_MOD_PARSE_MODULE, PYTHON_PARSE_GET_SCOPE_NAME, instance);
+  return py::isinstance<py::none>(scope_name) ? "" : py::cast<std::string>(scope_name);
+}
+
+// Clone the graph as parsed for another instance of the class, the class members and the scope of the nodes are
+// bound to the instance, which is all the parse takes from the instance apart from the key.
+FuncGraphPtr BindParsedGraph(const FuncGraphPtr& parsed_graph, const std::string& parsed_scope,
+                             const py::object& instance) {
+  Cloner cloner({parsed_graph}, true, true, true, std::make_shared<TraceCopy>(), nullptr);
+  auto func_graph = cloner[parsed_graph];
+  if (instance.is_none()) {
+    return func_graph;
+  }
+  py::module mod = python_adapter::GetPyModule(PYTHON_MOD_PARSE_MODULE);
+  py::object member_namespace = python_adapter::CallPyModFn(mod, PYTHON_MOD_GET_MEMBER_NAMESPACE_SYMBOL, instance);
+  auto name_space = std::make_shared<NameSpace>(RESOLVE_NAMESPACE_NAME_CLASS_MEMBER, member_namespace);
+  auto scope_name = GetScopeName(instance);
+  auto scope = std::make_shared<Scope>(scope_name);
+  for (auto& item : *cloner.cloned_node()) {
+    auto& node = item.second;
+    if (!parsed_scope.empty() && !scope_name.empty() && node->scope() != nullptr &&
+        node->scope()->name() == parsed_scope) {
+      node->set_scope(scope);
+    }
+    if (!node->isa<CNode>()) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    for (size_t i = 0; i < cnode->inputs().size(); ++i) {
+      auto input = cnode->input(i);
+      if (IsValueNode<NameSpace>(input) &&
+          GetValueNode<NameSpacePtr>(input)->module() == RESOLVE_NAMESPACE_NAME_CLASS_MEMBER) {
+        auto new_input = NewValueNode(name_space);
+        new_input->set_scope(node->scope());
+        cnode->set_input(i, new_input);
+      }
+    }
+  }
+  return func_graph;
+}
+}  // namespace
+
 // convert data to graph
 FuncGraphPtr ConvertToFuncGraph(const py::object& obj, const std::string& python_mod_get_parse_method) {
   std::vector<std::string> results = data_converter::GetObjKey(obj);
@@ -310,10 +372,24 @@ FuncGraphPtr ConvertToFuncGraph(const py::object& obj, const std::string& python
     }
   }
 
-  func_graph = ParsePythonCode(obj, python_mod_get_parse_method);
-  if (func_graph == nullptr) {
-    MS_LOG(ERROR) << "Parse resolve function error.";
-    return nullptr;
+  // the instances of a cell class share the graph parsed from the first of them, e.g. the layers of a deep model
+  py::object instance = py::none();
+  std::string parse_key = GetParseCacheKey(obj, python_mod_get_parse_method, &instance);
+  FuncGraphPtr parsed_graph = nullptr;
+  std::string parsed_scope;
+  if (!parse_key.empty() && data_converter::GetParsedGraph(parse_key, &parsed_graph, &parsed_scope)) {
+    MS_LOG(DEBUG) << "Bind the graph parsed for " << parse_key << " to " << obj_id;
+    func_graph = BindParsedGraph(parsed_graph, parsed_scope, instance);
+  } else {
+    func_graph = ParsePythonCode(obj, python_mod_get_parse_method);
+    if (func_graph == nullptr) {
+      MS_LOG(ERROR) << "Parse resolve function error.";
+      return nullptr;
+    }
+    if (!parse_key.empty()) {
+      // a clone is kept, as the graph returned is resolved and optimized in place
+      data_converter::CacheParsedGraph(parse_key, BindParsedGraph(func_graph, "", py::none()), GetScopeName(instance));
+    }
   }
 
   data_converter::MakeProperNameToFuncGraph(func_graph, obj_id);
@@ -341,6 +417,23 @@ const std::unordered_map<std::string, std::vector<FuncGraphPtr>>& GetObjGraphs()
   return object_graphs_map_;
 }
 
+static std::unordered_map<std::string, std::pair<FuncGraphPtr, std::string>> parsed_graph_map_ =
+  std::unordered_map<std::string, std::pair<FuncGraphPtr, std::string>>();
+
+void CacheParsedGraph(const std::string& parse_key, const FuncGraphPtr& func_graph, const std::string& scope_name) {
+  parsed_graph_map_[parse_key] = std::make_pair(func_graph, scope_name);
+}
+
+bool GetParsedGraph(const std::string& parse_key, FuncGraphPtr* const func_graph, std::string* const scope_name) {
+  auto iter = parsed_graph_map_.find(parse_key);
+  if (iter == parsed_graph_map_.end()) {
+    return false;
+  }
+  *func_graph = iter->second.first;
+  *scope_name = iter->second.second;
+  return true;
+}
+
 void CacheObjectValue(const std::string& obj_key, const Any& data) { object_map_[obj_key] = data; }
 bool GetObjectValue(const std::string& obj_key, Any* const data) {
   if (object_map_.count(obj_key)) {
@@ -424,6 +517,7 @@ ValuePtr PyDataToValue(const py::object& obj) {
 void ClearObjectCache() {
   object_map_.clear();
   object_graphs_map_.clear();
+  parsed_graph_map_.clear();
 }
 }  // namespace data_converter
 
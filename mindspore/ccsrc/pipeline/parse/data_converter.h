@@ -37,6 +37,10 @@ bool GetObjectValue(const std::string& obj_key, Any* const data);
 
 void SetObjGraphValue(const std::string& obj_key, const FuncGraphPtr& data);
 
+// the graphs as parsed from the methods of the cells, shared by the instances of a class, see get_parse_cache_key
+void CacheParsedGraph(const std::string& parse_key, const FuncGraphPtr& func_graph, const std::string& scope_name);
+bool GetParsedGraph(const std::string& parse_key, FuncGraphPtr* const func_graph, std::string* const scope_name);
+
 const std::unordered_map<std::string, std::vector<FuncGraphPtr>>& GetObjGraphs();
 
 std::vector<std::string> GetObjKey(const py::object& obj);
@@ -28,6 +28,7 @@
 #include "pipeline/parse/data_converter.h"
 #include "optimizer/ad/dfunctor.h"
 #include "ir/meta_tensor.h"
+#include "ir/func_graph_cloner.h"
 #include "transform/convert.h"
 #include "transform/df_graph_manager.h"
 #include "transform/graph_builder.h"
@@ -38,6 +39,9 @@
 #include "utils/convert_utils.h"
 #include "utils/utils.h"
 #include "utils/base_ref.h"
+#include "utils/metrics.h"
+#include "utils/step_stats.h"
+#include "utils/timeline.h"
 #include "vm/segment_runner.h"
 #include "parallel/context.h"
 #include "parallel/graph_util/get_parallel_info.h"
@@ -288,6 +292,16 @@ py::bytes ExecutorPy::GetFuncGraphProto(const std::string& phase, const std::str
   MS_LOG(EXCEPTION) << "Unknown ir type: " << ir_type;
 }
 
+void ExecutorPy::ExportOnnx(const std::string& phase, const std::string& file_name, bool external_data) {
+  FuncGraphPtr fg_ptr = GetFuncGraph(phase);
+  if (fg_ptr == nullptr) {
+    MS_LOG(EXCEPTION) << "Can not find func graph " << phase;
+  }
+  if (!ExportOnnxFile(fg_ptr, file_name, external_data)) {
+    MS_LOG(EXCEPTION) << "Export the ONNX model of " << phase << " to " << file_name << " failed.";
+  }
+}
+
 py::dict ExecutorPy::GetParameterLayout(const std::string& phase) {
   MS_LOG(DEBUG) << "GetParameterLayout!";
   std::string layout_graph = phase + kStepParallelGraph;
@@ -383,6 +397,82 @@ void ExecutorPy::GetGeBackendPolicy() const {
   }
 }
 
+namespace {
+// the phases of a network differ only by the leading index of the arguments, for the inputs of different shapes
+std::string GetShapeFreePhase(const std::string& phase) {
+  auto pos = phase.find_first_not_of("0123456789");
+  return pos == std::string::npos ? phase : phase.substr(pos);
+}
+
+bool IsShapeOnlyChanged(const abstract::AbstractBasePtrList& old_args, const abstract::AbstractBasePtrList& new_args) {
+  if (old_args.size() != new_args.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < old_args.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(old_args[i]);
+    MS_EXCEPTION_IF_NULL(new_args[i]);
+    auto old_tensor = dyn_cast<AbstractTensor>(old_args[i]);
+    auto new_tensor = dyn_cast<AbstractTensor>(new_args[i]);
+    if (old_tensor == nullptr || new_tensor == nullptr) {
+      if (!(*old_args[i] == *new_args[i])) {
+        return false;
+      }
+      continue;
+    }
+    MS_EXCEPTION_IF_NULL(old_tensor->element());
+    MS_EXCEPTION_IF_NULL(new_tensor->element());
+    MS_EXCEPTION_IF_NULL(old_tensor->shape());
+    MS_EXCEPTION_IF_NULL(new_tensor->shape());
+    if (!(*old_tensor->element()->BuildType() == *new_tensor->element()->BuildType()) ||
+        old_tensor->shape()->shape().size() != new_tensor->shape()->shape().size()) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+bool ExecutorPy::CompileByShapeGenericGraph(const py::object& obj, const std::string& phase_s,
+                                            const ExecutorInfoPtr& excutor_info) {
+  MS_EXCEPTION_IF_NULL(excutor_info);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  MS_EXCEPTION_IF_NULL(parallel::ParallelContext::GetInstance());
+  std::string parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (!context_ptr->enable_shape_respecialize() ||
+      (parallel_mode != parallel::STAND_ALONE && parallel_mode != parallel::DATA_PARALLEL)) {
+    return false;
+  }
+  auto iter = shape_generic_phases_.find(GetShapeFreePhase(phase_s));
+  if (iter == shape_generic_phases_.end() || info_.count(iter->second) == 0) {
+    return false;
+  }
+  auto generic_info = info_[iter->second];
+  MS_EXCEPTION_IF_NULL(generic_info->resource);
+  if (!IsShapeOnlyChanged(generic_info->args_spec, excutor_info->args_spec)) {
+    return false;
+  }
+
+  MS_EXCEPTION_IF_NULL(excutor_info->resource);
+  ResourcePtr resource = std::make_shared<Resource>(obj);
+  resource->SetResult(kBackend, excutor_info->resource->GetResult(kBackend));
+  resource->SetResult(kShapeGenericGraph, generic_info->resource->GetResult(kShapeGenericGraph));
+  resource->set_args_spec(excutor_info->args_spec);
+  std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, VmRespecializePipeline());
+  try {
+    pip->Run();
+  } catch (const std::exception& ex) {
+    // the graph may not be valid for the new shapes, it's compiled in full then
+    MS_LOG(WARNING) << "Compile phase " << phase_s << " by the graph of phase " << iter->second
+                    << " failed, compile it in full. " << ex.what();
+    resource->Clean();
+    return false;
+  }
+  MS_LOG(INFO) << "Compile phase " << phase_s << " by the graph of phase " << iter->second << ".";
+  excutor_info->resource = resource;
+  return true;
+}
+
 bool ExecutorPy::CompileInner(const py::object& obj, const py::tuple& args, const py::object& phase, bool use_vm) {
   MS_LOG(DEBUG) << "Start ExecutorPy compile!";
   if ((!py::isinstance<py::str>(phase))) {
@@ -430,14 +520,20 @@ bool ExecutorPy::CompileInner(const py::object& obj, const py::tuple& args, cons
 
   resource->set_args_spec(args_spec);
   excutor_info->arg_list_size = size;
+  excutor_info->args_spec = args_spec;
   excutor_info->resource = resource;
   info_[phase_s] = excutor_info;
-  pip->Run();
+  if (!use_vm || !CompileByShapeGenericGraph(obj, phase_s, excutor_info)) {
+    pip->Run();
+    if (resource->HasResult(kShapeGenericGraph)) {
+      shape_generic_phases_[GetShapeFreePhase(phase_s)] = phase_s;
+    }
+  }
 
   // save the run graph func to MsPipeLine
   SaveCompiledGraph(phase_s);
 
-  resource->Clean();
+  excutor_info->resource->Clean();
   // Reclaim all resource used by optimizer;
   ReclaimOptimizer();
 
@@ -585,23 +681,34 @@ void Pipeline::Run() {
   WITH(MsProfile::GetProfile())[&user_graph, this]() {
     int i = 0;
     for (auto& action : actions_) {
+      TimelineSpan span("action." + action.first, "pipeline");
 #ifdef ENABLE_TIMELINE
       DumpTime& dump_time = DumpTime::GetInstance();
       dump_time.Record(action.first, GetTime(), true);
 #endif
       bool result = true;
+      auto clone_stats = GetCloneStats();
       WITH(MsProfile::GetProfile()->Step(action.first))[&result, &action, this]() {
         MS_LOG(DEBUG) << "Action " << action.first << " start ...";
+        WITH_PASS_STAT("action." + action.first, [this]() -> size_t {
+          auto manager = resource_->manager();
+          return manager == nullptr ? 0 : manager->all_nodes().size();
+        })[&result, &action, this]() {
 #ifdef ENABLE_LOAD_ANF_IR
-        RunPipelineAction(action, resource_, &result);
+          RunPipelineAction(action, resource_, &result);
 #else
-        result = action.second(resource_);
+          result = action.second(resource_);
 #endif
+        };
         MS_LOG(DEBUG) << "Action " << action.first << " end.";
       };
       if (!result) {
         MS_LOG(EXCEPTION) << "pipeline running to end, failed in step:" << action.first;
       }
+      auto action_clone_stats = GetCloneStats();
+      MS_LOG(INFO) << "Action " << action.first << " cloned "
+                   << action_clone_stats.func_graphs - clone_stats.func_graphs << " graphs and "
+                   << action_clone_stats.nodes - clone_stats.nodes << " nodes.";
       if (MsContext::GetInstance()->save_graphs_flag() && resource_->func_graph() != nullptr) {
         auto graph = resource_->func_graph();
         if (graph != nullptr) {
@@ -643,6 +750,7 @@ void Pipeline::Run() {
   };
 #ifdef ENABLE_PROFILE
   MsProfile::Print();
+  MsProfile::SavePassStat();
   MsProfile::Reset();
 #endif
 
@@ -703,6 +811,10 @@ py::object ExecutorPy::Run(const py::tuple& args, const py::object& phase) {
     MS_LOG(EXCEPTION) << "Run failed, phase input is not a str";
   }
   auto phase_s = py::cast<std::string>(phase);
+  static auto step_time = MetricsRegistry::GetInstance().GetHistogram("mindspore_step_time_us",
+                                                                      "The time of the steps running the graphs.");
+  HistogramTimer timer(step_time);
+  StepStatsScope step_scope;
   std::string backend = MsContext::GetInstance()->backend_policy();
   if (backend == "ge") {
     return ExecDFGraph(args, phase_s);
@@ -763,13 +875,7 @@ py::object StructureOutput(const AbstractBasePtr& output, const py::tuple& data,
 
 std::shared_ptr<py::object> DoExecGraph(const FuncGraphPtr& graph, const std::vector<MeTensorPtr>& inputs,
                                         const std::string& phase) {
-  std::vector<GeTensorPtr> ge_tensors = TransformUtil::ConvertInputTensors(inputs, kOpFormat_NCHW);
-  if (ge_tensors.size() != inputs.size()) {
-    MS_LOG(ERROR) << "args convert to ge tensor error";
-    return nullptr;
-  }
-
-  std::vector<GeTensorPtr> ge_outputs;
+  std::vector<MeTensorPtr> me_outputs;
   transform::RunOptions run_options;
 
   run_options.name = phase;
@@ -781,21 +887,13 @@ std::shared_ptr<py::object> DoExecGraph(const FuncGraphPtr& graph, const std::ve
     return nullptr;
   }
 
-  {
-    // Release GIL before calling into (potentially long-running) C++ code
-    py::gil_scoped_release release;
-    MS_LOG(DEBUG) << "Run graph begin, inputs size is: " << inputs.size();
-    Status ret = graph_runner->RunGraph(run_options, ge_tensors, &ge_outputs);
-    MS_LOG(DEBUG) << "Run graph finish, outputs size is: " << ge_outputs.size();
-    if (ret != Status::SUCCESS) {
-      MS_LOG(ERROR) << "Exec graph failed";
-      return nullptr;
-    }
-  }
-
-  std::vector<MeTensorPtr> me_outputs = TransformUtil::ConvertGeTensors(ge_outputs);
-  if (me_outputs.size() != ge_outputs.size()) {
-    MS_LOG(ERROR) << "Convert output Ge tensor to Me tensor failed";
+  // the runner refills the GE tensors bound to the inputs of the graph and the outputs share the data of GE
+  MS_LOG(DEBUG) << "Run graph begin, inputs size is: " << inputs.size();
+  Status ret = graph_runner->RunGraph(run_options, inputs, &me_outputs);
+  MS_LOG(DEBUG) << "Run graph finish, outputs size is: " << me_outputs.size();
+  if (ret != Status::SUCCESS) {
+    MS_LOG(ERROR) << "Exec graph failed";
+    return nullptr;
   }
 
   py::tuple outputs(me_outputs.size());
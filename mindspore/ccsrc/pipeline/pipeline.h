@@ -59,6 +59,7 @@ struct ExecutorInfo {
   FuncGraphPtr func_graph;
   ResourcePtr resource;
   std::size_t arg_list_size;
+  abstract::AbstractBasePtrList args_spec;
 };
 
 using ExecutorInfoPtr = std::shared_ptr<ExecutorInfo>;
@@ -91,6 +92,7 @@ class ExecutorPy : public std::enable_shared_from_this<ExecutorPy> {
   ResourcePtr GetResource(const std::string& phase);
   FuncGraphPtr GetFuncGraph(const std::string& phase);
   py::bytes GetFuncGraphProto(const std::string& phase, const std::string& type);
+  void ExportOnnx(const std::string& phase, const std::string& file_name, bool external_data);
   std::size_t ArgListSize(const std::string& phase);
   compile::VmEvalFuncPtr GetVmEvalFunc(const std::string& phase);
   bool HasCompiled(const std::string& phase) const;
@@ -111,8 +113,12 @@ class ExecutorPy : public std::enable_shared_from_this<ExecutorPy> {
   void ConvertObjectToTensors(const py::dict& dict, std::map<std::string, tensor::TensorPtr>* tensors);
   bool ChangeExportGeirUseVmFlag(bool use_vm, const std::string& phase_s) const;
   void GetGeBackendPolicy() const;
+  bool CompileByShapeGenericGraph(const py::object& obj, const std::string& phase_s,
+                                  const ExecutorInfoPtr& excutor_info);
 
   std::map<std::string, ExecutorInfoPtr> info_;
+  // the phases keeping the optimized graphs for the inputs of other shapes, by the phases without the shapes
+  std::map<std::string, std::string> shape_generic_phases_;
   static std::shared_ptr<ExecutorPy> executor_;
   static std::mutex instance_lock_;
 };
@@ -31,6 +31,7 @@
 #include "utils/context/ms_context.h"
 #include "transform/df_graph_manager.h"
 #include "device/kernel_runtime_manager.h"
+#include "pynative/pynative_execute.h"
 
 namespace mindspore {
 // namespace to support opmap definition
@@ -266,6 +267,7 @@ void ReleaseGeTsd() {
 
 void ClearResAtexit() {
   MS_LOG(DEBUG) << "pipeline clear all resource";
+  pynative::ClearRunOpSessions();
   device::KernelRuntimeManager::Instance().ClearRuntimeResource();
   transform::DfGraphManager::GetInstance().ClearGraph();
   ad::g_k_prims.clear();
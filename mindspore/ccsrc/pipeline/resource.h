@@ -41,6 +41,10 @@ namespace py = pybind11;
 const char kBackend[] = "backend";
 const char kStepParallelGraph[] = "step_parallel";
 const char kOutput[] = "output";
+// the compile used the values of the shapes, its graph can't be reused by the inputs of other shapes
+const char kShapeSpecialized[] = "shape_specialized";
+// the optimized graph kept for the inputs of other shapes
+const char kShapeGenericGraph[] = "shape_generic_graph";
 
 class InferenceResource;
 
@@ -75,6 +75,16 @@ AbstractBasePtr BaseFuncGraphEvaluator::Infer(AnalysisEnginePtr engine, const Ab
   MS_EXCEPTION_IF_NULL(parent_context_);
   MS_EXCEPTION_IF_NULL(engine);
   graph_context_ = parent_context_->NewFuncGraphContext(fg, args_spec_list);
+  const AnfNodePtr &func_node = fg->get_return();
+  // The graph may have been analyzed with the same context by the evaluator of another call site, as the contexts
+  // of the graph are equal if the parents and the arguments are. The results of its nodes are kept by the context.
+  AnfNodeConfigPtr ret_conf = engine->MakeConfig(func_node, graph_context_);
+  AbstractBasePtr analyzed = engine->cache().GetValue(ret_conf);
+  if (analyzed != nullptr) {
+    MS_LOG(DEBUG) << "BaseFuncGraph " << fg->ToString() << " has been analyzed with context "
+                  << graph_context_->ToString() << ", inferred abstract: " << analyzed->ToString();
+    return analyzed;
+  }
   const auto &parameters = fg->parameters();
   for (size_t i = 0; i < nargs; i++) {
     const auto &arg = args_spec_list[i];
@@ -82,7 +92,6 @@ AbstractBasePtr BaseFuncGraphEvaluator::Infer(AnalysisEnginePtr engine, const Ab
     AnfNodeConfigPtr conf = engine->MakeConfig(node, graph_context_);
     engine->cache().set_value(conf, arg);
   }
-  const AnfNodePtr &func_node = fg->get_return();
 
   MS_LOG(DEBUG) << "Analysis FuncGraph begin, func graph: " << fg->ToString()
                 << ", context: " << graph_context_->ToString() << ", return node: " << func_node->DebugString();
@@ -95,7 +104,6 @@ AbstractBasePtr BaseFuncGraphEvaluator::Infer(AnalysisEnginePtr engine, const Ab
                   << ", abstract: " << base->ToString();
   }
 
-  AnfNodeConfigPtr ret_conf = engine->MakeConfig(func_node, graph_context_);
   AbstractBasePtr base = engine->GetEvaluatedValue(ret_conf);
   MS_EXCEPTION_IF_NULL(base);
   MS_LOG(DEBUG) << "BaseFuncGraph " << fg->ToString() << " infer end, inferred abstract: " << base->ToString();
@@ -273,6 +273,19 @@ void AnalysisEngine::ClearEvaluatorCache() {
   }
 }
 
+bool AnalysisEngine::HasEvaluatedPrim(const std::vector<std::string> &prim_names) const {
+  for (const auto &element : constructors_) {
+    auto prim_func = dyn_cast<PrimitiveAbstractClosure>(element.first);
+    if (prim_func == nullptr || prim_func->prim() == nullptr) {
+      continue;
+    }
+    if (std::find(prim_names.begin(), prim_names.end(), prim_func->prim()->name()) != prim_names.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void AnalysisEngine::Clear() {
   cache_.Clear();
   anfnode_config_map_.clear();
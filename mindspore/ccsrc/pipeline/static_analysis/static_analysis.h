@@ -166,6 +166,8 @@ class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
   AbstractBasePtr Execute(const AbstractFunctionPtr &fn, const AbstractBasePtrList &args_spec_list);
   void Clear();
   void ClearEvaluatorCache();
+  // Whether one of the primitives named by prim_names is evaluated since the last Clear.
+  bool HasEvaluatedPrim(const std::vector<std::string> &prim_names) const;
   AnalysisCache &cache() { return cache_; }
   AnfNodeConfigPtr MakeConfig(const AnfNodePtr &node, const AnalysisContextPtr &context) {
     return std::make_shared<AnfNodeConfig>(shared_from_this(), node, context);
@@ -23,8 +23,11 @@
 #include <memory>
 #include <string>
 #include <algorithm>
+#include <functional>
+#include <numeric>
 
 #include "kernel/kernel_fusion.h"
+#include "common/trans.h"
 #include "debug/anf_ir_dump.h"
 #include "session/anf_runtime_algorithm.h"
 #include "operator/ops.h"
@@ -41,6 +44,12 @@ const int8_t ELTWISE_USE = 1;
 const int8_t MULTI_ELTWISE_USE = 2;
 const int8_t MAX_MULTI_ELTWISE_SIZE = 4;
 const int8_t MAX_PURE_BUFFER_SUCC_SIZE = 3;
+// The unified buffer of an ai core, a fused kernel tiles all its live tensors through it
+const size_t UB_SIZE = 256 * 1024;
+// The elements of a tile of the live tensors in the unified buffer, a smaller tile wastes the vector unit
+const size_t MIN_UB_TILE_ELEMENTS = 8192;
+// The hbm traffic a fusion region saves at least to be worth compiling a fused kernel for
+const size_t MIN_SAVED_HBM_BYTES = 32 * 1024;
 constexpr auto kOpAttrFusionId = "fusion_id";
 
 #ifdef DEBUG
@@ -458,6 +467,109 @@ void GetFusionScopeNodeList(const session::KernelGraph &kernel_graph,
   }
 }
 
+bool IsUbFusionNode(const AnfNodePtr &node, const std::unordered_set<AnfNodePtr> &fused_set) {
+  if (!AnfAlgo::IsRealCNodeKernel(node) || fused_set.find(node) != fused_set.end() ||
+      AnfAlgo::GetKernelType(node) != KernelType::TBE_KERNEL || AnfAlgo::GetOutputTensorNum(node) != 1) {
+    return false;
+  }
+  auto fusion_type = AnfAlgo::GetFusionType(node);
+  return fusion_type == kernel::FusionType::ELEMWISE || fusion_type == kernel::FusionType::COMMREDUCE ||
+         fusion_type == kernel::FusionType::SEGMENT || fusion_type == kernel::FusionType::CONVLUTION;
+}
+
+size_t OutputTensorBytes(const AnfNodePtr &node) {
+  auto shape = AnfAlgo::GetOutputDeviceShape(node, 0);
+  return std::accumulate(shape.begin(), shape.end(), trans::TypeIdSize(AnfAlgo::GetOutputDeviceDataType(node, 0)),
+                         std::multiplies<size_t>());
+}
+
+// The bytes of an element of the tensors a node adds to the unified buffer, its output and the inputs but the one
+// from the region
+size_t UbBytesPerElement(const CNodePtr &node, const AnfNodePtr &region_input) {
+  size_t bytes = trans::TypeIdSize(AnfAlgo::GetOutputDeviceDataType(node, 0));
+  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(node); ++i) {
+    if (node->input(i + 1) != region_input) {
+      bytes += trans::TypeIdSize(AnfAlgo::GetInputDeviceDataType(node, i));
+    }
+  }
+  return bytes;
+}
+
+// Whether the inputs of a node, but the one from the region, are computed before the head of the region, so none
+// of them depends on the region and the fused node makes no cycle
+bool InputsBeforeRegion(const CNodePtr &node, const AnfNodePtr &region_input, size_t head_index,
+                        const std::unordered_map<AnfNodePtr, size_t> &topo_index) {
+  for (size_t i = 1; i < node->inputs().size(); ++i) {
+    auto input = node->input(i);
+    if (input == region_input) {
+      continue;
+    }
+    auto kernel = AnfAlgo::VisitKernel(input, 0).first;
+    MS_EXCEPTION_IF_NULL(kernel);
+    if (!kernel->isa<CNode>()) {
+      continue;
+    }
+    auto iter = topo_index.find(kernel);
+    if (iter == topo_index.end() || iter->second >= head_index) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Grow the regions from their heads over the elementwise nodes after them, as long as the live tensors of the region
+// still tile through the unified buffer, and keep the regions saving enough hbm traffic by their inner tensors.
+void MatchUbCapacityPattern(const session::KernelGraph &kernel_graph, std::unordered_set<AnfNodePtr> *fused_set,
+                            FusedNodeRecord *candidate_fusion) {
+  MS_EXCEPTION_IF_NULL(fused_set);
+  MS_EXCEPTION_IF_NULL(candidate_fusion);
+  auto manager = kernel_graph.manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto &users = manager->node_users();
+  std::vector<AnfNodePtr> node_list = TopoSort(kernel_graph.get_return());
+  std::unordered_map<AnfNodePtr, size_t> topo_index;
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    topo_index[node_list[i]] = i;
+  }
+  for (auto &head : node_list) {
+    if (!IsUbFusionNode(head, *fused_set)) {
+      continue;
+    }
+    std::unordered_set<AnfNodePtr> record({head});
+    auto tail = head->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(tail);
+    auto ub_bytes = UbBytesPerElement(tail, nullptr);
+    size_t saved_bytes = 0;
+    while (record.size() < static_cast<size_t>(MAX_PATTERN_SIZE) && users[tail].size() == 1) {
+      auto succ = users[tail].begin()->first;
+      if (!IsUbFusionNode(succ, *fused_set) || AnfAlgo::GetFusionType(succ) != kernel::FusionType::ELEMWISE ||
+          record.find(succ) != record.end()) {
+        break;
+      }
+      auto succ_cnode = succ->cast<CNodePtr>();
+      MS_EXCEPTION_IF_NULL(succ_cnode);
+      if (!InputsBeforeRegion(succ_cnode, tail, topo_index[head], topo_index)) {
+        break;
+      }
+      auto succ_ub_bytes = ub_bytes + UbBytesPerElement(succ_cnode, tail);
+      if (succ_ub_bytes * MIN_UB_TILE_ELEMENTS > UB_SIZE) {
+        break;
+      }
+      // the output of the tail is neither written to nor read back from hbm in the fused kernel
+      saved_bytes += 2 * OutputTensorBytes(tail);
+      ub_bytes = succ_ub_bytes;
+      (void)record.insert(succ);
+      tail = succ_cnode;
+    }
+    if (record.size() >= static_cast<size_t>(MIN_PATTERN_SIZE) && saved_bytes >= MIN_SAVED_HBM_BYTES) {
+      MS_LOG(DEBUG) << "Fuse " << record.size() << " nodes from " << head->DebugString() << " saving " << saved_bytes
+                    << " bytes of hbm traffic, " << ub_bytes << " bytes of unified buffer per element";
+      candidate_fusion->push_back(record);
+      fused_set->insert(record.begin(), record.end());
+    }
+  }
+}
+
 void MatchOpNamePattern(const session::KernelGraph &kernel_graph, std::unordered_set<AnfNodePtr> *fused_set,
                         FusedNodeRecord *candidate_fusion) {
   MS_EXCEPTION_IF_NULL(fused_set);
@@ -619,6 +731,7 @@ bool BufferFusion::MatchBufferFusionPattern(const session::KernelGraph &kernel_g
   std::unordered_set<AnfNodePtr> fused_set;
 
   MatchOpNamePattern(kernel_graph, &fused_set, &candidate_fusion);
+  MatchUbCapacityPattern(kernel_graph, &fused_set, &candidate_fusion);
   MatchFusionTypePattern(kernel_graph, &fused_set, &candidate_fusion);
 
   if (!candidate_fusion.empty()) {
@@ -0,0 +1,296 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/ascend/format_type/refine_format.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/trans.h"
+#include "kernel/oplib/oplib.h"
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+using KernelBuildInfoPtr = std::shared_ptr<kernel::KernelBuildInfo>;
+// A consumer is a kernel and its input index. The null kernel stands for an output of the graph, which is fetched in
+// the default format.
+using Consumer = std::pair<AnfNodePtr, size_t>;
+
+const size_t kMaxRefineRounds = 8;
+// The formats that insert_trans_op converts from and to the default format with a TransData.
+const std::set<std::string> kTransDataFormats = {kOpFormat_NC1HWC0, kOpFormat_FRAC_Z, kOpFormat_FRAC_NZ,
+                                                 kOpFormat_C1HWNCoC0};
+
+bool IsTransDataFormat(const std::string &format) { return kTransDataFormats.find(format) != kTransDataFormats.end(); }
+
+bool IsShapeMatchFormat(const std::vector<size_t> &shape, const std::string &format) {
+  if (!IsTransDataFormat(format) || shape.empty()) {
+    return true;
+  }
+  if (format == kOpFormat_FRAC_NZ) {
+    return shape.size() >= 2;
+  }
+  if (shape.size() > kShapeSupportFormatMap.size()) {
+    return false;
+  }
+  return kShapeSupportFormatMap[shape.size() - 1].find(format) != kShapeSupportFormatMap[shape.size() - 1].end();
+}
+
+bool HasSelectedKernelInfo(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto kernel_info = node->kernel_info();
+  return kernel_info != nullptr && kernel_info->select_kernel_build_info() != nullptr;
+}
+
+std::string OutputFormat(const session::KernelWithIndex &output, const CNodePtr &node,
+                         const KernelBuildInfoPtr &build_info) {
+  if (output.first == node) {
+    return build_info->GetOutputFormat(output.second);
+  }
+  if (!HasSelectedKernelInfo(output.first)) {
+    return kOpFormat_DEFAULT;
+  }
+  return AnfAlgo::GetOutputFormat(output.first, output.second);
+}
+
+std::string InputFormat(const Consumer &consumer, const CNodePtr &node, const KernelBuildInfoPtr &build_info) {
+  if (consumer.first == nullptr) {
+    return kOpFormat_DEFAULT;
+  }
+  if (consumer.first == node) {
+    return build_info->GetInputFormat(consumer.second);
+  }
+  if (!HasSelectedKernelInfo(consumer.first)) {
+    return kOpFormat_DEFAULT;
+  }
+  return AnfAlgo::GetInputFormat(consumer.first, consumer.second);
+}
+
+size_t OutputByteSize(const session::KernelWithIndex &output) {
+  auto type_id = AnfAlgo::GetOutputInferDataType(output.first, output.second);
+  if (HasSelectedKernelInfo(output.first) &&
+      AnfAlgo::GetOutputDeviceDataType(output.first, output.second) != kTypeUnknown) {
+    type_id = AnfAlgo::GetOutputDeviceDataType(output.first, output.second);
+  }
+  return trans::ShapeSize(AnfAlgo::GetOutputInferShape(output.first, output.second)) * trans::TypeIdSize(type_id);
+}
+
+void CollectConsumers(const FuncGraphManagerPtr &manager, const AnfNodePtr &node, size_t output_idx, bool through_tuple,
+                      std::vector<Consumer> *consumers) {
+  MS_EXCEPTION_IF_NULL(manager);
+  MS_EXCEPTION_IF_NULL(consumers);
+  auto iter = manager->node_users().find(node);
+  if (iter == manager->node_users().end()) {
+    return;
+  }
+  for (const auto &node_user : iter->second) {
+    auto user = node_user.first;
+    auto input_idx = IntToSize(node_user.second);
+    if (through_tuple) {
+      if (!AnfAlgo::CheckPrimitiveType(user, prim::kPrimTupleGetItem)) {
+        continue;
+      }
+      auto getitem = user->cast<CNodePtr>();
+      MS_EXCEPTION_IF_NULL(getitem);
+      auto index_node = getitem->input(kInputNodeOutputIndexInTupleGetItem);
+      MS_EXCEPTION_IF_NULL(index_node);
+      auto value_node = index_node->cast<ValueNodePtr>();
+      if (value_node != nullptr && IntToSize(GetValue<int>(value_node->value())) == output_idx) {
+        CollectConsumers(manager, user, 0, false, consumers);
+      }
+    } else if (AnfAlgo::CheckPrimitiveType(user, prim::kPrimDepend)) {
+      if (input_idx == kRealInputIndexInDepend) {
+        CollectConsumers(manager, user, output_idx, false, consumers);
+      }
+    } else if (AnfAlgo::CheckPrimitiveType(user, prim::kPrimControlDepend)) {
+      continue;
+    } else if (AnfAlgo::IsRealCNodeKernel(user)) {
+      consumers->emplace_back(user, input_idx - 1);
+    } else {
+      // make_tuple, return and the summaries take the tensor in the default format
+      consumers->emplace_back(nullptr, 0);
+    }
+  }
+}
+
+// The TransData kernels left for one output after insert_trans_op, CSE and eliminate_redundant_op: one from the
+// producer's format to the default format, and one from the default format to each other format of the consumers.
+size_t OutputTransDataCost(const session::KernelWithIndex &output, const std::vector<Consumer> &consumers,
+                           const CNodePtr &node, const KernelBuildInfoPtr &build_info) {
+  auto output_format = OutputFormat(output, node, build_info);
+  std::set<std::string> input_formats;
+  for (const auto &consumer : consumers) {
+    auto input_format = InputFormat(consumer, node, build_info);
+    if (input_format != output_format) {
+      (void)input_formats.insert(input_format);
+    }
+  }
+  if (input_formats.empty()) {
+    return 0;
+  }
+  size_t trans_data_num = IsTransDataFormat(output_format) ? 1 : 0;
+  for (const auto &input_format : input_formats) {
+    if (IsTransDataFormat(input_format)) {
+      ++trans_data_num;
+    }
+  }
+  return trans_data_num * OutputByteSize(output);
+}
+
+class FormatCostModel {
+ public:
+  FormatCostModel(const FuncGraphManagerPtr &manager, const CNodePtr &node) : node_(node) {
+    MS_EXCEPTION_IF_NULL(node);
+    std::set<session::KernelWithIndex> visited;
+    for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(node); ++i) {
+      AddOutput(manager, AnfAlgo::VisitKernel(AnfAlgo::GetInputNode(node, i), 0), &visited);
+    }
+    for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(node); ++i) {
+      AddOutput(manager, std::make_pair(node, i), &visited);
+    }
+  }
+  ~FormatCostModel() = default;
+
+  size_t Cost(const KernelBuildInfoPtr &build_info) const {
+    size_t cost = 0;
+    for (const auto &item : outputs_) {
+      cost += OutputTransDataCost(item.first, item.second, node_, build_info);
+    }
+    return cost;
+  }
+
+ private:
+  void AddOutput(const FuncGraphManagerPtr &manager, const session::KernelWithIndex &output,
+                 std::set<session::KernelWithIndex> *visited) {
+    MS_EXCEPTION_IF_NULL(output.first);
+    if (!visited->insert(output).second) {
+      return;
+    }
+    std::vector<Consumer> consumers;
+    CollectConsumers(manager, output.first, output.second, AnfAlgo::IsTupleOutput(output.first), &consumers);
+    outputs_.emplace_back(output, consumers);
+  }
+
+  CNodePtr node_;
+  std::vector<std::pair<session::KernelWithIndex, std::vector<Consumer>>> outputs_;
+};
+
+bool IsRefKernel(const CNodePtr &node) {
+  auto op_info = kernel::OpLib::FindOp(AnfAlgo::GetCNodeName(node), kernel::kTBE);
+  return op_info != nullptr && op_info->is_ref();
+}
+
+// The candidates keep the device types of the selected kernel info, so that insert_cast is not affected.
+bool IsCandidateKernelInfo(const CNodePtr &node, const kernel::KernelBuildInfo &selected,
+                           const kernel::KernelBuildInfo &candidate) {
+  if (candidate.GetInputNum() != selected.GetInputNum() || candidate.GetOutputNum() != selected.GetOutputNum()) {
+    return false;
+  }
+  for (size_t i = 0; i < candidate.GetInputNum(); ++i) {
+    if (candidate.GetInputDeviceType(i) != selected.GetInputDeviceType(i) ||
+        !IsShapeMatchFormat(AnfAlgo::GetPrevNodeOutputInferShape(node, i), candidate.GetInputFormat(i))) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < candidate.GetOutputNum(); ++i) {
+    if (candidate.GetOutputDeviceType(i) != selected.GetOutputDeviceType(i) ||
+        !IsShapeMatchFormat(AnfAlgo::GetOutputInferShape(node, i), candidate.GetOutputFormat(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RefineKernelFormat(const FuncGraphManagerPtr &manager, const CNodePtr &node, const KernelQueryPtr &kernel_query) {
+  MS_EXCEPTION_IF_NULL(kernel_query);
+  std::vector<KernelBuildInfoPtr> kernel_info_list;
+  kernel_query->Query(node, &kernel_info_list);
+  if (kernel_info_list.size() < 2) {
+    return false;
+  }
+  auto selected = node->kernel_info()->select_kernel_build_info();
+  MS_EXCEPTION_IF_NULL(selected);
+  if (selected->GetInputNum() != AnfAlgo::GetInputTensorNum(node) ||
+      selected->GetOutputNum() != AnfAlgo::GetOutputTensorNum(node)) {
+    return false;
+  }
+  FormatCostModel cost_model(manager, node);
+  auto selected_ptr = std::make_shared<kernel::KernelBuildInfo>(*selected);
+  size_t min_cost = cost_model.Cost(selected_ptr);
+  KernelBuildInfoPtr best = nullptr;
+  for (const auto &candidate : kernel_info_list) {
+    if (min_cost == 0) {
+      break;
+    }
+    MS_EXCEPTION_IF_NULL(candidate);
+    if (*candidate == *selected || !IsCandidateKernelInfo(node, *selected, *candidate)) {
+      continue;
+    }
+    size_t cost = cost_model.Cost(candidate);
+    if (cost < min_cost) {
+      min_cost = cost;
+      best = candidate;
+    }
+  }
+  if (best == nullptr) {
+    return false;
+  }
+  MS_LOG(DEBUG) << "Refine the kernel info of " << node->DebugString() << " from " << selected->ToString() << " to "
+                << best->ToString();
+  AnfAlgo::SetSelectKernelBuildInfo(best, node.get());
+  return true;
+}
+}  // namespace
+
+bool RefineFormat::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::vector<CNodePtr> kernels;
+  for (const auto &node : TopoSort(func_graph->get_return())) {
+    if (!AnfAlgo::IsRealCNodeKernel(node) || !HasSelectedKernelInfo(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    // the outputs of a ref kernel are its inputs, their formats are bound to the parameters
+    if (IsRefKernel(cnode)) {
+      continue;
+    }
+    kernels.push_back(cnode);
+  }
+  // Each change strictly lowers the total cost, so the sweeps end; the bound only keeps the compile time linear.
+  bool changed = false;
+  for (size_t round = 0; round < kMaxRefineRounds; ++round) {
+    bool round_changed = false;
+    for (const auto &kernel : kernels) {
+      round_changed = RefineKernelFormat(manager, kernel, kernel_query_) || round_changed;
+    }
+    if (!round_changed) {
+      break;
+    }
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
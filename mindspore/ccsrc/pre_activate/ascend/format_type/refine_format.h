@@ -0,0 +1,43 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_ASCEND_FORMAT_TYPE_REFINE_FORMAT_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_ASCEND_FORMAT_TYPE_REFINE_FORMAT_H_
+
+#include <memory>
+#include "pre_activate/common/pass.h"
+#include "pre_activate/ascend/ascend_helper.h"
+
+namespace mindspore {
+namespace opt {
+// Reselect the kernel build infos after the kernel select, so that the formats of connected kernels agree and
+// insert_trans_op has fewer TransData to insert. Each kernel is moved to the queried build info with the same
+// device types that has the lowest TransData cost with its producers and consumers, the cost of a TransData being
+// the byte size of the tensor it converts. The graph is swept until no kernel changes, so a format spreads over the
+// region of kernels that support it.
+class RefineFormat : public Pass {
+ public:
+  RefineFormat() : Pass("refine_format"), kernel_query_(std::make_shared<KernelQuery>()) {}
+  ~RefineFormat() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+
+ private:
+  KernelQueryPtr kernel_query_;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_ASCEND_FORMAT_TYPE_REFINE_FORMAT_H_
@@ -15,6 +15,7 @@
  */
 #include "pre_activate/ascend/ir_fusion/allreduce_fusion.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <memory>
@@ -23,6 +24,7 @@
 #include "utils/utils.h"
 #include "utils/graph_utils.h"
 #include "operator/ops.h"
+#include "ir/dtype.h"
 #include "device/kernel_info.h"
 #include "session/anf_runtime_algorithm.h"
 #include "kernel/kernel_build_info.h"
@@ -64,6 +66,61 @@ kernel::KernelBuildInfoPtr GenerateKernelBuildInfo(const AllReduceInfo_t &allred
   builder.SetOutputsDeviceType(outputs_device_type);
   return builder.Build();
 }
+
+// the length of the longest path from the inputs of the graph to a node, the backward produces the gradients of the
+// smaller depth earlier
+std::unordered_map<AnfNodePtr, size_t> GetNodeDepth(const std::vector<AnfNodePtr> &node_list) {
+  std::unordered_map<AnfNodePtr, size_t> depth;
+  for (auto &node : node_list) {
+    if (node == nullptr) {
+      continue;
+    }
+    size_t node_depth = 0;
+    if (node->isa<CNode>()) {
+      for (auto &input : node->cast<CNodePtr>()->inputs()) {
+        auto iter = depth.find(input);
+        if (iter != depth.end()) {
+          node_depth = std::max(node_depth, iter->second + 1);
+        }
+      }
+    }
+    depth[node] = node_depth;
+  }
+  return depth;
+}
+
+// the size in MB of the inputs of an allreduce
+float GetInputGradSize(const CNodePtr &cnode) {
+  size_t total_size = 0;
+  for (size_t input_index = 0; input_index < AnfAlgo::GetInputTensorNum(cnode); ++input_index) {
+    auto shape = AnfAlgo::GetPrevNodeOutputInferShape(cnode, input_index);
+    size_t size = GetTypeByte(TypeIdToType(AnfAlgo::GetPrevNodeOutputInferDataType(cnode, input_index)));
+    for (auto dim : shape) {
+      size *= dim;
+    }
+    total_size += size;
+  }
+  return static_cast<float>(total_size) / (1024 * 1024);
+}
+
+// order the allreduces as their gradients get ready, so the first segment is launched as early as possible
+void SortByReadiness(const std::unordered_map<AnfNodePtr, size_t> &depth, AllReduceInfo_t *allreduce_node_info) {
+  MS_EXCEPTION_IF_NULL(allreduce_node_info);
+  std::vector<size_t> order(allreduce_node_info->allreduce_node.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  auto &nodes = allreduce_node_info->allreduce_node;
+  std::stable_sort(order.begin(), order.end(),
+                   [&depth, &nodes](size_t a, size_t b) { return depth.at(nodes[a]) < depth.at(nodes[b]); });
+  AllReduceInfo_t sorted_info;
+  for (auto index : order) {
+    sorted_info.allreduce_node.push_back(allreduce_node_info->allreduce_node[index]);
+    sorted_info.input_grad_size.push_back(allreduce_node_info->input_grad_size[index]);
+    sorted_info.input_grad_time.push_back(allreduce_node_info->input_grad_time[index]);
+  }
+  *allreduce_node_info = sorted_info;
+}
 }  // namespace
 
 bool AllReduceFusion::GetSplitSegments(const AllReduceInfo_t &allreduce_node_info, size_t *segment_num,
@@ -76,6 +133,7 @@ bool AllReduceFusion::GetSplitSegments(const AllReduceInfo_t &allreduce_node_inf
   auto parallel_context = parallel::ParallelContext::GetInstance();
   MS_EXCEPTION_IF_NULL(parallel_context);
   const std::vector<uint32_t> split_indices = parallel_context->all_reduce_fusion_split_indices();
+  const std::vector<uint32_t> split_sizes = parallel_context->all_reduce_fusion_split_sizes();
 
   size_t segments = 0;
   if (split_indices.size() != 0) {
@@ -93,6 +151,21 @@ bool AllReduceFusion::GetSplitSegments(const AllReduceInfo_t &allreduce_node_inf
       segment_index->push_back(allreduce_node_size - 1);
       segments++;
     }
+  } else if (split_sizes.size() != 0) {
+    // the segments take the sizes in MB in turn, and the last one takes the rest
+    float segment_size = 0.0;
+    size_t size_index = 0;
+    for (size_t i = 0; i + 1 < allreduce_node_size && size_index < split_sizes.size(); ++i) {
+      segment_size += allreduce_node_info.input_grad_size[i];
+      if (segment_size >= static_cast<float>(split_sizes[size_index])) {
+        segment_index->push_back(i);
+        segments++;
+        size_index++;
+        segment_size = 0.0;
+      }
+    }
+    segment_index->push_back(allreduce_node_size - 1);
+    segments++;
   } else {
     segments = groups_;
     for (size_t i = 0; i < segments - 1; ++i) {
@@ -200,7 +273,6 @@ bool AllReduceFusion::DoFusion(const FuncGraphPtr &func_graph, const AllReduceIn
 
 bool AllReduceFusion::Run(const FuncGraphPtr &func_graph) {
   MS_EXCEPTION_IF_NULL(func_graph);
-  const float input_grad_size_num = 0.0;
   const float input_grad_time_num = 0.0;
   // divide candidate fusion groups with same (group,op,fusion) attrs, fusion==0 means not fusion
   std::unordered_map<std::string, AllReduceInfo_t> candidate_groups;
@@ -221,16 +293,25 @@ bool AllReduceFusion::Run(const FuncGraphPtr &func_graph) {
         candidate_groups[key] = allreduce_node_info;
       }
       candidate_groups[key].allreduce_node.push_back(node->cast<CNodePtr>());
-      candidate_groups[key].input_grad_size.push_back(input_grad_size_num);
+      candidate_groups[key].input_grad_size.push_back(GetInputGradSize(node->cast<CNodePtr>()));
       candidate_groups[key].input_grad_time.push_back(input_grad_time_num);
     }
   }
+  // the split indices given are of the allreduces in the topological order, otherwise the segments are split in the
+  // order of the gradients getting ready
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  bool sort_by_readiness = parallel_context->all_reduce_fusion_split_indices().empty();
+  auto depth = GetNodeDepth(node_list);
   // split candidate group to segments according to _group class member
   bool changed = false;
   for (auto &it : candidate_groups) {
     if (it.second.allreduce_node.size() <= 1) {
       continue;
     }
+    if (sort_by_readiness) {
+      SortByReadiness(depth, &it.second);
+    }
     size_t segment_num = 0;
     std::vector<size_t> segment_index;
     if (GetSplitSegments(it.second, &segment_num, &segment_index)) {
@@ -17,6 +17,7 @@
 #include <memory>
 #include <string>
 #include "pre_activate/common/optimizer.h"
+#include "pre_activate/pass/const_folding.h"
 #include "pre_activate/pass/convert_const_input_to_attr.h"
 #include "pre_activate/pass/convert_const_input_to_tensor_input.h"
 #include "pre_activate/pass/convert_tuple_input_to_dynamic_input.h"
@@ -40,6 +41,7 @@ void BackendCommonOptimization(const std::shared_ptr<session::KernelGraph> &kern
   auto optimizer = std::make_shared<GraphOptimizer>();
   auto common_pm = std::make_shared<PassManager>("common_pm");
   common_pm->AddPass(std::make_shared<ConvertConstInputToAttr>());
+  common_pm->AddPass(std::make_shared<ConstFolding>());
   common_pm->AddPass(std::make_shared<ConvertConstInputToTensorInput>());
   common_pm->AddPass(std::make_shared<ConvertTupleInputToDynamicInput>());
   optimizer->AddPassManager(common_pm);
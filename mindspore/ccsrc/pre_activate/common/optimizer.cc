@@ -108,6 +108,49 @@ AnfNodePtr HandleSexpVector(const BaseRef &sexp, const BaseRef &graph, bool mult
   }
   return CreateCNodeWithGraph(input_nodes, graph);
 }
+
+bool BuildSkeleton(const AnfNodePtr &pattern, PatternSkeleton *const skeleton) {
+  MS_EXCEPTION_IF_NULL(skeleton);
+  MS_EXCEPTION_IF_NULL(pattern);
+  auto cnode = pattern->cast<CNodePtr>();
+  if (cnode == nullptr || cnode->size() == 0 || !IsValueNode<Primitive>(cnode->input(0))) {
+    return false;
+  }
+  skeleton->prim_name = GetValueNode<PrimitivePtr>(cnode->input(0))->name();
+  skeleton->input_num = cnode->size();
+  for (size_t i = 1; i < cnode->size(); ++i) {
+    auto input = cnode->input(i);
+    if (input->isa<VarNode>() && input->cast<VarNodePtr>()->var_->isa<SeqVar>()) {
+      skeleton->has_seq_var = true;
+      break;
+    }
+    PatternSkeleton input_skeleton;
+    input_skeleton.index = i;
+    if (BuildSkeleton(input, &input_skeleton)) {
+      skeleton->inputs.push_back(std::move(input_skeleton));
+    }
+  }
+  return true;
+}
+
+bool SkeletonFits(const PatternSkeleton &skeleton, const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto cnode = node->cast<CNodePtr>();
+  if (cnode == nullptr) {
+    return false;
+  }
+  // a SeqVar can match no input
+  if (skeleton.has_seq_var ? cnode->size() + 1 < skeleton.input_num : cnode->size() != skeleton.input_num) {
+    return false;
+  }
+  auto prim = GetCNodePrimitive(cnode);
+  if (prim == nullptr || prim->name() != skeleton.prim_name) {
+    return false;
+  }
+  return std::all_of(skeleton.inputs.begin(), skeleton.inputs.end(), [&cnode](const PatternSkeleton &input) {
+    return SkeletonFits(input, cnode->input(input.index));
+  });
+}
 }  // namespace
 
 static bool AnfEqual(const BaseRef &a, const BaseRef &b) {
@@ -177,12 +220,19 @@ void PatternProcessPass::Build() {
   VarPtr fg = std::make_shared<Var>("RootG");
   BaseRef pattern = std::move(DefinePattern());
   pattern_ = SexpToNode(pattern, fg, multigraph_);
+  auto skeleton = std::make_shared<PatternSkeleton>();
+  if (BuildSkeleton(pattern_, skeleton.get())) {
+    skeleton_ = skeleton;
+  }
 }
 
 AnfNodePtr PatternProcessPass::Run(const FuncGraphPtr &func_graph, const AnfNodePtr &node) {
   if (pattern_ == nullptr) {
     Build();
   }
+  if (skeleton_ != nullptr && !SkeletonFits(*skeleton_, node)) {
+    return nullptr;
+  }
 
   auto empty_equiv = std::make_shared<Equiv>();
   EquivPtr equiv = pattern_engine_.Match(pattern_, node, empty_equiv);
@@ -32,6 +32,17 @@ namespace mindspore {
 namespace opt {
 using PatternListType = std::initializer_list<BaseRef>;
 
+// The primitive and the input number of a cnode of primitive in the pattern, with the ones of its inputs which are
+// cnodes of primitive too. A node not fitting them can't match the pattern, it's checked before building the equiv.
+struct PatternSkeleton {
+  size_t index = 0;
+  std::string prim_name;
+  size_t input_num = 0;
+  // the inputs from the SeqVar on have no fixed index, the input number is the least one then
+  bool has_seq_var = false;
+  std::vector<PatternSkeleton> inputs;
+};
+
 class PatternProcessPass : public NodePass {
  public:
   explicit PatternProcessPass(const std::string &name = "", bool multigraph = true);
@@ -44,6 +55,8 @@ class PatternProcessPass : public NodePass {
   void Build();
 
   AnfNodePtr pattern_ = nullptr;
+  // null if the root of the pattern isn't a cnode of primitive
+  std::shared_ptr<PatternSkeleton> skeleton_ = nullptr;
   bool multigraph_ = true;
   PatternEngine pattern_engine_;
 };
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/gpu/apply_momentum_fusion.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "kernel/kernel_build_info.h"
+#include "pre_activate/common/helper.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kApplyMomentumInputNum = 5;
+
+bool IsFusibleMomentum(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || AnfAlgo::GetCNodeName(node) != kApplyMomentumOpName) {
+    return false;
+  }
+  if (AnfAlgo::GetInputTensorNum(node) != kApplyMomentumInputNum || AnfAlgo::GetOutputTensorNum(node) != 1) {
+    return false;
+  }
+  auto type_id = AnfAlgo::GetOutputDeviceDataType(node, 0);
+  if (type_id != kNumberTypeFloat32 && type_id != kNumberTypeFloat16) {
+    return false;
+  }
+  for (size_t i = 0; i < kApplyMomentumInputNum; ++i) {
+    if (AnfAlgo::GetInputDeviceDataType(node, i) != type_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The candidates which the inputs of any candidate depend on
+std::unordered_set<AnfNodePtr> FindDependedMomentums(const std::vector<CNodePtr> &momentums) {
+  std::unordered_set<AnfNodePtr> candidates(momentums.begin(), momentums.end());
+  std::unordered_set<AnfNodePtr> depended;
+  std::unordered_set<AnfNodePtr> visited;
+  std::vector<AnfNodePtr> todo;
+  for (auto &momentum : momentums) {
+    todo.insert(todo.end(), momentum->inputs().begin() + 1, momentum->inputs().end());
+  }
+  while (!todo.empty()) {
+    auto node = todo.back();
+    todo.pop_back();
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    if (candidates.find(node) != candidates.end()) {
+      (void)depended.insert(node);
+    }
+    if (node->isa<CNode>()) {
+      auto &inputs = node->cast<CNodePtr>()->inputs();
+      todo.insert(todo.end(), inputs.begin(), inputs.end());
+    }
+  }
+  return depended;
+}
+
+CNodePtr CreateFusedMomentum(const std::shared_ptr<session::KernelGraph> &kernel_graph,
+                             const std::vector<CNodePtr> &momentums, TypeId type_id) {
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(kFusedApplyMomentumOpName))};
+  std::vector<TypeId> types;
+  std::vector<std::vector<size_t>> shapes;
+  for (auto &momentum : momentums) {
+    inputs.insert(inputs.end(), momentum->inputs().begin() + 1, momentum->inputs().end());
+    types.push_back(AnfAlgo::GetOutputInferDataType(momentum, 0));
+    shapes.push_back(AnfAlgo::GetOutputInferShape(momentum, 0));
+  }
+  auto fused_node = kernel_graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_scope(momentums.back()->scope());
+  AnfAlgo::SetOutputInferTypeAndShape(types, shapes, fused_node.get());
+
+  auto input_num = inputs.size() - 1;
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+  builder->SetInputsDeviceType(std::vector<TypeId>(input_num, type_id));
+  builder->SetOutputsFormat(std::vector<std::string>(momentums.size(), kOpFormat_DEFAULT));
+  builder->SetOutputsDeviceType(std::vector<TypeId>(momentums.size(), type_id));
+  builder->SetKernelType(UNKNOWN_KERNEL_TYPE);
+  builder->SetProcessor(kernel::Processor::CUDA);
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), fused_node.get());
+  return fused_node;
+}
+}  // namespace
+
+bool ApplyMomentumFusion::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto kernel_graph = func_graph->cast<std::shared_ptr<session::KernelGraph>>();
+  if (kernel_graph == nullptr) {
+    return false;
+  }
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::vector<CNodePtr> momentums;
+  for (auto &node : TopoSort(func_graph->get_return())) {
+    if (IsFusibleMomentum(node)) {
+      momentums.push_back(node->cast<CNodePtr>());
+    }
+  }
+  auto depended = FindDependedMomentums(momentums);
+  std::map<TypeId, std::vector<CNodePtr>> groups;
+  for (auto &momentum : momentums) {
+    if (depended.find(momentum) == depended.end()) {
+      groups[AnfAlgo::GetOutputDeviceDataType(momentum, 0)].push_back(momentum);
+    }
+  }
+  bool changed = false;
+  for (auto &group : groups) {
+    auto &group_momentums = group.second;
+    if (group_momentums.size() < 2) {
+      continue;
+    }
+    auto fused_node = CreateFusedMomentum(kernel_graph, group_momentums, group.first);
+    std::vector<AnfNodePtr> outputs;
+    CreateMultipleOutputsOfAnfNode(func_graph, fused_node, group_momentums.size(), &outputs);
+    for (size_t i = 0; i < group_momentums.size(); ++i) {
+      (void)manager->Replace(group_momentums[i], outputs[i]);
+    }
+    MS_LOG(INFO) << "Fuse " << group_momentums.size() << " ApplyMomentum kernels of type " << TypeIdLabel(group.first)
+                 << " into " << fused_node->DebugString();
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
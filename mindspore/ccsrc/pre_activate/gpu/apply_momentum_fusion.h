@@ -0,0 +1,35 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_APPLY_MOMENTUM_FUSION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_APPLY_MOMENTUM_FUSION_H_
+#include "pre_activate/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// Fuse the ApplyMomentum kernels of a graph with the same data type into one FusedApplyMomentum kernel, which updates
+// all the parameters in a few launches instead of one launch for each parameter. The inputs of the fused kernel are
+// the five inputs of each ApplyMomentum in turn, and its output i replaces the output of the ApplyMomentum i. An
+// ApplyMomentum depended on by another one is left alone, the fused kernel would depend on itself.
+class ApplyMomentumFusion : public Pass {
+ public:
+  ApplyMomentumFusion() : Pass("apply_momentum_fusion") {}
+  ~ApplyMomentumFusion() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_APPLY_MOMENTUM_FUSION_H_
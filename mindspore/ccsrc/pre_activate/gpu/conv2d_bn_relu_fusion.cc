@@ -0,0 +1,134 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/gpu/conv2d_bn_relu_fusion.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include "kernel/kernel_build_info.h"
+#include "operator/ops.h"
+#include "pre_activate/common/helper.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kConv2DBNReluInputNum = 6;
+
+bool IsSupportedConv(const CNodePtr &conv) {
+  if (AnfAlgo::GetInputTensorNum(conv) != 2 || AnfAlgo::GetNodeAttr<int>(conv, "group") != 1) {
+    return false;
+  }
+  if (AnfAlgo::GetOutputInferShape(conv, 0).size() != kShape4dDims) {
+    return false;
+  }
+  // the asymmetric same padding is done by a padded copy of the input in the Conv2D kernel
+  auto pad_mode = AnfAlgo::GetNodeAttr<std::string>(conv, "pad_mode");
+  if (pad_mode == "same" || pad_mode == "SAME") {
+    auto pad_list = AnfAlgo::GetNodeAttr<std::vector<int>>(conv, "pad_list");
+    if (pad_list.size() != 4 || pad_list[0] != pad_list[1] || pad_list[2] != pad_list[3]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HasSameDeviceType(const CNodePtr &conv, const CNodePtr &bn) {
+  auto type_id = AnfAlgo::GetOutputDeviceDataType(conv, 0);
+  if (type_id != kNumberTypeFloat32 && type_id != kNumberTypeFloat16) {
+    return false;
+  }
+  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(conv); ++i) {
+    if (AnfAlgo::GetInputDeviceDataType(conv, i) != type_id) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(bn); ++i) {
+    if (AnfAlgo::GetInputDeviceDataType(bn, i) != type_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CNodePtr CreateConv2DBNRelu(const std::shared_ptr<session::KernelGraph> &kernel_graph, const CNodePtr &conv,
+                            const CNodePtr &bn, const CNodePtr &relu) {
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(kFusedConv2DBNReluOpName)),
+                                    conv->input(1), conv->input(2)};
+  inputs.insert(inputs.end(), bn->inputs().begin() + 2, bn->inputs().end());
+  auto fused_node = kernel_graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_scope(relu->scope());
+  AnfAlgo::SetOutputInferTypeAndShape({AnfAlgo::GetOutputInferDataType(relu, 0)},
+                                      {AnfAlgo::GetOutputInferShape(relu, 0)}, fused_node.get());
+  AnfAlgo::CopyNodeAttrs(conv, fused_node);
+  AnfAlgo::CopyNodeAttr(kAttrEpsilon, bn, fused_node);
+
+  auto type_id = AnfAlgo::GetOutputDeviceDataType(conv, 0);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat(std::vector<std::string>(kConv2DBNReluInputNum, kOpFormat_DEFAULT));
+  builder->SetInputsDeviceType(std::vector<TypeId>(kConv2DBNReluInputNum, type_id));
+  builder->SetOutputsFormat({kOpFormat_DEFAULT});
+  builder->SetOutputsDeviceType({type_id});
+  builder->SetKernelType(UNKNOWN_KERNEL_TYPE);
+  builder->SetProcessor(kernel::Processor::CUDA);
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), fused_node.get());
+  return fused_node;
+}
+}  // namespace
+
+const BaseRef Conv2DBNReluFusion::DefinePattern() const {
+  VarPtr Xs = std::make_shared<SeqVar>();
+  VarPtr Ys = std::make_shared<SeqVar>();
+  VarPtr Z = std::make_shared<Var>();
+  return VectorRef({prim::kPrimRelu,
+                    VectorRef({prim::kPrimTupleGetItem,
+                               VectorRef({prim::kPrimBatchNorm, VectorRef({prim::kPrimConv2D, Xs}), Ys}), Z})});
+}
+
+const AnfNodePtr Conv2DBNReluFusion::Process(const FuncGraphPtr &func_graph, const AnfNodePtr &node,
+                                             const EquivPtr &) const {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  MS_EXCEPTION_IF_NULL(node);
+  auto kernel_graph = func_graph->cast<std::shared_ptr<session::KernelGraph>>();
+  if (kernel_graph == nullptr) {
+    return nullptr;
+  }
+  auto relu = CheckAnfNodeIfCNodeAndInputSize(node, kReluInputNum);
+  auto tuple_getitem = CheckAnfNodeIfCNodeAndInputSize(relu->input(1), kTupleGetitemInputNum);
+  auto bn = CheckAnfNodeIfCNodeAndInputSize(tuple_getitem->input(kRealInputNodeIndexInTupleGetItem), kBnInputNum);
+  auto conv = CheckAnfNodeIfCNodeAndInputSize(bn->input(1), kConvInputNum);
+  auto index_node = tuple_getitem->input(kInputNodeOutputIndexInTupleGetItem);
+  MS_EXCEPTION_IF_NULL(index_node);
+  auto value_node = index_node->cast<ValueNodePtr>();
+  if (value_node == nullptr || GetValue<int>(value_node->value()) != 0) {
+    return nullptr;
+  }
+  if (IsUsedByOthers(func_graph, tuple_getitem) || IsUsedByOthers(func_graph, bn) ||
+      IsUsedByOthers(func_graph, conv)) {
+    return nullptr;
+  }
+  if (!IsSupportedConv(conv) || !HasSameDeviceType(conv, bn)) {
+    return nullptr;
+  }
+  auto fused_node = CreateConv2DBNRelu(kernel_graph, conv, bn, relu);
+  MS_LOG(INFO) << "Fuse " << conv->DebugString() << ", " << bn->DebugString() << " and " << relu->DebugString()
+               << " into " << fused_node->DebugString();
+  return fused_node;
+}
+}  // namespace opt
+}  // namespace mindspore
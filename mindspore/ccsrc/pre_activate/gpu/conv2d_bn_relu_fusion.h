@@ -0,0 +1,35 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_CONV2D_BN_RELU_FUSION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_CONV2D_BN_RELU_FUSION_H_
+#include "pre_activate/common/optimizer.h"
+
+namespace mindspore {
+namespace opt {
+// Fuse Conv2D, the inference BatchNorm and ReLU into one FusedConv2DBNRelu kernel for the eval graphs on GPU, which
+// folds the BatchNorm into the filter and a bias and runs them in one cudnnConvolutionBiasActivationForward. Only the
+// chains whose intermediate outputs have no other users are fused, the training FusedBatchNorm is left alone.
+class Conv2DBNReluFusion : public PatternProcessPass {
+ public:
+  explicit Conv2DBNReluFusion(bool multigraph = true) : PatternProcessPass("conv2d_bn_relu_fusion", multigraph) {}
+  ~Conv2DBNReluFusion() override = default;
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_CONV2D_BN_RELU_FUSION_H_
@@ -0,0 +1,202 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/gpu/elemwise_fusion.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "kernel/kernel_build_info.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+const std::set<std::string> kUnaryElemwiseOpSet = {"Exp", "Log", "Neg", "Reciprocal", "ReLU"};
+const std::set<std::string> kBinaryElemwiseOpSet = {"TensorAdd", "Sub", "Mul", kRealDivOpName};
+
+size_t ShapeSize(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+}
+
+bool IsFusibleNode(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  auto op_name = AnfAlgo::GetCNodeName(cnode);
+  size_t input_num = 0;
+  if (kUnaryElemwiseOpSet.find(op_name) != kUnaryElemwiseOpSet.end()) {
+    input_num = 1;
+  } else if (kBinaryElemwiseOpSet.find(op_name) != kBinaryElemwiseOpSet.end()) {
+    input_num = 2;
+  }
+  if (input_num == 0 || AnfAlgo::GetInputTensorNum(cnode) != input_num || AnfAlgo::GetOutputTensorNum(cnode) != 1) {
+    return false;
+  }
+  auto type_id = AnfAlgo::GetOutputDeviceDataType(cnode, 0);
+  if (type_id != kNumberTypeFloat32 && type_id != kNumberTypeFloat16) {
+    return false;
+  }
+  auto output_size = ShapeSize(AnfAlgo::GetOutputInferShape(cnode, 0));
+  if (output_size == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < input_num; ++i) {
+    if (AnfAlgo::GetInputDeviceDataType(cnode, i) != type_id) {
+      return false;
+    }
+    auto input_size = ShapeSize(AnfAlgo::GetPrevNodeOutputInferShape(cnode, i));
+    if (input_size != output_size && input_size != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The nodes fused into the root, within the limits of the ops and the inputs of the fused kernel
+std::unordered_set<AnfNodePtr> FindChain(const FuncGraphManagerPtr &manager, const CNodePtr &root) {
+  auto output_size = ShapeSize(AnfAlgo::GetOutputInferShape(root, 0));
+  std::unordered_set<AnfNodePtr> chain = {root};
+  // the inputs of the chain at most, without the ones shared by several nodes
+  size_t input_num = AnfAlgo::GetInputTensorNum(root);
+  std::vector<CNodePtr> todo = {root};
+  while (!todo.empty() && chain.size() < kMaxFusedElemwiseOpNum) {
+    auto node = todo.back();
+    todo.pop_back();
+    for (size_t i = 1; i < node->inputs().size() && chain.size() < kMaxFusedElemwiseOpNum; ++i) {
+      auto input = node->input(i);
+      if (chain.find(input) != chain.end() || !IsFusibleNode(input) ||
+          ShapeSize(AnfAlgo::GetOutputInferShape(input, 0)) != output_size) {
+        continue;
+      }
+      // the intermediate result is not written out, the chain must be its only user
+      if (manager->node_users()[input].size() != 1) {
+        continue;
+      }
+      auto input_cnode = input->cast<CNodePtr>();
+      auto new_input_num = input_num + AnfAlgo::GetInputTensorNum(input_cnode) - 1;
+      if (new_input_num > kMaxFusedElemwiseInputNum) {
+        continue;
+      }
+      (void)chain.insert(input);
+      input_num = new_input_num;
+      todo.push_back(input_cnode);
+    }
+  }
+  return chain;
+}
+
+CNodePtr CreateFusedNode(const std::shared_ptr<session::KernelGraph> &kernel_graph, const CNodePtr &root,
+                         const std::unordered_set<AnfNodePtr> &chain) {
+  // the nodes in the order of the computation and the inputs of the chain in the order of their first use
+  std::vector<CNodePtr> nodes;
+  std::vector<AnfNodePtr> inputs;
+  std::unordered_set<AnfNodePtr> visited;
+  std::function<void(const AnfNodePtr &)> visit = [&](const AnfNodePtr &node) {
+    if (!visited.insert(node).second) {
+      return;
+    }
+    if (chain.find(node) == chain.end()) {
+      inputs.push_back(node);
+      return;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      visit(cnode->input(i));
+    }
+    nodes.push_back(cnode);
+  };
+  visit(root);
+  // the registers of one element: the inputs, then the result of each op
+  std::unordered_map<AnfNodePtr, int> regs;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    regs[inputs[i]] = SizeToInt(i);
+  }
+  std::vector<std::string> ops;
+  std::vector<int> lhs;
+  std::vector<int> rhs;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    auto &node = nodes[i];
+    ops.push_back(AnfAlgo::GetCNodeName(node));
+    lhs.push_back(regs[node->input(1)]);
+    rhs.push_back(node->inputs().size() > 2 ? regs[node->input(2)] : -1);
+    regs[node] = SizeToInt(inputs.size() + i);
+  }
+
+  std::vector<AnfNodePtr> fused_inputs = {NewValueNode(std::make_shared<Primitive>(kFusedElemwiseOpName))};
+  (void)fused_inputs.insert(fused_inputs.end(), inputs.begin(), inputs.end());
+  auto fused_node = kernel_graph->NewCNode(fused_inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_abstract(root->abstract());
+  fused_node->set_scope(root->scope());
+  AnfAlgo::SetNodeAttr(kAttrFusedOps, MakeValue(ops), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOpLhs, MakeValue(lhs), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOpRhs, MakeValue(rhs), fused_node);
+
+  auto type_id = AnfAlgo::GetOutputDeviceDataType(root, 0);
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat(std::vector<std::string>(inputs.size(), kOpFormat_DEFAULT));
+  builder->SetInputsDeviceType(std::vector<TypeId>(inputs.size(), type_id));
+  builder->SetOutputsFormat({kOpFormat_DEFAULT});
+  builder->SetOutputsDeviceType({type_id});
+  builder->SetKernelType(UNKNOWN_KERNEL_TYPE);
+  builder->SetProcessor(kernel::Processor::CUDA);
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), fused_node.get());
+  return fused_node;
+}
+}  // namespace
+
+bool ElemwiseFusion::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto kernel_graph = func_graph->cast<std::shared_ptr<session::KernelGraph>>();
+  if (kernel_graph == nullptr) {
+    return false;
+  }
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto todos = TopoSort(func_graph->get_return());
+  std::unordered_set<AnfNodePtr> fused;
+  bool changed = false;
+  // from the outputs, so each chain is fused into its last node
+  for (auto iter = todos.rbegin(); iter != todos.rend(); ++iter) {
+    auto &node = *iter;
+    if (fused.find(node) != fused.end() || !IsFusibleNode(node)) {
+      continue;
+    }
+    auto root = node->cast<CNodePtr>();
+    auto chain = FindChain(manager, root);
+    if (chain.size() < 2) {
+      continue;
+    }
+    auto fused_node = CreateFusedNode(kernel_graph, root, chain);
+    MS_LOG(INFO) << "Fuse " << chain.size() << " elementwise kernels into " << fused_node->DebugString();
+    fused.insert(chain.begin(), chain.end());
+    (void)manager->Replace(root, fused_node);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,35 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_ELEMWISE_FUSION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_ELEMWISE_FUSION_H_
+#include "pre_activate/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// Fuse the chains of the elementwise kernels on GPU, such as Mul->TensorAdd->ReLU, into one FusedElemwise kernel,
+// which keeps the intermediate results in registers instead of the global memory. A kernel joins the chain of its
+// user if the user is its only one and it has the whole shape of the chain output. The inputs of the chain may be
+// broadcast from one element, the other broadcasts are left to the kernels of the ops.
+class ElemwiseFusion : public Pass {
+ public:
+  ElemwiseFusion() : Pass("elemwise_fusion") {}
+  ~ElemwiseFusion() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_ELEMWISE_FUSION_H_
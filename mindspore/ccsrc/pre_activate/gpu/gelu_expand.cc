@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/gpu/gelu_expand.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include "ir/meta_tensor.h"
+#include "kernel/oplib/oplib.h"
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr float kGeluHalf = 0.5;
+constexpr float kGeluCubeCoeff = 0.044715;
+constexpr float kGeluSqrtTwoDivPi = 0.7978845608;
+
+bool CanExpand(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!AnfAlgo::IsRealCNodeKernel(node) || AnfAlgo::GetCNodeName(node) != prim::kPrimGelu->name()) {
+    return false;
+  }
+  auto type_id = AnfAlgo::GetOutputInferDataType(node, 0);
+  return type_id == kNumberTypeFloat32 || type_id == kNumberTypeFloat16;
+}
+
+ValueNodePtr NewScalarNode(const std::shared_ptr<session::KernelGraph> &kernel_graph, TypeId type_id, float value) {
+  auto tensor = std::make_shared<tensor::Tensor>(type_id, std::vector<int>{1});
+  if (type_id == kNumberTypeFloat16) {
+    *static_cast<float16 *>(tensor->data_c(true)) = float16(value);
+  } else {
+    *static_cast<float *>(tensor->data_c(true)) = value;
+  }
+  auto value_node = std::make_shared<ValueNode>(tensor);
+  value_node->set_abstract(tensor->ToAbstract());
+  value_node = kernel_graph->NewValueNode(value_node);
+  kernel_graph->AddValueNodeToGraph(value_node);
+  return value_node;
+}
+
+CNodePtr NewBasicNode(const std::shared_ptr<session::KernelGraph> &kernel_graph, const CNodePtr &gelu,
+                      const PrimitivePtr &prim, const std::vector<AnfNodePtr> &inputs) {
+  auto primitive = std::make_shared<Primitive>(prim->name());
+  std::vector<std::string> input_names = {"x", "y"};
+  input_names.resize(inputs.size());
+  primitive->set_attr(kAttrInputNames, MakeValue(input_names));
+  primitive->set_attr(kAttrOutputNames, MakeValue(std::vector<std::string>{"output"}));
+  std::vector<AnfNodePtr> new_inputs = {NewValueNode(primitive)};
+  (void)new_inputs.insert(new_inputs.end(), inputs.begin(), inputs.end());
+  auto node = kernel_graph->NewCNode(new_inputs);
+  MS_EXCEPTION_IF_NULL(node);
+  // all the ops are elementwise, they have the shape and the type of the gelu
+  node->set_abstract(gelu->abstract());
+  node->set_scope(gelu->scope());
+  return node;
+}
+
+CNodePtr ExpandGelu(const std::shared_ptr<session::KernelGraph> &kernel_graph, const CNodePtr &gelu) {
+  auto type_id = AnfAlgo::GetOutputInferDataType(gelu, 0);
+  auto x = gelu->input(1);
+  auto x_square = NewBasicNode(kernel_graph, gelu, prim::kPrimMul, {x, x});
+  auto x_cube = NewBasicNode(kernel_graph, gelu, prim::kPrimMul, {x_square, x});
+  auto cube_term = NewBasicNode(kernel_graph, gelu, prim::kPrimMul,
+                                {x_cube, NewScalarNode(kernel_graph, type_id, kGeluCubeCoeff)});
+  auto inner = NewBasicNode(kernel_graph, gelu, prim::kPrimTensorAdd, {x, cube_term});
+  auto scaled = NewBasicNode(kernel_graph, gelu, prim::kPrimMul,
+                             {inner, NewScalarNode(kernel_graph, type_id, kGeluSqrtTwoDivPi)});
+  auto tanh = NewBasicNode(kernel_graph, gelu, prim::kPrimTanh, {scaled});
+  auto one_plus =
+    NewBasicNode(kernel_graph, gelu, prim::kPrimTensorAdd, {tanh, NewScalarNode(kernel_graph, type_id, 1)});
+  auto half_x = NewBasicNode(kernel_graph, gelu, prim::kPrimMul, {x, NewScalarNode(kernel_graph, type_id, kGeluHalf)});
+  return NewBasicNode(kernel_graph, gelu, prim::kPrimMul, {half_x, one_plus});
+}
+}  // namespace
+
+bool GeluExpand::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto kernel_graph = func_graph->cast<std::shared_ptr<session::KernelGraph>>();
+  if (kernel_graph == nullptr) {
+    return false;
+  }
+  // the expansion only pays off if the basic ops are compiled by AKG, and fused by GraphKernelFusion
+  for (const auto &prim : {prim::kPrimMul, prim::kPrimTensorAdd, prim::kPrimTanh}) {
+    if (kernel::OpLib::FindOp(prim->name(), kernel::OpImplyType::kAKG) == nullptr) {
+      MS_LOG(INFO) << "Op " << prim->name() << " is not registered for AKG, Gelu is not expanded.";
+      return false;
+    }
+  }
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  bool changed = false;
+  for (const auto &node : TopoSort(func_graph->get_return())) {
+    if (!CanExpand(node)) {
+      continue;
+    }
+    auto expanded = ExpandGelu(kernel_graph, node->cast<CNodePtr>());
+    MS_LOG(INFO) << "Expand " << node->DebugString() << " into " << expanded->DebugString();
+    (void)manager->Replace(node, expanded);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_GELU_EXPAND_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_GELU_EXPAND_H_
+#include "pre_activate/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// Expand Gelu into the basic ops of its tanh approximation, 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3))),
+// whose kernels are compiled by AKG, so GraphKernelFusion fuses them with their neighbours into one kernel. It runs
+// before the kernels are selected, the new nodes are selected as any other node.
+class GeluExpand : public Pass {
+ public:
+  GeluExpand() : Pass("gelu_expand") {}
+  ~GeluExpand() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_GELU_EXPAND_H_
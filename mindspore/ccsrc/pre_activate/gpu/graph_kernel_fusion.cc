@@ -0,0 +1,197 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/gpu/graph_kernel_fusion.h"
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "ir/meta_tensor.h"
+#include "kernel/akg/akgkernelbuild.h"
+#include "kernel/kernel_build_info.h"
+#include "kernel/oplib/oplib.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+const std::set<std::string> kGraphKernelBasicOpSet = {"TensorAdd", "Sub", "Mul", kRealDivOpName, "Tanh", "Exp", "Neg"};
+constexpr size_t kMaxGraphKernelOpNum = 32;
+
+size_t ShapeSize(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+}
+
+bool IsScalarConst(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<ValueNode>()) {
+    return false;
+  }
+  auto tensor = node->cast<ValueNodePtr>()->value()->cast<tensor::TensorPtr>();
+  return tensor != nullptr && tensor->DataSize() == 1 &&
+         (tensor->data_type() == kNumberTypeFloat32 || tensor->data_type() == kNumberTypeFloat16);
+}
+
+bool IsBasicNode(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  auto op_name = AnfAlgo::GetCNodeName(cnode);
+  if (kGraphKernelBasicOpSet.find(op_name) == kGraphKernelBasicOpSet.end() ||
+      kernel::OpLib::FindOp(op_name, kernel::OpImplyType::kAKG) == nullptr) {
+    return false;
+  }
+  if (AnfAlgo::GetOutputTensorNum(cnode) != 1) {
+    return false;
+  }
+  auto type_id = AnfAlgo::GetOutputDeviceDataType(cnode, 0);
+  if (type_id != kNumberTypeFloat32 && type_id != kNumberTypeFloat16) {
+    return false;
+  }
+  auto output_size = ShapeSize(AnfAlgo::GetOutputInferShape(cnode, 0));
+  if (output_size == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(cnode); ++i) {
+    auto input_size = ShapeSize(AnfAlgo::GetPrevNodeOutputInferShape(cnode, i));
+    if (input_size != output_size && input_size != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The nodes fused into the root, whose intermediate results are only used in the cluster
+std::unordered_set<AnfNodePtr> FindCluster(const FuncGraphManagerPtr &manager, const CNodePtr &root) {
+  auto output_size = ShapeSize(AnfAlgo::GetOutputInferShape(root, 0));
+  std::unordered_set<AnfNodePtr> cluster = {root};
+  std::vector<CNodePtr> todo = {root};
+  while (!todo.empty() && cluster.size() < kMaxGraphKernelOpNum) {
+    auto node = todo.back();
+    todo.pop_back();
+    for (size_t i = 1; i < node->inputs().size() && cluster.size() < kMaxGraphKernelOpNum; ++i) {
+      auto input = node->input(i);
+      if (cluster.find(input) != cluster.end() || !IsBasicNode(input) ||
+          ShapeSize(AnfAlgo::GetOutputInferShape(input, 0)) != output_size) {
+        continue;
+      }
+      if (manager->node_users()[input].size() != 1) {
+        continue;
+      }
+      (void)cluster.insert(input);
+      todo.push_back(input->cast<CNodePtr>());
+    }
+  }
+  return cluster;
+}
+
+CNodePtr CreateGraphKernel(const std::shared_ptr<session::KernelGraph> &kernel_graph, const CNodePtr &root,
+                           const std::unordered_set<AnfNodePtr> &cluster) {
+  // the nodes in the order of the computation and the inputs of the cluster in the order of their first use, the
+  // scalar constants are left out as they are folded into the json
+  std::vector<AnfNodePtr> nodes;
+  std::vector<AnfNodePtr> inputs;
+  std::vector<TypeId> inputs_type;
+  std::unordered_set<AnfNodePtr> visited;
+  std::function<void(const CNodePtr &)> visit = [&](const CNodePtr &cnode) {
+    (void)visited.insert(cnode);
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      auto input = cnode->input(i);
+      if (visited.find(input) != visited.end()) {
+        continue;
+      }
+      if (cluster.find(input) != cluster.end()) {
+        visit(input->cast<CNodePtr>());
+      } else if (!IsScalarConst(input)) {
+        (void)visited.insert(input);
+        inputs.push_back(input);
+        inputs_type.push_back(AnfAlgo::GetInputDeviceDataType(cnode, i - 1));
+      }
+    }
+    nodes.push_back(cnode);
+  };
+  visit(root);
+
+  kernel::AkgKernelBuild akg_kernel_build;
+  nlohmann::json composite_json;
+  if (!akg_kernel_build.GenerateCompositeKernelJson(nodes, inputs, root, &composite_json)) {
+    MS_LOG(WARNING) << "Generate the composite json of the cluster of " << root->DebugString() << " failed.";
+    return nullptr;
+  }
+  auto primitive = std::make_shared<Primitive>(kGraphKernelOpName);
+  primitive->set_attr(kAttrCompositeJson, MakeValue(composite_json.dump()));
+  std::vector<AnfNodePtr> fused_inputs = {NewValueNode(primitive)};
+  (void)fused_inputs.insert(fused_inputs.end(), inputs.begin(), inputs.end());
+  auto fused_node = kernel_graph->NewCNode(fused_inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_abstract(root->abstract());
+  fused_node->set_scope(root->scope());
+
+  auto builder = std::make_shared<kernel::KernelBuildInfo::KernelBuildInfoBuilder>();
+  builder->SetInputsFormat(std::vector<std::string>(inputs.size(), kOpFormat_DEFAULT));
+  builder->SetInputsDeviceType(inputs_type);
+  builder->SetOutputsFormat({kOpFormat_DEFAULT});
+  builder->SetOutputsDeviceType({AnfAlgo::GetOutputDeviceDataType(root, 0)});
+  builder->SetKernelType(AUTO_DIFF_KERNEL);
+  builder->SetFusionType(kernel::FusionType::OPAQUE);
+  builder->SetProcessor(kernel::Processor::CUDA);
+  AnfAlgo::SetSelectKernelBuildInfo(builder->Build(), fused_node.get());
+  return fused_node;
+}
+}  // namespace
+
+bool GraphKernelFusion::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto kernel_graph = func_graph->cast<std::shared_ptr<session::KernelGraph>>();
+  if (kernel_graph == nullptr) {
+    return false;
+  }
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto todos = TopoSort(func_graph->get_return());
+  std::unordered_set<AnfNodePtr> fused;
+  bool changed = false;
+  // from the outputs, so each cluster is fused into its last node
+  for (auto iter = todos.rbegin(); iter != todos.rend(); ++iter) {
+    auto &node = *iter;
+    if (fused.find(node) != fused.end() || !IsBasicNode(node)) {
+      continue;
+    }
+    auto root = node->cast<CNodePtr>();
+    auto cluster = FindCluster(manager, root);
+    if (cluster.size() < 2) {
+      continue;
+    }
+    auto fused_node = CreateGraphKernel(kernel_graph, root, cluster);
+    if (fused_node == nullptr) {
+      continue;
+    }
+    MS_LOG(INFO) << "Fuse " << cluster.size() << " basic ops into the graph kernel " << fused_node->DebugString();
+    fused.insert(cluster.begin(), cluster.end());
+    (void)manager->Replace(root, fused_node);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,35 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_GRAPH_KERNEL_FUSION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_GRAPH_KERNEL_FUSION_H_
+#include "pre_activate/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// Fuse the connected elementwise ops registered for AKG into one GraphKernel node, whose subgraph is kept as the
+// composite json and compiled by AKG as one kernel, so the intermediate results never go through the global memory.
+// The scalar constant inputs are folded into the json. The kernels are cached by the hash of the json, as the single
+// AKG kernels are.
+class GraphKernelFusion : public Pass {
+ public:
+  GraphKernelFusion() : Pass("graph_kernel_fusion") {}
+  ~GraphKernelFusion() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_GPU_GRAPH_KERNEL_FUSION_H_
@@ -0,0 +1,247 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/mem_reuse/mem_reuse_planner.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include "pre_activate/mem_reuse/stream_reuse.h"
+
+namespace mindspore {
+namespace memreuse {
+namespace {
+constexpr size_t kInvalidBlock = std::numeric_limits<size_t>::max();
+
+// the same alignment as BestFitMemReuse::AlignMemorySize
+size_t AlignBlockSize(size_t size) {
+  return (size + kDefaultMemAlignSize + kAttAlignSize) / kDefaultMemAlignSize * kDefaultMemAlignSize;
+}
+}  // namespace
+
+void StaticMemPlanner::InitBlocks(const MemReuseUtil *mem_reuse_util_ptr) {
+  auto tensors = mem_reuse_util_ptr->total_refs_list();
+  auto workspaces = mem_reuse_util_ptr->total_wk_ref_list();
+  auto ops = mem_reuse_util_ptr->kernel_def_ptr_list();
+  op_num_ = ops.size();
+  blocks_.clear();
+  std::vector<size_t> tensor_blocks(tensors.size(), kInvalidBlock);
+  std::vector<size_t> wk_blocks(workspaces.size(), kInvalidBlock);
+  std::vector<int> tensor_uses(tensors.size(), 0);
+  // the block of a tensor starts at the first op which touches it
+  auto touch = [this](const KernelRefCountPtrList &refs, int ref_idx, size_t op_idx, uint32_t stream_id,
+                      std::vector<size_t> *ref_blocks) {
+    if (ref_idx < 0 || IntToSize(ref_idx) >= refs.size()) {
+      MS_LOG(EXCEPTION) << "ref index: " << ref_idx << " is invalid";
+    }
+    auto &block_idx = (*ref_blocks)[IntToSize(ref_idx)];
+    if (block_idx == kInvalidBlock) {
+      auto &ref = refs[IntToSize(ref_idx)];
+      MS_EXCEPTION_IF_NULL(ref);
+      block_idx = blocks_.size();
+      PlanBlock block;
+      block.ref = ref;
+      block.size = AlignBlockSize(ref->size_);
+      block.first = op_idx;
+      blocks_.push_back(block);
+    }
+    auto &block = blocks_[block_idx];
+    block.last = op_idx;
+    (void)block.streams.insert(stream_id);
+    return block_idx;
+  };
+  for (size_t i = 0; i < op_num_; ++i) {
+    auto &op = ops[i];
+    MS_EXCEPTION_IF_NULL(op);
+    for (auto idx : op->GetOutputRefIndexs()) {
+      (void)touch(tensors, idx, i, op->stream_id(), &tensor_blocks);
+    }
+    for (auto idx : op->GetWkRefIndexs()) {
+      (void)touch(workspaces, idx, i, op->stream_id(), &wk_blocks);
+    }
+    for (auto idx : op->GetInputRefIndexs()) {
+      (void)touch(tensors, idx, i, op->stream_id(), &tensor_blocks);
+      tensor_uses[IntToSize(idx)]++;
+    }
+  }
+  // a tensor which is not released by its inputs, such as a graph output, lives to the end
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    if (tensor_blocks[i] != kInvalidBlock && tensor_uses[i] < tensors[i]->ref_count_) {
+      blocks_[tensor_blocks[i]].last = op_num_ - 1;
+    }
+  }
+}
+
+void StaticMemPlanner::ComputeLowerBound() {
+  std::vector<size_t> starts(op_num_, 0);
+  std::vector<size_t> ends(op_num_, 0);
+  for (auto &block : blocks_) {
+    starts[block.first] += block.size;
+    ends[block.last] += block.size;
+  }
+  size_t live_size = 0;
+  lower_bound_ = 0;
+  for (size_t i = 0; i < op_num_; ++i) {
+    live_size += starts[i];
+    lower_bound_ = std::max(lower_bound_, live_size);
+    live_size -= ends[i];
+  }
+}
+
+bool StaticMemPlanner::IsStreamBound(const PlanBlock &block) const {
+  return std::any_of(block.streams.begin(), block.streams.end(),
+                     [this](uint32_t stream_id) { return parallel_streams_.count(stream_id) != 0; });
+}
+
+bool StaticMemPlanner::IsParallel(const PlanBlock &lhs, const PlanBlock &rhs) const {
+  auto is_parallel = [this](uint32_t curr_id, uint32_t target_id) {
+    auto iter = parallel_streams_map_.find(curr_id);
+    return iter != parallel_streams_map_.end() && iter->second.count(target_id) != 0;
+  };
+  for (auto lhs_id : lhs.streams) {
+    for (auto rhs_id : rhs.streams) {
+      if (is_parallel(lhs_id, rhs_id) || is_parallel(rhs_id, lhs_id)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void StaticMemPlanner::InsertBlock(size_t node, size_t begin, size_t end, size_t block_idx) {
+  auto &block = blocks_[block_idx];
+  if (block.last < begin || end < block.first) {
+    return;
+  }
+  touching_blocks_[node].push_back(block_idx);
+  if (block.first <= begin && end <= block.last) {
+    covering_blocks_[node].push_back(block_idx);
+    return;
+  }
+  auto mid = begin + (end - begin) / 2;
+  InsertBlock(2 * node, begin, mid, block_idx);
+  InsertBlock(2 * node + 1, mid + 1, end, block_idx);
+}
+
+void StaticMemPlanner::FindOverlaps(size_t node, size_t begin, size_t end, const PlanBlock &block,
+                                    std::vector<size_t> *overlaps) {
+  if (block.last < begin || end < block.first) {
+    return;
+  }
+  auto add = [this, overlaps](const std::vector<size_t> &found) {
+    for (auto idx : found) {
+      if (visit_marks_[idx] != visit_id_) {
+        visit_marks_[idx] = visit_id_;
+        overlaps->push_back(idx);
+      }
+    }
+  };
+  if (block.first <= begin && end <= block.last) {
+    add(touching_blocks_[node]);
+    return;
+  }
+  // a node which is partly in the lifetime: only the blocks covering all of it are sure to overlap
+  add(covering_blocks_[node]);
+  auto mid = begin + (end - begin) / 2;
+  FindOverlaps(2 * node, begin, mid, block, overlaps);
+  FindOverlaps(2 * node + 1, mid + 1, end, block, overlaps);
+}
+
+void StaticMemPlanner::PlaceBlock(size_t block_idx) {
+  auto &block = blocks_[block_idx];
+  std::vector<size_t> overlaps;
+  ++visit_id_;
+  FindOverlaps(1, 0, op_num_ - 1, block, &overlaps);
+  if (IsStreamBound(block)) {
+    for (auto idx : stream_bound_blocks_) {
+      if (visit_marks_[idx] != visit_id_ && IsParallel(block, blocks_[idx])) {
+        visit_marks_[idx] = visit_id_;
+        overlaps.push_back(idx);
+      }
+    }
+    stream_bound_blocks_.push_back(block_idx);
+  }
+  std::sort(overlaps.begin(), overlaps.end(),
+            [this](size_t lhs, size_t rhs) { return blocks_[lhs].offset < blocks_[rhs].offset; });
+  // take the smallest gap the block fits in, or the end of the overlapping blocks
+  size_t gap_offset = 0;
+  size_t best_offset = kInvalidBlock;
+  size_t best_gap = std::numeric_limits<size_t>::max();
+  for (auto idx : overlaps) {
+    auto &placed = blocks_[idx];
+    if (placed.offset >= gap_offset) {
+      auto gap = placed.offset - gap_offset;
+      if (gap >= block.size && gap < best_gap) {
+        best_gap = gap;
+        best_offset = gap_offset;
+      }
+    }
+    gap_offset = std::max(gap_offset, placed.offset + placed.size);
+  }
+  block.offset = best_offset == kInvalidBlock ? gap_offset : best_offset;
+  planned_size_ = std::max(planned_size_, block.offset + block.size);
+  InsertBlock(1, 0, op_num_ - 1, block_idx);
+}
+
+void StaticMemPlanner::Plan(const MemReuseUtil *mem_reuse_util_ptr) {
+  MS_EXCEPTION_IF_NULL(mem_reuse_util_ptr);
+  auto stream_reuse = std::make_shared<StreamReuse>();
+  stream_reuse->SetStreamReuseResource();
+  parallel_streams_map_ = stream_reuse->parallel_streams_map();
+  parallel_streams_.clear();
+  for (auto &item : parallel_streams_map_) {
+    (void)parallel_streams_.insert(item.first);
+    parallel_streams_.insert(item.second.begin(), item.second.end());
+  }
+  InitBlocks(mem_reuse_util_ptr);
+  planned_size_ = 0;
+  lower_bound_ = 0;
+  stream_bound_blocks_.clear();
+  if (op_num_ == 0) {
+    return;
+  }
+  ComputeLowerBound();
+  // segment tree nodes are numbered from 1, the children of node n are 2n and 2n + 1
+  covering_blocks_.assign(4 * op_num_, {});
+  touching_blocks_.assign(4 * op_num_, {});
+  visit_marks_.assign(blocks_.size(), 0);
+  visit_id_ = 0;
+  // the largest blocks first, then the longest lived ones
+  std::vector<size_t> order(blocks_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+    auto &lhs_block = blocks_[lhs];
+    auto &rhs_block = blocks_[rhs];
+    if (lhs_block.size != rhs_block.size) {
+      return lhs_block.size > rhs_block.size;
+    }
+    return lhs_block.last - lhs_block.first > rhs_block.last - rhs_block.first;
+  });
+  for (auto idx : order) {
+    PlaceBlock(idx);
+  }
+  MS_LOG(INFO) << "Static memory plan of " << blocks_.size() << " blocks, planned size: " << planned_size_
+               << ", lower bound: " << lower_bound_;
+}
+
+void StaticMemPlanner::Apply() const {
+  for (auto &block : blocks_) {
+    block.ref->offset_ = block.offset;
+  }
+}
+}  // namespace memreuse
+}  // namespace mindspore
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_PLANNER_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_PLANNER_H_
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "pre_activate/mem_reuse/kernel_refcount.h"
+#include "pre_activate/mem_reuse/mem_reuse.h"
+
+namespace mindspore {
+namespace memreuse {
+// A memory block to be planned: a tensor or a workspace, live from the op first to the op last (both included)
+struct PlanBlock {
+  KernelRefCountPtr ref;
+  size_t size{0};
+  size_t first{0};
+  size_t last{0};
+  size_t offset{0};
+  // the streams which write or read the block
+  std::set<uint32_t> streams;
+};
+
+// Offline planner of the dynamic memory. Unlike BestFitMemReuse, which assigns the offsets in execution order,
+// the planner knows the lifetimes of all blocks first, then places them from the largest to the smallest, each
+// one in the smallest gap left by the placed blocks whose lifetimes overlap with its own.
+class StaticMemPlanner {
+ public:
+  StaticMemPlanner() = default;
+  ~StaticMemPlanner() = default;
+  // Plan the offsets of all tensors and workspaces, nothing in mem_reuse_util_ptr is changed
+  void Plan(const MemReuseUtil *mem_reuse_util_ptr);
+  // Set the planned offsets to the tensors and workspaces
+  void Apply() const;
+  // The memory needed by the plan
+  size_t planned_size() const { return planned_size_; }
+  // The largest sum of the sizes of the blocks live at one op, no plan needs less memory
+  size_t lower_bound() const { return lower_bound_; }
+
+ private:
+  void InitBlocks(const MemReuseUtil *mem_reuse_util_ptr);
+  void ComputeLowerBound();
+  void PlaceBlock(size_t block_idx);
+  // If two blocks on parallel streams can not share memory even if their lifetimes do not overlap
+  bool IsStreamBound(const PlanBlock &block) const;
+  bool IsParallel(const PlanBlock &lhs, const PlanBlock &rhs) const;
+  // Segment tree over the ops, to find the placed blocks which overlap with a lifetime
+  void InsertBlock(size_t node, size_t begin, size_t end, size_t block_idx);
+  void FindOverlaps(size_t node, size_t begin, size_t end, const PlanBlock &block, std::vector<size_t> *overlaps);
+  size_t op_num_{0};
+  size_t planned_size_{0};
+  size_t lower_bound_{0};
+  std::vector<PlanBlock> blocks_;
+  // blocks whose lifetime covers the whole range of the node
+  std::vector<std::vector<size_t>> covering_blocks_;
+  // blocks whose lifetime has an op in the range of the node
+  std::vector<std::vector<size_t>> touching_blocks_;
+  // placed blocks on the streams having a parallel stream
+  std::vector<size_t> stream_bound_blocks_;
+  std::vector<size_t> visit_marks_;
+  size_t visit_id_{0};
+  std::unordered_set<uint32_t> parallel_streams_;
+  std::unordered_map<uint32_t, std::unordered_set<uint32_t>> parallel_streams_map_;
+};
+}  // namespace memreuse
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_PLANNER_H_
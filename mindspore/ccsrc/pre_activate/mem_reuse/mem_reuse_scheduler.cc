@@ -0,0 +1,243 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/mem_reuse/mem_reuse_scheduler.h"
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include "operator/ops.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace memreuse {
+namespace {
+const std::set<std::string> kOrderedOpSet = {kAtomicAddrCleanOpName, kAllReduceOpName, kAllGatherOpName,
+                                             kBroadcastOpName, kReduceScatterOpName};
+}  // namespace
+
+bool MemReuseScheduler::IsBarrier(const session::KernelGraph *graph, const CNodePtr &kernel) const {
+  auto kernel_name = AnfAlgo::GetCNodeName(kernel);
+  if (kOptOpeatorSet.find(kernel_name) != kOptOpeatorSet.end() ||
+      kOrderedOpSet.find(kernel_name) != kOrderedOpSet.end()) {
+    return true;
+  }
+  auto kernel_type = AnfAlgo::GetKernelType(kernel);
+  if (kernel_type == RT_KERNEL || kernel_type == HCCL_KERNEL) {
+    return true;
+  }
+  // a kernel writing its input in place
+  for (size_t i = 0; i < AnfAlgo::GetOutputTensorNum(kernel); ++i) {
+    if (graph->IsInRefOutputMap(std::make_pair(kernel, i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const std::vector<size_t> &MemReuseScheduler::FindInputKernels(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto iter = input_kernels_.find(node);
+  if (iter != input_kernels_.end()) {
+    return iter->second;
+  }
+  std::vector<size_t> input_kernels;
+  auto kernel_iter = kernel_index_.find(node);
+  if (kernel_iter != kernel_index_.end()) {
+    input_kernels.push_back(kernel_iter->second);
+  } else if (node->isa<CNode>()) {
+    // tuple getitem, make tuple, depend and the hidden nop nodes
+    std::set<size_t> found;
+    for (auto &input : node->cast<CNodePtr>()->inputs()) {
+      auto &kernels = FindInputKernels(input);
+      found.insert(kernels.begin(), kernels.end());
+    }
+    input_kernels.assign(found.begin(), found.end());
+  }
+  return input_kernels_[node] = input_kernels;
+}
+
+void MemReuseScheduler::InitKernelNodes(const session::KernelGraph *graph) {
+  kernel_nodes_.clear();
+  kernel_index_.clear();
+  input_kernels_.clear();
+  auto &kernels = graph->execution_order();
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    kernel_index_[kernels[i]] = i;
+  }
+  for (auto &kernel : kernels) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    KernelNode kernel_node;
+    kernel_node.kernel = kernel;
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    if (kernel_mod == nullptr) {
+      kernel_node.is_barrier = true;
+    } else {
+      auto output_sizes = kernel_mod->GetOutputSizeList();
+      auto workspace_sizes = kernel_mod->GetWorkspaceSizeList();
+      kernel_node.output_size = std::accumulate(output_sizes.begin(), output_sizes.end(), IntToSize(0));
+      kernel_node.workspace_size = std::accumulate(workspace_sizes.begin(), workspace_sizes.end(), IntToSize(0));
+      kernel_node.is_barrier = IsBarrier(graph, kernel);
+    }
+    kernel_node.stream_id = AnfAlgo::GetStreamId(kernel);
+    kernel_nodes_.push_back(kernel_node);
+  }
+  for (size_t i = 0; i < kernels.size(); ++i) {
+    std::set<size_t> found;
+    auto &inputs = kernels[i]->inputs();
+    for (size_t j = 1; j < inputs.size(); ++j) {
+      auto &input_kernels = FindInputKernels(inputs[j]);
+      found.insert(input_kernels.begin(), input_kernels.end());
+    }
+    kernel_nodes_[i].inputs.assign(found.begin(), found.end());
+    for (auto input : found) {
+      kernel_nodes_[input].users.push_back(i);
+    }
+  }
+  // the control depend edges are not data edges, keep the kernels in them in place
+  for (auto &node : TopoSort(graph->get_return())) {
+    if (IsPrimitiveCNode(node, prim::kPrimControlDepend)) {
+      for (auto idx : FindInputKernels(node)) {
+        kernel_nodes_[idx].is_barrier = true;
+      }
+    }
+  }
+}
+
+void MemReuseScheduler::ScheduleSegment(const std::vector<size_t> &segment, std::vector<size_t> *remaining_users,
+                                        std::vector<size_t> *order) const {
+  MS_EXCEPTION_IF_NULL(remaining_users);
+  MS_EXCEPTION_IF_NULL(order);
+  std::unordered_set<size_t> in_segment(segment.begin(), segment.end());
+  std::unordered_map<size_t, size_t> pending_inputs;
+  // ordered by the origin order, which is kept on ties
+  std::set<size_t> ready;
+  for (auto idx : segment) {
+    auto &inputs = kernel_nodes_[idx].inputs;
+    auto pending = std::count_if(inputs.begin(), inputs.end(),
+                                 [&in_segment](size_t input) { return in_segment.count(input) != 0; });
+    pending_inputs[idx] = LongToSize(pending);
+    if (pending == 0) {
+      (void)ready.insert(idx);
+    }
+  }
+  auto freed_size = [this, remaining_users](size_t idx) {
+    size_t freed = 0;
+    for (auto input : kernel_nodes_[idx].inputs) {
+      if ((*remaining_users)[input] == 1) {
+        freed += kernel_nodes_[input].output_size;
+      }
+    }
+    return freed;
+  };
+  while (!ready.empty()) {
+    // take the kernel which adds the least memory: the smallest output size minus freed size
+    auto best = ready.begin();
+    size_t best_freed = freed_size(*best);
+    for (auto iter = std::next(ready.begin()); iter != ready.end(); ++iter) {
+      auto freed = freed_size(*iter);
+      if (kernel_nodes_[*iter].output_size + best_freed < kernel_nodes_[*best].output_size + freed) {
+        best = iter;
+        best_freed = freed;
+      }
+    }
+    auto idx = *best;
+    (void)ready.erase(best);
+    order->push_back(idx);
+    for (auto input : kernel_nodes_[idx].inputs) {
+      (*remaining_users)[input]--;
+    }
+    for (auto user : kernel_nodes_[idx].users) {
+      if (in_segment.count(user) != 0 && --pending_inputs[user] == 0) {
+        (void)ready.insert(user);
+      }
+    }
+  }
+}
+
+size_t MemReuseScheduler::GetPeak(const std::vector<size_t> &order) const {
+  std::vector<size_t> remaining_users(kernel_nodes_.size());
+  for (size_t i = 0; i < kernel_nodes_.size(); ++i) {
+    remaining_users[i] = kernel_nodes_[i].users.size();
+  }
+  size_t live_size = 0;
+  size_t peak = 0;
+  for (auto idx : order) {
+    auto &kernel_node = kernel_nodes_[idx];
+    live_size += kernel_node.output_size;
+    peak = std::max(peak, live_size + kernel_node.workspace_size);
+    for (auto input : kernel_node.inputs) {
+      if (--remaining_users[input] == 0) {
+        live_size -= kernel_nodes_[input].output_size;
+      }
+    }
+  }
+  return peak;
+}
+
+void MemReuseScheduler::Schedule(session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  InitKernelNodes(graph);
+  std::vector<size_t> origin_order(kernel_nodes_.size());
+  for (size_t i = 0; i < origin_order.size(); ++i) {
+    origin_order[i] = i;
+  }
+  origin_peak_ = GetPeak(origin_order);
+  scheduled_peak_ = origin_peak_;
+  if (kernel_nodes_.size() < 2) {
+    return;
+  }
+  std::vector<size_t> remaining_users(kernel_nodes_.size());
+  for (size_t i = 0; i < kernel_nodes_.size(); ++i) {
+    remaining_users[i] = kernel_nodes_[i].users.size();
+  }
+  // the segments are split by the barriers and the changes of the stream
+  std::vector<size_t> order;
+  std::vector<size_t> segment;
+  for (size_t i = 0; i < kernel_nodes_.size(); ++i) {
+    auto &kernel_node = kernel_nodes_[i];
+    bool stream_changed = !segment.empty() && kernel_nodes_[segment.back()].stream_id != kernel_node.stream_id;
+    if (kernel_node.is_barrier || stream_changed) {
+      ScheduleSegment(segment, &remaining_users, &order);
+      segment.clear();
+    }
+    segment.push_back(i);
+    if (kernel_node.is_barrier) {
+      ScheduleSegment(segment, &remaining_users, &order);
+      segment.clear();
+    }
+  }
+  ScheduleSegment(segment, &remaining_users, &order);
+  if (order.size() != kernel_nodes_.size()) {
+    MS_LOG(EXCEPTION) << "Scheduled " << order.size() << " kernels of " << kernel_nodes_.size();
+  }
+  scheduled_peak_ = GetPeak(order);
+  MS_LOG(INFO) << "Memory aware schedule of " << order.size() << " kernels, origin peak: " << origin_peak_
+               << ", scheduled peak: " << scheduled_peak_;
+  if (scheduled_peak_ >= origin_peak_) {
+    scheduled_peak_ = origin_peak_;
+    return;
+  }
+  std::vector<CNodePtr> execution_order;
+  (void)std::transform(order.begin(), order.end(), std::back_inserter(execution_order),
+                       [this](size_t idx) { return kernel_nodes_[idx].kernel; });
+  graph->set_execution_order(execution_order);
+}
+}  // namespace memreuse
+}  // namespace mindspore
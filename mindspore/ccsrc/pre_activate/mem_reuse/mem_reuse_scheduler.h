@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_SCHEDULER_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_SCHEDULER_H_
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+
+namespace mindspore {
+namespace memreuse {
+// Reorders the independent kernels of a graph to lower the peak of the live memory, before the memory reuse is
+// planned on the execution order. The kernels with side effects, such as optimizers, communication and runtime
+// kernels, keep their positions; the kernels between two of them on one stream are reordered by data dependence.
+class MemReuseScheduler {
+ public:
+  MemReuseScheduler() = default;
+  ~MemReuseScheduler() = default;
+  // Set the new execution order to the graph if its peak is lower
+  void Schedule(session::KernelGraph *graph);
+  size_t origin_peak() const { return origin_peak_; }
+  size_t scheduled_peak() const { return scheduled_peak_; }
+
+ private:
+  struct KernelNode {
+    CNodePtr kernel;
+    size_t output_size{0};
+    size_t workspace_size{0};
+    uint32_t stream_id{0};
+    bool is_barrier{false};
+    // the kernels whose outputs are used by this one
+    std::vector<size_t> inputs;
+    std::vector<size_t> users;
+  };
+  void InitKernelNodes(const session::KernelGraph *graph);
+  // The kernels of the execution order reached from node, through the nodes which are not in it
+  const std::vector<size_t> &FindInputKernels(const AnfNodePtr &node);
+  bool IsBarrier(const session::KernelGraph *graph, const CNodePtr &kernel) const;
+  void ScheduleSegment(const std::vector<size_t> &segment, std::vector<size_t> *remaining_users,
+                       std::vector<size_t> *order) const;
+  size_t GetPeak(const std::vector<size_t> &order) const;
+  std::vector<KernelNode> kernel_nodes_;
+  std::unordered_map<AnfNodePtr, size_t> kernel_index_;
+  std::unordered_map<AnfNodePtr, std::vector<size_t>> input_kernels_;
+  size_t origin_peak_{0};
+  size_t scheduled_peak_{0};
+};
+}  // namespace memreuse
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_SCHEDULER_H_
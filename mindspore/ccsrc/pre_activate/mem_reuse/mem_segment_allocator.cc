@@ -0,0 +1,85 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/mem_reuse/mem_segment_allocator.h"
+#include <algorithm>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+void MemSegmentAllocator::Init(uint8_t *base, size_t size) {
+  base_ = base;
+  size_ = size;
+  dynamic_size_ = 0;
+  segment_size_ = 0;
+  segments_.clear();
+}
+
+uint8_t *MemSegmentAllocator::AllocSegment(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+  // The free spaces are between the segments, from the top down to the dynamic memory.
+  size_t top = size_;
+  for (auto iter = segments_.rbegin(); iter != segments_.rend(); ++iter) {
+    auto end = iter->first + iter->second;
+    if (top - end >= size) {
+      break;
+    }
+    top = iter->first;
+  }
+  if (top < dynamic_size_ || top - dynamic_size_ < size) {
+    return nullptr;
+  }
+  auto offset = top - size;
+  (void)segments_.emplace(offset, size);
+  segment_size_ += size;
+  return base_ + offset;
+}
+
+void MemSegmentAllocator::FreeSegment(const void *addr) {
+  auto ptr = static_cast<const uint8_t *>(addr);
+  auto iter = ptr < base_ ? segments_.end() : segments_.find(static_cast<size_t>(ptr - base_));
+  if (iter == segments_.end()) {
+    MS_LOG(EXCEPTION) << "Can't find the segment of the device address[" << addr << "].";
+  }
+  segment_size_ -= iter->second;
+  (void)segments_.erase(iter);
+}
+
+bool MemSegmentAllocator::ReserveDynamic(size_t size) {
+  if (size <= dynamic_size_) {
+    return true;
+  }
+  auto limit = segments_.empty() ? size_ : segments_.begin()->first;
+  if (size > limit) {
+    return false;
+  }
+  dynamic_size_ = size;
+  return true;
+}
+
+size_t MemSegmentAllocator::max_free_size() const {
+  size_t max_size = 0;
+  size_t top = size_;
+  for (auto iter = segments_.rbegin(); iter != segments_.rend(); ++iter) {
+    max_size = std::max(max_size, top - (iter->first + iter->second));
+    top = iter->first;
+  }
+  return top > dynamic_size_ ? std::max(max_size, top - dynamic_size_) : max_size;
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SEGMENT_ALLOCATOR_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SEGMENT_ALLOCATOR_H_
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace mindspore {
+namespace device {
+// The device memory shared by the graphs and the dynamic memory pool, instead of being split between them by a fixed
+// ratio. The dynamic memory of the graphs is at the bottom, it is reused by every graph so it only grows to the
+// largest one. The static memory of the graphs and the memory blocks of the pool are segments taken from the top, the
+// segment of a memory block the pool gives back is taken again by the graphs or the pool.
+class MemSegmentAllocator {
+ public:
+  MemSegmentAllocator() = default;
+  ~MemSegmentAllocator() = default;
+  void Init(uint8_t *base, size_t size);
+
+  // Take the segment at the top of the highest free space large enough, nullptr if there is none.
+  uint8_t *AllocSegment(size_t size);
+  // Give the segment back, it is merged with the free spaces around it.
+  void FreeSegment(const void *addr);
+  // Extend the dynamic memory at the bottom to the size, return false if a segment is in the way.
+  bool ReserveDynamic(size_t size);
+
+  // The size of the largest free space, which is the largest segment taken at once.
+  size_t max_free_size() const;
+  size_t free_size() const { return size_ - dynamic_size_ - segment_size_; }
+  size_t size() const { return size_; }
+  size_t dynamic_size() const { return dynamic_size_; }
+  size_t segment_size() const { return segment_size_; }
+
+ private:
+  uint8_t *base_{nullptr};
+  size_t size_{0};
+  size_t dynamic_size_{0};
+  size_t segment_size_{0};
+  // The offsets and the sizes of the segments taken.
+  std::map<size_t, size_t> segments_;
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SEGMENT_ALLOCATOR_H_
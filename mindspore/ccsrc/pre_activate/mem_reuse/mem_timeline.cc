@@ -0,0 +1,237 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/mem_reuse/mem_timeline.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <utility>
+#include <nlohmann/json.hpp>
+#include "utils/context/ms_context.h"
+
+using json = nlohmann::json;
+
+namespace mindspore {
+namespace memreuse {
+namespace {
+// The scope of the cell owning a node, which is its full name without the node.
+std::string OwnerScope(const std::string &owner) {
+  auto pos = owner.rfind('/');
+  return pos == std::string::npos ? owner : owner.substr(0, pos);
+}
+}  // namespace
+
+void MemTimeline::InitStatic(const MemReuseUtil *mem_reuse_util_ptr) {
+  MS_EXCEPTION_IF_NULL(mem_reuse_util_ptr);
+  auto refs = mem_reuse_util_ptr->total_refs_list();
+  auto wk_refs = mem_reuse_util_ptr->total_wk_ref_list();
+  auto ops = mem_reuse_util_ptr->kernel_def_ptr_list();
+  tensors_.clear();
+  kernels_.clear();
+  live_tensors_.clear();
+  // the lifetimes the same as the ones StaticMemPlanner plans, from the first op touching a tensor to the last
+  std::vector<size_t> first(refs.size() + wk_refs.size(), SIZE_MAX);
+  std::vector<size_t> last(first.size(), 0);
+  std::vector<int> uses(refs.size(), 0);
+  std::vector<size_t> ids(first.size(), SIZE_MAX);
+  auto touch = [&](size_t slot, size_t op_idx, const KernelRefCountPtr &ref, const std::string &owner, bool workspace,
+                   size_t index) {
+    if (ids[slot] == SIZE_MAX) {
+      ids[slot] = tensors_.size();
+      Tensor tensor;
+      tensor.owner = owner;
+      tensor.workspace = workspace;
+      tensor.index = index;
+      tensor.ref = ref;
+      tensors_.push_back(tensor);
+      first[slot] = op_idx;
+    }
+    last[slot] = op_idx;
+  };
+  auto check_index = [](int idx, size_t size) {
+    if (idx < 0 || IntToSize(idx) >= size) {
+      MS_LOG(EXCEPTION) << "ref index: " << idx << " is invalid";
+    }
+    return IntToSize(idx);
+  };
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto &op = ops[i];
+    MS_EXCEPTION_IF_NULL(op);
+    auto outputs = op->GetOutputRefIndexs();
+    for (size_t j = 0; j < outputs.size(); ++j) {
+      auto idx = check_index(outputs[j], refs.size());
+      touch(idx, i, refs[idx], op->scope_full_name(), false, j);
+    }
+    auto workspaces = op->GetWkRefIndexs();
+    for (size_t j = 0; j < workspaces.size(); ++j) {
+      auto idx = check_index(workspaces[j], wk_refs.size());
+      touch(refs.size() + idx, i, wk_refs[idx], op->scope_full_name(), true, j);
+    }
+    auto inputs = op->GetInputRefIndexs();
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      auto idx = check_index(inputs[j], refs.size());
+      touch(idx, i, refs[idx], op->scope_full_name(), false, j);
+      uses[idx]++;
+    }
+  }
+  // a tensor which is not released by its inputs, such as a graph output, lives to the end
+  for (size_t i = 0; i < refs.size(); ++i) {
+    if (ids[i] != SIZE_MAX && uses[i] < refs[i]->ref_count_) {
+      last[i] = ops.size() - 1;
+    }
+  }
+  kernels_.resize(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    kernels_[i].name = ops[i]->scope_full_name();
+  }
+  for (size_t slot = 0; slot < ids.size(); ++slot) {
+    if (ids[slot] == SIZE_MAX) {
+      continue;
+    }
+    for (size_t i = first[slot]; i <= last[slot]; ++i) {
+      kernels_[i].live.push_back(ids[slot]);
+    }
+  }
+  for (auto &kernel : kernels_) {
+    std::sort(kernel.live.begin(), kernel.live.end());
+  }
+}
+
+void MemTimeline::Alloc(const void *addr, size_t size, const std::string &owner, bool workspace, size_t index) {
+  if (addr == nullptr) {
+    return;
+  }
+  Tensor tensor;
+  tensor.owner = owner;
+  tensor.workspace = workspace;
+  tensor.index = index;
+  tensor.size = size;
+  tensor.addr = reinterpret_cast<uintptr_t>(addr);
+  live_tensors_[tensor.addr] = tensors_.size();
+  tensors_.push_back(tensor);
+}
+
+void MemTimeline::Free(const void *addr) { (void)live_tensors_.erase(reinterpret_cast<uintptr_t>(addr)); }
+
+void MemTimeline::RecordKernel(const std::string &name) {
+  Kernel kernel;
+  kernel.name = name;
+  kernel.live.reserve(live_tensors_.size());
+  for (auto &iter : live_tensors_) {
+    kernel.live.push_back(iter.second);
+  }
+  std::sort(kernel.live.begin(), kernel.live.end());
+  kernels_.push_back(std::move(kernel));
+}
+
+std::string MemTimelineFilePath(const std::string &kind, uint32_t graph_id) {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  auto save_graphs_path = context_ptr->save_graphs_path();
+  if (save_graphs_path.empty()) {
+    save_graphs_path = ".";
+  }
+  return save_graphs_path + "/mem_timeline_" + kind + "_" + std::to_string(graph_id) + ".json";
+}
+
+bool MemTimeline::Save(const std::string &file_path) const {
+  // the offsets of the dynamic tensors are from the lowest address of them
+  uintptr_t base = UINTPTR_MAX;
+  for (auto &tensor : tensors_) {
+    if (tensor.ref == nullptr) {
+      base = std::min(base, tensor.addr);
+    }
+  }
+  json tensors = json::array();
+  for (auto &tensor : tensors_) {
+    tensors.push_back({{"owner", tensor.owner},
+                       {"workspace", tensor.workspace},
+                       {"index", tensor.index},
+                       {"size", TensorSize(tensor)},
+                       {"offset", TensorOffset(tensor, base)}});
+  }
+  json kernels = json::array();
+  size_t peak_kernel = 0;
+  size_t peak_size = 0;
+  size_t peak_footprint = 0;
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    size_t live_size = 0;
+    size_t footprint = 0;
+    for (auto id : kernels_[i].live) {
+      auto &tensor = tensors_[id];
+      live_size += TensorSize(tensor);
+      footprint = std::max(footprint, TensorOffset(tensor, base) + TensorSize(tensor));
+    }
+    if (live_size > peak_size) {
+      peak_kernel = i;
+      peak_size = live_size;
+    }
+    peak_footprint = std::max(peak_footprint, footprint);
+    kernels.push_back(
+      {{"name", kernels_[i].name}, {"live_size", live_size}, {"footprint", footprint}, {"live", kernels_[i].live}});
+  }
+
+  // the top contributors at the peak, the tensors and the scopes of the cells owning them
+  json peak = {{"kernel", peak_kernel}, {"live_size", peak_size}, {"footprint", peak_footprint}};
+  std::vector<size_t> top_tensors;
+  std::vector<std::pair<std::string, size_t>> top_scopes;
+  if (!kernels_.empty()) {
+    top_tensors = kernels_[peak_kernel].live;
+    std::sort(top_tensors.begin(), top_tensors.end(),
+              [this](size_t lhs, size_t rhs) { return TensorSize(tensors_[lhs]) > TensorSize(tensors_[rhs]); });
+    top_tensors.resize(std::min(top_tensors.size(), kMemTimelineTopNum));
+    std::map<std::string, size_t> scope_sizes;
+    for (auto id : kernels_[peak_kernel].live) {
+      scope_sizes[OwnerScope(tensors_[id].owner)] += TensorSize(tensors_[id]);
+    }
+    top_scopes.assign(scope_sizes.begin(), scope_sizes.end());
+    std::stable_sort(top_scopes.begin(), top_scopes.end(),
+                     [](const std::pair<std::string, size_t> &lhs, const std::pair<std::string, size_t> &rhs) {
+                       return lhs.second > rhs.second;
+                     });
+    top_scopes.resize(std::min(top_scopes.size(), kMemTimelineTopNum));
+    peak["name"] = kernels_[peak_kernel].name;
+  }
+  peak["top_tensors"] = top_tensors;
+  json scopes = json::array();
+  for (auto &scope : top_scopes) {
+    scopes.push_back({{"scope", scope.first}, {"size", scope.second}});
+  }
+  peak["top_scopes"] = scopes;
+
+  std::ofstream file_out(file_path, std::ios::trunc | std::ios::out);
+  if (!file_out.is_open()) {
+    MS_LOG(ERROR) << "Open file " << file_path << " failed.";
+    return false;
+  }
+  file_out << json({{"kind", kind_}, {"peak", peak}, {"kernels", kernels}, {"tensors", tensors}}).dump();
+  file_out.close();
+
+  MS_LOG(INFO) << "Save the " << kind_ << " memory timeline of " << kernels_.size() << " kernels to " << file_path
+               << ", the peak live size is " << peak_size << " at kernel " << peak_kernel << ", the footprint is "
+               << peak_footprint;
+  for (auto id : top_tensors) {
+    auto &tensor = tensors_[id];
+    MS_LOG(INFO) << "Top tensor at the peak: " << tensor.owner << (tensor.workspace ? " workspace " : " output ")
+                 << tensor.index << ", size " << TensorSize(tensor) << ", offset " << TensorOffset(tensor, base);
+  }
+  for (auto &scope : top_scopes) {
+    MS_LOG(INFO) << "Top scope at the peak: " << scope.first << ", size " << scope.second;
+  }
+  return true;
+}
+}  // namespace memreuse
+}  // namespace mindspore
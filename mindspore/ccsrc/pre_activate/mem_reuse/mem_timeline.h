@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_TIMELINE_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_TIMELINE_H_
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pre_activate/mem_reuse/kernel_refcount.h"
+#include "pre_activate/mem_reuse/mem_reuse.h"
+
+namespace mindspore {
+namespace memreuse {
+// The number of the tensors and the scopes listed as the top contributors at the peak.
+constexpr size_t kMemTimelineTopNum = 20;
+
+// The timeline of the memory of a graph: the tensors live while each kernel runs in execution order, with their
+// sizes, the nodes owning them and their offsets, saved as JSON with the top contributors at the peak. The static
+// timeline takes the lifetimes from the kernel defs the reuse plans, the dynamic one records the memory pool as the
+// kernels run. The graph inputs and the parameters are in the static memory, out of the timeline.
+class MemTimeline {
+ public:
+  explicit MemTimeline(const std::string &kind) : kind_(kind) {}
+  ~MemTimeline() = default;
+
+  // Take the lifetimes of the tensors and the workspaces before BestFitMemReuse consumes the refcounts, their
+  // sizes and offsets are read when the timeline is saved, after they are assigned.
+  void InitStatic(const MemReuseUtil *mem_reuse_util_ptr);
+
+  // Record a tensor of the dynamic memory pool allocated for the node, the index is the one of the output, or of
+  // the workspace if it is a workspace.
+  void Alloc(const void *addr, size_t size, const std::string &owner, bool workspace, size_t index);
+  void Free(const void *addr);
+  // Record the tensors live while the kernel runs.
+  void RecordKernel(const std::string &name);
+
+  bool empty() const { return kernels_.empty(); }
+  // Save the timeline to the file, and log the top contributors at the peak.
+  bool Save(const std::string &file_path) const;
+
+ private:
+  struct Tensor {
+    std::string owner;
+    bool workspace{false};
+    size_t index{0};
+    // the tensor of the static timeline, whose size and offset are assigned later
+    KernelRefCountPtr ref;
+    size_t size{0};
+    uintptr_t addr{0};
+  };
+  struct Kernel {
+    std::string name;
+    // the indexes of the live tensors in tensors_
+    std::vector<size_t> live;
+  };
+  size_t TensorSize(const Tensor &tensor) const { return tensor.ref != nullptr ? tensor.ref->size_ : tensor.size; }
+  size_t TensorOffset(const Tensor &tensor, uintptr_t base) const {
+    return tensor.ref != nullptr ? tensor.ref->offset_ : static_cast<size_t>(tensor.addr - base);
+  }
+
+  std::string kind_;
+  std::vector<Tensor> tensors_;
+  std::vector<Kernel> kernels_;
+  // the tensors of the dynamic timeline live now, by address
+  std::unordered_map<uintptr_t, size_t> live_tensors_;
+};
+
+// The file the memory timeline of the graph is saved to, in the path the graphs are saved to.
+std::string MemTimelineFilePath(const std::string &kind, uint32_t graph_id);
+}  // namespace memreuse
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_TIMELINE_H_
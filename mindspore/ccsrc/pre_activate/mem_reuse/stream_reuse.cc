@@ -30,6 +30,10 @@ void StreamReuse::SetStreamReuseResource() {
   } else {
     MS_LOG(INFO) << "Non task sink or No Parallel stream exists";
   }
+  auto branch_streams = device::ascend::AscendStreamAssign::GetInstance().GetBranchStreams();
+  if (!branch_streams.empty()) {
+    InitBranchStreamMap(branch_streams, device::ascend::AscendStreamAssign::GetInstance().GetTotalStreamNum());
+  }
 #endif
   MS_LOG(INFO) << "no need to set stream mem reuse resource";
 }
@@ -98,5 +102,18 @@ void StreamReuse::InitReusableStreamMap() {
     }
   }
 }
+
+void StreamReuse::InitBranchStreamMap(const std::vector<uint32_t> &branch_streams, uint32_t stream_num) {
+  // a branch stream is ordered with the others by the events of its dependencies only, so it may run in parallel
+  // with any of them
+  for (const auto &branch : branch_streams) {
+    for (uint32_t stream_id = 0; stream_id < stream_num; ++stream_id) {
+      if (stream_id != branch) {
+        (void)parallel_streams_map_[branch].insert(stream_id);
+        (void)parallel_streams_map_[stream_id].insert(branch);
+      }
+    }
+  }
+}
 }  // namespace memreuse
 }  // namespace mindspore
@@ -43,6 +43,7 @@ class StreamReuse {
   ~StreamReuse() = default;
   void SetStreamReuseResource();
   void InitReusableStreamMap();
+  void InitBranchStreamMap(const std::vector<uint32_t> &branch_streams, uint32_t stream_num);
   std::vector<std::pair<uint32_t, uint32_t>> SortLogicPhysicMapToList();
   std::unordered_map<int, std::set<uint32_t>> GetLogicPhysicsStreamMap();
   void set_logic_physic_map(const std::unordered_map<uint32_t, uint32_t> &logic_physic_map) {
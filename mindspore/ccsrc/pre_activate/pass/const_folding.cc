@@ -0,0 +1,220 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/pass/const_folding.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "ir/meta_tensor.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+using FoldFunc = std::function<tensor::TensorPtr(const CNodePtr &, const std::vector<tensor::TensorPtr> &)>;
+
+template <typename T>
+double ToDouble(T value) {
+  return static_cast<double>(value);
+}
+
+template <>
+double ToDouble(float16 value) {
+  return static_cast<double>(static_cast<float>(value));
+}
+
+template <typename T>
+T FromDouble(double value) {
+  return static_cast<T>(value);
+}
+
+template <>
+float16 FromDouble<float16>(double value) {
+  return float16(static_cast<float>(value));
+}
+
+template <typename T>
+void ReadElements(const tensor::TensorPtr &tensor, std::vector<double> *elements) {
+  auto data = static_cast<const T *>(tensor->data_c(false));
+  MS_EXCEPTION_IF_NULL(data);
+  for (int i = 0; i < tensor->DataSize(); ++i) {
+    elements->push_back(ToDouble(data[i]));
+  }
+}
+
+template <typename T>
+void WriteElements(const std::vector<double> &elements, const tensor::TensorPtr &tensor) {
+  auto data = static_cast<T *>(tensor->data_c(true));
+  MS_EXCEPTION_IF_NULL(data);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    data[i] = FromDouble<T>(elements[i]);
+  }
+}
+
+bool IsCastType(TypeId type_id) {
+  return type_id == kNumberTypeFloat32 || type_id == kNumberTypeFloat16 || type_id == kNumberTypeInt32;
+}
+
+tensor::TensorPtr NewOutputTensor(const CNodePtr &cnode) {
+  auto shape = AnfAlgo::GetOutputInferShape(cnode, 0);
+  std::vector<int> tensor_shape;
+  (void)std::transform(shape.begin(), shape.end(), std::back_inserter(tensor_shape), SizeToInt);
+  return std::make_shared<tensor::Tensor>(AnfAlgo::GetOutputInferDataType(cnode, 0), tensor_shape);
+}
+
+// the reshapes keep the data, the output gets the infer shape of the node
+tensor::TensorPtr FoldReshape(const CNodePtr &cnode, const std::vector<tensor::TensorPtr> &inputs) {
+  if (inputs.size() != 1 || inputs[0]->data_type() != AnfAlgo::GetOutputInferDataType(cnode, 0)) {
+    return nullptr;
+  }
+  auto output = NewOutputTensor(cnode);
+  size_t size = IntToSize(output->data().nbytes());
+  if (size != IntToSize(inputs[0]->data().nbytes())) {
+    return nullptr;
+  }
+  if (size == 0) {
+    return output;
+  }
+  auto ret = memcpy_s(output->data_c(true), size, inputs[0]->data_c(false), size);
+  if (ret != 0) {
+    MS_LOG(EXCEPTION) << "memcpy_s error, errorno(" << ret << ")";
+  }
+  return output;
+}
+
+tensor::TensorPtr FoldCast(const CNodePtr &cnode, const std::vector<tensor::TensorPtr> &inputs) {
+  if (inputs.size() != 1) {
+    return nullptr;
+  }
+  auto src_type = inputs[0]->data_type();
+  auto dst_type = AnfAlgo::GetOutputInferDataType(cnode, 0);
+  if (src_type == dst_type) {
+    return FoldReshape(cnode, inputs);
+  }
+  if (!IsCastType(src_type) || !IsCastType(dst_type)) {
+    return nullptr;
+  }
+  auto output = NewOutputTensor(cnode);
+  if (output->DataSize() != inputs[0]->DataSize()) {
+    return nullptr;
+  }
+  std::vector<double> elements;
+  if (src_type == kNumberTypeFloat32) {
+    ReadElements<float>(inputs[0], &elements);
+  } else if (src_type == kNumberTypeFloat16) {
+    ReadElements<float16>(inputs[0], &elements);
+  } else {
+    ReadElements<int32_t>(inputs[0], &elements);
+  }
+  if (dst_type == kNumberTypeFloat32) {
+    WriteElements<float>(elements, output);
+  } else if (dst_type == kNumberTypeFloat16) {
+    WriteElements<float16>(elements, output);
+  } else {
+    WriteElements<int32_t>(elements, output);
+  }
+  return output;
+}
+
+const std::unordered_map<std::string, FoldFunc> &FoldFuncs() {
+  static const std::unordered_map<std::string, FoldFunc> fold_funcs = {
+    {prim::kPrimCast->name(), FoldCast},       {prim::kPrimReshape->name(), FoldReshape},
+    {kExpandDimsOpName, FoldReshape},          {prim::kPrimSqueeze->name(), FoldReshape},
+    {prim::kPrimFlatten->name(), FoldReshape}};
+  return fold_funcs;
+}
+
+// the tensors of the inputs if they're all tensor value nodes
+bool GetConstInputs(const CNodePtr &cnode, std::vector<tensor::TensorPtr> *inputs) {
+  for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+    auto &input = cnode->input(i);
+    if (!IsValueNode<tensor::Tensor>(input)) {
+      return false;
+    }
+    inputs->push_back(GetValueNode<tensor::TensorPtr>(input));
+  }
+  return !inputs->empty();
+}
+
+ValueNodePtr Fold(const std::shared_ptr<session::KernelGraph> &kernel_graph, const CNodePtr &cnode) {
+  if (!AnfAlgo::IsRealCNodeKernel(cnode) || AnfAlgo::GetOutputTensorNum(cnode) != 1) {
+    return nullptr;
+  }
+  auto iter = FoldFuncs().find(AnfAlgo::GetCNodeName(cnode));
+  if (iter == FoldFuncs().end()) {
+    return nullptr;
+  }
+  std::vector<tensor::TensorPtr> inputs;
+  if (!GetConstInputs(cnode, &inputs)) {
+    return nullptr;
+  }
+  auto tensor = iter->second(cnode, inputs);
+  if (tensor == nullptr) {
+    return nullptr;
+  }
+  auto value_node = std::make_shared<ValueNode>(tensor);
+  value_node->set_abstract(tensor->ToAbstract());
+  value_node = kernel_graph->NewValueNode(value_node);
+  value_node->set_scope(cnode->scope());
+  kernel_graph->AddValueNodeToGraph(value_node);
+  return value_node;
+}
+}  // namespace
+
+bool ConstFolding::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto kernel_graph = func_graph->cast<std::shared_ptr<session::KernelGraph>>();
+  if (kernel_graph == nullptr) {
+    return false;
+  }
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  // the outputs of the graph are kept as kernels, the outputs are fetched from the kernels
+  auto outputs = AnfAlgo::GetAllOutput(func_graph->output(), {prim::kPrimTupleGetItem});
+  std::unordered_set<AnfNodePtr> output_set(outputs.begin(), outputs.end());
+  std::unordered_set<ValueNodePtr> folded_inputs;
+  // in topological order, a folded node makes its users foldable
+  for (auto &node : TopoSort(func_graph->get_return())) {
+    if (!node->isa<CNode>() || output_set.find(node) != output_set.end()) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    auto value_node = Fold(kernel_graph, cnode);
+    if (value_node == nullptr) {
+      continue;
+    }
+    MS_LOG(INFO) << "Fold " << cnode->DebugString() << " into " << value_node->DebugString();
+    for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+      (void)folded_inputs.insert(cnode->input(i)->cast<ValueNodePtr>());
+    }
+    (void)manager->Replace(cnode, value_node);
+  }
+  for (auto &value_node : folded_inputs) {
+    if (!manager->all_nodes().contains(value_node)) {
+      kernel_graph->RemoveValueNodeFromGraph(value_node);
+    }
+  }
+  return !folded_inputs.empty();
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_PASS_CONST_FOLDING_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_PASS_CONST_FOLDING_H_
+#include "pre_activate/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// Evaluate on host the kernels whose inputs are all tensor value nodes, and replace them by value nodes, so that
+// they're not built and launched every step. The kernels folded are the reshapes, which keep the data, and the casts
+// between float32, float16 and int32. The value nodes left unused are removed from the kernel graph, they get no
+// static memory.
+class ConstFolding : public Pass {
+ public:
+  ConstFolding() : Pass("const_folding") {}
+  ~ConstFolding() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_PASS_CONST_FOLDING_H_
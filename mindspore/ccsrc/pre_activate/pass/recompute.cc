@@ -0,0 +1,144 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/pass/recompute.h"
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "utils/context/ms_context.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// the scope of the nodes created by the bprop functions
+constexpr auto kGradientsScope = "Gradients/";
+// BatchNorm is not recomputed, it updates the moving mean and variance in place
+const std::set<std::string> kCheapOpSet = {"ReLU", "Gelu", "Tanh", "Cast", "TensorAdd", "Sub", "Mul", kRealDivOpName};
+
+bool IsBackwardNode(const AnfNodePtr &node) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto scope = node->scope();
+  static const std::string gradients_scope = kGradientsScope;
+  return scope != nullptr && scope->name().compare(0, gradients_scope.size(), gradients_scope) == 0;
+}
+
+bool IsRecomputeNode(const CNodePtr &node, bool auto_recompute) {
+  if (!AnfAlgo::IsRealKernel(node) || IsBackwardNode(node) || node->inputs().size() <= 1 ||
+      AnfAlgo::GetOutputTensorNum(node) != 1) {
+    return false;
+  }
+  if (AnfAlgo::HasNodeAttr(kAttrRecompute, node)) {
+    return AnfAlgo::GetNodeAttr<bool>(node, kAttrRecompute);
+  }
+  return auto_recompute && kCheapOpSet.find(AnfAlgo::GetCNodeName(node)) != kCheapOpSet.end();
+}
+
+// If the inputs stay in memory till the backward pass anyway, the recompute does not make them live longer
+bool IsInputsKeptForBackward(const FuncGraphManagerPtr &manager, const CNodePtr &node) {
+  for (size_t i = 1; i < node->inputs().size(); ++i) {
+    auto input = node->input(i);
+    if (!input->isa<CNode>()) {
+      continue;
+    }
+    auto &users = manager->node_users()[input];
+    if (std::none_of(users.begin(), users.end(),
+                     [](const std::pair<AnfNodePtr, int> &user) { return IsBackwardNode(user.first); })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A backward input of the user, which is computed right before the user
+AnfNodePtr FindBackwardAnchor(const CNodePtr &user, const AnfNodePtr &node) {
+  for (size_t i = 1; i < user->inputs().size(); ++i) {
+    auto input = user->input(i);
+    if (input != node && input->isa<CNode>() && IsBackwardNode(input)) {
+      return input;
+    }
+  }
+  return nullptr;
+}
+
+CNodePtr CreateRecomputeNode(const std::shared_ptr<session::KernelGraph> &kernel_graph, const CNodePtr &node,
+                             const AnfNodePtr &anchor) {
+  auto inputs = node->inputs();
+  // the first input waits for the anchor, so the recompute is not scheduled in the forward pass
+  auto first_input = inputs[1];
+  auto depend = kernel_graph->NewCNode({NewValueNode(prim::kPrimDepend), first_input, anchor});
+  MS_EXCEPTION_IF_NULL(depend);
+  depend->set_abstract(first_input->abstract());
+  inputs[1] = depend;
+  auto recompute_node = kernel_graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(recompute_node);
+  recompute_node->set_abstract(node->abstract());
+  recompute_node->set_scope(anchor->scope());
+  AnfAlgo::SetSelectKernelBuildInfo(AnfAlgo::GetSelectKernelBuildInfo(node), recompute_node.get());
+  return recompute_node;
+}
+}  // namespace
+
+bool Recompute::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto kernel_graph = func_graph->cast<std::shared_ptr<session::KernelGraph>>();
+  if (kernel_graph == nullptr) {
+    return false;
+  }
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  bool auto_recompute = context_ptr->enable_recompute();
+  bool changed = false;
+  for (auto &node : TopoSort(func_graph->get_return())) {
+    MS_EXCEPTION_IF_NULL(node);
+    if (!node->isa<CNode>()) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    if (!IsRecomputeNode(cnode, auto_recompute)) {
+      continue;
+    }
+    // the marked nodes are recomputed even if their inputs live longer for it
+    if (!AnfAlgo::HasNodeAttr(kAttrRecompute, cnode) && !IsInputsKeptForBackward(manager, cnode)) {
+      continue;
+    }
+    // copy the users, the edges are changed below
+    auto users = manager->node_users()[cnode];
+    for (auto &user : users) {
+      if (!user.first->isa<CNode>() || !IsBackwardNode(user.first)) {
+        continue;
+      }
+      auto anchor = FindBackwardAnchor(user.first->cast<CNodePtr>(), cnode);
+      if (anchor == nullptr) {
+        continue;
+      }
+      MS_LOG(INFO) << "Recompute " << cnode->DebugString() << " for " << user.first->DebugString();
+      manager->SetEdge(user.first, user.second, CreateRecomputeNode(kernel_graph, cnode, anchor));
+      changed = true;
+    }
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_PASS_RECOMPUTE_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_PASS_RECOMPUTE_H_
+#include "pre_activate/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// Recompute the forward nodes near their users in the backward graph, so their outputs do not stay in memory
+// between the forward and the backward pass. The nodes marked with the attr "recompute" are recomputed, and the cheap
+// elementwise nodes too if the recompute of the context is enabled.
+class Recompute : public Pass {
+ public:
+  Recompute() : Pass("recompute") {}
+  ~Recompute() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_PASS_RECOMPUTE_H_
@@ -0,0 +1,418 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "predict/converter/graph_optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include "device/convert_tensor_utils.h"
+#include "predict/converter/executor_tensor.h"
+#include "utils/convert_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace executor {
+namespace {
+constexpr size_t kConvInputNum = 2;
+constexpr size_t kConvWithBiasInputNum = 3;
+constexpr size_t kBatchNormInputNum = 5;
+constexpr size_t kBatchNormScaleIndex = 1;
+constexpr size_t kBatchNormOffsetIndex = 2;
+constexpr size_t kBatchNormMeanIndex = 3;
+constexpr size_t kBatchNormVarianceIndex = 4;
+constexpr size_t kBiasAddInputNum = 2;
+
+bool IsGraphInput(const SubGraphDefT &sub_graph, uint32_t tensor_idx) {
+  return std::find(sub_graph.inputIndex.begin(), sub_graph.inputIndex.end(), tensor_idx) != sub_graph.inputIndex.end();
+}
+
+bool IsGraphOutput(const SubGraphDefT &sub_graph, uint32_t tensor_idx) {
+  return std::find(sub_graph.outputIndex.begin(), sub_graph.outputIndex.end(), tensor_idx) !=
+         sub_graph.outputIndex.end();
+}
+
+// the nodes using the tensor, a node using it several times is listed once for each
+std::vector<size_t> GetConsumers(const SubGraphDefT &sub_graph, uint32_t tensor_idx) {
+  std::vector<size_t> consumers;
+  for (size_t i = 0; i < sub_graph.nodes.size(); ++i) {
+    for (auto input_idx : sub_graph.nodes[i]->opDef->inputIndex) {
+      if (input_idx == tensor_idx) {
+        consumers.push_back(i);
+      }
+    }
+  }
+  return consumers;
+}
+
+// the single node using the tensor, or -1 if it is used by other nodes or is an output of the graph
+int GetSingleConsumer(const SubGraphDefT &sub_graph, uint32_t tensor_idx) {
+  auto consumers = GetConsumers(sub_graph, tensor_idx);
+  if (consumers.size() != 1 || IsGraphOutput(sub_graph, tensor_idx)) {
+    return -1;
+  }
+  return SizeToInt(consumers[0]);
+}
+
+int GetProducer(const SubGraphDefT &sub_graph, uint32_t tensor_idx) {
+  for (size_t i = 0; i < sub_graph.nodes.size(); ++i) {
+    auto &output_index = sub_graph.nodes[i]->opDef->outputIndex;
+    if (std::find(output_index.begin(), output_index.end(), tensor_idx) != output_index.end()) {
+      return SizeToInt(i);
+    }
+  }
+  return -1;
+}
+
+bool IsUnused(const SubGraphDefT &sub_graph, uint32_t tensor_idx) {
+  return GetConsumers(sub_graph, tensor_idx).empty() && !IsGraphOutput(sub_graph, tensor_idx);
+}
+
+bool IsConstTensor(const SubGraphDefT &sub_graph, uint32_t tensor_idx) {
+  if (tensor_idx >= sub_graph.allTensors.size() || sub_graph.allTensors[tensor_idx] == nullptr) {
+    return false;
+  }
+  auto &tensor = sub_graph.allTensors[tensor_idx];
+  return !tensor->data.empty() && !IsGraphInput(sub_graph, tensor_idx) && GetProducer(sub_graph, tensor_idx) < 0;
+}
+
+size_t GetElementNum(const std::vector<int> &dims) {
+  size_t num = 1;
+  for (auto dim : dims) {
+    num *= IntToSize(dim);
+  }
+  return num;
+}
+
+// the float data of a constant with 'element_num' elements, nullptr if it is not one
+float *GetConstFloatData(const SubGraphDefT &sub_graph, uint32_t tensor_idx, size_t element_num) {
+  if (!IsConstTensor(sub_graph, tensor_idx)) {
+    return nullptr;
+  }
+  auto &tensor = sub_graph.allTensors[tensor_idx];
+  if (tensor->dataType != predict::DataType_DT_FLOAT || GetElementNum(tensor->dims) != element_num ||
+      tensor->data.size() != element_num * sizeof(float)) {
+    return nullptr;
+  }
+  return reinterpret_cast<float *>(tensor->data.data());
+}
+
+uint32_t AddConstFloatTensor(const std::vector<float> &values, SubGraphDefT *sub_graph) {
+  std::unique_ptr<TensorDefT> tensor(new TensorDefT());
+  tensor->dataType = predict::DataType_DT_FLOAT;
+  tensor->dims = {SizeToInt(values.size())};
+  tensor->format = predict::Format_NCHW;
+  tensor->refCount = MS_MAX_REFCOUNT;
+  tensor->offset = 0;
+  tensor->data.resize(values.size() * sizeof(float));
+  if (!values.empty() && memcpy_s(tensor->data.data(), tensor->data.size(), values.data(), tensor->data.size()) != 0) {
+    MS_LOG(EXCEPTION) << "memcpy_s failed";
+  }
+  sub_graph->allTensors.emplace_back(std::move(tensor));
+  return SizeToUint(sub_graph->allTensors.size() - 1);
+}
+
+// the Conv2D node with float weights of its output channels, nullptr if the node is not one
+predict::Conv2DT *GetFloatConv(const SubGraphDefT &sub_graph, size_t node_idx, size_t *channel_out) {
+  auto &op = sub_graph.nodes[node_idx]->opDef;
+  auto conv = op->attr.AsConv2D();
+  if (conv == nullptr || (op->inputIndex.size() != kConvInputNum && op->inputIndex.size() != kConvWithBiasInputNum) ||
+      op->outputIndex.size() != 1) {
+    return nullptr;
+  }
+  auto weight_idx = op->inputIndex[1];
+  if (!IsConstTensor(sub_graph, weight_idx) || sub_graph.allTensors[weight_idx]->dims.empty()) {
+    return nullptr;
+  }
+  *channel_out = IntToSize(sub_graph.allTensors[weight_idx]->dims[0]);
+  if (op->inputIndex.size() == kConvWithBiasInputNum &&
+      GetConstFloatData(sub_graph, op->inputIndex[2], *channel_out) == nullptr) {
+    return nullptr;
+  }
+  return conv;
+}
+
+// set the bias of the convolution to 'bias' plus its current one, a bias shared with other nodes is kept
+void AddConvBias(const std::vector<float> &bias, size_t conv_idx, SubGraphDefT *sub_graph) {
+  auto &op = sub_graph->nodes[conv_idx]->opDef;
+  std::vector<float> new_bias = bias;
+  if (op->inputIndex.size() == kConvWithBiasInputNum) {
+    auto old_bias = GetConstFloatData(*sub_graph, op->inputIndex[2], bias.size());
+    MS_EXCEPTION_IF_NULL(old_bias);
+    for (size_t i = 0; i < new_bias.size(); ++i) {
+      new_bias[i] += old_bias[i];
+    }
+    op->inputIndex.pop_back();
+  }
+  op->inputIndex.push_back(AddConstFloatTensor(new_bias, sub_graph));
+  op->attr.AsConv2D()->hasBias = true;
+}
+
+// replace the output of the producer by the output of the node following it, and remove that node
+void MergeIntoProducer(size_t producer_idx, size_t node_idx, SubGraphDefT *sub_graph) {
+  auto &node_outputs = sub_graph->nodes[node_idx]->opDef->outputIndex;
+  sub_graph->nodes[producer_idx]->opDef->outputIndex = {node_outputs[0]};
+  (void)sub_graph->nodes.erase(sub_graph->nodes.begin() + SizeToLong(node_idx));
+}
+}  // namespace
+
+bool MsGraphOptimizer::Run(SubGraphDefT *sub_graph) {
+  if (sub_graph == nullptr) {
+    return false;
+  }
+  size_t node_num = sub_graph->nodes.size();
+  bool changed = true;
+  while (changed) {
+    changed = FoldConstReshape(sub_graph);
+    changed = EliminateReshape(sub_graph) || changed;
+    changed = FoldBatchNorm(sub_graph) || changed;
+    changed = FuseConvBiasAdd(sub_graph) || changed;
+    changed = FuseConvActivation(sub_graph) || changed;
+  }
+  RemoveUnusedTensors(sub_graph);
+  MS_LOG(INFO) << "Optimize the graph from " << node_num << " nodes to " << sub_graph->nodes.size() << " nodes.";
+  return true;
+}
+
+bool MsGraphOptimizer::CastToFloat16(SubGraphDefT *sub_graph) {
+  if (sub_graph == nullptr) {
+    return false;
+  }
+  size_t cast_num = 0;
+  for (auto &tensor : sub_graph->allTensors) {
+    if (tensor == nullptr || tensor->dataType != predict::DataType_DT_FLOAT) {
+      continue;
+    }
+    if (!tensor->data.empty()) {
+      size_t elem_num = tensor->data.size() / sizeof(float);
+      std::vector<uint8_t> half_data(elem_num * sizeof(uint16_t));
+      device::FloatToHalf(half_data.data(), tensor->data.data(), elem_num);
+      tensor->data.swap(half_data);
+    }
+    tensor->dataType = predict::DataType_DT_FLOAT16;
+    ++cast_num;
+  }
+  MS_LOG(INFO) << "Cast " << cast_num << " tensors of the graph to float16.";
+  return true;
+}
+
+bool MsGraphOptimizer::FoldBatchNorm(SubGraphDefT *sub_graph) {
+  bool changed = false;
+  for (size_t i = 0; i < sub_graph->nodes.size(); ++i) {
+    size_t channel_out = 0;
+    auto conv = GetFloatConv(*sub_graph, i, &channel_out);
+    if (conv == nullptr) {
+      continue;
+    }
+    auto &conv_op = sub_graph->nodes[i]->opDef;
+    auto bn_idx = GetSingleConsumer(*sub_graph, conv_op->outputIndex[0]);
+    if (bn_idx < 0 || conv->activationType != predict::ActivationType_NO_ACTIVATION) {
+      continue;
+    }
+    auto &bn_op = sub_graph->nodes[IntToSize(bn_idx)]->opDef;
+    auto bn = bn_op->attr.AsFusedBatchNorm();
+    if (bn == nullptr || bn_op->inputIndex.size() != kBatchNormInputNum ||
+        bn_op->inputIndex[0] != conv_op->outputIndex[0] || bn_op->outputIndex.empty()) {
+      continue;
+    }
+    // the statistics outputs of the batch norm are only produced for training
+    bool stats_unused = std::all_of(bn_op->outputIndex.begin() + 1, bn_op->outputIndex.end(),
+                                    [sub_graph](uint32_t idx) { return IsUnused(*sub_graph, idx); });
+    auto weight_idx = conv_op->inputIndex[1];
+    auto &weight = sub_graph->allTensors[weight_idx];
+    auto weight_data = GetConstFloatData(*sub_graph, weight_idx, GetElementNum(weight->dims));
+    auto scale = GetConstFloatData(*sub_graph, bn_op->inputIndex[kBatchNormScaleIndex], channel_out);
+    auto offset = GetConstFloatData(*sub_graph, bn_op->inputIndex[kBatchNormOffsetIndex], channel_out);
+    auto mean = GetConstFloatData(*sub_graph, bn_op->inputIndex[kBatchNormMeanIndex], channel_out);
+    auto variance = GetConstFloatData(*sub_graph, bn_op->inputIndex[kBatchNormVarianceIndex], channel_out);
+    if (!stats_unused || GetConsumers(*sub_graph, weight_idx).size() != 1 || weight_data == nullptr ||
+        scale == nullptr || offset == nullptr || mean == nullptr || variance == nullptr || channel_out == 0) {
+      continue;
+    }
+    // y = (conv(x, w) + b - mean) * scale / sqrt(variance + epsilon) + offset
+    size_t channel_size = GetElementNum(weight->dims) / channel_out;
+    std::vector<float> bias(channel_out);
+    for (size_t c = 0; c < channel_out; ++c) {
+      float factor = scale[c] / std::sqrt(variance[c] + bn->epsilon);
+      for (size_t j = 0; j < channel_size; ++j) {
+        weight_data[c * channel_size + j] *= factor;
+      }
+      bias[c] = offset[c] - mean[c] * factor;
+      if (conv_op->inputIndex.size() == kConvWithBiasInputNum) {
+        auto old_bias = GetConstFloatData(*sub_graph, conv_op->inputIndex[2], channel_out);
+        bias[c] += old_bias[c] * factor - old_bias[c];
+      }
+    }
+    AddConvBias(bias, i, sub_graph);
+    MergeIntoProducer(i, IntToSize(bn_idx), sub_graph);
+    changed = true;
+  }
+  return changed;
+}
+
+bool MsGraphOptimizer::FuseConvBiasAdd(SubGraphDefT *sub_graph) {
+  bool changed = false;
+  for (size_t i = 0; i < sub_graph->nodes.size(); ++i) {
+    size_t channel_out = 0;
+    auto conv = GetFloatConv(*sub_graph, i, &channel_out);
+    if (conv == nullptr || conv->activationType != predict::ActivationType_NO_ACTIVATION) {
+      continue;
+    }
+    auto &conv_op = sub_graph->nodes[i]->opDef;
+    auto bias_add_idx = GetSingleConsumer(*sub_graph, conv_op->outputIndex[0]);
+    if (bias_add_idx < 0) {
+      continue;
+    }
+    auto &bias_add_op = sub_graph->nodes[IntToSize(bias_add_idx)]->opDef;
+    if (bias_add_op->attr.AsBiasAdd() == nullptr || bias_add_op->inputIndex.size() != kBiasAddInputNum ||
+        bias_add_op->inputIndex[0] != conv_op->outputIndex[0] || bias_add_op->outputIndex.size() != 1) {
+      continue;
+    }
+    auto bias = GetConstFloatData(*sub_graph, bias_add_op->inputIndex[1], channel_out);
+    if (bias == nullptr) {
+      continue;
+    }
+    AddConvBias(std::vector<float>(bias, bias + channel_out), i, sub_graph);
+    MergeIntoProducer(i, IntToSize(bias_add_idx), sub_graph);
+    changed = true;
+  }
+  return changed;
+}
+
+bool MsGraphOptimizer::FuseConvActivation(SubGraphDefT *sub_graph) {
+  bool changed = false;
+  for (size_t i = 0; i < sub_graph->nodes.size(); ++i) {
+    auto &conv_op = sub_graph->nodes[i]->opDef;
+    auto conv = conv_op->attr.AsConv2D();
+    if (conv == nullptr || conv->activationType != predict::ActivationType_NO_ACTIVATION ||
+        conv_op->outputIndex.size() != 1) {
+      continue;
+    }
+    auto act_idx = GetSingleConsumer(*sub_graph, conv_op->outputIndex[0]);
+    if (act_idx < 0) {
+      continue;
+    }
+    auto &act_op = sub_graph->nodes[IntToSize(act_idx)]->opDef;
+    auto act = act_op->attr.AsActivation();
+    if (act == nullptr || (act->type != predict::ActivationType_RELU && act->type != predict::ActivationType_RELU6) ||
+        act_op->inputIndex.size() != 1 || act_op->outputIndex.size() != 1) {
+      continue;
+    }
+    conv->activationType = act->type;
+    MergeIntoProducer(i, IntToSize(act_idx), sub_graph);
+    changed = true;
+  }
+  return changed;
+}
+
+bool MsGraphOptimizer::EliminateReshape(SubGraphDefT *sub_graph) {
+  bool changed = false;
+  for (size_t i = 0; i < sub_graph->nodes.size();) {
+    auto &op = sub_graph->nodes[i]->opDef;
+    if (op->attr.AsReshape() == nullptr || op->inputIndex.size() != 1 || op->outputIndex.size() != 1) {
+      ++i;
+      continue;
+    }
+    auto input_idx = op->inputIndex[0];
+    auto output_idx = op->outputIndex[0];
+    // an identity reshape, its users take its input instead
+    if (sub_graph->allTensors[input_idx]->dims == sub_graph->allTensors[output_idx]->dims &&
+        !IsGraphOutput(*sub_graph, output_idx)) {
+      for (auto consumer : GetConsumers(*sub_graph, output_idx)) {
+        auto &consumer_inputs = sub_graph->nodes[consumer]->opDef->inputIndex;
+        std::replace(consumer_inputs.begin(), consumer_inputs.end(), output_idx, input_idx);
+      }
+      (void)sub_graph->nodes.erase(sub_graph->nodes.begin() + SizeToLong(i));
+      changed = true;
+      continue;
+    }
+    // the reshape of a reshape used by it alone, it takes the input of the first one
+    auto producer = GetProducer(*sub_graph, input_idx);
+    if (producer >= 0 && sub_graph->nodes[IntToSize(producer)]->opDef->attr.AsReshape() != nullptr &&
+        sub_graph->nodes[IntToSize(producer)]->opDef->inputIndex.size() == 1 &&
+        GetSingleConsumer(*sub_graph, input_idx) == SizeToInt(i)) {
+      op->inputIndex[0] = sub_graph->nodes[IntToSize(producer)]->opDef->inputIndex[0];
+      (void)sub_graph->nodes.erase(sub_graph->nodes.begin() + producer);
+      changed = true;
+      continue;
+    }
+    ++i;
+  }
+  return changed;
+}
+
+bool MsGraphOptimizer::FoldConstReshape(SubGraphDefT *sub_graph) {
+  bool changed = false;
+  for (size_t i = 0; i < sub_graph->nodes.size();) {
+    auto &op = sub_graph->nodes[i]->opDef;
+    if (op->attr.AsReshape() == nullptr || op->inputIndex.size() != 1 || op->outputIndex.size() != 1 ||
+        !IsConstTensor(*sub_graph, op->inputIndex[0]) || GetSingleConsumer(*sub_graph, op->inputIndex[0]) < 0 ||
+        IsGraphOutput(*sub_graph, op->outputIndex[0])) {
+      ++i;
+      continue;
+    }
+    auto &input = sub_graph->allTensors[op->inputIndex[0]];
+    auto &output = sub_graph->allTensors[op->outputIndex[0]];
+    output->data = std::move(input->data);
+    input->data.clear();
+    output->refCount = MS_MAX_REFCOUNT;
+    (void)sub_graph->nodes.erase(sub_graph->nodes.begin() + SizeToLong(i));
+    changed = true;
+  }
+  return changed;
+}
+
+void MsGraphOptimizer::RemoveUnusedTensors(SubGraphDefT *sub_graph) {
+  std::vector<bool> used(sub_graph->allTensors.size(), false);
+  auto mark = [&used](const std::vector<uint32_t> &indexes) {
+    for (auto idx : indexes) {
+      used[idx] = true;
+    }
+  };
+  mark(sub_graph->inputIndex);
+  mark(sub_graph->outputIndex);
+  for (auto &node : sub_graph->nodes) {
+    mark(node->opDef->inputIndex);
+    mark(node->opDef->outputIndex);
+  }
+  std::vector<uint32_t> new_index(sub_graph->allTensors.size(), 0);
+  std::vector<std::unique_ptr<TensorDefT>> all_tensors;
+  for (size_t i = 0; i < sub_graph->allTensors.size(); ++i) {
+    if (used[i]) {
+      new_index[i] = SizeToUint(all_tensors.size());
+      all_tensors.emplace_back(std::move(sub_graph->allTensors[i]));
+    }
+  }
+  if (all_tensors.size() == sub_graph->allTensors.size()) {
+    sub_graph->allTensors = std::move(all_tensors);
+    return;
+  }
+  MS_LOG(INFO) << "Remove " << sub_graph->allTensors.size() - all_tensors.size() << " unused tensors.";
+  sub_graph->allTensors = std::move(all_tensors);
+  auto remap = [&new_index](std::vector<uint32_t> *indexes) {
+    for (auto &idx : *indexes) {
+      idx = new_index[idx];
+    }
+  };
+  remap(&sub_graph->inputIndex);
+  remap(&sub_graph->outputIndex);
+  for (auto &node : sub_graph->nodes) {
+    remap(&node->opDef->inputIndex);
+    remap(&node->opDef->outputIndex);
+  }
+}
+}  // namespace executor
+}  // namespace mindspore
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_PREDICT_CONVERTER_GRAPH_OPTIMIZER_H_
+#define MINDSPORE_MINDSPORE_CCSRC_PREDICT_CONVERTER_GRAPH_OPTIMIZER_H_
+
+#include <vector>
+#include "predict/schema/inner/ms_generated.h"
+#include "predict/converter/attr_utils/convert_util.h"
+
+namespace mindspore {
+namespace executor {
+// The offline optimizations of the converted graph, run once the weights are filled so that they can be rewritten:
+//   - a FusedBatchNorm after a Conv2D is folded into the weight and bias of the convolution;
+//   - a BiasAdd and a ReLU or ReLU6 after a Conv2D are fused into it;
+//   - a chain of Reshapes is replaced by its last one and an identity Reshape is removed;
+//   - a Reshape of a constant is folded into the constant.
+// A pattern is only rewritten if its intermediate tensors are used by it alone, the tensors left unused are removed.
+class MsGraphOptimizer {
+ public:
+  MsGraphOptimizer() = default;
+  ~MsGraphOptimizer() = default;
+
+  bool Run(SubGraphDefT *sub_graph);
+
+  // Cast the float tensors of the graph to float16 for the devices running float16 kernels, the runtime converts the
+  // inputs and outputs of the graph between float and float16.
+  bool CastToFloat16(SubGraphDefT *sub_graph);
+
+ private:
+  bool FoldBatchNorm(SubGraphDefT *sub_graph);
+  bool FuseConvBiasAdd(SubGraphDefT *sub_graph);
+  bool FuseConvActivation(SubGraphDefT *sub_graph);
+  bool EliminateReshape(SubGraphDefT *sub_graph);
+  bool FoldConstReshape(SubGraphDefT *sub_graph);
+  void RemoveUnusedTensors(SubGraphDefT *sub_graph);
+};
+}  // namespace executor
+}  // namespace mindspore
+#endif  // MINDSPORE_MINDSPORE_CCSRC_PREDICT_CONVERTER_GRAPH_OPTIMIZER_H_
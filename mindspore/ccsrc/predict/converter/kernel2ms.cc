@@ -18,6 +18,7 @@
 #include <algorithm>
 #include "transform/convert.h"
 #include "predict/converter/lite_model/op_attr_packer.h"
+#include "predict/converter/graph_optimizer.h"
 #include "mindspore/ccsrc/operator/ops.h"
 
 namespace mindspore {
@@ -558,6 +559,14 @@ bool Kernel2Ms::KernelInput2MS(const std::vector<TensorPtr> &input_tensors) {
 
 bool Kernel2Ms::SaveDeviceModel(const std::shared_ptr<GraphDefT> &new_ms_graph_ptr, const std::string &save_path_name) {
   MS_EXCEPTION_IF_NULL(new_ms_graph_ptr);
+  // the weights are filled by now, so the graph can be optimized offline
+  MsGraphOptimizer optimizer;
+  if (sub_ms_graph_ != nullptr && !optimizer.Run(sub_ms_graph_.get())) {
+    MS_LOG(WARNING) << "optimize the mindspore graph failed";
+  }
+  if (save_float16_ && sub_ms_graph_ != nullptr && !optimizer.CastToFloat16(sub_ms_graph_.get())) {
+    MS_LOG(WARNING) << "cast the mindspore graph to float16 failed";
+  }
   return predict::utils::SaveDeviceModelUtil(new_ms_graph_ptr, save_path_name, sub_ms_graph_.release());
 }
 }  // namespace executor
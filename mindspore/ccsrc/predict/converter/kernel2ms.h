@@ -53,6 +53,10 @@ class Kernel2Ms {
 
   void set_device_target(TargetMode device_target) { device_target_ = device_target; }
 
+  bool save_float16() const { return save_float16_; }
+
+  void set_save_float16(bool save_float16) { save_float16_ = save_float16; }
+
   bool SaveDeviceModel(const std::shared_ptr<GraphDefT> &new_ms_graph_ptr, const std::string &save_path_name);
 
  private:
@@ -109,6 +113,7 @@ class Kernel2Ms {
   TensorCachePtr tensor_cache_ptr_ = nullptr;
   ConvertMode convert_mode_ = kConvertCpuMode;
   TargetMode device_target_ = kCPUTarget;
+  bool save_float16_ = false;
   std::vector<uint32_t> input_weight_idxs_;
   std::vector<uint32_t> all_input_idxs_;
 };
@@ -47,6 +47,7 @@ void StepConvertWeight(const std::vector<tensor::TensorPtr> &inputs) {
   std::string save_path = MsContext::GetInstance()->save_ms_model_path();
   if (save_ms_model) {
     MS_LOG(INFO) << "save ms model is true to path " << save_path;
+    executor::Kernel2Ms::GetInstance().set_save_float16(MsContext::GetInstance()->save_ms_model_fp16_flag());
     if (!executor::Kernel2Ms::GetInstance().KernelInput2MS(inputs)) {
       MS_LOG(WARNING) << "convert mindspore kernel input failed";
     }
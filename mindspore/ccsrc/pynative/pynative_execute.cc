@@ -20,10 +20,13 @@
 #include <map>
 #include <set>
 #include <unordered_set>
+#include <unordered_map>
+#include <string>
 
 #include "utils/any.h"
 #include "utils/utils.h"
 #include "utils/context/ms_context.h"
+#include "utils/timeline.h"
 #include "operator/ops.h"
 #include "pipeline/parse/data_converter.h"
 #include "pipeline/static_analysis/prim.h"
@@ -39,6 +42,16 @@ namespace pynative {
 using transform::GraphRunner;
 using transform::GraphRunnerOptions;
 using transform::OperatorPtr;
+
+// the sessions are kept through the ops, so are the graphs of the ops built by them
+static std::map<std::string, std::shared_ptr<session::SessionBasic>> op_sessions;
+// the abstracts inferred by python for the ops, by the keys of their graphs
+static std::unordered_map<std::string, AbstractBasePtr> infer_results;
+constexpr size_t kMaxInferResultNum = 4096;
+// the constant tensors of the python scalars passed to the ops, by the types and values of the scalars
+static std::unordered_map<std::string, MeTensorPtr> scalar_tensors;
+constexpr size_t kMaxScalarTensorNum = 1024;
+
 inline ValuePtr PyAttrValue(const py::object& obj) {
   ValuePtr converted_ret = nullptr;
   bool converted = parse::ConvertData(obj, &converted_ret);
@@ -48,19 +61,33 @@ inline ValuePtr PyAttrValue(const py::object& obj) {
   return converted_ret;
 }
 
+// The scalars are read only by the ops, so a tensor is made once for each of them and shared by the calls.
+MeTensorPtr GetScalarTensor(const py::object& obj) {
+  // bool is a subclass of int, and str of a float round trips, so the key tells apart all the scalars
+  auto key = std::string(py::str(obj.get_type())) + ":" + std::string(py::str(obj));
+  auto iter = scalar_tensors.find(key);
+  if (iter != scalar_tensors.end()) {
+    return iter->second;
+  }
+  auto me_tensor_ptr = std::make_shared<MeTensor>(py::array(obj), nullptr);
+  if (scalar_tensors.size() < kMaxScalarTensorNum) {
+    scalar_tensors[key] = me_tensor_ptr;
+  }
+  return me_tensor_ptr;
+}
+
 MeTensorPtr ConvertPyObjToTensor(const py::object& obj) {
   MeTensorPtr me_tensor_ptr = nullptr;
   if (py::isinstance<MeTensor>(obj)) {
     me_tensor_ptr = py::cast<MeTensorPtr>(obj);
   } else if (py::isinstance<py::tuple>(obj)) {
     me_tensor_ptr = std::make_shared<MeTensor>(py::cast<py::tuple>(obj), nullptr);
-  } else if (py::isinstance<py::float_>(obj)) {
-    me_tensor_ptr = std::make_shared<MeTensor>(py::cast<py::float_>(obj), nullptr);
-  } else if (py::isinstance<py::int_>(obj)) {
-    me_tensor_ptr = std::make_shared<MeTensor>(py::cast<py::int_>(obj), nullptr);
+  } else if (py::isinstance<py::float_>(obj) || py::isinstance<py::int_>(obj)) {
+    me_tensor_ptr = GetScalarTensor(obj);
   } else if (py::isinstance<py::list>(obj)) {
     me_tensor_ptr = std::make_shared<MeTensor>(py::cast<py::list>(obj), nullptr);
   } else if (py::isinstance<py::array>(obj)) {
+    // the tensor borrows the buffer of the array, which it keeps alive
     me_tensor_ptr = std::make_shared<MeTensor>(py::cast<py::array>(obj), nullptr);
   } else {
     MS_LOG(EXCEPTION) << "run op inputs type is invalid!";
@@ -83,6 +110,59 @@ void PynativeInfer(const PrimitivePyPtr& prim, const py::tuple& py_args, OpExecI
   op_exec_info->abstract = infer_res;
 }
 
+void AppendInputInfo(const py::object& input, bool is_weight, std::string* graph_info) {
+  MS_EXCEPTION_IF_NULL(graph_info);
+  if (py::isinstance<tensor::Tensor>(input)) {
+    auto tensor_ptr = py::cast<tensor::TensorPtr>(input);
+    MS_EXCEPTION_IF_NULL(tensor_ptr);
+    // the kernels are built for the exact shapes, the device format of the input selects the kernel too
+    (void)graph_info->append(std::to_string(tensor_ptr->data_type()) + ":");
+    for (auto dim : tensor_ptr->shape()) {
+      (void)graph_info->append(std::to_string(dim) + ",");
+    }
+    auto device_address = tensor_ptr->device_address();
+    if (device_address != nullptr) {
+      (void)graph_info->append(device_address->format() + std::to_string(device_address->type_id()));
+    }
+    (void)graph_info->append(is_weight ? "w_" : "_");
+  } else if (py::isinstance<py::tuple>(input) || py::isinstance<py::list>(input)) {
+    auto items = py::tuple(input);
+    (void)graph_info->append("(");
+    for (auto& item : items) {
+      AppendInputInfo(py::reinterpret_borrow<py::object>(item), is_weight, graph_info);
+    }
+    (void)graph_info->append(")_");
+  } else {
+    // the const inputs are converted to the attrs of the kernel
+    (void)graph_info->append(std::string(py::str(input)) + "_");
+  }
+}
+
+// The key of the single op graph built by the session: the primitive, its attrs and the dtypes, shapes and formats of
+// the inputs, the values of the inputs not being tensors. The abstract follows from them.
+std::string GetSingleOpGraphInfo(const OpExecInfoPtr& op_exec_info) {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
+  std::string graph_info = op_exec_info->op_name + "_";
+  size_t input_num = op_exec_info->op_inputs.size();
+  for (size_t index = 0; index < input_num; ++index) {
+    bool is_weight = index < op_exec_info->inputs_mask.size() && py::cast<bool>(op_exec_info->inputs_mask[index]);
+    AppendInputInfo(op_exec_info->op_inputs[index], is_weight, &graph_info);
+  }
+  auto prim = op_exec_info->py_primitive;
+  if (prim != nullptr) {
+    // the attrs may be changed on the same primitive, the hash is independent of their order
+    size_t attrs_hash = 0;
+    for (const auto& attr : prim->attrs()) {
+      MS_EXCEPTION_IF_NULL(attr.second);
+      attrs_hash ^= std::hash<std::string>{}(attr.first + "=" + attr.second->ToString());
+    }
+    (void)graph_info.append(std::to_string(reinterpret_cast<uintptr_t>(prim.get())) + "_" +
+                            std::to_string(attrs_hash));
+  }
+  MS_LOG(INFO) << "graph info [" << graph_info << "]";
+  return graph_info;
+}
+
 OpExecInfoPtr GenerateOpExecInfo(const py::args& args) {
   if (args.size() != PY_ARGS_NUM) {
     MS_LOG(ERROR) << "four args are needed by RunOp";
@@ -103,11 +183,6 @@ OpExecInfoPtr GenerateOpExecInfo(const py::args& args) {
     if (pyobj == nullptr) {
       MS_LOG(EXCEPTION) << "pyobj is empty";
     }
-    py::tuple py_args = args[PY_INPUTS];
-    // use python infer method
-    if (ignore_infer_prim.find(op_exec_info->op_name) == ignore_infer_prim.end()) {
-      PynativeInfer(prim, py_args, op_exec_info.get());
-    }
     op_exec_info->py_primitive = prim;
     op_exec_info->op_attrs = py::getattr(args[PY_PRIM], "attrs");
   }
@@ -117,27 +192,22 @@ OpExecInfoPtr GenerateOpExecInfo(const py::args& args) {
     MS_LOG(ERROR) << "" << op_exec_info->op_name << " op_inputs size not equal op_mask";
     return nullptr;
   }
-  return op_exec_info;
-}
-
-std::string GetSingleOpGraphInfo(const OpExecInfoPtr& op_exec_info) {
-  MS_EXCEPTION_IF_NULL(op_exec_info);
-  std::string graph_info;
-  MS_EXCEPTION_IF_NULL(op_exec_info->abstract);
-  // get input tensor info
-  size_t input_num = op_exec_info->op_inputs.size();
-  for (size_t index = 0; index < input_num; ++index) {
-    if (py::isinstance<tensor::Tensor>(op_exec_info->op_inputs[index])) {
-      auto tensor_ptr = py::cast<tensor::TensorPtr>(op_exec_info->op_inputs[index]);
-      MS_EXCEPTION_IF_NULL(tensor_ptr);
-      (void)graph_info.append(tensor_ptr->GetShapeAndDataTypeInfo() + "_");
+  op_exec_info->graph_info = GetSingleOpGraphInfo(op_exec_info);
+  // use python infer method, the result follows from the key of the op as the inputs are broadened to their shapes
+  if (!py::isinstance<py::none>(args[PY_PRIM]) &&
+      ignore_infer_prim.find(op_exec_info->op_name) == ignore_infer_prim.end()) {
+    auto iter = infer_results.find(op_exec_info->graph_info);
+    if (iter != infer_results.end()) {
+      op_exec_info->abstract = iter->second;
+    } else {
+      PynativeInfer(op_exec_info->py_primitive, op_exec_info->op_inputs, op_exec_info.get());
+      if (infer_results.size() >= kMaxInferResultNum) {
+        infer_results.clear();
+      }
+      infer_results[op_exec_info->graph_info] = op_exec_info->abstract;
     }
   }
-  // get prim and abstract info
-  (void)graph_info.append(std::to_string((uintptr_t)(op_exec_info->py_primitive.get())) + "_" +
-                          op_exec_info->abstract->ToString());
-  MS_LOG(INFO) << "graph info [" << graph_info << "]";
-  return graph_info;
+  return op_exec_info;
 }
 
 bool SetInputsForSingleOpGraph(const OpExecInfoPtr& op_exec_info, const std::vector<GeTensorPtr>& inputs,
@@ -406,18 +476,28 @@ py::object RunOpInMs(const OpExecInfoPtr& op_exec_info, PynativeStatusCode* stat
   if (device_target != kAscendDevice && device_target != kGPUDevice) {
     MS_EXCEPTION(ArgumentError) << "device target [" << device_target << "] is not supported in Pynative mode";
   }
-  std::shared_ptr<session::SessionBasic> session = session::SessionFactory::Get().Create(device_target);
-  MS_EXCEPTION_IF_NULL(session);
-  session->Init(ms_context->device_id());
+  auto& session = op_sessions[device_target];
+  if (session == nullptr) {
+    session = session::SessionFactory::Get().Create(device_target);
+    MS_EXCEPTION_IF_NULL(session);
+    session->Init(ms_context->device_id());
+  }
 
-  std::string graph_info = GetSingleOpGraphInfo(op_exec_info);
-  session->BuildOp(*op_exec_info, graph_info);
+  const std::string& graph_info = op_exec_info->graph_info;
+  if (!session->IsOpGraphBuilt(graph_info)) {
+    session->BuildOp(*op_exec_info, graph_info);
+  }
   py::tuple result = session->RunOp(*op_exec_info, graph_info);
   ms_context->set_enable_pynative_infer(false);
   *status = PYNATIVE_SUCCESS;
   return result;
 }
 
+void ClearRunOpSessions() {
+  op_sessions.clear();
+  infer_results.clear();
+}
+
 py::object RunOpWithBackendPolicy(MsBackendPolicy backend_policy, const OpExecInfoPtr op_exec_info,
                                   PynativeStatusCode* const status) {
   MS_EXCEPTION_IF_NULL(status);
@@ -477,6 +557,7 @@ py::tuple RunOp(const py::args& args) {
 
   OpExecInfoPtr op_exec_info = GenerateOpExecInfo(args);
   MS_EXCEPTION_IF_NULL(op_exec_info);
+  TimelineSpan span("RunOp." + op_exec_info->op_name, "pynative");
   if (op_exec_info->abstract != nullptr) {
     py::dict output = abstract::ConvertAbstractToPython(op_exec_info->abstract);
     if (!output["value"].is_none()) {
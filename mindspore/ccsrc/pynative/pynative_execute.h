@@ -66,6 +66,8 @@ struct OpExecInfo {
   py::tuple op_inputs;
   py::tuple inputs_mask;
   py::dict op_attrs;
+  // the key of the single op graph and of the infer result
+  std::string graph_info;
 };
 using OpExecInfoPtr = std::shared_ptr<OpExecInfo>;
 OpExecInfoPtr GenerateOpExecInfo(const py::args& args);
@@ -77,6 +79,9 @@ py::object RunOpInGE(const OpExecInfoPtr& op_exec_info, PynativeStatusCode* stat
 py::object RunOpInVM(const OpExecInfoPtr& op_exec_info, PynativeStatusCode* status);
 
 py::tuple RunOp(const py::args& args);
+
+// release the single op graphs cached by the sessions before the device runtime
+void ClearRunOpSessions();
 }  // namespace pynative
 }  // namespace mindspore
 
@@ -32,6 +32,7 @@
 #include "debug/anf_ir_dump.h"
 #include "debug/anf_ir_utils.h"
 #include "common/utils.h"
+#include "utils/profile.h"
 #include "pre_activate/common/helper.h"
 #include "device/kernel_runtime_manager.h"
 #include "kernel/tbe/tbe_python_funcs.h"
@@ -105,6 +106,8 @@ GraphId AscendSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrL
   predictmodel::StepConvertGraph(graph);
   // optimize graph
   HardwareOptimize(graph);
+  // the formats are final, the kernels are compiled while the runtime is initialized and the graph is adjusted
+  device::ascend::KernelEarlyBuild(graph.get());
   // init runtime resource
   InitRuntimeResource();
   // assign static memory of parameters
@@ -217,12 +220,13 @@ void AscendSession::BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph
   // build kernel
   RunOpAdjustKernel(graph);
   BuildKernel(graph);
-  run_op_graphs_[graph_info] = graph;
+  CacheRunOpGraph(graph_info, graph);
 }
 
 py::tuple AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) {
-  auto graph = run_op_graphs_[graph_info];
+  auto graph = GetRunOpGraph(graph_info);
   MS_EXCEPTION_IF_NULL(graph);
+  ResetRunOpGraphOutputs(graph.get());
   MS_LOG(INFO) << "Run op " << op_run_info.op_name << " start!";
   // malloc mem
   std::vector<tensor::TensorPtr> input_tensors = {};
@@ -244,7 +248,6 @@ py::tuple AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &gr
   }
   py::object tuple_obj = utils::cast<PyObjectRef>(output_tensors).object_;
   py::tuple tuple_tensors = py::cast<py::tuple>(tuple_obj);
-  run_op_graphs_.clear();
   MS_LOG(INFO) << "Run op " << op_run_info.op_name << " finish!";
   return tuple_tensors;
 }
@@ -320,7 +323,9 @@ void AscendSession::BuildKernel(const std::shared_ptr<KernelGraph> &kernel_graph
   MS_LOG(INFO) << "start !";
   struct timeval start_time, end_time;
   (void)gettimeofday(&start_time, nullptr);
-  auto ret = device::ascend::KernelBuild(kernel_graph.get());
+  bool ret = false;
+  WITH_PASS_STAT("kernel_build", [&kernel_graph]() -> size_t { return kernel_graph->execution_order().size(); })
+  [&ret, &kernel_graph]() { ret = device::ascend::KernelBuild(kernel_graph.get()); };
   if (!ret) {
     MS_LOG(EXCEPTION) << "kernel build error.";
   }
@@ -17,12 +17,22 @@
 #include "device/gpu/kernel_info_setter.h"
 #include "device/gpu/gpu_kernel_build.h"
 #include "device/gpu/gpu_kernel_runtime.h"
+#include "device/gpu/gpu_stream_assign.h"
+#include "kernel/gpu/gpu_kernel_factory.h"
+#include "kernel/oplib/oplib.h"
 #include "pre_activate/common/optimizer.h"
 #include "pre_activate/common/pass_manager.h"
 #include "pre_activate/ascend/ir_fusion/allreduce_fusion.h"
+#include "pre_activate/pass/recompute.h"
+#include "pre_activate/gpu/conv2d_bn_relu_fusion.h"
+#include "pre_activate/gpu/elemwise_fusion.h"
+#include "pre_activate/gpu/apply_momentum_fusion.h"
+#include "pre_activate/gpu/gelu_expand.h"
+#include "pre_activate/gpu/graph_kernel_fusion.h"
 #include "device/kernel_runtime_manager.h"
 #include "predict/predict.h"
 #include "common/utils.h"
+#include "utils/profile.h"
 #include "utils/context/ms_context.h"
 
 namespace mindspore {
@@ -30,6 +40,21 @@ namespace session {
 namespace gpu {
 using AnfAlgo = mindspore::session::AnfRuntimeAlgorithm;
 
+void GPUSession::ExpandOps(const std::shared_ptr<KernelGraph> &kernel_graph) const {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (!context_ptr->ir_fusion_flag() || !context_ptr->enable_graph_kernel()) {
+    return;
+  }
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::GeluExpand>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+  kernel_graph->SetExecOrderByDefault();
+}
+
 void GPUSession::SelectKernel(const std::shared_ptr<KernelGraph> &kernel_graph) const {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   for (const auto &kernel_node : kernel_graph->execution_order()) {
@@ -38,6 +63,12 @@ void GPUSession::SelectKernel(const std::shared_ptr<KernelGraph> &kernel_graph)
   }
 }
 
+bool GPUSession::HasKernel(const CNodePtr &node) const {
+  auto op_name = AnfAlgo::GetCNodeName(node);
+  return kernel::GpuKernelFactory::GetInstance().IsRegistered(op_name) ||
+         kernel::OpLib::FindOp(op_name, kernel::OpImplyType::kAKG) != nullptr;
+}
+
 void GPUSession::StartKernelRT() const {
   auto runtime_instance = device::KernelRuntimeManager::Instance().GetSingleKernelRuntime(kGPUDevice, device_id_);
   MS_EXCEPTION_IF_NULL(runtime_instance);
@@ -50,13 +81,39 @@ void GPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
   auto optimizer = std::make_shared<opt::GraphOptimizer>();
   auto pm = std::make_shared<opt::PassManager>();
   pm->AddPass(std::make_shared<opt::AllReduceFusion>());
+  pm->AddPass(std::make_shared<opt::Recompute>());
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (context_ptr->ir_fusion_flag()) {
+    pm->AddPass(std::make_shared<opt::Conv2DBNReluFusion>());
+    if (context_ptr->enable_graph_kernel()) {
+      pm->AddPass(std::make_shared<opt::GraphKernelFusion>());
+    }
+    pm->AddPass(std::make_shared<opt::ElemwiseFusion>());
+    pm->AddPass(std::make_shared<opt::ApplyMomentumFusion>());
+  }
   optimizer->AddPassManager(pm);
   (void)optimizer->Optimize(kernel_graph);
   kernel_graph->SetExecOrderByDefault();
 }
 
 void GPUSession::BuildKernel(const std::shared_ptr<KernelGraph> &kernel_graph) const {
-  device::gpu::GpuBuild(kernel_graph);
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  WITH_PASS_STAT("kernel_build", [&kernel_graph]() -> size_t { return kernel_graph->execution_order().size(); })
+  [&kernel_graph]() { device::gpu::GpuBuild(kernel_graph); };
+}
+
+void GPUSession::AssignStream(const std::shared_ptr<KernelGraph> &kernel_graph) const {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  // the streams are used by the launch with the dynamic memory pool only
+  if (!context_ptr->enable_gpu_multi_stream() || !context_ptr->enable_dynamic_mem_pool() ||
+      context_ptr->enable_graph_static_memory()) {
+    return;
+  }
+  device::gpu::GPUStreamAssign stream_assign;
+  stream_assign.AssignStream(kernel_graph);
 }
 
 void GPUSession::AllocateMemory(KernelGraph *kernel_graph) const {
@@ -74,10 +131,10 @@ void GPUSession::RunOpAllocateMemory(const std::vector<tensor::TensorPtr> &input
   runtime_instance->RunOpAssignMemory(input_tensors, kernel_graph);
 }
 
-void GPUSession::Execute(const std::shared_ptr<KernelGraph> &kernel_graph) const {
+void GPUSession::Execute(const std::shared_ptr<KernelGraph> &kernel_graph, size_t steps) const {
   auto runtime_instance = device::KernelRuntimeManager::Instance().GetSingleKernelRuntime(kGPUDevice, device_id_);
   MS_EXCEPTION_IF_NULL(runtime_instance);
-  if (!runtime_instance->Run(kernel_graph.get())) {
+  if (!runtime_instance->RunSteps(kernel_graph.get(), steps)) {
     MS_LOG(EXCEPTION) << "GPU execute graph failed!";
   }
 }
@@ -86,6 +143,8 @@ GraphId GPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
   // Construct graph, if construct successs, graph_sum_ + 1
   auto graph_id = graph_sum_;
   auto graph = ConstructKernelGraph(lst, outputs);
+  // Expand the composite ops into the basic ops of the graph kernels
+  ExpandOps(graph);
   // Select kernel build info
   SelectKernel(graph);
   // Convert kernel Graph to model
@@ -100,6 +159,8 @@ GraphId GPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
   auto execution_order = graph->execution_order();
   Reorder(&execution_order);
   graph->set_execution_order(execution_order);
+  // Assign the independent kernels to several streams
+  AssignStream(graph);
   // Alloc memeory, include static memory and dynamic memory
   AllocateMemory(graph.get());
   // Reset memory resource
@@ -116,8 +177,8 @@ void GPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
   MS_EXCEPTION_IF_NULL(kernel_graph);
   // Convert inputs to model
   predictmodel::StepConvertWeight(inputs);
-  // Run graph on GPU
-  Execute(kernel_graph);
+  // Run graph on GPU, the steps of the loop sink don't return to the host, the outputs are the ones of the last step
+  Execute(kernel_graph, LoopSinkSteps(*kernel_graph));
   // Get result from GPU
   UpdateOutputs(kernel_graph, outputs, inputs);
   // Summary
@@ -135,12 +196,13 @@ void GPUSession::BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_in
   SelectKernel(kernel_graph);
   StartKernelRT();
   BuildKernel(kernel_graph);
-  run_op_graphs_[graph_info] = kernel_graph;
+  CacheRunOpGraph(graph_info, kernel_graph);
 }
 
 py::tuple GPUSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) {
-  auto kernel_graph = run_op_graphs_[graph_info];
+  auto kernel_graph = GetRunOpGraph(graph_info);
   MS_EXCEPTION_IF_NULL(kernel_graph);
+  ResetRunOpGraphOutputs(kernel_graph.get());
   std::vector<tensor::TensorPtr> input_tensors = {};
   std::vector<bool> tensors_mask = {};
   ToTensorPtr(op_run_info, &input_tensors, &tensors_mask);
@@ -159,7 +221,6 @@ py::tuple GPUSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph
   }
   py::object tuple_obj = utils::cast<PyObjectRef>(output_tensors).object_;
   py::tuple tuple_tensors = py::cast<py::tuple>(tuple_obj);
-  run_op_graphs_.clear();
   return tuple_tensors;
 }
 }  // namespace gpu
@@ -41,8 +41,11 @@ class GPUSession : public SessionBasic {
   void RunGraph(const GraphId &graph_id, const std::vector<tensor::TensorPtr> &inputs, VectorRef *outputs) override;
   void BuildOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) override;
   py::tuple RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph_info) override;
+  bool HasKernel(const CNodePtr &node) const override;
 
  private:
+  void ExpandOps(const std::shared_ptr<KernelGraph> &kernel_graph) const;
+
   void SelectKernel(const std::shared_ptr<KernelGraph> &kernel_graph) const;
 
   void StartKernelRT() const;
@@ -51,11 +54,13 @@ class GPUSession : public SessionBasic {
 
   void BuildKernel(const std::shared_ptr<KernelGraph> &kernel_graph) const;
 
+  void AssignStream(const std::shared_ptr<KernelGraph> &kernel_graph) const;
+
   void AllocateMemory(KernelGraph *kernel_graph) const;
 
   void RunOpAllocateMemory(const std::vector<tensor::TensorPtr> &input_tensors, KernelGraph *kernel_graph) const;
 
-  void Execute(const std::shared_ptr<KernelGraph> &kernel_graph) const;
+  void Execute(const std::shared_ptr<KernelGraph> &kernel_graph, size_t steps = 1) const;
 };
 using GPUSessionPtr = std::shared_ptr<GPUSession>;
 MS_REG_SESSION(kGPUDevice, GPUSession);
@@ -456,6 +456,20 @@ void KernelGraph::BfsToUpdateNodeOutput() {
 
 void KernelGraph::AddValueNodeToGraph(const ValueNodePtr &value_node) { (void)graph_value_nodes_.insert(value_node); }
 
+void KernelGraph::RemoveValueNodeFromGraph(const ValueNodePtr &value_node) {
+  (void)graph_value_nodes_.erase(value_node);
+}
+
+void KernelGraph::ReleaseLazyOutputs() {
+  for (auto &weak_output : lazy_outputs_) {
+    auto lazy_output = weak_output.lock();
+    if (lazy_output != nullptr) {
+      lazy_output->Release();
+    }
+  }
+  lazy_outputs_.clear();
+}
+
 bool KernelGraph::IsInRefOutputMap(const AnfWithOutIndex &pair) const { return ref_out_in_map_.count(pair) != 0; }
 
 AnfWithOutIndex KernelGraph::GetRefCorrespondOutput(const AnfWithOutIndex &out_pair) const {
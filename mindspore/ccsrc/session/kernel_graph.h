@@ -26,6 +26,7 @@
 #include <unordered_set>
 #include "ir/func_graph.h"
 #include "ir/anf.h"
+#include "ir/meta_tensor.h"
 #include "utils/graph_utils.h"
 
 namespace mindspore {
@@ -72,6 +73,8 @@ class KernelGraph : public FuncGraph {
   std::unordered_set<ValueNodePtr> graph_value_nodes() { return graph_value_nodes_; }
   // add value node to graph
   void AddValueNodeToGraph(const ValueNodePtr &value_node);
+  // remove value node from graph, it gets no memory
+  void RemoveValueNodeFromGraph(const ValueNodePtr &value_node);
   // ref output is in map
   bool IsInRefOutputMap(const AnfWithOutIndex &pair) const;
   // get ref correspond pairs
@@ -86,6 +89,10 @@ class KernelGraph : public FuncGraph {
   bool executable() const { return executable_; }
   // set executable of graph
   void set_executable(bool executable) { executable_ = executable; }
+  // add an output of the last run left on the device
+  void AddLazyOutput(const tensor::LazyHostDataPtr &lazy_output) { lazy_outputs_.emplace_back(lazy_output); }
+  // sync the outputs of the last run left on the device to host, before the next run writes their memory
+  void ReleaseLazyOutputs();
 
  private:
   // remove value node form graph
@@ -118,6 +125,8 @@ class KernelGraph : public FuncGraph {
   std::unordered_map<AnfNodePtr, std::vector<std::pair<AnfNodePtr, size_t>>> node_output_edges_;
   // graph needn't execute
   bool executable_;
+  // the outputs of the last run left on the device, which are gone if all their tensors are
+  std::vector<std::weak_ptr<tensor::LazyHostData>> lazy_outputs_;
 };
 }  // namespace session
 using KernelGraphPtr = std::shared_ptr<session::KernelGraph>;
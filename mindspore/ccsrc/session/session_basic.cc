@@ -33,6 +33,7 @@ namespace mindspore {
 namespace session {
 namespace {
 const int kSummaryGetItem = 2;
+const size_t kMaxRunOpGraphNum = 512;
 void GetSummaryNodes(const KernelGraph *graph, std::unordered_map<std::string, std::pair<AnfNodePtr, int>> *summary) {
   MS_LOG(DEBUG) << "Update summary Start";
   MS_EXCEPTION_IF_NULL(graph);
@@ -87,7 +88,7 @@ bool ExistSummaryNode(const KernelGraph *graph) {
   return false;
 }
 
-BaseRef CreateOneTensor(const AnfNodePtr &node, size_t output_index, const KernelGraph &graph,
+BaseRef CreateOneTensor(const AnfNodePtr &node, size_t output_index, KernelGraph *graph,
                         const std::vector<tensor::TensorPtr> &input_tensors) {
   MS_EXCEPTION_IF_NULL(node);
   MS_LOG(INFO) << "create tensor for output[" << node->DebugString() << "] index[" << output_index << "]";
@@ -99,11 +100,11 @@ BaseRef CreateOneTensor(const AnfNodePtr &node, size_t output_index, const Kerne
       return value_node->value();
     }
     if (node->isa<Parameter>()) {
-      for (size_t input_idx = 0; input_idx < graph.inputs().size(); input_idx++) {
+      for (size_t input_idx = 0; input_idx < graph->inputs().size(); input_idx++) {
         if (input_idx > input_tensors.size()) {
           MS_LOG(EXCEPTION) << "input idx:" << input_idx << "out of range:" << input_tensors.size();
         }
-        if (graph.inputs()[input_idx] == node) {
+        if (graph->inputs()[input_idx] == node) {
           return input_tensors[input_idx];
         }
       }
@@ -124,6 +125,9 @@ BaseRef CreateOneTensor(const AnfNodePtr &node, size_t output_index, const Kerne
   MS_EXCEPTION_IF_NULL(ms_context);
   if (ms_context->enable_pynative_infer()) {
     tensor->set_device_address(AnfAlgo::GetMutableOutputAddr(node, output_index));
+  } else if (node->isa<CNode>() && !graph->IsInRefOutputMap(std::make_pair(node, output_index))) {
+    // the output is left on the device until it is asked for on host, and the graph syncs it before writing it again
+    graph->AddLazyOutput(tensor->SetLazyHostData(AnfAlgo::GetMutableOutputAddr(node, output_index)));
   } else if (!address->SyncDeviceToHost(tensor->shape(), LongToSize(tensor->data().nbytes()), tensor->data_type(),
                                         tensor->data_c(true))) {
     MS_LOG(INFO) << "output sync device to host error!!!";
@@ -132,7 +136,7 @@ BaseRef CreateOneTensor(const AnfNodePtr &node, size_t output_index, const Kerne
   return tensor;
 }
 
-BaseRef CreatTensorForOutput(const AnfNodePtr &anf, const KernelGraph &graph,
+BaseRef CreatTensorForOutput(const AnfNodePtr &anf, KernelGraph *graph,
                              const std::vector<tensor::TensorPtr> &input_tensors) {
   MS_EXCEPTION_IF_NULL(anf);
   MS_LOG(INFO) << "create tensor for output[" << anf->DebugString() << "]";
@@ -157,7 +161,7 @@ BaseRef CreatTensorForOutput(const AnfNodePtr &anf, const KernelGraph &graph,
   return CreateOneTensor(item_with_index.first, item_with_index.second, graph, input_tensors);
 }
 
-BaseRef CreatTupleForOutput(const AnfNodePtr &anf, const KernelGraph &graph,
+BaseRef CreatTupleForOutput(const AnfNodePtr &anf, KernelGraph *graph,
                             const std::vector<tensor::TensorPtr> &input_tensors) {
   MS_EXCEPTION_IF_NULL(anf);
   if (!AnfAlgo::IsRealKernel(anf)) {
@@ -176,6 +180,16 @@ BaseRef CreatTupleForOutput(const AnfNodePtr &anf, const KernelGraph &graph,
   return ret;
 }
 
+// copy an output of a run still on the device to the input of the graph on the device, instead of through host
+bool CopyLazyOutputOnDevice(const tensor::TensorPtr &tensor, const DeviceAddressPtr &device_address) {
+  MS_EXCEPTION_IF_NULL(tensor);
+  MS_EXCEPTION_IF_NULL(device_address);
+  if (tensor->lazy_host_data() == nullptr || tensor->device_address() == nullptr) {
+    return false;
+  }
+  return device_address->SyncDeviceToDevice(tensor->device_address().get());
+}
+
 std::string FindOpInputParameterType(const std::string &op_name, kernel::OpImplyType implyType, size_t index) {
   std::string para_type;
   auto op_info = kernel::OpLib::FindOp(op_name, implyType);
@@ -508,6 +522,13 @@ void SessionBasic::LoadInputData(const std::shared_ptr<KernelGraph> &kernel_grap
           need_sync = true;
         }
       }
+      if (need_sync && CopyLazyOutputOnDevice(tensor, device_address)) {
+        need_sync = false;
+      }
+      // a weight loaded in the format of the device is copied as it is
+      if (need_sync && tensor->LoadDeviceContent(device_address)) {
+        need_sync = false;
+      }
       if (need_sync) {
         tensor->set_device_address(device_address);
         MS_EXCEPTION_IF_NULL(device_address);
@@ -519,6 +540,8 @@ void SessionBasic::LoadInputData(const std::shared_ptr<KernelGraph> &kernel_grap
     }
     tensor->set_dirty(false);
   }
+  // the inputs are loaded, so the outputs of the last run can go to host before this run writes them
+  kernel_graph->ReleaseLazyOutputs();
 }
 
 void SessionBasic::UpdateOutputs(const std::shared_ptr<KernelGraph> &kernel_graph, VectorRef *const outputs,
@@ -530,10 +553,10 @@ void SessionBasic::UpdateOutputs(const std::shared_ptr<KernelGraph> &kernel_grap
     MS_LOG(INFO) << "update output[" << item->DebugString() << "]";
     MS_EXCEPTION_IF_NULL(item);
     if (AnfAlgo::IsTupleOutput(item) && AnfAlgo::IsRealKernel(item)) {
-      outputs->emplace_back(CreatTupleForOutput(item, *kernel_graph, input_tensors));
+      outputs->emplace_back(CreatTupleForOutput(item, kernel_graph.get(), input_tensors));
       continue;
     }
-    outputs->emplace_back(CreatTensorForOutput(item, *kernel_graph, input_tensors));
+    outputs->emplace_back(CreatTensorForOutput(item, kernel_graph.get(), input_tensors));
   }
 }
 
@@ -719,6 +742,58 @@ std::shared_ptr<KernelGraph> SessionBasic::ConstructSingleOpGraph(const OpRunInf
   return graph;
 }
 
+size_t SessionBasic::LoopSinkSteps(const KernelGraph &kernel_graph) const {
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  auto iter_num = ConfigManager::GetInstance().iter_num();
+  if (!context_ptr->loop_sink_flag() || iter_num <= 1) {
+    return 1;
+  }
+  auto &kernels = kernel_graph.execution_order();
+  bool has_get_next = std::any_of(kernels.begin(), kernels.end(), [](const CNodePtr &kernel) {
+    return AnfAlgo::GetCNodeName(kernel) == kGetNextOpName;
+  });
+  return has_get_next ? LongToSize(iter_num) : 1;
+}
+
+void SessionBasic::CacheRunOpGraph(const GraphInfo &graph_info, const std::shared_ptr<KernelGraph> &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto iter = run_op_graphs_.find(graph_info);
+  if (iter != run_op_graphs_.end()) {
+    run_op_graph_lru_.erase(iter->second.second);
+    (void)run_op_graphs_.erase(iter);
+  }
+  run_op_graph_lru_.push_front(graph_info);
+  run_op_graphs_[graph_info] = {graph, run_op_graph_lru_.begin()};
+  while (run_op_graph_lru_.size() > kMaxRunOpGraphNum) {
+    MS_LOG(INFO) << "Evict the single op graph [" << run_op_graph_lru_.back() << "]";
+    (void)run_op_graphs_.erase(run_op_graph_lru_.back());
+    run_op_graph_lru_.pop_back();
+  }
+}
+
+std::shared_ptr<KernelGraph> SessionBasic::GetRunOpGraph(const GraphInfo &graph_info) {
+  auto iter = run_op_graphs_.find(graph_info);
+  if (iter == run_op_graphs_.end()) {
+    MS_LOG(EXCEPTION) << "The single op graph [" << graph_info << "] is not built";
+  }
+  run_op_graph_lru_.splice(run_op_graph_lru_.begin(), run_op_graph_lru_, iter->second.second);
+  return iter->second.first;
+}
+
+void SessionBasic::ResetRunOpGraphOutputs(const KernelGraph *graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      if (AnfAlgo::OutputAddrExist(kernel, i)) {
+        AnfAlgo::SetOutputAddr(nullptr, i, kernel.get());
+      }
+    }
+  }
+}
+
 BaseRef SessionBasic::TransformBaseRefListToTuple(const BaseRef &base_ref) {
   if (utils::isa<VectorRef>(base_ref)) {
     auto ref_list = utils::cast<VectorRef>(base_ref);
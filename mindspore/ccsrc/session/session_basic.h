@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_SESSION_SESSION_BASIC_H
 
 #include <vector>
+#include <list>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -65,6 +66,14 @@ class SessionBasic {
 
   virtual py::tuple RunOp(const OpRunInfo &, const GraphInfo &) { return py::tuple(); }
 
+  // Whether the device has a kernel for the op of the node, the backend places the ops without one on the CPU.
+  virtual bool HasKernel(const CNodePtr &) const { return true; }
+
+  // the graph of the single op is built before, it's kept by the session until evicted by the newer ones
+  bool IsOpGraphBuilt(const GraphInfo &graph_info) const {
+    return run_op_graphs_.find(graph_info) != run_op_graphs_.end();
+  }
+
   virtual void RegisterSummaryCallBackFunc(const CallBackFunc &callback);
 
   std::shared_ptr<KernelGraph> ConstructKernelGraph(const AnfNodePtrList &lst, const AnfNodePtrList &outputs);
@@ -101,9 +110,20 @@ class SessionBasic {
                    std::vector<bool> *tensor_mask);
   // trans BaseRef list to py::tuple
   BaseRef TransformBaseRefListToTuple(const BaseRef &base_ref);
+  // The steps run by one run of the graph with the loop sink, the graph fetches the data of each step by its GetNext
+  // from the device queue, so they don't return to the host. The sessions without the task sink run them in turn.
+  size_t LoopSinkSteps(const KernelGraph &kernel_graph) const;
+  // the built graphs of the single ops are cached by the least recently used, up to kMaxRunOpGraphNum
+  void CacheRunOpGraph(const GraphInfo &graph_info, const std::shared_ptr<KernelGraph> &graph);
+  std::shared_ptr<KernelGraph> GetRunOpGraph(const GraphInfo &graph_info);
+  // the outputs of the last run are held by the returned tensors, the cached graph gets new ones
+  void ResetRunOpGraphOutputs(const KernelGraph *graph) const;
 
   std::unordered_map<GraphId, std::shared_ptr<KernelGraph>> graphs_;
-  std::unordered_map<GraphInfo, std::shared_ptr<KernelGraph>> run_op_graphs_;
+  std::unordered_map<GraphInfo, std::pair<std::shared_ptr<KernelGraph>, std::list<GraphInfo>::iterator>>
+    run_op_graphs_;
+  // the graph infos of the cached single op graphs, the most recently used first
+  std::list<GraphInfo> run_op_graph_lru_;
   std::shared_ptr<Context> context_;
   CallBackFunc summary_callback_;
   static GraphId graph_sum_;
@@ -141,7 +141,11 @@ Status GraphRunner::RunGraph(const RunOptions& options, const std::vector<GeTens
     return Status::FAILED;
   }
 #else
-  ge_outputs.swap(ge_inputs);
+  // the outputs are new tensors like those of GE, the inputs are bound to the runner
+  (void)std::transform(ge_inputs.begin(), ge_inputs.end(), std::back_inserter(ge_outputs),
+                       [](const GeTensor& ge_tensor) {
+                         return GeTensor(ge_tensor.GetTensorDesc(), ge_tensor.GetData(), ge_tensor.GetSize());
+                       });
 #endif
 
   (void)gettimeofday(&end_time, nullptr);
@@ -156,23 +160,46 @@ Status GraphRunner::RunGraph(const RunOptions& options, const std::vector<GeTens
   return Status::SUCCESS;
 }
 
+// The GE tensors of the inputs of a graph are kept and refilled at each step, only an input whose shape or data type
+// changes gets a new one. The runs do not share them, the caller holds the lock of the bindings.
+bool GraphRunner::BindInputs(const std::string& name, const std::vector<MeTensorPtr>& inputs,
+                             std::vector<GeTensorPtr>* const ge_inputs) {
+  MS_EXCEPTION_IF_NULL(ge_inputs);
+  auto& bindings = input_bindings_[name];
+  bindings.resize(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(inputs[i]);
+    auto& binding = bindings[i];
+    auto data_size = static_cast<size_t>(inputs[i]->data().nbytes());
+    bool reusable = binding != nullptr && binding->GetSize() == data_size &&
+                    binding->GetTensorDesc().GetDataType() == TransformUtil::ConvertDataType(inputs[i]->data_type()) &&
+                    binding->GetTensorDesc().GetShape().GetDims() ==
+                      TransformUtil::ConvertMeShape(inputs[i]->shape()).GetDims();
+    if (!reusable || binding->SetData(static_cast<uint8_t*>(inputs[i]->data_c()), data_size) != ge::GRAPH_SUCCESS) {
+      MS_LOG(INFO) << "Bind the input " << i << " of the graph " << name << " with shape "
+                   << TransformUtil::PrintVector(inputs[i]->shape());
+      binding = TransformUtil::ConvertTensor(inputs[i], kOpFormat_NCHW);
+    }
+    if (binding == nullptr) {
+      (void)input_bindings_.erase(name);
+      ge_inputs->clear();
+      return false;
+    }
+    ge_inputs->emplace_back(binding);
+  }
+  return true;
+}
+
 Status GraphRunner::RunGraph(const RunOptions& options, const std::vector<MeTensorPtr>& inputs,
                              std::vector<MeTensorPtr>* const outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  // a run on another thread holding the bindings is not waited for, the inputs of this one are converted afresh
+  std::unique_lock<std::mutex> lock(bindings_mutex_, std::try_to_lock);
   std::vector<GeTensorPtr> ge_inputs;
-  for (auto it : inputs) {
-    MS_LOG(INFO) << "inputs tensor's data size is: " << (*it).DataSize();
-    auto shape = (*it).shape();
-    std::string shape_str;
-    for (const auto& elem : shape) {
-      shape_str += std::to_string(elem);
-      shape_str += " ";
-    }
-    MS_LOG(INFO) << "inputs tensor's shape is: { " << shape_str << "}";
-
-    auto ge_tensor_ptr = TransformUtil::ConvertTensor(it, kOpFormat_NCHW);
-    if (ge_tensor_ptr != nullptr) {
-      ge_inputs.emplace_back(ge_tensor_ptr);
-    } else {
+  bool bound = lock.owns_lock() && !options.name.empty() && BindInputs(options.name, inputs, &ge_inputs);
+  if (!bound) {
+    ge_inputs = TransformUtil::ConvertInputTensors(inputs, kOpFormat_NCHW);
+    if (ge_inputs.size() != inputs.size()) {
       MS_LOG(INFO) << "Convert input Me tensor to Ge tensor failed. Abort this graph";
       return Status::FAILED;
     }
@@ -185,12 +212,15 @@ Status GraphRunner::RunGraph(const RunOptions& options, const std::vector<MeTens
     py::gil_scoped_release release;
     ret = RunGraph(options, ge_inputs, &ge_outputs);
   }
+  if (lock.owns_lock()) {
+    lock.unlock();
+  }
   if (ret != Status::SUCCESS) {
     return ret;
   } else {
-    // conver GeTensor to MeTensor
+    // the Me tensors share the data of the GeTensors
     for (auto& it : ge_outputs) {
-      auto tensor = TransformUtil::ConvertGeTensor(it);
+      auto tensor = TransformUtil::BorrowGeTensor(it);
       if (tensor != nullptr) {
         outputs->emplace_back(tensor);
       }
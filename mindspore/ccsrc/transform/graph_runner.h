@@ -22,6 +22,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "transform/types.h"
 #include "transform/util.h"
@@ -53,9 +54,15 @@ class GraphRunner {
   static std::shared_ptr<ge::Session> NewSession(const SessionOptions& sess_options);
 
  private:
+  bool BindInputs(const std::string& name, const std::vector<MeTensorPtr>& inputs,
+                  std::vector<GeTensorPtr>* ge_inputs);
+
   std::shared_ptr<ge::Session> sess_;
   transform::GraphRunnerOptions options_;
   DfGraphManager& graph_manager_;
+  // the GE tensors of the inputs of the graphs by their names, refilled by each run
+  std::mutex bindings_mutex_;
+  std::map<std::string, std::vector<GeTensorPtr>> input_bindings_;
 };
 }  // namespace transform
 }  // namespace mindspore
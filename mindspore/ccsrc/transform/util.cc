@@ -384,6 +384,40 @@ MeTensorPtr TransformUtil::ConvertGeTensor(const GeTensorPtr& ge_tensor) {
   return GenerateMeTensor(ge_tensor, me_dims, type_id);
 }
 
+namespace {
+// the buffer format of the numpy array of a data type, which Tensor::GetDataType reads back
+std::string NumpyFormat(const MeDataType& type) {
+  static const std::map<MeDataType, std::string> formats = {
+    {MeDataType::kNumberTypeBool, "?"},    {MeDataType::kNumberTypeInt8, "b"},
+    {MeDataType::kNumberTypeInt16, "h"},   {MeDataType::kNumberTypeInt32, "i"},
+    {MeDataType::kNumberTypeInt64, "q"},   {MeDataType::kNumberTypeUInt8, "B"},
+    {MeDataType::kNumberTypeUInt16, "H"},  {MeDataType::kNumberTypeUInt32, "I"},
+    {MeDataType::kNumberTypeUInt64, "Q"},  {MeDataType::kNumberTypeFloat16, "e"},
+    {MeDataType::kNumberTypeFloat32, "f"}, {MeDataType::kNumberTypeFloat64, "d"}};
+  auto iter = formats.find(type);
+  return iter == formats.end() ? "" : iter->second;
+}
+}  // namespace
+
+MeTensorPtr TransformUtil::BorrowGeTensor(const GeTensorPtr& ge_tensor) {
+  MS_EXCEPTION_IF_NULL(ge_tensor);
+  GeTensorDesc desc = ge_tensor->GetTensorDesc();
+  TypeId type_id = ConvertGeDataType(desc.GetDataType());
+  std::string format = NumpyFormat(type_id);
+  vector<int> me_dims = ConvertGeShape(desc.GetShape());
+  size_t data_size = GetDataTypeSize(type_id);
+  for (auto dim : me_dims) {
+    data_size *= IntToSize(dim);
+  }
+  if (format.empty() || ge_tensor->GetData() == nullptr || ge_tensor->GetSize() != data_size) {
+    return ConvertGeTensor(ge_tensor);
+  }
+  // the array holds the GE tensor through its base object, so the data lives as long as the ME tensor
+  py::capsule base(new GeTensorPtr(ge_tensor), [](void* ptr) { delete static_cast<GeTensorPtr*>(ptr); });
+  py::array data(py::dtype(format), me_dims, ge_tensor->GetData(), base);
+  return make_shared<MeTensor>(data);
+}
+
 // if request_dims is empty, use ge tensor's shape,otherwise convert to request shape
 MeTensorPtr TransformUtil::ConvertGeTensor(const GeTensorPtr ge_tensor, const std::vector<int>& request_dims) {
   MS_EXCEPTION_IF_NULL(ge_tensor);
@@ -104,6 +104,14 @@ class TransformUtil {
    * */
   static MeTensorPtr ConvertGeTensor(const GeTensorPtr& tensor);
 
+  /*
+   * Parameters:
+   *     tensor: [GeTensor] the data tensor in GE
+   * Return：
+   *     [MeTensor] the data tensor in ME, which shares the data of the GE tensor and keeps it alive
+   * */
+  static MeTensorPtr BorrowGeTensor(const GeTensorPtr& tensor);
+
   /*
    * Parameters:
    *     tensor: [GeTensor] the data tensor in GE
@@ -21,6 +21,8 @@
 #include "./common.h"
 #include "utils/convert_utils.h"
 #include "utils/tensorprint_utils.h"
+#include "utils/timeline.h"
+#include "utils/step_stats.h"
 #ifndef NO_DLIB
 #include "tdt/tsd_client.h"
 #include "tdt/tdt_host_interface.h"
@@ -48,8 +50,12 @@ MsContext::MsContext(const std::string& policy, const std::string& target) {
   save_graphs_path_ = ".";
   save_ms_model_flag_ = false;
   save_ms_model_path_ = "./model.ms";
+  save_ms_model_fp16_flag_ = false;
   enable_dump_ = false;
   save_dump_path_ = ".";
+  enable_timeline_ = false;
+  save_timeline_path_ = "./timeline.json";
+  enable_step_stats_ = false;
   tsd_ref_ = 0;
   ge_ref_ = 0;
   is_multi_graph_sink_ = false;
@@ -69,6 +75,18 @@ MsContext::MsContext(const std::string& policy, const std::string& target) {
   enable_hccl_ = false;
   enable_loop_sink_ = false;
   enable_mem_reuse_ = true;
+  enable_recompute_ = false;
+  enable_mem_swap_ = false;
+  enable_cuda_graph_ = false;
+  enable_graph_kernel_ = false;
+  enable_graph_static_memory_ = false;
+  enable_gpu_multi_stream_ = false;
+  enable_branch_streams_ = false;
+  enable_pynative_async_ = false;
+  enable_shape_respecialize_ = false;
+  cpu_inter_op_threads_ = 1;
+  cpu_int8_calibration_steps_ = 0;
+  max_device_models_ = 0;
   enable_gpu_summary_ = true;
   precompile_only_ = false;
   auto_mixed_precision_flag_ = true;
@@ -135,6 +153,24 @@ bool MsContext::set_device_target(const std::string& target) {
   return true;
 }
 
+void MsContext::set_enable_timeline(bool flag) {
+  if (flag) {
+    Timeline::GetInstance().Start();
+  } else {
+    Timeline::GetInstance().Stop(save_timeline_path_);
+  }
+  enable_timeline_ = flag;
+}
+
+void MsContext::set_enable_step_stats(bool flag) {
+  if (flag) {
+    StepStats::GetInstance().Start();
+  } else {
+    StepStats::GetInstance().Stop();
+  }
+  enable_step_stats_ = flag;
+}
+
 bool MsContext::set_device_id(uint32_t device_id) {
   device_id_ = device_id;
   MS_LOG(INFO) << "ms set context device id:" << device_id;
@@ -98,12 +98,57 @@ class MsContext {
   void set_enable_mem_reuse(bool enable_mem_reuse) { enable_mem_reuse_ = enable_mem_reuse; }
   bool enable_mem_reuse() const { return enable_mem_reuse_; }
 
+  void set_enable_recompute(bool enable_recompute) { enable_recompute_ = enable_recompute; }
+  bool enable_recompute() const { return enable_recompute_; }
+
+  void set_enable_mem_swap(bool enable_mem_swap) { enable_mem_swap_ = enable_mem_swap; }
+  bool enable_mem_swap() const { return enable_mem_swap_; }
+
+  void set_enable_cuda_graph(bool enable_cuda_graph) { enable_cuda_graph_ = enable_cuda_graph; }
+  bool enable_cuda_graph() const { return enable_cuda_graph_; }
+
+  void set_enable_graph_kernel(bool enable_graph_kernel) { enable_graph_kernel_ = enable_graph_kernel; }
+  bool enable_graph_kernel() const { return enable_graph_kernel_; }
+
+  void set_enable_graph_static_memory(bool enable_graph_static_memory) {
+    enable_graph_static_memory_ = enable_graph_static_memory;
+  }
+  bool enable_graph_static_memory() const { return enable_graph_static_memory_; }
+
+  void set_enable_gpu_multi_stream(bool enable_gpu_multi_stream) { enable_gpu_multi_stream_ = enable_gpu_multi_stream; }
+  bool enable_gpu_multi_stream() const { return enable_gpu_multi_stream_; }
+
+  void set_enable_branch_streams(bool enable_branch_streams) { enable_branch_streams_ = enable_branch_streams; }
+  bool enable_branch_streams() const { return enable_branch_streams_; }
+
+  void set_enable_pynative_async(bool enable_pynative_async) { enable_pynative_async_ = enable_pynative_async; }
+  bool enable_pynative_async() const { return enable_pynative_async_; }
+
+  void set_enable_shape_respecialize(bool enable_shape_respecialize) {
+    enable_shape_respecialize_ = enable_shape_respecialize;
+  }
+  bool enable_shape_respecialize() const { return enable_shape_respecialize_; }
+
+  void set_cpu_inter_op_threads(uint32_t cpu_inter_op_threads) { cpu_inter_op_threads_ = cpu_inter_op_threads; }
+  uint32_t cpu_inter_op_threads() const { return cpu_inter_op_threads_; }
+
+  void set_cpu_int8_calibration_steps(uint32_t cpu_int8_calibration_steps) {
+    cpu_int8_calibration_steps_ = cpu_int8_calibration_steps;
+  }
+  uint32_t cpu_int8_calibration_steps() const { return cpu_int8_calibration_steps_; }
+
+  void set_max_device_models(uint32_t max_device_models) { max_device_models_ = max_device_models; }
+  uint32_t max_device_models() const { return max_device_models_; }
+
   bool save_ms_model_flag() const { return save_ms_model_flag_; }
   void set_save_ms_model_flag(bool save_ms_model_flag) { save_ms_model_flag_ = save_ms_model_flag; }
 
   std::string save_ms_model_path() const { return save_ms_model_path_; }
   void set_save_ms_model_path(const std::string& save_ms_model_path) { save_ms_model_path_ = save_ms_model_path; }
 
+  bool save_ms_model_fp16_flag() const { return save_ms_model_fp16_flag_; }
+  void set_save_ms_model_fp16_flag(bool save_ms_model_fp16_flag) { save_ms_model_fp16_flag_ = save_ms_model_fp16_flag; }
+
   void set_enable_gpu_summary(bool enable_gpu_summary) { enable_gpu_summary_ = enable_gpu_summary; }
   bool enable_gpu_summary() const { return enable_gpu_summary_; }
 
@@ -121,6 +166,17 @@ class MsContext {
   void set_save_dump_path(const std::string& path) { save_dump_path_ = path; }
   std::string save_dump_path() const { return save_dump_path_; }
 
+  // starting the timeline clears it, stopping it saves the spans recorded in between to the timeline path
+  void set_enable_timeline(bool flag);
+  bool enable_timeline() const { return enable_timeline_; }
+
+  void set_save_timeline_path(const std::string& path) { save_timeline_path_ = path; }
+  std::string save_timeline_path() const { return save_timeline_path_; }
+
+  // starting the step stats clears the steps recorded so far
+  void set_enable_step_stats(bool flag);
+  bool enable_step_stats() const { return enable_step_stats_; }
+
   bool IsTsdOpened() const { return tsd_ref_ > 0; }
 
   bool is_multi_graph_sink() const { return is_multi_graph_sink_; }
@@ -162,11 +218,27 @@ class MsContext {
   bool enable_reduce_precision_;
   bool enable_loop_sink_;
   bool enable_mem_reuse_;
+  bool enable_recompute_;
+  bool enable_mem_swap_;
+  bool enable_cuda_graph_;
+  bool enable_graph_kernel_;
+  bool enable_graph_static_memory_;
+  bool enable_gpu_multi_stream_;
+  bool enable_branch_streams_;
+  bool enable_pynative_async_;
+  bool enable_shape_respecialize_;
+  uint32_t cpu_inter_op_threads_;
+  uint32_t cpu_int8_calibration_steps_;
+  uint32_t max_device_models_;
   std::string save_ms_model_path_;
   bool save_ms_model_flag_;
+  bool save_ms_model_fp16_flag_;
   bool enable_gpu_summary_;
   bool enable_dump_;
   std::string save_dump_path_;
+  bool enable_timeline_;
+  std::string save_timeline_path_;
+  bool enable_step_stats_;
   bool is_multi_graph_sink_;
   bool is_pynative_ge_init_;
   bool enable_dynamic_mem_pool_;
@@ -0,0 +1,175 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/metrics.h"
+#include <chrono>
+#include <sstream>
+
+namespace mindspore {
+namespace {
+uint64_t NowUs() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+size_t BucketIndex(int64_t value) {
+  if (value <= 0) {
+    return 0;
+  }
+  // the number of bits of the value, which is the first bucket whose bound is greater than it
+  auto index = static_cast<size_t>(64 - __builtin_clzll(static_cast<uint64_t>(value)));
+  return index < kHistogramBucketNum ? index : kHistogramBucketNum - 1;
+}
+
+// the last bucket to expose, the empty ones after it are left out
+size_t LastBucket(const HistogramSnapshot& snapshot) {
+  size_t last = 0;
+  for (size_t i = 0; i < kHistogramBucketNum - 1; ++i) {
+    if (snapshot.buckets[i] != 0) {
+      last = i;
+    }
+  }
+  return last;
+}
+}  // namespace
+
+size_t MetricShardIndex() {
+  static std::atomic<size_t> thread_count{0};
+  thread_local size_t index = thread_count++ % kMetricShardNum;
+  return index;
+}
+
+int64_t Counter::Value() const {
+  int64_t value = 0;
+  for (auto& shard : shards_) {
+    value += shard.value.load(std::memory_order_relaxed);
+  }
+  return value;
+}
+
+void Histogram::Observe(int64_t value) {
+  auto& shard = shards_[MetricShardIndex()];
+  shard.buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  shard.count.fetch_add(1, std::memory_order_relaxed);
+  shard.sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+HistogramSnapshot Histogram::Snapshot() const {
+  HistogramSnapshot snapshot;
+  for (auto& shard : shards_) {
+    for (size_t i = 0; i < kHistogramBucketNum; ++i) {
+      snapshot.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count += shard.count.load(std::memory_order_relaxed);
+    snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+HistogramTimer::HistogramTimer(Histogram* histogram) : histogram_(histogram), start_us_(NowUs()) {}
+
+void HistogramTimer::Stop() {
+  if (histogram_ != nullptr) {
+    histogram_->Observe(static_cast<int64_t>(NowUs() - start_us_));
+    histogram_ = nullptr;
+  }
+}
+
+Counter* MetricsRegistry::GetCounter(const std::string& name, const std::string& help) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = counters_[name];
+  if (entry.metric == nullptr) {
+    entry.help = help;
+    entry.metric.reset(new Counter());
+  }
+  return entry.metric.get();
+}
+
+Gauge* MetricsRegistry::GetGauge(const std::string& name, const std::string& help) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = gauges_[name];
+  if (entry.metric == nullptr) {
+    entry.help = help;
+    entry.metric.reset(new Gauge());
+  }
+  return entry.metric.get();
+}
+
+Histogram* MetricsRegistry::GetHistogram(const std::string& name, const std::string& help) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = histograms_[name];
+  if (entry.metric == nullptr) {
+    entry.help = help;
+    entry.metric.reset(new Histogram());
+  }
+  return entry.metric.get();
+}
+
+std::map<std::string, int64_t> MetricsRegistry::Collect() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, int64_t> values;
+  for (auto& counter : counters_) {
+    values[counter.first] = counter.second.metric->Value();
+  }
+  for (auto& gauge : gauges_) {
+    values[gauge.first] = gauge.second.metric->Value();
+  }
+  for (auto& histogram : histograms_) {
+    auto snapshot = histogram.second.metric->Snapshot();
+    values[histogram.first + "_count"] = snapshot.count;
+    values[histogram.first + "_sum"] = snapshot.sum;
+    int64_t cumulative = 0;
+    auto last = LastBucket(snapshot);
+    for (size_t i = 0; i <= last; ++i) {
+      cumulative += snapshot.buckets[i];
+      values[histogram.first + "_bucket_lt_" + std::to_string(Histogram::BucketBound(i))] = cumulative;
+    }
+  }
+  return values;
+}
+
+std::string MetricsRegistry::PrometheusText() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream oss;
+  for (auto& counter : counters_) {
+    oss << "# HELP " << counter.first << " " << counter.second.help << "\n";
+    oss << "# TYPE " << counter.first << " counter\n";
+    oss << counter.first << " " << counter.second.metric->Value() << "\n";
+  }
+  for (auto& gauge : gauges_) {
+    oss << "# HELP " << gauge.first << " " << gauge.second.help << "\n";
+    oss << "# TYPE " << gauge.first << " gauge\n";
+    oss << gauge.first << " " << gauge.second.metric->Value() << "\n";
+  }
+  for (auto& histogram : histograms_) {
+    auto& name = histogram.first;
+    auto snapshot = histogram.second.metric->Snapshot();
+    oss << "# HELP " << name << " " << histogram.second.help << "\n";
+    oss << "# TYPE " << name << " histogram\n";
+    // the values are integers, so the bucket of the values less than 2^i is the one of le 2^i - 1
+    int64_t cumulative = 0;
+    auto last = LastBucket(snapshot);
+    for (size_t i = 0; i <= last; ++i) {
+      cumulative += snapshot.buckets[i];
+      oss << name << "_bucket{le=\"" << Histogram::BucketBound(i) - 1 << "\"} " << cumulative << "\n";
+    }
+    oss << name << "_bucket{le=\"+Inf\"} " << snapshot.count << "\n";
+    oss << name << "_sum " << snapshot.sum << "\n";
+    oss << name << "_count " << snapshot.count << "\n";
+  }
+  return oss.str();
+}
+}  // namespace mindspore
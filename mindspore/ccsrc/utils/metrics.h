@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_METRICS_H_
+#define MINDSPORE_CCSRC_UTILS_METRICS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace mindspore {
+// The number of shards of a metric, the threads update the shard of their own so they rarely share a cache line.
+constexpr size_t kMetricShardNum = 16;
+// The buckets of a histogram are the powers of 2, bucket i counts the values less than 2^i and the last one the rest.
+constexpr size_t kHistogramBucketNum = 40;
+
+// the shard of the calling thread
+size_t MetricShardIndex();
+
+class Counter {
+ public:
+  Counter() = default;
+  ~Counter() = default;
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+
+  void Add(int64_t delta = 1) { shards_[MetricShardIndex()].value.fetch_add(delta, std::memory_order_relaxed); }
+  int64_t Value() const;
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<int64_t> value{0};
+  };
+  std::array<Shard, kMetricShardNum> shards_;
+};
+
+class Gauge {
+ public:
+  Gauge() = default;
+  ~Gauge() = default;
+  Gauge(const Gauge&) = delete;
+  Gauge& operator=(const Gauge&) = delete;
+
+  void Set(int64_t value) { value_.store(value, std::memory_order_relaxed); }
+  int64_t Value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_{0};
+};
+
+struct HistogramSnapshot {
+  std::array<int64_t, kHistogramBucketNum> buckets{};
+  int64_t count = 0;
+  int64_t sum = 0;
+};
+
+class Histogram {
+ public:
+  Histogram() = default;
+  ~Histogram() = default;
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  void Observe(int64_t value);
+  HistogramSnapshot Snapshot() const;
+  // the exclusive upper bound of a bucket but the last one
+  static int64_t BucketBound(size_t bucket) { return static_cast<int64_t>(1) << bucket; }
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<int64_t>, kHistogramBucketNum> buckets{};
+    std::atomic<int64_t> count{0};
+    std::atomic<int64_t> sum{0};
+  };
+  std::array<Shard, kMetricShardNum> shards_;
+};
+
+// Observe the microseconds from the construction to the destruction, or to the stop if it is stopped earlier.
+class HistogramTimer {
+ public:
+  explicit HistogramTimer(Histogram* histogram);
+  HistogramTimer(const HistogramTimer&) = delete;
+  HistogramTimer& operator=(const HistogramTimer&) = delete;
+  ~HistogramTimer() { Stop(); }
+
+  void Stop();
+
+ private:
+  Histogram* histogram_;
+  uint64_t start_us_;
+};
+
+// The metrics published by the components, which look them up once and update them without a lock. The metrics
+// live as long as the process, so the pointers returned are never invalidated.
+class MetricsRegistry {
+ public:
+  ~MetricsRegistry() = default;
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+  static MetricsRegistry& GetInstance();
+
+  Counter* GetCounter(const std::string& name, const std::string& help);
+  Gauge* GetGauge(const std::string& name, const std::string& help);
+  Histogram* GetHistogram(const std::string& name, const std::string& help);
+
+  // the values of the counters and gauges, and the count, sum and non-empty buckets of the histograms
+  std::map<std::string, int64_t> Collect();
+  // the metrics in the text exposition format of Prometheus
+  std::string PrometheusText();
+
+ private:
+  MetricsRegistry() = default;
+  template <typename T>
+  struct Entry {
+    std::string help;
+    std::unique_ptr<T> metric;
+  };
+
+  std::mutex mutex_;
+  std::map<std::string, Entry<Counter>> counters_;
+  std::map<std::string, Entry<Gauge>> gauges_;
+  std::map<std::string, Entry<Histogram>> histograms_;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_METRICS_H_
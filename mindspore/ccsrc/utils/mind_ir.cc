@@ -0,0 +1,731 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/mind_ir.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "utils/mind_ir.pb.h"
+#include "ir/func_graph.h"
+#include "ir/meta_tensor.h"
+#include "ir/primitive.h"
+#include "pipeline/static_analysis/abstract_value.h"
+#include "pipeline/static_analysis/dshape.h"
+#include "session/kernel_graph.h"
+#include "session/anf_runtime_algorithm.h"
+#include "device/kernel_info.h"
+#include "utils/convert_utils.h"
+#include "utils/graph_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kMindIRHeaderSize = 16;
+constexpr size_t kMaxLoadThreadNum = 8;
+
+size_t AlignUp(size_t size) { return (size + kMindIRAlign - 1) / kMindIRAlign * kMindIRAlign; }
+
+// Run task(0) ... task(task_num - 1) by several threads, false if any of them fails.
+bool RunParallel(size_t task_num, const std::function<bool(size_t)>& task) {
+  size_t thread_num = std::min({static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u)),
+                                kMaxLoadThreadNum, task_num});
+  std::atomic<size_t> next_task(0);
+  std::atomic<bool> success(true);
+  auto worker = [&]() {
+    for (size_t i = next_task++; i < task_num && success; i = next_task++) {
+      try {
+        if (!task(i)) {
+          success = false;
+        }
+      } catch (const std::exception& e) {
+        MS_LOG(ERROR) << "Load the MindIR failed: " << e.what();
+        success = false;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return success;
+}
+
+bool SaveAbstract(const AbstractBasePtr& abs, mindir::AbstractProto* proto) {
+  if (abs->isa<abstract::AbstractNone>()) {
+    proto->set_kind(mindir::AbstractProto::NONE);
+  } else if (abs->isa<abstract::AbstractScalar>()) {
+    proto->set_kind(mindir::AbstractProto::SCALAR);
+    proto->set_type_id(abs->BuildType()->type_id());
+  } else if (abs->isa<abstract::AbstractTensor>()) {
+    auto tensor_abs = abs->cast<abstract::AbstractTensorPtr>();
+    auto shape = dyn_cast<abstract::Shape>(tensor_abs->BuildShape());
+    if (tensor_abs->element() == nullptr || shape == nullptr) {
+      return false;
+    }
+    proto->set_kind(mindir::AbstractProto::TENSOR);
+    proto->set_type_id(tensor_abs->element()->BuildType()->type_id());
+    for (auto dim : shape->shape()) {
+      proto->add_shape(dim);
+    }
+  } else if (abs->isa<abstract::AbstractTuple>() || abs->isa<abstract::AbstractList>()) {
+    proto->set_kind(abs->isa<abstract::AbstractTuple>() ? mindir::AbstractProto::TUPLE : mindir::AbstractProto::LIST);
+    for (auto& element : abs->cast<abstract::AbstractSequeuePtr>()->elements()) {
+      if (element == nullptr || !SaveAbstract(element, proto->add_elements())) {
+        return false;
+      }
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+AbstractBasePtr LoadAbstract(const mindir::AbstractProto& proto) {
+  switch (proto.kind()) {
+    case mindir::AbstractProto::NONE:
+      return std::make_shared<abstract::AbstractNone>();
+    case mindir::AbstractProto::SCALAR:
+      return std::make_shared<abstract::AbstractScalar>(kAnyValue, TypeIdToType(TypeId(proto.type_id())));
+    case mindir::AbstractProto::TENSOR: {
+      auto element = std::make_shared<abstract::AbstractScalar>(kAnyValue, TypeIdToType(TypeId(proto.type_id())));
+      std::vector<int> shape(proto.shape().begin(), proto.shape().end());
+      return std::make_shared<abstract::AbstractTensor>(element, std::make_shared<abstract::Shape>(shape));
+    }
+    default:
+      break;
+  }
+  AbstractBasePtrList elements;
+  for (auto& element : proto.elements()) {
+    elements.push_back(LoadAbstract(element));
+  }
+  if (proto.kind() == mindir::AbstractProto::TUPLE) {
+    return std::make_shared<abstract::AbstractTuple>(elements);
+  }
+  return std::make_shared<abstract::AbstractList>(elements);
+}
+
+void SaveKernelBuildInfo(const kernel::KernelBuildInfo& build_info, mindir::KernelBuildInfoProto* proto) {
+  for (auto& format : build_info.GetAllInputFormats()) {
+    proto->add_input_formats(format);
+  }
+  for (auto& format : build_info.GetAllOutputFormats()) {
+    proto->add_output_formats(format);
+  }
+  for (auto type : build_info.GetAllInputDeviceTypes()) {
+    proto->add_input_device_types(type);
+  }
+  for (auto type : build_info.GetAllOutputDeviceTypes()) {
+    proto->add_output_device_types(type);
+  }
+  proto->set_kernel_type(build_info.kernel_type());
+  proto->set_fusion_type(build_info.fusion_type());
+  proto->set_processor(build_info.processor());
+}
+
+kernel::KernelBuildInfoPtr LoadKernelBuildInfo(const mindir::KernelBuildInfoProto& proto) {
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+  builder.SetInputsFormat(std::vector<std::string>(proto.input_formats().begin(), proto.input_formats().end()));
+  builder.SetOutputsFormat(std::vector<std::string>(proto.output_formats().begin(), proto.output_formats().end()));
+  std::vector<TypeId> input_types;
+  (void)std::transform(proto.input_device_types().begin(), proto.input_device_types().end(),
+                       std::back_inserter(input_types), [](int32_t type) { return TypeId(type); });
+  builder.SetInputsDeviceType(input_types);
+  std::vector<TypeId> output_types;
+  (void)std::transform(proto.output_device_types().begin(), proto.output_device_types().end(),
+                       std::back_inserter(output_types), [](int32_t type) { return TypeId(type); });
+  builder.SetOutputsDeviceType(output_types);
+  builder.SetKernelType(kernel::KernelType(proto.kernel_type()));
+  builder.SetFusionType(kernel::FusionType(proto.fusion_type()));
+  builder.SetProcessor(kernel::Processor(proto.processor()));
+  return builder.Build();
+}
+
+class MindIRSaver {
+ public:
+  MindIRSaver() = default;
+  ~MindIRSaver() = default;
+
+  bool Save(const std::string& file_name, const std::vector<FuncGraphPtr>& graphs);
+
+ private:
+  void AddGraph(const FuncGraphPtr& graph);
+  void CollectNode(const AnfNodePtr& node, size_t graph_index);
+  void CollectNodes();
+  bool SaveNode(const AnfNodePtr& node, mindir::NodeProto* proto);
+  bool SaveValue(const ValuePtr& value, mindir::ValueProto* proto);
+  void SaveGraph(size_t graph_index, int64_t node_begin, mindir::GraphProto* proto);
+  bool WriteFile(const std::string& file_name);
+
+  mindir::ModelProto model_;
+  std::vector<FuncGraphPtr> graphs_;
+  std::unordered_map<FuncGraphPtr, int64_t> graph_indexes_;
+  std::vector<std::vector<AnfNodePtr>> graph_nodes_;
+  std::unordered_set<AnfNodePtr> collected_;
+  std::unordered_map<AnfNodePtr, int64_t> node_ids_;
+  std::vector<tensor::TensorPtr> tensors_;
+  std::unordered_map<tensor::TensorPtr, int64_t> tensor_indexes_;
+};
+
+void MindIRSaver::AddGraph(const FuncGraphPtr& graph) {
+  if (graph_indexes_.find(graph) != graph_indexes_.end()) {
+    return;
+  }
+  graph_indexes_[graph] = SizeToLong(graphs_.size());
+  graphs_.push_back(graph);
+  graph_nodes_.emplace_back();
+}
+
+void MindIRSaver::CollectNode(const AnfNodePtr& node, size_t graph_index) {
+  if (!collected_.insert(node).second) {
+    return;
+  }
+  // a node belongs to the graph owning it, the value nodes and the nodes of no graph to the first graph using them
+  auto owner = node->func_graph();
+  if (owner != nullptr && !node->isa<ValueNode>()) {
+    AddGraph(owner);
+    graph_index = LongToSize(graph_indexes_[owner]);
+  }
+  graph_nodes_[graph_index].push_back(node);
+  if (IsValueNode<FuncGraph>(node)) {
+    AddGraph(GetValueNode<FuncGraphPtr>(node));
+  }
+}
+
+void MindIRSaver::CollectNodes() {
+  // the graphs called are added to graphs_ while they are walked
+  for (size_t i = 0; i < graphs_.size(); ++i) {
+    auto graph = graphs_[i];
+    for (auto& param : graph->parameters()) {
+      CollectNode(param, i);
+    }
+    auto kernel_graph = graph->cast<std::shared_ptr<session::KernelGraph>>();
+    if (kernel_graph != nullptr) {
+      for (auto& input : kernel_graph->inputs()) {
+        CollectNode(input, i);
+      }
+    }
+    if (graph->get_return() != nullptr) {
+      for (auto& node : TopoSort(graph->get_return())) {
+        CollectNode(node, i);
+      }
+    }
+    if (kernel_graph != nullptr) {
+      for (auto& value_node : kernel_graph->graph_value_nodes()) {
+        CollectNode(value_node, i);
+      }
+    }
+  }
+}
+
+bool MindIRSaver::SaveValue(const ValuePtr& value, mindir::ValueProto* proto) {
+  MS_EXCEPTION_IF_NULL(value);
+  if (value->isa<tensor::Tensor>()) {
+    auto tensor = value->cast<tensor::TensorPtr>();
+    auto iter = tensor_indexes_.find(tensor);
+    if (iter == tensor_indexes_.end()) {
+      iter = tensor_indexes_.emplace(tensor, SizeToLong(tensors_.size())).first;
+      tensors_.push_back(tensor);
+    }
+    proto->set_kind(mindir::ValueProto::TENSOR);
+    proto->set_index(iter->second);
+  } else if (value->isa<FuncGraph>()) {
+    // only the graphs of the value nodes are walked, not those nested in the other values
+    auto iter = graph_indexes_.find(value->cast<FuncGraphPtr>());
+    if (iter == graph_indexes_.end()) {
+      MS_LOG(ERROR) << "The graph " << value->ToString() << " is not saved.";
+      return false;
+    }
+    proto->set_kind(mindir::ValueProto::FUNC_GRAPH);
+    proto->set_index(iter->second);
+  } else if (value->isa<Primitive>()) {
+    auto prim = value->cast<PrimitivePtr>();
+    proto->set_kind(mindir::ValueProto::PRIMITIVE);
+    proto->set_str_value(prim->name());
+    for (auto& attr : prim->attrs()) {
+      auto attr_proto = proto->add_attrs();
+      attr_proto->set_name(attr.first);
+      if (attr.second == nullptr || !SaveValue(attr.second, attr_proto->mutable_value())) {
+        MS_LOG(ERROR) << "The attr " << attr.first << " of " << prim->name() << " can not be saved.";
+        return false;
+      }
+    }
+  } else if (value->isa<None>()) {
+    proto->set_kind(mindir::ValueProto::NONE);
+  } else if (value->isa<BoolImm>()) {
+    proto->set_kind(mindir::ValueProto::BOOL);
+    proto->set_bool_value(GetValue<bool>(value));
+  } else if (value->isa<Int32Imm>() || value->isa<Int64Imm>()) {
+    proto->set_kind(mindir::ValueProto::INT);
+    proto->set_type_id(value->type()->type_id());
+    proto->set_int_value(value->isa<Int32Imm>() ? GetValue<int>(value) : GetValue<int64_t>(value));
+  } else if (value->isa<FP32Imm>() || value->isa<FP64Imm>()) {
+    proto->set_kind(mindir::ValueProto::FLOAT);
+    proto->set_type_id(value->type()->type_id());
+    proto->set_float_value(value->isa<FP32Imm>() ? GetValue<float>(value) : GetValue<double>(value));
+  } else if (value->isa<StringImm>()) {
+    proto->set_kind(mindir::ValueProto::STRING);
+    proto->set_str_value(GetValue<std::string>(value));
+  } else if (value->isa<TensorType>()) {
+    auto element = value->cast<TensorTypePtr>()->element();
+    proto->set_kind(mindir::ValueProto::TYPE);
+    proto->set_is_tensor_type(true);
+    proto->set_type_id(element == nullptr ? kTypeUnknown : element->type_id());
+  } else if (value->isa<Type>()) {
+    proto->set_kind(mindir::ValueProto::TYPE);
+    proto->set_type_id(value->cast<TypePtr>()->type_id());
+  } else if (value->isa<ValueTuple>() || value->isa<ValueList>()) {
+    proto->set_kind(value->isa<ValueTuple>() ? mindir::ValueProto::TUPLE : mindir::ValueProto::LIST);
+    for (auto& element : value->cast<ValueSequeuePtr>()->value()) {
+      if (!SaveValue(element, proto->add_elements())) {
+        return false;
+      }
+    }
+  } else {
+    MS_LOG(ERROR) << "The value " << value->ToString() << " can not be saved in MindIR.";
+    return false;
+  }
+  return true;
+}
+
+bool MindIRSaver::SaveNode(const AnfNodePtr& node, mindir::NodeProto* proto) {
+  if (node->isa<Parameter>()) {
+    proto->set_kind(mindir::NodeProto::PARAMETER);
+    proto->set_name(node->cast<ParameterPtr>()->name());
+  } else if (node->isa<ValueNode>()) {
+    proto->set_kind(mindir::NodeProto::VALUE);
+    if (!SaveValue(node->cast<ValueNodePtr>()->value(), proto->mutable_value())) {
+      return false;
+    }
+  } else if (node->isa<CNode>()) {
+    proto->set_kind(mindir::NodeProto::CNODE);
+    for (auto& input : node->cast<CNodePtr>()->inputs()) {
+      auto iter = node_ids_.find(input);
+      if (iter == node_ids_.end()) {
+        MS_LOG(ERROR) << "The input " << input->DebugString() << " of " << node->DebugString() << " is not saved.";
+        return false;
+      }
+      proto->add_inputs(iter->second);
+    }
+  } else {
+    MS_LOG(ERROR) << "The node " << node->DebugString() << " can not be saved in MindIR.";
+    return false;
+  }
+  if (node->scope() != nullptr) {
+    proto->set_scope(node->scope()->name());
+  }
+  // the nodes of an abstract not kept, such as a function, get it by the inference again
+  if (node->abstract() != nullptr && !SaveAbstract(node->abstract(), proto->mutable_abstract())) {
+    proto->clear_abstract();
+  }
+  auto kernel_info = node->kernel_info();
+  if (kernel_info != nullptr && kernel_info->select_kernel_build_info() != nullptr) {
+    SaveKernelBuildInfo(*kernel_info->select_kernel_build_info(), proto->mutable_kernel_build_info());
+  }
+  return true;
+}
+
+void MindIRSaver::SaveGraph(size_t graph_index, int64_t node_begin, mindir::GraphProto* proto) {
+  auto graph = graphs_[graph_index];
+  proto->set_name(graph->debug_info()->name());
+  for (auto& flag : graph->flags()) {
+    auto flag_proto = proto->add_flags();
+    flag_proto->set_name(flag.first);
+    flag_proto->set_value(flag.second);
+  }
+  proto->set_node_begin(node_begin);
+  proto->set_node_num(SizeToLong(graph_nodes_[graph_index].size()));
+  for (auto& param : graph->parameters()) {
+    proto->add_parameters(node_ids_.at(param));
+  }
+  if (graph->get_return() != nullptr) {
+    proto->set_return_node(node_ids_.at(graph->get_return()));
+  }
+  auto kernel_graph = graph->cast<std::shared_ptr<session::KernelGraph>>();
+  if (kernel_graph == nullptr) {
+    return;
+  }
+  proto->set_kernel_graph(true);
+  proto->set_graph_id(kernel_graph->graph_id());
+  for (auto& cnode : kernel_graph->execution_order()) {
+    proto->add_execution_order(node_ids_.at(cnode));
+  }
+  for (auto& input : kernel_graph->inputs()) {
+    proto->add_graph_inputs(node_ids_.at(input));
+  }
+  for (auto& value_node : kernel_graph->graph_value_nodes()) {
+    proto->add_value_nodes(node_ids_.at(value_node));
+  }
+}
+
+bool MindIRSaver::WriteFile(const std::string& file_name) {
+  std::string model;
+  if (!model_.SerializeToString(&model)) {
+    MS_LOG(ERROR) << "Serialize the MindIR model failed.";
+    return false;
+  }
+  std::ofstream ofs(file_name, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open the file " << file_name << " failed.";
+    return false;
+  }
+  uint64_t model_size = model.size();
+  (void)ofs.write(kMindIRMagic, kMindIRHeaderSize - sizeof(model_size));
+  (void)ofs.write(reinterpret_cast<const char*>(&model_size), sizeof(model_size));
+  (void)ofs.write(model.data(), static_cast<std::streamsize>(model.size()));
+  size_t pos = kMindIRHeaderSize + model.size();
+  size_t data_begin = AlignUp(pos);
+  const std::string padding(kMindIRAlign, '\0');
+  for (int i = 0; i < model_.tensors_size(); ++i) {
+    auto offset = data_begin + model_.tensors(i).offset();
+    (void)ofs.write(padding.data(), static_cast<std::streamsize>(offset - pos));
+    (void)ofs.write(static_cast<const char*>(tensors_[IntToSize(i)]->data_c()),
+                    static_cast<std::streamsize>(model_.tensors(i).size()));
+    pos = offset + model_.tensors(i).size();
+  }
+  ofs.close();
+  if (!ofs.good()) {
+    MS_LOG(ERROR) << "Write the file " << file_name << " failed.";
+    return false;
+  }
+  return true;
+}
+
+bool MindIRSaver::Save(const std::string& file_name, const std::vector<FuncGraphPtr>& graphs) {
+  for (auto& graph : graphs) {
+    MS_EXCEPTION_IF_NULL(graph);
+    AddGraph(graph);
+  }
+  CollectNodes();
+  // the nodes of a graph take the ids next to each other, so the loader creates them by the graph
+  int64_t node_id = 0;
+  std::vector<int64_t> node_begins;
+  for (auto& nodes : graph_nodes_) {
+    node_begins.push_back(node_id);
+    for (auto& node : nodes) {
+      node_ids_[node] = node_id++;
+    }
+  }
+  model_.set_ir_version(kMindIRVersion);
+  for (auto& nodes : graph_nodes_) {
+    for (auto& node : nodes) {
+      if (!SaveNode(node, model_.add_nodes())) {
+        return false;
+      }
+    }
+  }
+  for (size_t i = 0; i < graphs_.size(); ++i) {
+    SaveGraph(i, node_begins[i], model_.add_graphs());
+  }
+  uint64_t offset = 0;
+  for (auto& tensor : tensors_) {
+    auto proto = model_.add_tensors();
+    for (auto dim : tensor->shape()) {
+      proto->add_dims(dim);
+    }
+    proto->set_data_type(tensor->data_type());
+    proto->set_offset(offset);
+    proto->set_size(tensor->data().nbytes());
+    offset = AlignUp(offset + proto->size());
+  }
+  return WriteFile(file_name);
+}
+
+class MindIRLoader {
+ public:
+  MindIRLoader() = default;
+  ~MindIRLoader() {
+    if (fd_ >= 0) {
+      (void)close(fd_);
+    }
+  }
+
+  std::vector<FuncGraphPtr> Load(const std::string& file_name);
+
+ private:
+  bool ReadModel(const std::string& file_name);
+  bool LoadTensors();
+  ValuePtr LoadValue(const mindir::ValueProto& proto);
+  bool CreateNodes();
+  bool LinkNode(size_t node_id);
+  void SetGraphs();
+
+  int fd_ = -1;
+  uint64_t data_begin_ = 0;
+  mindir::ModelProto model_;
+  std::vector<FuncGraphPtr> graphs_;
+  std::vector<size_t> node_graphs_;
+  std::vector<AnfNodePtr> nodes_;
+  std::vector<tensor::TensorPtr> tensors_;
+};
+
+bool MindIRLoader::ReadModel(const std::string& file_name) {
+  fd_ = open(file_name.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    MS_LOG(ERROR) << "Open the file " << file_name << " failed.";
+    return false;
+  }
+  char header[kMindIRHeaderSize];
+  uint64_t model_size = 0;
+  if (pread(fd_, header, kMindIRHeaderSize, 0) != static_cast<ssize_t>(kMindIRHeaderSize) ||
+      memcmp(header, kMindIRMagic, kMindIRHeaderSize - sizeof(model_size)) != 0) {
+    MS_LOG(ERROR) << "The file " << file_name << " is not a MindIR.";
+    return false;
+  }
+  (void)memcpy(&model_size, header + kMindIRHeaderSize - sizeof(model_size), sizeof(model_size));
+  std::string model(model_size, '\0');
+  if (pread(fd_, &model[0], model_size, kMindIRHeaderSize) != static_cast<ssize_t>(model_size) ||
+      !model_.ParseFromString(model)) {
+    MS_LOG(ERROR) << "Parse the MindIR " << file_name << " failed.";
+    return false;
+  }
+  if (model_.ir_version() != kMindIRVersion) {
+    MS_LOG(ERROR) << "The MindIR " << file_name << " is of version " << model_.ir_version() << ", not "
+                  << kMindIRVersion << ".";
+    return false;
+  }
+  data_begin_ = AlignUp(kMindIRHeaderSize + model_size);
+  return true;
+}
+
+bool MindIRLoader::LoadTensors() {
+  // the tensors are created by this thread, their data is read by several
+  std::vector<void*> buffers;
+  for (auto& proto : model_.tensors()) {
+    std::vector<int> shape(proto.dims().begin(), proto.dims().end());
+    auto tensor = std::make_shared<tensor::Tensor>(TypeId(proto.data_type()), shape);
+    if (tensor->data().nbytes() != static_cast<ssize_t>(proto.size())) {
+      MS_LOG(ERROR) << "The size of the tensor " << tensors_.size() << " is " << proto.size() << ", not "
+                    << tensor->data().nbytes() << ".";
+      return false;
+    }
+    buffers.push_back(tensor->data_c(true));
+    tensors_.push_back(tensor);
+  }
+  return RunParallel(buffers.size(), [this, &buffers](size_t i) {
+    auto& proto = model_.tensors(SizeToInt(i));
+    auto buffer = static_cast<char*>(buffers[i]);
+    uint64_t read_size = 0;
+    while (read_size < proto.size()) {
+      auto ret = pread(fd_, buffer + read_size, proto.size() - read_size, data_begin_ + proto.offset() + read_size);
+      if (ret <= 0) {
+        MS_LOG(ERROR) << "Read the tensor " << i << " failed.";
+        return false;
+      }
+      read_size += static_cast<uint64_t>(ret);
+    }
+    return true;
+  });
+}
+
+ValuePtr MindIRLoader::LoadValue(const mindir::ValueProto& proto) {
+  switch (proto.kind()) {
+    case mindir::ValueProto::NONE:
+      return kNone;
+    case mindir::ValueProto::BOOL:
+      return MakeValue(proto.bool_value());
+    case mindir::ValueProto::INT:
+      if (proto.type_id() == kNumberTypeInt64) {
+        return std::make_shared<Int64Imm>(proto.int_value());
+      }
+      return std::make_shared<Int32Imm>(static_cast<int>(proto.int_value()));
+    case mindir::ValueProto::FLOAT:
+      if (proto.type_id() == kNumberTypeFloat64) {
+        return std::make_shared<FP64Imm>(proto.float_value());
+      }
+      return std::make_shared<FP32Imm>(static_cast<float>(proto.float_value()));
+    case mindir::ValueProto::STRING:
+      return MakeValue(proto.str_value());
+    case mindir::ValueProto::TYPE:
+      if (proto.is_tensor_type()) {
+        return std::make_shared<TensorType>(TypeIdToType(TypeId(proto.type_id())));
+      }
+      return TypeIdToType(TypeId(proto.type_id()));
+    case mindir::ValueProto::TENSOR:
+      return tensors_.at(LongToSize(proto.index()));
+    case mindir::ValueProto::FUNC_GRAPH:
+      return graphs_.at(LongToSize(proto.index()));
+    case mindir::ValueProto::PRIMITIVE: {
+      auto prim = std::make_shared<Primitive>(proto.str_value());
+      for (auto& attr : proto.attrs()) {
+        prim->set_attr(attr.name(), LoadValue(attr.value()));
+      }
+      return prim;
+    }
+    default:
+      break;
+  }
+  std::vector<ValuePtr> elements;
+  for (auto& element : proto.elements()) {
+    elements.push_back(LoadValue(element));
+  }
+  if (proto.kind() == mindir::ValueProto::TUPLE) {
+    return std::make_shared<ValueTuple>(elements);
+  }
+  return std::make_shared<ValueList>(elements);
+}
+
+bool MindIRLoader::CreateNodes() {
+  // the nodes are created by this thread, as the debug infos of them take the ids from a counter not locked
+  nodes_.resize(IntToSize(model_.nodes_size()));
+  node_graphs_.resize(nodes_.size());
+  for (size_t graph_index = 0; graph_index < graphs_.size(); ++graph_index) {
+    auto& graph_proto = model_.graphs(SizeToInt(graph_index));
+    auto end = graph_proto.node_begin() + graph_proto.node_num();
+    if (graph_proto.node_begin() < 0 || end > model_.nodes_size()) {
+      MS_LOG(ERROR) << "The nodes of the graph " << graph_proto.name() << " are out of the model.";
+      return false;
+    }
+    auto graph = graphs_[graph_index];
+    for (auto id = graph_proto.node_begin(); id < end; ++id) {
+      auto& proto = model_.nodes(static_cast<int>(id));
+      AnfNodePtr node = nullptr;
+      if (proto.kind() == mindir::NodeProto::PARAMETER) {
+        auto param = std::make_shared<Parameter>(graph);
+        param->set_name(proto.name());
+        node = param;
+      } else if (proto.kind() == mindir::NodeProto::VALUE) {
+        node = std::make_shared<ValueNode>(LoadValue(proto.value()));
+      } else {
+        node = std::make_shared<CNode>(std::vector<AnfNodePtr>(), graph);
+      }
+      if (proto.has_scope()) {
+        node->set_scope(std::make_shared<Scope>(proto.scope()));
+      }
+      nodes_[LongToSize(id)] = node;
+      node_graphs_[LongToSize(id)] = graph_index;
+    }
+  }
+  return true;
+}
+
+bool MindIRLoader::LinkNode(size_t node_id) {
+  auto& proto = model_.nodes(SizeToInt(node_id));
+  auto node = nodes_[node_id];
+  if (node == nullptr) {
+    MS_LOG(ERROR) << "The node " << node_id << " belongs to no graph.";
+    return false;
+  }
+  if (proto.kind() == mindir::NodeProto::CNODE) {
+    std::vector<AnfNodePtr> inputs;
+    for (auto input : proto.inputs()) {
+      if (input < 0 || input >= SizeToLong(nodes_.size())) {
+        MS_LOG(ERROR) << "The input " << input << " of the node " << node_id << " is out of the model.";
+        return false;
+      }
+      inputs.push_back(nodes_[LongToSize(input)]);
+    }
+    node->cast<CNodePtr>()->set_inputs(inputs);
+  }
+  if (proto.has_abstract()) {
+    node->set_abstract(LoadAbstract(proto.abstract()));
+  }
+  if (proto.has_kernel_build_info() || model_.graphs(SizeToInt(node_graphs_[node_id])).kernel_graph()) {
+    node->set_kernel_info(std::make_shared<device::KernelInfo>());
+  }
+  if (proto.has_kernel_build_info()) {
+    AnfAlgo::SetSelectKernelBuildInfo(LoadKernelBuildInfo(proto.kernel_build_info()), node.get());
+  }
+  return true;
+}
+
+void MindIRLoader::SetGraphs() {
+  for (size_t graph_index = 0; graph_index < graphs_.size(); ++graph_index) {
+    auto& proto = model_.graphs(SizeToInt(graph_index));
+    auto graph = graphs_[graph_index];
+    std::vector<AnfNodePtr> params;
+    for (auto id : proto.parameters()) {
+      params.push_back(nodes_.at(LongToSize(id)));
+    }
+    graph->set_parameters(params);
+    if (proto.has_return_node()) {
+      graph->set_return(nodes_.at(LongToSize(proto.return_node()))->cast<CNodePtr>());
+    }
+    auto kernel_graph = graph->cast<std::shared_ptr<session::KernelGraph>>();
+    if (kernel_graph == nullptr) {
+      continue;
+    }
+    kernel_graph->set_graph_id(proto.graph_id());
+    std::vector<CNodePtr> execution_order;
+    for (auto id : proto.execution_order()) {
+      execution_order.push_back(nodes_.at(LongToSize(id))->cast<CNodePtr>());
+    }
+    kernel_graph->set_execution_order(execution_order);
+    for (auto id : proto.graph_inputs()) {
+      kernel_graph->MutableInputs()->push_back(nodes_.at(LongToSize(id)));
+    }
+    for (auto id : proto.value_nodes()) {
+      kernel_graph->AddValueNodeToGraph(nodes_.at(LongToSize(id))->cast<ValueNodePtr>());
+    }
+  }
+}
+
+std::vector<FuncGraphPtr> MindIRLoader::Load(const std::string& file_name) {
+  if (!ReadModel(file_name)) {
+    return {};
+  }
+  for (auto& proto : model_.graphs()) {
+    FuncGraphPtr graph = nullptr;
+    if (proto.kernel_graph()) {
+      graph = std::make_shared<session::KernelGraph>();
+    } else {
+      graph = std::make_shared<FuncGraph>();
+    }
+    graph->debug_info()->set_name(proto.name());
+    for (auto& flag : proto.flags()) {
+      graph->set_flags(flag.name(), flag.value());
+    }
+    graphs_.push_back(graph);
+  }
+  if (!LoadTensors() || !CreateNodes()) {
+    return {};
+  }
+  if (!RunParallel(nodes_.size(), [this](size_t i) { return LinkNode(i); })) {
+    return {};
+  }
+  SetGraphs();
+  MS_LOG(INFO) << "Loaded " << graphs_.size() << " graphs, " << nodes_.size() << " nodes and " << tensors_.size()
+               << " tensors from the MindIR " << file_name << ".";
+  return graphs_;
+}
+}  // namespace
+
+bool SaveMindIR(const std::string& file_name, const std::vector<FuncGraphPtr>& graphs) {
+  MindIRSaver saver;
+  if (!saver.Save(file_name, graphs)) {
+    MS_LOG(ERROR) << "Save the MindIR " << file_name << " failed.";
+    return false;
+  }
+  return true;
+}
+
+std::vector<FuncGraphPtr> LoadMindIR(const std::string& file_name) {
+  MindIRLoader loader;
+  return loader.Load(file_name);
+}
+}  // namespace mindspore
@@ -0,0 +1,40 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_UTILS_MIND_IR_H_
+#define MINDSPORE_CCSRC_UTILS_MIND_IR_H_
+
+#include <string>
+#include <vector>
+#include "ir/anf.h"
+
+namespace mindspore {
+// The binary MindIR keeps the graphs as they are after the optimization, with the abstracts of the nodes, the kernel
+// build infos selected for them and the state of the kernel graphs, so they are loaded back without being parsed or
+// optimized again. The tensors of the value nodes are kept out of the model in an aligned data section, which the
+// loader reads by several threads. The default values of the parameters are not saved, they come from a checkpoint.
+constexpr char kMindIRMagic[] = "MINDIR01";
+constexpr size_t kMindIRAlign = 64;
+constexpr int64_t kMindIRVersion = 1;
+
+// Save the graphs and the graphs they call, the first one is the root graph.
+bool SaveMindIR(const std::string& file_name, const std::vector<FuncGraphPtr>& graphs);
+
+// Load the graphs saved by SaveMindIR, the root graph first, or nothing if the file can not be loaded.
+// The tensors are created by the calling thread, so it holds the GIL if there is python.
+std::vector<FuncGraphPtr> LoadMindIR(const std::string& file_name);
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_MIND_IR_H_
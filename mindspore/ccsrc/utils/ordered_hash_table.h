@@ -0,0 +1,297 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_ORDERED_HASH_TABLE_H_
+#define MINDSPORE_CCSRC_UTILS_ORDERED_HASH_TABLE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+// The storage of OrderedMap and OrderedSet. The elements are kept in the order they are added in a vector, and an
+// open addressing table of their indexes in the vector finds them by key. Each element is allocated once and never
+// moved, so the references to the elements stay valid until they are erased, as they did in a list.
+// An erased element leaves a hole in the vector that the iteration skips, so erasing invalidates no iterator but the
+// erased one. The holes are compacted away when the vector is full, which invalidates the iterators; an insertion
+// otherwise keeps them valid, and an iteration goes on over the elements added after it started.
+template <typename ValueT, typename KeyT, typename KeyOf, class Hash, class Equal>
+class OrderedHashTable {
+  struct Entry {
+    std::size_t hash;
+    std::unique_ptr<ValueT> value;  // nullptr once the element is erased
+  };
+  using EntryList = std::vector<Entry>;
+  static constexpr std::size_t kNoIndex = std::numeric_limits<std::size_t>::max();
+  static constexpr std::size_t kMinSlots = 8;
+
+ public:
+  using value_type = ValueT;
+  using key_type = KeyT;
+  using size_type = std::size_t;
+
+  template <bool IsConst>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = ValueT;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const ValueT *, ValueT *>;
+    using reference = std::conditional_t<IsConst, const ValueT &, ValueT &>;
+
+    Iterator() = default;
+    Iterator(const EntryList *entries, size_type index) : entries_(entries), index_(index) {}
+    // An iterator converts to a const iterator.
+    template <bool C = IsConst, typename = std::enable_if_t<C>>
+    Iterator(const Iterator<false> &other) : entries_(other.entries_), index_(other.index_) {}
+
+    reference operator*() const { return *(*entries_)[index_].value; }
+    pointer operator->() const { return (*entries_)[index_].value.get(); }
+
+    Iterator &operator++() {
+      do {
+        ++index_;
+      } while (index_ < entries_->size() && (*entries_)[index_].value == nullptr);
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    Iterator &operator--() {
+      if (index_ > entries_->size()) {
+        index_ = entries_->size();
+      }
+      do {
+        --index_;
+      } while ((*entries_)[index_].value == nullptr);
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    // Every iterator past the last element is the end, so an end taken before an insertion is still the end.
+    template <bool C>
+    bool operator==(const Iterator<C> &other) const {
+      return position() == other.position();
+    }
+    template <bool C>
+    bool operator!=(const Iterator<C> &other) const {
+      return position() != other.position();
+    }
+
+   private:
+    template <bool C>
+    friend class Iterator;
+    friend class OrderedHashTable;
+
+    size_type position() const {
+      return (entries_ == nullptr || index_ >= entries_->size()) ? kNoIndex : index_;
+    }
+
+    const EntryList *entries_{nullptr};
+    size_type index_{0};
+  };
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  OrderedHashTable() = default;
+  ~OrderedHashTable() = default;
+  OrderedHashTable(const OrderedHashTable &) = delete;
+  OrderedHashTable &operator=(const OrderedHashTable &) = delete;
+
+  iterator begin() { return iterator(&entries_, first_); }
+  iterator end() { return iterator(&entries_, kNoIndex); }
+  const_iterator begin() const { return const_iterator(&entries_, first_); }
+  const_iterator end() const { return const_iterator(&entries_, kNoIndex); }
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    entries_.clear();
+    slots_.clear();
+    size_ = 0;
+    first_ = 0;
+  }
+
+  void swap(OrderedHashTable &rhs) {
+    std::swap(entries_, rhs.entries_);
+    std::swap(slots_, rhs.slots_);
+    std::swap(size_, rhs.size_);
+    std::swap(first_, rhs.first_);
+  }
+
+  void reserve(size_type num_entries) {
+    if (num_entries > entries_.capacity()) {
+      Compact();
+      entries_.reserve(num_entries);
+    }
+    if (num_entries * 2 > slots_.size()) {
+      Rehash(num_entries);
+    }
+  }
+
+  iterator find(const KeyT &key) { return iterator(&entries_, Find(key, Hash()(key))); }
+  const_iterator find(const KeyT &key) const { return const_iterator(&entries_, Find(key, Hash()(key))); }
+
+  // Add the element made by make_value() if there is none with the key, and return the element with the key.
+  // The key is not used once make_value() is called, so it may be moved from by make_value().
+  template <typename MakeValue>
+  std::pair<iterator, bool> try_emplace(const KeyT &key, MakeValue make_value) {
+    size_type hash = Hash()(key);
+    size_type index = Find(key, hash);
+    if (index != kNoIndex) {
+      return std::make_pair(iterator(&entries_, index), false);
+    }
+    if ((size_ + 1) * 2 > slots_.size()) {
+      Rehash(size_ + 1);
+    }
+    if (entries_.size() == entries_.capacity() && (entries_.size() - size_) * 4 >= entries_.size()) {
+      Compact();
+    }
+    index = entries_.size();
+    entries_.push_back(Entry{hash, make_value()});
+    size_++;
+    InsertSlot(hash, index);
+    return std::make_pair(iterator(&entries_, index), true);
+  }
+
+  // Remove the element at pos and return the iterator to the element after it.
+  iterator erase(const_iterator pos) {
+    size_type index = pos.index_;
+    EraseSlot(index);
+    entries_[index].value.reset();
+    size_--;
+    if (size_ == 0) {
+      entries_.clear();
+      first_ = 0;
+      return end();
+    }
+    // The holes at the back cost nothing to drop. The first element is remembered, so popping the elements at
+    // the front does not make begin() skip more and more holes.
+    while (entries_.back().value == nullptr) {
+      entries_.pop_back();
+    }
+    while (entries_[first_].value == nullptr) {
+      first_++;
+    }
+    iterator next(&entries_, index);
+    return ++next;
+  }
+
+  size_type erase(const KeyT &key) {
+    size_type index = Find(key, Hash()(key));
+    if (index == kNoIndex) {
+      return 0;
+    }
+    (void)erase(const_iterator(&entries_, index));
+    return 1;
+  }
+
+ private:
+  size_type Find(const KeyT &key, size_type hash) const {
+    if (slots_.empty()) {
+      return kNoIndex;
+    }
+    size_type mask = slots_.size() - 1;
+    for (size_type i = hash & mask; slots_[i] != 0; i = (i + 1) & mask) {
+      const Entry &entry = entries_[slots_[i] - 1];
+      if (entry.hash == hash && Equal()(KeyOf()(*entry.value), key)) {
+        return slots_[i] - 1;
+      }
+    }
+    return kNoIndex;
+  }
+
+  // The slots hold the index of an element plus one, 0 is a free slot. They are never more than half full.
+  void InsertSlot(size_type hash, size_type index) {
+    size_type mask = slots_.size() - 1;
+    size_type i = hash & mask;
+    while (slots_[i] != 0) {
+      i = (i + 1) & mask;
+    }
+    slots_[i] = index + 1;
+  }
+
+  // Free the slot of the element at index, moving back the elements probed past it so no lookup stops early.
+  void EraseSlot(size_type index) {
+    size_type mask = slots_.size() - 1;
+    size_type i = entries_[index].hash & mask;
+    while (slots_[i] != index + 1) {
+      i = (i + 1) & mask;
+    }
+    for (size_type j = (i + 1) & mask; slots_[j] != 0; j = (j + 1) & mask) {
+      size_type home = entries_[slots_[j] - 1].hash & mask;
+      // The element at j may move to i if its home slot is not in (i, j] cyclically.
+      bool stays = (i < j) ? (i < home && home <= j) : (i < home || home <= j);
+      if (!stays) {
+        slots_[i] = slots_[j];
+        i = j;
+      }
+    }
+    slots_[i] = 0;
+  }
+
+  void Rehash(size_type num_entries) {
+    size_type num_slots = kMinSlots;
+    while (num_slots < num_entries * 2) {
+      num_slots *= 2;
+    }
+    slots_.assign(num_slots, 0);
+    for (size_type index = 0; index < entries_.size(); ++index) {
+      if (entries_[index].value != nullptr) {
+        InsertSlot(entries_[index].hash, index);
+      }
+    }
+  }
+
+  // Drop the holes of the erased elements. The elements themselves do not move.
+  void Compact() {
+    if (entries_.size() == size_) {
+      return;
+    }
+    size_type count = 0;
+    for (size_type index = 0; index < entries_.size(); ++index) {
+      if (entries_[index].value != nullptr) {
+        if (index != count) {
+          entries_[count] = std::move(entries_[index]);
+        }
+        count++;
+      }
+    }
+    entries_.resize(count);
+    first_ = 0;
+    Rehash(std::max(size_, slots_.size() / 2));
+  }
+
+  EntryList entries_;
+  std::vector<size_type> slots_;
+  size_type size_{0};
+  size_type first_{0};  // The index of the first element
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_ORDERED_HASH_TABLE_H_
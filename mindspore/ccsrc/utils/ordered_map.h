@@ -18,17 +18,17 @@
 #define MINDSPORE_CCSRC_UTILS_ORDERED_MAP_H_
 
 #include <algorithm>
-#include <unordered_map>
 #include <utility>
 #include <list>
 #include <string>
 #include <functional>
 #include <memory>
 #include "utils/log_adapter.h"
+#include "utils/ordered_hash_table.h"
 
 namespace mindspore {
 // Implementation of OrderedMap that keeps insertion order
-// using unordered_map to improve the performance of find/erase, and use list to keep insertion order
+// using an open addressing table to find the pairs by key, and a vector of the pairs to keep insertion order
 template <typename KeyT, typename ValueT, class Hash = std::hash<KeyT>, class Equal = std::equal_to<KeyT>>
 class OrderedMap {
  public:
@@ -38,35 +38,43 @@ class OrderedMap {
   using equal = Equal;
   using pair_type = std::pair<key_t, value_t>;
   using sequential_type = std::list<pair_type>;
-  using iterator = typename sequential_type::iterator;
-  using const_iterator = typename sequential_type::const_iterator;
-  using reverse_iterator = typename sequential_type::reverse_iterator;
-  using const_reverse_iterator = typename sequential_type::const_reverse_iterator;
-  using map_type = std::unordered_map<key_t, iterator, hasher, equal>;
-  using value_type = typename sequential_type::value_type;
-  using size_type = typename sequential_type::size_type;
-
-  iterator begin() { return sequential_data_.begin(); }
-  iterator end() { return sequential_data_.end(); }
-  const_iterator begin() const { return sequential_data_.cbegin(); }
-  const_iterator end() const { return sequential_data_.cend(); }
-  const_iterator cbegin() const { return sequential_data_.cbegin(); }
-  const_iterator cend() const { return sequential_data_.cend(); }
-
-  reverse_iterator rbegin() { return sequential_data_.rbegin(); }
-  reverse_iterator rend() { return sequential_data_.rend(); }
-  const_reverse_iterator rbegin() const { return sequential_data_.rbegin(); }
-  const_reverse_iterator rend() const { return sequential_data_.rend(); }
-
-  pair_type &front() { return sequential_data_.front(); }
-  const pair_type &front() const { return sequential_data_.front(); }
-  pair_type &back() { return sequential_data_.back(); }
-  const pair_type &back() const { return sequential_data_.back(); }
+
+ private:
+  struct KeyOf {
+    const key_t &operator()(const pair_type &kv) const { return kv.first; }
+  };
+  using table_type = OrderedHashTable<pair_type, key_t, KeyOf, hasher, equal>;
+
+ public:
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using value_type = pair_type;
+  using size_type = typename table_type::size_type;
+
+  iterator begin() { return data_.begin(); }
+  iterator end() { return data_.end(); }
+  const_iterator begin() const { return data_.begin(); }
+  const_iterator end() const { return data_.end(); }
+  const_iterator cbegin() const { return data_.begin(); }
+  const_iterator cend() const { return data_.end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+  pair_type &front() { return *begin(); }
+  const pair_type &front() const { return *begin(); }
+  pair_type &back() { return *std::prev(end()); }
+  const pair_type &back() const { return *std::prev(end()); }
 
   OrderedMap() = default;
   ~OrderedMap() = default;
   OrderedMap(const OrderedMap &os) {
-    for (auto &item : os.sequential_data_) {
+    reserve(os.size());
+    for (auto &item : os) {
       (void)insert(pair_type(item.first, item.second));
     }
   }
@@ -80,38 +88,22 @@ class OrderedMap {
 
   OrderedMap &operator=(const OrderedMap &os) {
     if (this != &os) {
-      for (auto &item : os.sequential_data_) {
+      for (auto &item : os) {
         (void)insert(pair_type(item.first, item.second));
       }
     }
     return *this;
   }
 
-  void clear() {
-    map_data_.clear();
-    sequential_data_.clear();
-  }
+  void clear() { data_.clear(); }
 
-  void swap(OrderedMap &rhs) {
-    std::swap(map_data_, rhs.map_data_);
-    std::swap(sequential_data_, rhs.sequential_data_);
-  }
+  void swap(OrderedMap &rhs) { data_.swap(rhs.data_); }
 
-  void reserve(size_type num_entries) {
-    map_data_.reserve(num_entries);
-    sequential_data_.reserve(num_entries);
-  }
+  void reserve(size_type num_entries) { data_.reserve(num_entries); }
 
   std::pair<iterator, bool> add(const key_t &key) {
-    iterator empty_itr;
-    std::pair<key_t, typename map_type::mapped_type> map_pair = std::make_pair(key, empty_itr);
-    std::pair<typename map_type::iterator, bool> result = map_data_.insert(map_pair);
-    auto &seq_itr = result.first->second;
-    if (result.second) {
-      auto it = sequential_data_.insert(sequential_data_.end(), std::make_pair(key, ValueT()));
-      seq_itr = it;
-    }
-    return std::pair<iterator, bool>(seq_itr, result.second);
+    // The pair is only made when the key is not in the map yet
+    return data_.try_emplace(key, [&key]() { return std::make_unique<pair_type>(key, ValueT()); });
   }
 
   ValueT &operator[](const key_t &key) {
@@ -120,79 +112,37 @@ class OrderedMap {
   }
 
   std::pair<iterator, bool> insert(const pair_type &kv) {
-    auto result = add(kv.first);
-    if (result.second) {
-      *(result.first) = kv.second;
-      return std::make_pair(std::prev(end()), true);
-    }
-    return std::make_pair(result.first, false);
+    return data_.try_emplace(kv.first, [&kv]() { return std::make_unique<pair_type>(kv); });
   }
 
   std::pair<iterator, bool> insert(pair_type &&kv) {
-    iterator empty_itr;
-    std::pair<key_t, typename map_type::mapped_type> map_pair = std::make_pair(kv.first, empty_itr);
-    std::pair<typename map_type::iterator, bool> result = map_data_.insert(map_pair);
-    auto &seq_itr = result.first->second;
-    if (result.second) {
-      auto it = sequential_data_.insert(sequential_data_.end(), std::move(kv));
-      seq_itr = it;
-      return std::make_pair(std::prev(end()), true);
-    }
-    return std::make_pair(seq_itr, false);
+    return data_.try_emplace(kv.first, [&kv]() { return std::make_unique<pair_type>(std::move(kv)); });
   }
 
-  bool empty() const { return sequential_data_.empty(); }
+  bool empty() const { return data_.empty(); }
 
-  size_type size() const { return sequential_data_.size(); }
+  size_type size() const { return data_.size(); }
 
-  size_type count(const key_t &key) const {
-    auto pos = map_data_.find(key);
-    return pos == map_data_.end() ? 0 : 1;
-  }
+  size_type count(const key_t &key) const { return find(key) == end() ? 0 : 1; }
 
-  iterator find(const key_t &key) {
-    typename map_type::const_iterator pos = map_data_.find(key);
-    return pos == map_data_.end() ? sequential_data_.end() : (pos->second);
-  }
+  iterator find(const key_t &key) { return data_.find(key); }
 
-  const_iterator find(const key_t &key) const {
-    auto pos = map_data_.find(key);
-    return pos == map_data_.end() ? sequential_data_.end() : (pos->second);
-  }
+  const_iterator find(const key_t &key) const { return data_.find(key); }
 
-  // Remove the last element from the sequential_data_.
-  void pop_back() {
-    typename map_type::iterator pos = map_data_.find(sequential_data_.back().first);
-    map_data_.erase(pos);
-    sequential_data_.pop_back();
-  }
+  // Remove the last element.
+  void pop_back() { (void)data_.erase(std::prev(end())); }
 
-  // Remove the first element from the sequential_data_.
-  void pop_front() {
-    typename map_type::iterator pos = map_data_.find(sequential_data_.first().first);
-    map_data_.erase(pos);
-    sequential_data_.pop_front();
-  }
+  // Remove the first element.
+  void pop_front() { (void)data_.erase(begin()); }
 
   // Remove the element given by Iterator.
-  typename sequential_type::iterator erase(const typename sequential_type::iterator &itr) {
-    (void)map_data_.erase(itr->first);
-    auto next = sequential_data_.erase(itr);
-    if (next == sequential_data_.end()) return next;
-    return next;
-  }
+  iterator erase(const iterator &itr) { return data_.erase(itr); }
 
   // Remove the element with the given key
-  size_type erase(const key_t &key) {
-    auto itr = find(key);
-    if (itr == end()) return 0;
-    (void)erase(itr);
-    return 1;
-  }
+  size_type erase(const key_t &key) { return data_.erase(key); }
 
  private:
-  map_type map_data_;
-  sequential_type sequential_data_;
+  table_type data_;
 };
 }  // namespace mindspore
 
@@ -20,7 +20,6 @@
 #define MINDSPORE_CCSRC_UTILS_ORDERED_SET_H_
 
 #include <algorithm>
-#include <unordered_map>
 #include <vector>
 #include <list>
 #include <utility>
@@ -28,11 +27,12 @@
 #include <functional>
 #include <memory>
 #include "utils/log_adapter.h"
+#include "utils/ordered_hash_table.h"
 
 namespace mindspore {
 
 // Implementation of OrderedSet that keeps insertion order
-// using map as set, and use list as a sequential container to record elements to keep insertion order
+// using an open addressing table as set, and a vector as a sequential container to keep insertion order
 template <class T, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>>
 class OrderedSet {
  public:
@@ -41,25 +41,31 @@ class OrderedSet {
   using equal = KeyEqual;
   using sequential_type = std::list<element_type>;
   using vector_type = std::vector<element_type>;
-  using iterator = typename sequential_type::iterator;
-  using const_iterator = typename sequential_type::const_iterator;
-  using reverse_iterator = typename sequential_type::reverse_iterator;
-  using const_reverse_iterator = typename sequential_type::const_reverse_iterator;
-  using map_type = std::unordered_map<element_type, iterator, hasher, equal>;
+
+ private:
+  struct KeyOf {
+    const element_type& operator()(const element_type& e) const { return e; }
+  };
+  using table_type = OrderedHashTable<element_type, element_type, KeyOf, hasher, equal>;
+
+ public:
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
   using ordered_set_type = OrderedSet<element_type, hasher, equal>;
 
   OrderedSet() = default;
   ~OrderedSet() = default;
-  // OrderedSet use an iterator to list as mapped value to improve the performance of insertion and deletion,
-  // So copy of OrderedSet should re-build value of the map key to make it pointer to the new list,, thus we use
-  // traversal to build elements.
   OrderedSet(const OrderedSet& os) {
-    for (auto& item : os.ordered_data_) {
+    data_.reserve(os.size());
+    for (auto& item : os) {
       add(item);
     }
   }
 
   explicit OrderedSet(const sequential_type& other) {
+    data_.reserve(other.size());
     for (auto& item : other) {
       add(item);
     }
@@ -67,6 +73,7 @@ class OrderedSet {
 
   // Explicitly construct an OrderedSet use vector
   explicit OrderedSet(const vector_type& other) {
+    data_.reserve(other.size());
     for (auto& item : other) {
       add(item);
     }
@@ -74,7 +81,7 @@ class OrderedSet {
 
   OrderedSet& operator=(const OrderedSet& os) {
     if (this != &os) {
-      for (auto& item : os.ordered_data_) {
+      for (auto& item : os) {
         add(item);
       }
     }
@@ -86,76 +93,57 @@ class OrderedSet {
 
   // insert an element to the OrderedSet
   std::pair<iterator, bool> insert(const element_type& e) {
-    iterator empty_itr;
-    std::pair<element_type, typename map_type::mapped_type> map_pair = std::make_pair(e, empty_itr);
-    auto result = mapped_data_.insert(map_pair);
-    auto& seq_idx = result.first->second;
-    // if insert success;
-    if (result.second) {
-      auto it = ordered_data_.insert(ordered_data_.end(), e);
-      seq_idx = it;
-    }
-    return std::pair<iterator, bool>(seq_idx, result.second);
+    // The element is copied only once and nothing is allocated when it's already in the set
+    return data_.try_emplace(e, [&e]() { return std::make_unique<element_type>(e); });
   }
 
   // Remove an element, if removed return true, otherwise return false
-  bool erase(const element_type& e) {
-    auto pos = mapped_data_.find(e);
-    if (pos == mapped_data_.end()) {
-      return false;
-    }
-    // erase the sequential data first
-    (void)ordered_data_.erase(pos->second);
-    (void)mapped_data_.erase(pos);
-    return true;
-  }
+  bool erase(const element_type& e) { return data_.erase(e) != 0; }
 
   // Return the container size
-  std::size_t size() const { return mapped_data_.size(); }
+  std::size_t size() const { return data_.size(); }
 
-  bool empty() const { return mapped_data_.size() == 0; }
+  bool empty() const { return data_.empty(); }
 
   // Return the string contents in orderset, using ordered_data
   std::string toString() {
     std::ostringstream res;
     res << "orderset content:\n";
-    for (auto& item : ordered_data_) {
+    for (auto& item : data_) {
       res << std::to_string(reinterpret_cast<uintptr_t>(item.get())) << " ";
     }
     return res.str();
   }
 
   // Clear the elements
-  void clear() {
-    mapped_data_.clear();
-    ordered_data_.clear();
-  }
+  void clear() { data_.clear(); }
 
   // Compare two orderedset, if the order is not equal shall return false
-  bool operator==(const OrderedSet& other) const { return ordered_data_ == other.ordered_data_; }
+  bool operator==(const OrderedSet& other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+  }
 
   // Remove and return the first element in the OrderedSet
   T pop() {
-    if (ordered_data_.size() != 0) {
-      T res = ordered_data_.front();
-      (void)mapped_data_.erase(res);
-      (void)ordered_data_.erase(ordered_data_.begin());
+    if (!data_.empty()) {
+      T res = *data_.begin();
+      (void)data_.erase(data_.begin());
       return res;
     }
     MS_LOG(EXCEPTION) << "pop() on empty OrderedSet";
   }
 
   T back() {
-    if (ordered_data_.size() != 0) {
-      return ordered_data_.back();
+    if (!data_.empty()) {
+      return *std::prev(data_.end());
     }
     MS_LOG(EXCEPTION) << "back() on empty OrderedSet";
   }
 
   // Return true if there are no common elements
   bool is_disjoint(const OrderedSet& other) {
-    for (auto& item : other.ordered_data_) {
-      if (mapped_data_.find(item) != mapped_data_.end()) {
+    for (auto& item : other) {
+      if (contains(item)) {
         return false;
       }
     }
@@ -164,8 +152,8 @@ class OrderedSet {
 
   // Test whether this is subset of other
   bool is_subset(const OrderedSet& other) {
-    for (auto& item : ordered_data_) {
-      if (other.mapped_data_.find(item) == other.mapped_data_.end()) {
+    for (auto& item : data_) {
+      if (!other.contains(item)) {
         return false;
       }
     }
@@ -174,7 +162,7 @@ class OrderedSet {
 
   // Add elements in other to this orderedset
   void update(const OrderedSet& other) {
-    for (auto& item : other.ordered_data_) {
+    for (auto& item : other) {
       add(item);
     }
   }
@@ -194,7 +182,7 @@ class OrderedSet {
   }
 
   ordered_set_type get_union(const OrderedSet& other) {
-    ordered_set_type res(ordered_data_);
+    ordered_set_type res(*this);
     res.update(other);
     return res;
   }
@@ -204,9 +192,9 @@ class OrderedSet {
 
   // Return the intersection of two sets
   ordered_set_type intersection(const OrderedSet& other) {
-    ordered_set_type res(ordered_data_);
-    for (auto& item : ordered_data_) {
-      if (other.mapped_data_.find(item) == other.mapped_data_.end()) {
+    ordered_set_type res(*this);
+    for (auto& item : data_) {
+      if (!other.contains(item)) {
         (void)res.erase(item);
       }
     }
@@ -216,9 +204,9 @@ class OrderedSet {
 
   // Return the symmetric difference of two sets
   ordered_set_type symmetric_difference(const OrderedSet& other) {
-    ordered_set_type res(ordered_data_);
-    for (auto& item : other.ordered_data_) {
-      if (mapped_data_.find(item) != mapped_data_.end()) {
+    ordered_set_type res(*this);
+    for (auto& item : other) {
+      if (contains(item)) {
         (void)res.erase(item);
       } else {
         res.add(item);
@@ -232,7 +220,7 @@ class OrderedSet {
   // Remove elements which is also in others.
   void difference_update(const OrderedSet& other) {
     // use vector traversal, to keep ordrer
-    for (auto& item : other.ordered_data_) {
+    for (auto& item : other) {
       (void)erase(item);
     }
   }
@@ -251,29 +239,28 @@ class OrderedSet {
 
   // Return the set with elements that are not in the others
   ordered_set_type difference(const OrderedSet& other) {
-    ordered_set_type res(ordered_data_);
+    ordered_set_type res(*this);
     res.difference_update(other);
     return res;
   }
   ordered_set_type operator-(const OrderedSet& other) { return difference(other); }
 
-  bool contains(const element_type& e) const { return (mapped_data_.find(e) != mapped_data_.end()); }
+  bool contains(const element_type& e) const { return data_.find(e) != data_.end(); }
 
   // Return the count of an element in set
-  std::size_t count(const element_type& e) const { return mapped_data_.count(e); }
+  std::size_t count(const element_type& e) const { return contains(e) ? 1 : 0; }
 
-  iterator begin() { return ordered_data_.begin(); }
-  iterator end() { return ordered_data_.end(); }
+  iterator begin() { return data_.begin(); }
+  iterator end() { return data_.end(); }
 
-  const_iterator begin() const { return ordered_data_.cbegin(); }
-  const_iterator end() const { return ordered_data_.cend(); }
+  const_iterator begin() const { return data_.begin(); }
+  const_iterator end() const { return data_.end(); }
 
-  const_iterator cbegin() const { return ordered_data_.cbegin(); }
-  const_iterator cend() const { return ordered_data_.cend(); }
+  const_iterator cbegin() const { return data_.begin(); }
+  const_iterator cend() const { return data_.end(); }
 
  private:
-  map_type mapped_data_;
-  sequential_type ordered_data_;
+  table_type data_;
 };
 
 }  // namespace mindspore
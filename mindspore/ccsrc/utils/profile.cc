@@ -110,6 +110,21 @@ double GetTime(void) {
   return tv.tv_sec + tv.tv_usec * 1.0e-6;
 }
 
+int64_t GetRss() {
+  FILE* fp = fopen("/proc/self/statm", "r");
+  if (fp == nullptr) {
+    return 0;
+  }
+  long vm_pages = 0;
+  long rss_pages = 0;
+  int ret = fscanf(fp, "%ld %ld", &vm_pages, &rss_pages);
+  (void)fclose(fp);
+  if (ret != 2) {
+    return 0;
+  }
+  return static_cast<int64_t>(rss_pages) * sysconf(_SC_PAGESIZE) / 1024;
+}
+
 TimeInfo::~TimeInfo() {
   if (dict_ == nullptr) {
     return;
@@ -342,6 +357,63 @@ void MsProfile::Print() {
   // the length of text is too long to use MS_LOGINFO, use printf to print it
   (void)printf("\nTime group info:\n%s", text.c_str());
   (void)fflush(stdout);
+
+  const auto& pass_stat = GetSingleton().pass_stat_;
+  if (pass_stat.empty()) {
+    return;
+  }
+  std::ostringstream pass_oss;
+  pass_oss << std::setw(12) << "time(s)" << std::setw(8) << "count" << std::setw(10) << "nodes" << std::setw(10)
+           << "->" << std::setw(12) << "rss(KB)"
+           << " : pass\n";
+  for (const auto& id : GetSingleton().pass_order_) {
+    const auto& item = pass_stat.at(id);
+    pass_oss << std::setw(12) << std::fixed << std::setprecision(6) << item.time_ << std::setw(8) << item.count_
+             << std::setw(10) << item.nodes_before_ << std::setw(10) << item.nodes_after_ << std::setw(12)
+             << item.rss_delta_ << " : " << id << "\n";
+  }
+  text = pass_oss.str();
+  (void)printf("\nPass info:\n%s", text.c_str());
+  (void)fflush(stdout);
+}
+
+void MsProfile::StatPass(const std::string& id, double time, size_t nodes_before, size_t nodes_after,
+                         int64_t rss_delta) {
+  auto& ms_prof = GetSingleton();
+  auto iter = ms_prof.pass_stat_.find(id);
+  if (iter == ms_prof.pass_stat_.end()) {
+    ms_prof.pass_order_.push_back(id);
+    iter = ms_prof.pass_stat_.emplace(id, PassStat()).first;
+    iter->second.nodes_before_ = nodes_before;
+  }
+  auto& item = iter->second;
+  item.time_ += time;
+  item.count_ += 1;
+  item.nodes_after_ = nodes_after;
+  item.rss_delta_ += rss_delta;
+}
+
+void MsProfile::SavePassStat(const std::string& file_path) {
+  const auto& ms_prof = GetSingleton();
+  if (ms_prof.pass_stat_.empty()) {
+    return;
+  }
+  std::ofstream file_out(file_path, std::ios::trunc | std::ios::out);
+  if (!file_out.is_open()) {
+    MS_LOG(ERROR) << "Cannot open file " << file_path << " to save the pass stats.";
+    return;
+  }
+  file_out << "{\n    \"passes\": [";
+  for (size_t i = 0; i < ms_prof.pass_order_.size(); ++i) {
+    const auto& id = ms_prof.pass_order_[i];
+    const auto& item = ms_prof.pass_stat_.at(id);
+    file_out << (i == 0 ? "\n" : ",\n") << "        {\"name\": \"" << id << "\", \"time\": " << std::fixed
+             << std::setprecision(6) << item.time_ << ", \"count\": " << item.count_
+             << ", \"nodes_before\": " << item.nodes_before_ << ", \"nodes_after\": " << item.nodes_after_
+             << ", \"rss_delta_kb\": " << item.rss_delta_ << "}";
+  }
+  file_out << "\n    ]\n}\n";
+  file_out.close();
 }
 
 }  // namespace mindspore
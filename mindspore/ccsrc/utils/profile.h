@@ -17,8 +17,11 @@
 #ifndef MINDSPORE_CCSRC_UTILS_PROFILE_H_
 #define MINDSPORE_CCSRC_UTILS_PROFILE_H_
 
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
+#include <vector>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
@@ -31,6 +34,9 @@ using TimeInfoMap = std::map<std::string, const TimeInfo*>;
 
 extern double GetTime();
 
+// the resident set size of the process in KB
+extern int64_t GetRss();
+
 class ProfileBase;
 
 struct TimeInfo {
@@ -181,6 +187,15 @@ struct TimeStat {
   int count_;
 };
 
+// The runs of a compile pass, the node numbers are the ones before the first run and after the last run
+struct PassStat {
+  double time_ = 0.0;
+  int count_ = 0;
+  size_t nodes_before_ = 0;
+  size_t nodes_after_ = 0;
+  int64_t rss_delta_ = 0;
+};
+
 class MsProfile {
  public:
   ~MsProfile() { Clear(); }
@@ -199,8 +214,12 @@ class MsProfile {
     return ms_prof.profile_;
   }
   static void StatTime(const std::string& id, double time) { GetSingleton().time_stat_[id] += time; }
+  static void StatPass(const std::string& id, double time, size_t nodes_before, size_t nodes_after,
+                       int64_t rss_delta);
 
   static void Print();
+  // save the pass stats in json, in the order the passes first run
+  static void SavePassStat(const std::string& file_path = "./compile_pass_stat.json");
 
  private:
   MsProfile() = default;
@@ -212,6 +231,8 @@ class MsProfile {
 
   void Clear() {
     time_stat_.clear();
+    pass_stat_.clear();
+    pass_order_.clear();
     if (profile_ != nullptr) {
       delete profile_;
       profile_ = nullptr;
@@ -220,14 +241,40 @@ class MsProfile {
 
   std::map<std::string, TimeStat> time_stat_;  // record time and count info from some activity
   ProfileBase* profile_ = nullptr;             // record hierarchical profile info
+  std::map<std::string, PassStat> pass_stat_;  // record time, node number and memory of the compile passes
+  std::vector<std::string> pass_order_;
+};
+
+// Record a compile pass in MsProfile, node_num counts the nodes the pass works on.
+class PassStatTransaction {
+ public:
+  PassStatTransaction(const std::string& id, const std::function<size_t()>& node_num) : id_(id), node_num_(node_num) {}
+  PassStatTransaction(const PassStatTransaction&) = delete;
+  ~PassStatTransaction() = default;
+
+  template <class Function>
+  void operator-(const Function& func) {
+    size_t nodes_before = node_num_();
+    int64_t rss_before = GetRss();
+    double start_time = GetTime();
+    func();
+    double end_time = GetTime();
+    MsProfile::StatPass(id_, end_time - start_time, nodes_before, node_num_(), GetRss() - rss_before);
+  }
+
+ private:
+  std::string id_;
+  std::function<size_t()> node_num_;
 };
 
 }  // namespace mindspore
 
 #ifdef ENABLE_PROFILE
 #define WITH(x) ProfTransaction(x) -
+#define WITH_PASS_STAT(id, node_num) PassStatTransaction(id, node_num) -
 #else
 #define WITH(x) NoProfTransaction(x) -
+#define WITH_PASS_STAT(id, node_num) NoProfTransaction(static_cast<ProfileBase*>(nullptr)) -
 #endif
 
 #endif  // MINDSPORE_CCSRC_UTILS_PROFILE_H_
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/step_stats.h"
+#include <utility>
+#include "utils/timeline.h"
+
+namespace mindspore {
+const char* StepStats::PhaseName(StepPhase phase) {
+  static const char* const names[kStepPhaseNum] = {"data_wait", "host_dispatch", "device_compute", "communication",
+                                                   "optimizer"};
+  return phase < kStepPhaseNum ? names[phase] : "unknown";
+}
+
+void StepStats::Start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  steps_.clear();
+  started_ = true;
+}
+
+void StepStats::Stop() { started_ = false; }
+
+void StepStats::BeginStep() {
+  for (auto& us : phase_us_) {
+    us.store(0, std::memory_order_relaxed);
+  }
+  step_start_us_ = Timeline::NowUs();
+  in_step_ = true;
+}
+
+void StepStats::EndStep() {
+  if (!in_step_.exchange(false)) {
+    return;
+  }
+  auto total_us = static_cast<int64_t>(Timeline::NowUs() - step_start_us_);
+  std::map<std::string, int64_t> step;
+  int64_t measured_us = 0;
+  for (size_t i = 0; i < kStepPhaseNum; ++i) {
+    auto us = static_cast<int64_t>(phase_us_[i].load(std::memory_order_relaxed));
+    step[PhaseName(static_cast<StepPhase>(i))] = us;
+    measured_us += us;
+  }
+  step[PhaseName(kStepHostDispatch)] += total_us > measured_us ? total_us - measured_us : 0;
+  step["total"] = total_us;
+  std::lock_guard<std::mutex> lock(mutex_);
+  steps_.push_back(std::move(step));
+}
+
+std::vector<std::map<std::string, int64_t>> StepStats::Steps() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return steps_;
+}
+}  // namespace mindspore
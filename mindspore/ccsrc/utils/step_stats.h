@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_STEP_STATS_H_
+#define MINDSPORE_CCSRC_UTILS_STEP_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+enum StepPhase : size_t {
+  kStepDataWait = 0,
+  kStepHostDispatch,
+  kStepDeviceCompute,
+  kStepCommunication,
+  kStepOptimizer,
+  kStepPhaseNum
+};
+
+// The breakdown of the time of the training steps, a step being a run of a compiled graph. The runtimes add the time
+// of the kernels to the phase of each kernel while the stats are enabled, synchronizing the streams around the kernels
+// which run asynchronously, and the host dispatch of a step is the rest of its time. The time of the kernels run in
+// parallel is added up, so the phases of a step may add up to more than its time.
+class StepStats {
+ public:
+  ~StepStats() = default;
+  StepStats(const StepStats&) = delete;
+  StepStats& operator=(const StepStats&) = delete;
+  static StepStats& GetInstance();
+
+  static const char* PhaseName(StepPhase phase);
+
+  // clear the steps recorded so far and record the following ones
+  void Start();
+  void Stop();
+  bool started() const { return started_.load(std::memory_order_relaxed); }
+
+  void BeginStep();
+  void EndStep();
+  // add the time to a phase of the current step, nothing is added out of a step
+  void Add(StepPhase phase, uint64_t us) {
+    if (in_step_.load(std::memory_order_relaxed)) {
+      phase_us_[phase].fetch_add(us, std::memory_order_relaxed);
+    }
+  }
+  // the microseconds of the phases of the steps recorded, and their total
+  std::vector<std::map<std::string, int64_t>> Steps();
+
+ private:
+  StepStats() = default;
+
+  std::atomic<bool> started_{false};
+  std::atomic<bool> in_step_{false};
+  uint64_t step_start_us_{0};
+  std::array<std::atomic<uint64_t>, kStepPhaseNum> phase_us_{};
+  std::mutex mutex_;
+  std::vector<std::map<std::string, int64_t>> steps_;
+};
+
+// Record a step from the construction to the destruction, if the stats are started at the construction.
+class StepStatsScope {
+ public:
+  StepStatsScope() : enabled_(StepStats::GetInstance().started()) {
+    if (enabled_) {
+      StepStats::GetInstance().BeginStep();
+    }
+  }
+  StepStatsScope(const StepStatsScope&) = delete;
+  StepStatsScope& operator=(const StepStatsScope&) = delete;
+  ~StepStatsScope() {
+    if (enabled_) {
+      StepStats::GetInstance().EndStep();
+    }
+  }
+
+ private:
+  bool enabled_;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_STEP_STATS_H_
@@ -23,6 +23,10 @@
 
 namespace mindspore {
 namespace summary {
+namespace {
+// the events queued but not written yet, a step writes a few of them
+const size_t kMaxPendingEvents = 64;
+}  // namespace
 
 // implement the EventWriter
 EventWriter::EventWriter(const std::string &file_full_name) : filename_(file_full_name), events_write_count_(0) {
@@ -36,9 +40,11 @@ EventWriter::EventWriter(const std::string &file_full_name) : filename_(file_ful
   }
   // set the event writer status
   status_ = true;
+  writer_thread_ = std::thread(&EventWriter::WriterLoop, this);
 }
 
 EventWriter::~EventWriter() {
+  StopWriter();
   if (event_file_ != nullptr) {
     bool result = Close();
     if (!result) {
@@ -48,7 +54,10 @@ EventWriter::~EventWriter() {
 }
 
 // get the write event count
-int32_t EventWriter::GetWriteEventCount() const { return events_write_count_; }
+int32_t EventWriter::GetWriteEventCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return events_write_count_;
+}
 
 // Open the file
 bool EventWriter::Open() {
@@ -63,16 +72,58 @@ bool EventWriter::Open() {
   return result;
 }
 
-// write the event serialization string to file
+// queue the event serialization string to the writer thread
 void EventWriter::Write(const std::string &event_str) {
   if (event_file_ == nullptr) {
     MS_LOG(ERROR) << "Write failed because file could not be opened.";
     return;
   }
+  std::unique_lock<std::mutex> lock(mutex_);
+  written_cond_.wait(lock, [this] { return pending_events_.size() < kMaxPendingEvents || stopped_; });
+  if (stopped_) {
+    MS_LOG(ERROR) << "Write failed because the event writer is closed.";
+    return;
+  }
   events_write_count_++;
-  bool result = WriteRecord(event_str);
-  if (!result) {
-    MS_LOG(ERROR) << "Event write failed.";
+  pending_events_.push_back(event_str);
+  event_cond_.notify_one();
+}
+
+void EventWriter::WriterLoop() {
+  std::deque<std::string> batch;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      writing_ = false;
+      written_cond_.notify_all();
+      event_cond_.wait(lock, [this] { return !pending_events_.empty() || stopped_; });
+      if (pending_events_.empty()) {
+        return;
+      }
+      batch.swap(pending_events_);
+      writing_ = true;
+    }
+    for (auto &event_str : batch) {
+      if (!WriteRecord(event_str)) {
+        MS_LOG(ERROR) << "Event write failed.";
+      }
+    }
+    batch.clear();
+    if (!event_file_->Flush()) {
+      MS_LOG(ERROR) << "Failed to flush the events to file(" << filename_ << ").";
+    }
+  }
+}
+
+void EventWriter::StopWriter() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  event_cond_.notify_one();
+  written_cond_.notify_all();
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
   }
 }
 
@@ -86,6 +137,10 @@ bool EventWriter::Flush() {
     MS_LOG(ERROR) << "Can't flush because the event file is null.";
     return false;
   }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_cond_.wait(lock, [this] { return (pending_events_.empty() && !writing_) || stopped_; });
+  }
   // Sync the file
   if (!event_file_->Flush()) {
     MS_LOG(ERROR) << "Failed to sync to file(" << filename_ << "), the event count(" << events_write_count_ << ").";
@@ -102,6 +157,7 @@ bool EventWriter::Close() noexcept {
     MS_LOG(INFO) << "The event writer is closed.";
     return result;
   }
+  StopWriter();
   if (event_file_ != nullptr) {
     result = event_file_->Close();
     if (!result) {
@@ -117,6 +173,7 @@ bool EventWriter::Shut() noexcept {
     MS_LOG(INFO) << "The event writer is closed.";
     return true;
   }
+  StopWriter();
   bool result = Flush();
   if (!result) {
     MS_LOG(ERROR) << "Flush failed when close the file.";
@@ -17,8 +17,12 @@
 #ifndef SUMMARY_EVENT_WRITER_H_
 #define SUMMARY_EVENT_WRITER_H_
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "pybind11/pybind11.h"
 #include "securec/include/securec.h"
@@ -36,6 +40,8 @@ using WriteFile = system::WriteFile;
 using WriteFilePtr = std::shared_ptr<WriteFile>;
 using FileSystem = system::FileSystem;
 
+// The events are written by a background thread, so the training thread only queues them. The queue is bounded,
+// writing blocks when the thread falls behind that far. The thread flushes the file after each batch it writes.
 class EventWriter {
  public:
   // The file name = path + file_name
@@ -52,10 +58,10 @@ class EventWriter {
   // Open the file
   bool Open();
 
-  // write the Serialized "event_str" to file
+  // queue the Serialized "event_str" to write to file
   void Write(const std::string &event_str);
 
-  // Flush the cache to disk
+  // Wait for the queued events written and flush the cache to disk
   bool Flush();
 
   // close the file
@@ -72,12 +78,26 @@ class EventWriter {
   bool WriteRecord(const std::string &data);
 
  private:
+  void WriterLoop();
+  // write the queued events and stop the writer thread
+  void StopWriter() noexcept;
+
   // True: valid / False: closed
   bool status_ = false;
   std::shared_ptr<FileSystem> fs_;
   std::string filename_;
   WriteFilePtr event_file_;
   int32_t events_write_count_ = 0;
+
+  std::thread writer_thread_;
+  mutable std::mutex mutex_;
+  // notified when an event is queued or the writer is stopped
+  std::condition_variable event_cond_;
+  // notified when the writer thread has written a batch
+  std::condition_variable written_cond_;
+  std::deque<std::string> pending_events_;
+  bool writing_ = false;
+  bool stopped_ = false;
 };
 
 }  // namespace summary
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/timeline.h"
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include "utils/log_adapter.h"
+
+using json = nlohmann::json;
+
+namespace mindspore {
+namespace {
+// the tracks of the host threads are named by their system thread ids, which are unique across the python modules
+std::string ThreadTrack() {
+  thread_local std::string track = "host thread " + std::to_string(syscall(SYS_gettid));
+  return track;
+}
+}  // namespace
+
+uint64_t Timeline::NowUs() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+void Timeline::Start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  spans_.clear();
+  track_ids_.clear();
+  started_ = true;
+}
+
+void Timeline::Stop(const std::string& file_path) {
+  if (!started_.exchange(false)) {
+    return;
+  }
+  if (!file_path.empty() && !Save(file_path)) {
+    MS_LOG(ERROR) << "Save the timeline to " << file_path << " failed.";
+  }
+}
+
+size_t Timeline::TrackId(const std::string& track) {
+  auto iter = track_ids_.find(track);
+  if (iter != track_ids_.end()) {
+    return iter->second;
+  }
+  size_t track_id = track_ids_.size();
+  track_ids_[track] = track_id;
+  return track_id;
+}
+
+void Timeline::Record(const std::string& name, const std::string& category, uint64_t start_us, uint64_t end_us,
+                      const std::string& track) {
+  if (!started()) {
+    return;
+  }
+  auto track_name = track.empty() ? ThreadTrack() : track;
+  std::lock_guard<std::mutex> lock(mutex_);
+  spans_.push_back({name, category, start_us, end_us, TrackId(track_name)});
+}
+
+bool Timeline::Save(const std::string& file_path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto pid = static_cast<int>(getpid());
+  json events = json::array();
+  for (auto& track : track_ids_) {
+    events.push_back(
+      {{"name", "thread_name"}, {"ph", "M"}, {"pid", pid}, {"tid", track.second}, {"args", {{"name", track.first}}}});
+  }
+  // the complete events of the spans, the timestamps and durations are in microseconds
+  for (auto& span : spans_) {
+    events.push_back({{"name", span.name},
+                      {"cat", span.category},
+                      {"ph", "X"},
+                      {"ts", span.start_us},
+                      {"dur", span.end_us - span.start_us},
+                      {"pid", pid},
+                      {"tid", span.track_id}});
+  }
+  std::ofstream file_out(file_path, std::ios::trunc | std::ios::out);
+  if (!file_out.is_open()) {
+    MS_LOG(ERROR) << "Open file " << file_path << " failed.";
+    return false;
+  }
+  file_out << json({{"traceEvents", events}, {"displayTimeUnit", "ms"}}).dump();
+  file_out.close();
+  MS_LOG(INFO) << "Save " << spans_.size() << " spans of the timeline to " << file_path;
+  return true;
+}
+}  // namespace mindspore
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_TIMELINE_H_
+#define MINDSPORE_CCSRC_UTILS_TIMELINE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mindspore {
+// The spans of the host phases and the kernels of all the backends on one steady clock, saved in the Chrome trace
+// format which chrome://tracing and Perfetto open. The spans are recorded while the timeline is started, by the
+// thread which runs them, or on a named track such as the stream of a device.
+class Timeline {
+ public:
+  ~Timeline() = default;
+  Timeline(const Timeline&) = delete;
+  Timeline& operator=(const Timeline&) = delete;
+  static Timeline& GetInstance();
+
+  // the microseconds of the steady clock all the spans are recorded on
+  static uint64_t NowUs();
+
+  // clear the spans recorded so far and record the following ones
+  void Start();
+  // stop recording and save the spans to the file, nothing is saved if the path is empty
+  void Stop(const std::string& file_path);
+  bool started() const { return started_.load(std::memory_order_relaxed); }
+
+  // record a span, on the track of the calling thread if the track is empty
+  void Record(const std::string& name, const std::string& category, uint64_t start_us, uint64_t end_us,
+              const std::string& track = "");
+  bool Save(const std::string& file_path);
+
+ private:
+  Timeline() = default;
+  struct Span {
+    std::string name;
+    std::string category;
+    uint64_t start_us;
+    uint64_t end_us;
+    size_t track_id;
+  };
+  size_t TrackId(const std::string& track);
+
+  std::atomic<bool> started_{false};
+  std::mutex mutex_;
+  std::vector<Span> spans_;
+  std::map<std::string, size_t> track_ids_;
+};
+
+// Record the span from the construction to the destruction, if the timeline is started at the construction.
+class TimelineSpan {
+ public:
+  TimelineSpan(const std::string& name, const std::string& category, const std::string& track = "")
+      : enabled_(Timeline::GetInstance().started()) {
+    if (enabled_) {
+      name_ = name;
+      category_ = category;
+      track_ = track;
+      start_us_ = Timeline::NowUs();
+    }
+  }
+  TimelineSpan(const TimelineSpan&) = delete;
+  TimelineSpan& operator=(const TimelineSpan&) = delete;
+  ~TimelineSpan() {
+    if (enabled_) {
+      Timeline::GetInstance().Record(name_, category_, start_us_, Timeline::NowUs(), track_);
+    }
+  }
+
+ private:
+  bool enabled_;
+  std::string name_;
+  std::string category_;
+  std::string track_;
+  uint64_t start_us_ = 0;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_TIMELINE_H_
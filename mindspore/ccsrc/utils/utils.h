@@ -110,11 +110,17 @@ constexpr auto kResizeNearestNeighborGrad = "ResizeNearestNeighborGrad";
 constexpr auto kFusedMulAddOpName = "FusedMulAdd";
 constexpr auto kFusedMulAddNOpName = "FusedMulAddN";
 constexpr auto kFusedMulApplyMomentumOpName = "FusedMulApplyMomentum";
+constexpr auto kGetNextOpName = "GetNext";
+constexpr auto kFusedElemwiseOpName = "FusedElemwise";
+constexpr auto kFusedApplyMomentumOpName = "FusedApplyMomentum";
+constexpr auto kFusedConv2DBNReluOpName = "FusedConv2DBNRelu";
+constexpr auto kGraphKernelOpName = "GraphKernel";
 
 // attr key name
 constexpr auto kAttrInputNames = "input_names";
 constexpr auto kAttrOutputNames = "output_names";
 constexpr auto kAttrVisited = "visited";
+constexpr auto kAttrRecompute = "recompute";
 constexpr auto kAttrShape = "shape";
 constexpr auto kAttrMomentum = "momentum";
 constexpr auto kAttrEps = "eps";
@@ -140,6 +146,10 @@ constexpr auto kAttrDynInput = "dynamic";
 constexpr auto kAttrDynInputSizes = "dyn_input_sizes";
 constexpr auto kAttrSrcFormat = "src_format";
 constexpr auto kAttrOutputUsedNum = "output_used_num";
+constexpr auto kAttrFusedOps = "fused_ops";
+constexpr auto kAttrFusedOpLhs = "fused_op_lhs";
+constexpr auto kAttrFusedOpRhs = "fused_op_rhs";
+constexpr auto kAttrCompositeJson = "composite_json";
 
 // attr value
 constexpr auto kValueTargetSwitch = "target_switch";
@@ -150,6 +160,8 @@ const size_t kShape4dDims = 4;
 const size_t kShape5dDims = 5;
 const size_t kCubeSize = 16;
 const size_t kMemAlignSize = 512;
+const size_t kMaxFusedElemwiseOpNum = 16;
+const size_t kMaxFusedElemwiseInputNum = 8;
 
 // define special index in special node
 constexpr auto kAnfPrimitiveIndex = 0;
@@ -190,7 +202,7 @@ const std::set<std::string> kOptOpeatorSet = {
   kApplyAdaMaxOpName,    kApplyAddSignOpName,         kApplyCenteredRMSPOpName,
   kApplyFtrlOpName,      kApplyFtrlV2OpName,          kApplyGradientDescentOpName,
   kApplyPowerSignOpName, kApplyProximalAdagradOpName, kApplyProximalGradientDescentOpName,
-  kApplyRMSPropOpName,
+  kApplyRMSPropOpName,   kFusedApplyMomentumOpName,
 };
 
 static inline void ChangeFileMode(const std::string& file_name, mode_t mode) {
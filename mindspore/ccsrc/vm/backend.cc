@@ -22,7 +22,9 @@
 #include "ir/anf.h"
 #include "utils/callbacks.h"
 #include "utils/graph_utils.h"
+#include "utils/timeline.h"
 #include "session/session_factory.h"
+#include "session/anf_runtime_algorithm.h"
 #include "common/utils.h"
 
 namespace mindspore {
@@ -60,6 +62,15 @@ LinConvertResult MsBackend::MsConvert(const AnfNodePtrList &lst) {
   result.inputs = inputs;
   result.outputs = outputs;
   result.graph_id = kInvalidGraphId;
+  // the nodes of a segment are all placed on the same target
+  if (std::any_of(lst.begin(), lst.end(), [this](const AnfNodePtr &node) { return IsCpuNode(node); })) {
+    MS_LOG(INFO) << "Run the segment of " << lst.size() << " nodes on the CPU, the first is " << lst[0]->DebugString();
+    auto graph_id = cpu_sess_->CompileGraph(lst, outputs);
+    result.run = std::make_shared<RunFunc>(
+      [graph_id, this](const VectorRef &args) -> VectorRef { return MsRunGraph(graph_id, args, kCPUDevice); });
+    (void)g_ConvertCache.emplace(lst, result);
+    return result;
+  }
   auto graph_id = sess_->CompileGraph(lst, outputs);
   if (MsContext::GetInstance()->precompile_only()) {
     MS_LOG(INFO) << "PrecompileOnly, stop run graph";
@@ -162,8 +173,9 @@ VectorRef MsBackend::MsSimuRunGraph(const GraphId &g, const VectorRef &args) {
   return VectorRef(outputs);
 }
 
-VectorRef MsBackend::MsRunGraph(const GraphId &g, const VectorRef &args) {
+VectorRef MsBackend::MsRunGraph(const GraphId &g, const VectorRef &args, const std::string &target) {
   MS_LOG(DEBUG) << "start ms graph run:" << args.size() << ", g:" << g;
+  TimelineSpan span("MsRunGraph." + std::to_string(g), "vm");
   // Run graph
   std::vector<tensor::TensorPtr> inputs;
   for (const auto &arg : args) {
@@ -191,7 +203,9 @@ VectorRef MsBackend::MsRunGraph(const GraphId &g, const VectorRef &args) {
 
   VectorRef outputs;
   // call ms rungraph (graphId, input ,output)
-  sess_->RunGraph(g, inputs, &outputs);
+  auto &sess = target == kCPUDevice ? cpu_sess_ : sess_;
+  MS_EXCEPTION_IF_NULL(sess);
+  sess->RunGraph(g, inputs, &outputs);
   MS_LOG(DEBUG) << "RunGraph finished:" << outputs.size();
   return outputs;
 }
@@ -251,6 +265,15 @@ void MsBackend::SimulateRun(FinalVMPtr rt, FuncGraphPtr root) {
   MS_LOG(DEBUG) << "Simulate Eval end";
 }
 
+bool MsBackend::IsCpuNode(const AnfNodePtr &node) const {
+  if (cpu_sess_ == nullptr || is_multi_graph_sink_ || !session::AnfRuntimeAlgorithm::IsRealCNodeKernel(node) ||
+      !IsValueNode<Primitive>(node->cast<CNodePtr>()->input(0))) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  return !sess_->HasKernel(cnode) && cpu_sess_->HasKernel(cnode);
+}
+
 void MsBackend::Link(GraphId graph_id) {
   if (graph_id == kInvalidGraphId) {
     graph_id = sess_->GetFinalRunGraph();
@@ -274,6 +297,12 @@ MsBackend::MsBackend(const std::string &name, const std::string &target, uint32_
   }
   sess_->Init(device_id);
   sess_->RegisterSummaryCallBackFunc(callbacks::SummarySaveCallback);
+  if (target != kCPUDevice) {
+    cpu_sess_ = session::SessionFactory::Get().Create(kCPUDevice);
+    if (cpu_sess_ != nullptr) {
+      cpu_sess_->Init(0);
+    }
+  }
 }
 
 }  // namespace compile
@@ -56,6 +56,8 @@ class Backend {
   virtual LinConvertResult GetMultiGraphRun(const FuncGraphPtr &) { return LinConvertResult(); }
   virtual void SetSimuCondFlag(const BaseRef &, int) {}
   virtual int GetSimuCondFlag(const BaseRef &) { return 0; }
+  // Whether the node runs on the CPU instead of the device, the linear nodes are split into the segments of each.
+  virtual bool IsCpuNode(const AnfNodePtr &) const { return false; }
 
   LinConvertResult multi_result() { return multi_result_; }
   void set_multi_result(const LinConvertResult &value) { multi_result_ = value; }
@@ -89,7 +91,7 @@ class MsBackend : public Backend {
   ~MsBackend() override = default;
 
   LinConvertResult MsConvert(const AnfNodePtrList &lst);
-  VectorRef MsRunGraph(const GraphId &g, const VectorRef &args);
+  VectorRef MsRunGraph(const GraphId &g, const VectorRef &args, const std::string &target = "");
 
   VectorRef MsSimuRunGraph(const GraphId &g, const VectorRef &args);
   void SimulateRun(FinalVMPtr rt, FuncGraphPtr root) override;
@@ -101,9 +103,13 @@ class MsBackend : public Backend {
   LinConvertResult GetMultiGraphRun(const FuncGraphPtr &g) override;
   void SetSimuCondFlag(const BaseRef &c, int flag) override;
   int GetSimuCondFlag(const BaseRef &c) override;
+  // The ops the device has no kernel for run on the CPU if it has one, out of the graphs sunk as a whole.
+  bool IsCpuNode(const AnfNodePtr &node) const override;
 
  private:
   session::SessionPtr sess_;
+  // the session of the segments placed on the CPU, nullptr if the target is the CPU or it is not built in
+  session::SessionPtr cpu_sess_;
   std::unordered_map<BaseRef, CondGraph, BaseRefHash> simu_cond_map_;
   std::unordered_map<GraphId, LinConvertResult> graph_id_map_;
 };
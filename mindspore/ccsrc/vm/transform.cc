@@ -19,12 +19,15 @@
 #include "vm/transform.h"
 
 #include <algorithm>
+#include <deque>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "pipeline/static_analysis/abstract_value.h"
 #include "transform/convert.h"
+#include "session/anf_runtime_algorithm.h"
 #include "utils/graph_utils.h"
 #include "utils/context/ms_context.h"
 #include "debug/trace.h"
@@ -105,7 +108,7 @@ VectorRef CompileGraph::SplitNodes(const FuncGraphPtr& graph) {
     if (IsCut(node)) {
       MS_LOG(DEBUG) << "Cut node:" << node->DebugString(10) << ", size:" << split.size();
       if (split.size() != 0) {
-        splits.push_back(split);
+        AddLinearSplits(split, &splits);
       }
       splits.push_back(node);
       split.clear();
@@ -118,6 +121,73 @@ VectorRef CompileGraph::SplitNodes(const FuncGraphPtr& graph) {
   return splits;
 }
 
+// The nodes are reordered so the ones of the same target are together as long as their inputs are ready, which keeps
+// the segments, and the tensors going between the device and the CPU, few. The nodes which are not real kernels, such
+// as tuple_getitem and depend, go with their first input.
+void CompileGraph::AddLinearSplits(const VectorRef& nodes, VectorRef* splits) {
+  MS_EXCEPTION_IF_NULL(splits);
+  std::vector<AnfNodePtr> node_list;
+  std::unordered_map<AnfNodePtr, bool> on_cpu;
+  bool has_cpu_node = false;
+  for (auto& item : nodes) {
+    auto node = utils::cast<AnfNodePtr>(item);
+    bool cpu = backend_->IsCpuNode(node);
+    auto cnode = node->cast<CNodePtr>();
+    if (!cpu && cnode != nullptr && cnode->size() > 1 && !session::AnfRuntimeAlgorithm::IsRealKernel(node)) {
+      auto iter = on_cpu.find(cnode->input(1));
+      cpu = iter != on_cpu.end() && iter->second;
+    }
+    has_cpu_node = has_cpu_node || cpu;
+    on_cpu[node] = cpu;
+    node_list.push_back(node);
+  }
+  if (!has_cpu_node) {
+    splits->push_back(nodes);
+    return;
+  }
+
+  std::unordered_map<AnfNodePtr, size_t> pending_num;
+  std::unordered_map<AnfNodePtr, std::vector<AnfNodePtr>> users;
+  for (auto& node : node_list) {
+    pending_num[node] = 0;
+    if (!node->isa<CNode>()) {
+      continue;
+    }
+    for (auto& input : node->cast<CNodePtr>()->inputs()) {
+      if (on_cpu.count(input) != 0) {
+        pending_num[node]++;
+        users[input].push_back(node);
+      }
+    }
+  }
+  // the ready nodes of the device and of the CPU
+  std::deque<AnfNodePtr> ready[2];
+  for (auto& node : node_list) {
+    if (pending_num[node] == 0) {
+      ready[on_cpu[node]].push_back(node);
+    }
+  }
+  bool cpu = on_cpu[node_list[0]];
+  VectorRef split;
+  while (!ready[0].empty() || !ready[1].empty()) {
+    if (ready[cpu].empty()) {
+      MS_LOG(DEBUG) << "Split the " << (cpu ? "CPU" : "device") << " segment of size:" << split.size();
+      splits->push_back(split);
+      split.clear();
+      cpu = !cpu;
+    }
+    auto node = ready[cpu].front();
+    ready[cpu].pop_front();
+    split.push_back(node);
+    for (auto& user : users[node]) {
+      if (--pending_num[user] == 0) {
+        ready[on_cpu[user]].push_back(user);
+      }
+    }
+  }
+  splits->push_back(split);
+}
+
 // Push the value node on the stack.
 void CompileGraph::Push(const AnfNodePtr& node) {
   MS_EXCEPTION_IF_NULL(node);
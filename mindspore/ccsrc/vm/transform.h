@@ -80,6 +80,8 @@ class CompileGraph {
 
  private:
   void PushParameters(const FuncGraphPtr& func_graph);
+  // Add the linear nodes as the segments of the device and of the CPU.
+  void AddLinearSplits(const VectorRef& nodes, VectorRef* splits);
   bool SplitGraph(const FuncGraphPtr& func_graph);
   int LinConvert(const FuncGraphPtr& func_graph, const AnfNodePtrList& node_list);
   int InterpretNode(const FuncGraphPtr& func_graph, const CNodePtr& node);
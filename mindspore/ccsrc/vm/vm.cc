@@ -19,6 +19,7 @@
 #include "vm/vm.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "vm/vmimpl.h"
 #include "vm/backend.h"
@@ -28,6 +29,22 @@
 namespace mindspore {
 namespace compile {
 
+const FinalVM::InstFunction FinalVM::inst_functions_[Instruction::kInstNum] = {
+  &FinalVM::InstCall,          // kCall
+  &FinalVM::InstTailCall,      // kTailCall
+  &FinalVM::InstReturn,        // kReturn
+  &FinalVM::InstPartial,       // kPartial
+  &FinalVM::InstSwitch,        // kSwitch
+  &FinalVM::InstSwitchReturn,  // kSwitchReturn
+  &FinalVM::InstTuple,         // kTuple
+  &FinalVM::InstInput,         // kInput
+  &FinalVM::InstExternal,      // kExternal
+  &FinalVM::InstPush,          // kPush
+  &FinalVM::InstPushPrim,      // kPrim
+  nullptr,                     // kGraph, replaced by kPush when linked
+  &FinalVM::InstPadStack,      // kPadStack
+};
+
 // Initialize StructPartial.
 // Arguments:
 //   fn_: Callable function.
@@ -70,6 +87,81 @@ FinalVM::FinalVM(const InstSet& insts, const BackendPtr& backend) : insts_(insts
   MS_LOG(DEBUG) << "InstSet size:" << insts_.size();
   insts_stack_.emplace_back(BaseRef());
   retp_.push(-1);
+  InitDirectRun();
+}
+
+void FinalVM::InitDirectRun() {
+  direct_run_ = nullptr;
+  direct_arg_indexes_.clear();
+  // The instructions of the graph are an optional pad of the stack, the external function and the return of its
+  // last output.
+  size_t pc = 0;
+  if (pc < insts_.size() && insts_[pc].first == Instruction::kPadStack) {
+    ++pc;
+  }
+  if (pc + 1 >= insts_.size() || insts_[pc].first != Instruction::kExternal ||
+      insts_[pc + 1].first != Instruction::kReturn) {
+    return;
+  }
+  const auto &external = insts_[pc].second;
+  const auto &ret = insts_[pc + 1].second;
+  if (external.size() < 2 || !utils::isa<RunFunctionRef>(external[0]) || ret.empty() || !utils::isa<int>(ret[0]) ||
+      utils::cast<int>(ret[0]) != -1) {
+    return;
+  }
+  std::vector<size_t> indexes;
+  indexes.reserve(external.size() - 2);
+  for (size_t i = 2; i < external.size(); ++i) {
+    if (!utils::isa<int>(external[i])) {
+      return;
+    }
+    // Nothing is pushed before the function, so the args pushed in reverse are referred to by -1 for the first one,
+    // -2 for the second one and so on.
+    int index = -1 - utils::cast<int>(external[i]);
+    if (index < 0) {
+      return;
+    }
+    indexes.push_back(IntToSize(index));
+  }
+  auto fn = utils::cast<RunFunctionRef>(external[0]).func_;
+  if (fn == nullptr || !(*fn)) {
+    return;
+  }
+  direct_run_ = fn;
+  direct_arg_indexes_ = std::move(indexes);
+  MS_LOG(DEBUG) << "The graph is run directly by " << direct_arg_indexes_.size() << " inputs";
+}
+
+// The same values as Eval pushing the args and Ref reading them from the stack.
+BaseRef FinalVM::DirectEval(const VectorRef& args) {
+  VectorRef tuple;
+  tuple.elements().reserve(direct_arg_indexes_.size());
+  for (auto index : direct_arg_indexes_) {
+    if (index >= args.size()) {
+      MS_LOG(EXCEPTION) << "IndexError: index(" << index << ") out of range [0, " << args.size() << ").";
+    }
+    const auto &arg = args[index];
+    if (utils::isa<PyObjectRef>(arg)) {
+      py::object value = utils::cast<PyObjectRef>(arg).object_;
+      if (py::isinstance<py::bool_>(value)) {
+        tuple.push_back(static_cast<int>(py::cast<bool>(value)));
+      } else {
+        tuple.push_back(parse::data_converter::PyDataToValue(value));
+      }
+      continue;
+    }
+    tuple.push_back(arg);
+  }
+
+  auto outs = (*direct_run_)(tuple);
+  if (outs.empty()) {
+    MS_LOG(EXCEPTION) << "The graph run directly has no output";
+  }
+  const auto &out = outs[outs.size() - 1];
+  if (utils::isa<PyObjectRef>(out)) {
+    return parse::data_converter::PyDataToValue(utils::cast<PyObjectRef>(out).object_);
+  }
+  return out;
 }
 
 void FinalVM::Push(const BaseRef& v) {
@@ -156,7 +248,7 @@ void FinalVM::DoJmp(const BaseRef& jmp_orig) {
   if (utils::isa<StructPartial>(jmp)) {  // need to inherit from Base
     MS_LOG(DEBUG) << "Start jump StructPartial";
     auto new_jmp = utils::cast<std::shared_ptr<StructPartial>>(jmp);
-    auto args = new_jmp->args_;
+    const auto &args = new_jmp->args_;
     InstPadStack(VectorRef(std::vector<BaseRef>{static_cast<int>(args.size())}));
     auto iter = args.rbegin();
     for (; iter != args.rend(); ++iter) {
@@ -175,9 +267,13 @@ void FinalVM::DoJmp(const BaseRef& jmp_orig) {
 
 BaseRef FinalVM::Eval(const VectorRef& args) {
   MS_LOG(DEBUG) << "Start: " << args.size();
+  // the simulation of the graphs sunk as a whole runs their instructions
+  if (direct_run_ != nullptr && (backend_ == nullptr || !backend_->simu_flag())) {
+    return DirectEval(args);
+  }
   insts_stack_.clear();
   insts_stack_.resize(args.size());
-  std::stack<int>().swap(retp_);
+  std::stack<int, std::vector<int>>().swap(retp_);
   retp_.push(-1);
   pc_ = 0;
   sp_ = 0;
@@ -197,15 +293,15 @@ BaseRef FinalVM::Eval(const VectorRef& args) {
   }
 
   while (pc_ >= 0) {
-    auto inst = insts_[IntToSize(pc_)];
+    // the instructions aren't changed by an eval, they're run without the copy of their args
+    const auto &inst = insts_[IntToSize(pc_)];
     MS_LOG(DEBUG) << "Loop " << insts_.size() << ", pc:" << pc_ << ", inst:" << inst_str[inst.first];
     ++pc_;
-    auto iter = inst_function_map.find(inst.first);
-    if (iter != inst_function_map.end()) {
-      iter->second(inst.second);
-    } else {
+    InstFunction func = inst.first < Instruction::kInstNum ? inst_functions_[inst.first] : nullptr;
+    if (func == nullptr) {
       MS_LOG(EXCEPTION) << "Unknown instruction {" << inst_str[inst.first] << "}";
     }
+    (this->*func)(inst.second);
   }
 
   MS_LOG(DEBUG) << "End";
@@ -404,6 +500,7 @@ void FinalVM::InstSwitch(const VectorRef& args) {
 void FinalVM::InstTuple(const VectorRef& args) {
   MS_LOG(DEBUG) << "Start";
   VectorRef tuple;
+  tuple.elements().reserve(args.size());
   auto iter = args.begin();
   for (; iter != args.end(); ++iter) {
     auto a = utils::cast<int>(*iter);
@@ -479,6 +576,7 @@ void FinalVM::InstExternal(const VectorRef& args) {
     auto simu_run_ref = utils::cast<RunFunctionRef>(args[1]);
     fn = simu_run_ref.func_;
   }
+  tuple.elements().reserve(args.size());
   for (size_t i = 2; i < args.size(); ++i) {
     auto index = utils::cast<int>(args[i]);
     tuple.push_back(Ref(index));
@@ -26,7 +26,6 @@
 #include <tuple>
 #include <utility>
 #include <vector>
-#include <deque>
 #include "utils/base_ref.h"
 
 namespace mindspore {
@@ -48,12 +47,12 @@ enum Instruction {
   kPush,
   kPrim,
   kGraph,
-  kPadStack
+  kPadStack,
+  kInstNum
 };
 
 using InstType = std::pair<Instruction, VectorRef>;
 using InstSet = std::vector<InstType>;
-using InstFunctionMap = std::map<Instruction, std::function<void(const VectorRef&)>>;
 
 const std::vector<std::string> inst_str{"call",  "tail_call", "return", "partial",   "switch", "switch_return", "tuple",
                                         "input", "external",  "push",   "primitive", "graph",  "pad_stack"};
@@ -108,7 +107,10 @@ class FinalVM {
   void InstExternal(const VectorRef& args);
   void InstPushPrim(const VectorRef& args);
   void InstSwitchReturn(const VectorRef& args);
-  void set_insts(const InstSet& value) { insts_ = value; }
+  void set_insts(const InstSet& value) {
+    insts_ = value;
+    InitDirectRun();
+  }
 
  protected:
   BaseRef Ref(int i);
@@ -122,27 +124,26 @@ class FinalVM {
   void DoJmp(const BaseRef& jmp);
 
  private:
+  // Find out whether the graph run is one external function returning its output, as the graph of one segment or
+  // the graph sunk as a whole, then it's run with the args bound to the inputs of the function, without the stack.
+  void InitDirectRun();
+  BaseRef DirectEval(const VectorRef& args);
+
+  using InstFunction = void (FinalVM::*)(const VectorRef&);
+  // The functions of the instructions indexed by them, nullptr for the ones not run by the vm
+  static const InstFunction inst_functions_[Instruction::kInstNum];
+
   InstSet insts_;
-  std::deque<BaseRef> insts_stack_;
-  std::stack<int> retp_;
-  std::stack<int> retsp_;
+  // The value stack keeps its capacity through the evals
+  std::vector<BaseRef> insts_stack_;
+  std::stack<int, std::vector<int>> retp_;
+  std::stack<int, std::vector<int>> retsp_;
   int pc_;
   int sp_;
   BackendPtr backend_;
-  const InstFunctionMap inst_function_map = {
-    {Instruction::kCall, [this](const VectorRef& args) { InstCall(args); }},
-    {Instruction::kTailCall, [this](const VectorRef& args) { InstTailCall(args); }},
-    {Instruction::kReturn, [this](const VectorRef& args) { InstReturn(args); }},
-    {Instruction::kPartial, [this](const VectorRef& args) { InstPartial(args); }},
-    {Instruction::kSwitch, [this](const VectorRef& args) { InstSwitch(args); }},
-    {Instruction::kTuple, [this](const VectorRef& args) { InstTuple(args); }},
-    {Instruction::kPush, [this](const VectorRef& args) { InstPush(args); }},
-    {Instruction::kInput, [this](const VectorRef& args) { InstInput(args); }},
-    {Instruction::kPadStack, [this](const VectorRef& args) { InstPadStack(args); }},
-    {Instruction::kExternal, [this](const VectorRef& args) { InstExternal(args); }},
-    {Instruction::kPrim, [this](const VectorRef& args) { InstPushPrim(args); }},
-    {Instruction::kSwitchReturn, [this](const VectorRef& args) { InstSwitchReturn(args); }},
-  };
+  // The function of the graph run directly, and the indexes of the args which are its inputs
+  RunFuncPtr direct_run_;
+  std::vector<size_t> direct_arg_indexes_;
 };
 
 using FinalVMPtr = std::shared_ptr<FinalVM>;
@@ -492,6 +492,10 @@ class _Executor:
             return None
         return self._executor.get_func_graph_proto(exec_id, ir_type)
 
+    def _export_onnx(self, exec_id, file_name, external_data=False):
+        """Export the graph to an ONNX model file, with its parameters in a side file if `external_data` is True."""
+        self._executor.export_onnx(exec_id, file_name, external_data)
+
     def export(self, net, file_name, file_format='GEIR'):
         """
         Export graph.
@@ -125,6 +125,7 @@ class Parameter:
             shape = self.default_input.shape()
             dtype = self.default_input.dtype()
             x.default_input = initializer(init, shape=shape, dtype=dtype)
+            x.checkpoint_digest = None
 
         x.clone_info = copy(self.clone_info)
         _set_clone_info(self.clone_info, x.clone_info)
@@ -162,6 +163,8 @@ class Parameter:
                 # make a copy of Tensor to init the parameter
                 data = Tensor(data.asnumpy().copy())
             self.default_input = data
+            # the digest of the checkpoint file the data is loaded from, which load_param_into_net sets
+            self.checkpoint_digest = None
         else:
             raise ValueError("Parameter data must be tensor or number.")
 
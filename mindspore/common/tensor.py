@@ -32,7 +32,8 @@ class Tensor(Tensor_):
     in C++ side and some functions are implemented in Python layer.
 
     Args:
-        input_data (Tensor, float, int, bool, tuple, list, numpy.ndarray): Input data of the tensor.
+        input_data (Tensor, float, int, bool, tuple, list, numpy.ndarray): Input data of the tensor. A contiguous
+            numpy.ndarray is not copied if `dtype` is None or its data type, the tensor shares its memory instead.
         dtype (:class:`mindspore.dtype`): Should be None, bool or numeric type defined in `mindspore.dtype`.
             The argument is used to define the data type of the output tensor. If it is None, the data type of the
             output tensor will be as same as the `input_data`. Default: None.
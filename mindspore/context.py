@@ -231,6 +231,108 @@ class _Context:
     def enable_mem_reuse(self, enable_mem_reuse):
         self._context_handle.set_enable_mem_reuse(enable_mem_reuse)
 
+    @property
+    def enable_recompute(self):
+        return self._context_handle.get_enable_recompute()
+
+    @enable_recompute.setter
+    def enable_recompute(self, enable_recompute):
+        self._context_handle.set_enable_recompute(enable_recompute)
+
+    @property
+    def enable_mem_swap(self):
+        return self._context_handle.get_enable_mem_swap()
+
+    @enable_mem_swap.setter
+    def enable_mem_swap(self, enable_mem_swap):
+        self._context_handle.set_enable_mem_swap(enable_mem_swap)
+
+    @property
+    def enable_cuda_graph(self):
+        return self._context_handle.get_enable_cuda_graph()
+
+    @enable_cuda_graph.setter
+    def enable_cuda_graph(self, enable_cuda_graph):
+        self._context_handle.set_enable_cuda_graph(enable_cuda_graph)
+
+    @property
+    def enable_graph_kernel(self):
+        return self._context_handle.get_enable_graph_kernel()
+
+    @enable_graph_kernel.setter
+    def enable_graph_kernel(self, enable_graph_kernel):
+        self._context_handle.set_enable_graph_kernel(enable_graph_kernel)
+
+    @property
+    def enable_graph_static_memory(self):
+        return self._context_handle.get_enable_graph_static_memory()
+
+    @enable_graph_static_memory.setter
+    def enable_graph_static_memory(self, enable_graph_static_memory):
+        self._context_handle.set_enable_graph_static_memory(enable_graph_static_memory)
+
+    @property
+    def enable_gpu_multi_stream(self):
+        return self._context_handle.get_enable_gpu_multi_stream()
+
+    @enable_gpu_multi_stream.setter
+    def enable_gpu_multi_stream(self, enable_gpu_multi_stream):
+        self._context_handle.set_enable_gpu_multi_stream(enable_gpu_multi_stream)
+
+    @property
+    def enable_branch_streams(self):
+        return self._context_handle.get_enable_branch_streams()
+
+    @enable_branch_streams.setter
+    def enable_branch_streams(self, enable_branch_streams):
+        self._context_handle.set_enable_branch_streams(enable_branch_streams)
+
+    @property
+    def enable_pynative_async(self):
+        return self._context_handle.get_enable_pynative_async()
+
+    @enable_pynative_async.setter
+    def enable_pynative_async(self, enable_pynative_async):
+        self._context_handle.set_enable_pynative_async(enable_pynative_async)
+
+    @property
+    def enable_shape_respecialize(self):
+        return self._context_handle.get_enable_shape_respecialize()
+
+    @enable_shape_respecialize.setter
+    def enable_shape_respecialize(self, enable_shape_respecialize):
+        self._context_handle.set_enable_shape_respecialize(enable_shape_respecialize)
+
+    @property
+    def cpu_inter_op_threads(self):
+        return self._context_handle.get_cpu_inter_op_threads()
+
+    @cpu_inter_op_threads.setter
+    def cpu_inter_op_threads(self, cpu_inter_op_threads):
+        if cpu_inter_op_threads < 1 or cpu_inter_op_threads > 256:
+            raise ValueError("Cpu inter op threads must be in [1, 256], but got {}".format(cpu_inter_op_threads))
+        self._context_handle.set_cpu_inter_op_threads(cpu_inter_op_threads)
+
+    @property
+    def cpu_int8_calibration_steps(self):
+        return self._context_handle.get_cpu_int8_calibration_steps()
+
+    @cpu_int8_calibration_steps.setter
+    def cpu_int8_calibration_steps(self, cpu_int8_calibration_steps):
+        if cpu_int8_calibration_steps < 0:
+            raise ValueError("Cpu int8 calibration steps must be >= 0, but got {}".format(cpu_int8_calibration_steps))
+        self._context_handle.set_cpu_int8_calibration_steps(cpu_int8_calibration_steps)
+
+    @property
+    def max_device_models(self):
+        return self._context_handle.get_max_device_models()
+
+    @max_device_models.setter
+    def max_device_models(self, max_device_models):
+        if max_device_models < 0:
+            raise ValueError("Max device models must be >= 0, but got {}".format(max_device_models))
+        self._context_handle.set_max_device_models(max_device_models)
+
     @property
     def save_ms_model(self):
         return self._context_handle.get_save_ms_model_flag()
@@ -247,6 +349,14 @@ class _Context:
     def save_ms_model_path(self, save_ms_model_path):
         self._context_handle.set_save_ms_model_path(save_ms_model_path)
 
+    @property
+    def save_ms_model_fp16(self):
+        return self._context_handle.get_save_ms_model_fp16_flag()
+
+    @save_ms_model_fp16.setter
+    def save_ms_model_fp16(self, save_ms_model_fp16_flag):
+        self._context_handle.set_save_ms_model_fp16_flag(save_ms_model_fp16_flag)
+
     @property
     def enable_gpu_summary(self):
         return self._context_handle.get_enable_gpu_summary()
@@ -287,6 +397,30 @@ class _Context:
     def save_dump_path(self, save_dump_path):
         self._context_handle.set_save_dump_path(save_dump_path)
 
+    @property
+    def enable_timeline(self):
+        return self._context_handle.get_enable_timeline()
+
+    @enable_timeline.setter
+    def enable_timeline(self, enable_timeline):
+        self._context_handle.set_enable_timeline(enable_timeline)
+
+    @property
+    def save_timeline_path(self):
+        return self._context_handle.get_save_timeline_path()
+
+    @save_timeline_path.setter
+    def save_timeline_path(self, save_timeline_path):
+        self._context_handle.set_save_timeline_path(save_timeline_path)
+
+    @property
+    def enable_step_stats(self):
+        return self._context_handle.get_enable_step_stats()
+
+    @enable_step_stats.setter
+    def enable_step_stats(self, enable_step_stats):
+        self._context_handle.set_enable_step_stats(enable_step_stats)
+
     @property
     def reserve_class_name_in_scope(self):
         """Gets whether to save the network class name in the scope."""
@@ -377,7 +511,9 @@ def _context():
 
 
 @args_type_check(device_num=int, global_rank=int, mirror_mean=bool, cast_before_mirror=bool, parallel_mode=str,
-                 parameter_broadcast=bool)
+                 parameter_broadcast=bool, enable_parallel_optimizer=bool, enable_hierarchical_allreduce=bool,
+                 devices_per_node=int, gradient_compression=str, topk_compression_ratio=float,
+                 enable_alltoall=bool)
 def set_auto_parallel_context(**kwargs):
     """
     Set auto parallel context.
@@ -406,6 +542,25 @@ def set_auto_parallel_context(**kwargs):
         parameter_broadcast (bool): Indicating whether to broadcast parameters before training.
                        "stand_alone", "semi_auto_parallel" and "auto_parallel" do not support parameter
                        broadcast. Default: False.
+        enable_parallel_optimizer (bool): Whether to shard the optimizer states across the devices in data
+                       parallel. The gradients are reduce-scattered, each device updates its slice of the
+                       parameters, and the slices are all-gathered. Only AdamWeightDecay and
+                       AdamWeightDecayDynamicLR support it. Default: False.
+        enable_hierarchical_allreduce (bool): Whether to all-reduce the gradients hierarchically on multi-node
+                       jobs: reduce-scatter in each node, all-reduce the slices across the nodes, and all-gather
+                       in each node. Only hccl supports it, the other backends keep the flat allreduce.
+                       Default: False.
+        devices_per_node (int): The number of devices in a node, which hold consecutive ranks, the value must be
+                       in [1, 4096]. Default: 8.
+        gradient_compression (str): The compression of the gradients all-reduced in data parallel. "fp16"
+                       all-reduces them in float16, and "topk" all-gathers the largest elements of each gradient
+                       with their indices. The compression error is kept on device and added to the gradients of
+                       the next step. Default: "none".
+        topk_compression_ratio (float): The ratio of the elements of each gradient kept by the "topk"
+                       compression, the value must be in (0, 1]. Default: 0.01.
+        enable_alltoall (bool): Whether to redistribute the tensors between the operators by all-to-all, where
+                       a dimension would be all-gathered and another one split along the same devices.
+                       Default: False.
 
     Raises:
         ValueError: If input key is not attribute in auto parallel context.
@@ -417,6 +572,9 @@ def set_auto_parallel_context(**kwargs):
         >>> context.set_auto_parallel_context(cast_before_mirror=False)
         >>> context.set_auto_parallel_context(parallel_mode="auto_parallel")
         >>> context.set_auto_parallel_context(parameter_broadcast=False)
+        >>> context.set_auto_parallel_context(enable_parallel_optimizer=True)
+        >>> context.set_auto_parallel_context(enable_hierarchical_allreduce=True, devices_per_node=8)
+        >>> context.set_auto_parallel_context(gradient_compression="topk", topk_compression_ratio=0.01)
     """
     _set_auto_parallel_context(**kwargs)
 
@@ -447,6 +605,12 @@ def reset_auto_parallel_context():
     - cast_before_mirror: True.
     - parallel_mode: "stand_alone".
     - parameter_broadcast: False.
+    - enable_parallel_optimizer: False.
+    - enable_hierarchical_allreduce: False.
+    - devices_per_node: 8.
+    - gradient_compression: "none".
+    - topk_compression_ratio: 0.01.
+    - enable_alltoall: False.
     """
     _reset_auto_parallel_context()
 
@@ -454,10 +618,16 @@ def reset_auto_parallel_context():
 @args_type_check(mode=int, precompile_only=bool, device_target=str,
                  device_id=int, enable_ir_fusion=bool, save_graphs=bool, enable_hccl=bool,
                  enable_task_sink=bool, save_graphs_path=str, enable_loop_sink=bool,
-                 enable_mem_reuse=bool, save_ms_model=bool, save_ms_model_path=str, enable_gpu_summary=bool,
-                 enable_auto_mixed_precision=bool, enable_dump=bool, save_dump_path=str,
-                 enable_reduce_precision=bool, enable_dynamic_memory=bool, graph_memory_max_size=str,
-                 variable_memory_max_size=str)
+                 enable_mem_reuse=bool, enable_recompute=bool, enable_mem_swap=bool, enable_cuda_graph=bool,
+                 enable_graph_kernel=bool, enable_graph_static_memory=bool, enable_gpu_multi_stream=bool, enable_branch_streams=bool,
+                 enable_pynative_async=bool,
+                 enable_shape_respecialize=bool, save_ms_model=bool, save_ms_model_fp16=bool,
+                 save_ms_model_path=str, cpu_inter_op_threads=int, cpu_int8_calibration_steps=int,
+                 max_device_models=int, enable_gpu_summary=bool, enable_auto_mixed_precision=bool, enable_dump=bool,
+                 save_dump_path=str,
+                 enable_timeline=bool, save_timeline_path=str, enable_step_stats=bool, enable_reduce_precision=bool,
+                 enable_dynamic_memory=bool,
+                 graph_memory_max_size=str, variable_memory_max_size=str)
 def set_context(**kwargs):
     """
     Set context for running environment.
@@ -486,11 +656,54 @@ def set_context(**kwargs):
         enable_ir_fusion (bool): Whether to enable ir fusion. Default: True.
         save_graphs (bool): Whether to save graphs. Default: False.
         enable_hccl (bool): Whether to enable hccl. Default: False.
-        enable_loop_sink (bool): Whether to enable loop sink. Default: False.
+        enable_loop_sink (bool): Whether to enable loop sink. On GPU the steps of an epoch with the dataset sink
+                    mode are run by one run of the graph, the data of each step is fetched by GetNext. Default: False.
         enable_task_sink (bool): Whether to enable task sink. Default: True.
         enable_mem_reuse (bool): Whether to enable memory reuse. Default: True.
+        enable_recompute (bool): Whether to recompute the cheap forward operators in the backward graph instead of
+                    keeping their outputs, the operators of the cells marked by `Cell.recompute` are always
+                    recomputed. Default: False.
+        enable_mem_swap (bool): Whether to swap the long lived tensors to the host memory while they are not used,
+                    it only works with the memory reuse and without the task sink. Default: False.
+        enable_cuda_graph (bool): Whether to capture the kernels of a graph into a CUDA graph at its second run and
+                    replay it in the later runs, it only works on GPU with the static memory of the graphs, that is
+                    without the dynamic memory or with `enable_graph_static_memory`. Default: False.
+        enable_graph_kernel (bool): Whether to expand GeLU into basic operators and fuse the connected basic
+                    operators compiled by AKG into one AKG kernel of the subgraph, it only works on GPU with
+                    `enable_ir_fusion`. Default: False.
+        enable_graph_static_memory (bool): Whether to plan the memory of the graphs statically with the memory reuse
+                    when the dynamic memory is enabled on GPU, the memory of each graph is then taken from the dynamic
+                    memory pool once, and the single operators still use the pool. Default: False.
+        enable_gpu_multi_stream (bool): Whether to launch the independent branches of the graphs on several CUDA
+                    streams, it only works on GPU with the dynamic memory of the kernels. Default: False.
+        enable_branch_streams (bool): Whether to run the long branches off the critical path of the task sink graphs
+                    on streams of their own on Ascend, the events are only inserted for the dependencies across the
+                    streams which are not already ordered by others. The memory of the branch streams is not reused
+                    by the other streams. Default: False.
+        enable_pynative_async (bool): Whether to return from the operators of PYNATIVE_MODE once their kernels are
+                    launched, the host then runs ahead of the device. The outputs are waited for when they're read
+                    on the host by `asnumpy`, the errors of the kernels are raised there. It only works on GPU.
+                    Default: False.
+        enable_shape_respecialize (bool): Whether to compile a network called with the inputs of new shapes by
+                    inferring the shapes of the graph optimized for the earlier shapes again, instead of running all
+                    the passes again. The graphs whose compile depends on the values of the shapes, e.g. by `Shape`,
+                    `Size` or `len` of the tensors, are compiled in full. It only works on the graphs of the VM
+                    backend out of the auto parallel. Default: False.
+        cpu_inter_op_threads (int): The number of threads running the independent kernels of the graphs at the same
+                    time on CPU, in [1, 256]. The memory of the kernels is not reused when it's more than 1, as the
+                    reuse follows the execution order. Default: 1.
+        cpu_int8_calibration_steps (int): The number of launches running Conv2D and MatMul in float on CPU to get
+                    the ranges of their inputs, they run in int8 after that. It's for the inference of the graphs
+                    whose weights are not updated, as they're quantized once. 0 keeps them in float. Default: 0.
+        max_device_models (int): The max number of the task sink models of the graphs kept loaded on Ascend, the
+                    least recently run ones are unloaded beyond it and loaded again from their kept tasks when they
+                    run. The models are also unloaded when a model fails to load for the device memory. 0 keeps all
+                    of them loaded. Default: 0.
         save_ms_model (bool): Whether to save model converted by graph. Default: False.
         save_ms_model_path (str): Path to save converted model. Default: "."
+        save_ms_model_fp16 (bool): Whether to save the converted model in float16 for the ARMv8.2 devices, its float
+                    weights and tensors are cast to float16, while its inputs and outputs stay float32 for the
+                    caller of the predict runtime. Default: False.
         enable_gpu_summary (bool): Whether to enable gpu summary. Default: True.
         save_graphs_path (str): Path to save graphs. Default: "."
         enable_auto_mixed_precision (bool): Whether to enable auto mixed precision. Default: True.
@@ -498,6 +711,13 @@ def set_context(**kwargs):
         enable_reduce_precision (bool): Whether to enable precision reduction. Default: True.
         enable_dump (bool): Whether to enable dump. Default: False.
         save_dump_path (str): Set path to dump data. Default: ".".
+        enable_timeline (bool): Whether to record the timeline of the host phases and the kernels of the backends.
+                    Enabling it clears the timeline, disabling it saves the timeline recorded in between to
+                    save_timeline_path in the Chrome trace format. Default: False.
+        save_timeline_path (str): Set path to save the timeline. Default: "./timeline.json".
+        enable_step_stats (bool): Whether to record the time of the steps by data wait, host dispatch, device compute,
+                    communication and optimizer. The kernels are synchronized one by one to time them, so the steps
+                    run slower. Enabling it clears the steps recorded. Default: False.
         enable_dynamic_memory (bool): Whether to enable dynamic memory. Default: False.
         graph_memory_max_size (str): Set graph memory max size. Default: "26GB".
         variable_memory_max_size (str): Set variable memory max size. Default: "5GB".
@@ -517,8 +737,12 @@ def set_context(**kwargs):
         >>> context.set_context(save_ms_model=True, save_ms_model_path=".")
         >>> context.set_context(enable_gpu_summary=False)
         >>> context.set_context(enable_dump=False, save_dump_path=".")
+        >>> context.set_context(save_timeline_path="./timeline.json", enable_timeline=True)
         >>> context.set_context(reserve_class_name_in_scope=True)
         >>> context.set_context(enable_dynamic_memory=True)
+        >>> context.set_context(cpu_inter_op_threads=4)
+        >>> context.set_context(cpu_int8_calibration_steps=10)
+        >>> context.set_context(max_device_models=4)
         >>> context.set_context(graph_memory_max_size="25GB")
         >>> context.set_context(variable_memory_max_size="6GB")
         >>> context.set_context(mode=context.GRAPH_MODE,
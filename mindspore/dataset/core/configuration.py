@@ -16,12 +16,21 @@
 The configuration manager.
 """
 
+import re
+
 import mindspore._c_dataengine as cde
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
 
 
+def _is_cpu_list(cpus):
+    """Checks a cpu list in the format of the kernel, e.g. 0-3,8,10-11."""
+    if not isinstance(cpus, str) or not cpus:
+        return False
+    return re.fullmatch(r"\d+(-\d+)?(,\d+(-\d+)?)*", cpus) is not None
+
+
 class ConfigurationManager:
     """The configuration manager"""
 
@@ -57,6 +66,35 @@ class ConfigurationManager:
         """
         return self.config.get_seed()
 
+    def set_rows_per_buffer(self, rows):
+        """
+        Set the number of rows the source operators put in each buffer. The rows of a buffer move through the
+        pipeline together, e.g. a map with batched_pyfunc calls its Python functions once per buffer.
+
+        Args:
+            rows (int): number of rows per buffer.
+
+        Raises:
+            ValueError: If rows is invalid (<= 0 or > MAX_INT_32).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> con.set_rows_per_buffer(64)
+        """
+        if rows <= 0 or rows > INT32_MAX:
+            raise ValueError("Rows per buffer given is not within the required range")
+        self.config.set_rows_per_buffer(rows)
+
+    def get_rows_per_buffer(self):
+        """
+        Get the number of rows the source operators put in each buffer.
+
+        Returns:
+            Int, number of rows per buffer.
+        """
+        return self.config.get_rows_per_buffer()
+
     def set_prefetch_size(self, size):
         """
         Set the number of rows to be prefetched.
@@ -115,6 +153,219 @@ class ConfigurationManager:
         """
         return self.config.get_num_parallel_workers()
 
+    def set_lock_free_connector(self, lock_free):
+        """
+        Set whether the connectors between dataset operators are lock free by default.
+
+        Args:
+            lock_free (bool): True to use lock free ring buffers instead of blocking queues.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> con.set_lock_free_connector(True)
+        """
+        if not isinstance(lock_free, bool):
+            raise TypeError("lock_free should be a boolean")
+        self.config.set_lock_free_connector(lock_free)
+
+    def get_lock_free_connector(self):
+        """
+        Get whether the connectors between dataset operators are lock free by default.
+
+        Returns:
+            Bool, True if lock free ring buffers are used.
+        """
+        return self.config.get_lock_free_connector()
+
+    def set_profiling_interval(self, interval):
+        """
+        Set the sampling interval of the pipeline profiler. Pipelines launched afterwards are profiled.
+
+        Args:
+            interval (int): sampling interval in milliseconds, 0 turns the profiling off.
+
+        Raises:
+            ValueError: If interval is invalid (< 0 or > MAX_INT_32).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # sample every operator of the pipeline each 100 milliseconds.
+            >>> con.set_profiling_interval(100)
+        """
+        if interval < 0 or interval > INT32_MAX:
+            raise ValueError("Profiling interval given is not within the required range")
+        self.config.set_profiling_interval(interval)
+
+    def get_profiling_interval(self):
+        """
+        Get the sampling interval of the pipeline profiler.
+
+        Returns:
+            Int, sampling interval in milliseconds, 0 if the profiling is off.
+        """
+        return self.config.get_profiling_interval()
+
+    def set_auto_tune(self, auto_tune, interval=None):
+        """
+        Set whether the pipelines launched afterwards tune their worker counts and connector sizes during the
+        first epoch. The num_parallel_workers of an operator is the upper bound of its active workers.
+
+        Args:
+            auto_tune (bool): True to turn the auto tune on.
+            interval (int, optional): sampling interval in milliseconds (default=None, keep the current one).
+
+        Raises:
+            ValueError: If interval is invalid (<= 0 or > MAX_INT_32).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> con.set_auto_tune(True)
+        """
+        if not isinstance(auto_tune, bool):
+            raise TypeError("auto_tune should be a boolean")
+        if interval is not None:
+            if interval <= 0 or interval > INT32_MAX:
+                raise ValueError("Auto tune interval given is not within the required range")
+            self.config.set_auto_tune_interval(interval)
+        self.config.set_auto_tune(auto_tune)
+
+    def get_auto_tune(self):
+        """
+        Get whether the worker counts and connector sizes are tuned during the first epoch.
+
+        Returns:
+            Bool, True if the auto tune is on.
+        """
+        return self.config.get_auto_tune()
+
+    def set_worker_scratch_size(self, size):
+        """
+        Set the size of the scratch memory pool of each map worker. The intermediate images of the rows come
+        from that pool instead of the system allocator, which saves the allocation and page fault costs of the
+        pipelines with many augmentations.
+
+        Args:
+            size (int): size in MB of the pool of each worker, 0 turns the pools off.
+
+        Raises:
+            ValueError: If size is invalid (< 0 or > MAX_INT_32).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # give each map worker a pool of 64 MB.
+            >>> con.set_worker_scratch_size(64)
+        """
+        if size < 0 or size > INT32_MAX:
+            raise ValueError("Worker scratch size given is not within the required range")
+        self.config.set_worker_scratch_size(size)
+
+    def get_worker_scratch_size(self):
+        """
+        Get the size of the scratch memory pool of each map worker.
+
+        Returns:
+            Int, size in MB, 0 if the pools are off.
+        """
+        return self.config.get_worker_scratch_size()
+
+    def set_tensor_pool(self, pool):
+        """
+        Set the memory pool from which the tensors created afterwards take their data.
+
+        Args:
+            pool (str): "system" for the system allocator, "circular" for a pool of large arenas, or "numa" for a
+                pool which caches the freed buffers per thread and per numa node, so that the buffers stay local
+                to the workers which reuse them.
+
+        Raises:
+            ValueError: If pool is not one of the names above.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> con.set_tensor_pool("numa")
+        """
+        if pool not in ("system", "circular", "numa"):
+            raise ValueError("Tensor pool should be one of system, circular or numa")
+        self.config.set_tensor_pool(pool)
+
+    def get_tensor_pool(self):
+        """
+        Get the memory pool of the tensor data.
+
+        Returns:
+            Str, name of the pool.
+        """
+        return self.config.get_tensor_pool()
+
+    def set_work_stealing(self, work_stealing):
+        """
+        Set whether the maps of the pipelines launched afterwards compute their buffers on a pool of threads shared
+        by all the pipelines, one thread per core, instead of on threads of their own. The num_parallel_workers of
+        a map is then the number of its buffers computed at once.
+
+        Args:
+            work_stealing (bool): True to use the shared pool.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> con.set_work_stealing(True)
+        """
+        if not isinstance(work_stealing, bool):
+            raise TypeError("work_stealing should be a boolean")
+        self.config.set_work_stealing(work_stealing)
+
+    def get_work_stealing(self):
+        """
+        Get whether the maps compute their buffers on the shared pool of threads.
+
+        Returns:
+            Bool, True if the shared pool is used.
+        """
+        return self.config.get_work_stealing()
+
+    def set_cpu_placement(self, placement, reserved_cpus=None):
+        """
+        Set the cpus on which the threads of the pipelines launched afterwards run, so that they stay near the
+        device they feed and off the cpus of the compute kernels.
+
+        Args:
+            placement (str): "none" for all the cpus, "device" for the cpus of the numa node of the device of the
+                device queue (found for the GPUs, all the cpus otherwise), or a cpu list such as "0-15,32-47".
+            reserved_cpus (str, optional): a cpu list on which the threads never run (default=None, keep the current
+                one). An empty string reserves no cpu.
+
+        Raises:
+            ValueError: If placement or reserved_cpus is not a valid cpu list.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # run near the device, but not on the first 4 cpus.
+            >>> con.set_cpu_placement("device", reserved_cpus="0-3")
+        """
+        if placement not in ("none", "device") and not _is_cpu_list(placement):
+            raise ValueError("Cpu placement should be none, device or a cpu list")
+        if reserved_cpus is not None:
+            if reserved_cpus and not _is_cpu_list(reserved_cpus):
+                raise ValueError("Reserved cpus should be a cpu list")
+            self.config.set_reserved_cpus(reserved_cpus)
+        self.config.set_cpu_placement(placement)
+
+    def get_cpu_placement(self):
+        """
+        Get the cpus of the threads of the pipelines.
+
+        Returns:
+            Tuple of str, the placement and the reserved cpus.
+        """
+        return self.config.get_cpu_placement(), self.config.get_reserved_cpus()
+
     def __str__(self):
         """
         String representation of the configurations.
@@ -34,11 +34,13 @@ from mindspore._c_expression import typing
 
 from mindspore import log as logger
 from . import samplers
-from .iterators import DictIterator, TupleIterator
+from .iterators import DictIterator, TupleIterator, RowAccessor
+from .py_workers import SourceWorkers, FuncWorkers
 from .validators import check, check_batch, check_shuffle, check_map, check_repeat, check_zip, check_rename, \
     check_project, check_imagefolderdatasetv2, check_mnist_cifar_dataset, check_manifestdataset, \
     check_tfrecorddataset, check_vocdataset, check_celebadataset, check_minddataset, check_generatordataset, \
-    check_zip_dataset
+    check_zip_dataset, check_cache, check_bucket_batch_by_length
+from ..core.configuration import config
 from ..core.datatypes import mstype_to_detype, mstypelist_to_detypelist
 
 try:
@@ -159,7 +161,7 @@ class Dataset:
 
     @check_batch
     def batch(self, batch_size, drop_remainder=False, num_parallel_workers=None, per_batch_map=None,
-              input_columns=None):
+              input_columns=None, in_place=False, pad_info=None):
         """
         Combines batch_size number of consecutive rows into batches.
 
@@ -185,6 +187,12 @@ class Dataset:
                 last parameter of the callable should always be a BatchInfo object.
             input_columns (list of string, optional): List of names of the input columns. The size of the list should
                 match with signature of per_batch_map callable.
+            in_place (bool, optional): Whether the batches are allocated before their rows are computed, so that
+                a map right before the batch writes its output column straight into the batch (default=False).
+                It only applies to an int batch_size without per_batch_map, the other rows are copied as usual.
+            pad_info (dict, optional): The columns to pad, {column name: (pad_shape, pad_value)} (default=None).
+                The None dims of pad_shape, or all the dims if pad_shape is None, are padded to the largest of
+                the batch. The rows of a padded column may have different shapes.
 
         Returns:
             BatchDataset, dataset batched.
@@ -195,11 +203,52 @@ class Dataset:
             >>> # creates a dataset where every 100 rows is combined into a batch
             >>> # and drops the last incomplete batch if there is one.
             >>> data = data.batch(100, True)
+            >>>
+            >>> # pads the "ids" column of each batch with 0 to the longest row of the batch
+            >>> data = data.batch(100, pad_info={"ids": ([None], 0)})
+        """
+        return BatchDataset(self, batch_size, drop_remainder, num_parallel_workers, per_batch_map, input_columns,
+                            in_place, pad_info)
+
+    @check_bucket_batch_by_length
+    def bucket_batch_by_length(self, column_name, bucket_boundaries, bucket_batch_sizes, pad_info=None,
+                               pad_to_bucket_boundary=False, drop_remainder=False, num_parallel_workers=None):
         """
-        return BatchDataset(self, batch_size, drop_remainder, num_parallel_workers, per_batch_map, input_columns)
+        Groups the rows into buckets by their length and batches each bucket with its own batch size.
+
+        The length of a row is the size of the first dim of column_name. With the boundaries [b0, b1, ..., bn],
+        the rows shorter than b0 go to the first bucket, the rows with b0 <= length < b1 to the second one
+        and so on, the rows not shorter than bn go to the last bucket. A bucket is batched as soon as it holds
+        its batch size rows, the buckets left at the end of an epoch are batched with fewer rows.
+
+        Args:
+            column_name (str): The column whose first dim is the length of a row.
+            bucket_boundaries (list[int]): The strictly increasing upper bounds, excluded, of the buckets.
+            bucket_batch_sizes (list[int]): The batch size of each bucket, one more than bucket_boundaries.
+            pad_info (dict, optional): The columns to pad, see batch (default=None).
+            pad_to_bucket_boundary (bool, optional): Whether the None first dim of the padded columns is padded
+                to the boundary of the bucket minus 1 instead of the longest of the batch (default=False).
+                The last bucket is always padded to the longest of the batch.
+            drop_remainder (bool, optional): Whether the buckets left at the end of an epoch are dropped
+                (default=False).
+            num_parallel_workers (int, optional): Number of workers to process the Dataset in parallel (default=None).
+
+        Returns:
+            BatchDataset, dataset batched.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> # data is an instance of Dataset object.
+            >>> # batches the sentences shorter than 16 tokens by 64, shorter than 64 tokens by 16, the others by 4
+            >>> # and pads the "ids" column of each batch to the boundary of its bucket
+            >>> data = data.bucket_batch_by_length("ids", [16, 64], [64, 16, 4], pad_info={"ids": ([None], 0)},
+            >>>                                    pad_to_bucket_boundary=True)
+        """
+        return BatchDataset(self, max(bucket_batch_sizes), drop_remainder, num_parallel_workers, pad_info=pad_info,
+                            bucketing=(column_name, bucket_boundaries, bucket_batch_sizes, pad_to_bucket_boundary))
 
     @check_shuffle
-    def shuffle(self, buffer_size):
+    def shuffle(self, buffer_size, buffer_memory_mb=None):
         """
         Randomly shuffles the rows of this dataset using the following algorithm:
 
@@ -216,6 +265,9 @@ class Dataset:
             buffer_size (int): The size of the buffer (must be larger than 1) for
                 shuffling. Setting buffer_size equal to the number of rows in the entire
                 dataset will result in a global shuffle.
+            buffer_memory_mb (int, optional): The upper bound of the memory held by the
+                shuffle buffer, in MB (default=None, no bound). Once the rows of the buffer
+                reach it, the buffer holds fewer than buffer_size rows.
 
         Returns:
             ShuffleDataset, dataset shuffled.
@@ -229,11 +281,12 @@ class Dataset:
             >>> # creates a shuffled dataset using a shuffle buffer of size 4
             >>> data = data.shuffle(4)
         """
-        return ShuffleDataset(self, buffer_size)
+        return ShuffleDataset(self, buffer_size, buffer_memory_mb)
 
     @check_map
     def map(self, input_columns=None, operations=None, output_columns=None, columns_order=None,
-            num_parallel_workers=None):
+            num_parallel_workers=None, batch_mode=False, batched_pyfunc=False, python_multiprocessing=False,
+            max_rowsize=16):
         """
         Applies each operation in operations to this dataset.
 
@@ -272,6 +325,19 @@ class Dataset:
                 same).
             num_parallel_workers (int, optional): Number of threads used to process the dataset in
                 parallel (default=None, the value from the config will be used).
+            batch_mode (bool, optional): Whether this map is placed after a batch and each operation is
+                applied once on the whole batch instead of once per row. Normalize, HWC2CHW, TypeCast,
+                OneHot and ToFloat16 run their batch kernels, the other operations still run row by row
+                (default=False).
+            batched_pyfunc (bool, optional): Whether the Python functions in operations are called once on all
+                the rows of a buffer (see rowsPerBuffer in the config) instead of once per row. Each argument of
+                the function is then a list holding the column of every row as read only numpy arrays, and the
+                function returns a list, or a tuple of lists, with a result per row (default=False).
+            python_multiprocessing (bool, optional): Whether the Python functions in operations are computed by
+                num_parallel_workers worker processes instead of the map threads, so that they are not bound
+                to one core by the GIL. Their arguments and results go through shared memory (default=False).
+            max_rowsize (int, optional): Size in MB of the largest arguments or results which go through shared
+                memory with python_multiprocessing, larger ones are pickled (default=16).
 
         Returns:
             MapDataset, dataset after mapping operation.
@@ -384,8 +450,22 @@ class Dataset:
             >>> # Propagate some columns to the child node in this order:
             >>> columns_order = ["mod7", "mod3", "col1"]
             >>> ds_mapped = ds_pyfunc.map(input_columns, operations, output_columns, columns_order)
+            >>>
+            >>> # 4) Example of a map applied on whole batches
+            >>>
+            >>> # The images of each batch are normalized in a single pass.
+            >>> normalize_op = c_transforms.Normalize((121.0, 115.0, 100.0), (70.0, 68.0, 71.0))
+            >>> ds_batched = ds_decoded.batch(32).map(input_columns=["image"], operations=[normalize_op],
+            >>>                                       batch_mode=True)
+            >>>
+            >>> # 5) Example of a Python function called once on all the rows of a buffer
+            >>>
+            >>> # The GIL is taken once for all the rows instead of once per row.
+            >>> flip = lambda images: [np.flip(x, 1) for x in images]
+            >>> ds_flipped = ds_decoded.map(input_columns=["image"], operations=[flip], batched_pyfunc=True)
         """
-        return MapDataset(self, input_columns, operations, output_columns, columns_order, num_parallel_workers)
+        return MapDataset(self, input_columns, operations, output_columns, columns_order, num_parallel_workers,
+                          batch_mode, batched_pyfunc, python_multiprocessing, max_rowsize)
 
     @check_repeat
     def repeat(self, count=None):
@@ -421,6 +501,41 @@ class Dataset:
         """
         return RepeatDataset(self, count)
 
+    @check_cache
+    def cache(self, memory_mb, spill_dir=None, session_name=None):
+        """
+        Caches the rows of this dataset during the first epoch and serves the following epochs from the cache.
+
+        Note:
+            The operators below the cache run once, so the random operations below it are applied only once
+            and every epoch gets the same rows. Put the random operations which should differ between the epochs
+            after the cache.
+
+        Args:
+            memory_mb (int): The upper bound of the memory of the cache in MB.
+            spill_dir (str, optional): Directory where the rows which do not fit in memory are written
+                (default=None, the cache fails when it runs out of memory).
+            session_name (str, optional): Name under which the processes of a host share the cache through
+                shared memory (default=None, the cache is private to this pipeline). The first process to
+                open a session runs its pipeline and shares the rows, the other ones read them instead of
+                running their own pipeline below the cache, so they must all produce the same rows.
+
+        Returns:
+            CacheDataset, dataset cached.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> # data is an instance of Dataset object.
+            >>> # decodes the images once and replays the decoded rows for the 50 epochs.
+            >>> data = data.map(input_columns=["image"], operations=decode_op)
+            >>> data = data.cache(4096, "/tmp")
+            >>> data = data.repeat(50)
+            >>>
+            >>> # the training processes of the host decode the images once between them.
+            >>> data = data.cache(4096, session_name="imagenet_train")
+        """
+        return CacheDataset(self, memory_mb, spill_dir, session_name)
+
     @check_zip_dataset
     def zip(self, datasets):
         """
@@ -584,7 +699,7 @@ class Dataset:
 
         return TransferDataset(self, queue_name, device_id, device_type, num_batch)
 
-    def create_tuple_iterator(self, columns=None):
+    def create_tuple_iterator(self, columns=None, state=None):
         """
         Create an Iterator over the dataset. The data retrieved will be a list of ndarray of data.
 
@@ -594,6 +709,8 @@ class Dataset:
         Args:
             columns (list[str], optional): List of columns to be used to specify the order of columns
                 (defaults=None, means all columns).
+            state (str, optional): State returned by get_state of an iterator over the same pipeline,
+                to resume from (default=None, starts from the beginning).
 
         Returns:
             Iterator, list of ndarray.
@@ -608,15 +725,19 @@ class Dataset:
             >>>     # convert the returned tuple to a list and print
             >>>     print(list(item))
         """
-        return TupleIterator(self, columns)
+        return TupleIterator(self, columns, state)
 
-    def create_dict_iterator(self):
+    def create_dict_iterator(self, state=None):
         """
         Create an Iterator over the dataset.
 
         The data retrieved will be a dictionary. The order
         of the columns in the dictionary may not be the same as the original order.
 
+        Args:
+            state (str, optional): State returned by get_state of an iterator over the same pipeline,
+                to resume from (default=None, starts from the beginning).
+
         Returns:
             Iterator, dictionary of column_name-ndarray pair.
 
@@ -631,7 +752,7 @@ class Dataset:
             >>>     print(item["column1"])
 
         """
-        return DictIterator(self)
+        return DictIterator(self, state)
 
     def __iter__(self):
         """Create an Iterator over the dataset."""
@@ -795,6 +916,27 @@ class SourceDataset(Dataset):
 
     # No need for __init__ since it is the same as the super's init
 
+    def create_row_accessor(self):
+        """
+        Create a random access to the rows of the dataset, without launching a pipeline.
+
+        The rows are read by their ids, in the order of the dataset. The sampler of the dataset
+        is not applied.
+
+        Returns:
+            RowAccessor, the rows of the dataset as lists of ndarray.
+
+        Raises:
+            ValueError: If the dataset does not support random access.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> # data is an instance of ImageFolderDatasetV2
+            >>> accessor = data.create_row_accessor()
+            >>> image, label = accessor[10]
+        """
+        return RowAccessor(self)
+
 
 class DatasetOp(Dataset):
     """
@@ -813,10 +955,14 @@ class BatchDataset(DatasetOp):
         batch_size (int): The size of the batch.
         drop_remainder (bool, optional): Whether drop the remainder batch of data (drop_remainder=False).
             If True, the last incomplete batch will be dropped.
+        in_place (bool, optional): Whether a map right before the batch writes into the batch (in_place=False).
+        pad_info (dict, optional): The columns to pad, {column name: (pad_shape, pad_value)} (pad_info=None).
+        bucketing (tuple, optional): The length column, the bucket boundaries, the bucket batch sizes and
+            pad_to_bucket_boundary when the rows are bucketed by length (bucketing=None).
     """
 
     def __init__(self, input_dataset, batch_size, drop_remainder=False, num_parallel_workers=None,
-                 per_batch_map=None, input_columns=None):
+                 per_batch_map=None, input_columns=None, in_place=False, pad_info=None, bucketing=None):
         super().__init__(num_parallel_workers)
 
         if BatchDataset._is_ancestor_of_repeat(input_dataset):
@@ -826,6 +972,9 @@ class BatchDataset(DatasetOp):
         self.drop_remainder = drop_remainder
         self.per_batch_map = per_batch_map
         self.input_columns = input_columns
+        self.in_place = in_place
+        self.pad_info = pad_info
+        self.bucketing = bucketing
         self.input.append(input_dataset)
         input_dataset.output.append(self)
         self._input_indexs = input_dataset.input_indexs
@@ -836,6 +985,13 @@ class BatchDataset(DatasetOp):
         args["drop_remainder"] = self.drop_remainder
         args["per_batch_map"] = self.per_batch_map
         args["input_columns"] = self.input_columns
+        args["in_place"] = self.in_place
+        if self.pad_info is not None:
+            args["pad_info"] = {name: (None if shape is None else [-1 if dim is None else dim for dim in shape], value)
+                                for name, (shape, value) in self.pad_info.items()}
+        if self.bucketing is not None:
+            args["length_column"], args["bucket_boundaries"], args["bucket_batch_sizes"], \
+                args["pad_to_bucket_boundary"] = self.bucketing
         return args
 
     def get_dataset_size(self):
@@ -846,7 +1002,8 @@ class BatchDataset(DatasetOp):
             Number, number of batches.
         """
         child_size = self.input[0].get_dataset_size()
-        if child_size is not None:
+        # the number of batches of the buckets depends on the lengths of the rows
+        if child_size is not None and self.bucketing is None:
             if self.drop_remainder:
                 return math.floor(child_size / self.batch_size)
             return math.ceil(child_size / self.batch_size)
@@ -910,11 +1067,13 @@ class ShuffleDataset(DatasetOp):
     Args:
         input_dataset (Dataset): Input Dataset to be shuffled.
         buffer_size (int): The size of the buffer.
+        buffer_memory_mb (int, optional): The upper bound of the memory of the buffer in MB (default=None).
     """
 
-    def __init__(self, input_dataset, buffer_size):
+    def __init__(self, input_dataset, buffer_size, buffer_memory_mb=None):
         super().__init__()
         self.buffer_size = buffer_size
+        self.buffer_memory_mb = buffer_memory_mb
         self.input.append(input_dataset)
         input_dataset.output.append(self)
         self._input_indexs = input_dataset.input_indexs
@@ -922,6 +1081,7 @@ class ShuffleDataset(DatasetOp):
     def get_args(self):
         args = super().get_args()
         args["buffer_size"] = self.buffer_size
+        args["buffer_memory_mb"] = self.buffer_memory_mb
         return args
 
 
@@ -944,13 +1104,21 @@ class MapDataset(DatasetOp):
             The argument is mandatory if len(input_columns) != len(output_columns).
         num_parallel_workers (int, optional): Number of workers to process the Dataset
             in parallel (default=None).
+        batch_mode (bool, optional): Whether the operations are applied once on each batch (default=False).
+        batched_pyfunc (bool, optional): Whether the Python functions are called once on all the rows of a
+            buffer (default=False).
+        python_multiprocessing (bool, optional): Whether the Python functions are computed by worker
+            processes (default=False).
+        max_rowsize (int, optional): Size in MB of the largest arguments or results which go through shared
+            memory between the processes (default=16).
 
         Raises:
             ValueError: If len(input_columns) != len(output_columns) and columns_order is not specified.
     """
 
     def __init__(self, input_dataset, input_columns=None, operations=None, output_columns=None, columns_order=None,
-                 num_parallel_workers=None):
+                 num_parallel_workers=None, batch_mode=False, batched_pyfunc=False, python_multiprocessing=False,
+                 max_rowsize=16):
         super().__init__(num_parallel_workers)
         self.input.append(input_dataset)
         if input_columns is not None and not isinstance(input_columns, list):
@@ -958,11 +1126,24 @@ class MapDataset(DatasetOp):
         self.input_columns = input_columns
         if operations is not None and not isinstance(operations, list):
             operations = [operations]
+        self.func_workers = None
+        if python_multiprocessing and operations is not None:
+            # The Python functions are replaced by their counterparts in the worker processes
+            func_indices = [i for i, op in enumerate(operations) if callable(op)]
+            if func_indices:
+                num_workers = num_parallel_workers if num_parallel_workers is not None \
+                    else config.get_num_parallel_workers()
+                self.func_workers = FuncWorkers([operations[i] for i in func_indices], num_workers, max_rowsize)
+                operations = list(operations)
+                for i, remote in zip(func_indices, self.func_workers.funcs):
+                    operations[i] = remote
         self.operations = operations
         if output_columns is not None and not isinstance(output_columns, list):
             output_columns = [output_columns]
         self.output_columns = output_columns
         self.columns_order = columns_order
+        self.batch_mode = batch_mode
+        self.batched_pyfunc = batched_pyfunc
 
         if self.input_columns and self.output_columns \
                 and len(self.input_columns) != len(self.output_columns) \
@@ -977,6 +1158,8 @@ class MapDataset(DatasetOp):
         args["input_columns"] = self.input_columns
         args["operations"] = self.operations
         args["output_columns"] = self.output_columns
+        args["batch_mode"] = self.batch_mode
+        args["batched_pyfunc"] = self.batched_pyfunc
         return args
 
     def get_dataset_size(self):
@@ -1035,6 +1218,43 @@ class RepeatDataset(DatasetOp):
         return self.count
 
 
+class CacheDataset(DatasetOp):
+    """
+    The result of applying Cache operator to the input Dataset.
+
+    Args:
+        input_dataset (Dataset): Input Dataset to be cached.
+        memory_mb (int): The upper bound of the memory of the cache in MB.
+        spill_dir (str, optional): Directory where the rows which do not fit in memory are written (default=None).
+        session_name (str, optional): Name under which the processes of a host share the cache (default=None).
+    """
+
+    def __init__(self, input_dataset, memory_mb, spill_dir=None, session_name=None):
+        super().__init__()
+        self.memory_mb = memory_mb
+        self.spill_dir = spill_dir
+        self.session_name = session_name
+        self.input.append(input_dataset)
+        input_dataset.output.append(self)
+        self._input_indexs = input_dataset.input_indexs
+
+    def get_args(self):
+        args = super().get_args()
+        args["memory_mb"] = self.memory_mb
+        args["spill_dir"] = self.spill_dir
+        args["session_name"] = self.session_name
+        return args
+
+    def get_dataset_size(self):
+        """
+        Get the number of batches in an epoch.
+
+        Return:
+            Number, number of batches.
+        """
+        return self.input[0].get_dataset_size()
+
+
 class ZipDataset(DatasetOp):
     """
     The result of applying Zip operator to the input Dataset.
@@ -1171,10 +1391,10 @@ class TransferDataset(DatasetOp):
         args["num_batch"] = self.__num_batch
         return args
 
-    def create_dict_iterator(self):
+    def create_dict_iterator(self, state=None):
         raise RuntimeError("TransferDataset is not iterable")
 
-    def create_tuple_iterator(self, columns=None):
+    def create_tuple_iterator(self, columns=None, state=None):
         raise RuntimeError("TransferDataset is not iterable")
 
     def __iter__(self):
@@ -1426,6 +1646,9 @@ class ImageFolderDatasetV2(SourceDataset):
             into (default=None).
         shard_id (int, optional): The shard ID within num_shards (default=None). This
             argument should be specified only when num_shards is also specified.
+        index_file (str, optional): File which keeps the listing of the images (default=None).
+            The first run walks the folders and writes it, the next runs read it instead
+            as long as no folder changed and the other arguments which select the images are the same.
 
     Raises:
         RuntimeError: If sampler and shuffle are specified at the same time.
@@ -1445,12 +1668,14 @@ class ImageFolderDatasetV2(SourceDataset):
         >>> imagefolder_dataset = ds.ImageFolderDatasetV2(dataset_dir,class_indexing={"cat":0,"dog":1})
         >>> # 3) read all samples (image files) in dataset_dir with extensions .JPEG and .png (case sensitive)
         >>> imagefolder_dataset = ds.ImageFolderDatasetV2(dataset_dir, extensions={".JPEG",".png"})
+        >>> # 4) keep the listing of the images in a file, for the next runs
+        >>> imagefolder_dataset = ds.ImageFolderDatasetV2(dataset_dir, index_file="/path/to/imagefolder.index")
     """
 
     @check_imagefolderdatasetv2
     def __init__(self, dataset_dir, num_samples=None, num_parallel_workers=None,
                  shuffle=None, sampler=None, extensions=None, class_indexing=None,
-                 decode=False, num_shards=None, shard_id=None):
+                 decode=False, num_shards=None, shard_id=None, index_file=None):
         super().__init__(num_parallel_workers)
 
         self.dataset_dir = dataset_dir
@@ -1462,6 +1687,7 @@ class ImageFolderDatasetV2(SourceDataset):
         self.decode = decode
         self.num_shards = num_shards
         self.shard_id = shard_id
+        self.index_file = index_file
 
     def get_args(self):
         args = super().get_args()
@@ -1474,6 +1700,7 @@ class ImageFolderDatasetV2(SourceDataset):
         args["decode"] = self.decode
         args["num_shards"] = self.num_shards
         args["shard_id"] = self.shard_id
+        args["index_file"] = self.index_file
         return args
 
     def get_dataset_size(self):
@@ -1623,6 +1850,13 @@ class MindDataset(SourceDataset):
         shard_id (int, optional): The shard ID within num_shards (default=None). This
             argument should be specified only when num_shards is also specified.
         block_reader (bool, optional): Whether read data by block mode (default=False).
+        mmap_mode (bool, optional): Whether read the local dataset files through memory mappings instead of
+            file streams (default=False). The reader falls back to file streams when the files can not be mapped.
+        prefetch_depth (int, optional): Number of row groups read ahead of the parallel workers, rows when
+            block_reader is False (default=None, 16).
+        shuffle_window (int, optional): Shuffle the row groups instead of the rows, then the rows within
+            windows of shuffle_window consecutive rows (default=None, shuffle the rows). The pages are then read
+            near sequentially, across the shards as well since every shard gets whole row groups.
 
     Raises:
         ValueError: If num_shards is specified but shard_id is None.
@@ -1632,7 +1866,8 @@ class MindDataset(SourceDataset):
 
     @check_minddataset
     def __init__(self, dataset_file, columns_list=None, num_parallel_workers=None,
-                 shuffle=None, num_shards=None, shard_id=None, block_reader=False):
+                 shuffle=None, num_shards=None, shard_id=None, block_reader=False, mmap_mode=False,
+                 prefetch_depth=None, shuffle_window=None):
         super().__init__(num_parallel_workers)
         self.dataset_file = dataset_file
         self.columns_list = columns_list
@@ -1653,6 +1888,9 @@ class MindDataset(SourceDataset):
         self.num_shards = num_shards
         self.shard_id = shard_id
         self.block_reader = block_reader
+        self.mmap_mode = mmap_mode
+        self.prefetch_depth = prefetch_depth
+        self.shuffle_window = shuffle_window
 
     def get_args(self):
         args = super().get_args()
@@ -1661,6 +1899,9 @@ class MindDataset(SourceDataset):
         args["global_shuffle"] = self.global_shuffle
         args["partitions"] = self.partitions
         args["block_reader"] = self.block_reader
+        args["mmap_mode"] = self.mmap_mode
+        args["prefetch_depth"] = self.prefetch_depth
+        args["shuffle_window"] = self.shuffle_window
         args["num_shards"] = self.num_shards
         args["shard_id"] = self.shard_id
         return args
@@ -1708,6 +1949,14 @@ class GeneratorDataset(SourceDataset):
             If provided, sanity check will be performed on generator output.
         prefetch_size (int, optional): Prefetch number of records ahead of the user's request (default=None).
         sampler (Sampler, optional): Object used to choose samples from the dataset (default=None).
+        num_parallel_workers (int, optional): Number of worker processes reading the rows when
+            python_multiprocessing is True (default=None, number set in the config).
+        python_multiprocessing (bool, optional): Whether the rows are read by worker processes instead of the
+            pipeline thread, so that a Python source is not bound to one core by the GIL (default=False).
+            It needs a random access source, i.e. source[i] is a row and len(source) the number of rows, or a
+            sampler. The rows come back in the order of the indices, through shared memory.
+        max_rowsize (int, optional): Size in MB of the largest row which goes through shared memory, larger
+            rows are pickled (default=16).
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -1726,9 +1975,19 @@ class GeneratorDataset(SourceDataset):
     """
 
     @check_generatordataset
-    def __init__(self, generator_function, column_names, column_types=None, prefetch_size=None, sampler=None):
+    def __init__(self, generator_function, column_names, column_types=None, prefetch_size=None, sampler=None,
+                 num_parallel_workers=None, python_multiprocessing=False, max_rowsize=16):
         super().__init__(1)
-        if sampler is not None:
+        random_access = hasattr(generator_function, "__getitem__") and \
+            (sampler is not None or hasattr(generator_function, "__len__"))
+        if python_multiprocessing and not random_access:
+            logger.warning("python_multiprocessing needs a random access source, the rows are read by the "
+                           "pipeline thread.")
+        if python_multiprocessing and random_access:
+            num_workers = num_parallel_workers if num_parallel_workers is not None \
+                else config.get_num_parallel_workers()
+            self.generator_function = SourceWorkers(generator_function, sampler, num_workers, max_rowsize)
+        elif sampler is not None:
             self.generator_function = (lambda: sampler_fn(sampler, generator_function))
         else:
             try:
@@ -1805,6 +2064,12 @@ class TFRecordDataset(SourceDataset):
             argument should be specified only when num_shards is also specified.
         shard_equal_rows (bool): Get equal rows for all shards(default=False). If shard_equal_rows is false, number
             of rows of each shard may be not equal.
+        num_readahead_chunks (int, optional): Number of chunks of 1 MB each worker reads ahead of its parsing
+            (default=None, the workers read their files themselves). Overlaps the reads and the parsing, which
+            helps on network file systems.
+        write_index_files (bool, optional): Write an index beside each file which has none, with the offsets of
+            its records (default=False). The files are scanned once, then the rows are counted without reading
+            the files and the records of a file are split across the workers. See create_index_files.
     Examples:
         >>> import mindspore.dataset as ds
         >>> import mindspore.common.dtype as mstype
@@ -1845,7 +2110,8 @@ class TFRecordDataset(SourceDataset):
 
     @check_tfrecorddataset
     def __init__(self, dataset_files, schema=None, columns_list=None, num_samples=None, num_parallel_workers=None,
-                 shuffle=Shuffle.GLOBAL, num_shards=None, shard_id=None, shard_equal_rows=False):
+                 shuffle=Shuffle.GLOBAL, num_shards=None, shard_id=None, shard_equal_rows=False,
+                 num_readahead_chunks=None, write_index_files=False):
         super().__init__(num_parallel_workers)
         self.dataset_files = self._find_files(dataset_files)
         self.dataset_files.sort()
@@ -1873,6 +2139,26 @@ class TFRecordDataset(SourceDataset):
             self.shuffle_level = shuffle
             self.shuffle_files = True
         self.shard_equal_rows = shard_equal_rows
+        self.num_readahead_chunks = num_readahead_chunks
+        self.write_index_files = write_index_files
+
+    @staticmethod
+    def create_index_files(dataset_files):
+        """
+        Write the index of TFRecord files, beside each file with the suffix ".index".
+
+        An index holds the offsets of the records of its file. It is used while the file is not modified.
+
+        Args:
+            dataset_files (str or list[str]): String or list of files to be indexed, or glob strings.
+
+        Returns:
+            Number, the total number of rows of the files.
+        """
+        num_rows = 0
+        for dataset_file in TFRecordDataset._find_files(dataset_files):
+            num_rows += TFReaderOp.create_index_file(dataset_file)
+        return num_rows
 
     def get_args(self):
         args = super().get_args()
@@ -1894,6 +2180,8 @@ class TFRecordDataset(SourceDataset):
         args["num_shards"] = self.num_shards
         args["shard_id"] = self.shard_id
         args["shard_equal_rows"] = self.shard_equal_rows
+        args["num_readahead_chunks"] = self.num_readahead_chunks
+        args["write_index_files"] = self.write_index_files
         return args
 
     def get_dataset_size(self, estimate=False):
@@ -70,9 +70,10 @@ class Iterator:
 
     Attributes:
         dataset: Dataset to be iterated over
+        state: State returned by get_state of an iterator over the same pipeline, to resume from
     """
 
-    def __init__(self, dataset):
+    def __init__(self, dataset, state=None):
         ITERATORS_LIST.append(self)
         self.dataset = alter_tree(dataset)
         if not self.__is_tree():
@@ -84,6 +85,8 @@ class Iterator:
 
         root = self.__convert_node_postorder(self.dataset)
         self.depipeline.AssignRootNode(root)
+        if state is not None:
+            self.depipeline.SetResumeState(state)
         self.depipeline.LaunchTreeExec()
         self._index = 0
 
@@ -121,6 +124,8 @@ class Iterator:
             op_type = OpName.MAP
         elif isinstance(dataset, de.RepeatDataset):
             op_type = OpName.REPEAT
+        elif isinstance(dataset, de.CacheDataset):
+            op_type = OpName.CACHE
         elif isinstance(dataset, de.StorageDataset):
             op_type = OpName.STORAGE
         elif isinstance(dataset, de.ImageFolderDatasetV2):
@@ -223,6 +228,37 @@ class Iterator:
     def num_classes(self):
         return self.depipeline.GetNumClasses()
 
+    def get_state(self):
+        """
+        Get the position of the iterator, to resume an iterator over the same pipeline from it.
+
+        The samplers resume without reading the rows before the position. A shuffle or a TFRecordDataset
+        replays the current epoch up to the position. Samplers other than the sequential, random and
+        distributed ones, a callable batch size and the cache do not support it.
+
+        Returns:
+            str, the serialized state.
+        """
+        return self.depipeline.SaveState()
+
+    def dump_profile(self, path):
+        """
+        Write the per operator profile of the pipeline as json.
+
+        Args:
+            path (str): the file to write.
+        """
+        self.depipeline.DumpProfile(path)
+
+    def dump_chrome_trace(self, path):
+        """
+        Write the samples of the pipeline profiler as a chrome://tracing file.
+
+        Args:
+            path (str): the file to write.
+        """
+        self.depipeline.DumpChromeTrace(path)
+
 
 class DictIterator(Iterator):
     """
@@ -240,7 +276,7 @@ class DictIterator(Iterator):
             Dict, the next record in the dataset.
         """
 
-        return {k: v.as_array() for k, v in self.depipeline.GetNextAsMap().items()}
+        return self.depipeline.GetNextAsMap()
 
 
 class TupleIterator(Iterator):
@@ -248,12 +284,12 @@ class TupleIterator(Iterator):
     The derived class of Iterator with list type.
     """
 
-    def __init__(self, dataset, columns=None):
+    def __init__(self, dataset, columns=None, state=None):
         if columns is not None:
             if not isinstance(columns, list):
                 columns = [columns]
             dataset = dataset.project(columns)
-        super().__init__(dataset)
+        super().__init__(dataset, state)
 
     def __iter__(self):
         return self
@@ -266,4 +302,58 @@ class TupleIterator(Iterator):
             List, the next record in the dataset.
         """
 
-        return [t.as_array() for t in self.depipeline.GetNextAsList()]
+        return self.depipeline.GetNextAsList()
+
+
+class RowAccessor:
+    """
+    Random access to the rows of a source dataset by their ids, without launching a pipeline.
+
+    The ids follow the order of the rows in the dataset, its sampler is not applied. Only the
+    ImageFolderDatasetV2, MnistDataset, ManifestDataset, Cifar10Dataset and Cifar100Dataset support it.
+
+    Attributes:
+        dataset: Source dataset to read the rows of
+    """
+
+    def __init__(self, dataset):
+        op_type = self.__get_dataset_type(dataset)
+        ITERATORS_LIST.append(self)
+        self.dataset = dataset
+        self.depipeline = DEPipeline()
+        self.c_node = self.depipeline.AddNodeToTree(op_type, dataset.get_args())
+
+    @staticmethod
+    def __get_dataset_type(dataset):
+        """Get the op type of a source which supports random access."""
+        if isinstance(dataset, de.ImageFolderDatasetV2):
+            op_type = OpName.IMAGEFOLDER
+        elif isinstance(dataset, de.MnistDataset):
+            op_type = OpName.MNIST
+        elif isinstance(dataset, de.ManifestDataset):
+            op_type = OpName.MANIFEST
+        elif isinstance(dataset, de.Cifar10Dataset):
+            op_type = OpName.CIFAR10
+        elif isinstance(dataset, de.Cifar100Dataset):
+            op_type = OpName.CIFAR100
+        else:
+            raise ValueError("Unsupported DatasetOp for random access")
+
+        return op_type
+
+    def release(self):
+        if hasattr(self, 'depipeline') and self.depipeline:
+            del self.depipeline
+
+    def __getitem__(self, row_id):
+        """
+        Returns a row of the dataset as a list
+
+        Args:
+            row_id (int): The id of the row, from 0 to the number of rows in the dataset.
+
+        Returns:
+            List, the row with the given id.
+        """
+
+        return self.depipeline.GetRow(self.c_node, row_id)
@@ -0,0 +1,257 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""
+Worker processes for the Python sources and the Python map functions of a pipeline, so that they are not
+bound to the one core of the GIL. The arrays go between the processes through rings of shared memory, only
+their descriptions go through the pipes.
+"""
+import collections
+import multiprocessing
+import queue
+import traceback
+
+import numpy as np
+
+from mindspore import log as logger
+
+# The arrays of a slot are aligned on cache lines
+_ALIGN = 64
+# The rows a worker holds ahead of the reader
+_SLOTS_PER_WORKER = 2
+# Seconds between two checks that a worker is alive while waiting for it
+_POLL_INTERVAL = 1.0
+
+
+def _aligned(n):
+    return (n + _ALIGN - 1) // _ALIGN * _ALIGN
+
+
+def _flatten(obj, arrays):
+    """Collects the arrays of a nested tuple or list of arrays, returns the structure to rebuild it."""
+    if isinstance(obj, tuple):
+        return ("t", [_flatten(x, arrays) for x in obj])
+    if isinstance(obj, list):
+        return ("l", [_flatten(x, arrays) for x in obj])
+    arrays.append(np.asarray(obj))
+    return len(arrays) - 1
+
+
+def _unflatten(structure, arrays):
+    if isinstance(structure, int):
+        return arrays[structure]
+    items = [_unflatten(x, arrays) for x in structure[1]]
+    return tuple(items) if structure[0] == "t" else items
+
+
+class _SharedRing:
+    """
+    A ring of fixed size slots in shared memory, written by one process and read by another in the same
+    order. The reader copies a row out of its slot before the slot is written again, the callers ensure it
+    by never having more rows in flight than slots. A row which does not fit in a slot is pickled instead.
+    """
+
+    def __init__(self, num_slots, slot_size):
+        self.num_slots = num_slots
+        self.slot_size = slot_size
+        self.buf = multiprocessing.RawArray('B', num_slots * slot_size)
+        self.next_slot = 0
+
+    def put(self, obj):
+        """Writes a row in the next slot, returns its description for the reader."""
+        arrays = []
+        structure = _flatten(obj, arrays)
+        if any(a.dtype.hasobject for a in arrays) or sum(_aligned(a.nbytes) for a in arrays) > self.slot_size:
+            return ("pickled", obj)
+        slot = self.next_slot
+        self.next_slot = (slot + 1) % self.num_slots
+        base = slot * self.slot_size
+        offset = 0
+        metas = []
+        for a in arrays:
+            dst = np.ndarray(a.shape, dtype=a.dtype, buffer=self.buf, offset=base + offset)
+            dst[...] = a
+            metas.append((a.dtype.str, a.shape, offset))
+            offset += _aligned(a.nbytes)
+        return ("shared", slot, structure, metas)
+
+    def get(self, desc):
+        """Copies a row out of the slot of its description."""
+        if desc[0] == "pickled":
+            return desc[1]
+        _, slot, structure, metas = desc
+        base = slot * self.slot_size
+        arrays = [np.ndarray(shape, dtype=np.dtype(dtype), buffer=self.buf, offset=base + offset).copy()
+                  for dtype, shape, offset in metas]
+        return _unflatten(structure, arrays)
+
+
+def _worker_loop(targets, requests, results, in_ring, out_ring):
+    """The loop of a worker process, it computes the requests in order until it gets None."""
+    while True:
+        request = requests.get()
+        if request is None:
+            break
+        try:
+            if request[0] == "index":
+                # A row of a random access source
+                row = tuple(np.array(x) for x in targets[0][request[1]])
+            else:
+                args = in_ring.get(request[2])
+                row = targets[request[1]](*args)
+            results.put(("ok", out_ring.put(row)))
+        except Exception:  # pylint: disable=broad-except
+            results.put(("error", traceback.format_exc()))
+
+
+class _Worker:
+    """A worker process with its pipes and its rings."""
+
+    def __init__(self, context, targets, slot_size):
+        self.requests = context.Queue()
+        self.results = context.Queue()
+        self.in_ring = _SharedRing(_SLOTS_PER_WORKER, slot_size)
+        self.out_ring = _SharedRing(_SLOTS_PER_WORKER, slot_size)
+        self.process = context.Process(target=_worker_loop,
+                                       args=(targets, self.requests, self.results, self.in_ring, self.out_ring),
+                                       daemon=True)
+        self.process.start()
+
+    def result(self):
+        """Waits for the result of the oldest request."""
+        while True:
+            try:
+                status, payload = self.results.get(timeout=_POLL_INTERVAL)
+                break
+            except queue.Empty:
+                if not self.process.is_alive():
+                    raise RuntimeError("A Python worker process of the dataset exited unexpectedly.")
+        if status == "error":
+            raise RuntimeError("Exception in a Python worker process of the dataset:\n" + payload)
+        return self.out_ring.get(payload)
+
+    def close(self):
+        if self.process.is_alive():
+            self.requests.put(None)
+            self.process.join(_POLL_INTERVAL)
+        if self.process.is_alive():
+            self.process.terminate()
+
+
+class _WorkerPool:
+    """
+    Worker processes forked from the current process, so the targets need not be picklable. They are
+    forked once, when the dataset is created, before the threads of its pipeline.
+    """
+
+    def __init__(self, targets, num_workers, max_rowsize):
+        context = multiprocessing.get_context("fork")
+        slot_size = max_rowsize * 1024 * 1024
+        self.workers = [_Worker(context, targets, slot_size) for _ in range(num_workers)]
+        logger.info("Started {} Python worker processes for the dataset.".format(num_workers))
+
+    def __del__(self):
+        for worker in getattr(self, "workers", []):
+            worker.close()
+
+
+class SourceWorkers:
+    """
+    The generator function of a GeneratorDataset whose rows are read by worker processes. The source is a
+    random access one, dataset[i] is a row. The indices of an epoch are given to the workers in turn and the
+    rows come back in the order of the indices.
+
+    Args:
+        source: The random access source.
+        sampler: The indices of each epoch, None for all the rows in order.
+        num_workers (int): The number of worker processes.
+        max_rowsize (int): The size in MB of the largest row which goes through shared memory.
+    """
+
+    def __init__(self, source, sampler, num_workers, max_rowsize):
+        self.source = source
+        self.sampler = sampler
+        self.pool = _WorkerPool([source], num_workers, max_rowsize)
+
+    def __call__(self):
+        indices = self.sampler if self.sampler is not None else range(len(self.source))
+        return self._rows(iter(indices))
+
+    def _rows(self, indices):
+        workers = self.pool.workers
+        pending = collections.deque()
+        issued = 0
+
+        def issue():
+            nonlocal issued
+            index = next(indices, None)
+            if index is None:
+                return False
+            # Round robin, so each worker has at most _SLOTS_PER_WORKER rows in flight
+            worker = workers[issued % len(workers)]
+            worker.requests.put(("index", int(index)))
+            pending.append(worker)
+            issued += 1
+            return True
+
+        try:
+            for _ in range(len(workers) * _SLOTS_PER_WORKER):
+                if not issue():
+                    break
+            while pending:
+                row = pending.popleft().result()
+                issue()
+                yield row
+        finally:
+            # An epoch left early must not leave rows behind for the next one
+            while pending:
+                pending.popleft().result()
+
+
+class FuncWorkers:
+    """
+    The Python functions of a map, computed by worker processes. The calls of the MapOp workers go to the
+    idle processes, and wait for their results without the GIL.
+
+    Args:
+        funcs (list): The Python functions.
+        num_workers (int): The number of worker processes.
+        max_rowsize (int): The size in MB of the largest row which goes through shared memory.
+    """
+
+    def __init__(self, funcs, num_workers, max_rowsize):
+        self.pool = _WorkerPool(funcs, num_workers, max_rowsize)
+        self.idle = queue.Queue()
+        for worker in self.pool.workers:
+            self.idle.put(worker)
+        self.funcs = [_RemoteFunc(self, i) for i in range(len(funcs))]
+
+    def call(self, index, args):
+        worker = self.idle.get()
+        try:
+            worker.requests.put(("call", index, worker.in_ring.put(args)))
+            return worker.result()
+        finally:
+            self.idle.put(worker)
+
+
+class _RemoteFunc:
+    """A function of FuncWorkers, it replaces the Python function in the operations of the map."""
+
+    def __init__(self, workers, index):
+        self.workers = workers
+        self.index = index
+
+    def __call__(self, *args):
+        return self.workers.call(self.index, args)
@@ -255,7 +255,8 @@ def create_node(node):
     elif dataset_op == 'MindDataset':
         pyobj = pyclass(node['dataset_file'], node.get('column_list'),
                         node.get('num_parallel_workers'), node.get('seed'), node.get('num_shards'),
-                        node.get('shard_id'), node.get('block_reader'))
+                        node.get('shard_id'), node.get('block_reader'), node.get('mmap_mode'),
+                        node.get('prefetch_depth'), node.get('shuffle_window'))
 
     elif dataset_op == 'TFRecordDataset':
         pyobj = pyclass(node['dataset_files'], node.get('schema'), node.get('column_list'),
@@ -297,13 +298,17 @@ def create_node(node):
     elif dataset_op == 'RepeatDataset':
         pyobj = de.Dataset().repeat(node.get('count'))
 
+    elif dataset_op == 'CacheDataset':
+        pyobj = de.Dataset().cache(node.get('memory_mb'), node.get('spill_dir'), node.get('session_name'))
+
     elif dataset_op == 'MapDataset':
         tensor_ops = construct_tensor_ops(node.get('operations'))
         pyobj = de.Dataset().map(node.get('input_columns'), tensor_ops, node.get('output_columns'),
-                                 node.get('columns_order'), node.get('num_parallel_workers'))
+                                 node.get('columns_order'), node.get('num_parallel_workers'),
+                                 node.get('batch_mode', False))
 
     elif dataset_op == 'ShuffleDataset':
-        pyobj = de.Dataset().shuffle(node.get('buffer_size'))
+        pyobj = de.Dataset().shuffle(node.get('buffer_size'), node.get('buffer_memory_mb'))
 
     elif dataset_op == 'BatchDataset':
         pyobj = de.Dataset().batch(node['batch_size'], node.get('drop_remainder'))
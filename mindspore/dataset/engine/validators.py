@@ -310,6 +310,7 @@ def check_imagefolderdatasetv2(method):
         nreq_param_bool = ['shuffle', 'decode']
         nreq_param_list = ['extensions']
         nreq_param_dict = ['class_indexing']
+        nreq_param_str = ['index_file']
 
         # check dataset_dir; required argument
         dataset_dir = param_dict.get('dataset_dir')
@@ -325,6 +326,8 @@ def check_imagefolderdatasetv2(method):
 
         check_param_type(nreq_param_dict, param_dict, dict)
 
+        check_param_type(nreq_param_str, param_dict, str)
+
         check_sampler_shuffle_shard_options(param_dict)
 
         return method(*args, **kwargs)
@@ -396,8 +399,9 @@ def check_tfrecorddataset(method):
     def new_method(*args, **kwargs):
         param_dict = make_param_dict(method, args, kwargs)
 
-        nreq_param_int = ['num_samples', 'num_parallel_workers', 'num_shards', 'shard_id']
+        nreq_param_int = ['num_samples', 'num_parallel_workers', 'num_shards', 'shard_id', 'num_readahead_chunks']
         nreq_param_list = ['columns_list']
+        nreq_param_bool = ['write_index_files']
 
         # check dataset_files; required argument
         dataset_files = param_dict.get('dataset_files')
@@ -408,8 +412,14 @@ def check_tfrecorddataset(method):
 
         check_param_type(nreq_param_int, param_dict, int)
 
+        num_readahead_chunks = param_dict.get('num_readahead_chunks')
+        if num_readahead_chunks is not None and num_readahead_chunks < 0:
+            raise ValueError("num_readahead_chunks should not be negative.")
+
         check_param_type(nreq_param_list, param_dict, list)
 
+        check_param_type(nreq_param_bool, param_dict, bool)
+
         return method(*args, **kwargs)
 
     return new_method
@@ -488,9 +498,10 @@ def check_minddataset(method):
     def new_method(*args, **kwargs):
         param_dict = make_param_dict(method, args, kwargs)
 
-        nreq_param_int = ['num_samples', 'num_parallel_workers', 'seed', 'num_shards', 'shard_id']
+        nreq_param_int = ['num_samples', 'num_parallel_workers', 'seed', 'num_shards', 'shard_id', 'prefetch_depth',
+                          'shuffle_window']
         nreq_param_list = ['columns_list']
-        nreq_param_bool = ['block_reader']
+        nreq_param_bool = ['block_reader', 'mmap_mode']
 
         # check dataset_file; required argument
         dataset_file = param_dict.get('dataset_file')
@@ -508,6 +519,14 @@ def check_minddataset(method):
         if (num_shards is not None and shard_id is None) or (num_shards is None and shard_id is not None):
             raise ValueError("num_shards and shard_id need to be set or not set at the same time")
 
+        prefetch_depth = param_dict.get('prefetch_depth')
+        if prefetch_depth is not None and prefetch_depth <= 0:
+            raise ValueError("prefetch_depth should be greater than 0.")
+
+        shuffle_window = param_dict.get('shuffle_window')
+        if shuffle_window is not None and shuffle_window <= 0:
+            raise ValueError("shuffle_window should be greater than 0.")
+
         return method(*args, **kwargs)
 
     return new_method
@@ -519,8 +538,9 @@ def check_generatordataset(method):
     def new_method(*args, **kwargs):
         param_dict = make_param_dict(method, args, kwargs)
 
-        nreq_param_int = ['prefetch_size']
+        nreq_param_int = ['prefetch_size', 'num_parallel_workers', 'max_rowsize']
         nreq_param_list = ['column_names', 'column_types']
+        nreq_param_bool = ['python_multiprocessing']
 
         # check generator_function; required argument
         generator_function = param_dict.get('generator_function')
@@ -536,6 +556,16 @@ def check_generatordataset(method):
 
         check_param_type(nreq_param_list, param_dict, list)
 
+        check_param_type(nreq_param_bool, param_dict, bool)
+
+        num_parallel_workers = param_dict.get('num_parallel_workers')
+        if num_parallel_workers is not None:
+            check_num_parallel_workers(num_parallel_workers)
+
+        max_rowsize = param_dict.get('max_rowsize')
+        if max_rowsize is not None:
+            check_positive_int32(max_rowsize, 'max_rowsize')
+
         return method(*args, **kwargs)
 
     return new_method
@@ -565,6 +595,24 @@ def check_columns(columns, name):
         raise TypeError("{} should be either a list of strings or a single string.".format(name))
 
 
+def check_pad_info(pad_info):
+    """check the pad_info of batch, {column name: (pad shape or None, pad value)}."""
+    check_type(pad_info, 'pad_info', dict)
+    for name, pad in pad_info.items():
+        check_type(name, 'the column names of pad_info', str)
+        if not isinstance(pad, tuple) or len(pad) != 2:
+            raise ValueError("pad_info of column {} should be a tuple (pad_shape, pad_value).".format(name))
+        pad_shape, pad_value = pad
+        if pad_shape is not None:
+            check_type(pad_shape, 'pad_shape', list)
+            for dim in pad_shape:
+                if dim is not None:
+                    check_type(dim, 'the dims of pad_shape', int)
+                    check_positive_int32(dim, 'the dims of pad_shape')
+        if isinstance(pad_value, bool) or not isinstance(pad_value, (int, float)):
+            raise TypeError("pad_value of column {} should be a number.".format(name))
+
+
 def check_batch(method):
     """check the input arguments of batch."""
     @wraps(method)
@@ -572,7 +620,7 @@ def check_batch(method):
         param_dict = make_param_dict(method, args, kwargs)
 
         nreq_param_int = ['num_parallel_workers']
-        nreq_param_bool = ['drop_remainder']
+        nreq_param_bool = ['drop_remainder', 'in_place']
         nreq_param_columns = ['input_columns']
 
         # check batch_size; required argument
@@ -601,6 +649,56 @@ def check_batch(method):
             if len(input_columns) != (len(ins.signature(per_batch_map).parameters) - 1):
                 raise ValueError("the signature of per_batch_map should match with input columns")
 
+        pad_info = param_dict.get('pad_info')
+        if pad_info is not None:
+            check_pad_info(pad_info)
+
+        return method(*args, **kwargs)
+
+    return new_method
+
+
+def check_bucket_batch_by_length(method):
+    """check the input arguments of bucket_batch_by_length."""
+    @wraps(method)
+    def new_method(*args, **kwargs):
+        param_dict = make_param_dict(method, args, kwargs)
+
+        nreq_param_int = ['num_parallel_workers']
+        nreq_param_bool = ['pad_to_bucket_boundary', 'drop_remainder']
+
+        column_name = param_dict.get('column_name')
+        if column_name is None:
+            raise ValueError("column_name is not provided.")
+        check_type(column_name, 'column_name', str)
+
+        bucket_boundaries = param_dict.get('bucket_boundaries')
+        bucket_batch_sizes = param_dict.get('bucket_batch_sizes')
+        if bucket_boundaries is None or bucket_batch_sizes is None:
+            raise ValueError("bucket_boundaries and bucket_batch_sizes are not provided.")
+        check_type(bucket_boundaries, 'bucket_boundaries', list)
+        check_type(bucket_batch_sizes, 'bucket_batch_sizes', list)
+        if not bucket_boundaries:
+            raise ValueError("bucket_boundaries can not be empty.")
+        for boundary in bucket_boundaries:
+            check_type(boundary, 'the values of bucket_boundaries', int)
+            check_positive_int32(boundary, 'the values of bucket_boundaries')
+        if any(low >= high for low, high in zip(bucket_boundaries, bucket_boundaries[1:])):
+            raise ValueError("bucket_boundaries should be strictly increasing.")
+        if len(bucket_batch_sizes) != len(bucket_boundaries) + 1:
+            raise ValueError("bucket_batch_sizes should have one more value than bucket_boundaries.")
+        for batch_size in bucket_batch_sizes:
+            check_type(batch_size, 'the values of bucket_batch_sizes', int)
+            check_positive_int32(batch_size, 'the values of bucket_batch_sizes')
+
+        check_param_type(nreq_param_int, param_dict, int)
+
+        check_param_type(nreq_param_bool, param_dict, bool)
+
+        pad_info = param_dict.get('pad_info')
+        if pad_info is not None:
+            check_pad_info(pad_info)
+
         return method(*args, **kwargs)
 
     return new_method
@@ -619,6 +717,11 @@ def check_shuffle(method):
         check_type(buffer_size, 'buffer_size', int)
         check_interval_closed(buffer_size, 'buffer_size', [2, INT32_MAX])
 
+        buffer_memory_mb = param_dict.get("buffer_memory_mb")
+        if buffer_memory_mb is not None:
+            check_type(buffer_memory_mb, 'buffer_memory_mb', int)
+            check_positive_int32(buffer_memory_mb, 'buffer_memory_mb')
+
         return method(*args, **kwargs)
 
     return new_method
@@ -631,11 +734,13 @@ def check_map(method):
         param_dict = make_param_dict(method, args, kwargs)
 
         nreq_param_list = ['columns_order']
-        nreq_param_int = ['num_parallel_workers']
+        nreq_param_int = ['num_parallel_workers', 'max_rowsize']
         nreq_param_columns = ['input_columns', 'output_columns']
+        nreq_param_bool = ['batch_mode', 'batched_pyfunc', 'python_multiprocessing']
 
         check_param_type(nreq_param_list, param_dict, list)
         check_param_type(nreq_param_int, param_dict, int)
+        check_param_type(nreq_param_bool, param_dict, bool)
         for param_name in nreq_param_columns:
             param = param_dict.get(param_name)
             if param is not None:
@@ -661,6 +766,34 @@ def check_repeat(method):
     return new_method
 
 
+def check_cache(method):
+    """check the input arguments of cache."""
+    @wraps(method)
+    def new_method(*args, **kwargs):
+        param_dict = make_param_dict(method, args, kwargs)
+
+        # check memory_mb; required argument
+        memory_mb = param_dict.get("memory_mb")
+        if memory_mb is None:
+            raise ValueError("memory_mb is not provided.")
+        check_type(memory_mb, 'memory_mb', int)
+        check_positive_int32(memory_mb, 'memory_mb')
+
+        spill_dir = param_dict.get("spill_dir")
+        if spill_dir is not None:
+            check_type(spill_dir, 'spill_dir', str)
+
+        session_name = param_dict.get("session_name")
+        if session_name is not None:
+            check_type(session_name, 'session_name', str)
+            if not session_name or '/' in session_name:
+                raise ValueError("session_name should be a non empty name without '/'.")
+
+        return method(*args, **kwargs)
+
+    return new_method
+
+
 def check_zip(method):
     """check the input arguments of zip."""
     @wraps(method)
@@ -17,5 +17,6 @@ image augmentation module which is developed with c++ opencv. Py_transforms
 provide more kinds of image augmentations which is developed with python PIL.
 """
 from . import vision
+from . import text
 from . import c_transforms
 from . import py_transforms
@@ -0,0 +1,21 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""
+This module is to support text processing for NLP pipelines. The text is kept as the UTF-8 bytes in the uint8
+tensors, the tokenizers give the int32 ids of the tokens in a vocab. The operations are native, so they run in
+parallel by the workers of map.
+"""
+from . import c_transforms
+from .c_transforms import Vocab
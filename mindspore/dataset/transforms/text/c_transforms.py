@@ -0,0 +1,127 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""
+The module text.c_transforms provides the native text operations. The text is kept as the UTF-8 bytes in a 1D
+uint8 tensor, like the bytes columns read from TFRecord, and the tokenizers give a 1D int32 tensor of the ids.
+
+Examples:
+    >>> import mindspore.dataset.transforms.text.c_transforms as text
+    >>> vocab = text.Vocab.from_file("vocab.txt")
+    >>> data = data.map(input_columns=["text"], operations=[text.WordpieceTokenizer(vocab),
+    >>>                                                     text.TruncatePad(128)], num_parallel_workers=8)
+"""
+import mindspore._c_dataengine as cde
+
+from .validators import check_vocab_words, check_tokenizer, check_sliding_window, check_truncate_pad, check_pad_mask
+
+DE_C_DEFAULT_UNKNOWN_TOKEN = "[UNK]"
+
+
+class Vocab(cde.Vocab):
+    """
+    A hash table from the words to their ids, which the tokenizers of all the workers share.
+    Vocab.from_file(path) loads a vocab file with one word per line, like the vocab files of BERT.
+
+    Args:
+        words (list[str]): The words, the id of a word is its index in the list.
+    """
+
+    @check_vocab_words
+    def __init__(self, words):
+        super().__init__(words)
+
+
+class WhitespaceTokenizer(cde.WhitespaceTokenizerOp):
+    """
+    Split the text by the whitespaces and look the words up in the vocab.
+
+    Args:
+        vocab (Vocab): The vocab.
+        unknown_token (str, optional): The token of the words not in the vocab (default="[UNK]"). An error is
+            raised for them if it is not in the vocab either.
+        lower_case (bool, optional): Lower case the ASCII letters before the lookup (default=False).
+    """
+
+    @check_tokenizer
+    def __init__(self, vocab, unknown_token=DE_C_DEFAULT_UNKNOWN_TOKEN, lower_case=False):
+        self.unknown_token = unknown_token
+        self.lower_case = lower_case
+        super().__init__(vocab, unknown_token, lower_case)
+
+
+class WordpieceTokenizer(cde.WordpieceTokenizerOp):
+    """
+    Tokenize the text like BERT. The text is split by the whitespaces, the punctuations and the CJK characters,
+    then every word is split into the longest pieces in the vocab from its start, the pieces after the first one
+    are looked up with the prefix "##". The accents are kept, so the vocab should be cased for the accented text.
+
+    Args:
+        vocab (Vocab): The vocab.
+        unknown_token (str, optional): The token of the words which can not be split (default="[UNK]").
+        lower_case (bool, optional): Lower case the ASCII letters (default=True).
+        max_bytes_per_word (int, optional): The longer words are unknown (default=100).
+    """
+
+    @check_tokenizer
+    def __init__(self, vocab, unknown_token=DE_C_DEFAULT_UNKNOWN_TOKEN, lower_case=True, max_bytes_per_word=100):
+        self.unknown_token = unknown_token
+        self.lower_case = lower_case
+        self.max_bytes_per_word = max_bytes_per_word
+        super().__init__(vocab, unknown_token, lower_case, max_bytes_per_word)
+
+
+class SlidingWindow(cde.SlidingWindowOp):
+    """
+    Stack the windows of the width along the first dimension, e.g. [1,2,3,4] with width 3 gives [[1,2,3],[2,3,4]].
+
+    Args:
+        width (int): The width of the windows.
+    """
+
+    @check_sliding_window
+    def __init__(self, width):
+        self.width = width
+        super().__init__(width)
+
+
+class TruncatePad(cde.TruncatePadOp):
+    """
+    Truncate or pad the first dimension to the length, e.g. [1,2,3] with length 5 gives [1,2,3,0,0].
+
+    Args:
+        length (int): The length.
+        pad_value (int or float, optional): The value of the padded elements (default=0).
+    """
+
+    @check_truncate_pad
+    def __init__(self, length, pad_value=0):
+        self.length = length
+        self.pad_value = pad_value
+        super().__init__(length, pad_value)
+
+
+class PadMask(cde.PadMaskOp):
+    """
+    Generate the int32 mask of a padded tensor, which is 0 for the elements equal to the pad value and 1 for the
+    others, like the input mask of BERT.
+
+    Args:
+        pad_value (int or float, optional): The pad value (default=0).
+    """
+
+    @check_pad_mask
+    def __init__(self, pad_value=0):
+        self.pad_value = pad_value
+        super().__init__(pad_value)
@@ -0,0 +1,142 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""Validators for text TensorOps.
+"""
+from functools import wraps
+
+import mindspore._c_dataengine as cde
+
+from ...transforms.validators import check_pos_int32, check_bool, check_type, check_value, INT32_MAX
+
+
+def check_vocab_words(method):
+    """Wrapper method to check the parameters of Vocab."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        words = (list(args) + [None])[0]
+        if "words" in kwargs:
+            words = kwargs.get("words")
+        if words is None:
+            raise ValueError("words is not provided.")
+        if not isinstance(words, list) or not all(isinstance(w, str) for w in words):
+            raise ValueError("words needs to be a list of str.")
+        kwargs["words"] = words
+
+        return method(self, **kwargs)
+
+    return new_method
+
+
+def check_tokenizer(method):
+    """Wrapper method to check the parameters of the tokenizers."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        args = (list(args) + 4 * [None])[:4]
+        vocab, unknown_token, lower_case, max_bytes_per_word = args
+        if "vocab" in kwargs:
+            vocab = kwargs.get("vocab")
+        if "unknown_token" in kwargs:
+            unknown_token = kwargs.get("unknown_token")
+        if "lower_case" in kwargs:
+            lower_case = kwargs.get("lower_case")
+        if "max_bytes_per_word" in kwargs:
+            max_bytes_per_word = kwargs.get("max_bytes_per_word")
+
+        if vocab is None:
+            raise ValueError("vocab is not provided.")
+        if not isinstance(vocab, cde.Vocab):
+            raise ValueError("vocab needs to be a Vocab.")
+        kwargs["vocab"] = vocab
+        if unknown_token is not None:
+            check_type(unknown_token, str)
+            kwargs["unknown_token"] = unknown_token
+        if lower_case is not None:
+            check_bool(lower_case)
+            kwargs["lower_case"] = lower_case
+        if max_bytes_per_word is not None:
+            check_pos_int32(max_bytes_per_word)
+            kwargs["max_bytes_per_word"] = max_bytes_per_word
+
+        return method(self, **kwargs)
+
+    return new_method
+
+
+def check_sliding_window(method):
+    """Wrapper method to check the parameters of SlidingWindow."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        width = (list(args) + [None])[0]
+        if "width" in kwargs:
+            width = kwargs.get("width")
+        if width is None:
+            raise ValueError("width is not provided.")
+        check_pos_int32(width)
+        kwargs["width"] = width
+
+        return method(self, **kwargs)
+
+    return new_method
+
+
+def check_pad_value(pad_value):
+    if not isinstance(pad_value, (int, float)) or isinstance(pad_value, bool):
+        raise ValueError("pad_value needs to be a number.")
+
+
+def check_truncate_pad(method):
+    """Wrapper method to check the parameters of TruncatePad."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        args = (list(args) + 2 * [None])[:2]
+        length, pad_value = args
+        if "length" in kwargs:
+            length = kwargs.get("length")
+        if "pad_value" in kwargs:
+            pad_value = kwargs.get("pad_value")
+
+        if length is None:
+            raise ValueError("length is not provided.")
+        check_type(length, int)
+        check_value(length, [0, INT32_MAX])
+        kwargs["length"] = length
+        if pad_value is not None:
+            check_pad_value(pad_value)
+            kwargs["pad_value"] = pad_value
+
+        return method(self, **kwargs)
+
+    return new_method
+
+
+def check_pad_mask(method):
+    """Wrapper method to check the parameters of PadMask."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        pad_value = (list(args) + [None])[0]
+        if "pad_value" in kwargs:
+            pad_value = kwargs.get("pad_value")
+        if pad_value is not None:
+            check_pad_value(pad_value)
+            kwargs["pad_value"] = pad_value
+
+        return method(self, **kwargs)
+
+    return new_method
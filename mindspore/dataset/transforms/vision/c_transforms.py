@@ -41,11 +41,13 @@ Examples:
         >>> dataset = dataset.map(input_columns="label", operations=onehot_op)
 """
 import mindspore._c_dataengine as cde
+import mindspore.common.dtype as mstype
 
+from ...core.datatypes import mstype_to_detype
 from .utils import Inter, Border
 from .validators import check_prob, check_crop, check_resize_interpolation, check_random_resize_crop, \
     check_normalize_c, check_random_crop, check_random_color_adjust, check_random_rotation, \
-    check_resize, check_rescale, check_pad, check_cutout
+    check_resize, check_rescale, check_pad, check_cutout, check_normalize_hwc2chw
 
 DE_C_INTER_MODE = {Inter.NEAREST: cde.InterpolationMode.DE_INTER_NEAREST_NEIGHBOUR,
                    Inter.LINEAR: cde.InterpolationMode.DE_INTER_LINEAR,
@@ -373,6 +375,32 @@ class HWC2CHW(cde.ChannelSwapOp):
     """
 
 
+class NormalizeHWC2CHW(cde.FusedNormalizeOp):
+    """
+    Rescale, normalize and transpose the input image from shape (H, W, C) to shape (C, H, W) in a single pass.
+
+    Equivalent to Rescale(rescale, shift), Normalize(mean, std) and HWC2CHW() one after the other, without their
+    intermediate images. On uint8 images the pass is vectorized.
+
+    Args:
+        mean (list): List of mean values for each channel, w.r.t channel order.
+        std (list): List of standard deviations for each channel, w.r.t. channel order.
+        rescale (float, optional): Rescale factor applied before the normalization (default=1.0).
+        shift (float, optional): Shift factor applied before the normalization (default=0.0).
+        output_type (mindspore.dtype, optional): mindspore.float32 or mindspore.float16 (default=mindspore.float32).
+    """
+
+    @check_normalize_hwc2chw
+    def __init__(self, mean, std, rescale=1.0, shift=0.0, output_type=mstype.float32):
+        self.mean = mean
+        self.std = std
+        self.rescale = rescale
+        self.shift = shift
+        self.output_type = str(mstype_to_detype(output_type))
+        ops = [cde.RescaleOp(rescale, shift), cde.NormalizeOp(*mean, *std), cde.ChannelSwapOp()]
+        super().__init__(ops, mstype_to_detype(output_type))
+
+
 class RandomCropDecodeResize(cde.RandomCropDecodeResizeOp):
     """
     Equivalent to RandomResizedCrop, but crops before decodes.
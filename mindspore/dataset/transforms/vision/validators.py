@@ -17,6 +17,8 @@
 import numbers
 from functools import wraps
 
+import mindspore.common.dtype as mstype
+
 from .utils import Inter, Border
 from ...transforms.validators import check_pos_int32, check_pos_float32, check_value, check_uint8, FLOAT_MAX_INTEGER, \
     check_bool, check_2tuple, check_range, check_list, check_type, check_positive, INT32_MAX
@@ -807,3 +809,48 @@ def check_rescale(method):
         return method(self, **kwargs)
 
     return new_method
+
+
+def check_normalize_hwc2chw(method):
+    """Wrapper method to check the parameters of the fused rescale, normalize and HWC2CHW."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        mean, std, rescale, shift, output_type = (list(args) + 5 * [None])[:5]
+        if "mean" in kwargs:
+            mean = kwargs.get("mean")
+        if "std" in kwargs:
+            std = kwargs.get("std")
+        if "rescale" in kwargs:
+            rescale = kwargs.get("rescale")
+        if "shift" in kwargs:
+            shift = kwargs.get("shift")
+        if "output_type" in kwargs:
+            output_type = kwargs.get("output_type")
+
+        if mean is None:
+            raise ValueError("mean is not provided.")
+        if std is None:
+            raise ValueError("std is not provided.")
+        if len(mean) != 3:
+            raise ValueError("mean should have 3 values.")
+        check_normalize_c_param(mean, std)
+        kwargs["mean"] = mean
+        kwargs["std"] = std
+
+        if rescale is not None:
+            check_pos_float32(rescale)
+            kwargs["rescale"] = rescale
+        if shift is not None:
+            if not isinstance(shift, numbers.Number):
+                raise TypeError("shift is not a number.")
+            kwargs["shift"] = shift
+
+        if output_type is not None:
+            if output_type not in (mstype.float32, mstype.float16):
+                raise ValueError("output_type should be mindspore.float32 or mindspore.float16.")
+            kwargs["output_type"] = output_type
+
+        return method(self, **kwargs)
+
+    return new_method
@@ -42,6 +42,7 @@ EXCEPTIONS = dict(
     MRMInvalidHeaderSizeError=[103, 'Failed to set header size.'],
     MRMSetHeaderError=[104, 'Failed to set header.'],
     MRMWriteDatasetError=[105, 'Failed to write dataset.'],
+    MRMInvalidCompressionError=[106, 'Failed to set compression.'],
     MRMCommitError=[107, 'Failed to commit.'],
 
     MRMLaunchError=[108, 'Failed to launch.'],
@@ -60,6 +61,7 @@ EXCEPTIONS = dict(
     MRMFetchCandidateFieldsError=[118, 'Failed to fetch candidate category fields.'],
     MRMReadCategoryInfoError=[119, 'Failed to read category information.'],
     MRMFetchDataError=[120, 'Failed to fetch data by category.'],
+    MRMInvalidFlushBudgetError=[121, 'Failed to set flush budget.'],
 
 
     # MindRecord error 200-299 for File* and MindPage
@@ -206,6 +208,12 @@ class MRMInvalidPageSizeError(MindRecordException):
 class MRMInvalidHeaderSizeError(MindRecordException):
     pass
 
+class MRMInvalidCompressionError(MindRecordException):
+    pass
+
+class MRMInvalidFlushBudgetError(MindRecordException):
+    pass
+
 class MRMSetHeaderError(MindRecordException):
     pass
 
@@ -269,6 +269,45 @@ class FileWriter:
             self._verify_based_on_blob_fields(raw_data)
         return self._writer.write_raw_data(raw_data, validate)
 
+    def write_raw_data_from_files(self, raw_data, file_names, num_workers=8, validate=True):
+        """
+        Write raw data whose only blob field is the content of a file, such as an image. The files are read
+        and written by native threads without the GIL, instead of read into the raw data in python.
+
+        Args:
+           raw_data (list[dict]): List of raw data, without the blob field.
+           file_names (list[str]): The file holding the blob field of each item of raw_data.
+           num_workers (int, optional): The number of threads reading the files (default=8).
+           validate (bool, optional): Validate data according schema if it equals to True (default=True).
+
+        Raises:
+            ParamTypeError: If a parameter is of the wrong type.
+            ParamValueError: If the schema has not exactly one blob field, or the number of file names does
+                not match the raw data.
+            MRMOpenError: If failed to open MindRecord File.
+            MRMSetHeaderError: If failed to set header.
+            MRMWriteDatasetError: If failed to write dataset.
+        """
+        if not isinstance(raw_data, list):
+            raise ParamTypeError('raw_data', 'list')
+        for each_raw in raw_data:
+            if not isinstance(each_raw, dict):
+                raise ParamTypeError('raw_data item', 'dict')
+        if not isinstance(file_names, list) or not all(isinstance(name, str) for name in file_names):
+            raise ParamTypeError('file_names', 'list[str]')
+        if not isinstance(num_workers, int):
+            raise ParamTypeError('num_workers', 'int')
+        if len(raw_data) != len(file_names):
+            raise ParamValueError("The number of file names {} does not match the raw data {}."
+                                  .format(len(file_names), len(raw_data)))
+        if len(self._header.blob_fields) != 1:
+            raise ParamValueError("The schema should have exactly one blob field to read from files.")
+        if not self._writer.is_open:
+            self._writer.open(self._paths)
+        if not self._writer.get_shard_header():
+            self._writer.set_shard_header(self._header)
+        return self._writer.write_raw_data_from_files(raw_data, file_names, num_workers, validate)
+
     def set_header_size(self, header_size):
         """
         Set the size of header.
@@ -300,6 +339,39 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_compression(self, compression):
+        """
+        Set the compression of the blob fields, the readers decompress them on their own.
+
+        Args:
+           compression (str): "none" or "zlib", to be set before the first write_raw_data.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMInvalidCompressionError: If failed to set compression.
+        """
+        return self._writer.set_compression(compression)
+
+    def set_flush_budget(self, flush_budget):
+        """
+        Set the memory budget of the rows waiting for the disk. With a budget, the rows are written by a
+        background thread while the next ones are converted, and a write error is raised by the next
+        write_raw_data or by commit.
+
+        Args:
+           flush_budget (int): bytes, 0 (the default) to write the rows before write_raw_data returns,
+               to be set before the first write_raw_data.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMInvalidFlushBudgetError: If failed to set flush budget.
+        """
+        return self._writer.set_flush_budget(flush_budget)
+
     def commit(self):
         """
         Flush data to disk and generate the correspond db files.
@@ -339,6 +411,9 @@ class FileWriter:
             if os.path.exists(index_file):
                 os.chmod(index_file, stat.S_IRUSR | stat.S_IWUSR)
                 index_files.append(index_file)
+            directory_file = item + ".dir"
+            if os.path.exists(directory_file):
+                os.chmod(directory_file, stat.S_IRUSR | stat.S_IWUSR)
 
         logger.info("The list of mindrecord files created are: {}, and the list of index files are: {}".format(
             mindrecord_files, index_files))
@@ -19,7 +19,8 @@ import numpy as np
 import mindspore._c_mindrecord as ms
 from mindspore import log as logger
 from .common.exceptions import MRMOpenError, MRMOpenForAppendError, MRMInvalidHeaderSizeError, \
-    MRMInvalidPageSizeError, MRMSetHeaderError, MRMWriteDatasetError, MRMCommitError
+    MRMInvalidPageSizeError, MRMInvalidCompressionError, MRMInvalidFlushBudgetError, MRMSetHeaderError, \
+    MRMWriteDatasetError, MRMCommitError
 
 __all__ = ['ShardWriter']
 
@@ -112,6 +113,44 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_compression(self, compression):
+        """
+        Set the compression of the blobs.
+
+        Args:
+           compression (str): "none" or "zlib".
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMInvalidCompressionError: If failed to set compression.
+        """
+        ret = self._writer.set_compression(compression)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set compression.")
+            raise MRMInvalidCompressionError
+        return ret
+
+    def set_flush_budget(self, flush_budget):
+        """
+        Set the memory budget of the rows serialized ahead of the disk writes.
+
+        Args:
+           flush_budget (int): bytes, 0 to write the rows before write_raw_data returns.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMInvalidFlushBudgetError: If failed to set flush budget.
+        """
+        ret = self._writer.set_flush_budget(flush_budget)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set flush budget.")
+            raise MRMInvalidFlushBudgetError
+        return ret
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
@@ -171,6 +210,30 @@ class ShardWriter:
             raise MRMWriteDatasetError
         return ret
 
+    def write_raw_data_from_files(self, data, file_names, num_workers, validate=True):
+        """
+        Write raw data whose only blob field is the content of a file, the files are read by native threads.
+
+        Args:
+           data (list[dict]): List of raw data, without the blob field.
+           file_names (list[str]): The file holding the blob field of each row of data.
+           num_workers (int): The number of threads reading the files.
+           validate (bool, optional): verify data according schema if it equals to True.
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            MRMWriteDatasetError: If failed to write dataset.
+        """
+        raw_data = [{field: item[field] for field in self._header.schema.keys() - self._header.blob_fields
+                     if field in item} for item in data]
+        ret = self._writer.write_raw_data_from_files(raw_data, file_names, num_workers, validate)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to write dataset.")
+            raise MRMWriteDatasetError
+        return ret
+
     def _merge_blob(self, blob_data):
         """
         Merge multiple blob data whose type is bytes or ndarray
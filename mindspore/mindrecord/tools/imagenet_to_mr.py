@@ -43,11 +43,12 @@ class ImageNetToMR:
         image_dir (str): image directory contains n02119789, n02100735, n02110185, n02096294 dir.
         destination (str): the MindRecord file path to transform into.
         partition_number (int, optional): partition size (default=1).
+        num_workers (int, optional): the number of threads reading the images (default=8).
 
     Raises:
         ValueError: If map_file, image_dir or destination is invalid.
     """
-    def __init__(self, map_file, image_dir, destination, partition_number=1):
+    def __init__(self, map_file, image_dir, destination, partition_number=1, num_workers=8):
         check_filename(map_file)
         self.map_file = map_file
 
@@ -64,11 +65,15 @@ class ImageNetToMR:
         else:
             raise ValueError("The parameter partition_number must be int")
 
+        if not isinstance(num_workers, int) or num_workers <= 0:
+            raise ValueError("The parameter num_workers must be positive int")
+        self.num_workers = num_workers
+
         self.writer = FileWriter(self.destination, self.partition_number)
 
     def _get_imagenet_as_dict(self):
         """
-        Get data from imagenet as dict.
+        Get data from imagenet as dict, the image data is left to the writer to read from the file.
 
         Yields:
             data (dict of list): imagenet data list which contains dict.
@@ -96,7 +101,7 @@ class ImageNetToMR:
         if not dir_paths:
             raise PathNotExistsError("not valid image dir in {}".format(self.image_dir))
 
-        # get the filename, label and image binary as a dict
+        # get the filename and label as a dict
         for label in dir_paths:
             for item in os.listdir(dir_paths[label]):
                 file_name = os.path.join(dir_paths[label], item)
@@ -106,12 +111,6 @@ class ImageNetToMR:
                 data = {}
                 data["file_name"] = str(file_name)
                 data["label"] = int(label)
-
-                # get the image data
-                image_file = open(file_name, "rb")
-                image_bytes = image_file.read()
-                image_file.close()
-                data["data"] = image_bytes
                 yield data
 
     def transform(self):
@@ -141,22 +140,11 @@ class ImageNetToMR:
         # add the index
         self.writer.add_index(["label", "file_name"])
 
-        imagenet_iter = self._get_imagenet_as_dict()
-        batch_size = 256
-        transform_count = 0
-        while True:
-            data_list = []
-            try:
-                for _ in range(batch_size):
-                    data_list.append(imagenet_iter.__next__())
-                    transform_count += 1
-                self.writer.write_raw_data(data_list)
-                logger.info("transformed {} record...".format(transform_count))
-            except StopIteration:
-                if data_list:
-                    self.writer.write_raw_data(data_list)
-                    logger.info("transformed {} record...".format(transform_count))
-                break
+        # the images are read by the native threads of the writer, while the images read before are written
+        data_list = list(self._get_imagenet_as_dict())
+        file_names = [data["file_name"] for data in data_list]
+        self.writer.write_raw_data_from_files(data_list, file_names, self.num_workers)
+        logger.info("transformed {} record...".format(len(data_list)))
 
         ret = self.writer.commit()
 
@@ -74,6 +74,7 @@ class Cell:
         if _get_parallel_mode() in ["auto_parallel", "semi_auto_parallel"]:
             self._get_construct_inputs_number_and_name()
         self._parallel_inputs_run = None
+        self._checkpoint_verified = False
 
     @property
     def create_time(self):
@@ -388,9 +389,20 @@ class Cell:
         return param_dict
 
     def parameters_broadcast_dict(self, recurse=True):
+        """
+        Gets the parameters broadcast before training, which leaves out the layerwise parallel parameters and, once
+        all the ranks are verified to load the same checkpoints, the parameters loaded from them.
+
+        Args:
+            recurse (bool): Whether contains the parameters of subcells. Default: True.
+
+        Returns:
+            OrderedDict, the parameters dictionary, or None if there is no parameter to broadcast.
+        """
         param_dict = OrderedDict()
         for param in self.get_parameters(expand=recurse):
-            if param.layerwise_parallel is False:
+            if param.layerwise_parallel is False and \
+                    (param.checkpoint_digest is None or not self._checkpoint_verified):
                 param_dict[param.name] = param
         if not param_dict:
             return None
@@ -651,3 +663,30 @@ class Cell:
         """
         self.add_flags_recursive(broadcast_flag=mode)
         return self
+
+    def set_checkpoint_verified(self, mode=True):
+        """
+        Set whether all the ranks are verified to load the parameters from the same checkpoints, so the parameters
+        loaded from them are not broadcast.
+
+        Args:
+            mode (bool): Specifies whether the checkpoints are verified. Default: True.
+        """
+        self._checkpoint_verified = mode
+        return self
+
+    def recompute(self, mode=True):
+        """
+        Set the operators of the cell and its children cells to be recomputed in the backward graph.
+
+        The outputs of the recomputed operators are not kept from the forward pass to the backward pass, which
+        trades computation for memory.
+
+        Args:
+            mode (bool): Specifies whether the operators are recomputed. Default: True.
+        """
+        for _, cell in self.cells_and_names():
+            for value in cell.__dict__.values():
+                if isinstance(value, Primitive):
+                    value.add_prim_attr("recompute", mode)
+        return self
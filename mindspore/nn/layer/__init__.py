@@ -23,7 +23,7 @@ from .container import SequentialCell, CellList
 from .conv import Conv2d, Conv2dTranspose
 from .lstm import LSTM
 from .basic import Dropout, Flatten, Dense, ClipByNorm, Norm, OneHot
-from .embedding import Embedding
+from .embedding import Embedding, HostEmbeddingTable, HostEmbeddingLookup
 from .pooling import AvgPool2d, MaxPool2d
 
 __all__ = ['Softmax', 'LogSoftmax', 'ReLU', 'ReLU6', 'Tanh', 'GELU', 'Sigmoid', 'PReLU', 'get_activation', 'LeakyReLU',
@@ -32,6 +32,6 @@ __all__ = ['Softmax', 'LogSoftmax', 'ReLU', 'ReLU6', 'Tanh', 'GELU', 'Sigmoid',
            'Conv2d', 'Conv2dTranspose',
            'LSTM',
            'Dropout', 'Flatten', 'Dense', 'ClipByNorm', 'Norm', 'OneHot',
-           'Embedding',
+           'Embedding', 'HostEmbeddingTable', 'HostEmbeddingLookup',
            'AvgPool2d', 'MaxPool2d',
            ]
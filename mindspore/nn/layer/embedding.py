@@ -13,13 +13,14 @@
 # limitations under the License.
 # ============================================================================
 """embedding"""
+import numpy as np
 import mindspore.common.dtype as mstype
 from mindspore.common.tensor import Tensor
 from mindspore.ops import operations as P
 from mindspore.common.parameter import Parameter
 from mindspore.common.initializer import initializer
 from ..cell import Cell
-from ..._checkparam import ParamValidator as validator
+from ..._checkparam import ParamValidator as validator, Rel
 
 
 class Embedding(Cell):
@@ -101,3 +102,114 @@ class Embedding(Cell):
                 self.embedding_table,
                 self.dtype)
         return s
+
+
+class HostEmbeddingTable:
+    r"""
+    An embedding table kept in the host memory, for the tables too large for the device memory.
+
+    The rows looked up by a batch are gathered on the host and fed to the network, which gathers the embeddings
+    from them on the device with `HostEmbeddingLookup`, and the gradients of these rows are applied on the host
+    with the sparse adagrad scheme, so only the looked-up rows are transferred each step.
+
+    .. math::
+            accum += grad * grad
+    .. math::
+            var -= lr * grad * (1 / sqrt(accum))
+
+    The ids of a batch are deduplicated by `prefetch`, which is meant to run in the dataset pipeline, so that it
+    is overlapped with the training of the previous batches. The rows are gathered right before the step, so they
+    are never stale.
+
+    Args:
+        vocab_size (int): Size of the dictionary of embeddings.
+        embedding_size (int): The size of each embedding vector.
+        learning_rate (float): Learning rate of the sparse adagrad update. Default: 0.01.
+        initial_accum (float): Initial value of the adagrad accumulators. Default: 0.1.
+        embedding_table (numpy.ndarray): The initial embedding table of shape (vocab_size, embedding_size). If
+            None, it is sampled from the normal distribution N(0, 0.01). Default: None.
+
+    Examples:
+        >>> table = nn.HostEmbeddingTable(100000000, 64)
+        >>> # map the 'ids' column into the 'unique_ids' and 'restore_ids' columns
+        >>> dataset = dataset.map(input_columns=["ids"], output_columns=["unique_ids", "restore_ids"],
+        >>>                       columns_order=["unique_ids", "restore_ids", "data", "label"],
+        >>>                       operations=table.prefetch)
+    """
+    def __init__(self, vocab_size, embedding_size, learning_rate=0.01, initial_accum=0.1, embedding_table=None):
+        self.vocab_size = validator.check_integer('vocab_size', vocab_size, 0, Rel.GT)
+        self.embedding_size = validator.check_integer('embedding_size', embedding_size, 0, Rel.GT)
+        self.learning_rate = validator.check_float_positive('learning_rate', learning_rate)
+        initial_accum = validator.check_float_positive('initial_accum', initial_accum)
+        if embedding_table is None:
+            embedding_table = np.random.normal(0.0, 0.01, [vocab_size, embedding_size])
+        self.embedding_table = np.ascontiguousarray(embedding_table, dtype=np.float32)
+        if self.embedding_table.shape != (vocab_size, embedding_size):
+            raise ValueError("The shape of the embedding table should be {}, but got {}."
+                             .format((vocab_size, embedding_size), self.embedding_table.shape))
+        self.accum = np.full([vocab_size, embedding_size], initial_accum, dtype=np.float32)
+
+    def prefetch(self, ids):
+        """
+        Deduplicate the ids of a batch.
+
+        Args:
+            ids (numpy.ndarray): The ids of a batch.
+
+        Returns:
+            - **unique_ids** (numpy.ndarray) - The distinct ids, padded to the size of `ids` with -1, so that the
+              looked-up rows have a static shape. The type is int32.
+            - **restore_ids** (numpy.ndarray) - The positions of `ids` in `unique_ids`, which has the same shape as
+              `ids`. The type is int32.
+        """
+        flat_ids = np.asarray(ids).reshape(-1)
+        unique, restore = np.unique(flat_ids, return_inverse=True)
+        if unique.size and (unique[0] < 0 or unique[-1] >= self.vocab_size):
+            raise ValueError("The ids should be in [0, {}), but got [{}, {}]."
+                             .format(self.vocab_size, unique[0], unique[-1]))
+        unique_ids = np.full(flat_ids.size, -1, dtype=np.int32)
+        unique_ids[:unique.size] = unique
+        return unique_ids, restore.reshape(np.shape(ids)).astype(np.int32)
+
+    def lookup(self, unique_ids):
+        """Gather the rows of `unique_ids` from the table, the rows of the padding ids are zeros."""
+        valid = unique_ids >= 0
+        rows = np.zeros([unique_ids.size, self.embedding_size], dtype=np.float32)
+        rows[valid] = self.embedding_table[unique_ids[valid]]
+        return rows
+
+    def update(self, unique_ids, grad):
+        """Apply the gradients of the rows of `unique_ids` to the table, the rows of the padding ids are ignored."""
+        valid = unique_ids >= 0
+        ids = unique_ids[valid]
+        grad = np.asarray(grad, dtype=np.float32)[valid]
+        # the ids are distinct, so the rows can be updated by fancy indexing
+        self.accum[ids] += grad * grad
+        self.embedding_table[ids] -= self.learning_rate * grad / np.sqrt(self.accum[ids])
+
+
+class HostEmbeddingLookup(Cell):
+    r"""
+    Looks up the embeddings from the rows gathered from a `HostEmbeddingTable`.
+
+    Inputs:
+        - **rows** (Tensor) - The rows of the distinct ids of a batch, of shape :math:`(N, \text{embedding_size})`.
+        - **restore_ids** (Tensor) - The positions of the ids of the batch in the rows, the type is int32.
+
+    Outputs:
+        Tensor of shape :math:`(\text{restore_ids.shape}, \text{embedding_size})`.
+
+    Examples:
+        >>> lookup = nn.HostEmbeddingLookup()
+        >>> rows = Tensor(np.ones([6, 64]), mindspore.float32)
+        >>> restore_ids = Tensor(np.array([[0, 1, 2], [3, 1, 0]]), mindspore.int32)
+        >>> output = lookup(rows, restore_ids)
+        >>> output.shape()
+        (2, 3, 64)
+    """
+    def __init__(self):
+        super(HostEmbeddingLookup, self).__init__()
+        self.gather = P.GatherV2()
+
+    def construct(self, rows, restore_ids):
+        return self.gather(rows, restore_ids, 0)
@@ -32,6 +32,32 @@ _learning_rate_update_func = ['linear', 'cos', 'sin']
 adam_opt = C.MultitypeFuncGraph("adam_opt")
 
 
+def _adam_next_state(beta1, beta2, eps, lr, weight_decay_tensor, param, m, v, gradient):
+    """Compute the next param, m and v in float32."""
+    op_mul = P.Mul()
+    op_square = P.Square()
+    op_sqrt = P.Sqrt()
+    op_cast = P.Cast()
+    op_reshape = P.Reshape()
+    op_shape = P.Shape()
+
+    param = op_cast(param, mstype.float32)
+    m = op_cast(m, mstype.float32)
+    v = op_cast(v, mstype.float32)
+    gradient = op_cast(gradient, mstype.float32)
+
+    next_m = op_mul(beta1, m) + op_mul(op_cast(F.tuple_to_array((1.0,)), mstype.float32) - beta1, gradient)
+
+    next_v = op_mul(beta2, v) + op_mul(op_cast(F.tuple_to_array((1.0,)), mstype.float32) - beta2, op_square(gradient))
+
+    update = next_m / (op_sqrt(next_v) + eps)
+    update = update + op_mul(weight_decay_tensor, param)
+
+    update_with_lr = op_mul(lr, update)
+    next_param = param - op_reshape(update_with_lr, op_shape(param))
+    return next_param, next_m, next_v
+
+
 @adam_opt.register("Tensor", "Tensor", "Tensor", "Tensor", "Tensor", "Tensor", "Tensor", "Tensor", "Tensor")
 def _update_run_op(beta1, beta2, eps, lr, weight_decay_tensor, param, m, v, gradient):
     """
@@ -51,27 +77,45 @@ def _update_run_op(beta1, beta2, eps, lr, weight_decay_tensor, param, m, v, grad
     Returns:
         Tensor, the new value of v after updating.
     """
-    op_mul = P.Mul()
-    op_square = P.Square()
-    op_sqrt = P.Sqrt()
-    op_cast = P.Cast()
-    op_reshape = P.Reshape()
-    op_shape = P.Shape()
+    next_param, next_m, next_v = _adam_next_state(beta1, beta2, eps, lr, weight_decay_tensor, param, m, v, gradient)
 
-    param = op_cast(param, mstype.float32)
-    m = op_cast(m, mstype.float32)
-    v = op_cast(v, mstype.float32)
-    gradient = op_cast(gradient, mstype.float32)
+    next_v = F.depend(next_v, F.assign(param, next_param))
+    next_v = F.depend(next_v, F.assign(m, next_m))
+    next_v = F.depend(next_v, F.assign(v, next_v))
+    return next_v
 
-    next_m = op_mul(beta1, m) + op_mul(op_cast(F.tuple_to_array((1.0,)), mstype.float32) - beta1, gradient)
 
-    next_v = op_mul(beta2, v) + op_mul(op_cast(F.tuple_to_array((1.0,)), mstype.float32) - beta2, op_square(gradient))
+adam_opt_shard = C.MultitypeFuncGraph("adam_opt_shard")
 
-    update = next_m / (op_sqrt(next_v) + eps)
-    update = update + op_mul(weight_decay_tensor, param)
 
-    update_with_lr = op_mul(lr, update)
-    next_param = param - op_reshape(update_with_lr, op_shape(param))
+@adam_opt_shard.register("Function", "Function", "Function", "Number", "Tensor", "Tensor", "Tensor", "Tensor",
+                         "Tensor", "Tensor", "Bool", "Tensor", "Tensor", "Tensor", "Tensor")
+def _update_run_op_with_shard(reduce_scatter, all_gather, split, rank, grad_mean, beta1, beta2, eps, lr,
+                              weight_decay_tensor, shard, param, m, v, gradient):
+    """
+    Update parameters whose m and v are sharded across the devices.
+
+    Args:
+        reduce_scatter (Function): Sums the gradients of the devices and keeps the slice of this device.
+        all_gather (Function): Gathers the slices of the devices along the first dimension.
+        split (Function): Splits the parameter into the slices of the devices along the first dimension.
+        rank (int): The rank of this device.
+        grad_mean (Tensor): The mean coefficient of the reduced gradient.
+        shard (bool): Whether m and v of the parameter are sharded. If not, the gradient is already reduced.
+        param (Tensor): Parameters.
+        m (Tensor): m value of the slice of parameters.
+        v (Tensor): v value of the slice of parameters.
+        gradient (Tensor): Gradient of parameters.
+
+    Returns:
+        Tensor, the new value of v after updating.
+    """
+    if not shard:
+        return _update_run_op(beta1, beta2, eps, lr, weight_decay_tensor, param, m, v, gradient)
+    gradient = reduce_scatter(F.cast(gradient, mstype.float32)) * grad_mean
+    next_param, next_m, next_v = _adam_next_state(beta1, beta2, eps, lr, weight_decay_tensor, split(param)[rank],
+                                                  m, v, gradient)
+    next_param = all_gather(next_param)
 
     next_v = F.depend(next_v, F.assign(param, next_param))
     next_v = F.depend(next_v, F.assign(m, next_m))
@@ -79,6 +123,36 @@ def _update_run_op(beta1, beta2, eps, lr, weight_decay_tensor, param, m, v, grad
     return next_v
 
 
+def _init_parallel_optimizer(optimizer):
+    """
+    Shard m and v of the parameters of `optimizer` across the devices along the first dimension, if the parallel
+    optimizer is enabled. Returns the moments and the sharded flags.
+    """
+    if not optimizer.parallel_optimizer:
+        return optimizer.params.clone(prefix="adam_m", init='zeros'), \
+               optimizer.params.clone(prefix="adam_v", init='zeros'), None
+    group_size = get_group_size()
+    rank = get_rank()
+    shard_filter = tuple(_is_parallel_optimizer_param(x, group_size) for x in optimizer.params)
+    moments = []
+    for prefix in ["adam_m", "adam_v"]:
+        moment = []
+        for param, shard in zip(optimizer.params, shard_filter):
+            shape = param.default_input.shape()
+            if shard:
+                shape = (shape[0] // group_size,) + tuple(shape[1:])
+            moment.append(Parameter(initializer('zeros', shape, param.default_input.dtype()),
+                                    name=prefix + '.' + param.name))
+        moments.append(ParameterTuple(moment))
+    optimizer.reduce_scatter = P.ReduceScatter(ReduceOp.SUM, GlobalComm.WORLD_COMM_GROUP)
+    optimizer.all_gather = P.AllGather(GlobalComm.WORLD_COMM_GROUP)
+    optimizer.split = P.Split(0, group_size)
+    optimizer.rank = rank
+    grad_mean = 1.0 / group_size if _get_mirror_mean() else 1.0
+    optimizer.grad_mean = Tensor(np.array([grad_mean]).astype(np.float32))
+    return moments[0], moments[1], shard_filter
+
+
 def _check_param_value(beta1, beta2, eps, weight_decay):
     """Check the type of inputs."""
     validator.check_type("beta1", beta1, [float])
@@ -255,6 +329,9 @@ class AdamWeightDecay(Optimizer):
         >>> optim = AdamWeightDecay(params=net.trainable_params())
         >>> model = Model(net, loss_fn=loss, optimizer=optim, metrics=None)
    """
+
+    support_parallel_optimizer = True
+
     def __init__(self, params, learning_rate=1e-3, beta1=0.9, beta2=0.999, eps=1e-6, weight_decay=0.0):
         super(AdamWeightDecay, self).__init__(learning_rate, params)
         _check_param_value(beta1, beta2, eps, weight_decay)
@@ -265,15 +342,21 @@ class AdamWeightDecay(Optimizer):
         self.weight_decay_tensor = Tensor(np.array([weight_decay]).astype(np.float32))
 
         self.params = self.parameters
-        self.moments1 = self.params.clone(prefix="adam_m", init='zeros')
-        self.moments2 = self.params.clone(prefix="adam_v", init='zeros')
+        self.moments1, self.moments2, self.shard_filter = _init_parallel_optimizer(self)
 
         self.hyper_map = C.HyperMap()
 
     def construct(self, gradients):
-        updated_velocity = self.hyper_map(F.partial(adam_opt, self.beta1, self.beta2, self.eps, self.lr,
-                                                    self.weight_decay_tensor),
-                                          self.params, self.moments1, self.moments2, gradients)
+        if self.parallel_optimizer:
+            updated_velocity = self.hyper_map(F.partial(adam_opt_shard, self.reduce_scatter, self.all_gather,
+                                                        self.split, self.rank, self.grad_mean, self.beta1,
+                                                        self.beta2, self.eps, self.lr, self.weight_decay_tensor),
+                                              self.shard_filter, self.params, self.moments1, self.moments2,
+                                              gradients)
+        else:
+            updated_velocity = self.hyper_map(F.partial(adam_opt, self.beta1, self.beta2, self.eps, self.lr,
+                                                        self.weight_decay_tensor),
+                                              self.params, self.moments1, self.moments2, gradients)
 
         return updated_velocity
 
@@ -309,6 +392,9 @@ class AdamWeightDecayDynamicLR(Optimizer):
         >>> optim = AdamWeightDecayDynamicLR(params=net.trainable_params(), decay_steps=10)
         >>> model = Model(net, loss_fn=loss, optimizer=optim, metrics=None)
     """
+
+    support_parallel_optimizer = True
+
     def __init__(self,
                  params,
                  decay_steps,
@@ -333,8 +419,7 @@ class AdamWeightDecayDynamicLR(Optimizer):
         self.eps = Tensor(np.array([eps]).astype(np.float32))
         self.weight_decay_tensor = Tensor(np.array([weight_decay]).astype(np.float32))
         self.params = self.parameters
-        self.moments1 = self.params.clone(prefix="adam_m", init='zeros')
-        self.moments2 = self.params.clone(prefix="adam_v", init='zeros')
+        self.moments1, self.moments2, self.shard_filter = _init_parallel_optimizer(self)
 
         self.hyper_map = C.HyperMap()
         self.min = P.Minimum()
@@ -345,9 +430,16 @@ class AdamWeightDecayDynamicLR(Optimizer):
         step = self.min(self.global_step, self.decay_steps)
         p = step / self.decay_steps
         lr = self.diff_learning_rate * self.pow(self.one - p, self.power) + self.end_learning_rate
-        updated_velocity = self.hyper_map(F.partial(adam_opt, self.beta1, self.beta2, self.eps, lr,
-                                                    self.weight_decay_tensor),
-                                          self.params, self.moments1, self.moments2, gradients)
+        if self.parallel_optimizer:
+            updated_velocity = self.hyper_map(F.partial(adam_opt_shard, self.reduce_scatter, self.all_gather,
+                                                        self.split, self.rank, self.grad_mean, self.beta1,
+                                                        self.beta2, self.eps, lr, self.weight_decay_tensor),
+                                              self.shard_filter, self.params, self.moments1, self.moments2,
+                                              gradients)
+        else:
+            updated_velocity = self.hyper_map(F.partial(adam_opt, self.beta1, self.beta2, self.eps, lr,
+                                                        self.weight_decay_tensor),
+                                              self.params, self.moments1, self.moments2, gradients)
 
         added_global_step = self.global_step + self.one
         F.control_depend(lr, added_global_step)
@@ -24,6 +24,8 @@ from mindspore.common.parameter import Parameter, ParameterTuple
 from mindspore._checkparam import ParamValidator as validator
 from mindspore._checkparam import Rel
 from mindspore.common.tensor import Tensor
+from mindspore.train.parallel_utils import ParallelMode
+from mindspore.parallel._utils import _get_enable_parallel_optimizer, _get_parallel_mode
 
 logger = logging.getLogger('Optimizer')
 
@@ -48,8 +50,12 @@ class Optimizer(Cell):
     Raises:
         ValueError: If the learning_rate is a Tensor, but the dims of tensor is greater than 1.
         TypeError: If the learning_rate is not any of the three types: float, Tensor, Iterable.
+        RuntimeError: If the parallel optimizer is enabled in data parallel, but the optimizer does not support it.
     """
 
+    # Whether the optimizer can shard its states across the devices when `enable_parallel_optimizer` is set.
+    support_parallel_optimizer = False
+
     def __init__(self, learning_rate, parameters):
         super(Optimizer, self).__init__()
         if isinstance(learning_rate, float):
@@ -70,6 +76,10 @@ class Optimizer(Cell):
         self.parameters = ParameterTuple(parameters)
         if not self.parameters:
             raise ValueError("optimizer got an empty parameter list.")
+        self.parallel_optimizer = _get_enable_parallel_optimizer() and \
+            _get_parallel_mode() == ParallelMode.DATA_PARALLEL
+        if self.parallel_optimizer and not self.support_parallel_optimizer:
+            raise RuntimeError(f"{type(self).__name__} does not support the parallel optimizer.")
 
     def construct(self, *hyper_params):
         raise NotImplementedError
@@ -18,17 +18,21 @@ Wrap cells for networks.
 Use the Wrapper to combine the loss or build the training steps.
 """
 from .cell_wrapper import TrainOneStepCell, WithLossCell, WithGradCell, WithEvalCell, DataWrapper, \
-     ParameterUpdate, GetNextSingleOp
+     ParameterUpdate, GetNextSingleOp, TrainOneStepWithHostEmbeddingCell, NumericCheckCell, \
+     TrainOneStepWithAccumulationCell
 from .loss_scale import TrainOneStepWithLossScaleCell, DynamicLossScaleUpdateCell, FixedLossScaleUpdateCell
 from .grad_reducer import DistributedGradReducer
 
 __all__ = [
     "TrainOneStepCell",
+    "TrainOneStepWithAccumulationCell",
+    "TrainOneStepWithHostEmbeddingCell",
     "WithLossCell",
     "WithGradCell",
     "WithEvalCell",
     "DataWrapper",
     "GetNextSingleOp",
+    "NumericCheckCell",
     "TrainOneStepWithLossScaleCell",
     "DistributedGradReducer",
     "ParameterUpdate",
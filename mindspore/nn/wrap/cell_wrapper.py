@@ -17,6 +17,7 @@ import copy
 import numpy as np
 from mindspore.train.parallel_utils import ParallelMode
 from mindspore.parallel._utils import _get_device_num, _get_parallel_mode, _get_mirror_mean
+from mindspore._checkparam import check_int_positive
 from ...ops import composite as C, functional as F, operations as P
 from ...common import Tensor, dtype as mstype
 from ..cell import Cell
@@ -25,6 +26,19 @@ from ...common.parameter import Parameter, ParameterTuple
 from ...ops.operations.comm_ops import _VirtualDataset
 from .grad_reducer import DistributedGradReducer
 
+_accumulate_grad = C.MultitypeFuncGraph("accumulate_grad")
+_mean_grad = C.MultitypeFuncGraph("mean_grad")
+
+
+@_accumulate_grad.register("Tensor", "Tensor", "Tensor")
+def _tensor_accumulate_grad(keep, accu_grad, grad):
+    return F.assign(accu_grad, accu_grad * F.cast(keep, F.dtype(accu_grad)) + F.cast(grad, F.dtype(accu_grad)))
+
+
+@_mean_grad.register("Tensor", "Tensor")
+def _tensor_mean_grad(scale, accu_grad):
+    return accu_grad * F.cast(scale, F.dtype(accu_grad))
+
 
 class WithLossCell(Cell):
     r"""
@@ -214,6 +228,169 @@ class TrainOneStepCell(Cell):
         return F.depend(loss, self.optimizer(grads))
 
 
+class TrainOneStepWithAccumulationCell(Cell):
+    r"""
+    Network training package class with gradient accumulation.
+
+    A step is made of `accumulation_steps` micro steps, each of which runs the cell on a batch of inputs, so it
+    trains the network with batches `accumulation_steps` times as large in the same memory. The gradients of the
+    micro steps are accumulated in buffers kept on the device, and the mean of them is reduced over the devices and
+    applied by the optimizer on the last micro step only, which cuts the communication by `accumulation_steps` times.
+    The micro steps run the same compiled graph, the update is a branch taken by a counter on the device, so it
+    works in the dataset sink mode as well.
+
+    Args:
+        network (Cell): The training network.
+        optimizer (Cell): Optimizer for updating the weights.
+        accumulation_steps (int): The number of micro steps of a step, a positive int.
+        sens (Number): The scaling number to be filled as the input of backpropagation. Default value is 1.0.
+
+    Inputs:
+        - **data** (Tensor) - Tensor of shape :math:`(N, \ldots)`.
+        - **label** (Tensor) - Tensor of shape :math:`(N, \ldots)`.
+
+    Outputs:
+        Tensor, the loss of the micro step, a scalar Tensor with shape :math:`()`.
+
+    Examples:
+        >>> net = Net()
+        >>> loss_fn = nn.SoftmaxCrossEntropyWithLogits()
+        >>> optim = nn.Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+        >>> loss_net = nn.WithLossCell(net, loss_fn)
+        >>> train_net = nn.TrainOneStepWithAccumulationCell(loss_net, optim, accumulation_steps=4)
+    """
+    def __init__(self, network, optimizer, accumulation_steps, sens=1.0):
+        super(TrainOneStepWithAccumulationCell, self).__init__(auto_prefix=False)
+        self.accumulation_steps = check_int_positive(accumulation_steps)
+        self.network = network
+        self.network.add_flags(defer_inline=True)
+        self.weights = ParameterTuple(network.trainable_params())
+        self.optimizer = optimizer
+        self.grad = C.GradOperation('grad', get_by_list=True, sens_param=True)
+        self.sens = sens
+        self.hyper_map = C.HyperMap()
+        self.accu_grads = self.weights.clone(prefix="accu_grads", init='zeros')
+        # the index of the micro step in the step
+        self.micro_step = Parameter(initializer(0, [1], mstype.int32), name="micro_step")
+        self.zero = Tensor(np.zeros([1]).astype(np.int32))
+        self.one = Tensor(np.ones([1]).astype(np.int32))
+        self.last_micro_step = Tensor(np.array([accumulation_steps - 1]).astype(np.int32))
+        self.scale = Tensor(1.0 / accumulation_steps, mstype.float32)
+        self.equal = P.Equal()
+        self.not_equal = P.NotEqual()
+        self.select = P.Select()
+        self.reducer_flag = False
+        self.grad_reducer = None
+        parallel_mode = _get_parallel_mode()
+        if parallel_mode in (ParallelMode.DATA_PARALLEL, ParallelMode.HYBRID_PARALLEL):
+            self.reducer_flag = True
+        if self.reducer_flag:
+            mean = _get_mirror_mean()
+            degree = _get_device_num()
+            self.grad_reducer = DistributedGradReducer(optimizer.parameters, mean, degree)
+
+    def construct(self, data, label):
+        weights = self.weights
+        loss = self.network(data, label)
+        sens = P.Fill()(P.DType()(loss), P.Shape()(loss), self.sens)
+        grads = self.grad(self.network, weights)(data, label, sens)
+        micro_step = self.micro_step
+        # the gradients of the last step are dropped on the first micro step, instead of being cleared by the update
+        keep = self.not_equal(micro_step, self.zero)
+        accu_grads = self.hyper_map(F.partial(_accumulate_grad, keep), self.accu_grads, grads)
+        loss = F.depend(loss, accu_grads)
+        is_last = self.equal(micro_step, self.last_micro_step)
+        next_micro_step = self.select(is_last, self.zero, micro_step + self.one)
+        loss = F.depend(loss, F.assign(self.micro_step, next_micro_step))
+        # update the weights by the mean of the accumulated gradients on the last micro step
+        if is_last:
+            grads = self.hyper_map(F.partial(_mean_grad, self.scale), accu_grads)
+            if self.reducer_flag:
+                # apply grad reducer on grads
+                grads = self.grad_reducer(grads)
+            update = self.optimizer(grads)
+        else:
+            update = False
+        return F.depend(loss, update)
+
+
+class TrainOneStepWithHostEmbeddingCell(Cell):
+    r"""
+    Network training package class for the network whose embedding table is kept in the host memory.
+
+    The network takes the rows gathered from a `HostEmbeddingTable` and the positions of the ids in them as its
+    first two inputs, and looks up the embeddings with `HostEmbeddingLookup`. The weights of the network are
+    updated by the optimizer on the device, and the gradients of the rows are returned to update the table on
+    the host. Call `train_step` to run a whole step, the table is kept per process, so only the stand-alone mode
+    is supported.
+
+    Args:
+        network (Cell): The training network with loss.
+        optimizer (Cell): Optimizer for updating the weights.
+        host_table (HostEmbeddingTable): The embedding table in the host memory.
+        sens (Number): The scaling number to be filled as the input of backpropagation. Default value is 1.0.
+
+    Inputs:
+        - **rows** (Tensor) - Tensor of shape :math:`(N, \text{embedding_size})`.
+        - **restore_ids** (Tensor) - Tensor of the positions of the ids in the rows.
+        - **data** (Tensor) - Tensor of shape :math:`(N, \ldots)`.
+        - **label** (Tensor) - Tensor of shape :math:`(N, \ldots)`.
+
+    Outputs:
+        Tuple of 2 Tensors, the loss and the gradients of the rows.
+
+    Examples:
+        >>> table = nn.HostEmbeddingTable(100000000, 64)
+        >>> net = Net()
+        >>> optim = nn.Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+        >>> train_net = nn.TrainOneStepWithHostEmbeddingCell(net, optim, table)
+        >>> for unique_ids, restore_ids, data, label in dataset.create_tuple_iterator():
+        >>>     loss = train_net.train_step(unique_ids, restore_ids, data, label)
+    """
+    def __init__(self, network, optimizer, host_table, sens=1.0):
+        super(TrainOneStepWithHostEmbeddingCell, self).__init__(auto_prefix=False)
+        if _get_parallel_mode() != ParallelMode.STAND_ALONE:
+            raise ValueError("The host embedding table only supports the stand-alone mode, but got {}."
+                             .format(_get_parallel_mode()))
+        self.network = network
+        self.network.add_flags(defer_inline=True)
+        self.weights = ParameterTuple(network.trainable_params())
+        self.optimizer = optimizer
+        self.host_table = host_table
+        self.grad = C.GradOperation('grad', get_all=True, get_by_list=True, sens_param=True)
+        self.sens = sens
+
+    def construct(self, rows, restore_ids, data, label):
+        weights = self.weights
+        loss = self.network(rows, restore_ids, data, label)
+        sens = P.Fill()(P.DType()(loss), P.Shape()(loss), self.sens)
+        inputs_grads, grads = self.grad(self.network, weights)(rows, restore_ids, data, label, sens)
+        return F.depend(loss, self.optimizer(grads)), inputs_grads[0]
+
+    def train_step(self, unique_ids, restore_ids, data, label):
+        """
+        Gather the rows of `unique_ids` on the host, run a step on the device and update the rows on the host.
+
+        Args:
+            unique_ids (Union[Tensor, numpy.ndarray]): The distinct ids of the batch given by
+                `HostEmbeddingTable.prefetch`.
+            restore_ids (Union[Tensor, numpy.ndarray]): The positions of the ids of the batch in `unique_ids`.
+            data (Tensor): Tensor data to train.
+            label (Tensor): Tensor label data.
+
+        Returns:
+            Tensor, the loss of the step.
+        """
+        if isinstance(unique_ids, Tensor):
+            unique_ids = unique_ids.asnumpy()
+        if not isinstance(restore_ids, Tensor):
+            restore_ids = Tensor(restore_ids, mstype.int32)
+        rows = Tensor(self.host_table.lookup(unique_ids))
+        loss, rows_grad = self(rows, restore_ids, data, label)
+        self.host_table.update(unique_ids, rows_grad.asnumpy())
+        return loss
+
+
 class DataWrapper(Cell):
     """
     Network training package class for dataset.
@@ -271,6 +448,65 @@ class GetNextSingleOp(Cell):
         return self.get_next()
 
 
+class NumericCheckCell(Cell):
+    """
+    Cell to check the tensors, such as some outputs or the gradients of a step, for inf and nan on the device.
+
+    The tensors are reduced to their numeric status by `ops.operations.NumericStatus` in a few kernel launches, and
+    only the status is copied to host, so it is cheap enough to run every step. After the step, `first_non_finite`
+    finds the first tensor with inf or nan in the order of the names, such as the execution order of the ops.
+
+    Note:
+        Only supported on the `GPU` device.
+
+    Args:
+        names (Union[tuple[str], list[str]]): The names of the tensors checked, such as the names of the ops producing
+            them, or the names of the parameters of the gradients.
+
+    Inputs:
+        - **tensors** (Union(tuple[Tensor], list[Tensor])) - The tensors of float16 or float32, all of the same dtype.
+
+    Outputs:
+        Tensor of float32, the status of the tensors with the shape of :math:`(N, 5)`.
+
+    Examples:
+        >>> weights = net.trainable_params()
+        >>> check = NumericCheckCell([weight.name for weight in weights])
+        >>> status = check(grads)
+        >>> check.first_non_finite(status)
+    """
+
+    def __init__(self, names):
+        super(NumericCheckCell, self).__init__(auto_prefix=False)
+        if not isinstance(names, (tuple, list)) or not names or not all(isinstance(name, str) for name in names):
+            raise TypeError("The names should be a non-empty tuple or list of str.")
+        self.names = list(names)
+        self.numeric_status = P.NumericStatus()
+
+    def construct(self, tensors):
+        return self.numeric_status(tensors)
+
+    def first_non_finite(self, status):
+        """
+        Find the first tensor with inf or nan.
+
+        Args:
+            status (Tensor): The output of the cell.
+
+        Returns:
+            None if all the tensors are finite, otherwise a tuple of the name of the first tensor with inf or nan
+            and a dict of its status.
+        """
+        status = status.asnumpy()
+        if status.shape != (len(self.names), 5):
+            raise ValueError(f"The status shape {status.shape} does not match the {len(self.names)} names.")
+        for name, row in zip(self.names, status):
+            if row[0] > 0 or row[1] > 0:
+                return name, {"nan_count": int(row[0]), "inf_count": int(row[1]),
+                              "min": float(row[2]), "max": float(row[3]), "mean": float(row[4])}
+        return None
+
+
 class _VirtualDatasetCell(Cell):
     """
     Wrap the network with virtual dataset to convert data parallel layout to model parallel layout.
@@ -13,10 +13,16 @@
 # limitations under the License.
 # ============================================================================
 """grad reducer cell for distributed training"""
+import numpy as np
 from mindspore.nn.cell import Cell
+from mindspore.common.parameter import ParameterTuple
 from mindspore.communication.management import GlobalComm, get_group_size
 from mindspore.ops import functional as F, composite as C, operations as P
-from mindspore.ops.operations.comm_ops import AllReduce, ReduceOp
+from mindspore.ops.operations.comm_ops import AllGather, AllReduce, ReduceOp, ReduceScatter
+from mindspore.train.parallel_utils import ParallelMode
+from mindspore.parallel._utils import _get_enable_parallel_optimizer, _get_parallel_mode, \
+    _is_parallel_optimizer_param, _get_hierarchical_allreduce_groups, _get_gradient_compression, \
+    _get_topk_compression_ratio
 import mindspore.common.dtype as mstype
 
 reduce_opt = C.MultitypeFuncGraph("reduce_opt")
@@ -24,12 +30,34 @@ reduce_opt = C.MultitypeFuncGraph("reduce_opt")
 _all_reduce = AllReduce()
 
 
+_intra_reduce_scatter = None
+_inter_all_reduce = None
+_intra_all_gather = None
+
+
 def _init_optimizer_allreduce():
     global _all_reduce
     _all_reduce = AllReduce(ReduceOp.SUM, GlobalComm.WORLD_COMM_GROUP)
     _all_reduce.add_prim_attr('fusion', 1)
 
 
+def _init_hierarchical_allreduce(intra_group, inter_group):
+    global _intra_reduce_scatter
+    global _inter_all_reduce
+    global _intra_all_gather
+    _intra_reduce_scatter = ReduceScatter(ReduceOp.SUM, intra_group)
+    _inter_all_reduce = AllReduce(ReduceOp.SUM, inter_group)
+    _inter_all_reduce.add_prim_attr('fusion', 1)
+    _intra_all_gather = AllGather(intra_group)
+
+
+def _hierarchical_allreduce(grad):
+    """Reduce scatter the flattened gradient in the node, all reduce the slices across the nodes and all gather."""
+    flat_grad = F.reshape(grad, (-1,))
+    flat_grad = _intra_all_gather(_inter_all_reduce(_intra_reduce_scatter(flat_grad)))
+    return F.reshape(flat_grad, F.shape(grad))
+
+
 @reduce_opt.register("Function", "Number", "Bool", "Tensor")
 def _tensors_allreduce_mean(mul, degree, allreduce_filter, grad):
     """
@@ -69,6 +97,144 @@ def _tensors_allreduce(allreduce_filter, grad):
     return grad
 
 
+hierarchical_reduce_opt = C.MultitypeFuncGraph("hierarchical_reduce_opt")
+
+
+@hierarchical_reduce_opt.register("Function", "Number", "Bool", "Bool", "Tensor")
+def _tensors_hierarchical_allreduce_mean(mul, degree, allreduce_filter, hierarchical_filter, grad):
+    """
+    Apply mean and allreduce on gradient, the allreduce is done hierarchically if hierarchical_filter is true.
+
+    Args:
+        mul (Primitive): Div operation.
+        degree (int): The mean coefficient.
+        allreduce_filter (bool): When it is true, allreduce would apply.
+        hierarchical_filter (bool): When it is true, the allreduce is done hierarchically.
+        grad (Tensor): The gradient tensor before operation.
+
+    Returns:
+        Tensor, the gradient tensor after operation.
+    """
+    if allreduce_filter:
+        degree = F.scalar_cast(degree, F.dtype(grad))
+        if hierarchical_filter:
+            grad = _hierarchical_allreduce(grad)
+        else:
+            grad = _all_reduce(grad)
+        cast_op = P.Cast()
+        return mul(grad, cast_op(F.scalar_to_array(1.0/degree), F.dtype(grad)))
+    return grad
+
+
+@hierarchical_reduce_opt.register("Bool", "Bool", "Tensor")
+def _tensors_hierarchical_allreduce(allreduce_filter, hierarchical_filter, grad):
+    """
+    Apply allreduce on gradient, the allreduce is done hierarchically if hierarchical_filter is true.
+
+    Args:
+        allreduce_filter (bool): When it is true, allreduce would apply.
+        hierarchical_filter (bool): When it is true, the allreduce is done hierarchically.
+        grad (Tensor): The gradient tensor before operation.
+
+    Returns:
+        Tensor, the gradient tensor after operation.
+    """
+    if allreduce_filter:
+        if hierarchical_filter:
+            return _hierarchical_allreduce(grad)
+        return _all_reduce(grad)
+    return grad
+
+
+_fp16_all_reduce = None
+_sparse_all_gather = None
+
+
+def _init_gradient_compression():
+    global _fp16_all_reduce
+    global _sparse_all_gather
+    _fp16_all_reduce = AllReduce(ReduceOp.SUM, GlobalComm.WORLD_COMM_GROUP)
+    _fp16_all_reduce.add_prim_attr('fusion', 1)
+    _sparse_all_gather = AllGather(GlobalComm.WORLD_COMM_GROUP)
+
+
+def _compressed_allreduce(topk_num, residual, grad):
+    """
+    All reduce the gradient compensated by the residual of the last step, and update the residual with the error of
+    the compression.
+
+    Args:
+        topk_num (int): The number of the elements all-gathered by the top-k compression, 0 for the float16 compression.
+        residual (Parameter): The compression error of the last step.
+        grad (Tensor): The gradient tensor before operation.
+
+    Returns:
+        Tensor, the gradient tensor after operation.
+    """
+    grad = grad + F.cast(residual, F.dtype(grad))
+    if topk_num > 0:
+        flat_grad = F.reshape(grad, (-1,))
+        grad_size = F.shape(flat_grad)[0]
+        _, indices = P.TopK()(P.Abs()(flat_grad), topk_num)
+        values = P.GatherV2()(flat_grad, indices, 0)
+        new_residual = flat_grad - P.UnsortedSegmentSum()(values, indices, grad_size)
+        # the indices of the devices may overlap, the values are summed at the same index
+        dense_grad = P.UnsortedSegmentSum()(_sparse_all_gather(values), _sparse_all_gather(indices), grad_size)
+        new_grad = F.reshape(dense_grad, F.shape(grad))
+        new_residual = F.reshape(new_residual, F.shape(grad))
+    else:
+        fp16_grad = F.cast(grad, mstype.float16)
+        new_residual = grad - F.cast(fp16_grad, F.dtype(grad))
+        new_grad = F.cast(_fp16_all_reduce(fp16_grad), F.dtype(grad))
+    return F.depend(new_grad, F.assign(residual, F.cast(new_residual, F.dtype(residual))))
+
+
+compressed_reduce_opt = C.MultitypeFuncGraph("compressed_reduce_opt")
+
+
+@compressed_reduce_opt.register("Function", "Number", "Bool", "Number", "Tensor", "Tensor")
+def _tensors_compressed_allreduce_mean(mul, degree, allreduce_filter, topk_num, residual, grad):
+    """
+    Apply mean and compressed allreduce on gradient.
+
+    Args:
+        mul (Primitive): Div operation.
+        degree (int): The mean coefficient.
+        allreduce_filter (bool): When it is true, allreduce would apply.
+        topk_num (int): The number of the elements all-gathered by the top-k compression, 0 for the float16 compression.
+        residual (Parameter): The compression error of the last step.
+        grad (Tensor): The gradient tensor before operation.
+
+    Returns:
+        Tensor, the gradient tensor after operation.
+    """
+    if allreduce_filter:
+        degree = F.scalar_cast(degree, F.dtype(grad))
+        grad = _compressed_allreduce(topk_num, residual, grad)
+        cast_op = P.Cast()
+        return mul(grad, cast_op(F.scalar_to_array(1.0/degree), F.dtype(grad)))
+    return grad
+
+
+@compressed_reduce_opt.register("Bool", "Number", "Tensor", "Tensor")
+def _tensors_compressed_allreduce(allreduce_filter, topk_num, residual, grad):
+    """
+    Apply compressed allreduce on gradient.
+
+    Args:
+        allreduce_filter (bool): When it is true, allreduce would apply.
+        topk_num (int): The number of the elements all-gathered by the top-k compression, 0 for the float16 compression.
+        residual (Parameter): The compression error of the last step.
+        grad (Tensor): The gradient tensor before operation.
+
+    Returns:
+        Tensor, the gradient tensor after operation.
+    """
+    if allreduce_filter:
+        return _compressed_allreduce(topk_num, residual, grad)
+    return grad
+
+
 _get_datatype = C.MultitypeFuncGraph("_get_datatype")
 
 
@@ -178,7 +344,29 @@ class DistributedGradReducer(Cell):
             self.degree = degree
         self.mean = mean
         self.allreduce_filter = tuple(x.layerwise_parallel is False for x in parameters)
+        if _get_enable_parallel_optimizer() and _get_parallel_mode() == ParallelMode.DATA_PARALLEL:
+            # the gradients of the parameters sharded by the parallel optimizer are reduce-scattered in the optimizer
+            group_size = get_group_size()
+            self.allreduce_filter = tuple(not _is_parallel_optimizer_param(x, group_size) and allreduce_filter
+                                          for x, allreduce_filter in zip(parameters, self.allreduce_filter))
         _init_optimizer_allreduce()
+        # the compression error of each gradient is kept on device, and added to the gradient of the next step
+        self.compression = _get_gradient_compression()
+        if self.compression != "none":
+            self.residuals = ParameterTuple(parameters).clone(prefix="compression_residual", init='zeros')
+            ratio = _get_topk_compression_ratio()
+            self.topk_num = tuple(max(int(np.prod(x.default_input.shape()) * ratio), 1)
+                                  if self.compression == "topk" else 0 for x in parameters)
+            _init_gradient_compression()
+        # the gradients whose element numbers can be scattered in the node are all-reduced hierarchically
+        self.hierarchical = False
+        hierarchical_groups = _get_hierarchical_allreduce_groups()
+        if hierarchical_groups is not None and self.compression == "none":
+            intra_group, inter_group, intra_dev_num = hierarchical_groups
+            self.hierarchical = True
+            self.hierarchical_filter = tuple(int(np.prod(x.default_input.shape())) % intra_dev_num == 0
+                                             for x in parameters)
+            _init_hierarchical_allreduce(intra_group, inter_group)
 
     def construct(self, grads):
         # In some circumstances, the data precision of grads could be mixed with float16 and float32. Thus, the
@@ -187,7 +375,21 @@ class DistributedGradReducer(Cell):
         datatypes = self.hyper_map(F.partial(_get_datatype), grads)
         grads = self.hyper_map(F.partial(_cast_datatype, mstype.float32), grads)
 
-        if self.mean:
+        if self.compression != "none":
+            if self.mean:
+                new_grad = self.hyper_map(F.partial(compressed_reduce_opt, self.mul, self.degree),
+                                          self.allreduce_filter, self.topk_num, self.residuals, grads)
+            else:
+                new_grad = self.hyper_map(F.partial(compressed_reduce_opt), self.allreduce_filter, self.topk_num,
+                                          self.residuals, grads)
+        elif self.hierarchical:
+            if self.mean:
+                new_grad = self.hyper_map(F.partial(hierarchical_reduce_opt, self.mul, self.degree),
+                                          self.allreduce_filter, self.hierarchical_filter, grads)
+            else:
+                new_grad = self.hyper_map(F.partial(hierarchical_reduce_opt), self.allreduce_filter,
+                                          self.hierarchical_filter, grads)
+        elif self.mean:
             new_grad = self.hyper_map(F.partial(reduce_opt, self.mul, self.degree), self.allreduce_filter, grads)
         else:
             new_grad = self.hyper_map(F.partial(reduce_opt), self.allreduce_filter, grads)
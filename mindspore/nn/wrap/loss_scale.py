@@ -16,6 +16,7 @@
 from mindspore.nn.wrap.grad_reducer import DistributedGradReducer
 from mindspore.train.parallel_utils import ParallelMode
 from mindspore.parallel._utils import _get_device_num, _get_parallel_mode, _get_mirror_mean
+from mindspore import context
 from ..cell import Cell
 from ...common import Tensor, ParameterTuple
 from ...common.parameter import Parameter
@@ -23,7 +24,7 @@ from ...ops import functional as F
 from ...ops import composite as C
 from ...ops import operations as P
 from ...ops.operations import NPUGetFloatStatus, NPUAllocFloatStatus, NPUClearFloatStatus, ReduceSum, LessEqual, \
-    ControlDepend
+    ControlDepend, CheckOverflow, UpdateLossScale
 from ...common import dtype as mstype
 
 _grad_scale = C.MultitypeFuncGraph("grad_scale")
@@ -91,11 +92,16 @@ class DynamicLossScaleUpdateCell(Cell):
         self.logic_not = P.LogicalNot()
         self.logic_or = P.LogicalOr()
         self.const_true = Tensor(True, dtype=mstype.bool_)
+        # the whole update is one kernel on GPU
+        self.gpu_target = context.get_context("device_target") == "GPU"
+        self.update_loss_scale = UpdateLossScale(scale_factor, scale_window)
 
     def get_loss_scale(self):
         return self.loss_scale_value
 
     def construct(self, loss_scale, overflow):
+        if self.gpu_target:
+            return self.update_loss_scale(loss_scale, self.cur_iter, self.last_overflow_iter, overflow)
         overflow_cond = overflow
         loss_scale_on_overflow = self.select(overflow_cond, self.max(loss_scale * self.reciprocal(self.scale_factor),
                                                                      self.minimum_loss_scale), loss_scale)
@@ -211,6 +217,9 @@ class TrainOneStepWithLossScaleCell(Cell):
             degree = _get_device_num()
             self.grad_reducer = DistributedGradReducer(optimizer.parameters, mean, degree)
         self.is_distributed = self.parallel_mode != ParallelMode.STAND_ALONE
+        # the gradients are checked by CheckOverflow on GPU, which has no float status register
+        self.gpu_target = context.get_context("device_target") == "GPU"
+        self.check_overflow = CheckOverflow()
 
         self.loss_scale = None
         self.loss_scaling_manager = scale_update_cell
@@ -222,10 +231,12 @@ class TrainOneStepWithLossScaleCell(Cell):
     def construct(self, data, label, sens=None):
         weights = self.weights
         loss = self.network(data, label)
-        # init overflow buffer
-        init = self.alloc_status()
-        # clear overflow buffer
-        self.clear_status(init)
+        init = False
+        if not self.gpu_target:
+            # init overflow buffer
+            init = self.alloc_status()
+            # clear overflow buffer
+            self.clear_status(init)
         if sens is None:
             scaling_sens = self.loss_scale
         else:
@@ -235,16 +246,20 @@ class TrainOneStepWithLossScaleCell(Cell):
         if self.reducer_flag:
             # apply grad reducer on grads
             grads = self.grad_reducer(grads)
-        # get the overflow buffer
-        self.get_status(init)
-        # sum overflow buffer elements, 0:not overflow , >0:overflow
-        flag_sum = self.reduce_sum(init, (0,))
-        if self.is_distributed:
-            # sum overflow flag over devices
-            flag_reduce = self.allreduce(flag_sum)
-            cond = self.less_equal(self.base, flag_reduce)
+        if self.gpu_target:
+            # the reduced gradients are the same on all the devices, so are their overflows
+            cond = self.check_overflow(grads)
         else:
-            cond = self.less_equal(self.base, flag_sum)
+            # get the overflow buffer
+            self.get_status(init)
+            # sum overflow buffer elements, 0:not overflow , >0:overflow
+            flag_sum = self.reduce_sum(init, (0,))
+            if self.is_distributed:
+                # sum overflow flag over devices
+                flag_reduce = self.allreduce(flag_sum)
+                cond = self.less_equal(self.base, flag_reduce)
+            else:
+                cond = self.less_equal(self.base, flag_sum)
         overflow = cond
         if sens is None:
             overflow = self.loss_scaling_manager(self.loss_scale, cond)
@@ -117,6 +117,24 @@ def get_bprop_mirror_operator(self):
         instance_name = "grad_mirror" + self.instance_name
         all_reduce.set_prim_instance_name(instance_name)
 
+    if self.inter_group:
+        # reduce scatter in the node, all reduce 1/intra_dev_num of the gradient across the nodes, and all gather
+        # in the node
+        reduce_scatter = ReduceScatter(ReduceOp.SUM, self.intra_group)
+        inter_all_reduce = AllReduce(group=self.inter_group)
+        inter_all_reduce.add_prim_attr("fusion", fusion)
+        if hasattr(self, 'parameter'):
+            inter_all_reduce.add_prim_attr("parameter", self.parameter)
+        all_gather = AllGather(group=self.intra_group)
+        reshape = P.Reshape()
+        shape = P.Shape()
+
+        def hierarchical_all_reduce(dout):
+            dx = reshape(dout, (-1,))
+            dx = all_gather(inter_all_reduce(reduce_scatter(dx)))
+            return reshape(dx, shape(dout))
+        all_reduce = hierarchical_all_reduce
+
     def bprop(x, out, dout):
         if mean_flag:
             dx = all_reduce(dout)
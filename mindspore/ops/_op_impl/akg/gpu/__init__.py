@@ -22,4 +22,6 @@ from .relu6 import _relu6_akg
 from .relu6_grad import _relu6_grad_akg
 from .squeeze import _squeeze_akg
 from .squeeze_grad import _squeeze_grad_akg
+from .tanh import _tanh_akg
+from .tensor_add import _tensor_add_akg
 from .tile import _tile_akg
@@ -37,18 +37,18 @@ from .debug_ops import (ImageSummary, InsertGradientOf, ScalarSummary,
                         TensorSummary, Print)
 from .control_ops import ControlDepend, GeSwitch, Merge
 from .inner_ops import ScalarCast
-from .math_ops import (Abs, ACos, AddN, AssignAdd, AssignSub, BatchMatMul,
+from .math_ops import (Abs, ACos, AddN, AssignAdd, AssignSub, BatchMatMul, CheckOverflow,
                        ReduceMax, ReduceMin, ReduceMean, ReduceSum, ReduceAll, ReduceProd, CumProd,
                        Cos, Div, Equal, EqualCount, Exp, Floor, FloorDiv,
                        Greater, GreaterEqual, Less, LessEqual, Log, LogicalAnd,
                        LogicalNot, LogicalOr, MatMul, Maximum,
                        Minimum, Mul, Neg, NMSWithMask, NotEqual,
-                       NPUAllocFloatStatus, NPUClearFloatStatus,
+                       NPUAllocFloatStatus, NPUClearFloatStatus, NumericStatus,
                        NPUGetFloatStatus, Pow, RealDiv,
                        Reciprocal, CumSum,
                        Sin, Sqrt, Rsqrt,
-                       Square, Sub, TensorAdd, Sign, Round)
-from .random_ops import (RandomChoiceWithMask)
+                       Square, Sub, TensorAdd, Sign, Round, UpdateLossScale)
+from .random_ops import (RandomChoiceWithMask, RandomCropResizeNormalize)
 from .nn_ops import (LSTM, SGD, Adam, ApplyMomentum, BatchNorm,
                      BiasAdd, Conv2D,
                      DepthwiseConv2dNative,
@@ -137,6 +137,7 @@ __all__ = [
     'Sigmoid',
     'Tanh',
     'RandomChoiceWithMask',
+    'RandomCropResizeNormalize',
     'ResizeBilinear',
     'ScalarSummary',
     'ImageSummary',
@@ -153,6 +154,9 @@ __all__ = [
     'NPUAllocFloatStatus',
     'NPUGetFloatStatus',
     'NPUClearFloatStatus',
+    'CheckOverflow',
+    'NumericStatus',
+    'UpdateLossScale',
     'Reciprocal',
     'SmoothL1Loss',
     'ReduceAll',
@@ -329,13 +329,23 @@ class _MirrorOperator(PrimitiveWithInfer):
         group (str): The communication group to work on. Default: None.
         dev_num (int): The device number of the group. Default: None.
         mean_flag (bool): Whether use mean in backward. Default: None.
+        intra_group (str): The communication group of the devices of the group in this node. If it is set, the all
+            reduce is done hierarchically, by a reduce scatter in intra_group, an all reduce in inter_group and an
+            all gather in intra_group. Default: None.
+        inter_group (str): The communication group of the devices of the group at the same position in the other
+            nodes. Default: None.
+        intra_dev_num (int): The device number of intra_group. Default: None.
     """
 
     @prim_attr_register
-    def __init__(self, group=None, dev_num=None, mean_flag=None):
+    def __init__(self, group=None, dev_num=None, mean_flag=None, intra_group=None, inter_group=None,
+                 intra_dev_num=None):
         self.group = group
         self.dev_num = dev_num
         self.mean_flag = mean_flag
+        self.intra_group = intra_group
+        self.inter_group = inter_group
+        self.intra_dev_num = intra_dev_num
 
     def infer_shape(self, x_shape):
         return x_shape
@@ -1613,6 +1613,143 @@ class NPUClearFloatStatus(PrimitiveWithInfer):
         return mstype.float32
 
 
+class CheckOverflow(PrimitiveWithInfer):
+    """
+    Checks whether any element of the input tensors is inf or nan.
+
+    Note:
+        It's the overflow check of the loss scale training on the `GPU` device, all the tensors are checked in a few
+        kernel launches.
+
+    Inputs:
+        - **inputs** (Union(tuple[Tensor], list[Tensor])) - The tensors of float16 or float32, all of the same dtype.
+
+    Outputs:
+        Tensor, a bool scalar tensor, True if there is overflow.
+
+    Examples:
+        >>> check_overflow = CheckOverflow()
+        >>> x = Tensor(np.array([1.0, np.inf]), mindspore.float32)
+        >>> y = Tensor(np.array([1.0, 2.0]), mindspore.float32)
+        >>> check_overflow((x, y))
+        Tensor(True, shape=(), dtype=mindspore.bool_)
+    """
+
+    @prim_attr_register
+    def __init__(self):
+        """init CheckOverflow"""
+        self.init_prim_io_names(inputs=["inputs"], outputs=["overflow"])
+
+    def infer_shape(self, inputs):
+        validator.check_integer("inputs", len(inputs), 1, Rel.GE)
+        return []
+
+    def infer_dtype(self, inputs):
+        validator.check_type("inputs", inputs, [tuple, list])
+        args = {}
+        for i, dtype in enumerate(inputs):
+            validator.check_subclass(f"inputs[{i}]", dtype, mstype.tensor)
+            args[f"inputs[{i}]"] = dtype
+        validator.check_type_same(args, [mstype.float16, mstype.float32])
+        return mstype.bool_
+
+
+class NumericStatus(PrimitiveWithInfer):
+    """
+    Computes the numeric status of each input tensor, to find the tensors with inf or nan.
+
+    The status of a tensor is the count of nan, the count of inf, and the min, max and mean of its finite elements,
+    which are 0 if there are none.
+
+    Note:
+        It runs on the `GPU` device, all the tensors are reduced in a few kernel launches like `CheckOverflow`, so
+        only the small status tensor needs to be copied to host.
+
+    Inputs:
+        - **inputs** (Union(tuple[Tensor], list[Tensor])) - The tensors of float16 or float32, all of the same dtype.
+
+    Outputs:
+        Tensor of float32, with the shape of :math:`(N, 5)`, where :math:`N` is the number of the input tensors.
+
+    Examples:
+        >>> numeric_status = NumericStatus()
+        >>> x = Tensor(np.array([1.0, np.inf, 3.0]), mindspore.float32)
+        >>> y = Tensor(np.array([1.0, 2.0]), mindspore.float32)
+        >>> numeric_status((x, y))
+        [[0.0, 1.0, 1.0, 3.0, 2.0],
+         [0.0, 0.0, 1.0, 2.0, 1.5]]
+    """
+
+    @prim_attr_register
+    def __init__(self):
+        """init NumericStatus"""
+        self.init_prim_io_names(inputs=["inputs"], outputs=["status"])
+
+    def infer_shape(self, inputs):
+        validator.check_integer("inputs", len(inputs), 1, Rel.GE)
+        return [len(inputs), 5]
+
+    def infer_dtype(self, inputs):
+        validator.check_type("inputs", inputs, [tuple, list])
+        args = {}
+        for i, dtype in enumerate(inputs):
+            validator.check_subclass(f"inputs[{i}]", dtype, mstype.tensor)
+            args[f"inputs[{i}]"] = dtype
+        validator.check_type_same(args, [mstype.float16, mstype.float32])
+        return mstype.float32
+
+
+class UpdateLossScale(PrimitiveWithInfer):
+    """
+    Updates the dynamic loss scale by the overflow of a step, like `DynamicLossScaleUpdateCell`.
+
+    On overflow the loss scale is divided by `scale_factor`, but not below 1. After `scale_window` steps without
+    overflow it is multiplied by `scale_factor`. The loss scale, the current step and the last overflow step are
+    updated in place.
+
+    Note:
+        It's the loss scale update of `DynamicLossScaleUpdateCell` on the `GPU` device, done in one kernel.
+
+    Args:
+        scale_factor (float): Coefficient of increase and decrease.
+        scale_window (int): Maximum continuous training steps that do not have overflow.
+
+    Inputs:
+        - **loss_scale** (Parameter) - The loss scale, a float32 scalar.
+        - **cur_iter** (Parameter) - The current step, an int32 scalar.
+        - **last_overflow_iter** (Parameter) - The last step of overflow or increasing the loss scale, an int32 scalar.
+        - **overflow** (Tensor) - The bool scalar overflow of the current step.
+
+    Outputs:
+        Tensor, the overflow.
+    """
+    __mindspore_signature__ = (
+        ('loss_scale', sig_rw.RW_WRITE, sig_kind.KIND_POSITIONAL_KEYWORD),
+        ('cur_iter', sig_rw.RW_WRITE, sig_kind.KIND_POSITIONAL_KEYWORD),
+        ('last_overflow_iter', sig_rw.RW_WRITE, sig_kind.KIND_POSITIONAL_KEYWORD),
+        ('overflow', sig_rw.RW_READ, sig_kind.KIND_POSITIONAL_KEYWORD)
+    )
+
+    @prim_attr_register
+    def __init__(self, scale_factor, scale_window):
+        """init UpdateLossScale"""
+        validator.check_type("scale_factor", scale_factor, [float, int])
+        validator.check_type("scale_window", scale_window, [int])
+        self.scale_factor = float(scale_factor)
+        self.add_prim_attr("scale_factor", self.scale_factor)
+        self.init_prim_io_names(inputs=['loss_scale', 'cur_iter', 'last_overflow_iter', 'overflow'],
+                                outputs=['output'])
+
+    def infer_shape(self, loss_scale, cur_iter, last_overflow_iter, overflow):
+        return overflow
+
+    def infer_dtype(self, loss_scale, cur_iter, last_overflow_iter, overflow):
+        validator.check_type_same({"loss_scale": loss_scale}, [mstype.float32])
+        validator.check_type_same({"cur_iter": cur_iter, "last_overflow_iter": last_overflow_iter}, [mstype.int32])
+        validator.check_type_same({"overflow": overflow}, [mstype.bool_])
+        return overflow
+
+
 class Cos(PrimitiveWithInfer):
     """
     Computes cosine of input element-wise.
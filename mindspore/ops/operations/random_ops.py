@@ -62,3 +62,65 @@ class RandomChoiceWithMask(PrimitiveWithInfer):
         validator.check_subclass('x_dtype', x_dtype, mstype.tensor)
         validator.check_typename('x_dtype', x_dtype, [mstype.bool_])
         return (mstype.int32, mstype.bool_)
+
+
+class RandomCropResizeNormalize(PrimitiveWithInfer):
+    """
+    Randomly crops every image of a decoded batch, resizes the crops and normalizes them.
+
+    It runs the per sample augmentation of the dataset RandomResizedCrop and Normalize on the device, after the
+    batch left the dataset pipeline, so that the host cores only decode. Each crop covers a random area of the
+    image in `scale` with a random aspect ratio in `ratio`, it is resized bilinearly to `size`. Only GPU is supported.
+
+    Args:
+        size (tuple): The (height, width) of the output images.
+        scale (tuple): Range of the area of the crop relative to the image. Default: (0.08, 1.0).
+        ratio (tuple): Range of the aspect ratio of the crop. Default: (3. / 4., 4. / 3.).
+        mean (tuple): Mean of each channel. Default: (0.0, 0.0, 0.0).
+        std (tuple): Standard deviation of each channel. Default: (1.0, 1.0, 1.0).
+        seed (int): Random seed. Default: 0.
+
+    Inputs:
+        - **images** (Tensor) - The uint8 images, a tensor of shape :math:`(N, H, W, C)`.
+
+    Outputs:
+        Tensor, the float32 augmented images, of shape :math:`(N, C, size[0], size[1])`.
+
+    Examples:
+        >>> augment = RandomCropResizeNormalize((224, 224), mean=(123.7, 116.3, 103.5), std=(58.4, 57.1, 57.4))
+        >>> output = augment(images)
+    """
+
+    @prim_attr_register
+    def __init__(self, size, scale=(0.08, 1.0), ratio=(3. / 4., 4. / 3.), mean=(0.0, 0.0, 0.0),
+                 std=(1.0, 1.0, 1.0), seed=0):
+        """Init RandomCropResizeNormalize"""
+        self.init_prim_io_names(inputs=['images'], outputs=['output'])
+        for name, value in (('size', size), ('scale', scale), ('ratio', ratio), ('mean', mean), ('std', std)):
+            validator.check_type(name, value, [tuple])
+        validator.check("size len", len(size), '', 2)
+        validator.check("scale len", len(scale), '', 2)
+        validator.check("ratio len", len(ratio), '', 2)
+        validator.check("std len", len(std), "mean len", len(mean))
+        for value in size:
+            validator.check_type("size", value, [int])
+            validator.check_integer("size", value, 0, Rel.GT)
+        for value in scale + ratio + mean + std:
+            validator.check_type("scale, ratio, mean and std", value, [int, float])
+        for value in scale + ratio + std:
+            validator.check_float_positive("scale, ratio and std", float(value))
+        validator.check("scale[0]", scale[0], "scale[1]", scale[1], Rel.LE)
+        validator.check("ratio[0]", ratio[0], "ratio[1]", ratio[1], Rel.LE)
+        validator.check_type('seed', seed, [int])
+        for name, value in (('scale', scale), ('ratio', ratio), ('mean', mean), ('std', std)):
+            self.add_prim_attr(name, tuple(float(v) for v in value))
+
+    def infer_shape(self, images_shape):
+        validator.check_shape_length("images shape", len(images_shape), 4, Rel.EQ)
+        validator.check("images channels", images_shape[3], "mean len", len(self.mean))
+        return [images_shape[0], images_shape[3], self.size[0], self.size[1]]
+
+    def infer_dtype(self, images_dtype):
+        validator.check_subclass('images_dtype', images_dtype, mstype.tensor)
+        validator.check_typename('images_dtype', images_dtype, [mstype.uint8])
+        return mstype.float32
@@ -146,6 +146,130 @@ class _AutoParallelContext:
         self.check_context_handle()
         return self._context_handle.get_loss_repeated_mean()
 
+    def set_enable_parallel_optimizer(self, enable_parallel_optimizer):
+        """
+        Set enable_parallel_optimizer flag.
+
+        Note:
+            If enable_parallel_optimizer is true, in data parallel the optimizer states of the parameters are
+            sharded across the devices. The gradients are reduce-scattered instead of all-reduced, each device
+            updates its slice of the parameters, and the updated slices are all-gathered.
+
+        Args:
+            enable_parallel_optimizer (bool): The enable_parallel_optimizer flag.
+        """
+        self.check_context_handle()
+        self._context_handle.set_enable_parallel_optimizer(enable_parallel_optimizer)
+
+    def get_enable_parallel_optimizer(self):
+        """Get enable_parallel_optimizer flag."""
+        self.check_context_handle()
+        return self._context_handle.get_enable_parallel_optimizer()
+
+    def set_enable_hierarchical_allreduce(self, enable_hierarchical_allreduce):
+        """
+        Set enable_hierarchical_allreduce flag.
+
+        Note:
+            If enable_hierarchical_allreduce is true, the gradients of the parameters are reduce-scattered in each
+            node, all-reduced across the nodes on the scattered slices, and all-gathered in each node. It only takes
+            effect on hccl, and on the gradients whose communication groups span several nodes.
+
+        Args:
+            enable_hierarchical_allreduce (bool): The enable_hierarchical_allreduce flag.
+        """
+        self.check_context_handle()
+        self._context_handle.set_enable_hierarchical_allreduce(enable_hierarchical_allreduce)
+
+    def get_enable_hierarchical_allreduce(self):
+        """Get enable_hierarchical_allreduce flag."""
+        self.check_context_handle()
+        return self._context_handle.get_enable_hierarchical_allreduce()
+
+    def set_devices_per_node(self, devices_per_node):
+        """
+        Set the number of devices in a node, which hold consecutive ranks.
+
+        Args:
+            devices_per_node (int): The devices per node.
+
+        Raises:
+            ValueError: If the devices per node is not in [1, 4096].
+        """
+        self.check_context_handle()
+        if devices_per_node < 1 or devices_per_node > 4096:
+            raise ValueError("Devices per node must be in [1, 4096], but got {}".format(devices_per_node))
+        self._context_handle.set_devices_per_node(devices_per_node)
+
+    def get_devices_per_node(self):
+        """Get devices per node."""
+        self.check_context_handle()
+        return self._context_handle.get_devices_per_node()
+
+    def set_gradient_compression(self, gradient_compression):
+        """
+        Set the compression of the gradients all-reduced in data parallel.
+
+        Note:
+            With "fp16", the gradients are all-reduced in float16. With "topk", each device all-gathers the largest
+            elements of its gradients and their indices, and they are summed into the dense gradients. In both, the
+            compression error is kept on device as a residual, which is added to the gradients of the next step.
+
+        Args:
+            gradient_compression (str): The gradient compression, "none", "fp16" or "topk".
+
+        Raises:
+            ValueError: If the gradient compression is not supported.
+        """
+        self.check_context_handle()
+        ret = self._context_handle.set_gradient_compression(gradient_compression)
+        if ret is False:
+            raise ValueError("Gradient compression does not support {}".format(gradient_compression))
+
+    def get_gradient_compression(self):
+        """Get gradient compression."""
+        self.check_context_handle()
+        return self._context_handle.get_gradient_compression()
+
+    def set_topk_compression_ratio(self, topk_compression_ratio):
+        """
+        Set the ratio of the elements of each gradient all-gathered by the "topk" gradient compression.
+
+        Args:
+            topk_compression_ratio (float): The topk compression ratio.
+
+        Raises:
+            ValueError: If the topk compression ratio is not in (0, 1].
+        """
+        self.check_context_handle()
+        ret = self._context_handle.set_topk_compression_ratio(topk_compression_ratio)
+        if ret is False:
+            raise ValueError("Topk compression ratio must be in (0, 1], but got {}".format(topk_compression_ratio))
+
+    def get_topk_compression_ratio(self):
+        """Get topk compression ratio."""
+        self.check_context_handle()
+        return self._context_handle.get_topk_compression_ratio()
+
+    def set_enable_alltoall(self, enable_alltoall):
+        """
+        Set enable_alltoall flag.
+
+        Note:
+            If enable_alltoall is true, a tensor redistribution that all-gathers a dimension and then splits
+            another dimension along the same devices is done by one all-to-all.
+
+        Args:
+            enable_alltoall (bool): The enable_alltoall flag.
+        """
+        self.check_context_handle()
+        self._context_handle.set_enable_alltoall(enable_alltoall)
+
+    def get_enable_alltoall(self):
+        """Get enable_alltoall flag."""
+        self.check_context_handle()
+        return self._context_handle.get_enable_alltoall()
+
     def set_communication_backend(self, communication_backend):
         """
         Set communication backend.
@@ -236,8 +360,12 @@ class _AutoParallelContext:
         """
         Set allreduce fusion strategy by parameters data sizes.
 
+        The allreduces are fused in the order their gradients get ready, the segments take the sizes in turn and
+        the last one takes the rest, so a small first size lets the first allreduce start early in the backward.
+        It is used when the split indices are not set.
+
         Args:
-            sizes (list): Sizes list.
+            sizes (list): Sizes list, the sizes of the segments in MB.
 
         Raises:
             ValueError: If type of sizes item is not int.
@@ -292,7 +420,13 @@ _set_auto_parallel_context_func_map = {
     "cast_before_mirror": auto_parallel_context().set_cast_before_mirror,
     "loss_repeated_mean": auto_parallel_context().set_loss_repeated_mean,
     "parallel_mode": auto_parallel_context().set_parallel_mode,
-    "parameter_broadcast": auto_parallel_context().set_parameter_broadcast}
+    "parameter_broadcast": auto_parallel_context().set_parameter_broadcast,
+    "enable_parallel_optimizer": auto_parallel_context().set_enable_parallel_optimizer,
+    "enable_hierarchical_allreduce": auto_parallel_context().set_enable_hierarchical_allreduce,
+    "devices_per_node": auto_parallel_context().set_devices_per_node,
+    "gradient_compression": auto_parallel_context().set_gradient_compression,
+    "topk_compression_ratio": auto_parallel_context().set_topk_compression_ratio,
+    "enable_alltoall": auto_parallel_context().set_enable_alltoall}
 
 
 _get_auto_parallel_context_func_map = {
@@ -302,11 +436,19 @@ _get_auto_parallel_context_func_map = {
     "cast_before_mirror": auto_parallel_context().get_cast_before_mirror,
     "loss_repeated_mean": auto_parallel_context().get_loss_repeated_mean,
     "parallel_mode": auto_parallel_context().get_parallel_mode,
-    "parameter_broadcast": auto_parallel_context().get_parameter_broadcast}
+    "parameter_broadcast": auto_parallel_context().get_parameter_broadcast,
+    "enable_parallel_optimizer": auto_parallel_context().get_enable_parallel_optimizer,
+    "enable_hierarchical_allreduce": auto_parallel_context().get_enable_hierarchical_allreduce,
+    "devices_per_node": auto_parallel_context().get_devices_per_node,
+    "gradient_compression": auto_parallel_context().get_gradient_compression,
+    "topk_compression_ratio": auto_parallel_context().get_topk_compression_ratio,
+    "enable_alltoall": auto_parallel_context().get_enable_alltoall}
 
 
 @args_type_check(device_num=int, global_rank=int, mirror_mean=bool, cast_before_mirror=bool,
-                 loss_repeated_mean=bool, parallel_mode=str, parameter_broadcast=bool)
+                 loss_repeated_mean=bool, parallel_mode=str, parameter_broadcast=bool,
+                 enable_parallel_optimizer=bool, enable_hierarchical_allreduce=bool, devices_per_node=int,
+                 gradient_compression=str, topk_compression_ratio=float, enable_alltoall=bool)
 def _set_auto_parallel_context(**kwargs):
     """
     Set auto parallel context.
@@ -337,6 +479,20 @@ def _set_auto_parallel_context(**kwargs):
         parameter_broadcast (bool): Indicating whether to broadcast parameters before training.
                        "stand_alone", "semi_auto_parallel" and "auto_parallel" do not support parameter
                        broadcast. Default: False.
+        enable_parallel_optimizer (bool): Whether to shard the optimizer states across the devices in data
+                       parallel. Only AdamWeightDecay and AdamWeightDecayDynamicLR support it. Default: False.
+        enable_hierarchical_allreduce (bool): Whether to all-reduce the gradients by a reduce-scatter in each node,
+                       an allreduce across the nodes and an all-gather in each node. Only hccl supports it.
+                       Default: False.
+        devices_per_node (int): The number of devices in a node, which hold consecutive ranks, the value must be
+                       in [1, 4096]. Default: 8.
+        gradient_compression (str): The compression of the gradients all-reduced in data parallel, "none", "fp16"
+                       or "topk". The compression error is kept as a residual added to the next gradients.
+                       Default: "none".
+        topk_compression_ratio (float): The ratio of the elements of each gradient all-gathered by the "topk"
+                       compression, the value must be in (0, 1]. Default: 0.01.
+        enable_alltoall (bool): Whether to redistribute the tensors by all-to-all instead of an all-gather followed
+                       by a split of another dimension. Default: False.
 
     Raises:
         ValueError: If input key is not attribute in auto parallel context.
@@ -377,5 +533,11 @@ def _reset_auto_parallel_context():
     - cast_before_mirror: True.
     - parallel_mode: "stand_alone".
     - parameter_broadcast: False.
+    - enable_parallel_optimizer: False.
+    - enable_hierarchical_allreduce: False.
+    - devices_per_node: 8.
+    - gradient_compression: "none".
+    - topk_compression_ratio: 0.01.
+    - enable_alltoall: False.
     """
     auto_parallel_context().reset()
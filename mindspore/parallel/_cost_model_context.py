@@ -214,6 +214,182 @@ class _CostModelContext:
             raise ValueError("Context handle is none in context!!!")
         return self._context_handle.get_costmodel_communi_bias()
 
+    def set_costmodel_calibration_file(self, calibration_file):
+        """
+        Set costmodel calibration file.
+
+        Args:
+            calibration_file (str): The json file of the costs measured on the devices, which scale the
+                                    costs of the operators. An empty path disables the calibration.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_calibration_file(calibration_file)
+
+    def get_costmodel_calibration_file(self):
+        """
+        Get costmodel calibration file.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_calibration_file()
+
+    def set_costmodel_devices_per_node(self, devices_per_node):
+        """
+        Set costmodel devices per node.
+
+        Args:
+            devices_per_node (int): The number of devices in a node, 0 means the devices are fully connected.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_devices_per_node(devices_per_node)
+
+    def get_costmodel_devices_per_node(self):
+        """
+        Get costmodel devices per node.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_devices_per_node()
+
+    def set_costmodel_nodes_per_rack(self, nodes_per_rack):
+        """
+        Set costmodel nodes per rack.
+
+        Args:
+            nodes_per_rack (int): The number of nodes in a rack, 0 means all the nodes are in one rack.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_nodes_per_rack(nodes_per_rack)
+
+    def get_costmodel_nodes_per_rack(self):
+        """
+        Get costmodel nodes per rack.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_nodes_per_rack()
+
+    def set_costmodel_intra_rack_bandwidth_ratio(self, intra_rack_bandwidth_ratio):
+        """
+        Set costmodel intra rack bandwidth ratio.
+
+        Args:
+            intra_rack_bandwidth_ratio (float): The bandwidth between the nodes of a rack relative to the one in a node.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_intra_rack_bandwidth_ratio(intra_rack_bandwidth_ratio)
+
+    def get_costmodel_intra_rack_bandwidth_ratio(self):
+        """
+        Get costmodel intra rack bandwidth ratio.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_intra_rack_bandwidth_ratio()
+
+    def set_costmodel_inter_rack_bandwidth_ratio(self, inter_rack_bandwidth_ratio):
+        """
+        Set costmodel inter rack bandwidth ratio.
+
+        Args:
+            inter_rack_bandwidth_ratio (float): The bandwidth between the racks relative to the one in a node.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_inter_rack_bandwidth_ratio(inter_rack_bandwidth_ratio)
+
+    def get_costmodel_inter_rack_bandwidth_ratio(self):
+        """
+        Get costmodel inter rack bandwidth ratio.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_inter_rack_bandwidth_ratio()
+
+    def set_costmodel_intra_rack_latency(self, intra_rack_latency):
+        """
+        Set costmodel intra rack latency.
+
+        Args:
+            intra_rack_latency (float): The latency of a collective between the nodes of a rack, in bytes.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_intra_rack_latency(intra_rack_latency)
+
+    def get_costmodel_intra_rack_latency(self):
+        """
+        Get costmodel intra rack latency.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_intra_rack_latency()
+
+    def set_costmodel_inter_rack_latency(self, inter_rack_latency):
+        """
+        Set costmodel inter rack latency.
+
+        Args:
+            inter_rack_latency (float): The latency of a collective between the racks, in bytes.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_inter_rack_latency(inter_rack_latency)
+
+    def get_costmodel_inter_rack_latency(self):
+        """
+        Get costmodel inter rack latency.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_inter_rack_latency()
+
     def set_costmodel_allreduce_fusion_algorithm(self, algorithm):
         """
         Set costmodel allreduce fusion algorithm.
@@ -391,6 +567,31 @@ class _CostModelContext:
             raise ValueError("Context handle is none in context!!!")
         return self._context_handle.get_costmodel_allreduce_fusion_computation_time_parameter()
 
+    def set_costmodel_allreduce_fusion_bucket_size(self, bucket_size):
+        """
+        Set costmodel allreduce fusion bucket size.
+
+        Args:
+            bucket_size (float): The size in bytes of the parameter gradients fused into one AllReduce.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_allreduce_fusion_bucket_size(bucket_size)
+
+    def get_costmodel_allreduce_fusion_bucket_size(self):
+        """
+        Get costmodel allreduce fusion bucket size.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_allreduce_fusion_bucket_size()
+
     def reset_cost_model(self):
         """
         Reset cost model settings.
@@ -427,6 +628,13 @@ set_cost_model_context_func_map = {
     "costmodel_communi_threshold": cost_model_context().set_costmodel_communi_threshold,
     "costmodel_communi_const": cost_model_context().set_costmodel_communi_const,
     "costmodel_communi_bias": cost_model_context().set_costmodel_communi_bias,
+    "costmodel_calibration_file": cost_model_context().set_costmodel_calibration_file,
+    "costmodel_devices_per_node": cost_model_context().set_costmodel_devices_per_node,
+    "costmodel_nodes_per_rack": cost_model_context().set_costmodel_nodes_per_rack,
+    "costmodel_intra_rack_bandwidth_ratio": cost_model_context().set_costmodel_intra_rack_bandwidth_ratio,
+    "costmodel_inter_rack_bandwidth_ratio": cost_model_context().set_costmodel_inter_rack_bandwidth_ratio,
+    "costmodel_intra_rack_latency": cost_model_context().set_costmodel_intra_rack_latency,
+    "costmodel_inter_rack_latency": cost_model_context().set_costmodel_inter_rack_latency,
     "costmodel_allreduce_fusion_algorithm": cost_model_context().set_costmodel_allreduce_fusion_algorithm,
     "costmodel_allreduce_fusion_times": cost_model_context().set_costmodel_allreduce_fusion_times,
     "costmodel_allreduce_fusion_tail_percent": cost_model_context().set_costmodel_allreduce_fusion_tail_percent,
@@ -436,7 +644,8 @@ set_cost_model_context_func_map = {
     "costmodel_allreduce_fusion_allreduce_bandwidth":
         cost_model_context().set_costmodel_allreduce_fusion_allreduce_bandwidth,
     "costmodel_allreduce_fusion_computation_time_parameter":
-        cost_model_context().set_costmodel_allreduce_fusion_computation_time_parameter}
+        cost_model_context().set_costmodel_allreduce_fusion_computation_time_parameter,
+    "costmodel_allreduce_fusion_bucket_size": cost_model_context().set_costmodel_allreduce_fusion_bucket_size}
 
 
 get_cost_model_context_func_map = {
@@ -447,6 +656,13 @@ get_cost_model_context_func_map = {
     "costmodel_communi_threshold": cost_model_context().get_costmodel_communi_threshold,
     "costmodel_communi_const": cost_model_context().get_costmodel_communi_const,
     "costmodel_communi_bias": cost_model_context().get_costmodel_communi_bias,
+    "costmodel_calibration_file": cost_model_context().get_costmodel_calibration_file,
+    "costmodel_devices_per_node": cost_model_context().get_costmodel_devices_per_node,
+    "costmodel_nodes_per_rack": cost_model_context().get_costmodel_nodes_per_rack,
+    "costmodel_intra_rack_bandwidth_ratio": cost_model_context().get_costmodel_intra_rack_bandwidth_ratio,
+    "costmodel_inter_rack_bandwidth_ratio": cost_model_context().get_costmodel_inter_rack_bandwidth_ratio,
+    "costmodel_intra_rack_latency": cost_model_context().get_costmodel_intra_rack_latency,
+    "costmodel_inter_rack_latency": cost_model_context().get_costmodel_inter_rack_latency,
     "costmodel_allreduce_fusion_algorithm": cost_model_context().get_costmodel_allreduce_fusion_algorithm,
     "costmodel_allreduce_fusion_times": cost_model_context().get_costmodel_allreduce_fusion_times,
     "costmodel_allreduce_fusion_tail_percent": cost_model_context().get_costmodel_allreduce_fusion_tail_percent,
@@ -456,16 +672,21 @@ get_cost_model_context_func_map = {
     "costmodel_allreduce_fusion_allreduce_bandwidth":
         cost_model_context().get_costmodel_allreduce_fusion_allreduce_bandwidth,
     "costmodel_allreduce_fusion_computation_time_parameter":
-        cost_model_context().get_costmodel_allreduce_fusion_computation_time_parameter}
+        cost_model_context().get_costmodel_allreduce_fusion_computation_time_parameter,
+    "costmodel_allreduce_fusion_bucket_size": cost_model_context().get_costmodel_allreduce_fusion_bucket_size}
 
 
 @args_type_check(device_memory_capacity=float, costmodel_alpha=float, costmodel_beta=float, costmodel_gamma=float,
                  costmodel_communi_threshold=float, costmodel_communi_const=float, costmodel_communi_bias=float,
+                 costmodel_calibration_file=str, costmodel_devices_per_node=int, costmodel_nodes_per_rack=int,
+                 costmodel_intra_rack_bandwidth_ratio=float, costmodel_inter_rack_bandwidth_ratio=float,
+                 costmodel_intra_rack_latency=float, costmodel_inter_rack_latency=float,
                  costmodel_allreduce_fusion_algorithm=int, costmodel_allreduce_fusion_times=int,
                  costmodel_allreduce_fusion_tail_percent=float, costmodel_allreduce_fusion_tail_time=float,
                  costmodel_allreduce_fusion_allreduce_inherent_time=float,
                  costmodel_allreduce_fusion_allreduce_bandwidth=float,
-                 costmodel_allreduce_fusion_computation_time_parameter=float)
+                 costmodel_allreduce_fusion_computation_time_parameter=float,
+                 costmodel_allreduce_fusion_bucket_size=float)
 def set_cost_model_context(**kwargs):
     """
     Set cost model context.
@@ -481,10 +702,27 @@ def set_cost_model_context(**kwargs):
         costmodel_communi_threshold (float): A parameter used in adjusting communication calculation for practice.
         costmodel_communi_const (float): A parameter used in adjusting communication calculation for practice.
         costmodel_communi_bias (float): A parameter used in adjusting communication calculation for practice.
+        costmodel_calibration_file (str): The json file of the computation and communication time measured per
+            operator type on the devices. The costs of the operators are scaled by them in strategy-searching
+            algorithm. Default: "", which uses the analytical costs.
+        costmodel_devices_per_node (int): The number of devices in a node. The communication of the operators and
+            the tensor redistributions is weighted by the level of the links its groups span: in a node, between the
+            nodes of a rack, or between the racks. Default: 0, which treats the devices as fully connected.
+        costmodel_nodes_per_rack (int): The number of nodes in a rack. Default: 0, which puts all nodes in a rack.
+        costmodel_intra_rack_bandwidth_ratio (float): The bandwidth between the nodes of a rack relative to the one
+            in a node. Default: 1.0.
+        costmodel_inter_rack_bandwidth_ratio (float): The bandwidth between the racks relative to the one in a node.
+            Default: 1.0.
+        costmodel_intra_rack_latency (float): The latency of a collective between the nodes of a rack, in bytes of
+            the bandwidth in a node. Default: 0.0.
+        costmodel_inter_rack_latency (float): The latency of a collective between the racks, in bytes of the
+            bandwidth in a node. Default: 0.0.
         costmodel_allreduce_fusion_algorithm (int): The allreduce fusion algorithm.
             0: bypass allreduce fusion;
             1: only use backward computation time to group allreduce;
-            2: use backward computation time and parameter gradient allreduce time to group allreduce.
+            2: use backward computation time and parameter gradient allreduce time to group allreduce;
+            3: group allreduce into buckets of costmodel_allreduce_fusion_bucket_size bytes, in the order the
+            parameter gradients are computed in backward.
         costmodel_allreduce_fusion_times (int): The AllReduce fusion times of parameter gradients.
         costmodel_allreduce_fusion_tail_percent (float): A parameter used in allreduce fusion algorithm. The percentage
             of backward computing time corresponding to the last parameter gradients AllReduce in the whole backward
@@ -497,6 +735,8 @@ def set_cost_model_context(**kwargs):
             bandwidth of AllReduce.
         costmodel_allreduce_fusion_computation_time_parameter (float): A parameter used in allreduce fusion algorithm.
             The parameter used to compute backward computation time.
+        costmodel_allreduce_fusion_bucket_size (float): A parameter used in allreduce fusion algorithm 3. The size in
+            bytes of the parameter gradients fused into one AllReduce. Default: 26214400.0.
 
 
 
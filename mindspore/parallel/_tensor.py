@@ -260,7 +260,21 @@ def _reshape_param_data(param_data, dev_mat, tensor_map):
         slice_index = _get_tensor_slice_index(dev_mat, tensor_strategy, tensor_map, i)
         tensor_slices_new[int(slice_index)] = np.array(tensor_slices[i])
 
-    # combine slices to generate complete parameter
+    return Tensor(_combine_tensor_slices(tensor_slices_new, tensor_strategy))
+
+
+def _combine_tensor_slices(tensor_slices, tensor_strategy):
+    """
+    Combine the tensor slices ordered by the slice index into the complete tensor.
+
+    Args:
+        tensor_slices (list): The slices of numpy.ndarray, ordered by the slice index.
+        tensor_strategy (list): The split strategy of tensor.
+
+    Returns:
+        numpy.ndarray, the complete tensor.
+    """
+    tensor_slices_new = tensor_slices
     dim_len = len(tensor_strategy)
     for i in range(dim_len):
         ele_count = int(len(tensor_slices_new) / tensor_strategy[dim_len - 1 - i])
@@ -274,4 +288,39 @@ def _reshape_param_data(param_data, dev_mat, tensor_map):
             tensor_slices_new_inner.insert(len(tensor_slices_new_inner), np.array(new_tensor))
         tensor_slices_new = tensor_slices_new_inner
 
-    return Tensor(tensor_slices_new[0])
+    return tensor_slices_new[0]
+
+
+def _merge_tensor_slices(rank_slices, dev_mat, tensor_map):
+    """
+    Merge the slices saved by the ranks into the complete tensor, used to load the sliced checkpoints.
+
+    Args:
+        rank_slices (dict): The slices of numpy.ndarray, the key is the rank which saved the slice.
+        dev_mat (list): The device matrix of devices.
+        tensor_map (list): The split strategy of tensor.
+
+    Returns:
+        numpy.ndarray, the complete tensor.
+
+    Raises:
+        ValueError: If the slices of some ranks are missing.
+
+    Examples:
+        >>> rank_slices = {0: np.array([[1, 2]]), 1: np.array([[3, 4]])}
+        >>> tensor = _merge_tensor_slices(rank_slices, [2], [1, -1])
+    """
+    tensor_strategy = _get_tensor_strategy(dev_mat, tensor_map)
+    slice_count = 1
+    for dim in tensor_strategy:
+        slice_count *= dim
+
+    # the ranks holding the same slice are duplicates, any of them is taken
+    tensor_slices = [None] * slice_count
+    for rank, tensor_slice in rank_slices.items():
+        slice_index = int(_get_tensor_slice_index(dev_mat, tensor_strategy, tensor_map, rank))
+        tensor_slices[slice_index] = tensor_slice
+    missing = [index for index, tensor_slice in enumerate(tensor_slices) if tensor_slice is None]
+    if missing:
+        raise ValueError("The slices {} of the tensor are missing in the checkpoints.".format(missing))
+    return _combine_tensor_slices(tensor_slices, tensor_strategy)
@@ -15,7 +15,8 @@
 """Utils of auto parallel"""
 
 from mindspore._c_expression import reset_op_id
-from mindspore.communication.management import get_group_size, get_rank
+from mindspore.communication.management import GlobalComm, create_group, get_group_size, get_rank
+from mindspore.communication._comm_helper import Backend
 from mindspore.parallel._auto_parallel_context import auto_parallel_context, _set_auto_parallel_context,\
     _reset_auto_parallel_context
 
@@ -28,6 +29,81 @@ def _get_mirror_mean():
     return auto_parallel_context().get_mirror_mean()
 
 
+def _get_enable_parallel_optimizer():
+    return auto_parallel_context().get_enable_parallel_optimizer()
+
+
+def _is_parallel_optimizer_param(param, group_size):
+    """
+    Whether the optimizer states of the parameter are sharded by the parallel optimizer, which requires its first
+    dimension to be divided by the number of devices.
+    """
+    if param.layerwise_parallel or group_size <= 1:
+        return False
+    shape = param.default_input.shape()
+    return len(shape) > 0 and shape[0] % group_size == 0
+
+
+def _get_enable_hierarchical_allreduce():
+    return auto_parallel_context().get_enable_hierarchical_allreduce()
+
+
+def _get_gradient_compression():
+    return auto_parallel_context().get_gradient_compression()
+
+
+def _get_topk_compression_ratio():
+    return auto_parallel_context().get_topk_compression_ratio()
+
+
+def _split_ranks_by_node(rank_size, rank, devices_per_node):
+    """
+    Split the ranks of the world group by the nodes, each of which holds devices_per_node consecutive ranks.
+
+    Returns:
+        Tuple, the ranks in the node of rank, and the ranks in the other nodes at the same position as rank. None if
+        the devices are in one node, or the nodes are not full, where the hierarchical allreduce does not apply.
+    """
+    if devices_per_node <= 1 or rank_size <= devices_per_node or rank_size % devices_per_node != 0:
+        return None
+    node, position = divmod(rank, devices_per_node)
+    intra_ranks = list(range(node * devices_per_node, (node + 1) * devices_per_node))
+    inter_ranks = list(range(position, rank_size, devices_per_node))
+    return intra_ranks, inter_ranks
+
+
+_hierarchical_allreduce_groups = {}
+
+
+def _get_hierarchical_allreduce_groups():
+    """
+    Get the intra-node group and the inter-node group of the hierarchical allreduce on the world group, which are
+    created at the first call.
+
+    Returns:
+        Tuple, the intra-node group, the inter-node group and the device number of the intra-node group. None if the
+        hierarchical allreduce is disabled or does not apply.
+    """
+    if not _get_enable_hierarchical_allreduce() or GlobalComm.BACKEND != Backend.HCCL:
+        return None
+    rank_size = get_group_size()
+    rank = get_rank()
+    devices_per_node = auto_parallel_context().get_devices_per_node()
+    key = (rank_size, rank, devices_per_node)
+    if key not in _hierarchical_allreduce_groups:
+        split_ranks = _split_ranks_by_node(rank_size, rank, devices_per_node)
+        if split_ranks is None:
+            _hierarchical_allreduce_groups[key] = None
+        else:
+            intra_ranks, inter_ranks = split_ranks
+            intra_group = "hierarchical_intra_node_{}".format(rank // devices_per_node)
+            inter_group = "hierarchical_inter_node_{}".format(rank % devices_per_node)
+            create_group(intra_group, intra_ranks)
+            create_group(inter_group, inter_ranks)
+            _hierarchical_allreduce_groups[key] = (intra_group, inter_group, len(intra_ranks))
+    return _hierarchical_allreduce_groups[key]
+
+
 def _get_device_num():
     """Get the device num."""
     parallel_mode = auto_parallel_context().get_parallel_mode()
@@ -40,6 +40,37 @@ class OutputTo16(nn.Cell):
         return F.cast(self._op(x), mstype.float16)
 
 
+class _OutputTo32(nn.Cell):
+    "Wrap cell for amp. Cast network output back to float32"
+    def __init__(self, op):
+        super(_OutputTo32, self).__init__(auto_prefix=False)
+        self._op = op
+
+    def construct(self, x):
+        return F.cast(self._op(x), mstype.float32)
+
+
+# the cells computed in float16 by the level O1, the GEMM bound ones gaining the most from it
+_white_list = (nn.Conv2d, nn.Dense)
+
+
+def _auto_white_list(network, white_list):
+    """Run the cells of the white list in float16 and the rest of the network in float32."""
+    cells = network.name_cells()
+    change = False
+    for name in cells:
+        subcell = cells[name]
+        if subcell == network:
+            continue
+        elif isinstance(subcell, white_list):
+            network._cells[name] = _OutputTo32(subcell.to_float(mstype.float16))
+            change = True
+        else:
+            _auto_white_list(subcell, white_list)
+    if isinstance(network, nn.SequentialCell) and change:
+        network.cell_list = list(network.cells())
+
+
 def _do_keep_batchnorm_fp32(network):
     cells = network.name_cells()
     change = False
@@ -61,6 +92,11 @@ _config_level = {
         "keep_batchnorm_fp32": False,
         "cast_model_type": mstype.float32,
         "loss_scale_manager": None},
+    "O1": {
+        "keep_batchnorm_fp32": False,
+        "cast_model_type": mstype.float32,
+        "white_list": _white_list,
+        "loss_scale_manager": DynamicLossScaleManager()},
     "O2": {
         "keep_batchnorm_fp32": True,
         "cast_model_type": mstype.float16,
@@ -69,7 +105,7 @@ _config_level = {
 
 def _check_kwargs(key_words):
     for arg in key_words:
-        if arg not in ['cast_model_type', 'keep_batchnorm_fp32', 'loss_scale_manager']:
+        if arg not in ['cast_model_type', 'keep_batchnorm_fp32', 'white_list', 'loss_scale_manager']:
             raise  ValueError(f"Unsupported arg '{arg}'")
 
     if 'cast_model_type' in key_words:
@@ -77,6 +113,8 @@ def _check_kwargs(key_words):
                         [mstype.float16, mstype.float32], Rel.IN)
     if 'keep_batchnorm_fp32' in key_words:
         validator.check_isinstance('keep_batchnorm_fp32', key_words['keep_batchnorm_fp32'], bool)
+    if 'white_list' in key_words:
+        validator.check_isinstance('white_list', key_words['white_list'], tuple)
     if 'loss_scale_manager' in key_words:
         loss_scale_manager = key_words['loss_scale_manager']
         if loss_scale_manager:
@@ -91,9 +129,10 @@ def build_train_network(network, optimizer, loss_fn=None, level='O0', **kwargs):
         loss_fn (Union[None, Cell]): Definition of the loss_fn. If None, the `network` should have the loss inside.
             Default: None.
         optimizer (Optimizer): Optimizer to update the Parameter.
-        level (str): Supports [O0, O2].
+        level (str): Supports [O0, O1, O2].
 
             - O0: Do not change.
+            - O1: Run the cells of `white_list` in float16 and the rest in float32, using dynamic loss scale.
             - O2: Cast network to float16, keep batchnorm and `loss_fn` (if set) run in float32,
               using dynamic loss scale.
 
@@ -101,12 +140,14 @@ def build_train_network(network, optimizer, loss_fn=None, level='O0', **kwargs):
         cast_model_type (:class:`mindspore.dtype`): Supports `mstype.float16` or `mstype.float32`.
             If set to `mstype.float16`, use `float16` mode to train. If set, overwrite the level setting.
         keep_batchnorm_fp32 (bool): Keep Batchnorm run in `float32`. If set, overwrite the level setting.
+        white_list (tuple): The cell types run in `float16` while the network is in `float32`, such as
+            `(nn.Conv2d, nn.Dense)` of O1. If set, overwrite the level setting.
         loss_scale_manager (Union[None, LossScaleManager]): If None, not scale the loss, or else
             scale the loss by LossScaleManager. If set, overwrite the level setting.
     """
     validator.check_isinstance('network', network, nn.Cell)
     validator.check_isinstance('optimizer', optimizer, nn.Optimizer)
-    validator.check('level', level, "", ['O0', 'O2'], Rel.IN)
+    validator.check('level', level, "", ['O0', 'O1', 'O2'], Rel.IN)
     _check_kwargs(kwargs)
     config = dict(_config_level[level], **kwargs)
     config = edict(config)
@@ -116,6 +157,8 @@ def build_train_network(network, optimizer, loss_fn=None, level='O0', **kwargs):
 
         if config.keep_batchnorm_fp32:
             _do_keep_batchnorm_fp32(network)
+    elif config.get("white_list"):
+        _auto_white_list(network, config.white_list)
 
     if loss_fn:
         class WithLossCell(nn.Cell):
@@ -146,7 +189,7 @@ def build_train_network(network, optimizer, loss_fn=None, level='O0', **kwargs):
         loss_scale = loss_scale_manager.get_loss_scale()
         update_cell = loss_scale_manager.get_update_cell()
         if update_cell is not None:
-            if not context.get_context("enable_ge"):
+            if not context.get_context("enable_ge") and context.get_context("device_target") != "GPU":
                 raise ValueError("Only `loss_scale_manager=None` and "
                                  "`loss_scale_manager=FixedLossScaleManager(drop_overflow_update=False)`"
                                  "are supported in current version. If you use `O2` option, please"
@@ -21,10 +21,11 @@ import time
 import numpy as np
 
 import mindspore.context as context
-from mindspore.train.serialization import _exec_save_checkpoint, _fill_param_into_net, _save_graph
+from mindspore.train.serialization import _exec_save_checkpoint, _fill_param_into_net, _save_graph, \
+    _get_checkpoint_params, _snapshot_params, _AsyncCheckpointSaver
 from mindspore.train._utils import _make_directory
 from mindspore import log as logger
-from mindspore._checkparam import check_int_non_negative
+from mindspore._checkparam import check_int_non_negative, check_bool
 from mindspore.common.tensor import Tensor
 from .summary.summary_record import _cache_summary_tensor_data
 
@@ -150,6 +151,13 @@ class CheckpointConfig:
         keep_checkpoint_max (int): Maximum step to save checkpoint. Default: 5.
         keep_checkpoint_per_n_minutes (int): Keep one checkpoint every n minutes. Default: 0.
             Can't be used with keep_checkpoint_max at the same time.
+        async_save (bool): Whether to write the checkpoint files by a background thread. The parameters are copied
+            to host at the step of saving, and the training goes on while the file is written. Default: False.
+        integrated_save (bool): Whether to merge the parameters split by model parallel before saving. If False,
+            each rank saves only its own slices with their layouts, which are loaded by
+            `load_distributed_checkpoint`. Default: True.
+        device_format (bool): Whether to save the parameters the device keeps in its own format, such as the FracZ
+            weights on Ascend, in that format, so they are loaded without converting their format. Default: False.
 
     Raises:
         ValueError: If the input_param is None or 0.
@@ -163,7 +171,10 @@ class CheckpointConfig:
                  save_checkpoint_steps=1,
                  save_checkpoint_seconds=0,
                  keep_checkpoint_max=5,
-                 keep_checkpoint_per_n_minutes=0):
+                 keep_checkpoint_per_n_minutes=0,
+                 async_save=False,
+                 integrated_save=True,
+                 device_format=False):
 
         if not save_checkpoint_steps and not save_checkpoint_seconds and \
                 not keep_checkpoint_max and not keep_checkpoint_per_n_minutes:
@@ -190,6 +201,9 @@ class CheckpointConfig:
         else:
             if not self._keep_checkpoint_per_n_minutes or self._keep_checkpoint_per_n_minutes == 0:
                 self._keep_checkpoint_max = 1
+        self._async_save = check_bool(async_save)
+        self._integrated_save = check_bool(integrated_save)
+        self._device_format = check_bool(device_format)
 
     @property
     def save_checkpoint_steps(self):
@@ -211,6 +225,21 @@ class CheckpointConfig:
         """Get the value of _keep_checkpoint_per_n_minutes."""
         return self._keep_checkpoint_per_n_minutes
 
+    @property
+    def async_save(self):
+        """Get the value of _async_save."""
+        return self._async_save
+
+    @property
+    def integrated_save(self):
+        """Get the value of _integrated_save."""
+        return self._integrated_save
+
+    @property
+    def device_format(self):
+        """Get the value of _device_format."""
+        return self._device_format
+
     def get_checkpoint_policy(self):
         """Get the policy of checkpoint."""
         checkpoint_policy = {'save_checkpoint_steps': self._save_checkpoint_steps,
@@ -539,6 +568,7 @@ class ModelCheckpoint(Callback):
         self._manager = _CheckpointManager()
         self._prefix = _chg_ckpt_file_name_if_same_exist(self._directory, self._prefix)
         self._graph_saved = False
+        self._async_saver = _AsyncCheckpointSaver() if self._config.async_save else None
 
     def step_end(self, run_context):
         """
@@ -565,6 +595,8 @@ class ModelCheckpoint(Callback):
         cb_params = run_context.original_args()
         _to_save_last_ckpt = True
         self._save_ckpt(cb_params, _to_save_last_ckpt)
+        if self._async_saver is not None:
+            self._async_saver.wait()
 
         from mindspore.parallel._cell_wrapper import destroy_allgather_cell
         destroy_allgather_cell()
@@ -594,6 +626,9 @@ class ModelCheckpoint(Callback):
         if save_ckpt:
             cur_ckpoint_file = self._prefix + "-" + str(cb_params.cur_epoch_num) + "_" \
                                + str(step_num_in_epoch) + ".ckpt"
+            # the file of the previous step is counted by the file list and reuses the temporary file name.
+            if self._async_saver is not None:
+                self._async_saver.wait()
             # update checkpoint file list.
             self._manager.update_ckpoint_filelist(self._directory, self._prefix)
             # keep checkpoint files number equal max number.
@@ -619,10 +654,16 @@ class ModelCheckpoint(Callback):
                 _set_cur_net(cb_params.train_network)
                 cb_params.train_network.exec_checkpoint_graph()
 
-            _exec_save_checkpoint(cb_params.train_network, gen_file)
-
-            if os.path.exists(gen_file):
-                shutil.move(gen_file, cur_file)
+            if self._async_saver is not None:
+                snapshots = _snapshot_params(_get_checkpoint_params(cb_params.train_network,
+                                                                    self._config.integrated_save),
+                                             self._config.device_format)
+                self._async_saver.save(snapshots, gen_file, cur_file)
+            else:
+                _exec_save_checkpoint(cb_params.train_network, gen_file, integrated_save=self._config.integrated_save,
+                                      device_format=self._config.device_format)
+                if os.path.exists(gen_file):
+                    shutil.move(gen_file, cur_file)
             self._latest_ckpt_file_name = cur_file
 
     @property
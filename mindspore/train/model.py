@@ -13,6 +13,7 @@
 # limitations under the License.
 # ============================================================================
 """Model."""
+import hashlib
 import numpy as np
 
 from mindspore import log as logger
@@ -27,12 +28,24 @@ from ..nn.metrics import Loss
 from ..nn.wrap import WithLossCell, WithEvalCell, \
     DataWrapper
 from ..nn.wrap.cell_wrapper import _VirtualDatasetCell
+from ..nn.cell import Cell
+from ..ops import operations as P
 from .parallel_utils import ParallelMode
 from ..common import dtype as mstype
 from .dataset_helper import DatasetHelper
 from . import amp
 
 
+class _DigestGather(Cell):
+    """Gathers the digests of the checkpoints from all the ranks."""
+    def __init__(self):
+        super(_DigestGather, self).__init__()
+        self.all_gather = P.AllGather()
+
+    def construct(self, x):
+        return self.all_gather(x)
+
+
 class Model:
     """
     High-Level API for Training or Testing.
@@ -106,10 +119,28 @@ class Model:
         self._device_number = _get_device_num()
         self._global_rank = _get_global_rank()
         self._parameter_broadcast = _get_parameter_broadcast()
+        self._checkpoint_checked = False
 
         self._train_network = self._build_train_network()
         self._build_eval_network(metrics, eval_network, eval_indexes)
 
+    def _verify_checkpoint(self):
+        """
+        Verify all the ranks load the parameters from the same checkpoints, with the digests of them gathered from
+        every rank, so the parameters loaded are not broadcast before training. The ranks loading no checkpoint
+        join the gathering too.
+        """
+        digests = sorted((param.name, param.checkpoint_digest) for param in self._train_network.get_parameters()
+                         if param.layerwise_parallel is False and param.checkpoint_digest is not None)
+        digest = np.frombuffer(hashlib.sha256(repr(digests).encode()).digest(), np.int32)
+        gathered = _DigestGather()(Tensor(digest)).asnumpy().reshape(-1, digest.size)
+        verified = bool(digests) and (gathered == digest).all()
+        self._train_network.set_checkpoint_verified(verified)
+        self._checkpoint_checked = True
+        if verified:
+            logger.info("All the ranks load the same checkpoints, %d parameters loaded are not broadcast.",
+                        len(digests))
+
     def _check_kwargs(self, kwargs):
         for arg in kwargs:
             if arg not in ['loss_scale_manager']:
@@ -209,6 +240,8 @@ class Model:
 
         if self._parameter_broadcast:
             self._train_network.set_broadcast_flag()
+            if not self._checkpoint_checked and context.get_context("enable_ge"):
+                self._verify_checkpoint()
 
         # build callback list
         list_callback = _build_callbacks(callbacks)
@@ -378,8 +411,8 @@ class Model:
         _device_number_check(self._parallel_mode, self._device_number)
         _parameter_broadcast_check(self._parallel_mode, self._parameter_broadcast)
 
-        if context.get_context("device_target") in ["CPU", "GPU"] and context.get_context("enable_loop_sink"):
-            raise ValueError("CPU and GPU can't support loop sink, please set enable_loop_sink=False.")
+        if context.get_context("device_target") == "CPU" and context.get_context("enable_loop_sink"):
+            raise ValueError("CPU can't support loop sink, please set enable_loop_sink=False.")
 
         self._train(epoch,
                     train_dataset,
@@ -15,6 +15,9 @@
 """Model and parameters serialization."""
 import os
 import stat
+import hashlib
+import shutil
+import threading
 import numpy as np
 
 import mindspore.nn as nn
@@ -28,7 +31,7 @@ from mindspore.common.api import _executor
 from mindspore.common import dtype as mstype
 from mindspore._checkparam import check_input_data
 
-__all__ = ["save_checkpoint", "load_checkpoint", "load_param_into_net", "export"]
+__all__ = ["save_checkpoint", "load_checkpoint", "load_distributed_checkpoint", "load_param_into_net", "export"]
 
 tensor_to_ms_type = {"Int8": mstype.int8, "Int16": mstype.int16, "Int32": mstype.int32, "Int64": mstype.int64,
                      "Float16": mstype.float16, "Float32": mstype.float32, "Float64": mstype.float64}
@@ -97,40 +100,124 @@ def _update_param(param, new_param):
         param.set_parameter_data(type(param.data)(new_param.data))
 
 
-def save_checkpoint(parameter_list, ckpoint_file_name):
+def _snapshot_params(parameter_list, device_format=False):
+    """
+    Copies the parameters to host, the copies don't change with the parameters updated by the training later.
+
+    Args:
+        parameter_list (list): Parameters list, each element is a dict like {"name":xx, "data":xx}, and an optional
+                               "layout" of the slice like (dev_mat, tensor_map, rank).
+        device_format (bool): Whether to copy the parameters kept in a device format, such as FracZ, as they are.
+                              Default: False.
+
+    Returns:
+        list, each element is a tuple of the name, the type, the dims, the content, the layout and the device format
+        and type of a parameter, the last is None for the host format.
+    """
+    snapshots = []
+    for param in parameter_list:
+        param_data = param["data"]
+        dims = [0] if param_data.shape() == () else list(param_data.shape())
+        device_content = param_data.device_content() if device_format else None
+        if device_content is not None:
+            data_format, data_type, content = device_content
+            device = (data_format, str(data_type))
+        else:
+            content = param_data.asnumpy().reshape(-1).tostring()
+            device = None
+        snapshots.append((param["name"], str(param_data.dtype()), dims, content, param.get("layout"), device))
+    return snapshots
+
+
+def _write_checkpoint(snapshots, ckpoint_file_name):
+    """Serializes the host copies of the parameters into the checkpoint file."""
+    checkpoint_list = Checkpoint()
+    for name, tensor_type, dims, content, layout, device in snapshots:
+        param_value = checkpoint_list.value.add()
+        param_value.tag = name
+        param_tensor = param_value.tensor
+        param_tensor.tensor_content = content
+        param_tensor.tensor_type = tensor_type
+        param_tensor.dims.extend(dims)
+        if device is not None:
+            param_tensor.device_format, param_tensor.device_type = device
+        if layout is not None:
+            dev_mat, tensor_map, rank = layout
+            param_value.layout.dev_mat.extend(dev_mat)
+            param_value.layout.tensor_map.extend(tensor_map)
+            param_value.layout.rank = rank
+
+    with open(ckpoint_file_name, "wb") as f:
+        f.write(checkpoint_list.SerializeToString())
+    os.chmod(ckpoint_file_name, stat.S_IRUSR)
+
+
+class _AsyncCheckpointSaver:
+    """
+    Writes the checkpoint files by a background thread, one file at a time.
+
+    The parameters are copied to host before the thread starts, so the training goes on while the copies are
+    serialized and written. The error of the thread is raised by the next wait.
+    """
+    def __init__(self):
+        self._thread = None
+        self._error = None
+
+    def save(self, snapshots, ckpoint_file_name, final_file_name=None):
+        """Starts writing the snapshots after the previous file is written, it's moved to final_file_name if set."""
+        self.wait()
+        self._thread = threading.Thread(target=self._run, args=(snapshots, ckpoint_file_name, final_file_name))
+        self._thread.start()
+
+    def _run(self, snapshots, ckpoint_file_name, final_file_name):
+        try:
+            _write_checkpoint(snapshots, ckpoint_file_name)
+            if final_file_name is not None:
+                shutil.move(ckpoint_file_name, final_file_name)
+            logger.info("Save checkpoint %s asynchronously finish.", ckpoint_file_name)
+        except BaseException as e:
+            logger.error("Failed to save the checkpoint file %s.", ckpoint_file_name)
+            self._error = e
+
+    def wait(self):
+        """Waits for the file being written."""
+        if self._thread is not None:
+            self._thread.join()
+            self._thread = None
+        if self._error is not None:
+            error = self._error
+            self._error = None
+            raise RuntimeError(error.__str__())
+
+
+_async_saver = _AsyncCheckpointSaver()
+
+
+def save_checkpoint(parameter_list, ckpoint_file_name, async_save=False, device_format=False):
     """
     Saves checkpoint info to a specified file.
 
     Args:
         parameter_list (list): Parameters list, each element is a dict
-                               like {"name":xx, "type":xx, "shape":xx, "data":xx}.
+                               like {"name":xx, "type":xx, "shape":xx, "data":xx}. An element with a "layout"
+                               like (dev_mat, tensor_map, rank) is saved as the slice of the rank.
         ckpoint_file_name (str): Checkpoint file name.
+        async_save (bool): Whether to write the file by a background thread. The parameters are copied to host
+                           before it returns, and the previous asynchronous saving is waited for. Default: False.
+        device_format (bool): Whether to save the parameters the device keeps in its own format, such as the FracZ
+                              weights on Ascend, in that format. They are loaded to the same device without any
+                              conversion, and converted on host only when read there. Default: False.
 
     Raises:
         RuntimeError: Failed to save the Checkpoint file.
     """
     logger.info("Execute save checkpoint process.")
-    checkpoint_list = Checkpoint()
-
     try:
-        for param in parameter_list:
-            param_value = checkpoint_list.value.add()
-            param_value.tag = param["name"]
-            param_tensor = param_value.tensor
-            param_data = param["data"].asnumpy().reshape(-1)
-            param_tensor.tensor_content = param_data.tostring()
-            param_tensor.tensor_type = str(param["data"].dtype())
-
-            if param['data'].shape() == ():
-                param_tensor.dims.append(0)
-            else:
-                for dim in param['data'].shape():
-                    param_tensor.dims.append(dim)
-
-        with open(ckpoint_file_name, "wb") as f:
-            f.write(checkpoint_list.SerializeToString())
-        os.chmod(ckpoint_file_name, stat.S_IRUSR)
-
+        snapshots = _snapshot_params(parameter_list, device_format)
+        if async_save:
+            _async_saver.save(snapshots, ckpoint_file_name)
+            return
+        _write_checkpoint(snapshots, ckpoint_file_name)
     except BaseException as e:
         logger.error("Failed to save the checkpoint file %s.", ckpoint_file_name)
         raise RuntimeError(e.__str__())
@@ -151,6 +238,42 @@ def load_checkpoint(ckpoint_file_name, net=None):
     Raises:
         ValueError: Checkpoint file is incorrect.
     """
+    logger.info("Execute load checkpoint process.")
+    checkpoint_list, digest = _read_checkpoint(ckpoint_file_name)
+
+    parameter_dict = {}
+
+    try:
+        for element in checkpoint_list.value:
+            data_type = element.tensor.tensor_type
+            dims = element.tensor.dims
+
+            if element.tensor.HasField("device_format"):
+                parameter_dict[element.tag] = Parameter(_get_device_format_tensor(element), name=element.tag)
+                parameter_dict[element.tag].checkpoint_digest = digest
+                continue
+            param_data = _get_element_data(element)
+            if dims in [[0], [1]]:
+                parameter_dict[element.tag] = Parameter(param_data.reshape(-1)[0], name=element.tag)
+            else:
+                parameter_dict[element.tag] = Parameter(Tensor(param_data, tensor_to_ms_type[data_type]),
+                                                        name=element.tag)
+            parameter_dict[element.tag].checkpoint_digest = digest
+
+        logger.info("Load checkpoint process finish.")
+
+    except BaseException as e:
+        logger.error("Failed to load the checkpoint file %s.", ckpoint_file_name)
+        raise RuntimeError(e.__str__())
+
+    if net:
+        load_param_into_net(net, parameter_dict)
+
+    return parameter_dict
+
+
+def _read_checkpoint(ckpoint_file_name):
+    """Reads and parses the checkpoint file, returns it with the sha256 digest of the file."""
     if not isinstance(ckpoint_file_name, str):
         raise ValueError("The ckpoint_file_name must be String.")
 
@@ -160,9 +283,7 @@ def load_checkpoint(ckpoint_file_name, net=None):
     if os.path.getsize(ckpoint_file_name) == 0:
         raise ValueError("The checkpoint file may be empty, please make sure enter the correct file name.")
 
-    logger.info("Execute load checkpoint process.")
     checkpoint_list = Checkpoint()
-
     try:
         with open(ckpoint_file_name, "rb") as f:
             pb_content = f.read()
@@ -170,36 +291,90 @@ def load_checkpoint(ckpoint_file_name, net=None):
     except BaseException as e:
         logger.error("Failed to read the checkpoint file %s, please check the correct of the file.", ckpoint_file_name)
         raise ValueError(e.__str__())
+    return checkpoint_list, hashlib.sha256(pb_content).hexdigest()
+
+
+def _get_device_format_tensor(element):
+    """Gets a checkpoint element saved in the device format as a Tensor, which is converted on host on demand."""
+    np_type = tensor_to_np_type[element.tensor.tensor_type]
+    param_tensor = Tensor(np.empty(list(element.tensor.dims), np_type))
+    param_tensor.set_device_content(element.tensor.device_format, tensor_to_ms_type[element.tensor.device_type],
+                                    element.tensor.tensor_content)
+    return param_tensor
+
+
+def _get_element_data(element):
+    """Gets the data of a checkpoint element as a numpy.ndarray of its dims."""
+    if element.tensor.HasField("device_format"):
+        return _get_device_format_tensor(element).asnumpy()
+    np_type = tensor_to_np_type[element.tensor.tensor_type]
+    param_data = np.fromstring(element.tensor.tensor_content, np_type)
+    dims = element.tensor.dims
+    if dims in [[0], [1]]:
+        return param_data
+    return param_data.reshape(list(dims))
 
-    parameter_dict = {}
 
-    try:
-        for element in checkpoint_list.value:
-            data = element.tensor.tensor_content
-            data_type = element.tensor.tensor_type
-            np_type = tensor_to_np_type[data_type]
-            ms_type = tensor_to_ms_type[data_type]
-            param_data = np.fromstring(data, np_type)
-            dims = element.tensor.dims
+def load_distributed_checkpoint(net, ckpoint_file_names):
+    """
+    Loads the checkpoint files saved by each rank with its own slices into the network.
 
-            if dims in [[0], [1]]:
-                parameter_dict[element.tag] = Parameter(param_data[0], name=element.tag)
-            else:
-                param_dim = []
-                for dim in dims:
-                    param_dim.append(dim)
-                param_value = param_data.reshape(param_dim)
-                parameter_dict[element.tag] = Parameter(Tensor(param_value, ms_type), name=element.tag)
+    The slices of each parameter are merged on the host by the layouts saved with them, and split again by the
+    layout of the parameter in `net`, so the checkpoints can be loaded with a different device number or parallel
+    strategy. The parameters are merged one at a time, so only one complete parameter is in the host memory.
 
-        logger.info("Load checkpoint process finish.")
+    Args:
+        net (Cell): Cell network, which should be compiled so that its parameter layouts are known.
+        ckpoint_file_names (list[str]): The checkpoint files saved by all the ranks.
 
-    except BaseException as e:
-        logger.error("Failed to load the checkpoint file %s.", ckpoint_file_name)
-        raise RuntimeError(e.__str__())
+    Returns:
+        Dict, key is parameter name, value is a Parameter with the slice of the local device.
 
-    if net:
-        load_param_into_net(net, parameter_dict)
+    Raises:
+        ValueError: Checkpoint files are incorrect, or the slices of some ranks are missing.
+
+    Examples:
+        >>> ckpt_files = ["./rank_{}/CKP-1_32.ckpt".format(i) for i in range(8)]
+        >>> load_distributed_checkpoint(net, ckpt_files)
+    """
+    if not isinstance(net, nn.Cell):
+        raise TypeError("Argument net should be a Cell, but got {}.".format(type(net)))
+    if not isinstance(ckpoint_file_names, (list, tuple)) or not ckpoint_file_names:
+        raise ValueError("The ckpoint_file_names must be a non-empty list of String.")
+
+    logger.info("Execute load distributed checkpoint process.")
+    elements = {}
+    for ckpoint_file_name in ckpoint_file_names:
+        for element in _read_checkpoint(ckpoint_file_name)[0].value:
+            elements.setdefault(element.tag, []).append(element)
 
+    from mindspore.parallel._tensor import _merge_tensor_slices, _load_tensor_by_layout
+    parameter_dict = {}
+    for name, param_elements in elements.items():
+        element = param_elements[0]
+        data_type = element.tensor.tensor_type
+        if element.HasField("layout"):
+            dev_mat = list(element.layout.dev_mat)
+            tensor_map = list(element.layout.tensor_map)
+            rank_slices = {}
+            for param_element in param_elements:
+                if list(param_element.layout.dev_mat) != dev_mat or list(param_element.layout.tensor_map) != tensor_map:
+                    raise ValueError("The layouts of the parameter {} are different in the checkpoints.".format(name))
+                rank_slices[param_element.layout.rank] = _get_element_data(param_element)
+            param_data = _merge_tensor_slices(rank_slices, dev_mat, tensor_map)
+        else:
+            param_data = _get_element_data(element)
+
+        if element.tensor.dims in [[0], [1]]:
+            parameter_dict[name] = Parameter(param_data.reshape(-1)[0], name=name)
+            continue
+        param_tensor = Tensor(param_data, tensor_to_ms_type[data_type])
+        if name in net.parameter_layout_dict:
+            param_tensor = _load_tensor_by_layout(param_tensor, net.parameter_layout_dict[name])
+        parameter_dict[name] = Parameter(param_tensor, name=name)
+
+    load_param_into_net(net, parameter_dict)
+    logger.info("Load distributed checkpoint process finish.")
     return parameter_dict
 
 
@@ -250,6 +425,7 @@ def load_param_into_net(net, parameter_dict):
                 msg = ("Argument parameter_dict element should be a Parameter, but got {}.".format(type(new_param)))
                 raise TypeError(msg)
             _update_param(param, new_param)
+            param.checkpoint_digest = new_param.checkpoint_digest
         else:
             param_name_param_dict_not_have.append(param.name)
 
@@ -279,15 +455,15 @@ def _save_graph(network, file_name):
         os.chmod(file_name, stat.S_IWUSR | stat.S_IRUSR)
 
 
-def _exec_save_checkpoint(train_network, ckpoint_file_name):
+def _get_checkpoint_params(train_network, integrated_save=True):
     """
-    Saves checkpoint for 'ms' backend.
+    Gets the parameters list of the train network to save.
 
     Args:
         train_network (Network): The train network for training.
-        ckpoint_file_name (str): The name of checkpoint file.
+        integrated_save (bool): Whether to merge the parameters split by model parallel. If False, the slice of the
+                                local device is saved with its layout. Default: True.
     """
-
     param_dict = {}
     for _, param in train_network.parameters_and_names():
         param_dict[param.name] = param
@@ -301,14 +477,41 @@ def _exec_save_checkpoint(train_network, ckpoint_file_name):
             param_data = Tensor(value.data)
 
         # in model parallel scenario, some parameters were spliteds to all the devices,
-        # which should be combined before saving
+        # which should be combined before saving, or saved with the layouts
         if key in train_network.parameter_layout_dict:
-            param_data = _get_merged_param_data(train_network, key, param_data)
+            if integrated_save:
+                param_data = _get_merged_param_data(train_network, key, param_data)
+            else:
+                each_param["layout"] = _get_slice_layout(train_network, key)
 
         each_param["data"] = param_data
         param_list.append(each_param)
+    return param_list
+
+
+def _get_slice_layout(net, param_name):
+    """Gets the layout of the slice of the local device like (dev_mat, tensor_map, rank), None if not split."""
+    layout = net.parameter_layout_dict[param_name]
+    if len(layout) < 2 or all(dim == -1 for dim in layout[1]):
+        return None
+    from mindspore.communication.management import get_rank
+    return list(layout[0]), list(layout[1]), get_rank()
 
-    save_checkpoint(param_list, ckpoint_file_name)
+
+def _exec_save_checkpoint(train_network, ckpoint_file_name, async_save=False, integrated_save=True,
+                          device_format=False):
+    """
+    Saves checkpoint for 'ms' backend.
+
+    Args:
+        train_network (Network): The train network for training.
+        ckpoint_file_name (str): The name of checkpoint file.
+        async_save (bool): Whether to write the file by a background thread. Default: False.
+        integrated_save (bool): Whether to merge the parameters split by model parallel. Default: True.
+        device_format (bool): Whether to save the parameters in the format the device keeps them. Default: False.
+    """
+    save_checkpoint(_get_checkpoint_params(train_network, integrated_save), ckpoint_file_name, async_save,
+                    device_format)
 
 
 def _get_merged_param_data(net, param_name, param_data):
@@ -394,7 +597,7 @@ def _fill_param_into_net(net, parameter_list):
     load_param_into_net(net, parameter_dict)
 
 
-def export(net, *inputs, file_name, file_format='GEIR'):
+def export(net, *inputs, file_name, file_format='GEIR', external_data=False):
     """
     Exports MindSpore predict model to file in specified format.
 
@@ -408,6 +611,10 @@ def export(net, *inputs, file_name, file_format='GEIR'):
             Ascend model.
             - ONNX: Open Neural Network eXchange. An open format built to represent machine learning models.
             - LITE: Huawei model format for mobile.
+
+        external_data (bool): Whether to write the parameters of an 'ONNX' model to the file `file_name`.data in the
+            external data format of ONNX instead of into the model, which is needed by the models over 2GB.
+            Default: False.
     """
     logger.info("exporting model file:%s format:%s.", file_name, file_format)
     check_input_data(*inputs, data_class=Tensor)
@@ -426,10 +633,10 @@ def export(net, *inputs, file_name, file_format='GEIR'):
     elif file_format == 'ONNX':  # file_format is 'ONNX'
         phase_name = 'export_onnx'
         graph_id, _ = _executor.compile(net, *inputs, phase=phase_name)
-        onnx_stream = _executor._get_func_graph_proto(graph_id)
-        with open(file_name, 'wb') as f:
-            os.chmod(file_name, stat.S_IWUSR | stat.S_IRUSR)
-            f.write(onnx_stream)
+        _executor._export_onnx(graph_id, file_name, external_data)
+        os.chmod(file_name, stat.S_IWUSR | stat.S_IRUSR)
+        if external_data:
+            os.chmod(file_name + '.data', stat.S_IWUSR | stat.S_IRUSR)
     elif file_format == 'LITE':  # file_format is 'LITE'
         context.set_context(save_ms_model=True, save_ms_model_path=file_name)
         net(*inputs)
@@ -13,7 +13,8 @@
 # limitations under the License.
 # ============================================================================
 """Schedule the event writer process."""
-import multiprocessing as mp
+import queue
+import threading
 from enum import Enum, unique
 from mindspore import log as logger
 from ..._c_expression import Tensor
@@ -25,6 +26,8 @@ FORMAT_TENSOR_STR = "Tensor"
 FORMAT_IMAGE_STR = "Image"
 FORMAT_BEGIN_SLICE = "[:"
 FORMAT_END_SLICE = "]"
+# the steps whose summary data wait for the worker at most
+MAX_PENDING_STEPS = 32
 
 # cache the summary data dict
 # {id: SummaryData}
@@ -142,14 +145,13 @@ class WorkerScheduler:
         writer_id (int): The index of writer.
     """
     def __init__(self, writer_id):
-        # Create the process of write event file
-        self.write_lock = mp.Lock()
-        # Schedule info for all worker
-        # Format: {worker: (step, WorkerStatus)}
-        self.schedule_table = {}
+        # The steps waiting for the worker, the step waits only when the worker falls so far behind
+        self.pending_steps = queue.Queue(MAX_PENDING_STEPS)
         # write id
         self.writer_id = writer_id
         self.has_graph = False
+        self.worker = SummaryDataWorker(self.pending_steps, self.writer_id)
+        self.worker.start()
 
     def dispatch(self, step, data):
         """
@@ -174,7 +176,7 @@ class WorkerScheduler:
 
     def _start_worker(self, step, data_id):
         """
-        Start worker.
+        Send the data to the worker.
 
         Args:
             step (Number): The index of recode.
@@ -183,19 +185,11 @@ class WorkerScheduler:
         Return:
             bool, run successfully or not.
         """
-        # assign the worker
         policy = self._make_policy()
-        if policy == ScheduleMethod.TEMP_WORKER:
-            worker = SummaryDataProcess(step, data_id, self.write_lock, self.writer_id)
-            # update the schedule table
-            self.schedule_table[worker] = (step, data_id, WorkerStatus.WORKER_INIT)
-            # start the worker
-            worker.start()
+        if policy == ScheduleMethod.FORMAL_WORKER:
+            self.pending_steps.put((step, data_id))
         else:
             logger.error("Do not support the other scheduler policy now.")
-
-        # update the scheduler infor
-        self._update_scheduler()
         return True
 
     def _data_convert(self, data_list):
@@ -226,62 +220,59 @@ class WorkerScheduler:
 
         return True, size, data_list
 
-    def _update_scheduler(self):
-        """Check the worker status and update schedule table."""
-        workers = list(self.schedule_table.keys())
-        for worker in workers:
-            if not worker.is_alive():
-                # update the table
-                worker.join()
-                del self.schedule_table[worker]
+    def flush(self):
+        """Wait for the worker to process the pending data."""
+        if self.worker.is_alive():
+            self.pending_steps.join()
 
     def close(self):
         """Confirm all worker is end."""
-        workers = self.schedule_table.keys()
-        for worker in workers:
-            if worker.is_alive():
-                worker.join()
+        if self.worker.is_alive():
+            self.pending_steps.put(None)
+            self.worker.join()
 
     def _make_policy(self):
         """Select the schedule strategy by data."""
-        # now only support the temp worker
-        return ScheduleMethod.TEMP_WORKER
+        # now only support the formal worker
+        return ScheduleMethod.FORMAL_WORKER
 
 
-class SummaryDataProcess(mp.Process):
+class SummaryDataWorker(threading.Thread):
     """
-    Process that consume the summarydata.
+    Thread that consume the summary data of the steps, until it receives None.
 
     Args:
-        step (int): The index of step.
-        data_id (int): The index of summary data.
-        write_lock (Lock): The process lock for writer same file.
+        pending_steps (Queue): The step index and the index of summary data of the steps.
         writer_id (int): The index of writer.
     """
-    def __init__(self, step, data_id, write_lock, writer_id):
-        super(SummaryDataProcess, self).__init__()
+    def __init__(self, pending_steps, writer_id):
+        super(SummaryDataWorker, self).__init__()
         self.daemon = True
-        self.writer_id = writer_id
-        self.writer = SummaryDataManager.summary_file_get(self.writer_id)
+        self.pending_steps = pending_steps
+        self.writer = SummaryDataManager.summary_file_get(writer_id)
         if self.writer is None:
             logger.error("The writer_id(%r) does not have writer", writer_id)
-        self.step = step
-        self.data_id = data_id
-        self.write_lock = write_lock
-        self.name = "SummaryDataConsumer_" + str(self.step)
+        self.name = "SummaryDataConsumer_" + str(writer_id)
 
     def run(self):
-        """The consumer is process the step data and exit."""
-        # convert the data to event
-        # All exceptions need to be caught and end the queue
-        try:
-            logger.debug("process(%r) process a data(%r)", self.name, self.step)
-            # package the summary event
-            summary_event = package_summary_event(self.data_id, self.step)
-            # send the event to file
-            self._write_summary(summary_event)
-        except Exception as e:
-            logger.error("Summary data mq consumer exception occurred, value = %r", e)
+        """The consumer is process the step data until the end."""
+        while True:
+            item = self.pending_steps.get()
+            if item is None:
+                self.pending_steps.task_done()
+                break
+            step, data_id = item
+            # convert the data to event
+            # All exceptions need to be caught and continue with the next step
+            try:
+                logger.debug("thread(%r) process a data(%r)", self.name, step)
+                # package the summary event
+                summary_event = package_summary_event(data_id, step)
+                # send the event to file
+                self._write_summary(summary_event)
+            except Exception as e:
+                logger.error("Summary data mq consumer exception occurred, value = %r", e)
+            self.pending_steps.task_done()
 
     def _write_summary(self, summary_event):
         """
@@ -299,7 +290,5 @@ class SummaryDataProcess(mp.Process):
 
         """
         event_str = summary_event.SerializeToString()
-        self.write_lock.acquire()
         self.writer.write_event_to_file(event_str)
-        self.writer.flush()
-        self.write_lock.release()
+        self.writer.flush_cycle()
@@ -169,9 +169,8 @@ class SummaryRecord:
         # process the data
         self.worker_scheduler.dispatch(self.step, data)
 
-        # count & flush
+        # count, the worker flushes the events it writes by the flush time
         self.event_writer.count_event()
-        self.event_writer.flush_cycle()
 
         logger.debug("Send the summary data to scheduler for saving, step = %d", self.step)
         return True
@@ -205,6 +204,7 @@ class SummaryRecord:
         if self._closed:
             logger.error("The record writer is closed and can not flush.")
         else:
+            self.worker_scheduler.flush()
             self.event_writer.flush()
 
     def close(self):
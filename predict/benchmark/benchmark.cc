@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <utility>
 #include <memory>
+#include <cstring>
 #include "include/session.h"
 
 namespace mindspore {
@@ -252,6 +253,105 @@ STATUS Benchmark::CompareOutput(const std::map<NODE_ID, std::vector<Tensor *>> &
   }
 }
 
+namespace {
+// nearest rank percentile of the sorted times
+uint64_t GetPercentile(const std::vector<uint64_t> &sortedTimes, size_t percent) {
+  MS_ASSERT(!sortedTimes.empty());
+  size_t rank = (sortedTimes.size() * percent + 99) / 100;
+  return sortedTimes[rank == 0 ? 0 : rank - 1];
+}
+
+// the peak resident memory of the process, 0 if it is unknown
+size_t GetPeakMemoryKB() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, strlen("VmHWM:"), "VmHWM:") == 0) {
+      std::stringstream stream(line.substr(strlen("VmHWM:")));
+      size_t size = 0;
+      stream >> size;
+      return size;
+    }
+  }
+  return 0;
+}
+
+bool EndsWith(const std::string &str, const std::string &suffix) {
+  return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+}  // namespace
+
+STATUS Benchmark::ReportProfile(const std::vector<uint64_t> &sortedRunTimes) {
+  auto nodeProfiles = session->GetNodeProfiles();
+  uint64_t nodeTotalTime = 0;
+  for (auto &profile : nodeProfiles) {
+    nodeTotalTime += profile.totalTimeUs;
+  }
+  // the slowest nodes first
+  std::stable_sort(nodeProfiles.begin(), nodeProfiles.end(), [](const NodeProfile &a, const NodeProfile &b) {
+    return a.totalTimeUs > b.totalTimeUs;
+  });
+  size_t peakMemory = GetPeakMemoryKB();
+  float utilization = session->GetThreadPoolUtilization() * percentage;
+  for (auto &profile : nodeProfiles) {
+    MS_LOGI("Node %s (%s): AvgRunTime = %f ms, %f%%", profile.name.c_str(), profile.type.c_str(),
+            profile.totalTimeUs / US2MS / std::max<uint64_t>(profile.runCount, 1),
+            nodeTotalTime == 0 ? 0 : profile.totalTimeUs * percentage / nodeTotalTime);
+  }
+  MS_LOGI("PeakMemory = %zu KB, ThreadPoolUtilization = %f%%", peakMemory, utilization);
+  if (_flags->profilePath.empty()) {
+    return RET_OK;
+  }
+
+  std::ofstream out(_flags->profilePath);
+  if (!out.is_open()) {
+    MS_LOGE("open profile file %s failed", _flags->profilePath.c_str());
+    return RET_ERROR;
+  }
+  bool json = EndsWith(_flags->profilePath, ".json");
+  std::vector<std::pair<std::string, float>> summary = {
+    {"min_run_time_ms", sortedRunTimes.front() / US2MS},
+    {"max_run_time_ms", sortedRunTimes.back() / US2MS},
+    {"p50_run_time_ms", GetPercentile(sortedRunTimes, 50) / US2MS},
+    {"p90_run_time_ms", GetPercentile(sortedRunTimes, 90) / US2MS},
+    {"p99_run_time_ms", GetPercentile(sortedRunTimes, 99) / US2MS},
+    {"peak_memory_kb", static_cast<float>(peakMemory)},
+    {"thread_pool_utilization", utilization}};
+  if (json) {
+    out << "{\n  \"model\": \"" << modelName << "\",\n  \"loop_count\": " << sortedRunTimes.size()
+        << ",\n  \"num_threads\": " << _flags->numThreads << ",\n";
+    for (auto &item : summary) {
+      out << "  \"" << item.first << "\": " << item.second << ",\n";
+    }
+    out << "  \"nodes\": [";
+  } else {
+    out << "metric,value\nmodel," << modelName << "\nloop_count," << sortedRunTimes.size() << "\nnum_threads,"
+        << _flags->numThreads << "\n";
+    for (auto &item : summary) {
+      out << item.first << "," << item.second << "\n";
+    }
+    out << "\nnode,type,run_count,avg_run_time_ms,percentage\n";
+  }
+  for (size_t i = 0; i < nodeProfiles.size(); i++) {
+    auto &profile = nodeProfiles[i];
+    float avgTime = profile.totalTimeUs / US2MS / std::max<uint64_t>(profile.runCount, 1);
+    float ratio = nodeTotalTime == 0 ? 0 : profile.totalTimeUs * percentage / nodeTotalTime;
+    if (json) {
+      out << (i == 0 ? "\n" : ",\n") << "    {\"node\": \"" << profile.name << "\", \"type\": \"" << profile.type
+          << "\", \"run_count\": " << profile.runCount << ", \"avg_run_time_ms\": " << avgTime
+          << ", \"percentage\": " << ratio << "}";
+    } else {
+      out << profile.name << "," << profile.type << "," << profile.runCount << "," << avgTime << "," << ratio << "\n";
+    }
+  }
+  if (json) {
+    out << "\n  ]\n}\n";
+  }
+  out.close();
+  MS_LOGI("write profile to %s", _flags->profilePath.c_str());
+  return RET_OK;
+}
+
 STATUS Benchmark::MarkPerformance() {
   MS_LOGI("Running warm up loops...");
   for (int i = 0; i < _flags->warmUpLoopCount; i++) {
@@ -263,6 +363,10 @@ STATUS Benchmark::MarkPerformance() {
   }
 
   MS_LOGI("Running benchmark loops...");
+  if (_flags->profiling) {
+    session->SetProfiling(true);
+  }
+  std::vector<uint64_t> runTimes;
   uint64_t timeMin = maxTimeThr;
   uint64_t timeMax = 0;
   uint64_t timeAvg = 0;
@@ -276,6 +380,7 @@ STATUS Benchmark::MarkPerformance() {
 
     uint64_t end = GetTimeUs();
     uint64_t time = end - start;
+    runTimes.push_back(time);
     timeMin = std::min(timeMin, time);
     timeMax = std::max(timeMax, time);
     timeAvg += time;
@@ -294,6 +399,17 @@ STATUS Benchmark::MarkPerformance() {
     timeAvg /= _flags->loopCount;
     MS_LOGI("MinRunTime = %f ms, MaxRuntime = %f ms, AvgRunTime = %f ms", timeMin / US2MS, timeMax / US2MS,
             timeAvg / US2MS);
+    std::sort(runTimes.begin(), runTimes.end());
+    MS_LOGI("P50RunTime = %f ms, P90RunTime = %f ms, P99RunTime = %f ms", GetPercentile(runTimes, 50) / US2MS,
+            GetPercentile(runTimes, 90) / US2MS, GetPercentile(runTimes, 99) / US2MS);
+    if (_flags->profiling) {
+      auto status = ReportProfile(runTimes);
+      session->SetProfiling(false);
+      if (status != RET_OK) {
+        MS_LOGE("Report profile error %d", status);
+        return status;
+      }
+    }
   }
   return RET_OK;
 }
@@ -399,6 +515,7 @@ STATUS Benchmark::Init() {
   MS_LOGI("LoopCount = %d", this->_flags->loopCount);
   MS_LOGI("WarmUpLoopCount = %d", this->_flags->warmUpLoopCount);
   MS_LOGI("NumThreads = %d", this->_flags->numThreads);
+  MS_LOGI("Profiling = %d", this->_flags->profiling);
   MS_LOGI("calibDataPath = %s", this->_flags->calibDataPath.c_str());
 
   this->_flags->inDataType = this->_flags->inDataTypeIn == "img" ? kImage : kBinary;
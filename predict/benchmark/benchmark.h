@@ -64,6 +64,9 @@ class BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::loopCount, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::numThreads, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::warmUpLoopCount, "warmUpLoopCount", "Run warm up loop", 3);
+    AddFlag(&BenchmarkFlags::profiling, "profiling", "Profile every node, the memory and the thread pool", false);
+    AddFlag(&BenchmarkFlags::profilePath, "profilePath",
+            "Profile output path, in json if it ends with .json, in csv otherwise, if not set, only log it", "");
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::calibDataPath, "calibDataPath", "Calibration data file path", "");
   }
@@ -82,6 +85,8 @@ class BenchmarkFlags : public virtual FlagParser {
   int loopCount;
   int numThreads;
   int warmUpLoopCount;
+  bool profiling;
+  std::string profilePath;
   // MarkAccuracy
   std::string calibDataPath;
 };
@@ -116,6 +121,8 @@ class Benchmark {
 
   STATUS MarkPerformance();
 
+  STATUS ReportProfile(const std::vector<uint64_t> &sortedRunTimes);
+
   STATUS MarkAccuracy();
 
  private:
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICT_INCLUDE_BATCH_SESSION_H_
+#define PREDICT_INCLUDE_BATCH_SESSION_H_
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "include/session.h"
+#include "include/tensor.h"
+
+#define MSPREDICT_API __attribute__((visibility("default")))
+
+namespace mindspore {
+namespace predict {
+///\brief MindSpore predict batch session.
+///
+/// This class batches the concurrent requests of a server onto one session. The requests are queued and run
+/// together once their batch sizes fill the batch of the model, or when the first queued request has waited for the
+/// timeout. The batch of the model is the first dimension of its inputs and outputs, the requests are packed along
+/// it, the unused samples are zero and the outputs are split back to the requests.
+///
+///\note
+/// Run is thread-safe, the session is only run by the worker thread of the batch session.
+class MSPREDICT_API BatchSession {
+ public:
+  ///\brief Constructor of MindSpore predict batch session.
+  ///
+  ///\param[in] session The session running the batches, which must not be run by the caller any more.
+  ///\param[in] timeoutUs The time in microseconds a request waits for the other requests of its batch.
+  ///
+  ///\return Instance of MindSpore predict batch session.
+  BatchSession(const std::shared_ptr<Session> &session, int64_t timeoutUs);
+
+  ///\brief Destructor of MindSpore predict batch session, which runs the queued requests before it returns.
+  ~BatchSession();
+
+  ///\brief Init the batch session and start its worker thread.
+  ///
+  ///\return Return RET_OK if the initialization is success, otherwhise return RET_ERROR.
+  int Init();
+
+  ///\brief Run a request in a batch and wait for its outputs.
+  ///
+  ///\param[in] inputs The inputs of the request, whose first dimension is its batch size.
+  ///\param[out] outputs Every output node's output tensors of the request.
+  ///
+  ///\return Return RET_OK if run success, otherwhise return the error code.
+  ///
+  ///\note
+  /// The shapes of the inputs must be the ones of the model except the batch size, which is at most the batch of the
+  /// model. The caller needs to free memory of outputs.
+  int Run(const std::vector<Tensor *> &inputs, std::map<std::string, std::vector<Tensor *>> *outputs);
+
+  ///\brief Get the batch of the model, which is the maximum batch size of a run.
+  ///
+  ///\return The batch of the model.
+  int64_t GetMaxBatchSize() const { return maxBatchSize; }
+
+ private:
+  struct Request;
+
+  int CheckInputs(const std::vector<Tensor *> &inputs, int64_t *batchSize) const;
+  void WorkerLoop();
+  int RunBatch(const std::vector<Request *> &batch);
+  int SplitOutputs(const std::map<std::string, std::vector<Tensor *>> &batchOutputs,
+                   const std::vector<Request *> &batch);
+
+  std::shared_ptr<Session> session;
+  int64_t timeoutUs;
+  int64_t maxBatchSize = 0;
+  std::vector<std::vector<int64_t>> inputDims;
+  std::vector<DataType> inputDataTypes;
+
+  std::mutex mtx;
+  std::condition_variable queueCond;
+  std::condition_variable doneCond;
+  std::deque<Request *> requests;
+  int64_t queuedBatchSize = 0;
+  bool stopped = false;
+  std::thread worker;
+};
+
+///\brief MindSpore predict batch session create function
+///
+///\param[in] session The session running the batches, see BatchSession.
+///\param[in] timeoutUs The time in microseconds a request waits for the other requests of its batch.
+///
+///\return Instance of MindSpore predict batch session, nullptr if the inputs of the session have no batch.
+std::shared_ptr<BatchSession> MSPREDICT_API CreateBatchSession(const std::shared_ptr<Session> &session,
+                                                               int64_t timeoutUs);
+}  // namespace predict
+}  // namespace mindspore
+
+#endif  // PREDICT_INCLUDE_BATCH_SESSION_H_
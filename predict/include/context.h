@@ -18,6 +18,7 @@
 #define PREDICT_INCLUDE_CONTEXT_H_
 
 #include <memory>
+#include <string>
 #include "dlpack/dlpack.h"
 #include "include/tensor.h"
 
@@ -49,6 +50,9 @@ class MSPREDICT_API Context {
   DLContext deviceCtx;
   int threadNum = 1;
   std::shared_ptr<Allocator> allocator;
+  // the tuning log of the TVM kernels for the device, whose tuned kernels are preferred, the default kernels are used
+  // if it is empty
+  std::string kernelTuningPath;
 };
 }  // namespace predict
 }  // namespace mindspore
@@ -43,6 +43,20 @@ class Graph;
 /// The caller does not need to care about detailed implementation of this class, so just list the class name here.
 class GraphExecution;
 
+///\brief Model shared by the sessions defined by MindSpore predict.
+///
+///\note
+/// The caller does not need to care about detailed implementation of this class, so just list the class name here.
+class Model;
+
+///\brief The profile of a node over the profiled runs of a session.
+struct NodeProfile {
+  NODE_ID name;
+  std::string type;
+  uint64_t runCount = 0;
+  uint64_t totalTimeUs = 0;
+};
+
 ///\brief MindSpore predict session.
 ///
 /// This class represents session of MindSpore predict.
@@ -71,12 +85,21 @@ class MSPREDICT_API Session {
   ///\return Return RET_OK if the initialization is success, otherwhise return RET_ERROR.
   int Init(const char *graphBuf, size_t size);
 
+  ///\brief Init the session with a shared model.
+  ///
+  ///\param[in] model The model loaded by LoadModel, whose weights are shared with the other sessions.
+  ///
+  ///\return Return RET_OK if the initialization is success, otherwhise return RET_ERROR.
+  int Init(const std::shared_ptr<Model> &model);
+
   ///\brief Get the input of session.
   ///
   ///\return Input node's input tensors if found, empty vector otherwise.
   ///
   ///\note
   /// The caller needs to allocate and free memory of inputs.
+  /// The data of the inputs is read in place by Run unless the model takes them in NC4HW4 or float16, so a caller
+  /// buffer such as a camera frame can be set to an input by Tensor::SetData without a copy.
   std::vector<Tensor *> GetInput();
 
   ///\brief Run the session.
@@ -107,6 +130,38 @@ class MSPREDICT_API Session {
   /// The caller needs to free memory of outputs.
   std::map<std::string, std::vector<Tensor *>> GetAllOutput();
 
+  ///\brief Bind the output of a node to the buffers of the caller, which the following runs write in place.
+  ///
+  ///\param[in] nodeName Given output node name.
+  ///\param[in] outputs The tensors holding the buffers, in the order of GetOutput, empty to unbind the node.
+  ///
+  ///\return Return RET_OK if the outputs are bound, otherwise return RET_INPUT_TENSOR_ERROR or RET_ERROR.
+  ///
+  ///\note
+  /// The shape and data type of the tensors must be the ones of the node's outputs, which are in NCHW and not float16.
+  /// The caller keeps the tensors and their buffers until the node is unbound, the outputs of a bound node are not
+  /// returned by GetOutput and GetAllOutput.
+  int BindOutput(const std::string &nodeName, const std::vector<Tensor *> &outputs);
+
+  ///\brief Enable or disable the profiling of the runs, the profile collected so far is cleared.
+  ///
+  ///\param[in] enable Whether to time every node of the following runs.
+  ///
+  ///\note
+  /// The thread pool is shared by the sessions of the process, so its utilization is of all of them.
+  void SetProfiling(bool enable);
+
+  ///\brief Get the profile of the nodes.
+  ///
+  ///\return The profile of every node run since the profiling is enabled, in the order of the first run.
+  std::vector<NodeProfile> GetNodeProfiles() const;
+
+  ///\brief Get the utilization of the thread pool.
+  ///
+  ///\return The time of the threads running tasks over the time of all the threads in the parallel parts of the
+  /// runs since the profiling is enabled, 0 if nothing ran in parallel.
+  float GetThreadPoolUtilization() const;
+
  protected:
   ///\brief Init the executor.
   ///
@@ -114,9 +169,13 @@ class MSPREDICT_API Session {
   int InitExecutor();
 
   const Context &_ctx;
+  std::shared_ptr<Model> _model = nullptr;
   Graph *_graph = nullptr;
   GraphExecution *_executor = nullptr;
   bool reinitExecutor = true;
+  bool profiling = false;
+  std::vector<NodeProfile> nodeProfiles;
+  std::map<NODE_ID, std::vector<Tensor *>> boundOutputs;
 };
 
 ///\brief MindSpore predict neural network session create function
@@ -133,6 +192,39 @@ class MSPREDICT_API Session {
 ///\note
 /// The caller needs to allocate and free memory of graph buffer.
 std::shared_ptr<Session> MSPREDICT_API CreateSession(const char *graphBuf, size_t size, const Context &ctx);
+
+///\brief MindSpore predict model load function
+///
+/// This function used to load the model once for the sessions serving concurrent requests. The weights are held by
+/// the model and shared by the sessions created from it, so each session only owns its activations.
+///
+///\param[in] graphBuf The buffer of the graph, which is copied by the model.
+///\param[in] size The size of the graph buffer.
+///
+///\return Instance of the MindSpore predict model, nullptr if the buffer is invalid.
+std::shared_ptr<Model> MSPREDICT_API LoadModel(const char *graphBuf, size_t size);
+
+///\brief MindSpore predict model load function from file
+///
+/// This function maps the model file read-only instead of reading it into memory, and the weights aligned in the
+/// file refer to the mapped region directly, so they are loaded on demand and shared by the processes mapping the
+/// same file.
+///
+///\param[in] modelPath The path of the model file.
+///
+///\return Instance of the MindSpore predict model, nullptr if the file is invalid.
+std::shared_ptr<Model> MSPREDICT_API LoadModelFromFile(const char *modelPath);
+
+///\brief MindSpore predict neural network session create function with a shared model
+///
+///\param[in] model The model loaded by LoadModel.
+///\param[in] ctx The context of the session.
+///
+///\return Instance of MindSpore predict session.
+///
+///\note
+/// A session is not thread-safe, each thread runs its own session created from the same model.
+std::shared_ptr<Session> MSPREDICT_API CreateSession(const std::shared_ptr<Model> &model, const Context &ctx);
 }  // namespace predict
 }  // namespace mindspore
 
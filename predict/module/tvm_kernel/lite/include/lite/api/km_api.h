@@ -50,6 +50,9 @@ PUBLIC std::function<int(const std::vector<DLTensor *> &)> GetKernel(const std::
 struct PUBLIC KernelOption {
   int numThreads = 0;
   std::string device;
+  // the tuning log of the device, each line of which is "default_fid tuned_fid vc vh vw", the tuned kernel is used
+  // instead of the default one if it is linked and the output channels, height and width are multiples of its tiles
+  std::string tuningPath;
 };
 
 PUBLIC std::function<int(const std::vector<DLTensor *> &)> GetKernel(const mindspore::predict::OpDef &opdef,
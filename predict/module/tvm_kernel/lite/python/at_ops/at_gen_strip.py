@@ -14,7 +14,9 @@
 # ============================================================================
 """
 This module is rule to generation tvm operate. you can use it like:
-python3 at_gen_strip.py [x86:arm64:arm32]
+python3 at_gen_strip.py [x86:arm64:arm32] [float32:float16] [tuning_log]
+the float16 kernels are run by the float16 models, which are saved with the save_ms_model_fp16 context.
+the tuned convolutions of a tuning log written by at_tune.py are generated besides the default kernels.
 """
 import os
 import sys
@@ -23,13 +25,17 @@ from functools import partial
 from at_ops.at_lib import Deconv, tvm, ConvVar, BatchNorm, Eltwise, Resize, CaffeCrop, CaffePReLU
 from at_ops.at_lib import FullConnection, Power, ArgMax, Concat, Pad, Pooling, Mean, MatMul, Softmax
 from at_ops.at_lib import Activation, Exp, Split, Cast, ExpandDims, Tile, Range
+from at_ops.at_tune import gen_conv_by_fid
 from at_rt import at_runtime_reset
 
 
 check_correctness = False
 ARCH_TYPE = sys.argv[1]
 
-dtypes = ("float32",)  # "float16",  "uint8", "int8", "uint32", "int32"
+DTYPE = sys.argv[2] if len(sys.argv) > 2 else "float32"
+TUNING_LOG = sys.argv[3] if len(sys.argv) > 3 else None
+
+dtypes = (DTYPE,)  # "float32", "float16",  "uint8", "int8", "uint32", "int32"
 
 device_map = {
     "x86": "llvm",
@@ -507,6 +513,15 @@ def gen_const_libs(some_op=None):
             func(device=device, lib_path=lib_path, **args)
 
 
+def gen_tuned_libs(tuning_log):
+    with open(tuning_log) as log:
+        for line in log:
+            fields = line.split()
+            if not fields or fields[0].startswith("#"):
+                continue
+            gen_conv_by_fid(fields[1], device, lib_path, use_arm32=use_arm32)
+
+
 if __name__ == "__main__":
     if not os.path.exists(lib_path):
         os.makedirs(lib_path)
@@ -514,3 +529,5 @@ if __name__ == "__main__":
     with tvm.target.create(device):
         with at_runtime_reset.AtRuntimeReset():
             gen_const_libs()
+            if TUNING_LOG:
+                gen_tuned_libs(TUNING_LOG)
@@ -362,7 +362,7 @@ def ConvVar(device="llvm", lib_path="./", optype=None,\
     # generate lib
     attr = [batch, in_channel, in_height, in_width, out_channel, in_tensor, kernel_tensor]
     tensor_list = [*attr, bias, out_tensor] if has_bias else [*attr, out_tensor]
-    Genlib(s, tensor_list, device, opname, lib_path)
+    return Genlib(s, tensor_list, device, opname, lib_path)
 
 
 def BaseImplementation(input_tensor, temp_tensor, get_input, layout, padding):
@@ -0,0 +1,176 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""
+This module tunes the tiles of the convolution kernels for a SoC. you can use it like:
+python3 at_tune.py [x86:arm64:arm32] soc workload_file tuning_log [rpc_tracker_host:port rpc_key]
+each line of the workload file is "default_fid batch in_channel in_height in_width out_channel", the default fid
+and the shape of a convolution are logged by the kernel manager at debug level. each line of the tuning log is
+"default_fid tuned_fid vc vh vw", the tuned kernels are generated by at_gen_strip.py with the tuning log, and the
+runtime prefers them when the tuning log is set to the kernelTuningPath of its context.
+"""
+import itertools
+import os
+import re
+import sys
+import numpy as np
+from tvm.contrib import ndk
+from at_ops.at_lib import ConvVar, map_conv, tvm
+from config_tool import activation_enum_map, get_key_by_value
+
+CONV_FID_PATTERN = re.compile(
+    r"^(Conv2D|DepthwiseConv2D)_ndim(\d+)_([a-z]+\d+)_k(\d+)_s(\d+)_p(\d)(\d)(\d)(\d)_d(\d+)_act(\d+)"
+    r"_vc(\d+)_vh(\d+)_vw(\d+)_hasbias(\d)$")
+
+TILE_CANDIDATES = ((1, 2, 4, 8), (1, 2, 4), (1, 2, 4, 8))
+
+device_map = {
+    "x86": "llvm",
+    "arm64": "llvm -device=arm_cpu -model=%s -target=arm64-linux-android -mattr=+neon",
+    "arm32": "llvm -device=arm_cpu -model=%s -target=armv7a-linux-eabi -mfloat-abi=soft",
+}
+
+
+def parse_conv_fid(fid):
+    """the arguments of ConvVar and the tiles (vc, vh, vw) of a convolution kernel, None if it is not one"""
+    match = CONV_FID_PATTERN.match(fid)
+    if match is None:
+        return None, None
+    groups = match.groups()
+    kernel, stride, dilation = int(groups[3]), int(groups[4]), int(groups[9])
+    args = {
+        "optype": get_key_by_value(map_conv, groups[0]),
+        "ndim": int(groups[1]),
+        "layout": "NCHW",
+        "dtype": groups[2],
+        "kernels": (kernel, kernel),
+        "strides": (stride, stride),
+        "pad": tuple(int(p) for p in groups[5:9]),
+        "dilations": (dilation, dilation),
+        "activation_type": get_key_by_value(activation_enum_map, int(groups[10])),
+        "hasbias": groups[14] == "1",
+    }
+    if args["optype"] == "ConvolutionDepthwise":
+        args["channel_multiplier"] = 1
+    return args, tuple(int(t) for t in groups[11:14])
+
+
+def tuned_fid(fid, tiles):
+    vc, vh, vw = tiles
+    return re.sub(r"_vc\d+_vh\d+_vw\d+_", "_vc%d_vh%d_vw%d_" % (vc, vh, vw), fid)
+
+
+def conv_cfg(tiles):
+    vc, vh, vw = tiles
+    return {
+        "CI": tvm.var("CI"),
+        "VH": vh,
+        "VW": vw,
+        "VC": vc,
+        "VI": 1,
+        "tile_oh": vh,
+        "tile_ow": vw,
+        "tile_co": vc,
+        "ann_reduce": ["none", "unroll"],
+        "ann_spatial": ["unroll", "unroll", "vec"],
+        "core_id": 0,
+    }
+
+
+def gen_conv_by_fid(fid, device, lib_path, tiles=None, use_arm32=False):
+    """generate the convolution kernel of the fid, with the tiles instead of its own ones if they are given"""
+    args, fid_tiles = parse_conv_fid(fid)
+    if args is None:
+        raise ValueError("%s is not a convolution kernel" % fid)
+    return ConvVar(device=device, lib_path=lib_path, cfg=conv_cfg(tiles or fid_tiles), use_arm32=use_arm32, **args)
+
+
+def out_shape(args, height, width):
+    kernel, stride, dilation = args["kernels"][0], args["strides"][0], args["dilations"][0]
+    pad_up, pad_down, pad_left, pad_right = args["pad"]
+    dilated_kernel = (kernel - 1) * dilation + 1
+    return (height + pad_up + pad_down - dilated_kernel) // stride + 1, \
+           (width + pad_left + pad_right - dilated_kernel) // stride + 1
+
+
+def measure(func, opname, remote, workload, args, tmp_dir):
+    """the mean time in seconds of the kernel on the device"""
+    batch, in_channel, height, width, out_channel = workload
+    dtype = args["dtype"]
+    out_h, out_w = out_shape(args, height, width)
+    if args["optype"] == "ConvolutionDepthwise":
+        kernel_shape = (in_channel, 1) + args["kernels"]
+    else:
+        kernel_shape = (out_channel, in_channel) + args["kernels"]
+    shapes = [(batch, in_channel, height, width), kernel_shape]
+    if args["hasbias"]:
+        shapes.append((out_channel,))
+    shapes.append((batch, out_channel, out_h, out_w))
+    if remote is None:
+        ctx = tvm.cpu(0)
+        module = func
+    else:
+        lib_file = os.path.join(tmp_dir, opname + ".so")
+        func.export_library(lib_file, ndk.create_shared)
+        remote.upload(lib_file)
+        module = remote.load_module(opname + ".so")
+        ctx = remote.cpu(0)
+    tensors = [tvm.nd.array(np.random.uniform(size=shape).astype(dtype), ctx) for shape in shapes]
+    evaluator = module.time_evaluator(opname, ctx, number=10, repeat=3)
+    return evaluator(*workload, *tensors).mean
+
+
+def tune(device, workload_file, tuning_log, remote, tmp_dir, use_arm32):
+    with open(workload_file) as workloads, open(tuning_log, "w") as log:
+        log.write("# default_fid tuned_fid vc vh vw\n")
+        for line in workloads:
+            fields = line.split()
+            if not fields or fields[0].startswith("#"):
+                continue
+            fid, workload = fields[0], tuple(int(f) for f in fields[1:6])
+            args, _ = parse_conv_fid(fid)
+            if args is None:
+                print("skip", fid, "which is not a convolution kernel")
+                continue
+            out_h, out_w = out_shape(args, workload[2], workload[3])
+            best_tiles, best_time = None, None
+            for tiles in itertools.product(*TILE_CANDIDATES):
+                vc, vh, vw = tiles
+                # the kernels drop the tails of the output which the tiles do not divide
+                if workload[4] % vc or out_h % vh or out_w % vw:
+                    continue
+                _, func, _ = gen_conv_by_fid(fid, device, tmp_dir + "/", tiles, use_arm32)
+                cost = measure(func, tuned_fid(fid, tiles), remote, workload, args, tmp_dir)
+                print(fid, tiles, cost)
+                if best_time is None or cost < best_time:
+                    best_tiles, best_time = tiles, cost
+            if best_tiles is not None and best_tiles != (1, 1, 1):
+                log.write("%s %s %d %d %d\n" % (fid, tuned_fid(fid, best_tiles), *best_tiles))
+
+
+if __name__ == "__main__":
+    ARCH_TYPE, SOC = sys.argv[1], sys.argv[2]
+    DEVICE = device_map[ARCH_TYPE] % SOC if "%s" in device_map[ARCH_TYPE] else device_map[ARCH_TYPE]
+    REMOTE = None
+    if len(sys.argv) > 6:
+        from tvm import rpc
+        HOST, PORT = sys.argv[5].split(":")
+        REMOTE = rpc.connect_tracker(HOST, int(PORT)).request(sys.argv[6])
+    elif ARCH_TYPE != "x86":
+        raise ValueError("the kernels of %s are measured on the device through a rpc tracker" % ARCH_TYPE)
+    TMP_DIR = "./tune_" + SOC
+    if not os.path.exists(TMP_DIR):
+        os.makedirs(TMP_DIR)
+    with tvm.target.create(DEVICE):
+        tune(DEVICE, sys.argv[3], sys.argv[4], REMOTE, TMP_DIR, ARCH_TYPE == "arm32")
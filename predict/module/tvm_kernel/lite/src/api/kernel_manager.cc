@@ -139,9 +139,12 @@ void ConfigThreadPool(int mode = 1, int nthreads = 0, bool execute_self = true)
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include "flatbuffers/flatbuffers.h"
@@ -456,6 +459,66 @@ runnerType __attribute__((noinline)) GetKernel_Insert_vector_float(const std::st
   return runner;
 }
 
+struct TunedKernel {
+  std::string fid;
+  int vc = 1;
+  int vh = 1;
+  int vw = 1;
+};
+
+// the tuned kernels of a tuning log by their default kernels, the log is read once
+static const std::unordered_map<std::string, TunedKernel> &GetTunedKernels(const std::string &tuningPath) {
+  static std::mutex tuningMutex;
+  static std::unordered_map<std::string, std::unordered_map<std::string, TunedKernel>> tuningLogs;
+  std::lock_guard<std::mutex> lock(tuningMutex);
+  auto iter = tuningLogs.find(tuningPath);
+  if (iter != tuningLogs.end()) {
+    return iter->second;
+  }
+  std::unordered_map<std::string, TunedKernel> tunedKernels;
+  std::ifstream tuningLog(tuningPath);
+  if (!tuningLog.is_open()) {
+    MS_LOGW("open kernel tuning log %s failed, the default kernels are used", tuningPath.c_str());
+  }
+  std::string line;
+  while (std::getline(tuningLog, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::stringstream stream(line);
+    std::string defaultFid;
+    TunedKernel tuned;
+    if (!(stream >> defaultFid >> tuned.fid >> tuned.vc >> tuned.vh >> tuned.vw) || tuned.vc <= 0 || tuned.vh <= 0 ||
+        tuned.vw <= 0) {
+      MS_LOGW("invalid line in kernel tuning log %s: %s", tuningPath.c_str(), line.c_str());
+      continue;
+    }
+    tunedKernels[defaultFid] = tuned;
+  }
+  MS_LOGI("%zu tuned kernels in kernel tuning log %s", tunedKernels.size(), tuningPath.c_str());
+  // the references to the elements of an unordered_map stay valid when it grows
+  return tuningLogs.emplace(tuningPath, std::move(tunedKernels)).first->second;
+}
+
+// the tuned kernel of the convolution if its tiles divide the output, the default kernel otherwise
+static std::string GetTunedConvFid(const std::string &fid, const DLTensor *output, const KernelOption &option) {
+  if (option.tuningPath.empty() || output == nullptr || output->ndim != 4) {
+    return fid;
+  }
+  auto &tunedKernels = GetTunedKernels(option.tuningPath);
+  auto iter = tunedKernels.find(fid);
+  if (iter == tunedKernels.end()) {
+    return fid;
+  }
+  auto &tuned = iter->second;
+  if (output->shape[NCHW_C] % tuned.vc != 0 || output->shape[NCHW_H] % tuned.vh != 0 ||
+      output->shape[NCHW_W] % tuned.vw != 0 || GetFunction(tuned.fid) == nullptr) {
+    MS_LOGD("tuned kernel %s does not fit, use %s", tuned.fid.c_str(), fid.c_str());
+    return fid;
+  }
+  return tuned.fid;
+}
+
 static runnerType GetKernel_Conv(const mindspore::predict::OpDef &opdef, const std::vector<DLTensor *> &tensors,
                                  const KernelOption &option) {
   if (tensors.at(0) == nullptr) {
@@ -505,6 +568,12 @@ static runnerType GetKernel_Conv(const mindspore::predict::OpDef &opdef, const s
     int co = tensors.at(0)->shape[NCHW_C] * op->channelMultiplier();
     arg_const.push_back(co);
   }
+  // in the format of the workload file of at_tune.py
+  MS_LOGD("conv workload: %s %d %d %d %d %d", fid.c_str(), n, ci, h, w, arg_const.back());
+  // the output of the last convolution is still NHWC here, so its tiles can not be checked
+  if (!opdef.isLastConv()) {
+    fid = GetTunedConvFid(fid, tensors.back(), option);
+  }
   auto fun = GetKernel(fid);
   if (fun == nullptr) {
     MS_LOGE("GetKernel return nullptr");
@@ -60,6 +60,7 @@ class TVMOperator : public OpBase {
 
     KernelOption option;
     option.numThreads = ctx.threadNum;
+    option.tuningPath = ctx.kernelTuningPath;
     OpFunc opFunc = GetKernel(opDef, dlT, option);
     if (opFunc != nullptr) {
       auto op = std::unique_ptr<TVMOperator>(new (std::nothrow) TVMOperator(opFunc));
@@ -0,0 +1,283 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "include/batch_session.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include "common/mslog.h"
+#include "include/errorcode.h"
+#include "securec/include/securec.h"
+
+namespace mindspore {
+namespace predict {
+struct BatchSession::Request {
+  const std::vector<Tensor *> *inputs;
+  int64_t batchSize;
+  std::chrono::steady_clock::time_point enqueueTime;
+  std::map<std::string, std::vector<Tensor *>> *outputs;
+  int ret = RET_OK;
+  bool done = false;
+};
+
+namespace {
+void FreeTensors(std::vector<Tensor *> *tensors) {
+  for (auto tensor : *tensors) {
+    delete tensor;
+  }
+  tensors->clear();
+}
+
+void FreeOutputMap(std::map<std::string, std::vector<Tensor *>> *outputs) {
+  for (auto &output : *outputs) {
+    FreeTensors(&output.second);
+  }
+  outputs->clear();
+}
+}  // namespace
+
+std::shared_ptr<BatchSession> CreateBatchSession(const std::shared_ptr<Session> &session, int64_t timeoutUs) {
+  if (session == nullptr) {
+    MS_LOGE("the session is nullptr");
+    return nullptr;
+  }
+  auto batchSession = std::make_shared<BatchSession>(session, timeoutUs);
+  MS_ASSERT(batchSession != nullptr);
+  auto ret = batchSession->Init();
+  if (ret != RET_OK) {
+    MS_LOGE("Init batch session failed.");
+    return nullptr;
+  }
+  return batchSession;
+}
+
+BatchSession::BatchSession(const std::shared_ptr<Session> &session, int64_t timeoutUs)
+    : session(session), timeoutUs(timeoutUs) {}
+
+BatchSession::~BatchSession() {
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stopped = true;
+  }
+  queueCond.notify_all();
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+int BatchSession::Init() {
+  MS_ASSERT(session != nullptr);
+  if (timeoutUs < 0) {
+    MS_LOGE("the timeout %ld is invalid", timeoutUs);
+    return RET_PARAM_INVALID;
+  }
+  auto inputs = session->GetInput();
+  if (inputs.empty()) {
+    MS_LOGE("the session has no input");
+    return RET_ERROR;
+  }
+  for (auto input : inputs) {
+    auto dims = input->GetDims();
+    if (dims.empty() || dims[0] <= 0 || (maxBatchSize != 0 && dims[0] != maxBatchSize)) {
+      MS_LOGE("the inputs of the session have no common batch");
+      FreeTensors(&inputs);
+      return RET_ERROR;
+    }
+    maxBatchSize = dims[0];
+    inputDims.push_back(dims);
+    inputDataTypes.push_back(input->GetDataType());
+  }
+  FreeTensors(&inputs);
+  worker = std::thread(&BatchSession::WorkerLoop, this);
+  return RET_OK;
+}
+
+int BatchSession::CheckInputs(const std::vector<Tensor *> &inputs, int64_t *batchSize) const {
+  MS_ASSERT(batchSize != nullptr);
+  if (inputs.size() != inputDims.size()) {
+    MS_LOGE("input num %zu != model input num %zu", inputs.size(), inputDims.size());
+    return RET_INPUT_TENSOR_ERROR;
+  }
+  *batchSize = 0;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i] == nullptr || inputs[i]->GetData() == nullptr) {
+      MS_LOGE("input tensor data is null!");
+      return RET_INPUT_TENSOR_ERROR;
+    }
+    if (inputs[i]->GetFormat() != Format_NCHW || inputs[i]->GetDataType() != inputDataTypes[i]) {
+      MS_LOGE("input format or datatype of input %zu is different from the model", i);
+      return RET_INPUT_TENSOR_ERROR;
+    }
+    auto dims = inputs[i]->GetDims();
+    if (dims.size() != inputDims[i].size() || dims[0] <= 0 || dims[0] > maxBatchSize ||
+        (*batchSize != 0 && dims[0] != *batchSize)) {
+      MS_LOGE("batch size of input %zu is invalid, the batch of the model is %ld", i, maxBatchSize);
+      return RET_INPUT_TENSOR_ERROR;
+    }
+    for (size_t j = 1; j < dims.size(); j++) {
+      if (dims[j] != inputDims[i][j]) {
+        MS_LOGE("input %zu shape[%zu]: %ld, model shape[%zu]: %ld", i, j, dims[j], j, inputDims[i][j]);
+        return RET_INPUT_TENSOR_ERROR;
+      }
+    }
+    *batchSize = dims[0];
+  }
+  return RET_OK;
+}
+
+int BatchSession::Run(const std::vector<Tensor *> &inputs, std::map<std::string, std::vector<Tensor *>> *outputs) {
+  if (outputs == nullptr) {
+    MS_LOGE("outputs is nullptr");
+    return RET_NULL_PTR;
+  }
+  Request request;
+  auto ret = CheckInputs(inputs, &request.batchSize);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  request.inputs = &inputs;
+  request.outputs = outputs;
+  request.enqueueTime = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> lock(mtx);
+  if (stopped) {
+    MS_LOGE("the batch session is stopped");
+    return RET_ERROR;
+  }
+  requests.push_back(&request);
+  queuedBatchSize += request.batchSize;
+  queueCond.notify_all();
+  doneCond.wait(lock, [&request] { return request.done; });
+  return request.ret;
+}
+
+void BatchSession::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mtx);
+  while (true) {
+    queueCond.wait(lock, [this] { return stopped || !requests.empty(); });
+    if (requests.empty()) {
+      return;
+    }
+    // the first request waits for the others until the batch is full or it times out
+    auto deadline = requests.front()->enqueueTime + std::chrono::microseconds(timeoutUs);
+    (void)queueCond.wait_until(lock, deadline, [this] { return stopped || queuedBatchSize >= maxBatchSize; });
+
+    std::vector<Request *> batch;
+    int64_t batchSize = 0;
+    while (!requests.empty() && batchSize + requests.front()->batchSize <= maxBatchSize) {
+      batchSize += requests.front()->batchSize;
+      batch.push_back(requests.front());
+      requests.pop_front();
+    }
+    queuedBatchSize -= batchSize;
+
+    lock.unlock();
+    auto ret = RunBatch(batch);
+    lock.lock();
+    for (auto request : batch) {
+      request->ret = ret;
+      request->done = true;
+    }
+    doneCond.notify_all();
+  }
+}
+
+int BatchSession::RunBatch(const std::vector<Request *> &batch) {
+  auto inputs = session->GetInput();
+  if (inputs.size() != inputDims.size()) {
+    MS_LOGE("get input of the session failed");
+    FreeTensors(&inputs);
+    return RET_ERROR;
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    size_t dataSize = inputs[i]->GetDataSize();
+    size_t sampleSize = dataSize / maxBatchSize;
+    auto data = static_cast<uint8_t *>(malloc(dataSize));
+    if (data == nullptr) {
+      MS_LOGE("malloc batch input data of %zu bytes failed", dataSize);
+      FreeTensors(&inputs);
+      return RET_ERROR;
+    }
+    // the input tensor owns the batch data, which is freed with it
+    inputs[i]->SetData(data);
+    size_t offset = 0;
+    for (auto request : batch) {
+      size_t size = request->batchSize * sampleSize;
+      auto ret = memcpy_sp(data + offset, dataSize - offset, (*request->inputs)[i]->GetData(), size);
+      if (ret != RET_OK) {
+        MS_LOGE("copy input %zu of the batch failed", i);
+        FreeTensors(&inputs);
+        return RET_ERROR;
+      }
+      offset += size;
+    }
+    if (offset < dataSize) {
+      (void)memset_s(data + offset, dataSize - offset, 0, dataSize - offset);
+    }
+  }
+
+  auto ret = session->Run(inputs);
+  FreeTensors(&inputs);
+  if (ret != RET_OK) {
+    MS_LOGE("run the batch of %zu requests failed: %d", batch.size(), ret);
+    return ret;
+  }
+  auto batchOutputs = session->GetAllOutput();
+  ret = SplitOutputs(batchOutputs, batch);
+  FreeOutputMap(&batchOutputs);
+  return ret;
+}
+
+int BatchSession::SplitOutputs(const std::map<std::string, std::vector<Tensor *>> &batchOutputs,
+                               const std::vector<Request *> &batch) {
+  for (auto request : batch) {
+    request->outputs->clear();
+  }
+  for (auto &batchOutput : batchOutputs) {
+    for (auto tensor : batchOutput.second) {
+      auto dims = tensor->GetDims();
+      if (dims.empty() || dims[0] != maxBatchSize) {
+        MS_LOGE("output of node (%s) has no batch of the model", batchOutput.first.c_str());
+        for (auto request : batch) {
+          FreeOutputMap(request->outputs);
+        }
+        return RET_ERROR;
+      }
+      size_t sampleSize = tensor->GetDataSize() / maxBatchSize;
+      size_t offset = 0;
+      for (auto request : batch) {
+        dims[0] = request->batchSize;
+        std::unique_ptr<Tensor> output(new (std::nothrow) Tensor(tensor->GetDataType(), dims, tensor->GetFormat(),
+                                                                 nullptr));
+        if (output == nullptr || output->MallocData() != RET_OK) {
+          MS_LOGE("malloc output data failed");
+          for (auto req : batch) {
+            FreeOutputMap(req->outputs);
+          }
+          return RET_ERROR;
+        }
+        size_t size = request->batchSize * sampleSize;
+        (void)memcpy_sp(output->GetData(), size, static_cast<uint8_t *>(tensor->GetData()) + offset, size);
+        offset += size;
+        (*request->outputs)[batchOutput.first].push_back(output.release());
+      }
+    }
+  }
+  return RET_OK;
+}
+}  // namespace predict
+}  // namespace mindspore
@@ -18,6 +18,7 @@
 #include <map>
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include "schema/ms_generated.h"
 #include "common/graph_util.h"
@@ -28,8 +29,47 @@
 namespace mindspore {
 namespace predict {
 static const uint32_t G_MAX_OP_COUNT = 10000;
+static const size_t STATIC_MEMORY_ALIGN = 64;
+
+namespace {
+struct TensorLifetime {
+  Tensor *tensor;
+  size_t size;
+  size_t start;  // the step of the node producing the tensor
+  size_t end;    // the step of the last node consuming the tensor
+};
+
+size_t AlignStaticSize(size_t size) {
+  size = std::max(size, static_cast<size_t>(1));
+  return (size + STATIC_MEMORY_ALIGN - 1) / STATIC_MEMORY_ALIGN * STATIC_MEMORY_ALIGN;
+}
 
-Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx) {
+// the weight tensor referring to the data of the shared model instead of a copy
+Tensor *CreateSharedWeight(const TensorDef &tensorDef, void *data) {
+  std::vector<int64_t> dims;
+  if (tensorDef.dims() != nullptr) {
+    for (uint32_t j = 0; j < tensorDef.dims()->size(); j++) {
+      dims.push_back(tensorDef.dims()->data()[j]);
+    }
+  }
+  if (dims.empty()) {
+    dims.push_back(1);
+  }
+  auto tensor = new (std::nothrow) Tensor(tensorDef.dataType(), dims, tensorDef.format(), data);
+  if (tensor == nullptr) {
+    MS_LOGE("new Tensor failed");
+    return nullptr;
+  }
+  tensor->AddRef(MSConst_WEIGHT_REFCOUNT);
+  return tensor;
+}
+
+bool IsLifetimeOverlap(const TensorLifetime &a, const TensorLifetime &b) {
+  return a.start <= b.end && b.start <= a.end;
+}
+}  // namespace
+
+Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx, const Model *model) {
   if (buf == nullptr) {
     MS_LOGE("the input buffer is nullptr");
     return nullptr;
@@ -47,7 +87,7 @@ Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx) {
     MS_LOGE("graph malloc fail");
     return nullptr;
   }
-  auto ret = graph->Build(*graphDef, ctx);
+  auto ret = graph->Build(*graphDef, ctx, model);
   if (ret != RET_OK) {
     MS_LOGE("build graph fail");
     return nullptr;
@@ -58,17 +98,23 @@ Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx) {
 Graph::Graph() = default;
 
 Graph::~Graph() {
+  // the tensors must not free the memory of the arena
+  UnbindStaticMemory();
   for (auto &subgraph : subgraphs) {
     delete subgraph;
   }
   subgraphs.clear();
+  if (staticArena != nullptr) {
+    free(staticArena);
+    staticArena = nullptr;
+  }
 }
 
-int Graph::Build(const GraphDef &graphDef, const Context &ctx) {
+int Graph::Build(const GraphDef &graphDef, const Context &ctx, const Model *model) {
   MS_ASSERT(graphDef.subgraphs() != nullptr);
   for (size_t i = 0; i < graphDef.subgraphs()->size(); i++) {
     MS_ASSERT(graphDef.subgraphs()->GetAs<SubGraphDef>(i) != nullptr);
-    SubGraph *subGraph = SubGraph::CreateSubGraph(*(graphDef.subgraphs()->GetAs<SubGraphDef>(i)), ctx);
+    SubGraph *subGraph = SubGraph::CreateSubGraph(*(graphDef.subgraphs()->GetAs<SubGraphDef>(i)), ctx, model, i);
     if (subGraph == nullptr) {
       MS_LOGE("converter subgraph failed");
       return RET_ERROR;
@@ -114,6 +160,129 @@ void Graph::FreeAllTensors() {
 
 std::vector<SubGraph *> *Graph::Subgraphs() { return &subgraphs; }
 
+int Graph::PlanStaticMemory() {
+  // the nodes are visited in the same order as GraphExecution::Run
+  std::vector<Node *> order;
+  auto remainDepends = depends;
+  auto que = readyQue;
+  while (!que.empty()) {
+    auto *node = que.front();
+    que.pop_front();
+    order.push_back(node);
+    for (auto outNode : node->GetAllOutEdges()) {
+      auto nodeDepend = remainDepends.find(outNode);
+      if (nodeDepend == remainDepends.end()) {
+        continue;
+      }
+      nodeDepend->second.erase(node);
+      if (nodeDepend->second.empty()) {
+        remainDepends.erase(nodeDepend);
+        que.push_back(outNode);
+      }
+    }
+  }
+
+  // the inputs and outputs are handed over to the caller, so they are not in the arena
+  std::unordered_set<Tensor *> excluded;
+  for (auto subgraph : subgraphs) {
+    MS_ASSERT(subgraph != nullptr);
+    for (auto tensor : subgraph->GetInputs()) {
+      excluded.insert(tensor);
+    }
+    for (auto tensor : subgraph->GetOutputs()) {
+      excluded.insert(tensor);
+    }
+    for (auto &output : subgraph->GetOutputsMap()) {
+      excluded.insert(output.second.begin(), output.second.end());
+    }
+  }
+
+  std::unordered_map<Tensor *, size_t> lifetimeIndex;
+  std::vector<TensorLifetime> lifetimes;
+  std::unordered_set<Tensor *> kept;
+  for (size_t step = 0; step < order.size(); step++) {
+    auto *node = order[step];
+    for (auto tensor : node->GetOutputTensors()) {
+      if (tensor == nullptr || tensor->RefCount() == MSConst_WEIGHT_REFCOUNT || tensor->GetData() != nullptr ||
+          lifetimeIndex.count(tensor) > 0) {
+        continue;
+      }
+      if (excluded.count(tensor) > 0) {
+        if (kept.insert(tensor).second) {
+          staticKeptTensors.push_back(tensor);
+        }
+        continue;
+      }
+      lifetimeIndex[tensor] = lifetimes.size();
+      lifetimes.push_back({tensor, AlignStaticSize(tensor->GetDataSize()), step, step});
+    }
+    for (auto tensor : node->GetInputTensors()) {
+      auto iter = lifetimeIndex.find(tensor);
+      if (iter != lifetimeIndex.end()) {
+        lifetimes[iter->second].end = step;
+      }
+    }
+  }
+
+  // place the larger tensors first, each at the lowest offset free during its lifetime
+  std::vector<size_t> sorted(lifetimes.size());
+  std::iota(sorted.begin(), sorted.end(), 0);
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [&lifetimes](size_t a, size_t b) { return lifetimes[a].size > lifetimes[b].size; });
+  std::vector<size_t> offsets(lifetimes.size(), 0);
+  std::vector<size_t> placed;
+  size_t arenaSize = 0;
+  size_t totalSize = 0;
+  for (auto i : sorted) {
+    std::vector<std::pair<size_t, size_t>> busy;
+    for (auto j : placed) {
+      if (IsLifetimeOverlap(lifetimes[i], lifetimes[j])) {
+        busy.emplace_back(offsets[j], offsets[j] + lifetimes[j].size);
+      }
+    }
+    std::sort(busy.begin(), busy.end());
+    size_t offset = 0;
+    for (auto &range : busy) {
+      if (range.first >= offset + lifetimes[i].size) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    offsets[i] = offset;
+    placed.push_back(i);
+    arenaSize = std::max(arenaSize, offset + lifetimes[i].size);
+    totalSize += lifetimes[i].size;
+  }
+
+  if (arenaSize > 0) {
+    staticArena = static_cast<char *>(malloc(arenaSize));
+    if (staticArena == nullptr) {
+      MS_LOGE("malloc static memory arena of %zu bytes failed", arenaSize);
+      staticKeptTensors.clear();
+      return RET_ERROR;
+    }
+  }
+  for (size_t i = 0; i < lifetimes.size(); i++) {
+    staticOffsets.emplace_back(lifetimes[i].tensor, offsets[i]);
+  }
+  hasStaticPlan = true;
+  MS_LOGI("static memory plan: %zu tensors of %zu bytes in an arena of %zu bytes", lifetimes.size(), totalSize,
+          arenaSize);
+  return RET_OK;
+}
+
+void Graph::BindStaticMemory() {
+  for (auto &item : staticOffsets) {
+    item.first->SetData(staticArena + item.second);
+  }
+}
+
+void Graph::UnbindStaticMemory() {
+  for (auto &item : staticOffsets) {
+    item.first->SetData(nullptr);
+  }
+}
+
 SubGraph::SubGraph() = default;
 
 SubGraph::~SubGraph() {
@@ -125,6 +294,12 @@ SubGraph::~SubGraph() {
   }
   nodes.clear();
 
+  // the data of the shared weights is owned by the model
+  for (auto &weight : sharedWeights) {
+    weight->SetData(nullptr);
+  }
+  sharedWeights.clear();
+
   for (auto &allTensor : allTensors) {
     if (allTensor != nullptr) {
       delete allTensor;
@@ -133,14 +308,15 @@ SubGraph::~SubGraph() {
   allTensors.clear();
 }
 
-SubGraph *SubGraph::CreateSubGraph(const SubGraphDef &subGraphDef, const Context &ctx) {
+SubGraph *SubGraph::CreateSubGraph(const SubGraphDef &subGraphDef, const Context &ctx, const Model *model,
+                                   size_t subGraphIndex) {
   std::unique_ptr<SubGraph> subGraph(new (std::nothrow) SubGraph());
   if (subGraph == nullptr) {
     MS_LOGE("subGraph malloc fail");
     return nullptr;
   }
 
-  auto ret = subGraph->Build(subGraphDef, ctx);
+  auto ret = subGraph->Build(subGraphDef, ctx, model, subGraphIndex);
   if (ret != RET_OK) {
     MS_LOGE("subGraph Build fail");
     return nullptr;
@@ -149,7 +325,7 @@ SubGraph *SubGraph::CreateSubGraph(const SubGraphDef &subGraphDef, const Context
   return subGraph.release();
 }
 
-int SubGraph::Build(const SubGraphDef &subGraphDef, const Context &ctx) {
+int SubGraph::Build(const SubGraphDef &subGraphDef, const Context &ctx, const Model *model, size_t subGraphIndex) {
   int ret;
   MS_ASSERT(subGraphDef.inputIndex() != nullptr);
   ret = ConverterIndex(*(subGraphDef.inputIndex()), &inputIndices);
@@ -167,7 +343,7 @@ int SubGraph::Build(const SubGraphDef &subGraphDef, const Context &ctx) {
   }
   MS_LOGD("converter outputIndex succ");
   MS_ASSERT(subGraphDef.allTensors() != nullptr);
-  ret = ConverterAllTensor(*(subGraphDef.allTensors()));
+  ret = ConverterAllTensor(*(subGraphDef.allTensors()), model, subGraphIndex);
   if (ret != RET_OK) {
     MS_LOGE("ConverterAllTensor failed: %d", ret);
     return ret;
@@ -209,7 +385,8 @@ int SubGraph::ConverterIndex(const flatbuffers::Vector<uint32_t> &srcIndex, std:
   return RET_OK;
 }
 
-int SubGraph::ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<TensorDef>> &srcTensors) {
+int SubGraph::ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<TensorDef>> &srcTensors,
+                                 const Model *model, size_t subGraphIndex) {
   uint32_t tensorsSize = srcTensors.size();
 
   allTensors.clear();
@@ -220,6 +397,16 @@ int SubGraph::ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<T
       MS_LOGE("%ud th tensordef is null", i);
       return RET_ERROR;
     }
+    void *sharedData = model == nullptr ? nullptr : model->GetWeightData(subGraphIndex, i);
+    if (sharedData != nullptr) {
+      auto tensor = CreateSharedWeight(*tensorDef, sharedData);
+      if (tensor == nullptr) {
+        return RET_ERROR;
+      }
+      allTensors.push_back(tensor);
+      sharedWeights.push_back(tensor);
+      continue;
+    }
     auto tensor = Tensor::CopyFromTensorDef(*tensorDef);
     if (tensor == nullptr) {
       return RET_ERROR;
@@ -22,11 +22,13 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 #include "common/utils.h"
 #include "common/graph_util.h"
 #include "include/tensor.h"
 #include "src/node.h"
+#include "src/model.h"
 
 #define MSPREDICT_API __attribute__((visibility("default")))
 
@@ -36,8 +38,10 @@ class SubGraph {
  public:
   SubGraph();
   ~SubGraph();
-  static SubGraph *CreateSubGraph(const SubGraphDef &subGraphDef, const Context &ctx);
-  int Build(const SubGraphDef &subGraphDef, const Context &ctx);
+  static SubGraph *CreateSubGraph(const SubGraphDef &subGraphDef, const Context &ctx, const Model *model = nullptr,
+                                  size_t subGraphIndex = 0);
+  int Build(const SubGraphDef &subGraphDef, const Context &ctx, const Model *model = nullptr,
+            size_t subGraphIndex = 0);
   bool IsInputIndex(uint32_t i);
   bool IsOutputIndex(uint32_t i);
 
@@ -56,7 +60,8 @@ class SubGraph {
  private:
   int ConverterIndex(const flatbuffers::Vector<uint32_t> &srcIndex, std::vector<uint32_t> *dstIndex);
 
-  int ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<TensorDef>> &srcTensors);
+  int ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<TensorDef>> &srcTensors, const Model *model,
+                         size_t subGraphIndex);
 
   int ConverterNodes(const flatbuffers::Vector<flatbuffers::Offset<NodeDef>> &opDefs, const Context &ctx);
 
@@ -69,6 +74,7 @@ class SubGraph {
   std::vector<uint32_t> inputIndices;
   std::vector<uint32_t> outputIndices;
   std::vector<Tensor *> allTensors;  // weight + input + output
+  std::vector<Tensor *> sharedWeights;  // the weights referring to the data of the shared model
   std::map<NODE_ID, std::vector<Tensor *>> outputsMap;
 };
 
@@ -76,7 +82,8 @@ class MSPREDICT_API Graph {
  public:
   Graph();
   ~Graph();
-  static Graph *CreateFromBuf(const char *buf, size_t size, const Context &ctx);
+  // the weights refer to the data of 'model' if it is given, which must outlive the graph
+  static Graph *CreateFromBuf(const char *buf, size_t size, const Context &ctx, const Model *model = nullptr);
 
   std::vector<Tensor *> GetInputs();
   std::vector<Tensor *> GetOutputs();
@@ -85,15 +92,30 @@ class MSPREDICT_API Graph {
 
   void FreeAllTensors();
 
-  int Build(const GraphDef &def, const Context &ctx);
+  int Build(const GraphDef &def, const Context &ctx, const Model *model = nullptr);
   std::vector<SubGraph *> *Subgraphs();
 
+  // Plan the intermediate tensors into one arena by their lifetimes in the execution order, so a run binds them to
+  // fixed offsets instead of allocating and freeing them node by node. The inputs, the outputs and the weights keep
+  // their own memory. Return RET_OK if the arena is allocated.
+  int PlanStaticMemory();
+  bool HasStaticMemoryPlan() const { return hasStaticPlan; }
+  void BindStaticMemory();
+  void UnbindStaticMemory();
+  // the outputs of the nodes which are not in the plan, allocated before a run
+  const std::vector<Tensor *> &GetStaticKeptTensors() const { return staticKeptTensors; }
+
  protected:
   friend class GraphExecution;
 
   std::vector<SubGraph *> subgraphs;
   std::unordered_map<Node *, std::unordered_set<Node *>> depends;  // records the dependencies
   std::deque<Node *> readyQue;  // the nodes which can execute without any dependencies
+
+  bool hasStaticPlan = false;
+  char *staticArena = nullptr;
+  std::vector<std::pair<Tensor *, size_t>> staticOffsets;  // the planned tensors and their offsets in the arena
+  std::vector<Tensor *> staticKeptTensors;
 };
 }  // namespace predict
 }  // namespace mindspore
@@ -15,9 +15,11 @@
  */
 
 #include "src/graph_execution.h"
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include <memory>
+#include "common/utils.h"
 
 namespace mindspore {
 namespace predict {
@@ -51,6 +53,27 @@ int GraphExecution::TransInputDataToNc4hw4(const Tensor &src, Tensor *dst) {
   return RET_OK;
 }
 
+int GraphExecution::TransInputDataToFloat16(const Tensor &src, Tensor *dst) {
+  MS_ASSERT(dst != nullptr);
+  if (dst->GetFormat() != Format_NCHW) {
+    MS_LOGE("float16 input format not support. only nchw is supported now");
+    return RET_ERROR;
+  }
+  if (dst->GetData() == nullptr) {
+    auto ret = dst->MallocData(nullptr, MSConst_WEIGHT_REFCOUNT);
+    if (ret != RET_OK) {
+      MS_LOGE("Malloc inputTensors failed: %d", ret);
+      return ret;
+    }
+  }
+  auto ret = FloatToFloat16(&src, dst);
+  if (ret != RET_OK) {
+    MS_LOGE("FloatToFloat16 failed");
+    return ret;
+  }
+  return RET_OK;
+}
+
 int GraphExecution::SetInputTensors(const std::vector<Tensor *> &inputs) {
   size_t num = inputs.size();
   if (num != inputTensors.size()) {
@@ -75,7 +98,9 @@ int GraphExecution::SetInputTensors(const std::vector<Tensor *> &inputs) {
       return RET_INPUT_TENSOR_ERROR;
     }
 
-    if (inputs[i]->GetDataType() != inputTensors[i]->GetDataType()) {
+    // the inputs of a float16 model are float, see GetInput
+    bool toFloat16 = inputTensors[i]->GetDataType() == DataType_DT_FLOAT16;
+    if (inputs[i]->GetDataType() != (toFloat16 ? DataType_DT_FLOAT : inputTensors[i]->GetDataType())) {
       MS_LOGE("tensor datatype in graph and executor are different!");
       return RET_INPUT_TENSOR_ERROR;
     }
@@ -85,7 +110,13 @@ int GraphExecution::SetInputTensors(const std::vector<Tensor *> &inputs) {
       return RET_INPUT_TENSOR_ERROR;
     }
 
-    if (inputs[i]->GetFormat() == inputTensors[i]->GetFormat()) {
+    if (toFloat16) {
+      auto ret = TransInputDataToFloat16(*inputs[i], inputTensors[i]);
+      if (ret != RET_OK) {
+        MS_LOGE("TransInputDataToFloat16 failed");
+        return ret;
+      }
+    } else if (inputs[i]->GetFormat() == inputTensors[i]->GetFormat()) {
       auto data = inputs[i]->GetData();
       if (data == nullptr) {
         MS_LOGE("data of input tensor is null!");
@@ -106,7 +137,28 @@ int GraphExecution::SetInputTensors(const std::vector<Tensor *> &inputs) {
   return RET_OK;
 }
 
+void GraphExecution::BindOutputData() {
+  for (auto &bound : boundOutputs) {
+    auto &refOutputs = graph->GetOutputsMap().at(bound.first);
+    for (size_t i = 0; i < refOutputs.size() && i < bound.second.size(); i++) {
+      refOutputs[i]->SetData(bound.second[i]->GetData());
+      // the buffer of the caller is never freed by the nodes consuming the output
+      refOutputs[i]->AddRef(MSConst_WEIGHT_REFCOUNT - refOutputs[i]->RefCount());
+    }
+  }
+}
+
+void GraphExecution::UnbindOutputData() {
+  for (auto &bound : boundOutputs) {
+    for (auto tensor : graph->GetOutputsMap().at(bound.first)) {
+      tensor->SetData(nullptr);
+      tensor->DefRef(tensor->RefCount());
+    }
+  }
+}
+
 int GraphExecution::MallocOutput() {
+  BindOutputData();
   for (auto tensor : outputTensors) {
     auto ret = tensor->MallocData();
     if (ret != RET_OK) {
@@ -114,6 +166,16 @@ int GraphExecution::MallocOutput() {
       return RET_ERROR;
     }
   }
+  if (graph->HasStaticMemoryPlan()) {
+    // the nodes do not allocate their outputs with the static memory plan
+    for (auto tensor : graph->GetStaticKeptTensors()) {
+      auto ret = tensor->MallocData();
+      if (ret != RET_OK) {
+        MS_LOGE("malloc output data failed");
+        return RET_ERROR;
+      }
+    }
+  }
   return RET_OK;
 }
 
@@ -147,7 +209,24 @@ int GraphExecution::CopyOutputTensors(const std::vector<Tensor *> &refOutputs, s
       return RET_ERROR;
     }
 
-    if (tensor->GetFormat() == Format_NC4HW4) {
+    if (tensor->GetDataType() == DataType_DT_FLOAT16) {
+      // the outputs of a float16 model are float
+      t->SetDataType(DataType_DT_FLOAT);
+      auto ret = t->MallocData();
+      if (ret != RET_OK) {
+        MS_LOGE("malloc data failed.")
+        FreeTensors(outputs);
+        return ret;
+      }
+
+      ret = Float16ToFloat(tensor, t.get());
+      if (ret != RET_OK) {
+        MS_LOGE("Float16ToFloat failed");
+        FreeTensors(outputs);
+        return ret;
+      }
+      tensor->FreeData();
+    } else if (tensor->GetFormat() == Format_NC4HW4) {
       t->SetFormat(Format_NCHW);
       auto ret = t->MallocData();
       if (ret != RET_OK) {
@@ -174,6 +253,9 @@ int GraphExecution::CopyOutputTensors(const std::vector<Tensor *> &refOutputs, s
 std::map<NODE_ID, std::vector<Tensor *>> GraphExecution::GetAllOutput() {
   std::map<NODE_ID, std::vector<Tensor *>> outputs{};
   for (auto &outputNode : graph->GetOutputsMap()) {
+    if (boundOutputs.count(outputNode.first) > 0) {
+      continue;
+    }
     std::vector<Tensor *> outputNodeTensors{};
     auto ret = this->CopyOutputTensors(outputNode.second, &outputNodeTensors);
     if (ret != RET_OK) {
@@ -193,6 +275,10 @@ std::vector<Tensor *> GraphExecution::GetOutput(const NODE_ID &nodeName) {
     MS_LOGE("node name is not in output.");
     return outputNodeTensors;
   }
+  if (boundOutputs.count(nodeName) > 0) {
+    MS_LOGI("the output of node (%s) is bound to the buffers of the caller.", nodeName.c_str());
+    return outputNodeTensors;
+  }
   auto ret = this->CopyOutputTensors(iter->second, &outputNodeTensors);
   if (ret != RET_OK) {
     MS_LOGE("copy output failed.");
@@ -207,7 +293,8 @@ std::vector<Tensor *> GraphExecution::GetInput() {
       MS_LOGE("tensor from graph->GetInputs() is nullptr");
       return inputs;
     }
-    std::unique_ptr<Tensor> t(new Tensor(refInput->GetDataType(), refInput->GetDims(), Format_NCHW, nullptr));
+    auto dataType = refInput->GetDataType() == DataType_DT_FLOAT16 ? DataType_DT_FLOAT : refInput->GetDataType();
+    std::unique_ptr<Tensor> t(new Tensor(dataType, refInput->GetDims(), Format_NCHW, nullptr));
     if (t == nullptr) {
       MS_LOGE("new Tensor failed.")
       FreeTensors(&inputs);
@@ -224,7 +311,7 @@ void GraphExecution::ResetInputData() {
       MS_LOGW("tensor in inputTensors is nullptr");
       continue;
     }
-    if (tensor->GetFormat() == Format_NC4HW4) {
+    if (tensor->GetFormat() == Format_NC4HW4 || tensor->GetDataType() == DataType_DT_FLOAT16) {
       if (tensor->GetData() != nullptr) {
         free(tensor->GetData());
         tensor->SetData(nullptr);
@@ -237,6 +324,26 @@ void GraphExecution::ResetInputData() {
 
 void GraphExecution::FreeAllTensors() { graph->FreeAllTensors(); }
 
+void GraphExecution::AddNodeProfile(Node *node, uint64_t timeUs, size_t *profileIdx) {
+  MS_ASSERT(nodeProfiles != nullptr && profileIdx != nullptr);
+  // the nodes run in the same order every time, so the profile of a node is mostly the next one
+  auto idx = *profileIdx;
+  if (idx >= nodeProfiles->size() || (*nodeProfiles)[idx].name != node->ID()) {
+    auto iter = std::find_if(nodeProfiles->begin(), nodeProfiles->end(),
+                             [node](const NodeProfile &profile) { return profile.name == node->ID(); });
+    idx = static_cast<size_t>(iter - nodeProfiles->begin());
+    if (iter == nodeProfiles->end()) {
+      NodeProfile profile;
+      profile.name = node->ID();
+      profile.type = node->Type();
+      nodeProfiles->push_back(profile);
+    }
+  }
+  (*nodeProfiles)[idx].runCount++;
+  (*nodeProfiles)[idx].totalTimeUs += timeUs;
+  *profileIdx = idx + 1;
+}
+
 int GraphExecution::Run(const std::vector<Tensor *> &inputs) {
   if (inputs.empty()) {
     MS_LOGE("input is empty");
@@ -260,17 +367,31 @@ int GraphExecution::Run(const std::vector<Tensor *> &inputs) {
   if (ret != RET_OK) {
     MS_LOGE("MallocOutput failed: %d", ret);
     ResetInputData();
+    UnbindOutputData();
     return ret;
   }
 
+  bool staticMemory = graph->HasStaticMemoryPlan();
+  if (staticMemory) {
+    graph->BindStaticMemory();
+  }
+  size_t profileIdx = 0;
   while (!readyQue.empty()) {
     auto *node = readyQue.front();
     readyQue.pop_front();
 
-    ret = node->Run(_ctx);
+    uint64_t start = nodeProfiles != nullptr ? GetTimeUs() : 0;
+    ret = staticMemory ? node->Execute() : node->Run(_ctx);
+    if (nodeProfiles != nullptr) {
+      AddNodeProfile(node, GetTimeUs() - start, &profileIdx);
+    }
     if (ret != RET_OK) {
       MS_LOGE("node (%s) failed to run op (%s). error code:%d", node->ID().c_str(), node->Type().c_str(), ret);
       ResetInputData();
+      if (staticMemory) {
+        graph->UnbindStaticMemory();
+      }
+      UnbindOutputData();
       FreeAllTensors();
       return ret;
     }
@@ -286,6 +407,10 @@ int GraphExecution::Run(const std::vector<Tensor *> &inputs) {
   }
 
   ResetInputData();
+  if (staticMemory) {
+    graph->UnbindStaticMemory();
+  }
+  UnbindOutputData();
 
   return RET_OK;
 }
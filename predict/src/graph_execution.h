@@ -27,6 +27,7 @@
 #include "common/mslog.h"
 #include "src/graph.h"
 #include "include/errorcode.h"
+#include "include/session.h"
 #include "schema/inner/ms_generated.h"
 #include "src/operator/cpu/include/op_func_comm.h"
 #include "src/node.h"
@@ -47,14 +48,24 @@ class GraphExecution {
   virtual std::map<NODE_ID, std::vector<Tensor *>> GetAllOutput();
   virtual std::vector<Tensor *> GetOutput(const NODE_ID &nodeName);
 
+  // the time of every node is added to the profiles while they are set
+  void SetNodeProfiles(std::vector<NodeProfile> *profiles) { nodeProfiles = profiles; }
+
+  // the bound outputs are written to the buffers of the caller instead of the ones allocated by the runtime
+  void SetBoundOutputs(const std::map<NODE_ID, std::vector<Tensor *>> &outputs) { boundOutputs = outputs; }
+
  private:
   void ResetInputData();
   int MallocOutput();
+  void BindOutputData();
+  void UnbindOutputData();
   void FreeTensors(std::vector<Tensor *> *tensors);
   int TransInputDataToNc4hw4(const Tensor &src, Tensor *dst);
+  int TransInputDataToFloat16(const Tensor &src, Tensor *dst);
   int CopyOutputTensors(const std::vector<Tensor *> &refOutputs, std::vector<Tensor *> *outputs);
   void FreeOutputMap(std::map<NODE_ID, std::vector<Tensor *>> *map);
   void FreeAllTensors();
+  void AddNodeProfile(Node *node, uint64_t timeUs, size_t *profileIdx);
 
  protected:
   Graph *graph;
@@ -63,6 +74,8 @@ class GraphExecution {
   std::vector<Tensor *> outputTensors;
   std::unordered_map<Node *, std::unordered_set<Node *>> depends;  // records the dependencies
   std::deque<Node *> readyQue;  // the nodes which can execute without any dependencies
+  std::vector<NodeProfile> *nodeProfiles = nullptr;
+  std::map<NODE_ID, std::vector<Tensor *>> boundOutputs;
 };
 }  // namespace predict
 }  // namespace mindspore
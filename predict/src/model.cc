@@ -0,0 +1,204 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/model.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstdlib>
+#include "common/mslog.h"
+#include "include/errorcode.h"
+#include "include/tensor.h"
+#include "securec/include/securec.h"
+
+namespace mindspore {
+namespace predict {
+std::shared_ptr<Model> Model::Create(const char *graphBuf, size_t size) {
+  if (graphBuf == nullptr) {
+    MS_LOGE("the graphBuf is nullptr");
+    return nullptr;
+  }
+  std::shared_ptr<Model> model(new (std::nothrow) Model());
+  if (model == nullptr) {
+    MS_LOGE("new Model failed");
+    return nullptr;
+  }
+  auto ret = model->Init(graphBuf, size);
+  if (ret != RET_OK) {
+    MS_LOGE("Init model failed: %d", ret);
+    return nullptr;
+  }
+  return model;
+}
+
+std::shared_ptr<Model> Model::CreateFromFile(const char *modelPath) {
+  if (modelPath == nullptr) {
+    MS_LOGE("the modelPath is nullptr");
+    return nullptr;
+  }
+  std::shared_ptr<Model> model(new (std::nothrow) Model());
+  if (model == nullptr) {
+    MS_LOGE("new Model failed");
+    return nullptr;
+  }
+  auto ret = model->InitFromFile(modelPath);
+  if (ret != RET_OK) {
+    MS_LOGE("Init model from %s failed: %d", modelPath, ret);
+    return nullptr;
+  }
+  return model;
+}
+
+Model::~Model() {
+  for (auto data : ownedData) {
+    free(data);
+  }
+  ownedData.clear();
+  if (buf != nullptr) {
+    if (isMapped) {
+      (void)munmap(buf, size);
+    } else {
+      free(buf);
+    }
+    buf = nullptr;
+  }
+}
+
+int Model::Init(const char *graphBuf, size_t size) {
+  flatbuffers::Verifier verify((const uint8_t *)graphBuf, size);
+  if (!VerifyGraphDefBuffer(verify)) {
+    MS_LOGE("the buffer is invalid and fail to create model");
+    return RET_ERROR;
+  }
+  // the copy is owned by the model, so the caller can free the graph buffer
+  buf = static_cast<char *>(malloc(size));
+  if (buf == nullptr) {
+    MS_LOGE("malloc model buffer of %zu bytes failed", size);
+    return RET_ERROR;
+  }
+  auto ret = memcpy_sp(buf, size, graphBuf, size);
+  if (ret != RET_OK) {
+    MS_LOGE("copy model buffer failed");
+    return RET_ERROR;
+  }
+  this->size = size;
+  return InitWeights();
+}
+
+int Model::InitFromFile(const char *modelPath) {
+  int fd = open(modelPath, O_RDONLY);
+  if (fd < 0) {
+    MS_LOGE("open model file %s failed", modelPath);
+    return RET_ERROR;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+    MS_LOGE("the model file %s is empty or can not be stat", modelPath);
+    (void)close(fd);
+    return RET_ERROR;
+  }
+  auto fileSize = static_cast<size_t>(fileStat.st_size);
+  // the pages are loaded on demand and shared with the page cache, the weights are read-only
+  void *mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (mapped == MAP_FAILED) {
+    MS_LOGE("mmap model file %s failed", modelPath);
+    return RET_ERROR;
+  }
+  buf = static_cast<char *>(mapped);
+  size = fileSize;
+  isMapped = true;
+
+  flatbuffers::Verifier verify((const uint8_t *)buf, size);
+  if (!VerifyGraphDefBuffer(verify)) {
+    MS_LOGE("the model file %s is invalid and fail to create model", modelPath);
+    return RET_ERROR;
+  }
+  return InitWeights();
+}
+
+int Model::InitWeights() {
+  auto graphDef = GetGraphDef(buf);
+  MS_ASSERT(graphDef->subgraphs() != nullptr);
+  for (size_t i = 0; i < graphDef->subgraphs()->size(); i++) {
+    auto subGraphDef = graphDef->subgraphs()->GetAs<SubGraphDef>(i);
+    MS_ASSERT(subGraphDef != nullptr && subGraphDef->allTensors() != nullptr);
+    std::vector<void *> subGraphWeights;
+    for (size_t j = 0; j < subGraphDef->allTensors()->size(); j++) {
+      auto tensorDef = subGraphDef->allTensors()->GetAs<TensorDef>(j);
+      MS_ASSERT(tensorDef != nullptr);
+      void *data = nullptr;
+      if (tensorDef->refCount() == MSConst_WEIGHT_REFCOUNT && tensorDef->data() != nullptr &&
+          tensorDef->data()->size() > 0) {
+        data = GetTensorData(*tensorDef);
+        if (data == nullptr) {
+          MS_LOGE("get the data of weight %zu in subgraph %zu failed", j, i);
+          return RET_ERROR;
+        }
+      }
+      subGraphWeights.push_back(data);
+    }
+    weightData.push_back(subGraphWeights);
+  }
+  if (!ownedData.empty()) {
+    MS_LOGI("%zu weights are not aligned in the model and copied", ownedData.size());
+  }
+  return RET_OK;
+}
+
+void *Model::GetTensorData(const TensorDef &tensorDef) {
+  std::vector<int64_t> dims;
+  if (tensorDef.dims() != nullptr) {
+    for (uint32_t i = 0; i < tensorDef.dims()->size(); i++) {
+      dims.push_back(tensorDef.dims()->data()[i]);
+    }
+  }
+  if (dims.empty()) {
+    dims.push_back(1);
+  }
+  Tensor tensor(tensorDef.dataType(), dims, tensorDef.format(), nullptr);
+  size_t dataSize = tensor.GetDataSize();
+  auto tensorData = tensorDef.data()->data();
+  size_t align = (tensor.GetTensorDtype().bits + 7) / 8;
+  // the data in the buffer is referred to directly if it is aligned to its element and complete
+  if (tensorDef.data()->size() >= dataSize && (align == 0 || reinterpret_cast<uintptr_t>(tensorData) % align == 0)) {
+    return const_cast<uint8_t *>(tensorData);
+  }
+  auto data = malloc(dataSize);
+  if (data == nullptr) {
+    MS_LOGE("malloc weight data of %zu bytes failed", dataSize);
+    return nullptr;
+  }
+  ownedData.push_back(data);
+  (void)memset_s(data, dataSize, 0, dataSize);
+  auto ret = memcpy_sp(data, dataSize, tensorData, tensorDef.data()->size());
+  if (ret != RET_OK) {
+    MS_LOGE("copy data fail,dst size %zu, src size %u", dataSize, tensorDef.data()->size());
+    return nullptr;
+  }
+  return data;
+}
+
+void *Model::GetWeightData(size_t subGraphIndex, size_t tensorIndex) const {
+  if (subGraphIndex >= weightData.size() || tensorIndex >= weightData[subGraphIndex].size()) {
+    return nullptr;
+  }
+  return weightData[subGraphIndex][tensorIndex];
+}
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICT_SRC_MODEL_H_
+#define PREDICT_SRC_MODEL_H_
+
+#include <memory>
+#include <vector>
+#include "schema/inner/ms_generated.h"
+
+namespace mindspore {
+namespace predict {
+// The model shared by the sessions created from it. It owns a copy of the graph buffer and the data of the weights,
+// which are immutable and referred to by the weight tensors of all the sessions, so each session only allocates its
+// activations and workspaces.
+class Model {
+ public:
+  ~Model();
+  static std::shared_ptr<Model> Create(const char *graphBuf, size_t size);
+  // map the model file read-only instead of reading it, the weights refer to the mapped pages
+  static std::shared_ptr<Model> CreateFromFile(const char *modelPath);
+
+  const char *GetBuffer() const { return buf; }
+  size_t GetSize() const { return size; }
+  // the data of the weight tensor 'tensorIndex' in the subgraph 'subGraphIndex', nullptr if it is not a weight
+  void *GetWeightData(size_t subGraphIndex, size_t tensorIndex) const;
+
+ private:
+  Model() = default;
+  int Init(const char *graphBuf, size_t size);
+  int InitFromFile(const char *modelPath);
+  int InitWeights();
+  void *GetTensorData(const TensorDef &tensorDef);
+
+  char *buf = nullptr;
+  size_t size = 0;
+  bool isMapped = false;
+  std::vector<std::vector<void *>> weightData;
+  std::vector<void *> ownedData;  // the copies of the weights which can not be referred to in the buffer
+};
+}  // namespace predict
+}  // namespace mindspore
+
+#endif  // PREDICT_SRC_MODEL_H_
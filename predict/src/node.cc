@@ -118,6 +118,15 @@ int Node::Run(const Context &ctx) {
   return RET_OK;
 }
 
+int Node::Execute() {
+  MS_LOGD("%s execute start", id.c_str());
+  if (op == nullptr) {
+    MS_LOGE("op is nullptr.");
+    return RET_ERROR;
+  }
+  return op->Execute(inputs, outputs);
+}
+
 int Node::MallocOutput(const Context &ctx) {
   size_t refCount = outEdges.size();
   for (auto tensor : outputs) {
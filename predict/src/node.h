@@ -48,6 +48,8 @@ class Node {
 
   int InitOp(const OpDef &opDef, const Context &ctx);
   int Run(const Context &ctx);
+  // run the op only, the outputs are allocated by the static memory plan of the graph
+  int Execute();
   int MallocOutput(const Context &ctx);
   void FreeInput();
 
@@ -418,5 +418,117 @@ int Nc4hw4ToNchw(const Tensor *input, Tensor *output) {
 
   return RET_OK;
 }
+
+namespace {
+constexpr uint32_t kFloatSignMask = 0x80000000;
+constexpr uint32_t kFloatInfBits = 0x7F800000;
+// the float bits of the half max (65520 rounds to inf), the half min normal 2^-14 and the half of the half min
+// subnormal 2^-25, below which the half is zero
+constexpr uint32_t kHalfOverflowBits = 0x477FF000;
+constexpr uint32_t kHalfMinNormalBits = 0x38800000;
+constexpr uint32_t kHalfUnderflowBits = 0x33000000;
+constexpr uint32_t kFloatMantissaBits = 23;
+constexpr uint32_t kHalfMantissaShift = 13;
+constexpr uint32_t kExpBiasDiffBits = 0x38000000;
+
+// round to nearest even, as the float16 conversions of the hardware do
+uint16_t FloatBitsToHalf(uint32_t bits) {
+  auto sign = static_cast<uint16_t>((bits & kFloatSignMask) >> 16);
+  uint32_t absBits = bits & ~kFloatSignMask;
+  if (absBits > kFloatInfBits) {
+    return static_cast<uint16_t>(sign | 0x7E00);
+  }
+  if (absBits >= kHalfOverflowBits) {
+    return static_cast<uint16_t>(sign | 0x7C00);
+  }
+  if (absBits < kHalfUnderflowBits) {
+    return sign;
+  }
+  uint32_t mantissa;
+  uint32_t shift;
+  if (absBits < kHalfMinNormalBits) {
+    // subnormal half, the implicit bit of the float is shifted into the mantissa
+    mantissa = (absBits & 0x7FFFFF) | 0x800000;
+    shift = kHalfMantissaShift + 113 - (absBits >> kFloatMantissaBits);
+  } else {
+    mantissa = absBits - kExpBiasDiffBits;
+    shift = kHalfMantissaShift;
+  }
+  uint32_t half = mantissa >> shift;
+  uint32_t rest = mantissa & ((1u << shift) - 1);
+  uint32_t halfway = 1u << (shift - 1);
+  if (rest > halfway || (rest == halfway && (half & 1) != 0)) {
+    // a carry into the exponent is still the right half
+    half++;
+  }
+  return static_cast<uint16_t>(sign | half);
+}
+
+uint32_t HalfToFloatBits(uint16_t half) {
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  uint32_t exp = (half >> 10) & 0x1F;
+  uint32_t mantissa = half & 0x3FF;
+  if (exp == 0x1F) {
+    return sign | kFloatInfBits | (mantissa << kHalfMantissaShift);
+  }
+  if (exp == 0) {
+    if (mantissa == 0) {
+      return sign;
+    }
+    // normalize the subnormal half
+    exp = 113;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      exp--;
+    }
+    return sign | (exp << kFloatMantissaBits) | ((mantissa & 0x3FF) << kHalfMantissaShift);
+  }
+  return sign | (((half & 0x7FFF) << kHalfMantissaShift) + kExpBiasDiffBits);
+}
+
+int CheckCastTensors(const Tensor *input, const Tensor *output, DataType srcType, DataType dstType) {
+  if (input == nullptr || output == nullptr || input->GetData() == nullptr || output->GetData() == nullptr) {
+    MS_LOGE("input or output is nullptr");
+    return RET_NULL_PTR;
+  }
+  if (input->GetDataType() != srcType || output->GetDataType() != dstType) {
+    MS_LOGE("Unsupported dataType: %d to %d", input->GetDataType(), output->GetDataType());
+    return RET_ERROR;
+  }
+  if (input->GetFormat() != output->GetFormat() || input->GetElementSize() != output->GetElementSize()) {
+    MS_LOGE("the format or the shape of input and output are different");
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+}  // namespace
+
+int FloatToFloat16(const Tensor *input, Tensor *output) {
+  auto ret = CheckCastTensors(input, output, DataType_DT_FLOAT, DataType_DT_FLOAT16);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  auto src = static_cast<const uint32_t *>(input->GetData());
+  auto dst = static_cast<uint16_t *>(output->GetData());
+  size_t size = input->GetElementSize();
+  for (size_t i = 0; i < size; i++) {
+    dst[i] = FloatBitsToHalf(src[i]);
+  }
+  return RET_OK;
+}
+
+int Float16ToFloat(const Tensor *input, Tensor *output) {
+  auto ret = CheckCastTensors(input, output, DataType_DT_FLOAT16, DataType_DT_FLOAT);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  auto src = static_cast<const uint16_t *>(input->GetData());
+  auto dst = static_cast<uint32_t *>(output->GetData());
+  size_t size = input->GetElementSize();
+  for (size_t i = 0; i < size; i++) {
+    dst[i] = HalfToFloatBits(src[i]);
+  }
+  return RET_OK;
+}
 }  // namespace predict
 }  // namespace mindspore
@@ -53,6 +53,8 @@ void MSUInt8ToInt16WithOffsetC4Fast(int16_t *dst, const uint8_t *src, size_t zer
 int MSPackC4(float *dst, const float *src, size_t area, size_t depth);
 int NchwToNc4hw4(const Tensor *input, Tensor *output);
 int Nc4hw4ToNchw(const Tensor *input, Tensor *output);
+int FloatToFloat16(const Tensor *input, Tensor *output);
+int Float16ToFloat(const Tensor *input, Tensor *output);
 #ifdef __cplusplus
 }
 #endif
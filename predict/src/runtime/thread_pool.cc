@@ -16,7 +16,9 @@
 
 #include "src/runtime/thread_pool.h"
 #include <algorithm>
+#include <fstream>
 #include "common/mslog.h"
+#include "common/utils.h"
 
 namespace mindspore {
 namespace predict {
@@ -24,37 +26,8 @@ static constexpr int kThreadPoolMaxThreads = 8;
 static const int kCoreNumThr = 4;
 static const int kMidCoreNum = 2;
 static const int kBigCoreNum = 2;
-bool LiteQueue::Enqueue(const ThreadPoolTask &task) {
-  const int tailIndex = tail.load(std::memory_order_relaxed);
-  // queue full
-  auto next = (tailIndex + 1) % kSingleThreadMaxTask;
-  if (next == head.load(std::memory_order_acquire)) {
-    return false;
-  }
-  buffer[tailIndex] = task;
-  tail.store(next, std::memory_order_release);
-  taskSize.fetch_add(1);
-  return true;
-}
-
-bool LiteQueue::Dequeue(ThreadPoolTask *out) {
-  if (out == nullptr) {
-    MS_LOGE("ThreadPoolTask is nullptr");
-    return false;
-  }
-  if (taskSize.load() == 0) {
-    return false;
-  }
-  // queue empty
-  const int headIndex = head.load(std::memory_order_relaxed);
-  if (headIndex == tail.load(std::memory_order_acquire)) {
-    return false;
-  }
-  *out = buffer[headIndex];
-  head.store((headIndex + 1) % kSingleThreadMaxTask, std::memory_order_release);
-  return true;
-}
-
+static const int kTaskNumShift = 32;
+static const int64_t kTaskIdMask = 0xFFFFFFFF;
 bool LiteThreadBind::Bind(int numThreads, int mode) {
   InitSortedCpuId();
   if (numThreads > static_cast<int>(sortedCpuIds.size())) {
@@ -79,6 +52,17 @@ bool LiteThreadBind::Bind(int numThreads, int mode) {
   return true;
 }
 
+int LiteThreadBind::GetCpuMaxFreq(int cpuId) {
+  std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpuId) + "/cpufreq/cpuinfo_max_freq";
+  std::ifstream fin(path);
+  int freq = 0;
+  if (!fin.is_open() || !(fin >> freq)) {
+    MS_LOGD("read max frequency of cpu %d failed", cpuId);
+    return 0;
+  }
+  return freq;
+}
+
 void LiteThreadBind::InitSortedCpuId() {
   int numCores = static_cast<int>(std::thread::hardware_concurrency());
   if (numCores < kCoreNumThr) {
@@ -88,13 +72,21 @@ void LiteThreadBind::InitSortedCpuId() {
     bigCore = kBigCoreNum;
     midCore = kMidCoreNum;
   }
+  // the big cores of a big.LITTLE SoC are found by their max frequency, the cores of the same frequency are in the
+  // descending order of their ids
+  std::vector<std::pair<int, int>> cpuFreqs;
+  for (int i = 0; i < numCores; ++i) {
+    cpuFreqs.emplace_back(i, GetCpuMaxFreq(i));
+  }
+  std::sort(cpuFreqs.begin(), cpuFreqs.end(), [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+    return a.second != b.second ? a.second > b.second : a.first > b.first;
+  });
   if (numCores > kCoreNumThr) {
     numCores = bigCore + midCore;
   }
-  sortedCpuIds.resize(numCores);
   sortedCpuIds.clear();
-  for (int i = numCores - 1; i >= 0; --i) {
-    sortedCpuIds.emplace_back(i);
+  for (int i = 0; i < numCores; ++i) {
+    sortedCpuIds.emplace_back(cpuFreqs[i].first);
   }
 }
 
@@ -196,27 +188,15 @@ bool LiteThreadBind::SetCPUBind(pthread_t threadId, const cpu_set_t &cpuSet) {
   return true;
 }
 
-LiteThreadPool::LiteThreadPool(int numThreads) {
-  queueList.resize(kThreadPoolMaxThreads);
-  queueList.clear();
-  AddNewThread(numThreads);
-}
+LiteThreadPool::LiteThreadPool(int numThreads) { AddNewThread(numThreads); }
 
 void LiteThreadPool::AddNewThread(int newNums) {
   for (int i = curThreadNums, j = 0; j < newNums; ++j, ++i) {
-    queueList.push_back(std::unique_ptr<LiteQueue>(new LiteQueue()));
     threadList.emplace_back([this, i]() {
-      ThreadPoolTask task;
       while (!destroy) {
         while (running != 0) {
-          MS_LOGD("i = %d, thread id = %lu, taskSize = %d", i, pthread_self(), queueList[i]->taskSize.load());
-          while (queueList[i]->taskSize.load() > 0 && queueList[i]->Dequeue(&task)) {
-            auto ret = task.first(task.second.taskId, task.second.tvmParam, task.second.cdata);
-            if (ret != 0) {
-              errorInfo.emplace_back(std::make_pair(task.second.taskId, std::make_pair(false, ret)));
-            }
-            queueList[i]->taskSize.fetch_sub(1);
-          }
+          MS_LOGD("i = %d, thread id = %lu", i, pthread_self());
+          RunTasks();
           std::this_thread::yield();
         }
         std::unique_lock<std::mutex> queueLock(tMutex);
@@ -228,45 +208,54 @@ void LiteThreadPool::AddNewThread(int newNums) {
   curThreadNums += newNums;
 }
 
+void LiteThreadPool::RunTasks() {
+  // the tasks are claimed one by one instead of being split evenly, so the faster threads run more of them
+  int64_t state = taskState.fetch_add(1);
+  while ((state & kTaskIdMask) < (state >> kTaskNumShift)) {
+    int taskId = static_cast<int>(state & kTaskIdMask);
+    bool profile = profiling.load();
+    uint64_t start = profile ? GetTimeUs() : 0;
+    auto ret = curTask.first(taskId, &curEnv, curTask.second.cdata);
+    if (ret != 0) {
+      std::lock_guard<std::mutex> errorLock(errorMutex);
+      errorInfo.emplace_back(std::make_pair(taskId, std::make_pair(false, ret)));
+    }
+    if (profile) {
+      // added before the task is finished, which the master thread waits for
+      busyTimeUs.fetch_add(GetTimeUs() - start);
+    }
+    finishedTasks.fetch_add(1);
+    state = taskState.fetch_add(1);
+  }
+}
+
 bool LiteThreadPool::DistributeTask(ThreadPoolTask task, int numTask) {
-  // wake up
+  std::lock_guard<std::mutex> distributeLock(distributeMutex);
   errorInfo.clear();
+  curTask = task;
+  curEnv.num_task = numTask;
+  finishedTasks.store(0);
+  // publish the task to the threads, which may still be claiming the ids of the last one
+  taskState.store(static_cast<int64_t>(numTask) << kTaskNumShift);
+  // wake up
   if (!AddRunReference()) {
     MS_LOGE("add reference failed");
     return false;
   }
-  bool kSuccFlag;
-  for (int i = 1; i < numTask; ++i) {
-    task.second.taskId = i;
-    do {
-      kSuccFlag = false;
-      for (auto &queue : queueList) {
-        MS_ASSERT(queue != nullptr);
-        if (queue->Enqueue(task)) {
-          kSuccFlag = true;
-          break;
-        }
-      }
-      std::this_thread::yield();
-    } while (!kSuccFlag);
-  }
   MS_LOGI("add %d task successful", numTask);
+  bool profile = profiling.load();
+  uint64_t start = profile ? GetTimeUs() : 0;
   // master thread
-  int ret = task.first(0, task.second.tvmParam, task.second.cdata);
-  if (ret != 0) {
-    errorInfo.emplace_back(std::make_pair(0, std::make_pair(false, ret)));
-  }
-  kSuccFlag = false;
-  while (!kSuccFlag) {
-    kSuccFlag = true;
-    for (auto iter = queueList.begin(); iter != queueList.end(); ++iter) {
-      if ((*iter)->taskSize.load() != 0) {
-        kSuccFlag = false;
-        break;
-      }
-    }
+  RunTasks();
+  while (finishedTasks.load() != numTask) {
     std::this_thread::yield();
   }
+  if (profile) {
+    // the workers and the master thread
+    totalTimeUs.fetch_add((GetTimeUs() - start) * (curThreadNums + 1));
+  }
+  // no id is left to claim until the next task
+  taskState.store(0);
   // hibernate
   if (!SubRunReference()) {
     MS_LOGE("sub reference failed");
@@ -276,6 +265,18 @@ bool LiteThreadPool::DistributeTask(ThreadPoolTask task, int numTask) {
   return CheckResult();
 }
 
+void LiteThreadPool::SetProfiling(bool enable) {
+  std::lock_guard<std::mutex> distributeLock(distributeMutex);
+  busyTimeUs.store(0);
+  totalTimeUs.store(0);
+  profiling.store(enable);
+}
+
+float LiteThreadPool::GetUtilization() const {
+  uint64_t total = totalTimeUs.load();
+  return total == 0 ? 0.0f : static_cast<float>(busyTimeUs.load()) / total;
+}
+
 bool LiteThreadPool::AddRunReference() {
   running.fetch_add(1);
   std::lock_guard<std::mutex> queueLock(tMutex);
@@ -291,7 +292,7 @@ bool LiteThreadPool::SubRunReference() {
 bool LiteThreadPool::CheckResult() {
   bool kSuccFlag = true;
   for (auto result : errorInfo) {
-    if (result.second.first) {
+    if (!result.second.first) {
       MS_LOGE("task %d failed, error code is %d", result.first, result.second.second);
       kSuccFlag = false;
     }
@@ -377,6 +378,7 @@ bool ThreadPool::SetThreadPool(int numThreads) {
       MS_LOGE("%d threads create failed", realNums);
       return false;
     }
+    gThreadPool->SetProfiling(profiling);
   } else {
     gThreadPool->AddNewThread(realNums);
   }
@@ -413,7 +415,7 @@ bool ThreadPool::LaunchThreadPoolTask() {
 
 bool ThreadPool::AddTask(const WorkFun &worker, void *cdata, int numTask) {
   if (numTask <= 0) {
-    numTask = totalThreadNum;
+    numTask = totalThreadNum > 1 ? totalThreadNum * kTaskPerThread : totalThreadNum;
   }
   // single task, run master thread
   if (numTask <= 1) {
@@ -433,6 +435,19 @@ bool ThreadPool::AddTask(const WorkFun &worker, void *cdata, int numTask) {
   return gThreadPool->DistributeTask(task, numTask);
 }
 
+void ThreadPool::SetProfiling(bool enable) {
+  std::lock_guard<std::mutex> Lock(gPoolMutex);
+  profiling = enable;
+  if (gThreadPool != nullptr) {
+    gThreadPool->SetProfiling(enable);
+  }
+}
+
+float ThreadPool::GetUtilization() {
+  std::lock_guard<std::mutex> Lock(gPoolMutex);
+  return gThreadPool == nullptr ? 0.0f : gThreadPool->GetUtilization();
+}
+
 LiteThreadPool::~LiteThreadPool() {
   destroy.store(true);
   running.store(0);
@@ -30,7 +30,9 @@
 
 namespace mindspore {
 namespace predict {
-constexpr int kSingleThreadMaxTask = 4;
+// the tasks a parallel launch is split into per thread when the caller leaves it to the pool, so that the faster
+// cores claim more of them and a preempted core holds back a small chunk only
+constexpr int kTaskPerThread = 4;
 using TvmEnv = TVMParallelGroupEnv;
 using WorkFun = FTVMParallelLambda;
 using TaskParam = struct Param {
@@ -40,21 +42,6 @@ using TaskParam = struct Param {
 };
 using ThreadPoolTask = std::pair<WorkFun, TaskParam>;
 
-class LiteQueue {
- public:
-  LiteQueue() = default;
-  ~LiteQueue() = default;
-
-  bool Enqueue(const ThreadPoolTask &task);
-  bool Dequeue(ThreadPoolTask *out);
-  std::atomic<int> taskSize{0};
-
- private:
-  std::atomic<int> head{0};
-  std::atomic<int> tail{0};
-  ThreadPoolTask buffer[kSingleThreadMaxTask]{};
-};
-
 class LiteThreadBind {
  public:
   LiteThreadBind() = default;
@@ -65,6 +52,7 @@ class LiteThreadBind {
  private:
   enum AffinityMode : int { BIG_CORE = 1, MID_CORE = -1, NO_BIND = 0 };
   void InitSortedCpuId();
+  int GetCpuMaxFreq(int cpuId);
   bool BindAllThread(bool bindFlag);
   bool BindMasterThread(bool bindFlag, int mode = MID_CORE);
   bool BindThreads(bool bindFlag);
@@ -84,6 +72,8 @@ class LiteThreadPool {
 
   void AddNewThread(int newNums);
   bool DistributeTask(ThreadPoolTask task, int numTask);
+  void SetProfiling(bool enable);
+  float GetUtilization() const;
   std::vector<std::thread> threadList{};
 
  private:
@@ -91,13 +81,25 @@ class LiteThreadPool {
   bool AddRunReference();
   bool SubRunReference();
   bool CheckResult();
+  void RunTasks();
   int curThreadNums{0};
-  std::vector<std::unique_ptr<LiteQueue>> queueList;
   std::atomic_int running{0};
   std::mutex tMutex;
   std::condition_variable queueReady;
   std::atomic<bool> destroy = {false};
+  // the task being run, whose ids are claimed by all the threads in turn
+  std::mutex distributeMutex;
+  ThreadPoolTask curTask{};
+  TvmEnv curEnv{};
+  // the number of the tasks in the high 32 bits and the next id in the low ones, so an id is claimed in one step
+  std::atomic<int64_t> taskState{0};
+  std::atomic_int finishedTasks{0};
+  std::mutex errorMutex;
   std::vector<std::pair<int, errCode>> errorInfo{};
+  // the time of the threads running tasks and the time of all the threads while a task is distributed
+  std::atomic<bool> profiling{false};
+  std::atomic<uint64_t> busyTimeUs{0};
+  std::atomic<uint64_t> totalTimeUs{0};
 };
 
 class ThreadPool {
@@ -106,6 +108,8 @@ class ThreadPool {
   void ConfigThreadPool(int mode, int numThreads);
   bool LaunchThreadPoolTask();
   bool AddTask(const WorkFun &worker, void *cdata, int numTask);
+  void SetProfiling(bool enable);
+  float GetUtilization();
 
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool &operator=(const ThreadPool &) = delete;
@@ -122,6 +126,7 @@ class ThreadPool {
   std::mutex gPoolMutex;
   int totalThreadNum{1};
   int bindMode{-1};
+  bool profiling{false};
 };
 }  // namespace predict
 }  // namespace mindspore
@@ -21,6 +21,8 @@
 #include "common/mslog.h"
 #include "src/graph.h"
 #include "src/graph_execution.h"
+#include "src/model.h"
+#include "src/runtime/thread_pool.h"
 
 namespace mindspore {
 namespace predict {
@@ -48,6 +50,31 @@ std::shared_ptr<Session> CreateSession(const char *graphBuf, size_t size, const
   }
   return session;
 }
+std::shared_ptr<Model> LoadModel(const char *graphBuf, size_t size) {
+  if (size > MAX_BUFFER_SIZE) {
+    MS_LOGE("the size is invalid");
+    return nullptr;
+  }
+  return Model::Create(graphBuf, size);
+}
+
+std::shared_ptr<Model> LoadModelFromFile(const char *modelPath) { return Model::CreateFromFile(modelPath); }
+
+std::shared_ptr<Session> CreateSession(const std::shared_ptr<Model> &model, const Context &ctx) {
+  if (model == nullptr) {
+    MS_LOGE("the model is nullptr");
+    return nullptr;
+  }
+  auto session = std::make_shared<Session>(ctx);
+  MS_ASSERT(session != nullptr);
+  auto ret = session->Init(model);
+  if (ret != RET_OK) {
+    MS_LOGE("Init session failed.");
+    return nullptr;
+  }
+  return session;
+}
+
 Session::Session(const Context &ctx) : _ctx(ctx) {
   Context cfgCtx;
   cfgCtx = ctx;
@@ -62,6 +89,29 @@ int Session::Init(const char *graphBuf, size_t size) {
     MS_LOGE("Graph create from buf failed.");
     return RET_NULL_PTR;
   }
+  if (_graph->PlanStaticMemory() != RET_OK) {
+    MS_LOGW("Plan static memory failed, the tensors are allocated in each run.");
+  }
+
+  auto ret = this->InitExecutor();
+  if (ret != RET_OK) {
+    MS_LOGE("Init Executor failed");
+    return ret;
+  }
+  return ret;
+}
+
+int Session::Init(const std::shared_ptr<Model> &model) {
+  MS_ASSERT(model != nullptr);
+  _model = model;
+  _graph = Graph::CreateFromBuf(model->GetBuffer(), model->GetSize(), _ctx, model.get());
+  if (_graph == nullptr) {
+    MS_LOGE("Graph create from model failed.");
+    return RET_NULL_PTR;
+  }
+  if (_graph->PlanStaticMemory() != RET_OK) {
+    MS_LOGW("Plan static memory failed, the tensors are allocated in each run.");
+  }
 
   auto ret = this->InitExecutor();
   if (ret != RET_OK) {
@@ -111,6 +161,8 @@ int Session::Run(const std::vector<Tensor *> &inputs) {
     MS_LOGE("_executor is nullptr");
     return ret;
   }
+  _executor->SetNodeProfiles(profiling ? &nodeProfiles : nullptr);
+  _executor->SetBoundOutputs(boundOutputs);
   ret = _executor->Run(inputs);
   return ret;
 }
@@ -139,6 +191,57 @@ std::vector<Tensor *> Session::GetOutput(const std::string &nodeName) {
   return outputs;
 }
 
+int Session::BindOutput(const std::string &nodeName, const std::vector<Tensor *> &outputs) {
+  if (_graph == nullptr) {
+    MS_LOGE("the graph is nullptr");
+    return RET_ERROR;
+  }
+  auto iter = _graph->GetOutputsMap().find(nodeName);
+  if (iter == _graph->GetOutputsMap().end()) {
+    MS_LOGE("node name (%s) is not in output.", nodeName.c_str());
+    return RET_INPUT_TENSOR_ERROR;
+  }
+  if (outputs.empty()) {
+    (void)boundOutputs.erase(nodeName);
+    return RET_OK;
+  }
+  auto &refOutputs = iter->second;
+  if (outputs.size() != refOutputs.size()) {
+    MS_LOGE("output num %zu != node (%s) output num %zu", outputs.size(), nodeName.c_str(), refOutputs.size());
+    return RET_INPUT_TENSOR_ERROR;
+  }
+  for (size_t i = 0; i < outputs.size(); i++) {
+    MS_ASSERT(refOutputs[i] != nullptr);
+    if (outputs[i] == nullptr || outputs[i]->GetData() == nullptr) {
+      MS_LOGE("output tensor data is null!");
+      return RET_INPUT_TENSOR_ERROR;
+    }
+    // the outputs converted from NC4HW4 or float16 are written by CopyOutputTensors, not by the nodes
+    if (refOutputs[i]->GetFormat() != Format_NCHW || refOutputs[i]->GetDataType() == DataType_DT_FLOAT16) {
+      MS_LOGE("output %zu of node (%s) can not be bound, only nchw and not float16 is supported now", i,
+              nodeName.c_str());
+      return RET_INPUT_TENSOR_ERROR;
+    }
+    if (outputs[i]->GetFormat() != Format_NCHW || outputs[i]->GetDataType() != refOutputs[i]->GetDataType() ||
+        !outputs[i]->CompareShape(*refOutputs[i])) {
+      MS_LOGE("output %zu of node (%s) is different from the model", i, nodeName.c_str());
+      return RET_INPUT_TENSOR_ERROR;
+    }
+  }
+  boundOutputs[nodeName] = outputs;
+  return RET_OK;
+}
+
+void Session::SetProfiling(bool enable) {
+  profiling = enable;
+  nodeProfiles.clear();
+  ThreadPool::GetInstance()->SetProfiling(enable);
+}
+
+std::vector<NodeProfile> Session::GetNodeProfiles() const { return nodeProfiles; }
+
+float Session::GetThreadPoolUtilization() const { return ThreadPool::GetInstance()->GetUtilization(); }
+
 std::map<std::string, std::vector<Tensor *>> Session::GetAllOutput() {
   if (_executor == nullptr) {
     MS_LOGE("graph's executor is nullptr.");
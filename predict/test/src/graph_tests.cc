@@ -16,12 +16,16 @@
 
 #include <gtest/gtest.h>
 #include <cstdio>
+#include <cstring>
 #include <string>
+#include <thread>
 #include "schema/inner/ms_generated.h"
 #include "src/graph.h"
 #include "common/file_utils.h"
 #include "test/test_context.h"
 #include "include/session.h"
+#include "include/batch_session.h"
+#include "include/errorcode.h"
 
 namespace mindspore {
 namespace predict {
@@ -144,5 +148,306 @@ TEST_F(GraphTest, CreateFromFileAdd) {
   FreeOutputs(&outputs);
   FreeInputs(&inputs);
 }
+
+std::unique_ptr<NodeDefT> CreateAddNode(const std::string &name, const std::vector<uint32_t> &inputIndex,
+                                        const std::vector<uint32_t> &outputIndex) {
+  std::unique_ptr<NodeDefT> node(new (std::nothrow) NodeDefT);
+  std::unique_ptr<OpDefT> opDef(new (std::nothrow) OpDefT);
+  node->opDef = std::move(opDef);
+  node->opDef->isLastConv = false;
+  node->opDef->inputIndex = inputIndex;
+  node->opDef->outputIndex = outputIndex;
+  node->opDef->name = name;
+  node->fmkType = FmkType_CAFFE;
+
+  auto attr = std::unique_ptr<AddT>(new (std::nothrow) AddT());
+  attr->format = DataFormatType_NCHW;
+  node->opDef->attr.type = OpT_Add;
+  node->opDef->attr.value = attr.release();
+  return node;
+}
+
+TEST_F(GraphTest, RunWithStaticMemoryPlan) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test2";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0, 1};
+  msSubgraph->outputIndex = {3};
+
+  // tensor 2 is the intermediate tensor in the static memory arena: 3 = (0 + 1) + 1
+  msSubgraph->nodes.emplace_back(CreateAddNode(msSubgraph->name + "0", {0, 1}, {2}));
+  msSubgraph->nodes.emplace_back(CreateAddNode(msSubgraph->name + "1", {2, 1}, {3}));
+  InitMsGraphAllTensor(msSubgraph.get());
+  std::unique_ptr<TensorDefT> tensor4(new (std::nothrow) TensorDefT);
+  ASSERT_NE(tensor4, nullptr);
+  tensor4->refCount = 0;
+  tensor4->format = Format_NCHW;
+  tensor4->dataType = DataType_DT_FLOAT;
+  tensor4->dims = {1, 1, 1, 2};
+  tensor4->offset = -1;
+  tensor4->data.resize(0);
+  msSubgraph->allTensors.emplace_back(std::move(tensor4));
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  int size = builder.GetSize();
+  void *content = builder.GetBufferPointer();
+
+  Context ctx;
+  auto session = CreateSession(static_cast<char *>(content), size, ctx);
+  ASSERT_NE(session, nullptr);
+
+  std::vector<float> tmpT = {1, 2};
+  std::vector<float> tmpT2 = {3, 5};
+  for (int i = 0; i < 2; i++) {
+    auto inputs = session->GetInput();
+    inputs[0]->SetData(tmpT.data());
+    inputs[1]->SetData(tmpT2.data());
+
+    auto ret = session->Run(inputs);
+    EXPECT_EQ(0, ret);
+    auto outputs = session->GetAllOutput();
+    ASSERT_EQ(1, outputs.size());
+    EXPECT_EQ(7, reinterpret_cast<float *>(outputs.begin()->second.front()->GetData())[0]);
+    EXPECT_EQ(12, reinterpret_cast<float *>(outputs.begin()->second.front()->GetData())[1]);
+
+    FreeOutputs(&outputs);
+    FreeInputs(&inputs);
+  }
+}
+
+void RunSessionsWithSharedModel(bool fromFile) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test3";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0};
+  msSubgraph->outputIndex = {2};
+  msSubgraph->nodes.emplace_back(CreateAddNode(msSubgraph->name + "0", {0, 1}, {2}));
+  InitMsGraphAllTensor(msSubgraph.get());
+  // tensor 1 is the weight shared by the sessions
+  std::vector<float> weight = {3, 5};
+  msSubgraph->allTensors[1]->data.resize(weight.size() * sizeof(float));
+  memcpy(msSubgraph->allTensors[1]->data.data(), weight.data(), weight.size() * sizeof(float));
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  int size = builder.GetSize();
+  void *content = builder.GetBufferPointer();
+
+  std::shared_ptr<Model> model = nullptr;
+  if (fromFile) {
+    // the model is mapped from the file
+    const char *modelPath = "./shared_model_test.ms";
+    FILE *fp = fopen(modelPath, "wb");
+    ASSERT_NE(fp, nullptr);
+    ASSERT_EQ(size, fwrite(content, 1, size, fp));
+    fclose(fp);
+    model = LoadModelFromFile(modelPath);
+    (void)remove(modelPath);
+  } else {
+    model = LoadModel(static_cast<char *>(content), size);
+  }
+  ASSERT_NE(model, nullptr);
+  Context ctx;
+  auto session1 = CreateSession(model, ctx);
+  auto session2 = CreateSession(model, ctx);
+  ASSERT_NE(session1, nullptr);
+  ASSERT_NE(session2, nullptr);
+
+  std::vector<float> tmpT = {1, 2};
+  for (auto &session : {session1, session2}) {
+    auto inputs = session->GetInput();
+    ASSERT_EQ(1, inputs.size());
+    inputs[0]->SetData(tmpT.data());
+
+    auto ret = session->Run(inputs);
+    EXPECT_EQ(0, ret);
+    auto outputs = session->GetAllOutput();
+    EXPECT_EQ(4, reinterpret_cast<float *>(outputs.begin()->second.front()->GetData())[0]);
+    EXPECT_EQ(7, reinterpret_cast<float *>(outputs.begin()->second.front()->GetData())[1]);
+
+    FreeOutputs(&outputs);
+    FreeInputs(&inputs);
+  }
+}
+
+TEST_F(GraphTest, RunSessionsWithSharedModel) { RunSessionsWithSharedModel(false); }
+
+TEST_F(GraphTest, RunSessionsWithMappedModel) { RunSessionsWithSharedModel(true); }
+
+TEST_F(GraphTest, RunBatchSession) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test4";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0, 1};
+  msSubgraph->outputIndex = {2};
+  msSubgraph->nodes.emplace_back(CreateAddNode(msSubgraph->name + "0", {0, 1}, {2}));
+  InitMsGraphAllTensor(msSubgraph.get());
+  // the model runs a batch of 2 samples
+  for (auto &tensor : msSubgraph->allTensors) {
+    tensor->dims = {2, 1, 1, 2};
+  }
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  int size = builder.GetSize();
+  void *content = builder.GetBufferPointer();
+
+  Context ctx;
+  auto session = CreateSession(static_cast<char *>(content), size, ctx);
+  ASSERT_NE(session, nullptr);
+  auto batchSession = CreateBatchSession(session, 1000000);
+  ASSERT_NE(batchSession, nullptr);
+  EXPECT_EQ(2, batchSession->GetMaxBatchSize());
+
+  // two requests of batch 1 run concurrently, each gets its own sample of the batch
+  std::vector<std::vector<float>> in1Data = {{1, 2}, {10, 20}};
+  std::vector<float> in2Data = {3, 5};
+  std::vector<float> results(4, 0);
+  std::vector<int> rets(2, RET_ERROR);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 2; i++) {
+    threads.emplace_back([&, i]() {
+      Tensor in1(DataType_DT_FLOAT, {1, 1, 1, 2}, Format_NCHW, in1Data[i].data());
+      Tensor in2(DataType_DT_FLOAT, {1, 1, 1, 2}, Format_NCHW, in2Data.data());
+      std::map<std::string, std::vector<Tensor *>> outputs;
+      rets[i] = batchSession->Run({&in1, &in2}, &outputs);
+      if (rets[i] == RET_OK && !outputs.empty() && !outputs.begin()->second.empty()) {
+        auto output = outputs.begin()->second.front();
+        results[i * 2] = reinterpret_cast<float *>(output->GetData())[0];
+        results[i * 2 + 1] = reinterpret_cast<float *>(output->GetData())[1];
+      }
+      FreeOutputs(&outputs);
+      in1.SetData(nullptr);
+      in2.SetData(nullptr);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(RET_OK, rets[0]);
+  EXPECT_EQ(RET_OK, rets[1]);
+  EXPECT_EQ(std::vector<float>({4, 7, 13, 25}), results);
+}
+
+TEST_F(GraphTest, ProfileSession) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test5";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0, 1};
+  msSubgraph->outputIndex = {2};
+  msSubgraph->nodes.emplace_back(CreateAddNode(msSubgraph->name + "0", {0, 1}, {2}));
+  InitMsGraphAllTensor(msSubgraph.get());
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  int size = builder.GetSize();
+  void *content = builder.GetBufferPointer();
+
+  Context ctx;
+  auto session = CreateSession(static_cast<char *>(content), size, ctx);
+  ASSERT_NE(session, nullptr);
+  std::vector<float> tmpT = {1, 2};
+  std::vector<float> tmpT2 = {3, 5};
+  auto inputs = session->GetInput();
+  inputs[0]->SetData(tmpT.data());
+  inputs[1]->SetData(tmpT2.data());
+
+  // the run before the profiling is enabled is not profiled
+  EXPECT_EQ(RET_OK, session->Run(inputs));
+  auto outputs = session->GetAllOutput();
+  FreeOutputs(&outputs);
+  session->SetProfiling(true);
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(RET_OK, session->Run(inputs));
+    outputs = session->GetAllOutput();
+    FreeOutputs(&outputs);
+  }
+  auto profiles = session->GetNodeProfiles();
+  ASSERT_EQ(1u, profiles.size());
+  EXPECT_EQ("test5_10", profiles[0].name);
+  EXPECT_EQ(2u, profiles[0].runCount);
+
+  session->SetProfiling(false);
+  EXPECT_TRUE(session->GetNodeProfiles().empty());
+  FreeInputs(&inputs);
+}
+
+TEST_F(GraphTest, BindSessionOutput) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test6";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0, 1};
+  msSubgraph->outputIndex = {2};
+  msSubgraph->nodes.emplace_back(CreateAddNode(msSubgraph->name + "0", {0, 1}, {2}));
+  InitMsGraphAllTensor(msSubgraph.get());
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  int size = builder.GetSize();
+  void *content = builder.GetBufferPointer();
+
+  Context ctx;
+  auto session = CreateSession(static_cast<char *>(content), size, ctx);
+  ASSERT_NE(session, nullptr);
+  std::vector<float> tmpT = {1, 2};
+  std::vector<float> tmpT2 = {3, 5};
+  auto inputs = session->GetInput();
+  inputs[0]->SetData(tmpT.data());
+  inputs[1]->SetData(tmpT2.data());
+
+  std::vector<float> outData = {0, 0};
+  std::vector<Tensor *> outputs = {new Tensor(DataType_DT_FLOAT, {1, 1, 1, 2}, Format_NCHW, outData.data())};
+  std::vector<Tensor *> badOutputs = {new Tensor(DataType_DT_FLOAT, {1, 1, 2, 1}, Format_NCHW, outData.data())};
+  EXPECT_NE(RET_OK, session->BindOutput("test6_10", badOutputs));
+  EXPECT_NE(RET_OK, session->BindOutput("test6_2", outputs));
+  ASSERT_EQ(RET_OK, session->BindOutput("test6_10", outputs));
+
+  // the bound output is written in place and is not returned by the session
+  for (int i = 0; i < 2; i++) {
+    tmpT[0] = i;
+    EXPECT_EQ(RET_OK, session->Run(inputs));
+    EXPECT_EQ(i + 3.0f, outData[0]);
+    EXPECT_EQ(7.0f, outData[1]);
+    EXPECT_TRUE(session->GetOutput("test6_10").empty());
+    auto allOutputs = session->GetAllOutput();
+    EXPECT_TRUE(allOutputs.empty());
+  }
+
+  ASSERT_EQ(RET_OK, session->BindOutput("test6_10", {}));
+  EXPECT_EQ(RET_OK, session->Run(inputs));
+  auto allOutputs = session->GetAllOutput();
+  ASSERT_EQ(1u, allOutputs.size());
+  EXPECT_NE(outData.data(), allOutputs["test6_10"][0]->GetData());
+  FreeOutputs(&allOutputs);
+  FreeInputs(&outputs);
+  FreeInputs(&badOutputs);
+  FreeInputs(&inputs);
+}
 }  // namespace predict
 }  // namespace mindspore
@@ -0,0 +1,315 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""
+Benchmarks of the dataset engine.
+
+Each case iterates a pipeline to its end and reports the rows per second and the CPU time of the process per row, which
+counts all the threads of the engine. The timing starts at the first row, so the launch of the pipeline is left out.
+A case of an op also runs the same pipeline without the op, the difference is the CPU time the op adds to a row:
+
+    op_cpu_us_per_row = (cpu_us_per_row(pipeline + op) - cpu_us_per_row(pipeline)) / chain
+
+where `chain` is the number of the ops added, the connector cases chain project ops which only pass the rows on, so
+the difference is the cost of moving a row through a connector.
+
+The images are generated at the sizes of the cases and written as an ImageFolder tree and a MindRecord file, the
+TFRecord cases read the files of `--tf_dir`.
+
+Run with `python dataset_benchmark.py --output result.json`, the json has a record for each case that can be compared
+between the builds: `--baseline result.json` lists the cases whose rows per second dropped by more than `--threshold`,
+and the exit code is 1 if there are any.
+"""
+
+import argparse
+import glob
+import json
+import os
+import shutil
+import sys
+import tempfile
+import time
+
+import numpy as np
+from PIL import Image
+
+import mindspore.dataset as ds
+import mindspore.dataset.transforms.c_transforms as C
+import mindspore.dataset.transforms.vision.c_transforms as vision
+import mindspore.common.dtype as mstype
+from mindspore.mindrecord import FileWriter
+
+TF_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "../../ut/data/dataset/test_tf_file_3_images")
+MEAN = [0.485 * 255, 0.456 * 255, 0.406 * 255]
+STD = [0.229 * 255, 0.224 * 255, 0.225 * 255]
+
+
+class Data:
+    """The files of the cases, written under `path` with `num_images` images of each of the sizes."""
+
+    def __init__(self, path, sizes, num_images, tf_dir=TF_DIR):
+        self.path = path
+        self.sizes = sizes
+        self.num_images = num_images
+        self.tf_files = sorted(glob.glob(os.path.join(tf_dir, "*.data")))
+        self.tf_schema = os.path.join(tf_dir, "datasetSchema.json")
+        self.tf_rows = 3
+        rng = np.random.RandomState(1)
+        for size in sizes:
+            image_dir = self.image_dir(size)
+            files = []
+            for i in range(num_images):
+                class_dir = os.path.join(image_dir, "class%d" % (i % 2))
+                os.makedirs(class_dir, exist_ok=True)
+                # an upscaled random image compresses like a photo, the noise would not
+                small = rng.randint(0, 256, [max(size // 16, 2), max(size // 16, 2), 3]).astype(np.uint8)
+                file_name = os.path.join(class_dir, "%d.jpg" % i)
+                Image.fromarray(small).resize((size, size), Image.BILINEAR).save(file_name, quality=90)
+                files.append((file_name, i % 2))
+            writer = FileWriter(self.mindrecord_file(size), 1)
+            writer.add_schema({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}},
+                              "img_schema")
+            data = []
+            for file_name, label in files:
+                with open(file_name, "rb") as f:
+                    data.append({"file_name": os.path.basename(file_name), "label": label, "data": f.read()})
+            writer.write_raw_data(data)
+            writer.commit()
+
+    def image_dir(self, size):
+        return os.path.join(self.path, "images_%d" % size)
+
+    def mindrecord_file(self, size):
+        return os.path.join(self.path, "images_%d.mindrecord" % size)
+
+    def repeat(self, rows, source_rows):
+        return max((rows + source_rows - 1) // source_rows, 1)
+
+    def image_folder(self, size, rows, workers=None, decode=False):
+        dataset = ds.ImageFolderDatasetV2(self.image_dir(size), num_parallel_workers=workers, decode=decode)
+        return dataset.repeat(self.repeat(rows, self.num_images))
+
+    def mindrecord(self, size, rows, workers=None, columns=None):
+        dataset = ds.MindDataset(self.mindrecord_file(size), columns_list=columns, num_parallel_workers=workers)
+        return dataset.repeat(self.repeat(rows, self.num_images))
+
+    def tfrecord(self, rows, workers=None):
+        dataset = ds.TFRecordDataset(self.tf_files, self.tf_schema, num_parallel_workers=workers,
+                                     shuffle=ds.Shuffle.FILES)
+        return dataset.repeat(self.repeat(rows, self.tf_rows))
+
+
+class Case:
+    """
+    A benchmark case, `make(data, rows)` builds its pipeline of `rows` input rows and `base(data, rows)` the same
+    pipeline without the `chain` ops measured, the output rows of a pipeline have `batch` input rows each.
+    """
+
+    def __init__(self, name, op, params, make, base=None, chain=1, batch=1):
+        self.name = name
+        self.op = op
+        self.params = params
+        self.make = make
+        self.base = base
+        self.chain = chain
+        self.batch = batch
+
+
+def _map(dataset, operations, column="image", workers=1):
+    return dataset.map(input_columns=[column], operations=operations, num_parallel_workers=workers)
+
+
+def _source_cases(sizes):
+    size = sizes[0]
+    cases = []
+    for workers in [1, 4]:
+        params = {"workers": workers}
+        cases += [
+            Case("ImageFolderOp/%d" % workers, "ImageFolderOp", params,
+                 lambda data, rows, w=workers: data.image_folder(size, rows, w)),
+            Case("MindRecordOp/%d" % workers, "MindRecordOp", params,
+                 lambda data, rows, w=workers: data.mindrecord(size, rows, w)),
+            Case("TFReaderOp/%d" % workers, "TFReaderOp", params, lambda data, rows, w=workers: data.tfrecord(rows, w)),
+        ]
+    return cases
+
+
+def _tensor_op_cases(sizes):
+    cases = []
+    for size in sizes:
+        half = size // 2
+        params = {"size": size}
+        raw = lambda data, rows, s=size: data.image_folder(s, rows)
+        decoded = lambda data, rows, s=size: _map(data.image_folder(s, rows), [vision.Decode()])
+        ops = [
+            ("Decode", raw, lambda: vision.Decode()),
+            ("RandomCropDecodeResize", raw, lambda h=half: vision.RandomCropDecodeResize(h)),
+            ("Resize", decoded, lambda h=half: vision.Resize(h)),
+            ("CenterCrop", decoded, lambda h=half: vision.CenterCrop(h)),
+            ("RandomCrop", decoded, lambda h=half: vision.RandomCrop(h)),
+            ("RandomResizedCrop", decoded, lambda h=half: vision.RandomResizedCrop(h)),
+            ("RandomHorizontalFlip", decoded, lambda: vision.RandomHorizontalFlip()),
+            ("RandomColorAdjust", decoded,
+             lambda: vision.RandomColorAdjust(brightness=(0.5, 1.5), contrast=(0.5, 1.5), saturation=(0.5, 1.5))),
+            ("RandomRotation", decoded, lambda: vision.RandomRotation(30)),
+            ("Rescale", decoded, lambda: vision.Rescale(1.0 / 255.0, 0.0)),
+            ("Normalize", decoded, lambda: vision.Normalize(MEAN, STD)),
+            ("HWC2CHW", decoded, lambda: vision.HWC2CHW()),
+            ("NormalizeHWC2CHW", decoded, lambda: vision.NormalizeHWC2CHW(MEAN, STD)),
+        ]
+        for op, base, make_op in ops:
+            cases.append(Case("%s/%d" % (op, size), op, params,
+                              lambda data, rows, b=base, m=make_op: _map(b(data, rows), [m()]), base))
+    # the ops of the label
+    labels = lambda data, rows: data.mindrecord(sizes[0], rows, columns=["label"])
+    cases += [
+        Case("OneHot", "OneHot", {}, lambda data, rows: _map(labels(data, rows), [C.OneHot(10)], "label"), labels),
+        Case("TypeCast", "TypeCast", {},
+             lambda data, rows: _map(labels(data, rows), [C.TypeCast(mstype.float32)], "label"), labels),
+    ]
+    return cases
+
+
+def _engine_op_cases(sizes):
+    size = sizes[0]
+    batch_size = 32
+    cases = []
+    decoded = lambda data, rows: _map(data.image_folder(size, rows), [vision.Decode()], workers=4)
+    for workers in [1, 2, 4, 8]:
+        params = {"workers": workers}
+        cases += [
+            Case("MapOp/%d" % workers, "MapOp", params,
+                 lambda data, rows, w=workers: _map(data.image_folder(size, rows),
+                                                    [vision.Decode(), vision.Resize(size // 2)], workers=w),
+                 lambda data, rows: data.image_folder(size, rows)),
+            Case("BatchOp/%d" % workers, "BatchOp", params,
+                 lambda data, rows, w=workers: decoded(data, rows).batch(batch_size, num_parallel_workers=w),
+                 decoded, batch=batch_size),
+        ]
+    # the shuffle op has no workers, its cost is in the size of the buffer
+    for buffer_size in [1000, 10000]:
+        cases.append(Case("ShuffleOp/%d" % buffer_size, "ShuffleOp", {"buffer_size": buffer_size},
+                          lambda data, rows, b=buffer_size: data.mindrecord(size, rows).shuffle(b),
+                          lambda data, rows: data.mindrecord(size, rows)))
+    labels = lambda data, rows: data.mindrecord(size, rows, columns=["label"])
+    for chain in [1, 4]:
+        cases.append(Case("Connector/%d" % chain, "Connector", {"chain": chain},
+                          lambda data, rows, n=chain: _projects(labels(data, rows), n), labels, chain=chain))
+    return cases
+
+
+def _projects(dataset, chain):
+    for _ in range(chain):
+        dataset = dataset.project(["label"])
+    return dataset
+
+
+def default_cases(sizes=(224, 512)):
+    return _source_cases(list(sizes)) + _tensor_op_cases(list(sizes)) + _engine_op_cases(list(sizes))
+
+
+def _measure(dataset, batch):
+    """Iterate the dataset to its end, return the input rows after the first output row, the seconds and cpu seconds."""
+    rows = 0
+    start_time = start_cpu = None
+    for _ in dataset.create_tuple_iterator():
+        if start_time is None:
+            start_time = time.perf_counter()
+            start_cpu = time.process_time()
+            continue
+        rows += batch
+    if rows == 0:
+        return 0, 0.0, 0.0
+    return rows, time.perf_counter() - start_time, time.process_time() - start_cpu
+
+
+def run_case(case, data, rows):
+    ds.config.set_seed(1)
+    measured, seconds, cpu = _measure(case.make(data, rows), case.batch)
+    if measured == 0:
+        raise RuntimeError("The case {} has less than two output rows".format(case.name))
+    result = {
+        "case": case.name,
+        "op": case.op,
+        "params": case.params,
+        "rows": measured,
+        "rows_per_sec": measured / max(seconds, 1e-9),
+        "cpu_us_per_row": cpu / measured * 1e6,
+    }
+    if case.base is not None:
+        base_rows, _, base_cpu = _measure(case.base(data, rows), 1)
+        base_cpu_us = base_cpu / max(base_rows, 1) * 1e6
+        result["op_cpu_us_per_row"] = (result["cpu_us_per_row"] - base_cpu_us) / case.chain
+    return result
+
+
+def run(cases, data, rows=2000):
+    return [run_case(case, data, rows) for case in cases]
+
+
+def compare(results, baseline, threshold):
+    """The cases of both runs whose rows per second dropped by more than `threshold` of the baseline."""
+    base = {result["case"]: result for result in baseline}
+    regressions = []
+    for result in results:
+        old = base.get(result["case"])
+        if old is not None and result["rows_per_sec"] < old["rows_per_sec"] * (1.0 - threshold):
+            regressions.append({"case": result["case"], "rows_per_sec": result["rows_per_sec"],
+                                "baseline_rows_per_sec": old["rows_per_sec"]})
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmarks of the dataset engine")
+    parser.add_argument("--output", type=str, default="", help="the json file of the results")
+    parser.add_argument("--baseline", type=str, default="", help="the json file of the results to compare with")
+    parser.add_argument("--threshold", type=float, default=0.1, help="the drop of rows per second of a regression")
+    parser.add_argument("--ops", type=str, default="", help="the comma separated ops to run, all of them by default")
+    parser.add_argument("--rows", type=int, default=2000, help="the input rows of a case")
+    parser.add_argument("--images", type=int, default=64, help="the images generated of each size")
+    parser.add_argument("--sizes", type=str, default="224,512", help="the comma separated sizes of the images")
+    parser.add_argument("--tf_dir", type=str, default=TF_DIR, help="the dir of the TFRecord files and their schema")
+    args = parser.parse_args()
+
+    sizes = [int(size) for size in args.sizes.split(",")]
+    cases = default_cases(sizes)
+    if args.ops:
+        ops = args.ops.split(",")
+        cases = [case for case in cases if case.op in ops]
+    path = tempfile.mkdtemp()
+    try:
+        results = run(cases, Data(path, sizes, args.images, args.tf_dir), args.rows)
+    finally:
+        shutil.rmtree(path, ignore_errors=True)
+    print("{:<28}{:>14}{:>14}{:>14}".format("case", "rows/s", "cpu(us)/row", "op(us)/row"))
+    for result in results:
+        print("{:<28}{:>14.1f}{:>14.1f}{:>14}".format(
+            result["case"], result["rows_per_sec"], result["cpu_us_per_row"],
+            "{:.1f}".format(result["op_cpu_us_per_row"]) if "op_cpu_us_per_row" in result else "-"))
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2)
+    if args.baseline:
+        with open(args.baseline, "r") as f:
+            regressions = compare(results, json.load(f), args.threshold)
+        for regression in regressions:
+            print("Regression of {}: {:.1f} rows/s, {:.1f} rows/s before".format(
+                regression["case"], regression["rows_per_sec"], regression["baseline_rows_per_sec"]))
+        if regressions:
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,40 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Run the dataset benchmarks briefly, to keep them working."""
+
+import pytest
+
+from .dataset_benchmark import Data, compare, default_cases, run
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_dataset_benchmark(tmp_path):
+    sizes = [32]
+    cases = [case for case in default_cases(sizes) if case.name in
+             ("ImageFolderOp/1", "MindRecordOp/1", "TFReaderOp/1", "Resize/32", "OneHot", "MapOp/2", "BatchOp/2",
+              "ShuffleOp/1000", "Connector/4")]
+    results = run(cases, Data(str(tmp_path), sizes, 8), rows=64)
+    assert len(results) == len(cases)
+    for result in results:
+        assert result["rows"] > 0
+        assert result["rows_per_sec"] > 0
+        assert result["cpu_us_per_row"] >= 0
+
+    slower = [dict(result, rows_per_sec=result["rows_per_sec"] / 2) for result in results]
+    assert not compare(results, slower, 0.1)
+    assert [r["case"] for r in compare(slower, results, 0.1)] == [result["case"] for result in results]
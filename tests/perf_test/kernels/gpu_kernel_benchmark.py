@@ -0,0 +1,214 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""
+Micro benchmarks of the GPU kernels.
+
+Each case chains the same op `chain` times in one graph, feeding the output of a step to the next one, so that the
+steps are not merged and only the first input is copied in. The difference between the chained graph and the graph of
+one step is the time of the kernels, the rest of the one step graph is the launch and sync overhead of a run:
+
+    kernel_time = (time(chain) - time(1)) / (chain - 1)
+    overhead = time(1) - kernel_time
+
+Run on a GPU with `python gpu_kernel_benchmark.py --output result.json`, the json has a record for each case that can
+be compared between the builds.
+"""
+
+import argparse
+import json
+import time
+
+import numpy as np
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+
+class _UnaryStep(nn.Cell):
+    def __init__(self, op):
+        super(_UnaryStep, self).__init__()
+        self.op = op
+
+    def construct(self, x, a, b, c, d):
+        return self.op(x)
+
+
+class _BinaryStep(nn.Cell):
+    def __init__(self, op):
+        super(_BinaryStep, self).__init__()
+        self.op = op
+
+    def construct(self, x, a, b, c, d):
+        return self.op(x, a)
+
+
+class _LayerNormStep(nn.Cell):
+    def __init__(self, op):
+        super(_LayerNormStep, self).__init__()
+        self.op = op
+
+    def construct(self, x, a, b, c, d):
+        return self.op(x, a, b)[0]
+
+
+class _BatchNormStep(nn.Cell):
+    def __init__(self, op):
+        super(_BatchNormStep, self).__init__()
+        self.op = op
+
+    def construct(self, x, a, b, c, d):
+        return self.op(x, a, b, c, d)[0]
+
+
+class _Transpose(nn.Cell):
+    def __init__(self, perm):
+        super(_Transpose, self).__init__()
+        self.transpose = P.Transpose()
+        self.perm = perm
+
+    def construct(self, x):
+        return self.transpose(x, self.perm)
+
+
+class _Chain(nn.Cell):
+    def __init__(self, step, inner):
+        super(_Chain, self).__init__()
+        self.step = step
+        self.inner = inner
+
+    def construct(self, x, a, b, c, d):
+        return self.step(self.inner(x, a, b, c, d), a, b, c, d)
+
+
+class Case:
+    """A benchmark case, the output of the step has the shape of its first input."""
+
+    def __init__(self, name, step, shapes, dtype=np.float32, flops=0):
+        self.name = name
+        self.step = step
+        self.shapes = shapes
+        self.dtype = dtype
+        self.flops = flops
+
+    def inputs(self):
+        np.random.seed(1)
+        inputs = [Tensor(np.random.uniform(0.5, 1.0, shape).astype(self.dtype)) for shape in self.shapes]
+        # the unused inputs of the step
+        inputs += [Tensor(np.ones([1]).astype(self.dtype))] * (5 - len(inputs))
+        return inputs
+
+    def bytes(self):
+        itemsize = np.dtype(self.dtype).itemsize
+        return (sum(int(np.prod(shape)) for shape in self.shapes) + int(np.prod(self.shapes[0]))) * itemsize
+
+
+def _conv_flops(n, c, h, w, out_channel, kernel):
+    return 2 * n * out_channel * h * w * c * kernel * kernel
+
+
+def default_cases():
+    nchw = [32, 64, 56, 56]
+    cases = []
+    for dtype in [np.float32, np.float16]:
+        cases += [
+            Case("ReLU", lambda: _UnaryStep(P.ReLU()), [nchw], dtype),
+            Case("Neg", lambda: _UnaryStep(P.Neg()), [nchw], dtype),
+            Case("TensorAdd", lambda: _BinaryStep(P.TensorAdd()), [nchw, nchw], dtype),
+            Case("Mul", lambda: _BinaryStep(P.Mul()), [nchw, nchw], dtype),
+            Case("BiasAdd", lambda: _BinaryStep(P.BiasAdd()), [nchw, [64]], dtype),
+            Case("Transpose", lambda: _UnaryStep(_Transpose((0, 1, 3, 2))), [nchw], dtype),
+            Case("Softmax", lambda: _UnaryStep(P.Softmax()), [[4096, 1000]], dtype),
+            Case("LayerNorm", lambda: _LayerNormStep(P.LayerNorm(begin_norm_axis=1, begin_params_axis=1)),
+                 [[4096, 1024], [1024], [1024]], dtype),
+            Case("BatchNorm", lambda: _BatchNormStep(P.BatchNorm(is_training=False)),
+                 [nchw, [64], [64], [64], [64]], dtype),
+            Case("MatMul", lambda: _BinaryStep(P.MatMul()), [[2048, 2048], [2048, 2048]], dtype,
+                 2 * 2048 * 2048 * 2048),
+            Case("Conv2D", lambda: _BinaryStep(P.Conv2D(out_channel=64, kernel_size=3, pad_mode="same")),
+                 [nchw, [64, 64, 3, 3]], dtype, _conv_flops(32, 64, 56, 56, 64, 3)),
+        ]
+    return cases
+
+
+def _median_time(net, inputs, warmup, repeat):
+    for _ in range(warmup):
+        net(*inputs).asnumpy()
+    times = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        # asnumpy waits for the kernels of the run
+        net(*inputs).asnumpy()
+        times.append(time.perf_counter() - start)
+    return float(np.median(times))
+
+
+def _chain_net(case, chain):
+    net = case.step()
+    for _ in range(chain - 1):
+        net = _Chain(case.step(), net)
+    return net
+
+
+def run_case(case, chain=10, warmup=3, repeat=20):
+    inputs = case.inputs()
+    single_time = _median_time(_chain_net(case, 1), inputs, warmup, repeat)
+    chain_time = _median_time(_chain_net(case, chain), inputs, warmup, repeat)
+    kernel_time = max((chain_time - single_time) / (chain - 1), 1e-9)
+    return {
+        "op": case.name,
+        "dtype": np.dtype(case.dtype).name,
+        "shapes": case.shapes,
+        "kernel_us": kernel_time * 1e6,
+        "overhead_us": max(single_time - kernel_time, 0.0) * 1e6,
+        "bandwidth_gbps": case.bytes() / kernel_time / 1e9,
+        "gflops": case.flops / kernel_time / 1e9,
+    }
+
+
+def run(cases, chain=10, warmup=3, repeat=20):
+    context.set_context(mode=context.GRAPH_MODE, device_target="GPU")
+    return [run_case(case, chain, warmup, repeat) for case in cases]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Micro benchmarks of the GPU kernels")
+    parser.add_argument("--output", type=str, default="", help="the json file of the results")
+    parser.add_argument("--ops", type=str, default="", help="the comma separated ops to run, all of them by default")
+    parser.add_argument("--chain", type=int, default=10, help="the steps chained in the graph of a case")
+    parser.add_argument("--warmup", type=int, default=3, help="the runs before the timed ones")
+    parser.add_argument("--repeat", type=int, default=20, help="the timed runs, the median is reported")
+    args = parser.parse_args()
+
+    cases = default_cases()
+    if args.ops:
+        ops = args.ops.split(",")
+        cases = [case for case in cases if case.name in ops]
+    results = run(cases, args.chain, args.warmup, args.repeat)
+    print("{:<12}{:<10}{:>12}{:>14}{:>12}{:>10}".format("op", "dtype", "kernel(us)", "overhead(us)", "GB/s",
+                                                        "GFLOP/s"))
+    for result in results:
+        print("{:<12}{:<10}{:>12.1f}{:>14.1f}{:>12.1f}{:>10.1f}".format(
+            result["op"], result["dtype"], result["kernel_us"], result["overhead_us"], result["bandwidth_gbps"],
+            result["gflops"]))
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,32 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Run the GPU kernel benchmarks briefly, to keep them working."""
+
+import pytest
+
+from .gpu_kernel_benchmark import default_cases, run
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_gpu_kernel_benchmark():
+    cases = [case for case in default_cases() if case.name in ("ReLU", "MatMul", "LayerNorm")]
+    results = run(cases, chain=2, warmup=1, repeat=2)
+    assert len(results) == len(cases)
+    for result in results:
+        assert result["kernel_us"] > 0
+        assert result["bandwidth_gbps"] > 0
@@ -0,0 +1,33 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Run the training benchmark briefly, to keep it working."""
+
+import pytest
+
+from .train_benchmark import PHASES, run
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_train_benchmark():
+    result = run("lstm", "GPU", batch_size=4, steps=3, warmup=1, data="host")
+    assert len(result["steps"]) == 3
+    assert result["samples_per_sec"] > 0
+    for step in result["steps"]:
+        assert step["device_compute"] > 0
+        assert step["optimizer"] > 0
+        assert sum(step[phase] for phase in PHASES) >= step["total"]
@@ -0,0 +1,209 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""
+Benchmarks of the training throughput, with the time of each step broken down by its phases.
+
+A model is trained for some steps on synthetic data with the step stats of the context enabled, which record for each
+run of the training graph:
+
+    data_wait       the GetNext kernels waiting for the data sunk to the device, and the time of the benchmark making
+                    the batch of the step on the host when the data is not sunk
+    device_compute  the kernels of the forward and backward network
+    communication   the collective kernels
+    optimizer       the kernels in the scope of the optimizer cell
+    host_dispatch   the rest of the step, the graph run by the VM and the session, and the copies of the inputs
+
+The kernels are synchronized one by one to time them, so the steps run slower than without the stats, and the graphs
+sunk as a whole to Ascend only have their device compute. With `--data synthetic` the same batch is fed to every step,
+with `--data host` a new random batch is made on the host for each step. The seeds are fixed, so the runs of a model
+start from the same weights and see the same batches.
+
+Run with `python train_benchmark.py --model resnet50 --device GPU --output result.json`, the json has the samples per
+second and the median microseconds of each phase over the steps, and the phases of every step.
+"""
+
+import argparse
+import json
+import time
+
+import numpy as np
+
+import mindspore.common.dtype as mstype
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore._c_expression import get_step_stats
+from mindspore.model_zoo.Bert_NEZHA import BertConfig, BertNetworkWithLoss, BertTrainOneStepCell
+from mindspore.model_zoo.resnet import resnet50
+from mindspore.nn.optim import AdamWeightDecayDynamicLR, Momentum
+from mindspore.ops import operations as P
+
+PHASES = ["data_wait", "host_dispatch", "device_compute", "communication", "optimizer"]
+
+
+class _LSTMClassifier(nn.Cell):
+    def __init__(self, batch_size, input_size, hidden_size, num_layers, num_classes):
+        super(_LSTMClassifier, self).__init__()
+        self.lstm = nn.LSTM(input_size, hidden_size, num_layers)
+        zeros = np.zeros([num_layers, batch_size, hidden_size]).astype(np.float32)
+        self.h0 = Tensor(zeros)
+        self.c0 = Tensor(zeros)
+        self.mean = P.ReduceMean()
+        self.fc = nn.Dense(hidden_size, num_classes)
+
+    def construct(self, x):
+        output, _ = self.lstm(x, (self.h0, self.c0))
+        return self.fc(self.mean(output, 0))
+
+
+class Model:
+    """A model to train, `make_inputs(rng)` makes a batch of the inputs of its train network."""
+
+    def __init__(self, name, make_net, make_inputs):
+        self.name = name
+        self.make_net = make_net
+        self.make_inputs = make_inputs
+
+
+def _classifier_train_net(network, learning_rate=0.01):
+    loss = nn.SoftmaxCrossEntropyWithLogits(is_grad=False, sparse=True)
+    optimizer = Momentum(network.trainable_params(), learning_rate, 0.9)
+    return nn.TrainOneStepCell(nn.WithLossCell(network, loss), optimizer)
+
+
+def _labels(rng, batch_size, num_classes):
+    return rng.randint(0, num_classes, [batch_size]).astype(np.int32)
+
+
+def _resnet50(batch_size):
+    return Model("resnet50", lambda: _classifier_train_net(resnet50(1000)),
+                 lambda rng: [rng.uniform(-1.0, 1.0, [batch_size, 3, 224, 224]).astype(np.float32),
+                              _labels(rng, batch_size, 1000)])
+
+
+def _bert_base(batch_size, seq_length=128, max_predictions=20):
+    config = BertConfig(batch_size=batch_size, seq_length=seq_length, vocab_size=21128, hidden_size=768,
+                        num_hidden_layers=12, num_attention_heads=12, intermediate_size=3072, hidden_act="gelu",
+                        hidden_dropout_prob=0.1, attention_probs_dropout_prob=0.1, max_position_embeddings=512,
+                        type_vocab_size=2, initializer_range=0.02, use_relative_positions=False,
+                        input_mask_from_dataset=True, token_type_ids_from_dataset=True, dtype=mstype.float32,
+                        compute_type=mstype.float32)
+
+    def make_net():
+        network = BertNetworkWithLoss(config, True)
+        optimizer = AdamWeightDecayDynamicLR(network.trainable_params(), decay_steps=1000)
+        return BertTrainOneStepCell(network, optimizer)
+
+    def make_inputs(rng):
+        positions = np.sort(rng.choice(seq_length, max_predictions, replace=False))
+        return [rng.randint(0, config.vocab_size, [batch_size, seq_length]).astype(np.int32),
+                np.ones([batch_size, seq_length]).astype(np.int32),
+                rng.randint(0, 2, [batch_size, seq_length]).astype(np.int32),
+                rng.randint(0, 2, [batch_size, 1]).astype(np.int32),
+                np.tile(positions, [batch_size, 1]).astype(np.int32),
+                rng.randint(0, config.vocab_size, [batch_size, max_predictions]).astype(np.int32),
+                np.ones([batch_size, max_predictions]).astype(np.float32)]
+
+    return Model("bert_base", make_net, make_inputs)
+
+
+def _lstm(batch_size, seq_length=64, input_size=256, hidden_size=512, num_layers=2, num_classes=10):
+    return Model("lstm",
+                 lambda: _classifier_train_net(
+                     _LSTMClassifier(batch_size, input_size, hidden_size, num_layers, num_classes)),
+                 lambda rng: [rng.uniform(-1.0, 1.0, [seq_length, batch_size, input_size]).astype(np.float32),
+                              _labels(rng, batch_size, num_classes)])
+
+
+MODELS = {"resnet50": _resnet50, "bert_base": _bert_base, "lstm": _lstm}
+
+
+def _median(steps, key):
+    return float(np.median([step[key] for step in steps])) if steps else 0.0
+
+
+def run(model_name, device, batch_size, steps=20, warmup=3, data="synthetic", seed=1):
+    """Train the model for the steps after the warmup ones, return the throughput and the phases of the steps."""
+    context.set_context(mode=context.GRAPH_MODE, device_target=device)
+    np.random.seed(seed)
+    rng = np.random.RandomState(seed)
+    model = MODELS[model_name](batch_size)
+    net = model.make_net()
+    net.set_train()
+    inputs = [Tensor(x) for x in model.make_inputs(rng)]
+    for _ in range(warmup):
+        net(*inputs)
+
+    data_waits = []
+    context.set_context(enable_step_stats=True)
+    try:
+        for _ in range(steps):
+            start = time.perf_counter()
+            if data == "host":
+                inputs = [Tensor(x) for x in model.make_inputs(rng)]
+            data_waits.append(int((time.perf_counter() - start) * 1e6))
+            # the loss is copied to the host, so the step is done when it returns
+            net(*inputs).asnumpy()
+    finally:
+        context.set_context(enable_step_stats=False)
+
+    step_stats = get_step_stats()
+    if len(step_stats) != steps:
+        raise RuntimeError("Recorded {} steps of {} runs".format(len(step_stats), steps))
+    records = []
+    for step, data_wait in zip(step_stats, data_waits):
+        record = {phase: int(step[phase]) for phase in PHASES}
+        record["data_wait"] += data_wait
+        record["total"] = int(step["total"]) + data_wait
+        records.append(record)
+    total_us = _median(records, "total")
+    return {
+        "model": model_name,
+        "device": device,
+        "batch_size": batch_size,
+        "data": data,
+        "seed": seed,
+        "samples_per_sec": batch_size / max(total_us, 1.0) * 1e6,
+        "phases_us": dict({phase: _median(records, phase) for phase in PHASES}, total=total_us),
+        "steps": records,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmarks of the training throughput")
+    parser.add_argument("--model", type=str, default="resnet50", choices=sorted(MODELS.keys()))
+    parser.add_argument("--device", type=str, default="GPU", choices=["CPU", "GPU", "Ascend"])
+    parser.add_argument("--batch_size", type=int, default=32)
+    parser.add_argument("--steps", type=int, default=20, help="the timed steps, the medians of them are reported")
+    parser.add_argument("--warmup", type=int, default=3, help="the steps before the timed ones, compiling the graph")
+    parser.add_argument("--data", type=str, default="synthetic", choices=["synthetic", "host"],
+                        help="the same batch for every step, or a new batch made on the host for each step")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--output", type=str, default="", help="the json file of the result")
+    args = parser.parse_args()
+
+    result = run(args.model, args.device, args.batch_size, args.steps, args.warmup, args.data, args.seed)
+    print("{} on {}, batch size {}: {:.1f} samples/s".format(result["model"], result["device"], result["batch_size"],
+                                                            result["samples_per_sec"]))
+    for phase in PHASES + ["total"]:
+        print("{:<16}{:>14.1f} us".format(phase, result["phases_us"][phase]))
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(result, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
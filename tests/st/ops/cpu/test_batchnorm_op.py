@@ -0,0 +1,67 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore import Tensor
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetBatchNorm(nn.Cell):
+    def __init__(self, is_training):
+        super(NetBatchNorm, self).__init__()
+        self.bn = P.BatchNorm(is_training=is_training, epsilon=1e-5)
+
+    def construct(self, x, scale, offset, mean, variance):
+        return self.bn(x, scale, offset, mean, variance)[0]
+
+
+def expect_output(x, scale, offset, mean, variance):
+    shape = (1, -1, 1, 1)
+    return (x - mean.reshape(shape)) / np.sqrt(variance.reshape(shape) + 1e-5) * scale.reshape(shape) + \
+        offset.reshape(shape)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_batchnorm_inference():
+    np.random.seed(1)
+    x = np.random.randn(2, 3, 4, 4).astype(np.float32)
+    scale = np.random.rand(3).astype(np.float32)
+    offset = np.random.randn(3).astype(np.float32)
+    mean = np.random.randn(3).astype(np.float32)
+    variance = np.random.rand(3).astype(np.float32) + 0.5
+    output = NetBatchNorm(False)(Tensor(x), Tensor(scale), Tensor(offset), Tensor(mean), Tensor(variance))
+    expect = expect_output(x, scale, offset, mean, variance)
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_batchnorm_training():
+    np.random.seed(2)
+    x = np.random.randn(2, 3, 4, 4).astype(np.float32)
+    scale = np.random.rand(3).astype(np.float32)
+    offset = np.random.randn(3).astype(np.float32)
+    zeros = np.zeros(3).astype(np.float32)
+    output = NetBatchNorm(True)(Tensor(x), Tensor(scale), Tensor(offset), Tensor(zeros), Tensor(zeros))
+    expect = expect_output(x, scale, offset, x.mean(axis=(0, 2, 3)), x.var(axis=(0, 2, 3)))
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-4)
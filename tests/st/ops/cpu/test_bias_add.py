@@ -51,3 +51,17 @@ def test_bias_add2():
     expect_output = np.ones([2,3]).astype(np.float32)*2
     print(output)
     assert np.all(output.asnumpy()==expect_output), "bias_add execute failed, please check current code commit"
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_bias_add_large():
+    x = np.random.randn(8, 37, 23, 29).astype(np.float32)
+    b = np.random.randn(37).astype(np.float32)
+    bias_add = Net()
+    output = bias_add(Tensor(x), Tensor(b))
+    expect_output = x + b.reshape(1, 37, 1, 1)
+    assert np.allclose(output.asnumpy(), expect_output), "bias_add execute failed, please check current code commit"
+    x = np.random.randn(1027, 37).astype(np.float32)
+    output = bias_add(Tensor(x), Tensor(b))
+    assert np.allclose(output.asnumpy(), x + b), "bias_add execute failed, please check current code commit"
@@ -50,3 +50,18 @@ def test_bias_add_grad2():
     expect_output = np.array([32.,32.,32.]).astype(np.float32)
     print(output.asnumpy())
     assert np.all(output.asnumpy()==expect_output), "bias_add_grad execute failed, please check current code commit"
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_bias_add_grad_large():
+    dout = np.random.randn(8, 37, 23, 29).astype(np.float32)
+    bias_add_grad = Net()
+    output = bias_add_grad(Tensor(dout))
+    expect_output = np.sum(dout, axis=(0, 2, 3))
+    assert np.allclose(output.asnumpy(), expect_output, rtol=1e-4, atol=1e-3), \
+        "bias_add_grad execute failed, please check current code commit"
+    dout = np.random.randn(1027, 37).astype(np.float32)
+    output = bias_add_grad(Tensor(dout))
+    assert np.allclose(output.asnumpy(), np.sum(dout, axis=0), rtol=1e-4, atol=1e-3), \
+        "bias_add_grad execute failed, please check current code commit"
@@ -0,0 +1,45 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore import Tensor
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetConcat(nn.Cell):
+    def __init__(self, axis):
+        super(NetConcat, self).__init__()
+        self.concat = P.Concat(axis)
+
+    def construct(self, x, y, z):
+        return self.concat((x, y, z))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_concat():
+    np.random.seed(1)
+    for axis in [0, 1, -1]:
+        x = np.random.randn(2, 3, 4, 5).astype(np.float32)
+        y = np.random.randn(2, 3, 4, 5).astype(np.float32)
+        z = np.random.randn(2, 3, 4, 5).astype(np.float32)
+        output = NetConcat(axis)(Tensor(x), Tensor(y), Tensor(z))
+        assert (output.asnumpy() == np.concatenate((x, y, z), axis)).all()
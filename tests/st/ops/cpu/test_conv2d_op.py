@@ -72,3 +72,29 @@ def test_conv2d():
                          [198, 210, 222]]]]).astype(np.float32)
     print(output)
     assert (output.asnumpy() == expect).all()
+
+
+class NetConv2dTwice(nn.Cell):
+    def __init__(self):
+        super(NetConv2dTwice, self).__init__()
+        self.conv = P.Conv2D(out_channel=2, kernel_size=1, mode=1, pad_mode="valid", pad=0, stride=1, dilation=1,
+                             group=1)
+        self.mul = P.Mul()
+
+    def construct(self, x, w0, w1):
+        return self.mul(self.conv(x, w0), self.conv(x, w1))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv2d_same_primitive():
+    # the convs of the same shapes share the cached primitive, and keep their own data
+    x = np.arange(1 * 3 * 3 * 3).reshape(1, 3, 3, 3).astype(np.float32)
+    w0 = np.arange(2 * 3 * 1 * 1).reshape(2, 3, 1, 1).astype(np.float32)
+    w1 = np.ones([2, 3, 1, 1]).astype(np.float32)
+    output = NetConv2dTwice()(Tensor(x), Tensor(w0), Tensor(w1))
+    expect = np.tensordot(w0[:, :, 0, 0], x[0], axes=1) * np.tensordot(w1[:, :, 0, 0], x[0], axes=1)
+    assert (output.asnumpy() == expect[np.newaxis]).all()
+    output = NetConv2d()()
+    assert (output.asnumpy() == np.tensordot(w0[:, :, 0, 0], x[0], axes=1)[np.newaxis]).all()
@@ -0,0 +1,63 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore import Tensor
+import mindspore.context as context
+
+
+class NetConvMatMul(nn.Cell):
+    def __init__(self, conv_weight, matmul_weight):
+        super(NetConvMatMul, self).__init__()
+        self.conv = P.Conv2D(out_channel=8, kernel_size=3, mode=1, pad_mode="valid", pad=0, stride=1, dilation=1,
+                             group=1)
+        self.relu = P.ReLU()
+        self.reshape = P.Reshape()
+        self.matmul = P.MatMul(transpose_b=True)
+        self.conv_weight = Tensor(conv_weight)
+        self.matmul_weight = Tensor(matmul_weight)
+
+    def construct(self, x):
+        y = self.relu(self.conv(x, self.conv_weight))
+        return self.matmul(self.reshape(y, (2, -1)), self.matmul_weight)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_int8_conv_matmul():
+    np.random.seed(1)
+    conv_weight = np.random.randn(8, 4, 3, 3).astype(np.float32) * 0.2
+    matmul_weight = np.random.randn(10, 8 * 6 * 6).astype(np.float32) * 0.1
+    inputs = [np.random.randn(2, 4, 8, 8).astype(np.float32) for _ in range(4)]
+
+    context.set_context(mode=context.GRAPH_MODE, device_target='CPU', cpu_int8_calibration_steps=0)
+    float_net = NetConvMatMul(conv_weight, matmul_weight)
+    expects = [float_net(Tensor(x)).asnumpy() for x in inputs]
+
+    context.set_context(cpu_int8_calibration_steps=2)
+    int8_net = NetConvMatMul(conv_weight, matmul_weight)
+    for i, x in enumerate(inputs):
+        output = int8_net(Tensor(x)).asnumpy()
+        if i < 2:
+            # the calibration launches run in float
+            assert np.allclose(output, expects[i], rtol=1e-4, atol=1e-4)
+        else:
+            error = np.abs(output - expects[i]).max() / np.abs(expects[i]).max()
+            assert error < 0.05
+    context.set_context(cpu_int8_calibration_steps=0)
@@ -0,0 +1,61 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore import Tensor
+import mindspore.context as context
+
+
+class MultiTowerNet(nn.Cell):
+    def __init__(self, weights):
+        super(MultiTowerNet, self).__init__()
+        self.matmul = P.MatMul()
+        self.relu = P.ReLU()
+        self.mul = P.Mul()
+        self.weights = [Tensor(w) for w in weights]
+
+    def construct(self, x):
+        tower0 = self.relu(self.matmul(x, self.weights[0]))
+        tower1 = self.relu(self.matmul(x, self.weights[1]))
+        tower2 = self.relu(self.matmul(x, self.weights[2]))
+        tower3 = self.relu(self.matmul(x, self.weights[3]))
+        return self.mul(self.mul(tower0, tower1), self.mul(tower2, tower3))
+
+
+def expect_output(x, weights):
+    out = np.ones([x.shape[0], weights[0].shape[1]]).astype(np.float32)
+    for w in weights:
+        out = out * np.maximum(np.matmul(x, w), 0)
+    return out
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_inter_op_threads():
+    np.random.seed(1)
+    x = np.random.randn(32, 64).astype(np.float32)
+    weights = [np.random.randn(64, 16).astype(np.float32) for _ in range(4)]
+    expect = expect_output(x, weights)
+    for thread_num in [1, 4]:
+        context.set_context(mode=context.GRAPH_MODE, device_target="CPU", cpu_inter_op_threads=thread_num)
+        net = MultiTowerNet(weights)
+        for _ in range(3):
+            output = net(Tensor(x))
+            assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-4)
+    context.set_context(cpu_inter_op_threads=1)
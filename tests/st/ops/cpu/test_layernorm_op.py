@@ -0,0 +1,49 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore import Tensor
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetLayerNorm(nn.Cell):
+    def __init__(self, begin_norm_axis, begin_params_axis):
+        super(NetLayerNorm, self).__init__()
+        self.layer_norm = P.LayerNorm(begin_norm_axis, begin_params_axis)
+
+    def construct(self, x, gamma, beta):
+        return self.layer_norm(x, gamma, beta)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_layernorm():
+    np.random.seed(1)
+    x = np.random.randn(4, 8, 16).astype(np.float32)
+    gamma = np.random.randn(8, 16).astype(np.float32)
+    beta = np.random.randn(8, 16).astype(np.float32)
+    y, mean, variance = NetLayerNorm(1, 1)(Tensor(x), Tensor(gamma), Tensor(beta))
+    expect_mean = x.mean(axis=(1, 2), keepdims=True)
+    expect_variance = x.var(axis=(1, 2), keepdims=True)
+    expect_y = (x - expect_mean) / np.sqrt(expect_variance + 1e-12) * gamma + beta
+    assert np.allclose(y.asnumpy(), expect_y, rtol=1e-4, atol=1e-4)
+    assert np.allclose(mean.asnumpy(), expect_mean, rtol=1e-4, atol=1e-4)
+    assert np.allclose(variance.asnumpy(), expect_variance, rtol=1e-4, atol=1e-4)
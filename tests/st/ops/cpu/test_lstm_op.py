@@ -0,0 +1,112 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore import Tensor
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetLstm(nn.Cell):
+    def __init__(self, input_size, hidden_size, num_layers, has_bias, bidirectional):
+        super(NetLstm, self).__init__()
+        self.lstm = P.LSTM(input_size=input_size, hidden_size=hidden_size, num_layers=num_layers,
+                           has_bias=has_bias, bidirectional=bidirectional, dropout=0.0)
+
+    def construct(self, x, h, c, w):
+        return self.lstm(x, h, c, w)
+
+
+def sigmoid(x):
+    return 1 / (1 + np.exp(-x))
+
+
+def lstm_direction(x, h, c, w_ih, w_hh, bias, reverse):
+    """the lstm of one direction of one layer, the gates are in the order i, f, g, o"""
+    hidden_size = h.shape[1]
+    steps = range(x.shape[0] - 1, -1, -1) if reverse else range(x.shape[0])
+    y = np.zeros((x.shape[0], x.shape[1], hidden_size)).astype(np.float32)
+    for t in steps:
+        gates = np.matmul(x[t], w_ih.T) + np.matmul(h, w_hh.T) + bias
+        i = sigmoid(gates[:, :hidden_size])
+        f = sigmoid(gates[:, hidden_size:2 * hidden_size])
+        g = np.tanh(gates[:, 2 * hidden_size:3 * hidden_size])
+        o = sigmoid(gates[:, 3 * hidden_size:])
+        c = f * c + i * g
+        h = o * np.tanh(c)
+        y[t] = h
+    return y, h, c
+
+
+def expect_output(x, h, c, w, num_layers, has_bias, num_directions):
+    hidden_size = h.shape[2]
+    gate_size = 4 * hidden_size
+    offset = 0
+    hy = np.zeros(h.shape).astype(np.float32)
+    cy = np.zeros(c.shape).astype(np.float32)
+    for layer in range(num_layers):
+        outputs = []
+        for d in range(num_directions):
+            input_size = x.shape[2]
+            w_ih = w[offset:offset + gate_size * input_size].reshape(gate_size, input_size)
+            offset += gate_size * input_size
+            w_hh = w[offset:offset + gate_size * hidden_size].reshape(gate_size, hidden_size)
+            offset += gate_size * hidden_size
+            bias = np.zeros(gate_size).astype(np.float32)
+            if has_bias:
+                bias = w[offset:offset + gate_size] + w[offset + gate_size:offset + 2 * gate_size]
+                offset += 2 * gate_size
+            index = layer * num_directions + d
+            y, hy[index], cy[index] = lstm_direction(x, h[index], c[index], w_ih, w_hh, bias, d == 1)
+            outputs.append(y)
+        x = np.concatenate(outputs, axis=2)
+    return x, hy, cy
+
+
+def run_lstm(seq_len, batch, input_size, hidden_size, num_layers, has_bias, bidirectional):
+    num_directions = 2 if bidirectional else 1
+    gate_size = 4 * hidden_size
+    weight_size = num_layers * num_directions * gate_size * (input_size + hidden_size + (2 if has_bias else 0))
+    x = np.random.randn(seq_len, batch, input_size).astype(np.float32)
+    h = np.random.randn(num_layers * num_directions, batch, hidden_size).astype(np.float32)
+    c = np.random.randn(num_layers * num_directions, batch, hidden_size).astype(np.float32)
+    w = (np.random.randn(weight_size) * 0.1).astype(np.float32)
+    net = NetLstm(input_size, hidden_size, num_layers, has_bias, bidirectional)
+    y, hy, cy, _, _ = net(Tensor(x), Tensor(h), Tensor(c), Tensor(w.reshape(weight_size, 1, 1)))
+    expect_y, expect_hy, expect_cy = expect_output(x, h, c, w, num_layers, has_bias, num_directions)
+    assert np.allclose(y.asnumpy(), expect_y, rtol=1e-4, atol=1e-4)
+    assert np.allclose(hy.asnumpy(), expect_hy, rtol=1e-4, atol=1e-4)
+    assert np.allclose(cy.asnumpy(), expect_cy, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_lstm():
+    np.random.seed(1)
+    run_lstm(5, 2, 3, 4, 1, True, False)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_lstm_bidirectional_layers():
+    np.random.seed(2)
+    run_lstm(4, 3, 8, 4, 2, True, True)
+    run_lstm(4, 3, 6, 3, 1, False, True)
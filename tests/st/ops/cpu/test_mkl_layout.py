@@ -0,0 +1,89 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore import Tensor
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetLayoutChain(nn.Cell):
+    """the mkl kernels keep the blocked layouts between them, the graph output is in the plain one"""
+    def __init__(self, weights, scale, offset, mean, variance):
+        super(NetLayoutChain, self).__init__()
+        self.conv = P.Conv2D(out_channel=16, kernel_size=3, mode=1, pad_mode="valid", pad=0, stride=1, dilation=1,
+                             group=1)
+        self.bn = P.BatchNorm(is_training=False, epsilon=1e-5)
+        self.relu = P.ReLU()
+        self.maxpool = P.MaxPool(ksize=2, strides=2, padding="VALID")
+        self.add = P.TensorAdd()
+        self.concat = P.Concat(1)
+        self.w0 = Tensor(weights[0])
+        self.w1 = Tensor(weights[1])
+        self.scale = Tensor(scale)
+        self.offset = Tensor(offset)
+        self.mean = Tensor(mean)
+        self.variance = Tensor(variance)
+
+    def construct(self, x):
+        y0 = self.conv(x, self.w0)
+        y0 = self.relu(self.bn(y0, self.scale, self.offset, self.mean, self.variance)[0])
+        y1 = self.relu(self.conv(x, self.w1))
+        out = self.add(y0, y1)
+        return self.maxpool(self.concat((out, y1)))
+
+
+def conv2d(x, w):
+    n, _, h, wd = x.shape
+    out_channel, _, kh, kw = w.shape
+    out = np.zeros((n, out_channel, h - kh + 1, wd - kw + 1)).astype(np.float32)
+    for i in range(h - kh + 1):
+        for j in range(wd - kw + 1):
+            patch = x[:, :, i:i + kh, j:j + kw]
+            out[:, :, i, j] = np.tensordot(patch, w, axes=([1, 2, 3], [1, 2, 3]))
+    return out
+
+
+def maxpool2x2(x):
+    n, c, h, w = x.shape
+    return x[:, :, :h // 2 * 2, :w // 2 * 2].reshape(n, c, h // 2, 2, w // 2, 2).max(axis=(3, 5))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_mkl_layout_chain():
+    np.random.seed(1)
+    x = np.random.randn(2, 8, 10, 10).astype(np.float32)
+    weights = [np.random.randn(16, 8, 3, 3).astype(np.float32) * 0.1 for _ in range(2)]
+    scale = np.random.rand(16).astype(np.float32)
+    offset = np.random.randn(16).astype(np.float32)
+    mean = np.random.randn(16).astype(np.float32)
+    variance = np.random.rand(16).astype(np.float32) + 0.5
+    net = NetLayoutChain(weights, scale, offset, mean, variance)
+    output = net(Tensor(x))
+
+    shape = (1, -1, 1, 1)
+    y0 = conv2d(x, weights[0])
+    y0 = (y0 - mean.reshape(shape)) / np.sqrt(variance.reshape(shape) + 1e-5) * scale.reshape(shape) + \
+        offset.reshape(shape)
+    y0 = np.maximum(y0, 0)
+    y1 = np.maximum(conv2d(x, weights[1]), 0)
+    expect = maxpool2x2(np.concatenate((y0 + y1, y1), axis=1))
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-4)
@@ -0,0 +1,49 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore import Tensor
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetTensorAdd(nn.Cell):
+    def __init__(self):
+        super(NetTensorAdd, self).__init__()
+        self.add = P.TensorAdd()
+
+    def construct(self, x, y):
+        return self.add(x, y)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_tensor_add():
+    np.random.seed(1)
+    add = NetTensorAdd()
+    shapes = [((2, 3, 4, 4), (2, 3, 4, 4)),
+              ((2, 3, 4, 4), (3, 1, 1)),
+              ((1, 3, 1, 4), (2, 3, 4, 4)),
+              ((4, 5), (5,))]
+    for x_shape, y_shape in shapes:
+        x = np.random.randn(*x_shape).astype(np.float32)
+        y = np.random.randn(*y_shape).astype(np.float32)
+        output = add(Tensor(x), Tensor(y))
+        assert np.allclose(output.asnumpy(), x + y, rtol=1e-5, atol=1e-5)
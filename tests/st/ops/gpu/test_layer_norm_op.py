@@ -0,0 +1,94 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+from mindspore import Tensor
+from mindspore.ops import operations as P
+from mindspore.ops.operations import _grad_ops as G
+import mindspore.nn as nn
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target="GPU")
+
+epsilon = 1e-12
+
+
+class LayerNormNet(nn.Cell):
+    def __init__(self, begin_norm_axis, begin_params_axis):
+        super(LayerNormNet, self).__init__()
+        self.layer_norm = P.LayerNorm(begin_norm_axis, begin_params_axis)
+
+    def construct(self, x, gamma, beta):
+        return self.layer_norm(x, gamma, beta)
+
+
+class LayerNormGradNet(nn.Cell):
+    def __init__(self, begin_norm_axis, begin_params_axis):
+        super(LayerNormGradNet, self).__init__()
+        self.layer_norm_grad = G.LayerNormGrad(begin_norm_axis, begin_params_axis)
+
+    def construct(self, x, dy, variance, mean, gamma):
+        return self.layer_norm_grad(x, dy, variance, mean, gamma)
+
+
+def layer_norm_np(x, gamma, beta):
+    mean = np.mean(x, axis=-1, keepdims=True)
+    variance = np.var(x, axis=-1, keepdims=True)
+    y = (x - mean) / np.sqrt(variance + epsilon) * gamma + beta
+    return y, mean, variance
+
+
+def layer_norm_grad_np(x, dy, variance, mean, gamma):
+    rstd = 1 / np.sqrt(variance + epsilon)
+    x_hat = (x - mean) * rstd
+    g = dy * gamma
+    dx = rstd * (g - np.mean(g, axis=-1, keepdims=True) - x_hat * np.mean(g * x_hat, axis=-1, keepdims=True))
+    dgamma = np.sum(dy * x_hat, axis=0)
+    dbeta = np.sum(dy, axis=0)
+    return dx, dgamma, dbeta
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_layer_norm():
+    np.random.seed(0)
+    x = np.random.randn(64, 768).astype(np.float32)
+    gamma = np.random.randn(768).astype(np.float32)
+    beta = np.random.randn(768).astype(np.float32)
+    y, mean, variance = LayerNormNet(-1, -1)(Tensor(x), Tensor(gamma), Tensor(beta))
+    expect_y, expect_mean, expect_variance = layer_norm_np(x, gamma, beta)
+    assert np.allclose(y.asnumpy(), expect_y, rtol=1e-4, atol=1e-4)
+    assert np.allclose(mean.asnumpy(), expect_mean, rtol=1e-4, atol=1e-4)
+    assert np.allclose(variance.asnumpy(), expect_variance, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_layer_norm_grad():
+    np.random.seed(0)
+    x = np.random.randn(64, 20).astype(np.float32)
+    dy = np.random.randn(64, 20).astype(np.float32)
+    gamma = np.random.randn(20).astype(np.float32)
+    mean = np.mean(x, axis=-1, keepdims=True)
+    variance = np.var(x, axis=-1, keepdims=True)
+    dx, dgamma, dbeta = LayerNormGradNet(-1, -1)(Tensor(x), Tensor(dy), Tensor(variance), Tensor(mean),
+                                                 Tensor(gamma))
+    expect_dx, expect_dgamma, expect_dbeta = layer_norm_grad_np(x, dy, variance, mean, gamma)
+    assert np.allclose(dx.asnumpy(), expect_dx, rtol=1e-4, atol=1e-4)
+    assert np.allclose(dgamma.asnumpy(), expect_dgamma, rtol=1e-4, atol=1e-4)
+    assert np.allclose(dbeta.asnumpy(), expect_dbeta, rtol=1e-4, atol=1e-4)
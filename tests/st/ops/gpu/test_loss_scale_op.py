@@ -0,0 +1,115 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore.ops import functional as F
+from mindspore import Tensor
+from mindspore.common.parameter import Parameter
+import mindspore.common.dtype as mstype
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target="GPU")
+
+
+class NetCheckOverflow(nn.Cell):
+    def __init__(self):
+        super(NetCheckOverflow, self).__init__()
+        self.check_overflow = P.CheckOverflow()
+
+    def construct(self, x, y, z):
+        return self.check_overflow((x, y, z))
+
+
+class NetNumericStatus(nn.Cell):
+    def __init__(self):
+        super(NetNumericStatus, self).__init__()
+        self.numeric_status = P.NumericStatus()
+
+    def construct(self, x, y, z):
+        return self.numeric_status((x, y, z))
+
+
+class NetUpdateLossScale(nn.Cell):
+    def __init__(self, loss_scale, scale_factor, scale_window):
+        super(NetUpdateLossScale, self).__init__()
+        self.loss_scale = Parameter(Tensor(loss_scale, dtype=mstype.float32), name="loss_scale")
+        self.cur_iter = Parameter(Tensor(1, dtype=mstype.int32), name="current_iterator_step")
+        self.last_overflow_iter = Parameter(Tensor(0, dtype=mstype.int32), name="last_overflow_iterator_step")
+        self.update_loss_scale = P.UpdateLossScale(scale_factor, scale_window)
+
+    def construct(self, overflow):
+        output = self.update_loss_scale(self.loss_scale, self.cur_iter, self.last_overflow_iter, overflow)
+        return output, F.depend(self.loss_scale, output)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_check_overflow():
+    x = np.random.randn(16, 1024).astype(np.float32)
+    y = np.random.randn(3, 3, 64, 64).astype(np.float32)
+    z = np.random.randn(10).astype(np.float32)
+    net = NetCheckOverflow()
+    assert not net(Tensor(x), Tensor(y), Tensor(z)).asnumpy()
+
+    y[1, 2, 3, 4] = np.inf
+    assert net(Tensor(x), Tensor(y), Tensor(z)).asnumpy()
+    y[1, 2, 3, 4] = np.nan
+    assert net(Tensor(x), Tensor(y), Tensor(z)).asnumpy()
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_numeric_status():
+    x = np.random.randn(16, 1024).astype(np.float32)
+    y = np.random.randn(3, 3, 64, 64).astype(np.float32)
+    z = np.random.randn(10).astype(np.float32)
+    y[1, 2, 3, 4] = np.inf
+    y[2, 1, 0, 0] = np.nan
+    status = NetNumericStatus()(Tensor(x), Tensor(y), Tensor(z)).asnumpy()
+    assert status.shape == (3, 5)
+    for i, data in enumerate((x, y, z)):
+        finite = data[np.isfinite(data)]
+        assert status[i][0] == np.isnan(data).sum()
+        assert status[i][1] == np.isinf(data).sum()
+        assert np.allclose(status[i][2:], [finite.min(), finite.max(), finite.mean()], atol=1e-5)
+
+    check = nn.NumericCheckCell(["x", "y", "z"])
+    name, _ = check.first_non_finite(check((Tensor(x), Tensor(y), Tensor(z))))
+    assert name == "y"
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_update_loss_scale():
+    net = NetUpdateLossScale(1024.0, 2, 2)
+    no_overflow = Tensor(False, dtype=mstype.bool_)
+    overflow = Tensor(True, dtype=mstype.bool_)
+
+    output, loss_scale = net(overflow)
+    assert output.asnumpy()
+    assert loss_scale.asnumpy() == 512.0
+    # increased after 2 steps without overflow
+    output, loss_scale = net(no_overflow)
+    assert not output.asnumpy()
+    assert loss_scale.asnumpy() == 512.0
+    output, loss_scale = net(no_overflow)
+    assert not output.asnumpy()
+    assert loss_scale.asnumpy() == 1024.0
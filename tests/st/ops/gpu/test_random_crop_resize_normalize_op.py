@@ -0,0 +1,50 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+from mindspore import Tensor
+from mindspore.ops import operations as P
+import mindspore.nn as nn
+import numpy as np
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='GPU')
+
+
+class NetRandomCropResizeNormalize(nn.Cell):
+    def __init__(self):
+        super(NetRandomCropResizeNormalize, self).__init__()
+        self.augment = P.RandomCropResizeNormalize((16, 12), mean=(10.0, 20.0, 30.0), std=(2.0, 4.0, 5.0), seed=1)
+
+    def construct(self, images):
+        return self.augment(images)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_random_crop_resize_normalize():
+    # every crop of an image of constant channels has the same output
+    images = np.zeros((4, 40, 30, 3), np.uint8)
+    images[:, :, :, 0] = 20
+    images[:, :, :, 1] = 40
+    images[:, :, :, 2] = 80
+    output = NetRandomCropResizeNormalize()(Tensor(images))
+    assert output.asnumpy().shape == (4, 3, 16, 12)
+    expect = np.zeros((4, 3, 16, 12), np.float32)
+    expect[:, 0] = 5.0
+    expect[:, 1] = 5.0
+    expect[:, 2] = 10.0
+    assert np.allclose(output.asnumpy(), expect)
@@ -0,0 +1,126 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore.ops import functional as F
+from mindspore import Tensor
+from mindspore.common.parameter import Parameter
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target="GPU")
+
+
+class NetSparseApplyAdagrad(nn.Cell):
+    def __init__(self, var, accum, lr):
+        super(NetSparseApplyAdagrad, self).__init__()
+        self.var = Parameter(Tensor(var), name="var")
+        self.accum = Parameter(Tensor(accum), name="accum")
+        self.sparse_apply_adagrad = P.SparseApplyAdagrad(lr)
+
+    def construct(self, grad, indices):
+        output = self.sparse_apply_adagrad(self.var, self.accum, grad, indices)
+        return F.depend(self.var, output), F.depend(self.accum, output)
+
+
+class EmbeddingLoss(nn.Cell):
+    def __init__(self):
+        super(EmbeddingLoss, self).__init__()
+        self.square = P.Square()
+        self.reduce_sum = P.ReduceSum()
+
+    def construct(self, embeddings, label):
+        return self.reduce_sum(self.square(embeddings - label), ())
+
+
+class EmbeddingSparseTrain(nn.Cell):
+    """The gradient of the embedding table is taken by the one of the looked up rows, the values of the sparse
+    gradient, with the indices of the lookup"""
+    def __init__(self, table, lr):
+        super(EmbeddingSparseTrain, self).__init__()
+        self.table = Parameter(Tensor(table), name="table")
+        self.accum = Parameter(Tensor(np.full(table.shape, 0.1, np.float32)), name="accum")
+        self.gather = P.GatherV2()
+        self.loss = EmbeddingLoss()
+        self.grad = P.GradOperation('grad')
+        self.sparse_apply_adagrad = P.SparseApplyAdagrad(lr)
+
+    def construct(self, indices, label):
+        embeddings = self.gather(self.table, indices, 0)
+        values = self.grad(self.loss)(embeddings, label)
+        output = self.sparse_apply_adagrad(self.table, self.accum, values, indices)
+        return F.depend(self.table, output)
+
+
+def sparse_apply_adagrad_expect(var, accum, lr, grad, indices):
+    # the values of the same row are summed up before the update, as the dense gradient does
+    var = var.copy()
+    accum = accum.copy()
+    dense_grad = np.zeros_like(var)
+    np.add.at(dense_grad, indices, grad)
+    rows = np.unique(indices)
+    accum[rows] += dense_grad[rows] * dense_grad[rows]
+    var[rows] -= lr * dense_grad[rows] / np.sqrt(accum[rows])
+    return var, accum
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_sparse_apply_adagrad():
+    var = np.random.randn(20, 3, 4).astype(np.float32)
+    accum = np.random.rand(20, 3, 4).astype(np.float32) + 0.1
+    grad = np.random.randn(5, 3, 4).astype(np.float32)
+    indices = np.array([7, 0, 19, 3, 11], dtype=np.int32)
+    net = NetSparseApplyAdagrad(var, accum, 0.01)
+    var_out, accum_out = net(Tensor(grad), Tensor(indices))
+    expect_var, expect_accum = sparse_apply_adagrad_expect(var, accum, 0.01, grad, indices)
+    assert np.allclose(var_out.asnumpy(), expect_var, rtol=1e-5, atol=1e-5)
+    assert np.allclose(accum_out.asnumpy(), expect_accum, rtol=1e-5, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_sparse_apply_adagrad_repeated_indices():
+    var = np.random.randn(10, 8).astype(np.float32)
+    accum = np.random.rand(10, 8).astype(np.float32) + 0.1
+    grad = np.random.randn(7, 8).astype(np.float32)
+    indices = np.array([4, 1, 4, 4, 9, 1, 0], dtype=np.int32)
+    net = NetSparseApplyAdagrad(var, accum, 0.1)
+    var_out, accum_out = net(Tensor(grad), Tensor(indices))
+    expect_var, expect_accum = sparse_apply_adagrad_expect(var, accum, 0.1, grad, indices)
+    assert np.allclose(var_out.asnumpy(), expect_var, rtol=1e-5, atol=1e-5)
+    assert np.allclose(accum_out.asnumpy(), expect_accum, rtol=1e-5, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_embedding_sparse_train():
+    table = np.random.randn(1000, 16).astype(np.float32)
+    indices = np.array([[3, 999, 3], [0, 512, 3]], dtype=np.int32)
+    label = np.random.randn(2, 3, 16).astype(np.float32)
+    net = EmbeddingSparseTrain(table, 0.05)
+    expect_table = table
+    expect_accum = np.full(table.shape, 0.1, np.float32)
+    for _ in range(3):
+        values = 2 * (expect_table[indices] - label)
+        expect_table, expect_accum = sparse_apply_adagrad_expect(expect_table, expect_accum, 0.05,
+                                                                 values.reshape(-1, 16), indices.reshape(-1))
+        output = net(Tensor(indices.reshape(-1)), Tensor(label.reshape(-1, 16)))
+    assert np.allclose(output.asnumpy(), expect_table, rtol=1e-4, atol=1e-4)
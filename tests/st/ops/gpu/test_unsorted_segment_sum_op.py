@@ -0,0 +1,94 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+from mindspore import Tensor
+from mindspore.ops import operations as P
+import mindspore.nn as nn
+import numpy as np
+import mindspore.context as context
+
+
+class UnsortedSegmentSumNet(nn.Cell):
+    def __init__(self, num_segments):
+        super(UnsortedSegmentSumNet, self).__init__()
+        self.unsorted_segment_sum = P.UnsortedSegmentSum()
+        self.num_segments = num_segments
+
+    def construct(self, x, segment_ids):
+        return self.unsorted_segment_sum(x, segment_ids, self.num_segments)
+
+
+class GatherNet(nn.Cell):
+    def __init__(self):
+        super(GatherNet, self).__init__()
+        self.gather = P.GatherV2()
+
+    def construct(self, x, indices):
+        return self.gather(x, indices, 0)
+
+
+class GatherGradNet(nn.Cell):
+    def __init__(self, network):
+        super(GatherGradNet, self).__init__()
+        self.grad = P.GradOperation('grad', get_all=True, sens_param=True)
+        self.network = network
+
+    def construct(self, x, indices, dout):
+        return self.grad(self.network)(x, indices, dout)
+
+
+def unsorted_segment_sum_expect(x, segment_ids, num_segments):
+    expect = np.zeros((num_segments,) + x.shape[segment_ids.ndim:], x.dtype)
+    for i, segment in enumerate(segment_ids.reshape(-1)):
+        if 0 <= segment < num_segments:
+            expect[segment] += x.reshape((-1,) + x.shape[segment_ids.ndim:])[i]
+    return expect
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_unsorted_segment_sum():
+    context.set_context(mode=context.GRAPH_MODE, device_target="GPU")
+    x = np.arange(6 * 4, dtype=np.float32).reshape(6, 4)
+    segment_ids = np.array([3, 0, 3, -1, 7, 1], dtype=np.int32)
+    output = UnsortedSegmentSumNet(5)(Tensor(x), Tensor(segment_ids))
+    assert np.allclose(output.asnumpy(), unsorted_segment_sum_expect(x, segment_ids, 5))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_unsorted_segment_sum_2d_ids():
+    context.set_context(mode=context.GRAPH_MODE, device_target="GPU")
+    x = np.arange(2 * 3 * 5, dtype=np.int32).reshape(2, 3, 5)
+    segment_ids = np.array([[1, 1, 0], [2, 1, 0]], dtype=np.int32)
+    output = UnsortedSegmentSumNet(4)(Tensor(x), Tensor(segment_ids))
+    assert (output.asnumpy() == unsorted_segment_sum_expect(x, segment_ids, 4)).all()
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_gather_grad():
+    context.set_context(mode=context.GRAPH_MODE, device_target="GPU")
+    x = np.random.randn(10, 8).astype(np.float32)
+    indices = np.array([2, 5, 2, 9, 0, 2], dtype=np.int32)
+    dout = np.random.randn(6, 8).astype(np.float32)
+    dx, _ = GatherGradNet(GatherNet())(Tensor(x), Tensor(indices), Tensor(dout))
+    expect = np.zeros_like(x)
+    np.add.at(expect, indices, dout)
+    assert np.allclose(dx.asnumpy(), expect, rtol=1e-5, atol=1e-5)
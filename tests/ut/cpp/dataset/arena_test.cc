@@ -17,6 +17,9 @@
 #include <string>
 #include "dataset/util/arena.h"
 #include "common/common.h"
+#include "dataset/core/global_context.h"
+#include "dataset/core/tensor.h"
+#include "dataset/util/scratch_pool.h"
 #include "dataset/util/de_error.h"
 #include "utils/log_adapter.h"
 
@@ -47,3 +50,39 @@ TEST_F(MindDataTestArena, TestALLFunction) {
   }
   MS_LOG(DEBUG) << *mp;
 }
+
+TEST_F(MindDataTestArena, TestScratchPool) {
+  std::shared_ptr<ScratchPool> pool;
+  Status rc = ScratchPool::CreateScratchPool(&pool, 1, GlobalContext::Instance()->mem_pool());
+  ASSERT_TRUE(rc.IsOk());
+  EXPECT_EQ(ScratchPool::ThreadPool(), nullptr);
+
+  // A block too big for the arena comes from the fallback pool
+  void *small = nullptr;
+  void *big = nullptr;
+  ASSERT_TRUE(pool->Allocate(1024, &small));
+  ASSERT_TRUE(pool->Allocate(2 * 1048576, &big));
+  EXPECT_LT(pool->PercentFree(), 100);
+  pool->Deallocate(big);
+  pool->Deallocate(small);
+  EXPECT_EQ(pool->PercentFree(), 100);
+
+  {
+    // The tensors created in the scope take their data from the pool, and keep it alive
+    MemoryPoolScope scope(pool);
+    EXPECT_EQ(ScratchPool::ThreadPool(), pool);
+    std::shared_ptr<Tensor> t;
+    rc = Tensor::CreateTensor(&t, TensorImpl::kFlexible, TensorShape({64, 64, 3}), DataType(DataType::DE_UINT8));
+    ASSERT_TRUE(rc.IsOk());
+    EXPECT_NE(t->StartAddr(), nullptr);
+    EXPECT_LT(pool->PercentFree(), 100);
+    t.reset();
+    EXPECT_EQ(pool->PercentFree(), 100);
+    {
+      MemoryPoolScope global_scope(nullptr);
+      EXPECT_EQ(ScratchPool::ThreadPool(), nullptr);
+    }
+    EXPECT_EQ(ScratchPool::ThreadPool(), pool);
+  }
+  EXPECT_EQ(ScratchPool::ThreadPool(), nullptr);
+}
@@ -17,6 +17,8 @@
 #include <memory>
 #include <string>
 #include "dataset/core/client.h"
+#include "dataset/engine/datasetops/batch_slot_pool.h"
+#include "dataset/kernels/data/data_utils.h"
 #include "common/common.h"
 #include "common/utils.h"
 #include "gtest/gtest.h"
@@ -325,3 +327,56 @@ TEST_F(MindDataTestBatchOp, TestBatchDropTrueRepeat) {
   }
   EXPECT_EQ(success, true);
 }
+
+TEST_F(MindDataTestBatchOp, TestBatchSlotPool) {
+  BatchSlotPool pool(4);
+  std::vector<TensorShape> shapes = {TensorShape({2})};
+  std::vector<DataType> types = {DataType(DataType::DE_FLOAT32)};
+
+  // The rows of a batch get lined up views of the same batch tensor
+  TensorRow row0, row1, row2;
+  EXPECT_TRUE(pool.GetSlots(0, shapes, types, &row0).IsOk());
+  EXPECT_TRUE(pool.GetSlots(1, shapes, types, &row1).IsOk());
+  ASSERT_EQ(row0.size(), 1);
+  ASSERT_EQ(row1.size(), 1);
+  std::shared_ptr<Tensor> base = row0[0]->view_base();
+  ASSERT_NE(base, nullptr);
+  EXPECT_EQ(base->shape(), TensorShape({4, 2}));
+  EXPECT_EQ(row1[0]->view_base(), base);
+  EXPECT_EQ(row1[0]->StartAddr(), row0[0]->StartAddr() + 2 * sizeof(float));
+
+  // A row which does not match the batch gets no slot
+  EXPECT_TRUE(pool.GetSlots(2, {TensorShape({3})}, types, &row2).IsOk());
+  EXPECT_TRUE(row2.empty());
+
+  // The epoch ends after 5 rows, the next epoch starts on a new batch
+  EXPECT_EQ(pool.EndOfEpoch(5), 8);
+  EXPECT_EQ(pool.EndOfEpoch(8), 8);
+}
+
+TEST_F(MindDataTestBatchOp, TestBatchPad) {
+  std::vector<int32_t> long_row = {1, 2};
+  std::vector<int32_t> short_row = {3};
+  std::shared_ptr<Tensor> t0, t1, batched;
+  ASSERT_TRUE(Tensor::CreateTensor(&t0, TensorImpl::kFlexible, TensorShape({2}), DataType(DataType::DE_INT32),
+                                   reinterpret_cast<unsigned char *>(long_row.data())).IsOk());
+  ASSERT_TRUE(Tensor::CreateTensor(&t1, TensorImpl::kFlexible, TensorShape({1}), DataType(DataType::DE_INT32),
+                                   reinterpret_cast<unsigned char *>(short_row.data())).IsOk());
+
+  // The unknown dim is padded to the longest row
+  ASSERT_TRUE(BatchPad({t0, t1}, TensorShape::CreateUnknownShapeWithRank(1), -1, &batched).IsOk());
+  EXPECT_EQ(batched->shape(), TensorShape({2, 2}));
+  std::vector<int32_t> expected = {1, 2, 3, -1};
+  int32_t value = 0;
+  for (dsize_t i = 0; i < 4; i++) {
+    EXPECT_TRUE(batched->GetItemAt<int32_t>(&value, {i / 2, i % 2}).IsOk());
+    EXPECT_EQ(value, expected[i]);
+  }
+
+  // A known dim is padded to the pad shape, the rows larger than the pad shape are rejected
+  ASSERT_TRUE(BatchPad({t0, t1}, TensorShape({3}), 0, &batched).IsOk());
+  EXPECT_EQ(batched->shape(), TensorShape({2, 3}));
+  EXPECT_TRUE(batched->GetItemAt<int32_t>(&value, {1, 2}).IsOk());
+  EXPECT_EQ(value, 0);
+  EXPECT_FALSE(BatchPad({t0, t1}, TensorShape({1}), 0, &batched).IsOk());
+}
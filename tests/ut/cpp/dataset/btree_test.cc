@@ -15,7 +15,10 @@
  */
 
 #include <sstream>
+#include <utility>
+#include <vector>
 #include "dataset/util/btree.h"
+#include "dataset/util/btree_olc.h"
 #include "dataset/util/auto_index.h"
 #include "dataset/util/system_pool.h"
 #include "dataset/util/task_manager.h"
@@ -41,6 +44,16 @@ struct mytraits {
 
 };
 
+struct myappendtraits {
+    using slot_type = uint16_t;
+
+    static const slot_type kLeafSlots = 6;
+
+    static const slot_type kInnerSlots = 3;
+
+    static const bool kAppendMode = true;
+};
+
 
 class MindDataTestBPlusTree : public UT::Common {
  public:
@@ -199,3 +212,112 @@ TEST_F(MindDataTestBPlusTree, Test3) {
     MS_LOG(DEBUG) << ai[i] << std::endl;
   }
 }
+
+// Test concurrent insert and search with optimistic lock coupling.
+TEST_F(MindDataTestBPlusTree, Test4) {
+  Allocator<std::string> alloc(std::make_shared<SystemPool>());
+  OlcBPlusTree<uint64_t, std::string, std::less<uint64_t>, mytraits> btree(alloc);
+  TaskGroup vg;
+  auto f = [&](int k) -> Status {
+    TaskManager::FindMe()->Post();
+    for (int i = 0; i < 100; i++) {
+      // Interleave the keys of the threads so that they split the same nodes
+      uint64_t key = i * 100 + k;
+      Status rc = btree.DoInsert(key, "Hello World. I am " + std::to_string(key));
+      EXPECT_TRUE(rc.IsOk());
+      // Every key inserted so far by this thread is visible
+      std::string val;
+      uint64_t lookup = (i / 2) * 100 + k;
+      EXPECT_TRUE(btree.Search(lookup, &val));
+      EXPECT_EQ(val, "Hello World. I am " + std::to_string(lookup));
+    }
+    return Status::OK();
+  };
+  for (int k = 0; k < 100; k++) {
+    vg.CreateAsyncTask("Concurrent Insert", std::bind(f, k));
+  }
+  vg.join_all();
+  EXPECT_EQ(btree.size(), 10000);
+
+  // Test iterator
+  {
+    int cnt = 0;
+    uint64_t expected = 0;
+    for (auto it = btree.begin(); it != btree.end(); ++it) {
+      EXPECT_EQ(it.key(), expected);
+      EXPECT_EQ(it.value(), "Hello World. I am " + std::to_string(expected));
+      ++expected;
+      ++cnt;
+    }
+    EXPECT_EQ(cnt, 10000);
+  }
+
+  // Test search and duplicate key
+  {
+    std::string val;
+    EXPECT_TRUE(btree.Search(5000, &val));
+    EXPECT_EQ(val, "Hello World. I am 5000");
+    EXPECT_FALSE(btree.Search(10000, &val));
+    Status rc = btree.DoInsert(100, "Expect error");
+    EXPECT_EQ(rc, Status(StatusCode::kDuplicateKey));
+    EXPECT_EQ(btree.size(), 10000);
+  }
+}
+
+// Test bulk load of sorted keys.
+TEST_F(MindDataTestBPlusTree, Test5) {
+  Allocator<std::string> alloc(std::make_shared<SystemPool>());
+  std::vector<std::pair<uint64_t, std::string>> rows;
+  for (uint64_t i = 0; i < 1000; i++) {
+    rows.emplace_back(2 * i, "Hello World. I am " + std::to_string(2 * i));
+  }
+  {
+    OlcBPlusTree<uint64_t, std::string, std::less<uint64_t>, mytraits> btree(alloc);
+    Status rc = btree.BulkLoad(rows.begin(), rows.end());
+    EXPECT_TRUE(rc.IsOk());
+    EXPECT_EQ(btree.size(), 1000);
+    // A quarter of each leaf is left for the inserts
+    EXPECT_EQ(btree.leaves(), 250);
+    rc = btree.BulkLoad(rows.begin(), rows.end());
+    EXPECT_FALSE(rc.IsOk());
+    // The odd keys go in between
+    for (uint64_t i = 0; i < 1000; i++) {
+      rc = btree.DoInsert(2 * i + 1, "Hello World. I am " + std::to_string(2 * i + 1));
+      EXPECT_TRUE(rc.IsOk());
+    }
+    uint64_t expected = 0;
+    for (auto it = btree.begin(); it != btree.end(); ++it) {
+      EXPECT_EQ(it.key(), expected);
+      ++expected;
+    }
+    EXPECT_EQ(expected, 2000);
+    std::string val;
+    EXPECT_TRUE(btree.Search(1999, &val));
+    EXPECT_EQ(val, "Hello World. I am 1999");
+  }
+  {
+    // The appended keys leave the nodes full
+    OlcBPlusTree<uint64_t, std::string, std::less<uint64_t>, myappendtraits> btree(alloc);
+    Status rc = btree.BulkLoad(rows.begin(), rows.end());
+    EXPECT_TRUE(rc.IsOk());
+    EXPECT_EQ(btree.leaves(), 167);
+    // The last leaf takes two more keys before it splits
+    for (uint64_t key = 2000; key < 2006; key += 2) {
+      rc = btree.DoInsert(key, "Hello World. I am " + std::to_string(key));
+      EXPECT_TRUE(rc.IsOk());
+    }
+    EXPECT_EQ(btree.leaves(), 168);
+    std::string val;
+    EXPECT_TRUE(btree.Search(2004, &val));
+    EXPECT_TRUE(btree.Search(0, &val));
+    EXPECT_EQ(val, "Hello World. I am 0");
+  }
+  {
+    // The keys must be sorted
+    OlcBPlusTree<uint64_t, std::string, std::less<uint64_t>, mytraits> btree(alloc);
+    std::swap(rows[10], rows[11]);
+    Status rc = btree.BulkLoad(rows.begin(), rows.end());
+    EXPECT_FALSE(rc.IsOk());
+    EXPECT_TRUE(btree.empty());
+  }
+}
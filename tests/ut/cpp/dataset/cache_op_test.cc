@@ -0,0 +1,176 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/core/client.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include <memory>
+#include <vector>
+#include <iostream>
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestCacheOp : public UT::DatasetOpTesting {
+
+};
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The first epoch fills the cache, the second one is served from it.
+//
+// Tree:  repeat over cache over storage
+//
+//    RepeatOp
+//        |
+//     CacheOp
+//        |
+//    StorageOp
+//
+TEST_F(MindDataTestCacheOp, TestCacheRepeat) {
+  Status rc;
+  MS_LOG(INFO) << "UT test TestCacheRepeat.";
+
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path;
+  dataset_path = datasets_root_path_ + "/testDataset1";
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder()
+      .SetDatasetFilesDir(dataset_path)
+      .SetRowsPerBuffer(2)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(1)
+      .Build(&my_storage_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op);
+  ASSERT_TRUE(rc.IsOk());
+  std::shared_ptr<CacheOp> my_cache_op;
+  rc = CacheOp::Builder().SetMemoryMb(16).SetRowsPerBuffer(3).Build(&my_cache_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_cache_op);
+  ASSERT_TRUE(rc.IsOk());
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  rc = RepeatOp::Builder(2).Build(&my_repeat_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_repeat_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  // Set children/root layout.
+  rc = my_cache_op->AddChild(my_storage_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_repeat_op->AddChild(my_cache_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_repeat_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  ASSERT_TRUE(rc.IsOk());
+
+  // Both epochs must give the same rows in the same order.
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  std::vector<std::string> first_epoch;
+  int row_count = 0;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  ASSERT_TRUE(rc.IsOk());
+  while (!tensor_list.empty()) {
+    std::ostringstream ss;
+    for (auto &t : tensor_list) {
+      ss << *t;
+    }
+    if (row_count < 10) {
+      first_epoch.push_back(ss.str());
+    } else {
+      EXPECT_EQ(ss.str(), first_epoch[row_count - 10]);
+    }
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    row_count++;
+  }
+  ASSERT_EQ(row_count, 20);
+}
+
+TEST_F(MindDataTestCacheOp, TestCacheBuilder) {
+  MS_LOG(INFO) << "UT test TestCacheBuilder.";
+  std::shared_ptr<CacheOp> my_cache_op;
+  Status rc = CacheOp::Builder().Build(&my_cache_op);
+  EXPECT_FALSE(rc.IsOk());
+  rc = CacheOp::Builder().SetMemoryMb(1).SetRowsPerBuffer(0).Build(&my_cache_op);
+  EXPECT_FALSE(rc.IsOk());
+}
+
+TEST_F(MindDataTestCacheOp, TestSharedCache) {
+  MS_LOG(INFO) << "UT test TestSharedCache.";
+  SharedCache::Destroy("ut_shared_cache");
+  std::unique_ptr<SharedCache> producer;
+  Status rc = SharedCache::Open("ut_shared_cache", 1, &producer);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_TRUE(producer->producer());
+  std::unique_ptr<SharedCache> reader;
+  rc = SharedCache::Open("ut_shared_cache", 1, &reader);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_FALSE(reader->producer());
+
+  rc = producer->SetColumnMap({{"col1", 0}, {"col2", 1}});
+  ASSERT_TRUE(rc.IsOk());
+  for (int64_t i = 0; i < 4; i++) {
+    std::shared_ptr<Tensor> t1;
+    std::shared_ptr<Tensor> t2;
+    rc = Tensor::CreateTensor(&t1, TensorImpl::kFlexible, TensorShape({2, 3}), DataType(DataType::DE_INT32));
+    ASSERT_TRUE(rc.IsOk());
+    rc = t1->SetItemAt<int32_t>({1, 2}, static_cast<int32_t>(i));
+    ASSERT_TRUE(rc.IsOk());
+    rc = Tensor::CreateTensor(&t2, TensorImpl::kFlexible, TensorShape({1}), DataType(DataType::DE_UINT8));
+    ASSERT_TRUE(rc.IsOk());
+    rc = producer->Publish(i, {t1, t2});
+    ASSERT_TRUE(rc.IsOk());
+  }
+  // The rows must be published in order
+  rc = producer->Publish(7, {});
+  EXPECT_FALSE(rc.IsOk());
+  producer->Seal(false);
+
+  std::unordered_map<std::string, int32_t> column_name_map;
+  rc = reader->GetColumnMap(&column_name_map);
+  ASSERT_TRUE(rc.IsOk());
+  EXPECT_EQ(column_name_map["col2"], 1);
+  TensorRow row;
+  for (int64_t i = 0; i < 4; i++) {
+    rc = reader->GetRow(i, &row);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(row.size(), 2);
+    EXPECT_EQ(row[0]->shape(), TensorShape({2, 3}));
+    int32_t v = -1;
+    rc = row[0]->GetItemAt<int32_t>(&v, {1, 2});
+    ASSERT_TRUE(rc.IsOk());
+    EXPECT_EQ(v, i);
+  }
+  // Past the last row of a sealed session
+  rc = reader->GetRow(4, &row);
+  ASSERT_TRUE(rc.IsOk());
+  EXPECT_TRUE(row.empty());
+
+  // The session is gone once both are closed, the next one to open it produces again
+  producer.reset();
+  reader.reset();
+  rc = SharedCache::Open("ut_shared_cache", 1, &producer);
+  ASSERT_TRUE(rc.IsOk());
+  EXPECT_TRUE(producer->producer());
+}
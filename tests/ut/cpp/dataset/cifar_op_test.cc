@@ -89,6 +89,38 @@ TEST_F(MindDataTestCifarOp, TestSequentialSamplerCifar10) {
   }
 }
 
+TEST_F(MindDataTestCifarOp, TestCifar10GetRow) {
+  std::string folder_path = datasets_root_path_ + "/testCifar10Data/";
+  std::shared_ptr<CifarOp> op = Cifarop(16, 2, 32, folder_path, nullptr, 100);
+  TensorRow row;
+  Status rc = op->GetRow(99, &row);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_EQ(row.size(), 2);
+  EXPECT_TRUE(row[0]->shape() == TensorShape({32, 32, 3}));
+  // GetRow sees all the rows, num_samples only limits the tree
+  int64_t num_rows = 0;
+  EXPECT_TRUE(op->GetNumRowsInDataset(&num_rows).IsOk());
+  EXPECT_TRUE(op->GetRow(num_rows - 1, &row).IsOk());
+  EXPECT_TRUE(op->GetRow(num_rows, &row).IsError());
+  auto tree = Build({op});
+  tree->Prepare();
+  rc = tree->Launch();
+  if (rc.IsError()) {
+    MS_LOG(ERROR) << "Return code error detected during tree launch: " << common::SafeCStr(rc.ToString()) << ".";
+    EXPECT_TRUE(false);
+  } else {
+    DatasetIterator di(tree);
+    TensorMap tensor_map;
+    di.GetNextAsMap(&tensor_map);
+    uint64_t i = 0;
+    while (tensor_map.size() != 0) {
+      i++;
+      di.GetNextAsMap(&tensor_map);
+    }
+    EXPECT_TRUE(i == 100);
+  }
+}
+
 TEST_F(MindDataTestCifarOp, TestRandomSamplerCifar10) {
   uint32_t original_seed = GlobalContext::config_manager()->seed();
   GlobalContext::config_manager()->set_seed(0);
@@ -15,6 +15,7 @@
  */
 
 #include <fcntl.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -50,10 +51,18 @@ public:
 
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
+  // Use the lock free backend of the Connector. Unordered implies lock free.
+  void SetLockFree(bool lock_free, bool ordered) {
+    lock_free_ = lock_free;
+    ordered_ = ordered;
+  }
+
 private:
   std::unique_ptr<TaskGroup> tg_;
   uint32_t last_input_;
   uint32_t sleep_ms_ = 0;
+  bool lock_free_ = false;
+  bool ordered_ = true;
   std::vector<uint32_t> input_;
 
   // This worker loop is to be called by a single thread. It will pop my_conn Connector
@@ -123,6 +132,28 @@ TEST_F(MindDataTestConnector, Test2) {
 
 
 
+// Test3: same as Test2 with the lock free backend.
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3.";
+  this->SetSleepMilliSec(30);
+  this->SetLockFree(true, true);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+// Test4: same as Test2 with unordered connectors. All the elements must arrive exactly once.
+TEST_F(MindDataTestConnector, Test4) {
+  MS_LOG(INFO) << "MindDataTestConnector Test4.";
+  this->SetSleepMilliSec(30);
+  this->SetLockFree(true, false);
+  Status rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
   last_input_ = 150;
@@ -178,11 +209,15 @@ Status MindDataTestConnector::Run_test_1() {
 
   auto conn1 = std::make_shared<Connector<uint32_t>>(l1_threads,  // num of producers
                                                      l2_threads,  // num of consumers
-                                                     conn1_qcap);  // the cap of each queue
+                                                     conn1_qcap,  // the cap of each queue
+                                                     lock_free_,
+                                                     ordered_);
 
   auto conn2 = std::make_shared<Connector<uint32_t>>(l2_threads,
                                                      l3_threads,
-                                                     conn2_qcap);
+                                                     conn2_qcap,
+                                                     lock_free_,
+                                                     ordered_);
 
   // Instantiating the threads in the first layer
   for (int i = 0; i < l1_threads; i++) {
@@ -242,9 +277,9 @@ Status MindDataTestConnector::SerialWorkerPull(
       GoToSleep(sleep_ms_);
     }
 
-    // Raising interrupt after it processed the last_input_.
+    // Raising interrupt after it processed the last_input_ (or everything when the connector is unordered).
     // This will trigger the MidWorkerJob threads to quit their worker loop.
-    if (res == last_input_) {
+    if ((ordered_ && res == last_input_) || output->size() == input_.size()) {
       MS_LOG(INFO) << "All data is collected.";
       tg_->interrupt_all();
       break;
@@ -295,6 +330,14 @@ Status MindDataTestConnector::MidWorkerJob(
 }
 
 Status MindDataTestConnector::ValidateOutput(const std::vector<uint32_t> &output) {
+  if (!ordered_) {
+    std::vector<uint32_t> sorted(output);
+    std::sort(sorted.begin(), sorted.end());
+    if (sorted != input_) {
+      return Status(StatusCode::kUnexpectedError, "Output vector does not contain every input exactly once.");
+    }
+    return Status::OK();
+  }
   int prev = 0;
   for (auto el : output) {
     if (prev >= el) {
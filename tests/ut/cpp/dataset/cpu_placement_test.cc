@@ -0,0 +1,69 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "dataset/util/cpu_placement.h"
+#include "dataset/util/task_manager.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestCpuPlacement : public UT::Common {
+ public:
+  MindDataTestCpuPlacement() {}
+
+  void SetUp() { Services::CreateInstance(); }
+};
+
+TEST_F(MindDataTestCpuPlacement, TestParseCpuList) {
+  std::vector<int32_t> expected = {0, 1, 2, 3, 8};
+  EXPECT_EQ(CpuPlacement::ParseCpuList("0-3,8,2"), expected);
+  EXPECT_EQ(CpuPlacement::ParseCpuList("8,0-3\n"), expected);
+  EXPECT_TRUE(CpuPlacement::ParseCpuList("").empty());
+  expected = {4};
+  EXPECT_EQ(CpuPlacement::ParseCpuList("x,4,3-1"), expected);
+  expected = {0, 8};
+  EXPECT_EQ(CpuPlacement::Exclude({0, 1, 2, 3, 8}, {1, 2, 3, 9}), expected);
+}
+
+TEST_F(MindDataTestCpuPlacement, TestNodeCpus) {
+  // Every cpu of a node is a cpu of the host
+  std::vector<int32_t> allowed = CpuPlacement::AllowedCpus();
+  ASSERT_FALSE(allowed.empty());
+  for (auto &node : CpuPlacement::NodeCpus()) {
+    EXPECT_GE(node.first, 0);
+    EXPECT_FALSE(node.second.empty());
+  }
+  EXPECT_EQ(CpuPlacement::PciDeviceNode("not a bus id"), -1);
+}
+
+TEST_F(MindDataTestCpuPlacement, TestPinCurrentThread) {
+  std::vector<int32_t> allowed = CpuPlacement::AllowedCpus();
+  ASSERT_FALSE(allowed.empty());
+  std::vector<int32_t> one = {allowed.back()};
+  Status rc = CpuPlacement::PinCurrentThread(one);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_EQ(sched_getcpu(), allowed.back());
+  rc = CpuPlacement::PinCurrentThread(allowed);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_EQ(CpuPlacement::AllowedCpus(), allowed);
+  // Nothing to do for an empty list
+  rc = CpuPlacement::PinCurrentThread({});
+  EXPECT_TRUE(rc.IsOk());
+}
@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fstream>
 #include <string>
+#include <nlohmann/json.hpp>
 #include "dataset/util/circular_pool.h"
+#include "dataset/util/cpu_placement.h"
 #include "dataset/core/client.h"
 #include "dataset/engine/execution_tree.h"
 #include "dataset/engine/datasetops/shuffle_op.h"
@@ -143,3 +146,112 @@ TEST_F(MindDataTestExecutionTree, TestExecutionTree2) {
 TEST_F(MindDataTestExecutionTree, TestExecutionTree3) {
   MS_LOG(INFO) << "Doing MindDataTestExecutionTree3.";
 }
+
+// Profile a small tree and check the summary
+TEST_F(MindDataTestExecutionTree, TestExecutionTreeProfiling) {
+  MS_LOG(INFO) << "Doing MindDataTestExecutionTreeProfiling.";
+  Status rc;
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path = datasets_root_path_ + "/testDataset1";
+  std::shared_ptr<StorageOp> my_storage_op;
+  StorageOp::Builder()
+      .SetDatasetFilesDir(dataset_path)
+      .SetRowsPerBuffer(2)
+      .SetWorkerConnectorSize(2)
+      .SetNumWorkers(2)
+      .Build(&my_storage_op);
+
+  my_tree->AssociateNode(my_storage_op);
+  my_tree->AssignRoot(my_storage_op);
+  rc = my_tree->EnableProfiling(0);
+  EXPECT_FALSE(rc.IsOk());
+  rc = my_tree->EnableProfiling(1);
+  EXPECT_TRUE(rc.IsOk());
+  ASSERT_NE(my_tree->profiler(), nullptr);
+
+  my_tree->Prepare();
+  rc = my_tree->EnableProfiling(1);
+  EXPECT_FALSE(rc.IsOk());
+  my_tree->Launch();
+
+  DatasetIterator di(my_tree);
+  TensorRow buffer;
+  int32_t row_count = 0;
+  rc = di.FetchNextTensorRow(&buffer);
+  EXPECT_TRUE(rc.IsOk());
+  while (!buffer.empty()) {
+    row_count++;
+    rc = di.FetchNextTensorRow(&buffer);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  my_tree->profiler()->Sample();
+
+  std::string json_file = "./execution_tree_profile.json";
+  rc = my_tree->profiler()->DumpJson(json_file);
+  EXPECT_TRUE(rc.IsOk());
+  std::ifstream in(json_file);
+  nlohmann::json js;
+  in >> js;
+  ASSERT_EQ(js["ops"].size(), 1);
+  EXPECT_EQ(js["ops"][0]["opType"], "StorageOp");
+  EXPECT_EQ(js["ops"][0]["rows"], row_count);
+  EXPECT_EQ(js["ops"][0]["workers"].size(), 2);
+  EXPECT_FALSE(js["timestampsMs"].empty());
+
+  rc = my_tree->profiler()->DumpChromeTrace("./execution_tree_trace.json");
+  EXPECT_TRUE(rc.IsOk());
+}
+
+TEST_F(MindDataTestExecutionTree, TestExecutionTreeCpuPlacement) {
+  MS_LOG(INFO) << "Doing MindDataTestExecutionTreeCpuPlacement.";
+  Status rc;
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path = datasets_root_path_ + "/testDataset1";
+  std::shared_ptr<StorageOp> my_storage_op;
+  StorageOp::Builder()
+      .SetDatasetFilesDir(dataset_path)
+      .SetRowsPerBuffer(2)
+      .SetWorkerConnectorSize(2)
+      .SetNumWorkers(2)
+      .Build(&my_storage_op);
+  my_tree->AssociateNode(my_storage_op);
+  my_tree->AssignRoot(my_storage_op);
+
+  std::vector<int32_t> allowed = CpuPlacement::AllowedCpus();
+  ASSERT_FALSE(allowed.empty());
+  std::string first = std::to_string(allowed[0]);
+  // Nothing to pin when the threads may run on every allowed cpu
+  rc = my_tree->SetCpuPlacement("none", "");
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(my_tree->AllTasks()->cpus().empty());
+  // No device, the threads are not bound to a node
+  rc = my_tree->SetCpuPlacement("device", "");
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_FALSE(my_tree->SetCpuPlacement("bad", "").IsOk());
+  EXPECT_FALSE(my_tree->SetCpuPlacement(first, first).IsOk());
+  if (allowed.size() > 1) {
+    rc = my_tree->SetCpuPlacement("none", first);
+    EXPECT_TRUE(rc.IsOk());
+    EXPECT_EQ(my_tree->AllTasks()->cpus().size(), allowed.size() - 1);
+  }
+  rc = my_tree->SetCpuPlacement(first, "");
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_EQ(my_tree->AllTasks()->cpus().size(), allowed.size() > 1 ? 1 : 0);
+
+  // The pinned pipeline gives the same rows
+  my_tree->Prepare();
+  my_tree->Launch();
+  DatasetIterator di(my_tree);
+  TensorRow buffer;
+  int32_t row_count = 0;
+  rc = di.FetchNextTensorRow(&buffer);
+  EXPECT_TRUE(rc.IsOk());
+  while (!buffer.empty()) {
+    row_count++;
+    rc = di.FetchNextTensorRow(&buffer);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  ASSERT_EQ(row_count, 10);
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "dataset/util/executor.h"
+#include "dataset/util/task_manager.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestExecutor : public UT::Common {
+ public:
+  MindDataTestExecutor() {}
+
+  void SetUp() { Services::CreateInstance(); }
+};
+
+TEST_F(MindDataTestExecutor, TestSubmitAndWait) {
+  Executor executor(4);
+  ASSERT_EQ(executor.num_threads(), 4);
+  std::atomic<int64_t> sum(0);
+  std::vector<std::shared_ptr<ExecutorJob>> jobs;
+  for (int64_t i = 0; i < 10000; i++) {
+    jobs.push_back(executor.Submit([&sum, i]() -> Status {
+      sum += i;
+      return Status::OK();
+    }));
+  }
+  for (auto &job : jobs) {
+    ASSERT_TRUE(job->Wait().IsOk());
+    ASSERT_TRUE(job->Done());
+  }
+  ASSERT_EQ(sum, 10000 * 9999 / 2);
+}
+
+TEST_F(MindDataTestExecutor, TestNestedJobs) {
+  // Every pool thread waits for a job it has queued, the waiting threads run the queued jobs meanwhile
+  Executor executor(2);
+  std::atomic<int64_t> count(0);
+  std::vector<std::shared_ptr<ExecutorJob>> jobs;
+  for (int i = 0; i < 100; i++) {
+    jobs.push_back(executor.Submit([&executor, &count]() -> Status {
+      auto inner = executor.Submit([&count]() -> Status {
+        count++;
+        return Status::OK();
+      });
+      return inner->Wait(false);
+    }));
+  }
+  for (auto &job : jobs) {
+    ASSERT_TRUE(job->Wait().IsOk());
+  }
+  ASSERT_EQ(count, 100);
+}
+
+TEST_F(MindDataTestExecutor, TestErrorAndCancel) {
+  Executor executor(1);
+  // The error of a job goes back to its waiter
+  auto failed = executor.Submit([]() -> Status { RETURN_STATUS_UNEXPECTED("job error"); });
+  Status rc = failed->Wait();
+  ASSERT_TRUE(rc.IsError());
+  ASSERT_EQ(rc.get_code(), StatusCode::kUnexpectedError);
+
+  // A job cancelled before it starts is skipped
+  std::atomic<bool> started(false);
+  std::atomic<bool> release(false);
+  std::atomic<bool> ran(false);
+  auto blocker = executor.Submit([&started, &release]() -> Status {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+    return Status::OK();
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+  auto skipped = executor.Submit([&ran]() -> Status {
+    ran = true;
+    return Status::OK();
+  });
+  skipped->Cancel();
+  release = true;
+  ASSERT_TRUE(blocker->Wait().IsOk());
+  ASSERT_TRUE(skipped->Wait().IsOk());
+  ASSERT_FALSE(ran);
+}
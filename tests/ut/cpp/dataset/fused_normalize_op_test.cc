@@ -0,0 +1,114 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "dataset/kernels/image/fused_normalize_op.h"
+#include "dataset/kernels/image/hwc_to_chw_op.h"
+#include "dataset/kernels/image/image_op_fusion.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/image/rescale_op.h"
+#include "dataset/core/cv_tensor.h"
+#include "utils/log_adapter.h"
+#include <opencv2/opencv.hpp>
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestFusedNormalizeOP : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedNormalizeOP() : CVOpCommon() {}
+};
+
+TEST_F(MindDataTestFusedNormalizeOP, TestOp) {
+  MS_LOG(INFO) << "Doing TestFusedNormalizeOp::TestOp.";
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+                                                std::make_shared<NormalizeOp>(0.485, 0.456, 0.406, 0.229, 0.224, 0.225),
+                                                std::make_shared<HwcToChwOp>()};
+
+  // The reference runs the ops one after the other
+  std::shared_ptr<Tensor> expected = input_tensor_;
+  for (auto &op : ops) {
+    std::shared_ptr<Tensor> out;
+    Status s = op->Compute(expected, &out);
+    EXPECT_TRUE(s.IsOk());
+    expected = out;
+  }
+
+  std::vector<std::shared_ptr<TensorOp>> fused = ops;
+  Status s = FuseImageOps(&fused);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(fused.size(), 1);
+  EXPECT_NE(std::dynamic_pointer_cast<FusedNormalizeOp>(fused[0]), nullptr);
+
+  std::shared_ptr<Tensor> output_tensor;
+  s = fused[0]->Compute(input_tensor_, &output_tensor);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(output_tensor->shape(), expected->shape());
+  EXPECT_EQ(output_tensor->type(), expected->type());
+
+  cv::Mat actual_mat = CVTensor::AsCVTensor(output_tensor)->mat();
+  cv::Mat expected_mat = CVTensor::AsCVTensor(expected)->mat();
+  // Only the float rounding of the folded scale and shift differs
+  EXPECT_LT(cv::norm(actual_mat, expected_mat, cv::NORM_INF), 1e-4);
+}
+
+TEST_F(MindDataTestFusedNormalizeOP, TestNoFusion) {
+  MS_LOG(INFO) << "Doing TestFusedNormalizeOp::TestNoFusion.";
+  // A single op and an op starting with HwcToChw are left as they are
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<HwcToChwOp>(), std::make_shared<RescaleOp>(0.5, 0.0)};
+  Status s = FuseImageOps(&ops);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(ops.size(), 2);
+  EXPECT_EQ(std::dynamic_pointer_cast<FusedNormalizeOp>(ops[0]), nullptr);
+  EXPECT_EQ(std::dynamic_pointer_cast<FusedNormalizeOp>(ops[1]), nullptr);
+}
+
+TEST_F(MindDataTestFusedNormalizeOP, TestFloat16) {
+  MS_LOG(INFO) << "Doing TestFusedNormalizeOp::TestFloat16.";
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+                                                std::make_shared<NormalizeOp>(0.485, 0.456, 0.406, 0.229, 0.224, 0.225),
+                                                std::make_shared<HwcToChwOp>()};
+  FusedNormalizeOp op32(ops);
+  FusedNormalizeOp op16(ops, DataType(DataType::DE_FLOAT16));
+
+  std::vector<DataType> types;
+  Status s = op16.OutputType({DataType(DataType::DE_UINT8)}, types);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(types[0], DataType(DataType::DE_FLOAT16));
+
+  std::shared_ptr<Tensor> out32, out16;
+  s = op32.Compute(input_tensor_, &out32);
+  EXPECT_TRUE(s.IsOk());
+  s = op16.Compute(input_tensor_, &out16);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(out16->shape(), out32->shape());
+  EXPECT_EQ(out16->type(), DataType(DataType::DE_FLOAT16));
+
+  // The vectorized body and the scalar tail both round to the nearest half
+  const float *expected = reinterpret_cast<const float *>(out32->StartAddr());
+  const float16 *actual = reinterpret_cast<const float16 *>(out16->StartAddr());
+  float max_err = 0;
+  for (int64_t i = 0; i < out32->Size(); i++) {
+    max_err = std::max(max_err, std::abs(static_cast<float>(actual[i]) - expected[i]));
+  }
+  EXPECT_LT(max_err, 4e-3);
+}
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -487,3 +488,128 @@ TEST_F(MindDataTestImageFolderSampler, TestImageFolderSharding2) {
     EXPECT_TRUE(i == 11);
   }
 }
+
+TEST_F(MindDataTestImageFolderSampler, TestImageFolderGetRow) {
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  std::shared_ptr<ImageFolderOp> op = ImageFolder(16, 2, 32, folder_path, false);
+  TensorRow row;
+  int32_t label = 0;
+  // the rows are indexed without a tree, in the order of the sequential sampler
+  for (int64_t i = 0; i < 44; i += 5) {
+    Status rc = op->GetRow(i, &row);
+    EXPECT_TRUE(rc.IsOk());
+    EXPECT_EQ(row.size(), 2);
+    row[1]->GetItemAt<int32_t>(&label, {});
+    EXPECT_EQ(label, i / 11);
+  }
+  EXPECT_TRUE(op->GetRow(44, &row).IsError());
+  EXPECT_TRUE(op->GetRow(-1, &row).IsError());
+  // the tree reuses the index of GetRow
+  auto tree = Build({op});
+  tree->Prepare();
+  Status rc = tree->Launch();
+  if (rc.IsError()) {
+    MS_LOG(ERROR) << "Return code error detected during tree launch: " << common::SafeCStr(rc.ToString()) << ".";
+    EXPECT_TRUE(false);
+  } else {
+    DatasetIterator di(tree);
+    TensorMap tensor_map;
+    rc = di.GetNextAsMap(&tensor_map);
+    EXPECT_TRUE(rc.IsOk());
+    uint64_t i = 0;
+    while (tensor_map.size() != 0) {
+      tensor_map["label"]->GetItemAt<int32_t>(&label, {});
+      EXPECT_EQ(label, i / 11);
+      i++;
+      di.GetNextAsMap(&tensor_map);
+    }
+    EXPECT_TRUE(i == 44);
+  }
+}
+
+TEST_F(MindDataTestImageFolderSampler, TestImageFolderIndexFile) {
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  std::string index_file = "/tmp/image_folder_op_test.index";
+  (void)std::remove(index_file.c_str());
+  // the first op walks the folders and writes the index, the second one reads it back
+  for (int32_t pass = 0; pass < 2; pass++) {
+    std::shared_ptr<ImageFolderOp> op;
+    ImageFolderOp::Builder builder;
+    Status rc = builder.SetNumWorkers(4)
+                  .SetImageFolderDir(folder_path)
+                  .SetExtensions({".jpg", ".JPEG"})
+                  .SetIndexFile(index_file)
+                  .Build(&op);
+    EXPECT_TRUE(rc.IsOk());
+    TensorRow row;
+    int32_t label = 0;
+    for (int64_t i = 0; i < 44; i += 5) {
+      rc = op->GetRow(i, &row);
+      EXPECT_TRUE(rc.IsOk());
+      row[1]->GetItemAt<int32_t>(&label, {});
+      EXPECT_EQ(label, i / 11);
+    }
+    EXPECT_TRUE(op->GetRow(44, &row).IsError());
+    EXPECT_TRUE(Path(index_file).Exists());
+  }
+  (void)std::remove(index_file.c_str());
+}
+
+TEST_F(MindDataTestImageFolderSampler, TestImageFolderSaveState) {
+  int32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(0);
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  auto build_tree = [&folder_path]() {
+    std::unique_ptr<Sampler> sampler = mindspore::make_unique<RandomSampler>();
+    return Build({ImageFolder(4, 3, 32, folder_path, false, std::move(sampler)), Repeat(2)});
+  };
+  // the rows of a run which is not interrupted
+  std::vector<std::pair<int32_t, int64_t>> expected;
+  auto tree = build_tree();
+  tree->Prepare();
+  EXPECT_TRUE(tree->Launch().IsOk());
+  {
+    DatasetIterator di(tree);
+    TensorRow row;
+    di.FetchNextTensorRow(&row);
+    while (!row.empty()) {
+      int32_t label = 0;
+      row[1]->GetItemAt<int32_t>(&label, {});
+      expected.emplace_back(label, row[0]->Size());
+      di.FetchNextTensorRow(&row);
+    }
+  }
+  EXPECT_EQ(expected.size(), 88);
+  // stop in the second repeat and save the position
+  std::string state;
+  tree = build_tree();
+  tree->Prepare();
+  EXPECT_TRUE(tree->Launch().IsOk());
+  {
+    DatasetIterator di(tree);
+    TensorRow row;
+    for (int32_t i = 0; i < 50; i++) {
+      di.FetchNextTensorRow(&row);
+    }
+    EXPECT_TRUE(tree->SaveState(di.rows_fetched(), &state).IsOk());
+  }
+  // resume in a new tree, the rows follow on from the saved position
+  tree = build_tree();
+  tree->Prepare();
+  int64_t rows = 0;
+  EXPECT_TRUE(tree->LoadState(state, &rows).IsOk());
+  EXPECT_EQ(rows, 50);
+  EXPECT_TRUE(tree->Launch().IsOk());
+  DatasetIterator di(tree);
+  di.set_rows_fetched(rows);
+  TensorRow row;
+  di.FetchNextTensorRow(&row);
+  while (!row.empty()) {
+    int32_t label = 0;
+    row[1]->GetItemAt<int32_t>(&label, {});
+    EXPECT_EQ(expected[di.rows_fetched() - 1], std::make_pair(label, row[0]->Size()));
+    di.FetchNextTensorRow(&row);
+  }
+  EXPECT_EQ(di.rows_fetched(), 88);
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
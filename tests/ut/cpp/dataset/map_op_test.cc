@@ -19,6 +19,8 @@
 
 #include "common/common.h"
 #include "dataset/core/client.h"
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
 #include "dataset/core/tensor.h"
 #include "dataset/engine/datasetops/source/image_folder_op.h"
 #include "dataset/kernels/image/decode_op.h"
@@ -812,3 +814,128 @@ TEST_F(MindDataTestMapOp, ImageFolder_Decode_Repeat_Resize_NoInputColumns) {
   }
   EXPECT_TRUE(i == 88);
 }
+
+// TestAutoTune scenario:
+//    StorageOp -> RepeatOp -> MapOp with the auto tune on.
+//    The auto tune must not change the rows that flow through the tree, and the number of active
+//    workers of the MapOp must stay between 1 and its num_workers.
+TEST_F(MindDataTestMapOp, TestAutoTune) {
+  Status rc;
+  MS_LOG(INFO) << "Doing TestAutoTune.";
+  uint32_t num_repeats = 3;
+  int32_t num_workers = 5;
+
+  auto my_storage_op = this->CreateStorageOp();
+  rc = my_tree_->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto my_no_op = std::make_shared<mindspore::dataset::test::NoOp>();
+  std::vector<std::shared_ptr<TensorOp>> my_func_list;
+  my_func_list.push_back(my_no_op);
+
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  rc = RepeatOp::Builder(num_repeats).Build(&my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssociateNode(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  std::shared_ptr<MapOp> my_map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({"label"})
+    .SetOutColNames({})
+    .SetTensorFuncs(std::move(my_func_list))
+    .SetNumWorkers(num_workers);
+  rc = builder.Build(&my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssociateNode(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  rc = my_map_op->AddChild(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_repeat_op->AddChild(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssignRoot(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  rc = my_tree_->EnableAutoTune(1);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  DatasetIterator di(my_tree_);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  uint32_t row_count = 0;
+  while (!tensor_list.empty()) {
+    row_count++;
+    int32_t active = my_map_op->active_workers();
+    EXPECT_TRUE(active >= 1 && active <= num_workers);
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  ASSERT_EQ(row_count, 10 * num_repeats);
+}
+
+TEST_F(MindDataTestMapOp, TestWorkStealing) {
+  Status rc;
+  MS_LOG(INFO) << "Doing TestWorkStealing.";
+  uint32_t num_repeats = 3;
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  bool old_work_stealing = cfg->work_stealing();
+  cfg->set_work_stealing(true);
+
+  auto my_storage_op = this->CreateStorageOp();
+  rc = my_tree_->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto my_no_op = std::make_shared<mindspore::dataset::test::NoOp>();
+  std::vector<std::shared_ptr<TensorOp>> my_func_list;
+  my_func_list.push_back(my_no_op);
+
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  rc = RepeatOp::Builder(num_repeats).Build(&my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssociateNode(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  std::shared_ptr<MapOp> my_map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({"label"})
+    .SetOutColNames({})
+    .SetTensorFuncs(std::move(my_func_list))
+    .SetNumWorkers(4);
+  rc = builder.Build(&my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssociateNode(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  rc = my_map_op->AddChild(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_repeat_op->AddChild(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssignRoot(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  // The buffers are computed by the pool of the Executor and still come out in order, epoch after epoch
+  DatasetIterator di(my_tree_);
+  TensorRow tensor_list;
+  std::vector<std::shared_ptr<Tensor>> labels;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  while (!tensor_list.empty()) {
+    // The column ordering is |image|label|A|B|
+    labels.push_back(tensor_list[1]);
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  cfg->set_work_stealing(old_work_stealing);
+  ASSERT_EQ(labels.size(), 10 * num_repeats);
+  for (uint32_t i = 10; i < labels.size(); i++) {
+    EXPECT_TRUE(*labels[i] == *labels[i - 10]);
+  }
+}
@@ -16,8 +16,12 @@
 
 #include "dataset/util/memory_pool.h"
 #include "dataset/util/circular_pool.h"
+#include "dataset/util/numa_pool.h"
 #include "dataset/util/system_pool.h"
 #include "dataset/util/allocator.h"
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include <thread>
 #include "common/common.h"
 #include "gtest/gtest.h"
 
@@ -74,3 +78,51 @@ TEST_F(MindDataTestMemoryPool, TestAllocator) {
   ASSERT_EQ(v, 3);
   MS_LOG(DEBUG) << *(std::dynamic_pointer_cast<CircularPool>(mp_)) << std::endl;
 }
+
+TEST_F(MindDataTestMemoryPool, TestNumaPool) {
+  std::shared_ptr<MemoryPool> pool;
+  Status rc = NumaPool::CreateNumaPool(&pool);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_GE(std::dynamic_pointer_cast<NumaPool>(pool)->num_nodes(), 1);
+  // A freed block is reused by the next allocation of its size class
+  void *p = nullptr;
+  rc = pool->Allocate(1000, &p);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0);
+  pool->Deallocate(p);
+  void *q = nullptr;
+  rc = pool->Allocate(1500, &q);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(p, q);
+  // Growing within the block keeps it, growing beyond copies the data
+  static_cast<char *>(q)[0] = 7;
+  rc = pool->Reallocate(&q, 1500, 1900);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(p, q);
+  rc = pool->Reallocate(&q, 1900, 100000);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(static_cast<char *>(q)[0], 7);
+  // Blocks allocated by one thread may be freed by another, and above the largest class
+  void *big = nullptr;
+  rc = pool->Allocate(100 * 1048576L, &big);
+  ASSERT_TRUE(rc.IsOk());
+  std::thread t([pool, q, big]() {
+    pool->Deallocate(q);
+    pool->Deallocate(big);
+  });
+  t.join();
+}
+
+TEST_F(MindDataTestMemoryPool, TestTensorPoolConfig) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  std::shared_ptr<MemoryPool> old_pool = GlobalContext::Instance()->mem_pool();
+  cfg->set_tensor_pool("numa");
+  ASSERT_EQ(cfg->tensor_pool(), "numa");
+  ASSERT_NE(std::dynamic_pointer_cast<NumaPool>(GlobalContext::Instance()->mem_pool()), nullptr);
+  // An unknown name keeps the current pool
+  cfg->set_tensor_pool("buddy");
+  ASSERT_EQ(cfg->tensor_pool(), "numa");
+  cfg->set_tensor_pool("system");
+  ASSERT_EQ(cfg->tensor_pool(), "system");
+  ASSERT_NE(GlobalContext::Instance()->mem_pool(), old_pool);
+}
@@ -480,4 +480,89 @@ TEST_F(MindDataTestMindRecordOp, TestMindRecordBlockReaderRepeat) {
     row_count++;
   }
 }
-#endif
+
+// Reads every row of a MindRecord dataset and returns their printed tensors
+static void ReadAllRows(const std::string &dataset_file, bool block_reader, bool mmap_mode, int32_t prefetch_depth,
+                        std::vector<std::string> *rows) {
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<MindRecordOp> my_mindrecord_op;
+  MindRecordOp::Builder builder;
+  builder.SetDatasetFile(dataset_file)
+      .SetRowsPerBuffer(3)
+      .SetNumMindRecordWorkers(4)
+      .SetPrefetchDepth(prefetch_depth)
+      .SetColumnsToLoad({"file_name", "label"});
+  if (block_reader) {
+    builder.SetBlockReader();
+  }
+  if (mmap_mode) {
+    builder.SetMmapMode();
+  }
+  Status rc = builder.Build(&my_mindrecord_op);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(my_mindrecord_op->mmap_mode(), mmap_mode);
+
+  rc = my_tree->AssociateNode(my_mindrecord_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_mindrecord_op);
+  EXPECT_TRUE(rc.IsOk());
+  my_tree->Prepare();
+  my_tree->Launch();
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  ASSERT_TRUE(rc.IsOk());
+  while (!tensor_list.empty()) {
+    std::ostringstream ss;
+    for (int i = 0; i < tensor_list.size(); i++) {
+      ss << (*tensor_list[i]) << ";";
+    }
+    rows->push_back(ss.str());
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+  }
+}
+
+TEST_F(MindDataTestMindRecordOp, TestMindRecordMmapMode) {
+  // single MindRecord op and nothing else, read by file streams then through memory mappings
+  //
+  //    MindRecordOp
+
+  MS_LOG(INFO) << "UT test TestMindRecordMmapMode";
+
+  std::string dataset_file = mindrecord_root_path_ + "/testMindDataSet/testImageNetData/imagenet.mindrecord0";
+  for (bool block_reader : {false, true}) {
+    std::vector<std::string> stream_rows;
+    std::vector<std::string> mmap_rows;
+    ReadAllRows(dataset_file, block_reader, false, 0, &stream_rows);
+    ReadAllRows(dataset_file, block_reader, true, 0, &mmap_rows);
+    ASSERT_FALSE(stream_rows.empty());
+    ASSERT_EQ(stream_rows, mmap_rows);
+  }
+}
+
+TEST_F(MindDataTestMindRecordOp, TestMindRecordPrefetchDepth) {
+  // single MindRecord op and nothing else, with a single task then many tasks read ahead
+  //
+  //    MindRecordOp
+
+  MS_LOG(INFO) << "UT test TestMindRecordPrefetchDepth";
+
+  std::string dataset_file = mindrecord_root_path_ + "/testMindDataSet/testImageNetData/imagenet.mindrecord0";
+  for (bool block_reader : {false, true}) {
+    std::vector<std::string> default_rows;
+    ReadAllRows(dataset_file, block_reader, false, 0, &default_rows);
+    ASSERT_FALSE(default_rows.empty());
+    for (int32_t prefetch_depth : {1, 64}) {
+      std::vector<std::string> rows;
+      ReadAllRows(dataset_file, block_reader, false, prefetch_depth, &rows);
+      ASSERT_EQ(rows, default_rows);
+    }
+  }
+
+  std::shared_ptr<MindRecordOp> my_mindrecord_op;
+  Status rc = MindRecordOp::Builder().SetDatasetFile(dataset_file).SetPrefetchDepth(-1).Build(&my_mindrecord_op);
+  ASSERT_TRUE(rc.IsError());
+}
+#endif
\ No newline at end of file
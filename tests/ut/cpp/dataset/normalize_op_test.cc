@@ -55,3 +55,41 @@ TEST_F(MindDataTestNormalizeOP, TestOp) {
   cv::FileStorage file(output_filename, cv::FileStorage::WRITE);
   file << "imageData" << cv_output_image;
 }
+
+TEST_F(MindDataTestNormalizeOP, TestBatchCompute) {
+  MS_LOG(INFO) << "Doing TestNormalizeOp::TestBatchCompute.";
+  float mean[3] = {121.0, 115.0, 100.0};
+  float std[3] = {70.0, 68.0, 71.0};
+  std::unique_ptr<NormalizeOp> op(new NormalizeOp(mean[0], mean[1], mean[2], std[0], std[1], std[2]));
+
+  // A batch of the same image twice
+  std::vector<dsize_t> batch_shape = {2};
+  for (dsize_t d = 0; d < input_tensor_->Rank(); d++) {
+    batch_shape.push_back(input_tensor_->shape()[d]);
+  }
+  std::shared_ptr<Tensor> batch;
+  Status s = Tensor::CreateTensor(&batch, TensorImpl::kFlexible, TensorShape(batch_shape), input_tensor_->type());
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(batch->InsertTensor({0}, input_tensor_).IsOk());
+  EXPECT_TRUE(batch->InsertTensor({1}, input_tensor_).IsOk());
+
+  std::shared_ptr<Tensor> expected;
+  s = op->Compute(input_tensor_, &expected);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> output;
+  s = op->BatchCompute(batch, &output);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(output->shape(), batch->shape());
+  EXPECT_EQ(output->type(), DataType(DataType::DE_FLOAT32));
+
+  // Every row of the batch matches the row by row result up to the float rounding
+  auto expected_itr = expected->begin<float>();
+  auto output_itr = output->begin<float>();
+  for (dsize_t i = 0; i < 2 * expected->Size(); i++, output_itr++) {
+    if (i == expected->Size()) {
+      expected_itr = expected->begin<float>();
+    }
+    ASSERT_NEAR(*output_itr, *expected_itr, 1e-4);
+    expected_itr++;
+  }
+}
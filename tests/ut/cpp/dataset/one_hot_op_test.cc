@@ -53,3 +53,32 @@ TEST_F(MindDataTestOneHotOp, TestOp) {
   ASSERT_TRUE(*output == *expected);
   MS_LOG(INFO) << "MindDataTestOneHotOp end.";
 }
+
+TEST_F(MindDataTestOneHotOp, TestBatchCompute) {
+  MS_LOG(INFO) << "Doing MindDataTestOneHotOp BatchCompute.";
+  // A batch of 3 rows, one label per row
+  int32_t labels[3] = {2, 0, 1};
+  std::shared_ptr<Tensor> input = std::make_shared<Tensor>(TensorShape({3, 1}), DataType(DataType::DE_INT32),
+                                                           reinterpret_cast <unsigned char *>(labels));
+  std::shared_ptr<Tensor> output;
+
+  std::unique_ptr<OneHotOp> op(new OneHotOp(4));
+  EXPECT_TRUE(op->BatchSupported());
+  Status s = op->BatchCompute(input, &output);
+  int32_t out[12] = {0, 0, 1, 0,
+                     1, 0, 0, 0,
+                     0, 1, 0, 0};
+  std::shared_ptr<Tensor> expected = std::make_shared<Tensor>(TensorShape{3, 4}, DataType(DataType::DE_INT32),
+                                                              reinterpret_cast <unsigned char *>(out));
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_TRUE(output->shape() == expected->shape());
+  ASSERT_TRUE(*output == *expected);
+
+  // A label out of range fails the whole batch
+  labels[1] = 4;
+  input = std::make_shared<Tensor>(TensorShape({3}), DataType(DataType::DE_INT32),
+                                   reinterpret_cast <unsigned char *>(labels));
+  s = op->BatchCompute(input, &output);
+  EXPECT_FALSE(s.IsOk());
+  MS_LOG(INFO) << "MindDataTestOneHotOp BatchCompute end.";
+}
@@ -172,3 +172,36 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, Test7) {
+  // Change the capacity of a queue while it holds elements
+  Queue<int> que(8);
+  ASSERT_EQ(que.capacity(), 8);
+  que.set_capacity(2);
+  ASSERT_EQ(que.capacity(), 2);
+  ASSERT_EQ(que.max_capacity(), 8);
+  Status rc = que.Add(1);
+  ASSERT_TRUE(rc.IsOk());
+  rc = que.Add(2);
+  ASSERT_TRUE(rc.IsOk());
+  // A producer blocks on the lowered capacity until the queue grows again.
+  TaskGroup vg;
+  rc = que.Register(&vg);
+  ASSERT_TRUE(rc.IsOk());
+  rc = vg.CreateAsyncTask("Producer", [&que]() -> Status {
+    TaskManager::FindMe()->Post();
+    return que.Add(3);
+  });
+  ASSERT_TRUE(rc.IsOk());
+  que.set_capacity(100);
+  ASSERT_EQ(que.capacity(), 8);
+  rc = vg.join_all();
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.size(), 3);
+  int v = 0;
+  for (int i = 1; i <= 3; i++) {
+    rc = que.PopFront(&v);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(v, i);
+  }
+}
@@ -154,3 +154,30 @@ TEST_F(MindDataTestRandomCropDecodeResizeOp, TestOp1) {
   }
   MS_LOG(INFO) << "MindDataTestRandomCropDecodeResizeOp end!";
 }
+
+TEST_F(MindDataTestRandomCropDecodeResizeOp, TestScaledDecode) {
+  MS_LOG(INFO) << "Doing MindDataTestRandomCropDecodeResizeOp TestScaledDecode";
+  const int x = 101;
+  const int y = 57;
+  const int crop_width = 403;
+  const int crop_height = 299;
+  std::shared_ptr<Tensor> full, scaled;
+  for (int scale_denom = 1; scale_denom <= kMaxJpegScaleDenom; scale_denom *= 2) {
+    Status s = JpegCropAndDecode(raw_input_tensor_, &scaled, x, y, crop_width, crop_height, scale_denom);
+    EXPECT_TRUE(s.IsOk());
+    int x_end = (x + crop_width + scale_denom - 1) / scale_denom;
+    int y_end = (y + crop_height + scale_denom - 1) / scale_denom;
+    EXPECT_EQ(scaled->shape()[0], y_end - y / scale_denom);
+    EXPECT_EQ(scaled->shape()[1], x_end - x / scale_denom);
+    EXPECT_EQ(scaled->shape()[2], 3);
+  }
+
+  // the whole image at 1/8 keeps its aspect
+  EXPECT_TRUE(JpegCropAndDecode(raw_input_tensor_, &full).IsOk());
+  EXPECT_TRUE(JpegCropAndDecode(raw_input_tensor_, &scaled, 0, 0, 0, 0, kMaxJpegScaleDenom).IsOk());
+  EXPECT_EQ(scaled->shape()[0], (full->shape()[0] + kMaxJpegScaleDenom - 1) / kMaxJpegScaleDenom);
+  EXPECT_EQ(scaled->shape()[1], (full->shape()[1] + kMaxJpegScaleDenom - 1) / kMaxJpegScaleDenom);
+
+  EXPECT_FALSE(JpegCropAndDecode(raw_input_tensor_, &scaled, x, y, crop_width, crop_height, 3).IsOk());
+  MS_LOG(INFO) << "MindDataTestRandomCropDecodeResizeOp TestScaledDecode end!";
+}
@@ -16,6 +16,7 @@
 #include "common/common.h"
 #include "common/cvop_common.h"
 #include "dataset/kernels/image/random_crop_op.h"
+#include "dataset/util/random.h"
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -58,3 +59,27 @@ TEST_F(MindDataTestRandomCropOp, TestOp2) {
   EXPECT_EQ(true, s.IsOk());
   MS_LOG(INFO) << "testRandomCrop end.";
 }
+
+TEST_F(MindDataTestRandomCropOp, TestRowRandomScope) {
+  MS_LOG(INFO) << "Doing testRandomCrop with the random stream of a row.";
+  // Two ops with different seeds crop the same row the same way, another row is cropped elsewhere
+  std::unique_ptr<RandomCropOp> op1(new RandomCropOp(64, 64, 0, 0, 0, 0, BorderType::kConstant, false));
+  std::unique_ptr<RandomCropOp> op2(new RandomCropOp(64, 64, 0, 0, 0, 0, BorderType::kConstant, false));
+  std::shared_ptr<Tensor> out1, out2, out3;
+  {
+    RowRandomScope scope(7, 1, 42);
+    EXPECT_TRUE(op1->Compute(input_tensor_, &out1).IsOk());
+  }
+  {
+    RowRandomScope scope(7, 1, 42);
+    EXPECT_TRUE(op2->Compute(input_tensor_, &out2).IsOk());
+  }
+  {
+    RowRandomScope scope(7, 2, 42);
+    EXPECT_TRUE(op2->Compute(input_tensor_, &out3).IsOk());
+  }
+  ASSERT_EQ(out1->SizeInBytes(), out2->SizeInBytes());
+  EXPECT_EQ(memcmp(out1->StartAddr(), out2->StartAddr(), out1->SizeInBytes()), 0);
+  EXPECT_NE(memcmp(out1->StartAddr(), out3->StartAddr(), out1->SizeInBytes()), 0);
+  EXPECT_EQ(RowRandomScope::Current(), nullptr);
+}
@@ -73,6 +73,8 @@ TEST_F(MindDataTestRenameOp, TestRenameOpDefault) {
       .SetOutColNames(out_colnames)
       .Build(&rename_op);
   EXPECT_TRUE(rc.IsOk());
+  // A rename is done in the thread of its parent by default
+  EXPECT_TRUE(rename_op->inlined());
 
   rc = my_tree->AssociateNode(rename_op);
   EXPECT_TRUE(rc.IsOk());
@@ -96,6 +98,9 @@ TEST_F(MindDataTestRenameOp, TestRenameOpDefault) {
   rc = di.FetchNextTensorRow(&tensor_list);
   EXPECT_TRUE(rc.IsOk());
 
+  EXPECT_EQ(di.col_name_id_map().count("label1"), 1);
+  EXPECT_EQ(di.col_name_id_map().count("label"), 0);
+
   int row_count = 0;
   while (!tensor_list.empty()) {
     MS_LOG(INFO) << "Row display for row #: " << row_count << ".";
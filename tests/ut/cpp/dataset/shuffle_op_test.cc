@@ -333,3 +333,59 @@ TEST_F(MindDataTestShuffleOp, TestRepeatShuffle) {
   }
   ASSERT_EQ(row_count, 20);
 }
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The shuffle buffer has a memory bound, all the rows still come out.
+// - A negative memory bound is rejected.
+TEST_F(MindDataTestShuffleOp, TestShuffleMemoryBound) {
+  Status rc;
+  MS_LOG(INFO) << "UT test TestShuffleMemoryBound.";
+
+  // A negative bound fails the build
+  std::shared_ptr<ShuffleOp> my_shuffle_op;
+  rc = ShuffleOp::Builder().SetShuffleSize(4).SetShuffleMemoryMb(-1).Build(&my_shuffle_op);
+  EXPECT_TRUE(rc.IsError());
+
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::string dataset_path = datasets_root_path_ + "/testDataset1";
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder()
+      .SetDatasetFilesDir(dataset_path)
+      .SetRowsPerBuffer(2)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(1)
+      .Build(&my_storage_op);
+  ASSERT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = ShuffleOp::Builder()
+         .SetShuffleSize(4)
+         .SetShuffleMemoryMb(1)
+         .SetShuffleSeed(100)
+         .SetRowsPerBuffer(3)
+         .Build(&my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_shuffle_op->AddChild(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    row_count++;
+  }
+  ASSERT_EQ(row_count, 10);
+}
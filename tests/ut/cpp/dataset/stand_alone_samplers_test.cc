@@ -18,6 +18,7 @@
 #include "dataset/core/client.h"
 #include "dataset/core/global_context.h"
 #include "dataset/engine/datasetops/source/sampler/distributed_sampler.h"
+#include "dataset/engine/datasetops/source/sampler/index_permutation.h"
 #include "dataset/engine/datasetops/source/sampler/random_sampler.h"
 #include "dataset/engine/datasetops/source/sampler/sampler.h"
 #include "dataset/engine/datasetops/source/sampler/sequential_sampler.h"
@@ -110,3 +111,49 @@ TEST_F(MindDataTestStandAloneSampler, TestStandAoneSequentialSampler) {
   db->GetTensor(&tensor, 0, 0);
   EXPECT_TRUE((*tensor) == (*label2));
 }
+
+TEST_F(MindDataTestStandAloneSampler, TestIndexPermutation) {
+  for (int64_t n : {1, 2, 5, 64, 1000, 65537}) {
+    IndexPermutation first(n, 5489, 0);
+    IndexPermutation second(n, 5489, 1);
+    std::vector<bool> seen(n, false);
+    int64_t same = 0;
+    for (int64_t i = 0; i < n; i++) {
+      int64_t id = first[i];
+      ASSERT_TRUE(id >= 0 && id < n);
+      EXPECT_FALSE(seen[id]);
+      seen[id] = true;
+      same += (id == second[i]);
+    }
+    // Another epoch gives another order
+    if (n >= 64) {
+      EXPECT_LT(same, n / 4);
+    }
+  }
+}
+
+TEST_F(MindDataTestStandAloneSampler, TestStreamingRandomSampler) {
+  MockStorageOp mock(1000);
+  std::shared_ptr<Sampler> sampler = std::make_shared<RandomSampler>(false, 1000, 64);
+  std::unique_ptr<DataBuffer> db;
+  std::shared_ptr<Tensor> tensor;
+  sampler->Init(&mock);
+  for (int epoch = 0; epoch < 2; epoch++) {
+    std::vector<bool> seen(1000, false);
+    int64_t count = 0;
+    sampler->GetNextBuffer(&db);
+    while (!db->eoe()) {
+      db->GetTensor(&tensor, 0, 0);
+      EXPECT_LE(tensor->Size(), 64);
+      for (auto it = tensor->begin<int64_t>(); it != tensor->end<int64_t>(); ++it) {
+        ASSERT_TRUE(*it >= 0 && *it < 1000);
+        EXPECT_FALSE(seen[*it]);
+        seen[*it] = true;
+        count++;
+      }
+      sampler->GetNextBuffer(&db);
+    }
+    EXPECT_EQ(count, 1000);
+    sampler->Reset();
+  }
+}
@@ -21,6 +21,8 @@
 #include <memory>
 #include <vector>
 #include <iostream>
+#include <sstream>
+#include <string>
 
 namespace common = mindspore::common;
 
@@ -163,3 +165,46 @@ TEST_F(MindDataTestStorageOp, TestStorageBasic2) {
   }
   ASSERT_EQ(row_count, 10); // Should be 10 rows fetched
 }
+
+// Reads the label column of testDataset1, printed row by row.
+static std::vector<std::string> ReadLabels(const std::string &dataset_path, int32_t num_workers) {
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<StorageOp> my_storage_op;
+  StorageOp::Builder builder;
+  builder.SetDatasetFilesDir(dataset_path)
+    .SetRowsPerBuffer(1)
+    .SetWorkerConnectorSize(1)
+    .SetNumWorkers(num_workers)
+    .SetColumnsToLoad({"label"});
+  Status rc = builder.Build(&my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  my_tree->AssociateNode(my_storage_op);
+  my_tree->AssignRoot(my_storage_op);
+  my_tree->Prepare();
+  my_tree->Launch();
+
+  std::vector<std::string> labels;
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  while (rc.IsOk() && !tensor_list.empty()) {
+    std::ostringstream ss;
+    ss << *tensor_list[0];
+    labels.push_back(ss.str());
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  return labels;
+}
+
+TEST_F(MindDataTestStorageOp, TestStorageManyWorkers) {
+  // The workers take the buffers from a shared queue and finish them in any order, but the
+  // buffers still come out in the order of a single worker.
+  MS_LOG(INFO) << "UT test TestStorageManyWorkers.";
+  std::string dataset_path = datasets_root_path_ + "/testDataset1";
+  std::vector<std::string> expected = ReadLabels(dataset_path, 1);
+  ASSERT_EQ(expected.size(), 10);
+  ASSERT_EQ(ReadLabels(dataset_path, 4), expected);
+  ASSERT_EQ(ReadLabels(dataset_path, 12), expected);
+}
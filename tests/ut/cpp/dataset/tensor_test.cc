@@ -377,3 +377,50 @@ TEST_F(MindDataTestTensorDE, TensorIterator) {
   }
   ASSERT_TRUE(ctr == 6);
 }
+
+TEST_F(MindDataTestTensorDE, StridedIterator) {
+  std::vector<uint32_t> values = {1, 2, 3, 4, 5, 6};
+  std::shared_ptr<Tensor> t = std::make_shared<Tensor>(TensorShape({2, 3}), DataType(DataType::DE_UINT32),
+                                                       reinterpret_cast<unsigned char *>(&values[0]));
+  std::vector<uint32_t> column;
+  for (auto i = t->begin<uint32_t>({0, 1}, 0); i != t->end<uint32_t>({0, 1}, 0); i++) {
+    column.push_back(*i);
+  }
+  ASSERT_EQ(column, std::vector<uint32_t>({2, 5}));
+  auto row = t->begin<uint32_t>({1, 0}, 1);
+  ASSERT_EQ(t->end<uint32_t>({1, 0}, 1) - row, 3);
+  ASSERT_EQ(row[2], 6);
+  row[1] = 7;
+  uint32_t o;
+  ASSERT_TRUE(t->GetItemAt<uint32_t>(&o, {1, 1}).IsOk());
+  ASSERT_EQ(o, 7);
+  ASSERT_FALSE(t->begin<uint32_t>({2, 0}, 0));
+  ASSERT_FALSE(t->begin<uint32_t>({0, 0}, 2));
+  ASSERT_EQ(t->Strides(), std::vector<dsize_t>({12, 4}));
+}
+
+TEST_F(MindDataTestTensorDE, TensorView) {
+  std::shared_ptr<Tensor> base = std::make_shared<Tensor>(TensorShape({3, 2}), DataType(DataType::DE_UINT32));
+  ASSERT_TRUE(base->Zero().IsOk());
+
+  // A view of the second row writes into the base
+  std::shared_ptr<Tensor> view;
+  ASSERT_TRUE(Tensor::CreateView(&view, base, {1}, TensorShape({2})).IsOk());
+  ASSERT_TRUE(view->view_base() == base);
+  ASSERT_TRUE(view->StartAddr() == base->StartAddr() + 2 * sizeof(uint32_t));
+  ASSERT_TRUE(view->SetItemAt<uint32_t>({1}, 7).IsOk());
+  uint32_t o;
+  ASSERT_TRUE(base->GetItemAt<uint32_t>(&o, {1, 1}).IsOk());
+  ASSERT_EQ(o, 7);
+
+  // A view of a view shares the owner, and a view which does not fit fails
+  std::shared_ptr<Tensor> sub_view;
+  ASSERT_TRUE(Tensor::CreateView(&sub_view, view, {1}, TensorShape({1})).IsOk());
+  ASSERT_TRUE(sub_view->view_base() == base);
+  ASSERT_FALSE(Tensor::CreateView(&sub_view, base, {2}, TensorShape({4})).IsOk());
+
+  // The view keeps the data alive after the base is released
+  base.reset();
+  ASSERT_TRUE(view->GetItemAt<uint32_t>(&o, {1}).IsOk());
+  ASSERT_EQ(o, 7);
+}
@@ -109,6 +109,37 @@ TEST_F(MindDataTestTensorShape, TestUnknown) {
   ASSERT_EQ(t4, TensorShape({-1, -1, -1}));
 }
 
+TEST_F(MindDataTestTensorShape, TestStrides) {
+  TensorShape t({4, 2, 3});
+  ASSERT_EQ(t.Strides(), std::vector<dsize_t>({6, 3, 1}));
+  ASSERT_EQ(t.Stride(0), 6);
+  ASSERT_EQ(TensorShape::CreateScalar().Strides(), std::vector<dsize_t>{});
+  ASSERT_EQ(TensorShape({2, 0, 3}).Strides(), std::vector<dsize_t>({0, 3, 1}));
+  ASSERT_EQ(TensorShape({-1, 3}).Strides(), std::vector<dsize_t>({0, 0}));
+  t = t.PrependDim(5);
+  ASSERT_EQ(t.Strides(), std::vector<dsize_t>({24, 6, 3, 1}));
+  TensorShape t2 = t;
+  ASSERT_EQ(t2.Strides(), t.Strides());
+}
+
+TEST_F(MindDataTestTensorShape, TestHighRank) {
+  std::vector<dsize_t> vec = {2, 1, 3, 1, 2, 1, 2, 3};
+  TensorShape t(vec);
+  ASSERT_EQ(t.Rank(), 8);
+  ASSERT_EQ(t.AsVector(), vec);
+  ASSERT_EQ(t.NumOfElements(), 72);
+  ASSERT_EQ(t.Strides(), std::vector<dsize_t>({36, 36, 12, 12, 6, 6, 3, 1}));
+  TensorShape t2 = t;
+  ASSERT_EQ(t, t2);
+  ASSERT_EQ(t.InsertDim(6, 4), TensorShape({2, 1, 3, 1, 2, 1, 4, 2, 3}));
+  ASSERT_EQ(t.Squeeze(), TensorShape({2, 3, 2, 2, 3}));
+  ASSERT_NE(t, TensorShape({2, 1, 3, 1, 2, 1, 2, 4}));
+  TensorShape t3 = TensorShape::CreateUnknownShapeWithRank(7);
+  ASSERT_EQ(t3.known(), false);
+  ASSERT_EQ(t3.Rank(), 7);
+  ASSERT_EQ(t3[6], TensorShape::kDimUnknown);
+}
+
 // Test materializing a TensorShape by calling method on a given column descriptor
 TEST_F(MindDataTestTensorShape, TestColDescriptor) {
   int32_t rank = 0; // not used
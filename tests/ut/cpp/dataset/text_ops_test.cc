@@ -0,0 +1,124 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "dataset/kernels/text/pad_mask_op.h"
+#include "dataset/kernels/text/sliding_window_op.h"
+#include "dataset/kernels/text/truncate_pad_op.h"
+#include "dataset/kernels/text/vocab.h"
+#include "dataset/kernels/text/whitespace_tokenizer_op.h"
+#include "dataset/kernels/text/wordpiece_tokenizer_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestTextOps : public UT::Common {
+ protected:
+  MindDataTestTextOps() = default;
+
+  std::shared_ptr<Tensor> TextTensor(const std::string &text) {
+    std::shared_ptr<Tensor> t;
+    EXPECT_TRUE(Tensor::CreateTensor(&t, TensorImpl::kFlexible, TensorShape({static_cast<dsize_t>(text.size())}),
+                                     DataType(DataType::DE_UINT8),
+                                     reinterpret_cast<const unsigned char *>(text.data())).IsOk());
+    return t;
+  }
+
+  template <typename T>
+  std::vector<T> Values(const std::shared_ptr<Tensor> &t) {
+    std::vector<T> values;
+    for (auto itr = t->begin<T>(); itr != t->end<T>(); itr++) {
+      values.push_back(*itr);
+    }
+    return values;
+  }
+};
+
+TEST_F(MindDataTestTextOps, TestWhitespaceTokenizer) {
+  auto vocab = std::make_shared<Vocab>(std::vector<std::string>{"[UNK]", "hello", "world", "Hello"});
+  std::shared_ptr<Tensor> output;
+  WhitespaceTokenizerOp op(vocab);
+  ASSERT_TRUE(op.Compute(TextTensor(" Hello \t world\nfoo "), &output).IsOk());
+  ASSERT_EQ(output->type(), DataType(DataType::DE_INT32));
+  ASSERT_EQ(Values<int32_t>(output), std::vector<int32_t>({3, 2, 0}));
+
+  WhitespaceTokenizerOp lower_op(vocab, "[UNK]", true);
+  ASSERT_TRUE(lower_op.Compute(TextTensor("Hello world"), &output).IsOk());
+  ASSERT_EQ(Values<int32_t>(output), std::vector<int32_t>({1, 2}));
+
+  // No unknown token in the vocab
+  WhitespaceTokenizerOp no_unknown_op(vocab, "<unk>");
+  ASSERT_FALSE(no_unknown_op.Compute(TextTensor("foo"), &output).IsOk());
+  ASSERT_TRUE(no_unknown_op.Compute(TextTensor(""), &output).IsOk());
+  ASSERT_EQ(output->shape(), TensorShape({0}));
+}
+
+TEST_F(MindDataTestTextOps, TestWordpieceTokenizer) {
+  auto vocab = std::make_shared<Vocab>(
+    std::vector<std::string>{"[UNK]", "un", "##aff", "##able", ",", "runn", "##ing", "\xe4\xb8\xad", "!"});
+  std::shared_ptr<Tensor> output;
+  WordpieceTokenizerOp op(vocab);
+  // "unaffable, running!" and a CJK character with no space around it
+  ASSERT_TRUE(op.Compute(TextTensor("UNaffable, runn\xe4\xb8\xading! unknown"), &output).IsOk());
+  ASSERT_EQ(Values<int32_t>(output), std::vector<int32_t>({1, 2, 3, 4, 5, 7, 0, 8, 0}));
+
+  WordpieceTokenizerOp short_op(vocab, "[UNK]", true, 5);
+  ASSERT_TRUE(short_op.Compute(TextTensor("unaffable running"), &output).IsOk());
+  ASSERT_EQ(Values<int32_t>(output), std::vector<int32_t>({0, 0}));
+}
+
+TEST_F(MindDataTestTextOps, TestSlidingWindow) {
+  int32_t values[5] = {1, 2, 3, 4, 5};
+  std::shared_ptr<Tensor> input;
+  ASSERT_TRUE(Tensor::CreateTensor(&input, TensorImpl::kFlexible, TensorShape({5}), DataType(DataType::DE_INT32),
+                                   reinterpret_cast<const unsigned char *>(values)).IsOk());
+  std::shared_ptr<Tensor> output;
+  SlidingWindowOp op(3);
+  ASSERT_TRUE(op.Compute(input, &output).IsOk());
+  ASSERT_EQ(output->shape(), TensorShape({3, 3}));
+  ASSERT_EQ(Values<int32_t>(output), std::vector<int32_t>({1, 2, 3, 2, 3, 4, 3, 4, 5}));
+
+  SlidingWindowOp wide_op(6);
+  ASSERT_TRUE(wide_op.Compute(input, &output).IsOk());
+  ASSERT_EQ(output->shape(), TensorShape({0, 6}));
+}
+
+TEST_F(MindDataTestTextOps, TestTruncatePadAndMask) {
+  float values[3] = {1, 2, 3};
+  std::shared_ptr<Tensor> input;
+  ASSERT_TRUE(Tensor::CreateTensor(&input, TensorImpl::kFlexible, TensorShape({3}), DataType(DataType::DE_FLOAT32),
+                                   reinterpret_cast<const unsigned char *>(values)).IsOk());
+  std::shared_ptr<Tensor> padded;
+  TruncatePadOp pad_op(5, -1);
+  ASSERT_TRUE(pad_op.Compute(input, &padded).IsOk());
+  ASSERT_EQ(Values<float>(padded), std::vector<float>({1, 2, 3, -1, -1}));
+  std::shared_ptr<Tensor> truncated;
+  TruncatePadOp truncate_op(2);
+  ASSERT_TRUE(truncate_op.Compute(input, &truncated).IsOk());
+  ASSERT_EQ(Values<float>(truncated), std::vector<float>({1, 2}));
+
+  std::shared_ptr<Tensor> mask;
+  PadMaskOp mask_op(-1);
+  ASSERT_TRUE(mask_op.Compute(padded, &mask).IsOk());
+  ASSERT_EQ(mask->type(), DataType(DataType::DE_INT32));
+  ASSERT_EQ(Values<int32_t>(mask), std::vector<int32_t>({1, 1, 1, 0, 0}));
+}
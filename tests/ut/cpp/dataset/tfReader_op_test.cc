@@ -13,12 +13,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
 
 #include "dataset/core/client.h"
 #include "dataset/engine/data_schema.h"
+#include "dataset/util/path.h"
 #include "common/common.h"
 #include "common/utils.h"
 #include "gtest/gtest.h"
@@ -90,6 +93,60 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderBasic1) {
   ASSERT_EQ(row_count, 12);
 }
 
+TEST_F(MindDataTestTFReaderOp, TestTFReaderReadahead) {
+  // Start with an empty execution tree
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path;
+  dataset_path = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  TFReaderOp::Builder builder;
+  builder.SetDatasetFilesList({dataset_path})
+      .SetRowsPerBuffer(4)
+      .SetNumWorkers(1)
+      .SetReadaheadChunks(2);
+  std::unique_ptr<DataSchema> schema = mindspore::make_unique<DataSchema>();
+  schema->LoadSchemaFile(datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json", {});
+  builder.SetDataSchema(std::move(schema));
+  Status rc = builder.Build(&my_tfreader_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  rc = my_tree->AssociateNode(my_tfreader_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  rc = my_tree->AssignRoot(my_tfreader_op);
+  ASSERT_TRUE(rc.IsOk());
+
+  MS_LOG(INFO) << "Launching tree and begin iteration.";
+  rc = my_tree->Prepare();
+  ASSERT_TRUE(rc.IsOk());
+
+  rc = my_tree->Launch();
+  ASSERT_TRUE(rc.IsOk());
+
+  // The rows parsed from the chunks read ahead are the same as the rows read directly
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  ASSERT_TRUE(rc.IsOk());
+
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    row_count++;
+  }
+
+  ASSERT_EQ(row_count, 12);
+
+  // A negative number of chunks is rejected
+  TFReaderOp::Builder bad_builder;
+  bad_builder.SetDatasetFilesList({dataset_path}).SetReadaheadChunks(-1);
+  rc = bad_builder.Build(&my_tfreader_op);
+  ASSERT_FALSE(rc.IsOk());
+}
+
 TEST_F(MindDataTestTFReaderOp, TestTFReaderLargeRowsPerBuffer) {
   // Start with an empty execution tree
   auto my_tree = std::make_shared<ExecutionTree>();
@@ -697,3 +754,69 @@ TEST_F(MindDataTestTFReaderOp, TestTotalRowsBasic) {
   TFReaderOp::CountTotalRows(&total_rows, filenames, 729, true);
   ASSERT_EQ(total_rows, 60);
 }
+
+TEST_F(MindDataTestTFReaderOp, TestTFReaderIndexFile) {
+  // the index is written beside the file, on a copy of it
+  std::string dataset_path = "/tmp/tfReader_op_test.data";
+  std::string index_file = dataset_path + kTFIndexFileSuffix;
+  {
+    std::ifstream in(datasets_root_path_ + "/testTFTestAllTypes/test.data", std::ios::binary);
+    std::ofstream out(dataset_path, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+  }
+  (void)std::remove(index_file.c_str());
+
+  int64_t total_rows = 0;
+  Status rc = TFReaderOp::CreateIndexFile(dataset_path, &total_rows);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(total_rows, 12);
+  ASSERT_TRUE(Path(index_file).Exists());
+  // the rows are counted from the index
+  TFReaderOp::CountTotalRows(&total_rows, {dataset_path, dataset_path}, 2);
+  ASSERT_EQ(total_rows, 24);
+
+  // the records of the file are split across the workers, with and without readahead, and for two shards
+  for (int32_t readahead : {0, 2}) {
+    int row_count = 0;
+    for (int32_t shard = 0; shard < 2; shard++) {
+      auto my_tree = std::make_shared<ExecutionTree>();
+      std::shared_ptr<TFReaderOp> my_tfreader_op;
+      TFReaderOp::Builder builder;
+      builder.SetDatasetFilesList({dataset_path})
+        .SetRowsPerBuffer(2)
+        .SetNumWorkers(4)
+        .SetNumDevices(2)
+        .SetDeviceId(shard)
+        .SetShardEqualRows(true)
+        .SetReadaheadChunks(readahead);
+      rc = builder.Build(&my_tfreader_op);
+      ASSERT_TRUE(rc.IsOk());
+      ASSERT_EQ(my_tfreader_op->num_workers(), 4);
+      rc = my_tree->AssociateNode(my_tfreader_op);
+      ASSERT_TRUE(rc.IsOk());
+      rc = my_tree->AssignRoot(my_tfreader_op);
+      ASSERT_TRUE(rc.IsOk());
+      rc = my_tree->Prepare();
+      ASSERT_TRUE(rc.IsOk());
+      rc = my_tree->Launch();
+      ASSERT_TRUE(rc.IsOk());
+
+      DatasetIterator di(my_tree);
+      TensorRow tensor_list;
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+      int shard_rows = 0;
+      while (!tensor_list.empty()) {
+        ASSERT_EQ(tensor_list.size(), 9);
+        rc = di.FetchNextTensorRow(&tensor_list);
+        ASSERT_TRUE(rc.IsOk());
+        shard_rows++;
+      }
+      ASSERT_EQ(shard_rows, 6);
+      row_count += shard_rows;
+    }
+    ASSERT_EQ(row_count, 12);
+  }
+  (void)std::remove(index_file.c_str());
+  (void)std::remove(dataset_path.c_str());
+}
@@ -23,6 +23,7 @@
 #include "dataset/engine/datasetops/source/sampler/weighted_random_sampler.h"
 #include "utils/log_adapter.h"
 
+#include <chrono>
 #include <vector>
 #include <unordered_set>
 
@@ -293,3 +294,63 @@ TEST_F(MindDataTestWeightedRandomSampler, TestResetNoReplacement) {
   ASSERT_EQ(m_sampler.GetNextBuffer(&db), Status::OK());
   ASSERT_EQ(db->eoe(), true);
 }
+
+TEST_F(MindDataTestWeightedRandomSampler, TestAliasDistribution) {
+  // Skewed weights, with zeros which are never drawn
+  uint64_t num_samples = 200000;
+  std::vector<double> weights = {0, 1, 2, 3, 4, 0, 10};
+  std::vector<uint64_t> freq(weights.size(), 0);
+
+  WeightedRandomSampler m_sampler(weights, num_samples, true);
+  DummyRandomAccessOp dummy_random_access_op(weights.size());
+  ASSERT_EQ(m_sampler.Init(&dummy_random_access_op), Status::OK());
+
+  std::unique_ptr<DataBuffer> db;
+  TensorRow row;
+  ASSERT_EQ(m_sampler.GetNextBuffer(&db), Status::OK());
+  db->PopRow(&row);
+  for (auto it = row[0]->begin<uint64_t>(); it != row[0]->end<uint64_t>(); it++) {
+    freq[*it]++;
+  }
+
+  for (size_t i = 0; i < weights.size(); i++) {
+    double expected = num_samples * weights[i] / 20.0;
+    EXPECT_NEAR(static_cast<double>(freq[i]), expected, 0.02 * num_samples);
+    if (weights[i] == 0) {
+      EXPECT_EQ(freq[i], 0);
+    }
+  }
+}
+
+TEST_F(MindDataTestWeightedRandomSampler, TestAliasThroughput) {
+  // Millions of distinct weights, as in class rebalancing
+  uint64_t total_samples = 4000000;
+  uint64_t num_samples = 10000000;
+  std::vector<double> weights(total_samples);
+  for (uint64_t i = 0; i < total_samples; i++) {
+    weights[i] = 1.0 + (i % 1000);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  WeightedRandomSampler m_sampler(weights, num_samples, true, 1000000);
+  DummyRandomAccessOp dummy_random_access_op(total_samples);
+  ASSERT_EQ(m_sampler.Init(&dummy_random_access_op), Status::OK());
+  auto built = std::chrono::steady_clock::now();
+
+  std::unique_ptr<DataBuffer> db;
+  TensorRow row;
+  uint64_t drawn = 0;
+  ASSERT_EQ(m_sampler.GetNextBuffer(&db), Status::OK());
+  while (!db->eoe()) {
+    db->PopRow(&row);
+    drawn += row[0]->Size();
+    ASSERT_EQ(m_sampler.GetNextBuffer(&db), Status::OK());
+  }
+  auto end = std::chrono::steady_clock::now();
+  ASSERT_EQ(drawn, num_samples);
+
+  double build_ms = std::chrono::duration<double, std::milli>(built - start).count();
+  double draw_s = std::chrono::duration<double>(end - built).count();
+  MS_LOG(INFO) << "Alias tables of " << total_samples << " weights built in " << build_ms << " ms, "
+               << static_cast<double>(num_samples) / draw_s << " samples per second.";
+}
@@ -218,3 +218,74 @@ TEST_F(MindDataTestZipOp, MindDataTestZipOpRepeat) {
   }
   ASSERT_EQ(row_count, 9); // Should be 9 rows fetched
 }
+
+TEST_F(MindDataTestZipOp, MindDataTestZipOpUnalignedBuffers) {
+/* Tree:
+ *
+ *
+ *                  OpId(2) ZipOp
+ *            /                       \
+ *     OpId(0) StorageOp    OpId(1) StorageOp
+ * The children have buffers of different sizes, the zipped buffers hold the rows all the children have.
+*/
+  Status rc;
+  MS_LOG(INFO) << "UT test TestZipUnalignedBuffers.";
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path = datasets_root_path_ + "/test_tf_file_3_images_1";
+  std::string dataset_path2 = datasets_root_path_ + "/test_tf_file_3_images_2";
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder()
+      .SetDatasetFilesDir(dataset_path)
+      .SetRowsPerBuffer(2)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(1)
+      .Build(&my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<StorageOp> my_storage_op2;
+  rc = StorageOp::Builder()
+      .SetDatasetFilesDir(dataset_path2)
+      .SetRowsPerBuffer(3)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(1)
+      .Build(&my_storage_op2);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op2);
+  EXPECT_TRUE(rc.IsOk());
+
+  std::shared_ptr<ZipOp> zip_op;
+  rc = ZipOp::Builder().Build(&zip_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(zip_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = zip_op->AddChild(std::move(my_storage_op));
+  EXPECT_TRUE(rc.IsOk());
+  rc = zip_op->AddChild(std::move(my_storage_op2));
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(zip_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    // Every zipped row has all the columns of both children
+    EXPECT_EQ(tensor_list.size(), di.col_name_id_map().size());
+    for (const auto &tensor : tensor_list) {
+      EXPECT_NE(tensor, nullptr);
+    }
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    row_count++;
+  }
+  ASSERT_EQ(row_count, 3); // Should be 3 rows fetched
+}
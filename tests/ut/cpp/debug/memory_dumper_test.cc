@@ -14,8 +14,13 @@
  * limitations under the License.
  */
 #include <fcntl.h>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <string>
+#include <vector>
 #include "common/common_test.h"
 #include "./common.h"
 #include "utils/system/file_system.h"
@@ -126,4 +131,53 @@ TEST_F(TestMemoryDumper, test_DumpToFileNotExistDir) {
 
   ASSERT_EQ(ret, true);
 }
+
+TEST_F(TestMemoryDumper, test_GetStatistics) {
+  std::vector<float> data = {1.0, -3.0, 5.0, std::nanf(""), std::numeric_limits<float>::infinity()};
+  DumpStatistics statistics;
+  ASSERT_TRUE(Dump::GetStatistics(data.data(), data.size() * sizeof(float), kNumberTypeFloat32, &statistics));
+  EXPECT_EQ(statistics.min, -3.0);
+  EXPECT_EQ(statistics.max, 5.0);
+  EXPECT_EQ(statistics.mean, 1.0);
+  EXPECT_EQ(statistics.nan_count, 1);
+  EXPECT_EQ(statistics.inf_count, 1);
+  ASSERT_FALSE(Dump::GetStatistics(data.data(), data.size() * sizeof(float), kObjectTypeString, &statistics));
+}
+
+TEST_F(TestMemoryDumper, test_AsyncStatisticsDump) {
+  class AsyncDump : public Dump {
+   public:
+    AsyncDump() {
+      async_dump_ = true;
+      statistics_only_ = true;
+      sample_interval_ = 2;
+    }
+  };
+  AsyncDump dump;
+  ASSERT_TRUE(dump.IsIterNeedDump());
+  dump.UpdataCurIter();
+  ASSERT_FALSE(dump.IsIterNeedDump());
+
+  const std::string dump_dir = "./tmp/async_dump";
+  for (int i = 0; i < 3; ++i) {
+    std::vector<int32_t> data = {i, i + 2};
+    std::vector<uint8_t> bytes(reinterpret_cast<uint8_t *>(data.data()),
+                               reinterpret_cast<uint8_t *>(data.data()) + data.size() * sizeof(int32_t));
+    ASSERT_TRUE(dump.DumpTensor(dump_dir + "/tensor_" + std::to_string(i), std::move(bytes), kNumberTypeInt32));
+  }
+  dump.WaitDumpFinished();
+
+  std::ifstream statistics_file(dump_dir + "/statistics.csv");
+  ASSERT_TRUE(statistics_file.is_open());
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(statistics_file, line)) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), 4);
+  EXPECT_EQ(lines[0], "name,type,min,max,mean,nan_count,inf_count");
+  EXPECT_EQ(lines[3], "tensor_2,kNumberTypeInt32,2,4,3,0,0");
+  std::shared_ptr<system::FileSystem> fs = system::Env::GetFileSystem();
+  fs->DeleteFile(dump_dir + "/statistics.csv");
+}
 }  // namespace mindspore
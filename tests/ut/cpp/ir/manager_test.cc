@@ -634,6 +634,33 @@ TEST_F(TestManager, test_parent_manual) {
   assert(p == nullptr);
 }
 
+TEST_F(TestManager, test_used_total_after_replace) {
+  // f calls g, g calls h
+  FuncGraphPtr h = std::make_shared<FuncGraph>();
+  ParameterPtr x = h->add_parameter();
+  h->set_output(x);
+  FuncGraphPtr g = std::make_shared<FuncGraph>();
+  ParameterPtr y = g->add_parameter();
+  g->set_output(g->NewCNode({NewValueNode(h), y}));
+  FuncGraphPtr f = std::make_shared<FuncGraph>();
+  ParameterPtr z = f->add_parameter();
+  f->set_output(f->NewCNode({NewValueNode(g), z}));
+
+  auto mng = Manage(f);
+  ASSERT_EQ(2, mng->func_graphs_used_total(f).size());
+  ASSERT_EQ(1, mng->func_graphs_used_total(g).size());
+  ASSERT_FALSE(mng->recursive(f));
+
+  // only the callers of g recompute the graphs they use
+  ASSERT_TRUE(mng->Replace(g->output(), y));
+  ASSERT_EQ(2, mng->func_graphs().size());
+  ASSERT_EQ(1, mng->func_graphs_used_total(f).size());
+  ASSERT_TRUE(mng->func_graphs_used_total(f).contains(g));
+  ASSERT_EQ(0, mng->func_graphs_used_total(g).size());
+  ASSERT_EQ(nullptr, mng->parent(g));
+  CheckAnalysisSize(mng);
+}
+
 TEST_F(TestManager, test_flat) {
   std::vector<std::shared_ptr<Stage>> stages;
   std::vector<std::string> specs = {"nodes=X:x", "parents=", "fvs_direct="};
@@ -313,6 +313,24 @@ TEST_F(TestTensor, PyArrayDataTest) {
   }
 }
 
+TEST_F(TestTensor, BorrowPyArrayTest) {
+  py::array_t<float, py::array::c_style> input({2, 3});
+  float *input_data = reinterpret_cast<float *>(input.request(true).ptr);
+  for (int i = 0; i < 6; i++) {
+    input_data[i] = static_cast<float>(i);
+  }
+  input.attr("setflags")(py::arg("write") = false);
+
+  // the read only array is borrowed for reading, and copied before the first write
+  TensorPtr tensor = std::make_shared<Tensor>(input);
+  ASSERT_EQ(input_data, tensor->data_c(false));
+  auto *tensor_data = reinterpret_cast<float *>(tensor->data_c(true));
+  ASSERT_NE(input_data, tensor_data);
+  tensor_data[0] = 10;
+  ASSERT_EQ(0, input_data[0]);
+  ASSERT_EQ(5, tensor_data[5]);
+}
+
 TEST_F(TestTensor, TensorDataTest) {
   // Init a data buffer
   float ge_tensor_data[] = {1.1, 2.2, 3.3, 4.4, 5.5, 6.6};
@@ -339,5 +357,43 @@ TEST_F(TestTensor, TensorDataTest) {
   }
 }
 
+// a device address on the host memory, which counts its syncs to host
+class HostDeviceAddress : public DeviceAddress {
+ public:
+  HostDeviceAddress(void *ptr, size_t size) : DeviceAddress(ptr, size) {}
+  ~HostDeviceAddress() override = default;
+  bool SyncDeviceToHost(const std::vector<int> &, size_t size, TypeId, void *host_ptr) const override {
+    sync_count_++;
+    return memcpy_s(host_ptr, size, GetPtr(), GetSize()) == EOK;
+  }
+  bool SyncHostToDevice(const std::vector<int> &, size_t, TypeId, const void *) const override { return true; }
+  mutable int sync_count_{0};
+};
+
+TEST_F(TestTensor, LazyHostDataTest) {
+  float device_data[] = {1.1, 2.2, 3.3, 4.4, 5.5, 6.6};
+  auto device_address = std::make_shared<HostDeviceAddress>(device_data, sizeof(device_data));
+  auto tensor = std::make_shared<Tensor>(TypeId::kNumberTypeFloat32, std::vector<int>({2, 3}));
+  auto lazy_data = tensor->SetLazyHostData(device_address);
+  ASSERT_EQ(tensor->device_address(), device_address);
+  ASSERT_EQ(device_address->sync_count_, 0);
+
+  // the copy shares the host data, so syncing one syncs both
+  Tensor copy(*tensor);
+  py::array_t<float> data = (py::array_t<float>)copy.data_sync();
+  ASSERT_EQ(device_address->sync_count_, 1);
+  ASSERT_EQ(data.unchecked()(1, 2), device_data[5]);
+  (void)tensor->data_sync();
+  ASSERT_EQ(device_address->sync_count_, 1);
+
+  // the device data is not read after the release
+  lazy_data->Release();
+  device_data[5] = 0;
+  ASSERT_EQ(tensor->device_address(), nullptr);
+  data = (py::array_t<float>)tensor->data_sync();
+  ASSERT_EQ(data.unchecked()(1, 2), static_cast<float>(6.6));
+  ASSERT_EQ(device_address->sync_count_, 1);
+}
+
 }  // namespace tensor
 }  // namespace mindspore
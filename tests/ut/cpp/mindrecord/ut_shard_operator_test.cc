@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <iostream>
@@ -460,5 +461,44 @@ TEST_F(TestShardOperator, TestShardCategorySampleShuffle) {
   ASSERT_EQ(category_no, 0);
   ASSERT_TRUE(i <= kSampleSize);
 }
+
+TEST_F(TestShardOperator, TestShardShuffleBlock) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test block shuffle"));
+
+  // 8 row groups of 5 rows over 2 shards
+  const int kGroups = 8;
+  const int kRows = 5;
+  ShardTask tasks;
+  for (int group_id = 0; group_id < kGroups; group_id++) {
+    for (int row = 0; row < kRows; row++) {
+      tasks.InsertTask(group_id % 2, group_id / 2, {static_cast<uint64_t>(row)}, json{});
+    }
+  }
+
+  ShardShuffle shuffle(1, kRows);
+  ASSERT_EQ(shuffle(tasks), SUCCESS);
+  auto permutation = tasks.permutation_;
+  ASSERT_EQ(permutation.size(), kGroups * kRows);
+  std::vector<int> sorted = permutation;
+  std::sort(sorted.begin(), sorted.end());
+  for (int i = 0; i < kGroups * kRows; i++) {
+    ASSERT_EQ(sorted[i], i);
+  }
+
+  // the windows are as long as the row groups, each one holds the rows of a single row group
+  bool row_groups_shuffled = false;
+  for (int start = 0; start < kGroups * kRows; start += kRows) {
+    auto block = permutation[start] / kRows;
+    row_groups_shuffled = row_groups_shuffled || block != start / kRows;
+    for (int i = start; i < start + kRows; i++) {
+      ASSERT_EQ(permutation[i] / kRows, block);
+    }
+  }
+  ASSERT_TRUE(row_groups_shuffled);
+
+  // the next epoch is another permutation
+  ASSERT_EQ(shuffle(tasks), SUCCESS);
+  ASSERT_NE(tasks.permutation_, permutation);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "mindrecord/include/shard_page_cache.h"
+#include "ut_common.h"
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardPageCache : public UT::Common {
+ public:
+  TestShardPageCache() {}
+
+  void TearDown() override {
+    ShardPageCache::GetInstance().set_capacity(0);
+    ShardPageCache::GetInstance().Clear();
+  }
+};
+
+CachedPage MakePage(size_t size) { return std::make_shared<const std::vector<uint8_t>>(size, 1); }
+
+TEST_F(TestShardPageCache, TestAdmitOnReuse) {
+  MS_LOG(INFO) << FormatInfo("Test ShardPageCache admit on reuse");
+  auto &cache = ShardPageCache::GetInstance();
+  cache.Clear();
+  cache.set_capacity(300);
+  bool admit = true;
+  // the first access is only remembered
+  EXPECT_EQ(cache.Lookup("file", 0, 100, &admit), nullptr);
+  EXPECT_FALSE(admit);
+  // reused within the budget
+  EXPECT_EQ(cache.Lookup("file", 0, 100, &admit), nullptr);
+  EXPECT_TRUE(admit);
+  cache.Insert("file", 0, MakePage(100));
+  EXPECT_NE(cache.Lookup("file", 0, 100, &admit), nullptr);
+  EXPECT_FALSE(admit);
+
+  // reused after more bytes than the budget holds
+  EXPECT_EQ(cache.Lookup("file", 1, 100, &admit), nullptr);
+  EXPECT_EQ(cache.Lookup("other", 0, 400, &admit), nullptr);
+  EXPECT_EQ(cache.Lookup("file", 1, 100, &admit), nullptr);
+  EXPECT_FALSE(admit);
+  EXPECT_EQ(cache.get_hits(), 1u);
+  EXPECT_EQ(cache.get_misses(), 5u);
+}
+
+TEST_F(TestShardPageCache, TestEvictLeastRecentlyUsed) {
+  MS_LOG(INFO) << FormatInfo("Test ShardPageCache evict least recently used");
+  auto &cache = ShardPageCache::GetInstance();
+  cache.Clear();
+  cache.set_capacity(200);
+  bool admit = false;
+  cache.Insert("file", 0, MakePage(100));
+  cache.Insert("file", 1, MakePage(100));
+  EXPECT_NE(cache.Lookup("file", 0, 0, &admit), nullptr);
+  cache.Insert("file", 2, MakePage(100));
+  EXPECT_NE(cache.Lookup("file", 0, 0, &admit), nullptr);
+  EXPECT_EQ(cache.Lookup("file", 1, 0, &admit), nullptr);
+  EXPECT_NE(cache.Lookup("file", 2, 0, &admit), nullptr);
+  // a page larger than the budget is never held
+  cache.Insert("file", 3, MakePage(300));
+  EXPECT_EQ(cache.Lookup("file", 3, 0, &admit), nullptr);
+
+  cache.set_capacity(0);
+  EXPECT_FALSE(cache.enabled());
+  EXPECT_EQ(cache.Lookup("file", 0, 0, &admit), nullptr);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -209,5 +209,48 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Finish();
 }
+
+TEST_F(TestShardReader, TestShardReaderColumnarBatch) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet as columns");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open(file_name, 4, column_list), SUCCESS);
+  ASSERT_EQ(dataset.Launch(true), SUCCESS);
+
+  const int32_t kBatchRows = 7;
+  int64_t row_id = 0;
+  while (true) {
+    ShardColumnarBatch batch;
+    ASSERT_EQ(dataset.GetColumnarBatch(row_id, kBatchRows, 0, &batch), SUCCESS);
+    if (batch.num_rows == 0) break;
+    ASSERT_EQ(batch.blob_offsets.size(), batch.num_rows + 1);
+    ASSERT_EQ(batch.columns.size(), 2);
+    ASSERT_EQ(batch.columns[0].name, "file_name");
+    ASSERT_EQ(batch.columns[1].name, "label");
+    for (uint32_t i = 0; i < batch.num_rows; ++i) {
+      auto row = dataset.GetNextById(row_id + i, 0);
+      ASSERT_EQ(row.size(), 1);
+      const auto &blob = std::get<0>(row[0]);
+      auto &label = std::get<1>(row[0]);
+      ASSERT_EQ(std::vector<uint8_t>(batch.blob_data.begin() + batch.blob_offsets[i],
+                                     batch.blob_data.begin() + batch.blob_offsets[i + 1]),
+                blob);
+      const auto &file_name_column = batch.columns[0];
+      ASSERT_EQ(std::string(file_name_column.data.begin() + file_name_column.offsets[i],
+                            file_name_column.data.begin() + file_name_column.offsets[i + 1]),
+                label["file_name"].get<std::string>());
+      const auto &label_column = batch.columns[1];
+      ASSERT_EQ(label_column.offsets[i + 1] - label_column.offsets[i], sizeof(int32_t));
+      int32_t label_value = 0;
+      (void)memcpy(&label_value, label_column.data.data() + label_column.offsets[i], sizeof(int32_t));
+      ASSERT_EQ(label_value, label["label"].get<int32_t>());
+    }
+    row_id += batch.num_rows;
+  }
+  ASSERT_EQ(row_id, dataset.get_num_rows());
+  dataset.Finish();
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -17,6 +17,7 @@
 #include <chrono>
 #include <cstring>
 #include <dirent.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -1460,5 +1461,225 @@ TEST_F(TestShardWriter, TestOpenForAppend) {
   MS_LOG(INFO) << "end ---- TestOpenForAppend\n";
 }
 
+TEST_F(TestShardWriter, TestShardWriterCompression) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test blob compression"));
+
+  // load binary data
+  std::vector<std::vector<uint8_t>> bin_data;
+  std::vector<std::string> filenames;
+  if (-1 == mindrecord::GetAbsoluteFiles("./data/mindrecord/testImageNetData/images", filenames)) {
+    MS_LOG(INFO) << "-- ATTN -- Missed data directory. Skip this case. -----------------";
+    return;
+  }
+  mindrecord::Img2DataUint8(filenames, bin_data);
+
+  // init shardHeader
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+
+  // load  meta data
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+  bin_data.resize(annotations.size());
+  std::map<std::uint64_t, std::vector<json>> rawdatas;
+  rawdatas.insert(pair<uint64_t, vector<json>>(anno_schema_id, annotations));
+
+  // write the blobs compressed
+  std::string filename = "./imagenet_zlib.shard01";
+  mindrecord::ShardWriter fw;
+  ASSERT_TRUE(fw.Open({filename}) == SUCCESS);
+  ASSERT_TRUE(fw.set_compression("lz77") == FAILED);
+  ASSERT_TRUE(fw.set_compression(kCompressionZlib) == SUCCESS);
+  ASSERT_TRUE(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+  std::vector<std::vector<uint8_t>> blobs = bin_data;
+  ASSERT_TRUE(fw.WriteRawData(rawdatas, blobs) == SUCCESS);
+  ASSERT_TRUE(fw.Commit() == SUCCESS);
+  mindrecord::ShardIndexGenerator sg{filename};
+  sg.Build();
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+
+  // every reading mode gets the blobs back as written
+  std::sort(bin_data.begin(), bin_data.end());
+  auto column_list = std::vector<std::string>{"label", "file_name", "data"};
+  for (bool block_reader : {false, true}) {
+    for (bool mmap_mode : {false, true}) {
+      ShardReader dataset;
+      ASSERT_EQ(dataset.Open(filename, 4, column_list, {}, block_reader, mmap_mode), SUCCESS);
+      dataset.Launch();
+      std::vector<std::vector<uint8_t>> read_data;
+      while (true) {
+        auto x = dataset.GetNext();
+        if (x.empty()) break;
+        for (auto &j : x) {
+          read_data.push_back(std::get<0>(j));
+        }
+      }
+      dataset.Finish();
+      std::sort(read_data.begin(), read_data.end());
+      ASSERT_TRUE(read_data == bin_data);
+    }
+  }
+
+  remove(common::SafeCStr(filename + ".db"));
+  remove(common::SafeCStr(filename + kRowDirectorySuffix));
+  remove(common::SafeCStr(filename));
+}
+
+TEST_F(TestShardWriter, TestShardWriterFlushBudget) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test background flush"));
+
+  // load binary data
+  std::vector<std::vector<uint8_t>> bin_data;
+  std::vector<std::string> filenames;
+  if (-1 == mindrecord::GetAbsoluteFiles("./data/mindrecord/testImageNetData/images", filenames)) {
+    MS_LOG(INFO) << "-- ATTN -- Missed data directory. Skip this case. -----------------";
+    return;
+  }
+  mindrecord::Img2DataUint8(filenames, bin_data);
+
+  // init shardHeader
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+
+  // load  meta data
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+  bin_data.resize(annotations.size());
+
+  // write the rows two by two, each batch is over the budget so only one waits for the disk at a time
+  std::string filename = "./imagenet_flush.shard01";
+  mindrecord::ShardWriter fw;
+  ASSERT_TRUE(fw.Open({filename}) == SUCCESS);
+  ASSERT_TRUE(fw.set_flush_budget(1) == SUCCESS);
+  ASSERT_TRUE(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+  for (size_t i = 0; i < annotations.size(); i += 2) {
+    auto end = std::min(i + 2, annotations.size());
+    std::map<std::uint64_t, std::vector<json>> rawdatas;
+    rawdatas[anno_schema_id] = std::vector<json>(annotations.begin() + i, annotations.begin() + end);
+    std::vector<std::vector<uint8_t>> blobs(bin_data.begin() + i, bin_data.begin() + end);
+    ASSERT_TRUE(fw.WriteRawData(rawdatas, blobs) == SUCCESS);
+  }
+  ASSERT_TRUE(fw.set_flush_budget(0) == FAILED);
+  ASSERT_TRUE(fw.Commit() == SUCCESS);
+  mindrecord::ShardIndexGenerator sg{filename};
+  sg.Build();
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+
+  // the rows are read back in the order of the batches
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open(filename, 4, {"label", "file_name", "data"}), SUCCESS);
+  dataset.Launch();
+  std::vector<std::vector<uint8_t>> read_data;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      read_data.push_back(std::get<0>(j));
+    }
+  }
+  dataset.Finish();
+  ASSERT_TRUE(read_data == bin_data);
+
+  remove(common::SafeCStr(filename + ".db"));
+  remove(common::SafeCStr(filename + kRowDirectorySuffix));
+  remove(common::SafeCStr(filename));
+}
+
+TEST_F(TestShardWriter, TestShardWriterRowDirectory) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test row directory"));
+
+  // load binary data
+  std::vector<std::vector<uint8_t>> bin_data;
+  std::vector<std::string> filenames;
+  if (-1 == mindrecord::GetAbsoluteFiles("./data/mindrecord/testImageNetData/images", filenames)) {
+    MS_LOG(INFO) << "-- ATTN -- Missed data directory. Skip this case. -----------------";
+    return;
+  }
+  mindrecord::Img2DataUint8(filenames, bin_data);
+
+  // init shardHeader
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json =
+    R"({"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  ASSERT_EQ(anno_schema_id, 0);
+  std::vector<std::string> index_fields{"label"};
+  ASSERT_TRUE(header_data.AddIndexFields(index_fields) == SUCCESS);
+
+  // load  meta data
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+  bin_data.resize(annotations.size());
+  std::map<std::uint64_t, std::vector<json>> rawdatas;
+  rawdatas.insert(pair<uint64_t, vector<json>>(anno_schema_id, annotations));
+
+  std::vector<std::string> file_names = {"./imagenet_dir.shard01", "./imagenet_dir.shard02"};
+  mindrecord::ShardWriter fw;
+  ASSERT_TRUE(fw.Open(file_names) == SUCCESS);
+  ASSERT_TRUE(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)) == SUCCESS);
+  ASSERT_TRUE(fw.WriteRawData(rawdatas, bin_data) == SUCCESS);
+  ASSERT_TRUE(fw.Commit() == SUCCESS);
+  mindrecord::ShardIndexGenerator sg{file_names[0]};
+  sg.Build();
+  ASSERT_TRUE(sg.WriteToDatabase() == SUCCESS);
+  for (const auto &file_name : file_names) {
+    ASSERT_EQ(access(common::SafeCStr(file_name + kRowDirectorySuffix), R_OK), 0);
+  }
+
+  auto read_rows = [&file_names](const std::vector<std::string> &column_list) {
+    ShardReader dataset;
+    std::vector<std::string> rows;
+    if (dataset.Open(file_names[0], 4, column_list) != SUCCESS) {
+      return rows;
+    }
+    dataset.Launch();
+    while (true) {
+      auto x = dataset.GetNext();
+      if (x.empty()) break;
+      for (auto &j : x) {
+        rows.push_back(std::get<1>(j).dump() + std::string(std::get<0>(j).begin(), std::get<0>(j).end()));
+      }
+    }
+    dataset.Finish();
+    return rows;
+  };
+
+  // the rows created from the row directories are the ones of the index databases
+  for (const auto &column_list : std::vector<std::vector<std::string>>{{"label"}, {"file_name", "label", "data"}}) {
+    auto from_directory = read_rows(column_list);
+    ASSERT_EQ(from_directory.size(), annotations.size());
+    for (const auto &file_name : file_names) {
+      ASSERT_EQ(rename(common::SafeCStr(file_name + kRowDirectorySuffix),
+                       common::SafeCStr(file_name + kRowDirectorySuffix + ".bak")),
+                0);
+    }
+    auto from_index = read_rows(column_list);
+    for (const auto &file_name : file_names) {
+      ASSERT_EQ(rename(common::SafeCStr(file_name + kRowDirectorySuffix + ".bak"),
+                       common::SafeCStr(file_name + kRowDirectorySuffix)),
+                0);
+    }
+    ASSERT_TRUE(from_directory == from_index);
+  }
+
+  for (const auto &file_name : file_names) {
+    remove(common::SafeCStr(file_name + ".db"));
+    remove(common::SafeCStr(file_name + kRowDirectorySuffix));
+    remove(common::SafeCStr(file_name));
+  }
+}
+
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -176,6 +176,23 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, SubstitutionsOfPrims) {
+  FuncGraphPtr before_idempotent = getPyFun.CallAndParseRet("test_idempotent", "before_2");
+  FuncGraphPtr after_idempotent = getPyFun.CallAndParseRet("test_idempotent", "after");
+  FuncGraphPtr before_constant = getPyFun.CallAndParseRet("test_constant_variable", "before_1");
+  FuncGraphPtr after_constant = getPyFun.CallAndParseRet("test_constant_variable", "after");
+
+  ASSERT_TRUE(nullptr != before_idempotent);
+  ASSERT_TRUE(nullptr != after_idempotent);
+  ASSERT_TRUE(nullptr != before_constant);
+  ASSERT_TRUE(nullptr != after_constant);
+
+  // each node only tries the substitutions of its primitive
+  auto opts = std::vector<SubstitutionPtr>({elim_Z, elim_R, idempotent_P, Qct_to_P});
+  ASSERT_TRUE(CheckOpt(before_idempotent, after_idempotent, opts));
+  ASSERT_TRUE(CheckOpt(before_constant, after_constant, opts));
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <string>
+#include "common/common_test.h"
+#include "parallel/auto_parallel/cost_calibration.h"
+#include "parallel/auto_parallel/costmodel.h"
+#include "parallel/device_manager.h"
+
+namespace mindspore {
+namespace parallel {
+class TestCostCalibration : public UT::Common {
+ public:
+  TestCostCalibration() {}
+  void SetUp();
+  void TearDown();
+  void WriteDatabase(const std::string& content);
+
+  std::string file_ = "./cost_calibration_test.json";
+};
+
+void TestCostCalibration::SetUp() {
+  std::list<int32_t> dev_list;
+  for (int32_t i = 0; i < 8; i++) {
+    dev_list.push_back(i);
+  }
+  std::list<int32_t> stage_map;
+  stage_map.push_back(8);
+  int32_t local_dev = 0;
+  g_device_manager = std::make_shared<DeviceManager>();
+  g_device_manager->Init(dev_list, local_dev, stage_map, "hccl");
+}
+
+void TestCostCalibration::TearDown() {
+  CostCalibration::GetInstance()->Clear();
+  (void)std::remove(file_.c_str());
+}
+
+void TestCostCalibration::WriteDatabase(const std::string& content) {
+  std::ofstream fout(file_);
+  fout << content;
+  fout.close();
+}
+
+TEST_F(TestCostCalibration, test_load) {
+  WriteDatabase(
+    "{\"device_num\": 8, \"reference\": {\"computation\": 2.0, \"communication\": 4.0},"
+    " \"operators\": {\"MatMul\": {\"computation\": 1.0, \"communication\": 12.0}, \"ReLU\": {\"computation\": 6.0}},"
+    " \"redistribution\": {\"communication\": 2.0}}");
+  auto calibration = CostCalibration::GetInstance();
+  calibration->Load(file_);
+  ASSERT_FALSE(calibration->empty());
+  EXPECT_DOUBLE_EQ(calibration->GetOperatorCalibration("MatMul").computation_scale, 0.5);
+  EXPECT_DOUBLE_EQ(calibration->GetOperatorCalibration("MatMul").communication_scale, 3.0);
+  EXPECT_DOUBLE_EQ(calibration->GetOperatorCalibration("ReLU").computation_scale, 3.0);
+  EXPECT_DOUBLE_EQ(calibration->GetOperatorCalibration("ReLU").communication_scale, 1.0);
+  EXPECT_DOUBLE_EQ(calibration->GetOperatorCalibration("Softmax").computation_scale, 1.0);
+  EXPECT_DOUBLE_EQ(calibration->redistribution_calibration().communication_scale, 0.5);
+
+  auto cost = std::make_shared<Cost>(100.0, 10.0);
+  cost->communication_without_parameter_ = 4.0;
+  cost->communication_with_partial_para_ = 6.0;
+  CalibrateForMeasuredCost(cost, calibration->GetOperatorCalibration("MatMul"));
+  EXPECT_DOUBLE_EQ(cost->memory_cost_, 50.0);
+  EXPECT_DOUBLE_EQ(cost->communication_cost_, 30.0);
+  EXPECT_DOUBLE_EQ(cost->communication_without_parameter_, 12.0);
+  EXPECT_DOUBLE_EQ(cost->communication_with_partial_para_, 18.0);
+}
+
+TEST_F(TestCostCalibration, test_ignore_other_topology) {
+  WriteDatabase("{\"device_num\": 16, \"operators\": {\"MatMul\": {\"computation\": 2.0}}}");
+  auto calibration = CostCalibration::GetInstance();
+  calibration->Load(file_);
+  EXPECT_TRUE(calibration->empty());
+  EXPECT_DOUBLE_EQ(calibration->GetOperatorCalibration("MatMul").computation_scale, 1.0);
+}
+}  // namespace parallel
+}  // namespace mindspore
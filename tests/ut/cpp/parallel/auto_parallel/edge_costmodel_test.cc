@@ -109,6 +109,30 @@ TEST_F(TestEdgeCostModel, test_InitEdgeCost) {
   ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
 }
 
+TEST_F(TestEdgeCostModel, test_InitEdgeCost_with_cache) {
+  std::string edge_name = "MatMul-MatMul";
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  Edge::ClearRedistributionCostCache();
+  std::shared_ptr<Edge> edge = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  ASSERT_EQ(edge->InitEdgeCost(), SUCCESS);
+  // the second edge between the same layouts takes the cached costs
+  std::shared_ptr<Edge> cached_edge = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  ASSERT_EQ(cached_edge->InitEdgeCost(), SUCCESS);
+  for (auto& output_swc : matmul1->GetStrategyCost()) {
+    for (auto& input_swc : matmul2->GetStrategyCost()) {
+      auto cost_list = edge->GetCostList(output_swc->strategy_ptr, input_swc->strategy_ptr);
+      auto cached_cost_list = cached_edge->GetCostList(output_swc->strategy_ptr, input_swc->strategy_ptr);
+      ASSERT_EQ(cost_list.size(), cached_cost_list.size());
+      for (size_t i = 0; i < cost_list.size(); ++i) {
+        ASSERT_NE(cost_list[i], cached_cost_list[i]);
+        ASSERT_DOUBLE_EQ(cost_list[i]->communication_cost_, cached_cost_list[i]->communication_cost_);
+        ASSERT_DOUBLE_EQ(cost_list[i]->memory_cost_, cached_cost_list[i]->memory_cost_);
+      }
+    }
+  }
+}
+
 TEST_F(TestEdgeCostModel, test_OpEliminationSetNewCost) {
   std::string edge_name = "MatMul-MatMul";
   std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
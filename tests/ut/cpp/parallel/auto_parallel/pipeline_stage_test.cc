@@ -0,0 +1,63 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "parallel/auto_parallel/pipeline_stage.h"
+
+namespace mindspore {
+namespace parallel {
+class TestPipelineStage : public UT::Common {
+ public:
+  TestPipelineStage() {}
+};
+
+TEST_F(TestPipelineStage, test_partition_stages) {
+  std::vector<double> op_costs = {4.0, 1.0, 1.0, 2.0, 3.0, 1.0};
+  std::vector<int32_t> stage_ids;
+  ASSERT_EQ(PartitionPipelineStages(op_costs, 3, &stage_ids), SUCCESS);
+  // the stages are [4], [1, 1, 2] and [3, 1]
+  std::vector<int32_t> expect = {0, 1, 1, 1, 2, 2};
+  ASSERT_EQ(stage_ids, expect);
+
+  ASSERT_EQ(PartitionPipelineStages(op_costs, 1, &stage_ids), SUCCESS);
+  ASSERT_EQ(stage_ids, std::vector<int32_t>(6, 0));
+  ASSERT_EQ(PartitionPipelineStages(op_costs, 7, &stage_ids), FAILED);
+}
+
+TEST_F(TestPipelineStage, test_one_forward_one_backward_schedule) {
+  // the first of 2 stages runs the forwards of 2 micro-batches before the first backward
+  auto schedule = OneForwardOneBackwardSchedule(0, 2, 3);
+  std::vector<bool> forward = {true, true, false, true, false, false};
+  std::vector<int32_t> micro_batch = {0, 1, 0, 2, 1, 2};
+  ASSERT_EQ(schedule.size(), forward.size());
+  for (size_t i = 0; i < schedule.size(); ++i) {
+    ASSERT_EQ(schedule[i].forward, forward[i]);
+    ASSERT_EQ(schedule[i].micro_batch, micro_batch[i]);
+  }
+
+  // the last stage alternates from the first micro-batch
+  schedule = OneForwardOneBackwardSchedule(1, 2, 2);
+  forward = {true, false, true, false};
+  micro_batch = {0, 0, 1, 1};
+  ASSERT_EQ(schedule.size(), forward.size());
+  for (size_t i = 0; i < schedule.size(); ++i) {
+    ASSERT_EQ(schedule[i].forward, forward[i]);
+    ASSERT_EQ(schedule[i].micro_batch, micro_batch[i]);
+  }
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -123,5 +123,47 @@ TEST_F(TestDeviceManager, test_CreateDeviceListByRankList) {
   ASSERT_EQ(it->rank(), int32_t(1));
 }
 
+TEST_F(TestDeviceManager, test_DeviceTopology) {
+  DeviceTopology flat;
+  ASSERT_EQ(flat.GetLevel(1024), INTRA_NODE);
+  ASSERT_DOUBLE_EQ(flat.CommunicationCost(100.0, flat.GetLevel(1024)), 100.0);
+
+  DeviceTopology topology;
+  topology.devices_per_node = 8;
+  topology.nodes_per_rack = 4;
+  topology.bandwidth_ratio[INTRA_RACK] = 0.5;
+  topology.bandwidth_ratio[INTER_RACK] = 0.25;
+  topology.latency[INTER_RACK] = 10.0;
+  ASSERT_EQ(topology.GetLevel(8), INTRA_NODE);
+  ASSERT_EQ(topology.GetLevel(9), INTRA_RACK);
+  ASSERT_EQ(topology.GetLevel(32), INTRA_RACK);
+  ASSERT_EQ(topology.GetLevel(33), INTER_RACK);
+  ASSERT_DOUBLE_EQ(topology.CommunicationCost(100.0, INTRA_NODE), 100.0);
+  ASSERT_DOUBLE_EQ(topology.CommunicationCost(100.0, INTRA_RACK), 200.0);
+  ASSERT_DOUBLE_EQ(topology.CommunicationCost(100.0, INTER_RACK), 410.0);
+  ASSERT_DOUBLE_EQ(topology.CommunicationCost(0.0, INTER_RACK), 0.0);
+}
+
+TEST_F(TestDeviceManager, test_SplitRanksByNode) {
+  RankList intra_ranks, inter_ranks;
+  ASSERT_EQ(SplitRanksByNode({0, 1, 2, 3, 4, 5, 6, 7}, 5, 4, &intra_ranks, &inter_ranks), Status::SUCCESS);
+  ASSERT_EQ(intra_ranks, RankList({4, 5, 6, 7}));
+  ASSERT_EQ(inter_ranks, RankList({1, 5}));
+
+  // the group of the ranks 1, 3, 5, ... on four nodes
+  ASSERT_EQ(SplitRanksByNode({1, 3, 5, 7, 9, 11, 13, 15}, 11, 4, &intra_ranks, &inter_ranks), Status::SUCCESS);
+  ASSERT_EQ(intra_ranks, RankList({9, 11}));
+  ASSERT_EQ(inter_ranks, RankList({3, 7, 11, 15}));
+
+  // in one node
+  ASSERT_EQ(SplitRanksByNode({0, 1, 2, 3}, 1, 4, &intra_ranks, &inter_ranks), Status::FAILED);
+  // one rank in each node
+  ASSERT_EQ(SplitRanksByNode({0, 4}, 4, 4, &intra_ranks, &inter_ranks), Status::FAILED);
+  // different numbers of ranks in the nodes
+  ASSERT_EQ(SplitRanksByNode({0, 1, 2, 4, 5}, 1, 4, &intra_ranks, &inter_ranks), Status::FAILED);
+  // not in the group
+  ASSERT_EQ(SplitRanksByNode({0, 1, 4, 5}, 2, 4, &intra_ranks, &inter_ranks), Status::FAILED);
+}
+
 }  // namespace parallel
 }  // namespace mindspore
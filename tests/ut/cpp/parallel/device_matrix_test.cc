@@ -91,5 +91,16 @@ TEST_F(TestDeviceMatrix, TestCornerCase2GetAlongDim) {
   EXPECT_THROW({ DeviceMatrix arr(8, dev_list, shape); }, std::runtime_error);
 }
 
+TEST_F(TestDeviceMatrix, TestGetRankSpanAlongDims) {
+  Shape shape = {2, 4, 2};
+  // the groups along the last dimension are [0, 1]
+  ASSERT_EQ(GetRankSpanAlongDims(shape, {2}), 2);
+  // the groups along the first dimension are [0, 8]
+  ASSERT_EQ(GetRankSpanAlongDims(shape, {0}), 9);
+  // the groups along the last two dimensions are [0 .. 7]
+  ASSERT_EQ(GetRankSpanAlongDims(shape, {1, 2}), 8);
+  ASSERT_EQ(GetRankSpanAlongDims(shape, {}), 1);
+}
+
 }  // namespace parallel
 }  // namespace mindspore
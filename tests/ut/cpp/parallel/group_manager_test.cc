@@ -151,5 +151,25 @@ TEST_F(TestGroupManager, test_FindGroup) {
   gp_ptr2 = nullptr;
 }
 
+TEST_F(TestGroupManager, test_InitGroups) {
+  Group* gp_ptr = new Group();
+  ASSERT_EQ(Init(&gp_ptr), Status::SUCCESS);
+  delete gp_ptr;
+  gp_ptr = nullptr;
+  // the communicator is only created when the group is used
+  ASSERT_FALSE(gm.IsGroupInitialized("1-2"));
+
+  std::list<Device> dev_list;
+  dev_list.push_back(Device(int32_t(3)));
+  dev_list.push_back(Device(int32_t(4)));
+  Group gp;
+  ASSERT_EQ(gm.CreateGroup("3-4", dev_list, &gp), Status::SUCCESS);
+  ASSERT_EQ(gm.InitGroups({"3-4", "1-2", "3-4", "5-6"}), Status::SUCCESS);
+  ASSERT_TRUE(gm.IsGroupInitialized("1-2"));
+  ASSERT_TRUE(gm.IsGroupInitialized("3-4"));
+  ASSERT_FALSE(gm.IsGroupInitialized("5-6"));
+  ASSERT_EQ(gm.DestroyAllGroups(), Status::SUCCESS);
+}
+
 }  // namespace parallel
 }  // namespace mindspore
@@ -17,6 +17,7 @@
 #include "common/common_test.h"
 #include "common/py_func_graph_fetcher.h"
 #include "parallel/tensor_layout/redistribution_operator_infer.h"
+#include "parallel/context.h"
 #include "parallel/device_manager.h"
 #include "util_layout_gen_test.h"
 
@@ -45,7 +46,7 @@ class TestRedistributionOperatorInfer : public UT::Common {
     g_device_manager->Init(dev_list, local_dev, stage_map, "hccl");
   }
 
-  virtual void TearDown() {}
+  virtual void TearDown() { ParallelContext::GetInstance()->set_enable_alltoall(false); }
 };
 
 // check if in_tensor_map could be changed to out_tensor_map with operator_list
@@ -107,5 +108,37 @@ TEST_F(TestRedistributionOperatorInfer, TestInferOperatorAll) {
   ASSERT_EQ(status, Status::SUCCESS);
 }
 
+TEST_F(TestRedistributionOperatorInfer, TestInferOperatorAllWithAlltoAll) {
+  ParallelContext::GetInstance()->set_enable_alltoall(true);
+  uint32_t dim_len = 3;
+  Status status = InferOperatorCheckAll(dim_len);
+  ASSERT_EQ(status, Status::SUCCESS);
+}
+
+OperatorC CreateOperatorC(const OperatorName& name, const Args& args) {
+  return std::make_pair(std::make_pair(name, args), Shape({16, 16}));
+}
+
+TEST_F(TestRedistributionOperatorInfer, TestMergeRedistributionOperators) {
+  // the split is cancelled by the concat of the same dimensions, the concat followed by the split of another tensor
+  // dimension along the same device dimension is kept without all-to-all
+  OperatorList operator_list = {CreateOperatorC(SPLIT_BY_AXIS, {2, 0, 1}), CreateOperatorC(CONCAT_BY_AXIS, {0, 1, 2}),
+                                CreateOperatorC(CONCAT_BY_AXIS, {1, 0, 2}), CreateOperatorC(SPLIT_BY_AXIS, {2, 0, 0})};
+  OperatorList merged = MergeRedistributionOperators(operator_list, false);
+  ASSERT_EQ(merged.size(), 2);
+  ASSERT_EQ(merged[0].first.first, CONCAT_BY_AXIS);
+  ASSERT_EQ(merged[1].first.first, SPLIT_BY_AXIS);
+
+  merged = MergeRedistributionOperators(operator_list, true);
+  ASSERT_EQ(merged.size(), 1);
+  ASSERT_EQ(merged[0].first.first, PERMUTE_BY_AXIS);
+  ASSERT_EQ(merged[0].first.second, Args({2, 0, 1, 0}));
+
+  // the split along another device dimension is kept
+  operator_list = {CreateOperatorC(CONCAT_BY_AXIS, {1, 0, 2}), CreateOperatorC(SPLIT_BY_AXIS, {2, 0, 1})};
+  merged = MergeRedistributionOperators(operator_list, true);
+  ASSERT_EQ(merged.size(), 2);
+}
+
 }  // namespace parallel
 }  // namespace mindspore
@@ -458,7 +458,8 @@ static KernelGraphPtr CreateKernelGraphForBufferFusionSingleIn(
 
 static KernelGraphPtr CreateKernelGraphForBufferFusion(
   uint32_t targetlayers, bool conv_flag = false,
-  mindspore::kernel::FusionType fusiontype = mindspore::kernel::CONVLUTION) {
+  mindspore::kernel::FusionType fusiontype = mindspore::kernel::CONVLUTION,
+  const std::vector<int> &shp = {1, 3, 3, 4}) {
   // build the func_graph manually, eg:
   /* CreateKernelGraphForBufferFusion(3)
    * @mindspore
@@ -471,7 +472,6 @@ static KernelGraphPtr CreateKernelGraphForBufferFusion(
   KernelGraphPtr g = std::make_shared<KernelGraph>();
   std::vector<AnfNodePtr> inputs;
   // x is input tensor.
-  std::vector<int> shp = {1, 3, 3, 4};
   tensor::TensorPtr x_tensor = std::make_shared<tensor::Tensor>(kFloat32->type_id(), shp);
 
   TensorTypePtr tensor_type = std::make_shared<TensorType>(kFloat32);
@@ -1235,6 +1235,25 @@ TEST_F(TestHWBufferFusion, BufferFusionSegment) {
   ASSERT_EQ(manager->all_nodes().size(), 5);
 }
 
+TEST_F(TestHWBufferFusion, BufferFusionUbCapacity) {
+  // 6 elementwise layers of 512KB tensors, whose live tensors tile through the unified buffer together
+  KernelGraphPtr graph_ptr =
+    CreateKernelGraphForBufferFusion(6, false, mindspore::kernel::CONVLUTION, std::vector<int>{32, 4, 32, 32});
+  ASSERT_TRUE(nullptr != graph_ptr);
+  mindspore::opt::BufferFusion buffer_fusion = BufferFusion();
+  std::vector<FuncGraphPtr> graphs{graph_ptr};
+  FuncGraphManagerPtr manager = std::make_shared<FuncGraphManager>(graphs);
+  manager->AddFuncGraph(graph_ptr);
+  ASSERT_EQ(buffer_fusion.MatchBufferFusionPattern(*graph_ptr), true);
+  std::unordered_map<int, BufferFusionInfo_t> buffer_fusion_infos;
+  buffer_fusion.GetBufferFusionInfo(*graph_ptr, &buffer_fusion_infos);
+  ASSERT_EQ(buffer_fusion_infos.size(), 1);
+  auto &buffer_fusion_info = buffer_fusion_infos.begin()->second;
+  EXPECT_EQ(buffer_fusion_info.anf_nodes.size(), 6);
+  EXPECT_EQ(buffer_fusion_info.inputs_list.size(), 1);
+  EXPECT_EQ(buffer_fusion_info.outputs_list.size(), 1);
+}
+
 TEST_F(TestHWBufferFusion, BufferFusionEltwise1BeforeAnd3After) {
   KernelGraphPtr graph_ptr = CreateKernelGraphForBufferFusionEltwiseBeforeAndAfter(1);
   ASSERT_TRUE(nullptr != graph_ptr);
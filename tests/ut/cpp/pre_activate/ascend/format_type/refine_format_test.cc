@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "utils/utils.h"
+
+#define private public
+#define protected public
+#include "pre_activate/ascend/format_type/refine_format.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace opt {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+namespace {
+kernel::KernelBuildInfoPtr CreateKernelBuildInfo(const std::vector<std::string> &inputs_format,
+                                                 const std::vector<std::string> &outputs_format) {
+  KernelBuildInfoBuilder builder;
+  builder.SetInputsFormat(inputs_format);
+  builder.SetInputsDeviceType(std::vector<TypeId>(inputs_format.size(), kNumberTypeFloat16));
+  builder.SetOutputsFormat(outputs_format);
+  builder.SetOutputsDeviceType(std::vector<TypeId>(outputs_format.size(), kNumberTypeFloat16));
+  return builder.Build();
+}
+}  // namespace
+
+class TestHWRefineFormat : public BackendCommon {
+ public:
+  TestHWRefineFormat() = default;
+  ~TestHWRefineFormat() override = default;
+
+  // add(relu(add(x, y)), y) or relu(add(x, y)), where the adds are selected in NC1HWC0 and the relu in default format
+  std::shared_ptr<session::KernelGraph> CreateGraph(bool relu_to_output) {
+    auto kernel_graph = std::make_shared<session::KernelGraph>();
+    auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat16, std::vector<int>{2, 32, 224, 224});
+    auto x = kernel_graph->NewParameter();
+    x->set_abstract(abstract);
+    AnfAlgo::SetSelectKernelBuildInfo(CreateKernelBuildInfo({}, {kOpFormat_NC1HWC0}), x.get());
+    auto y = kernel_graph->NewParameter();
+    y->set_abstract(abstract);
+    AnfAlgo::SetSelectKernelBuildInfo(CreateKernelBuildInfo({}, {kOpFormat_NC1HWC0}), y.get());
+
+    auto add = kernel_graph->NewCNode({NewValueNode(std::make_shared<Primitive>(prim::kPrimTensorAdd->name())), x, y});
+    add->set_abstract(abstract);
+    AnfAlgo::SetSelectKernelBuildInfo(
+      CreateKernelBuildInfo({kOpFormat_NC1HWC0, kOpFormat_NC1HWC0}, {kOpFormat_NC1HWC0}), add.get());
+    relu_ = kernel_graph->NewCNode({NewValueNode(std::make_shared<Primitive>(prim::kPrimRelu->name())), add});
+    relu_->set_abstract(abstract);
+    AnfAlgo::SetSelectKernelBuildInfo(CreateKernelBuildInfo({kOpFormat_DEFAULT}, {kOpFormat_DEFAULT}), relu_.get());
+    if (relu_to_output) {
+      kernel_graph->set_output(kernel_graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), relu_}));
+      return kernel_graph;
+    }
+    auto add2 =
+      kernel_graph->NewCNode({NewValueNode(std::make_shared<Primitive>(prim::kPrimTensorAdd->name())), relu_, y});
+    add2->set_abstract(abstract);
+    AnfAlgo::SetSelectKernelBuildInfo(
+      CreateKernelBuildInfo({kOpFormat_NC1HWC0, kOpFormat_NC1HWC0}, {kOpFormat_NC1HWC0}), add2.get());
+    kernel_graph->set_output(kernel_graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), add2}));
+    return kernel_graph;
+  }
+
+  void RunPass(const std::shared_ptr<session::KernelGraph> &kernel_graph);
+
+  CNodePtr relu_;
+};
+
+class MockRefineFormatKernelQuery : public KernelQuery {
+ public:
+  MockRefineFormatKernelQuery() = default;
+  ~MockRefineFormatKernelQuery() override = default;
+  void Query(const CNodePtr &kernel_node,
+             std::vector<std::shared_ptr<kernel::KernelBuildInfo>> *kernel_info_list) override {
+    if (AnfAlgo::GetCNodeName(kernel_node) == prim::kPrimRelu->name()) {
+      kernel_info_list->push_back(CreateKernelBuildInfo({kOpFormat_DEFAULT}, {kOpFormat_DEFAULT}));
+      kernel_info_list->push_back(CreateKernelBuildInfo({kOpFormat_NC1HWC0}, {kOpFormat_NC1HWC0}));
+    }
+  }
+};
+
+void TestHWRefineFormat::RunPass(const std::shared_ptr<session::KernelGraph> &kernel_graph) {
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  auto pass = std::make_shared<opt::RefineFormat>();
+  pass->kernel_query_ = std::make_shared<MockRefineFormatKernelQuery>();
+  pm->AddPass(pass);
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+}
+
+TEST_F(TestHWRefineFormat, test_refine_format_between_5hd_kernels) {
+  auto kernel_graph = CreateGraph(false);
+  RunPass(kernel_graph);
+  // the relu between two NC1HWC0 adds takes NC1HWC0 too, so no TransData is left around it
+  EXPECT_EQ(AnfAlgo::GetInputFormat(relu_, 0), kOpFormat_NC1HWC0);
+  EXPECT_EQ(AnfAlgo::GetOutputFormat(relu_, 0), kOpFormat_NC1HWC0);
+}
+
+TEST_F(TestHWRefineFormat, test_keep_format_on_equal_cost) {
+  auto kernel_graph = CreateGraph(true);
+  RunPass(kernel_graph);
+  // one TransData is needed before or after the relu either way, the selected kernel info is kept
+  EXPECT_EQ(AnfAlgo::GetInputFormat(relu_, 0), kOpFormat_DEFAULT);
+  EXPECT_EQ(AnfAlgo::GetOutputFormat(relu_, 0), kOpFormat_DEFAULT);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "ir/anf.h"
+#include "common/py_func_graph_fetcher.h"
+#include "operator/ops.h"
+#include "kernel/kernel_build_info.h"
+#include "session/anf_runtime_algorithm.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "pre_activate/gpu/apply_momentum_fusion.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWApplyMomentumFusion : public BackendCommon {
+ public:
+  TestHWApplyMomentumFusion() : getPyFun_("gtest_input.pre_activate.apply_momentum_fusion_test", true) {}
+  ~TestHWApplyMomentumFusion() override = default;
+
+ public:
+  UT::PyFuncGraphFetcher getPyFun_;
+};
+
+TEST_F(TestHWApplyMomentumFusion, test_apply_momentum_fusion) {
+  FuncGraphPtr g = getPyFun_.CallAndParseRet("test_apply_momentum_fusion", "before");
+  ASSERT_TRUE(g != nullptr);
+  std::vector<int> shp{2, 32, 224, 224};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+  AbstractBasePtrList args_spec_list(8, x_abstract);
+  auto kernel_graph = GetKernelGraph(g, args_spec_list);
+  ASSERT_TRUE(kernel_graph != nullptr);
+  // the float32 kernels selected on GPU
+  std::vector<AnfNodePtr> nodes(kernel_graph->inputs().begin(), kernel_graph->inputs().end());
+  nodes.insert(nodes.end(), kernel_graph->execution_order().begin(), kernel_graph->execution_order().end());
+  for (auto &node : nodes) {
+    size_t input_num = node->isa<CNode>() ? AnfAlgo::GetInputTensorNum(node) : 0;
+    kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+    builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+    builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({kNumberTypeFloat32});
+    AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+  }
+  auto var0 = kernel_graph->inputs()[0];
+  auto var1 = kernel_graph->inputs()[5];
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::ApplyMomentumFusion>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+
+  // make_tuple(apply_momentum, apply_momentum) -> make_tuple(tuple_getitem(fused, 0), tuple_getitem(fused, 1))
+  auto make_tuple = kernel_graph->output();
+  ASSERT_TRUE(IsPrimitiveCNode(make_tuple, prim::kPrimMakeTuple));
+  auto out0 = make_tuple->cast<CNodePtr>()->input(1);
+  auto out1 = make_tuple->cast<CNodePtr>()->input(2);
+  ASSERT_TRUE(IsPrimitiveCNode(out0, prim::kPrimTupleGetItem));
+  ASSERT_TRUE(IsPrimitiveCNode(out1, prim::kPrimTupleGetItem));
+  auto fused = out0->cast<CNodePtr>()->input(1);
+  EXPECT_EQ(out1->cast<CNodePtr>()->input(1), fused);
+  ASSERT_EQ(AnfAlgo::GetCNodeName(fused), kFusedApplyMomentumOpName);
+  auto fused_cnode = fused->cast<CNodePtr>();
+  ASSERT_EQ(fused_cnode->inputs().size(), 11);
+  EXPECT_EQ(fused_cnode->input(1), var0);
+  EXPECT_EQ(fused_cnode->input(6), var1);
+  EXPECT_EQ(AnfAlgo::GetOutputTensorNum(fused), 2);
+  EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(fused, 9), kNumberTypeFloat32);
+}
+}  // namespace opt
+}  // namespace mindspore
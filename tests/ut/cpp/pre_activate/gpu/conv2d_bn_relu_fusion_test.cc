@@ -0,0 +1,100 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "ir/anf.h"
+#include "common/py_func_graph_fetcher.h"
+#include "operator/ops.h"
+#include "kernel/kernel_build_info.h"
+#include "session/anf_runtime_algorithm.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "pre_activate/gpu/conv2d_bn_relu_fusion.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWConv2DBNReluFusion : public BackendCommon {
+ public:
+  TestHWConv2DBNReluFusion() : getPyFun_("gtest_input.pre_activate.conv2d_bn_relu_fusion_test", true) {}
+  ~TestHWConv2DBNReluFusion() override = default;
+
+  KernelGraphPtr GetOptimizedGraph(const std::string &tag) {
+    FuncGraphPtr g = getPyFun_.CallAndParseRet("test_conv2d_bn_relu_fusion", tag);
+    EXPECT_TRUE(g != nullptr);
+    std::vector<int> shp_x{32, 64, 56, 56};
+    std::vector<int> shp_w{64, 64, 3, 3};
+    std::vector<int> shp_b{64};
+    auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp_x);
+    auto w_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp_w);
+    auto b_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp_b);
+    AbstractBasePtrList args_spec_list{x_abstract, w_abstract, b_abstract, b_abstract, b_abstract, b_abstract};
+    auto kernel_graph = GetKernelGraph(g, args_spec_list);
+    EXPECT_TRUE(kernel_graph != nullptr);
+    // the float32 kernels selected on GPU
+    std::vector<AnfNodePtr> nodes(kernel_graph->inputs().begin(), kernel_graph->inputs().end());
+    nodes.insert(nodes.end(), kernel_graph->execution_order().begin(), kernel_graph->execution_order().end());
+    for (auto &node : nodes) {
+      size_t input_num = node->isa<CNode>() ? AnfAlgo::GetInputTensorNum(node) : 0;
+      size_t output_num = AnfAlgo::GetOutputTensorNum(node);
+      kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+      builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+      builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+      builder.SetOutputsFormat(std::vector<std::string>(output_num, kOpFormat_DEFAULT));
+      builder.SetOutputsDeviceType(std::vector<TypeId>(output_num, kNumberTypeFloat32));
+      AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+    }
+
+    auto optimizer = std::make_shared<opt::GraphOptimizer>();
+    auto pm = std::make_shared<opt::PassManager>();
+    pm->AddPass(std::make_shared<opt::Conv2DBNReluFusion>());
+    optimizer->AddPassManager(pm);
+    (void)optimizer->Optimize(kernel_graph);
+    return kernel_graph;
+  }
+
+ public:
+  UT::PyFuncGraphFetcher getPyFun_;
+};
+
+TEST_F(TestHWConv2DBNReluFusion, test_conv2d_bn_relu_fusion) {
+  auto kernel_graph = GetOptimizedGraph("before");
+  auto x = kernel_graph->inputs()[0];
+  auto variance = kernel_graph->inputs()[5];
+
+  // relu(tuple_getitem(batch_norm(conv2d(x, w), ...), 0)) -> fused_conv2d_bn_relu(x, w, ...)
+  auto output = kernel_graph->output();
+  ASSERT_TRUE(output != nullptr);
+  ASSERT_EQ(AnfAlgo::GetCNodeName(output), kFusedConv2DBNReluOpName);
+  auto fused_cnode = output->cast<CNodePtr>();
+  ASSERT_EQ(fused_cnode->inputs().size(), 7);
+  EXPECT_EQ(fused_cnode->input(1), x);
+  EXPECT_EQ(fused_cnode->input(6), variance);
+  EXPECT_TRUE(AnfAlgo::HasNodeAttr(kAttrEpsilon, fused_cnode));
+  EXPECT_TRUE(AnfAlgo::HasNodeAttr("pad_mode", fused_cnode));
+  EXPECT_EQ(AnfAlgo::GetOutputInferShape(output, 0), std::vector<size_t>({32, 64, 56, 56}));
+  EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(output, 5), kNumberTypeFloat32);
+}
+
+TEST_F(TestHWConv2DBNReluFusion, test_conv2d_bn_relu_fusion_used_by_others) {
+  auto kernel_graph = GetOptimizedGraph("before_used_by_others");
+  // the output of the BatchNorm is used by the TensorAdd too
+  auto make_tuple = kernel_graph->output();
+  ASSERT_TRUE(IsPrimitiveCNode(make_tuple, prim::kPrimMakeTuple));
+  auto relu = make_tuple->cast<CNodePtr>()->input(1);
+  EXPECT_TRUE(IsPrimitiveCNode(relu, prim::kPrimRelu));
+}
+}  // namespace opt
+}  // namespace mindspore
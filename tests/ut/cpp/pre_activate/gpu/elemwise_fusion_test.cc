@@ -0,0 +1,112 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "ir/anf.h"
+#include "common/py_func_graph_fetcher.h"
+#include "operator/ops.h"
+#include "kernel/kernel_build_info.h"
+#include "session/anf_runtime_algorithm.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "pre_activate/gpu/elemwise_fusion.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWElemwiseFusion : public BackendCommon {
+ public:
+  TestHWElemwiseFusion() : getPyFun_("gtest_input.pre_activate.elemwise_fusion_test", true) {}
+  ~TestHWElemwiseFusion() override = default;
+
+  std::shared_ptr<session::KernelGraph> GetFloatKernelGraph(const std::string &name) {
+    FuncGraphPtr g = getPyFun_.CallAndParseRet("test_elemwise_fusion", name);
+    MS_EXCEPTION_IF_NULL(g);
+    std::vector<int> shp{2, 32, 224, 224};
+    auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+    AbstractBasePtrList args_spec_list{x_abstract, x_abstract};
+    auto kernel_graph = GetKernelGraph(g, args_spec_list);
+    MS_EXCEPTION_IF_NULL(kernel_graph);
+    std::vector<AnfNodePtr> nodes(kernel_graph->inputs().begin(), kernel_graph->inputs().end());
+    nodes.insert(nodes.end(), kernel_graph->execution_order().begin(), kernel_graph->execution_order().end());
+    for (auto &node : nodes) {
+      size_t input_num = node->isa<CNode>() ? AnfAlgo::GetInputTensorNum(node) : 0;
+      kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+      builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+      builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+      builder.SetOutputsFormat({kOpFormat_DEFAULT});
+      builder.SetOutputsDeviceType({kNumberTypeFloat32});
+      AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+    }
+    return kernel_graph;
+  }
+
+  void RunElemwiseFusion(const std::shared_ptr<session::KernelGraph> &kernel_graph) {
+    auto optimizer = std::make_shared<opt::GraphOptimizer>();
+    auto pm = std::make_shared<opt::PassManager>();
+    pm->AddPass(std::make_shared<opt::ElemwiseFusion>());
+    optimizer->AddPassManager(pm);
+    (void)optimizer->Optimize(kernel_graph);
+  }
+
+ public:
+  UT::PyFuncGraphFetcher getPyFun_;
+};
+
+TEST_F(TestHWElemwiseFusion, test_elemwise_fusion_chain) {
+  auto kernel_graph = GetFloatKernelGraph("chain");
+  auto x = kernel_graph->inputs()[0];
+  auto y = kernel_graph->inputs()[1];
+  RunElemwiseFusion(kernel_graph);
+
+  // relu(add(mul(x, y), x)) -> fused_elemwise(x, y)
+  auto fused = kernel_graph->output();
+  ASSERT_TRUE(fused->isa<CNode>());
+  ASSERT_EQ(AnfAlgo::GetCNodeName(fused), kFusedElemwiseOpName);
+  auto fused_cnode = fused->cast<CNodePtr>();
+  ASSERT_EQ(fused_cnode->inputs().size(), 3);
+  EXPECT_EQ(fused_cnode->input(1), x);
+  EXPECT_EQ(fused_cnode->input(2), y);
+  std::vector<std::string> ops{"Mul", "TensorAdd", "ReLU"};
+  std::vector<int> lhs{0, 2, 3};
+  std::vector<int> rhs{1, 0, -1};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused, kAttrFusedOps), ops);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedOpLhs), lhs);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedOpRhs), rhs);
+  EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(fused, 0), kNumberTypeFloat32);
+  EXPECT_EQ(AnfAlgo::GetInputDeviceDataType(fused, 1), kNumberTypeFloat32);
+}
+
+TEST_F(TestHWElemwiseFusion, test_elemwise_fusion_shared_output) {
+  auto kernel_graph = GetFloatKernelGraph("shared");
+  RunElemwiseFusion(kernel_graph);
+
+  // make_tuple(relu(mul), exp(neg(mul))) -> make_tuple(relu(mul), fused_elemwise(mul))
+  auto make_tuple = kernel_graph->output();
+  ASSERT_TRUE(IsPrimitiveCNode(make_tuple, prim::kPrimMakeTuple));
+  auto relu = make_tuple->cast<CNodePtr>()->input(1);
+  ASSERT_TRUE(IsPrimitiveCNode(relu, prim::kPrimRelu));
+  auto mul = relu->cast<CNodePtr>()->input(1);
+  ASSERT_EQ(AnfAlgo::GetCNodeName(mul), "Mul");
+  auto fused = make_tuple->cast<CNodePtr>()->input(2);
+  ASSERT_EQ(AnfAlgo::GetCNodeName(fused), kFusedElemwiseOpName);
+  auto fused_cnode = fused->cast<CNodePtr>();
+  ASSERT_EQ(fused_cnode->inputs().size(), 2);
+  EXPECT_EQ(fused_cnode->input(1), mul);
+  std::vector<std::string> ops{"Neg", "Exp"};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused, kAttrFusedOps), ops);
+}
+}  // namespace opt
+}  // namespace mindspore
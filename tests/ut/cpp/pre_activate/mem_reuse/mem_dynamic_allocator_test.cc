@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "pre_activate/mem_reuse/mem_dynamic_allocator.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+// The memory pool over a host buffer
+class HostMemPool : public DynamicMemPoolBestFit {
+ public:
+  HostMemPool() : buffer_(kBufferSize) {}
+  ~HostMemPool() override = default;
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    if (used_ != 0 || size > kBufferSize) {
+      return 0;
+    }
+    used_ = size;
+    *addr = buffer_.data();
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &) override {
+    used_ = 0;
+    return true;
+  }
+  size_t free_mem_size() override { return kBufferSize - used_; }
+  size_t total_mem_size() override { return kBufferSize; }
+
+ protected:
+  size_t mem_alloc_unit_size() const override { return kBufferSize; }
+
+ private:
+  static const size_t kBufferSize = 4 << 20;
+  std::vector<uint8_t> buffer_;
+  size_t used_{0};
+};
+
+class TestDynamicMemPool : public UT::Common {
+ public:
+  TestDynamicMemPool() {}
+};
+
+TEST_F(TestDynamicMemPool, cached_mem_buf) {
+  HostMemPool mem_pool;
+  auto addr1 = mem_pool.AllocTensorMem(1000);
+  auto addr2 = mem_pool.AllocTensorMem(1000);
+  ASSERT_NE(addr1, nullptr);
+  ASSERT_NE(addr2, nullptr);
+  ASSERT_EQ(mem_pool.used_mem_statistics(), 2048);
+  // the small memory buf is cached by size class, and taken again by the same size on the same stream
+  mem_pool.FreeTensorMem(addr1);
+  ASSERT_EQ(mem_pool.cached_mem_statistics(), 1024);
+  ASSERT_EQ(mem_pool.used_mem_statistics(), 1024);
+  ASSERT_EQ(mem_pool.AllocTensorMem(600), addr1);
+  ASSERT_EQ(mem_pool.cached_mem_statistics(), 0);
+  // a memory buf cached on another stream is not taken
+  mem_pool.FreeTensorMem(addr2, 1);
+  auto addr3 = mem_pool.AllocTensorMem(1000);
+  ASSERT_NE(addr3, addr2);
+  ASSERT_EQ(mem_pool.cached_mem_statistics(), 1024);
+  // the large memory buf is combined at once
+  auto addr4 = mem_pool.AllocTensorMem(2 << 20);
+  ASSERT_NE(addr4, nullptr);
+  mem_pool.FreeTensorMem(addr4);
+  ASSERT_EQ(mem_pool.cached_mem_statistics(), 1024);
+  // the cached memory bufs are combined before the memory pool extends
+  mem_pool.FreeTensorMem(addr3);
+  ASSERT_EQ(mem_pool.cached_mem_statistics(), 2048);
+  auto addr5 = mem_pool.AllocTensorMem((4 << 20) - 1024);
+  ASSERT_NE(addr5, nullptr);
+  ASSERT_EQ(mem_pool.cached_mem_statistics(), 0);
+  mem_pool.DumpDynamicMemPoolInfo();
+}
+
+TEST_F(TestDynamicMemPool, release_idle_mem_block) {
+  HostMemPool mem_pool;
+  auto addr1 = mem_pool.AllocTensorMem(1000);
+  auto addr2 = mem_pool.AllocTensorMem(2 << 20);
+  ASSERT_NE(addr1, nullptr);
+  ASSERT_NE(addr2, nullptr);
+  // the memory block is kept while a memory buf in it is used
+  mem_pool.FreeTensorMem(addr2);
+  ASSERT_EQ(mem_pool.ReleaseIdleMemBlock(), 0);
+  ASSERT_EQ(mem_pool.total_mem_statistics(), 4 << 20);
+  // the cached memory buf is combined before the memory block is released
+  mem_pool.FreeTensorMem(addr1);
+  ASSERT_EQ(mem_pool.ReleaseIdleMemBlock(), 4 << 20);
+  ASSERT_EQ(mem_pool.total_mem_statistics(), 0);
+  ASSERT_EQ(mem_pool.cached_mem_statistics(), 0);
+  // the memory pool extends again
+  ASSERT_NE(mem_pool.AllocTensorMem(1000), nullptr);
+  ASSERT_EQ(mem_pool.total_mem_statistics(), 4 << 20);
+}
+}  // namespace device
+}  // namespace mindspore
@@ -20,6 +20,7 @@
 #include "operator/ops.h"
 #include "pre_activate/mem_reuse/mem_reuse.h"
 #include "pre_activate/mem_reuse/mem_reuse_allocator.h"
+#include "pre_activate/mem_reuse/mem_reuse_planner.h"
 
 #include "common/common_test.h"
 #include "common/py_func_graph_fetcher.h"
@@ -32,6 +33,7 @@ using mindspore::memreuse::KernelRefCountPtr;
 using mindspore::memreuse::MemReuseUtil;
 using mindspore::memreuse::MemReuseUtilPtr;
 using mindspore::memreuse::RefCountType;
+using mindspore::memreuse::StaticMemPlanner;
 using MembufPtr = std::shared_ptr<mindspore::memreuse::Membuf>;
 
 namespace mindspore {
@@ -122,6 +124,30 @@ TEST_F(TestMemReuseAllocator, mem_reuse_allocator) {
   ASSERT_EQ(is_reusable_stream, true);
 }
 
+TEST_F(TestMemReuseAllocator, static_mem_planner) {
+  auto mem_reuse_util_ptr = std::make_shared<MemReuseUtil>();
+  InitMemReuseUtils(mem_reuse_util_ptr.get());
+  auto static_mem_planner = std::make_shared<StaticMemPlanner>();
+  static_mem_planner->Plan(mem_reuse_util_ptr.get());
+  // tensor_0, tensor_2, tensor_3 and tensor_4 are live at kernel3
+  ASSERT_EQ(static_mem_planner->lower_bound(), 5632);
+  ASSERT_EQ(static_mem_planner->planned_size(), 5632);
+  static_mem_planner->Apply();
+  auto tensors = mem_reuse_util_ptr->total_refs_list();
+  ASSERT_EQ(tensors[4]->offset_, 0);
+  ASSERT_EQ(tensors[2]->offset_, 2560);
+  ASSERT_EQ(tensors[1]->offset_, 0);
+  ASSERT_EQ(tensors[0]->offset_, 4096);
+  ASSERT_EQ(tensors[3]->offset_, 5120);
+  // tensor_5 only lives at kernel4, in the gap left by tensor_2
+  ASSERT_EQ(tensors[5]->offset_, 2560);
+
+  // the refcounts are left for the best fit reuse
+  auto best_fit_mem_reuse = std::make_shared<BestFitMemReuse>();
+  best_fit_mem_reuse->Reuse(mem_reuse_util_ptr.get());
+  ASSERT_GE(best_fit_mem_reuse->GetAllocatedSize(), static_mem_planner->lower_bound());
+}
+
 TEST_F(TestMemReuseAllocator, mem_reuse_allocator_add_membuf) {
   auto best_fit_mem_reuse = std::make_shared<BestFitMemReuse>();
   auto tensor_desc = std::make_shared<KernelRefCount>();
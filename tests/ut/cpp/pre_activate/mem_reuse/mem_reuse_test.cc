@@ -21,7 +21,9 @@
 #include "session/ascend_session.h"
 #include "pre_activate/mem_reuse/kernel_refcount.h"
 #include "pre_activate/mem_reuse/mem_reuse_allocator.h"
+#include "pre_activate/mem_reuse/mem_reuse_scheduler.h"
 #include "device/kernel_info.h"
+#include "device/mem_swap_manager.h"
 #include "kernel/tbe/tbe_kernel_mod.h"
 #include "operator/ops.h"
 #include "utils/log_adapter.h"
@@ -270,5 +272,37 @@ TEST_F(TestMemReuseWithPy, TestSetInfo) {
   auto exec_graph = CreateGraphWithExecOrder();
   ASSERT_NE(exec_graph, nullptr);
 }
+
+TEST_F(TestMemReuseWithPy, MemReuseScheduler) {
+  KernelGraphPtr g = CreateKernelGraph();
+  ASSERT_NE(g, nullptr);
+  g->SetExecOrderByDefault();
+  auto origin_order = g->execution_order();
+  ASSERT_EQ(origin_order.size(), 2);
+  MemReuseScheduler mem_reuse_scheduler;
+  mem_reuse_scheduler.Schedule(g.get());
+  // a chain can not be reordered
+  ASSERT_EQ(g->execution_order(), origin_order);
+  ASSERT_EQ(mem_reuse_scheduler.scheduled_peak(), mem_reuse_scheduler.origin_peak());
+}
+
+TEST_F(TestMemReuseWithPy, MemSwapManager) {
+  KernelGraphPtr g = CreateKernelGraph();
+  ASSERT_NE(g, nullptr);
+  g->SetExecOrderByDefault();
+  MemReuseUtilPtr mem_reuse_util_ptr = std::make_shared<MemReuseUtil>();
+  ASSERT_NE(mem_reuse_util_ptr, nullptr);
+  auto ret = mem_reuse_util_ptr->InitDynamicKernelRef(g.get());
+  ASSERT_EQ(ret, true);
+  mem_reuse_util_ptr->SetKernelDefMap();
+  mem_reuse_util_ptr->SetReuseRefCount();
+  auto refs_size = mem_reuse_util_ptr->total_refs_list_.size();
+  device::MemSwapManager mem_swap_manager;
+  mem_swap_manager.Plan(g.get(), mem_reuse_util_ptr.get());
+  // no tensor of a short chain is idle long enough to be swapped
+  ASSERT_TRUE(mem_swap_manager.empty());
+  ASSERT_EQ(mem_swap_manager.host_size(), 0);
+  ASSERT_EQ(mem_reuse_util_ptr->total_refs_list_.size(), refs_size);
+}
 }  // namespace memreuse
 }  // namespace mindspore
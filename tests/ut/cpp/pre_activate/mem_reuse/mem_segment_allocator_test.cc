@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "pre_activate/mem_reuse/mem_segment_allocator.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+class TestMemSegmentAllocator : public UT::Common {
+ public:
+  TestMemSegmentAllocator() {}
+};
+
+TEST_F(TestMemSegmentAllocator, alloc_and_reserve) {
+  std::vector<uint8_t> buffer(1 << 20);
+  MemSegmentAllocator mem_segments;
+  mem_segments.Init(buffer.data(), buffer.size());
+  // the segments are taken from the top
+  auto seg1 = mem_segments.AllocSegment(256 << 10);
+  auto seg2 = mem_segments.AllocSegment(256 << 10);
+  ASSERT_EQ(seg1, buffer.data() + (768 << 10));
+  ASSERT_EQ(seg2, buffer.data() + (512 << 10));
+  // the dynamic memory grows from the bottom up to the lowest segment
+  ASSERT_TRUE(mem_segments.ReserveDynamic(256 << 10));
+  ASSERT_FALSE(mem_segments.ReserveDynamic(768 << 10));
+  ASSERT_EQ(mem_segments.dynamic_size(), 256 << 10);
+  ASSERT_EQ(mem_segments.max_free_size(), 256 << 10);
+  ASSERT_EQ(mem_segments.AllocSegment(512 << 10), nullptr);
+  // the segment given back is taken again, before the space above the dynamic memory
+  mem_segments.FreeSegment(seg1);
+  ASSERT_EQ(mem_segments.AllocSegment(128 << 10), buffer.data() + (896 << 10));
+  ASSERT_EQ(mem_segments.AllocSegment(128 << 10), buffer.data() + (768 << 10));
+  ASSERT_EQ(mem_segments.AllocSegment(128 << 10), buffer.data() + (384 << 10));
+  ASSERT_EQ(mem_segments.free_size(), 128 << 10);
+  // the dynamic memory takes the space of the segment given back at the bottom
+  mem_segments.FreeSegment(buffer.data() + (384 << 10));
+  mem_segments.FreeSegment(seg2);
+  ASSERT_TRUE(mem_segments.ReserveDynamic(768 << 10));
+  ASSERT_EQ(mem_segments.free_size(), 0);
+  ASSERT_EQ(mem_segments.max_free_size(), 0);
+  // the dynamic memory is kept when it is reserved smaller
+  ASSERT_TRUE(mem_segments.ReserveDynamic(0));
+  ASSERT_EQ(mem_segments.dynamic_size(), 768 << 10);
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,129 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "common/common_test.h"
+#include "pre_activate/mem_reuse/mem_reuse.h"
+#include "pre_activate/mem_reuse/mem_timeline.h"
+
+namespace mindspore {
+namespace memreuse {
+class TestMemTimeline : public UT::Common {
+ public:
+  TestMemTimeline() : file_name_("./test_mem_timeline.json") {}
+  void TearDown() override { (void)std::remove(file_name_.c_str()); }
+
+  nlohmann::json Load() const {
+    std::ifstream file_in(file_name_);
+    nlohmann::json timeline;
+    file_in >> timeline;
+    return timeline;
+  }
+
+ protected:
+  std::string file_name_;
+};
+
+namespace {
+KernelRefCountPtr NewTensor(int index, size_t size, int ref_count) {
+  auto tensor = std::make_shared<KernelRefCount>();
+  tensor->index_ = index;
+  tensor->size_ = size;
+  tensor->ref_count_ = ref_count;
+  return tensor;
+}
+
+KernelDefPtr NewKernelDef(const KernelRefCountPtrList &inputs, const KernelRefCountPtrList &outputs,
+                          const std::string &name) {
+  auto kernel_def = std::make_shared<KernelDef>();
+  kernel_def->set_input_refs(inputs);
+  kernel_def->set_output_refs(outputs);
+  kernel_def->set_scope_full_name(name);
+  return kernel_def;
+}
+}  // namespace
+
+TEST_F(TestMemTimeline, static_timeline) {
+  auto tensor_0 = NewTensor(0, 512, 1);
+  auto tensor_1 = NewTensor(1, 1024, 2);
+  auto tensor_2 = NewTensor(2, 256, 1);
+  // tensor_3 is a graph output, which lives to the end
+  auto tensor_3 = NewTensor(3, 2048, 9999);
+  auto workspace = NewTensor(0, 4096, 1);
+  std::vector<KernelDefPtr> kernels{NewKernelDef({}, {tensor_0}, "Default/layer1/Conv2D-op0"),
+                                    NewKernelDef({tensor_0}, {tensor_1}, "Default/layer1/ReLU-op1"),
+                                    NewKernelDef({tensor_1}, {tensor_2}, "Default/layer2/Conv2D-op2"),
+                                    NewKernelDef({tensor_1, tensor_2}, {tensor_3}, "Default/layer2/Add-op3")};
+  kernels[2]->wk_space_[nullptr] = {workspace};
+  MemReuseUtil mem_reuse_util;
+  mem_reuse_util.set_total_refs_list({tensor_0, tensor_1, tensor_2, tensor_3});
+  mem_reuse_util.set_kernel_def_ptr_list(kernels);
+  mem_reuse_util.total_wk_ref_list_ = {workspace};
+
+  MemTimeline timeline("static");
+  timeline.InitStatic(&mem_reuse_util);
+  // the offsets are read when the timeline is saved
+  workspace->offset_ = 1024;
+  ASSERT_TRUE(timeline.Save(file_name_));
+  auto json = Load();
+  EXPECT_EQ(json["kind"], "static");
+  ASSERT_EQ(json["kernels"].size(), 4);
+  EXPECT_EQ(json["kernels"][1]["live_size"], 1536);
+  EXPECT_EQ(json["kernels"][3]["live_size"], 3328);
+  // tensor_1, tensor_2 and the workspace are live at the peak
+  auto &peak = json["peak"];
+  EXPECT_EQ(peak["kernel"], 2);
+  EXPECT_EQ(peak["name"], "Default/layer2/Conv2D-op2");
+  EXPECT_EQ(peak["live_size"], 5376);
+  EXPECT_EQ(peak["footprint"], 5120);
+  auto top_tensor = json["tensors"][peak["top_tensors"][0].get<size_t>()];
+  EXPECT_EQ(top_tensor["owner"], "Default/layer2/Conv2D-op2");
+  EXPECT_EQ(top_tensor["workspace"], true);
+  EXPECT_EQ(top_tensor["offset"], 1024);
+  EXPECT_EQ(peak["top_scopes"][0]["scope"], "Default/layer2");
+  EXPECT_EQ(peak["top_scopes"][0]["size"], 4352);
+  EXPECT_EQ(peak["top_scopes"][1]["scope"], "Default/layer1");
+}
+
+TEST_F(TestMemTimeline, dynamic_timeline) {
+  std::vector<char> pool(4096);
+  MemTimeline timeline("dynamic");
+  timeline.Alloc(pool.data() + 512, 512, "Default/MatMul-op0", false, 0);
+  timeline.Alloc(pool.data() + 2048, 1024, "Default/MatMul-op0", true, 0);
+  timeline.RecordKernel("Default/MatMul-op0");
+  timeline.Free(pool.data() + 2048);
+  timeline.Alloc(pool.data(), 256, "Default/ReLU-op1", false, 0);
+  timeline.RecordKernel("Default/ReLU-op1");
+  timeline.Free(pool.data() + 512);
+  timeline.RecordKernel("Default/Add-op2");
+  ASSERT_TRUE(timeline.Save(file_name_));
+  auto json = Load();
+  EXPECT_EQ(json["kind"], "dynamic");
+  ASSERT_EQ(json["kernels"].size(), 3);
+  EXPECT_EQ(json["kernels"][1]["live"], std::vector<size_t>({0, 2}));
+  EXPECT_EQ(json["kernels"][2]["live_size"], 256);
+  EXPECT_EQ(json["peak"]["kernel"], 0);
+  EXPECT_EQ(json["peak"]["live_size"], 1536);
+  // the offsets are from the lowest address
+  EXPECT_EQ(json["tensors"][1]["offset"], 2048);
+  EXPECT_EQ(json["peak"]["footprint"], 3072);
+}
+}  // namespace memreuse
+}  // namespace mindspore
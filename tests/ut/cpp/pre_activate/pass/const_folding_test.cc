@@ -0,0 +1,104 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/backend_common_test.h"
+#include "ir/anf.h"
+#include "ir/meta_tensor.h"
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "session/kernel_graph.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "pre_activate/pass/const_folding.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWConstFolding : public BackendCommon {
+ public:
+  TestHWConstFolding() = default;
+  ~TestHWConstFolding() override = default;
+};
+
+TEST_F(TestHWConstFolding, test_fold_reshape_cast) {
+  auto kernel_graph = std::make_shared<session::KernelGraph>();
+  // add(x, cast(reshape(const)))
+  auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{6});
+  auto tensor_data = static_cast<float *>(tensor->data_c(true));
+  for (int i = 0; i < 6; ++i) {
+    tensor_data[i] = 0.5f * i;
+  }
+  auto value_node = std::make_shared<ValueNode>(tensor);
+  value_node->set_abstract(tensor->ToAbstract());
+  auto const_node = kernel_graph->NewValueNode(value_node);
+  kernel_graph->AddValueNodeToGraph(const_node);
+  auto x = kernel_graph->add_parameter();
+  x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat16, std::vector<int>{2, 3}));
+
+  auto reshape =
+    kernel_graph->NewCNode({NewValueNode(std::make_shared<Primitive>(prim::kPrimReshape->name())), const_node});
+  AnfAlgo::SetOutputInferTypeAndShape({kNumberTypeFloat32}, {{2, 3}}, reshape.get());
+  auto cast = kernel_graph->NewCNode({NewValueNode(std::make_shared<Primitive>(prim::kPrimCast->name())), reshape});
+  AnfAlgo::SetOutputInferTypeAndShape({kNumberTypeFloat16}, {{2, 3}}, cast.get());
+  auto add = kernel_graph->NewCNode({NewValueNode(std::make_shared<Primitive>(prim::kPrimTensorAdd->name())), x, cast});
+  AnfAlgo::SetOutputInferTypeAndShape({kNumberTypeFloat16}, {{2, 3}}, add.get());
+  kernel_graph->set_output(kernel_graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), add}));
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::ConstFolding>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+
+  auto folded = add->input(2);
+  ASSERT_TRUE(IsValueNode<tensor::Tensor>(folded));
+  auto folded_tensor = GetValueNode<tensor::TensorPtr>(folded);
+  EXPECT_EQ(folded_tensor->data_type(), kNumberTypeFloat16);
+  EXPECT_EQ(folded_tensor->shape(), std::vector<int>({2, 3}));
+  auto folded_data = static_cast<float16 *>(folded_tensor->data_c(false));
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(static_cast<float>(folded_data[i]), 0.5f * i);
+  }
+  // the const folded away gets no memory
+  auto value_nodes = kernel_graph->graph_value_nodes();
+  EXPECT_EQ(value_nodes.count(const_node), 0);
+  EXPECT_EQ(value_nodes.count(folded->cast<ValueNodePtr>()), 1);
+}
+
+TEST_F(TestHWConstFolding, test_keep_output) {
+  auto kernel_graph = std::make_shared<session::KernelGraph>();
+  auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto value_node = std::make_shared<ValueNode>(tensor);
+  value_node->set_abstract(tensor->ToAbstract());
+  auto const_node = kernel_graph->NewValueNode(value_node);
+  kernel_graph->AddValueNodeToGraph(const_node);
+  auto cast = kernel_graph->NewCNode({NewValueNode(std::make_shared<Primitive>(prim::kPrimCast->name())), const_node});
+  AnfAlgo::SetOutputInferTypeAndShape({kNumberTypeFloat16}, {{2, 3}}, cast.get());
+  auto make_tuple = kernel_graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), cast});
+  kernel_graph->set_output(make_tuple);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::ConstFolding>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+
+  // the outputs of the graph are fetched from the kernels
+  EXPECT_EQ(make_tuple->input(1), cast);
+  EXPECT_EQ(kernel_graph->graph_value_nodes().count(const_node), 1);
+}
+}  // namespace opt
+}  // namespace mindspore
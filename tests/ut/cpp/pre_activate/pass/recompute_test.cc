@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "ir/anf.h"
+#include "common/py_func_graph_fetcher.h"
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "pre_activate/pass/recompute.h"
+#include "utils/context/ms_context.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWRecompute : public BackendCommon {
+ public:
+  TestHWRecompute() : getPyFun_("gtest_input.pre_activate.recompute_test", true) {}
+  ~TestHWRecompute() override = default;
+
+ public:
+  UT::PyFuncGraphFetcher getPyFun_;
+};
+
+TEST_F(TestHWRecompute, test_recompute_relu) {
+  FuncGraphPtr g = getPyFun_.CallAndParseRet("test_recompute", "before");
+  ASSERT_TRUE(g != nullptr);
+  std::vector<int> shp{2, 32, 224, 224};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+  AbstractBasePtrList args_spec_list{x_abstract, x_abstract};
+  auto kernel_graph = GetKernelGraph(g, args_spec_list);
+  ASSERT_TRUE(kernel_graph != nullptr);
+
+  // return -> make_tuple(relu, relu_grad(mul, relu))
+  auto make_tuple = kernel_graph->output();
+  ASSERT_TRUE(IsPrimitiveCNode(make_tuple, prim::kPrimMakeTuple));
+  auto relu = make_tuple->cast<CNodePtr>()->input(1);
+  auto relu_grad = make_tuple->cast<CNodePtr>()->input(2)->cast<CNodePtr>();
+  ASSERT_TRUE(relu_grad != nullptr);
+  auto mul = relu_grad->input(1);
+  ASSERT_EQ(relu_grad->input(2), relu);
+  auto scope = std::make_shared<Scope>("Gradients/Default/network-ReLU");
+  relu_grad->set_scope(scope);
+  mul->set_scope(scope);
+
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  ms_context->set_enable_recompute(true);
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::Recompute>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+  ms_context->set_enable_recompute(false);
+
+  // the forward output is kept, the backward one uses a copy computed after mul
+  EXPECT_EQ(make_tuple->cast<CNodePtr>()->input(1), relu);
+  auto recompute_relu = relu_grad->input(2);
+  ASSERT_TRUE(IsPrimitiveCNode(recompute_relu, prim::kPrimRelu));
+  EXPECT_NE(recompute_relu, relu);
+  auto depend = recompute_relu->cast<CNodePtr>()->input(1);
+  ASSERT_TRUE(IsPrimitiveCNode(depend, prim::kPrimDepend));
+  EXPECT_EQ(depend->cast<CNodePtr>()->input(2), mul);
+  EXPECT_EQ(recompute_relu->scope(), scope);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,186 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "predict/converter/executor_tensor.h"
+#include "predict/converter/graph_optimizer.h"
+
+namespace mindspore {
+namespace executor {
+class TestGraphOptimizer : public UT::Common {
+ public:
+  TestGraphOptimizer() = default;
+
+  uint32_t AddTensor(const std::vector<int> &dims, const std::vector<float> &data = {}) {
+    std::unique_ptr<TensorDefT> tensor(new TensorDefT());
+    tensor->dataType = predict::DataType_DT_FLOAT;
+    tensor->dims = dims;
+    tensor->format = predict::Format_NCHW;
+    tensor->refCount = data.empty() ? 0 : MS_MAX_REFCOUNT;
+    tensor->data.resize(data.size() * sizeof(float));
+    if (!data.empty()) {
+      memcpy(tensor->data.data(), data.data(), tensor->data.size());
+    }
+    graph_.allTensors.emplace_back(std::move(tensor));
+    return graph_.allTensors.size() - 1;
+  }
+
+  void AddNode(predict::OpT type, void *attr, const std::vector<uint32_t> &inputs,
+               const std::vector<uint32_t> &outputs) {
+    std::unique_ptr<NodeDef> node(new NodeDef());
+    node->opDef.reset(new OpDefT());
+    node->opDef->attr.type = type;
+    node->opDef->attr.value = attr;
+    node->opDef->inputIndex = inputs;
+    node->opDef->outputIndex = outputs;
+    graph_.nodes.emplace_back(std::move(node));
+  }
+
+  std::vector<float> GetData(uint32_t index) {
+    auto &tensor = graph_.allTensors[index];
+    auto data = reinterpret_cast<float *>(tensor->data.data());
+    return std::vector<float>(data, data + tensor->data.size() / sizeof(float));
+  }
+
+  SubGraphDefT graph_;
+};
+
+// conv(x) -> batch norm -> bias add -> relu6, with 2 output channels of 1x1 kernels on 1 input channel
+TEST_F(TestGraphOptimizer, test_fuse_conv_bn_bias_relu) {
+  auto x = AddTensor({1, 1, 2, 2});
+  auto weight = AddTensor({2, 1, 1, 1}, {1, 2});
+  auto conv_out = AddTensor({1, 2, 2, 2});
+  AddNode(predict::OpT_Conv2D, new predict::Conv2DT(), {x, weight}, {conv_out});
+  auto scale = AddTensor({2}, {2, 3});
+  auto offset = AddTensor({2}, {1, 1});
+  auto mean = AddTensor({2}, {1, 0});
+  auto variance = AddTensor({2}, {4, 9});
+  auto bn_out = AddTensor({1, 2, 2, 2});
+  std::vector<uint32_t> bn_outputs = {bn_out, AddTensor({2}), AddTensor({2}), AddTensor({2}), AddTensor({2})};
+  auto bn_attr = new predict::FusedBatchNormT();
+  bn_attr->epsilon = 0;
+  AddNode(predict::OpT_FusedBatchNorm, bn_attr, {conv_out, scale, offset, mean, variance}, bn_outputs);
+  auto bias = AddTensor({2}, {0.5, -0.5});
+  auto bias_add_out = AddTensor({1, 2, 2, 2});
+  AddNode(predict::OpT_BiasAdd, new predict::BiasAddT(), {bn_out, bias}, {bias_add_out});
+  auto act_attr = new predict::ActivationT();
+  act_attr->type = predict::ActivationType_RELU6;
+  auto act_out = AddTensor({1, 2, 2, 2});
+  AddNode(predict::OpT_Activation, act_attr, {bias_add_out}, {act_out});
+  graph_.inputIndex = {x};
+  graph_.outputIndex = {act_out};
+
+  MsGraphOptimizer optimizer;
+  ASSERT_TRUE(optimizer.Run(&graph_));
+  ASSERT_EQ(graph_.nodes.size(), 1);
+  auto &op = graph_.nodes[0]->opDef;
+  auto conv = op->attr.AsConv2D();
+  ASSERT_NE(conv, nullptr);
+  EXPECT_TRUE(conv->hasBias);
+  EXPECT_EQ(conv->activationType, predict::ActivationType_RELU6);
+  ASSERT_EQ(op->inputIndex.size(), 3);
+  // the scales are 2 / sqrt(4) and 3 / sqrt(9), the biases are offset - mean * scale plus the bias add
+  EXPECT_EQ(GetData(op->inputIndex[1]), std::vector<float>({1, 2}));
+  EXPECT_EQ(GetData(op->inputIndex[2]), std::vector<float>({0.5, 0.5}));
+  EXPECT_EQ(op->outputIndex, graph_.outputIndex);
+  // x, the weight, the bias and the output are left
+  EXPECT_EQ(graph_.allTensors.size(), 4);
+}
+
+TEST_F(TestGraphOptimizer, test_keep_shared_conv_output) {
+  auto x = AddTensor({1, 1, 2, 2});
+  auto weight = AddTensor({2, 1, 1, 1}, {1, 2});
+  auto conv_out = AddTensor({1, 2, 2, 2});
+  AddNode(predict::OpT_Conv2D, new predict::Conv2DT(), {x, weight}, {conv_out});
+  auto act_attr = new predict::ActivationT();
+  act_attr->type = predict::ActivationType_RELU;
+  auto act_out = AddTensor({1, 2, 2, 2});
+  AddNode(predict::OpT_Activation, act_attr, {conv_out}, {act_out});
+  graph_.inputIndex = {x};
+  // the output of the conv is an output of the graph too, so the relu is not fused
+  graph_.outputIndex = {conv_out, act_out};
+
+  MsGraphOptimizer optimizer;
+  ASSERT_TRUE(optimizer.Run(&graph_));
+  EXPECT_EQ(graph_.nodes.size(), 2);
+  EXPECT_EQ(graph_.nodes[0]->opDef->attr.AsConv2D()->activationType, predict::ActivationType_NO_ACTIVATION);
+}
+
+TEST_F(TestGraphOptimizer, test_eliminate_reshape) {
+  auto x = AddTensor({1, 4, 1, 1});
+  auto reshape1_out = AddTensor({2, 2});
+  AddNode(predict::OpT_Reshape, new predict::ReshapeT(), {x}, {reshape1_out});
+  auto reshape2_out = AddTensor({4});
+  AddNode(predict::OpT_Reshape, new predict::ReshapeT(), {reshape1_out}, {reshape2_out});
+  auto identity_out = AddTensor({4});
+  AddNode(predict::OpT_Reshape, new predict::ReshapeT(), {reshape2_out}, {identity_out});
+  auto act_out = AddTensor({4});
+  AddNode(predict::OpT_Activation, new predict::ActivationT(), {identity_out}, {act_out});
+  graph_.inputIndex = {x};
+  graph_.outputIndex = {act_out};
+
+  MsGraphOptimizer optimizer;
+  ASSERT_TRUE(optimizer.Run(&graph_));
+  ASSERT_EQ(graph_.nodes.size(), 2);
+  EXPECT_NE(graph_.nodes[0]->opDef->attr.AsReshape(), nullptr);
+  EXPECT_EQ(graph_.nodes[0]->opDef->inputIndex, graph_.inputIndex);
+  EXPECT_EQ(graph_.nodes[1]->opDef->inputIndex, graph_.nodes[0]->opDef->outputIndex);
+  EXPECT_EQ(graph_.allTensors[graph_.nodes[0]->opDef->outputIndex[0]]->dims, std::vector<int>({4}));
+}
+
+TEST_F(TestGraphOptimizer, test_fold_const_reshape) {
+  auto x = AddTensor({1, 1, 2, 2});
+  auto const_weight = AddTensor({2}, {1, 2});
+  auto weight = AddTensor({2, 1, 1, 1});
+  AddNode(predict::OpT_Reshape, new predict::ReshapeT(), {const_weight}, {weight});
+  auto conv_out = AddTensor({1, 2, 2, 2});
+  AddNode(predict::OpT_Conv2D, new predict::Conv2DT(), {x, weight}, {conv_out});
+  graph_.inputIndex = {x};
+  graph_.outputIndex = {conv_out};
+
+  MsGraphOptimizer optimizer;
+  ASSERT_TRUE(optimizer.Run(&graph_));
+  ASSERT_EQ(graph_.nodes.size(), 1);
+  auto weight_idx = graph_.nodes[0]->opDef->inputIndex[1];
+  EXPECT_EQ(graph_.allTensors[weight_idx]->dims, std::vector<int>({2, 1, 1, 1}));
+  EXPECT_EQ(GetData(weight_idx), std::vector<float>({1, 2}));
+  EXPECT_EQ(graph_.allTensors.size(), 3);
+}
+
+TEST_F(TestGraphOptimizer, test_cast_to_float16) {
+  auto x = AddTensor({1, 1, 2, 2});
+  auto weight = AddTensor({2, 1, 1, 1}, {1, -2});
+  auto conv_out = AddTensor({1, 2, 2, 2});
+  AddNode(predict::OpT_Conv2D, new predict::Conv2DT(), {x, weight}, {conv_out});
+  graph_.inputIndex = {x};
+  graph_.outputIndex = {conv_out};
+
+  MsGraphOptimizer optimizer;
+  ASSERT_TRUE(optimizer.CastToFloat16(&graph_));
+  for (auto &tensor : graph_.allTensors) {
+    EXPECT_EQ(tensor->dataType, predict::DataType_DT_FLOAT16);
+  }
+  auto &weight_data = graph_.allTensors[weight]->data;
+  ASSERT_EQ(weight_data.size(), 2 * sizeof(uint16_t));
+  auto half_data = reinterpret_cast<uint16_t *>(weight_data.data());
+  EXPECT_EQ(half_data[0], 0x3C00);
+  EXPECT_EQ(half_data[1], 0xC000);
+}
+}  // namespace executor
+}  // namespace mindspore
@@ -0,0 +1,42 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import operations as P
+from mindspore.ops import Primitive
+
+ApplyMomentum = P.ApplyMomentum()
+make_tuple = Primitive('make_tuple')
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_apply_momentum_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(var0, accum0, lr, grad0, momentum, var1, accum1, grad1):
+        out0 = ApplyMomentum(var0, accum0, lr, grad0, momentum)
+        out1 = ApplyMomentum(var1, accum1, lr, grad1, momentum)
+        return make_tuple(out0, out1)
+
+    return fns[tag]
@@ -0,0 +1,53 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import operations as P
+from mindspore.ops import Primitive
+
+conv = P.Conv2D(out_channel=64, kernel_size=3, mode=1, pad_mode="pad", pad=1, stride=1, dilation=1, group=1)
+bn = P.BatchNorm(is_training=False)
+relu = P.ReLU()
+add = P.TensorAdd()
+make_tuple = Primitive('make_tuple')
+tuple_getitem = Primitive('tuple_getitem')
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_conv2d_bn_relu_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, w, scale, b, mean, variance):
+        conv_output = conv(x, w)
+        bn_output = bn(conv_output, scale, b, mean, variance)
+        return relu(tuple_getitem(bn_output, 0))
+
+    @fns
+    def before_used_by_others(x, w, scale, b, mean, variance):
+        conv_output = conv(x, w)
+        bn_output = bn(conv_output, scale, b, mean, variance)
+        item0 = tuple_getitem(bn_output, 0)
+        return make_tuple(relu(item0), add(item0, item0))
+
+    return fns[tag]
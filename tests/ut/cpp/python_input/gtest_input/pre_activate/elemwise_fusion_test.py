@@ -0,0 +1,50 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import operations as P
+from mindspore.ops import Primitive
+
+make_tuple = Primitive('make_tuple')
+relu = P.ReLU()
+mul = P.Mul()
+add = P.TensorAdd()
+neg = P.Neg()
+exp = P.Exp()
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_elemwise_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def chain(x, y):
+        return relu(add(mul(x, y), x))
+
+    @fns
+    def shared(x, y):
+        # mul has two users, only the chain of neg and exp is fused
+        out = mul(x, y)
+        return make_tuple(relu(out), exp(neg(out)))
+
+    return fns[tag]
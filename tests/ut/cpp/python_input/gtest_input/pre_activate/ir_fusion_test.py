@@ -278,4 +278,15 @@ def test_all_reduce_fusion_group(tag):
         output = make_tuple(y1, y2, y3, y4, y5)
         return make_tuple(output)
 
+    @fns
+    def after3(x1, x2, x3, x4, x5):
+        ar = allreduce(x4, x3, x2, x1)
+        y1 = tuple_getitem(ar, 3)
+        y2 = tuple_getitem(ar, 2)
+        y3 = tuple_getitem(ar, 1)
+        y4 = tuple_getitem(ar, 0)
+        y5 = allreduce(x5)
+        res = make_tuple(y1, y2, y3, y4, y5)
+        return make_tuple(res)
+
     return fns[tag]
@@ -0,0 +1,46 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import operations as P
+from mindspore.ops import Primitive
+from mindspore.ops.operations import _grad_ops as G
+
+make_tuple = Primitive('make_tuple')
+relu = P.ReLU()
+relu_grad = G.ReluGrad()
+mul = P.Mul()
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_recompute(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, dout):
+        out = relu(x)
+        # mul and relu_grad are set to the backward scope by the test
+        grad = relu_grad(mul(dout, dout), out)
+        return make_tuple(out, grad)
+
+    return fns[tag]
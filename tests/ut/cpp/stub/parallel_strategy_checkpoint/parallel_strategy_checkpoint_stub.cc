@@ -29,8 +29,10 @@ bool StrategyCheckpoint::CheckPointExit() const { return false; }
 
 Status StrategyCheckpoint::RemoveCheckPoint() const { return SUCCESS; }
 
-Status StrategyCheckpoint::Load(StrategyMap* strategy_map) { return SUCCESS; }
+Status StrategyCheckpoint::Load(StrategyMap* strategy_map, FingerprintMap* fingerprint_map) { return SUCCESS; }
 
-Status StrategyCheckpoint::Save(const StrategyMap& strategy_map) { return SUCCESS; }
+Status StrategyCheckpoint::Save(const StrategyMap& strategy_map, const FingerprintMap& fingerprint_map) {
+  return SUCCESS;
+}
 }  // namespace parallel
 }  // namespace mindspore
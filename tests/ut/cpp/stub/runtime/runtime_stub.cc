@@ -71,6 +71,16 @@ rtError_t rtModelExecute(rtModel_t model, rtStream_t stream, uint32_t flag) { re
 
 rtError_t rtMemAllocManaged(void **ptr, uint64_t size, uint32_t flag) { return RT_ERROR_NONE; }
 
+rtError_t rtMallocHost(void **hostPtr, uint64_t size) {
+  *hostPtr = new uint8_t[size];
+  return RT_ERROR_NONE;
+}
+
+rtError_t rtFreeHost(void *hostPtr) {
+  delete[] reinterpret_cast<uint8_t *>(hostPtr);
+  return RT_ERROR_NONE;
+}
+
 rtError_t rtMemcpyAsync(void *dst, uint64_t destMax, const void *src, uint64_t count, rtMemcpyKind_t kind,
                         rtStream_t stream) {
   return RT_ERROR_NONE;
@@ -28,6 +28,8 @@ std::vector<uint32_t> AscendStreamAssign::GetWaitStreams() { return vector<uint3
 
 std::vector<uint32_t> AscendStreamAssign::GetHcomStreams() { return vector<uint32_t>(); }
 
+std::vector<uint32_t> AscendStreamAssign::GetBranchStreams() const { return vector<uint32_t>(); }
+
 namespace tasksink {
 bool TaskGenerator::GenTasks(const std::vector<CNodePtr> &anf_node_list, std::vector<TaskInfoPtr> *const task_info_list,
                              uint32_t graph_id) {
@@ -203,6 +203,42 @@ TEST_F(TestGraphRunner, TestRunGraph) {
   }
 }
 
+TEST_F(TestGraphRunner, TestRunGraphBindInputs) {
+  DfGraphManager& graph_manager = DfGraphManager::GetInstance();
+  graph_manager.ClearGraph();
+
+  std::shared_ptr<DfGraphConvertor> convertor = MakeGeGraph();
+  std::map<std::string, MeTensorPtr> dict;
+  dict.emplace("x1", MakeTensor(kF32, {2, 1, 2, 2}));
+
+  (*convertor).ConvertAllNode().InitParam(dict).BuildGraph();
+  graph_manager.AddGraph("test_graph", (*convertor).GetComputeGraph());
+
+  MeTensorPtr input_ptr = MakeTensor(kF32, {1, 1, 2, 3});
+  auto input_data = static_cast<float *>(input_ptr->data_c(true));
+  std::vector<MeTensorPtr> me_inputs{input_ptr};
+  std::vector<MeTensorPtr> first_outputs;
+  std::vector<MeTensorPtr> second_outputs;
+
+  GraphRunnerOptions options;
+  GraphRunner graph_runner(options);
+  RunOptions run_options;
+  run_options.name = "test_graph";
+  input_data[0] = 1;
+  ASSERT_TRUE(graph_runner.RunGraph(run_options, me_inputs, &first_outputs) == Status::SUCCESS);
+  auto binding = graph_runner.input_bindings_["test_graph"][0];
+  input_data[0] = 2;
+  ASSERT_TRUE(graph_runner.RunGraph(run_options, me_inputs, &second_outputs) == Status::SUCCESS);
+
+  // the GE tensor of the input is refilled, and the outputs of the steps do not share data
+  ASSERT_EQ(binding, graph_runner.input_bindings_["test_graph"][0]);
+  ASSERT_EQ(first_outputs.size(), 1);
+  ASSERT_EQ(second_outputs.size(), 1);
+  EXPECT_EQ(static_cast<float *>(first_outputs[0]->data_c())[0], 1);
+  EXPECT_EQ(static_cast<float *>(second_outputs[0]->data_c())[0], 2);
+  EXPECT_EQ(second_outputs[0]->shape(), input_ptr->shape());
+}
+
 TEST_F(TestGraphRunner, TestAPI) {
   DfGraphManager& graph_manager = DfGraphManager::GetInstance();
   graph_manager.ClearGraph();
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "utils/metrics.h"
+
+namespace mindspore {
+class TestMetrics : public UT::Common {
+ public:
+  TestMetrics() {}
+};
+
+TEST_F(TestMetrics, test_counter_and_histogram_across_threads) {
+  auto &registry = MetricsRegistry::GetInstance();
+  auto counter = registry.GetCounter("test_metrics_counter_total", "The test counter.");
+  auto histogram = registry.GetHistogram("test_metrics_histogram_us", "The test histogram.");
+  ASSERT_EQ(counter, registry.GetCounter("test_metrics_counter_total", "The test counter."));
+  const int kThreadNum = 8;
+  const int kAddNum = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([counter, histogram]() {
+      for (int j = 0; j < kAddNum; ++j) {
+        counter->Add();
+        histogram->Observe(j % 4);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter->Value(), kThreadNum * kAddNum);
+  auto snapshot = histogram->Snapshot();
+  EXPECT_EQ(snapshot.count, kThreadNum * kAddNum);
+  EXPECT_EQ(snapshot.sum, kThreadNum * kAddNum / 4 * (0 + 1 + 2 + 3));
+  // 0 is less than 1, 1 is less than 2, 2 and 3 are less than 4
+  EXPECT_EQ(snapshot.buckets[0], kThreadNum * kAddNum / 4);
+  EXPECT_EQ(snapshot.buckets[1], kThreadNum * kAddNum / 4);
+  EXPECT_EQ(snapshot.buckets[2], kThreadNum * kAddNum / 2);
+
+  auto values = registry.Collect();
+  EXPECT_EQ(values["test_metrics_counter_total"], kThreadNum * kAddNum);
+  EXPECT_EQ(values["test_metrics_histogram_us_count"], kThreadNum * kAddNum);
+  EXPECT_EQ(values["test_metrics_histogram_us_bucket_lt_2"], kThreadNum * kAddNum / 2);
+  EXPECT_EQ(values["test_metrics_histogram_us_bucket_lt_4"], kThreadNum * kAddNum);
+}
+
+TEST_F(TestMetrics, test_prometheus_text) {
+  auto &registry = MetricsRegistry::GetInstance();
+  registry.GetGauge("test_metrics_gauge_bytes", "The test gauge.")->Set(1024);
+  {
+    HistogramTimer timer(registry.GetHistogram("test_metrics_timer_us", "The test timer."));
+  }
+  auto text = registry.PrometheusText();
+  EXPECT_NE(text.find("# TYPE test_metrics_gauge_bytes gauge\ntest_metrics_gauge_bytes 1024\n"), std::string::npos);
+  EXPECT_NE(text.find("# TYPE test_metrics_timer_us histogram\n"), std::string::npos);
+  EXPECT_NE(text.find("test_metrics_timer_us_bucket{le=\"+Inf\"} 1\n"), std::string::npos);
+  EXPECT_NE(text.find("test_metrics_timer_us_count 1\n"), std::string::npos);
+}
+}  // namespace mindspore
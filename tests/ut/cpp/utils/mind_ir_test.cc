@@ -0,0 +1,111 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ir/meta_tensor.h"
+#include "operator/ops.h"
+#include "session/kernel_graph.h"
+#include "session/anf_runtime_algorithm.h"
+#include "device/kernel_info.h"
+#include "utils/mind_ir.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class TestMindIR : public UT::Common {
+ public:
+  TestMindIR() : file_name_("./test_mind_ir.mindir") {}
+  void TearDown() override { (void)std::remove(file_name_.c_str()); }
+
+ protected:
+  std::string file_name_;
+};
+
+TEST_F(TestMindIR, SaveAndLoadKernelGraph) {
+  std::vector<int> shape = {2, 3};
+  auto abs = std::make_shared<abstract::AbstractTensor>(kFloat32, shape);
+  auto graph = std::make_shared<session::KernelGraph>();
+  graph->set_graph_id(3);
+  auto x = graph->add_parameter();
+  x->set_name("x");
+  x->set_abstract(abs);
+  graph->MutableInputs()->push_back(x);
+
+  auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape);
+  auto data = static_cast<float *>(tensor->data_c(true));
+  for (int i = 0; i < 6; ++i) {
+    data[i] = static_cast<float>(i);
+  }
+  auto y = NewValueNode(tensor);
+  y->set_abstract(abs);
+  graph->AddValueNodeToGraph(y);
+
+  auto prim = std::make_shared<Primitive>(prim::kPrimTensorAdd->name());
+  prim->set_attr("input_names", MakeValue(std::vector<std::string>{"x", "y"}));
+  auto add = graph->NewCNode({NewValueNode(prim), x, y});
+  add->set_abstract(abs);
+  KernelBuildInfoBuilder builder;
+  builder.SetInputsFormat({kOpFormat_DEFAULT, kOpFormat_DEFAULT});
+  builder.SetOutputsFormat({kOpFormat_NC1HWC0});
+  builder.SetInputsDeviceType({kNumberTypeFloat32, kNumberTypeFloat32});
+  builder.SetOutputsDeviceType({kNumberTypeFloat16});
+  builder.SetKernelType(KernelType::AUTO_DIFF_KERNEL);
+  AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), add.get());
+  graph->set_output(add);
+  graph->SetExecOrderByDefault();
+  ASSERT_TRUE(SaveMindIR(file_name_, {graph}));
+
+  auto graphs = LoadMindIR(file_name_);
+  ASSERT_EQ(graphs.size(), 1);
+  auto new_graph = graphs[0]->cast<std::shared_ptr<session::KernelGraph>>();
+  ASSERT_NE(new_graph, nullptr);
+  EXPECT_EQ(new_graph->graph_id(), 3);
+  ASSERT_EQ(new_graph->inputs().size(), 1);
+  EXPECT_EQ(new_graph->inputs()[0]->cast<ParameterPtr>()->name(), "x");
+  ASSERT_EQ(new_graph->execution_order().size(), 1);
+  auto new_add = new_graph->execution_order()[0];
+  EXPECT_TRUE(AnfAlgo::GetCNodeName(new_add) == prim::kPrimTensorAdd->name());
+  EXPECT_EQ(new_add->input(1), new_graph->inputs()[0]);
+  EXPECT_EQ(AnfAlgo::GetOutputInferShape(new_add, 0), std::vector<size_t>({2, 3}));
+  EXPECT_EQ(AnfAlgo::GetOutputFormat(new_add, 0), kOpFormat_NC1HWC0);
+  EXPECT_EQ(AnfAlgo::GetOutputDeviceDataType(new_add, 0), kNumberTypeFloat16);
+  EXPECT_EQ(AnfAlgo::GetKernelType(new_add), KernelType::AUTO_DIFF_KERNEL);
+  EXPECT_NE(AnfAlgo::GetCNodePrimitive(new_add)->GetAttr("input_names"), nullptr);
+
+  ASSERT_EQ(new_graph->graph_value_nodes().size(), 1);
+  auto new_tensor = GetValueNode<tensor::TensorPtr>(new_add->input(2));
+  ASSERT_NE(new_tensor, nullptr);
+  EXPECT_EQ(new_tensor->shape(), shape);
+  auto new_data = static_cast<float *>(new_tensor->data_c());
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(new_data[i], static_cast<float>(i));
+  }
+}
+
+TEST_F(TestMindIR, LoadInvalidFile) {
+  FILE *file = std::fopen(file_name_.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  (void)std::fputs("not a mindir", file);
+  (void)std::fclose(file);
+  EXPECT_TRUE(LoadMindIR(file_name_).empty());
+  EXPECT_TRUE(LoadMindIR("./not_exist.mindir").empty());
+}
+}  // namespace mindspore
@@ -18,6 +18,7 @@
 #include <memory>
 #include <algorithm>
 
+#include "utils/ordered_map.h"
 #include "utils/ordered_set.h"
 #include "common/common_test.h"
 
@@ -147,4 +148,59 @@ TEST_F(TestOrderedSet, test_contains) {
   ASSERT_TRUE(!res.contains(e2));
 }
 
+TEST_F(TestOrderedSet, test_erase_keeps_order) {
+  OrderedSet<int> a;
+  for (int i = 0; i < 1000; i++) {
+    a.add(i);
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    a.erase(i);
+  }
+  // The holes left by the erased elements are compacted away when the set grows
+  for (int i = 1000; i < 3000; i++) {
+    a.add(i);
+  }
+  ASSERT_EQ(a.size(), 2500);
+  int expected = 1;
+  for (auto& e : a) {
+    ASSERT_EQ(e, expected);
+    expected += (expected < 999) ? 2 : 1;
+  }
+  ASSERT_EQ(a.back(), 2999);
+}
+
+TEST_F(TestOrderedSet, test_iterate_while_adding) {
+  OrderedSet<int> todo;
+  todo.add(0);
+  int visited = 0;
+  for (auto& e : todo) {
+    visited++;
+    if (e < 100) {
+      todo.add(e + 1);
+    }
+  }
+  ASSERT_EQ(visited, 101);
+}
+
+TEST_F(TestOrderedSet, test_map_reference_stable) {
+  OrderedMap<int, OrderedSet<int>> users;
+  auto& first_users = users[0];
+  first_users.add(1);
+  for (int i = 1; i < 1000; i++) {
+    users[i].add(i);
+  }
+  for (int i = 1; i < 500; i++) {
+    users.erase(i);
+  }
+  for (int i = 1000; i < 2000; i++) {
+    users[i].add(i);
+  }
+  ASSERT_EQ(&first_users, &users[0]);
+  ASSERT_TRUE(first_users.contains(1));
+  ASSERT_EQ(users.size(), 1501);
+  ASSERT_EQ(users.begin()->first, 0);
+  ASSERT_EQ(std::next(users.begin())->first, 500);
+  ASSERT_EQ(users.rbegin()->first, 1999);
+}
+
 }  // namespace mindspore
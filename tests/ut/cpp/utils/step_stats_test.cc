@@ -0,0 +1,59 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <thread>
+#include "common/common_test.h"
+#include "utils/step_stats.h"
+
+namespace mindspore {
+class TestStepStats : public UT::Common {
+ public:
+  TestStepStats() {}
+};
+
+TEST_F(TestStepStats, test_step_breakdown) {
+  auto &step_stats = StepStats::GetInstance();
+  { StepStatsScope scope; }
+  step_stats.Start();
+  ASSERT_TRUE(step_stats.started());
+  {
+    StepStatsScope scope;
+    step_stats.Add(kStepDeviceCompute, 300);
+    step_stats.Add(kStepCommunication, 200);
+    step_stats.Add(kStepDeviceCompute, 100);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  // out of a step
+  step_stats.Add(kStepOptimizer, 1000);
+  step_stats.Stop();
+  { StepStatsScope scope; }
+
+  auto steps = step_stats.Steps();
+  ASSERT_EQ(steps.size(), 1);
+  auto &step = steps[0];
+  EXPECT_EQ(step["device_compute"], 400);
+  EXPECT_EQ(step["communication"], 200);
+  EXPECT_EQ(step["optimizer"], 0);
+  EXPECT_EQ(step["data_wait"], 0);
+  EXPECT_GE(step["total"], 2000);
+  // the host dispatch is the rest of the step
+  EXPECT_EQ(step["host_dispatch"], step["total"] - 600);
+
+  step_stats.Start();
+  EXPECT_TRUE(step_stats.Steps().empty());
+  step_stats.Stop();
+}
+}  // namespace mindspore
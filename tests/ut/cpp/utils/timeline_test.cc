@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "common/common_test.h"
+#include "utils/timeline.h"
+
+namespace mindspore {
+class TestTimeline : public UT::Common {
+ public:
+  TestTimeline() {}
+};
+
+TEST_F(TestTimeline, test_save_chrome_trace) {
+  const std::string file_path = "./timeline_test.json";
+  auto &timeline = Timeline::GetInstance();
+  { TimelineSpan span("not_started", "host"); }
+  timeline.Start();
+  ASSERT_TRUE(timeline.started());
+  { TimelineSpan span("RunOp.Add", "pynative"); }
+  timeline.Record("Default/Conv2D-op1", "gpu_kernel", 10, 25, "GPU stream 0");
+  timeline.Stop(file_path);
+  ASSERT_FALSE(timeline.started());
+  { TimelineSpan span("stopped", "host"); }
+
+  std::ifstream file_in(file_path);
+  ASSERT_TRUE(file_in.is_open());
+  auto trace = nlohmann::json::parse(file_in);
+  size_t tracks = 0;
+  size_t spans = 0;
+  for (auto &event : trace["traceEvents"]) {
+    if (event["ph"] == "M") {
+      tracks++;
+      continue;
+    }
+    ASSERT_EQ(event["ph"], "X");
+    spans++;
+    if (event["name"] == "Default/Conv2D-op1") {
+      EXPECT_EQ(event["ts"], 10);
+      EXPECT_EQ(event["dur"], 15);
+    } else {
+      EXPECT_EQ(event["name"], "RunOp.Add");
+    }
+  }
+  // a host thread and the stream
+  EXPECT_EQ(tracks, 2);
+  EXPECT_EQ(spans, 2);
+  (void)remove(file_path.c_str());
+}
+}  // namespace mindspore
@@ -131,5 +131,42 @@ TEST_F(TestCompileSegmentRunner, test_RunOperation2) {
   auto res = RunOperation(prim::kPrimScalarGt, args);
   ASSERT_EQ(py::cast<bool>(BaseRefToPyData(res)), false);
 }
+
+// The backend placing the scalar_sub on the CPU.
+class CpuSubBackend : public Backend {
+ public:
+  CpuSubBackend() : Backend("vm") {}
+  bool IsCpuNode(const AnfNodePtr &node) const override { return IsPrimitiveCNode(node, prim::kPrimScalarSub); }
+};
+
+TEST_F(TestCompileSegmentRunner, test_split_cpu_nodes) {
+  auto g = std::make_shared<FuncGraph>();
+  auto x = g->add_parameter();
+  auto y = g->add_parameter();
+  auto a = g->NewCNode({NewValueNode(prim::kPrimScalarSub), x, y});
+  auto b = g->NewCNode({NewValueNode(prim::kPrimScalarAdd), a, y});
+  auto c = g->NewCNode({NewValueNode(prim::kPrimScalarSub), a, x});
+  auto d = g->NewCNode({NewValueNode(prim::kPrimScalarAdd), b, c});
+  g->set_output(d);
+  std::shared_ptr<mindspore::FuncGraphManager> manager = mindspore::Manage(g);
+
+  // the nodes of the CPU are grouped in one segment before the ones of the device
+  CompileGraph transform(std::make_shared<CpuSubBackend>());
+  auto splits = transform.SplitNodes(g);
+  ASSERT_EQ(splits.size(), 3);
+  ASSERT_TRUE(utils::isa<VectorRef>(splits[0]) && utils::isa<VectorRef>(splits[1]));
+  auto cpu_split = utils::cast<VectorRef>(splits[0]);
+  auto device_split = utils::cast<VectorRef>(splits[1]);
+  ASSERT_EQ(cpu_split.size(), 2);
+  ASSERT_TRUE(utils::cast<AnfNodePtr>(cpu_split[0]) == a && utils::cast<AnfNodePtr>(cpu_split[1]) == c);
+  ASSERT_EQ(device_split.size(), 2);
+  ASSERT_TRUE(utils::cast<AnfNodePtr>(device_split[0]) == b && utils::cast<AnfNodePtr>(device_split[1]) == d);
+
+  // all the nodes are in one segment without the CPU
+  CompileGraph vm_transform(std::make_shared<Backend>("vm"));
+  splits = vm_transform.SplitNodes(g);
+  ASSERT_EQ(splits.size(), 2);
+  ASSERT_EQ(utils::cast<VectorRef>(splits[0]).size(), 4);
+}
 }  // namespace compile
 }  // namespace mindspore
@@ -56,5 +56,27 @@ TEST_F(TestCompileVM, FinalVM) {
   vm = nullptr;
 }
 
+TEST_F(TestCompileVM, DirectRun) {
+  // the graph of one segment returns the output of its function of the args (x, y) as the inputs (y, x)
+  RunFuncPtr fn = std::make_shared<RunFunc>([](const VectorRef& args) {
+    return VectorRef({utils::cast<int>(args[0]) * 10 + utils::cast<int>(args[1])});
+  });
+  std::vector<std::pair<Instruction, VectorRef>> instr;
+  instr.push_back({Instruction::kPadStack, VectorRef({1})});
+  instr.push_back({Instruction::kExternal, VectorRef({fn, fn, -2, -1})});
+  instr.push_back({Instruction::kReturn, VectorRef({-1, 3})});
+  BackendPtr backend = std::make_shared<Backend>("vm");
+  FinalVM vm(instr, backend);
+  ASSERT_EQ(utils::cast<int>(vm.Eval(VectorRef({1, 2}))), 21);
+  ASSERT_EQ(utils::cast<int>(vm.Eval(VectorRef({3, 4}))), 43);
+
+  // the same function run by the instructions when it is not the whole graph
+  instr.insert(instr.begin() + 1, {Instruction::kPush, VectorRef({5})});
+  instr[2].second = VectorRef({fn, fn, -3, -1});
+  instr[3].second = VectorRef({-1, 4});
+  vm.set_insts(instr);
+  ASSERT_EQ(utils::cast<int>(vm.Eval(VectorRef({1, 2}))), 25);
+}
+
 }  // namespace compile
 }  // namespace mindspore
@@ -0,0 +1,72 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+import numpy as np
+import pytest
+
+import mindspore.dataset as ds
+from mindspore import log as logger
+
+
+def gen(lengths):
+    for length in lengths:
+        yield (np.arange(length, dtype=np.int32) + 1,)
+
+
+def test_batch_pad():
+    logger.info("test_batch_pad")
+    data1 = ds.GeneratorDataset((lambda: gen([1, 3, 2])), ["ids"])
+    data1 = data1.batch(3, pad_info={"ids": ([None], -1)})
+    res = [item["ids"] for item in data1.create_dict_iterator()]
+    assert len(res) == 1
+    np.testing.assert_array_equal(res[0], np.array([[1, -1, -1], [1, 2, 3], [1, 2, -1]]))
+
+
+def test_bucket_batch_by_length():
+    logger.info("test_bucket_batch_by_length")
+    data1 = ds.GeneratorDataset((lambda: gen([1, 5, 2, 6, 3, 1])), ["ids"])
+    data1 = data1.bucket_batch_by_length("ids", [3], [2, 3], pad_info={"ids": ([None], 0)})
+    res = [item["ids"] for item in data1.create_dict_iterator()]
+    # [1, 2] fill the first bucket, the last bucket is left with 3 rows, then the first bucket with 1 row
+    assert len(res) == 3
+    np.testing.assert_array_equal(res[0], np.array([[1, 0], [1, 2]]))
+    assert res[1].shape == (3, 6)
+    np.testing.assert_array_equal(res[2], np.array([[1]]))
+
+
+def test_bucket_batch_pad_to_boundary():
+    logger.info("test_bucket_batch_pad_to_boundary")
+    data1 = ds.GeneratorDataset((lambda: gen([1, 2, 1, 2])), ["ids"])
+    data1 = data1.bucket_batch_by_length("ids", [4], [2, 2], pad_info={"ids": ([None], 0)},
+                                         pad_to_bucket_boundary=True, drop_remainder=True)
+    res = [item["ids"] for item in data1.create_dict_iterator()]
+    assert len(res) == 2
+    for batch in res:
+        assert batch.shape == (2, 3)
+
+
+def test_bucket_batch_invalid():
+    logger.info("test_bucket_batch_invalid")
+    data1 = ds.GeneratorDataset((lambda: gen([1, 2])), ["ids"])
+    with pytest.raises(ValueError):
+        data1.bucket_batch_by_length("ids", [3, 2], [1, 1, 1])
+    with pytest.raises(ValueError):
+        data1.bucket_batch_by_length("ids", [3], [1])
+
+
+if __name__ == '__main__':
+    test_batch_pad()
+    test_bucket_batch_by_length()
+    test_bucket_batch_pad_to_boundary()
+    test_bucket_batch_invalid()
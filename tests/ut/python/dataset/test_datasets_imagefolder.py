@@ -422,6 +422,30 @@ def test_imagefolder_zip():
     assert (num_iter == 10)
 
 
+
+def test_imagefolder_row_accessor():
+    logger.info("Test Case row accessor")
+    data1 = ds.ImageFolderDatasetV2(DATA_DIR, shuffle=False)
+    accessor = data1.create_row_accessor()
+
+    # the rows come in the order of the dataset, 11 images per class
+    for row_id in range(0, 44, 5):
+        image, label = accessor[row_id]
+        logger.info("image is {}".format(image))
+        assert label == row_id // 11
+
+    try:
+        accessor[44]
+        assert False
+    except RuntimeError as e:
+        assert "Invalid row id" in str(e)
+
+    # the rows read through the pipeline are the same
+    for row_id, item in enumerate(data1.create_dict_iterator()):
+        image, _ = accessor[row_id]
+        assert (image == item["image"]).all()
+
+
 if __name__ == '__main__':
     test_imagefolder_basic()
     logger.info('test_imagefolder_basic Ended.\n')
@@ -476,3 +500,6 @@ if __name__ == '__main__':
 
     test_imagefolder_zip()
     logger.info('test_imagefolder_zip Ended.\n')
+
+    test_imagefolder_row_accessor()
+    logger.info('test_imagefolder_row_accessor Ended.\n')
@@ -391,6 +391,37 @@ def test_case_13():
         i = i + 1
 
 
+class RandomAccessMC:
+    def __len__(self):
+        return 64
+
+    def __getitem__(self, i):
+        return (np.array([i]), np.array([[i, i + 1], [i + 2, i + 3]]))
+
+
+def test_case_14():
+    """
+    Test a random access source and a map read by worker processes.
+    """
+    logger.info("Test python_multiprocessing in GeneratorDataset and map.")
+
+    # apply dataset operations
+    data1 = ds.GeneratorDataset(RandomAccessMC(), ["col0", "col1"], num_parallel_workers=4,
+                                python_multiprocessing=True)
+    data1 = data1.map(input_columns="col0", operations=(lambda x: (x * 5)), num_parallel_workers=2,
+                      python_multiprocessing=True)
+
+    # The rows keep the order of the source, in every epoch
+    for _ in range(2):
+        i = 0
+        for item in data1.create_tuple_iterator():
+            golden = np.array([i * 5])
+            assert np.array_equal(item[0], golden)
+            golden = np.array([[i, i + 1], [i + 2, i + 3]])
+            assert np.array_equal(item[1], golden)
+            i = i + 1
+        assert i == 64
+
 def test_case_error_1():
     def generator_np():
         for i in range(64):
@@ -454,6 +485,7 @@ if __name__ == "__main__":
     test_case_11()
     test_case_12()
     test_case_13()
+    test_case_14()
     test_case_error_1()
     test_case_error_2()
     test_case_error_3()
@@ -41,3 +41,17 @@ def test_case_iterator():
     check(COLUMNS[0:7])
     check(COLUMNS[7:8])
     check(COLUMNS[0:2:8])
+
+
+def test_iterator_shares_data():
+    """
+    Test the arrays given by the iterators wrap the data of the tensors
+    """
+    data1 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=COLUMNS)
+    for row in data1.create_tuple_iterator():
+        assert all([not d.flags['OWNDATA'] for d in row])
+        break
+    for row in data1.create_dict_iterator():
+        assert all([not d.flags['OWNDATA'] for d in row.values()])
+        assert np.array_equal(np.copy(row["col_1d"]), row["col_1d"])
+        break
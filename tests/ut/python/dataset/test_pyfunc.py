@@ -181,6 +181,30 @@ def test_case_6():
         i = i + 4
 
 
+def test_case_7():
+    """
+    Test batched PyFunc
+    """
+    logger.info("Test batched 1-1 and 1-n PyFunc followed by a C++ op")
+
+    # apply dataset operations
+    ds.config.set_rows_per_buffer(4)
+    data1 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, shuffle=False)
+    data1 = data1.map(input_columns="col0", output_columns=["out0", "out1"],
+                      operations=[(lambda xs: [x + x for x in xs]), (lambda xs: (xs, [x + 1 for x in xs]))],
+                      columns_order=["out0", "out1"], batched_pyfunc=True)
+
+    i = 0
+    for item in data1.create_dict_iterator():  # each data is a dictionary
+        # In this test, the dataset is 2x2 sequential tensors
+        golden = np.array([[i * 2, (i + 1) * 2], [(i + 2) * 2, (i + 3) * 2]])
+        assert np.array_equal(item["out0"], golden)
+        assert np.array_equal(item["out1"], golden + 1)
+        i = i + 4
+    assert i > 0
+    ds.config.set_rows_per_buffer(1)
+
+
 if __name__ == "__main__":
     test_case_0()
     test_case_1()
@@ -189,3 +213,4 @@ if __name__ == "__main__":
     test_case_4()
     test_case_5()
     test_case_6()
+    test_case_7()
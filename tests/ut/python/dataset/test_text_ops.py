@@ -0,0 +1,75 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+import numpy as np
+import pytest
+
+import mindspore.dataset as ds
+import mindspore.dataset.transforms.text.c_transforms as text
+
+
+def gen_text():
+    for line in ["Hello, world!", "unaffable running"]:
+        yield (np.frombuffer(line.encode("utf-8"), np.uint8),)
+
+
+def test_wordpiece_tokenizer():
+    vocab = text.Vocab(["[PAD]", "[UNK]", "hello", ",", "world", "!", "un", "##aff", "##able", "running"])
+    assert len(vocab) == 10
+    assert vocab.lookup("world") == 4
+    data = ds.GeneratorDataset(gen_text, ["text"])
+    data = data.map(input_columns=["text"], operations=[text.WordpieceTokenizer(vocab), text.TruncatePad(6)],
+                    num_parallel_workers=2)
+    expected = [[2, 3, 4, 5, 0, 0], [6, 7, 8, 9, 0, 0]]
+    for row, ids in zip(data.create_dict_iterator(), expected):
+        assert row["text"].dtype == np.int32
+        np.testing.assert_array_equal(row["text"], np.array(ids, np.int32))
+
+
+def test_whitespace_tokenizer_mask():
+    vocab = text.Vocab(["[PAD]", "[UNK]", "Hello,", "world!"])
+    data = ds.GeneratorDataset(gen_text, ["text"])
+    data = data.map(input_columns=["text"], operations=[text.WhitespaceTokenizer(vocab), text.TruncatePad(3),
+                                                        text.PadMask()])
+    expected = [[1, 1, 0], [1, 1, 0]]
+    for row, mask in zip(data.create_dict_iterator(), expected):
+        np.testing.assert_array_equal(row["text"], np.array(mask, np.int32))
+
+
+def test_sliding_window():
+    def gen():
+        yield (np.array([1, 2, 3, 4], np.int64),)
+
+    data = ds.GeneratorDataset(gen, ["col"])
+    data = data.map(input_columns=["col"], operations=text.SlidingWindow(3))
+    for row in data.create_dict_iterator():
+        np.testing.assert_array_equal(row["col"], np.array([[1, 2, 3], [2, 3, 4]], np.int64))
+
+
+def test_text_ops_invalid_params():
+    with pytest.raises(ValueError):
+        text.WordpieceTokenizer(["hello"])
+    with pytest.raises(ValueError):
+        text.SlidingWindow(0)
+    with pytest.raises(ValueError):
+        text.TruncatePad(-1)
+    with pytest.raises(ValueError):
+        text.PadMask("0")
+
+
+if __name__ == '__main__':
+    test_wordpiece_tokenizer()
+    test_whitespace_tokenizer_mask()
+    test_sliding_window()
+    test_text_ops_invalid_params()
@@ -280,3 +280,13 @@ def test_cv_file_writer_shard_num_greater_than_1000():
     with pytest.raises(ParamValueError) as err:
         FileWriter(CV_FILE_NAME, 1001)
     assert 'Shard number should between' in str(err.value)
+
+def test_cv_file_writer_from_files_mismatch():
+    """test cv file writer when the file names do not match the raw data."""
+    writer = FileWriter(CV_FILE_NAME, 1)
+    cv_schema_json = {"file_name": {"type": "string"},
+                      "label": {"type": "int32"}, "data": {"type": "bytes"}}
+    writer.add_schema(cv_schema_json, "img_schema")
+    with pytest.raises(ParamValueError) as err:
+        writer.write_raw_data_from_files([{"file_name": "001.jpg", "label": 1}], [])
+    assert 'does not match the raw data' in str(err.value)
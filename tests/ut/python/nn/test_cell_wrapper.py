@@ -17,7 +17,7 @@ import numpy as np
 import mindspore.nn as nn
 from mindspore import Tensor, Parameter
 from mindspore.common.api import _executor
-from mindspore.nn import TrainOneStepCell, WithLossCell, ParameterUpdate
+from mindspore.nn import TrainOneStepCell, WithLossCell, ParameterUpdate, TrainOneStepWithAccumulationCell
 from mindspore.nn.optim import Momentum
 from mindspore.common import dtype as mstype
 from mindspore.ops import operations as P
@@ -91,6 +91,26 @@ def test_parameter_update_float32():
     _executor.compile(update_network, input_lr)
 
 
+def test_train_one_step_with_accumulation():
+    """ test_train_one_step_with_accumulation """
+    net = Net()
+    loss = nn.SoftmaxCrossEntropyWithLogits()
+    optimizer = Momentum(net.trainable_params(), 0.01, 0.9)
+
+    net_with_loss = WithLossCell(net, loss)
+    train_network = TrainOneStepWithAccumulationCell(net_with_loss, optimizer, accumulation_steps=4)
+    assert 'accu_grads.weight' in train_network.parameters_dict()
+    assert 'micro_step' in train_network.parameters_dict()
+
+    train_network.set_train()
+    inputs = Tensor(np.ones([1, 64]).astype(np.float32))
+    label = Tensor(np.zeros([1, 10]).astype(np.float32))
+    _executor.compile(train_network, inputs, label)
+
+    with pytest.raises(ValueError):
+        TrainOneStepWithAccumulationCell(net_with_loss, optimizer, accumulation_steps=0)
+
+
 def test_parameter_update_error():
     """ test_parameter_update """
     input_np = np.array([1])
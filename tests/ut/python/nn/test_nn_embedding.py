@@ -16,7 +16,7 @@
 import numpy as np
 from mindspore import Tensor
 from mindspore.common import dtype
-from mindspore.nn import Embedding
+from mindspore.nn import Embedding, HostEmbeddingTable, HostEmbeddingLookup
 from mindspore.common.api import _executor
 from ..ut_filter import non_graph_engine
 
@@ -45,3 +45,32 @@ def test_check_embedding_3():
 def test_print_embedding():
     net = Embedding(20000, 768, False)
     print(net)
+
+
+def test_host_embedding_table_prefetch():
+    table = HostEmbeddingTable(10, 4)
+    unique_ids, restore_ids = table.prefetch(np.array([[3, 5, 3], [7, 5, 1]]))
+    assert np.all(unique_ids == np.array([1, 3, 5, 7, -1, -1]))
+    assert np.all(restore_ids == np.array([[1, 2, 1], [3, 2, 0]]))
+    rows = table.lookup(unique_ids)
+    assert rows.shape == (6, 4)
+    assert np.all(rows[:4] == table.embedding_table[[1, 3, 5, 7]])
+    assert np.all(rows[4:] == 0)
+
+
+def test_host_embedding_table_update():
+    table = HostEmbeddingTable(10, 4, learning_rate=0.5, initial_accum=1.0, embedding_table=np.zeros([10, 4]))
+    unique_ids = np.array([2, 6, -1], np.int32)
+    grad = np.array([[3.0] * 4, [0.0] * 4, [1.0] * 4], np.float32)
+    table.update(unique_ids, grad)
+    assert np.allclose(table.embedding_table[2], -0.5 * 3.0 / np.sqrt(10.0))
+    assert np.all(table.embedding_table[6] == 0)
+    assert np.all(table.accum[0] == 1.0)
+
+
+@non_graph_engine
+def test_host_embedding_lookup():
+    net = HostEmbeddingLookup()
+    rows = Tensor(np.ones([16, 768]), dtype.float32)
+    restore_ids = Tensor(np.ones([8, 2]), dtype.int32)
+    _executor.compile(net, rows, restore_ids)
@@ -174,6 +174,13 @@ def test_allreduce_fusion_parameters():
     computation_time_parameter = cost_model_context.get_cost_model_context('costmodel_allreduce_fusion_computation_time_parameter')
     assert (computation_time_parameter == 0.1)
 
+    cost_model_context.set_cost_model_context(costmodel_allreduce_fusion_bucket_size=1024.0)
+    bucket_size = cost_model_context.get_cost_model_context('costmodel_allreduce_fusion_bucket_size')
+    assert (bucket_size == 1024.0)
+    cost_model_context.reset_cost_model_context()
+    bucket_size = cost_model_context.get_cost_model_context('costmodel_allreduce_fusion_bucket_size')
+    assert (bucket_size == 26214400.0)
+
 
 def test_allreduce_fusion1():
     cost_model_context.set_cost_model_context(costmodel_allreduce_fusion_algorithm=1)
@@ -292,3 +299,31 @@ def test_allreduce_fusion5():
     assert (allreduce_fusion_dict == expect_dict)
     cost_model_context.reset_cost_model_context()
 
+
+
+def test_allreduce_fusion6():
+    cost_model_context.set_cost_model_context(costmodel_allreduce_fusion_algorithm=3)
+    # each weight gradient is 128 * 128 float32, so a bucket holds 4 of them
+    cost_model_context.set_cost_model_context(costmodel_allreduce_fusion_bucket_size=262144.0)
+    net = SimpleDMLNet(DenseNet2(has_bias=False, activation=None), DenseNet2(has_bias=False, activation=None))
+    allreduce_fusion_dict = train_common(net)
+
+    expect_dict = {'backbone2.fc8.weight': 1,
+                   'backbone2.fc7.weight': 1,
+                   'backbone2.fc6.weight': 2,
+                   'backbone2.fc5.weight': 2,
+                   'backbone2.fc4.weight': 3,
+                   'backbone2.fc3.weight': 3,
+                   'backbone2.fc2.weight': 4,
+                   'backbone2.fc1.weight': 4,
+                   'backbone1.fc8.weight': 1,
+                   'backbone1.fc7.weight': 1,
+                   'backbone1.fc6.weight': 2,
+                   'backbone1.fc5.weight': 2,
+                   'backbone1.fc4.weight': 3,
+                   'backbone1.fc3.weight': 3,
+                   'backbone1.fc2.weight': 4,
+                   'backbone1.fc1.weight': 4,}
+
+    assert (allreduce_fusion_dict == expect_dict)
+    cost_model_context.reset_cost_model_context()
@@ -0,0 +1,69 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+""" test parallel optimizer """
+import numpy as np
+import pytest
+import mindspore.nn as nn
+import mindspore.context as context
+from mindspore.common.api import _executor
+from mindspore.nn import Dense
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn import Momentum
+from mindspore.nn.optim import AdamWeightDecay
+from mindspore import Tensor
+from mindspore.communication.management import init, get_group_size
+from mindspore.train.parallel_utils import ParallelMode
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.dense1 = Dense(128, 64)
+        self.dense2 = Dense(64, 31)
+
+    def construct(self, x):
+        x = self.dense1(x)
+        return self.dense2(x)
+
+
+def test_adam_weight_decay_shard_moments():
+    context.set_context(mode=context.GRAPH_MODE)
+    init()
+    context.reset_auto_parallel_context()
+    context.set_auto_parallel_context(parallel_mode=ParallelMode.DATA_PARALLEL, mirror_mean=True,
+                                      enable_parallel_optimizer=True)
+    group_size = get_group_size()
+    network = Net()
+    optimizer = AdamWeightDecay(network.trainable_params())
+    for param, moment in zip(optimizer.params, optimizer.moments1):
+        shape = param.default_input.shape()
+        if group_size > 1 and shape[0] % group_size == 0:
+            assert moment.default_input.shape() == (shape[0] // group_size,) + tuple(shape[1:])
+        else:
+            assert moment.default_input.shape() == shape
+
+    network = TrainOneStepCell(WithLossCell(network, nn.SoftmaxCrossEntropyWithLogits()), optimizer)
+    predict = Tensor(np.ones([64, 128]).astype(np.float32) * 0.01)
+    label = Tensor(np.zeros([64, 31]).astype(np.float32))
+    _executor.compile(network, predict, label)
+    context.reset_auto_parallel_context()
+
+
+def test_momentum_not_support_parallel_optimizer():
+    context.reset_auto_parallel_context()
+    context.set_auto_parallel_context(parallel_mode=ParallelMode.DATA_PARALLEL, enable_parallel_optimizer=True)
+    network = Net()
+    with pytest.raises(RuntimeError):
+        Momentum(network.trainable_params(), learning_rate=0.1, momentum=0.9)
+    context.reset_auto_parallel_context()
@@ -58,6 +58,26 @@ def test_set_auto_parallel_context():
     parameter_broadcast_is_set = auto_parallel_context().get_parameter_broadcast_is_set()
     assert parameter_broadcast_is_set == True
 
+    context.set_auto_parallel_context(enable_hierarchical_allreduce=True, devices_per_node=4)
+    assert context.get_auto_parallel_context("enable_hierarchical_allreduce") == True
+    assert context.get_auto_parallel_context("devices_per_node") == 4
+
+    with pytest.raises(ValueError):
+        context.set_auto_parallel_context(devices_per_node=0)
+
+    context.set_auto_parallel_context(gradient_compression="topk", topk_compression_ratio=0.1)
+    assert context.get_auto_parallel_context("gradient_compression") == "topk"
+    assert abs(context.get_auto_parallel_context("topk_compression_ratio") - 0.1) < 1e-6
+
+    with pytest.raises(ValueError):
+        context.set_auto_parallel_context(gradient_compression="int8")
+
+    context.set_auto_parallel_context(enable_alltoall=True)
+    assert context.get_auto_parallel_context("enable_alltoall") == True
+
+    with pytest.raises(ValueError):
+        context.set_auto_parallel_context(topk_compression_ratio=0.0)
+
     with pytest.raises(ValueError):
         context.set_auto_parallel_context(device_num=0)
 
@@ -98,3 +118,7 @@ def test_reset_auto_parallel_context():
     assert parameter_broadcast == False
     assert device_num_is_set == False
     assert parameter_broadcast_is_set == False
+    assert context.get_auto_parallel_context("enable_hierarchical_allreduce") == False
+    assert context.get_auto_parallel_context("devices_per_node") == 8
+    assert context.get_auto_parallel_context("gradient_compression") == "none"
+    assert context.get_auto_parallel_context("enable_alltoall") == False
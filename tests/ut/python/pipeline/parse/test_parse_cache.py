@@ -0,0 +1,73 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test_parse_cache """
+import numpy as np
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore import context
+from mindspore.common.api import _executor
+from mindspore.ops import operations as P
+from mindspore._extends.parse import get_parse_cache_key
+
+
+class Layer(nn.Cell):
+    def __init__(self, scale, use_relu=True):
+        super(Layer, self).__init__()
+        self.weight = Parameter(Tensor(np.full([4, 4], scale, np.float32)), name="weight_%d" % scale)
+        self.matmul = P.MatMul()
+        if use_relu:
+            self.act = P.ReLU()
+        else:
+            self.act = nn.ReLU()
+
+    def construct(self, x):
+        return self.act(self.matmul(x, self.weight))
+
+
+class Encoder(nn.Cell):
+    def __init__(self, depth):
+        super(Encoder, self).__init__()
+        self.layers = nn.CellList([Layer(i + 1) for i in range(depth)])
+
+    def construct(self, x):
+        for layer in self.layers:
+            x = layer(x)
+        return x
+
+
+def test_parse_cache_key():
+    layer1 = Layer(1)
+    layer2 = Layer(2)
+    key1, instance1 = get_parse_cache_key(layer1.construct)
+    key2, instance2 = get_parse_cache_key(layer2.construct)
+    assert key1 == key2
+    assert instance1 is layer1
+    assert instance2 is layer2
+
+    # self.act is resolved at once as a primitive, or later as a cell
+    key3, _ = get_parse_cache_key(Layer(1, use_relu=False).construct)
+    assert key3 != key1
+    layer1.add_flags(defer_inline=True)
+    key4, _ = get_parse_cache_key(layer1.construct)
+    assert key4 != key2
+
+    assert get_parse_cache_key(test_parse_cache_key) is None
+
+
+def test_compile_identical_layers():
+    context.set_context(mode=context.GRAPH_MODE)
+    net = Encoder(4)
+    x = Tensor(np.ones([2, 4], np.float32))
+    _executor.compile(net, x)
@@ -71,6 +71,50 @@ def test_dump_target():
     assert context.get_context("save_dump_path") == "."
 
 
+def test_cpu_inter_op_threads():
+    """ test_cpu_inter_op_threads """
+    with pytest.raises(TypeError):
+        context.set_context(cpu_inter_op_threads=True)
+    with pytest.raises(ValueError):
+        context.set_context(cpu_inter_op_threads=0)
+    context.set_context(cpu_inter_op_threads=4)
+    assert context.get_context("cpu_inter_op_threads") == 4
+    context.set_context(cpu_inter_op_threads=1)
+    assert context.get_context("cpu_inter_op_threads") == 1
+
+
+def test_cpu_int8_calibration_steps():
+    """ test_cpu_int8_calibration_steps """
+    with pytest.raises(TypeError):
+        context.set_context(cpu_int8_calibration_steps=1.0)
+    with pytest.raises(ValueError):
+        context.set_context(cpu_int8_calibration_steps=-1)
+    context.set_context(cpu_int8_calibration_steps=10)
+    assert context.get_context("cpu_int8_calibration_steps") == 10
+    context.set_context(cpu_int8_calibration_steps=0)
+    assert context.get_context("cpu_int8_calibration_steps") == 0
+
+
+def test_enable_pynative_async():
+    """ test_enable_pynative_async """
+    with pytest.raises(TypeError):
+        context.set_context(enable_pynative_async=1)
+    context.set_context(enable_pynative_async=True)
+    assert context.get_context("enable_pynative_async")
+    context.set_context(enable_pynative_async=False)
+    assert not context.get_context("enable_pynative_async")
+
+
+def test_enable_shape_respecialize():
+    """ test_enable_shape_respecialize """
+    with pytest.raises(TypeError):
+        context.set_context(enable_shape_respecialize=1)
+    context.set_context(enable_shape_respecialize=True)
+    assert context.get_context("enable_shape_respecialize")
+    context.set_context(enable_shape_respecialize=False)
+    assert not context.get_context("enable_shape_respecialize")
+
+
 def test_set_context():
     """ test_set_context """
     context.set_context(mode=context.GRAPH_MODE, device_target="Ascend",
@@ -66,6 +66,18 @@ def test_amp_o2():
     train_network = amp.build_train_network(net, optimizer, level="O2")
     output = train_network(inputs, label)
 
+def test_amp_o1():
+    inputs = Tensor(np.ones([16, 16]).astype(np.float32))
+    label = Tensor(np.zeros([16, 16]).astype(np.float32))
+    net = Net(16, 16)
+
+    optimizer = nn.Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+    train_network = amp.build_train_network(net, optimizer, level="O1")
+    # only the dense of the white list runs in float16
+    assert isinstance(net.dense, amp._OutputTo32)
+    assert isinstance(net.loss, nn.MSELoss)
+    output = train_network(inputs, label)
+
 def test_amp_o2_loss():
     inputs = Tensor(np.ones([16, 16]).astype(np.float32))
     label = Tensor(np.zeros([16, 16]).astype(np.float32))
@@ -342,3 +342,33 @@ def test_step_end_save_graph():
         os.remove('./test_files/test-graph.meta')
     ckpoint_cb.step_end(run_context)
     assert os.path.exists('./test_files/test-graph.meta') == False
+
+
+def test_checkpoint_save_ckpt_async():
+    """Test checkpoint save ckpt asynchronously."""
+    train_config = CheckpointConfig(
+        save_checkpoint_steps=16,
+        save_checkpoint_seconds=0,
+        keep_checkpoint_max=5,
+        keep_checkpoint_per_n_minutes=0,
+        async_save=True)
+    cb_params = _InternalCallbackParam()
+    net = Net()
+    loss = nn.SoftmaxCrossEntropyWithLogits()
+    optim = Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+    network_ = WithLossCell(net, loss)
+    _train_network = TrainOneStepCell(network_, optim)
+    cb_params.train_network = _train_network
+    cb_params.epoch_num = 10
+    cb_params.cur_epoch_num = 5
+    cb_params.cur_step_num = 160
+    cb_params.batch_num = 32
+    ckpoint_cb = ModelCheckpoint(prefix="test_async", directory='./test_files', config=train_config)
+    run_context = RunContext(cb_params)
+    ckpoint_cb.begin(run_context)
+    ckpoint_cb.step_end(run_context)
+    cb_params.cur_step_num = 176
+    ckpoint_cb.end(run_context)
+    assert os.path.exists(ckpoint_cb.latest_ckpt_file_name)
+    with pytest.raises(TypeError):
+        CheckpointConfig(async_save=1)
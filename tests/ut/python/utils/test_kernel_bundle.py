@@ -0,0 +1,63 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test_kernel_bundle """
+import json
+import os
+import shutil
+import tempfile
+from mindspore._extends.kernel_bundle import pack_kernel_bundle, unpack_kernel_bundle
+from mindspore._extends.utils import cal_sha256
+
+
+def _write_kernel(kernel_meta_dir, kernel_name, content, broken=False):
+    bin_path = os.path.join(kernel_meta_dir, kernel_name + '.o')
+    with open(bin_path, 'wb') as f:
+        f.write(content)
+    sha256 = 'broken' if broken else cal_sha256(bin_path)
+    with open(os.path.join(kernel_meta_dir, kernel_name + '.json'), 'w') as f:
+        json.dump({'kernelName': kernel_name, 'binFileSuffix': '.o', 'sha256': sha256}, f)
+
+
+def test_pack_and_unpack_kernel_bundle():
+    work_dir = tempfile.mkdtemp()
+    try:
+        src_dir = os.path.join(work_dir, 'src_kernel_meta')
+        dst_dir = os.path.join(work_dir, 'dst_kernel_meta')
+        os.makedirs(src_dir)
+        _write_kernel(src_dir, 'te_add_0', b'add')
+        _write_kernel(src_dir, 'te_mul_0', b'mul')
+        _write_kernel(src_dir, 'te_sub_0', b'sub', broken=True)
+        bundle_path = os.path.join(work_dir, 'kernels.tar.gz')
+        assert pack_kernel_bundle(src_dir, bundle_path) == 2
+
+        os.makedirs(dst_dir)
+        _write_kernel(dst_dir, 'te_add_0', b'add')
+        assert unpack_kernel_bundle(bundle_path, dst_dir) == 1
+        assert sorted(os.listdir(dst_dir)) == ['te_add_0.json', 'te_add_0.o', 'te_mul_0.json', 'te_mul_0.o']
+        assert cal_sha256(os.path.join(dst_dir, 'te_mul_0.o')) == cal_sha256(os.path.join(src_dir, 'te_mul_0.o'))
+        assert unpack_kernel_bundle(bundle_path, dst_dir) == 0
+    finally:
+        shutil.rmtree(work_dir)
+
+
+def test_unpack_invalid_kernel_bundle():
+    work_dir = tempfile.mkdtemp()
+    try:
+        bundle_path = os.path.join(work_dir, 'kernels.tar.gz')
+        with open(bundle_path, 'wb') as f:
+            f.write(b'not a bundle')
+        assert unpack_kernel_bundle(bundle_path, os.path.join(work_dir, 'kernel_meta')) == -1
+    finally:
+        shutil.rmtree(work_dir)
@@ -29,7 +29,8 @@ from mindspore.nn.optim.momentum import Momentum
 from mindspore.nn import WithLossCell, TrainOneStepCell
 from mindspore.train.callback import _CheckpointManager
 from mindspore.train.serialization import save_checkpoint, load_checkpoint,load_param_into_net, \
-                                          _exec_save_checkpoint, export, _save_graph
+                                          load_distributed_checkpoint, \
+                                          _exec_save_checkpoint, export, _save_graph, _async_saver
 from ..ut_filter import run_on_onnxruntime
 from mindspore import context
 
@@ -281,6 +282,104 @@ def test_exec_save_checkpoint():
     load_checkpoint("new_ckpt.ckpt")
 
 
+def test_load_checkpoint_digest():
+    net = Net(10)
+    _exec_save_checkpoint(net, ckpoint_file_name="./digest_ckpt.ckpt")
+    new_net = Net(10)
+    assert len(new_net.parameters_broadcast_dict()) == len(new_net.parameters_dict())
+
+    par_dict = load_checkpoint("digest_ckpt.ckpt", new_net)
+    os.remove("digest_ckpt.ckpt")
+    digest = par_dict['conv1.weight'].checkpoint_digest
+    assert len(digest) == 64
+    assert new_net.conv1.weight.checkpoint_digest == digest
+    # only the parameters loaded from the verified checkpoints are left out
+    new_net.set_checkpoint_verified()
+    assert new_net.parameters_broadcast_dict() is None
+    new_net.conv1.weight.set_parameter_data(Tensor(np.ones([64, 3, 7, 7]), dtype=mstype.float32))
+    assert list(new_net.parameters_broadcast_dict().keys()) == ['conv1.weight']
+    assert new_net.conv1.weight.clone('clone', init='zeros').checkpoint_digest is None
+    new_net.set_checkpoint_verified(False)
+    assert len(new_net.parameters_broadcast_dict()) == len(new_net.parameters_dict())
+
+
+def test_save_checkpoint_async():
+    """ test_save_checkpoint_async """
+    value = np.random.randint(0, 255, [12, 1024]).astype(np.float32)
+    parameter_list = [{'name': "param_async", 'data': Tensor(value)}]
+    ckpoint_file_name = os.path.join(_cur_dir, './parameters_async.ckpt')
+    if os.path.exists(ckpoint_file_name):
+        os.chmod(ckpoint_file_name, stat.S_IWRITE)
+        os.remove(ckpoint_file_name)
+
+    save_checkpoint(parameter_list, ckpoint_file_name, async_save=True)
+    _async_saver.wait()
+    par_dict = load_checkpoint(ckpoint_file_name)
+    assert np.all(par_dict['param_async'].data.asnumpy() == value)
+    os.chmod(ckpoint_file_name, stat.S_IWRITE)
+    os.remove(ckpoint_file_name)
+
+
+def test_save_checkpoint_device_format():
+    """ test_save_checkpoint_device_format """
+    value = np.random.randint(0, 255, [12, 1024]).astype(np.float32)
+    device_tensor = Tensor(np.empty([12, 1024], np.float32))
+    device_tensor.set_device_content("DefaultFormat", mstype.float16, value.astype(np.float16).tobytes())
+    parameter_list = [{'name': "param_device", 'data': device_tensor}, {'name': "param_host", 'data': Tensor(value)}]
+    ckpoint_file_name = os.path.join(_cur_dir, './parameters_device.ckpt')
+    if os.path.exists(ckpoint_file_name):
+        os.chmod(ckpoint_file_name, stat.S_IWRITE)
+        os.remove(ckpoint_file_name)
+
+    save_checkpoint(parameter_list, ckpoint_file_name, device_format=True)
+    par_dict = load_checkpoint(ckpoint_file_name)
+    device_format, device_type, _ = par_dict['param_device'].data.device_content()
+    assert device_format == "DefaultFormat"
+    assert device_type == mstype.float16
+    assert par_dict['param_host'].data.device_content() is None
+    assert np.all(par_dict['param_device'].data.asnumpy() == value)
+    assert np.all(par_dict['param_host'].data.asnumpy() == value)
+    os.chmod(ckpoint_file_name, stat.S_IWRITE)
+    os.remove(ckpoint_file_name)
+
+
+class SlicedNet(nn.Cell):
+    """Net with a parameter saved by slices."""
+    def __init__(self):
+        super(SlicedNet, self).__init__()
+        self.weight = Parameter(Tensor(np.zeros([4, 2]).astype(np.float32)), name="sliced_weight")
+
+    def construct(self, x):
+        return x + self.weight
+
+
+def test_load_distributed_checkpoint():
+    """ test_load_distributed_checkpoint """
+    value = np.arange(8).reshape(4, 2).astype(np.float32)
+    ckpoint_file_names = []
+    # the weight is split by rows on 2 devices
+    for rank in range(2):
+        parameter_list = [{'name': "sliced_weight", 'data': Tensor(value[rank * 2: rank * 2 + 2]),
+                           'layout': ([2], [1, -1], rank)}]
+        ckpoint_file_name = os.path.join(_cur_dir, './parameters_rank_{}.ckpt'.format(rank))
+        if os.path.exists(ckpoint_file_name):
+            os.chmod(ckpoint_file_name, stat.S_IWRITE)
+            os.remove(ckpoint_file_name)
+        save_checkpoint(parameter_list, ckpoint_file_name)
+        ckpoint_file_names.append(ckpoint_file_name)
+
+    net = SlicedNet()
+    par_dict = load_distributed_checkpoint(net, ckpoint_file_names)
+    assert np.all(par_dict['sliced_weight'].data.asnumpy() == value)
+    assert np.all(net.weight.data.asnumpy() == value)
+
+    with pytest.raises(ValueError):
+        load_distributed_checkpoint(net, ckpoint_file_names[:1])
+    for ckpoint_file_name in ckpoint_file_names:
+        os.chmod(ckpoint_file_name, stat.S_IWRITE)
+        os.remove(ckpoint_file_name)
+
+
 def test_load_checkpoint_empty_file():
     os.mknod("empty.ckpt")
     with pytest.raises(ValueError):
@@ -362,6 +461,19 @@ def test_lenet5_onnx_export():
     export(net, input, file_name='lenet5.onnx', file_format='ONNX')
 
 
+def test_lenet5_onnx_export_external_data():
+    input = Tensor(np.ones([1, 1, 32, 32]).astype(np.float32) * 0.01)
+    net = LeNet5()
+    export(net, input, file_name='lenet5_external.onnx', file_format='ONNX', external_data=True)
+    model_size = os.path.getsize('lenet5_external.onnx')
+    data_size = os.path.getsize('lenet5_external.onnx.data')
+    # the weights of the convolutions and the dense layers are in the side file
+    assert data_size > (6 * 25 + 16 * 6 * 25 + 16 * 25 * 120 + 120 * 84 + 84 * 10) * 4
+    assert model_size < data_size
+    os.remove('lenet5_external.onnx')
+    os.remove('lenet5_external.onnx.data')
+
+
 @run_on_onnxruntime
 def test_lenet5_onnx_load_run():
     onnx_file = 'lenet5.onnx'